@@ -12,6 +12,10 @@
 
 #include "yb/cdc/cdc_producer.h"
 
+#include <deque>
+#include <future>
+#include <unordered_set>
+
 #include "yb/cdc/cdc_service.pb.h"
 #include "yb/common/transaction.h"
 #include "yb/common/wire_protocol.h"
@@ -19,18 +23,38 @@
 #include "yb/consensus/raft_consensus.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
+#include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/docdb/value_type.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/flag_tags.h"
 
 DEFINE_int32(cdc_transaction_timeout_ms, 0,
   "Don't check for an aborted transaction unless its original write is lagging by this duration.");
 
+DEFINE_int32(cdc_records_cache_ttl_ms, 0,
+             "How long decoded records of GetChanges response could be reused by other streams "
+             "reading the same tablet from the same op id. 0 to disable the cache.");
+TAG_FLAG(cdc_records_cache_ttl_ms, advanced);
+TAG_FLAG(cdc_records_cache_ttl_ms, runtime);
+
+DEFINE_int32(cdc_records_cache_max_entries, 1024,
+             "Max number of GetChanges responses kept in the CDC records cache.");
+TAG_FLAG(cdc_records_cache_max_entries, advanced);
+TAG_FLAG(cdc_records_cache_max_entries, runtime);
+
+DEFINE_int32(cdc_transaction_status_cache_size, 10000,
+             "Max number of final (committed or aborted) transaction statuses remembered by CDC "
+             "producer, so they are not requested again by subsequent GetChanges calls.");
+TAG_FLAG(cdc_transaction_status_cache_size, advanced);
+TAG_FLAG(cdc_transaction_status_cache_size, runtime);
+
 namespace yb {
 namespace cdc {
 
@@ -185,22 +209,65 @@ Result<ReplicateMsgs> SortWrites(const ReplicateMsgs& msgs,
   return ordered_msgs;
 }
 
-Result<TransactionStatusResult> GetTransactionStatus(
+// Remembers final statuses of transactions, that were requested from transaction participant, so
+// they are not requested again when the same transaction is seen by another GetChanges call.
+class FinalTransactionStatusCache {
+ public:
+  static FinalTransactionStatusCache& Instance() {
+    static FinalTransactionStatusCache instance;
+    return instance;
+  }
+
+  boost::optional<TransactionStatusResult> Find(const TransactionId& txn_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = statuses_.find(txn_id);
+    if (it == statuses_.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+
+  void Insert(const TransactionId& txn_id, const TransactionStatusResult& status) {
+    if (status.status != TransactionStatus::COMMITTED &&
+        status.status != TransactionStatus::ABORTED) {
+      return;
+    }
+    const size_t max_size = std::max(FLAGS_cdc_transaction_status_cache_size, 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!statuses_.emplace(txn_id, status).second) {
+      return;
+    }
+    order_.push_back(txn_id);
+    while (order_.size() > max_size) {
+      statuses_.erase(order_.front());
+      order_.pop_front();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  TxnStatusMap statuses_;
+  // Transactions in order of insertion, the oldest are evicted first.
+  std::deque<TransactionId> order_;
+};
+
+// Sends status request to transaction participant, txn_id should be alive until the result is
+// ready.
+std::future<Result<TransactionStatusResult>> RequestTransactionStatus(
     const TransactionId& txn_id,
     const HybridTime& hybrid_time,
     TransactionParticipant* txn_participant) {
   static const std::string reason = "cdc";
 
-  std::promise<Result<TransactionStatusResult>> txn_status_promise;
-  auto future = txn_status_promise.get_future();
-  auto callback = [&txn_status_promise](Result<TransactionStatusResult> result) {
-    txn_status_promise.set_value(std::move(result));
+  auto txn_status_promise = std::make_shared<std::promise<Result<TransactionStatusResult>>>();
+  auto future = txn_status_promise->get_future();
+  auto callback = [txn_status_promise](Result<TransactionStatusResult> result) {
+    txn_status_promise->set_value(std::move(result));
   };
 
   txn_participant->RequestStatusAt(
       {&txn_id, hybrid_time, hybrid_time, 0, &reason, TransactionLoadFlags{}, callback});
-  future.wait();
-  return future.get();
+  return future;
 }
 
 // Build transaction status as of hybrid_time.
@@ -222,43 +289,70 @@ Result<TxnStatusMap> BuildTxnStatusMap(const ReplicateMsgs& messages,
     }
   }
 
-  // Now go through all WRITE_OP records and get transaction status of records for which
-  // corresponding APPLYING record does not exist in WAL as yet.
+  // Now go through all WRITE_OP records and collect transactions for which corresponding
+  // APPLYING record does not exist in WAL as yet, together with hybrid time of their first write.
+  auto& status_cache = FinalTransactionStatusCache::Instance();
+  std::vector<std::pair<TransactionId, HybridTime>> unknown_txns;
+  std::unordered_set<TransactionId, TransactionIdHash> unknown_txn_ids;
   for (const auto& msg : messages) {
     if (msg->op_type() == consensus::OperationType::WRITE_OP
         && msg->write_request().write_batch().has_transaction()) {
       auto txn_id = VERIFY_RESULT(FullyDecodeTransactionId(
           msg->write_request().write_batch().transaction().transaction_id()));
 
-      if (!txn_map.count(txn_id)) {
-        TransactionStatusResult txn_status(TransactionStatus::PENDING, HybridTime::kMin);
-
-        auto result = GetTransactionStatus(txn_id, cdc_read_hybrid_time, txn_participant);
-        if (!result.ok()) {
-          if (result.status().IsNotFound()) {
-            // Naive heuristic for handling whether a transaction is aborted or still pending:
-            // 1. If the normal transaction timeout is not reached, assume good operation.
-            // 2. If more_replicate_messages, assume a race between reading
-            //    TransactionParticipant & LogCache.
-            // TODO (#2405) : Handle long running or very large transactions correctly.
-            if (!more_replicate_msgs) {
-              auto timeout = HybridTime::FromPB(msg->hybrid_time())
-                  .AddMilliseconds(FLAGS_cdc_transaction_timeout_ms);
-              if (timeout < cdc_read_hybrid_time) {
-                LOG(INFO) << "Transaction not found, considering it aborted: " << txn_id;
-                txn_status = TransactionStatusResult::Aborted();
-              }
-            }
-          } else {
-            return result.status();
+      if (txn_map.count(txn_id) || !unknown_txn_ids.insert(txn_id).second) {
+        continue;
+      }
+      auto cached_status = status_cache.Find(txn_id);
+      if (cached_status) {
+        txn_map.emplace(txn_id, *cached_status);
+        continue;
+      }
+      unknown_txns.emplace_back(txn_id, HybridTime::FromPB(msg->hybrid_time()));
+    }
+  }
+
+  // Request statuses of all unknown transactions at once, instead of waiting for each of them.
+  std::vector<std::future<Result<TransactionStatusResult>>> futures;
+  futures.reserve(unknown_txns.size());
+  for (const auto& txn : unknown_txns) {
+    futures.push_back(RequestTransactionStatus(txn.first, cdc_read_hybrid_time, txn_participant));
+  }
+
+  Status status;
+  for (size_t i = 0; i != unknown_txns.size(); ++i) {
+    const auto& txn_id = unknown_txns[i].first;
+    // Wait for all the requests, even if some of them failed, since they refer txn_id.
+    auto result = futures[i].get();
+    if (!status.ok()) {
+      continue;
+    }
+    TransactionStatusResult txn_status(TransactionStatus::PENDING, HybridTime::kMin);
+    if (!result.ok()) {
+      if (result.status().IsNotFound()) {
+        // Naive heuristic for handling whether a transaction is aborted or still pending:
+        // 1. If the normal transaction timeout is not reached, assume good operation.
+        // 2. If more_replicate_messages, assume a race between reading
+        //    TransactionParticipant & LogCache.
+        // TODO (#2405) : Handle long running or very large transactions correctly.
+        if (!more_replicate_msgs) {
+          auto timeout = unknown_txns[i].second.AddMilliseconds(FLAGS_cdc_transaction_timeout_ms);
+          if (timeout < cdc_read_hybrid_time) {
+            LOG(INFO) << "Transaction not found, considering it aborted: " << txn_id;
+            txn_status = TransactionStatusResult::Aborted();
           }
-        } else {
-          txn_status = *result;
         }
-        txn_map.emplace(txn_id, txn_status);
+      } else {
+        status = result.status();
+        continue;
       }
+    } else {
+      txn_status = *result;
+      status_cache.Insert(txn_id, txn_status);
     }
+    txn_map.emplace(txn_id, txn_status);
   }
+  RETURN_NOT_OK(status);
   return txn_map;
 }
 
@@ -287,12 +381,10 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
   // We'll use DocDB key hash to identify the records that belong to the same row.
   Slice prev_key;
   CDCRecordPB* record = nullptr;
-  for (const auto& write_pair : batch.write_pairs()) {
-    Slice key = write_pair.key();
+  return docdb::EnumerateWritePairs(batch, [&](const Slice& key, const Slice& value) -> Status {
     const auto key_size = VERIFY_RESULT(
         docdb::DocKey::EncodedSize(key, docdb::DocKeyPart::kWholeDocKey));
 
-    Slice value = write_pair.value();
     docdb::Value decoded_value;
     RETURN_NOT_OK(decoded_value.Decode(value));
 
@@ -311,7 +403,7 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
         // producer and re-serializing on consumer.
         auto kv_pair = record->add_key();
         kv_pair->set_key(std::to_string(decoded_key.doc_key().hash()));
-        kv_pair->mutable_value()->set_binary_value(write_pair.key());
+        kv_pair->mutable_value()->set_binary_value(key.ToBuffer());
       } else {
         AddPrimaryKey(decoded_key, schema, record);
       }
@@ -337,11 +429,11 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
 
     if (metadata.record_format == CDCRecordFormat::WAL) {
       auto kv_pair = record->add_changes();
-      kv_pair->set_key(write_pair.key());
-      kv_pair->mutable_value()->set_binary_value(write_pair.value());
+      kv_pair->set_key(key.ToBuffer());
+      kv_pair->mutable_value()->set_binary_value(value.ToBuffer());
     } else if (record->operation() == CDCRecordPB_OperationType_WRITE) {
       PrimitiveValue column_id;
-      Slice key_column = write_pair.key().data() + key_size;
+      Slice key_column(key.data() + key_size, key.end());
       RETURN_NOT_OK(PrimitiveValue::DecodeKey(&key_column, &column_id));
       if (column_id.value_type() == docdb::ValueType::kColumnId) {
         const ColumnSchema& col = VERIFY_RESULT(schema.column_by_id(column_id.GetColumnId()));
@@ -350,8 +442,8 @@ CHECKED_STATUS PopulateWriteRecord(const ReplicateMsgPtr& msg,
         LOG(DFATAL) << "Unexpected value type in key: " << column_id.value_type();
       }
     }
-  }
-  return Status::OK();
+    return Status::OK();
+  });
 }
 
 // Populate CDC record corresponding to WAL UPDATE_TRANSACTION_OP entry.
@@ -366,6 +458,43 @@ CHECKED_STATUS PopulateTransactionRecord(const ReplicateMsgPtr& msg,
 
 } // namespace
 
+CDCRecordsCache::ResponsePtr CDCRecordsCache::Find(
+    const Key& key, int64_t committed_index, uint32_t schema_version) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  const auto& entry = it->second;
+  if (entry.committed_index != committed_index || entry.schema_version != schema_version ||
+      entry.expiration < CoarseMonoClock::now()) {
+    entries_.erase(it);
+    return nullptr;
+  }
+  return entry.response;
+}
+
+void CDCRecordsCache::Insert(
+    const Key& key, int64_t committed_index, uint32_t schema_version, ResponsePtr response) {
+  auto now = CoarseMonoClock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t max_entries = std::max(FLAGS_cdc_records_cache_max_entries, 0);
+  if (entries_.size() >= max_entries) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.expiration < now) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (entries_.size() >= max_entries) {
+      return;
+    }
+  }
+  auto expiration = now + std::chrono::milliseconds(FLAGS_cdc_records_cache_ttl_ms);
+  entries_[key] = Entry { committed_index, schema_version, expiration, std::move(response) };
+}
+
 Status GetChanges(const std::string& stream_id,
                   const std::string& tablet_id,
                   const OpId& from_op_id,
@@ -374,7 +503,31 @@ Status GetChanges(const std::string& stream_id,
                   const MemTrackerPtr& mem_tracker,
                   consensus::ReplicateMsgsHolder* msgs_holder,
                   GetChangesResponsePB* resp,
-                  int64_t* last_readable_opid_index) {
+                  int64_t* last_readable_opid_index,
+                  CDCRecordsCache* records_cache) {
+  if (FLAGS_cdc_records_cache_ttl_ms <= 0) {
+    records_cache = nullptr;
+  }
+  CDCRecordsCache::Key cache_key;
+  uint32_t schema_version = 0;
+  if (records_cache) {
+    cache_key = CDCRecordsCache::Key {
+        tablet_id, from_op_id, stream_metadata.record_type, stream_metadata.record_format };
+    schema_version = tablet_peer->tablet()->metadata()->schema_version();
+    auto committed_index = tablet_peer->consensus()->GetLastCommittedOpId().index;
+    auto cached = records_cache->Find(cache_key, committed_index, schema_version);
+    if (cached) {
+      resp->mutable_records()->CopyFrom(cached->records());
+      resp->mutable_checkpoint()->CopyFrom(cached->checkpoint());
+      if (last_readable_opid_index) {
+        *last_readable_opid_index = committed_index;
+      }
+      return Status::OK();
+    }
+  }
+
+  int64_t last_readable_index = 0;
+
   // Request scope on transaction participant so that transactions are not removed from participant
   // while RequestScope is active.
   RequestScope request_scope;
@@ -384,7 +537,10 @@ Status GetChanges(const std::string& stream_id,
   }
 
   auto read_ops = VERIFY_RESULT(tablet_peer->consensus()->
-    ReadReplicatedMessagesForCDC(from_op_id, last_readable_opid_index));
+    ReadReplicatedMessagesForCDC(from_op_id, &last_readable_index));
+  if (last_readable_opid_index) {
+    *last_readable_opid_index = last_readable_index;
+  }
   ScopedTrackedConsumption consumption;
   if (read_ops.read_from_disk_size && mem_tracker) {
     consumption = ScopedTrackedConsumption(mem_tracker, read_ops.read_from_disk_size);
@@ -420,6 +576,13 @@ Status GetChanges(const std::string& stream_id,
       nullptr, std::move(ordered_messages), std::move(consumption));
   (checkpoint.index > 0 ? checkpoint : from_op_id).ToPB(
       resp->mutable_checkpoint()->mutable_op_id());
+
+  if (records_cache) {
+    auto cached = std::make_shared<GetChangesResponsePB>();
+    cached->mutable_records()->CopyFrom(resp->records());
+    cached->mutable_checkpoint()->CopyFrom(resp->checkpoint());
+    records_cache->Insert(cache_key, last_readable_index, schema_version, std::move(cached));
+  }
   return Status::OK();
 }
 
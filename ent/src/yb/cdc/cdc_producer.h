@@ -14,6 +14,7 @@
 #define ENT_SRC_YB_CDC_CDC_PRODUCER_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include <boost/functional/hash.hpp>
@@ -26,6 +27,7 @@
 #include "yb/consensus/consensus.pb.h"
 #include "yb/docdb/docdb.pb.h"
 #include "yb/tablet/tablet_fwd.h"
+#include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 
 namespace yb {
@@ -43,6 +45,56 @@ struct StreamMetadata {
   }
 };
 
+// Caches decoded records of recent GetChanges calls, so streams with the same record type and
+// format, reading the same tablet from the same op id, share the log read and decoding.
+// Entry is used only while tablet committed op id and schema version are the same as when
+// it was created, and it is not older than cdc_records_cache_ttl_ms. So caught up streams that
+// poll concurrently are served from the cache, while lagging streams see the same records as
+// without it.
+class CDCRecordsCache {
+ public:
+  struct Key {
+    TabletId tablet_id;
+    OpId from_op_id;
+    CDCRecordType record_type;
+    CDCRecordFormat record_format;
+
+    bool operator==(const Key& rhs) const {
+      return tablet_id == rhs.tablet_id && from_op_id == rhs.from_op_id &&
+             record_type == rhs.record_type && record_format == rhs.record_format;
+    }
+
+    friend size_t hash_value(const Key& key) {
+      size_t seed = 0;
+      boost::hash_combine(seed, key.tablet_id);
+      boost::hash_combine(seed, key.from_op_id.term);
+      boost::hash_combine(seed, key.from_op_id.index);
+      boost::hash_combine(seed, key.record_type);
+      boost::hash_combine(seed, key.record_format);
+      return seed;
+    }
+  };
+
+  // Contains only records and checkpoint.
+  typedef std::shared_ptr<const GetChangesResponsePB> ResponsePtr;
+
+  ResponsePtr Find(const Key& key, int64_t committed_index, uint32_t schema_version);
+
+  void Insert(
+      const Key& key, int64_t committed_index, uint32_t schema_version, ResponsePtr response);
+
+ private:
+  struct Entry {
+    int64_t committed_index;
+    uint32_t schema_version;
+    CoarseTimePoint expiration;
+    ResponsePtr response;
+  };
+
+  std::mutex mutex_;
+  boost::unordered_map<Key, Entry> entries_;
+};
+
 CHECKED_STATUS GetChanges(const std::string& stream_id,
                           const std::string& tablet_id,
                           const OpId& op_id,
@@ -51,7 +103,8 @@ CHECKED_STATUS GetChanges(const std::string& stream_id,
                           const std::shared_ptr<MemTracker>& mem_tracker,
                           consensus::ReplicateMsgsHolder* msgs_holder,
                           GetChangesResponsePB* resp,
-                          int64_t* last_readable_opid_index = nullptr);
+                          int64_t* last_readable_opid_index = nullptr,
+                          CDCRecordsCache* records_cache = nullptr);
 
 }  // namespace cdc
 }  // namespace yb
@@ -39,6 +39,7 @@
 #include "yb/client/yb_table_name.h"
 #include "yb/client/yb_op.h"
 #include "yb/gutil/strings/join.h"
+#include "yb/rpc/messenger.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
@@ -81,6 +82,12 @@ DEFINE_int32(update_metrics_interval_ms, 1000,
 
 DEFINE_bool(enable_collect_cdc_metrics, false, "Enable collecting cdc metrics.");
 
+DEFINE_int32(cdc_wait_for_changes_check_interval_ms, 10,
+             "How often GetChanges call, that waits for new changes, checks whether they were "
+             "committed.");
+TAG_FLAG(cdc_wait_for_changes_check_interval_ms, advanced);
+TAG_FLAG(cdc_wait_for_changes_check_interval_ms, runtime);
+
 DECLARE_bool(enable_log_retention_by_op_idx);
 
 DECLARE_int32(cdc_checkpoint_opid_interval_ms);
@@ -116,6 +123,8 @@ CDCServiceImpl::CDCServiceImpl(TSTabletManager* tablet_manager,
       server->messenger());
   async_client_init_->Start();
 
+  CHECK_OK(ThreadPoolBuilder("cdc_get_changes").Build(&get_changes_pool_));
+
   update_peers_and_metrics_thread_.reset(new std::thread(
       &CDCServiceImpl::UpdatePeersAndMetrics, this));
 }
@@ -295,6 +304,45 @@ Result<google::protobuf::RepeatedPtrField<master::TabletLocationsPB>> CDCService
 void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
                                 GetChangesResponsePB* resp,
                                 RpcContext context) {
+  auto wait_deadline = CoarseTimePoint::min();
+  if (req->wait_for_changes_ms() > 0) {
+    // Leave some time to send the response before the client deadline.
+    wait_deadline = std::min(CoarseMonoClock::now() + req->wait_for_changes_ms() * 1ms,
+                             context.GetClientDeadline() - 100ms);
+  }
+  DoGetChanges(req, resp, std::move(context), wait_deadline);
+}
+
+void CDCServiceImpl::ScheduleGetChanges(const GetChangesRequestPB* req,
+                                        GetChangesResponsePB* resp,
+                                        RpcContext context,
+                                        CoarseTimePoint wait_deadline) {
+  auto context_ptr = std::make_shared<RpcContext>(std::move(context));
+  ++scheduled_get_changes_;
+  tablet_manager_->server()->messenger()->scheduler().Schedule(
+      [this, req, resp, context_ptr, wait_deadline](const Status& status) {
+        auto s = status;
+        if (s.ok() && cdc_service_stopped_.load(std::memory_order_acquire)) {
+          s = STATUS(ServiceUnavailable, "CDC service is shutting down");
+        }
+        if (s.ok()) {
+          s = get_changes_pool_->SubmitFunc([this, req, resp, context_ptr, wait_deadline] {
+            DoGetChanges(req, resp, std::move(*context_ptr), wait_deadline);
+          });
+        }
+        if (!s.ok()) {
+          SetupErrorAndRespond(resp->mutable_error(), s, CDCErrorPB::INTERNAL_ERROR,
+                               context_ptr.get());
+        }
+        --scheduled_get_changes_;
+      },
+      FLAGS_cdc_wait_for_changes_check_interval_ms * 1ms);
+}
+
+void CDCServiceImpl::DoGetChanges(const GetChangesRequestPB* req,
+                                  GetChangesResponsePB* resp,
+                                  RpcContext context,
+                                  CoarseTimePoint wait_deadline) {
   if (!CheckOnline(req, resp, &context)) {
     return;
   }
@@ -359,6 +407,13 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   RPC_CHECK_AND_RETURN_ERROR(record.ok(), record.status(), resp->mutable_error(),
                              CDCErrorPB::INTERNAL_ERROR, context);
 
+  if (req->has_from_checkpoint() && CoarseMonoClock::now() < wait_deadline &&
+      tablet_peer->consensus()->GetLastCommittedOpId().index <= op_id.index) {
+    // Nothing to read yet, check again later instead of responding with empty batch.
+    ScheduleGetChanges(req, resp, std::move(context), wait_deadline);
+    return;
+  }
+
   int64_t last_readable_index;
   consensus::ReplicateMsgsHolder msgs_holder;
   MemTrackerPtr mem_tracker = GetMemTracker(tablet_peer, producer_tablet);
@@ -366,7 +421,7 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   // Read the latest changes from the Log.
   s = cdc::GetChanges(
       req->stream_id(), req->tablet_id(), op_id, *record->get(), tablet_peer, mem_tracker,
-      &msgs_holder, resp, &last_readable_index);
+      &msgs_holder, resp, &last_readable_index, &records_cache_);
   RPC_STATUS_RETURN_ERROR(
       s,
       resp->mutable_error(),
@@ -1080,6 +1135,14 @@ void CDCServiceImpl::BootstrapProducer(const BootstrapProducerRequestPB* req,
 
 void CDCServiceImpl::Shutdown() {
   if (async_client_init_) {
+    cdc_service_stopped_.store(true, std::memory_order_release);
+    // Scheduled calls check for shutdown within the check interval.
+    while (scheduled_get_changes_.load(std::memory_order_acquire) > 0) {
+      SleepFor(MonoDelta::FromMilliseconds(1));
+    }
+    if (get_changes_pool_) {
+      get_changes_pool_->Shutdown();
+    }
     async_client_init_->Shutdown();
     rpcs_.Shutdown();
     if (update_peers_and_metrics_thread_) {
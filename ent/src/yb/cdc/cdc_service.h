@@ -37,6 +37,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/service_util.h"
+#include "yb/util/threadpool.h"
 
 namespace yb {
 
@@ -137,6 +138,18 @@ class CDCServiceImpl : public CDCServiceIf {
 
   CHECKED_STATUS CheckTabletValidForStream(const ProducerTabletInfo& producer_info);
 
+  // Serves GetChanges, waiting until wait_deadline for new changes when there are none.
+  void DoGetChanges(const GetChangesRequestPB* req,
+                    GetChangesResponsePB* resp,
+                    rpc::RpcContext context,
+                    CoarseTimePoint wait_deadline);
+
+  // Retries DoGetChanges after cdc_wait_for_changes_check_interval_ms.
+  void ScheduleGetChanges(const GetChangesRequestPB* req,
+                          GetChangesResponsePB* resp,
+                          rpc::RpcContext context,
+                          CoarseTimePoint wait_deadline);
+
   void TabletLeaderGetChanges(const GetChangesRequestPB* req,
                               GetChangesResponsePB* resp,
                               std::shared_ptr<rpc::RpcContext> context,
@@ -186,6 +199,8 @@ class CDCServiceImpl : public CDCServiceIf {
   MetricRegistry* metric_registry_;
   std::shared_ptr<CDCServerMetrics> server_metrics_;
 
+  CDCRecordsCache records_cache_;
+
   // Used to protect tablet_checkpoints_ and stream_metadata_ maps.
   mutable rw_spinlock mutex_;
 
@@ -268,6 +283,11 @@ class CDCServiceImpl : public CDCServiceIf {
   // True when this service is stopped. Used to inform
   // get_minimum_checkpoints_and_update_peers_thread_ that it should exit.
   std::atomic<bool> cdc_service_stopped_{false};
+
+  // Runs GetChanges calls that waited for new changes.
+  std::unique_ptr<ThreadPool> get_changes_pool_;
+  // Number of GetChanges calls scheduled to check for new changes.
+  std::atomic<int> scheduled_get_changes_{0};
 };
 
 }  // namespace cdc
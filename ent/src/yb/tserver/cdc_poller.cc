@@ -21,6 +21,7 @@
 #include "yb/client/client.h"
 
 #include "yb/consensus/opid_util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/threadpool.h"
 
@@ -31,6 +32,18 @@ DEFINE_int32(replication_failure_delay_exponent, 16 /* ~ 2^16/1000 ~= 65 sec */,
 DEFINE_bool(cdc_consumer_use_proxy_forwarding, false,
             "When enabled, read requests from the CDC Consumer that go to the wrong node are "
             "forwarded to the correct node by the Producer.");
+DEFINE_bool(cdc_consumer_prefetch_changes, false,
+            "When enabled, the CDC Consumer polls for the next batch of changes while the "
+            "previous batch is being applied. Only used when async_replication_polling_delay_ms "
+            "is 0.");
+TAG_FLAG(cdc_consumer_prefetch_changes, advanced);
+TAG_FLAG(cdc_consumer_prefetch_changes, runtime);
+DEFINE_int32(cdc_consumer_wait_for_changes_ms, 0,
+             "How long the Producer could wait for new changes before responding to GetChanges "
+             "request from the CDC Consumer with empty batch. Limited to half of "
+             "cdc_read_rpc_timeout_ms.");
+TAG_FLAG(cdc_consumer_wait_for_changes_ms, advanced);
+TAG_FLAG(cdc_consumer_wait_for_changes_ms, runtime);
 
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 
@@ -99,13 +112,23 @@ void CDCPoller::DoPoll() {
     SleepFor(MonoDelta::FromMilliseconds(delay));
   }
 
+  SendGetChangesUnlocked(op_id_, &CDCPoller::HandlePoll);
+}
+
+void CDCPoller::SendGetChangesUnlocked(
+    const OpIdPB& op_id,
+    void (CDCPoller::*handler)(Status, std::shared_ptr<cdc::GetChangesResponsePB>)) {
   cdc::GetChangesRequestPB req;
   req.set_stream_id(producer_tablet_info_.stream_id);
   req.set_tablet_id(producer_tablet_info_.tablet_id);
   req.set_serve_as_proxy(FLAGS_cdc_consumer_use_proxy_forwarding);
+  if (FLAGS_cdc_consumer_wait_for_changes_ms > 0) {
+    req.set_wait_for_changes_ms(
+        std::min(FLAGS_cdc_consumer_wait_for_changes_ms, FLAGS_cdc_read_rpc_timeout_ms / 2));
+  }
 
   cdc::CDCCheckpointPB checkpoint;
-  *checkpoint.mutable_op_id() = op_id_;
+  *checkpoint.mutable_op_id() = op_id;
   if (checkpoint.op_id().index() > 0 || checkpoint.op_id().term() > 0) {
     // Only send non-zero checkpoints in request.
     // If we don't know the latest checkpoint, then CDC producer can use the checkpoint from
@@ -126,14 +149,13 @@ void CDCPoller::DoPoll() {
         [=](const Status &status, cdc::GetChangesResponsePB &&new_resp) {
           auto retained = rpcs->Unregister(read_rpc_handle);
           auto resp = std::make_shared<cdc::GetChangesResponsePB>(std::move(new_resp));
-          WARN_NOT_OK(thread_pool_->SubmitFunc(std::bind(&CDCPoller::HandlePoll, this,
-                                                         status, resp)),
+          WARN_NOT_OK(thread_pool_->SubmitFunc(std::bind(handler, this, status, resp)),
                       "Could not submit HandlePoll to thread pool");
         });
     (**read_rpc_handle).SendRpc();
   } else {
     // Handle the Poll as a failure so repeated invocations will incur backoff.
-    WARN_NOT_OK(thread_pool_->SubmitFunc(std::bind(&CDCPoller::HandlePoll, this,
+    WARN_NOT_OK(thread_pool_->SubmitFunc(std::bind(handler, this,
                   STATUS(Aborted, LogPrefixUnlocked() + "InvalidHandle for GetChangesCDCRpc"),
                   resp_)),
                 "Could not submit HandlePoll to thread pool");
@@ -172,10 +194,51 @@ void CDCPoller::HandlePoll(yb::Status status,
   }
   poll_failures_ = max(poll_failures_ - 2, 0); // otherwise, recover slowly if we're congested
 
+  if (FLAGS_cdc_consumer_prefetch_changes && FLAGS_async_replication_polling_delay_ms == 0) {
+    PrefetchUnlocked();
+  }
+
   // Success Case: ApplyChanges() from Poll
   WARN_NOT_OK(output_client_->ApplyChanges(resp_.get()), "Could not ApplyChanges");
 }
 
+void CDCPoller::PrefetchUnlocked() {
+  DCHECK(!prefetch_in_progress_);
+  prefetch_in_progress_ = true;
+  apply_waits_for_prefetch_ = false;
+  prefetch_resp_.reset();
+  // Changes after the checkpoint of the response being applied.
+  prefetch_op_id_ = resp_->checkpoint().op_id();
+  SendGetChangesUnlocked(prefetch_op_id_, &CDCPoller::HandlePrefetch);
+}
+
+void CDCPoller::HandlePrefetch(yb::Status status,
+                               std::shared_ptr<cdc::GetChangesResponsePB> resp) {
+  RETURN_WHEN_OFFLINE();
+
+  std::lock_guard<std::mutex> l(data_mutex_);
+
+  prefetch_in_progress_ = false;
+  prefetch_status_ = status;
+  prefetch_resp_ = resp;
+  if (apply_waits_for_prefetch_) {
+    apply_waits_for_prefetch_ = false;
+    UsePrefetchedUnlocked();
+  }
+}
+
+void CDCPoller::UsePrefetchedUnlocked() {
+  auto resp = std::move(prefetch_resp_);
+  prefetch_resp_.reset();
+  if (!consensus::OpIdEquals(prefetch_op_id_, op_id_)) {
+    // Applied changes end at different op id, so prefetched changes could not be used.
+    return Poll();
+  }
+  WARN_NOT_OK(thread_pool_->SubmitFunc(std::bind(&CDCPoller::HandlePoll, this,
+                                                 prefetch_status_, resp)),
+              "Could not submit HandlePoll to thread pool");
+}
+
 void CDCPoller::HandleApplyChanges(cdc::OutputClientResponse response) {
   RETURN_WHEN_OFFLINE();
 
@@ -204,6 +267,14 @@ void CDCPoller::DoHandleApplyChanges(cdc::OutputClientResponse response) {
 
   op_id_ = response.last_applied_op_id;
 
+  if (prefetch_in_progress_) {
+    apply_waits_for_prefetch_ = true;
+    return;
+  }
+  if (prefetch_resp_) {
+    return UsePrefetchedUnlocked();
+  }
+
   Poll();
 }
 #undef RETURN_WHEN_OFFLINE
@@ -69,6 +69,16 @@ class CDCPoller {
   bool CheckOnline();
 
   void DoPoll();
+  // Sends GetChanges request for changes after op_id, response is handled by handler in the
+  // thread pool.
+  void SendGetChangesUnlocked(
+      const OpIdPB& op_id,
+      void (CDCPoller::*handler)(Status, std::shared_ptr<cdc::GetChangesResponsePB>));
+  // Starts polling for changes after resp_, while resp_ is being applied.
+  void PrefetchUnlocked();
+  void HandlePrefetch(yb::Status status, std::shared_ptr<cdc::GetChangesResponsePB> resp);
+  // Handles prefetched changes, after previous changes were applied.
+  void UsePrefetchedUnlocked();
   // Does the work of sending the changes to the output client.
   void HandlePoll(yb::Status status,
                   std::shared_ptr<cdc::GetChangesResponsePB> resp);
@@ -100,6 +110,15 @@ class CDCPoller {
   std::atomic<bool> is_polling_{true};
   int poll_failures_ GUARDED_BY(data_mutex_){0};
   int apply_failures_ GUARDED_BY(data_mutex_){0};
+
+  // Prefetch of changes after resp_, see FLAGS_cdc_consumer_prefetch_changes.
+  bool prefetch_in_progress_ GUARDED_BY(data_mutex_) = false;
+  // Changes were applied while prefetch was in progress, so prefetched changes should be handled
+  // as soon as they are received.
+  bool apply_waits_for_prefetch_ GUARDED_BY(data_mutex_) = false;
+  OpIdPB prefetch_op_id_ GUARDED_BY(data_mutex_);
+  yb::Status prefetch_status_ GUARDED_BY(data_mutex_);
+  std::shared_ptr<cdc::GetChangesResponsePB> prefetch_resp_ GUARDED_BY(data_mutex_);
 };
 
 } // namespace enterprise
@@ -61,7 +61,7 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   CHECKED_STATUS ApplyChanges(const cdc::GetChangesResponsePB* resp) override;
 
   void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                          rpc::Rpcs::Handle handle);
+                          rpc::Rpcs::Handle handle, const std::string& tablet_id);
 
  private:
   void TabletLookupCallback(
@@ -71,7 +71,12 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   void WriteIfAllRecordsProcessed();
 
-  void SendNextCDCWriteToTablet();
+  // Sends all writes that could be sent now, see TwoDCWriteInterface::GetNextWriteRequest.
+  void SendCDCWrites();
+
+  void SendCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request);
+
+  void WriteDone(const std::string& tablet_id, const Status& status);
 
   // Increment processed record count.
   // Returns true if all records are processed, false if there are still some pending records.
@@ -91,7 +96,8 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   std::shared_ptr<client::YBTable> table_;
 
-  // Used to protect error_status_, op_id_, done_processing_ and record counts.
+  // Used to protect error_status_, op_id_, done_processing_, record counts and write_strategy_
+  // after all records were processed.
   mutable rw_spinlock lock_;
   Status error_status_ GUARDED_BY(lock_);
   OpIdPB op_id_ GUARDED_BY(lock_) = consensus::MinimumOpId();
@@ -99,6 +105,7 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   uint32_t processed_record_count_ GUARDED_BY(lock_) = 0;
   uint32_t record_count_ GUARDED_BY(lock_) = 0;
+  size_t writes_in_flight_ GUARDED_BY(lock_) = 0;
 
   // This will cache the response to an ApplyChanges() request.
   cdc::GetChangesResponsePB twodc_resp_copy_;
@@ -126,6 +133,7 @@ Status TwoDCOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* poller_r
     done_processing_ = false;
     processed_record_count_ = 0;
     record_count_ = poller_resp->records_size();
+    writes_in_flight_ = 0;
     ResetWriteInterface(&write_strategy_);
   }
 
@@ -200,7 +208,7 @@ void TwoDCOutputClient::WriteIfAllRecordsProcessed() {
       HandleResponse();
     } else {
       // Apply the writes on consumer.
-      SendNextCDCWriteToTablet();
+      SendCDCWrites();
     }
   }
 }
@@ -226,9 +234,25 @@ void TwoDCOutputClient::TabletLookupCallbackFastTrack(const size_t record_idx) {
   WriteIfAllRecordsProcessed();
 }
 
-void TwoDCOutputClient::SendNextCDCWriteToTablet() {
-  auto write_request = write_strategy_->GetNextWriteRequest();
+void TwoDCOutputClient::SendCDCWrites() {
+  for (;;) {
+    std::unique_ptr<WriteRequestPB> write_request;
+    {
+      std::lock_guard<decltype(lock_)> l(lock_);
+      if (!error_status_.ok()) {
+        return;
+      }
+      write_request = write_strategy_->GetNextWriteRequest();
+      if (!write_request) {
+        return;
+      }
+      ++writes_in_flight_;
+    }
+    SendCDCWriteToTablet(std::move(write_request));
+  }
+}
 
+void TwoDCOutputClient::SendCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request) {
   auto deadline = CoarseMonoClock::Now() +
                   MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
   auto write_rpc_handle = local_client_->rpcs->Prepare();
@@ -240,32 +264,53 @@ void TwoDCOutputClient::SendNextCDCWriteToTablet() {
         local_client_->client.get(),
         write_request.get(),
         std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this,
-                  std::placeholders::_1, std::placeholders::_2, write_rpc_handle),
+                  std::placeholders::_1, std::placeholders::_2, write_rpc_handle,
+                  write_request->tablet_id()),
         UseLocalTserver());
     (**write_rpc_handle).SendRpc();
   } else {
     LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
+    WriteDone(write_request->tablet_id(),
+              STATUS_FORMAT(Aborted, "Invalid handle for CDC write, tablet ID: $0",
+                            write_request->tablet_id()));
   }
 }
 
 void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response,
-                                           rpc::Rpcs::Handle handle) {
+                                           rpc::Rpcs::Handle handle,
+                                           const std::string& tablet_id) {
   auto retained = local_client_->rpcs->Unregister(handle);
   if (!status.ok()) {
-    HandleError(status, true /* done */);
+    WriteDone(tablet_id, status);
     return;
   } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()), true /* done */);
+    WriteDone(tablet_id, StatusFromPB(response.error().status()));
     return;
   }
 
   cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
 
-  if (!write_strategy_->HasMoreWrites()) {
+  WriteDone(tablet_id, Status::OK());
+}
+
+void TwoDCOutputClient::WriteDone(const std::string& tablet_id, const Status& status) {
+  if (!status.ok()) {
+    HandleError(status, false /* done */);
+  }
+  bool done;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    write_strategy_->WriteDone(tablet_id);
+    --writes_in_flight_;
+    // After failure we wait for writes in flight, and return error without sending other writes.
+    done = writes_in_flight_ == 0 && (!error_status_.ok() || !write_strategy_->HasMoreWrites());
+  }
+
+  if (done) {
     // Last record, return response to caller.
     HandleResponse();
   } else {
-    SendNextCDCWriteToTablet();
+    SendCDCWrites();
   }
 }
 
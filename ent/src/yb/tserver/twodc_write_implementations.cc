@@ -11,6 +11,7 @@
 // under the License.
 
 #include <deque>
+#include <set>
 
 #include "yb/tserver/twodc_write_interface.h"
 #include "yb/tserver/tserver.pb.h"
@@ -32,6 +33,13 @@ DEFINE_int32(cdc_max_apply_batch_size_bytes, 0, "Max CDC write request batch siz
                                                 " default to consensus_max_batch_size_bytes.");
 TAG_FLAG(cdc_max_apply_batch_size_bytes, runtime);
 
+DEFINE_int32(cdc_max_parallel_apply_tablets, 1,
+             "Max number of consumer tablets that batched CDC writes are sent to in parallel. "
+             "Writes to the same tablet are always sent one at a time, to keep order of changes "
+             "to the same key.");
+TAG_FLAG(cdc_max_parallel_apply_tablets, advanced);
+TAG_FLAG(cdc_max_parallel_apply_tablets, runtime);
+
 DEFINE_test_flag(bool, twodc_write_hybrid_time, false,
                  "Override external_hybrid_time with initialHybridTimeValue for testing.");
 
@@ -73,17 +81,26 @@ class SequentialWriteImplementation : public TwoDCWriteInterface {
   }
 
   std::unique_ptr <WriteRequestPB> GetNextWriteRequest() override {
+    if (write_in_flight_ || records_.empty()) {
+      return nullptr;
+    }
     auto next_req = std::move(records_.front());
     records_.pop_front();
+    write_in_flight_ = true;
     return next_req;
   }
 
+  void WriteDone(const std::string& tablet_id) override {
+    write_in_flight_ = false;
+  }
+
   bool HasMoreWrites() override {
     return records_.size() > 0;
   }
 
  private:
   std::deque <std::unique_ptr<WriteRequestPB>> records_;
+  bool write_in_flight_ = false;
 
 };
 
@@ -91,7 +108,8 @@ class SequentialWriteImplementation : public TwoDCWriteInterface {
 // Max number of records in a request is cdc_max_apply_batch_num_records, and max size of a request
 // is cdc_max_apply_batch_size_kb. Batches are not sent by opid order, since a GetChangesResponse
 // can contain interleaved records to multiple tablets. Rather, we send batches to each tablet
-// in order for that tablet, before moving on to the next tablet.
+// in order for that tablet. Batches to up to cdc_max_parallel_apply_tablets different tablets are
+// sent in parallel, while there is at most one batch in flight per tablet.
 class BatchedWriteImplementation : public TwoDCWriteInterface {
   ~BatchedWriteImplementation() = default;
 
@@ -135,13 +153,26 @@ class BatchedWriteImplementation : public TwoDCWriteInterface {
   }
 
   std::unique_ptr <WriteRequestPB> GetNextWriteRequest() override {
-    auto& queue = records_.begin()->second;
-    auto next_req = std::move(queue.front());
-    queue.pop_front();
-    if (queue.size() == 0) {
-      records_.erase(next_req->tablet_id());
+    if (tablets_in_flight_.size() >= std::max(FLAGS_cdc_max_parallel_apply_tablets, 1)) {
+      return nullptr;
     }
-    return next_req;
+    for (auto& tablet_and_queue : records_) {
+      if (!tablets_in_flight_.insert(tablet_and_queue.first).second) {
+        continue;
+      }
+      auto& queue = tablet_and_queue.second;
+      auto next_req = std::move(queue.front());
+      queue.pop_front();
+      if (queue.size() == 0) {
+        records_.erase(next_req->tablet_id());
+      }
+      return next_req;
+    }
+    return nullptr;
+  }
+
+  void WriteDone(const std::string& tablet_id) override {
+    tablets_in_flight_.erase(tablet_id);
   }
 
   bool HasMoreWrites() override {
@@ -151,6 +182,8 @@ class BatchedWriteImplementation : public TwoDCWriteInterface {
  private:
   std::map <std::string, std::deque<std::unique_ptr < WriteRequestPB>>>
   records_;
+  // Tablets that have write in flight.
+  std::set<std::string> tablets_in_flight_;
 };
 
 void ResetWriteInterface(std::unique_ptr<TwoDCWriteInterface>* write_strategy) {
@@ -31,7 +31,11 @@ namespace enterprise {
 class TwoDCWriteInterface {
  public:
   virtual ~TwoDCWriteInterface() {}
+  // Returns next write request to send, or nullptr if no write could be sent until one of the
+  // writes in flight is done.
   virtual std::unique_ptr <WriteRequestPB> GetNextWriteRequest() = 0;
+  // Notifies that write to the tablet, returned by GetNextWriteRequest, is done.
+  virtual void WriteDone(const std::string& tablet_id) = 0;
   virtual void ProcessRecord(const std::string& tablet_id, const cdc::CDCRecordPB& record) = 0;
   virtual bool HasMoreWrites() = 0;
 };
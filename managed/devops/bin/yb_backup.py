@@ -267,6 +267,22 @@ def checksum_path_downloaded(file_path):
     return checksum_path(file_path) + '.downloaded'
 
 
+def checksum_path_base(file_path):
+    return checksum_path(file_path) + '.base'
+
+
+def parse_checksums(output):
+    """
+    Parses the output of sha256sum into a map from the file name to its check-sum.
+    """
+    result = {}
+    for line in output.split("\n"):
+        fields = line.split()
+        if len(fields) == 2:
+            result[os.path.basename(fields[1])] = fields[0]
+    return result
+
+
 # TODO: get rid of this sed / test program generation in favor of a more maintainable solution.
 def key_and_file_filter(checksum_file):
     return "\" $( sed 's| .*/| |' {} ) \"".format(pipes.quote(checksum_file))
@@ -342,6 +358,11 @@ class AzBackupStorage(AbstractBackupStorage):
         dest = "'{}'".format(dest + os.getenv('AZURE_STORAGE_SAS_TOKEN'))
         return ["{} {} {}".format(self._command_list_prefix(), src, dest)]
 
+    def copy_file_cmd(self, src, dest):
+        src = "'{}'".format(src + os.getenv('AZURE_STORAGE_SAS_TOKEN'))
+        dest = "'{}'".format(dest + os.getenv('AZURE_STORAGE_SAS_TOKEN'))
+        return ["{} {} {}".format(self._command_list_prefix(), src, dest)]
+
     def download_file_cmd(self, src, dest):
         src = "'{}'".format(src + os.getenv('AZURE_STORAGE_SAS_TOKEN'))
         dest = "'{}'".format(dest)
@@ -374,6 +395,9 @@ class GcsBackupStorage(AbstractBackupStorage):
     def upload_file_cmd(self, src, dest):
         return self._command_list_prefix() + ["cp", src, dest]
 
+    def copy_file_cmd(self, src, dest):
+        return self._command_list_prefix() + ["cp", src, dest]
+
     def download_file_cmd(self, src, dest):
         return self._command_list_prefix() + ["cp", src, dest]
 
@@ -403,6 +427,12 @@ class S3BackupStorage(AbstractBackupStorage):
             cmd_list.append("--server-side-encryption")
         return self._command_list_prefix() + cmd_list
 
+    def copy_file_cmd(self, src, dest):
+        cmd_list = ["cp", src, dest]
+        if self.options.args.sse:
+            cmd_list.append("--server-side-encryption")
+        return self._command_list_prefix() + cmd_list
+
     def download_file_cmd(self, src, dest):
         return self._command_list_prefix() + ["get", src, dest]
 
@@ -439,6 +469,12 @@ class NfsBackupStorage(AbstractBackupStorage):
     def download_file_cmd(self, src, dest):
         return self._command_list_prefix() + [src, dest]
 
+    # Hard link keeps the copy valid when the source backup is deleted, without using space.
+    def copy_file_cmd(self, src, dest):
+        return ["mkdir -p {} && (ln -f {} {} || cp {} {})".format(
+            os.path.dirname(dest), pipes.quote(src), pipes.quote(dest),
+            pipes.quote(src), pipes.quote(dest))]
+
     # This is a list of single string, because a) we need a single string for executing
     # `mkdir && rsync` and b) we need a list of 1 element, as it goes through a tuple().
     def upload_dir_cmd(self, src, dest):
@@ -494,6 +530,7 @@ class YBBackup:
         self.tmp_dir_name = ''
         self.server_ips_with_uploaded_cloud_cfg = {}
         self.k8s_namespace_to_cfg = {}
+        self.incremental_uploads = []
         self.parse_arguments()
 
     def sleep_or_raise(self, num_retry, timeout, ex):
@@ -622,6 +659,11 @@ class YBBackup:
             help="Disable automatic generation of a name under the given backup location. If this "
                  "is specified, the backup location will be the exact path of the directory "
                  "storing the snapshot.")
+        parser.add_argument(
+            '--base_backup_location',
+            help="Exact snapshot directory of a previous backup of the same tables. Files of "
+                 "tablets, that did not change since that backup, are copied from it within the "
+                 "storage instead of being uploaded from the tablet servers.")
         parser.add_argument(
             '--no_snapshot_deleting',
             action='store_true',
@@ -657,6 +699,8 @@ class YBBackup:
             logging.info("Parsed arguments: {}".format(vars(self.args)))
 
         self.args.backup_location = self.args.backup_location or self.args.s3bucket
+        if self.args.base_backup_location and self.args.command != 'create':
+            raise BackupException("--base_backup_location is only supported for creating backup")
         options = BackupOptions(self.args)
         self.cloud_cfg_file_path = os.path.join(self.get_tmp_dir(), CLOUD_CFG_FILE_NAME)
         if self.is_s3():
@@ -1244,6 +1288,16 @@ class YBBackup:
         # Run a sequence of steps for each tablet, handling different tablets in parallel.
         parallel_uploads.run(pool)
 
+        if self.incremental_uploads:
+            # Files of each tablet are also handled in parallel, using a separate pool, so
+            # tablet commands waiting for their files do not block them.
+            file_pool = ThreadPool(self.args.parallelism)
+            parallel_file_uploads = MultiArgParallelCmd(
+                lambda *args: self.upload_changed_files(file_pool, *args))
+            for args in self.incremental_uploads:
+                parallel_file_uploads.add_args(*args)
+            parallel_file_uploads.run(pool)
+
     def rearrange_snapshot_dirs(
             self, find_snapshot_dir_results, snapshot_id, tablets_by_tserver_ip):
         """
@@ -1335,6 +1389,19 @@ class YBBackup:
                      snapshot_dir, tserver_ip, self.args.storage_type, target_filepath))
         upload_tablet_cmd = self.storage.upload_dir_cmd(snapshot_dir, target_filepath)
 
+        if self.args.base_backup_location:
+            # Commands to be run on TSes over ssh for the incremental backup.
+            # 1. Create check-sum file (via sha256sum tool).
+            parallel_commands.add_args(create_checksum_cmd, tserver_ip)
+            # 2. Download check-sum file of the tablet from the base backup, if it is there.
+            parallel_commands.add_args(
+                self.download_base_checksum_cmd(tablet_id, snapshot_dir), tserver_ip)
+            # Files and check-sum file are uploaded by upload_changed_files, when check-sums of
+            # all tablets are ready.
+            self.incremental_uploads.append(
+                (snapshot_filepath, tablet_id, tserver_ip, snapshot_dir))
+            return
+
         # Commands to be run on TSes over ssh for uploading the tablet backup.
         # 1. Create check-sum file (via sha256sum tool).
         parallel_commands.add_args(create_checksum_cmd, tserver_ip)
@@ -1343,6 +1410,71 @@ class YBBackup:
         # 3. Upload tablet folder.
         parallel_commands.add_args(tuple(upload_tablet_cmd), tserver_ip)
 
+    def download_base_checksum_cmd(self, tablet_id, snapshot_dir):
+        """
+        Returns command that downloads the check-sum file of the tablet from the base backup.
+        Missing file is not an error, e.g. tablet was created after the base backup, so all
+        its files will be uploaded.
+        """
+        source_checksum_filepath = checksum_path(
+            os.path.join(self.args.base_backup_location, 'tablet-%s' % (tablet_id)))
+        base_checksum = checksum_path_base(strip_dir(snapshot_dir))
+        cmd = self.storage.download_file_cmd(source_checksum_filepath, base_checksum)
+        cmd = cmd[0] if len(cmd) == 1 else quote_cmd_line_for_bash(cmd)
+        return "rm -f {0} && ({1} || rm -f {0})".format(pipes.quote(base_checksum), cmd)
+
+    def upload_changed_files(self, file_pool, snapshot_filepath, tablet_id, tserver_ip,
+                             snapshot_dir):
+        """
+        Uploads files of the tablet snapshot that are not present in the base backup, and copies
+        the files that are present there with the same check-sum within the storage.
+        SST files are immutable, so unchanged tablets only require copying.
+
+        :param file_pool: thread pool used to handle files of the tablet in parallel.
+        :param snapshot_filepath: Filepath/cloud url where the backup must be stored.
+        :param tablet_id: tablet_id for the tablet whose data we would like to upload.
+        :param tserver_ip: tserver ip from which the data needs to be uploaded.
+        :param snapshot_dir: The snapshot directory on the tserver from which we need to upload.
+        """
+        snapshot_dir = strip_dir(snapshot_dir)
+        snapshot_dir_checksum = checksum_path(snapshot_dir)
+        checksums = parse_checksums(self.run_ssh_cmd(['cat', snapshot_dir_checksum], tserver_ip))
+        base_checksums = parse_checksums(self.run_ssh_cmd(
+            "cat {} 2>/dev/null || true".format(pipes.quote(checksum_path_base(snapshot_dir))),
+            tserver_ip))
+
+        target_tablet_filepath = os.path.join(snapshot_filepath, 'tablet-%s' % (tablet_id))
+        base_tablet_filepath = os.path.join(
+            self.args.base_backup_location, 'tablet-%s' % (tablet_id))
+        file_cmds = []
+        num_copied = 0
+        for file_name in sorted(checksums):
+            target_file = os.path.join(target_tablet_filepath, file_name)
+            if base_checksums.get(file_name) == checksums[file_name]:
+                file_cmds.append(self.storage.copy_file_cmd(
+                    os.path.join(base_tablet_filepath, file_name), target_file))
+                num_copied += 1
+            else:
+                file_cmds.append(self.storage.upload_file_cmd(
+                    os.path.join(snapshot_dir, file_name), target_file))
+        logging.info('Uploading %d and copying %d files of %s from tablet server %s to %s URL %s'
+                     % (len(file_cmds) - num_copied, num_copied, snapshot_dir, tserver_ip,
+                        self.args.storage_type, target_tablet_filepath))
+        file_pool.map(lambda cmd: self.run_ssh_cmd(cmd, tserver_ip), file_cmds)
+
+        # Intents DB is not covered by the check-sum file, so it is always uploaded.
+        intents_dir = os.path.join(snapshot_dir, 'intents')
+        has_intents = self.run_ssh_cmd(
+            "test -d {} && echo yes || true".format(pipes.quote(intents_dir)), tserver_ip)
+        if has_intents.strip() == 'yes':
+            self.run_ssh_cmd(self.storage.upload_dir_cmd(
+                intents_dir + '/', os.path.join(target_tablet_filepath, 'intents') + '/'),
+                tserver_ip)
+
+        # Check-sum file is uploaded last, restore fails if backup of tablet is incomplete.
+        self.run_ssh_cmd(self.storage.upload_file_cmd(
+            snapshot_dir_checksum, checksum_path(target_tablet_filepath)), tserver_ip)
+
     def prepare_download_command(self, parallel_commands, snapshot_filepath, tablet_id,
                                  tserver_ip, snapshot_dir, snapshot_metadata):
         """
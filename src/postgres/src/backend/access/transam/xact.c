@@ -2071,7 +2071,10 @@ CommitTransaction(void)
 	 * It is time to commit YB transaction.
 	 * Postgres transaction can be aborted at this point without an issue
 	 * in case of YBCCommitTransaction failure.
+	 * Invalidation messages that were not sent with catalog writes are sent
+	 * first, the same way as the catalog writes do, before commit.
 	 */
+	YBSendPendingInvalidationMessages();
 	YBCCommitTransaction();
 
 	CallXactCallbacks(is_parallel_worker ? XACT_EVENT_PARALLEL_PRE_COMMIT
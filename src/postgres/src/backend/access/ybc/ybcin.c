@@ -33,8 +33,11 @@
 #include "catalog/index.h"
 #include "catalog/pg_type.h"
 #include "commands/ybccmds.h"
+#include "optimizer/clauses.h"
 #include "utils/rel.h"
+#include "executor/ybcExpr.h"
 #include "executor/ybcModifyTable.h"
+#include "pg_yb_utils.h"
 
 /* --------------------------------------------------------------------------------------------- */
 
@@ -284,6 +287,21 @@ ybcinrescan(IndexScanDesc scan, ScanKey scankey, int nscankeys,	ScanKey orderbys
 																	 nscankeys, scankey);
 	ybScan->index = scan->indexRelation;
 	scan->opaque = ybScan;
+
+	/*
+	 * Index-only scan reads the index table, so the filter, which references index columns, is
+	 * evaluated by YugaByte on index rows before they are sent.
+	 */
+	if (scan->yb_scan_filter != NIL && ybScan->prepare_params.index_only_scan)
+	{
+		YBCPgExpr filter = YBCNewEvalExprCallWithVars(ybScan->handle,
+													  make_ands_explicit(scan->yb_scan_filter),
+													  BOOLOID,
+													  -1 /* typmod */);
+		HandleYBStatusWithOwner(YBCPgDmlBindWhereExpr(ybScan->handle, filter),
+								ybScan->handle,
+								ybScan->stmt_owner);
+	}
 }
 
 /*
@@ -2645,6 +2645,15 @@ CopyFrom(CopyState cstate)
 	errcallback.previous = error_context_stack;
 	error_context_stack = &errcallback;
 
+	/*
+	 * Rows of YB relation without BEFORE ROW triggers are written in bulk
+	 * load mode, which keeps multiple write batches in flight.  Errors of
+	 * the writes are reported at the latest when the bulk load is finished.
+	 */
+	if (useYBMultiInsert)
+		HandleYBStatus(YBCPgStartBulkLoad(YBCGetDatabaseOid(cstate->rel),
+										  RelationGetRelid(cstate->rel)));
+
 	/* Warn if non-txn COPY enabled and relation does not meet non-txn criteria. */
 	if (YBIsNonTxnCopyEnabled() && !useNonTxnInsert)
 		ereport(WARNING,
@@ -2941,6 +2950,10 @@ CopyFrom(CopyState cstate)
 							nBufferedTuples, bufferedTuples,
 							firstBufferedLineNo);
 
+	/* Wait for the writes that are still in flight */
+	if (useYBMultiInsert)
+		HandleYBStatus(YBCPgFinishBulkLoad());
+
 	/* Done, clean up */
 	error_context_stack = errcallback.previous;
 
@@ -750,6 +750,37 @@ nextval_internal(Oid relid, bool check_permissions)
 	cycle = pgsform->seqcycle;
 	ReleaseSysCache(pgstuple);
 
+	/*
+	 * Try to take values from the ones leased by the local tablet server. Cycling and reaching
+	 * the sequence bound are handled below.
+	 */
+	if (IsYugaByteEnabled() && !cycle)
+	{
+		int64_t first_value;
+		int64_t last_value;
+		bool found = false;
+		HandleYBStatus(YBCFetchSequenceRange(MyDatabaseId,
+											 relid,
+											 yb_catalog_cache_version,
+											 incby,
+											 minv,
+											 maxv,
+											 cache,
+											 &first_value,
+											 &last_value,
+											 &found));
+		if (found)
+		{
+			elm->increment = incby;
+			elm->last = first_value;
+			elm->cached = last_value;
+			elm->last_valid = true;
+			last_used_seq = elm;
+			relation_close(seqrel, NoLock);
+			return first_value;
+		}
+	}
+
 retry:
 	rescnt = 0;
 	if (IsYugaByteEnabled())
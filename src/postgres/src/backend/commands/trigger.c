@@ -6059,6 +6059,14 @@ AfterTriggerSaveEvent(EState *estate, ResultRelInfo *relinfo,
 				continue;		/* Uniqueness definitely not violated */
 		}
 
+		/*
+		 * In YugaByte mode, let the check of the referenced row be batched
+		 * with checks of other rows queued by the statement.
+		 */
+		if (IsYBRelation(rel) && row_trigger && newtup != NULL &&
+			RI_FKey_trigger_type(trigger->tgfoid) == RI_TRIGGER_FK)
+			YbAddTriggerFKReferenceIntent(trigger, rel, newtup);
+
 		/*
 		 * Fill in event structure and add it to the current query's queue.
 		 * Note we set ats_table to NULL whenever this trigger doesn't use
@@ -101,6 +101,11 @@ IndexOnlyNext(IndexOnlyScanState *node)
 		node->ioss_ScanDesc->xs_want_itup = true;
 		node->ioss_VMBuffer = InvalidBuffer;
 
+		/* Quals YugaByte evaluates, they are bound to the statement with the scan keys. */
+		if (IsYugaByteEnabled())
+			scandesc->yb_scan_filter =
+				((IndexOnlyScan *) node->ss.ps.plan)->yb_remote_filter;
+
 		/*
 		 * If no run-time keys to calculate or they are ready, go ahead and
 		 * pass the scankeys to the index AM.
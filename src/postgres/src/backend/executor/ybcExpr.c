@@ -33,6 +33,7 @@
 #include "commands/dbcommands.h"
 #include "executor/tuptable.h"
 #include "miscadmin.h"
+#include "optimizer/var.h"
 #include "utils/syscache.h"
 #include "utils/builtins.h"
 
@@ -82,3 +83,39 @@ YBCPgExpr YBCNewEvalExprCall(YBCPgStatement ybc_stmt,
 
 	return ybc_expr;
 }
+
+YBCPgExpr YBCNewEvalExprCallWithVars(YBCPgStatement ybc_stmt,
+                                     Expr *pg_expr,
+                                     int32_t typid,
+                                     int32_t typmod) {
+	YBCPgExpr ybc_expr = YBCNewEvalExprCall(ybc_stmt, pg_expr, InvalidAttrNumber, typid, typmod);
+
+	/*
+	 * Reference every column used by the expression, so DocDB reads it, along with its type id
+	 * and mod, so DocDB can convert its value to the datum expected by the expression.
+	 */
+	List      *vars = pull_var_clause((Node *) pg_expr, 0 /* flags */);
+	Bitmapset *attnos = NULL;
+	ListCell  *lc;
+	foreach(lc, vars)
+	{
+		Var *var = lfirst_node(Var, lc);
+		if (bms_is_member(var->varattno, attnos))
+			continue;
+		attnos = bms_add_member(attnos, var->varattno);
+
+		YBCPgTypeAttrs type_attrs = { var->vartypmod };
+		YBCPgExpr col_expr = YBCNewColumnRef(ybc_stmt, var->varattno, var->vartype, &type_attrs);
+		YBCPgOperatorAppendArg(ybc_expr, col_expr);
+		YBCPgExpr var_typid_expr = YBCNewConstant(ybc_stmt, INT4OID, (Datum) var->vartype,
+		                                          /* IsNull */ false);
+		YBCPgOperatorAppendArg(ybc_expr, var_typid_expr);
+		YBCPgExpr var_typmod_expr = YBCNewConstant(ybc_stmt, INT4OID, (Datum) var->vartypmod,
+		                                           /* IsNull */ false);
+		YBCPgOperatorAppendArg(ybc_expr, var_typmod_expr);
+	}
+	list_free(vars);
+	bms_free(attnos);
+
+	return ybc_expr;
+}
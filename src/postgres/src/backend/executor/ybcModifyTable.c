@@ -288,10 +288,20 @@ static void YBCExecWriteStmt(YBCPgStatement ybc_stmt, Relation rel, int *rows_af
 	bool is_syscatalog_version_change = is_syscatalog_change
 			&& (modifies_row || RelationHasCachedLists(rel));
 
-	/* Let the master know if this should increment the catalog version. */
+	/*
+	 * Let the master know if this should increment the catalog version, and
+	 * pass the invalidation messages registered so far, so that other
+	 * sessions can apply them instead of refreshing their caches completely.
+	 */
 	if (is_syscatalog_version_change)
 	{
+		SharedInvalidationMessage *msgs = NULL;
+		int nmsgs = YBGetPendingInvalidationMessages(&msgs);
+
 		HandleYBStatus(YBCPgSetIsSysCatalogVersionChange(ybc_stmt));
+		if (nmsgs > 0)
+			HandleYBStatus(YBCPgSetCatalogInvalMessages(
+				ybc_stmt, (const char *) msgs, nmsgs * sizeof(SharedInvalidationMessage)));
 	}
 
 	HandleYBStatus(YBCPgSetCatalogCacheVersion(ybc_stmt, yb_catalog_cache_version));
@@ -313,6 +323,7 @@ static void YBCExecWriteStmt(YBCPgStatement ybc_stmt, Relation rel, int *rows_af
 	{
 		// TODO(shane) also update the shared memory catalog version here.
 		yb_catalog_cache_version += 1;
+		YBResetPendingInvalidationMessages();
 	}
 }
 
@@ -721,7 +732,7 @@ bool YBCExecuteUpdate(Relation rel,
 			Expr *expr = copyObject(tle->expr);
 			YBCExprInstantiateParams(expr, estate->es_param_list_info);
 
-			YBCPgExpr ybc_expr = YBCNewEvalExprCall(update_stmt, expr, attnum, type_id, type_mod);
+			YBCPgExpr ybc_expr = YBCNewEvalExprCallWithVars(update_stmt, expr, type_id, type_mod);
 
 			HandleYBStatus(YBCPgDmlAssignColumn(update_stmt, attnum, ybc_expr));
 
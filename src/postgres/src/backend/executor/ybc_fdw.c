@@ -43,6 +43,7 @@
 #include "foreign/foreign.h"
 #include "miscadmin.h"
 #include "nodes/makefuncs.h"
+#include "optimizer/clauses.h"
 #include "optimizer/cost.h"
 #include "optimizer/pathnode.h"
 #include "optimizer/paths.h"
@@ -51,6 +52,7 @@
 #include "optimizer/var.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
+#include "utils/ruleutils.h"
 #include "utils/sampling.h"
 
 /*  YB includes. */
@@ -64,6 +66,7 @@
 #include "pg_yb_utils.h"
 #include "access/ybcam.h"
 #include "executor/ybcExpr.h"
+#include "optimizer/ybcplan.h"
 
 #include "utils/resowner_private.h"
 
@@ -161,9 +164,24 @@ ybcGetForeignPlan(PlannerInfo *root,
 	YbFdwPlanState *yb_plan_state = (YbFdwPlanState *) baserel->fdw_private;
 	Index          scan_relid     = baserel->relid;
 	ListCell       *lc;
+	List           *local_clauses = NIL;
+	List           *remote_clauses = NIL;
 
 	scan_clauses = extract_actual_clauses(scan_clauses, false);
 
+	/*
+	 * Split the quals into the ones YugaByte evaluates to filter rows before
+	 * sending them, and the ones evaluated locally.
+	 */
+	foreach(lc, scan_clauses)
+	{
+		Expr *expr = (Expr *) lfirst(lc);
+		if (yb_enable_expression_pushdown && YBCIsSupportedDocDBScanFilter(expr))
+			remote_clauses = lappend(remote_clauses, expr);
+		else
+			local_clauses = lappend(local_clauses, expr);
+	}
+
 	/* Get the target columns that need to be retrieved from YugaByte */
 	foreach(lc, baserel->reltarget->exprs)
 	{
@@ -174,7 +192,7 @@ ybcGetForeignPlan(PlannerInfo *root,
 		                        baserel->min_attr);
 	}
 
-	foreach(lc, scan_clauses)
+	foreach(lc, local_clauses)
 	{
 		Expr *expr = (Expr *) lfirst(lc);
 		pull_varattnos_min_attr((Node *) expr,
@@ -227,9 +245,9 @@ ybcGetForeignPlan(PlannerInfo *root,
 
 	/* Create the ForeignScan node */
 	return make_foreignscan(tlist,  /* target list */
-	                        scan_clauses,
+	                        local_clauses,
 	                        scan_relid,
-	                        NIL,    /* expressions YB may evaluate (none) */
+	                        remote_clauses,  /* expressions YB may evaluate */
 	                        target_attrs,  /* fdw_private data for YB */
 	                        NIL,    /* custom YB target list (none for now) */
 	                        NIL,    /* custom YB target list (none for now) */
@@ -487,6 +505,19 @@ ybcSetupScanTargets(ForeignScanState *node)
 														   false /* hasoid */);
 		ExecInitScanTupleSlot(estate, &node->ss, target_tupdesc);
 	}
+
+	/* Set the scan filter evaluated by YugaByte, it references the columns it needs. */
+	if (foreignScan->fdw_exprs != NIL)
+	{
+		Expr *filter = make_ands_explicit(foreignScan->fdw_exprs);
+		YBCPgExpr expr = YBCNewEvalExprCallWithVars(ybc_state->handle,
+													filter,
+													BOOLOID,
+													-1 /* typmod */);
+		HandleYBStatusWithOwner(YBCPgDmlBindWhereExpr(ybc_state->handle, expr),
+								ybc_state->handle,
+								ybc_state->stmt_owner);
+	}
 	MemoryContextSwitchTo(oldcontext);
 }
 
@@ -607,6 +638,28 @@ ybcEndForeignScan(ForeignScanState *node)
 	ybcFreeStatementObject(ybc_state);
 }
 
+/*
+ * ybcExplainForeignScan
+ *		Show the scan filter evaluated by YugaByte
+ */
+static void
+ybcExplainForeignScan(ForeignScanState *node, ExplainState *es)
+{
+	ForeignScan *foreignScan = (ForeignScan *) node->ss.ps.plan;
+
+	if (foreignScan->fdw_exprs == NIL)
+		return;
+
+	List *context = set_deparse_context_planstate(es->deparse_cxt,
+												  (Node *) node,
+												  NIL /* ancestors */);
+	char *filter = deparse_expression((Node *) make_ands_explicit(foreignScan->fdw_exprs),
+									  context,
+									  es->verbose /* forceprefix */,
+									  false /* showimplicit */);
+	ExplainPropertyText("Remote Filter", filter, es);
+}
+
 /* ------------------------------------------------------------------------- */
 /*  FDW declaration */
 
@@ -626,9 +679,9 @@ ybc_fdw_handler()
 	fdwroutine->IterateForeignScan = ybcIterateForeignScan;
 	fdwroutine->ReScanForeignScan  = ybcReScanForeignScan;
 	fdwroutine->EndForeignScan     = ybcEndForeignScan;
+	fdwroutine->ExplainForeignScan = ybcExplainForeignScan;
 
 	/* TODO: These are optional but we should support them eventually. */
-	/* fdwroutine->ExplainForeignScan = ybcExplainForeignScan; */
 	/* fdwroutine->AnalyzeForeignTable = ybcAnalyzeForeignTable; */
 	/* fdwroutine->IsForeignScanParallelSafe = ybcIsForeignScanParallelSafe; */
 
@@ -1789,6 +1789,7 @@ _readIndexOnlyScan(void)
 	READ_NODE_FIELD(indexorderby);
 	READ_NODE_FIELD(indextlist);
 	READ_ENUM_FIELD(indexorderdir, ScanDirection);
+	READ_NODE_FIELD(yb_remote_filter);
 
 	READ_DONE();
 }
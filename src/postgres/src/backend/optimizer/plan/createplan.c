@@ -184,7 +184,8 @@ static IndexOnlyScan *make_indexonlyscan(List *qptlist, List *qpqual,
 				   Index scanrelid, Oid indexid,
 				   List *indexqual, List *indexorderby,
 				   List *indextlist,
-				   ScanDirection indexscandir);
+				   ScanDirection indexscandir,
+				   List *yb_remote_filter);
 static BitmapIndexScan *make_bitmap_indexscan(Index scanrelid, Oid indexid,
 					  List *indexqual,
 					  List *indexqualorig);
@@ -2647,7 +2648,7 @@ yb_single_row_update_or_delete_path(PlannerInfo *root,
 
 			/* Verify expression is supported. */
 			bool needs_pushdown = false;
-			if (!YBCIsSupportedSingleRowModifyAssignExpr(tle->expr, tle->resno, &needs_pushdown))
+			if (!YBCIsSupportedSingleRowModifyAssignExpr(tle->expr, &needs_pushdown))
 			{
 				RelationClose(relation);
 				return false;
@@ -2791,7 +2792,11 @@ yb_single_row_update_or_delete_path(PlannerInfo *root,
 		primary_key_attrs = bms_add_member(primary_key_attrs, tle->resno);
 	}
 
-	/* Verify RETURNING columns are either primary key columns or UPDATE's SET columns. */
+	/*
+	 * Verify RETURNING columns are either primary key columns or UPDATE's SET
+	 * columns. Values of SET columns evaluated by DocDB are not known to the
+	 * query layer, so they cannot be returned.
+	 */
 	if (list_length(path->returningLists) > 0)
 	{
 		foreach(values, linitial(path->returningLists))
@@ -2802,6 +2807,8 @@ yb_single_row_update_or_delete_path(PlannerInfo *root,
 			if (!bms_is_member(tle->resorigcol - attr_offset, update_attrs) &&
 				!bms_is_member(tle->resorigcol, primary_key_attrs))
 				return false;
+			if (bms_is_member(tle->resorigcol, pushdown_update_attrs))
+				return false;
 		}
 	}
 
@@ -3112,6 +3119,7 @@ create_indexscan_plan(PlannerInfo *root,
 	List	   *fixed_indexquals;
 	List	   *fixed_indexorderbys;
 	List	   *indexorderbyops = NIL;
+	List	   *yb_remote_filter = NIL;
 	ListCell   *l;
 
 	/* it should be a base rel... */
@@ -3239,6 +3247,28 @@ create_indexscan_plan(PlannerInfo *root,
 		}
 	}
 
+	/*
+	 * YugaByte index-only scans read all the columns they need from the index
+	 * table, so the quals YugaByte can evaluate are checked on index rows
+	 * before they are sent.  Without local quals LIMIT is pushed down too.
+	 */
+	if (indexonly && yb_enable_expression_pushdown &&
+		IsYBRelationById(planner_rt_fetch(baserelid, root)->relid))
+	{
+		List	   *local_qpqual = NIL;
+
+		foreach(l, qpqual)
+		{
+			Expr	   *clause = (Expr *) lfirst(l);
+
+			if (YBCIsSupportedDocDBScanFilter(clause))
+				yb_remote_filter = lappend(yb_remote_filter, clause);
+			else
+				local_qpqual = lappend(local_qpqual, clause);
+		}
+		qpqual = local_qpqual;
+	}
+
 	/* Finally ready to build the plan node */
 	if (indexonly)
 		scan_plan = (Scan *) make_indexonlyscan(tlist,
@@ -3248,7 +3278,8 @@ create_indexscan_plan(PlannerInfo *root,
 												fixed_indexquals,
 												fixed_indexorderbys,
 												best_path->indexinfo->indextlist,
-												best_path->indexscandir);
+												best_path->indexscandir,
+												yb_remote_filter);
 	else
 		scan_plan = (Scan *) make_indexscan(tlist,
 											qpqual,
@@ -5498,7 +5529,8 @@ make_indexonlyscan(List *qptlist,
 				   List *indexqual,
 				   List *indexorderby,
 				   List *indextlist,
-				   ScanDirection indexscandir)
+				   ScanDirection indexscandir,
+				   List *yb_remote_filter)
 {
 	IndexOnlyScan *node = makeNode(IndexOnlyScan);
 	Plan	   *plan = &node->scan.plan;
@@ -5513,6 +5545,7 @@ make_indexonlyscan(List *qptlist,
 	node->indexorderby = indexorderby;
 	node->indextlist = indextlist;
 	node->indexorderdir = indexscandir;
+	node->yb_remote_filter = yb_remote_filter;
 
 	return node;
 }
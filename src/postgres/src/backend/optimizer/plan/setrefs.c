@@ -1035,6 +1035,12 @@ set_indexonlyscan_references(PlannerInfo *root,
 					   index_itlist,
 					   INDEX_VAR,
 					   rtoffset);
+	plan->yb_remote_filter = (List *)
+		fix_upper_expr(root,
+					   (Node *) plan->yb_remote_filter,
+					   index_itlist,
+					   INDEX_VAR,
+					   rtoffset);
 	/* indexqual is already transformed to reference index columns */
 	plan->indexqual = fix_scan_list(root, plan->indexqual, rtoffset);
 	/* indexorderby is already transformed to reference index columns */
@@ -2053,6 +2053,8 @@ finalize_plan(PlannerInfo *root, Plan *plan,
 							  &context);
 			finalize_primnode((Node *) ((IndexOnlyScan *) plan)->indexorderby,
 							  &context);
+			finalize_primnode((Node *) ((IndexOnlyScan *) plan)->yb_remote_filter,
+							  &context);
 
 			/*
 			 * we need not look at indextlist, since it cannot contain Params.
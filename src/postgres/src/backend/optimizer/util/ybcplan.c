@@ -25,14 +25,17 @@
 
 #include "optimizer/ybcplan.h"
 #include "access/htup_details.h"
+#include "catalog/pg_collation.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
 #include "nodes/makefuncs.h"
+#include "nodes/nodeFuncs.h"
 #include "nodes/nodes.h"
 #include "nodes/plannodes.h"
 #include "nodes/print.h"
 #include "nodes/relation.h"
 #include "utils/datum.h"
+#include "utils/pg_locale.h"
 #include "utils/rel.h"
 #include "utils/syscache.h"
 #include "utils/lsyscache.h"
@@ -194,6 +197,25 @@ static void YBCExprInstantiateParamsInternal(Expr* expr,
 			}
 			return;
 		}
+		case T_BoolExpr:
+		{
+			BoolExpr *bool_expr = castNode(BoolExpr, expr);
+			ListCell *lc = NULL;
+			foreach(lc, bool_expr->args)
+			{
+				Expr *arg = (Expr *) lfirst(lc);
+				YBCExprInstantiateParamsInternal(arg,
+				                                 paramLI,
+				                                 (Expr **)&lc->data.ptr_value);
+			}
+			return;
+		}
+		case T_NullTest:
+		{
+			NullTest *null_test = castNode(NullTest, expr);
+			YBCExprInstantiateParamsInternal(null_test->arg, paramLI, &null_test->arg);
+			return;
+		}
 		case T_OpExpr:
 		{
 			OpExpr   *op_expr = castNode(OpExpr, expr);
@@ -258,7 +280,28 @@ static bool YBCIsSupportedDocDBFunctionId(Oid funcid, Form_pg_proc pg_proc) {
 	return true;
 }
 
-static bool YBCAnalyzeExpression(Expr *expr, AttrNumber target_attnum, bool *has_vars, bool *has_docdb_unsupported_funcs) {
+/*
+ * Check if DocDB evaluates functions with the given input collation the same
+ * way as the query layer does. DocDB has no locale setup, so it evaluates
+ * them with the "C" collation.
+ */
+static bool YBCIsSupportedDocDBCollation(Oid collid) {
+	if (!OidIsValid(collid) || collid == C_COLLATION_OID)
+	{
+		return true;
+	}
+
+	return collid == DEFAULT_COLLATION_OID &&
+	       lc_collate_is_c(DEFAULT_COLLATION_OID) &&
+	       lc_ctype_is_c(DEFAULT_COLLATION_OID);
+}
+
+/*
+ * Analyze whether the expression is basic enough to be evaluated by DocDB.
+ * The expression may reference any regular column of a type known to DocDB.
+ * Bind variables are only accepted if allow_params is set.
+ */
+static bool YBCAnalyzeExpression(Expr *expr, bool allow_params, bool *has_vars, bool *has_docdb_unsupported_funcs) {
 	switch (nodeTag(expr))
 	{
 		case T_Const:
@@ -268,13 +311,17 @@ static bool YBCAnalyzeExpression(Expr *expr, AttrNumber target_attnum, bool *has
 			/* References to table attrs (to be read) */
 			Var *var = castNode(Var, expr);
 			*has_vars = true;
-			return var->varattno == target_attnum;
+			return var->varattno > 0 && var->varlevelsup == 0 &&
+			       YBCPgFindTypeEntity(var->vartype) != NULL;
 		}
 		case T_Param:
 		{
-			/* Bind variables. */
+			/*
+			 * Bind variables. Not for scan filters, as values of parameters
+			 * of a generic plan are not guaranteed to be constant.
+			 */
 			Param *param = castNode(Param, expr);
-			return param->paramkind == PARAM_EXTERN;
+			return param->paramkind == PARAM_EXTERN && allow_params;
 		}
 		case T_RelabelType:
 		{
@@ -283,7 +330,28 @@ static bool YBCAnalyzeExpression(Expr *expr, AttrNumber target_attnum, bool *has
 			 * compatible datatypes so we just recurse into its argument.
 			 */
 			RelabelType *rt = castNode(RelabelType, expr);
-			return YBCAnalyzeExpression(rt->arg, target_attnum, has_vars, has_docdb_unsupported_funcs);
+			return YBCAnalyzeExpression(rt->arg, allow_params, has_vars, has_docdb_unsupported_funcs);
+		}
+		case T_BoolExpr:
+		{
+			/* AND, OR, NOT of the supported expressions. */
+			BoolExpr *bool_expr = castNode(BoolExpr, expr);
+			ListCell *lc = NULL;
+			foreach (lc, bool_expr->args) {
+				Expr* arg = (Expr *) lfirst(lc);
+				if (!YBCAnalyzeExpression(arg, allow_params, has_vars, has_docdb_unsupported_funcs)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case T_NullTest:
+		{
+			/* Row types are tested for NULL fieldwise, which is not supported. */
+			NullTest *null_test = castNode(NullTest, expr);
+			if (null_test->argisrow || type_is_rowtype(exprType((Node *) null_test->arg)))
+				return false;
+			return YBCAnalyzeExpression(null_test->arg, allow_params, has_vars, has_docdb_unsupported_funcs);
 		}
 		case T_FuncExpr:
 		case T_OpExpr:
@@ -291,6 +359,7 @@ static bool YBCAnalyzeExpression(Expr *expr, AttrNumber target_attnum, bool *has
 			List         *args = NULL;
 			ListCell     *lc = NULL;
 			Oid          funcid = InvalidOid;
+			Oid          inputcollid = InvalidOid;
 			HeapTuple    tuple = NULL;
 
 			/* Get the function info. */
@@ -299,12 +368,18 @@ static bool YBCAnalyzeExpression(Expr *expr, AttrNumber target_attnum, bool *has
 				FuncExpr *func_expr = castNode(FuncExpr, expr);
 				args = func_expr->args;
 				funcid = func_expr->funcid;
+				inputcollid = func_expr->inputcollid;
 			}
 			else if (IsA(expr, OpExpr))
 			{
 				OpExpr *op_expr = castNode(OpExpr, expr);
 				args = op_expr->args;
 				funcid = op_expr->opfuncid;
+				inputcollid = op_expr->inputcollid;
+			}
+
+			if (!YBCIsSupportedDocDBCollation(inputcollid)) {
+				*has_docdb_unsupported_funcs = true;
 			}
 
 			/*
@@ -330,7 +405,7 @@ static bool YBCAnalyzeExpression(Expr *expr, AttrNumber target_attnum, bool *has
 			/* Checking all arguments are valid (stable). */
 			foreach (lc, args) {
 				Expr* expr = (Expr *) lfirst(lc);
-				if (!YBCAnalyzeExpression(expr, target_attnum, has_vars, has_docdb_unsupported_funcs)) {
+				if (!YBCAnalyzeExpression(expr, allow_params, has_vars, has_docdb_unsupported_funcs)) {
 				    return false;
 				}
 			}
@@ -345,13 +420,14 @@ static bool YBCAnalyzeExpression(Expr *expr, AttrNumber target_attnum, bool *has
 
 /*
  * Can expression be evaluated in DocDB.
- * Eventually any immutable expression whose only variables are column references.
- * Currently, limit to the case where the only referenced column is the target column.
+ * Any immutable expression whose only variables are references to the columns
+ * of the target relation. DocDB evaluates it against the current row, so
+ * the assignment needs no read in the query layer.
  */
-bool YBCIsSupportedSingleRowModifyAssignExpr(Expr *expr, AttrNumber target_attnum, bool *needs_pushdown) {
+bool YBCIsSupportedSingleRowModifyAssignExpr(Expr *expr, bool *needs_pushdown) {
 	bool has_vars = false;
 	bool has_docdb_unsupported_funcs = false;
-	bool is_basic_expr = YBCAnalyzeExpression(expr, target_attnum, &has_vars, &has_docdb_unsupported_funcs);
+	bool is_basic_expr = YBCAnalyzeExpression(expr, true /* allow_params */, &has_vars, &has_docdb_unsupported_funcs);
 
 	/* default, will set to true below if needed. */
 	*needs_pushdown = false;
@@ -377,6 +453,21 @@ bool YBCIsSupportedSingleRowModifyAssignExpr(Expr *expr, AttrNumber target_attnu
 	return false;
 }
 
+/*
+ * Can the scan qual be evaluated by DocDB, so rows it filters out are not sent
+ * to the query layer.
+ * It should be an immutable expression referencing the columns of the scanned
+ * relation and builtin functions only.
+ */
+bool YBCIsSupportedDocDBScanFilter(Expr *expr) {
+	bool has_vars = false;
+	bool has_docdb_unsupported_funcs = false;
+	bool is_basic_expr = YBCAnalyzeExpression(expr, false /* allow_params */, &has_vars, &has_docdb_unsupported_funcs);
+
+	/* Quals without variables are cheap to evaluate by the query layer. */
+	return is_basic_expr && has_vars && !has_docdb_unsupported_funcs;
+}
+
 /*
  * Returns true if the following are all true:
  *  - is insert, update, or delete command.
@@ -430,7 +521,6 @@ static bool ModifyTableIsSingleRowWrite(ModifyTable *modifyTable)
 				TargetEntry *target = (TargetEntry *) lfirst(lc);
 				bool needs_pushdown = false;
 				if (!YBCIsSupportedSingleRowModifyAssignExpr(target->expr,
-				                                             target->resno,
 				                                             &needs_pushdown))
 				{
 					return false;
@@ -3694,28 +3694,53 @@ static void YBRefreshCache()
 				        errmsg("Cannot refresh cache within a transaction")));
 	}
 
-	if (yb_debug_log_catcache_events)
-	{
-		ereport(LOG,(errmsg("Refreshing catalog cache.")));
-	}
-
-	/* Get the latest syscatalog version from the master */
+	/*
+	 * Get the latest syscatalog version from the master, along with the
+	 * invalidation messages of the catalog changes since the caches were last
+	 * refreshed, if the master still has all of them.
+	 */
 	uint64_t catalog_master_version = 0;
-	YBCPgGetCatalogMasterVersion(&catalog_master_version);
+	const char *inval_messages = NULL;
+	size_t inval_messages_size = 0;
+	HandleYBStatus(YBCPgGetCatalogInvalMessages(yb_catalog_inval_version,
+												&catalog_master_version,
+												&inval_messages,
+												&inval_messages_size));
 
 	/* Need to execute some (read) queries internally so start a local txn. */
 	start_xact_command();
 
-	/* Clear and reload system catalog caches, including all callbacks. */
-	ResetCatalogCaches();
-	CallSystemCacheCallbacks();
-	YBPreloadRelCache();
+	if (inval_messages &&
+		YBApplyInvalidationMessages(inval_messages, inval_messages_size))
+	{
+		if (yb_debug_log_catcache_events)
+		{
+			ereport(LOG,
+					(errmsg("Invalidated catalog cache entries of versions "
+							UINT64_FORMAT " to " UINT64_FORMAT ".",
+							(uint64) yb_catalog_inval_version + 1,
+							(uint64) catalog_master_version)));
+		}
+	}
+	else
+	{
+		if (yb_debug_log_catcache_events)
+		{
+			ereport(LOG,(errmsg("Refreshing catalog cache.")));
+		}
 
-	/* Also invalidate the pggate cache. */
-	YBCPgInvalidateCache();
+		/* Clear and reload system catalog caches, including all callbacks. */
+		ResetCatalogCaches();
+		CallSystemCacheCallbacks();
+		YBPreloadRelCache();
+
+		/* Also invalidate the pggate cache. */
+		YBCPgInvalidateCache();
+	}
 
 	/* Set the new ysql cache version. */
 	yb_catalog_cache_version = catalog_master_version;
+	yb_catalog_inval_version = catalog_master_version;
 	yb_need_cache_refresh = false;
 
 	finish_xact_command();
@@ -421,7 +421,12 @@ RI_FKey_check(TriggerData *trigdata)
 			riinfo, new_row, (void **)&tuple_id, &tuple_id_size);
 		RelationClose(idx_rel);
 
-		if (tuple_id != NULL && YBCForeignKeyReferenceExists(ref_table_id, tuple_id, tuple_id_size))
+		bool		exists = false;
+
+		if (tuple_id != NULL)
+			HandleYBStatus(YBCForeignKeyReferenceExists(ref_table_id, tuple_id, tuple_id_size,
+														YBCGetDatabaseOid(pk_rel), &exists));
+		if (exists)
 		{
 			elog(DEBUG1, "Skipping FK check for table %d, ybctid %s", ref_table_id, tuple_id);
 			heap_close(pk_rel, RowShareLock);
@@ -1781,6 +1786,46 @@ RI_FKey_pk_upd_check_required(Trigger *trigger, Relation pk_rel,
 	return false;
 }
 
+/* ----------
+ * YbAddTriggerFKReferenceIntent -
+ *
+ *	Called by the AFTER trigger queue manager, when it queues an RI check
+ *	trigger for a row of YB relation.  Adds the referenced row to the intents,
+ *	so the YB layer could read the referenced rows of all queued checks in
+ *	batches, instead of one read per row.  Only references to the primary key
+ *	are batched.
+ * ----------
+ */
+void
+YbAddTriggerFKReferenceIntent(Trigger *trigger, Relation fk_rel,
+							  HeapTuple new_row)
+{
+	const RI_ConstraintInfo *riinfo;
+	Relation	pk_rel;
+	Relation	idx_rel;
+	char	   *tuple_id = NULL;
+	int64_t		tuple_id_size = 0;
+
+	riinfo = ri_FetchConstraintInfo(trigger, fk_rel, false);
+
+	/* Partially null keys are checked without the referenced row lookup. */
+	if (riinfo->confmatchtype == FKCONSTR_MATCH_PARTIAL ||
+		ri_NullCheck(RelationGetDescr(fk_rel), new_row, riinfo, false) != RI_KEYS_NONE_NULL)
+		return;
+
+	pk_rel = heap_open(riinfo->pk_relid, RowShareLock);
+	idx_rel = RelationIdGetRelation(riinfo->conindid);
+	if (IsYBRelation(pk_rel) && idx_rel->rd_index != NULL && idx_rel->rd_index->indisprimary)
+	{
+		BuildYBTupleId(pk_rel, fk_rel, pk_rel, riinfo, new_row,
+					   (void **)&tuple_id, &tuple_id_size);
+		if (tuple_id != NULL)
+			YBCAddForeignKeyReferenceIntent(RelationGetRelid(pk_rel), tuple_id, tuple_id_size);
+	}
+	RelationClose(idx_rel);
+	heap_close(pk_rel, RowShareLock);
+}
+
 /* ----------
  * RI_FKey_fk_upd_check_required -
  *
@@ -102,6 +102,7 @@
 #include "access/xact.h"
 #include "catalog/catalog.h"
 #include "catalog/pg_constraint.h"
+#include "catalog/pg_database.h"
 #include "miscadmin.h"
 #include "storage/sinval.h"
 #include "storage/smgr.h"
@@ -114,6 +115,9 @@
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
 
+#include "pg_yb_utils.h"
+#include "yb/yql/pggate/ybc_pggate.h"
+
 
 /*
  * To minimize palloc traffic, we keep pending requests in successively-
@@ -176,6 +180,25 @@ static SharedInvalidationMessage *SharedInvalidMessagesArray;
 static int	numSharedInvalidMessagesArray;
 static int	maxSharedInvalidMessagesArray;
 
+/*
+ * In YugaByte mode other backends do not receive our messages through the
+ * shared invalidation queue, so all messages registered by the current
+ * transaction are also collected here.  They are sent to the master with the
+ * next write that increments the catalog version, and other backends apply
+ * them instead of doing a full cache refresh when they see the new version.
+ *
+ * Messages registered for catalog tuples are always followed by such a write
+ * (or the write does not need to be seen by other backends at all).  Other
+ * messages, e.g. from CacheInvalidateRelcache(), set
+ * yb_pending_msgs_need_version_bump, so that the catalog version is
+ * incremented for them at commit if no write did it after them.
+ */
+static SharedInvalidationMessage *yb_pending_msgs = NULL;
+static int	yb_num_pending_msgs = 0;
+static int	yb_max_pending_msgs = 0;
+static bool yb_pending_msgs_need_version_bump = false;
+static bool yb_in_heap_tuple_inval = false;
+
 
 /*
  * Dynamically-registered callback functions.  Current implementation
@@ -332,6 +355,37 @@ AppendInvalidationMessageList(InvalidationChunk **destHdr,
  * ----------------------------------------------------------------
  */
 
+/*
+ * YBAddPendingInvalidationMessage
+ *		Remember message to be sent to other backends through the master.
+ */
+static void
+YBAddPendingInvalidationMessage(const SharedInvalidationMessage *msg)
+{
+	if (!IsYugaByteEnabled())
+		return;
+
+	if (yb_pending_msgs == NULL)
+	{
+		yb_max_pending_msgs = FIRSTCHUNKSIZE;
+		yb_pending_msgs = (SharedInvalidationMessage *)
+			MemoryContextAlloc(TopMemoryContext,
+							   yb_max_pending_msgs *
+							   sizeof(SharedInvalidationMessage));
+	}
+	else if (yb_num_pending_msgs == yb_max_pending_msgs)
+	{
+		yb_max_pending_msgs *= 2;
+		yb_pending_msgs = (SharedInvalidationMessage *)
+			repalloc(yb_pending_msgs,
+					 yb_max_pending_msgs * sizeof(SharedInvalidationMessage));
+	}
+
+	yb_pending_msgs[yb_num_pending_msgs++] = *msg;
+	if (!yb_in_heap_tuple_inval)
+		yb_pending_msgs_need_version_bump = true;
+}
+
 /*
  * Add a catcache inval entry
  */
@@ -357,6 +411,7 @@ AddCatcacheInvalidationMessage(InvalidationListHeader *hdr,
 	 */
 	VALGRIND_MAKE_MEM_DEFINED(&msg, sizeof(msg));
 
+	YBAddPendingInvalidationMessage(&msg);
 	AddInvalidationMessage(&hdr->cclist, &msg);
 }
 
@@ -375,6 +430,7 @@ AddCatalogInvalidationMessage(InvalidationListHeader *hdr,
 	/* check AddCatcacheInvalidationMessage() for an explanation */
 	VALGRIND_MAKE_MEM_DEFINED(&msg, sizeof(msg));
 
+	YBAddPendingInvalidationMessage(&msg);
 	AddInvalidationMessage(&hdr->cclist, &msg);
 }
 
@@ -405,6 +461,7 @@ AddRelcacheInvalidationMessage(InvalidationListHeader *hdr,
 	/* check AddCatcacheInvalidationMessage() for an explanation */
 	VALGRIND_MAKE_MEM_DEFINED(&msg, sizeof(msg));
 
+	YBAddPendingInvalidationMessage(&msg);
 	AddInvalidationMessage(&hdr->rclist, &msg);
 }
 
@@ -431,6 +488,7 @@ AddSnapshotInvalidationMessage(InvalidationListHeader *hdr,
 	/* check AddCatcacheInvalidationMessage() for an explanation */
 	VALGRIND_MAKE_MEM_DEFINED(&msg, sizeof(msg));
 
+	YBAddPendingInvalidationMessage(&msg);
 	AddInvalidationMessage(&hdr->rclist, &msg);
 }
 
@@ -996,6 +1054,8 @@ AtEOXact_Inval(bool isCommit)
 	transInvalInfo = NULL;
 	SharedInvalidMessagesArray = NULL;
 	numSharedInvalidMessagesArray = 0;
+
+	YBResetPendingInvalidationMessages();
 }
 
 /*
@@ -1112,7 +1172,7 @@ CommandEndInvalidationMessages(void)
 
 
 /*
- * CacheInvalidateHeapTuple
+ * CacheInvalidateHeapTupleInternal
  *		Register the given tuple for invalidation at end of command
  *		(ie, current command is creating or outdating this tuple).
  *		Also, detect whether a relcache invalidation is implied.
@@ -1122,10 +1182,10 @@ CommandEndInvalidationMessages(void)
  * version and newtuple the new version.  This allows avoidance of duplicate
  * effort during an update.
  */
-void
-CacheInvalidateHeapTuple(Relation relation,
-						 HeapTuple tuple,
-						 HeapTuple newtuple)
+static void
+CacheInvalidateHeapTupleInternal(Relation relation,
+								 HeapTuple tuple,
+								 HeapTuple newtuple)
 {
 	Oid			tupleRelId;
 	Oid			databaseId;
@@ -1243,6 +1303,25 @@ CacheInvalidateHeapTuple(Relation relation,
 	RegisterRelcacheInvalidation(databaseId, relationId);
 }
 
+/*
+ * CacheInvalidateHeapTuple
+ *		See CacheInvalidateHeapTupleInternal().
+ *
+ * In YugaByte mode messages registered here are sent to other backends with
+ * the write of the tuple, so they don't need a separate catalog version
+ * increment.
+ */
+void
+CacheInvalidateHeapTuple(Relation relation,
+						 HeapTuple tuple,
+						 HeapTuple newtuple)
+{
+	/* On error the flag is reset at the end of transaction. */
+	yb_in_heap_tuple_inval = true;
+	CacheInvalidateHeapTupleInternal(relation, tuple, newtuple);
+	yb_in_heap_tuple_inval = false;
+}
+
 /*
  * CacheInvalidateCatalog
  *		Register invalidation of the whole content of a system catalog.
@@ -1513,3 +1592,99 @@ CallSyscacheCallbacks(int cacheid, uint32 hashvalue)
 		i = ccitem->link - 1;
 	}
 }
+
+/*
+ * YBGetPendingInvalidationMessages
+ *		Returns the number of invalidation messages registered by the current
+ *		transaction since the last reset, and sets *msgs to point to them.
+ */
+int
+YBGetPendingInvalidationMessages(SharedInvalidationMessage **msgs)
+{
+	*msgs = yb_pending_msgs;
+	return yb_num_pending_msgs;
+}
+
+/*
+ * YBResetPendingInvalidationMessages
+ *		Forget invalidation messages after they were sent to the master, or at
+ *		the end of transaction.
+ */
+void
+YBResetPendingInvalidationMessages(void)
+{
+	yb_num_pending_msgs = 0;
+	yb_pending_msgs_need_version_bump = false;
+	yb_in_heap_tuple_inval = false;
+}
+
+/*
+ * YBSendPendingInvalidationMessages
+ *		Called before commit.  Increments the catalog version with the pending
+ *		invalidation messages, if some of them were not registered for catalog
+ *		tuples written after them.
+ */
+void
+YBSendPendingInvalidationMessages(void)
+{
+	uint64_t	version = 0;
+
+	if (!IsYugaByteEnabled() || YBCIsInitDbModeEnvVarSet() ||
+		!yb_pending_msgs_need_version_bump)
+	{
+		YBResetPendingInvalidationMessages();
+		return;
+	}
+
+	HandleYBStatus(YBCPgIncrementCatalogVersion(
+		(const char *) yb_pending_msgs,
+		yb_num_pending_msgs * sizeof(SharedInvalidationMessage),
+		&version));
+
+	/*
+	 * Same as after catalog writes, local caches are up to date with the new
+	 * version only if there was no other increment in the meantime.
+	 */
+	if (version == yb_catalog_cache_version + 1)
+		yb_catalog_cache_version = version;
+
+	YBResetPendingInvalidationMessages();
+}
+
+/*
+ * YBApplyInvalidationMessages
+ *		Process invalidation messages of catalog changes done by other
+ *		backends, as received from the master.
+ *
+ * Returns false if the messages are malformed, so caller should do a full
+ * cache refresh instead.
+ */
+bool
+YBApplyInvalidationMessages(const char *messages, size_t size)
+{
+	SharedInvalidationMessage msg;
+	size_t		offset;
+
+	if (size % sizeof(SharedInvalidationMessage) != 0)
+		return false;
+
+	for (offset = 0; offset < size; offset += sizeof(SharedInvalidationMessage))
+	{
+		memcpy(&msg, messages + offset, sizeof(SharedInvalidationMessage));
+		LocalExecuteInvalidationMessage(&msg);
+
+		/* The pggate cache has table descriptors of relations too. */
+		if (msg.id == SHAREDINVALRELCACHE_ID &&
+			(msg.rc.dbId == MyDatabaseId || msg.rc.dbId == InvalidOid))
+		{
+			if (msg.rc.relId == InvalidOid)
+				HandleYBStatus(YBCPgInvalidateCache());
+			else
+				YBCPgInvalidateTableCache(
+					msg.rc.dbId == InvalidOid ? TemplateDbOid : msg.rc.dbId,
+					msg.rc.relId);
+		}
+	}
+
+	return true;
+}
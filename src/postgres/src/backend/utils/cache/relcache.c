@@ -6505,6 +6505,7 @@ load_relcache_init_file(bool shared)
 		if (yb_catalog_cache_version == YB_CATCACHE_VERSION_UNINITIALIZED)
 		{
 			yb_catalog_cache_version = ybc_stored_cache_version;
+			yb_catalog_inval_version = ybc_stored_cache_version;
 		}
 	}
 
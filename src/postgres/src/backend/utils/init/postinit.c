@@ -1028,6 +1028,7 @@ InitPostgres(const char *in_dbname, Oid dboid, const char *username,
 	if (IsYugaByteEnabled() && !IsBootstrapProcessingMode())
 	{
 		YBCPgGetCatalogMasterVersion(&yb_catalog_cache_version);
+		yb_catalog_inval_version = yb_catalog_cache_version;
 	}
 
 	// See if tablegroup catalog exists - needs to happen before cache fully initialized.
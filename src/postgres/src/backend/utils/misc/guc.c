@@ -1834,6 +1834,16 @@ static struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"yb_enable_expression_pushdown", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Push down the evaluation of supported scan WHERE clauses to DocDB."),
+			NULL
+		},
+		&yb_enable_expression_pushdown,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"yb_debug_report_error_stacktrace", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Append stacktrace information for error messages."),
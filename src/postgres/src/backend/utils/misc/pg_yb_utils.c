@@ -55,6 +55,7 @@
 #include "tcop/utility.h"
 
 uint64_t yb_catalog_cache_version = YB_CATCACHE_VERSION_UNINITIALIZED;
+uint64_t yb_catalog_inval_version = YB_CATCACHE_VERSION_UNINITIALIZED;
 
 /** These values are lazily initialized based on corresponding environment variables. */
 int ybc_pg_double_write = -1;
@@ -667,6 +668,8 @@ YBRaiseNotSupportedSignal(const char *msg, int issue_no, int signal_level)
 	}
 }
 
+bool yb_enable_expression_pushdown = false;
+
 //------------------------------------------------------------------------------
 // YB Debug utils.
 
@@ -22,6 +22,7 @@
 #include "nodes/makefuncs.h"
 #include "utils/numeric.h"
 #include "utils/memutils.h"
+#include "catalog/pg_collation.h"
 #include "catalog/ybctype.h"
 #include "common/int.h"
 #include "nodes/execnodes.h"
@@ -97,6 +98,7 @@ static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
 		case T_OpExpr:
 		{
 			Oid          funcid = InvalidOid;
+			Oid          inputcollid = InvalidOid;
 			List         *args = NULL;
 			ListCell     *lc = NULL;
 
@@ -106,14 +108,23 @@ static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
 				FuncExpr *func_expr = castNode(FuncExpr, expr);
 				args = func_expr->args;
 				funcid = func_expr->funcid;
+				inputcollid = func_expr->inputcollid;
 			}
 			else if (IsA(expr, OpExpr))
 			{
 				OpExpr *op_expr = castNode(OpExpr, expr);
 				args = op_expr->args;
 				funcid = op_expr->opfuncid;
+				inputcollid = op_expr->inputcollid;
 			}
 
+			/*
+			 * DocDB has no locale setup of the database, the planner only
+			 * pushes down the default collation if it is equivalent to "C".
+			 */
+			if (inputcollid == DEFAULT_COLLATION_OID)
+				inputcollid = C_COLLATION_OID;
+
 			FmgrInfo *flinfo = palloc0(sizeof(FmgrInfo));
 			FunctionCallInfoData fcinfo;
 
@@ -121,7 +132,7 @@ static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
 			InitFunctionCallInfoData(fcinfo,
 			                         flinfo,
 			                         args->length,
-			                         InvalidOid,
+			                         inputcollid,
 			                         NULL,
 			                         NULL);
 			int i = 0;
@@ -143,6 +154,48 @@ static Datum evalExpr(YbgExprContext ctx, Expr* expr, bool *is_null)
 			*is_null = fcinfo.isnull;
 			return result;
 		}
+		case T_BoolExpr:
+		{
+			BoolExpr *bool_expr = castNode(BoolExpr, expr);
+			ListCell *lc = NULL;
+			bool      any_null = false;
+
+			if (bool_expr->boolop == NOT_EXPR)
+			{
+				Datum arg = evalExpr(ctx, linitial(bool_expr->args), is_null);
+				return *is_null ? (Datum) 0 : BoolGetDatum(!DatumGetBool(arg));
+			}
+
+			/*
+			 * AND (OR) is false (true) if any argument is false (true),
+			 * otherwise it is NULL if any argument is NULL.
+			 */
+			bool short_circuit = bool_expr->boolop == OR_EXPR;
+			foreach(lc, bool_expr->args)
+			{
+				bool arg_null = false;
+				Datum arg = evalExpr(ctx, (Expr *) lfirst(lc), &arg_null);
+				if (arg_null)
+					any_null = true;
+				else if (DatumGetBool(arg) == short_circuit)
+				{
+					*is_null = false;
+					return BoolGetDatum(short_circuit);
+				}
+			}
+			*is_null = any_null;
+			return BoolGetDatum(!short_circuit);
+		}
+		case T_NullTest:
+		{
+			NullTest *null_test = castNode(NullTest, expr);
+			bool      arg_null = false;
+
+			/* Planner ensures argument is not of a row type. */
+			evalExpr(ctx, null_test->arg, &arg_null);
+			*is_null = false;
+			return BoolGetDatum(null_test->nulltesttype == IS_NULL ? arg_null : !arg_null);
+		}
 		case T_RelabelType:
 		{
 			RelabelType *rt = castNode(RelabelType, expr);
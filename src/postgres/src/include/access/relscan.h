@@ -159,6 +159,12 @@ typedef struct IndexScanDescData
 	 *   index-scan execution in YugaByte.
 	 */
 	YBCPgExecParameters *yb_exec_params;
+
+	/*
+	 * Quals YugaByte evaluates on the index rows of an index-only scan, referencing index columns.
+	 * They are set by the IndexOnlyScan node before the scan keys are passed with rescan.
+	 */
+	List	   *yb_scan_filter;
 }			IndexScanDescData;
 
 /* Generic structure for parallel scans */
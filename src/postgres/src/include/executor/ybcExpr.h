@@ -42,4 +42,8 @@ extern YBCPgExpr YBCNewConstant(YBCPgStatement ybc_stmt, Oid type_id, Datum datu
 // Construct a generic eval_expr call for given a PG Expr and its expected type and attno.
 extern YBCPgExpr YBCNewEvalExprCall(YBCPgStatement ybc_stmt, Expr *expr, int32_t attno, int32_t type_id, int32_t type_mod);
 
+// Construct a generic eval_expr call for given a PG Expr of the expected type, which may reference
+// any regular columns of the table.
+extern YBCPgExpr YBCNewEvalExprCallWithVars(YBCPgStatement ybc_stmt, Expr *expr, int32_t type_id, int32_t type_mod);
+
 #endif							/* YBCEXPR_H */
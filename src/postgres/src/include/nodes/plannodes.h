@@ -440,6 +440,7 @@ typedef struct IndexOnlyScan
 	List	   *indexorderby;	/* list of index ORDER BY exprs */
 	List	   *indextlist;		/* TargetEntry list describing index's cols */
 	ScanDirection indexorderdir;	/* forward or backward or don't care */
+	List	   *yb_remote_filter;	/* quals YugaByte evaluates on index rows */
 } IndexOnlyScan;
 
 /* ----------------
@@ -32,9 +32,9 @@ void YBCExprInstantiateParams(Expr* expr, ParamListInfo paramLI);
 
 bool YBCIsSupportedSingleRowModifyWhereExpr(Expr *expr);
 
-bool YBCIsSupportedSingleRowModifyAssignExpr(Expr *expr,
-                                             AttrNumber target_attno,
-                                             bool *needs_pushdown);
+bool YBCIsSupportedSingleRowModifyAssignExpr(Expr *expr, bool *needs_pushdown);
+
+bool YBCIsSupportedDocDBScanFilter(Expr *expr);
 
 bool YBCIsSingleRowModify(PlannedStmt *pstmt);
 
@@ -55,6 +55,15 @@
  */
 extern uint64_t yb_catalog_cache_version;
 
+/*
+ * Catalog version the caches were last made consistent with by a refresh.
+ * Unlike yb_catalog_cache_version it is not advanced by this backend's own
+ * catalog writes, so a refresh applies the invalidation messages of all
+ * catalog versions after it, also the ones of other backends' writes that
+ * happened in between.
+ */
+extern uint64_t yb_catalog_inval_version;
+
 #define YB_CATCACHE_VERSION_UNINITIALIZED (0)
 
 /*
@@ -270,6 +279,12 @@ Oid YBCGetDatabaseOid(Relation rel);
 void YBRaiseNotSupported(const char *msg, int issue_no);
 void YBRaiseNotSupportedSignal(const char *msg, int issue_no, int signal_level);
 
+/*
+ * Evaluate the scan quals that DocDB supports in DocDB, so rows filtered out by
+ * them are not sent to the query layer.
+ */
+extern bool yb_enable_expression_pushdown;
+
 //------------------------------------------------------------------------------
 // YB Debug utils.
 
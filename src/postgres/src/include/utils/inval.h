@@ -16,6 +16,7 @@
 
 #include "access/htup.h"
 #include "storage/relfilenode.h"
+#include "storage/sinval.h"
 #include "utils/relcache.h"
 
 
@@ -65,4 +66,12 @@ extern void CallSyscacheCallbacks(int cacheid, uint32 hashvalue);
 extern void CallSystemCacheCallbacks(void);
 
 extern void InvalidateSystemCaches(void);
+
+extern int	YBGetPendingInvalidationMessages(SharedInvalidationMessage **msgs);
+
+extern void YBResetPendingInvalidationMessages(void);
+
+extern void YBSendPendingInvalidationMessages(void);
+
+extern bool YBApplyInvalidationMessages(const char *messages, size_t size);
 #endif							/* INVAL_H */
@@ -223,3 +223,22 @@ DROP TABLE tbl;
 -- \d tbl
 -- DROP TABLE tbl;
 --
+
+/*
+ * 10. Index-only scan with quals on INCLUDE columns evaluated by YugaByte.
+ */
+CREATE TABLE tbl (c1 int, c2 int, c3 int, c4 float8);
+INSERT INTO tbl SELECT x, 2*x, 3*x, 4 FROM generate_series(1,10) AS x;
+CREATE INDEX tbl_idx ON tbl (c1 ASC, c2) INCLUDE (c3, c4);
+EXPLAIN (COSTS OFF)
+SELECT c1, c3 FROM tbl WHERE c1 > 2 AND c3 % 2 = 0 ORDER BY c1 LIMIT 2;
+SELECT c1, c3 FROM tbl WHERE c1 > 2 AND c3 % 2 = 0 ORDER BY c1 LIMIT 2;
+SET yb_enable_expression_pushdown = on;
+EXPLAIN (COSTS OFF)
+SELECT c1, c3 FROM tbl WHERE c1 > 2 AND c3 % 2 = 0 ORDER BY c1 LIMIT 2;
+SELECT c1, c3 FROM tbl WHERE c1 > 2 AND c3 % 2 = 0 ORDER BY c1 LIMIT 2;
+-- Volatile quals are still evaluated locally.
+EXPLAIN (COSTS OFF)
+SELECT c4 FROM tbl WHERE c1 > 2 AND c3 % 2 = 0 AND c4 = random();
+RESET yb_enable_expression_pushdown;
+DROP TABLE tbl;
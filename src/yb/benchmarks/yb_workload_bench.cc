@@ -0,0 +1,558 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Reproducible workload benchmark for YSQL and YCQL.
+//
+// Runs a configurable mix of point reads, point writes, range scans, secondary index reads and
+// multi-row distributed transactions against a single table, with uniform or zipfian key
+// distribution, and reports throughput and latency percentiles for each operation type.
+//
+// Keys are generated from --seed, so the same flags produce the same sequence of operations on
+// each thread. Example:
+//   yb_workload_bench --api=ysql --hosts=127.0.0.1 --load --num_keys=1000000
+//   yb_workload_bench --api=ysql --hosts=127.0.0.1 --read_percent=50 --write_percent=30 \
+//       --txn_percent=20 --key_distribution=zipfian --duration_sec=300
+
+#include <math.h>
+
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/optional.hpp>
+
+#include <glog/logging.h>
+
+#include "yb/integration-tests/cql_test_util.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+#include "yb/util/net/net_util.h"
+#include "yb/util/status.h"
+
+#include "yb/yql/pgwrapper/libpq_utils.h"
+
+DEFINE_string(api, "ysql", "API to run the workload against: ysql or ycql.");
+
+DEFINE_string(hosts, "127.0.0.1", "Comma separated list of hosts to connect to.");
+
+DEFINE_int32(ysql_port, 5433, "YSQL port.");
+
+DEFINE_int32(ycql_port, 9042, "YCQL port.");
+
+DEFINE_string(keyspace, "yb_workload_bench", "Database (YSQL) or keyspace (YCQL) to use.");
+
+DEFINE_string(table_name, "workload", "Table name to use.");
+
+DEFINE_bool(load, false, "Create the table and load --num_keys rows before running the workload.");
+
+DEFINE_int64(num_keys, 100000, "Number of keys in the table.");
+
+DEFINE_int32(value_size_bytes, 64, "Size of the value column.");
+
+DEFINE_int32(num_threads, 16, "Number of client threads, each uses its own connection.");
+
+DEFINE_int32(duration_sec, 60, "Duration of the workload, 0 to only load data.");
+
+DEFINE_int32(read_percent, 50, "Percent of point reads in the workload.");
+
+DEFINE_int32(write_percent, 50, "Percent of point writes in the workload.");
+
+DEFINE_int32(scan_percent, 0, "Percent of range scans in the workload.");
+
+DEFINE_int32(index_read_percent, 0, "Percent of reads by the secondary index in the workload.");
+
+DEFINE_int32(txn_percent, 0, "Percent of multi-row distributed transactions in the workload.");
+
+DEFINE_int32(scan_length, 100, "Max number of rows returned by a range scan.");
+
+DEFINE_int32(txn_num_keys, 2, "Number of rows updated by a single distributed transaction.");
+
+DEFINE_string(key_distribution, "uniform", "Distribution of accessed keys: uniform or zipfian.");
+
+DEFINE_double(zipfian_theta, 0.99, "Skew of zipfian distribution, higher means more contention.");
+
+DEFINE_int32(report_interval_sec, 10, "Interval for reporting intermediate throughput.");
+
+DEFINE_uint64(seed, 0, "Seed for the key generators, thread i uses seed + i.");
+
+namespace yb {
+
+namespace {
+
+// Rows with keys in the same range of this size share hash column, so range scans could be
+// served by a single tablet.
+constexpr int64_t kKeysPerHash = 1000;
+
+constexpr int64_t kMaxLatencyUs = 60 * 1000 * 1000;
+
+enum class OpType {
+  kRead,
+  kWrite,
+  kScan,
+  kIndexRead,
+  kTxn,
+};
+
+constexpr size_t kNumOpTypes = static_cast<size_t>(OpType::kTxn) + 1;
+
+const char* const kOpTypeNames[kNumOpTypes] = {
+  "read", "write", "scan", "index_read", "txn",
+};
+
+int64_t HashOf(int64_t key) {
+  return key / kKeysPerHash;
+}
+
+// Generates integers in [0, n) with zipfian distribution, using algorithm from
+// "Quickly Generating Billion-Record Synthetic Databases", Gray et al, SIGMOD 1994.
+// Low numbers are the most popular, so keys are scrambled by the caller.
+class ZipfianGenerator {
+ public:
+  ZipfianGenerator(int64_t n, double theta)
+      : n_(n), theta_(theta), alpha_(1.0 / (1.0 - theta)), zetan_(Zeta(n, theta)),
+        eta_((1.0 - std::pow(2.0 / n, 1.0 - theta)) / (1.0 - Zeta(2, theta) / zetan_)) {}
+
+  template <class Engine>
+  int64_t Next(Engine* engine) const {
+    double u = std::uniform_real_distribution<double>()(*engine);
+    double uz = u * zetan_;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, theta_)) {
+      return 1;
+    }
+    return std::min<int64_t>(n_ - 1, n_ * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+  }
+
+ private:
+  static double Zeta(int64_t n, double theta) {
+    double result = 0;
+    for (int64_t i = 1; i <= n; ++i) {
+      result += 1.0 / std::pow(i, theta);
+    }
+    return result;
+  }
+
+  const int64_t n_;
+  const double theta_;
+  const double alpha_;
+  const double zetan_;
+  const double eta_;
+};
+
+// Queries that are the same for both APIs, except transaction syntax.
+class Session {
+ public:
+  virtual ~Session() = default;
+
+  virtual CHECKED_STATUS Execute(const std::string& query) = 0;
+
+  // Executes query and returns number of fetched rows.
+  virtual Result<int> Fetch(const std::string& query) = 0;
+
+  // Executes statements atomically in a distributed transaction.
+  virtual CHECKED_STATUS ExecuteTransaction(const std::vector<std::string>& statements) = 0;
+};
+
+class YsqlSession : public Session {
+ public:
+  explicit YsqlSession(pgwrapper::PGConn conn) : conn_(std::move(conn)) {}
+
+  CHECKED_STATUS Execute(const std::string& query) override {
+    return conn_.Execute(query);
+  }
+
+  Result<int> Fetch(const std::string& query) override {
+    auto res = VERIFY_RESULT(conn_.Fetch(query));
+    return PQntuples(res.get());
+  }
+
+  CHECKED_STATUS ExecuteTransaction(const std::vector<std::string>& statements) override {
+    RETURN_NOT_OK(conn_.Execute("BEGIN TRANSACTION ISOLATION LEVEL SNAPSHOT"));
+    Status status;
+    for (const auto& statement : statements) {
+      status = conn_.Execute(statement);
+      if (!status.ok()) {
+        break;
+      }
+    }
+    if (status.ok()) {
+      status = conn_.Execute("COMMIT");
+    }
+    if (!status.ok()) {
+      WARN_NOT_OK(conn_.Execute("ROLLBACK"), "Rollback failed");
+    }
+    return status;
+  }
+
+ private:
+  pgwrapper::PGConn conn_;
+};
+
+class YcqlSession : public Session {
+ public:
+  explicit YcqlSession(CassandraSession session) : session_(std::move(session)) {}
+
+  CHECKED_STATUS Execute(const std::string& query) override {
+    return session_.ExecuteQuery(query);
+  }
+
+  Result<int> Fetch(const std::string& query) override {
+    auto result = VERIFY_RESULT(session_.ExecuteWithResult(query));
+    auto iterator = result.CreateIterator();
+    int count = 0;
+    while (iterator.Next()) {
+      ++count;
+    }
+    return count;
+  }
+
+  CHECKED_STATUS ExecuteTransaction(const std::vector<std::string>& statements) override {
+    std::string query = "BEGIN TRANSACTION ";
+    for (const auto& statement : statements) {
+      query += statement;
+      query += "; ";
+    }
+    query += "END TRANSACTION;";
+    return session_.ExecuteQuery(query);
+  }
+
+ private:
+  CassandraSession session_;
+};
+
+class WorkloadBench {
+ public:
+  WorkloadBench() {
+    boost::split(hosts_, FLAGS_hosts, boost::is_any_of(","));
+    percents_[static_cast<size_t>(OpType::kRead)] = FLAGS_read_percent;
+    percents_[static_cast<size_t>(OpType::kWrite)] = FLAGS_write_percent;
+    percents_[static_cast<size_t>(OpType::kScan)] = FLAGS_scan_percent;
+    percents_[static_cast<size_t>(OpType::kIndexRead)] = FLAGS_index_read_percent;
+    percents_[static_cast<size_t>(OpType::kTxn)] = FLAGS_txn_percent;
+    for (auto& histogram : histograms_) {
+      histogram = std::make_unique<HdrHistogram>(kMaxLatencyUs, 3);
+    }
+  }
+
+  CHECKED_STATUS Run() {
+    RETURN_NOT_OK(Validate());
+    if (FLAGS_load) {
+      RETURN_NOT_OK(CreateTable());
+      RETURN_NOT_OK(Load());
+    }
+    if (FLAGS_duration_sec <= 0) {
+      return Status::OK();
+    }
+    return RunWorkload();
+  }
+
+ private:
+  bool IsYsql() const {
+    return FLAGS_api == "ysql";
+  }
+
+  CHECKED_STATUS Validate() {
+    if (FLAGS_api != "ysql" && FLAGS_api != "ycql") {
+      return STATUS_FORMAT(InvalidArgument, "Unknown api: $0", FLAGS_api);
+    }
+    if (FLAGS_key_distribution == "zipfian") {
+      zipfian_.emplace(FLAGS_num_keys, FLAGS_zipfian_theta);
+    } else if (FLAGS_key_distribution != "uniform") {
+      return STATUS_FORMAT(InvalidArgument, "Unknown key distribution: $0",
+                           FLAGS_key_distribution);
+    }
+    int total = 0;
+    for (auto percent : percents_) {
+      if (percent < 0) {
+        return STATUS(InvalidArgument, "Operation percent should not be negative");
+      }
+      total += percent;
+    }
+    if (total != 100) {
+      return STATUS_FORMAT(InvalidArgument, "Operation percents sum up to $0 instead of 100",
+                           total);
+    }
+    if (FLAGS_num_keys <= 0 || FLAGS_num_threads <= 0) {
+      return STATUS(InvalidArgument, "Number of keys and threads should be positive");
+    }
+    return Status::OK();
+  }
+
+  Result<std::unique_ptr<Session>> Connect(size_t idx, bool use_keyspace = true) {
+    const auto& host = hosts_[idx % hosts_.size()];
+    if (IsYsql()) {
+      auto conn = VERIFY_RESULT(pgwrapper::PGConn::Connect(
+          HostPort(host, FLAGS_ysql_port), use_keyspace ? FLAGS_keyspace : ""));
+      return std::unique_ptr<Session>(std::make_unique<YsqlSession>(std::move(conn)));
+    }
+    if (!cql_driver_) {
+      cql_driver_ = std::make_unique<CppCassandraDriver>(
+          hosts_, FLAGS_ycql_port, /* use_partition_aware_routing = */ true);
+    }
+    auto session = std::make_unique<YcqlSession>(VERIFY_RESULT(cql_driver_->CreateSession()));
+    if (use_keyspace) {
+      RETURN_NOT_OK(session->Execute("USE " + FLAGS_keyspace));
+    }
+    return std::unique_ptr<Session>(std::move(session));
+  }
+
+  CHECKED_STATUS CreateTable() {
+    auto session = VERIFY_RESULT(Connect(0, /* use_keyspace = */ false));
+    if (IsYsql()) {
+      auto result = VERIFY_RESULT(session->Fetch(Format(
+          "SELECT 1 FROM pg_database WHERE datname = '$0'", FLAGS_keyspace)));
+      if (result == 0) {
+        RETURN_NOT_OK(session->Execute("CREATE DATABASE " + FLAGS_keyspace));
+      }
+      session = VERIFY_RESULT(Connect(0));
+      RETURN_NOT_OK(session->Execute("DROP TABLE IF EXISTS " + FLAGS_table_name));
+      RETURN_NOT_OK(session->Execute(Format(
+          "CREATE TABLE $0 (h BIGINT, k BIGINT, r BIGINT, v TEXT, PRIMARY KEY (h HASH, k ASC))",
+          FLAGS_table_name)));
+    } else {
+      RETURN_NOT_OK(session->Execute("CREATE KEYSPACE IF NOT EXISTS " + FLAGS_keyspace));
+      RETURN_NOT_OK(session->Execute("USE " + FLAGS_keyspace));
+      RETURN_NOT_OK(session->Execute("DROP TABLE IF EXISTS " + FLAGS_table_name));
+      RETURN_NOT_OK(session->Execute(Format(
+          "CREATE TABLE $0 (h BIGINT, k BIGINT, r BIGINT, v TEXT, PRIMARY KEY ((h), k)) "
+              "WITH transactions = { 'enabled' : true }",
+          FLAGS_table_name)));
+    }
+    return session->Execute(Format(
+        "CREATE INDEX $0_r_idx ON $0 (r)", FLAGS_table_name));
+  }
+
+  CHECKED_STATUS Load() {
+    LOG(INFO) << "Loading " << FLAGS_num_keys << " rows";
+    auto start = MonoTime::Now();
+    std::atomic<int64_t> next_key{0};
+    std::vector<Status> statuses(FLAGS_num_threads);
+    std::vector<std::unique_ptr<Session>> sessions;
+    for (int i = 0; i != FLAGS_num_threads; ++i) {
+      sessions.push_back(VERIFY_RESULT(Connect(i)));
+    }
+    std::vector<std::thread> threads;
+    for (int i = 0; i != FLAGS_num_threads; ++i) {
+      threads.emplace_back([this, i, &next_key, &sessions, &statuses] {
+        std::mt19937_64 engine(FLAGS_seed + i);
+        for (;;) {
+          auto key = next_key.fetch_add(1, std::memory_order_acq_rel);
+          if (key >= FLAGS_num_keys) {
+            break;
+          }
+          auto status = sessions[i]->Execute(WriteQuery(key, &engine));
+          if (!status.ok()) {
+            statuses[i] = status;
+            break;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& status : statuses) {
+      RETURN_NOT_OK(status);
+    }
+    LOG(INFO) << "Loaded " << FLAGS_num_keys << " rows in " << MonoTime::Now() - start;
+    return Status::OK();
+  }
+
+  std::string WriteQuery(int64_t key, std::mt19937_64* engine) {
+    std::string value(FLAGS_value_size_bytes, 'a');
+    for (auto& c : value) {
+      c = 'a' + (*engine)() % 26;
+    }
+    if (IsYsql()) {
+      return Format(
+          "INSERT INTO $0 (h, k, r, v) VALUES ($1, $2, $2, '$3') "
+              "ON CONFLICT (h, k) DO UPDATE SET v = EXCLUDED.v",
+          FLAGS_table_name, HashOf(key), key, value);
+    }
+    return Format("INSERT INTO $0 (h, k, r, v) VALUES ($1, $2, $2, '$3')",
+                  FLAGS_table_name, HashOf(key), key, value);
+  }
+
+  std::string UpdateQuery(int64_t key, int64_t delta) {
+    // YCQL does not support arithmetic on non counter columns, so value is overwritten instead.
+    return Format("UPDATE $0 SET v = '$1' WHERE h = $2 AND k = $3",
+                  FLAGS_table_name, delta, HashOf(key), key);
+  }
+
+  int64_t NextKey(std::mt19937_64* engine) {
+    if (zipfian_) {
+      // Scramble popular keys, so they are spread across tablets.
+      auto rank = static_cast<uint64_t>(zipfian_->Next(engine));
+      return (rank * 0x9E3779B97F4A7C15ULL) % FLAGS_num_keys;
+    }
+    return std::uniform_int_distribution<int64_t>(0, FLAGS_num_keys - 1)(*engine);
+  }
+
+  OpType NextOpType(std::mt19937_64* engine) {
+    int value = std::uniform_int_distribution<int>(0, 99)(*engine);
+    for (size_t i = 0; i != kNumOpTypes; ++i) {
+      if (value < percents_[i]) {
+        return static_cast<OpType>(i);
+      }
+      value -= percents_[i];
+    }
+    return OpType::kRead;
+  }
+
+  CHECKED_STATUS ExecuteOp(OpType type, Session* session, std::mt19937_64* engine) {
+    auto key = NextKey(engine);
+    switch (type) {
+      case OpType::kRead:
+        return ResultToStatus(session->Fetch(Format(
+            "SELECT v FROM $0 WHERE h = $1 AND k = $2", FLAGS_table_name, HashOf(key), key)));
+      case OpType::kWrite:
+        return session->Execute(WriteQuery(key, engine));
+      case OpType::kScan:
+        return ResultToStatus(session->Fetch(Format(
+            "SELECT k, v FROM $0 WHERE h = $1 AND k >= $2 LIMIT $3",
+            FLAGS_table_name, HashOf(key), key, FLAGS_scan_length)));
+      case OpType::kIndexRead:
+        return ResultToStatus(session->Fetch(Format(
+            "SELECT h, k FROM $0 WHERE r = $1", FLAGS_table_name, key)));
+      case OpType::kTxn: {
+        std::vector<std::string> statements;
+        statements.push_back(UpdateQuery(key, (*engine)()));
+        for (int i = 1; i < FLAGS_txn_num_keys; ++i) {
+          statements.push_back(UpdateQuery(NextKey(engine), (*engine)()));
+        }
+        return session->ExecuteTransaction(statements);
+      }
+    }
+    FATAL_INVALID_ENUM_VALUE(OpType, type);
+  }
+
+  CHECKED_STATUS RunWorkload() {
+    std::vector<std::unique_ptr<Session>> sessions;
+    for (int i = 0; i != FLAGS_num_threads; ++i) {
+      sessions.push_back(VERIFY_RESULT(Connect(i)));
+    }
+
+    LOG(INFO) << "Running workload for " << FLAGS_duration_sec << "s";
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i != FLAGS_num_threads; ++i) {
+      threads.emplace_back([this, i, &stop, &sessions] {
+        // Derive a separate seed for workload, so it does not repeat keys used during load.
+        std::mt19937_64 engine(FLAGS_seed + FLAGS_num_threads + i);
+        while (!stop.load(std::memory_order_acquire)) {
+          auto type = NextOpType(&engine);
+          auto start = MonoTime::Now();
+          auto status = ExecuteOp(type, sessions[i].get(), &engine);
+          auto idx = static_cast<size_t>(type);
+          if (status.ok()) {
+            histograms_[idx]->Increment((MonoTime::Now() - start).ToMicroseconds());
+          } else {
+            auto errors = errors_[idx].fetch_add(1, std::memory_order_acq_rel);
+            YB_LOG_EVERY_N_SECS(WARNING, 5)
+                << kOpTypeNames[idx] << " failed: " << status << ", total errors: " << errors + 1;
+          }
+        }
+      });
+    }
+
+    auto start = MonoTime::Now();
+    auto deadline = start + MonoDelta::FromSeconds(FLAGS_duration_sec);
+    auto last_report = start;
+    uint64_t last_count = 0;
+    for (;;) {
+      auto now = MonoTime::Now();
+      if (now >= deadline) {
+        break;
+      }
+      auto next_report = last_report + MonoDelta::FromSeconds(FLAGS_report_interval_sec);
+      SleepFor(std::min(next_report, deadline) - now);
+      now = MonoTime::Now();
+      auto count = TotalOps();
+      LOG(INFO) << Format("Ops/sec: $0, total ops: $1",
+                          (count - last_count) / (now - last_report).ToSeconds(), count);
+      last_report = now;
+      last_count = count;
+    }
+    stop.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    Report(MonoTime::Now() - start);
+    return Status::OK();
+  }
+
+  uint64_t TotalOps() const {
+    uint64_t result = 0;
+    for (const auto& histogram : histograms_) {
+      result += histogram->TotalCount();
+    }
+    return result;
+  }
+
+  void Report(MonoDelta elapsed) const {
+    std::cout << Format("api: $0, threads: $1, keys: $2, distribution: $3, elapsed: $4",
+                        FLAGS_api, FLAGS_num_threads, FLAGS_num_keys, FLAGS_key_distribution,
+                        elapsed) << std::endl;
+    std::cout << Format("$0 $1 $2 $3 $4 $5 $6 $7 $8",
+                        "op", "ops/sec", "errors", "mean_us", "p50_us", "p95_us", "p99_us",
+                        "p99.9_us", "max_us") << std::endl;
+    for (size_t i = 0; i != kNumOpTypes; ++i) {
+      const auto& histogram = *histograms_[i];
+      if (histogram.TotalCount() == 0 && errors_[i].load(std::memory_order_acquire) == 0) {
+        continue;
+      }
+      std::cout << Format("$0 $1 $2 $3 $4 $5 $6 $7 $8",
+                          kOpTypeNames[i], histogram.TotalCount() / elapsed.ToSeconds(),
+                          errors_[i].load(std::memory_order_acquire), histogram.MeanValue(),
+                          histogram.ValueAtPercentile(50), histogram.ValueAtPercentile(95),
+                          histogram.ValueAtPercentile(99), histogram.ValueAtPercentile(99.9),
+                          histogram.MaxValue()) << std::endl;
+    }
+    std::cout << Format("total $0", TotalOps() / elapsed.ToSeconds()) << std::endl;
+  }
+
+  std::vector<std::string> hosts_;
+  int percents_[kNumOpTypes];
+  boost::optional<ZipfianGenerator> zipfian_;
+  std::unique_ptr<CppCassandraDriver> cql_driver_;
+  std::unique_ptr<HdrHistogram> histograms_[kNumOpTypes];
+  std::atomic<uint64_t> errors_[kNumOpTypes] = {};
+};
+
+} // namespace
+
+} // namespace yb
+
+int main(int argc, char** argv) {
+  yb::ParseCommandLineFlags(&argc, &argv, true);
+  yb::InitGoogleLoggingSafe(argv[0]);
+
+  yb::WorkloadBench bench;
+  auto status = bench.Run();
+  if (!status.ok()) {
+    LOG(ERROR) << "Workload failed: " << status;
+    return 1;
+  }
+  return 0;
+}
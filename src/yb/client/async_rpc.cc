@@ -50,6 +50,29 @@ METRIC_DEFINE_histogram(
     server, handler_latency_yb_client_time_to_send,
     "Time taken for a Write/Read rpc to be sent to the server", yb::MetricUnit::kMicroseconds,
     "Microseconds spent before sending the request to the server", 60000000LU, 2);
+METRIC_DEFINE_counter(
+    server, yb_client_hedged_reads, "Number of hedged reads", yb::MetricUnit::kRequests,
+    "Number of reads, that were also sent to another replica, because response was not received "
+    "in time");
+METRIC_DEFINE_counter(
+    server, yb_client_hedged_read_wins, "Number of hedged reads that won",
+    yb::MetricUnit::kRequests,
+    "Number of hedged reads, where response of the other replica was used");
+METRIC_DEFINE_histogram(
+    server, handler_latency_yb_client_sampled_flush_lookup,
+    "Time taken by tablet lookups of sampled session flush", yb::MetricUnit::kMicroseconds,
+    "Microseconds spent from the flush start until all tablets of the flush were looked up",
+    60000000LU, 2);
+METRIC_DEFINE_histogram(
+    server, handler_latency_yb_client_sampled_flush_transaction,
+    "Time taken by transaction preparation of sampled session flush",
+    yb::MetricUnit::kMicroseconds,
+    "Microseconds spent waiting for the transaction to become ready after tablet lookups",
+    60000000LU, 2);
+METRIC_DEFINE_histogram(
+    server, handler_latency_yb_client_sampled_flush, "Time taken by sampled session flush",
+    yb::MetricUnit::kMicroseconds, "Microseconds spent in the sampled session flush", 60000000LU,
+    2);
 DECLARE_bool(rpc_dump_all_traces);
 DECLARE_bool(collect_end_to_end_traces);
 
@@ -102,7 +125,14 @@ AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
       remote_read_rpc_time(METRIC_handler_latency_yb_client_read_remote.Instantiate(entity)),
       local_write_rpc_time(METRIC_handler_latency_yb_client_write_local.Instantiate(entity)),
       local_read_rpc_time(METRIC_handler_latency_yb_client_read_local.Instantiate(entity)),
-      time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)) {
+      time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)),
+      hedged_reads(METRIC_yb_client_hedged_reads.Instantiate(entity)),
+      hedged_read_wins(METRIC_yb_client_hedged_read_wins.Instantiate(entity)),
+      sampled_flush_lookup_time(
+          METRIC_handler_latency_yb_client_sampled_flush_lookup.Instantiate(entity)),
+      sampled_flush_transaction_time(
+          METRIC_handler_latency_yb_client_sampled_flush_transaction.Instantiate(entity)),
+      sampled_flush_time(METRIC_handler_latency_yb_client_sampled_flush.Instantiate(entity)) {
 }
 
 AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
@@ -118,6 +148,7 @@ AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
                       mutable_retrier(),
                       trace_.get()),
       ops_(std::move(data->ops)),
+      coalesced_batches_(std::move(data->coalesced_batches)),
       start_(MonoTime::Now()),
       async_rpc_metrics_(data->batcher->async_rpc_metrics()) {
 
@@ -141,6 +172,31 @@ void AsyncRpc::SendRpc() {
   TRACE_TO(trace_, "SendRpc() called.");
 
   retained_self_ = shared_from_this();
+  if (!ops_.front()->yb_op->read_only()) {
+    // Pace writes to the tablet that advertised write backpressure, but do not wait past the
+    // deadline, so the RPC still times out as usual.
+    const auto send_time = std::min(
+        tablet_invoker_.tablet()->ReserveWriteSlot(), retrier().deadline());
+    const auto now = CoarseMonoClock::now();
+    if (send_time > now) {
+      TRACE_TO(trace_, "Write paced by tablet backpressure");
+      auto self = retained_self_;
+      batcher_->messenger()->scheduler().Schedule(
+          [this, self](const Status& status) {
+            if (!status.ok()) {
+              Finished(status);
+              return;
+            }
+            ExecuteOnTablet();
+          },
+          send_time - now);
+      return;
+    }
+  }
+  ExecuteOnTablet();
+}
+
+void AsyncRpc::ExecuteOnTablet() {
   // For now, if this is a retry, execute this rpc on the leader even if
   // the consistency level is YBConsistencyLevel::CONSISTENT_PREFIX or
   // FLAGS_redis_allow_reads_from_followers is set to true.
@@ -162,6 +218,19 @@ const YBTable* AsyncRpc::table() const {
   return ops_[0]->yb_op->table();
 }
 
+template <class F>
+void AsyncRpc::ForEachBatch(const F& f) {
+  if (coalesced_batches_.empty()) {
+    f(batcher_.get(), ops_, 0);
+    return;
+  }
+  size_t ops_begin = 0;
+  for (const auto& batch : coalesced_batches_) {
+    f(batch.batcher.get(), batch.ops, ops_begin);
+    ops_begin += batch.ops.size();
+  }
+}
+
 void AsyncRpc::Finished(const Status& status) {
   Status new_status = status;
   if (tablet_invoker_.Done(&new_status)) {
@@ -169,8 +238,16 @@ void AsyncRpc::Finished(const Status& status) {
       ops_[0]->yb_op->MarkTablePartitionsAsStale();
     }
     ProcessResponseFromTserver(new_status);
-    batcher_->RemoveInFlightOpsAfterFlushing(ops_, new_status, MakeFlushExtraResult());
-    batcher_->CheckForFinishedFlush();
+    auto flush_extra_result = MakeFlushExtraResult();
+    ForEachBatch([this, &new_status, &flush_extra_result](
+        Batcher* batcher, const InFlightOps& ops, size_t ops_begin) {
+      if (batcher->flush_traced()) {
+        batcher->AddFlushTraceRpc(
+            tablet().tablet_id(), ops.size(), start_, num_attempts(), new_status, ServerTrace());
+      }
+      batcher->RemoveInFlightOpsAfterFlushing(ops, new_status, flush_extra_result);
+      batcher->CheckForFinishedFlush();
+    });
     retained_self_.reset();
   }
 }
@@ -274,7 +351,7 @@ AsyncRpcBase<Req, Resp>::AsyncRpcBase(AsyncRpcData* data,
     : AsyncRpc(data, consistency_level) {
 
   req_.set_tablet_id(tablet_invoker_.tablet()->tablet_id());
-  req_.set_include_trace(IsTracingEnabled());
+  req_.set_include_trace(IsTracingEnabled() || batcher_->flush_traced());
   const ConsistentReadPoint* read_point = batcher_->read_point();
   bool has_read_time = false;
   if (read_point) {
@@ -570,12 +647,18 @@ void WriteRpc::ProcessResponseFromTserver(const Status& status) {
   if (resp_.has_trace_buffer()) {
     TRACE_TO(trace_, "Received from server: $0", resp_.trace_buffer());
   }
-  batcher_->ProcessWriteResponse(*this, status);
+  ForEachBatch([this, &status](Batcher* batcher, const InFlightOps& ops, size_t ops_begin) {
+    batcher->ProcessWriteResponse(*this, ops, ops_begin, status);
+  });
   if (!CommonResponseCheck(status)) {
     SwapRequestsAndResponses(true);
     return;
   }
 
+  if (status.ok()) {
+    tablet_invoker_.tablet()->SetWriteInterval(MonoDelta::FromMicroseconds(
+        resp_.write_interval_us()));
+  }
   SwapRequestsAndResponses(false);
 }
 
@@ -655,12 +738,122 @@ void ReadRpc::CallRemoteMethod() {
   TRACE_TO(trace, "SendRpcToTserver");
   ADOPT_TRACE(trace.get());
 
+  // Only the first attempt is hedged, retries are sent to the leader.
+  if (num_attempts() == 1 && async_rpc_metrics_) {
+    auto hedge_delay = tablet_invoker_.HedgeDelay(async_rpc_metrics_->remote_read_rpc_time.get());
+    if (hedge_delay.Initialized()) {
+      CallRemoteMethodHedged(hedge_delay);
+      TRACE_TO(trace, "RpcDispatched Asynchronously");
+      return;
+    }
+  }
+
   tablet_invoker_.proxy()->ReadAsync(
       req_, &resp_, PrepareController(),
       std::bind(&ReadRpc::Finished, this, Status::OK()));
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
 
+struct ReadRpc::HedgedAttempt {
+  struct Call {
+    rpc::RpcController controller;
+    tserver::ReadResponsePB resp;
+  };
+
+  // The first call is the original request, the second one is the hedge.
+  Call calls[2];
+  rpc::ScheduledTaskId hedge_task_id = rpc::kUninitializedScheduledTaskId;
+
+  // Protects fields below.
+  std::mutex mutex;
+  // Index of the call, which response is used. The request is modified by response processing,
+  // so the hedge is not sent after the winner is determined.
+  int winner = -1;
+  tserver::ReadRequestPB hedge_req;
+  RemoteTabletServer* hedge_ts = nullptr;
+  MonoTime hedge_start;
+};
+
+void ReadRpc::CallRemoteMethodHedged(MonoDelta hedge_delay) {
+  auto attempt = std::make_shared<HedgedAttempt>();
+  const auto* controller = PrepareController();
+  for (auto& call : attempt->calls) {
+    call.controller.set_timeout(controller->timeout());
+  }
+  attempt->calls[0].controller.set_allow_local_calls_in_curr_thread(
+      controller->allow_local_calls_in_curr_thread());
+
+  // Schedule before sending the request, since the RPC could be finished and destroyed as soon
+  // as the request is sent. The task retains the RPC until it is executed or aborted.
+  auto self = retained_self_;
+  attempt->hedge_task_id = batcher_->messenger()->scheduler().Schedule(
+      [this, self, attempt](const Status& status) {
+        if (status.ok()) {
+          SendHedge(attempt);
+        }
+      },
+      hedge_delay.ToSteadyDuration());
+
+  tablet_invoker_.proxy()->ReadAsync(
+      req_, &attempt->calls[0].resp, &attempt->calls[0].controller,
+      [this, attempt] { HedgedCallDone(attempt, 0); });
+}
+
+void ReadRpc::SendHedge(const std::shared_ptr<HedgedAttempt>& attempt) {
+  RemoteTabletServer* ts;
+  {
+    std::lock_guard<std::mutex> lock(attempt->mutex);
+    if (attempt->winner != -1) {
+      return;
+    }
+    ts = tablet_invoker_.SelectHedgeTabletServer();
+    if (!ts) {
+      return;
+    }
+    // Copy the request, since it is modified by response processing, once the original call
+    // wins.
+    attempt->hedge_req = req_;
+    attempt->hedge_ts = ts;
+    attempt->hedge_start = MonoTime::Now();
+  }
+
+  TRACE_TO(trace_, "Sending hedged read to $0", ts->ToString());
+  async_rpc_metrics_->hedged_reads->Increment();
+  ts->RequestStarted();
+  ts->proxy()->ReadAsync(
+      attempt->hedge_req, &attempt->calls[1].resp, &attempt->calls[1].controller,
+      [this, attempt] { HedgedCallDone(attempt, 1); });
+}
+
+void ReadRpc::HedgedCallDone(const std::shared_ptr<HedgedAttempt>& attempt, size_t idx) {
+  auto& call = attempt->calls[idx];
+  {
+    std::lock_guard<std::mutex> lock(attempt->mutex);
+    if (idx == 1) {
+      attempt->hedge_ts->RequestFinished(MonoTime::Now().GetDeltaSince(attempt->hedge_start));
+    }
+    // Only the attempt could be accessed after the winner is determined, because the RPC could
+    // be already destroyed.
+    if (attempt->winner != -1) {
+      return;
+    }
+    // Failed hedge is ignored, errors are handled using response of the original call.
+    if (idx != 0 && (!call.controller.status().ok() || call.resp.has_error())) {
+      return;
+    }
+    attempt->winner = idx;
+  }
+
+  batcher_->messenger()->scheduler().Abort(attempt->hedge_task_id);
+  if (idx != 0) {
+    TRACE_TO(trace_, "Using response of hedged read");
+    async_rpc_metrics_->hedged_read_wins->Increment();
+  }
+  resp_.Swap(&call.resp);
+  mutable_retrier()->mutable_controller()->Swap(&call.controller);
+  Finished(Status::OK());
+}
+
 void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
   size_t redis_idx = 0;
   size_t ql_idx = 0;
@@ -728,7 +921,12 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         if (ql_response.has_rows_data_sidecar()) {
           Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
               ql_response.rows_data_sidecar()));
-          ql_op->mutable_rows_data()->assign(util::to_char_ptr(rows_data.data()), rows_data.size());
+          if (ql_op->reference_rows_data()) {
+            ql_op->SetReferencedRowsData(rows_data, retrier().controller().ResponseHolder());
+          } else {
+            ql_op->mutable_rows_data()->assign(
+                util::to_char_ptr(rows_data.data()), rows_data.size());
+          }
         }
         ql_idx++;
         break;
@@ -745,8 +943,12 @@ void ReadRpc::SwapRequestsAndResponses(bool skip_responses) {
         if (pgsql_response.has_rows_data_sidecar()) {
           Slice rows_data = CHECK_RESULT(retrier().controller().GetSidecar(
               pgsql_response.rows_data_sidecar()));
-          down_cast<YBPgsqlReadOp*>(yb_op)->mutable_rows_data()->assign(
-              util::to_char_ptr(rows_data.data()), rows_data.size());
+          if (pgsql_op->reference_rows_data()) {
+            pgsql_op->SetReferencedRowsData(rows_data, retrier().controller().ResponseHolder());
+          } else {
+            pgsql_op->mutable_rows_data()->assign(
+                util::to_char_ptr(rows_data.data()), rows_data.size());
+          }
         }
         pgsql_idx++;
         break;
@@ -44,6 +44,17 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> local_write_rpc_time;
   scoped_refptr<Histogram> local_read_rpc_time;
   scoped_refptr<Histogram> time_to_send;
+  scoped_refptr<Counter> hedged_reads;
+  scoped_refptr<Counter> hedged_read_wins;
+  scoped_refptr<Histogram> sampled_flush_lookup_time;
+  scoped_refptr<Histogram> sampled_flush_transaction_time;
+  scoped_refptr<Histogram> sampled_flush_time;
+};
+
+// Ops of a batcher, that were sent in the same RPC with ops of other batchers.
+struct CoalescedBatch {
+  scoped_refptr<Batcher> batcher;
+  InFlightOps ops;
 };
 
 struct AsyncRpcData {
@@ -53,6 +64,9 @@ struct AsyncRpcData {
   bool need_consistent_read = false;
   HybridTime write_time_for_backfill_ = HybridTime::kInvalid;
   InFlightOps ops;
+  // Filled only when ops of several batchers were coalesced into a single RPC, in the same order
+  // as in ops. batcher should be the batcher of the first batch in this case.
+  std::vector<CoalescedBatch> coalesced_batches;
 };
 
 struct FlushExtraResult {
@@ -89,6 +103,9 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
 
   void SendRpcToTserver(int attempt_num) override;
 
+  // Sends the RPC to the tablet, on its current leader unless it could be read from a follower.
+  void ExecuteOnTablet();
+
   virtual void CallRemoteMethod() = 0;
 
   // This is the last step where errors and responses are collected from the response and
@@ -98,11 +115,19 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   // See FlushExtraResult for details.
   virtual FlushExtraResult MakeFlushExtraResult() = 0;
 
+  // Trace received from tablet server, if it was requested.
+  virtual std::string ServerTrace() const = 0;
+
   void Failed(const Status& status) override;
 
   // Is this a local call?
   bool IsLocalCall() const;
 
+  // Invokes f(batcher, ops, ops_begin) for each batcher, whose ops were sent by this RPC.
+  // ops_begin is the index of the first op of the batcher in ops_.
+  template <class F>
+  void ForEachBatch(const F& f);
+
   // Pointer back to the batcher. Processes the write response when it
   // completes, regardless of success or failure.
   scoped_refptr<Batcher> batcher_;
@@ -116,6 +141,9 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   // These operations are in kRequestSent state.
   InFlightOps ops_;
 
+  // See AsyncRpcData::coalesced_batches.
+  std::vector<CoalescedBatch> coalesced_batches_;
+
   MonoTime start_;
   std::shared_ptr<AsyncRpcMetrics> async_rpc_metrics_;
   rpc::RpcCommandPtr retained_self_;
@@ -145,6 +173,10 @@ class AsyncRpcBase : public AsyncRpc {
                                        : ReadHybridTime()};
   }
 
+  std::string ServerTrace() const override {
+    return resp_.trace_buffer();
+  }
+
   Req req_;
   Resp resp_;
 };
@@ -169,9 +201,18 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
   virtual ~ReadRpc();
 
  private:
+  struct HedgedAttempt;
+
   void SwapRequestsAndResponses(bool skip_responses);
   void CallRemoteMethod() override;
   void ProcessResponseFromTserver(const Status& status) override;
+
+  // Sends the read to the tablet server selected by tablet invoker, and schedules a duplicate
+  // request to another replica after the specified delay. Both requests have their own response
+  // storage, the response of the first request that succeeds is moved to resp_.
+  void CallRemoteMethodHedged(MonoDelta hedge_delay);
+  void SendHedge(const std::shared_ptr<HedgedAttempt>& attempt);
+  void HedgedCallDone(const std::shared_ptr<HedgedAttempt>& attempt, size_t idx);
 };
 
 }  // namespace internal
@@ -55,6 +55,7 @@
 #include "yb/client/session.h"
 #include "yb/client/table.h"
 #include "yb/client/transaction.h"
+#include "yb/client/write_coalescer.h"
 #include "yb/client/yb_op.h"
 
 #include "yb/common/wire_protocol.h"
@@ -64,6 +65,7 @@
 #include "yb/util/debug-util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/random_util.h"
 
 // When this flag is set to false and we have separate errors for operation, then batcher would
 // report IO Error status. Otherwise we will try to combine errors from separate operation to
@@ -71,6 +73,11 @@
 DEFINE_test_flag(bool, combine_batcher_errors, false,
                  "Whether combine errors into batcher status.");
 
+DEFINE_int32(client_flush_trace_sample_rate, 0,
+             "Collect phase timings and tablet server traces for one of this number of session "
+             "flushes. Collected timings are reported to client metrics and to the flush trace "
+             "callback of the session. 0 disables sampling.");
+
 using std::pair;
 using std::set;
 using std::unique_ptr;
@@ -94,6 +101,54 @@ namespace internal {
 const std::string Batcher::kErrorReachingOutToTServersMsg(
     "Errors occured while reaching out to the tablet servers");
 
+namespace {
+
+// Allocates in-flight ops from the arena of the batcher. Allocator is stored in the control block
+// of the op shared pointer, so the arena is kept alive until the last op referencing it is freed.
+template <class T>
+class SharedArenaAllocator {
+ public:
+  typedef T value_type;
+
+  explicit SharedArenaAllocator(std::shared_ptr<ThreadSafeArena> arena)
+      : arena_(std::move(arena)) {}
+
+  template <class U>
+  SharedArenaAllocator(const SharedArenaAllocator<U>& other) // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    void* result = arena_->AllocateBytesAligned(n * sizeof(T), alignof(T));
+    if (result == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(result);
+  }
+
+  void deallocate(T* p, size_t n) {
+    // Memory is released together with the arena.
+  }
+
+  const std::shared_ptr<ThreadSafeArena>& arena() const {
+    return arena_;
+  }
+
+ private:
+  std::shared_ptr<ThreadSafeArena> arena_;
+};
+
+template <class T, class U>
+bool operator==(const SharedArenaAllocator<T>& lhs, const SharedArenaAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(const SharedArenaAllocator<T>& lhs, const SharedArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+} // namespace
+
 // About lock ordering in this file:
 // ------------------------------
 // The locks must be acquired in the following order:
@@ -116,6 +171,9 @@ Batcher::Batcher(YBClient* client,
   : client_(client),
     weak_session_(session),
     error_collector_(error_collector),
+    arena_(std::make_shared<ThreadSafeArena>()),
+    ops_(0, std::hash<InFlightOpPtr>(), std::equal_to<InFlightOpPtr>(),
+         ThreadSafeArenaAllocator<InFlightOpPtr>(arena_.get())),
     next_op_sequence_number_(0),
     async_rpc_metrics_(session->async_rpc_metrics()),
     transaction_(std::move(transaction)),
@@ -209,6 +267,10 @@ void Batcher::CheckForFinishedFlush() {
     state_ = BatcherState::kComplete;
   }
 
+  if (flush_trace_) {
+    ReportFlushTrace();
+  }
+
   if (session) {
     // Important to do this outside of the lock so that we don't have
     // a lock inversion deadlock -- the session lock should always
@@ -229,6 +291,38 @@ void Batcher::CheckForFinishedFlush() {
   RunCallback(s);
 }
 
+void Batcher::AddFlushTraceRpc(
+    const TabletId& tablet_id, size_t num_ops, MonoTime sent, int num_attempts,
+    const Status& status, std::string server_trace) {
+  auto now = MonoTime::Now();
+  FlushTraceRpc rpc = {
+    .tablet_id = tablet_id,
+    .num_ops = num_ops,
+    .sent = sent.GetDeltaSince(flush_trace_->start),
+    .finished = now.GetDeltaSince(flush_trace_->start),
+    .num_attempts = num_attempts,
+    .status = status,
+    .server_trace = std::move(server_trace),
+  };
+  std::lock_guard<decltype(mutex_)> lock(mutex_);
+  flush_trace_->rpcs.push_back(std::move(rpc));
+}
+
+void Batcher::ReportFlushTrace() {
+  flush_trace_->finished = MonoTime::Now().GetDeltaSince(flush_trace_->start);
+  if (async_rpc_metrics_) {
+    async_rpc_metrics_->sampled_flush_lookup_time->Increment(
+        flush_trace_->lookups_done.ToMicroseconds());
+    async_rpc_metrics_->sampled_flush_transaction_time->Increment(
+        (flush_trace_->transaction_ready - flush_trace_->lookups_done).ToMicroseconds());
+    async_rpc_metrics_->sampled_flush_time->Increment(flush_trace_->finished.ToMicroseconds());
+  }
+  VLOG_WITH_PREFIX(3) << "Flush trace: " << flush_trace_->ToString();
+  if (flush_trace_callback_) {
+    flush_trace_callback_(*flush_trace_);
+  }
+}
+
 void Batcher::RunCallback(const Status& status) {
   auto runnable = std::make_shared<yb::FunctionRunnable>(
       [ cb{std::move(flush_callback_)}, status ]() { cb(status); });
@@ -256,6 +350,11 @@ void Batcher::FlushAsync(StatusFunctor callback) {
     flush_callback_ = std::move(callback);
     deadline_ = ComputeDeadlineUnlocked();
     operations_count = ops_.size();
+    auto sample_rate = FLAGS_client_flush_trace_sample_rate;
+    if (sample_rate > 0 && RandomWithChance(sample_rate)) {
+      flush_trace_ = std::make_unique<FlushTrace>();
+      flush_trace_->start = MonoTime::Now();
+    }
   }
 
   auto transaction = this->transaction();
@@ -280,7 +379,8 @@ void Batcher::FlushAsync(StatusFunctor callback) {
 Status Batcher::Add(shared_ptr<YBOperation> yb_op) {
   // As soon as we get the op, start looking up where it belongs,
   // so that when the user calls Flush, we are ready to go.
-  auto in_flight_op = std::make_shared<InFlightOp>(yb_op);
+  auto in_flight_op = std::allocate_shared<InFlightOp>(
+      SharedArenaAllocator<InFlightOp>(arena_), yb_op);
   RETURN_NOT_OK(yb_op->GetPartitionKey(&in_flight_op->partition_key));
 
   if (VERIFY_RESULT(yb_op->MaybeRefreshTablePartitions())) {
@@ -515,6 +615,9 @@ void Batcher::FlushBuffersIfReady() {
 }
 
 void Batcher::ExecuteOperations(Initial initial) {
+  if (flush_trace_ && initial) {
+    flush_trace_->lookups_done = MonoTime::Now().GetDeltaSince(flush_trace_->start);
+  }
   auto transaction = this->transaction();
   if (transaction) {
     // If this Batcher is executed in context of transaction,
@@ -543,6 +646,10 @@ void Batcher::ExecuteOperations(Initial initial) {
     state_ = BatcherState::kTransactionReady;
   }
 
+  if (flush_trace_) {
+    flush_trace_->transaction_ready = MonoTime::Now().GetDeltaSince(flush_trace_->start);
+  }
+
   // All asynchronous requests were completed, so we could access ops_queue_ w/o holding the lock.
   if (ops_queue_.empty()) {
     return;
@@ -575,6 +682,15 @@ void Batcher::ExecuteOperations(Initial initial) {
     }
   }
 
+  if (start == ops_queue_.begin() && CanCoalesceWrites()) {
+    auto* tablet = start->get()->tablet.get();
+    InFlightOps ops(
+        std::make_move_iterator(ops_queue_.begin()), std::make_move_iterator(ops_queue_.end()));
+    ops_queue_.clear();
+    client_->data_->write_coalescer_->Add(this, tablet, std::move(ops));
+    return;
+  }
+
   // Consistent read is not required when whole batch fits into one command.
   bool need_consistent_read = force_consistent_read || start != ops_queue_.begin();
   rpcs.push_back(CreateRpc(
@@ -590,6 +706,21 @@ void Batcher::ExecuteOperations(Initial initial) {
   }
 }
 
+bool Batcher::CanCoalesceWrites() const {
+  if (!WriteCoalescer::Enabled() || !client_->data_->write_coalescer_ || transaction_ ||
+      force_consistent_read_ || hybrid_time_for_write_.is_valid()) {
+    return false;
+  }
+  for (const auto& op : ops_queue_) {
+    // PostgreSQL writes could specify write time for the whole request.
+    if (op->yb_op->group() != OpGroup::kWrite ||
+        op->yb_op->type() == YBOperation::Type::PGSQL_WRITE) {
+      return false;
+    }
+  }
+  return true;
+}
+
 rpc::Messenger* Batcher::messenger() const {
   return client_->messenger();
 }
@@ -620,7 +751,7 @@ void Batcher::RequestFinished(const TabletId& tablet_id, RetryableRequestId requ
 }
 
 std::shared_ptr<AsyncRpc> Batcher::CreateRpc(
-    RemoteTablet* tablet, InFlightOps::const_iterator begin, InFlightOps::const_iterator end,
+    RemoteTablet* tablet, InFlightOps::iterator begin, InFlightOps::iterator end,
     const bool allow_local_calls_in_curr_thread, const bool need_consistent_read) {
   VLOG_WITH_PREFIX(3) << "FlushBuffersIfReady: already in flushing state, immediately flushing to "
                       << tablet->tablet_id();
@@ -635,8 +766,9 @@ std::shared_ptr<AsyncRpc> Batcher::CreateRpc(
 
   // Split the read operations according to consistency levels since based on consistency
   // levels the read algorithm would differ.
-  InFlightOps ops(begin, end);
   auto op_group = (**begin).yb_op->group();
+  // Ops queue is cleared after creating RPCs, so ops could be moved from it.
+  InFlightOps ops(std::make_move_iterator(begin), std::make_move_iterator(end));
   AsyncRpcData data{this, tablet, allow_local_calls_in_curr_thread, need_consistent_read,
                     hybrid_time_for_write_, std::move(ops)};
   switch (op_group) {
@@ -676,7 +808,7 @@ void Batcher::RemoveInFlightOpsAfterFlushing(
   }
 }
 
-void Batcher::ProcessRpcStatus(const AsyncRpc &rpc, const Status &s) {
+void Batcher::ProcessRpcStatus(const AsyncRpc &rpc, const InFlightOps& ops, const Status &s) {
   // TODO: there is a potential race here -- if the Batcher gets destructed while
   // RPCs are in-flight, then accessing state_ will crash. We probably need to keep
   // track of the in-flight RPCs, and in the destructor, change each of them to an
@@ -690,18 +822,19 @@ void Batcher::ProcessRpcStatus(const AsyncRpc &rpc, const Status &s) {
 
   if (PREDICT_FALSE(!s.ok())) {
     // Mark each of the ops as failed, since the whole RPC failed.
-    for (auto& in_flight_op : rpc.ops()) {
+    for (auto& in_flight_op : ops) {
       CombineErrorUnlocked(in_flight_op, s);
     }
   }
 }
 
 void Batcher::ProcessReadResponse(const ReadRpc &rpc, const Status &s) {
-  ProcessRpcStatus(rpc, s);
+  ProcessRpcStatus(rpc, rpc.ops(), s);
 }
 
-void Batcher::ProcessWriteResponse(const WriteRpc &rpc, const Status &s) {
-  ProcessRpcStatus(rpc, s);
+void Batcher::ProcessWriteResponse(
+    const WriteRpc &rpc, const InFlightOps& ops, size_t ops_begin, const Status &s) {
+  ProcessRpcStatus(rpc, ops, s);
 
   if (s.ok() && rpc.resp().has_propagated_hybrid_time()) {
     client_->data_->UpdateLatestObservedHybridTime(rpc.resp().propagated_hybrid_time());
@@ -720,11 +853,16 @@ void Batcher::ProcessWriteResponse(const WriteRpc &rpc, const Status &s) {
                  << rpc.resp().DebugString();
       continue;
     }
-    shared_ptr<YBOperation> yb_op = rpc.ops()[err_pb.row_index()]->yb_op;
-    VLOG_WITH_PREFIX(1) << "Error on op " << yb_op->ToString() << ": "
+    // Error for op of another batcher, that was coalesced into the same RPC.
+    size_t row_index = err_pb.row_index();
+    if (row_index < ops_begin || row_index >= ops_begin + ops.size()) {
+      continue;
+    }
+    const auto& in_flight_op = ops[row_index - ops_begin];
+    VLOG_WITH_PREFIX(1) << "Error on op " << in_flight_op->yb_op->ToString() << ": "
                         << err_pb.error().ShortDebugString();
     std::lock_guard<decltype(mutex_)> lock(mutex_);
-    CombineErrorUnlocked(rpc.ops()[err_pb.row_index()], StatusFromPB(err_pb.error()));
+    CombineErrorUnlocked(in_flight_op, StatusFromPB(err_pb.error()));
   }
 }
 
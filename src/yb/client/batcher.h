@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "yb/client/async_rpc.h"
+#include "yb/client/flush_trace.h"
 #include "yb/client/transaction.h"
 
 #include "yb/common/consistent_read_point.h"
@@ -51,6 +52,7 @@
 #include "yb/util/debug-util.h"
 #include "yb/util/locks.h"
 #include "yb/util/status.h"
+#include "yb/util/memory/arena.h"
 
 namespace yb {
 
@@ -194,6 +196,21 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   double RejectionScore(int attempt_num);
 
+  void SetFlushTraceCallback(FlushTraceCallback callback) {
+    flush_trace_callback_ = std::move(callback);
+  }
+
+  // Whether phase timings are collected for this flush.
+  bool flush_traced() const {
+    return flush_trace_ != nullptr;
+  }
+
+  // Records timings of RPC sent during traced flush.
+  // Should be invoked before ops of this RPC are removed from the batcher.
+  void AddFlushTraceRpc(
+      const TabletId& tablet_id, size_t num_ops, MonoTime sent, int num_attempts,
+      const Status& status, std::string server_trace);
+
   std::string LogPrefix() const;
 
   // This is a status error string used when there are multiple errors that need to be fetched
@@ -231,22 +248,33 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   void CheckForFinishedFlush();
   void FlushBuffersIfReady();
   std::shared_ptr<AsyncRpc> CreateRpc(
-      RemoteTablet* tablet, InFlightOps::const_iterator begin, InFlightOps::const_iterator end,
+      RemoteTablet* tablet, InFlightOps::iterator begin, InFlightOps::iterator end,
       bool allow_local_calls_in_curr_thread, bool need_consistent_read);
 
+  // Whether queued ops could be passed to the write coalescer of the client, to be sent together
+  // with writes of other batchers to the same tablet. Should be called for ops of single tablet.
+  bool CanCoalesceWrites() const;
+
   // Calls/Schedules flush_callback_ and resets it to free resources.
   void RunCallback(const Status& s);
 
+  // Updates metrics and invokes flush trace callback for the finished traced flush.
+  void ReportFlushTrace();
+
   // Log an error where an Rpc callback has response count mismatch.
   void AddOpCountMismatchError();
 
   // Cleans up an RPC response, scooping out any errors and passing them up
   // to the batcher.
   void ProcessReadResponse(const ReadRpc &rpc, const Status &s);
-  void ProcessWriteResponse(const WriteRpc &rpc, const Status &s);
+
+  // Processes response for ops of this batcher, that start at ops_begin in rpc ops.
+  // The rpc could also contain ops of other batchers, when writes were coalesced.
+  void ProcessWriteResponse(
+      const WriteRpc &rpc, const InFlightOps& ops, size_t ops_begin, const Status &s);
 
   // Process RPC status.
-  void ProcessRpcStatus(const AsyncRpc &rpc, const Status &s);
+  void ProcessRpcStatus(const AsyncRpc &rpc, const InFlightOps& ops, const Status &s);
 
   // Async Callbacks.
   void TabletLookupFinished(InFlightOpPtr op, const Result<internal::RemoteTabletPtr>& result);
@@ -281,9 +309,15 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // will be called exactly once (and the state changed to kFlushed).
   StatusFunctor flush_callback_;
 
+  // Memory for in-flight ops and ops_ of this batch, released when the last op is destroyed.
+  // Ops keep the arena alive through their allocator, since they could outlive the batcher,
+  // for instance when the last reference to the batcher is released by a tablet lookup callback.
+  std::shared_ptr<ThreadSafeArena> arena_;
+
   // All buffered or in-flight ops.
   // Added to this set during apply, removed during Finished of AsyncRpc.
-  std::unordered_set<InFlightOpPtr> ops_;
+  std::unordered_set<InFlightOpPtr, std::hash<InFlightOpPtr>, std::equal_to<InFlightOpPtr>,
+                     ThreadSafeArenaAllocator<InFlightOpPtr>> ops_;
   InFlightOps ops_queue_;
 
   // When each operation is added to the batcher, it is assigned a sequence number
@@ -323,6 +357,11 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   RejectionScoreSourcePtr rejection_score_source_;
 
+  FlushTraceCallback flush_trace_callback_;
+
+  // Phase timings of this flush, set in FlushAsync only when the flush is sampled.
+  std::unique_ptr<FlushTrace> flush_trace_;
+
   DISALLOW_COPY_AND_ASSIGN(Batcher);
 };
 
@@ -274,6 +274,7 @@ YB_CLIENT_SPECIALIZE_SIMPLE(ListNamespaces);
 YB_CLIENT_SPECIALIZE_SIMPLE(GetNamespaceInfo);
 YB_CLIENT_SPECIALIZE_SIMPLE(ReservePgsqlOids);
 YB_CLIENT_SPECIALIZE_SIMPLE(GetYsqlCatalogConfig);
+YB_CLIENT_SPECIALIZE_SIMPLE(IncrementYsqlCatalogVersion);
 YB_CLIENT_SPECIALIZE_SIMPLE(CreateUDType);
 YB_CLIENT_SPECIALIZE_SIMPLE(DeleteUDType);
 YB_CLIENT_SPECIALIZE_SIMPLE(ListUDTypes);
@@ -350,6 +350,7 @@ class YBClient::Data {
   std::unique_ptr<rpc::ProxyCache> proxy_cache_;
   gscoped_ptr<DnsResolver> dns_resolver_;
   scoped_refptr<internal::MetaCache> meta_cache_;
+  std::shared_ptr<internal::WriteCoalescer> write_coalescer_;
   scoped_refptr<MetricEntity> metric_entity_;
 
   // Set of hostnames and IPs on the local host.
@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <thread>
 #include <set>
 #include <vector>
@@ -46,6 +47,7 @@
 #include "yb/client/client-test-util.h"
 #include "yb/client/client_utils.h"
 #include "yb/client/error.h"
+#include "yb/client/flush_trace.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/session.h"
 #include "yb/client/table.h"
@@ -87,6 +89,7 @@
 #include "yb/util/capabilities.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/sockaddr.h"
+#include "yb/util/pb_util.h"
 #include "yb/util/status.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/test_util.h"
@@ -101,7 +104,10 @@ DECLARE_int32(log_inject_latency_ms_mean);
 DECLARE_int32(log_inject_latency_ms_stddev);
 DECLARE_int32(master_inject_latency_on_tablet_lookups_ms);
 DECLARE_int32(max_create_tablets_per_ts);
+DECLARE_int32(meta_cache_prefetch_page_size);
 DECLARE_int32(TEST_scanner_inject_latency_on_each_batch_ms);
+DECLARE_int32(client_flush_trace_sample_rate);
+DECLARE_int32(client_write_coalescing_window_us);
 DECLARE_int32(scanner_max_batch_size_bytes);
 DECLARE_int32(scanner_ttl_ms);
 DECLARE_int32(tablet_server_svc_queue_length);
@@ -1444,6 +1450,211 @@ TEST_F(ClientTest, TestStaleLocations) {
   ASSERT_FALSE(locs_pb.stale());
 }
 
+namespace {
+
+std::set<TabletId> SnapshotTablets(const std::string& path, const TableId& table_id) {
+  master::TabletLocationsSnapshotPB snapshot;
+  CHECK_OK(pb_util::ReadPBContainerFromPath(Env::Default(), path, &snapshot));
+  std::set<TabletId> result;
+  for (const auto& location : snapshot.tablet_locations()) {
+    for (const auto& location_table_id : location.table_ids()) {
+      if (location_table_id == table_id) {
+        result.insert(location.tablet_id());
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_F(ClientTest, PrefetchTableLocations) {
+  constexpr int kNumTablets = 5;
+  // Use small pages, so several requests are required to fetch all tablets.
+  FLAGS_meta_cache_prefetch_page_size = 2;
+
+  TableHandle table;
+  ASSERT_NO_FATALS(CreateTable(YBTableName(YQL_DATABASE_CQL, "prefetch"), kNumTablets, &table));
+
+  // Use new client, so its meta cache is empty.
+  auto client = ASSERT_RESULT(YBClientBuilder()
+      .add_master_server_addr(ToString(cluster_->mini_master()->bound_rpc_addr()))
+      .Build());
+  std::shared_ptr<YBTable> yb_table;
+  ASSERT_OK(client->OpenTable(table->id(), &yb_table));
+
+  Synchronizer sync;
+  client->PrefetchTableLocations(
+      yb_table.get(), CoarseMonoClock::Now() + 15s, sync.AsStatusFunctor());
+  ASSERT_OK(sync.Wait());
+
+  auto path = GetTestPath("meta_cache_snapshot");
+  ASSERT_OK(client->SaveMetaCacheSnapshot(path));
+  auto tablets = SnapshotTablets(path, table->id());
+  ASSERT_EQ(kNumTablets, tablets.size());
+
+  // Locations loaded from the snapshot by another client are present in its meta cache.
+  auto new_client = ASSERT_RESULT(YBClientBuilder()
+      .add_master_server_addr(ToString(cluster_->mini_master()->bound_rpc_addr()))
+      .Build());
+  ASSERT_OK(new_client->LoadMetaCacheSnapshot(path));
+  auto new_path = GetTestPath("new_meta_cache_snapshot");
+  ASSERT_OK(new_client->SaveMetaCacheSnapshot(new_path));
+  ASSERT_EQ(tablets, SnapshotTablets(new_path, table->id()));
+
+  ASSERT_OK(client->PrefetchNamespaceTabletLocations(
+      kKeyspaceName, CoarseMonoClock::Now() + 15s));
+}
+
+// Checks that lookups served from the cache without taking the meta cache lock see changes of
+// the table, its tablets and their leaders.
+TEST_F(ClientTest, MetaCacheLockFreeLookup) {
+  auto* meta_cache = client_->data_->meta_cache_.get();
+  auto* table = client_table_.table().get();
+  const auto deadline = CoarseMonoClock::Now() + 15s;
+
+  GetTableLocationsRequestPB req;
+  GetTableLocationsResponsePB resp;
+  table->name().SetIntoTableIdentifierPB(req.mutable_table());
+  ASSERT_OK(cluster_->mini_master()->master()->catalog_manager()->GetTableLocations(
+      &req, &resp));
+  ASSERT_EQ(resp.tablet_locations_size(), kNumTablets);
+  // Use the last tablet, so its partition start is not empty and its end is empty.
+  const auto& location = resp.tablet_locations(kNumTablets - 1);
+  const auto partition_key = location.partition().partition_key_start();
+  ASSERT_FALSE(partition_key.empty());
+  ASSERT_TRUE(location.partition().partition_key_end().empty());
+
+  // Returns tablet found by lookup and whether the callback was invoked inline, i.e. the lookup
+  // was served from the cache.
+  auto lookup = [meta_cache, table, &partition_key, deadline]()
+      -> Result<std::pair<internal::RemoteTabletPtr, bool>> {
+    std::promise<Result<internal::RemoteTabletPtr>> promise;
+    std::atomic<bool> done{false};
+    meta_cache->LookupTabletByKey(
+        table, partition_key, deadline,
+        [&promise, &done](const Result<internal::RemoteTabletPtr>& result) {
+          done = true;
+          promise.set_value(result);
+        });
+    bool inline_lookup = done.load();
+    auto tablet = VERIFY_RESULT(promise.get_future().get());
+    return std::make_pair(tablet, inline_lookup);
+  };
+
+  // Fill the cache.
+  auto lookup_result = ASSERT_RESULT(lookup());
+  auto tablet = lookup_result.first;
+  ASSERT_EQ(tablet->tablet_id(), location.tablet_id());
+  lookup_result = ASSERT_RESULT(lookup());
+  ASSERT_TRUE(lookup_result.second);
+  ASSERT_EQ(lookup_result.first, tablet);
+
+  // Leader change is visible through the atomic leader without taking the tablet lock.
+  auto* leader = tablet->LeaderTServer();
+  ASSERT_NE(leader, nullptr);
+  tablet->MarkTServerAsFollower(leader);
+  ASSERT_EQ(tablet->LeaderTServer(), nullptr);
+  ASSERT_FALSE(tablet->HasLeader());
+  // A tablet without leader is not served from the cache, lookup refreshes it from master.
+  lookup_result = ASSERT_RESULT(lookup());
+  ASSERT_FALSE(lookup_result.second);
+  ASSERT_EQ(lookup_result.first, tablet);
+  ASSERT_EQ(tablet->LeaderTServer(), leader);
+  tablet->MarkTServerAsFollower(leader);
+  ASSERT_TRUE(tablet->MarkTServerAsLeader(leader));
+  ASSERT_EQ(tablet->LeaderTServer(), leader);
+  ASSERT_TRUE(ASSERT_RESULT(lookup()).second);
+
+  // Stale table is not served from the cache until its locations are fetched again.
+  meta_cache->InvalidateTableCache(table->id());
+  lookup_result = ASSERT_RESULT(lookup());
+  ASSERT_FALSE(lookup_result.second);
+  ASSERT_EQ(lookup_result.first, tablet);
+  lookup_result = ASSERT_RESULT(lookup());
+  ASSERT_TRUE(lookup_result.second);
+  ASSERT_EQ(lookup_result.first, tablet);
+
+  // Split the tablet in the cache: post-split tablets replace it in published tablets.
+  google::protobuf::RepeatedPtrField<master::TabletLocationsPB> children;
+  const auto hash_start = PartitionSchema::DecodeMultiColumnHashValue(partition_key);
+  const auto split_key = PartitionSchema::EncodeMultiColumnHashValue(
+      (static_cast<uint32_t>(hash_start) + 0x10000) / 2);
+  for (int i = 0; i != 2; ++i) {
+    auto& child = *children.Add();
+    child = location;
+    child.set_tablet_id(Format("$0-child-$1", location.tablet_id(), i));
+    child.set_split_depth(location.split_depth() + 1);
+    if (i == 0) {
+      child.mutable_partition()->set_partition_key_end(split_key);
+    } else {
+      child.mutable_partition()->set_partition_key_start(split_key);
+    }
+  }
+  ASSERT_OK(meta_cache->ProcessTabletLocations(children, nullptr, 0));
+  lookup_result = ASSERT_RESULT(lookup());
+  ASSERT_TRUE(lookup_result.second);
+  ASSERT_EQ(lookup_result.first->tablet_id(), children.Get(0).tablet_id());
+  ASSERT_EQ(lookup_result.first->partition().partition_key_end(), split_key);
+  // The parent tablet object is left intact for lookups that already got it.
+  ASSERT_EQ(tablet->tablet_id(), location.tablet_id());
+  ASSERT_FALSE(tablet->stale());
+}
+
+TEST_F(ClientTest, CoalesceWrites) {
+  constexpr int kNumSessions = 100;
+  // Use long window, so all writes to the same tablet are coalesced.
+  FLAGS_client_write_coalescing_window_us = 100000;
+
+  std::vector<YBSessionPtr> sessions;
+  std::vector<std::future<Status>> futures;
+  for (int i = 0; i != kNumSessions; ++i) {
+    auto session = client_->NewSession();
+    session->SetTimeout(10s);
+    ASSERT_OK(session->Apply(BuildTestRow(client_table_, i)));
+    futures.push_back(session->FlushFuture());
+    sessions.push_back(std::move(session));
+  }
+
+  for (auto& future : futures) {
+    ASSERT_OK(future.get());
+  }
+  for (const auto& session : sessions) {
+    ASSERT_EQ(0, session->CountPendingErrors());
+  }
+  ASSERT_EQ(kNumSessions, CountRowsFromClient(client_table_));
+}
+
+TEST_F(ClientTest, FlushTrace) {
+  constexpr int kNumRows = 10;
+  FLAGS_client_flush_trace_sample_rate = 1;
+
+  std::vector<FlushTrace> traces;
+  auto session = client_->NewSession();
+  session->SetTimeout(10s);
+  session->SetFlushTraceCallback([&traces](const FlushTrace& trace) {
+    traces.push_back(trace);
+  });
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(session->Apply(BuildTestRow(client_table_, i)));
+  }
+  ASSERT_OK(session->Flush());
+
+  ASSERT_EQ(traces.size(), 1U);
+  const auto& trace = traces[0];
+  LOG(INFO) << "Flush trace: " << trace.ToString();
+  ASSERT_FALSE(trace.rpcs.empty());
+  size_t num_ops = 0;
+  for (const auto& rpc : trace.rpcs) {
+    ASSERT_OK(rpc.status);
+    ASSERT_LE(trace.transaction_ready, rpc.sent);
+    ASSERT_LE(rpc.sent, rpc.finished);
+    ASSERT_LE(rpc.finished, trace.finished);
+    num_ops += rpc.num_ops;
+  }
+  ASSERT_EQ(num_ops, static_cast<size_t>(kNumRows));
+}
+
 // Test creating and accessing a table which has multiple tablets,
 // each of which is replicated.
 //
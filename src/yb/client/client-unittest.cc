@@ -39,6 +39,7 @@
 
 #include "yb/client/client.h"
 #include "yb/client/client-internal.h"
+#include "yb/client/meta_cache.h"
 
 namespace yb {
 namespace client {
@@ -173,6 +174,28 @@ TEST(ClientUnitTest, TestRetryFunc) {
   ASSERT_LT(counter, 20);
 }
 
+TEST(ClientUnitTest, TestTabletServerLoadScore) {
+  internal::RemoteTabletServer fast("fast", nullptr);
+  internal::RemoteTabletServer slow("slow", nullptr);
+  for (int i = 0; i != 10; ++i) {
+    fast.RequestStarted();
+    fast.RequestFinished(MonoDelta::FromMilliseconds(1));
+    slow.RequestStarted();
+    slow.RequestFinished(MonoDelta::FromMilliseconds(10));
+  }
+  ASSERT_LT(fast.LoadScore(), slow.LoadScore());
+
+  // Outstanding requests increase the score of the server.
+  for (int i = 0; i != 20; ++i) {
+    fast.RequestStarted();
+  }
+  ASSERT_GT(fast.LoadScore(), slow.LoadScore());
+  for (int i = 0; i != 20; ++i) {
+    fast.RequestFinished(MonoDelta::FromMilliseconds(1));
+  }
+  ASSERT_LT(fast.LoadScore(), slow.LoadScore());
+}
+
 } // namespace client
 } // namespace yb
 
@@ -50,6 +50,7 @@
 #include "yb/client/namespace_alterer.h"
 #include "yb/client/table_creator.h"
 #include "yb/client/tablet_server.h"
+#include "yb/client/write_coalescer.h"
 
 #include "yb/common/common.pb.h"
 #include "yb/common/entity_ids.h"
@@ -73,6 +74,7 @@
 #include "yb/util/oid_generator.h"
 #include "yb/util/tsan_util.h"
 #include "yb/util/crypt.h"
+#include "yb/util/env.h"
 
 using yb::master::AlterTableRequestPB;
 using yb::master::AlterTableRequestPB_Step;
@@ -117,6 +119,8 @@ using yb::master::ReservePgsqlOidsRequestPB;
 using yb::master::ReservePgsqlOidsResponsePB;
 using yb::master::GetYsqlCatalogConfigRequestPB;
 using yb::master::GetYsqlCatalogConfigResponsePB;
+using yb::master::IncrementYsqlCatalogVersionRequestPB;
+using yb::master::IncrementYsqlCatalogVersionResponsePB;
 using yb::master::CreateUDTypeRequestPB;
 using yb::master::CreateUDTypeResponsePB;
 using yb::master::AlterRoleRequestPB;
@@ -368,6 +372,8 @@ Status YBClientBuilder::DoBuild(rpc::Messenger* messenger, std::unique_ptr<YBCli
     c->data_->messenger_ = c->data_->messenger_holder_.get();
   }
   c->data_->proxy_cache_ = std::make_unique<rpc::ProxyCache>(c->data_->messenger_);
+  c->data_->write_coalescer_ = std::make_shared<internal::WriteCoalescer>(
+      &c->data_->messenger_->scheduler());
   c->data_->metric_entity_ = data_->metric_entity_;
 
   c->data_->master_address_flag_name_ = data_->master_address_flag_name_;
@@ -432,6 +438,9 @@ YBClient::~YBClient() {
 
 void YBClient::Shutdown() {
   data_->StartShutdown();
+  if (data_->write_coalescer_) {
+    data_->write_coalescer_->Shutdown();
+  }
   if (data_->messenger_holder_) {
     data_->messenger_holder_->Shutdown();
   }
@@ -814,6 +823,32 @@ Status YBClient::GetYsqlCatalogMasterVersion(uint64_t *ysql_catalog_version) {
   return Status::OK();
 }
 
+Status YBClient::GetYsqlCatalogInvalMessages(uint64_t from_version,
+                                             uint64_t *ysql_catalog_version,
+                                             boost::optional<std::string>* inval_messages) {
+  GetYsqlCatalogConfigRequestPB req;
+  GetYsqlCatalogConfigResponsePB resp;
+  req.set_inval_messages_from_version(from_version);
+  CALL_SYNC_LEADER_MASTER_RPC(req, resp, GetYsqlCatalogConfig);
+  *ysql_catalog_version = resp.version();
+  if (resp.has_inval_messages()) {
+    *inval_messages = std::move(*resp.mutable_inval_messages());
+  } else {
+    *inval_messages = boost::none;
+  }
+  return Status::OK();
+}
+
+Status YBClient::IncrementYsqlCatalogVersion(const std::string& inval_messages,
+                                             uint64_t *ysql_catalog_version) {
+  IncrementYsqlCatalogVersionRequestPB req;
+  IncrementYsqlCatalogVersionResponsePB resp;
+  req.set_inval_messages(inval_messages);
+  CALL_SYNC_LEADER_MASTER_RPC(req, resp, IncrementYsqlCatalogVersion);
+  *ysql_catalog_version = resp.version();
+  return Status::OK();
+}
+
 Status YBClient::GrantRevokePermission(GrantRevokeStatementType statement_type,
                                        const PermissionType& permission,
                                        const ResourceType& resource_type,
@@ -1437,6 +1472,50 @@ void YBClient::LookupTabletById(const std::string& tablet_id,
       tablet_id, deadline, std::move(callback), use_cache);
 }
 
+void YBClient::PrefetchTableLocations(const YBTable* table,
+                                      CoarseTimePoint deadline,
+                                      StatusFunctor callback) {
+  data_->meta_cache_->PrefetchTableLocations(table, deadline, std::move(callback));
+}
+
+Status YBClient::PrefetchNamespaceTabletLocations(const NamespaceName& namespace_name,
+                                                  CoarseTimePoint deadline) {
+  std::vector<std::shared_ptr<YBTable>> tables;
+  for (const auto& table_name : VERIFY_RESULT(ListTables())) {
+    if (table_name.namespace_name() != namespace_name) {
+      continue;
+    }
+    std::shared_ptr<YBTable> table;
+    RETURN_NOT_OK(OpenTable(table_name.table_id(), &table));
+    tables.push_back(std::move(table));
+  }
+
+  std::vector<std::future<Status>> futures;
+  futures.reserve(tables.size());
+  for (const auto& table : tables) {
+    futures.push_back(MakeFuture<Status>([this, &table, deadline](auto callback) {
+      this->PrefetchTableLocations(table.get(), deadline, std::move(callback));
+    }));
+  }
+
+  Status result;
+  for (auto& future : futures) {
+    auto status = future.get();
+    if (result.ok()) {
+      result = status;
+    }
+  }
+  return result;
+}
+
+Status YBClient::SaveMetaCacheSnapshot(const std::string& path) {
+  return data_->meta_cache_->SaveSnapshot(Env::Default(), path);
+}
+
+Status YBClient::LoadMetaCacheSnapshot(const std::string& path) {
+  return data_->meta_cache_->LoadSnapshot(Env::Default(), path);
+}
+
 HostPort YBClient::GetMasterLeaderAddress() {
   return data_->leader_master_hostport();
 }
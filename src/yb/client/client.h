@@ -394,6 +394,16 @@ class YBClient {
 
   CHECKED_STATUS GetYsqlCatalogMasterVersion(uint64_t *ysql_catalog_version);
 
+  // Same as above, but also fetches concatenated invalidation messages of catalog versions after
+  // from_version. inval_messages is not set when master does not have messages of all of them.
+  CHECKED_STATUS GetYsqlCatalogInvalMessages(uint64_t from_version,
+                                             uint64_t *ysql_catalog_version,
+                                             boost::optional<std::string>* inval_messages);
+
+  // For Postgres: increment catalog version, recording inval_messages along with the new version.
+  CHECKED_STATUS IncrementYsqlCatalogVersion(const std::string& inval_messages,
+                                             uint64_t *ysql_catalog_version);
+
   // Grant permission with given arguments.
   CHECKED_STATUS GrantRevokePermission(GrantRevokeStatementType statement_type,
                                        const PermissionType& permission,
@@ -666,6 +676,22 @@ class YBClient {
                         LookupTabletCallback callback,
                         UseCache use_cache);
 
+  // Fetches locations of all tablets of the table into the meta cache, using paginated
+  // GetTableLocations requests instead of looking up partitions one by one.
+  void PrefetchTableLocations(const YBTable* table,
+                              CoarseTimePoint deadline,
+                              StatusFunctor callback);
+
+  // Fetches locations of all tablets of all tables in the namespace into the meta cache.
+  CHECKED_STATUS PrefetchNamespaceTabletLocations(const NamespaceName& namespace_name,
+                                                  CoarseTimePoint deadline);
+
+  // Saves tablet locations cached by this client to the file at path.
+  CHECKED_STATUS SaveMetaCacheSnapshot(const std::string& path);
+
+  // Loads tablet locations saved by SaveMetaCacheSnapshot to the meta cache of this client.
+  CHECKED_STATUS LoadMetaCacheSnapshot(const std::string& path);
+
   rpc::Messenger* messenger() const;
 
   const scoped_refptr<MetricEntity>& metric_entity() const;
@@ -78,9 +78,11 @@ class YBTableCreator;
 class YBTableName;
 class YBTabletServer;
 
+struct FlushTrace;
 struct YBTableInfo;
 
 typedef std::function<void(std::vector<const TabletId*>*)> LocalTabletFilter;
+typedef std::function<void(const FlushTrace&)> FlushTraceCallback;
 
 YB_STRONGLY_TYPED_BOOL(ForceConsistentRead);
 YB_STRONGLY_TYPED_BOOL(Initial);
@@ -100,6 +102,7 @@ class RemoteTablet;
 typedef scoped_refptr<RemoteTablet> RemoteTabletPtr;
 
 class RemoteTabletServer;
+class WriteCoalescer;
 
 class Batcher;
 typedef scoped_refptr<Batcher> BatcherPtr;
@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CLIENT_FLUSH_TRACE_H
+#define YB_CLIENT_FLUSH_TRACE_H
+
+#include <string>
+#include <vector>
+
+#include "yb/common/entity_ids.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+#include "yb/util/tostring.h"
+
+namespace yb {
+namespace client {
+
+// Timings of a single RPC sent during sampled flush. Times are relative to the flush start.
+struct FlushTraceRpc {
+  TabletId tablet_id;
+  size_t num_ops = 0;
+  // Time when RPC was sent to tablet server for the first time.
+  MonoDelta sent;
+  // Time when response was received.
+  MonoDelta finished;
+  int num_attempts = 0;
+  Status status;
+  // Trace collected by tablet server while processing this request.
+  std::string server_trace;
+
+  std::string ToString() const {
+    return YB_STRUCT_TO_STRING(tablet_id, num_ops, sent, finished, num_attempts, status);
+  }
+};
+
+// Timings of session flush phases, collected for sampled flushes.
+// Times are relative to the flush start.
+struct FlushTrace {
+  MonoTime start;
+  // Time when all tablet lookups were finished.
+  MonoDelta lookups_done;
+  // Time when transaction became ready to send operations, equals to lookups_done for
+  // non transactional flush.
+  MonoDelta transaction_ready;
+  // Time when the whole flush was finished.
+  MonoDelta finished;
+  std::vector<FlushTraceRpc> rpcs;
+
+  std::string ToString() const {
+    return YB_STRUCT_TO_STRING(lookups_done, transaction_ready, finished, rpcs);
+  }
+};
+
+} // namespace client
+} // namespace yb
+
+#endif // YB_CLIENT_FLUSH_TRACE_H
@@ -59,6 +59,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/net/dns_resolver.h"
 #include "yb/util/net/net_util.h"
+#include "yb/util/pb_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/shared_lock.h"
 
@@ -71,6 +72,10 @@ using namespace std::literals;  // NOLINT
 DEFINE_int32(max_concurrent_master_lookups, 500,
              "Maximum number of concurrent tablet location lookups from YB client to master");
 
+DEFINE_int32(meta_cache_prefetch_page_size, 1000,
+             "Max number of tablet locations requested from master by a single RPC when "
+             "prefetching locations of all tablets of a table.");
+
 DEFINE_test_flag(bool, verify_all_replicas_alive, false,
                  "If set, when a RemoteTablet object is destroyed, we will verify that all its "
                  "replicas are not marked as failed");
@@ -249,6 +254,40 @@ bool RemoteTabletServer::HasCapability(CapabilityId capability) const {
   return std::binary_search(capabilities_.begin(), capabilities_.end(), capability);
 }
 
+void RemoteTabletServer::ToPB(TSInfoPB* pb) const {
+  pb->set_permanent_uuid(uuid_);
+  SharedLock<rw_spinlock> lock(mutex_);
+  *pb->mutable_private_rpc_addresses() = private_rpc_hostports_;
+  *pb->mutable_broadcast_addresses() = public_rpc_hostports_;
+  *pb->mutable_cloud_info() = cloud_info_pb_;
+  for (auto capability : capabilities_) {
+    pb->add_capabilities(capability);
+  }
+}
+
+void RemoteTabletServer::RequestStarted() {
+  outstanding_requests_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RemoteTabletServer::RequestFinished(MonoDelta latency) {
+  // Weight of a new sample in the moving average is 1 / kLatencyEwmaFactor.
+  constexpr int64_t kLatencyEwmaFactor = 8;
+
+  outstanding_requests_.fetch_sub(1, std::memory_order_relaxed);
+  const auto sample = std::max<int64_t>(latency.ToMicroseconds(), 1);
+  auto old_value = latency_ewma_us_.load(std::memory_order_relaxed);
+  int64_t new_value;
+  do {
+    new_value = old_value ? old_value + (sample - old_value) / kLatencyEwmaFactor : sample;
+  } while (!latency_ewma_us_.compare_exchange_weak(
+      old_value, new_value, std::memory_order_relaxed));
+}
+
+int64_t RemoteTabletServer::LoadScore() const {
+  return (latency_ewma_us_.load(std::memory_order_relaxed) + 1) *
+         (std::max<int64_t>(outstanding_requests_.load(std::memory_order_relaxed), 0) + 1);
+}
+
 ////////////////////////////////////////////////////////////
 
 RemoteTablet::~RemoteTablet() {
@@ -276,28 +315,57 @@ void RemoteTablet::Refresh(
     CHECK(it != tservers.end());
     replicas_.emplace_back(it->second.get(), r.role());
   }
-  stale_ = false;
+  UpdateLeaderUnlocked();
+  stale_.store(false, std::memory_order_release);
   refresh_time_.store(MonoTime::Now(), std::memory_order_release);
 }
 
+void RemoteTablet::ToPB(TabletLocationsPB* pb) const {
+  pb->set_tablet_id(tablet_id_);
+  partition_.ToPB(pb->mutable_partition());
+  pb->set_split_depth(split_depth_);
+  pb->set_stale(false);
+  SharedLock<rw_spinlock> lock(mutex_);
+  for (const auto& replica : replicas_) {
+    auto* replica_pb = pb->add_replicas();
+    replica.ts->ToPB(replica_pb->mutable_ts_info());
+    replica_pb->set_role(replica.role);
+  }
+}
+
 void RemoteTablet::MarkStale() {
-  std::lock_guard<rw_spinlock> lock(mutex_);
-  stale_ = true;
+  stale_.store(true, std::memory_order_release);
 }
 
 bool RemoteTablet::stale() const {
-  SharedLock<rw_spinlock> lock(mutex_);
-  return stale_;
+  return stale_.load(std::memory_order_acquire);
 }
 
 void RemoteTablet::MarkAsSplit() {
-  std::lock_guard<rw_spinlock> lock(mutex_);
-  is_split_ = true;
+  is_split_.store(true, std::memory_order_release);
 }
 
 bool RemoteTablet::is_split() const {
-  SharedLock<rw_spinlock> lock(mutex_);
-  return is_split_;
+  return is_split_.load(std::memory_order_acquire);
+}
+
+void RemoteTablet::SetWriteInterval(MonoDelta interval) {
+  write_interval_us_.store(interval.ToMicroseconds(), std::memory_order_release);
+}
+
+CoarseTimePoint RemoteTablet::ReserveWriteSlot() {
+  const auto now = CoarseMonoClock::now();
+  const auto interval_us = write_interval_us_.load(std::memory_order_acquire);
+  if (interval_us <= 0) {
+    return now;
+  }
+  auto slot = next_write_slot_.load(std::memory_order_acquire);
+  CoarseTimePoint result;
+  do {
+    result = std::max(slot, now);
+  } while (!next_write_slot_.compare_exchange_weak(
+      slot, result + std::chrono::microseconds(interval_us), std::memory_order_acq_rel));
+  return result;
 }
 
 bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& status) {
@@ -308,6 +376,7 @@ bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& statu
   for (RemoteReplica& rep : replicas_) {
     if (rep.ts == ts) {
       rep.MarkFailed();
+      UpdateLeaderUnlocked();
       return true;
     }
   }
@@ -326,13 +395,19 @@ int RemoteTablet::GetNumFailedReplicas() const {
 }
 
 RemoteTabletServer* RemoteTablet::LeaderTServer() const {
-  SharedLock<rw_spinlock> lock(mutex_);
+  return leader_.load(std::memory_order_acquire);
+}
+
+void RemoteTablet::UpdateLeaderUnlocked() {
+  DCHECK(mutex_.is_locked());
+  RemoteTabletServer* leader = nullptr;
   for (const RemoteReplica& replica : replicas_) {
     if (!replica.Failed() && replica.role == RaftPeerPB::LEADER) {
-      return replica.ts;
+      leader = replica.ts;
+      break;
     }
   }
-  return nullptr;
+  leader_.store(leader, std::memory_order_release);
 }
 
 bool RemoteTablet::HasLeader() const {
@@ -430,6 +505,7 @@ void RemoteTablet::GetRemoteTabletServers(
         update.replica->ClearFailed();
       }
     }
+    UpdateLeaderUnlocked();
   }
 }
 
@@ -444,6 +520,7 @@ bool RemoteTablet::MarkTServerAsLeader(const RemoteTabletServer* server) {
       replica.role = RaftPeerPB::FOLLOWER;
     }
   }
+  UpdateLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   VLOG_IF_WITH_PREFIX(3, !found) << "Specified server not found: " << server->ToString()
                                  << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -459,6 +536,7 @@ void RemoteTablet::MarkTServerAsFollower(const RemoteTabletServer* server) {
       found = true;
     }
   }
+  UpdateLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   DCHECK(found) << "Tablet " << tablet_id_ << ": Specified server not found: "
                 << server->ToString() << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -542,6 +620,9 @@ class LookupRpc : public Rpc {
 
   virtual void NotifyFailure(const Status& status) = 0;
 
+  // Invoked after received locations were processed by the meta cache.
+  virtual void NotifySuccess() {}
+
   std::shared_ptr<MasterServiceProxy> master_proxy() const {
     return client()->data_->master_proxy();
   }
@@ -704,6 +785,8 @@ void LookupRpc::DoFinished(
     YB_LOG_WITH_PREFIX_EVERY_N_SECS(WARNING, 1) << new_status;
     new_status = new_status.CloneAndPrepend(Substitute("$0 failed", ToString()));
     NotifyFailure(new_status);
+  } else {
+    NotifySuccess();
   }
 }
 
@@ -854,7 +937,7 @@ Status MetaCache::ProcessTabletLocations(
           to_notify.emplace_back(std::move(lookup->callback), remote);
           delete lookup;
         }
-        if (!partition_group_start) {
+        if (!partition_group_start && request_no != 0) {
           it->second.Finished(request_no, TabletIdLookup(tablet_id));
         }
       }
@@ -882,6 +965,10 @@ Status MetaCache::ProcessTabletLocations(
         }
       }
     }
+
+    for (const auto& processed_table : processed_tables) {
+      PublishTabletsUnlocked(processed_table.first, tables_[processed_table.first]);
+    }
   }
 
   for (const auto& callback_and_remote_tablet : to_notify) {
@@ -998,6 +1085,27 @@ void MetaCache::MaybeUpdateClientRequests(const TableData& table_data, const Rem
   tablet_requests[tablet.tablet_id()].request_id_seq = requests_it->second.request_id_seq;
 }
 
+void MetaCache::PublishTabletsUnlocked(const TableId& table_id, const TableData& table_data) {
+  std::shared_ptr<const TabletsByPartition> tablets;
+  if (!table_data.stale) {
+    tablets = std::make_shared<const TabletsByPartition>(table_data.tablets_by_partition);
+  }
+  std::atomic_store_explicit(
+      &table_data.published_tablets->tablets, std::move(tablets), std::memory_order_release);
+
+  auto old_snapshot = std::atomic_load_explicit(&tables_snapshot_, std::memory_order_acquire);
+  if (old_snapshot && old_snapshot->count(table_id)) {
+    return;
+  }
+  // Table is published for the first time, so the table map itself has to be replaced.
+  auto new_snapshot = old_snapshot ? std::make_shared<TablesSnapshot>(*old_snapshot)
+                                   : std::make_shared<TablesSnapshot>();
+  new_snapshot->emplace(table_id, table_data.published_tablets);
+  std::atomic_store_explicit(
+      &tables_snapshot_, std::shared_ptr<const TablesSnapshot>(std::move(new_snapshot)),
+      std::memory_order_release);
+}
+
 void MetaCache::InvalidateTableCache(const TableId& table_id) {
   VLOG_WITH_FUNC(1) << "table: " << table_id;
 
@@ -1017,6 +1125,7 @@ void MetaCache::InvalidateTableCache(const TableId& table_id) {
         }
       }
       it->second.tablet_lookups_by_group.clear();
+      PublishTabletsUnlocked(table_id, it->second);
     }
   }
   for (const auto& callback : to_notify) {
@@ -1234,17 +1343,101 @@ class LookupByKeyRpc : public LookupRpc {
   GetTableLocationsResponsePB resp_;
 };
 
-RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* table,
-                                                             const std::string& partition_key) {
-  auto it = tables_.find(table->id());
-  if (PREDICT_FALSE(it == tables_.end() || it->second.stale)) {
-    // No cache available for this table or it is stale.
+// Fetches locations of all tablets of the table. Each RPC requests one page of locations and
+// starts RPC for the next page after processing the response.
+class PrefetchTableLocationsRpc : public LookupRpc {
+ public:
+  PrefetchTableLocationsRpc(const scoped_refptr<MetaCache>& meta_cache,
+                            const YBTable* table,
+                            const std::string& partition_key_start,
+                            StatusFunctor callback,
+                            CoarseTimePoint deadline)
+      : LookupRpc(meta_cache, 0 /* request_no */, deadline),
+        table_(table->shared_from_this()),
+        partition_key_start_(partition_key_start),
+        callback_(std::move(callback)) {
+  }
+
+  std::string ToString() const override {
+    return Format("PrefetchTableLocations($0, $1, $2)",
+                  table_->name(), Slice(partition_key_start_).ToDebugHexString(),
+                  num_attempts());
+  }
+
+  void DoSendRpc() override {
+    req_.mutable_table()->set_table_id(table_->id());
+    req_.set_partition_key_start(partition_key_start_);
+    req_.set_max_returned_locations(FLAGS_meta_cache_prefetch_page_size);
+
+    master_proxy()->GetTableLocationsAsync(
+        req_, &resp_, mutable_retrier()->mutable_controller(),
+        std::bind(&PrefetchTableLocationsRpc::Finished, this, Status::OK()));
+  }
+
+ private:
+  void Finished(const Status& status) override {
+    const auto table_partitions_version = table_->GetPartitionsVersion();
+    if (resp_.partitions_version() != table_partitions_version) {
+      DoFinished(
+          STATUS_EC_FORMAT(
+              TryAgain, ClientError(ClientErrorCode::kTablePartitionsAreStale),
+              "Received table $0 partitions version: $1, ours is: $2", table_->id(),
+              resp_.partitions_version(), table_partitions_version),
+          resp_, nullptr /* partition_group_start */);
+      return;
+    }
+    DoFinished(status, resp_, nullptr /* partition_group_start */);
+  }
+
+  void NotifySuccess() override {
+    const auto& partition_key_end =
+        resp_.tablet_locations(resp_.tablet_locations_size() - 1).partition().partition_key_end();
+    if (partition_key_end.empty()) {
+      callback_(Status::OK());
+      return;
+    }
+    rpc::StartRpc<PrefetchTableLocationsRpc>(
+        meta_cache(), table_.get(), partition_key_end, std::move(callback_),
+        retrier().deadline());
+  }
+
+  void NotifyFailure(const Status& status) override {
+    callback_(status);
+  }
+
+  std::shared_ptr<const YBTable> table_;
+
+  // Encoded partition key of the first tablet in the page.
+  std::string partition_key_start_;
+
+  StatusFunctor callback_;
+
+  GetTableLocationsRequestPB req_;
+
+  GetTableLocationsResponsePB resp_;
+};
+
+RemoteTabletPtr MetaCache::LookupTabletByKeyFastPath(const YBTable* table,
+                                                     const std::string& partition_key) {
+  auto snapshot = std::atomic_load_explicit(&tables_snapshot_, std::memory_order_acquire);
+  if (PREDICT_FALSE(!snapshot)) {
+    return nullptr;
+  }
+  auto it = snapshot->find(table->id());
+  if (PREDICT_FALSE(it == snapshot->end())) {
+    // No cache available for this table.
+    return nullptr;
+  }
+  auto tablets = std::atomic_load_explicit(&it->second->tablets, std::memory_order_acquire);
+  if (PREDICT_FALSE(!tablets)) {
+    // Table cache is stale.
     return nullptr;
   }
 
   DCHECK_EQ(partition_key, table->FindPartitionStart(partition_key));
-  auto tablet_it = it->second.tablets_by_partition.find(partition_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
+  const auto& tablets_by_partition = *tablets;
+  auto tablet_it = tablets_by_partition.find(partition_key);
+  if (PREDICT_FALSE(tablet_it == tablets_by_partition.end())) {
     // No tablets with a start partition key lower than 'partition_key'.
     return nullptr;
   }
@@ -1265,12 +1458,11 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* tabl
   return nullptr;
 }
 
-// We disable thread safety analysis in this function due to manual conditional locking.
-RemoteTabletPtr MetaCache::FastLookupTabletByKeyUnlocked(
+RemoteTabletPtr MetaCache::FastLookupTabletByKey(
     const YBTable* table,
     const std::string& partition_start) {
   // Fast path: lookup in the cache.
-  auto result = LookupTabletByKeyFastPathUnlocked(table, partition_start);
+  auto result = LookupTabletByKeyFastPath(table, partition_start);
   if (result && result->HasLeader()) {
     VLOG(4) << "Fast lookup: found tablet " << result->tablet_id();
     return result;
@@ -1302,7 +1494,9 @@ bool MetaCache::DoLookupTabletByKey(
   int64_t request_no;
   {
     Lock lock(mutex_);
-    tablet = FastLookupTabletByKeyUnlocked(table, partition_start);
+    // Check again under the lock, so locations could not be processed between the check and
+    // adding lookup to the group.
+    tablet = FastLookupTabletByKey(table, partition_start);
     if (tablet) {
       return true;
     }
@@ -1360,6 +1554,14 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
                     << ", partition_key: " << Slice(partition_key).ToDebugHexString()
                     << ", partition_start: " << Slice(partition_start).ToDebugHexString();
 
+  {
+    auto tablet = FastLookupTabletByKey(table, partition_start);
+    if (tablet) {
+      callback(tablet);
+      return;
+    }
+  }
+
   const std::string* partition_group_start = nullptr;
   if (DoLookupTabletByKey<SharedLock<boost::shared_mutex>>(
           table, partition_start, deadline, &callback, &partition_group_start)) {
@@ -1373,6 +1575,62 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
       << ", partition_key: " << Slice(partition_key).ToDebugHexString();
 }
 
+void MetaCache::PrefetchTableLocations(const YBTable* table,
+                                       CoarseTimePoint deadline,
+                                       StatusFunctor callback) {
+  VLOG_WITH_FUNC(4) << "Table: " << table->ToString();
+  rpc::StartRpc<PrefetchTableLocationsRpc>(
+      this, table, std::string() /* partition_key_start */, std::move(callback), deadline);
+}
+
+Status MetaCache::SaveSnapshot(Env* env, const std::string& path) {
+  master::TabletLocationsSnapshotPB snapshot;
+  {
+    SharedLock<decltype(mutex_)> lock(mutex_);
+    // Colocated tablets are shared by several tables, so they are stored once with all table ids.
+    std::unordered_map<TabletId, TabletLocationsPB*> tablet_locations;
+    for (const auto& id_and_table : tables_) {
+      if (id_and_table.second.stale) {
+        continue;
+      }
+      for (const auto& partition_and_tablet : id_and_table.second.tablets_by_partition) {
+        const auto& tablet = partition_and_tablet.second;
+        if (tablet->stale() || tablet->is_split()) {
+          continue;
+        }
+        auto& location = tablet_locations[tablet->tablet_id()];
+        if (!location) {
+          location = snapshot.add_tablet_locations();
+          tablet->ToPB(location);
+        }
+        location->add_table_ids(id_and_table.first);
+      }
+    }
+  }
+
+  RETURN_NOT_OK(pb_util::WritePBContainerToPath(
+      env, path, snapshot, pb_util::OVERWRITE, pb_util::NO_SYNC));
+  LOG(INFO) << "Saved " << snapshot.tablet_locations_size() << " tablet locations to " << path;
+  return Status::OK();
+}
+
+Status MetaCache::LoadSnapshot(Env* env, const std::string& path) {
+  master::TabletLocationsSnapshotPB snapshot;
+  RETURN_NOT_OK(pb_util::ReadPBContainerFromPath(env, path, &snapshot));
+
+  // Tablets of different tables are not ordered by partitions, so each of them is processed
+  // separately.
+  google::protobuf::RepeatedPtrField<TabletLocationsPB> locations;
+  for (auto& location : *snapshot.mutable_tablet_locations()) {
+    locations.Clear();
+    locations.Add()->Swap(&location);
+    RETURN_NOT_OK(ProcessTabletLocations(
+        locations, nullptr /* partition_group_start */, 0 /* request_no */));
+  }
+  LOG(INFO) << "Loaded " << snapshot.tablet_locations_size() << " tablet locations from " << path;
+  return Status::OK();
+}
+
 RemoteTabletPtr MetaCache::LookupTabletByIdFastPathUnlocked(const TabletId& tablet_id) {
   auto it = tablets_by_id_.find(tablet_id);
   if (it != tablets_by_id_.end()) {
@@ -33,6 +33,7 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <memory>
@@ -70,6 +71,7 @@
 
 namespace yb {
 
+class Env;
 class Histogram;
 class YBPartialRow;
 
@@ -91,6 +93,7 @@ namespace internal {
 class LookupRpc;
 class LookupByKeyRpc;
 class LookupByIdRpc;
+class PrefetchTableLocationsRpc;
 
 // The information cached about a given tablet server in the cluster.
 //
@@ -140,10 +143,26 @@ class RemoteTabletServer {
 
   bool HasCapability(CapabilityId capability) const;
 
+  // Fills pb with information about this server, in the same form as master reports it.
+  void ToPB(master::TSInfoPB* pb) const;
+
+  // Should be invoked when request is sent to this server, and when response for it is received.
+  // Used to estimate load of this server.
+  void RequestStarted();
+  void RequestFinished(MonoDelta latency);
+
+  // Estimated time to process a new request by this server, based on moving average of response
+  // time and the number of outstanding requests. Lower score means less loaded server.
+  int64_t LoadScore() const;
+
  private:
   mutable rw_spinlock mutex_;
   const std::string uuid_;
 
+  // Exponentially weighted moving average of response time in microseconds, 0 if unknown.
+  std::atomic<int64_t> latency_ewma_us_{0};
+  std::atomic<int64_t> outstanding_requests_{0};
+
   google::protobuf::RepeatedPtrField<HostPortPB> public_rpc_hostports_;
   google::protobuf::RepeatedPtrField<HostPortPB> private_rpc_hostports_;
   yb::CloudInfoPB cloud_info_pb_;
@@ -203,8 +222,7 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
       : tablet_id_(std::move(tablet_id)),
         log_prefix_(Format("T $0: ", tablet_id_)),
         partition_(std::move(partition)),
-        split_depth_(split_depth),
-        stale_(false) {
+        split_depth_(split_depth) {
   }
 
   ~RemoteTablet();
@@ -289,25 +307,49 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // See TabletLocationsPB::split_depth.
   uint64 split_depth() const { return split_depth_; }
 
+  // Fills pb with cached locations of this tablet, except table ids.
+  void ToPB(master::TabletLocationsPB* pb) const;
+
+  // Sets the interval between writes to this tablet, that its leader advertises under write
+  // pressure. Zero interval stops pacing.
+  void SetWriteInterval(MonoDelta interval);
+
+  // Reserves the next slot for sending a write to this tablet, and returns its time. Slots are
+  // spaced by the write interval, so writes are paced instead of being sent in bursts.
+  CoarseTimePoint ReserveWriteSlot();
+
  private:
   // Same as ReplicasAsString(), except that the caller must hold mutex_.
   std::string ReplicasAsStringUnlocked() const;
 
+  // Updates leader_ after change of replicas_, the caller must hold unique lock on mutex_.
+  void UpdateLeaderUnlocked();
+
   const std::string tablet_id_;
   const std::string log_prefix_;
   const Partition partition_;
   const uint64 split_depth_;
 
-  // All non-const members are protected by 'mutex_'.
+  // Flags and leader are read without lock by the lookup fast path.
+  std::atomic<bool> stale_{false};
+  std::atomic<bool> is_split_{false};
+
+  // Leader among not failed replicas, nullptr if there is no such replica.
+  // Modified under 'mutex_' together with replicas_.
+  std::atomic<RemoteTabletServer*> leader_{nullptr};
+
+  // All other non-const members are protected by 'mutex_'.
   mutable rw_spinlock mutex_;
-  bool stale_;
-  bool is_split_ = false;
   std::vector<RemoteReplica> replicas_;
 
   // Last time this object was refreshed. Initialized to MonoTime::Min() so we don't have to be
   // checking whether it has been initialized everytime we use this value.
   std::atomic<MonoTime> refresh_time_{MonoTime::Min()};
 
+  // Write interval in microseconds, and the time of the next free write slot.
+  std::atomic<int64_t> write_interval_us_{0};
+  std::atomic<CoarseTimePoint> next_write_slot_{CoarseTimePoint()};
+
   DISALLOW_COPY_AND_ASSIGN(RemoteTablet);
 };
 
@@ -363,6 +405,24 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
                         LookupTabletCallback callback,
                         UseCache use_cache);
 
+  // Fetches locations of all tablets of the table from master and stores them in the cache.
+  // Locations are requested in pages of FLAGS_meta_cache_prefetch_page_size tablets.
+  // The callback is invoked after the last page is processed, or on the first failure.
+  //
+  // NOTE: the memory referenced by 'table' must remain valid until 'callback' is invoked.
+  void PrefetchTableLocations(const YBTable* table,
+                              CoarseTimePoint deadline,
+                              StatusFunctor callback);
+
+  // Writes locations of all cached tablets to the file at path.
+  CHECKED_STATUS SaveSnapshot(Env* env, const std::string& path);
+
+  // Loads tablet locations written by SaveSnapshot into the cache.
+  // Loaded locations are used as if they were received from master and are validated lazily:
+  // when a tablet server rejects a request, the tablet is looked up again as for any other
+  // cached tablet, and lookups of partitions that do not match the snapshot go to master.
+  CHECKED_STATUS LoadSnapshot(Env* env, const std::string& path);
+
   // Return the local tablet server if available.
   RemoteTabletServer* local_tserver() const {
     return local_tserver_;
@@ -387,6 +447,8 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   // REQUIRES locations to be in order of partitions and without overlaps.
   // There could be gaps due to post-tablets not yet being running, in this case, MetaCache will
   // just skip updating cache for these tablets until they become running.
+  // request_no is 0 when locations were not received in response to a lookup, for instance
+  // when they were prefetched or loaded from a snapshot.
   CHECKED_STATUS ProcessTabletLocations(
       const google::protobuf::RepeatedPtrField<master::TabletLocationsPB>& locations,
       const std::string* partition_group_start,
@@ -398,6 +460,7 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   friend class LookupRpc;
   friend class LookupByKeyRpc;
   friend class LookupByIdRpc;
+  friend class PrefetchTableLocationsRpc;
 
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
 
@@ -435,9 +498,23 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   typedef std::string PartitionKey;
   typedef std::string PartitionGroupKey;
+  typedef std::map<PartitionKey, RemoteTabletPtr> TabletsByPartition;
+
+  // Immutable copy of tablets_by_partition of a table, used by lookups by key without taking
+  // mutex_. The tablets pointer is replaced under mutex_ and read with std::atomic_load_explicit,
+  // it is null while the table is stale.
+  struct PublishedTablets {
+    std::shared_ptr<const TabletsByPartition> tablets;
+  };
+
+  // Published tablets of all tables known to the cache. Replaced only when a table is added,
+  // changes of tablets of a known table are published through its PublishedTablets.
+  typedef std::unordered_map<TableId, std::shared_ptr<PublishedTablets>> TablesSnapshot;
 
   struct TableData {
-    std::map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+    TabletsByPartition tablets_by_partition;
+    const std::shared_ptr<PublishedTablets> published_tablets =
+        std::make_shared<PublishedTablets>();
     std::unordered_map<PartitionGroupKey, LookupDataGroup> tablet_lookups_by_group;
     // When replacing tablet which has been split with post-split tablet in tablets_by_partition
     // it is moved into split_tablets and added to the end of the chain corresponding to its
@@ -447,10 +524,15 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   };
 
   // Lookup the given tablet by key, only consulting local information.
-  // Returns true and sets *remote_tablet if successful.
-  RemoteTabletPtr LookupTabletByKeyFastPathUnlocked(
+  // Does not require mutex_, since it uses tables_snapshot_ and published tablets of the table.
+  RemoteTabletPtr LookupTabletByKeyFastPath(
       const YBTable* table,
-      const std::string& partition_key) REQUIRES_SHARED(mutex_);
+      const std::string& partition_key);
+
+  // Publishes tablets of the table for lookups without mutex_, should be invoked after changing
+  // tablets_by_partition or stale flag of the table. Only tablets of this table are copied.
+  void PublishTabletsUnlocked(const TableId& table_id, const TableData& table_data)
+      REQUIRES(mutex_);
 
   RemoteTabletPtr LookupTabletByIdFastPathUnlocked(const TabletId& tablet_id)
       REQUIRES_SHARED(mutex_);
@@ -483,9 +565,9 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       std::unordered_map<Key, LookupDataGroup>* key_to_group_lookup_data,
       CallbackNotifier* notifier) REQUIRES(mutex_);
 
-  RemoteTabletPtr FastLookupTabletByKeyUnlocked(
+  RemoteTabletPtr FastLookupTabletByKey(
       const YBTable* table,
-      const std::string& partition_start) REQUIRES_SHARED(mutex_);
+      const std::string& partition_start);
 
   // If `tablet` is a result of splitting of pre-split tablet for which we already have
   // TabletRequests structure inside YBClient - updates TabletRequests.request_id_seq for the
@@ -534,6 +616,9 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  // Replaced under mutex_ when a table is added to tables_, read with std::atomic_load_explicit.
+  std::shared_ptr<const TablesSnapshot> tables_snapshot_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<TabletId, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
@@ -67,10 +67,12 @@ DECLARE_int32(TEST_max_write_waiters);
 DECLARE_uint64(log_segment_size_bytes);
 DECLARE_uint64(sst_files_soft_limit);
 DECLARE_uint64(sst_files_hard_limit);
+DECLARE_bool(enable_write_backpressure);
 DECLARE_int32(log_min_seconds_to_retain);
 DECLARE_int64(remote_bootstrap_rate_limit_bytes_per_sec);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_int32(log_cache_size_limit_mb);
+DECLARE_bool(tserver_coalesce_identical_reads);
 
 METRIC_DECLARE_counter(majority_sst_files_rejections);
 
@@ -508,6 +510,61 @@ TEST_F_EX(QLStressTest, Increment, QLStressTestIntValue) {
   ASSERT_EQ(value.int64_value(), kIncrements) << value.ToString();
 }
 
+// Concurrent reads of the same key with identical reads coalesced, while the value is incremented
+// by a writer. Each read should observe a value that is not less than the last value acknowledged
+// before the read was started.
+TEST_F_EX(QLStressTest, CoalescedReads, QLStressTestIntValue) {
+  constexpr int kKey = 1;
+  constexpr int kNumReaders = 16;
+
+  FLAGS_tserver_coalesce_identical_reads = true;
+
+  auto write_value = [this](const YBSessionPtr& session, int64_t value) -> Status {
+    auto op = table_.NewWriteOp(QLWriteRequestPB::QL_STMT_INSERT);
+    auto* const req = op->mutable_request();
+    QLAddInt32HashValue(req, kKey);
+    table_.AddInt64ColumnValue(req, kValueColumn, value);
+    RETURN_NOT_OK(session->ApplyAndFlush(op));
+    SCHECK_EQ(op->response().status(), QLResponsePB::YQL_STATUS_OK, RemoteError,
+              Format("Write failed: $0", op->response().ShortDebugString()));
+    return Status::OK();
+  };
+
+  ASSERT_OK(write_value(NewSession(), 0));
+
+  TestThreadHolder thread_holder;
+  std::atomic<int64_t> acked_value{0};
+  std::atomic<int> num_reads{0};
+
+  thread_holder.AddThreadFunctor(
+      [&stop = thread_holder.stop_flag(), &acked_value, &write_value, this] {
+    auto session = NewSession();
+    for (int64_t value = 1; !stop.load(std::memory_order_acquire); ++value) {
+      ASSERT_OK(write_value(session, value));
+      acked_value.store(value, std::memory_order_release);
+    }
+  });
+
+  for (int i = 0; i != kNumReaders; ++i) {
+    thread_holder.AddThreadFunctor(
+        [&stop = thread_holder.stop_flag(), &acked_value, &num_reads, this] {
+      auto session = NewSession();
+      while (!stop.load(std::memory_order_acquire)) {
+        const auto min_value = acked_value.load(std::memory_order_acquire);
+        auto value = ASSERT_RESULT(ReadRow(session, kKey));
+        ASSERT_GE(value.int64_value(), min_value);
+        num_reads.fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  thread_holder.WaitAndStop(10s);
+
+  LOG(INFO) << "Reads: " << num_reads.load() << ", last acked value: " << acked_value.load();
+  ASSERT_GT(num_reads.load(), 0);
+  ASSERT_GT(acked_value.load(), 0);
+}
+
 class QLStressTestSingleTablet : public QLStressTest {
  private:
   int NumTablets() override {
@@ -916,6 +973,30 @@ TEST_F_EX(QLStressTest, WriteStop, QLStressTestDelayWrite_6_6) {
   TestWriteRejection();
 }
 
+// Writes over sst_files_soft_limit are paced by clients, instead of being rejected.
+TEST_F_EX(QLStressTest, WriteBackpressure, QLStressTestDelayWrite_4_10) {
+  constexpr int kWriters = 10;
+  constexpr int kKeyBase = 10000;
+
+  FLAGS_enable_write_backpressure = true;
+
+  std::array<std::atomic<int>, kWriters> keys;
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kWriters; ++i) {
+    keys[i] = i * kKeyBase;
+    AddWriter(std::string(1_KB, 'X'), &keys[i], &thread_holder, 0s, true /* allow_failures */);
+  }
+
+  thread_holder.WaitAndStop(30s);
+
+  int keys_written = 0;
+  for (int i = 0; i != kWriters; ++i) {
+    keys_written += keys[i].load() - kKeyBase * i;
+  }
+  LOG(INFO) << "Total keys written: " << keys_written;
+  ASSERT_GE(keys_written, RegularBuildVsSanitizers(1000, 100));
+}
+
 class QLStressTestLongRemoteBootstrap : public QLStressTestSingleTablet {
  public:
   void SetUp() override {
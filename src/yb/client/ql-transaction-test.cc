@@ -47,6 +47,8 @@ using yb::tablet::GetTransactionTimeout;
 using yb::tablet::TabletPeer;
 
 DECLARE_uint64(transaction_heartbeat_usec);
+DECLARE_double(transaction_max_missed_heartbeat_periods);
+DECLARE_double(transaction_min_heartbeat_replication_periods);
 DECLARE_int32(log_min_seconds_to_retain);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
@@ -121,6 +123,28 @@ TEST_F(QLTransactionTest, LookupTabletFailure) {
   ASSERT_TRUE(!result.ok() && result.status().IsTimedOut()) << "Result: " << AsString(result);
 }
 
+TEST_F(QLTransactionTest, SingleShardFinalFlush) {
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  txn->ExpectFinalFlush();
+  ASSERT_OK(WriteRow(session, 1 /* key */, 2 /* value */));
+
+  // All writes were already applied, so flushing more operations is not allowed.
+  auto result = WriteRow(session, 3 /* key */, 4 /* value */);
+  ASSERT_TRUE(!result.ok() && result.status().IsIllegalState()) << "Result: " << AsString(result);
+
+  ASSERT_NOK(txn->CommitFuture().get());
+  ASSERT_EQ(2, ASSERT_RESULT(SelectRow(CreateSession(), 1 /* key */)));
+
+  txn = CreateTransaction();
+  session = CreateSession(txn);
+  txn->ExpectFinalFlush();
+  ASSERT_OK(WriteRow(session, 5 /* key */, 6 /* value */));
+  ASSERT_OK(txn->CommitFuture().get());
+  ASSERT_EQ(6, ASSERT_RESULT(SelectRow(CreateSession(), 5 /* key */)));
+  CheckNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, ReadWithTimeInFuture) {
   WriteData();
   server::SkewedClockDeltaChanger delta_changer(100ms, skewed_clock_);
@@ -1449,6 +1473,74 @@ TEST_F_EX(QLTransactionTest, ChangeLeader, QLTransactionBigLogSegmentSizeTest) {
   ASSERT_LE(expirations.load() * 100, successes * 5);
 }
 
+// Checks that heartbeats acknowledged without replication do not extend the transaction, that
+// replication is forced after half of the transaction timeout, and that the transaction survives
+// leader change of its status tablet while heartbeats are not replicated.
+TEST_F_EX(QLTransactionTest, HeartbeatReplication, QLTransactionBigLogSegmentSizeTest) {
+  // Heartbeats are replicated only when they are forced by the transaction timeout.
+  FLAGS_transaction_min_heartbeat_replication_periods = 1000;
+  FLAGS_transaction_max_missed_heartbeat_periods = 20;
+  const auto timeout = GetTransactionTimeout();
+  const auto heartbeat_period = std::chrono::microseconds(FLAGS_transaction_heartbeat_usec);
+
+  auto txn = CreateTransaction();
+  ASSERT_OK(WriteRows(CreateSession(txn)));
+  const auto txn_id = txn->id();
+
+  auto status_tablet_leader = [this, &txn_id]() -> tablet::TabletPeerPtr {
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      std::vector<tablet::TabletPeerPtr> peers;
+      cluster_->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers(&peers);
+      for (const auto& peer : peers) {
+        if (peer->consensus() &&
+            peer->consensus()->GetLeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY &&
+            peer->tablet()->transaction_coordinator() &&
+            peer->tablet()->transaction_coordinator()->test_last_touch(txn_id).is_valid()) {
+          return peer;
+        }
+      }
+    }
+    return nullptr;
+  };
+
+  tablet::TabletPeerPtr leader;
+  ASSERT_OK(WaitFor([&leader, &status_tablet_leader] {
+    leader = status_tablet_leader();
+    return leader != nullptr;
+  }, 10s * kTimeMultiplier, "Find status tablet leader"));
+  auto* coordinator = leader->tablet()->transaction_coordinator();
+  const auto first_touch = coordinator->test_last_touch(txn_id);
+
+  // Several heartbeats are acknowledged without moving last touch.
+  std::this_thread::sleep_for(timeout / 2 - heartbeat_period * 3);
+  ASSERT_EQ(coordinator->test_last_touch(txn_id), first_touch);
+
+  // Once half of the timeout passed, heartbeat is replicated.
+  HybridTime second_touch;
+  ASSERT_OK(WaitFor([coordinator, &txn_id, &first_touch, &second_touch] {
+    second_touch = coordinator->test_last_touch(txn_id);
+    return second_touch != first_touch;
+  }, timeout, "Heartbeat replicated"));
+  const auto passed_usec =
+      second_touch.GetPhysicalValueMicros() - first_touch.GetPhysicalValueMicros();
+  ASSERT_GE(passed_usec, timeout.count() / 2);
+  ASSERT_LT(passed_usec, timeout.count());
+
+  // Change leader of the status tablet while heartbeats are acknowledged without replication.
+  std::this_thread::sleep_for(heartbeat_period * 3);
+  ASSERT_EQ(coordinator->test_last_touch(txn_id), second_touch);
+  consensus::LeaderStepDownRequestPB req;
+  req.set_tablet_id(leader->tablet_id());
+  consensus::LeaderStepDownResponsePB resp;
+  ASSERT_OK(leader->consensus()->StepDown(&req, &resp));
+  ASSERT_FALSE(resp.has_error()) << resp.error().ShortDebugString();
+
+  // New leader knows the last replicated touch and keeps the transaction alive.
+  std::this_thread::sleep_for(timeout * 2);
+  ASSERT_OK(txn->CommitFuture().get());
+  VerifyData();
+}
+
 class RemoteBootstrapTest : public QLTransactionTest {
  protected:
   void SetUp() override {
@@ -27,6 +27,7 @@ DECLARE_bool(enable_transaction_sealing);
 DECLARE_bool(TEST_fail_on_replicated_batch_idx_set_in_txn_record);
 DECLARE_int32(TEST_write_rejection_percentage);
 DECLARE_int64(transaction_rpc_timeout_ms);
+DECLARE_bool(transaction_parallel_commit);
 
 namespace yb {
 namespace client {
@@ -144,5 +145,22 @@ TEST_F(SealTxnTest, Update) {
   CheckNoRunningTransactions();
 }
 
+// Check that regular commit, requested while writes are in flight, is done in parallel with them.
+TEST_F(SealTxnTest, ParallelCommit) {
+  FLAGS_transaction_parallel_commit = true;
+
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  ASSERT_OK(WriteRows(session, /* transaction = */ 0));
+  ASSERT_OK(WriteRows(session, /* transaction = */ 0, WriteOpType::UPDATE, Flush::kFalse));
+  auto flush_future = session->FlushFuture();
+  auto commit_future = txn->CommitFuture();
+  ASSERT_OK(flush_future.get());
+  ASSERT_OK(commit_future.get());
+  ASSERT_NO_FATALS(VerifyData(1, WriteOpType::UPDATE));
+  ASSERT_OK(cluster_->RestartSync());
+  CheckNoRunningTransactions();
+}
+
 } // namespace client
 } // namespace yb
@@ -81,6 +81,13 @@ void YBSession::SetRejectionScoreSource(RejectionScoreSourcePtr rejection_score_
   rejection_score_source_ = std::move(rejection_score_source);
 }
 
+void YBSession::SetFlushTraceCallback(FlushTraceCallback callback) {
+  if (batcher_) {
+    batcher_->SetFlushTraceCallback(callback);
+  }
+  flush_trace_callback_ = std::move(callback);
+}
+
 YBSession::~YBSession() {
   WARN_NOT_OK(Close(true), "Closed Session with pending operations.");
 }
@@ -202,6 +209,7 @@ internal::Batcher& YBSession::Batcher() {
       batcher_->SetTimeout(timeout_);
     }
     batcher_->SetRejectionScoreSource(rejection_score_source_);
+    batcher_->SetFlushTraceCallback(flush_trace_callback_);
     if (hybrid_time_for_write_.is_valid()) {
       batcher_->SetHybridTimeForWrite(hybrid_time_for_write_);
     }
@@ -249,6 +249,10 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   void SetRejectionScoreSource(RejectionScoreSourcePtr rejection_score_source);
 
+  // Sets callback that is invoked with phase timings of sampled flushes of this session, before
+  // the flush callback. See client_flush_trace_sample_rate.
+  void SetFlushTraceCallback(FlushTraceCallback callback);
+
  private:
   friend class YBClient;
   friend class internal::Batcher;
@@ -292,6 +296,8 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   RejectionScoreSourcePtr rejection_score_source_;
 
+  FlushTraceCallback flush_trace_callback_;
+
   DISALLOW_COPY_AND_ASSIGN(YBSession);
 };
 
@@ -25,12 +25,31 @@
 #include "yb/tserver/tserver_service.proxy.h"
 #include "yb/tserver/tserver_error.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
 
 DEFINE_test_flag(bool, assert_local_op, false,
                  "When set, we crash if we received an operation that cannot be served locally.");
 DEFINE_int32(force_lookup_cache_refresh_secs, 0, "When non-zero, specifies how often we send a "
              "GetTabletLocations request to the master leader to update the tablet replicas cache. "
              "This request is only sent if we are processing a ConsistentPrefix read.");
+DEFINE_bool(select_replica_by_load, false,
+            "When set, ConsistentPrefix reads are sent to the less loaded of two random replicas, "
+            "according to the measured response time and the number of outstanding requests, "
+            "instead of the closest replica.");
+TAG_FLAG(select_replica_by_load, advanced);
+TAG_FLAG(select_replica_by_load, runtime);
+DEFINE_double(hedged_read_delay_percentile, 0,
+              "When positive, a ConsistentPrefix read that did not get a response during this "
+              "percentile of remote read latency is also sent to another replica, and the first "
+              "response is used. 0 disables hedged reads.");
+TAG_FLAG(hedged_read_delay_percentile, advanced);
+TAG_FLAG(hedged_read_delay_percentile, runtime);
+DEFINE_int32(hedged_read_min_delay_us, 1000,
+             "Minimal delay before sending a hedged read, in microseconds.");
+TAG_FLAG(hedged_read_min_delay_us, advanced);
+TAG_FLAG(hedged_read_min_delay_us, runtime);
 
 using namespace std::placeholders;
 
@@ -56,12 +75,39 @@ TabletInvoker::TabletInvoker(const bool local_tserver_only,
         local_tserver_only_(local_tserver_only),
         consistent_prefix_(consistent_prefix) {}
 
-TabletInvoker::~TabletInvoker() {}
+TabletInvoker::~TabletInvoker() {
+  RequestFinished();
+}
+
+namespace {
+
+// Uses power of two choices, instead of picking the least loaded of all candidates, so concurrent
+// requests do not herd to the same server before its load estimate is updated.
+RemoteTabletServer* SelectLessLoaded(const std::vector<RemoteTabletServer*>& candidates) {
+  if (candidates.size() <= 1) {
+    return candidates.empty() ? nullptr : candidates.front();
+  }
+  auto first = RandomUniformInt<size_t>(0, candidates.size() - 1);
+  auto second = RandomUniformInt<size_t>(0, candidates.size() - 2);
+  if (second >= first) {
+    ++second;
+  }
+  return candidates[first]->LoadScore() <= candidates[second]->LoadScore()
+      ? candidates[first] : candidates[second];
+}
+
+} // namespace
 
 void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   TRACE_TO(trace_, "SelectTabletServerWithConsistentPrefix()");
 
   std::vector<RemoteTabletServer*> candidates;
+  if (FLAGS_select_replica_by_load) {
+    tablet_->GetRemoteTabletServers(&candidates);
+    current_ts_ = SelectLessLoaded(candidates);
+    VLOG(1) << "Using less loaded tserver: " << yb::ToString(current_ts_);
+    return;
+  }
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
                                               YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
                                               &candidates);
@@ -213,9 +259,44 @@ void TabletInvoker::Execute(const std::string& tablet_id, bool leader_only) {
   VLOG(2) << "Tablet " << tablet_id_ << ": Writing batch to replica "
           << current_ts_->ToString();
 
+  current_ts_->RequestStarted();
+  request_ts_ = current_ts_;
+  request_start_ = MonoTime::Now();
   rpc_->SendRpcToTserver(retrier_->attempt_num());
 }
 
+MonoDelta TabletInvoker::HedgeDelay(const Histogram* latency) const {
+  // Percentile is not meaningful until enough reads are measured.
+  constexpr uint64_t kMinLatencySamples = 100;
+
+  if (FLAGS_hedged_read_delay_percentile <= 0 || !consistent_prefix_ || local_tserver_only_ ||
+      !latency || latency->histogram()->TotalCount() < kMinLatencySamples) {
+    return MonoDelta();
+  }
+  auto delay = latency->histogram()->ValueAtPercentile(FLAGS_hedged_read_delay_percentile);
+  return MonoDelta::FromMicroseconds(
+      std::max<int64_t>(delay, FLAGS_hedged_read_min_delay_us));
+}
+
+RemoteTabletServer* TabletInvoker::SelectHedgeTabletServer() {
+  std::vector<RemoteTabletServer*> candidates;
+  tablet_->GetRemoteTabletServers(&candidates);
+  candidates.erase(
+      std::remove(candidates.begin(), candidates.end(), current_ts_), candidates.end());
+  auto* result = SelectLessLoaded(candidates);
+  if (result && !result->InitProxy(client_).ok()) {
+    return nullptr;
+  }
+  return result;
+}
+
+void TabletInvoker::RequestFinished() {
+  if (request_ts_) {
+    request_ts_->RequestFinished(MonoTime::Now().GetDeltaSince(request_start_));
+    request_ts_ = nullptr;
+  }
+}
+
 Status TabletInvoker::FailToNewReplica(const Status& reason,
                                        const tserver::TabletServerErrorPB* error_code) {
   if (ErrorCode(error_code) == tserver::TabletServerErrorPB::STALE_FOLLOWER) {
@@ -258,6 +339,8 @@ bool TabletInvoker::Done(Status* status) {
   TRACE_TO(trace_, "Done($0)", status->ToString(false));
   ADOPT_TRACE(trace_);
 
+  RequestFinished();
+
   if (status->IsAborted() || retrier_->finished()) {
     return true;
   }
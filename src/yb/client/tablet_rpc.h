@@ -33,6 +33,8 @@
 
 namespace yb {
 
+class Histogram;
+
 namespace tserver {
 class TabletServerServiceProxy;
 }
@@ -77,6 +79,14 @@ class TabletInvoker {
   ::yb::HostPort ProxyEndpoint() const;
   YBClient& client() const { return *client_; }
   const RemoteTabletServer& current_ts() { return *current_ts_; }
+
+  // Delay after which the request should be duplicated to another replica, based on the
+  // latency histogram of similar requests. Not initialized if the request should not be hedged.
+  MonoDelta HedgeDelay(const Histogram* latency) const;
+
+  // Returns replica for the duplicate request, with initialized proxy, or nullptr if there is no
+  // other live replica.
+  RemoteTabletServer* SelectHedgeTabletServer();
   bool local_tserver_only() const { return local_tserver_only_; }
 
  private:
@@ -104,6 +114,9 @@ class TabletInvoker {
 
   void InitialLookupTabletDone(const Result<RemoteTabletPtr>& result);
 
+  // Updates load statistics of the tablet server that received the last request.
+  void RequestFinished();
+
   // If we receive TABLET_NOT_FOUND and current_ts_ is set, that means we contacted a tserver
   // with a tablet_id, but the tserver no longer has that tablet.
   bool TabletNotFoundOnTServer(const tserver::TabletServerErrorPB* error_code,
@@ -143,6 +156,11 @@ class TabletInvoker {
   // RemoteTabletServer is taken from YBClient cache, so it is guaranteed that those objects are
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
   RemoteTabletServer* current_ts_ = nullptr;
+
+  // The TS that received the request, which response is not yet processed, and time when this
+  // request was sent. Used to track load of tablet servers.
+  RemoteTabletServer* request_ts_ = nullptr;
+  MonoTime request_start_;
 };
 
 CHECKED_STATUS ErrorStatus(const tserver::TabletServerErrorPB* error);
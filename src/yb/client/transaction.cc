@@ -48,6 +48,10 @@ DEFINE_uint64(transaction_heartbeat_usec, 500000 * yb::kTimeMultiplier,
 DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
 DEFINE_bool(transaction_disable_proactive_cleanup_in_tests, false,
             "Disable cleanup of intents in abort path.");
+DEFINE_bool(transaction_parallel_commit, false,
+            "Commit transaction in parallel with writing its last intents, when commit is "
+            "requested while writes are still in flight. Requires enable_transaction_sealing on "
+            "tablet servers.");
 DECLARE_uint64(max_clock_skew_usec);
 
 DEFINE_test_flag(int32, transaction_inject_flushed_delay_ms, 0,
@@ -198,6 +202,26 @@ class YBTransaction::Impl final {
     bool has_tablets_without_metadata = false;
     {
       std::unique_lock<std::mutex> lock(mutex_);
+      if (initial) {
+        unprepared_requests_ -= std::min(unprepared_requests_, ops.size());
+      }
+      if (single_shard_) {
+        lock.unlock();
+        if (waiter) {
+          waiter(STATUS(IllegalState, "Flush after final flush of transaction"));
+        }
+        return false;
+      }
+      if (initial && final_flush_expected_) {
+        final_flush_expected_ = false;
+        if (CouldExecuteSingleShard(ops)) {
+          // Metadata is left empty, so the batch is executed as a regular single shard write.
+          // It does not write intents, so there is nothing to commit or clean up afterwards.
+          VLOG_WITH_PREFIX(2) << "Prepare, single shard";
+          single_shard_ = true;
+          return true;
+        }
+      }
       const bool defer = !ready_;
 
       int num_tablets = 0;
@@ -263,6 +287,12 @@ class YBTransaction::Impl final {
   void ExpectOperations(size_t count) {
     std::lock_guard<std::mutex> lock(mutex_);
     running_requests_ += count;
+    unprepared_requests_ += count;
+  }
+
+  void ExpectFinalFlush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    final_flush_expected_ = true;
   }
 
   void Flushed(
@@ -301,6 +331,9 @@ class YBTransaction::Impl final {
         }
         const std::string* prev_tablet_id = nullptr;
         for (const auto& op : ops) {
+          if (single_shard_) {
+            break;
+          }
           if (op->yb_op->applied() && op->yb_op->should_add_intents(metadata_.isolation)) {
             const std::string& tablet_id = op->tablet->tablet_id();
             if (prev_tablet_id == nullptr || tablet_id != *prev_tablet_id) {
@@ -340,6 +373,14 @@ class YBTransaction::Impl final {
     auto transaction = transaction_->shared_from_this();
     {
       std::unique_lock<std::mutex> lock(mutex_);
+      if (!seal_only && CouldCommitInParallel()) {
+        // Intents of running requests are not written yet, but all of them already have batch
+        // indexes assigned. So transaction could be sealed with all participating tablets, and
+        // coordinator commits it as soon as all those batches are replicated, instead of waiting
+        // for running requests before sending commit.
+        VLOG_WITH_PREFIX(2) << "Parallel commit, running requests: " << running_requests_;
+        seal_only = SealOnly::kTrue;
+      }
       auto status = CheckCouldCommit(seal_only, &lock);
       if (!status.ok()) {
         callback(status);
@@ -926,6 +967,31 @@ class YBTransaction::Impl final {
     callback(data);
   }
 
+  // Whether the batch could be executed as a single shard operation instead of the transactional
+  // one. It is allowed only when all operations of the transaction are writes to the same tablet,
+  // flushed by this batch, and nothing was read before, so there are no conflicts to track.
+  bool CouldExecuteSingleShard(const internal::InFlightOps& ops) {
+    if (ops.empty() || child_ || !tablets_.empty() || running_requests_ != ops.size() ||
+        read_point_.GetReadTime()) {
+      return false;
+    }
+    const auto* tablet = ops.front()->tablet.get();
+    for (const auto& op : ops) {
+      if (op->tablet.get() != tablet || op->yb_op->group() != OpGroup::kWrite ||
+          !op->yb_op->should_add_intents(metadata_.isolation)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // All running requests should be prepared, otherwise we don't know the full set of tablets that
+  // should be listed in the commit record.
+  bool CouldCommitInParallel() {
+    return FLAGS_transaction_parallel_commit && running_requests_ > 0 &&
+           unprepared_requests_ == 0 && !single_shard_ && !tablets_.empty();
+  }
+
   CHECKED_STATUS CheckCouldCommit(SealOnly seal_only, std::unique_lock<std::mutex>* lock) {
     RETURN_NOT_OK(CheckRunning(lock));
     if (child_) {
@@ -982,8 +1048,14 @@ class YBTransaction::Impl final {
   std::promise<TransactionMetadata> metadata_promise_;
   std::shared_future<TransactionMetadata> metadata_future_;
   size_t running_requests_ = 0;
+  // Number of running requests, that were not yet passed to Prepare.
+  size_t unprepared_requests_ = 0;
   // Set to true after commit record is replicated. Used only during transaction sealing.
   bool commit_replicated_ = false;
+  // Next flush is the last one before commit, see YBTransaction::ExpectFinalFlush.
+  bool final_flush_expected_ = false;
+  // Operations of this transaction were executed by a single shard operation.
+  bool single_shard_ = false;
 };
 
 CoarseTimePoint AdjustDeadline(CoarseTimePoint deadline) {
@@ -1037,6 +1109,10 @@ void YBTransaction::ExpectOperations(size_t count) {
   impl_->ExpectOperations(count);
 }
 
+void YBTransaction::ExpectFinalFlush() {
+  impl_->ExpectFinalFlush();
+}
+
 void YBTransaction::Flushed(
     const internal::InFlightOps& ops, const ReadHybridTime& used_read_time, const Status& status) {
   impl_->Flushed(ops, used_read_time, status);
@@ -102,6 +102,12 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
   // number of ops.
   void ExpectOperations(size_t count);
 
+  // Notifies transaction that the next flush is the last one before commit.
+  // If all operations of the transaction are writes to a single tablet, flushed by this batch,
+  // then the batch is executed as a single shard operation. It is applied in one Raft round without
+  // writing provisional records, and commit does not have to contact transaction status tablet.
+  void ExpectFinalFlush();
+
   // Notifies transaction that specified ops were flushed with some status.
   void Flushed(
       const internal::InFlightOps& ops, const ReadHybridTime& used_read_time, const Status& status);
@@ -26,11 +26,16 @@
 
 #include "yb/common/transaction.h"
 
+#include "yb/master/master.pb.h"
 #include "yb/master/master_defaults.h"
 
 DEFINE_uint64(transaction_manager_workers_limit, 50,
               "Max number of workers used by transaction manager");
 
+DEFINE_bool(transaction_status_tablet_placement_affinity, true,
+            "When there is no local transaction status tablet, prefer status tablets whose leader "
+            "is in the same zone, or at least in the same region, as the client.");
+
 namespace yb {
 namespace client {
 
@@ -44,8 +49,19 @@ const YBTableName kTransactionTableName(
 // Resolved - final state, when all tablets are resolved and written to cache.
 YB_DEFINE_ENUM(TransactionTableStatus, (kExists)(kUpdating)(kResolved));
 
-void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>& tablets,
+struct TransactionTableState {
+  LocalTabletFilter local_tablet_filter;
+  std::atomic<TransactionTableStatus> status{TransactionTableStatus::kExists};
+  std::vector<TabletId> tablets;
+  // Tablets whose leader was in the same zone as the client, or in the same region, if there are
+  // no such tablets in the zone, at the moment when tablets were resolved.
+  std::vector<TabletId> placement_local_tablets;
+};
+
+void InvokeCallback(const TransactionTableState& table_state, const std::vector<TabletId>& tablets,
+                    const std::vector<TabletId>& placement_local_tablets,
                     const PickStatusTabletCallback& callback) {
+  const auto& filter = table_state.local_tablet_filter;
   if (filter) {
     std::vector<const TabletId*> ids;
     ids.reserve(tablets.size());
@@ -57,16 +73,48 @@ void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>
       callback(*RandomElement(ids));
       return;
     }
+  }
+  if (!placement_local_tablets.empty()) {
+    callback(RandomElement(placement_local_tablets));
+    return;
+  }
+  if (filter) {
     YB_LOG_EVERY_N_SECS(WARNING, 1) << "No local transaction status tablet";
   }
   callback(RandomElement(tablets));
 }
 
-struct TransactionTableState {
-  LocalTabletFilter local_tablet_filter;
-  std::atomic<TransactionTableStatus> status{TransactionTableStatus::kExists};
-  std::vector<TabletId> tablets;
-};
+bool SamePlacement(const CloudInfoPB& lhs, const CloudInfoPB& rhs, bool compare_zone) {
+  return lhs.placement_cloud() == rhs.placement_cloud() &&
+         lhs.placement_region() == rhs.placement_region() &&
+         (!compare_zone || lhs.placement_zone() == rhs.placement_zone());
+}
+
+std::vector<TabletId> PlacementLocalTablets(
+    const CloudInfoPB& cloud_info, const std::vector<master::TabletLocationsPB>& locations) {
+  std::vector<TabletId> result;
+  if (!FLAGS_transaction_status_tablet_placement_affinity || !cloud_info.has_placement_region()) {
+    return result;
+  }
+  for (bool compare_zone : {true, false}) {
+    if (compare_zone && !cloud_info.has_placement_zone()) {
+      continue;
+    }
+    for (const auto& tablet : locations) {
+      for (const auto& replica : tablet.replicas()) {
+        if (replica.role() == consensus::RaftPeerPB::LEADER &&
+            SamePlacement(cloud_info, replica.ts_info().cloud_info(), compare_zone)) {
+          result.push_back(tablet.tablet_id());
+          break;
+        }
+      }
+    }
+    if (!result.empty()) {
+      break;
+    }
+  }
+  return result;
+}
 
 // Picks status tablet for transaction.
 class PickStatusTabletTask {
@@ -80,21 +128,24 @@ class PickStatusTabletTask {
 
   void Run() {
     // TODO(dtxn) async
-    auto tablets_result = GetTransactionTableTablets();
+    std::vector<master::TabletLocationsPB> locations;
+    auto tablets_result = GetTransactionTableTablets(&locations);
     if (!tablets_result) {
       VLOG(1) << "Failed to get tablets of txn status table: " << tablets_result.status();
       callback_(tablets_result.status());
       return;
     }
     const auto tablets = std::move(*tablets_result);
+    const auto placement_local_tablets = PlacementLocalTablets(client_->cloud_info(), locations);
     auto expected = TransactionTableStatus::kExists;
     if (table_state_->status.compare_exchange_strong(
         expected, TransactionTableStatus::kUpdating, std::memory_order_acq_rel)) {
       table_state_->tablets = tablets;
+      table_state_->placement_local_tablets = placement_local_tablets;
       table_state_->status.store(TransactionTableStatus::kResolved, std::memory_order_release);
     }
 
-    InvokeCallback(table_state_->local_tablet_filter, tablets, callback_);
+    InvokeCallback(*table_state_, tablets, placement_local_tablets, callback_);
   }
 
   void Done(const Status& status) {
@@ -106,24 +157,28 @@ class PickStatusTabletTask {
   }
 
  private:
-  Result<std::vector<TabletId>> GetTransactionTableTablets() {
+  Result<std::vector<TabletId>> GetTransactionTableTablets(
+      std::vector<master::TabletLocationsPB>* locations) {
     std::vector<TabletId> tablets;
-    if (!FetchTransactionTableTablets(&tablets).ok()) {
+    if (!FetchTransactionTableTablets(&tablets, locations).ok()) {
       // Tablets for txn status table are not ready yet.
       // Wait for table creation completion and try again.
       RETURN_NOT_OK(client_->WaitForCreateTableToFinish(kTransactionTableName));
-      RETURN_NOT_OK(FetchTransactionTableTablets(&tablets));
+      RETURN_NOT_OK(FetchTransactionTableTablets(&tablets, locations));
     }
     SCHECK(!tablets.empty(), IllegalState, Format("No tablets in table $0", kTransactionTableName));
     return std::move(tablets);
   }
 
-  CHECKED_STATUS FetchTransactionTableTablets(std::vector<TabletId>* tablets) {
+  CHECKED_STATUS FetchTransactionTableTablets(
+      std::vector<TabletId>* tablets, std::vector<master::TabletLocationsPB>* locations) {
+    tablets->clear();
+    locations->clear();
     return client_->GetTablets(kTransactionTableName,
                                0 /* max_tablets */,
                                tablets,
                                nullptr /* ranges */,
-                               nullptr /* locations */,
+                               locations,
                                RequireTabletsRunning::kTrue);
   }
 
@@ -140,7 +195,8 @@ class InvokeCallbackTask {
   }
 
   void Run() {
-    InvokeCallback(table_state_->local_tablet_filter, table_state_->tablets, callback_);
+    InvokeCallback(
+        *table_state_, table_state_->tablets, table_state_->placement_local_tablets, callback_);
   }
 
   void Done(const Status& status) {
@@ -179,7 +235,8 @@ class TransactionManager::Impl {
   void PickStatusTablet(PickStatusTabletCallback callback) {
     if (table_state_.status.load(std::memory_order_acquire) == TransactionTableStatus::kResolved) {
       if (ThreadRestrictions::IsWaitAllowed()) {
-        InvokeCallback(table_state_.local_tablet_filter, table_state_.tablets, callback);
+        InvokeCallback(
+            table_state_, table_state_.tablets, table_state_.placement_local_tablets, callback);
       } else if (!invoke_callback_tasks_.Enqueue(&thread_pool_, &table_state_, callback)) {
         callback(STATUS_FORMAT(ServiceUnavailable,
                               "Invoke callback queue overflow, number of tasks: $0",
@@ -0,0 +1,136 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/client/write_coalescer.h"
+
+#include "yb/client/batcher.h"
+#include "yb/client/in_flight_op.h"
+#include "yb/client/meta_cache.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+DEFINE_int32(client_write_coalescing_window_us, 0,
+             "Time in microseconds, during which writes flushed by different sessions to the same "
+             "tablet are collected, to be sent in a single write RPC. 0 disables coalescing.");
+TAG_FLAG(client_write_coalescing_window_us, advanced);
+TAG_FLAG(client_write_coalescing_window_us, runtime);
+
+DEFINE_int32(client_write_coalescing_max_ops, 64,
+             "Coalesced writes to a tablet are sent without waiting for the end of the window, "
+             "when they contain at least this number of ops.");
+TAG_FLAG(client_write_coalescing_max_ops, advanced);
+TAG_FLAG(client_write_coalescing_max_ops, runtime);
+
+namespace yb {
+namespace client {
+namespace internal {
+
+WriteCoalescer::WriteCoalescer(rpc::Scheduler* scheduler) : scheduler_(*scheduler) {}
+
+WriteCoalescer::~WriteCoalescer() {
+  LOG_IF(DFATAL, !buckets_.empty()) << "Write coalescer destroyed with pending writes";
+}
+
+bool WriteCoalescer::Enabled() {
+  return FLAGS_client_write_coalescing_window_us > 0;
+}
+
+void WriteCoalescer::Add(BatcherPtr batcher, RemoteTablet* tablet, InFlightOps ops) {
+  Bucket full_bucket;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!shutdown_) {
+      auto& bucket = buckets_[tablet->tablet_id()];
+      if (!bucket.tablet) {
+        bucket.tablet = tablet;
+      }
+      bucket.num_ops += ops.size();
+      bucket.batches.push_back(CoalescedBatch{std::move(batcher), std::move(ops)});
+      if (bucket.num_ops < static_cast<size_t>(FLAGS_client_write_coalescing_max_ops)) {
+        if (bucket.task_id == rpc::kUninitializedScheduledTaskId) {
+          std::weak_ptr<WriteCoalescer> weak_self = shared_from_this();
+          auto tablet_id = tablet->tablet_id();
+          bucket.task_id = scheduler_.Schedule(
+              [weak_self, tablet_id](rpc::ScheduledTaskId task_id, const Status& status) {
+                auto self = weak_self.lock();
+                if (self) {
+                  self->WindowExpired(tablet_id, task_id);
+                }
+              },
+              std::chrono::microseconds(FLAGS_client_write_coalescing_window_us));
+        }
+        return;
+      }
+      if (bucket.task_id != rpc::kUninitializedScheduledTaskId) {
+        scheduler_.Abort(bucket.task_id);
+      }
+      full_bucket = std::move(bucket);
+      buckets_.erase(tablet->tablet_id());
+    } else {
+      full_bucket.tablet = tablet;
+      full_bucket.batches.push_back(CoalescedBatch{std::move(batcher), std::move(ops)});
+    }
+  }
+  Send(std::move(full_bucket));
+}
+
+void WriteCoalescer::WindowExpired(const TabletId& tablet_id, rpc::ScheduledTaskId task_id) {
+  Bucket bucket;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buckets_.find(tablet_id);
+    // Bucket could be already sent, because it was filled up, and a new window could be started.
+    if (it == buckets_.end() || it->second.task_id != task_id) {
+      return;
+    }
+    bucket = std::move(it->second);
+    buckets_.erase(it);
+  }
+  Send(std::move(bucket));
+}
+
+void WriteCoalescer::Shutdown() {
+  std::unordered_map<TabletId, Bucket> buckets;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+    buckets.swap(buckets_);
+  }
+  for (auto& p : buckets) {
+    scheduler_.Abort(p.second.task_id);
+    Send(std::move(p.second));
+  }
+}
+
+void WriteCoalescer::Send(Bucket bucket) {
+  auto& batches = bucket.batches;
+  AsyncRpcData data{batches.front().batcher, bucket.tablet.get(),
+                    false /* allow_local_calls_in_curr_thread */,
+                    false /* need_consistent_read */, HybridTime::kInvalid, {}};
+  if (batches.size() == 1) {
+    data.ops = std::move(batches.front().ops);
+  } else {
+    data.ops.reserve(bucket.num_ops);
+    for (const auto& batch : batches) {
+      data.ops.insert(data.ops.end(), batch.ops.begin(), batch.ops.end());
+    }
+    data.coalesced_batches = std::move(batches);
+  }
+  VLOG(4) << "Sending " << data.ops.size() << " coalesced ops to " << bucket.tablet->tablet_id();
+  std::make_shared<WriteRpc>(&data)->SendRpc();
+}
+
+} // namespace internal
+} // namespace client
+} // namespace yb
@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CLIENT_WRITE_COALESCER_H
+#define YB_CLIENT_WRITE_COALESCER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/client/async_rpc.h"
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids.h"
+
+#include "yb/rpc/scheduler.h"
+
+namespace yb {
+namespace client {
+namespace internal {
+
+// Merges writes flushed by concurrent batchers to the same tablet into a single WriteRpc.
+// Writes are collected during a short window, started by the first write to the tablet, or until
+// the configured number of ops is reached. Errors are still delivered to the batcher of each op.
+class WriteCoalescer : public std::enable_shared_from_this<WriteCoalescer> {
+ public:
+  explicit WriteCoalescer(rpc::Scheduler* scheduler);
+  ~WriteCoalescer();
+
+  // Whether write batches should be passed to this coalescer, instead of being sent directly.
+  static bool Enabled();
+
+  // Adds write ops of the batcher, all of them should be destined for the specified tablet.
+  void Add(BatcherPtr batcher, RemoteTablet* tablet, InFlightOps ops);
+
+  // Sends all pending writes, new writes are sent immediately after this call.
+  void Shutdown();
+
+ private:
+  struct Bucket {
+    scoped_refptr<RemoteTablet> tablet;
+    std::vector<CoalescedBatch> batches;
+    size_t num_ops = 0;
+    rpc::ScheduledTaskId task_id = rpc::kUninitializedScheduledTaskId;
+  };
+
+  void WindowExpired(const TabletId& tablet_id, rpc::ScheduledTaskId task_id);
+
+  static void Send(Bucket bucket);
+
+  rpc::Scheduler& scheduler_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, Bucket> buckets_;
+  bool shutdown_ = false;
+};
+
+} // namespace internal
+} // namespace client
+} // namespace yb
+
+#endif // YB_CLIENT_WRITE_COALESCER_H
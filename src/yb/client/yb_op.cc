@@ -132,8 +132,9 @@ const RedisResponsePB& YBRedisOp::response() const {
 }
 
 OpGroup YBRedisReadOp::group() {
-  return FLAGS_redis_allow_reads_from_followers ? OpGroup::kConsistentPrefixRead
-                                                : OpGroup::kLeaderRead;
+  return FLAGS_redis_allow_reads_from_followers ||
+         yb_consistency_level_ == YBConsistencyLevel::CONSISTENT_PREFIX
+      ? OpGroup::kConsistentPrefixRead : OpGroup::kLeaderRead;
 }
 
 // YBRedisWriteOp -----------------------------------------------------------------
@@ -483,13 +484,26 @@ std::vector<ColumnSchema> YBqlReadOp::MakeColumnSchemasFromRequest() const {
 Result<QLRowBlock> YBqlReadOp::MakeRowBlock() const {
   Schema schema(MakeColumnSchemasFromRequest(), 0);
   QLRowBlock result(schema);
-  Slice data(rows_data_);
+  Slice data = rows_data_slice();
   if (!data.empty()) {
     RETURN_NOT_OK(result.Deserialize(request().client(), &data));
   }
   return result;
 }
 
+Result<QLCompactRowBlock> YBqlReadOp::MakeCompactRowBlock() const {
+  QLCompactRowBlock result(Schema(MakeColumnSchemasFromRequest(), 0));
+  if (rows_data_holder_) {
+    if (!referenced_rows_data_.empty()) {
+      RETURN_NOT_OK(result.Deserialize(
+          request().client(), referenced_rows_data_, rows_data_holder_));
+    }
+  } else if (!rows_data_.empty()) {
+    RETURN_NOT_OK(result.Deserialize(request().client(), rows_data_));
+  }
+  return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 // YBPgsql Operators
 //--------------------------------------------------------------------------------------------------
@@ -574,7 +588,8 @@ CHECKED_STATUS SetRangePartitionBounds(const YBPgsqlReadOp& op,
       // In case of backward scan process must be start from the last partition.
       *key = op.table()->GetPartitions().back();
     }
-    key_upper_bound->clear();
+    // Upper bound set by the caller is kept, i.e. pggate bounds the scan of each tablet in a
+    // parallel ordered scan.
     return Status::OK();
   }
   auto upper_bound_key = docdb::DocKey(std::move(range_components_end)).Encode().ToStringBuffer();
@@ -688,6 +703,11 @@ YBPgsqlReadOp::YBPgsqlReadOp(const shared_ptr<YBTable>& table)
       yb_consistency_level_(YBConsistencyLevel::STRONG) {
 }
 
+OpGroup YBPgsqlReadOp::group() {
+  return yb_consistency_level_ == YBConsistencyLevel::CONSISTENT_PREFIX
+      ? OpGroup::kConsistentPrefixRead : OpGroup::kLeaderRead;
+}
+
 std::unique_ptr<YBPgsqlReadOp> YBPgsqlReadOp::NewSelect(const shared_ptr<YBTable>& table) {
   std::unique_ptr<YBPgsqlReadOp> op(new YBPgsqlReadOp(table));
   PgsqlReadRequestPB *req = op->mutable_request();
@@ -816,7 +836,7 @@ std::vector<ColumnSchema> YBPgsqlReadOp::MakeColumnSchemasFromRequest() const {
 Result<QLRowBlock> YBPgsqlReadOp::MakeRowBlock() const {
   Schema schema(MakeColumnSchemasFromRequest(), 0);
   QLRowBlock result(schema);
-  Slice data(rows_data_);
+  Slice data = rows_data_slice();
   if (!data.empty()) {
     RETURN_NOT_OK(result.Deserialize(request().client(), &data));
   }
@@ -52,6 +52,7 @@ class RedisResponsePB;
 class QLWriteRequestPB;
 class QLReadRequestPB;
 class QLResponsePB;
+class QLCompactRowBlock;
 class QLRowBlock;
 
 namespace client {
@@ -244,6 +245,16 @@ class YBRedisReadOp : public YBRedisOp {
 
   CHECKED_STATUS GetPartitionKey(std::string* partition_key) const override;
 
+  YBConsistencyLevel yb_consistency_level() const {
+    return yb_consistency_level_;
+  }
+
+  // CONSISTENT_PREFIX allows the read to be served by the closest replica, even if
+  // redis_allow_reads_from_followers is not set.
+  void set_yb_consistency_level(YBConsistencyLevel yb_consistency_level) {
+    yb_consistency_level_ = yb_consistency_level;
+  }
+
  protected:
   Type type() const override { return REDIS_READ; }
   OpGroup group() override;
@@ -251,6 +262,7 @@ class YBRedisReadOp : public YBRedisOp {
  private:
   friend class YBTable;
   std::unique_ptr<RedisReadRequestPB> redis_read_request_;
+  YBConsistencyLevel yb_consistency_level_ = YBConsistencyLevel::STRONG;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -376,9 +388,28 @@ class YBqlReadOp : public YBqlOp {
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
+  // Same as MakeRowBlock, but column values are not converted to QLValue. When rows data is
+  // referenced, the block references it too, so it is not copied at all.
+  Result<QLCompactRowBlock> MakeCompactRowBlock() const;
+
   const ReadHybridTime& read_time() const { return read_time_; }
   void SetReadTime(const ReadHybridTime& value) { read_time_ = value; }
 
+  // When set, rows data received from tablet server is not copied to rows_data(). The operation
+  // references the RPC sidecar and keeps the response alive instead, so rows data is only available
+  // via rows_data_slice() and the row blocks.
+  void set_reference_rows_data(bool value) { reference_rows_data_ = value; }
+  bool reference_rows_data() const { return reference_rows_data_; }
+
+  void SetReferencedRowsData(Slice data, std::shared_ptr<const void> holder) {
+    referenced_rows_data_ = data;
+    rows_data_holder_ = std::move(holder);
+  }
+
+  Slice rows_data_slice() const {
+    return rows_data_holder_ ? referenced_rows_data_ : Slice(rows_data_);
+  }
+
  protected:
   Type type() const override { return QL_READ; }
   OpGroup group() override;
@@ -389,6 +420,9 @@ class YBqlReadOp : public YBqlOp {
   std::unique_ptr<QLReadRequestPB> ql_read_request_;
   YBConsistencyLevel yb_consistency_level_;
   ReadHybridTime read_time_;
+  bool reference_rows_data_ = false;
+  Slice referenced_rows_data_;
+  std::shared_ptr<const void> rows_data_holder_;
 };
 
 std::vector<ColumnSchema> MakeColumnSchemasFromColDesc(
@@ -534,11 +568,26 @@ class YBPgsqlReadOp : public YBPgsqlOp {
   const ReadHybridTime& read_time() const { return read_time_; }
   void SetReadTime(const ReadHybridTime& value) { read_time_ = value; }
 
+  // Same as YBqlReadOp::set_reference_rows_data.
+  void set_reference_rows_data(bool value) { reference_rows_data_ = value; }
+  bool reference_rows_data() const { return reference_rows_data_; }
+
+  void SetReferencedRowsData(Slice data, std::shared_ptr<const void> holder) {
+    referenced_rows_data_ = data;
+    rows_data_holder_ = std::move(holder);
+  }
+
+  Slice rows_data_slice() const {
+    return rows_data_holder_ ? referenced_rows_data_ : Slice(rows_data_);
+  }
+
   static std::vector<ColumnSchema> MakeColumnSchemasFromColDesc(
       const google::protobuf::RepeatedPtrField<PgsqlRSColDescPB>& rscol_descs);
 
   bool should_add_intents(IsolationLevel isolation_level) override;
 
+  OpGroup group() override;
+
  protected:
   virtual Type type() const override { return PGSQL_READ; }
 
@@ -548,6 +597,9 @@ class YBPgsqlReadOp : public YBPgsqlOp {
   std::unique_ptr<PgsqlReadRequestPB> read_request_;
   YBConsistencyLevel yb_consistency_level_;
   ReadHybridTime read_time_;
+  bool reference_rows_data_ = false;
+  Slice referenced_rows_data_;
+  std::shared_ptr<const void> rows_data_holder_;
 };
 
 // This class is not thread-safe, though different YBNoOp objects on
@@ -86,27 +86,23 @@ char* DocHybridTime::EncodedInDocDbFormat(char* dest) const {
 
 Status DocHybridTime::DecodeFrom(Slice *slice) {
   const size_t previous_size = slice->size();
-  {
-    // Currently we just ignore the generation number as it should always be 0.
-    RETURN_NOT_OK(FastDecodeDescendingSignedVarInt(slice));
-    int64_t decoded_micros =
-        kYugaByteMicrosecondEpoch + VERIFY_RESULT(FastDecodeDescendingSignedVarInt(slice));
+  // Generation number, microseconds, logical value and shifted write id are decoded at once, since
+  // this function is called for every key visited by DocDB.
+  int64_t decoded[4];
+  RETURN_NOT_OK(FastDecodeDescendingSignedVarInts(slice, decoded, arraysize(decoded)));
 
-    int64_t decoded_logical = VERIFY_RESULT(FastDecodeDescendingSignedVarInt(slice));
-
-    hybrid_time_ = HybridTime::FromMicrosecondsAndLogicalValue(decoded_micros, decoded_logical);
-  }
-
-  const auto ptr_before_decoding_write_id = slice->data();
-  int64_t decoded_shifted_write_id = VERIFY_RESULT(FastDecodeDescendingSignedVarInt(slice));
+  // Currently we just ignore the generation number as it should always be 0.
+  hybrid_time_ = HybridTime::FromMicrosecondsAndLogicalValue(
+      kYugaByteMicrosecondEpoch + decoded[1], decoded[2]);
 
+  int64_t decoded_shifted_write_id = decoded[3];
   if (decoded_shifted_write_id < 0) {
     return STATUS_SUBSTITUTE(
         Corruption,
         "Negative decoded_shifted_write_id: $0. Was trying to decode from: $1",
         decoded_shifted_write_id,
-        Slice(ptr_before_decoding_write_id,
-              slice->data() + slice->size() - ptr_before_decoding_write_id).ToDebugHexString());
+        Slice(slice->data() - (previous_size - slice->size()),
+              slice->data() + slice->size()).ToDebugHexString());
   }
   write_id_ = (decoded_shifted_write_id >> kNumBitsForHybridTimeSize) - 1;
 
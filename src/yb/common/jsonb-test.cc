@@ -15,6 +15,7 @@
 #include <rapidjson/prettywriter.h>
 
 #include "yb/common/jsonb.h"
+#include "yb/common/ql_value.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
@@ -151,5 +152,48 @@ TEST(JsonbTest, TestArrays) {
   VerifyArray(document);
 }
 
+void AddJsonOperation(JsonOperatorPB json_operator, const std::string& key,
+                      QLJsonColumnOperationsPB* json_ops) {
+  auto* op = json_ops->add_json_operations();
+  op->set_json_operator(json_operator);
+  op->mutable_operand()->mutable_value()->set_string_value(key);
+}
+
+TEST(JsonbTest, TestApplyJsonbOperators) {
+  constexpr int kNumKeys = 100;
+  std::string json = "{";
+  for (int i = 0; i != kNumKeys; ++i) {
+    json += Format(R"#($0"k$1" : { "a" : $1, "b" : "v$1" })#", i ? ", " : "", i);
+  }
+  json += "}";
+  Jsonb jsonb;
+  ASSERT_OK(jsonb.FromString(json));
+  const Slice serialized(jsonb.SerializedJsonb());
+
+  for (int i = 0; i != kNumKeys; ++i) {
+    QLJsonColumnOperationsPB json_ops;
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, Format("k$0", i), &json_ops);
+    AddJsonOperation(JsonOperatorPB::JSON_TEXT, "b", &json_ops);
+    QLValue result;
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(serialized, json_ops, &result));
+    ASSERT_EQ(Format("v$0", i), result.string_value());
+
+    // Object result is returned as jsonb.
+    json_ops.mutable_json_operations()->RemoveLast();
+    AddJsonOperation(JsonOperatorPB::JSON_OBJECT, "a", &json_ops);
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(serialized, json_ops, &result));
+    Jsonb expected;
+    ASSERT_OK(expected.FromString(std::to_string(i)));
+    ASSERT_EQ(expected.SerializedJsonb(), result.jsonb_value());
+  }
+
+  // Missing key gives null.
+  QLJsonColumnOperationsPB json_ops;
+  AddJsonOperation(JsonOperatorPB::JSON_OBJECT, "k", &json_ops);
+  QLValue result;
+  ASSERT_OK(Jsonb::ApplyJsonbOperators(serialized, json_ops, &result));
+  ASSERT_TRUE(result.IsNull());
+}
+
 }  // namespace common
 }  // namespace yb
@@ -40,12 +40,13 @@ CHECKED_STATUS QLExprExecutor::EvalExpr(const QLExpressionPB& ql_expr,
       break;
 
     case QLExpressionPB::ExprCase::kJsonColumn: {
-      QLExprResult temp;
+      // Apply operators to the column value in place, documents could be large and usually only
+      // a small part of them is selected.
       const QLJsonColumnOperationsPB& json_ops = ql_expr.json_column();
-      RETURN_NOT_OK(table_row.ReadColumn(json_ops.column_id(), temp.Writer()));
-      common::Jsonb jsonb;
-      temp.MoveToJsonb(&jsonb);
-      RETURN_NOT_OK(jsonb.ApplyJsonbOperators(json_ops, &result_writer.NewValue()));
+      const auto* value = table_row.GetColumn(json_ops.column_id());
+      const Slice jsonb = value ? Slice(value->jsonb_value()) : Slice();
+      RETURN_NOT_OK(common::Jsonb::ApplyJsonbOperators(
+          jsonb, json_ops, &result_writer.NewValue()));
       break;
     }
 
@@ -0,0 +1,98 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/common/ql_rowblock.h"
+#include "yb/common/ql_value.h"
+
+#include "yb/util/decimal.h"
+#include "yb/util/test_macros.h"
+
+namespace yb {
+
+TEST(QLRowBlockTest, CompactRowBlock) {
+  constexpr int kRows = 10;
+
+  Schema schema({ ColumnSchema("i", INT32),
+                  ColumnSchema("s", STRING),
+                  ColumnSchema("d", DOUBLE),
+                  ColumnSchema("b", BOOL),
+                  ColumnSchema("t", TIMESTAMP),
+                  ColumnSchema("dec", DECIMAL, true /* is_nullable */) }, 0);
+  QLRowBlock row_block(schema);
+  for (int i = 0; i != kRows; ++i) {
+    auto& row = row_block.Extend();
+    row.mutable_column(0)->set_int32_value(i);
+    row.mutable_column(1)->set_string_value(Format("value_$0", i));
+    row.mutable_column(2)->set_double_value(i * 0.5);
+    row.mutable_column(3)->set_bool_value(i % 2 == 0);
+    row.mutable_column(4)->set_timestamp_value(1000000LL * i);
+    if (i % 3 != 0) {
+      row.mutable_column(5)->set_decimal_value(
+          util::Decimal(Format("$0.25", i)).EncodeToComparable());
+    }
+  }
+  faststring buffer;
+  row_block.Serialize(YQL_CLIENT_CQL, &buffer);
+
+  QLCompactRowBlock compact(schema);
+  ASSERT_OK(compact.Deserialize(YQL_CLIENT_CQL, buffer.ToString()));
+  ASSERT_EQ(static_cast<size_t>(kRows), compact.row_count());
+  for (int i = 0; i != kRows; ++i) {
+    const auto& expected = row_block.row(i);
+    const auto row = compact.row(i);
+    ASSERT_EQ(i, row.int_value(0));
+    ASSERT_EQ(Format("value_$0", i), row.bytes_value(1).ToBuffer());
+    ASSERT_EQ(i * 0.5, row.double_value(2));
+    ASSERT_EQ(i % 2 == 0, row.bool_value(3));
+    ASSERT_EQ(expected.column(4).timestamp_value().ToInt64(), row.int_value(4));
+    ASSERT_EQ(i % 3 == 0, row.IsNull(5));
+    for (size_t col_idx = 0; col_idx != schema.num_columns(); ++col_idx) {
+      QLValue value;
+      ASSERT_OK(row.GetValue(col_idx, &value));
+      ASSERT_EQ(expected.column(col_idx), value) << "Row " << i << ", column " << col_idx;
+    }
+  }
+
+  // Serialized compact row block is the same as the original serialized rows.
+  faststring compact_buffer;
+  compact.Serialize(YQL_CLIENT_CQL, &compact_buffer);
+  ASSERT_EQ(buffer.ToString(), compact_buffer.ToString());
+
+  // Truncated data is rejected.
+  QLCompactRowBlock truncated(schema);
+  ASSERT_NOK(truncated.Deserialize(
+      YQL_CLIENT_CQL, buffer.ToString().substr(0, buffer.size() - 1)));
+
+  // Referenced rows data is kept alive by its holder, not copied.
+  auto holder = std::make_shared<std::string>(buffer.ToString());
+  QLCompactRowBlock referenced(schema);
+  ASSERT_OK(referenced.Deserialize(YQL_CLIENT_CQL, Slice(*holder), holder));
+  const auto* holder_data = holder->data();
+  std::weak_ptr<std::string> weak_holder = holder;
+  holder.reset();
+  ASSERT_FALSE(weak_holder.expired());
+  ASSERT_EQ(static_cast<size_t>(kRows), referenced.row_count());
+  for (int i = 0; i != kRows; ++i) {
+    const auto value = referenced.row(i).bytes_value(1);
+    ASSERT_GE(value.cdata(), holder_data);
+    ASSERT_LT(value.cdata(), holder_data + buffer.size());
+    ASSERT_EQ(Format("value_$0", i), value.ToBuffer());
+  }
+  faststring referenced_buffer;
+  referenced.Serialize(YQL_CLIENT_CQL, &referenced_buffer);
+  ASSERT_EQ(buffer.ToString(), referenced_buffer.ToString());
+}
+
+} // namespace yb
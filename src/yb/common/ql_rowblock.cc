@@ -21,6 +21,8 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/wire_protocol.h"
 
+#include "yb/util/date_time.h"
+
 namespace yb {
 
 using std::shared_ptr;
@@ -179,4 +181,152 @@ string QLRowBlock::ZeroRowsData(const QLClient client) {
   return string(sizeof(int32_t), 0); // Encode 32-bit 0 length.
 }
 
+//---------------------------------- QL compact row block ----------------------------------
+namespace {
+
+template <class Cell>
+CHECKED_STATUS DecodeFixedWidthValue(DataType type, Slice data, Cell* cell) {
+  const size_t len = data.size();
+  switch (type) {
+    case INT8: {
+      int8_t value = 0;
+      RETURN_NOT_OK(CQLDecodeNum(len, Load8, &data, &value));
+      cell->int_value = value;
+      return Status::OK();
+    }
+    case INT16: {
+      int16_t value = 0;
+      RETURN_NOT_OK(CQLDecodeNum(len, NetworkByteOrder::Load16, &data, &value));
+      cell->int_value = value;
+      return Status::OK();
+    }
+    case INT32: {
+      int32_t value = 0;
+      RETURN_NOT_OK(CQLDecodeNum(len, NetworkByteOrder::Load32, &data, &value));
+      cell->int_value = value;
+      return Status::OK();
+    }
+    case INT64: FALLTHROUGH_INTENDED;
+    case TIME:
+      return CQLDecodeNum(len, NetworkByteOrder::Load64, &data, &cell->int_value);
+    case TIMESTAMP: {
+      int64_t value = 0;
+      RETURN_NOT_OK(CQLDecodeNum(len, NetworkByteOrder::Load64, &data, &value));
+      cell->int_value = DateTime::AdjustPrecision(value,
+                                                  DateTime::CqlInputFormat.input_precision,
+                                                  DateTime::kInternalPrecision);
+      return Status::OK();
+    }
+    case DATE: {
+      uint32_t value = 0;
+      RETURN_NOT_OK(CQLDecodeNum(len, NetworkByteOrder::Load32, &data, &value));
+      cell->int_value = value;
+      return Status::OK();
+    }
+    case BOOL: {
+      uint8_t value = 0;
+      RETURN_NOT_OK(CQLDecodeNum(len, Load8, &data, &value));
+      cell->int_value = value != 0;
+      return Status::OK();
+    }
+    case FLOAT: {
+      float value = 0;
+      RETURN_NOT_OK(CQLDecodeFloat(len, NetworkByteOrder::Load32, &data, &value));
+      cell->double_value = value;
+      return Status::OK();
+    }
+    case DOUBLE:
+      return CQLDecodeFloat(len, NetworkByteOrder::Load64, &data, &cell->double_value);
+    default:
+      // Other values are only referenced.
+      return Status::OK();
+  }
+}
+
+} // namespace
+
+Slice QLCompactRowBlock::Row::bytes_value(size_t col_idx) const {
+  const auto& c = cell(col_idx);
+  return c.size < 0 ? Slice() : Slice(block_->data().cdata() + c.offset, c.size);
+}
+
+Status QLCompactRowBlock::Row::GetValue(size_t col_idx, QLValue* value) const {
+  const auto& c = cell(col_idx);
+  if (c.size < 0) {
+    value->SetNull();
+    return Status::OK();
+  }
+  // The serialized value is preceded by its length in the rows data.
+  Slice data(block_->data().cdata() + c.offset - sizeof(int32_t), sizeof(int32_t) + c.size);
+  return value->Deserialize(block_->schema_.column(col_idx).type(), YQL_CLIENT_CQL, &data);
+}
+
+QLCompactRowBlock::QLCompactRowBlock(const Schema& schema) : schema_(schema) {
+}
+
+void QLCompactRowBlock::Serialize(const QLClient client, faststring* buffer) const {
+  CHECK_EQ(client, YQL_CLIENT_CQL);
+  CQLEncodeLength(row_count_, buffer);
+  for (const auto& cell : cells_) {
+    CQLEncodeLength(cell.size, buffer);
+    if (cell.size > 0) {
+      buffer->append(data().cdata() + cell.offset, cell.size);
+    }
+  }
+}
+
+Status QLCompactRowBlock::Deserialize(const QLClient client, std::string data) {
+  owned_data_ = std::move(data);
+  data_holder_ = nullptr;
+  external_data_ = Slice();
+  return DoDeserialize(client);
+}
+
+Status QLCompactRowBlock::Deserialize(
+    const QLClient client, Slice data, std::shared_ptr<const void> data_holder) {
+  owned_data_.clear();
+  data_holder_ = std::move(data_holder);
+  external_data_ = data;
+  return DoDeserialize(client);
+}
+
+Status QLCompactRowBlock::DoDeserialize(const QLClient client) {
+  CHECK_EQ(client, YQL_CLIENT_CQL);
+  cells_.clear();
+  row_count_ = 0;
+
+  const Slice data = this->data();
+  Slice slice = data;
+  const int32_t count = VERIFY_RESULT(CQLDecodeLength(&slice));
+  if (count < 0) {
+    return STATUS_FORMAT(Corruption, "Invalid row count: $0", count);
+  }
+  const size_t num_columns = schema_.num_columns();
+  cells_.reserve(count * num_columns);
+  for (int32_t i = 0; i < count; ++i) {
+    for (size_t col_idx = 0; col_idx < num_columns; ++col_idx) {
+      Cell cell;
+      cell.size = VERIFY_RESULT(CQLDecodeLength(&slice));
+      cell.offset = slice.data() - data.data();
+      cell.int_value = 0;
+      if (cell.size >= 0) {
+        if (static_cast<size_t>(cell.size) > slice.size()) {
+          return STATUS(NetworkError, "Truncated CQL message");
+        }
+        RETURN_NOT_OK(DecodeFixedWidthValue(
+            schema_.column(col_idx).type()->main(), Slice(slice.data(), cell.size), &cell));
+        slice.remove_prefix(cell.size);
+      } else if (cell.size != -1) {
+        return STATUS_FORMAT(Corruption, "Invalid value length: $0", cell.size);
+      }
+      cells_.push_back(cell);
+    }
+  }
+  if (!slice.empty()) {
+    return STATUS(Corruption, "Extra data at the end of row block");
+  }
+  row_count_ = count;
+  return Status::OK();
+}
+
 } // namespace yb
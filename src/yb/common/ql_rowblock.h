@@ -128,6 +128,87 @@ class QLRowBlock {
   std::vector<QLRow> rows_;
 };
 
+//----------------------------------- QL compact row block ------------------------------------
+// A block of QL rows deserialized without creating a QLValue for each column value. The block owns
+// the serialized rows data, or keeps alive the buffer it references. Fixed-width values are decoded
+// into the cells, other values are referenced as slices of the rows data, and could be converted to
+// QLValue when needed. The block is serialized back by copying the referenced data.
+class QLCompactRowBlock {
+ private:
+  struct Cell {
+    // Offset of the serialized value in rows data, and its size. Size is -1 for null.
+    uint32_t offset;
+    int32_t size;
+    // Decoded value of fixed-width types.
+    union {
+      int64_t int_value;
+      double double_value;
+    };
+  };
+
+ public:
+  class Row {
+   public:
+    bool IsNull(size_t col_idx) const { return cell(col_idx).size < 0; }
+
+    // Value of an integer, timestamp, date, time or boolean column.
+    int64_t int_value(size_t col_idx) const { return cell(col_idx).int_value; }
+
+    // Value of a float or double column.
+    double double_value(size_t col_idx) const { return cell(col_idx).double_value; }
+
+    bool bool_value(size_t col_idx) const { return cell(col_idx).int_value != 0; }
+
+    // Serialized value. It is the value itself for string and binary columns.
+    Slice bytes_value(size_t col_idx) const;
+
+    // Converts the value to QLValue, e.g. for types that have no compact form.
+    CHECKED_STATUS GetValue(size_t col_idx, QLValue* value) const;
+
+   private:
+    friend class QLCompactRowBlock;
+
+    Row(const QLCompactRowBlock* block, size_t row_idx) : block_(block), row_idx_(row_idx) {}
+
+    const Cell& cell(size_t col_idx) const {
+      return block_->cells_[row_idx_ * block_->schema_.num_columns() + col_idx];
+    }
+
+    const QLCompactRowBlock* block_;
+    size_t row_idx_;
+  };
+
+  explicit QLCompactRowBlock(const Schema& schema);
+
+  const Schema& schema() const { return schema_; }
+
+  size_t row_count() const { return row_count_; }
+
+  Row row(size_t idx) const { return Row(this, idx); }
+
+  //----------------------------- serializer / deserializer ---------------------------------
+  void Serialize(QLClient client, faststring* buffer) const;
+  CHECKED_STATUS Deserialize(QLClient client, std::string data);
+
+  // Deserializes rows data without copying it. data_holder keeps data alive while it is referenced
+  // by the block, e.g. the RPC call that received it as a sidecar.
+  CHECKED_STATUS Deserialize(
+      QLClient client, Slice data, std::shared_ptr<const void> data_holder);
+
+ private:
+  CHECKED_STATUS DoDeserialize(QLClient client);
+
+  // Serialized rows data, either owned or referenced.
+  Slice data() const { return data_holder_ ? external_data_ : Slice(owned_data_); }
+
+  Schema schema_;
+  std::string owned_data_;
+  std::shared_ptr<const void> data_holder_;
+  Slice external_data_;
+  size_t row_count_ = 0;
+  std::vector<Cell> cells_;
+};
+
 } // namespace yb
 
 #endif // YB_COMMON_QL_ROWBLOCK_H
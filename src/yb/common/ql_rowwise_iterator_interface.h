@@ -15,7 +15,9 @@
 #define YB_COMMON_QL_ROWWISE_ITERATOR_INTERFACE_H
 
 #include <memory>
+#include <vector>
 
+#include "yb/common/ql_expr.h"
 #include "yb/util/result.h"
 #include "yb/util/status.h"
 #include "yb/docdb/doc_key.h"
@@ -27,7 +29,6 @@ class PgsqlReadRequestPB;
 class PgsqlResponsePB;
 class QLReadRequestPB;
 class QLResponsePB;
-class QLTableRow;
 class Schema;
 
 namespace common {
@@ -92,8 +93,32 @@ class YQLRowwiseIteratorIf {
     return DoNextRow(schema(), table_row);
   }
 
+  // Read up to max_rows next rows using the specified projection. Rows already present in the
+  // batch are cleared and reused, so the same batch should be passed on every call to avoid
+  // reallocating the column storage. Returns the number of rows read, which is less than max_rows
+  // only when the iterator is exhausted.
+  Result<size_t> NextRowBatch(const Schema& projection, size_t max_rows,
+                              std::vector<QLTableRow>* rows) {
+    return DoNextRowBatch(projection, max_rows, rows);
+  }
+
  private:
   virtual CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) = 0;
+
+  virtual Result<size_t> DoNextRowBatch(const Schema& projection, size_t max_rows,
+                                        std::vector<QLTableRow>* rows) {
+    size_t num_rows = 0;
+    while (num_rows < max_rows && VERIFY_RESULT(HasNext())) {
+      if (num_rows == rows->size()) {
+        rows->emplace_back();
+      } else {
+        (*rows)[num_rows].Clear();
+      }
+      RETURN_NOT_OK(DoNextRow(projection, &(*rows)[num_rows]));
+      ++num_rows;
+    }
+    return num_rows;
+  }
 };
 
 }  // namespace common
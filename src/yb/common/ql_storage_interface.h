@@ -98,6 +98,16 @@ class YQLStorageIf {
                                      const ReadHybridTime& read_time,
                                      const QLValuePB& ybctid,
                                      common::YQLRowwiseIteratorIf::UniPtr* iter) const = 0;
+
+  // Create iterator for querying by several ybctids, that should be sorted in ascending order and
+  // sought with SeekTuple in that order.
+  virtual CHECKED_STATUS GetIterator(const Schema& projection,
+                                     const Schema& schema,
+                                     const TransactionOperationContextOpt& txn_op_context,
+                                     CoarseTimePoint deadline,
+                                     const ReadHybridTime& read_time,
+                                     const std::vector<Slice>& ybctids,
+                                     common::YQLRowwiseIteratorIf::UniPtr* iter) const = 0;
 };
 
 }  // namespace common
@@ -97,6 +97,9 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   }
   pb->set_is_ysql_catalog_table(is_ysql_catalog_table_);
   pb->set_is_backfilling(is_backfilling_);
+  if (HasHistoryRetentionInterval()) {
+    pb->set_history_retention_interval_sec(history_retention_interval_sec_);
+  }
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -128,6 +131,9 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   if (pb.has_is_backfilling()) {
     table_properties.SetIsBackfilling(pb.is_backfilling());
   }
+  if (pb.has_history_retention_interval_sec()) {
+    table_properties.SetHistoryRetentionIntervalSec(pb.history_retention_interval_sec());
+  }
   return table_properties;
 }
 
@@ -156,6 +162,9 @@ void TableProperties::AlterFromTablePropertiesPB(const TablePropertiesPB& pb) {
   if (pb.has_is_backfilling()) {
     SetIsBackfilling(pb.is_backfilling());
   }
+  if (pb.has_history_retention_interval_sec()) {
+    SetHistoryRetentionIntervalSec(pb.history_retention_interval_sec());
+  }
 }
 
 void TableProperties::Reset() {
@@ -168,6 +177,7 @@ void TableProperties::Reset() {
   num_tablets_ = 0;
   is_ysql_catalog_table_ = false;
   is_backfilling_ = false;
+  history_retention_interval_sec_ = kNoHistoryRetentionInterval;
 }
 
 string TableProperties::ToString() const {
@@ -180,6 +190,9 @@ string TableProperties::ToString() const {
   if (HasCopartitionTableId()) {
     result += Format("copartition_table_id: $0 ", copartition_table_id_);
   }
+  if (HasHistoryRetentionInterval()) {
+    result += Format("history_retention_interval_sec: $0 ", history_retention_interval_sec_);
+  }
   return result + Format(
       "consistency_level: $0 is_ysql_catalog_table: $1 }",
       consistency_level_,
@@ -378,7 +378,8 @@ class TableProperties {
 
     return default_time_to_live_ == other.default_time_to_live_ &&
            use_mangled_column_name_ == other.use_mangled_column_name_ &&
-           contain_counters_ == other.contain_counters_;
+           contain_counters_ == other.contain_counters_ &&
+           history_retention_interval_sec_ == other.history_retention_interval_sec_;
 
     // Ignoring num_tablets_.
     // Ignoring is_backfilling_.
@@ -414,6 +415,7 @@ class TableProperties {
     // Ignoring contain_counters_.
     // Ignoring is_backfilling_.
     // Ignoring wal_retention_secs_.
+    // Ignoring history_retention_interval_sec_.
     return true;
   }
 
@@ -493,6 +495,18 @@ class TableProperties {
     return is_ysql_catalog_table_;
   }
 
+  bool HasHistoryRetentionInterval() const {
+    return history_retention_interval_sec_ != kNoHistoryRetentionInterval;
+  }
+
+  void SetHistoryRetentionIntervalSec(int32_t history_retention_interval_sec) {
+    history_retention_interval_sec_ = history_retention_interval_sec;
+  }
+
+  int32_t history_retention_interval_sec() const {
+    return history_retention_interval_sec_;
+  }
+
   bool IsBackfilling() const { return is_backfilling_; }
 
   void SetIsBackfilling(bool is_backfilling) { is_backfilling_ = is_backfilling; }
@@ -513,6 +527,7 @@ class TableProperties {
   // is being taken into consideration when deciding whether properties between
   // two different tables are equal or equivalent.
   static const int kNoDefaultTtl = -1;
+  static const int kNoHistoryRetentionInterval = -1;
   int64_t default_time_to_live_ = kNoDefaultTtl;
   bool contain_counters_ = false;
   bool is_transactional_ = false;
@@ -523,6 +538,7 @@ class TableProperties {
   bool use_mangled_column_name_ = false;
   int num_tablets_ = 0;
   bool is_ysql_catalog_table_ = false;
+  int32_t history_retention_interval_sec_ = kNoHistoryRetentionInterval;
 };
 
 typedef uint32_t PgTableOid;
@@ -95,10 +95,14 @@ struct StatusRequest {
   const std::string* reason;
   TransactionLoadFlags flags;
   TransactionStatusCallback callback;
+  // Whether PENDING status recently received from the transaction coordinator could be used
+  // instead of requesting status again, even when it is older than read_ht.
+  bool accept_recent_pending = false;
 
   std::string ToString() const {
-    return Format("{ id: $0 read_ht: $1 global_limit_ht: $2 serial_no: $3 reason: $4 flags: $5}",
-                  *id, read_ht, global_limit_ht, serial_no, *reason, flags);
+    return Format("{ id: $0 read_ht: $1 global_limit_ht: $2 serial_no: $3 reason: $4 flags: $5 "
+                      "accept_recent_pending: $6 }",
+                  *id, read_ht, global_limit_ht, serial_no, *reason, flags, accept_recent_pending);
   }
 };
 
@@ -139,6 +143,12 @@ class TransactionStatusManager {
   // Returns minimal running hybrid time of all running transactions.
   virtual HybridTime MinRunningHybridTime() const = 0;
 
+  // Returns false only if it is known that running transactions have no strong write intents for
+  // keys in [lower_bound, upper_bound). Empty upper_bound means that there is no upper bound.
+  virtual bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const {
+    return true;
+  }
+
  private:
   friend class RequestScope;
 
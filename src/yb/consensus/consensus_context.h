@@ -45,6 +45,13 @@ class ConsensusContext {
 
   virtual bool ShouldApplyWrite() = 0;
 
+  // Called on followers before applying a sequence of committed operations, so writes of these
+  // operations could be combined. FinishApplyBatch() is called after the last operation of the
+  // sequence is applied, and before applying any operation other than a write.
+  virtual void StartApplyBatch() = 0;
+
+  virtual void FinishApplyBatch() = 0;
+
   // Performs steps to prepare request for peer.
   // For instance it could enqueue some operations to the Raft.
   //
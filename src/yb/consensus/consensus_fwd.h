@@ -23,6 +23,7 @@ namespace consensus {
 
 class Consensus;
 class ConsensusContext;
+class MultiRaftManager;
 class PeerProxyFactory;
 class PeerMessageQueue;
 class RaftConfigPB;
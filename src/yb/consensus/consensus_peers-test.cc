@@ -31,6 +31,8 @@
 //
 
 #include <chrono>
+#include <mutex>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -48,6 +50,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 #include "yb/util/threadpool.h"
@@ -56,6 +59,9 @@ using namespace std::chrono_literals;
 
 METRIC_DECLARE_entity(tablet);
 
+DECLARE_int32(consensus_max_batch_size_bytes);
+DECLARE_int32(consensus_max_pipelined_requests_per_peer);
+
 namespace yb {
 namespace consensus {
 
@@ -414,5 +420,88 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   ASSERT_LT(mock_proxy->update_count() - initial_update_count, 5);
 }
 
+// Proxy that responds to update requests with delay, so several requests could be in flight.
+class PipelinedPeerProxy : public PeerProxy {
+ public:
+  explicit PipelinedPeerProxy(ThreadPool* pool) : pool_(pool) {
+    last_received_.CopyFrom(MinimumOpId());
+  }
+
+  void UpdateAsync(const ConsensusRequestPB* request,
+                   RequestTriggerMode trigger_mode,
+                   ConsensusResponsePB* response,
+                   rpc::RpcController* controller,
+                   const rpc::ResponseCallback& callback) override {
+    response->Clear();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (OpIdLessThan(last_received_, request->preceding_id())) {
+        ConsensusErrorPB* error = response->mutable_status()->mutable_error();
+        error->set_code(ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH);
+        StatusToPB(STATUS(IllegalState, ""), error->mutable_status());
+      } else if (request->ops_size() > 0) {
+        last_received_.CopyFrom(request->ops(request->ops_size() - 1).id());
+      }
+      response->set_responder_uuid(kFollowerUuid);
+      response->set_responder_term(request->caller_term());
+      response->mutable_status()->mutable_last_received()->CopyFrom(last_received_);
+      response->mutable_status()->mutable_last_received_current_leader()->CopyFrom(
+          last_received_);
+      response->mutable_status()->set_last_committed_idx(last_received_.index());
+      max_in_flight_ = std::max(max_in_flight_, ++in_flight_);
+    }
+    CHECK_OK(pool_->SubmitFunc([this, callback] {
+      std::this_thread::sleep_for(20ms);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --in_flight_;
+      }
+      callback();
+    }));
+  }
+
+  void RequestConsensusVoteAsync(const VoteRequestPB* request,
+                                 VoteResponsePB* response,
+                                 rpc::RpcController* controller,
+                                 const rpc::ResponseCallback& callback) override {
+    LOG(FATAL) << "Not implemented";
+  }
+
+  size_t max_in_flight() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_in_flight_;
+  }
+
+ private:
+  ThreadPool* const pool_;
+  std::mutex mutex_;
+  OpIdPB last_received_;
+  size_t in_flight_ = 0;
+  size_t max_in_flight_ = 0;
+};
+
+TEST_F(ConsensusPeersTest, PipelinedRequests) {
+  constexpr int kNumOps = 50;
+  constexpr size_t kMaxPipelinedRequests = 4;
+  FLAGS_consensus_max_pipelined_requests_per_peer = kMaxPipelinedRequests;
+  FLAGS_consensus_max_batch_size_bytes = 2_KB;
+
+  auto proxy = new PipelinedPeerProxy(raft_pool_.get());
+  auto peer = ASSERT_RESULT(Peer::NewRemotePeer(
+      FakeRaftPeerPB(kFollowerUuid), kTabletId, kLeaderUuid, PeerProxyPtr(proxy),
+      message_queue_.get(), raft_pool_token_.get(), nullptr /* consensus */,
+      messenger_.get()));
+  auto se = ScopeExit([&peer] {
+    peer->Close();
+  });
+
+  AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1, kNumOps, 500 /* payload */);
+  ASSERT_OK(peer->SignalRequest(RequestTriggerMode::kAlwaysSend));
+
+  WaitForMajorityReplicatedIndex(kNumOps);
+  ASSERT_GT(proxy->max_in_flight(), 1U);
+  ASSERT_LE(proxy->max_in_flight(), kMaxPipelinedRequests);
+}
+
 }  // namespace consensus
 }  // namespace yb
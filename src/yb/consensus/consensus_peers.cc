@@ -81,6 +81,23 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms,
              "finish before returning proceding to close the Peer and return");
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
+DEFINE_bool(consensus_send_serialized_ops, true,
+            "Send operations to followers serialized by the log cache, so the same operation is "
+            "serialized once for all followers instead of once per UpdateConsensus RPC.");
+TAG_FLAG(consensus_send_serialized_ops, advanced);
+
+DEFINE_int32(consensus_max_pipelined_requests_per_peer, 1,
+             "Maximum number of UpdateConsensus requests in flight to one peer. Requests are "
+             "pipelined only when there are more operations to send than fit into one batch, "
+             "which allows lagging peers on high latency links to catch up faster.");
+TAG_FLAG(consensus_max_pipelined_requests_per_peer, advanced);
+TAG_FLAG(consensus_max_pipelined_requests_per_peer, runtime);
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, true,
+            "Send heartbeats of tablets, whose followers are on the same server, in one RPC.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, runtime);
+
 DECLARE_int32(raft_heartbeat_interval_ms);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
@@ -123,10 +140,12 @@ Peer::Peer(
       queue_(queue),
       raft_pool_token_(raft_pool_token),
       consensus_(consensus),
-      messenger_(messenger) {}
+      messenger_(messenger) {
+  calls_.push_back(std::make_unique<UpdateCall>());
+}
 
 void Peer::SetTermForTest(int term) {
-  response_.set_responder_term(term);
+  MainCall().response.set_responder_term(term);
 }
 
 Status Peer::Init() {
@@ -204,17 +223,18 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   }
 
   // The peer has no pending request nor is sending: send the request.
+  auto& request = MainCall().request;
   bool needs_remote_bootstrap = false;
   bool last_exchange_successful = false;
   RaftPeerPB::MemberType member_type = RaftPeerPB::UNKNOWN_MEMBER_TYPE;
-  int64_t commit_index_before = request_.has_committed_op_id() ?
-      request_.committed_op_id().index() : kMinimumOpIdIndex;
+  int64_t commit_index_before = request.has_committed_op_id() ?
+      request.committed_op_id().index() : kMinimumOpIdIndex;
   ReplicateMsgsHolder msgs_holder;
   Status s = queue_->RequestForPeer(
-      peer_pb_.permanent_uuid(), &request_, &msgs_holder, &needs_remote_bootstrap,
+      peer_pb_.permanent_uuid(), &request, &msgs_holder, &needs_remote_bootstrap,
       &member_type, &last_exchange_successful);
-  int64_t commit_index_after = request_.has_committed_op_id() ?
-      request_.committed_op_id().index() : kMinimumOpIdIndex;
+  int64_t commit_index_after = request.has_committed_op_id() ?
+      request.committed_op_id().index() : kMinimumOpIdIndex;
 
   if (PREDICT_FALSE(!s.ok())) {
     LOG_WITH_PREFIX(INFO) << "Could not obtain request from queue for peer: " << s;
@@ -280,13 +300,9 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     }
   }
 
-  if (request_.tablet_id().empty()) {
-    request_.set_tablet_id(tablet_id_);
-    request_.set_caller_uuid(leader_uuid_);
-    request_.set_dest_uuid(peer_pb_.permanent_uuid());
-  }
+  InitRequest(&request);
 
-  const bool req_has_ops = (request_.ops_size() > 0) || (commit_index_after > commit_index_before);
+  const bool req_has_ops = (request.ops_size() > 0) || (commit_index_after > commit_index_before);
 
   // If the queue is empty, check if we were told to send a status-only message (which is what
   // happens during heartbeats). If not, just return.
@@ -299,18 +315,81 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     heartbeater_->Snooze();
   }
 
+  std::vector<ReplicateMsgsHolder> msgs_holders;
+  msgs_holders.push_back(std::move(msgs_holder));
+  PreparePipelinedRequests(&msgs_holders);
+
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_leader_request_fraction);
 
+  // The performing lock is held by all calls sent here, and it is released by the call whose
+  // response is processed last.
+  const size_t num_calls = msgs_holders.size();
+  num_inflight_calls_.store(num_calls, std::memory_order_release);
+
   processing_lock.unlock();
   performing_lock.release();
 
-  // We will cleanup ops from request in ProcessResponse, because otherwise there could be race
-  // condition. When rest of this function is running in parallel to ProcessResponse.
-  msgs_holder.ReleaseOps();
+  for (size_t i = 0; i != num_calls; ++i) {
+    // We will cleanup ops from request in ProcessResponse, because otherwise there could be race
+    // condition. When rest of this function is running in parallel to ProcessResponse.
+    msgs_holders[i].ReleaseOps();
+    SendCall(calls_[i].get(), trigger_mode);
+  }
+}
+
+void Peer::InitRequest(ConsensusRequestPB* request) {
+  if (request->tablet_id().empty()) {
+    request->set_tablet_id(tablet_id_);
+    request->set_caller_uuid(leader_uuid_);
+    request->set_dest_uuid(peer_pb_.permanent_uuid());
+  }
+}
+
+void Peer::PreparePipelinedRequests(std::vector<ReplicateMsgsHolder>* msgs_holders) {
+  const auto& main_request = MainCall().request;
+  if (main_request.ops().empty()) {
+    return;
+  }
+  const size_t max_calls = std::max(FLAGS_consensus_max_pipelined_requests_per_peer, 1);
+  int64_t last_sent_index = main_request.ops(main_request.ops_size() - 1).id().index();
+  while (msgs_holders->size() < max_calls &&
+         queue_->PrepareNextPipelinedRequest(peer_pb_.permanent_uuid(), last_sent_index)) {
+    // New calls are allocated only when no calls are in flight, so pointers to existing calls
+    // stay valid.
+    if (calls_.size() == msgs_holders->size()) {
+      calls_.push_back(std::make_unique<UpdateCall>());
+    }
+    auto& request = calls_[msgs_holders->size()]->request;
+    ReplicateMsgsHolder msgs_holder;
+    bool needs_remote_bootstrap = false;
+    auto status = queue_->RequestForPeer(
+        peer_pb_.permanent_uuid(), &request, &msgs_holder, &needs_remote_bootstrap);
+    if (!status.ok() || needs_remote_bootstrap || request.ops().empty()) {
+      // Response to already prepared requests will find out what to do next with the peer.
+      break;
+    }
+    InitRequest(&request);
+    last_sent_index = request.ops(request.ops_size() - 1).id().index();
+    msgs_holders->push_back(std::move(msgs_holder));
+  }
+}
 
-  controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
-  proxy_->UpdateAsync(&request_, trigger_mode, &response_, &controller_,
-                      std::bind(&Peer::ProcessResponse, retain_self));
+void Peer::SendCall(UpdateCall* call, RequestTriggerMode trigger_mode) {
+  auto& request = call->request;
+  if (request.ops_size() > 0 && proxy_->SupportsSerializedOps()) {
+    // Ops are sent from buffers shared with other peers, so they should not be serialized again
+    // as a part of the request.
+    auto serialized_ops = queue_->SerializeOps(request.ops());
+    request.mutable_ops()->ExtractSubrange(0, request.ops().size(), nullptr /* elements */);
+    if (!supports_compressed_ops_.load(std::memory_order_acquire) ||
+        !queue_->CompressOps(serialized_ops, &request)) {
+      call->controller.set_serialized_request_fields(std::move(serialized_ops));
+    }
+  }
+
+  call->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  proxy_->UpdateAsync(&request, trigger_mode, &call->response, &call->controller,
+                      std::bind(&Peer::ProcessResponse, shared_from_this(), call));
 }
 
 std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
@@ -323,18 +402,35 @@ std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
   return lock;
 }
 
-void Peer::ProcessResponse() {
-  request_.mutable_ops()->ExtractSubrange(0, request_.ops().size(), nullptr /* elements */);
-
+void Peer::ProcessResponse(UpdateCall* call) {
   DCHECK(performing_mutex_.is_locked()) << "Got a response when nothing was pending";
-  Status status = controller_.status();
-  controller_.Reset();
+  bool more_pending = ProcessCallResponse(call);
+
+  if (num_inflight_calls_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    // Responses to other pipelined calls are not processed yet, the last of them will continue.
+    return;
+  }
 
   auto performing_lock = LockPerforming(std::adopt_lock);
+  if (more_pending) {
+    performing_lock.release();
+    SendNextRequest(RequestTriggerMode::kAlwaysSend);
+  }
+}
+
+bool Peer::ProcessCallResponse(UpdateCall* call) {
+  auto& request = call->request;
+  auto& response = call->response;
+  request.mutable_ops()->ExtractSubrange(0, request.ops().size(), nullptr /* elements */);
+  request.clear_compressed_ops();
+  request.clear_ops_uncompressed_size();
+
+  Status status = call->controller.status();
+  call->controller.Reset();
 
   auto processing_lock = StartProcessingUnlocked();
   if (!processing_lock.owns_lock()) {
-    return;
+    return false;
   }
 
   if (!status.ok()) {
@@ -347,26 +443,26 @@ void Peer::ProcessResponse() {
       queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
     }
     ProcessResponseError(status);
-    return;
+    return false;
   }
 
-  if (response_.has_propagated_hybrid_time()) {
-    queue_->clock()->Update(HybridTime(response_.propagated_hybrid_time()));
+  if (response.has_propagated_hybrid_time()) {
+    queue_->clock()->Update(HybridTime(response.propagated_hybrid_time()));
   }
 
   // We should try to evict a follower which returns a WRONG UUID error.
-  if (response_.has_error() &&
-      response_.error().code() == tserver::TabletServerErrorPB::WRONG_SERVER_UUID) {
+  if (response.has_error() &&
+      response.error().code() == tserver::TabletServerErrorPB::WRONG_SERVER_UUID) {
     queue_->NotifyObserversOfFailedFollower(
         peer_pb_.permanent_uuid(),
         Substitute("Leader communication with peer $0 received error $1, will try to "
                    "evict peer", peer_pb_.permanent_uuid(),
-                   response_.error().ShortDebugString()));
-    ProcessResponseError(StatusFromPB(response_.error().status()));
-    return;
+                   response.error().ShortDebugString()));
+    ProcessResponseError(StatusFromPB(response.error().status()));
+    return false;
   }
 
-  auto s = StatusFromResponse(response_);
+  auto s = StatusFromResponse(response);
   if (!s.ok() &&
       tserver::TabletServerError(s) == tserver::TabletServerErrorPB::TABLET_NOT_RUNNING &&
       tablet::RaftGroupStateError(s) == tablet::RaftGroupStatePB::FAILED) {
@@ -379,49 +475,44 @@ void Peer::ProcessResponse() {
         peer_pb_.permanent_uuid(),
         Format("Tablet in peer $0 is in FAILED state, will try to evict peer",
                peer_pb_.permanent_uuid()));
-    ProcessResponseError(StatusFromPB(response_.error().status()));
+    ProcessResponseError(StatusFromPB(response.error().status()));
   }
 
   // Response should be either error or status.
-  LOG_IF(DFATAL, response_.has_error() == response_.has_status())
-    << "Invalid response: " << response_.ShortDebugString();
+  LOG_IF(DFATAL, response.has_error() == response.has_status())
+    << "Invalid response: " << response.ShortDebugString();
 
   // Pass through errors we can respond to, like not found, since in that case
   // we will need to remotely bootstrap. TODO: Handle DELETED response once implemented.
-  if ((response_.has_error() &&
-      response_.error().code() != tserver::TabletServerErrorPB::TABLET_NOT_FOUND) ||
-      (response_.status().has_error() &&
-          response_.status().error().code() == consensus::ConsensusErrorPB::CANNOT_PREPARE)) {
+  if ((response.has_error() &&
+      response.error().code() != tserver::TabletServerErrorPB::TABLET_NOT_FOUND) ||
+      (response.status().has_error() &&
+          response.status().error().code() == consensus::ConsensusErrorPB::CANNOT_PREPARE)) {
     // Again, let the queue know that the remote is still responsive, since we will not be sending
     // this error response through to the queue.
     queue_->NotifyPeerIsResponsiveDespiteError(peer_pb_.permanent_uuid());
-    ProcessResponseError(StatusFromPB(response_.error().status()));
-    return;
+    ProcessResponseError(StatusFromPB(response.error().status()));
+    return false;
   }
 
   failed_attempts_ = 0;
-  bool more_pending = queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), response_);
-
-  if (more_pending) {
-    processing_lock.unlock();
-    performing_lock.release();
-    SendNextRequest(RequestTriggerMode::kAlwaysSend);
-  }
+  supports_compressed_ops_.store(response.supports_compressed_ops(), std::memory_order_release);
+  return queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), response);
 }
 
 Status Peer::SendRemoteBootstrapRequest() {
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(INFO, 30) << "Sending request to remotely bootstrap";
-  controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolNormal);
+  rb_controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolNormal);
   return raft_pool_token_->SubmitFunc([retain_self = shared_from_this()]() {
     retain_self->proxy_->StartRemoteBootstrap(
-      &retain_self->rb_request_, &retain_self->rb_response_, &retain_self->controller_,
+      &retain_self->rb_request_, &retain_self->rb_response_, &retain_self->rb_controller_,
       std::bind(&Peer::ProcessRemoteBootstrapResponse, retain_self));
   });
 }
 
 void Peer::ProcessRemoteBootstrapResponse() {
-  Status status = controller_.status();
-  controller_.Reset();
+  Status status = rb_controller_.status();
+  rb_controller_.Reset();
 
   auto performing_lock = LockPerforming(std::adopt_lock);
   auto processing_lock = StartProcessingUnlocked();
@@ -499,8 +590,10 @@ Peer::~Peer() {
   CHECK_EQ(state_, kPeerClosed) << "Peer cannot be implicitly closed";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr heartbeat_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      heartbeat_batcher_(std::move(heartbeat_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
@@ -509,9 +602,20 @@ void RpcPeerProxy::UpdateAsync(const ConsensusRequestPB* request,
                                rpc::RpcController* controller,
                                const rpc::ResponseCallback& callback) {
   controller->set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  // Only requests without operations are batched, so replication latency is not affected.
+  if (heartbeat_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher &&
+      trigger_mode == RequestTriggerMode::kAlwaysSend && request->ops().empty() &&
+      !request->has_compressed_ops()) {
+    heartbeat_batcher_->AddRequest(*request, response, controller, callback);
+    return;
+  }
   consensus_proxy_->UpdateConsensusAsync(*request, response, controller, callback);
 }
 
+bool RpcPeerProxy::SupportsSerializedOps() const {
+  return FLAGS_consensus_send_serialized_ops;
+}
+
 void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
@@ -544,13 +648,18 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  auto heartbeat_batcher = multi_raft_manager_
+      ? multi_raft_manager_->AddOrGetBatcher(hostport) : nullptr;
+  return std::make_unique<RpcPeerProxy>(
+      std::move(hostport), std::move(proxy), std::move(heartbeat_batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
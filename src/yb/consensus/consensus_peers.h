@@ -42,6 +42,7 @@
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/consensus_util.h"
+#include "yb/consensus/multi_raft_batcher.h"
 
 #include "yb/rpc/response_callback.h"
 #include "yb/rpc/rpc_controller.h"
@@ -173,11 +174,34 @@ class Peer : public std::enable_shared_from_this<Peer> {
   }
 
  private:
+  // State of UpdateConsensus RPC to the peer.
+  struct UpdateCall {
+    ConsensusRequestPB request;
+    ConsensusResponsePB response;
+    rpc::RpcController controller;
+  };
+
   void SendNextRequest(RequestTriggerMode trigger_mode);
 
+  void InitRequest(ConsensusRequestPB* request);
+
+  // Prepares additional requests with operations following the ones in the main request, when
+  // log has more operations than fit into one batch. Holders of their operations are appended to
+  // msgs_holders.
+  void PreparePipelinedRequests(std::vector<ReplicateMsgsHolder>* msgs_holders);
+
+  void SendCall(UpdateCall* call, RequestTriggerMode trigger_mode);
+
   // Signals that a response was received from the peer. This method does response handling that
   // requires IO or may block.
-  void ProcessResponse();
+  void ProcessResponse(UpdateCall* call);
+
+  // Handles response of the call, returns true if there are more requests pending.
+  bool ProcessCallResponse(UpdateCall* call);
+
+  UpdateCall& MainCall() {
+    return *calls_[0];
+  }
 
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
@@ -214,18 +238,25 @@ class Peer : public std::enable_shared_from_this<Peer> {
   PeerMessageQueue* queue_;
   uint64_t failed_attempts_ = 0;
 
-  // The latest consensus update request and response.
-  ConsensusRequestPB request_;
-  ConsensusResponsePB response_;
+  // Whether the peer reported that it accepts compressed ops.
+  std::atomic<bool> supports_compressed_ops_{false};
+
+  // Calls for the latest consensus update requests. The first one is used for every request, the
+  // following ones are used for pipelined requests. Only the first
+  // consensus_max_pipelined_requests_per_peer calls are used.
+  std::vector<std::unique_ptr<UpdateCall>> calls_;
+
+  // Number of calls, whose responses were not processed yet.
+  std::atomic<size_t> num_inflight_calls_{0};
 
   // The latest remote bootstrap request and response.
   StartRemoteBootstrapRequestPB rb_request_;
   StartRemoteBootstrapResponsePB rb_response_;
+  rpc::RpcController rb_controller_;
 
-  rpc::RpcController controller_;
-
-  // Held if there is an outstanding request.  This is used in order to ensure that we only have a
-  // single request outstanding at a time, and to wait for the outstanding requests at Close().
+  // Held if there are outstanding requests.  This is used in order to ensure that we only have a
+  // single group of pipelined requests outstanding at a time, and to wait for the outstanding
+  // requests at Close().
   AtomicTryMutex performing_mutex_;
 
   // Heartbeater for remote peer implementations.  This will send status only requests to the remote
@@ -292,6 +323,12 @@ class PeerProxy {
     LOG(DFATAL) << "Not implemented";
   }
 
+  // Whether UpdateAsync() could send ops, that were serialized in advance and attached to the
+  // controller, instead of ops from the request.
+  virtual bool SupportsSerializedOps() const {
+    return false;
+  }
+
   virtual ~PeerProxy() {}
 };
 
@@ -313,7 +350,9 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  // Heartbeat-only updates are sent through heartbeat_batcher, when it is specified.
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr heartbeat_batcher = nullptr);
 
   virtual void UpdateAsync(const ConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -321,6 +360,8 @@ class RpcPeerProxy : public PeerProxy {
                            rpc::RpcController* controller,
                            const rpc::ResponseCallback& callback) override;
 
+  bool SupportsSerializedOps() const override;
+
   virtual void RequestConsensusVoteAsync(const VoteRequestPB* request,
                                          VoteResponsePB* response,
                                          rpc::RpcController* controller,
@@ -346,12 +387,16 @@ class RpcPeerProxy : public PeerProxy {
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  MultiRaftHeartbeatBatcherPtr heartbeat_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  // When multi_raft_manager is specified, heartbeats of proxies created by this factory are sent
+  // through its batchers.
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -363,6 +408,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
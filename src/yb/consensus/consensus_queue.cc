@@ -49,6 +49,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_reader.h"
 #include "yb/consensus/log_util.h"
+#include "yb/consensus/ops_compression.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/raft_consensus.h"
@@ -86,6 +87,18 @@ DEFINE_int32(consensus_max_batch_size_bytes, 4_MB,
 TAG_FLAG(consensus_max_batch_size_bytes, advanced);
 TAG_FLAG(consensus_max_batch_size_bytes, runtime);
 
+DEFINE_bool(enable_consensus_ops_compression, false,
+            "Compress operations sent to followers that support it. Reduces network traffic "
+            "to remote followers at the cost of CPU on the leader and followers.");
+TAG_FLAG(enable_consensus_ops_compression, advanced);
+TAG_FLAG(enable_consensus_ops_compression, runtime);
+
+DEFINE_int32(consensus_ops_compression_min_batch_size_bytes, 64_KB,
+             "Batches of operations sent to followers are compressed only if they are at least "
+             "this large.");
+TAG_FLAG(consensus_ops_compression_min_batch_size_bytes, advanced);
+TAG_FLAG(consensus_ops_compression_min_batch_size_bytes, runtime);
+
 DEFINE_int32(follower_unavailable_considered_failed_sec, 900,
              "Seconds that a leader is unable to successfully heartbeat to a "
              "follower after which the follower is considered to be failed and "
@@ -158,6 +171,12 @@ METRIC_DEFINE_gauge_int64(tablet, in_progress_ops, "Leader Operations in Progres
                           MetricUnit::kOperations,
                           "Number of operations in the leader queue ack'd by a minority of "
                           "peers.");
+METRIC_DEFINE_counter(tablet, consensus_ops_uncompressed_bytes,
+                      "Consensus Ops Uncompressed Bytes", MetricUnit::kBytes,
+                      "Size of operations sent to peers compressed, before compression.");
+METRIC_DEFINE_counter(tablet, consensus_ops_compressed_bytes,
+                      "Consensus Ops Compressed Bytes", MetricUnit::kBytes,
+                      "Size of operations sent to peers compressed, after compression.");
 
 const auto kCDCConsumerCheckpointInterval = FLAGS_cdc_checkpoint_opid_interval_ms * 1ms;
 
@@ -185,7 +204,9 @@ void PeerMessageQueue::TrackedPeer::ResetLeaderLeases() {
   x.Instantiate(metric_entity, 0)
 PeerMessageQueue::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : num_majority_done_ops(INSTANTIATE_METRIC(METRIC_majority_done_ops)),
-    num_in_progress_ops(INSTANTIATE_METRIC(METRIC_in_progress_ops)) {
+    num_in_progress_ops(INSTANTIATE_METRIC(METRIC_in_progress_ops)),
+    ops_uncompressed_bytes(METRIC_consensus_ops_uncompressed_bytes.Instantiate(metric_entity)),
+    ops_compressed_bytes(METRIC_consensus_ops_compressed_bytes.Instantiate(metric_entity)) {
 }
 #undef INSTANTIATE_METRIC
 
@@ -197,13 +218,15 @@ PeerMessageQueue::PeerMessageQueue(const scoped_refptr<MetricEntity>& metric_ent
                                    const string& tablet_id,
                                    const server::ClockPtr& clock,
                                    ConsensusContext* context,
-                                   unique_ptr<ThreadPoolToken> raft_pool_token)
+                                   unique_ptr<ThreadPoolToken> raft_pool_token,
+                                   unique_ptr<ThreadPoolToken> log_prefetch_token)
     : raft_pool_observers_token_(std::move(raft_pool_token)),
       local_peer_pb_(local_peer_pb),
       local_peer_uuid_(local_peer_pb_.has_permanent_uuid() ? local_peer_pb_.permanent_uuid()
                                                            : string()),
       tablet_id_(tablet_id),
-      log_cache_(metric_entity, log, server_tracker, local_peer_pb.permanent_uuid(), tablet_id),
+      log_cache_(metric_entity, log, server_tracker, local_peer_pb.permanent_uuid(), tablet_id,
+                 std::move(log_prefetch_token)),
       operations_mem_tracker_(
           MemTracker::FindOrCreateTracker("OperationsFromDisk", parent_tracker)),
       metrics_(metric_entity),
@@ -692,6 +715,21 @@ Result<ReadOpsResult> PeerMessageQueue::ReadReplicatedMessagesForCDC(const yb::O
   return result;
 }
 
+bool PeerMessageQueue::PrepareNextPipelinedRequest(
+    const std::string& uuid, int64_t last_sent_index) {
+  LockGuard lock(queue_lock_);
+  auto peer = FindPtrOrNull(peers_map_, uuid);
+  if (PREDICT_FALSE(peer == nullptr || queue_state_.mode == Mode::NON_LEADER ||
+                    queue_state_.state != State::kQueueOpen || peer->needs_remote_bootstrap)) {
+    return false;
+  }
+  peer->next_index = last_sent_index + 1;
+  // Pipelined request is not a retransmission.
+  peer->last_num_messages_sent = -1;
+  peer->current_retransmissions = -1;
+  return log_cache_.HasOpBeenWritten(peer->next_index);
+}
+
 Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
                                                           StartRemoteBootstrapRequestPB* req) {
   TrackedPeer* peer = nullptr;
@@ -1080,7 +1118,12 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       // log, which is guaranteed by the Raft protocol to be a valid op.
 
       bool peer_has_prefix_of_log = IsOpInLog(yb::OpId::FromPB(status.last_received()));
-      if (peer_has_prefix_of_log) {
+      if (peer_has_prefix_of_log && !status.has_error() &&
+          status.last_received().index() < peer->last_received.index()) {
+        // Stale response to a pipelined request, the peer already acked later ops.
+        VLOG_WITH_PREFIX_UNLOCKED(2) << "Stale response from peer " << peer->ToString() << ": "
+                                     << response.ShortDebugString();
+      } else if (peer_has_prefix_of_log) {
         // If the latest thing in their log is in our log, we are in sync.
         peer->last_received = status.last_received();
         peer->next_index = peer->last_received.index() + 1;
@@ -1262,6 +1305,7 @@ void PeerMessageQueue::Close() {
     installed_num_sst_files_changed_listener_ = false;
   }
   raft_pool_observers_token_->Shutdown();
+  log_cache_.Close();
   LockGuard lock(queue_lock_);
   ClearUnlocked();
 }
@@ -1522,5 +1566,28 @@ void PeerMessageQueue::TrackOperationsMemory(const OpIds& op_ids) {
   log_cache_.TrackOperationsMemory(op_ids);
 }
 
+std::vector<RefCntBuffer> PeerMessageQueue::SerializeOps(
+    const google::protobuf::RepeatedPtrField<ReplicateMsg>& ops) {
+  return log_cache_.SerializeOps(ops);
+}
+
+bool PeerMessageQueue::CompressOps(
+    const std::vector<RefCntBuffer>& serialized_ops, ConsensusRequestPB* request) {
+  if (!FLAGS_enable_consensus_ops_compression) {
+    return false;
+  }
+  int64_t size = 0;
+  for (const auto& op : serialized_ops) {
+    size += op.size();
+  }
+  if (size < FLAGS_consensus_ops_compression_min_batch_size_bytes ||
+      !consensus::CompressOps(serialized_ops, request)) {
+    return false;
+  }
+  metrics_.ops_uncompressed_bytes->IncrementBy(size);
+  metrics_.ops_compressed_bytes->IncrementBy(request->compressed_ops().size());
+  return true;
+}
+
 }  // namespace consensus
 }  // namespace yb
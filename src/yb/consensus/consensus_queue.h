@@ -196,7 +196,8 @@ class PeerMessageQueue {
                    const std::string& tablet_id,
                    const server::ClockPtr& clock,
                    ConsensusContext* context,
-                   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token);
+                   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token,
+                   std::unique_ptr<ThreadPoolToken> log_prefetch_token = nullptr);
 
   // Initialize the queue.
   virtual void Init(const OpIdPB& last_locally_replicated);
@@ -274,6 +275,15 @@ class PeerMessageQueue {
       RaftPeerPB::MemberType* member_type = nullptr,
       bool* last_exchange_successful = nullptr);
 
+  // Moves the position of the peer after the last op sent to it, so the next RequestForPeer()
+  // continues from there without waiting for the response. Returns true if the log has ops
+  // after it.
+  //
+  // Responses to pipelined requests could arrive in any order, stale responses do not move the
+  // position back. When a pipelined request is rejected or lost, the peer responds with an error to
+  // the following request, and the position is reset as usual.
+  bool PrepareNextPipelinedRequest(const std::string& uuid, int64_t last_sent_index);
+
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
   // peer->needs_remote_bootstrap to false.
@@ -329,6 +339,9 @@ class PeerMessageQueue {
     scoped_refptr<AtomicGauge<int64_t> > num_majority_done_ops;
     // Keeps track of the number of ops. that are still in progress (IsDone() returns false).
     scoped_refptr<AtomicGauge<int64_t> > num_in_progress_ops;
+    // Size of ops sent to peers compressed, before and after compression.
+    scoped_refptr<Counter> ops_uncompressed_bytes;
+    scoped_refptr<Counter> ops_compressed_bytes;
 
     explicit Metrics(const scoped_refptr<MetricEntity>& metric_entity);
   };
@@ -365,6 +378,14 @@ class PeerMessageQueue {
   // Start memory tracking of following operations in case they are still present in our caches.
   void TrackOperationsMemory(const OpIds& op_ids);
 
+  // Returns ops of request prepared by RequestForPeer(), serialized by the log cache.
+  std::vector<RefCntBuffer> SerializeOps(
+      const google::protobuf::RepeatedPtrField<ReplicateMsg>& ops);
+
+  // Compresses serialized ops into the request, when compression is enabled and the batch is
+  // large enough. Returns true if ops were compressed.
+  bool CompressOps(const std::vector<RefCntBuffer>& serialized_ops, ConsensusRequestPB* request);
+
   const server::ClockPtr& clock() const {
     return clock_;
   }
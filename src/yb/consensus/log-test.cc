@@ -51,6 +51,7 @@
 DEFINE_int32(num_batches, 10000,
              "Number of batches to write to/read from the Log in TestWriteManyBatches");
 
+DECLARE_int32(log_max_recycled_segments);
 DECLARE_int32(log_min_segments_to_retain);
 DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
@@ -635,6 +636,68 @@ TEST_F(LogTest, TestGCWithLogRunning) {
   }
 }
 
+// Tests that GCed segments are recycled and reused as new segments.
+TEST_F(LogTest, TestGCRecyclesSegments) {
+  FLAGS_log_max_recycled_segments = 2;
+  BuildLog();
+
+  auto count_recycled = [this]() -> Result<size_t> {
+    auto files = VERIFY_RESULT(env_->GetChildren(tablet_wal_path_, ExcludeDots::kTrue));
+    return std::count_if(files.begin(), files.end(), [](const std::string& file) {
+      return HasPrefixString(file, ".tmp.recycled-");
+    });
+  };
+
+  vector<LogAnchor*> anchors;
+  ElementDeleter deleter(&anchors);
+
+  const int kNumOpsPerSegment = 5;
+  OpIdPB op_id = MakeOpId(1, 1);
+  ASSERT_OK(AppendMultiSegmentSequence(5, kNumOpsPerSegment, &op_id, &anchors));
+
+  // Release anchors of the first 3 segments, only 2 of them should be recycled.
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_OK(log_anchor_registry_->Unregister(anchors[i]));
+  }
+  int64_t anchored_index = -1;
+  ASSERT_OK(log_anchor_registry_->GetEarliestRegisteredLogIndex(&anchored_index));
+  int num_gced_segments = 0;
+  ASSERT_OK(log_->GC(anchored_index, &num_gced_segments));
+  ASSERT_EQ(3, num_gced_segments);
+  auto num_recycled = ASSERT_RESULT(count_recycled());
+  ASSERT_EQ(2, num_recycled);
+
+  // New segments reuse recycled files, and their old content is not visible.
+  ASSERT_OK(RollLog());
+  ASSERT_OK(AppendNoOps(&op_id, kNumOpsPerSegment));
+  ASSERT_OK(RollLog());
+  ASSERT_OK(AppendNoOps(&op_id, kNumOpsPerSegment));
+  num_recycled = ASSERT_RESULT(count_recycled());
+  ASSERT_EQ(0, num_recycled);
+
+  ReplicateMsgs repls;
+  const int64_t first_index = anchors[3]->log_index;
+  const int64_t last_index = op_id.index() - 1;
+  ASSERT_OK(log_->GetLogReader()->ReadReplicatesInRange(
+      first_index, last_index, LogReader::kNoSizeLimit, &repls));
+  ASSERT_EQ(last_index - first_index + 1, static_cast<int64_t>(repls.size()));
+  for (size_t i = 0; i != repls.size(); ++i) {
+    ASSERT_EQ(first_index + static_cast<int64_t>(i), repls[i]->id().index());
+  }
+
+  for (size_t i = 3; i != anchors.size(); ++i) {
+    ASSERT_OK(log_anchor_registry_->Unregister(anchors[i]));
+  }
+  ASSERT_OK(log_->GC(op_id.index(), &num_gced_segments));
+  ASSERT_OK(log_->Close());
+
+  // Recycled files left by closed log are deleted when it is opened.
+  BuildLog();
+  num_recycled = ASSERT_RESULT(count_recycled());
+  ASSERT_EQ(0, num_recycled);
+  ASSERT_OK(log_->Close());
+}
+
 // Test that, when we are set to retain a given number of log segments,
 // we also retain any relevant log index chunks, even if those operations
 // are not necessary for recovery.
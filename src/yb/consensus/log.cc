@@ -44,6 +44,7 @@
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_sync_group.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
 
@@ -52,6 +53,7 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/strings/util.h"
 #include "yb/gutil/walltime.h"
 #include "yb/util/coding.h"
 #include "yb/util/countdown_latch.h"
@@ -132,6 +134,13 @@ TAG_FLAG(log_inject_latency_ms_stddev, unsafe);
 DEFINE_int32(log_inject_append_latency_ms_max, 0,
              "The maximum latency to inject before the log append operation.");
 
+DEFINE_int32(log_max_recycled_segments, 0,
+             "Maximum number of GCed log segments kept per tablet to be reused as new segments. "
+             "Space of reused segment file is zeroed in place, instead of deleting the file and "
+             "allocating a new one. Encrypted segments are never reused. 0 disables recycling.");
+TAG_FLAG(log_max_recycled_segments, advanced);
+TAG_FLAG(log_max_recycled_segments, runtime);
+
 DEFINE_test_flag(bool, log_consider_all_ops_safe, false,
             "If true, we consider all operations to be safe and will not wait"
             "for the opId to apply to the local log. i.e. WaitForSafeOpIdToApply "
@@ -163,6 +172,7 @@ static bool dummy = google::RegisterFlagValidator(
     &FLAGS_log_min_segments_to_retain, &ValidateLogsToRetain);
 
 static const char kSegmentPlaceholderFileTemplate[] = ".tmp.newsegmentXXXXXX";
+static const char kRecycledSegmentFilePrefix[] = ".tmp.recycled-";
 
 namespace yb {
 namespace log {
@@ -537,6 +547,7 @@ Status Log::Init() {
   CHECK_EQ(kLogInitialized, log_state_);
   // Init the index
   log_index_.reset(new LogIndex(wal_dir_));
+  RETURN_NOT_OK(DeleteStaleRecycledSegments());
   // Reader for previous segments.
   RETURN_NOT_OK(LogReader::Open(get_env(),
                                 log_index_,
@@ -802,6 +813,7 @@ Status Log::DoAppend(LogEntryBatch* entry_batch,
       LongOperationTracker long_operation_tracker(
           "Log append", FLAGS_consensus_log_scoped_watch_delay_append_threshold_ms * 1ms);
 
+      ScopedWaitState wait_state(WaitState::kLogAppend);
       RETURN_NOT_OK(active_segment_->WriteEntryBatch(entry_batch_data));
     }
 
@@ -934,7 +946,12 @@ Status Log::Sync() {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
-        RETURN_NOT_OK(active_segment_->Sync());
+        ScopedWaitState wait_state(WaitState::kLogSync);
+        if (options_.sync_group) {
+          RETURN_NOT_OK(options_.sync_group->Sync(active_segment_.get()));
+        } else {
+          RETURN_NOT_OK(active_segment_->Sync());
+        }
       }
     }
   }
@@ -1121,9 +1138,13 @@ Status Log::GC(int64_t min_op_idx, int32_t* num_gced) {
           segments_to_delete[segments_to_delete.size() - 1]->header().sequence_number()));
     }
 
-    // Now that they are no longer referenced by the Log, delete the files.
+    // Now that they are no longer referenced by the Log, delete or recycle the files.
     *num_gced = 0;
     for (const scoped_refptr<ReadableLogSegment>& segment : segments_to_delete) {
+      if (VERIFY_RESULT(RecycleSegment(segment))) {
+        (*num_gced)++;
+        continue;
+      }
       LOG_WITH_PREFIX(INFO) << "Deleting log segment in path: " << segment->path()
                             << " (GCed ops < " << min_op_idx << ")";
       RETURN_NOT_OK(get_env()->DeleteFile(segment->path()));
@@ -1340,14 +1361,37 @@ Status Log::PreAllocateNewSegment() {
   // We always want to sync on close: https://github.com/yugabyte/yugabyte-db/issues/3490
   opts.sync_on_close = true;
   opts.o_direct = durable_wal_write_;
-  RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
 
-  if (options_.preallocate_segments) {
-    uint64_t next_segment_size = NextSegmentDesiredSize();
+  std::string recycled_path;
+  {
+    std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+    if (!recycled_segment_paths_.empty()) {
+      recycled_path = std::move(recycled_segment_paths_.back());
+      recycled_segment_paths_.pop_back();
+    }
+  }
+
+  uint64_t allocated_size = 0;
+  if (!recycled_path.empty()) {
+    auto status = ReuseRecycledSegment(opts, recycled_path, &allocated_size);
+    if (!status.ok()) {
+      allocated_size = 0;
+      LOG_WITH_PREFIX(WARNING) << "Failed to reuse recycled segment " << recycled_path << ": "
+                               << status;
+      WARN_NOT_OK(get_env()->DeleteFile(recycled_path), "Failed to delete recycled segment");
+    }
+  }
+
+  if (allocated_size == 0) {
+    RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
+  }
+
+  uint64_t next_segment_size = NextSegmentDesiredSize();
+  if (options_.preallocate_segments && next_segment_size > allocated_size) {
     TRACE("Preallocating $0 byte segment in $1", next_segment_size, next_segment_path_);
     // TODO (perf) zero the new segments -- this could result in additional performance
     // improvements.
-    RETURN_NOT_OK(next_segment_file_->PreAllocate(next_segment_size));
+    RETURN_NOT_OK(next_segment_file_->PreAllocate(next_segment_size - allocated_size));
   }
 
   {
@@ -1359,6 +1403,57 @@ Status Log::PreAllocateNewSegment() {
   return Status::OK();
 }
 
+Status Log::ReuseRecycledSegment(
+    const WritableFileOptions& opts, const std::string& path, uint64_t* allocated_size) {
+  *allocated_size = VERIFY_RESULT(get_env()->GetFileSize(path));
+  WritableFileOptions reuse_opts = opts;
+  reuse_opts.mode = Env::REUSE_EXISTING;
+  std::unique_ptr<WritableFile> segment_file;
+  RETURN_NOT_OK(get_env()->NewWritableFile(reuse_opts, path, &segment_file));
+  VLOG_WITH_PREFIX(1) << "Reusing recycled segment as next WAL segment: " << path;
+  next_segment_path_ = path;
+  next_segment_file_.reset(segment_file.release());
+  return Status::OK();
+}
+
+Result<bool> Log::RecycleSegment(const scoped_refptr<ReadableLogSegment>& segment) {
+  // Segment that is still referenced could be read, so it cannot be overwritten.
+  if (!segment->HasOneRef() || segment->file_size() == 0 ||
+      segment->readable_file()->IsEncrypted()) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+    if (recycled_segment_paths_.size() >=
+            static_cast<size_t>(std::max(FLAGS_log_max_recycled_segments, 0))) {
+      return false;
+    }
+  }
+
+  auto path = JoinPathSegments(
+      wal_dir_, Format("$0$1", kRecycledSegmentFilePrefix, segment->header().sequence_number()));
+  LOG_WITH_PREFIX(INFO) << "Recycling log segment in path: " << segment->path() << " as " << path;
+  RETURN_NOT_OK(get_env()->RenameFile(segment->path(), path));
+  std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+  recycled_segment_paths_.push_back(std::move(path));
+  return true;
+}
+
+Status Log::DeleteStaleRecycledSegments() {
+  std::vector<std::string> children;
+  auto status = get_env()->GetChildren(wal_dir_, ExcludeDots::kTrue, &children);
+  if (status.IsNotFound()) {
+    return Status::OK();
+  }
+  RETURN_NOT_OK(status);
+  for (const auto& child : children) {
+    if (HasPrefixString(child, kRecycledSegmentFilePrefix)) {
+      RETURN_NOT_OK(get_env()->DeleteFile(JoinPathSegments(wal_dir_, child)));
+    }
+  }
+  return Status::OK();
+}
+
 Status Log::SwitchToAllocatedSegment() {
   CHECK_EQ(allocation_state(), kAllocationFinished);
 
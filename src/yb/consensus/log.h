@@ -361,6 +361,18 @@ class Log : public RefCountedThreadSafe<Log> {
   // Preallocates the space for a new segment.
   CHECKED_STATUS PreAllocateNewSegment();
 
+  // Opens recycled segment file at 'path' as the next segment. Sets 'allocated_size' to the size
+  // of space, that file already has.
+  CHECKED_STATUS ReuseRecycledSegment(
+      const WritableFileOptions& opts, const std::string& path, uint64_t* allocated_size);
+
+  // Keeps file of the GCed segment to be reused as a new segment. Returns false if segment
+  // should be deleted instead.
+  Result<bool> RecycleSegment(const scoped_refptr<ReadableLogSegment>& segment);
+
+  // Deletes recycled segment files, left by previous run of the log in wal_dir_.
+  CHECKED_STATUS DeleteStaleRecycledSegments();
+
   // Returns the desired size for the next log segment to be created.
   uint64_t NextSegmentDesiredSize();
 
@@ -507,6 +519,10 @@ class Log : public RefCountedThreadSafe<Log> {
   std::atomic<SegmentAllocationState> allocation_state_;
   bool allocation_requested_ GUARDED_BY(allocation_mutex_) = false;
 
+  // Paths of GCed segment files, that are kept to be reused as new segments.
+  std::mutex recycled_segments_mutex_;
+  std::vector<std::string> recycled_segment_paths_ GUARDED_BY(recycled_segments_mutex_);
+
   scoped_refptr<MetricEntity> metric_entity_;
   gscoped_ptr<LogMetrics> metrics_;
 
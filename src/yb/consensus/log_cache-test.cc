@@ -117,12 +117,14 @@ class LogCacheTest : public YBTest {
     ASSERT_OK(log_->WaitUntilAllFlushed());
   }
 
-  void CloseAndReopenCache(const OpIdPB& preceding_id) {
+  void CloseAndReopenCache(const OpIdPB& preceding_id,
+                           std::unique_ptr<ThreadPoolToken> prefetch_token = nullptr) {
     // Blow away the memtrackers before creating the new cache.
     cache_.reset();
 
     cache_.reset(new LogCache(
-        metric_entity_, log_.get(), nullptr /* mem_tracker */, kPeerUuid, kTestTablet));
+        metric_entity_, log_.get(), nullptr /* mem_tracker */, kPeerUuid, kTestTablet,
+        std::move(prefetch_token)));
     cache_->Init(preceding_id);
   }
 
@@ -345,6 +347,75 @@ TEST_F(LogCacheTest, TestReplaceMessages) {
             cache_->ToString());
 }
 
+TEST_F(LogCacheTest, SerializeOps) {
+  const int kNumOps = 3;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumOps, 100));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 8_MB));
+  ASSERT_EQ(kNumOps, read_result.messages.size());
+
+  ConsensusRequestPB request;
+  for (const auto& msg : read_result.messages) {
+    request.mutable_ops()->AddAllocated(msg.get());
+  }
+  auto size_before = cache_->metrics_.size->value();
+  auto serialized = cache_->SerializeOps(request.ops());
+  ASSERT_EQ(kNumOps, serialized.size());
+  int64_t serialized_size = 0;
+  std::string buffer;
+  for (const auto& op : serialized) {
+    serialized_size += op.size();
+    buffer.append(op.data(), op.size());
+  }
+  ASSERT_EQ(size_before + serialized_size, cache_->metrics_.size->value());
+
+  // Serialized ops are parsed as ops of the request.
+  ConsensusRequestPB parsed;
+  ASSERT_TRUE(parsed.ParseFromString(buffer));
+  ASSERT_EQ(kNumOps, parsed.ops_size());
+  for (int i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(request.ops(i).SerializeAsString(), parsed.ops(i).SerializeAsString());
+  }
+
+  // The same buffers are returned for the next peer.
+  auto serialized_again = cache_->SerializeOps(request.ops());
+  for (int i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(serialized[i].data(), serialized_again[i].data());
+  }
+  ASSERT_EQ(size_before + serialized_size, cache_->metrics_.size->value());
+
+  request.mutable_ops()->ExtractSubrange(0, request.ops_size(), nullptr /* elements */);
+}
+
+// Tests that ops following the ones read from disk are read ahead in background, so the next read
+// does not hit disk.
+TEST_F(LogCacheTest, Prefetch) {
+  constexpr int kNumOps = 20;
+  std::unique_ptr<ThreadPool> prefetch_pool;
+  ASSERT_OK(ThreadPoolBuilder("prefetch").Build(&prefetch_pool));
+  CloseAndReopenCache(MinimumOpId(), prefetch_pool->NewToken(ThreadPool::ExecutionMode::SERIAL));
+
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumOps));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(kNumOps);
+  ASSERT_EQ(0, cache_->metrics_.num_ops->value());
+
+  // Only the first op fits the size limit.
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, 1));
+  ASSERT_EQ(1, read_result.messages.size());
+  ASSERT_OK(WaitFor([this] {
+    return cache_->metrics_.disk_reads->value() >= kNumOps;
+  }, 10s, "Read ahead"));
+  auto disk_reads = cache_->metrics_.disk_reads->value();
+
+  read_result = ASSERT_RESULT(cache_->ReadOps(1, 8_MB));
+  ASSERT_EQ(kNumOps - 1, read_result.messages.size());
+  EXPECT_EQ(OpIdStrForIndex(2), OpIdToString(read_result.messages[0]->id()));
+  ASSERT_EQ(disk_reads, cache_->metrics_.disk_reads->value());
+
+  cache_.reset();
+}
+
 TEST_F(LogCacheTest, TestMTReadAndWrite) {
   atomic<bool> stop { false };
   bool stopped = false;
@@ -38,6 +38,7 @@
 #include <vector>
 
 #include <gflags/gflags.h>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/wire_format_lite.h>
 #include <google/protobuf/wire_format_lite_inl.h>
 
@@ -57,6 +58,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 
 using namespace std::literals;
 
@@ -72,6 +74,12 @@ DEFINE_int32(global_log_cache_size_limit_mb, 1024,
              "caching log entries across all tablets is kept under this threshold.");
 TAG_FLAG(global_log_cache_size_limit_mb, advanced);
 
+DEFINE_int64(log_cache_prefetch_size_bytes, 8_MB,
+             "Size of ops evicted from the log cache, that are read ahead from disk in "
+             "background for lagging peers. 0 disables read ahead.");
+TAG_FLAG(log_cache_prefetch_size_bytes, advanced);
+TAG_FLAG(log_cache_prefetch_size_bytes, runtime);
+
 DEFINE_test_flag(bool, log_cache_skip_eviction, false,
                  "Don't evict log entries in tests.");
 
@@ -94,6 +102,15 @@ namespace {
 
 const std::string kParentMemTrackerId = "log_cache"s;
 
+// Calculate the total byte size that will be used on the wire to replicate this message as part of
+// a consensus update request. This accounts for the length delimiting and tagging of the message.
+int64_t TotalByteSizeForMessage(const ReplicateMsg& msg) {
+  int msg_size = google::protobuf::internal::WireFormatLite::LengthDelimitedSize(
+    msg.ByteSize());
+  msg_size += 1; // for the type tag
+  return msg_size;
+}
+
 }
 
 typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
@@ -102,12 +119,14 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
                    const scoped_refptr<log::Log>& log,
                    const MemTrackerPtr& server_tracker,
                    const string& local_uuid,
-                   const string& tablet_id)
+                   const string& tablet_id,
+                   std::unique_ptr<ThreadPoolToken> prefetch_token)
   : log_(log),
     local_uuid_(local_uuid),
     tablet_id_(tablet_id),
     next_sequential_op_index_(0),
     min_pinned_op_index_(0),
+    prefetch_token_(std::move(prefetch_token)),
     metrics_(metric_entity) {
 
   const int64_t max_ops_size_bytes = FLAGS_log_cache_size_limit_mb * 1_MB;
@@ -135,6 +154,7 @@ MemTrackerPtr LogCache::GetServerMemTracker(const MemTrackerPtr& server_tracker)
 }
 
 LogCache::~LogCache() {
+  Close();
   tracker_->Release(tracker_->consumption());
   cache_.clear();
 
@@ -178,6 +198,11 @@ Result<LogCache::PrepareAppendResult> LogCache::PrepareAppendOperations(const Re
         cache_.erase(it);
       }
     }
+    ++prefetch_generation_;
+    for (auto it = prefetched_.lower_bound(first_idx_in_batch); it != prefetched_.end();) {
+      prefetched_bytes_ -= TotalByteSizeForMessage(*it->second);
+      it = prefetched_.erase(it);
+    }
   }
 
   for (auto& e : entries_to_insert) {
@@ -263,13 +288,20 @@ Result<yb::OpId> LogCache::LookupOpId(int64_t op_index) const {
 
 namespace {
 
-// Calculate the total byte size that will be used on the wire to replicate this message as part of
-// a consensus update request. This accounts for the length delimiting and tagging of the message.
-int64_t TotalByteSizeForMessage(const ReplicateMsg& msg) {
-  int msg_size = google::protobuf::internal::WireFormatLite::LengthDelimitedSize(
-    msg.ByteSize());
-  msg_size += 1; // for the type tag
-  return msg_size;
+RefCntBuffer SerializeOp(const ReplicateMsg& msg) {
+  using google::protobuf::internal::WireFormatLite;
+  using google::protobuf::io::CodedOutputStream;
+
+  const uint32_t tag = WireFormatLite::MakeTag(
+      ConsensusRequestPB::kOpsFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  const uint32_t msg_size = msg.ByteSize();
+  RefCntBuffer result(CodedOutputStream::VarintSize32(tag) +
+                      CodedOutputStream::VarintSize32(msg_size) + msg_size);
+  auto* out = CodedOutputStream::WriteVarint32ToArray(tag, result.udata());
+  out = CodedOutputStream::WriteVarint32ToArray(msg_size, out);
+  out = msg.SerializeWithCachedSizesToArray(out);
+  DCHECK_EQ(out, result.uend());
+  return result;
 }
 
 } // anonymous namespace
@@ -312,17 +344,20 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         up_to = std::min(iter->first - 1, static_cast<uint64_t>(to_index - 1));
       }
 
-      l.unlock();
-
       ReplicateMsgs raw_replicate_ptrs;
-      RETURN_NOT_OK_PREPEND(
-        log_->GetLogReader()->ReadReplicatesInRange(
-            next_index, up_to, remaining_space, &raw_replicate_ptrs),
-        Substitute("Failed to read ops $0..$1", next_index, up_to));
-      metrics_.disk_reads->IncrementBy(raw_replicate_ptrs.size());
-      LOG_WITH_PREFIX_UNLOCKED(INFO)
-          << "Successfully read " << raw_replicate_ptrs.size() << " ops from disk.";
-      l.lock();
+      TakePrefetchedUnlocked(next_index, up_to, &raw_replicate_ptrs);
+      if (raw_replicate_ptrs.empty()) {
+        l.unlock();
+
+        RETURN_NOT_OK_PREPEND(
+          log_->GetLogReader()->ReadReplicatesInRange(
+              next_index, up_to, remaining_space, &raw_replicate_ptrs),
+          Substitute("Failed to read ops $0..$1", next_index, up_to));
+        metrics_.disk_reads->IncrementBy(raw_replicate_ptrs.size());
+        LOG_WITH_PREFIX_UNLOCKED(INFO)
+            << "Successfully read " << raw_replicate_ptrs.size() << " ops from disk.";
+        l.lock();
+      }
 
       for (auto& msg : raw_replicate_ptrs) {
         CHECK_EQ(next_index, msg->id().index());
@@ -335,9 +370,13 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
           next_index++;
         } else {
           result.have_more_messages = true;
+          break;
         }
       }
 
+      ErasePrefetchedUnlocked(next_index);
+      MaybeStartPrefetchUnlocked(next_index);
+
     } else {
       // Pull contiguous messages from the cache until the size limit is achieved.
       for (; iter != cache_.end(); ++iter) {
@@ -366,6 +405,84 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
   return result;
 }
 
+void LogCache::TakePrefetchedUnlocked(
+    int64_t from_index, int64_t to_index, ReplicateMsgs* msgs) {
+  for (auto it = prefetched_.find(from_index);
+       it != prefetched_.end() && it->first == from_index && from_index <= to_index;
+       ++it, ++from_index) {
+    msgs->push_back(it->second);
+  }
+}
+
+void LogCache::ErasePrefetchedUnlocked(int64_t index) {
+  auto end = prefetched_.lower_bound(index);
+  for (auto it = prefetched_.begin(); it != end;) {
+    prefetched_bytes_ -= TotalByteSizeForMessage(*it->second);
+    it = prefetched_.erase(it);
+  }
+}
+
+void LogCache::MaybeStartPrefetchUnlocked(int64_t index) {
+  const int64_t limit = FLAGS_log_cache_prefetch_size_bytes;
+  // Start read ahead only when the previous one was mostly consumed, so ops are read by large
+  // ranges.
+  if (!prefetch_token_ || prefetch_running_ || limit <= 0 || prefetched_bytes_ > limit / 2) {
+    return;
+  }
+  if (!prefetched_.empty()) {
+    index = std::max<int64_t>(index, prefetched_.rbegin()->first + 1);
+  }
+  // Ops that are present in the cache don't need read ahead.
+  auto it = cache_.lower_bound(index);
+  int64_t to_index = it != cache_.end() ? static_cast<int64_t>(it->first) - 1
+                                        : next_sequential_op_index_ - 1;
+  if (index > to_index) {
+    return;
+  }
+
+  prefetch_running_ = true;
+  auto status = prefetch_token_->SubmitFunc(std::bind(
+      &LogCache::Prefetch, this, index, to_index, limit - prefetched_bytes_,
+      prefetch_generation_));
+  if (!status.ok()) {
+    prefetch_running_ = false;
+    VLOG_WITH_PREFIX_UNLOCKED(1) << "Failed to start read ahead: " << status;
+  }
+}
+
+void LogCache::Prefetch(
+    int64_t from_index, int64_t to_index, int64_t max_bytes, uint64_t generation) {
+  ReplicateMsgs msgs;
+  auto status = log_->GetLogReader()->ReadReplicatesInRange(
+      from_index, to_index, max_bytes, &msgs);
+  metrics_.disk_reads->IncrementBy(msgs.size());
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  prefetch_running_ = false;
+  if (!status.ok()) {
+    LOG_WITH_PREFIX_UNLOCKED(WARNING) << "Failed to read ahead ops " << from_index << ".."
+                                      << to_index << ": " << status;
+    return;
+  }
+  if (generation != prefetch_generation_) {
+    return;
+  }
+  VLOG_WITH_PREFIX_UNLOCKED(1) << "Read ahead " << msgs.size() << " ops from " << from_index;
+  for (auto& msg : msgs) {
+    auto index = msg->id().index();
+    auto size = TotalByteSizeForMessage(*msg);
+    if (prefetched_.emplace(index, std::move(msg)).second) {
+      prefetched_bytes_ += size;
+    }
+  }
+}
+
+void LogCache::Close() {
+  if (prefetch_token_) {
+    prefetch_token_->Shutdown();
+  }
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   std::lock_guard<simple_spinlock> lock(lock_);
   return EvictSomeUnlocked(index, bytes_to_evict);
@@ -502,6 +619,57 @@ void LogCache::DumpToHtml(std::ostream& out) const {
   out << "</table>";
 }
 
+std::vector<RefCntBuffer> LogCache::SerializeOps(
+    const google::protobuf::RepeatedPtrField<ReplicateMsg>& ops) {
+  std::vector<RefCntBuffer> result(ops.size());
+  std::vector<int> missing;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    for (int i = 0; i != ops.size(); ++i) {
+      auto it = cache_.find(ops.Get(i).id().index());
+      if (it != cache_.end() && it->second.msg.get() == &ops.Get(i) && it->second.serialized) {
+        result[i] = it->second.serialized;
+      } else {
+        missing.push_back(i);
+      }
+    }
+  }
+
+  if (missing.empty()) {
+    return result;
+  }
+
+  // Serialization is relatively expensive, so do it outside the lock.
+  for (auto i : missing) {
+    result[i] = SerializeOp(ops.Get(i));
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  int64_t mem_required = 0;
+  int64_t tracked_mem_required = 0;
+  for (auto i : missing) {
+    auto it = cache_.find(ops.Get(i).id().index());
+    // Operation could be evicted or replaced meanwhile, or serialized by concurrent call.
+    if (it == cache_.end() || it->second.msg.get() != &ops.Get(i) || it->second.serialized) {
+      continue;
+    }
+    auto& entry = it->second;
+    entry.serialized = result[i];
+    int64_t size = entry.serialized.size();
+    entry.mem_usage += size;
+    mem_required += size;
+    if (entry.tracked) {
+      tracked_mem_required += size;
+    }
+  }
+  metrics_.size->IncrementBy(mem_required);
+  if (tracked_mem_required) {
+    tracker_->Consume(tracked_mem_required);
+  }
+
+  return result;
+}
+
 void LogCache::TrackOperationsMemory(const OpIds& op_ids) {
   if (op_ids.empty()) {
     return;
@@ -47,6 +47,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/result.h"
 
@@ -54,6 +55,7 @@ namespace yb {
 
 class MetricEntity;
 class MemTracker;
+class ThreadPoolToken;
 
 namespace log {
 class Log;
@@ -82,7 +84,8 @@ class LogCache {
            const scoped_refptr<log::Log>& log,
            const std::shared_ptr<MemTracker>& server_tracker,
            const std::string& local_uuid,
-           const std::string& tablet_id);
+           const std::string& tablet_id,
+           std::unique_ptr<ThreadPoolToken> prefetch_token = nullptr);
   ~LogCache();
 
   static std::shared_ptr<MemTracker> GetServerMemTracker(
@@ -107,7 +110,9 @@ class LogCache {
   //
   // If the ops being requested are not available in the log, this will synchronously read these ops
   // from disk. Therefore, this function may take a substantial amount of time and should not be
-  // called with important locks held, etc.
+  // called with important locks held, etc. After such read, following ops are read ahead in
+  // background, when prefetch token was provided, so subsequent calls for the lagging peer do not
+  // wait for disk.
   Result<ReadOpsResult> ReadOps(int64_t after_op_index,
                                 int max_size_bytes);
 
@@ -119,6 +124,12 @@ class LogCache {
                                 int64_t to_op_index,
                                 int max_size_bytes);
 
+  // Returns operations serialized as ops field of ConsensusRequestPB, one buffer per operation.
+  // Serialized operations are kept in the cache, so the same operation sent to several peers is
+  // serialized only once.
+  std::vector<RefCntBuffer> SerializeOps(
+      const google::protobuf::RepeatedPtrField<ReplicateMsg>& ops);
+
   // Append the operations into the log and the cache.  When the messages have completed writing
   // into the on-disk log, fires 'callback'.
   //
@@ -174,10 +185,14 @@ class LogCache {
 
   CHECKED_STATUS CopyLogTo(const std::string& dest_dir);
 
+  // Waits for running read ahead to finish and stops starting new ones.
+  void Close();
+
  private:
   FRIEND_TEST(LogCacheTest, TestAppendAndGetMessages);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimit);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, SerializeOps);
   friend class LogCacheTest;
 
   // An entry in the cache.
@@ -187,6 +202,10 @@ class LogCache {
     // to compute, so we compute it only once upon insertion.
     int64_t mem_usage;
 
+    // msg serialized as ops field of ConsensusRequestPB, filled when msg is sent to peers for the
+    // first time. Its size is included into mem_usage.
+    RefCntBuffer serialized;
+
     // Did we start memory tracking for this entry.
     bool tracked = false;
   };
@@ -220,6 +239,17 @@ class LogCache {
 
   Result<PrepareAppendResult> PrepareAppendOperations(const ReplicateMsgs& msgs);
 
+  // Appends to 'msgs' contiguous prefetched ops starting from 'from_index' up to 'to_index'.
+  void TakePrefetchedUnlocked(int64_t from_index, int64_t to_index, ReplicateMsgs* msgs);
+
+  // Removes prefetched ops with index less than 'index'.
+  void ErasePrefetchedUnlocked(int64_t index);
+
+  // Starts reading ahead ops, that are not in the cache, following 'index'.
+  void MaybeStartPrefetchUnlocked(int64_t index);
+
+  void Prefetch(int64_t from_index, int64_t to_index, int64_t max_bytes, uint64_t generation);
+
   scoped_refptr<log::Log> const log_;
 
   // The UUID of the local peer.
@@ -256,6 +286,17 @@ class LogCache {
   // A MemTracker for this instance.
   std::shared_ptr<MemTracker> tracker_;
 
+  // Token used to read ahead ops that were evicted from the cache, for lagging peers.
+  std::unique_ptr<ThreadPoolToken> prefetch_token_;
+
+  // Ops read ahead from disk, they are not a part of the cache and are bounded separately by
+  // log_cache_prefetch_size_bytes. Protected by lock_.
+  std::map<int64_t, ReplicateMsgPtr> prefetched_;
+  int64_t prefetched_bytes_ = 0;
+  bool prefetch_running_ = false;
+  // Incremented when ops are replaced in the log, so ops read ahead before that are dropped.
+  uint64_t prefetch_generation_ = 0;
+
   struct Metrics {
     explicit Metrics(const scoped_refptr<MetricEntity>& metric_entity);
 
@@ -155,13 +155,13 @@ Status LogIndex::IndexChunk::Open() {
 
   int err;
   RETRY_ON_EINTR(err, ftruncate(fd_, kChunkFileSize));
-  RETURN_NOT_OK(CheckError(fd_, "truncate"));
+  RETURN_NOT_OK(CheckError(err, "truncate"));
 
-  mapping_ = static_cast<uint8_t*>(mmap(nullptr, kChunkFileSize, PROT_READ | PROT_WRITE,
-                                        MAP_SHARED, fd_, 0));
-  if (mapping_ == nullptr) {
-    return STATUS(IOError, "Unable to mmap()", Errno(err));
+  void* mapping = mmap(nullptr, kChunkFileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (mapping == MAP_FAILED) {
+    return STATUS(IOError, "Unable to mmap()", Errno(errno));
   }
+  mapping_ = static_cast<uint8_t*>(mapping);
 
   return Status::OK();
 }
@@ -0,0 +1,132 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include "yb/consensus/log_sync_group.h"
+#include "yb/consensus/log_util.h"
+
+#include "yb/util/env.h"
+#include "yb/util/path_util.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(log_sync_group_max_delay_us);
+
+namespace yb {
+namespace log {
+
+namespace {
+
+// Counts file system syncs, that are slow enough to let concurrent requests pile up.
+class FileSystemSyncEnv : public EnvWrapper {
+ public:
+  explicit FileSystemSyncEnv(Env* target) : EnvWrapper(target) {}
+
+  CHECKED_STATUS SyncFileSystem(const std::string& path) override {
+    ++num_syncs;
+    std::this_thread::sleep_for(5ms);
+    return sync_status;
+  }
+
+  std::atomic<uint64_t> num_syncs{0};
+  Status sync_status;
+};
+
+} // namespace
+
+class LogSyncGroupTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    env_ = std::make_unique<FileSystemSyncEnv>(Env::Default());
+  }
+
+  std::unique_ptr<WritableLogSegment> CreateSegment(int idx) {
+    auto path = JoinPathSegments(GetTestDataDirectory(), Format("segment-$0", idx));
+    std::unique_ptr<WritableFile> file;
+    CHECK_OK(env_->NewWritableFile(path, &file));
+    CHECK_OK(file->Append(Slice("data")));
+    return std::make_unique<WritableLogSegment>(path, std::move(file));
+  }
+
+  // Syncs segments from multiple threads, returns total number of sync requests.
+  uint64_t SyncConcurrently(LogSyncGroup* group, const Status& expected_status) {
+    constexpr int kNumThreads = 8;
+    constexpr int kSyncsPerThread = 20;
+    std::vector<std::thread> threads;
+    for (int i = 0; i != kNumThreads; ++i) {
+      threads.emplace_back([this, group, i, &expected_status] {
+        auto segment = CreateSegment(i);
+        for (int j = 0; j != kSyncsPerThread; ++j) {
+          auto status = group->Sync(segment.get());
+          EXPECT_EQ(expected_status.CodeAsString(), status.CodeAsString()) << status;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return kNumThreads * kSyncsPerThread;
+  }
+
+  std::unique_ptr<FileSystemSyncEnv> env_;
+};
+
+TEST_F(LogSyncGroupTest, CombineSyncs) {
+  LogSyncGroups groups(env_.get());
+  auto* group = groups.Get(GetTestDataDirectory());
+  ASSERT_EQ(group, groups.Get(GetTestDataDirectory()));
+
+  auto num_requests = SyncConcurrently(group, Status::OK());
+  const auto num_syncs = env_->num_syncs.load();
+  ASSERT_EQ(num_syncs, group->num_file_system_syncs());
+  ASSERT_GT(num_syncs, 0U);
+  // Requests that arrive while file system sync is running are combined into the next sync.
+  ASSERT_LT(num_syncs, num_requests);
+}
+
+TEST_F(LogSyncGroupTest, AdaptiveDelay) {
+  FLAGS_log_sync_group_max_delay_us = 100000;
+  LogSyncGroup group(env_.get(), GetTestDataDirectory());
+
+  auto num_requests = SyncConcurrently(&group, Status::OK());
+  // Delay is bounded by half of the observed sync latency, not by the flag.
+  ASSERT_GE(group.TEST_AverageSyncLatency().ToMilliseconds(), 5);
+  ASSERT_LT(env_->num_syncs.load() * 2, num_requests);
+}
+
+TEST_F(LogSyncGroupTest, FallbackWhenNotSupported) {
+  env_->sync_status = STATUS(NotSupported, "");
+  LogSyncGroup group(env_.get(), GetTestDataDirectory());
+
+  SyncConcurrently(&group, Status::OK());
+  ASSERT_EQ(0U, group.num_file_system_syncs());
+  // After the first failed attempt segments are synced separately.
+  ASSERT_EQ(1U, env_->num_syncs.load());
+}
+
+TEST_F(LogSyncGroupTest, FailureIsPermanent) {
+  env_->sync_status = STATUS(IOError, "Injected failure");
+  LogSyncGroup group(env_.get(), GetTestDataDirectory());
+  auto segment = CreateSegment(0);
+  ASSERT_TRUE(group.Sync(segment.get()).IsIOError());
+
+  env_->sync_status = Status::OK();
+  ASSERT_TRUE(group.Sync(segment.get()).IsIOError());
+  ASSERT_EQ(1U, env_->num_syncs.load());
+}
+
+} // namespace log
+} // namespace yb
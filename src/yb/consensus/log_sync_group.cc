@@ -0,0 +1,126 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_sync_group.h"
+
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
+#include "yb/consensus/log_util.h"
+
+#include "yb/util/env.h"
+#include "yb/util/logging.h"
+
+DEFINE_int32(log_sync_group_max_delay_us, 1000,
+             "Maximum time to delay file system sync of a WAL sync group, in order to combine "
+             "more concurrent sync requests. Actual delay adapts to the observed sync latency and "
+             "is used only when concurrent requests were seen. 0 to disable.");
+
+namespace yb {
+namespace log {
+
+LogSyncGroup::LogSyncGroup(Env* env, std::string path) : env_(env), path_(std::move(path)) {}
+
+Status LogSyncGroup::Sync(WritableLogSegment* segment) {
+  if (!file_system_sync_supported_.load(std::memory_order_acquire)) {
+    return segment->Sync();
+  }
+
+  // Data buffered by the file itself, for instance by O_DIRECT file, is not covered by file
+  // system sync, so it should be written out first.
+  RETURN_NOT_OK(segment->Flush());
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Data of the segment was written before the request was registered, so any file system sync
+  // started after this point makes it durable.
+  const auto request = ++last_request_;
+  while (sync_running_ && last_synced_request_ < request) {
+    cond_.wait(lock);
+  }
+  if (last_synced_request_ >= request || !failure_.ok()) {
+    return failure_;
+  }
+  if (!file_system_sync_supported_.load(std::memory_order_acquire)) {
+    lock.unlock();
+    return segment->Sync();
+  }
+
+  sync_running_ = true;
+  auto delay = BatchingDelayUnlocked();
+  if (delay) {
+    // Let more requests join the group, they wait for this sync since it is marked as running.
+    lock.unlock();
+    SleepFor(delay);
+    lock.lock();
+  }
+  const auto covered_request = last_request_;
+  const auto group_size = covered_request - last_synced_request_;
+  lock.unlock();
+  auto start = MonoTime::Now();
+  auto status = env_->SyncFileSystem(path_);
+  auto latency = MonoTime::Now() - start;
+  lock.lock();
+  sync_running_ = false;
+  if (status.ok()) {
+    last_synced_request_ = covered_request;
+    last_group_size_ = group_size;
+    avg_sync_latency_us_ = avg_sync_latency_us_ == 0
+        ? latency.ToMicroseconds()
+        : (avg_sync_latency_us_ * 7 + latency.ToMicroseconds()) / 8;
+    num_file_system_syncs_.fetch_add(1, std::memory_order_acq_rel);
+  } else if (status.IsNotSupported()) {
+    LOG(INFO) << "File system sync is not supported for " << path_ << ", syncing WAL files "
+              << "separately";
+    file_system_sync_supported_.store(false, std::memory_order_release);
+  } else {
+    LOG(WARNING) << "Failed to sync file system of " << path_ << ": " << status;
+    failure_ = status;
+  }
+  cond_.notify_all();
+  lock.unlock();
+
+  if (status.IsNotSupported()) {
+    // Requests of waiting threads are not covered either, they sync their segments separately.
+    return segment->Sync();
+  }
+  return status;
+}
+
+MonoDelta LogSyncGroup::BatchingDelayUnlocked() const {
+  // Delay is useful only when concurrent requests were observed, otherwise it just adds latency.
+  // Waiting for a fraction of the device sync latency lets the group grow while keeping latency of
+  // each request within a constant factor of the sync latency.
+  const auto max_delay_us = FLAGS_log_sync_group_max_delay_us;
+  if (max_delay_us <= 0 || last_group_size_ <= 1) {
+    return MonoDelta();
+  }
+  const auto delay_us = std::min<int64_t>(max_delay_us, avg_sync_latency_us_ / 2);
+  return delay_us > 0 ? MonoDelta::FromMicroseconds(delay_us) : MonoDelta();
+}
+
+LogSyncGroups::LogSyncGroups(Env* env) : env_(env) {}
+
+LogSyncGroups::~LogSyncGroups() {}
+
+LogSyncGroup* LogSyncGroups::Get(const std::string& wal_root_dir) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& group = groups_[wal_root_dir];
+  if (!group) {
+    group = std::make_unique<LogSyncGroup>(env_, wal_root_dir);
+  }
+  return group.get();
+}
+
+} // namespace log
+} // namespace yb
@@ -0,0 +1,104 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_LOG_SYNC_GROUP_H
+#define YB_CONSENSUS_LOG_SYNC_GROUP_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+class Env;
+
+namespace log {
+
+class WritableLogSegment;
+
+// Combines syncs of WAL segments of different tablets located on the same disk. Instead of fsync
+// of each segment, a single file system sync is done for all segments that requested sync while
+// the previous file system sync was running, so the number of syncs does not grow with the number
+// of tablets. When concurrent requests are observed, the sync is delayed by a fraction of the
+// observed sync latency to let more requests join the group. Falls back to fsync of each segment
+// if the platform does not support file system sync.
+class LogSyncGroup {
+ public:
+  LogSyncGroup(Env* env, std::string path);
+
+  // Makes data already written to the segment durable.
+  CHECKED_STATUS Sync(WritableLogSegment* segment);
+
+  // Returns the average latency of file system sync.
+  MonoDelta TEST_AverageSyncLatency() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return MonoDelta::FromMicroseconds(avg_sync_latency_us_);
+  }
+
+  const std::string& path() const {
+    return path_;
+  }
+
+  uint64_t num_file_system_syncs() const {
+    return num_file_system_syncs_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // Returns how long sync should wait for more requests before starting.
+  MonoDelta BatchingDelayUnlocked() const;
+
+  Env* const env_;
+  const std::string path_;
+  std::atomic<bool> file_system_sync_supported_{true};
+  std::atomic<uint64_t> num_file_system_syncs_{0};
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  // Number of the last sync request.
+  uint64_t last_request_ = 0;
+  // All requests with number less than or equal to this one are durable.
+  uint64_t last_synced_request_ = 0;
+  bool sync_running_ = false;
+  // Number of requests covered by the last file system sync.
+  uint64_t last_group_size_ = 0;
+  // Moving average of file system sync latency.
+  int64_t avg_sync_latency_us_ = 0;
+  // Failed sync leaves unknown subset of the data durable, so all subsequent syncs fail.
+  Status failure_;
+};
+
+// Holds sync groups of WAL root directories, one per directory.
+class LogSyncGroups {
+ public:
+  explicit LogSyncGroups(Env* env);
+  ~LogSyncGroups();
+
+  // Returns sync group of the WAL root directory, creating it if necessary.
+  LogSyncGroup* Get(const std::string& wal_root_dir);
+
+ private:
+  Env* const env_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<LogSyncGroup>> groups_;
+};
+
+} // namespace log
+} // namespace yb
+
+#endif // YB_CONSENSUS_LOG_SYNC_GROUP_H
@@ -132,6 +132,10 @@ const int kLogMinorVersion = 0;
 // Maximum log segment header/footer size, in bytes (8 MB).
 const uint32_t kLogSegmentMaxHeaderOrFooterSize = 8 * 1024 * 1024;
 
+// Number of bytes read together with the magic and length of the segment header or footer, so
+// the header or footer itself is usually read by the same IO.
+const size_t kLogSegmentMetadataReadAheadSize = 4_KB;
+
 LogOptions::LogOptions()
     : segment_size_bytes(FLAGS_log_segment_size_bytes == 0 ? FLAGS_log_segment_size_mb * 1_MB
                                                            : FLAGS_log_segment_size_bytes),
@@ -285,8 +289,16 @@ Status ReadableLogSegment::ReadFileSize() {
 }
 
 Status ReadableLogSegment::ReadHeader() {
+  // Read the magic, the header length and usually the whole header with a single read.
+  std::vector<uint8_t> buffer(std::max<uint64_t>(
+      kLogSegmentHeaderMagicAndHeaderLength,
+      std::min<uint64_t>(file_size(), kLogSegmentHeaderMagicAndHeaderLength +
+                                      kLogSegmentMetadataReadAheadSize)));
+  Slice data;
+  RETURN_NOT_OK(ReadFully(readable_file_.get(), 0, buffer.size(), &data, buffer.data()));
+
   uint32_t header_size;
-  RETURN_NOT_OK(ReadHeaderMagicAndHeaderLength(&header_size));
+  RETURN_NOT_OK(ParseHeaderMagicAndHeaderLength(data, &header_size));
   if (header_size == 0) {
     // If a log file has been pre-allocated but not initialized, then
     // 'header_size' will be 0 even the file size is > 0; in this
@@ -303,36 +315,27 @@ Status ReadableLogSegment::ReadHeader() {
                    header_size, kLogSegmentMaxHeaderOrFooterSize));
   }
 
-  std::vector<uint8_t> header_space(header_size);
   Slice header_slice;
-  LogSegmentHeaderPB header;
-
-  // Read and parse the log segment header.
-  RETURN_NOT_OK_PREPEND(ReadFully(readable_file_.get(), kLogSegmentHeaderMagicAndHeaderLength,
-                                  header_size, &header_slice, header_space.data()),
-                                      "Unable to read fully");
+  if (kLogSegmentHeaderMagicAndHeaderLength + header_size <= data.size()) {
+    header_slice = Slice(data.data() + kLogSegmentHeaderMagicAndHeaderLength, header_size);
+  } else {
+    buffer.resize(header_size);
+    RETURN_NOT_OK_PREPEND(ReadFully(readable_file_.get(), kLogSegmentHeaderMagicAndHeaderLength,
+                                    header_size, &header_slice, buffer.data()),
+                          "Unable to read fully");
+  }
 
-  RETURN_NOT_OK_PREPEND(pb_util::ParseFromArray(&header,
+  // Parse the log segment header.
+  RETURN_NOT_OK_PREPEND(pb_util::ParseFromArray(&header_,
                                                 header_slice.data(),
                                                 header_size),
                         "Unable to parse protobuf");
 
-  header_.CopyFrom(header);
   first_entry_offset_ = header_size + kLogSegmentHeaderMagicAndHeaderLength;
 
   return Status::OK();
 }
 
-
-Status ReadableLogSegment::ReadHeaderMagicAndHeaderLength(uint32_t *len) {
-  uint8_t scratch[kLogSegmentHeaderMagicAndHeaderLength];
-  Slice slice;
-  RETURN_NOT_OK(ReadFully(readable_file_.get(), 0, kLogSegmentHeaderMagicAndHeaderLength,
-                          &slice, scratch));
-  RETURN_NOT_OK(ParseHeaderMagicAndHeaderLength(slice, len));
-  return Status::OK();
-}
-
 namespace {
 
 // We don't run TSAN on this function because it makes it really slow and causes some
@@ -391,8 +394,18 @@ Status ReadableLogSegment::ParseHeaderMagicAndHeaderLength(const Slice &data,
 }
 
 Status ReadableLogSegment::ReadFooter() {
+  CHECK_GT(file_size(), kLogSegmentFooterMagicAndFooterLength);
+
+  // Read the tail of the file, that usually contains the whole footer, with a single read.
+  std::vector<uint8_t> buffer(std::min<uint64_t>(
+      file_size(), kLogSegmentFooterMagicAndFooterLength + kLogSegmentMetadataReadAheadSize));
+  Slice data;
+  RETURN_NOT_OK(ReadFully(readable_file_.get(), file_size() - buffer.size(), buffer.size(), &data,
+                          buffer.data()));
+
   uint32_t footer_size;
-  RETURN_NOT_OK(ReadFooterMagicAndFooterLength(&footer_size));
+  RETURN_NOT_OK(ParseFooterMagicAndFooterLength(
+      data.Suffix(kLogSegmentFooterMagicAndFooterLength), &footer_size));
 
   if (footer_size == 0 || footer_size > kLogSegmentMaxHeaderOrFooterSize) {
     return STATUS(NotFound,
@@ -406,18 +419,21 @@ Status ReadableLogSegment::ReadFooter() {
         "Decoded footer length pointed at a footer before the first entry.");
   }
 
-  std::vector<uint8_t> footer_space(footer_size);
   Slice footer_slice;
-
-  int64_t footer_offset = file_size() - kLogSegmentFooterMagicAndFooterLength - footer_size;
+  if (footer_size + kLogSegmentFooterMagicAndFooterLength <= data.size()) {
+    footer_slice = Slice(
+        data.end() - kLogSegmentFooterMagicAndFooterLength - footer_size, footer_size);
+  } else {
+    int64_t footer_offset = file_size() - kLogSegmentFooterMagicAndFooterLength - footer_size;
+    buffer.resize(footer_size);
+    RETURN_NOT_OK_PREPEND(ReadFully(readable_file_.get(), footer_offset,
+                                    footer_size, &footer_slice, buffer.data()),
+                          "Footer not found. Could not read fully.");
+  }
 
   LogSegmentFooterPB footer;
 
-  // Read and parse the log segment footer.
-  RETURN_NOT_OK_PREPEND(ReadFully(readable_file_.get(), footer_offset,
-                                  footer_size, &footer_slice, footer_space.data()),
-                        "Footer not found. Could not read fully.");
-
+  // Parse the log segment footer.
   RETURN_NOT_OK_PREPEND(pb_util::ParseFromArray(&footer,
                                                 footer_slice.data(),
                                                 footer_size),
@@ -427,21 +443,6 @@ Status ReadableLogSegment::ReadFooter() {
   return Status::OK();
 }
 
-Status ReadableLogSegment::ReadFooterMagicAndFooterLength(uint32_t *len) {
-  uint8_t scratch[kLogSegmentFooterMagicAndFooterLength];
-  Slice slice;
-
-  CHECK_GT(file_size(), kLogSegmentFooterMagicAndFooterLength);
-  RETURN_NOT_OK(ReadFully(readable_file_.get(),
-                          file_size() - kLogSegmentFooterMagicAndFooterLength,
-                          kLogSegmentFooterMagicAndFooterLength,
-                          &slice,
-                          scratch));
-
-  RETURN_NOT_OK(ParseFooterMagicAndFooterLength(slice, len));
-  return Status::OK();
-}
-
 Status ReadableLogSegment::ParseFooterMagicAndFooterLength(const Slice &data,
                                                            uint32_t *parsed_len) {
   RETURN_NOT_OK_PREPEND(data.check_size(kLogSegmentFooterMagicAndFooterLength),
@@ -78,6 +78,7 @@ extern const size_t kEntryHeaderSize;
 extern const int kLogMajorVersion;
 extern const int kLogMinorVersion;
 
+class LogSyncGroup;
 class ReadableLogSegment;
 
 // Options for the Write Ahead Log. The LogOptions constructor initializes default field values
@@ -114,6 +115,9 @@ struct LogOptions {
 
   uint64_t initial_active_segment_sequence_number = 0;
 
+  // If specified, syncs of the log are combined with syncs of other logs on the same disk.
+  LogSyncGroup* sync_group = nullptr;
+
   LogOptions();
 };
 
@@ -297,14 +301,10 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
 
   CHECKED_STATUS ReadHeader();
 
-  CHECKED_STATUS ReadHeaderMagicAndHeaderLength(uint32_t *len);
-
   CHECKED_STATUS ParseHeaderMagicAndHeaderLength(const Slice &data, uint32_t *parsed_len);
 
   CHECKED_STATUS ReadFooter();
 
-  CHECKED_STATUS ReadFooterMagicAndFooterLength(uint32_t *len);
-
   CHECKED_STATUS ParseFooterMagicAndFooterLength(const Slice &data, uint32_t *parsed_len);
 
   // Starting at 'offset', read the rest of the log file, looking for any
@@ -411,6 +411,11 @@ class WritableLogSegment {
     return writable_file_->Sync();
   }
 
+  // Writes data buffered by the underlying writable file, without waiting for it to be durable.
+  CHECKED_STATUS Flush() {
+    return writable_file_->Flush(WritableFile::FLUSH_ASYNC);
+  }
+
   // Returns true if the segment header has already been written to disk.
   bool IsHeaderWritten() const {
     return is_header_written_;
@@ -0,0 +1,97 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <algorithm>
+
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/util/flag_tags.h"
+
+using namespace std::literals;
+
+DEFINE_int32(multi_raft_heartbeat_batch_window_ms, 20,
+             "Heartbeats of tablets that have followers on the same server are collected during "
+             "this time and sent in one RPC.");
+TAG_FLAG(multi_raft_heartbeat_batch_window_ms, advanced);
+TAG_FLAG(multi_raft_heartbeat_batch_window_ms, runtime);
+
+DEFINE_int32(multi_raft_heartbeat_batch_max_size, 1000,
+             "Maximum number of heartbeats sent in one batched RPC.");
+TAG_FLAG(multi_raft_heartbeat_batch_max_size, advanced);
+TAG_FLAG(multi_raft_heartbeat_batch_max_size, runtime);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+MonoDelta MultiRaftHeartbeatTraits::BatchWindow() {
+  return FLAGS_multi_raft_heartbeat_batch_window_ms * 1ms;
+}
+
+size_t MultiRaftHeartbeatTraits::MaxBatchSize() {
+  return std::max(FLAGS_multi_raft_heartbeat_batch_max_size, 1);
+}
+
+MonoDelta MultiRaftHeartbeatTraits::Timeout() {
+  return FLAGS_consensus_rpc_timeout_ms * 1ms;
+}
+
+void MultiRaftHeartbeatTraits::Send(
+    ConsensusServiceProxy* proxy, const Request& request, Response* response,
+    rpc::RpcController* controller, rpc::ResponseCallback callback) {
+  proxy->UpdateConsensusAsync(request, response, controller, std::move(callback));
+}
+
+void MultiRaftHeartbeatTraits::SendBatch(
+    ConsensusServiceProxy* proxy, const BatchRequest& request, BatchResponse* response,
+    rpc::RpcController* controller, rpc::ResponseCallback callback) {
+  // Responses of the batch are processed like responses of individual heartbeats.
+  controller->set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  proxy->MultiRaftUpdateConsensusAsync(request, response, controller, std::move(callback));
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache)
+    : messenger_(messenger), proxy_cache_(proxy_cache) {
+}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const HostPort& hostport) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = batchers_.find(hostport);
+  if (it != batchers_.end()) {
+    auto batcher = it->second.lock();
+    if (batcher) {
+      return batcher;
+    }
+  }
+
+  // Drop batchers of servers that no longer have peers of tablets led by this server.
+  for (auto i = batchers_.begin(); i != batchers_.end();) {
+    if (i->second.expired()) {
+      i = batchers_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+
+  auto batcher = std::make_shared<MultiRaftHeartbeatBatcher>(
+      hostport.ToString(), std::make_shared<ConsensusServiceProxy>(proxy_cache_, hostport),
+      messenger_);
+  batchers_[hostport] = batcher;
+  return batcher;
+}
+
+}  // namespace consensus
+}  // namespace yb
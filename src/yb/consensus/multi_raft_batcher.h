@@ -0,0 +1,89 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus_fwd.h"
+
+#include "yb/rpc/rpc_batcher.h"
+
+#include "yb/util/net/net_util.h"
+
+namespace yb {
+namespace consensus {
+
+struct MultiRaftHeartbeatTraits {
+  typedef ConsensusServiceProxy Proxy;
+  typedef ConsensusRequestPB Request;
+  typedef ConsensusResponsePB Response;
+  typedef MultiRaftConsensusRequestPB BatchRequest;
+  typedef MultiRaftConsensusResponsePB BatchResponse;
+
+  static const char* Name() { return "Heartbeat"; }
+
+  static void Send(
+      ConsensusServiceProxy* proxy, const Request& request, Response* response,
+      rpc::RpcController* controller, rpc::ResponseCallback callback);
+  static void SendBatch(
+      ConsensusServiceProxy* proxy, const BatchRequest& request, BatchResponse* response,
+      rpc::RpcController* controller, rpc::ResponseCallback callback);
+
+  static Request* AddRequest(BatchRequest* batch) { return batch->add_consensus_request(); }
+  static const Request& GetRequest(const BatchRequest& batch, int index) {
+    return batch.consensus_request(index);
+  }
+  static int ResponseSize(const BatchResponse& batch) {
+    return batch.consensus_response_size();
+  }
+  static Response* MutableResponse(BatchResponse* batch, int index) {
+    return batch->mutable_consensus_response(index);
+  }
+
+  static MonoDelta BatchWindow();
+  static size_t MaxBatchSize();
+  static MonoDelta Timeout();
+};
+
+// Coalesces heartbeat-only UpdateConsensus requests of all tablets, that have leaders on this
+// server and followers on the same remote server, into one MultiRaftUpdateConsensus RPC.
+// Servers that do not implement MultiRaftUpdateConsensus get regular UpdateConsensus RPCs.
+typedef rpc::RpcBatcher<MultiRaftHeartbeatTraits> MultiRaftHeartbeatBatcher;
+
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+// Keeps one heartbeat batcher per remote server, shared by peers of all tablets on this server.
+// Batchers are owned by the peer proxies that use them.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache);
+
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const HostPort& hostport);
+
+ private:
+  rpc::Messenger* const messenger_;
+  rpc::ProxyCache* const proxy_cache_;
+
+  std::mutex mutex_;
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_;
+};
+
+}  // namespace consensus
+}  // namespace yb
+
+#endif  // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
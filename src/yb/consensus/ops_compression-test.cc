@@ -0,0 +1,61 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/consensus-test-util.h"
+#include "yb/consensus/ops_compression.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace consensus {
+
+class OpsCompressionTest : public YBTest {
+};
+
+TEST_F(OpsCompressionTest, CompressAndDecompress) {
+  const int kNumOps = 10;
+  ConsensusRequestPB ops;
+  std::vector<RefCntBuffer> serialized_ops;
+  for (int i = 1; i <= kNumOps; ++i) {
+    ConsensusRequestPB single_op;
+    *single_op.add_ops() = *CreateDummyReplicate(1, i, HybridTime(i), 1000);
+    *ops.add_ops() = single_op.ops(0);
+    serialized_ops.emplace_back(single_op.SerializePartialAsString());
+  }
+
+  ConsensusRequestPB request;
+  request.set_tablet_id("tablet");
+  ASSERT_TRUE(CompressOps(serialized_ops, &request));
+  ASSERT_EQ(0, request.ops_size());
+  ASSERT_LT(request.compressed_ops().size(), static_cast<size_t>(ops.ByteSize()));
+  ASSERT_EQ(ops.ByteSize(), request.ops_uncompressed_size());
+
+  ASSERT_OK(DecompressOps(&request));
+  ASSERT_FALSE(request.has_compressed_ops());
+  ASSERT_FALSE(request.has_ops_uncompressed_size());
+  ASSERT_EQ("tablet", request.tablet_id());
+  ASSERT_EQ(kNumOps, request.ops_size());
+  for (int i = 0; i != kNumOps; ++i) {
+    ASSERT_EQ(ops.ops(i).ShortDebugString(), request.ops(i).ShortDebugString());
+  }
+}
+
+TEST_F(OpsCompressionTest, Corrupted) {
+  ConsensusRequestPB request;
+  request.set_compressed_ops("not compressed data");
+  request.set_ops_uncompressed_size(100);
+  ASSERT_NOK(DecompressOps(&request));
+}
+
+} // namespace consensus
+} // namespace yb
@@ -0,0 +1,69 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/ops_compression.h"
+
+#include <lz4.h>
+
+#include <string>
+
+#include "yb/consensus/consensus.pb.h"
+
+#include "yb/util/logging.h"
+
+namespace yb {
+namespace consensus {
+
+bool CompressOps(const std::vector<RefCntBuffer>& serialized_ops, ConsensusRequestPB* request) {
+  std::string input;
+  for (const auto& op : serialized_ops) {
+    input.append(op.data(), op.size());
+  }
+  if (input.empty() || input.size() > LZ4_MAX_INPUT_SIZE) {
+    return false;
+  }
+
+  std::string output(LZ4_compressBound(input.size()), '\0');
+  int compressed_size = LZ4_compress_default(
+      input.data(), &output[0], input.size(), output.size());
+  if (compressed_size <= 0 || static_cast<size_t>(compressed_size) >= input.size()) {
+    return false;
+  }
+  output.resize(compressed_size);
+  request->set_compressed_ops(std::move(output));
+  request->set_ops_uncompressed_size(input.size());
+  return true;
+}
+
+Status DecompressOps(ConsensusRequestPB* request) {
+  if (!request->has_compressed_ops()) {
+    return Status::OK();
+  }
+
+  const auto& input = request->compressed_ops();
+  std::string output(request->ops_uncompressed_size(), '\0');
+  int size = LZ4_decompress_safe(input.data(), &output[0], input.size(), output.size());
+  if (size < 0 || static_cast<size_t>(size) != output.size()) {
+    return STATUS_FORMAT(Corruption, "Failed to decompress ops: $0, expected size: $1",
+                         size, output.size());
+  }
+  request->clear_compressed_ops();
+  request->clear_ops_uncompressed_size();
+  if (!request->MergeFromString(output)) {
+    return STATUS(Corruption, "Failed to parse decompressed ops");
+  }
+  return Status::OK();
+}
+
+} // namespace consensus
+} // namespace yb
@@ -47,6 +47,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/opid.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 #include "yb/util/tostring.h"
 #include "yb/util/trace.h"
@@ -872,6 +873,20 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
   OpIds applied_op_ids;
   applied_op_ids.reserve(committed_op_id.index - prev_id.index);
 
+  // Writes of several operations are combined only on followers, so leader does not delay
+  // responses to clients.
+  const bool apply_batch = GetActiveRoleUnlocked() != RaftPeerPB::LEADER;
+  if (apply_batch) {
+    context_->StartApplyBatch();
+  }
+  // Makes sure that batch is finished on failure. FinishApplyBatch() is a no-op for a finished
+  // batch.
+  auto se = ScopeExit([this, apply_batch] {
+    if (apply_batch) {
+      context_->FinishApplyBatch();
+    }
+  });
+
   while (!pending_operations_.empty()) {
     auto round = pending_operations_.front();
     auto current_id = yb::OpId::FromPB(round->id());
@@ -894,8 +909,13 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
             << prev_id << " of " << committed_op_id;
         break;
       }
-    } else if (current_id.index > max_allowed_op_id.index ||
-               current_id.term > max_allowed_op_id.term) {
+    } else if (apply_batch) {
+      context_->FinishApplyBatch();
+      context_->StartApplyBatch();
+    }
+    if (type != OperationType::WRITE_OP &&
+        (current_id.index > max_allowed_op_id.index ||
+         current_id.term > max_allowed_op_id.term)) {
       max_allowed_op_id = safe_op_id_waiter_->WaitForSafeOpIdToApply(current_id);
       SCHECK(max_allowed_op_id.index >= current_id.index &&
                  max_allowed_op_id.term >= current_id.term,
@@ -913,6 +933,10 @@ Status ReplicaState::ApplyPendingOperationsUnlocked(
     NotifyReplicationFinishedUnlocked(round, Status::OK(), leader_term, &applied_op_ids);
   }
 
+  if (apply_batch) {
+    context_->FinishApplyBatch();
+  }
+
   SetLastCommittedIndexUnlocked(prev_id);
 
   applied_ops_tracker_(applied_op_ids);
@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/retryable_requests.h"
+
+#include "yb/tserver/tserver.pb.h"
+
+#include "yb/util/opid.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace consensus {
+
+class RetryableRequestsTest : public YBTest {
+ protected:
+  void Bootstrap(const ClientId& client_id, int64_t request_id, int64_t op_index,
+                 RestartSafeCoarseTimePoint time) {
+    ReplicateMsg msg;
+    msg.mutable_id()->set_term(1);
+    msg.mutable_id()->set_index(op_index);
+    auto* write_request = msg.mutable_write_request();
+    auto ids = client_id.ToUInt64Pair();
+    write_request->set_client_id1(ids.first);
+    write_request->set_client_id2(ids.second);
+    write_request->set_request_id(request_id);
+    write_request->set_min_running_request_id(1);
+    requests_.Bootstrap(msg, time);
+  }
+
+  RetryableRequests requests_;
+};
+
+TEST_F(RetryableRequestsTest, CleanExpired) {
+  ASSERT_EQ(requests_.CleanExpiredReplicatedAndGetMinOpId(), OpId::Max());
+
+  auto fresh = requests_.Clock().Now();
+  auto expired = fresh - 1h;
+  auto client1 = ClientId::GenerateRandom();
+  auto client2 = ClientId::GenerateRandom();
+  auto client3 = ClientId::GenerateRandom();
+
+  // Request ids are not adjacent, so each request gets its own range.
+  Bootstrap(client1, 1, 1, expired);
+  Bootstrap(client2, 1, 2, expired);
+  Bootstrap(client1, 3, 3, fresh);
+  Bootstrap(client2, 3, 4, expired);
+  Bootstrap(client3, 1, 5, fresh);
+  ASSERT_EQ(requests_.TEST_Counts().replicated, 5);
+
+  // All ranges of client2 are expired, and the first range of client1.
+  ASSERT_EQ(requests_.CleanExpiredReplicatedAndGetMinOpId(), OpId(1, 3));
+  ASSERT_EQ(requests_.TEST_Counts().replicated, 2);
+
+  // Adding a range with a lower op id moves client to the front.
+  Bootstrap(client3, 3, 2, fresh);
+  ASSERT_EQ(requests_.CleanExpiredReplicatedAndGetMinOpId(), OpId(1, 2));
+  ASSERT_EQ(requests_.TEST_Counts().replicated, 3);
+}
+
+} // namespace consensus
+} // namespace yb
@@ -13,6 +13,8 @@
 
 #include "yb/consensus/retryable_requests.h"
 
+#include <set>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -143,8 +145,14 @@ struct ClientRetryableRequests {
   ReplicatedRetryableRequestRanges replicated;
   RetryableRequestId min_running_request_id = 0;
   RestartSafeCoarseTimePoint empty_since;
+  // Min op id of replicated ranges, this client is ordered by in ClientsByMinOpId.
+  // Invalid when client does not have replicated ranges.
+  yb::OpId ordered_min_op_id = yb::OpId::Invalid();
 };
 
+// Clients that have replicated ranges, ordered by the min op id of their ranges.
+typedef std::set<std::pair<yb::OpId, ClientRetryableRequests*>> ClientsByMinOpId;
+
 std::chrono::seconds RangeTimeLimit() {
   return std::chrono::seconds(FLAGS_retryable_request_range_time_limit_secs);
 }
@@ -224,6 +232,7 @@ class RetryableRequests::Impl {
 
     CleanupReplicatedRequests(
         data.write_request().min_running_request_id(), &client_retryable_requests);
+    UpdateClientOrder(&client_retryable_requests);
 
     if (data.request_id() < client_retryable_requests.min_running_request_id) {
       round->NotifyReplicationFinished(
@@ -264,25 +273,36 @@ class RetryableRequests::Impl {
     auto now = clock_.Now();
     auto clean_start =
         now - std::chrono::seconds(GetAtomicFlag(&FLAGS_retryable_request_timeout_secs));
-    for (auto ci = clients_.begin(); ci != clients_.end();) {
-      ClientRetryableRequests& client_retryable_requests = ci->second;
-      auto& op_id_index = client_retryable_requests.replicated.get<OpIdIndex>();
+
+    // Result is the min op id of ranges that are not expired. Ranges of each client are dropped
+    // in op id order, until the first one that is not expired. So it is enough to process clients
+    // in order of their min op id, until the first client whose min range is not expired.
+    // Expired ranges of other clients will be dropped when they get to the front, their op ids
+    // are greater than result anyway.
+    while (!clients_by_min_op_id_.empty()) {
+      auto* client = clients_by_min_op_id_.begin()->second;
+      auto& op_id_index = client->replicated.get<OpIdIndex>();
       auto it = op_id_index.begin();
       int64_t count = 0;
       while (it != op_id_index.end() && it->max_time < clean_start) {
         ++it;
         ++count;
       }
+      if (count == 0) {
+        result = it->min_op_id;
+        break;
+      }
       if (replicated_request_ranges_gauge_) {
         replicated_request_ranges_gauge_->DecrementBy(count);
       }
-      if (it != op_id_index.end()) {
-        result = std::min(result, it->min_op_id);
-        op_id_index.erase(op_id_index.begin(), it);
-      } else {
-        op_id_index.clear();
-      }
-      if (op_id_index.empty() && client_retryable_requests.running.empty()) {
+      op_id_index.erase(op_id_index.begin(), it);
+      UpdateClientOrder(client);
+    }
+
+    for (auto ci = clients_.begin(); ci != clients_.end();) {
+      ClientRetryableRequests& client_retryable_requests = ci->second;
+      if (client_retryable_requests.replicated.empty() &&
+          client_retryable_requests.running.empty()) {
         // We delay deleting client with empty requests, to be able to filter requests with too
         // small request id.
         if (client_retryable_requests.empty_since == RestartSafeCoarseTimePoint()) {
@@ -334,6 +354,7 @@ class RetryableRequests::Impl {
     if (status.ok()) {
       AddReplicated(
           yb::OpId::FromPB(replicate_msg.id()), data, entry_time, &client_retryable_requests);
+      UpdateClientOrder(&client_retryable_requests);
     }
   }
 
@@ -361,6 +382,7 @@ class RetryableRequests::Impl {
 
     AddReplicated(
         yb::OpId::FromPB(replicate_msg.id()), data, entry_time, &client_retryable_requests);
+    UpdateClientOrder(&client_retryable_requests);
   }
 
   RestartSafeCoarseMonoClock& Clock() {
@@ -384,6 +406,25 @@ class RetryableRequests::Impl {
   }
 
  private:
+  // Should be invoked after replicated ranges of client were changed, to keep its position in
+  // clients_by_min_op_id_.
+  void UpdateClientOrder(ClientRetryableRequests* client) {
+    auto min_op_id = yb::OpId::Invalid();
+    if (!client->replicated.empty()) {
+      min_op_id = client->replicated.get<OpIdIndex>().begin()->min_op_id;
+    }
+    if (min_op_id == client->ordered_min_op_id) {
+      return;
+    }
+    if (client->ordered_min_op_id.valid()) {
+      clients_by_min_op_id_.erase(std::make_pair(client->ordered_min_op_id, client));
+    }
+    if (min_op_id.valid()) {
+      clients_by_min_op_id_.emplace(min_op_id, client);
+    }
+    client->ordered_min_op_id = min_op_id;
+  }
+
   void CleanupReplicatedRequests(
       RetryableRequestId new_min_running_request_id,
       ClientRetryableRequests* client_retryable_requests) {
@@ -531,6 +572,7 @@ class RetryableRequests::Impl {
 
   const std::string log_prefix_;
   std::unordered_map<ClientId, ClientRetryableRequests, ClientIdHash> clients_;
+  ClientsByMinOpId clients_by_min_op_id_;
   RestartSafeCoarseMonoClock clock_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
@@ -25,6 +25,10 @@ class TestConsensusContext : public ConsensusContext {
 
   bool ShouldApplyWrite() override { return true; }
 
+  void StartApplyBatch() override {}
+
+  void FinishApplyBatch() override {}
+
   HybridTime PreparePeerRequest() override { return HybridTime(); }
 
   void MajorityReplicated() override {}
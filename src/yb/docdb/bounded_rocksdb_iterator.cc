@@ -19,8 +19,18 @@ namespace docdb {
 BoundedRocksDbIterator::BoundedRocksDbIterator(
     rocksdb::DB* rocksdb, const rocksdb::ReadOptions& read_opts,
     const KeyBounds* key_bounds)
-    : iterator_(rocksdb->NewIterator(read_opts)), key_bounds_(key_bounds) {
+    : key_bounds_(key_bounds) {
   CHECK_NOTNULL(key_bounds_);
+  if (read_opts.iterate_upper_bound || key_bounds_->upper.empty()) {
+    iterator_.reset(rocksdb->NewIterator(read_opts));
+  } else {
+    // SST files of a tablet created by split also contain keys of the other child tablet. Let
+    // RocksDB stop at the upper bound, instead of reading those keys, until they are compacted.
+    auto bounded_read_opts = read_opts;
+    upper_bound_ = std::make_unique<Slice>(key_bounds_->upper.AsSlice());
+    bounded_read_opts.iterate_upper_bound = upper_bound_.get();
+    iterator_.reset(rocksdb->NewIterator(bounded_read_opts));
+  }
   VLOG(3) << "key_bounds_ = " << yb::ToString(key_bounds_);
 }
 
@@ -78,6 +78,9 @@ class BoundedRocksDbIterator : public rocksdb::Iterator {
   }
 
  private:
+  // Upper bound of key_bounds_, used as iterate_upper_bound when caller did not specify one.
+  // Allocated separately, so it does not move together with the iterator.
+  std::unique_ptr<Slice> upper_bound_;
   std::unique_ptr<rocksdb::Iterator> iterator_;
   const KeyBounds* key_bounds_;
 };
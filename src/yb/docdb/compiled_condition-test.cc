@@ -0,0 +1,167 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/compiled_condition.h"
+#include "yb/docdb/doc_expr.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr ColumnIdRep kInt32Column = kFirstColumnIdRep;
+constexpr ColumnIdRep kInt64Column = kFirstColumnIdRep + 1;
+
+void AddComparison(PgsqlConditionPB* condition, QLOperator op, ColumnIdRep column_id,
+                   int64_t value, bool column_first = true) {
+  auto* comparison = condition->add_operands()->mutable_condition();
+  comparison->set_op(op);
+  PgsqlExpressionPB column;
+  column.set_column_id(column_id);
+  PgsqlExpressionPB constant;
+  if (column_id == kInt32Column) {
+    constant.mutable_value()->set_int32_value(static_cast<int32_t>(value));
+  } else {
+    constant.mutable_value()->set_int64_value(value);
+  }
+  *comparison->add_operands() = column_first ? column : constant;
+  *comparison->add_operands() = column_first ? constant : column;
+}
+
+}  // namespace
+
+class CompiledConditionTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    // Every 5th row has NULL in int32 column, and every 7th row does not have int64 column at all.
+    rows_.resize(100);
+    for (size_t i = 0; i != rows_.size(); ++i) {
+      QLValuePB int32_value;
+      if (i % 5 != 0) {
+        int32_value.set_int32_value(static_cast<int32_t>(i));
+      }
+      rows_[i].AllocColumn(kInt32Column, int32_value);
+      if (i % 7 != 0) {
+        QLValuePB int64_value;
+        int64_value.set_int64_value(static_cast<int64_t>(i) * 1000);
+        rows_[i].AllocColumn(kInt64Column, int64_value);
+      }
+    }
+  }
+
+  // Checks that the compiled condition selects the same rows as DocExprExecutor.
+  void CheckCondition(const PgsqlExpressionPB& where_expr, size_t expected_matches) {
+    CompiledPgsqlCondition compiled;
+    ASSERT_TRUE(compiled.Init(where_expr));
+    std::vector<size_t> selection;
+    ASSERT_OK(compiled.Evaluate(rows_, rows_.size(), &selection));
+
+    DocExprExecutor executor;
+    std::vector<size_t> expected;
+    for (size_t i = 0; i != rows_.size(); ++i) {
+      QLExprResult match;
+      ASSERT_OK(executor.EvalExpr(where_expr, rows_[i], match.Writer()));
+      if (match.Value().bool_value()) {
+        expected.push_back(i);
+      }
+    }
+    ASSERT_EQ(expected, selection);
+    ASSERT_EQ(expected_matches, selection.size());
+  }
+
+  std::vector<QLTableRow> rows_;
+};
+
+TEST_F(CompiledConditionTest, Comparisons) {
+  for (auto op : {QL_OP_EQUAL, QL_OP_NOT_EQUAL, QL_OP_LESS_THAN, QL_OP_LESS_THAN_EQUAL,
+                  QL_OP_GREATER_THAN, QL_OP_GREATER_THAN_EQUAL}) {
+    for (bool column_first : {true, false}) {
+      PgsqlExpressionPB where_expr;
+      auto* condition = where_expr.mutable_condition();
+      condition->set_op(QL_OP_AND);
+      AddComparison(condition, op, kInt32Column, 42, column_first);
+      CompiledPgsqlCondition compiled;
+      ASSERT_TRUE(compiled.Init(where_expr));
+      std::vector<size_t> selection;
+      ASSERT_OK(compiled.Evaluate(rows_, rows_.size(), &selection));
+
+      DocExprExecutor executor;
+      size_t expected_matches = 0;
+      for (const auto& row : rows_) {
+        QLExprResult match;
+        ASSERT_OK(executor.EvalExpr(where_expr, row, match.Writer()));
+        expected_matches += match.Value().bool_value();
+      }
+      ASSERT_EQ(expected_matches, selection.size()) << where_expr.ShortDebugString();
+    }
+  }
+}
+
+TEST_F(CompiledConditionTest, Conjunction) {
+  PgsqlExpressionPB where_expr;
+  auto* condition = where_expr.mutable_condition();
+  condition->set_op(QL_OP_AND);
+  AddComparison(condition, QL_OP_GREATER_THAN_EQUAL, kInt32Column, 10);
+  AddComparison(condition, QL_OP_LESS_THAN, kInt64Column, 50000);
+  auto* not_null = condition->add_operands()->mutable_condition();
+  not_null->set_op(QL_OP_IS_NOT_NULL);
+  not_null->add_operands()->set_column_id(kInt64Column);
+  // Rows 10..49 without multiples of 5 and 7.
+  CheckCondition(where_expr, 27);
+}
+
+TEST_F(CompiledConditionTest, IsNull) {
+  PgsqlExpressionPB where_expr;
+  auto* condition = where_expr.mutable_condition();
+  condition->set_op(QL_OP_IS_NULL);
+  condition->add_operands()->set_column_id(kInt64Column);
+  CheckCondition(where_expr, 15);
+}
+
+TEST_F(CompiledConditionTest, Unsupported) {
+  CompiledPgsqlCondition compiled;
+
+  PgsqlExpressionPB where_expr;
+  auto* condition = where_expr.mutable_condition();
+  condition->set_op(QL_OP_OR);
+  AddComparison(condition, QL_OP_EQUAL, kInt32Column, 1);
+  AddComparison(condition, QL_OP_EQUAL, kInt32Column, 2);
+  ASSERT_FALSE(compiled.Init(where_expr));
+
+  condition->set_op(QL_OP_AND);
+  ASSERT_TRUE(compiled.Init(where_expr));
+  condition->mutable_operands(1)->mutable_condition()->mutable_operands(1)->mutable_value()->
+      set_string_value("2");
+  ASSERT_FALSE(compiled.Init(where_expr));
+}
+
+TEST_F(CompiledConditionTest, NotComparable) {
+  PgsqlExpressionPB where_expr;
+  auto* condition = where_expr.mutable_condition();
+  condition->set_op(QL_OP_AND);
+  // Compare int64 column with int32 constant.
+  AddComparison(condition, QL_OP_EQUAL, kInt32Column, 1);
+  condition->mutable_operands(0)->mutable_condition()->mutable_operands(0)->set_column_id(
+      kInt64Column);
+  CompiledPgsqlCondition compiled;
+  ASSERT_TRUE(compiled.Init(where_expr));
+  std::vector<size_t> selection;
+  ASSERT_NOK(compiled.Evaluate(rows_, rows_.size(), &selection));
+}
+
+}  // namespace docdb
+}  // namespace yb
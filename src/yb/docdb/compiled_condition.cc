@@ -0,0 +1,213 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/compiled_condition.h"
+
+#include <functional>
+
+#include "yb/common/ql_value.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+bool IsSupportedType(QLValuePB::ValueCase type) {
+  switch (type) {
+    case QLValuePB::kInt8Value: FALLTHROUGH_INTENDED;
+    case QLValuePB::kInt16Value: FALLTHROUGH_INTENDED;
+    case QLValuePB::kInt32Value: FALLTHROUGH_INTENDED;
+    case QLValuePB::kInt64Value:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t IntValue(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case QLValuePB::kInt8Value: return value.int8_value();
+    case QLValuePB::kInt16Value: return value.int16_value();
+    case QLValuePB::kInt32Value: return value.int32_value();
+    case QLValuePB::kInt64Value: return value.int64_value();
+    default:
+      LOG(DFATAL) << "Unexpected value type: " << value.ShortDebugString();
+      return 0;
+  }
+}
+
+// Returns the operator to use when operands of the comparison are swapped.
+QLOperator SwapOperands(QLOperator op) {
+  switch (op) {
+    case QL_OP_LESS_THAN: return QL_OP_GREATER_THAN;
+    case QL_OP_LESS_THAN_EQUAL: return QL_OP_GREATER_THAN_EQUAL;
+    case QL_OP_GREATER_THAN: return QL_OP_LESS_THAN;
+    case QL_OP_GREATER_THAN_EQUAL: return QL_OP_LESS_THAN_EQUAL;
+    default: return op;
+  }
+}
+
+bool IsColumnRef(const PgsqlExpressionPB& expr) {
+  // Negative column ids are virtual columns that are not stored in the row.
+  return expr.expr_case() == PgsqlExpressionPB::ExprCase::kColumnId && expr.column_id() >= 0;
+}
+
+bool IsSupportedConstant(const PgsqlExpressionPB& expr) {
+  return expr.expr_case() == PgsqlExpressionPB::ExprCase::kValue &&
+         IsSupportedType(expr.value().value_case());
+}
+
+}  // namespace
+
+bool CompiledPgsqlCondition::Init(const PgsqlExpressionPB& condition) {
+  comparisons_.clear();
+  if (condition.expr_case() != PgsqlExpressionPB::ExprCase::kCondition) {
+    return false;
+  }
+  return AddCondition(condition.condition());
+}
+
+bool CompiledPgsqlCondition::AddCondition(const PgsqlConditionPB& condition) {
+  const auto& operands = condition.operands();
+  switch (condition.op()) {
+    case QL_OP_AND:
+      if (operands.empty()) {
+        return false;
+      }
+      for (const auto& operand : operands) {
+        if (operand.expr_case() != PgsqlExpressionPB::ExprCase::kCondition ||
+            !AddCondition(operand.condition())) {
+          return false;
+        }
+      }
+      return true;
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL:
+      if (operands.size() != 1 || !IsColumnRef(operands.Get(0))) {
+        return false;
+      }
+      comparisons_.push_back(Comparison {
+          operands.Get(0).column_id(), condition.op(), QLValuePB::VALUE_NOT_SET, 0 });
+      return true;
+
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: {
+      if (operands.size() != 2) {
+        return false;
+      }
+      auto op = condition.op();
+      const PgsqlExpressionPB* column = &operands.Get(0);
+      const PgsqlExpressionPB* constant = &operands.Get(1);
+      if (!IsColumnRef(*column)) {
+        std::swap(column, constant);
+        op = SwapOperands(op);
+      }
+      if (!IsColumnRef(*column) || !IsSupportedConstant(*constant)) {
+        return false;
+      }
+      comparisons_.push_back(Comparison {
+          column->column_id(), op, constant->value().value_case(), IntValue(constant->value()) });
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+template <class Op>
+Status CompiledPgsqlCondition::Filter(const Comparison& comparison,
+                                      const Op& op,
+                                      const std::vector<QLTableRow>& rows,
+                                      std::vector<size_t>* selection) const {
+  // NULL is not equal to a constant and is not ordered with respect to it, see QLValuePB
+  // comparison operators.
+  const bool null_matches = comparison.op == QL_OP_NOT_EQUAL;
+  size_t num_selected = 0;
+  for (size_t index : *selection) {
+    const QLValuePB* value = rows[index].GetColumn(comparison.column_id);
+    bool match;
+    if (value == nullptr || IsNull(*value)) {
+      match = null_matches;
+    } else if (PREDICT_FALSE(value->value_case() != comparison.type)) {
+      return STATUS(RuntimeError, "values not comparable");
+    } else {
+      match = op(IntValue(*value), comparison.value);
+    }
+    if (match) {
+      (*selection)[num_selected++] = index;
+    }
+  }
+  selection->resize(num_selected);
+  return Status::OK();
+}
+
+Status CompiledPgsqlCondition::Evaluate(const std::vector<QLTableRow>& rows,
+                                        size_t num_rows,
+                                        std::vector<size_t>* selection) const {
+  selection->resize(num_rows);
+  for (size_t i = 0; i != num_rows; ++i) {
+    (*selection)[i] = i;
+  }
+
+  for (const auto& comparison : comparisons_) {
+    if (selection->empty()) {
+      break;
+    }
+    switch (comparison.op) {
+      case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+      case QL_OP_IS_NOT_NULL: {
+        const bool want_null = comparison.op == QL_OP_IS_NULL;
+        size_t num_selected = 0;
+        for (size_t index : *selection) {
+          const QLValuePB* value = rows[index].GetColumn(comparison.column_id);
+          if ((value == nullptr || IsNull(*value)) == want_null) {
+            (*selection)[num_selected++] = index;
+          }
+        }
+        selection->resize(num_selected);
+        break;
+      }
+      case QL_OP_EQUAL:
+        RETURN_NOT_OK(Filter(comparison, std::equal_to<>(), rows, selection));
+        break;
+      case QL_OP_NOT_EQUAL:
+        RETURN_NOT_OK(Filter(comparison, std::not_equal_to<>(), rows, selection));
+        break;
+      case QL_OP_LESS_THAN:
+        RETURN_NOT_OK(Filter(comparison, std::less<>(), rows, selection));
+        break;
+      case QL_OP_LESS_THAN_EQUAL:
+        RETURN_NOT_OK(Filter(comparison, std::less_equal<>(), rows, selection));
+        break;
+      case QL_OP_GREATER_THAN:
+        RETURN_NOT_OK(Filter(comparison, std::greater<>(), rows, selection));
+        break;
+      case QL_OP_GREATER_THAN_EQUAL:
+        RETURN_NOT_OK(Filter(comparison, std::greater_equal<>(), rows, selection));
+        break;
+      default:
+        return STATUS_FORMAT(IllegalState, "Unexpected operator in compiled condition: $0",
+                             comparison.op);
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,67 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_COMPILED_CONDITION_H
+#define YB_DOCDB_COMPILED_CONDITION_H
+
+#include <vector>
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_expr.h"
+
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// Pushed-down WHERE condition compiled into a flat list of comparisons between an integer column
+// and a constant, combined with AND. Instead of walking the expression tree for every row, the
+// condition is applied to a batch of rows one comparison at a time, narrowing the set of selected
+// rows. Results are the same as evaluating the condition with DocExprExecutor.
+class CompiledPgsqlCondition {
+ public:
+  CompiledPgsqlCondition() = default;
+
+  // Compiles the condition. Returns false when it contains expressions that are not supported, in
+  // which case the condition should be evaluated with DocExprExecutor.
+  bool Init(const PgsqlExpressionPB& condition);
+
+  // Fills selection with indexes of rows among the first num_rows rows that match the condition.
+  CHECKED_STATUS Evaluate(const std::vector<QLTableRow>& rows,
+                          size_t num_rows,
+                          std::vector<size_t>* selection) const;
+
+ private:
+  struct Comparison {
+    ColumnIdRep column_id;
+    QLOperator op;
+    // Type of the constant, not used by IS NULL and IS NOT NULL.
+    QLValuePB::ValueCase type;
+    int64_t value;
+  };
+
+  bool AddCondition(const PgsqlConditionPB& condition);
+
+  template <class Op>
+  CHECKED_STATUS Filter(const Comparison& comparison,
+                        const Op& op,
+                        const std::vector<QLTableRow>& rows,
+                        std::vector<size_t>* selection) const;
+
+  std::vector<Comparison> comparisons_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_COMPILED_CONDITION_H
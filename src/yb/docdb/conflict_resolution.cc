@@ -359,6 +359,9 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
           }
         }
       };
+      // Status of the same blocking transaction is requested by all resolvers that conflict with
+      // it, so pending status received a moment ago is good enough.
+      request.accept_recent_pending = true;
       status_manager().RequestStatusAt(request);
     }
   }
@@ -136,5 +136,40 @@ TEST_F(ConsensusFrontierTest, TestUpdates) {
             "hybrid_time_filter: <invalid> }");
 }
 
+TEST_F(ConsensusFrontierTest, TestTtlExpiration) {
+  ConsensusFrontier frontier{{1, 1}, 1000_usec_ht, HybridTime::kInvalid};
+  frontier.set_value_ttl_expiration(2000_usec_ht);
+  frontier.set_ttl_row_expiration(HybridTime::kMin);
+
+  ConsensusFrontier newer{{1, 2}, 1100_usec_ht, HybridTime::kInvalid};
+  newer.set_value_ttl_expiration(3000_usec_ht);
+  newer.set_ttl_row_expiration(2500_usec_ht);
+
+  ConsensusFrontier merged = frontier;
+  merged.Update(newer, UpdateUserValueType::kLargest);
+  EXPECT_EQ(3000_usec_ht, merged.value_ttl_expiration());
+  EXPECT_EQ(2500_usec_ht, merged.ttl_row_expiration());
+  EXPECT_TRUE(merged.Dominates(frontier, UpdateUserValueType::kLargest));
+
+  google::protobuf::Any any;
+  merged.ToPB(&any);
+  ConsensusFrontier decoded;
+  decoded.FromPB(any);
+  EXPECT_TRUE(decoded.Equals(merged));
+
+  // Expiration of merged data is unknown when expiration of any part of it is unknown.
+  ConsensusFrontier unknown{{1, 3}, 1200_usec_ht, HybridTime::kInvalid};
+  merged.Update(unknown, UpdateUserValueType::kLargest);
+  EXPECT_FALSE(merged.value_ttl_expiration().is_valid());
+  EXPECT_FALSE(merged.ttl_row_expiration().is_valid());
+  EXPECT_TRUE(merged.Dominates(newer, UpdateUserValueType::kLargest));
+  EXPECT_FALSE(newer.Dominates(merged, UpdateUserValueType::kLargest));
+
+  unknown.ToPB(&any);
+  decoded.FromPB(any);
+  EXPECT_FALSE(decoded.value_ttl_expiration().is_valid());
+  EXPECT_TRUE(decoded.Equals(unknown));
+}
+
 }  // namespace docdb
 }  // namespace yb
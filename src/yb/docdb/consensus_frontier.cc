@@ -24,7 +24,9 @@ ConsensusFrontier::~ConsensusFrontier() {
 bool ConsensusFrontier::Equals(const UserFrontier& pre_rhs) const {
   const ConsensusFrontier& rhs = down_cast<const ConsensusFrontier&>(pre_rhs);
   return op_id_ == rhs.op_id_ && ht_ == rhs.ht_ && history_cutoff_ == rhs.history_cutoff_ &&
-         hybrid_time_filter_ == rhs.hybrid_time_filter_;
+         hybrid_time_filter_ == rhs.hybrid_time_filter_ &&
+         value_ttl_expiration_ == rhs.value_ttl_expiration_ &&
+         ttl_row_expiration_ == rhs.ttl_row_expiration_;
 }
 
 void ConsensusFrontier::ToPB(google::protobuf::Any* any) const {
@@ -35,6 +37,12 @@ void ConsensusFrontier::ToPB(google::protobuf::Any* any) const {
   if (hybrid_time_filter_.is_valid()) {
     pb.set_hybrid_time_filter(hybrid_time_filter_.ToUint64());
   }
+  if (value_ttl_expiration_.is_valid()) {
+    pb.set_value_ttl_expiration(value_ttl_expiration_.ToUint64());
+  }
+  if (ttl_row_expiration_.is_valid()) {
+    pb.set_ttl_row_expiration(ttl_row_expiration_.ToUint64());
+  }
   any->PackFrom(pb);
 }
 
@@ -49,6 +57,10 @@ void ConsensusFrontier::FromPB(const google::protobuf::Any& any) {
   } else {
     hybrid_time_filter_ = HybridTime();
   }
+  value_ttl_expiration_ = pb.has_value_ttl_expiration()
+      ? HybridTime(pb.value_ttl_expiration()) : HybridTime();
+  ttl_row_expiration_ = pb.has_ttl_row_expiration()
+      ? HybridTime(pb.ttl_row_expiration()) : HybridTime();
 }
 
 void ConsensusFrontier::FromOpIdPBDeprecated(const OpIdPB& pb) {
@@ -56,9 +68,15 @@ void ConsensusFrontier::FromOpIdPBDeprecated(const OpIdPB& pb) {
 }
 
 std::string ConsensusFrontier::ToString() const {
+  std::string expiration;
+  if (value_ttl_expiration_.is_valid() || ttl_row_expiration_.is_valid()) {
+    expiration = yb::Format(
+        " value_ttl_expiration: $0 ttl_row_expiration: $1",
+        value_ttl_expiration_, ttl_row_expiration_);
+  }
   return yb::Format(
-      "{ op_id: $0 hybrid_time: $1 history_cutoff: $2 hybrid_time_filter: $3 }",
-      op_id_, ht_, history_cutoff_, hybrid_time_filter_);
+      "{ op_id: $0 hybrid_time: $1 history_cutoff: $2 hybrid_time_filter: $3$4 }",
+      op_id_, ht_, history_cutoff_, hybrid_time_filter_, expiration);
 }
 
 namespace {
@@ -96,6 +114,17 @@ void UpdateField(
   FATAL_INVALID_ENUM_VALUE(rocksdb::UpdateUserValueType, update_type);
 }
 
+// Unlike UpdateField, unknown (invalid) value wins, because expiration of merged data is unknown
+// when expiration of any part of it is unknown.
+void UpdateExpiration(
+    HybridTime* this_value, HybridTime new_value, rocksdb::UpdateUserValueType update_type) {
+  if (!this_value->is_valid() || !new_value.is_valid()) {
+    *this_value = HybridTime();
+    return;
+  }
+  UpdateField(this_value, new_value, update_type);
+}
+
 } // anonymous namespace
 
 void ConsensusFrontier::Update(
@@ -104,6 +133,8 @@ void ConsensusFrontier::Update(
   UpdateField(&op_id_, rhs.op_id_, update_type);
   UpdateField(&ht_, rhs.ht_, update_type);
   UpdateField(&history_cutoff_, rhs.history_cutoff_, update_type);
+  UpdateExpiration(&value_ttl_expiration_, rhs.value_ttl_expiration_, update_type);
+  UpdateExpiration(&ttl_row_expiration_, rhs.ttl_row_expiration_, update_type);
   // Reset filter after compaction.
   hybrid_time_filter_ = HybridTime();
 }
@@ -74,6 +74,12 @@ class ConsensusFrontier : public rocksdb::UserFrontier {
     hybrid_time_filter_ = value;
   }
 
+  HybridTime value_ttl_expiration() const { return value_ttl_expiration_; }
+  void set_value_ttl_expiration(HybridTime value) { value_ttl_expiration_ = value; }
+
+  HybridTime ttl_row_expiration() const { return ttl_row_expiration_; }
+  void set_ttl_row_expiration(HybridTime value) { ttl_row_expiration_ = value; }
+
  private:
   OpId op_id_;
   HybridTime ht_;
@@ -84,6 +90,17 @@ class ConsensusFrontier : public rocksdb::UserFrontier {
   HybridTime history_cutoff_;
 
   HybridTime hybrid_time_filter_;
+
+  // Max expiration time of values written to the file according to their value level TTL,
+  // HybridTime::kMax if some of them do not expire. TTL rows, i.e. merge records that change TTL
+  // of existing values, are also included. Invalid when unknown, e.g. file contains transactional
+  // writes or was written before this field was introduced, and it stays invalid when merged with
+  // other frontiers. Only the largest frontier of this parameter is being used.
+  HybridTime value_ttl_expiration_;
+
+  // Max expiration time of TTL rows written to the file, HybridTime::kMin if there are no such
+  // rows. Unknown is handled the same way as for value_ttl_expiration_.
+  HybridTime ttl_row_expiration_;
 };
 
 typedef rocksdb::UserFrontiersBase<ConsensusFrontier> ConsensusFrontiers;
@@ -43,6 +43,10 @@ DEFINE_bool(ycql_consistent_transactional_paging, false,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_int32(ycql_scan_batch_size, 1024,
+             "Number of rows read from the DocDB iterator at a time by YCQL scans of tables "
+             "without static columns. Set to 1 to read rows one at a time.");
+
 DECLARE_bool(trace_docdb_calls);
 
 namespace yb {
@@ -1277,7 +1281,28 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   // Begin the normal fetch.
   int match_count = 0;
   bool static_dealt_with = true;
-  while (resultset->rsrow_count() < row_count_limit && VERIFY_RESULT(iter->HasNext())) {
+
+  // Without static columns every row read is a regular row that maps to at most one result row,
+  // so rows can be read in batches of no more than the number of result rows still needed.
+  const bool use_row_batch = !schema.has_statics() && !read_distinct_columns &&
+                             static_row_spec == nullptr && FLAGS_ycql_scan_batch_size > 1;
+  while (use_row_batch && resultset->rsrow_count() < row_count_limit) {
+    const size_t max_rows = std::min<size_t>(
+        FLAGS_ycql_scan_batch_size, row_count_limit - resultset->rsrow_count());
+    const size_t num_rows = VERIFY_RESULT(iter->NextRowBatch(
+        non_static_projection, max_rows, &row_batch_));
+    for (size_t i = 0; i != num_rows; ++i) {
+      RETURN_NOT_OK(AddRowToResult(
+          spec, row_batch_[i], row_count_limit, offset, resultset, &match_count,
+          &num_rows_skipped));
+    }
+    if (num_rows < max_rows) {
+      break;
+    }
+  }
+
+  while (!use_row_batch && resultset->rsrow_count() < row_count_limit &&
+         VERIFY_RESULT(iter->HasNext())) {
     const bool last_read_static = iter->IsNextStaticColumn();
 
     // Note that static columns are sorted before non-static columns in DocDB as follows. This is
@@ -233,6 +233,9 @@ class QLReadOperation : public DocExprExecutor {
   const QLReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
   QLResponsePB response_;
+
+  // Reused across NextRowBatch calls to avoid reallocating rows for every batch.
+  std::vector<QLTableRow> row_batch_;
 };
 
 }  // namespace docdb
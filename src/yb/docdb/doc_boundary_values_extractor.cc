@@ -13,6 +13,7 @@
 //
 //
 
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/docdb/consensus_frontier.h"
@@ -223,8 +224,42 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
   }
 };
 
+// Filters out files that contain only records written after max_ht, in addition to the files
+// filtered out by the provided filter.
+class ReadTimeFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  ReadTimeFileFilter(HybridTime max_ht, std::shared_ptr<rocksdb::ReadFileFilter> filter)
+      : max_ht_(max_ht), filter_(std::move(filter)) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    if (filter_ && !filter_->Filter(file)) {
+      return false;
+    }
+    // Files written by older versions could have no hybrid time boundaries.
+    const auto* smallest = file.smallest.user_value_with_tag(kDocHybridTimeTag);
+    if (!smallest) {
+      return true;
+    }
+    DocHybridTime min_doc_ht;
+    if (!min_doc_ht.FullyDecodeFrom(*smallest).ok()) {
+      return true;
+    }
+    return min_doc_ht.hybrid_time() <= max_ht_;
+  }
+
+ private:
+  const HybridTime max_ht_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> filter_;
+};
+
 } // namespace
 
+std::shared_ptr<rocksdb::ReadFileFilter> CreateReadTimeFileFilter(
+    HybridTime max_ht, std::shared_ptr<rocksdb::ReadFileFilter> filter) {
+  return std::make_shared<ReadTimeFileFilter>(max_ht, std::move(filter));
+}
+
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance() {
   static std::shared_ptr<rocksdb::BoundaryValuesExtractor> instance =
       std::make_shared<DocBoundaryValuesExtractor>();
@@ -252,10 +252,19 @@ CHECKED_STATUS DocExprExecutor::EvalTSCall(const PgsqlBCallPB& tscall,
       int32_t col_attrno = tscall.operands(1).value().int32_value();
       int32_t ret_typeid = tscall.operands(2).value().int32_value();
       int32_t ret_typemod = tscall.operands(3).value().int32_value();
+      // Optional triples of referenced column, its YSQL type id and type mod follow.
+      std::vector<DocPgVarRef> var_refs;
+      for (int i = 4; i + 2 < tscall.operands_size(); i += 3) {
+        var_refs.push_back(DocPgVarRef{
+            ColumnId(tscall.operands(i).column_id()),
+            YbgTypeDesc{tscall.operands(i + 1).value().int32_value(),
+                        tscall.operands(i + 2).value().int32_value()}});
+      }
       RETURN_NOT_OK(DocPgEvalExpr(expr_str,
                                   col_attrno,
                                   ret_typeid,
                                   ret_typemod,
+                                  var_refs,
                                   table_row,
                                   schema,
                                   result));
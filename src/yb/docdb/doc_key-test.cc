@@ -439,6 +439,35 @@ TEST_F(DocKeyTest, TestWriteId) {
   TestRoundTripDocOrSubDocKeyEncodingDecoding(subdoc_key);
 }
 
+TEST_F(DocKeyTest, TestDocKeyRange) {
+  const auto key1 = DocKey(PrimitiveValues("row1")).Encode();
+  const auto key2 = DocKey(PrimitiveValues("row2")).Encode();
+  const auto key3 = DocKey(PrimitiveValues("row3")).Encode();
+  const auto key4 = DocKey(PrimitiveValues("row4")).Encode();
+
+  DocKeyRange range;
+  ASSERT_FALSE(range.Overlaps(Slice(), Slice()));
+
+  range.Expand(key3.AsSlice(), key3.AsSlice());
+  range.Expand(key2.AsSlice(), key2.AsSlice());
+  ASSERT_TRUE(range.Overlaps(Slice(), Slice()));
+  ASSERT_TRUE(range.Overlaps(key1.AsSlice(), Slice()));
+  ASSERT_TRUE(range.Overlaps(key1.AsSlice(), key3.AsSlice()));
+  // Lower bound is inclusive, upper bound is exclusive.
+  ASSERT_TRUE(range.Overlaps(key3.AsSlice(), key4.AsSlice()));
+  ASSERT_FALSE(range.Overlaps(key1.AsSlice(), key2.AsSlice()));
+  ASSERT_FALSE(range.Overlaps(key4.AsSlice(), Slice()));
+
+  range.Clear();
+  ASSERT_FALSE(range.Overlaps(Slice(), Slice()));
+
+  auto unbounded = DocKeyRange::Unbounded();
+  unbounded.Expand(key2.AsSlice(), key2.AsSlice());
+  ASSERT_TRUE(unbounded.Overlaps(key4.AsSlice(), Slice()));
+  unbounded.Clear();
+  ASSERT_FALSE(unbounded.Overlaps(key4.AsSlice(), Slice()));
+}
+
 struct CollectedIntent {
   IntentStrength strength;
   KeyBytes intent_key;
@@ -724,5 +753,37 @@ TEST_F(DocKeyTest, TestEnumerateIntents) {
   }
 }
 
+TEST_F(DocKeyTest, MemoizedDocKeyDecoder) {
+  const DocKey key1(0x1234, PrimitiveValues("h1", 1), PrimitiveValues("r1", 10));
+  const DocKey key2(0x1234, PrimitiveValues("h1", 1), PrimitiveValues("r1", 20));
+  const DocKey key3(0x1234, PrimitiveValues("h1", 1), PrimitiveValues("r2", 20));
+  const DocKey key4(0x4321, PrimitiveValues("h2", 1), PrimitiveValues("r2", 20));
+  const DocKey key5(PrimitiveValues("r2", 20, "r3"));
+
+  MemoizedDocKeyDecoder decoder;
+  auto check = [&decoder](const DocKey& key, size_t expected_decoded_components) {
+    SCOPED_TRACE(key.ToString());
+    ASSERT_OK(decoder.Decode(key.Encode()));
+    ASSERT_EQ(!key.hashed_group().empty(), decoder.has_hash());
+    ASSERT_EQ(key.hashed_group(), decoder.hashed_group());
+    ASSERT_EQ(key.range_group(), decoder.range_group());
+    ASSERT_EQ(expected_decoded_components, decoder.num_decoded_components());
+  };
+
+  check(key1, 4);
+  // Only the last range component differs.
+  check(key2, 1);
+  check(key3, 2);
+  // Decoding the same key again does not decode anything.
+  check(key3, 0);
+  // Different hash code, so nothing could be reused.
+  check(key4, 4);
+  check(key5, 3);
+  check(key1, 4);
+
+  ASSERT_NOK(decoder.Decode(Slice("\x01")));
+  check(key1, 4);
+}
+
 }  // namespace docdb
 }  // namespace yb
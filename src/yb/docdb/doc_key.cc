@@ -1077,10 +1077,10 @@ DocDbAwareV2FilterPolicy::GetKeyTransformer() const {
 
 DocKeyEncoderAfterTableIdStep DocKeyEncoder::CotableId(const Uuid& cotable_id) {
   if (!cotable_id.IsNil()) {
-    std::string bytes;
-    cotable_id.EncodeToComparable(&bytes);
+    uint8_t bytes[kUuidSize];
+    cotable_id.EncodeToComparable(bytes);
     out_->AppendValueType(ValueType::kTableId);
-    out_->AppendRawBytes(bytes);
+    out_->AppendRawBytes(Slice(bytes, kUuidSize));
   }
   return DocKeyEncoderAfterTableIdStep(out_);
 }
@@ -1206,6 +1206,62 @@ bool DocKeyDecoder::GroupEnded() const {
   return input_.empty() || input_[0] == ValueTypeAsChar::kGroupEnd;
 }
 
+Status MemoizedDocKeyDecoder::Decode(const Slice& doc_key) {
+  const size_t common_prefix = doc_key.difference_offset(prev_key_);
+  num_decoded_components_ = 0;
+  // Make sure we don't reuse components of a partially decoded key after a failure.
+  prev_key_.clear();
+
+  DocKeyDecoder decoder(doc_key);
+  RETURN_NOT_OK(decoder.DecodeCotableId());
+  RETURN_NOT_OK(decoder.DecodePgtableId());
+  has_hash_ = VERIFY_RESULT(decoder.DecodeHashCode());
+  const size_t header_size = decoder.ConsumedSizeFrom(doc_key.data());
+  // Components of the previous key could be reused only while all preceding bytes are the same.
+  bool reuse = header_size <= common_prefix && header_size == header_size_;
+  header_size_ = header_size;
+
+  if (has_hash_) {
+    RETURN_NOT_OK(DecodeGroup(doc_key, common_prefix, &reuse, &decoder, &hashed_group_));
+  } else {
+    hashed_group_.values.clear();
+    hashed_group_.ends.clear();
+  }
+  if (!decoder.GroupEnded()) {
+    RETURN_NOT_OK(DecodeGroup(doc_key, common_prefix, &reuse, &decoder, &range_group_));
+  } else {
+    range_group_.values.clear();
+    range_group_.ends.clear();
+  }
+
+  prev_key_.assign(doc_key.cdata(), doc_key.size());
+  return Status::OK();
+}
+
+Status MemoizedDocKeyDecoder::DecodeGroup(
+    const Slice& doc_key, size_t common_prefix, bool* reuse, DocKeyDecoder* decoder,
+    Group* group) {
+  size_t idx = 0;
+  while (!decoder->GroupEnded()) {
+    if (*reuse && idx < group->ends.size() && group->ends[idx] <= common_prefix) {
+      *decoder->mutable_input() = Slice(doc_key.data() + group->ends[idx], doc_key.end());
+    } else {
+      *reuse = false;
+      if (idx == group->values.size()) {
+        group->values.emplace_back();
+        group->ends.push_back(0);
+      }
+      RETURN_NOT_OK(decoder->DecodePrimitiveValue(&group->values[idx]));
+      group->ends[idx] = decoder->ConsumedSizeFrom(doc_key.data());
+      ++num_decoded_components_;
+    }
+    ++idx;
+  }
+  group->values.resize(idx);
+  group->ends.resize(idx);
+  return decoder->ConsumeGroupEnd();
+}
+
 Result<bool> DocKeyDecoder::HasPrimitiveValue() {
   return docdb::HasPrimitiveValue(&input_, AllowSpecial::kFalse);
 }
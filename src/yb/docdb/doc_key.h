@@ -429,6 +429,52 @@ class DocKeyDecoder {
   Slice input_;
 };
 
+// Decodes hashed and range components of consecutive DocKeys, for instance of the rows visited by
+// a scan. Components that lie entirely within the common prefix of the key and the previously
+// decoded key are reused instead of being decoded again. So decoding the key of the next row in a
+// range scan usually decodes only the last range components.
+class MemoizedDocKeyDecoder {
+ public:
+  // Decodes a whole encoded DocKey, without subkeys and hybrid time.
+  CHECKED_STATUS Decode(const Slice& doc_key);
+
+  bool has_hash() const {
+    return has_hash_;
+  }
+
+  const std::vector<PrimitiveValue>& hashed_group() const {
+    return hashed_group_.values;
+  }
+
+  const std::vector<PrimitiveValue>& range_group() const {
+    return range_group_.values;
+  }
+
+  // Number of components actually decoded by the last Decode call, the remaining components were
+  // reused from the previous key.
+  size_t num_decoded_components() const {
+    return num_decoded_components_;
+  }
+
+ private:
+  struct Group {
+    std::vector<PrimitiveValue> values;
+    // Offset in the encoded key right after each component.
+    std::vector<size_t> ends;
+  };
+
+  CHECKED_STATUS DecodeGroup(
+      const Slice& doc_key, size_t common_prefix, bool* reuse, DocKeyDecoder* decoder,
+      Group* group);
+
+  std::string prev_key_;
+  bool has_hash_ = false;
+  size_t header_size_ = 0;
+  Group hashed_group_;
+  Group range_group_;
+  size_t num_decoded_components_ = 0;
+};
+
 // Clears range components from provided key. Returns true if they were exists.
 Result<bool> ClearRangeComponents(KeyBytes* out, AllowSpecial allow_special = AllowSpecial::kFalse);
 
@@ -904,12 +950,68 @@ struct KeyBounds {
   }
 };
 
+// Smallest range of doc keys that contains all doc keys added to it. Unbounded range contains all
+// doc keys, and adding keys to it does not change it.
+class DocKeyRange {
+ public:
+  static DocKeyRange Unbounded() {
+    DocKeyRange result;
+    result.unbounded_ = true;
+    return result;
+  }
+
+  // Extends the range, so it contains all doc keys in [min_doc_key, max_doc_key].
+  void Expand(const Slice& min_doc_key, const Slice& max_doc_key) {
+    if (unbounded_) {
+      return;
+    }
+    if (empty_ || min_doc_key.compare(min_doc_key_) < 0) {
+      min_doc_key_ = min_doc_key.ToBuffer();
+    }
+    if (empty_ || max_doc_key.compare(max_doc_key_) > 0) {
+      max_doc_key_ = max_doc_key.ToBuffer();
+    }
+    empty_ = false;
+  }
+
+  // Makes the range empty and bounded.
+  void Clear() {
+    unbounded_ = false;
+    empty_ = true;
+    min_doc_key_.clear();
+    max_doc_key_.clear();
+  }
+
+  // Returns true if the range has common keys with [lower_bound, upper_bound).
+  // Empty upper_bound means that there is no upper bound.
+  bool Overlaps(const Slice& lower_bound, const Slice& upper_bound) const {
+    if (unbounded_) {
+      return true;
+    }
+    if (empty_) {
+      return false;
+    }
+    return Slice(max_doc_key_).compare(lower_bound) >= 0 &&
+           (upper_bound.empty() || Slice(min_doc_key_).compare(upper_bound) < 0);
+  }
+
+ private:
+  bool unbounded_ = false;
+  bool empty_ = true;
+  std::string min_doc_key_;
+  std::string max_doc_key_;
+};
+
+class DocRowCache;
+
 // Combined DB to store regular records and intents.
 // TODO: move this to a more appropriate header file.
 struct DocDB {
   rocksdb::DB* regular;
   rocksdb::DB* intents;
   const KeyBounds* key_bounds;
+  // Cache of rows read by point reads, if enabled for the tablet.
+  DocRowCache* row_cache = nullptr;
 
   static DocDB FromRegularUnbounded(rocksdb::DB* regular) {
     return {regular, nullptr /* intents */, &KeyBounds::kNoBounds};
@@ -75,10 +75,10 @@ Status CheckHybridTimeSizeAndValueType(
 }
 
 template <char END_OF_STRING>
-void AppendEncodedStrToKey(const string &s, KeyBuffer *dest) {
+void AppendEncodedStrToKey(const Slice& s, KeyBuffer *dest) {
   static_assert(END_OF_STRING == '\0' || END_OF_STRING == '\xff',
                 "Only characters '\0' and '\xff' allowed as a template parameter");
-  if (END_OF_STRING == '\0' && s.find('\0') == string::npos) {
+  if (END_OF_STRING == '\0' && memchr(s.cdata(), '\0', s.size()) == nullptr) {
     // Fast path: no zero characters, nothing to encode.
     dest->append(s);
   } else {
@@ -93,11 +93,11 @@ void AppendEncodedStrToKey(const string &s, KeyBuffer *dest) {
   }
 }
 
-void AppendZeroEncodedStrToKey(const string &s, KeyBuffer *dest) {
+void AppendZeroEncodedStrToKey(const Slice& s, KeyBuffer *dest) {
   AppendEncodedStrToKey<'\0'>(s, dest);
 }
 
-void AppendComplementZeroEncodedStrToKey(const string &s, KeyBuffer *dest) {
+void AppendComplementZeroEncodedStrToKey(const Slice& s, KeyBuffer *dest) {
   AppendEncodedStrToKey<'\xff'>(s, dest);
 }
 
@@ -86,11 +86,11 @@ inline void AppendColumnIdToKey(ColumnId val, Buffer* dest) {
 
 // Encodes the given string by replacing '\x00' with "\x00\x01" and appends it to the given
 // destination string.
-void AppendZeroEncodedStrToKey(const std::string &s, KeyBuffer *dest);
+void AppendZeroEncodedStrToKey(const Slice& s, KeyBuffer *dest);
 
 // Encodes the given string by replacing '\xff' with "\xff\xfe" and appends it to the given
 // destination string.
-void AppendComplementZeroEncodedStrToKey(const string &s, KeyBuffer *dest);
+void AppendComplementZeroEncodedStrToKey(const Slice& s, KeyBuffer *dest);
 
 // Appends two zero characters to the given string. We don't add final end-of-string characters in
 // this function.
@@ -100,12 +100,12 @@ void TerminateZeroEncodedKeyStr(KeyBuffer *dest);
 // in this function.
 void TerminateComplementZeroEncodedKeyStr(KeyBuffer *dest);
 
-inline void ZeroEncodeAndAppendStrToKey(const std::string &s, KeyBuffer *dest) {
+inline void ZeroEncodeAndAppendStrToKey(const Slice& s, KeyBuffer *dest) {
   AppendZeroEncodedStrToKey(s, dest);
   TerminateZeroEncodedKeyStr(dest);
 }
 
-inline void ComplementZeroEncodeAndAppendStrToKey(const std::string &s, KeyBuffer* dest) {
+inline void ComplementZeroEncodeAndAppendStrToKey(const Slice& s, KeyBuffer* dest) {
   AppendComplementZeroEncodedStrToKey(s, dest);
   TerminateComplementZeroEncodedKeyStr(dest);
 }
@@ -138,9 +138,10 @@ DocPgsqlScanSpec::DocPgsqlScanSpec(const Schema& schema,
     InitRangeOptions(*condition);
 
     // Range options are only valid if all range columns are set (i.e. have one or more options).
+    // Otherwise options of the columns that have them are used to skip scan over range bounds.
     for (int i = 0; i < schema_.num_range_key_columns(); i++) {
       if ((*range_options_)[i].empty()) {
-        range_options_ = nullptr;
+        partial_range_options_ = std::move(range_options_);
         break;
       }
     }
@@ -78,6 +78,12 @@ class DocPgsqlScanSpec : public common::PgsqlScanSpec {
     return range_options_;
   }
 
+  // Options of range columns with EQ/IN conditions, when only some of range columns have them.
+  // Columns without such conditions have no options and are constrained by range_bounds only.
+  const std::shared_ptr<std::vector<std::vector<PrimitiveValue>>>& partial_range_options() const {
+    return partial_range_options_;
+  }
+
  private:
   // Return inclusive lower/upper range doc key considering the start_doc_key.
   Result<KeyBytes> Bound(const bool lower_bound) const;
@@ -90,12 +96,15 @@ class DocPgsqlScanSpec : public common::PgsqlScanSpec {
 
   // Initialize range_options_ if hashed_components_ in set and all range columns have one or more
   // options (i.e. using EQ/IN conditions). Otherwise range_options_ will stay null and we will
-  // only use the range_bounds for scanning.
+  // use the range_bounds for scanning, with partial_range_options_ if some columns have options.
   void InitRangeOptions(const PgsqlConditionPB& condition);
 
   // The range value options if set. (possibly more than one due to IN conditions).
   std::shared_ptr<std::vector<std::vector<PrimitiveValue>>> range_options_;
 
+  // See partial_range_options().
+  std::shared_ptr<std::vector<std::vector<PrimitiveValue>>> partial_range_options_;
+
   // Schema of the columns to scan.
   const Schema& schema_;
 
@@ -64,6 +64,12 @@ class DocQLScanSpec : public common::QLScanSpec {
     return range_options_;
   }
 
+  // Options of range columns with EQ/IN conditions, when only some of range columns have them.
+  // Columns without such conditions have no options and are constrained by range_bounds only.
+  const std::shared_ptr<std::vector<std::vector<PrimitiveValue>>>& partial_range_options() const {
+    return partial_range_options_;
+  }
+
   bool include_static_columns() const {
     return include_static_columns_;
   }
@@ -80,7 +86,7 @@ class DocQLScanSpec : public common::QLScanSpec {
 
   // Initialize range_options_ if hashed_components_ in set and all range columns have one or more
   // options (i.e. using EQ/IN conditions). Otherwise range_options_ will stay null and we will
-  // only use the range_bounds for scanning.
+  // use the range_bounds for scanning, with partial_range_options_ if some columns have options.
   void InitRangeOptions(const QLConditionPB& condition);
 
   // Returns the lower/upper doc key based on the range components.
@@ -109,6 +115,9 @@ class DocQLScanSpec : public common::QLScanSpec {
   // The range value options if set. (possibly more than one due to IN conditions).
   std::shared_ptr<std::vector<std::vector<PrimitiveValue>>> range_options_;
 
+  // See partial_range_options().
+  std::shared_ptr<std::vector<std::vector<PrimitiveValue>>> partial_range_options_;
+
   // Does the scan include static columns also?
   const bool include_static_columns_;
 
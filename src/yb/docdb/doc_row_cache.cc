@@ -0,0 +1,109 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_row_cache.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_write_batch.h"
+#include "yb/docdb/docdb.pb.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(docdb_row_cache_max_entries, 0,
+             "Maximum number of rows read by point reads of a full primary key, that are cached "
+             "per tablet to serve later reads of the same rows. 0 to disable.");
+TAG_FLAG(docdb_row_cache_max_entries, advanced);
+
+namespace yb {
+namespace docdb {
+
+bool DocRowCache::Get(const Slice& doc_key, const std::vector<PrimitiveValue>& projection,
+                      HybridTime read_time, SubDocument* row) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(KeyBuffer(doc_key));
+  if (it == entries_.end() || it->second.read_time > read_time ||
+      it->second.projection != projection) {
+    return false;
+  }
+  *row = it->second.row;
+  return true;
+}
+
+void DocRowCache::Put(const Slice& doc_key, const std::vector<PrimitiveValue>& projection,
+                      const SubDocument& row, HybridTime read_time, uint64_t epoch) {
+  const auto epoch_index = EpochIndex(doc_key);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& max_write_time = max_write_times_[epoch_index];
+  if (Epoch(doc_key) != epoch || (max_write_time.is_valid() && max_write_time > read_time)) {
+    return;
+  }
+  if (entries_.size() >= static_cast<size_t>(FLAGS_docdb_row_cache_max_entries)) {
+    // Hot rows are read again soon after, so just start over instead of tracking recency.
+    entries_.clear();
+  }
+  auto& entry = entries_[KeyBuffer(doc_key)];
+  entry.projection = projection;
+  entry.row = row;
+  entry.read_time = read_time;
+}
+
+void DocRowCache::InvalidateDocuments(
+    const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time) {
+  // Values replicated from another cluster are written at their external hybrid time.
+  for (const auto& pair : put_batch.write_pairs()) {
+    if (pair.has_external_hybrid_time()) {
+      hybrid_time.MakeAtLeast(HybridTime(pair.external_hybrid_time()));
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  WARN_NOT_OK(EnumerateWritePairs(
+                  put_batch,
+                  [this, hybrid_time](const Slice& key, const Slice& value) {
+                    DocKey decoded_doc_key;
+                    auto doc_key_size = decoded_doc_key.DecodeFrom(key);
+                    if (!doc_key_size.ok() || (decoded_doc_key.hashed_group().empty() &&
+                                               decoded_doc_key.range_group().empty())) {
+                      // Could not find the document, or it is a table tombstone that deletes all
+                      // documents of colocated table, so invalidate all of them.
+                      for (size_t i = 0; i != kNumEpochs; ++i) {
+                        InvalidateUnlocked(i, hybrid_time);
+                      }
+                      entries_.clear();
+                      return Status::OK();
+                    }
+                    const auto doc_key = key.Prefix(*doc_key_size);
+                    InvalidateUnlocked(EpochIndex(doc_key), hybrid_time);
+                    entries_.erase(KeyBuffer(doc_key));
+                    return Status::OK();
+                  }),
+              "Failed to invalidate rows");
+}
+
+void DocRowCache::Clear(HybridTime hybrid_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i != kNumEpochs; ++i) {
+    InvalidateUnlocked(i, hybrid_time);
+  }
+  entries_.clear();
+}
+
+void DocRowCache::InvalidateUnlocked(size_t epoch_index, HybridTime hybrid_time) {
+  epochs_[epoch_index].fetch_add(1, std::memory_order_acq_rel);
+  auto& max_write_time = max_write_times_[epoch_index];
+  if (!max_write_time.is_valid() || max_write_time < hybrid_time) {
+    max_write_time = hybrid_time;
+  }
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,95 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_DOC_ROW_CACHE_H
+#define YB_DOCDB_DOC_ROW_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "yb/common/hybrid_time.h"
+
+#include "yb/docdb/key_bytes.h"
+#include "yb/docdb/subdocument.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+class KeyValueWriteBatchPB;
+
+// Per tablet cache of rows read by point reads of a full primary key, keyed by encoded DocKey.
+// A row is cached with the projection and the hybrid time it was read at, and is served to reads
+// of the same projection at or after that time.
+//
+// Rows are invalidated when writes to them are applied to the regular DB. Reads capture the epoch
+// of the row before reading it from RocksDB, so rows whose writes were applied in the meantime are
+// not cached. Each epoch also tracks the max hybrid time of invalidated writes, so a row read
+// before a write, that was applied before the row was read, is not cached either.
+class DocRowCache {
+ public:
+  // Returns the current epoch of the document.
+  uint64_t Epoch(const Slice& doc_key) const {
+    return epochs_[EpochIndex(doc_key)].load(std::memory_order_acquire);
+  }
+
+  // Copies the cached row of the document to row, if it was read with the same projection at a
+  // hybrid time not after read_time. Returns false if there is no such row.
+  bool Get(const Slice& doc_key, const std::vector<PrimitiveValue>& projection,
+           HybridTime read_time, SubDocument* row);
+
+  // Adds the row read at read_time, unless the document was invalidated since epoch was
+  // obtained, or a write after read_time was applied to it.
+  void Put(const Slice& doc_key, const std::vector<PrimitiveValue>& projection,
+           const SubDocument& row, HybridTime read_time, uint64_t epoch);
+
+  // Invalidates all documents modified by the non-transactional write batch applied at
+  // hybrid_time.
+  void InvalidateDocuments(const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time);
+
+  // Invalidates all documents, for instance when transaction intents are applied at hybrid_time.
+  // Without hybrid_time, only rows being read concurrently are not cached.
+  void Clear(HybridTime hybrid_time = HybridTime::kMin);
+
+ private:
+  struct Entry {
+    std::vector<PrimitiveValue> projection;
+    SubDocument row;
+    HybridTime read_time;
+  };
+
+  // Documents are mapped to a fixed number of epochs by the hash of their encoded DocKey.
+  static constexpr size_t kNumEpochs = 64;
+
+  static size_t EpochIndex(const Slice& doc_key) {
+    return doc_key.hash() % kNumEpochs;
+  }
+
+  void InvalidateUnlocked(size_t epoch_index, HybridTime hybrid_time);
+
+  std::array<std::atomic<uint64_t>, kNumEpochs> epochs_ = {};
+
+  std::mutex mutex_;
+  // Max hybrid time of writes invalidated in each epoch.
+  std::array<HybridTime, kNumEpochs> max_write_times_;
+  std::map<KeyBuffer, Entry> entries_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_DOC_ROW_CACHE_H
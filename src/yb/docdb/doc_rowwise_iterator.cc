@@ -21,6 +21,7 @@
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/doc_row_cache.h"
 #include "yb/docdb/doc_scanspec_util.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb.h"
@@ -334,8 +335,10 @@ class RangeBasedScanChoices : public ScanChoices {
   CHECKED_STATUS DoneWithCurrentTarget() override;
   CHECKED_STATUS SeekToCurrentTarget(IntentAwareIterator* db_iter) override;
 
- private:
+ protected:
   std::vector<PrimitiveValue> lower_, upper_;
+
+ private:
   KeyBytes prev_scan_target_;
 };
 
@@ -449,6 +452,122 @@ Status RangeBasedScanChoices::SeekToCurrentTarget(IntentAwareIterator* db_iter)
   return Status::OK();
 }
 
+// Skip scan over range columns, when some of them have EQ/IN conditions and others have range
+// bounds or no conditions at all. Each column has a list of options in scan order: a single value
+// for each EQ/IN option, or a single range for other columns. When the value of some column in the
+// row key is not within its options, the iterator seeks directly to the next option of this column,
+// or past the current value of the previous column if there are no options left.
+// For instance, for "h = 1 and r2 in (4, 5)" the scan target for the row key [1][2, 3] is
+// [1][2, 4], and for the row key [1][2, 6] it is [1][2, +Inf], i.e. the next value of r1.
+class HybridScanChoices : public RangeBasedScanChoices {
+ public:
+  HybridScanChoices(const Schema& schema, const DocQLScanSpec& doc_spec)
+      : RangeBasedScanChoices(schema, doc_spec) {
+    InitOptions(*doc_spec.partial_range_options());
+  }
+
+  HybridScanChoices(const Schema& schema, const DocPgsqlScanSpec& doc_spec)
+      : RangeBasedScanChoices(schema, doc_spec) {
+    InitOptions(*doc_spec.partial_range_options());
+  }
+
+  CHECKED_STATUS SkipTargetsUpTo(const Slice& new_target) override;
+
+ private:
+  struct OptionRange {
+    PrimitiveValue lower;
+    PrimitiveValue upper;
+  };
+
+  void InitOptions(const std::vector<std::vector<PrimitiveValue>>& range_options);
+
+  // Scan start of the option in scan direction.
+  const PrimitiveValue& OptionStart(const OptionRange& option) const {
+    return is_forward_scan_ ? option.lower : option.upper;
+  }
+
+  // Options of each range column, in scan order.
+  std::vector<std::vector<OptionRange>> options_;
+};
+
+void HybridScanChoices::InitOptions(
+    const std::vector<std::vector<PrimitiveValue>>& range_options) {
+  DCHECK_EQ(range_options.size(), lower_.size());
+  options_.resize(range_options.size());
+  for (size_t col_idx = 0; col_idx != range_options.size(); ++col_idx) {
+    auto& column_options = options_[col_idx];
+    if (range_options[col_idx].empty()) {
+      column_options.push_back(OptionRange{lower_[col_idx], upper_[col_idx]});
+      continue;
+    }
+    // Options are already in scan order, see InitRangeOptions of scan specs.
+    column_options.reserve(range_options[col_idx].size());
+    for (const auto& value : range_options[col_idx]) {
+      column_options.push_back(OptionRange{value, value});
+    }
+  }
+}
+
+Status HybridScanChoices::SkipTargetsUpTo(const Slice& new_target) {
+  VLOG(2) << __PRETTY_FUNCTION__ << " Updating current target to be >= "
+          << DocKey::DebugSliceToString(new_target);
+  DCHECK(!FinishedWithScanChoices());
+
+  DocKeyDecoder decoder(new_target);
+  RETURN_NOT_OK(decoder.DecodeToRangeGroup());
+  current_scan_target_.Reset(Slice(new_target.data(), decoder.left_input().data()));
+
+  size_t col_idx = 0;
+  PrimitiveValue target_value;
+  bool last_was_infinity = false;
+  while (col_idx < options_.size() && VERIFY_RESULT(decoder.HasPrimitiveValue())) {
+    RETURN_NOT_OK(decoder.DecodePrimitiveValue(&target_value));
+    const auto& options = options_[col_idx];
+    ++col_idx;
+
+    // The first option, that does not end before the target value in scan direction.
+    auto it = is_forward_scan_
+        ? std::partition_point(options.begin(), options.end(), [&target_value](const auto& option) {
+            return option.upper < target_value;
+          })
+        : std::partition_point(options.begin(), options.end(), [&target_value](const auto& option) {
+            return option.lower > target_value;
+          });
+    if (it == options.end()) {
+      // Target value is beyond all options of this column, so go to the next value of the
+      // previous column.
+      PrimitiveValue(is_forward_scan_ ? ValueType::kHighest : ValueType::kLowest)
+          .AppendToKey(&current_scan_target_);
+      last_was_infinity = true;
+      break;
+    }
+
+    const auto& start = OptionStart(*it);
+    if (is_forward_scan_ ? target_value < start : target_value > start) {
+      // Target value is between options, so go to the start of the next option.
+      start.AppendToKey(&current_scan_target_);
+      last_was_infinity = start.IsInfinity();
+      break;
+    }
+
+    target_value.AppendToKey(&current_scan_target_);
+    last_was_infinity = target_value.IsInfinity();
+  }
+
+  // Remaining columns start from their first options.
+  for (; col_idx < options_.size() && !last_was_infinity; ++col_idx) {
+    const auto& start = OptionStart(options_[col_idx].front());
+    start.AppendToKey(&current_scan_target_);
+    last_was_infinity = start.IsInfinity();
+  }
+
+  VLOG(2) << "After " << __PRETTY_FUNCTION__ << " current_scan_target_ is "
+          << DocKey::DebugSliceToString(current_scan_target_);
+  current_scan_target_.AppendValueType(ValueType::kGroupEnd);
+
+  return Status::OK();
+}
+
 DocRowwiseIterator::DocRowwiseIterator(
     const Schema &projection,
     const Schema &schema,
@@ -508,7 +627,9 @@ Result<bool> DocRowwiseIterator::InitScanChoices(
     return true;
   }
 
-  if (doc_spec.range_bounds()) {
+  if (doc_spec.partial_range_options()) {
+    scan_choices_.reset(new HybridScanChoices(schema_, doc_spec));
+  } else if (doc_spec.range_bounds()) {
     scan_choices_.reset(new RangeBasedScanChoices(schema_, doc_spec));
   }
 
@@ -525,7 +646,9 @@ Result<bool> DocRowwiseIterator::InitScanChoices(
     return true;
   }
 
-  if (doc_spec.range_bounds()) {
+  if (doc_spec.partial_range_options()) {
+    scan_choices_.reset(new HybridScanChoices(schema_, doc_spec));
+  } else if (doc_spec.range_bounds()) {
     scan_choices_.reset(new RangeBasedScanChoices(schema_, doc_spec));
   }
 
@@ -550,12 +673,40 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
+  // Rows outside of the scan bounds are never read, so intents do not have to be read either when
+  // no running transaction wrote within these bounds. Colocated tables also read the table
+  // tombstone, which lies outside of the bounds, so they always read intents.
+  boost::optional<KeyBounds> scan_bounds;
+  if (!schema_.has_cotable_id() && !schema_.has_pgtable_id()) {
+    scan_bounds.emplace(lower_doc_key, upper_doc_key);
+    if (doc_db_.row_cache && is_fixed_point_get && is_forward_scan_) {
+      RETURN_NOT_OK(InitRowCacheKey(lower_doc_key, upper_doc_key));
+    }
+  }
+
+  // The epoch should be obtained before the RocksDB iterator is created, because the iterator
+  // reads the data as of its creation.
+  if (!row_cache_key_.empty()) {
+    row_cache_epoch_ = doc_db_.row_cache->Epoch(row_cache_key_.AsSlice());
+  }
+
   db_iter_ = CreateIntentAwareIterator(
       doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      deadline_, read_time_, doc_spec.CreateFileFilter(), nullptr /* iterate_upper_bound */,
+      scan_bounds.get_ptr());
 
   row_ready_ = false;
 
+  if (!row_cache_key_.empty()) {
+    // Intents of running transactions could be visible to this read, so the regular DB is not
+    // enough to read the row.
+    if (db_iter_->reads_intents()) {
+      row_cache_key_.Clear();
+    } else if (VERIFY_RESULT(ReadFromRowCache())) {
+      return Status::OK();
+    }
+  }
+
   if (is_forward_scan_) {
     has_bound_key_ = !upper_doc_key.empty();
     if (has_bound_key_) {
@@ -586,6 +737,71 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   return Status::OK();
 }
 
+Status DocRowwiseIterator::InitRowCacheKey(
+    const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key) {
+  // Expired values are not returned, so rows could not be cached when values have TTL.
+  if (schema_.has_statics() || TableTTL(schema_) != Value::kMaxTtl) {
+    return Status::OK();
+  }
+
+  // Point read of a doc key scans from the doc key to the doc key followed by +inf.
+  KeyBytes point_upper_doc_key = lower_doc_key;
+  point_upper_doc_key.AppendValueTypeBeforeGroupEnd(ValueType::kHighest);
+  if (point_upper_doc_key != upper_doc_key) {
+    return Status::OK();
+  }
+
+  DocKey doc_key;
+  RETURN_NOT_OK(doc_key.FullyDecodeFrom(lower_doc_key.AsSlice()));
+  if (doc_key.hashed_group().size() == schema_.num_hash_key_columns() &&
+      doc_key.range_group().size() == schema_.num_range_key_columns()) {
+    row_cache_key_ = lower_doc_key;
+  }
+  return Status::OK();
+}
+
+Result<bool> DocRowwiseIterator::ReadFromRowCache() {
+  if (!doc_db_.row_cache->Get(
+          row_cache_key_.AsSlice(), projection_subkeys_, read_time_.read, &row_)) {
+    return false;
+  }
+  iter_key_ = row_cache_key_;
+  const auto dockey_sizes = VERIFY_RESULT(DocKey::EncodedHashPartAndDocKeySizes(iter_key_));
+  row_hash_key_ = iter_key_.AsSlice().Prefix(dockey_sizes.first);
+  row_key_ = iter_key_.AsSlice().Prefix(dockey_sizes.second);
+  row_ready_ = true;
+  row_from_cache_ = true;
+  return true;
+}
+
+namespace {
+
+bool HasTtl(const SubDocument& doc) {
+  if (doc.GetTtl() != -1) {
+    return true;
+  }
+  if (IsObjectType(doc.value_type()) && doc.object_num_keys() != 0) {
+    for (const auto& child : doc.object_container()) {
+      if (HasTtl(child.second)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void DocRowwiseIterator::MaybeCacheRow() const {
+  // Read would be restarted, when a newer version of the row was seen.
+  const auto max_seen_ht = db_iter_->max_seen_ht();
+  if ((max_seen_ht.is_valid() && max_seen_ht > read_time_.read) || HasTtl(row_)) {
+    return;
+  }
+  doc_db_.row_cache->Put(
+      row_cache_key_.AsSlice(), projection_subkeys_, row_, read_time_.read, row_cache_epoch_);
+}
+
 Status DocRowwiseIterator::Init(const common::QLScanSpec& spec) {
   return DoInit(dynamic_cast<const DocQLScanSpec&>(spec));
 }
@@ -625,6 +841,10 @@ Result<bool> DocRowwiseIterator::HasNext() const {
   if (done_) {
     return false;
   }
+  if (row_from_cache_) {
+    done_ = true;
+    return false;
+  }
 
   bool doc_found = false;
   while (!doc_found) {
@@ -704,6 +924,10 @@ Result<bool> DocRowwiseIterator::HasNext() const {
     RETURN_NOT_OK(has_next_status_);
     // After this, the iter should be positioned right after the subdocument.
 
+    if (doc_found && !row_cache_key_.empty() && row_key_ == row_cache_key_.AsSlice()) {
+      MaybeCacheRow();
+    }
+
     if (!doc_found) {
       SubDocument full_row;
       // If doc is not found, decide if some non-projection column exists.
@@ -731,12 +955,16 @@ string DocRowwiseIterator::ToString() const {
 
 namespace {
 
-// Set primary key column values (hashed or range columns) in a QL row value map.
-CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
+// Set primary key column values (hashed or range columns) in a QL row value map. The first
+// num_reused columns have the same values as in prev_row, so they are copied from it instead of
+// being converted again. Returns the number of converted columns.
+Result<size_t> SetQLPrimaryKeyColumnValues(const Schema& schema,
                                            const size_t begin_index,
                                            const size_t column_count,
                                            const char* column_type,
-                                           DocKeyDecoder* decoder,
+                                           const std::vector<PrimitiveValue>& values,
+                                           const QLTableRow* prev_row,
+                                           size_t num_reused,
                                            QLTableRow* table_row) {
   if (begin_index + column_count > schema.num_columns()) {
     return STATUS_SUBSTITUTE(
@@ -744,14 +972,22 @@ CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
         "$0 primary key columns between positions $1 and $2 go beyond table columns $3",
         column_type, begin_index, begin_index + column_count - 1, schema.num_columns());
   }
-  PrimitiveValue primitive_value;
+  if (values.size() != column_count) {
+    return STATUS_FORMAT(
+        Corruption, "Expected $0 $1 primary key columns, got $2",
+        column_count, column_type, values.size());
+  }
+  num_reused = prev_row ? std::min(num_reused, column_count) : 0;
   for (size_t i = 0, j = begin_index; i < column_count; i++, j++) {
+    if (i < num_reused) {
+      table_row->CopyColumn(schema.column_id(j), *prev_row);
+      continue;
+    }
     const auto ql_type = schema.column(j).type();
     QLTableColumn& column = table_row->AllocColumn(schema.column_id(j));
-    RETURN_NOT_OK(decoder->DecodePrimitiveValue(&primitive_value));
-    PrimitiveValue::ToQLValuePB(primitive_value, ql_type, &column.value);
+    PrimitiveValue::ToQLValuePB(values[i], ql_type, &column.value);
   }
-  return decoder->ConsumeGroupEnd();
+  return column_count - num_reused;
 }
 
 } // namespace
@@ -776,6 +1012,41 @@ bool DocRowwiseIterator::IsNextStaticColumn() const {
 Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table_row) {
   VLOG(4) << __PRETTY_FUNCTION__;
 
+  ResolveProjection(projection);
+  return FillRow(nullptr /* prev_row */, table_row);
+}
+
+Result<size_t> DocRowwiseIterator::DoNextRowBatch(
+    const Schema& projection, size_t max_rows, std::vector<QLTableRow>* rows) {
+  VLOG(4) << __PRETTY_FUNCTION__;
+
+  // Columns of the projection are resolved once for the whole batch, and primary key columns that
+  // a row shares with the previous row of the batch are copied from it.
+  ResolveProjection(projection);
+  size_t num_rows = 0;
+  while (num_rows < max_rows && VERIFY_RESULT(DocRowwiseIterator::HasNext())) {
+    if (num_rows == rows->size()) {
+      rows->emplace_back();
+    } else {
+      (*rows)[num_rows].Clear();
+    }
+    const QLTableRow* prev_row = num_rows ? &(*rows)[num_rows - 1] : nullptr;
+    RETURN_NOT_OK(FillRow(prev_row, &(*rows)[num_rows]));
+    ++num_rows;
+  }
+  return num_rows;
+}
+
+void DocRowwiseIterator::ResolveProjection(const Schema& projection) {
+  projected_columns_.clear();
+  for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
+    const auto& column_id = projection.column_id(i);
+    projected_columns_.push_back(
+        ProjectedColumn{column_id, PrimitiveValue(column_id), &projection.column(i)});
+  }
+}
+
+Status DocRowwiseIterator::FillRow(const QLTableRow* prev_row, QLTableRow* table_row) {
   if (PREDICT_FALSE(done_)) {
     return STATUS(NotFound, "end of iter");
   }
@@ -786,32 +1057,36 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
     return STATUS(InternalError, "next row has not be prepared for reading");
   }
 
-  DocKeyDecoder decoder(row_key_);
-  RETURN_NOT_OK(decoder.DecodeCotableId());
-  RETURN_NOT_OK(decoder.DecodePgtableId());
-  bool has_hash_components = VERIFY_RESULT(decoder.DecodeHashCode());
+  // Consecutive rows usually share a prefix of the primary key, so only the components that
+  // differ from the previous row are decoded.
+  RETURN_NOT_OK(row_key_decoder_.Decode(row_key_));
 
   // Populate the key column values from the doc key. The key column values in doc key were
   // written in the same order as in the table schema (see DocKeyFromQLKey). If the range columns
-  // are present, read them also.
-  if (has_hash_components) {
-    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
+  // are present, read them also. Components that were not decoded again are the same as in the
+  // previous row.
+  const auto& hashed_group = row_key_decoder_.hashed_group();
+  const auto& range_group = row_key_decoder_.range_group();
+  const size_t num_key_components = hashed_group.size() + range_group.size();
+  const size_t num_reused =
+      num_key_components - std::min(num_key_components, row_key_decoder_.num_decoded_components());
+  if (row_key_decoder_.has_hash()) {
+    num_converted_key_columns_ += VERIFY_RESULT(SetQLPrimaryKeyColumnValues(
         schema_, 0, schema_.num_hash_key_columns(),
-        "hash", &decoder, table_row));
+        "hash", hashed_group, prev_row, num_reused, table_row));
   }
-  if (!decoder.GroupEnded()) {
-    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
+  if (!range_group.empty()) {
+    num_converted_key_columns_ += VERIFY_RESULT(SetQLPrimaryKeyColumnValues(
         schema_, schema_.num_hash_key_columns(), schema_.num_range_key_columns(),
-        "range", &decoder, table_row));
+        "range", range_group, prev_row,
+        num_reused - std::min(num_reused, hashed_group.size()), table_row));
   }
 
-  for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
-    const auto& column_id = projection.column_id(i);
-    const auto ql_type = projection.column(i).type();
-    const SubDocument* column_value = row_.GetChild(PrimitiveValue(column_id));
+  for (const auto& projected_column : projected_columns_) {
+    const SubDocument* column_value = row_.GetChild(projected_column.subkey);
     if (column_value != nullptr) {
-      QLTableColumn& column = table_row->AllocColumn(column_id);
-      SubDocument::ToQLValuePB(*column_value, ql_type, &column.value);
+      QLTableColumn& column = table_row->AllocColumn(projected_column.id);
+      SubDocument::ToQLValuePB(*column_value, projected_column.column->type(), &column.value);
       column.ttl_seconds = column_value->GetTtl();
       if (column_value->IsWriteTimeSet()) {
         column.write_time = column_value->GetWriteTime();
@@ -858,31 +1133,68 @@ Result<Slice> DocRowwiseIterator::GetTupleId() const {
   return tuple_id;
 }
 
+void DocRowwiseIterator::AppendTablePrefix(KeyBytes* out) const {
+  if (schema_.has_cotable_id()) {
+    uint8_t bytes[kUuidSize];
+    schema_.cotable_id().EncodeToComparable(bytes);
+    out->AppendValueType(ValueType::kTableId);
+    out->AppendRawBytes(Slice(bytes, kUuidSize));
+  } else if (schema_.has_pgtable_id()) {
+    out->AppendValueType(ValueType::kPgTableOid);
+    out->AppendUInt32(schema_.pgtable_id());
+  }
+}
+
+Status DocRowwiseIterator::InitForTuples(const std::vector<Slice>& tuple_ids) {
+  DCHECK(std::is_sorted(tuple_ids.begin(), tuple_ids.end(),
+                        [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; }));
+  is_forward_scan_ = true;
+
+  // Bloom filters are built from the whole key, including cotable id / pgtable id prefix.
+  const std::vector<Slice>* filter_keys = &tuple_ids;
+  std::vector<KeyBytes> prefixed_keys;
+  std::vector<Slice> prefixed_key_slices;
+  if (schema_.has_cotable_id() || schema_.has_pgtable_id()) {
+    prefixed_keys.resize(tuple_ids.size());
+    prefixed_key_slices.reserve(tuple_ids.size());
+    for (size_t i = 0; i != tuple_ids.size(); ++i) {
+      AppendTablePrefix(&prefixed_keys[i]);
+      prefixed_keys[i].AppendRawBytes(tuple_ids[i]);
+      prefixed_key_slices.push_back(prefixed_keys[i].AsSlice());
+    }
+    filter_keys = &prefixed_key_slices;
+  }
+
+  db_iter_ = CreateIntentAwareIterator(
+      doc_db_, *filter_keys, rocksdb::kDefaultQueryId, txn_op_context_, deadline_, read_time_);
+
+  row_ready_ = false;
+  has_bound_key_ = false;
+  seek_tuples_forward_ = true;
+
+  return Status::OK();
+}
+
 Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
   // If cotable id / pgtable id is present in the table schema, then
   // we need to prepend it in the tuple key to seek.
+  Slice seek_key = tuple_id;
   if (schema_.has_cotable_id() || schema_.has_pgtable_id()) {
     uint32_t size = schema_.has_pgtable_id() ? sizeof(PgTableOid) : kUuidSize;
     if (!tuple_key_) {
       tuple_key_.emplace();
       tuple_key_->Reserve(1 + size + tuple_id.size());
-
-      if (schema_.has_cotable_id()) {
-        std::string bytes;
-        schema_.cotable_id().EncodeToComparable(&bytes);
-        tuple_key_->AppendValueType(ValueType::kTableId);
-        tuple_key_->AppendRawBytes(bytes);
-      } else {
-        tuple_key_->AppendValueType(ValueType::kPgTableOid);
-        tuple_key_->AppendUInt32(schema_.pgtable_id());
-      }
+      AppendTablePrefix(&*tuple_key_);
     } else {
       tuple_key_->Truncate(1 + size);
     }
     tuple_key_->AppendRawBytes(tuple_id);
-    db_iter_->Seek(*tuple_key_);
+    seek_key = tuple_key_->AsSlice();
+  }
+  if (seek_tuples_forward_) {
+    db_iter_->SeekForward(seek_key);
   } else {
-    db_iter_->Seek(tuple_id);
+    db_iter_->Seek(seek_key);
   }
 
   iter_key_.Clear();
@@ -71,6 +71,11 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   CHECKED_STATUS Init(const common::QLScanSpec& spec);
   CHECKED_STATUS Init(const common::PgsqlScanSpec& spec);
 
+  // Init iterator to read the tuples with the given ids, see SeekTuple. Tuple ids should be sorted
+  // in ascending order and sought in that order, so the iterator is only moved forward between
+  // them. SST files that do not contain any of the tuples according to bloom filters are skipped.
+  CHECKED_STATUS InitForTuples(const std::vector<Slice>& tuple_ids);
+
   // This must always be called before NextRow. The implementation actually finds the
   // first row to scan, and NextRow expects the RocksDB iterator to already be properly
   // positioned.
@@ -104,16 +109,33 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   Result<Slice> GetTupleId() const override;
 
   // Seeks to the given tuple by its id. The tuple id should be the serialized DocKey and without
-  // the cotable id.
+  // the cotable id. The tuple should be within the bounds of the scan spec the iterator was
+  // initialized with.
   Result<bool> SeekTuple(const Slice& tuple_id) override;
 
   // Retrieves the next key to read after the iterator finishes for the given page.
   CHECKED_STATUS GetNextReadSubDocKey(SubDocKey* sub_doc_key) const override;
 
+  // Number of primary key column values converted from DocKeys of the rows read so far. Columns
+  // that a row of a batch shares with the previous row of that batch are copied instead.
+  size_t num_converted_key_columns() const {
+    return num_converted_key_columns_;
+  }
+
  private:
+  // Non-key column of the projection, with the subkey it is stored under in the row.
+  struct ProjectedColumn {
+    ColumnId id;
+    PrimitiveValue subkey;
+    const ColumnSchema* column;
+  };
+
   template <class T>
   CHECKED_STATUS DoInit(const T& spec);
 
+  // Appends cotable id / pgtable id prefix of the table, if any, to out.
+  void AppendTablePrefix(KeyBytes* out) const;
+
   Result<bool> InitScanChoices(
       const DocQLScanSpec& doc_spec, const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key);
 
@@ -157,6 +179,26 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  Result<size_t> DoNextRowBatch(const Schema& projection, size_t max_rows,
+                                std::vector<QLTableRow>* rows) override;
+
+  // Fills projected_columns_ with the non-key columns of projection.
+  void ResolveProjection(const Schema& projection);
+
+  // Reads the row prepared by HasNext into table_row, using projected_columns_. prev_row is the
+  // row read right before this one, when it is still available to copy key columns from.
+  CHECKED_STATUS FillRow(const QLTableRow* prev_row, QLTableRow* table_row);
+
+  // Sets row_cache_key_ if the scan is a point read of a full primary key, whose row could be
+  // cached.
+  CHECKED_STATUS InitRowCacheKey(const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key);
+
+  // Serves the row from the row cache. Returns false if it is not cached.
+  Result<bool> ReadFromRowCache();
+
+  // Adds the row just read from RocksDB to the row cache, if it could be served to later reads.
+  void MaybeCacheRow() const;
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -220,8 +262,29 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Key for seeking a YSQL tuple. Used only when the table has a cotable id.
   boost::optional<KeyBytes> tuple_key_;
 
+  // Set by InitForTuples, tuples are sought forward from the current position.
+  bool seek_tuples_forward_ = false;
+
+  // Decodes primary key columns of the current row, reusing those of the previous row.
+  MemoizedDocKeyDecoder row_key_decoder_;
+
   // Hybrid time of the table tombstone, if found.
   mutable DocHybridTime table_tombstone_time_ = DocHybridTime::kInvalid;
+
+  // Encoded DocKey of the point read, whose row could be served from or added to
+  // doc_db_.row_cache. Empty when the row cache is not used.
+  KeyBytes row_cache_key_;
+
+  // Epoch of row_cache_key_, obtained before the row was read from RocksDB.
+  uint64_t row_cache_epoch_ = 0;
+
+  // The row was served from the row cache, so there are no more rows after it.
+  bool row_from_cache_ = false;
+
+  // Non-key columns of the projection rows are being read with.
+  std::vector<ProjectedColumn> projected_columns_;
+
+  size_t num_converted_key_columns_ = 0;
 };
 
 }  // namespace docdb
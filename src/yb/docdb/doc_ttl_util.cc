@@ -13,6 +13,8 @@
 
 #include "yb/docdb/doc_ttl_util.h"
 
+#include <algorithm>
+
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/value.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -36,6 +38,18 @@ CHECKED_STATUS HasExpiredTTL(const HybridTime& key_hybrid_time, const MonoDelta&
   return Status::OK();
 }
 
+HybridTime ExpirationHybridTime(const HybridTime& write_hybrid_time, const MonoDelta& ttl) {
+  if (ttl.Equals(Value::kMaxTtl) || ttl.Equals(Value::kResetTtl)) {
+    return HybridTime::kMax;
+  }
+  auto write_micros = write_hybrid_time.GetPhysicalValueMicros();
+  auto ttl_micros = std::max<int64_t>(ttl.ToMicroseconds(), 0);
+  if (static_cast<uint64_t>(ttl_micros) >= kMaxHybridTimePhysicalMicros - write_micros) {
+    return HybridTime::kMax;
+  }
+  return HybridTime::FromMicros(write_micros + ttl_micros);
+}
+
 const MonoDelta TableTTL(const Schema& schema) {
   MonoDelta ttl = Value::kMaxTtl;
   if (schema.table_properties().HasDefaultTimeToLive()) {
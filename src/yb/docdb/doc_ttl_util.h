@@ -34,6 +34,10 @@ namespace docdb {
 CHECKED_STATUS HasExpiredTTL(const HybridTime& key_hybrid_time, const MonoDelta& ttl,
                              const HybridTime& read_hybrid_time, bool* has_expired);
 
+// Returns the hybrid time at which a value written at write_hybrid_time with the given value level
+// TTL expires, or HybridTime::kMax if it does not expire.
+HybridTime ExpirationHybridTime(const HybridTime& write_hybrid_time, const MonoDelta& ttl);
+
 // Computes the table level TTL, given a schema.
 const MonoDelta TableTTL(const Schema& schema);
 
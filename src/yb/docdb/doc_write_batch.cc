@@ -26,8 +26,18 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/value_type.h"
 #include "yb/docdb/kv_debug.h"
+#include "yb/gutil/casts.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/coding.h"
 #include "yb/util/enums.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(replicate_encoded_write_pairs, false,
+            "Replicate write pairs of non-transactional write batches encoded in one buffer, "
+            "instead of a protobuf message per pair. Should be enabled only after all servers "
+            "of the cluster are upgraded to the version, that supports it.");
+TAG_FLAG(replicate_encoded_write_pairs, advanced);
+TAG_FLAG(replicate_encoded_write_pairs, runtime);
 
 using yb::BinaryOutputFormat;
 
@@ -50,6 +60,12 @@ Status DocWriteBatch::SeekToKeyPrefix(LazyIterator* iter, bool has_ancestor) {
   // Check the cache first.
   boost::optional<DocWriteBatchCache::Entry> cached_entry =
     cache_.Get(key_prefix_);
+  if (!cached_entry && shared_cache_) {
+    cached_entry = shared_cache_->Get(key_prefix_, shared_cache_read_time_);
+    if (cached_entry) {
+      cache_.Put(key_prefix_, *cached_entry);
+    }
+  }
   if (cached_entry) {
     current_entry_ = *cached_entry;
     subdoc_exists_ = current_entry_.value_type != ValueType::kTombstone;
@@ -58,9 +74,23 @@ Status DocWriteBatch::SeekToKeyPrefix(LazyIterator* iter, bool has_ancestor) {
   return SeekToKeyPrefix(iter->Iterator(), has_ancestor);
 }
 
+void DocWriteBatch::SetSharedCache(SharedDocWriteBatchCache* shared_cache, HybridTime read_time) {
+  shared_cache_ = shared_cache;
+  shared_cache_read_time_ = read_time;
+}
+
+void DocWriteBatch::PublishToSharedCache() {
+  if (shared_cache_) {
+    shared_cache_->Put(shared_cache_candidates_, shared_cache_read_time_);
+    shared_cache_candidates_.clear();
+  }
+}
+
 Status DocWriteBatch::SeekToKeyPrefix(IntentAwareIterator* doc_iter, bool has_ancestor) {
   const auto prev_subdoc_ht = current_entry_.doc_hybrid_time;
   const auto prev_key_prefix_exact = current_entry_.found_exact_key_prefix;
+  // Obtained before reading, so that the entry is not shared if the document is modified meanwhile.
+  const uint64_t shared_cache_epoch = shared_cache_ ? shared_cache_->Epoch(key_prefix_) : 0;
 
   // Seek the value.
   doc_iter->Seek(key_prefix_.AsSlice());
@@ -89,6 +119,10 @@ Status DocWriteBatch::SeekToKeyPrefix(IntentAwareIterator* doc_iter, bool has_an
     current_entry_.value_type = ValueType::kTombstone;
     current_entry_.doc_hybrid_time = key_data.write_time;
     cache_.Put(key_prefix_, current_entry_);
+    if (shared_cache_) {
+      // An expired value stays expired at any later read time.
+      shared_cache_candidates_.push_back({key_prefix_.data(), current_entry_, shared_cache_epoch});
+    }
     return Status::OK();
   }
 
@@ -143,6 +177,11 @@ Status DocWriteBatch::SeekToKeyPrefix(IntentAwareIterator* doc_iter, bool has_an
     } else {
       cache_.Put(key_prefix_, current_entry_);
       subdoc_exists_ = current_entry_.value_type != ValueType::kTombstone;
+      // Values with TTL could expire before a later read time, so they are not shared.
+      if (shared_cache_ && merge_flags == 0 && ttl.Equals(Value::kMaxTtl)) {
+        shared_cache_candidates_.push_back(
+            {key_prefix_.data(), current_entry_, shared_cache_epoch});
+      }
     }
   }
   return Status::OK();
@@ -589,6 +628,30 @@ void DocWriteBatch::Clear() {
 }
 
 void DocWriteBatch::MoveToWriteBatchPB(KeyValueWriteBatchPB *kv_pb) {
+  // Intents of transactional batches are processed pair by pair, so they are not encoded.
+  if (FLAGS_replicate_encoded_write_pairs && !kv_pb->has_transaction() &&
+      kv_pb->write_pairs().empty()) {
+    size_t size = 0;
+    for (const auto& entry : put_batch_) {
+      size += entry.first.size() + entry.second.size() + 2 * kMaxVarint32Length;
+    }
+    auto& encoded = *kv_pb->mutable_encoded_write_pairs();
+    encoded.reserve(size);
+    auto append = [&encoded](const std::string& str) {
+      uint8_t size_buffer[kMaxVarint32Length];
+      auto end = EncodeVarint32(size_buffer, static_cast<uint32_t>(str.size()));
+      encoded.append(pointer_cast<const char*>(size_buffer), end - size_buffer);
+      encoded.append(str);
+    };
+    for (const auto& entry : put_batch_) {
+      append(entry.first);
+      append(entry.second);
+    }
+    kv_pb->set_encoded_write_pairs_count(static_cast<uint32_t>(put_batch_.size()));
+    put_batch_.clear();
+    return;
+  }
+
   kv_pb->mutable_write_pairs()->Reserve(put_batch_.size());
   for (auto& entry : put_batch_) {
     KeyValuePairPB* kv_pair = kv_pb->add_write_pairs();
@@ -606,6 +669,27 @@ void DocWriteBatch::TEST_CopyToWriteBatchPB(KeyValueWriteBatchPB *kv_pb) const {
   }
 }
 
+Status EnumerateWritePairs(
+    const KeyValueWriteBatchPB& put_batch, const WritePairHandler& handler) {
+  for (const auto& pair : put_batch.write_pairs()) {
+    RETURN_NOT_OK(handler(pair.key(), pair.value()));
+  }
+  Slice encoded(put_batch.encoded_write_pairs());
+  while (!encoded.empty()) {
+    Slice key, value;
+    if (!GetLengthPrefixedSlice(&encoded, &key) || !GetLengthPrefixedSlice(&encoded, &value)) {
+      return STATUS_FORMAT(Corruption, "Bad encoded write pairs, left: $0",
+                           encoded.ToDebugHexString());
+    }
+    RETURN_NOT_OK(handler(key, value));
+  }
+  return Status::OK();
+}
+
+size_t WritePairsCount(const KeyValueWriteBatchPB& put_batch) {
+  return put_batch.write_pairs_size() + put_batch.encoded_write_pairs_count();
+}
+
 // ------------------------------------------------------------------------------------------------
 // Converting a RocksDB write batch to a string.
 // ------------------------------------------------------------------------------------------------
@@ -83,6 +83,15 @@ class DocWriteBatch {
   Status SeekToKeyPrefix(LazyIterator* doc_iter, bool has_ancestor = false);
   Status SeekToKeyPrefix(IntentAwareIterator* doc_iter, bool has_ancestor);
 
+  // Makes this batch look up key prefixes in shared_cache before reading them from RocksDB at
+  // read_time. Entries read from RocksDB are collected to be added to shared_cache by
+  // PublishToSharedCache.
+  void SetSharedCache(SharedDocWriteBatchCache* shared_cache, HybridTime read_time);
+
+  // Adds entries read from RocksDB to the shared cache. Should be called only when all operations
+  // were applied to this batch at the read time passed to SetSharedCache, i.e. without read restart.
+  void PublishToSharedCache();
+
   // Set the primitive at the given path to the given value. Intermediate subdocuments are created
   // if necessary and possible.
   CHECKED_STATUS SetPrimitive(
@@ -239,6 +248,10 @@ class DocWriteBatch {
 
   DocWriteBatchCache cache_;
 
+  SharedDocWriteBatchCache* shared_cache_ = nullptr;
+  HybridTime shared_cache_read_time_;
+  std::vector<SharedDocWriteBatchCache::Candidate> shared_cache_candidates_;
+
   DocDB doc_db_;
 
   InitMarkerBehavior init_marker_behavior_;
@@ -251,6 +264,15 @@ class DocWriteBatch {
   DocWriteBatchCache::Entry current_entry_;
 };
 
+typedef std::function<CHECKED_STATUS(const Slice& key, const Slice& value)> WritePairHandler;
+
+// Invokes handler for each write pair of the batch, replicated either in write_pairs or in
+// encoded_write_pairs. Keys are in the order they were added to the batch.
+CHECKED_STATUS EnumerateWritePairs(
+    const KeyValueWriteBatchPB& put_batch, const WritePairHandler& handler);
+
+size_t WritePairsCount(const KeyValueWriteBatchPB& put_batch);
+
 // Converts a RocksDB WriteBatch to a string.
 Result<std::string> WriteBatchToString(
     const rocksdb::WriteBatch& write_batch,
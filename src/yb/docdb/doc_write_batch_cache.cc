@@ -18,9 +18,12 @@
 #include <sstream>
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb-internal.h"
+#include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flag_tags.h"
 
 using std::back_inserter;
 using std::copy;
@@ -34,6 +37,12 @@ using std::vector;
 
 using yb::FormatBytesAsStr;
 
+DEFINE_int32(docdb_shared_write_batch_cache_max_entries, 4096,
+             "Maximum number of key prefixes read by non-transactional write operations that are "
+             "cached per tablet to be reused by later write operations. 0 to disable.");
+TAG_FLAG(docdb_shared_write_batch_cache_max_entries, advanced);
+TAG_FLAG(docdb_shared_write_batch_cache_max_entries, runtime);
+
 namespace yb {
 namespace docdb {
 
@@ -93,5 +102,77 @@ void DocWriteBatchCache::Clear() {
   prefix_to_gen_ht_.clear();
 }
 
+namespace {
+
+// Returns the encoded DocKey of the given key, or the key itself if it could not be decoded.
+Slice DocKeyPrefix(const Slice& key) {
+  auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+  return doc_key_size.ok() ? key.Prefix(*doc_key_size) : key;
+}
+
+}  // namespace
+
+size_t SharedDocWriteBatchCache::EpochIndex(const Slice& key) {
+  return DocKeyPrefix(key).hash() % kNumEpochs;
+}
+
+boost::optional<DocWriteBatchCache::Entry> SharedDocWriteBatchCache::Get(
+    const KeyBytes& key_prefix, HybridTime read_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key_prefix.data());
+  if (it == entries_.end() || it->second.read_time > read_time) {
+    return boost::none;
+  }
+  return it->second.entry;
+}
+
+void SharedDocWriteBatchCache::Put(const std::vector<Candidate>& candidates,
+                                   HybridTime read_time) {
+  if (candidates.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& candidate : candidates) {
+    if (Epoch(candidate.key_prefix.AsSlice()) != candidate.epoch) {
+      continue;
+    }
+    if (entries_.size() >= static_cast<size_t>(FLAGS_docdb_shared_write_batch_cache_max_entries)) {
+      // Hot keys are read again soon after, so just start over instead of tracking recency.
+      entries_.clear();
+    }
+    auto& shared_entry = entries_[candidate.key_prefix];
+    shared_entry.entry = candidate.entry;
+    shared_entry.read_time = read_time;
+  }
+}
+
+void SharedDocWriteBatchCache::InvalidateDocuments(const KeyValueWriteBatchPB& put_batch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  WARN_NOT_OK(EnumerateWritePairs(
+                  put_batch,
+                  [this](const Slice& key, const Slice& value) {
+                    InvalidateDocumentUnlocked(key);
+                    return Status::OK();
+                  }),
+              "Failed to invalidate documents");
+}
+
+void SharedDocWriteBatchCache::InvalidateDocumentUnlocked(const Slice& key) {
+  const auto doc_key = DocKeyPrefix(key);
+  epochs_[EpochIndex(doc_key)].fetch_add(1, std::memory_order_acq_rel);
+  auto it = entries_.lower_bound(KeyBuffer(doc_key));
+  while (it != entries_.end() && it->first.AsSlice().starts_with(doc_key)) {
+    it = entries_.erase(it);
+  }
+}
+
+void SharedDocWriteBatchCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& epoch : epochs_) {
+    epoch.fetch_add(1, std::memory_order_acq_rel);
+  }
+  entries_.clear();
+}
+
 }  // namespace docdb
 }  // namespace yb
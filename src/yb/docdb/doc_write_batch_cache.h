@@ -14,8 +14,13 @@
 #ifndef YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 #define YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -24,9 +29,13 @@
 #include "yb/docdb/value_type.h"
 #include "yb/docdb/value.h"
 
+#include "yb/util/slice.h"
+
 namespace yb {
 namespace docdb {
 
+class KeyValueWriteBatchPB;
+
 // A utility used by DocWriteBatch. Caches generation hybrid_times (hybrid_times of full overwrite
 // or deletion) for key prefixes that were read from RocksDB or created by previous operations
 // performed on the DocWriteBatch.
@@ -77,6 +86,63 @@ class DocWriteBatchCache {
   std::unordered_map<KeyBuffer, Entry, ByteBufferHash> prefix_to_gen_ht_;
 };
 
+// Cache of DocWriteBatchCache entries read from RocksDB, shared by the write batches of
+// non-transactional operations of one tablet, so that read-modify-write operations on hot keys do
+// not have to read the same key prefixes from RocksDB over and over again.
+//
+// An entry stays valid until a write to its document is applied, so the tablet should call
+// InvalidateDocuments for every non-transactional write batch it applies, and Clear for any other
+// change to the regular DB. Each document has an epoch that is incremented on invalidation. Write
+// batches remember the epoch before reading a key prefix from RocksDB, and the entry is dropped
+// on Put if the epoch has changed meanwhile.
+//
+// This class is thread-safe.
+class SharedDocWriteBatchCache {
+ public:
+  struct Candidate {
+    KeyBuffer key_prefix;
+    DocWriteBatchCache::Entry entry;
+    uint64_t epoch;
+  };
+
+  // Returns the current epoch of the document the key prefix belongs to.
+  uint64_t Epoch(const Slice& key_prefix) const {
+    return epochs_[EpochIndex(key_prefix)].load(std::memory_order_acquire);
+  }
+
+  // Returns the entry for the key prefix, if it was read at a hybrid time not after read_time.
+  boost::optional<DocWriteBatchCache::Entry> Get(const KeyBytes& key_prefix, HybridTime read_time);
+
+  // Adds entries read from RocksDB at read_time, skipping the ones whose documents were invalidated
+  // since their epoch was obtained.
+  void Put(const std::vector<Candidate>& candidates, HybridTime read_time);
+
+  // Invalidates all documents modified by the non-transactional write batch.
+  void InvalidateDocuments(const KeyValueWriteBatchPB& put_batch);
+
+  void Clear();
+
+ private:
+  struct SharedEntry {
+    DocWriteBatchCache::Entry entry;
+    HybridTime read_time;
+  };
+
+  // Documents are mapped to a fixed number of epochs by the hash of their encoded DocKey.
+  static constexpr size_t kNumEpochs = 64;
+
+  static size_t EpochIndex(const Slice& key);
+
+  void InvalidateDocumentUnlocked(const Slice& key);
+
+  std::array<std::atomic<uint64_t>, kNumEpochs> epochs_ = {};
+
+  std::mutex mutex_;
+  // Ordered by key prefix, so that all entries of a document could be found by its DocKey.
+  // Key prefixes are short enough to be stored inline in KeyBuffer, so lookups do not allocate.
+  std::map<KeyBuffer, SharedEntry> entries_;
+};
+
 
 }  // namespace docdb
 }  // namespace yb
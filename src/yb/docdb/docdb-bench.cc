@@ -0,0 +1,265 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Micro-benchmarks for DocDB hot paths: key encoding and decoding, and iteration over synthetic
+// data in a temporary RocksDB, with and without provisional records of transactions.
+// Each benchmark logs a line starting with "RESULT: ", so results of different builds could be
+// compared with grep.
+
+#include <string>
+#include <vector>
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_value.h"
+#include "yb/common/transaction-test-util.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/docdb_test_base.h"
+#include "yb/docdb/in_mem_docdb.h"
+#include "yb/docdb/intent_aware_iterator.h"
+
+#include "yb/util/format.h"
+#include "yb/util/monotime.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DEFINE_int32(docdb_bench_encoding_iterations, 1000000,
+             "Number of iterations for each encoding benchmark.");
+DEFINE_int32(docdb_bench_num_rows, 10000, "Number of rows written for iteration benchmarks.");
+DEFINE_int32(docdb_bench_num_columns, 50, "Number of non key columns in wide row benchmark.");
+DEFINE_int32(docdb_bench_scan_iterations, 10, "Number of full scans in iteration benchmarks.");
+
+DECLARE_bool(TEST_docdb_sort_weak_intents_in_tests);
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr int kFirstValueColumnId = 10;
+// Provisional records are grouped into transactions of this number of rows.
+constexpr int kRowsPerTransaction = 10;
+
+const HybridTime kWriteTime = HybridTime::FromMicros(1000);
+const HybridTime kIntentWriteTime = HybridTime::FromMicros(2000);
+const HybridTime kCommitTime = HybridTime::FromMicros(3000);
+const HybridTime kReadTime = HybridTime::FromMicros(10000);
+
+DocKey RowKey(int64_t row) {
+  return DocKey(std::vector<PrimitiveValue>{
+      PrimitiveValue(Format("row_$0", row)), PrimitiveValue(row) });
+}
+
+} // namespace
+
+class DocDBBench : public DocDBTestBase {
+ protected:
+  void SetUp() override {
+    FLAGS_TEST_docdb_sort_weak_intents_in_tests = true;
+    DocDBTestBase::SetUp();
+  }
+
+  template <class F>
+  void RunBenchmark(const std::string& name, int iterations, const F& f) {
+    auto start = MonoTime::Now();
+    for (int i = 0; i != iterations; ++i) {
+      f(i);
+    }
+    auto elapsed = MonoTime::Now() - start;
+    LOG(INFO) << Format(
+        "RESULT: $0: $1 iterations, $2 ns/iteration", name, iterations,
+        elapsed.ToNanoseconds() / std::max(iterations, 1));
+  }
+
+  // Writes num_rows rows with num_columns int64 columns each, and flushes them to SST files.
+  // Rows with index modulo 100 less than intent_percent are written as provisional records of
+  // transactions, that are committed before the read time.
+  void WriteRows(int num_rows, int num_columns, int intent_percent,
+                 InMemDocDbState* in_mem_state = nullptr) {
+    auto dwb = MakeDocWriteBatch();
+    boost::optional<TransactionId> txn_id;
+    int rows_in_txn = 0;
+    for (int row = 0; row != num_rows; ++row) {
+      auto encoded_doc_key = RowKey(row).Encode();
+      for (int column = 0; column != num_columns; ++column) {
+        DocPath path(encoded_doc_key, PrimitiveValue(ColumnId(kFirstValueColumnId + column)));
+        PrimitiveValue value(static_cast<int64_t>(row * num_columns + column));
+        ASSERT_OK(dwb.SetPrimitive(path, value));
+        if (in_mem_state) {
+          ASSERT_OK(in_mem_state->SetPrimitive(path, value));
+        }
+      }
+      if (row % 100 < intent_percent) {
+        if (!txn_id || rows_in_txn == kRowsPerTransaction) {
+          txn_id = TransactionId::GenerateRandom();
+          txn_status_manager_.Commit(*txn_id, kCommitTime);
+          rows_in_txn = 0;
+        }
+        ++rows_in_txn;
+        SetCurrentTransactionId(*txn_id);
+        ASSERT_OK(WriteToRocksDBAndClear(&dwb, kIntentWriteTime));
+        ResetCurrentTransactionId();
+      } else {
+        ASSERT_OK(WriteToRocksDBAndClear(&dwb, kWriteTime));
+      }
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  TransactionOperationContext TxnOpContext() {
+    return TransactionOperationContext(TransactionId::GenerateRandom(), &txn_status_manager_);
+  }
+
+  void BenchmarkIntentAwareIterator(int intent_percent) {
+    ASSERT_OK(DestroyRocksDB());
+    ASSERT_OK(ReopenRocksDB());
+    SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+    const int num_rows = FLAGS_docdb_bench_num_rows;
+    const int num_columns = 4;
+    ASSERT_NO_FATALS(WriteRows(num_rows, num_columns, intent_percent));
+
+    auto create_iterator = [this] {
+      return CreateIntentAwareIterator(
+          doc_db(), BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none /* user_key_for_filter */,
+          rocksdb::kDefaultQueryId, TxnOpContext(), CoarseTimePoint::max() /* deadline */,
+          ReadHybridTime::SingleTime(kReadTime));
+    };
+
+    RunBenchmark(
+        Format("IntentAwareIteratorScan/intents=$0%", intent_percent),
+        FLAGS_docdb_bench_scan_iterations, [&](int) {
+      auto iter = create_iterator();
+      iter->Seek(DocKey());
+      int num_keys = 0;
+      while (iter->valid()) {
+        auto key = ASSERT_RESULT(iter->FetchKey()).key;
+        ++num_keys;
+        iter->SeekPastSubKey(key);
+      }
+      ASSERT_EQ(num_rows * num_columns, num_keys);
+    });
+
+    auto iter = create_iterator();
+    RunBenchmark(
+        Format("IntentAwareIteratorSeek/intents=$0%", intent_percent),
+        FLAGS_docdb_bench_scan_iterations * num_rows, [&](int i) {
+      iter->Seek(RowKey((i * 7919LL) % num_rows));
+      ASSERT_TRUE(iter->valid());
+      ASSERT_OK(iter->FetchKey());
+    });
+  }
+
+  TransactionStatusManagerMock txn_status_manager_;
+};
+
+TEST_F(DocDBBench, DocKeyEncode) {
+  DocKey doc_key(
+      0x1234, { PrimitiveValue("hash_component"), PrimitiveValue(12345678) },
+      { PrimitiveValue("range_component"), PrimitiveValue(87654321) });
+  size_t total_size = 0;
+  RunBenchmark("DocKeyEncode", FLAGS_docdb_bench_encoding_iterations, [&](int) {
+    total_size += doc_key.Encode().size();
+  });
+  ASSERT_GT(total_size, 0U);
+}
+
+TEST_F(DocDBBench, DocKeyDecode) {
+  auto encoded = DocKey(
+      0x1234, { PrimitiveValue("hash_component"), PrimitiveValue(12345678) },
+      { PrimitiveValue("range_component"), PrimitiveValue(87654321) }).Encode();
+  DocKey doc_key;
+  RunBenchmark("DocKeyDecode", FLAGS_docdb_bench_encoding_iterations, [&](int) {
+    ASSERT_OK(doc_key.FullyDecodeFrom(encoded.AsSlice()));
+  });
+  ASSERT_EQ(2U, doc_key.range_group().size());
+}
+
+TEST_F(DocDBBench, PrimitiveValueAppendToKey) {
+  std::vector<PrimitiveValue> values = {
+      PrimitiveValue("string_value"), PrimitiveValue(1234567890),
+      PrimitiveValue("descending_string_value", SortOrder::kDescending),
+      PrimitiveValue(ColumnId(kFirstValueColumnId)),
+  };
+  KeyBytes key_bytes;
+  RunBenchmark("PrimitiveValueAppendToKey", FLAGS_docdb_bench_encoding_iterations, [&](int i) {
+    key_bytes.Clear();
+    values[i % values.size()].AppendToKey(&key_bytes);
+  });
+  ASSERT_GT(key_bytes.size(), 0U);
+}
+
+TEST_F(DocDBBench, SubDocKeyDecode) {
+  auto encoded = SubDocKey(
+      RowKey(12345), PrimitiveValue(ColumnId(kFirstValueColumnId)), kWriteTime).Encode();
+  SubDocKey sub_doc_key;
+  RunBenchmark("SubDocKeyDecode", FLAGS_docdb_bench_encoding_iterations, [&](int) {
+    Slice slice = encoded.AsSlice();
+    ASSERT_OK(sub_doc_key.DecodeFrom(&slice));
+  });
+  ASSERT_EQ(1, sub_doc_key.num_subkeys());
+}
+
+TEST_F(DocDBBench, IntentAwareIterator) {
+  for (int intent_percent : {0, 10, 50, 100}) {
+    ASSERT_NO_FATALS(BenchmarkIntentAwareIterator(intent_percent));
+  }
+}
+
+TEST_F(DocDBBench, DocRowwiseIteratorWideRows) {
+  const int num_rows = FLAGS_docdb_bench_num_rows;
+  const int num_columns = FLAGS_docdb_bench_num_columns;
+
+  std::vector<ColumnSchema> columns = {
+      ColumnSchema("k_str", DataType::STRING, /* is_nullable = */ false),
+      ColumnSchema("k_int", DataType::INT64, false),
+  };
+  std::vector<ColumnId> column_ids = { 0_ColId, 1_ColId };
+  std::vector<std::string> value_column_names;
+  for (int column = 0; column != num_columns; ++column) {
+    value_column_names.push_back(Format("v$0", column));
+    columns.emplace_back(value_column_names.back(), DataType::INT64, true);
+    column_ids.emplace_back(kFirstValueColumnId + column);
+  }
+  Schema schema(columns, column_ids, 2);
+  Schema projection;
+  ASSERT_OK(schema.CreateProjectionByNames(value_column_names, &projection));
+
+  InMemDocDbState expected_state;
+  ASSERT_NO_FATALS(WriteRows(num_rows, num_columns, /* intent_percent = */ 0, &expected_state));
+
+  // Make sure that synthetic data was written as expected before measuring reads.
+  InMemDocDbState actual_state;
+  actual_state.CaptureAt(doc_db(), kReadTime);
+  ASSERT_TRUE(actual_state.EqualsAndLogDiff(expected_state));
+
+  RunBenchmark(
+      Format("DocRowwiseIteratorWideRows/columns=$0", num_columns),
+      FLAGS_docdb_bench_scan_iterations, [&](int) {
+    DocRowwiseIterator iter(
+        projection, schema, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(kReadTime));
+    ASSERT_OK(iter.Init());
+    QLTableRow row;
+    int fetched_rows = 0;
+    while (ASSERT_RESULT(iter.HasNext())) {
+      ASSERT_OK(iter.NextRow(&row));
+      ++fetched_rows;
+    }
+    ASSERT_EQ(num_rows, fetched_rows);
+  });
+}
+
+}  // namespace docdb
+}  // namespace yb
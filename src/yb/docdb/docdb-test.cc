@@ -15,11 +15,13 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/db/db_impl.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/db/writebuffer.h"
+#include "yb/rocksdb/perf_context.h"
 #include "yb/rocksdb/util/statistics.h"
 
 #include "yb/common/hybrid_time.h"
@@ -66,6 +68,8 @@ using namespace std::chrono_literals;
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(TEST_docdb_sort_weak_intents_in_tests);
+DECLARE_bool(replicate_encoded_write_pairs);
+DECLARE_int32(memstore_bloom_filter_size_kb);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -2192,6 +2196,52 @@ SubDocKey(DocKey([], ["k"]), [HT{ physical: 6000 }]) -> "v6"  // file 11
       )#");
 }
 
+// Entries above the history cutoff are kept without decoding their subkeys, entries below it
+// should still be cleaned up using overwrites of their parents.
+TEST_F(DocDBTest, CompactionKeepsEntriesAboveHistoryCutoff) {
+  const DocKey doc_key(PrimitiveValues("k1"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key), Value(PrimitiveValue::kTombstone),
+                         3000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(10))),
+                         Value(PrimitiveValue("a")), 6000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(10))),
+                         Value(PrimitiveValue("b")), 2000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(10))),
+                         Value(PrimitiveValue("c")), 4000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(11))),
+                         Value(PrimitiveValue("d")), 7000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue(ColumnId(11))),
+                         Value(PrimitiveValue("e")), 1000_usec_ht));
+  const DocKey doc_key_row2(PrimitiveValues("k2"));
+  KeyBytes encoded_doc_key_row2(doc_key_row2.Encode());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key_row2), Value(PrimitiveValue("f")),
+                         8000_usec_ht));
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key_row2), Value(PrimitiveValue("g")),
+                         1000_usec_ht));
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k1"]), [HT{ physical: 3000 }]) -> DEL
+SubDocKey(DocKey([], ["k1"]), [ColumnId(10); HT{ physical: 6000 }]) -> "a"
+SubDocKey(DocKey([], ["k1"]), [ColumnId(10); HT{ physical: 4000 }]) -> "c"
+SubDocKey(DocKey([], ["k1"]), [ColumnId(10); HT{ physical: 2000 }]) -> "b"
+SubDocKey(DocKey([], ["k1"]), [ColumnId(11); HT{ physical: 7000 }]) -> "d"
+SubDocKey(DocKey([], ["k1"]), [ColumnId(11); HT{ physical: 1000 }]) -> "e"
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 8000 }]) -> "f"
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 1000 }]) -> "g"
+      )#");
+
+  FullyCompactHistoryBefore(5000_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(
+      R"#(
+SubDocKey(DocKey([], ["k1"]), [ColumnId(10); HT{ physical: 6000 }]) -> "a"
+SubDocKey(DocKey([], ["k1"]), [ColumnId(10); HT{ physical: 4000 }]) -> "c"
+SubDocKey(DocKey([], ["k1"]), [ColumnId(11); HT{ physical: 7000 }]) -> "d"
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 8000 }]) -> "f"
+SubDocKey(DocKey([], ["k2"]), [HT{ physical: 1000 }]) -> "g"
+      )#");
+}
+
 TEST_F(DocDBTest, BasicTest) {
   // A few points to make it easier to understand the expected binary representations here:
   // - Initial bytes such as 'S' (kString), 'I' (kInt64) correspond to members of the enum
@@ -2462,6 +2512,97 @@ TEST_F(DocDBTest, MultiOperationDocWriteBatch) {
       )#", dwb_str);
 }
 
+// Write pairs replicated encoded should be applied to the same RocksDB write batch as regular
+// write pairs.
+TEST_F(DocDBTest, EncodedWritePairs) {
+  const auto encoded_doc_key = DocKey(PrimitiveValues("a")).Encode();
+  std::vector<std::string> batch_strs;
+  for (bool encoded : {false, true}) {
+    FLAGS_replicate_encoded_write_pairs = encoded;
+    auto dwb = MakeDocWriteBatch();
+    ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "b"), PrimitiveValue("v1")));
+    ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "c", "d"), PrimitiveValue("v2")));
+    ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "c", "e"), PrimitiveValue("v3")));
+
+    KeyValueWriteBatchPB put_batch;
+    dwb.MoveToWriteBatchPB(&put_batch);
+    ASSERT_EQ(encoded ? 0 : 3, put_batch.write_pairs_size());
+    ASSERT_EQ(encoded, put_batch.has_encoded_write_pairs());
+    ASSERT_EQ(3U, WritePairsCount(put_batch));
+
+    std::vector<std::string> values;
+    ASSERT_OK(EnumerateWritePairs(put_batch, [&values](const Slice& key, const Slice& value) {
+      values.push_back(value.ToBuffer());
+      return Status::OK();
+    }));
+    ASSERT_EQ((std::vector<std::string>{"Sv1", "Sv2", "Sv3"}), values);
+
+    rocksdb::WriteBatch rocksdb_write_batch;
+    PrepareNonTransactionWriteBatch(put_batch, 1000_usec_ht, &rocksdb_write_batch);
+    batch_strs.push_back(ASSERT_RESULT(WriteBatchToString(
+        rocksdb_write_batch, StorageDbType::kRegular, BinaryOutputFormat::kEscaped)));
+  }
+  ASSERT_EQ(batch_strs[0], batch_strs[1]);
+}
+
+TEST_F(DocDBTest, SharedDocWriteBatchCache) {
+  const auto encoded_doc_key = DocKey(PrimitiveValues("a")).Encode();
+  {
+    auto dwb = MakeDocWriteBatch(InitMarkerBehavior::kRequired);
+    ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_doc_key, "b"), PrimitiveValue("v1")));
+    ASSERT_OK(WriteToRocksDB(dwb, 1000_usec_ht));
+  }
+
+  SharedDocWriteBatchCache shared_cache;
+  {
+    // Reads the init marker of the document from RocksDB.
+    auto dwb = MakeDocWriteBatch(InitMarkerBehavior::kRequired);
+    dwb.SetSharedCache(&shared_cache, 2000_usec_ht);
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(encoded_doc_key, "c"), PrimitiveValue("v2"),
+        ReadHybridTime::SingleTime(2000_usec_ht)));
+    ASSERT_FALSE(shared_cache.Get(encoded_doc_key, 2000_usec_ht));
+    dwb.PublishToSharedCache();
+  }
+
+  auto entry = shared_cache.Get(encoded_doc_key, 3000_usec_ht);
+  ASSERT_TRUE(entry);
+  ASSERT_EQ(ValueType::kObject, entry->value_type);
+  ASSERT_EQ(1000_usec_ht, entry->doc_hybrid_time.hybrid_time());
+  // Entry was read at a later hybrid time.
+  ASSERT_FALSE(shared_cache.Get(encoded_doc_key, 1500_usec_ht));
+
+  {
+    // Uses the shared entry for the document.
+    auto dwb = MakeDocWriteBatch(InitMarkerBehavior::kRequired);
+    dwb.SetSharedCache(&shared_cache, 3000_usec_ht);
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(encoded_doc_key, "d"), PrimitiveValue("v3"),
+        ReadHybridTime::SingleTime(3000_usec_ht)));
+    auto local_entry = dwb.LookupCache(encoded_doc_key);
+    ASSERT_TRUE(local_entry);
+    ASSERT_EQ(1000_usec_ht, local_entry->doc_hybrid_time.hybrid_time());
+  }
+
+  KeyValueWriteBatchPB put_batch;
+  put_batch.add_write_pairs()->set_key(
+      SubDocKey(DocKey(PrimitiveValues("a")), PrimitiveValue("c")).Encode().ToStringBuffer());
+  const auto epoch = shared_cache.Epoch(encoded_doc_key.AsSlice());
+  shared_cache.InvalidateDocuments(put_batch);
+  ASSERT_FALSE(shared_cache.Get(encoded_doc_key, 3000_usec_ht));
+
+  // Entries read before the invalidation are not added.
+  shared_cache.Put({{encoded_doc_key.data(), *entry, epoch}}, 3000_usec_ht);
+  ASSERT_FALSE(shared_cache.Get(encoded_doc_key, 3000_usec_ht));
+  shared_cache.Put(
+      {{encoded_doc_key.data(), *entry, shared_cache.Epoch(encoded_doc_key.AsSlice())}},
+      3000_usec_ht);
+  ASSERT_TRUE(shared_cache.Get(encoded_doc_key, 3000_usec_ht));
+
+  shared_cache.Clear();
+  ASSERT_FALSE(shared_cache.Get(encoded_doc_key, 3000_usec_ht));
+}
+
 class DocDBTestBoundaryValues: public DocDBTest {
  protected:
   void TestBoundaryValues(size_t flush_rate) {
@@ -2651,6 +2792,134 @@ TEST_F(DocDBTest, BloomFilterTest) {
   ASSERT_NO_FATALS(CheckBloom(2, &total_bloom_useful, 2, &total_table_iterators));
 }
 
+TEST_F(DocDBTest, ReadTimeFileFilter) {
+  // Each file contains the version of the key written at the corresponding hybrid time:
+  // file1: key = value1 at 1000
+  // file2: key = value2 at 2000
+  // file3: key = value3 at 3000
+  DocKey key(0, PrimitiveValues("key"), PrimitiveValues());
+  for (int i = 1; i <= 3; ++i) {
+    auto dwb = MakeDocWriteBatch();
+    ASSERT_OK(dwb.SetPrimitive(DocPath(key.Encode()), PrimitiveValue(Format("value$0", i))));
+    ASSERT_OK(WriteToRocksDB(dwb, HybridTime(i * 1000)));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  auto encoded_subdoc_key = SubDocKey(key).EncodeWithoutHt();
+  for (int i = 1; i <= 3; ++i) {
+    SubDocument doc_from_rocksdb;
+    bool subdoc_found_in_rocksdb = false;
+    GetSubDocumentData data = { encoded_subdoc_key, &doc_from_rocksdb, &subdoc_found_in_rocksdb };
+    auto iterators_before =
+        regular_db_options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+    ASSERT_OK(GetSubDocument(
+        doc_db(), data, rocksdb::kDefaultQueryId, boost::none /* txn_op_context */,
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromUint64(i * 1000 + 500)));
+    ASSERT_TRUE(subdoc_found_in_rocksdb);
+    ASSERT_EQ(Format("\"value$0\"", i), doc_from_rocksdb.ToString());
+    // Files written after the read time are not read.
+    ASSERT_EQ(iterators_before + i,
+              regular_db_options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS));
+  }
+}
+
+TEST_F(DocDBTest, MemTableBloomFilter) {
+  FLAGS_memstore_bloom_filter_size_kb = 64;
+  ASSERT_OK(ReinitDBOptions());
+
+  DocKey key1(0, PrimitiveValues("key1"), PrimitiveValues());
+  DocKey key2(0, PrimitiveValues("key2"), PrimitiveValues());
+  auto dwb = MakeDocWriteBatch();
+  ASSERT_OK(dwb.SetPrimitive(DocPath(key1.Encode()), PrimitiveValue("value")));
+  ASSERT_OK(WriteToRocksDB(dwb, 1000_usec_ht));
+
+  rocksdb::SetPerfLevel(rocksdb::PerfLevel::kEnableCount);
+  for (const auto* key : {&key1, &key2}) {
+    SubDocument doc_from_rocksdb;
+    bool subdoc_found_in_rocksdb = false;
+    auto encoded_subdoc_key = SubDocKey(*key).EncodeWithoutHt();
+    GetSubDocumentData data = { encoded_subdoc_key, &doc_from_rocksdb, &subdoc_found_in_rocksdb };
+    rocksdb::perf_context.Reset();
+    ASSERT_OK(GetSubDocument(
+        doc_db(), data, rocksdb::kDefaultQueryId,
+        boost::none /* txn_op_context */, CoarseTimePoint::max() /* deadline */));
+    // Only the memstore contains key1, and it is not even looked at for key2.
+    ASSERT_EQ(key == &key1, subdoc_found_in_rocksdb);
+    ASSERT_EQ(key == &key1 ? 0U : 1U, rocksdb::perf_context.bloom_memtable_miss_count);
+  }
+  rocksdb::SetPerfLevel(rocksdb::PerfLevel::kDisable);
+}
+
+TEST_F(DocDBTest, MultiKeyBloomFilterTest) {
+  // Turn off "next instead of seek" optimization, because this test rely on DocDB to do seeks.
+  FLAGS_max_nexts_to_avoid_seek = 0;
+
+  DocKey key1(0, PrimitiveValues("key1"), PrimitiveValues());
+  DocKey key2(0, PrimitiveValues("key2"), PrimitiveValues());
+  DocKey key3(0, PrimitiveValues("key3"), PrimitiveValues());
+  DocKey key4(0, PrimitiveValues("key4"), PrimitiveValues());
+  const auto encoded_key1 = key1.Encode();
+  const auto encoded_key2 = key2.Encode();
+  const auto encoded_key3 = key3.Encode();
+  const auto encoded_key4 = key4.Encode();
+
+  // file1: k1, k3
+  // file2: k1, k2
+  auto dwb = MakeDocWriteBatch();
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_key1), PrimitiveValue("value")));
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_key3), PrimitiveValue("value")));
+  ASSERT_OK(WriteToRocksDB(dwb, 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  dwb.Clear();
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_key1), PrimitiveValue("value")));
+  ASSERT_OK(dwb.SetPrimitive(DocPath(encoded_key2), PrimitiveValue("value")));
+  ASSERT_OK(WriteToRocksDB(dwb, 2000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  int total_bloom_useful =
+      regular_db_options().statistics->getTickerCount(rocksdb::BLOOM_FILTER_USEFUL);
+  int total_table_iterators =
+      regular_db_options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+
+  auto create_iterator = [this](const std::vector<Slice>& keys) {
+    return CreateIntentAwareIterator(
+        doc_db(), keys, rocksdb::kDefaultQueryId, boost::none /* txn_op_context */,
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::SingleTime(3000_usec_ht));
+  };
+  auto check_key = [](IntentAwareIterator* iter, const KeyBytes& expected_key) {
+    ASSERT_TRUE(iter->valid());
+    auto fetched_key = ASSERT_RESULT(iter->FetchKey()).key;
+    ASSERT_TRUE(fetched_key.starts_with(expected_key.AsSlice()))
+        << SubDocKey::DebugSliceToString(fetched_key);
+  };
+
+  {
+    // Only file2 could contain k2.
+    auto iter = create_iterator({encoded_key2.AsSlice()});
+    ASSERT_NO_FATALS(CheckBloom(1, &total_bloom_useful, 1, &total_table_iterators));
+    iter->Seek(encoded_key2.AsSlice());
+    ASSERT_NO_FATALS(check_key(iter.get(), encoded_key2));
+  }
+
+  {
+    // File is read when it could contain any of the keys.
+    auto iter = create_iterator({encoded_key2.AsSlice(), encoded_key3.AsSlice()});
+    ASSERT_NO_FATALS(CheckBloom(0, &total_bloom_useful, 2, &total_table_iterators));
+    iter->Seek(encoded_key2.AsSlice());
+    ASSERT_NO_FATALS(check_key(iter.get(), encoded_key2));
+    iter->SeekForward(encoded_key3.AsSlice());
+    ASSERT_NO_FATALS(check_key(iter.get(), encoded_key3));
+  }
+
+  {
+    // None of the files contain k4.
+    auto iter = create_iterator({encoded_key4.AsSlice()});
+    ASSERT_NO_FATALS(CheckBloom(2, &total_bloom_useful, 0, &total_table_iterators));
+    iter->Seek(encoded_key4.AsSlice());
+    ASSERT_FALSE(iter->valid());
+  }
+}
+
 TEST_F(DocDBTest, MergingIterator) {
   // Test for the case described in https://yugabyte.atlassian.net/browse/ENG-1677.
 
@@ -3117,6 +3386,94 @@ TEST_F(DocDBTest, TestBuildSubDocumentBounds) {
   EXPECT_FALSE(subdoc_found);
 }
 
+TEST_F(DocDBTest, TestBuildSubDocumentIndexBounds) {
+  // Two level document, laid out like a Redis sorted set: score -> member -> value.
+  const DocKey doc_key(PrimitiveValues("key"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  const int kNumScores = 10;
+  // Leaves visible at read time, in key order.
+  std::vector<std::tuple<string, string, string>> leaves;
+  for (int i = 0; i != kNumScores; ++i) {
+    const string score = Format("s$0", i);
+    for (const char* member : {"a", "b"}) {
+      const string member_key = Format("m$0$1", i, member);
+      const string value = Format("v$0$1", i, member);
+      DocPath path(encoded_doc_key, PrimitiveValue(score), PrimitiveValue(member_key));
+      if (i % 4 == 2 && member == string("b")) {
+        // Expires before the read time.
+        ASSERT_OK(SetPrimitive(
+            path, Value(PrimitiveValue(value), MonoDelta::FromMilliseconds(100)), 1000_usec_ht));
+        continue;
+      }
+      ASSERT_OK(SetPrimitive(path, PrimitiveValue(value), 1000_usec_ht));
+      if (i % 4 == 1) {
+        // Whole score is deleted below.
+        continue;
+      }
+      if (i % 4 == 3 && member == string("a")) {
+        ASSERT_OK(DeleteSubDoc(path, 2000_usec_ht));
+        continue;
+      }
+      leaves.emplace_back(score, member_key, value);
+    }
+    if (i % 4 == 1) {
+      ASSERT_OK(DeleteSubDoc(DocPath(encoded_doc_key, PrimitiveValue(score)), 3000_usec_ht));
+      if (i == 5) {
+        // Member written after the tombstone of its score.
+        const string member_key = "m5a";
+        ASSERT_OK(SetPrimitive(
+            DocPath(encoded_doc_key, PrimitiveValue(score), PrimitiveValue(member_key)),
+            PrimitiveValue("v5new"), 4000_usec_ht));
+        leaves.emplace_back(score, member_key, "v5new");
+      }
+    }
+  }
+  const int64 num_leaves = leaves.size();
+
+  const auto encoded_subdoc_key = SubDocKey(doc_key).EncodeWithoutHt();
+  // -1 means that there is no bound.
+  const std::vector<int64> lows = {-1, 0, 1, 3, 4, num_leaves - 1, num_leaves, num_leaves + 2};
+  const std::vector<int64> highs = {-1, 0, 2, 5, num_leaves - 2, num_leaves - 1, num_leaves + 3};
+  for (int64 low : lows) {
+    for (int64 high : highs) {
+      if (high != -1 && low > high) {
+        continue;
+      }
+      SCOPED_TRACE(Format("Index bounds: [$0, $1]", low, high));
+      IndexBound low_index = low == -1 ? IndexBound() : IndexBound(low, true /* is_lower */);
+      IndexBound high_index = high == -1 ? IndexBound() : IndexBound(high, false /* is_lower */);
+
+      // Expected result contains leaves with index in [low, high], tombstoned and expired entries
+      // are not counted.
+      SubDocument expected;
+      bool expected_found = false;
+      for (int64 index = 0; index != num_leaves; ++index) {
+        if (!low_index.CanInclude(index) || !high_index.CanInclude(index)) {
+          continue;
+        }
+        const auto& leaf = leaves[index];
+        expected.GetOrAddChild(PrimitiveValue(std::get<0>(leaf))).first->SetChildPrimitive(
+            PrimitiveValue(std::get<1>(leaf)), PrimitiveValue(std::get<2>(leaf)));
+        expected_found = true;
+      }
+
+      SubDocument doc_from_rocksdb;
+      bool subdoc_found = false;
+      GetSubDocumentData data = { encoded_subdoc_key, &doc_from_rocksdb, &subdoc_found };
+      data.low_index = &low_index;
+      data.high_index = &high_index;
+      ASSERT_OK(GetSubDocument(
+          doc_db(), data, rocksdb::kDefaultQueryId,
+          kNonTransactionalOperationContext, CoarseTimePoint::max() /* deadline */,
+          ReadHybridTime::SingleTime(1000000_usec_ht)));
+      ASSERT_EQ(expected_found, subdoc_found);
+      if (expected_found) {
+        ASSERT_STR_EQ_VERBOSE_TRIMMED(expected.ToString(), doc_from_rocksdb.ToString());
+      }
+    }
+  }
+}
+
 TEST_F(DocDBTest, TestCompactionForCollectionsWithTTL) {
   DocKey collection_key(PrimitiveValues("collection"));
   SetUpCollectionWithTTL(collection_key, UseIntermediateFlushes::kFalse);
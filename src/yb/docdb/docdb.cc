@@ -24,6 +24,7 @@
 #include "yb/common/transaction.h"
 
 #include "yb/docdb/conflict_resolution.h"
+#include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb-internal.h"
@@ -35,6 +36,7 @@
 #include "yb/docdb/docdb_util.h"
 #include "yb/docdb/intent.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/subdocument.h"
@@ -51,6 +53,7 @@
 
 #include "yb/util/bitmap.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/coding.h"
 #include "yb/util/date_time.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
@@ -365,9 +368,13 @@ Status ExecuteDocWriteOperation(const vector<unique_ptr<DocOperation>>& doc_writ
                                 InitMarkerBehavior init_marker_behavior,
                                 std::atomic<int64_t>* monotonic_counter,
                                 HybridTime* restart_read_ht,
-                                const string& table_name) {
+                                const string& table_name,
+                                SharedDocWriteBatchCache* shared_cache) {
   DCHECK_ONLY_NOTNULL(restart_read_ht);
   DocWriteBatch doc_write_batch(doc_db, init_marker_behavior, monotonic_counter);
+  if (shared_cache) {
+    doc_write_batch.SetSharedCache(shared_cache, read_time.read);
+  }
   DocOperationApplyData data = {&doc_write_batch, deadline, read_time, restart_read_ht};
   for (const unique_ptr<DocOperation>& doc_op : doc_write_ops) {
     Status s = doc_op->Apply(data);
@@ -388,6 +395,9 @@ Status ExecuteDocWriteOperation(const vector<unique_ptr<DocOperation>>& doc_writ
 
     RETURN_NOT_OK(s);
   }
+  if (!restart_read_ht->is_valid()) {
+    doc_write_batch.PublishToSharedCache();
+  }
   doc_write_batch.MoveToWriteBatchPB(write_batch);
   return Status::OK();
 }
@@ -399,20 +409,20 @@ void PrepareNonTransactionWriteBatch(
   CHECK(put_batch.read_pairs().empty());
 
   DocHybridTimeBuffer doc_ht_buffer;
-  for (int write_id = 0; write_id < put_batch.write_pairs_size(); ++write_id) {
-    const auto& kv_pair = put_batch.write_pairs(write_id);
-    CHECK(!kv_pair.key().empty());
-    CHECK(!kv_pair.value().empty());
+  IntraTxnWriteId write_id = 0;
+  auto put = [&](const Slice& key, const Slice& value, HybridTime pair_hybrid_time) {
+    CHECK(!key.empty());
+    CHECK(!value.empty());
 
 #ifndef NDEBUG
     // Debug-only: ensure all keys we get in Raft replication can be decoded.
     {
       SubDocKey subdoc_key;
-      Status s = subdoc_key.FullyDecodeFromKeyWithOptionalHybridTime(kv_pair.key());
+      Status s = subdoc_key.FullyDecodeFromKeyWithOptionalHybridTime(key);
       CHECK(s.ok())
           << "Failed decoding key: " << s.ToString() << "; "
-          << "Problematic key: " << BestEffortDocDBKeyToStr(KeyBytes(kv_pair.key())) << "\n"
-          << "value: " << FormatBytesAsStr(kv_pair.value()) << "\n"
+          << "Problematic key: " << BestEffortDocDBKeyToStr(KeyBytes(key)) << "\n"
+          << "value: " << FormatBytesAsStr(value) << "\n"
           << "put_batch:\n" << put_batch.DebugString();
     }
 #endif
@@ -427,17 +437,74 @@ void PrepareNonTransactionWriteBatch(
     // same key (row/column) within a transaction. We set it based on the position of the write
     // operation in its write batch.
 
-    hybrid_time = kv_pair.has_external_hybrid_time() ?
-        HybridTime(kv_pair.external_hybrid_time()) : hybrid_time;
     std::array<Slice, 2> key_parts = {{
-        Slice(kv_pair.key()),
-        doc_ht_buffer.EncodeWithValueType(hybrid_time, write_id),
+        key,
+        doc_ht_buffer.EncodeWithValueType(pair_hybrid_time, write_id++),
     }};
-    Slice key_value = kv_pair.value();
-    rocksdb_write_batch->Put(key_parts, { &key_value, 1 });
+    rocksdb_write_batch->Put(key_parts, { &value, 1 });
+  };
+
+  for (const auto& kv_pair : put_batch.write_pairs()) {
+    hybrid_time = kv_pair.has_external_hybrid_time() ?
+        HybridTime(kv_pair.external_hybrid_time()) : hybrid_time;
+    put(kv_pair.key(), kv_pair.value(), hybrid_time);
+  }
+
+  // Encoded pairs are only replicated for batches without external hybrid time, so they are put
+  // directly from the replicated buffer.
+  Slice encoded(put_batch.encoded_write_pairs());
+  while (!encoded.empty()) {
+    Slice key, value;
+    CHECK(GetLengthPrefixedSlice(&encoded, &key) && GetLengthPrefixedSlice(&encoded, &value))
+        << "Bad encoded write pairs: " << put_batch.ShortDebugString();
+    put(key, value, hybrid_time);
   }
 }
 
+void SetTtlExpiration(
+    const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time, ConsensusFrontier* frontier) {
+  HybridTime value_expiration = HybridTime::kMin;
+  HybridTime ttl_row_expiration = HybridTime::kMin;
+  auto add = [&](Slice value, HybridTime pair_hybrid_time) -> Status {
+    uint64_t merge_flags = 0;
+    MonoDelta ttl;
+    RETURN_NOT_OK(Value::DecodeMergeFlags(&value, &merge_flags));
+    RETURN_NOT_OK(Value::DecodeTTL(&value, &ttl));
+    auto expiration = ExpirationHybridTime(pair_hybrid_time, ttl);
+    value_expiration.MakeAtLeast(expiration);
+    if (merge_flags & Value::kTtlFlag) {
+      ttl_row_expiration.MakeAtLeast(expiration);
+    }
+    return Status::OK();
+  };
+
+  for (const auto& kv_pair : put_batch.write_pairs()) {
+    auto status = add(kv_pair.value(), kv_pair.has_external_hybrid_time()
+        ? HybridTime(kv_pair.external_hybrid_time()) : hybrid_time);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to decode TTL of " << FormatBytesAsStr(kv_pair.value()) << ": "
+                   << status;
+      return;
+    }
+  }
+
+  Slice encoded(put_batch.encoded_write_pairs());
+  while (!encoded.empty()) {
+    Slice key, value;
+    if (!GetLengthPrefixedSlice(&encoded, &key) || !GetLengthPrefixedSlice(&encoded, &value)) {
+      return;
+    }
+    auto status = add(value, hybrid_time);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to decode TTL of " << FormatBytesAsStr(value) << ": " << status;
+      return;
+    }
+  }
+
+  frontier->set_value_ttl_expiration(value_expiration);
+  frontier->set_ttl_row_expiration(ttl_row_expiration);
+}
+
 namespace {
 
 // Checks if the given slice points to the part of an encoded SubDocKey past all of the subkeys
@@ -827,6 +894,11 @@ CHECKED_STATUS BuildSubDocument(
     if (data.deadline_info && data.deadline_info->CheckAndSetDeadlinePassed()) {
       return STATUS(Expired, "Deadline for query passed.");
     }
+    // All values up to the high index bound were already observed, so nothing that follows could
+    // be included. Stop here instead of visiting the rest of the subdocument.
+    if (!data.high_index->CanInclude(*num_values_observed)) {
+      return Status::OK();
+    }
     // Since we modify num_values_observed on recursive calls, we keep a local copy of the value.
     int64 current_values_observed = *num_values_observed;
     auto key_data = VERIFY_RESULT(iter->FetchKey());
@@ -888,21 +960,30 @@ CHECKED_STATUS BuildSubDocument(
       }
 
       const bool is_collection = IsCollectionType(value_type);
+      const bool is_packed_row = value_type == ValueType::kPackedRow;
       // We have found some key that matches our entire subdocument_key, i.e. we didn't skip ahead
       // to a lower level key (with optional object init markers).
-      if (is_collection || value_type == ValueType::kTombstone) {
+      if (is_collection || is_packed_row || value_type == ValueType::kTombstone) {
         if (low_ts < write_time) {
           low_ts = write_time;
         }
         if (is_collection) {
           *data.result = SubDocument(value_type);
+        } else if (is_packed_row) {
+          // Packed row overwrites the whole row, so it is handled as an object init marker
+          // followed by the packed column values. Column values written after the packed row are
+          // merged into the result by the code below.
+          *data.result = SubDocument();
+          RETURN_NOT_OK(UnpackRowToSubDocument(
+              doc_value.packed_row(), write_time.hybrid_time().GetPhysicalValueMicros(),
+              data.result));
         }
 
         // If the subkey lower bound filters out the key we found, we want to skip to the lower
         // bound. If it does not, we want to seek to the next key. This prevents an infinite loop
         // where the iterator keeps seeking to itself if the key we found matches the low subkey.
         // TODO: why are not we doing this for arrays?
-        if (IsObjectType(value_type) && !data.low_subkey->CanInclude(key)) {
+        if ((IsObjectType(value_type) || is_packed_row) && !data.low_subkey->CanInclude(key)) {
           // Try to seek to the low_subkey for efficiency.
           SeekToLowerBound(*data.low_subkey, iter);
         } else {
@@ -1259,6 +1340,14 @@ yb::Status GetSubDocument(
   // Seed key_bytes with the subdocument key. For each subkey in the projection, build subdocument
   // and reuse key_bytes while appending the subkey.
   *data.result = SubDocument();
+  // When the row is stored as a packed row, the projected columns are taken from it, unless they
+  // were written after the packed row. max_overwrite_ht is the packed row write time in that case.
+  SubDocument packed_row(ValueType::kInvalid);
+  if (value_type == ValueType::kPackedRow) {
+    RETURN_NOT_OK(UnpackRowToSubDocument(
+        doc_value.packed_row(), max_overwrite_ht.hybrid_time().GetPhysicalValueMicros(),
+        &packed_row));
+  }
   KeyBytes key_bytes;
   // Preallocate some extra space to avoid allocation for small subkeys.
   key_bytes.Reserve(data.subdocument_key.size() + kMaxBytesPerEncodedHybridTime + 32);
@@ -1274,10 +1363,28 @@ yb::Status GetSubDocument(
     IntentAwareIteratorPrefixScope prefix_scope(key_bytes, db_iter);
     db_iter->SeekForward(&key_bytes);
     SubDocument descendant(ValueType::kInvalid);
-    int64 num_values_observed = 0;
-    RETURN_NOT_OK(BuildSubDocument(
-        db_iter, data.Adjusted(key_bytes, &descendant), max_overwrite_ht,
-        &num_values_observed));
+    DocHybridTime column_overwrite_ht = max_overwrite_ht;
+    if (packed_row.value_type() != ValueType::kInvalid) {
+      Expiration column_exp = data.exp;
+      RETURN_NOT_OK(FindLastWriteTime(
+          db_iter, key_bytes.AsSlice(), &column_overwrite_ht, &column_exp));
+    }
+    if (column_overwrite_ht == max_overwrite_ht &&
+        packed_row.value_type() != ValueType::kInvalid) {
+      // The column was not written after the packed row.
+      SubDocument* packed_column = packed_row.GetChild(subkey);
+      if (packed_column) {
+        descendant = std::move(*packed_column);
+      } else if (subkey.value_type() == ValueType::kSystemColumnId) {
+        // Packed row also serves as the liveness column.
+        descendant = SubDocument(PrimitiveValue());
+      }
+    } else {
+      int64 num_values_observed = 0;
+      RETURN_NOT_OK(BuildSubDocument(
+          db_iter, data.Adjusted(key_bytes, &descendant), max_overwrite_ht,
+          &num_values_observed));
+    }
     *data.doc_found = descendant.value_type() != ValueType::kInvalid;
     data.result->SetChild(subkey, std::move(descendant));
 
@@ -1392,45 +1499,25 @@ CHECKED_STATUS IntentToWriteRequest(
   return Status::OK();
 }
 
-Status PrepareApplyIntentsBatch(
-    const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
-    rocksdb::WriteBatch* regular_batch,
-    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
-  // regular_batch or intents_batch could be null. In this case we don't fill apply batch for
-  // appropriate DB.
+namespace {
 
+// Fills batches for the specified transaction using the provided reverse index iterator, that
+// could be shared by several transactions. intent_iter is used only when regular_batch is not null.
+CHECKED_STATUS PrepareApplyIntentsBatch(
+    const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    BoundedRocksDbIterator* reverse_index_iter, BoundedRocksDbIterator* intent_iter,
+    rocksdb::WriteBatch* regular_batch, rocksdb::WriteBatch* intents_batch,
+    const std::string& log_prefix) {
   KeyBytes txn_reverse_index_prefix;
   Slice transaction_id_slice = transaction_id.AsSlice();
   AppendTransactionKeyPrefix(transaction_id, &txn_reverse_index_prefix);
-  txn_reverse_index_prefix.AppendValueType(ValueType::kMaxByte);
   Slice key_prefix = txn_reverse_index_prefix.AsSlice();
-  key_prefix.remove_suffix(1);
-  const Slice reverse_index_upperbound = txn_reverse_index_prefix.AsSlice();
-
-  auto reverse_index_iter = CreateRocksDBIterator(
-      intents_db, &KeyBounds::kNoBounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
-      rocksdb::kDefaultQueryId, nullptr /* read_filter */, &reverse_index_upperbound);
-
-  BoundedRocksDbIterator intent_iter;
-
-  // If we don't have regular_batch, it means that we are just removing intents, i.e. when a
-  // transaction has been aborted. We don't need the intent iterator in that case, because the
-  // reverse index iterator is sufficient.
-  if (regular_batch) {
-    intent_iter = CreateRocksDBIterator(
-        intents_db, key_bounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
-        rocksdb::kDefaultQueryId);
-  }
 
-  reverse_index_iter.Seek(key_prefix);
-
-  DocHybridTimeBuffer doc_ht_buffer;
-
-  const auto& log_prefix = intents_db->GetOptions().log_prefix;
+  reverse_index_iter->Seek(key_prefix);
 
   IntraTxnWriteId write_id = 0;
-  while (reverse_index_iter.Valid()) {
-    rocksdb::Slice key_slice(reverse_index_iter.key());
+  while (reverse_index_iter->Valid()) {
+    rocksdb::Slice key_slice(reverse_index_iter->key());
 
     if (!key_slice.starts_with(key_prefix)) {
       break;
@@ -1438,12 +1525,12 @@ Status PrepareApplyIntentsBatch(
 
     VLOG(4) << log_prefix << "Apply reverse index record to ["
             << (regular_batch ? "R" : "") << (intents_batch ? "I" : "")
-            << "]: " << EntryToString(reverse_index_iter, StorageDbType::kIntents);
+            << "]: " << EntryToString(*reverse_index_iter, StorageDbType::kIntents);
 
     // If the key ends at the transaction id then it is transaction metadata (status tablet,
     // isolation level etc.).
     if (key_slice.size() > txn_reverse_index_prefix.size()) {
-      auto reverse_index_value = reverse_index_iter.value();
+      auto reverse_index_value = reverse_index_iter->value();
       if (!reverse_index_value.empty() && reverse_index_value[0] == ValueTypeAsChar::kBitSet) {
         CHECK(!FLAGS_TEST_fail_on_replicated_batch_idx_set_in_txn_record);
         reverse_index_value.remove_prefix(1);
@@ -1452,10 +1539,10 @@ Status PrepareApplyIntentsBatch(
 
       // Value of reverse index is a key of original intent record, so seek it and check match.
       if (regular_batch &&
-          (!key_bounds || key_bounds->IsWithinBounds(reverse_index_iter.value()))) {
+          (!key_bounds || key_bounds->IsWithinBounds(reverse_index_value))) {
         RETURN_NOT_OK(IntentToWriteRequest(
-            transaction_id_slice, commit_ht, reverse_index_iter.key(), reverse_index_value,
-            &intent_iter, regular_batch, &write_id));
+            transaction_id_slice, commit_ht, reverse_index_iter->key(), reverse_index_value,
+            intent_iter, regular_batch, &write_id));
       }
 
       if (intents_batch) {
@@ -1464,14 +1551,75 @@ Status PrepareApplyIntentsBatch(
     }
 
     if (intents_batch) {
-      intents_batch->SingleDelete(reverse_index_iter.key());
+      intents_batch->SingleDelete(reverse_index_iter->key());
     }
 
-    reverse_index_iter.Next();
+    reverse_index_iter->Next();
   }
 
   return Status::OK();
 }
 
+} // namespace
+
+Status PrepareApplyIntentsBatch(
+    const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    rocksdb::WriteBatch* regular_batch,
+    rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
+  // regular_batch or intents_batch could be null. In this case we don't fill apply batch for
+  // appropriate DB.
+
+  KeyBytes reverse_index_upperbound_buffer;
+  AppendTransactionKeyPrefix(transaction_id, &reverse_index_upperbound_buffer);
+  reverse_index_upperbound_buffer.AppendValueType(ValueType::kMaxByte);
+  const Slice reverse_index_upperbound = reverse_index_upperbound_buffer.AsSlice();
+
+  auto reverse_index_iter = CreateRocksDBIterator(
+      intents_db, &KeyBounds::kNoBounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
+      rocksdb::kDefaultQueryId, nullptr /* read_filter */, &reverse_index_upperbound);
+
+  BoundedRocksDbIterator intent_iter;
+
+  // If we don't have regular_batch, it means that we are just removing intents, i.e. when a
+  // transaction has been aborted. We don't need the intent iterator in that case, because the
+  // reverse index iterator is sufficient.
+  if (regular_batch) {
+    intent_iter = CreateRocksDBIterator(
+        intents_db, key_bounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
+        rocksdb::kDefaultQueryId);
+  }
+
+  return PrepareApplyIntentsBatch(
+      transaction_id, commit_ht, key_bounds, &reverse_index_iter, &intent_iter, regular_batch,
+      intents_batch, intents_db->GetOptions().log_prefix);
+}
+
+Status PrepareRemoveIntentsBatch(
+    std::vector<TransactionId> transactions, rocksdb::DB* intents_db,
+    rocksdb::WriteBatch* intents_batch) {
+  if (transactions.empty()) {
+    return Status::OK();
+  }
+
+  // Reverse index records of all transactions are placed before this bound, so a single iterator
+  // could be used for all of them. Transactions are processed in key order, so it only moves
+  // forward.
+  const char reverse_index_upperbound_char = ValueTypeAsChar::kTransactionId + 1;
+  const Slice reverse_index_upperbound(&reverse_index_upperbound_char, 1);
+  auto reverse_index_iter = CreateRocksDBIterator(
+      intents_db, &KeyBounds::kNoBounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
+      rocksdb::kDefaultQueryId, nullptr /* read_filter */, &reverse_index_upperbound);
+
+  std::sort(transactions.begin(), transactions.end());
+  const auto& log_prefix = intents_db->GetOptions().log_prefix;
+  for (const auto& transaction_id : transactions) {
+    RETURN_NOT_OK(PrepareApplyIntentsBatch(
+        transaction_id, HybridTime() /* commit_ht */, nullptr /* key_bounds */,
+        &reverse_index_iter, nullptr /* intent_iter */, nullptr /* regular_batch */,
+        intents_batch, log_prefix));
+  }
+  return Status::OK();
+}
+
 }  // namespace docdb
 }  // namespace yb
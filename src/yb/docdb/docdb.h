@@ -129,6 +129,9 @@ Result<PrepareDocWriteOperationResult> PrepareDocWriteOperation(
 // Input: doc_write_ops, read snapshot hybrid_time if requested in PrepareDocWriteOperation().
 // Context: rocksdb
 // Outputs: keys_locked, write_batch
+//
+// shared_cache, when specified, is used to look up and to share key prefixes read from RocksDB with
+// other operations of the same tablet. It should be used only for non-transactional operations.
 CHECKED_STATUS ExecuteDocWriteOperation(
     const std::vector<std::unique_ptr<DocOperation>>& doc_write_ops,
     CoarseTimePoint deadline,
@@ -138,13 +141,20 @@ CHECKED_STATUS ExecuteDocWriteOperation(
     InitMarkerBehavior init_marker_behavior,
     std::atomic<int64_t>* monotonic_counter,
     HybridTime* restart_read_ht,
-    const std::string& table_name);
+    const std::string& table_name,
+    SharedDocWriteBatchCache* shared_cache = nullptr);
 
 void PrepareNonTransactionWriteBatch(
     const docdb::KeyValueWriteBatchPB& put_batch,
     HybridTime hybrid_time,
     rocksdb::WriteBatch* rocksdb_write_batch);
 
+// Sets value_ttl_expiration and ttl_row_expiration of the frontier, which should be the largest
+// frontier of the non-transactional put_batch applied at hybrid_time. They are left unknown when
+// some of the values cannot be decoded.
+void SetTtlExpiration(
+    const KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time, ConsensusFrontier* frontier);
+
 YB_STRONGLY_TYPED_BOOL(LastKey);
 
 // Enumerates intents corresponding to provided key value pairs.
@@ -192,6 +202,12 @@ CHECKED_STATUS PrepareApplyIntentsBatch(
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
 
+// Fills intents_batch with removal of all intents of the specified transactions, e.g. after they
+// were aborted. A single reverse index iterator is used for all transactions.
+CHECKED_STATUS PrepareRemoveIntentsBatch(
+    std::vector<TransactionId> transactions, rocksdb::DB* intents_db,
+    rocksdb::WriteBatch* intents_batch);
+
 // Represents a general SubDocKey with information on whether this bound is lower/upper and whether
 // it is exclusive. Used in range requests.
 class SubDocKeyBound : public SubDocKey {
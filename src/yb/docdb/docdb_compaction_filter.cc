@@ -15,6 +15,7 @@
 
 #include <memory>
 
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 
 #include "yb/rocksdb/compaction_filter.h"
@@ -23,6 +24,7 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb-internal.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -34,6 +36,23 @@ using rocksdb::CompactionFilter;
 using rocksdb::VectorToString;
 using rocksdb::FilterDecision;
 
+DEFINE_int32(rocksdb_compaction_time_window_sec, 0,
+             "When positive, SST files are partitioned by hybrid time of their writes into "
+             "windows of the specified size, and files from different windows are not compacted "
+             "together. Together with file_expiration_by_table_ttl it allows to drop expired data "
+             "without rewriting it.");
+
+DEFINE_bool(file_expiration_by_table_ttl, false,
+            "Delete SST files as a whole when all their entries are expired according to the "
+            "table TTL. Value level TTL is not taken into account, so it should not be enabled "
+            "for tables that use value level TTL longer than the table TTL.");
+
+DEFINE_bool(file_expiration_by_value_ttl, false,
+            "Delete the oldest SST files as a whole when all their values are expired according "
+            "to the value level TTL, and no newer file could extend it. Together with "
+            "rocksdb_compaction_time_window_sec it allows to drop expired Redis keys without "
+            "rewriting them.");
+
 namespace yb {
 namespace docdb {
 
@@ -100,14 +119,35 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
 
   sub_key_ends_.resize(num_shared_components);
 
-  RETURN_NOT_OK(SubDocKey::DecodeDocKeyAndSubKeyEnds(key, &sub_key_ends_));
-  const size_t new_stack_size = sub_key_ends_.size();
-
   // Remove overwrite hybrid_times for components that are no longer relevant for the current
   // SubDocKey.
   overwrite_.resize(min(overwrite_.size(), num_shared_components));
-  DocHybridTime ht;
-  RETURN_NOT_OK(ht.DecodeFromEnd(key));
+
+  Slice key_without_ht = key;
+  const auto ht = VERIFY_RESULT(DocHybridTime::DecodeFromEnd(&key_without_ht));
+
+  // Fast path for entries that are too new to be garbage-collected, which is the case for most
+  // entries of minor compactions. Every component of such key would get the overwrite hybrid
+  // time of the deepest shared component pushed to the stack, the same value that is used when
+  // the stack is extended for the next key. So we don't decode the subkeys of this key, and keep
+  // only the shared components in sub_key_ends_ and overwrite_.
+  //
+  // Entries above the history cutoff are never dropped because of an earlier overwrite, since
+  // the overwrite stack only contains hybrid times not exceeding the cutoff. They also cannot
+  // continue a merge block, since a merge record is only processed when it does not exceed the
+  // cutoff, and newer hybrid times of the same key precede it.
+  if (ht.hybrid_time() > history_cutoff) {
+    // Skip kHybridTime value type.
+    const size_t size = key_without_ht.size() - 1;
+    prev_subdoc_key_.resize(size);
+    memcpy(prev_subdoc_key_.data() + same_bytes, key.cdata() + same_bytes, size - same_bytes);
+    within_merge_block_ = false;
+    return FilterDecision::kKeep;
+  }
+
+  RETURN_NOT_OK(SubDocKey::DecodeDocKeyAndSubKeyEnds(key, &sub_key_ends_));
+  const size_t new_stack_size = sub_key_ends_.size();
+
   // We're comparing the hybrid time in this key with the stack top of overwrite_ht_ after
   // truncating the stack to the number of components in the common prefix of previous and current
   // key.
@@ -173,17 +213,6 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     within_merge_block_ = false;
   }
 
-  // See if we found a higher hybrid time not exceeding the history cutoff hybrid time at which the
-  // subdocument (including a primitive value) rooted at the current key was fully overwritten.
-  // In case of ht > history_cutoff_, we just keep the parent document's highest known overwrite
-  // hybrid time that does not exceed the cutoff hybrid time. In that case this entry is obviously
-  // too new to be garbage-collected.
-  if (ht.hybrid_time() > history_cutoff) {
-    AssignPrevSubDocKey(key.cdata(), same_bytes);
-    overwrite_.push_back({prev_overwrite_ht, prev_exp});
-    return FilterDecision::kKeep;
-  }
-
   // Check for CQL columns deleted from the schema. This is done regardless of whether this is a
   // major or minor compaction.
   //
@@ -211,6 +240,17 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
       value_slice.FirstByteOr(ValueTypeAsChar::kInvalid));
   const Expiration curr_exp(ht.hybrid_time(), value.ttl());
 
+  // Columns deleted from the schema are also removed from packed rows.
+  std::string repacked_row;
+  if (value_type == ValueType::kPackedRow && !retention_.deleted_cols->empty() &&
+      VERIFY_RESULT(RemoveColumnsFromPackedRow(
+          value_slice, *retention_.deleted_cols, &repacked_row))) {
+    value_slice = repacked_row;
+    *value_changed = true;
+    new_value->clear();
+    value.EncodeAndAppend(new_value, &value_slice);
+  }
+
   // If within the merge block.
   //     If the row is a TTL row, delete it.
   //     Otherwise, replace it with the cached TTL (i.e., apply merge).
@@ -348,6 +388,87 @@ const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
 
+Slice DocDBCompactionFilterFactory::SubcompactionBoundary(const Slice& user_key) const {
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+  if (!doc_key_size.ok()) {
+    return Slice();
+  }
+  return Slice(user_key.data(), *doc_key_size);
+}
+
+uint64_t DocDBCompactionFilterFactory::TimeWindow(
+    const rocksdb::UserFrontier& largest_frontier) const {
+  if (FLAGS_rocksdb_compaction_time_window_sec <= 0) {
+    return 0;
+  }
+  auto hybrid_time = down_cast<const ConsensusFrontier&>(largest_frontier).hybrid_time();
+  if (!hybrid_time.is_valid()) {
+    return 0;
+  }
+  return hybrid_time.GetPhysicalValueMicros() /
+         (static_cast<uint64_t>(FLAGS_rocksdb_compaction_time_window_sec) *
+          MonoTime::kMicrosecondsPerSecond);
+}
+
+bool DocDBCompactionFilterFactory::Expired(const rocksdb::UserFrontier& largest_frontier) const {
+  if (!FLAGS_file_expiration_by_table_ttl) {
+    return false;
+  }
+  // Largest frontier contains the max hybrid time of all writes to the file.
+  auto hybrid_time = down_cast<const ConsensusFrontier&>(largest_frontier).hybrid_time();
+  if (!hybrid_time.is_valid()) {
+    return false;
+  }
+  auto retention = retention_policy_->GetRetentionDirective();
+  if (retention.retain_delete_markers_in_major_compaction) {
+    return false;
+  }
+  bool has_expired = false;
+  auto status = HasExpiredTTL(
+      hybrid_time, retention.table_ttl, retention.history_cutoff, &has_expired);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to check file expiration: " << status;
+    return false;
+  }
+  return has_expired;
+}
+
+bool DocDBCompactionFilterFactory::ExpiredOldest(
+    const rocksdb::UserFrontier& largest_frontier,
+    const rocksdb::UserFrontier* newer_files_frontier) const {
+  if (!FLAGS_file_expiration_by_value_ttl) {
+    return false;
+  }
+  const auto& frontier = down_cast<const ConsensusFrontier&>(largest_frontier);
+  auto expiration = frontier.value_ttl_expiration();
+  if (!expiration.is_valid() || expiration == HybridTime::kMax) {
+    return false;
+  }
+  auto retention = retention_policy_->GetRetentionDirective();
+  if (retention.retain_delete_markers_in_major_compaction ||
+      !retention.history_cutoff.is_valid() ||
+      expiration.GetPhysicalValueMicros() >= retention.history_cutoff.GetPhysicalValueMicros()) {
+    return false;
+  }
+
+  // Values could only be extended by TTL rows written before they expire, because Redis does not
+  // set TTL of keys that do not exist. Such rows could be in newer files, so we require them to
+  // be expired as well. Writes that are not flushed yet are newer than all files, so they could
+  // not contain such rows when the newer files already have writes after the expiration.
+  auto hybrid_time = frontier.hybrid_time();
+  if (newer_files_frontier) {
+    const auto& newer = down_cast<const ConsensusFrontier&>(*newer_files_frontier);
+    auto newer_ttl_row_expiration = newer.ttl_row_expiration();
+    if (!newer_ttl_row_expiration.is_valid() ||
+        newer_ttl_row_expiration.GetPhysicalValueMicros() >=
+            retention.history_cutoff.GetPhysicalValueMicros()) {
+      return false;
+    }
+    hybrid_time.MakeAtLeast(newer.hybrid_time());
+  }
+  return hybrid_time.is_valid() && hybrid_time >= expiration;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
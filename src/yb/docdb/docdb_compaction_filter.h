@@ -165,6 +165,22 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
       const rocksdb::CompactionFilter::Context& context) override;
   const char* Name() const override;
 
+  // DocDB compaction filter keeps state between keys of the same DocKey, so subcompactions are
+  // split at DocKey boundaries.
+  Slice SubcompactionBoundary(const Slice& user_key) const override;
+
+  // Time windows are based on the hybrid time of the latest write to the file.
+  uint64_t TimeWindow(const rocksdb::UserFrontier& largest_frontier) const override;
+
+  // File is expired when its latest write is expired according to the table TTL.
+  bool Expired(const rocksdb::UserFrontier& largest_frontier) const override;
+
+  // Oldest file is expired when all its values are expired according to their value level TTL,
+  // and none of them could be extended by TTL rows of newer writes.
+  bool ExpiredOldest(
+      const rocksdb::UserFrontier& largest_frontier,
+      const rocksdb::UserFrontier* newer_files_frontier) const override;
+
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
   const KeyBounds* key_bounds_;
@@ -29,6 +29,7 @@
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/thread_pool.h"
 #include "yb/tablet/transaction_participant.h"
+#include "yb/util/bitmap.h"
 #include "yb/util/flag_tags.h"
 
 DEFINE_uint64(aborted_intent_cleanup_ms, 60000, // 1 minute by default, 1 sec for testing
@@ -53,7 +54,8 @@ namespace {
 class DocDBIntentsCompactionFilter : public rocksdb::CompactionFilter {
  public:
   explicit DocDBIntentsCompactionFilter(tablet::Tablet* tablet, const KeyBounds* key_bounds)
-      : tablet_(tablet), compaction_start_time_(tablet->clock()->Now().GetPhysicalValueMicros()) {}
+      : tablet_(tablet), key_bounds_(key_bounds),
+        compaction_start_time_(tablet->clock()->Now().GetPhysicalValueMicros()) {}
 
   ~DocDBIntentsCompactionFilter() override;
 
@@ -70,7 +72,16 @@ class DocDBIntentsCompactionFilter : public rocksdb::CompactionFilter {
   void AddToSet(const TransactionId& transaction_id);
 
  private:
+  // Whether the intent with the specified key is related to this tablet. Weak intents on the
+  // empty doc key (table root) are written for every row, so they are related to all tablets
+  // split from the same tablet.
+  bool IsRelatedIntent(const Slice& intent_key) const {
+    return (!intent_key.empty() && intent_key[0] == ValueTypeAsChar::kGroupEnd) ||
+           key_bounds_->IsWithinBounds(intent_key);
+  }
+
   tablet::Tablet* const tablet_;
+  const KeyBounds* const key_bounds_;
   const MicrosTime compaction_start_time_;
 
   TransactionIdSet transactions_to_cleanup_;
@@ -103,8 +114,35 @@ rocksdb::FilterDecision DocDBIntentsCompactionFilter::Filter(
     filter_usage_logged_ = true;
   }
 
+  const auto key_type = GetKeyType(key, StorageDbType::kIntents);
+
+  // Remove intents and reverse index records, which are not related to this tablet anymore (due to
+  // split of the tablet). Reverse index record value is the key of the intent it refers to.
+  // Such records are ignored when transaction is applied, so they would never be removed
+  // otherwise.
+  if (key_bounds_ && key_bounds_->IsInitialized()) {
+    if (key_type == KeyType::kIntentKey && !IsRelatedIntent(key)) {
+      return rocksdb::FilterDecision::kDiscard;
+    }
+    if (key_type == KeyType::kReverseTxnKey) {
+      Slice intent_key = existing_value;
+      // Reverse index record of the last intent of a batch could be prefixed with the encoded set
+      // of replicated batches.
+      if (!intent_key.empty() && intent_key[0] == ValueTypeAsChar::kBitSet) {
+        intent_key.remove_prefix(1);
+        if (!OneWayBitmap::Skip(&intent_key).ok()) {
+          LOG(DFATAL) << "Bad reverse index value: " << existing_value.ToDebugHexString();
+          return rocksdb::FilterDecision::kKeep;
+        }
+      }
+      if (!IsRelatedIntent(intent_key)) {
+        return rocksdb::FilterDecision::kDiscard;
+      }
+    }
+  }
+
   // Find transaction metadata row.
-  if (GetKeyType(key, StorageDbType::kIntents) == KeyType::kTransactionMetadata) {
+  if (key_type == KeyType::kTransactionMetadata) {
     TransactionMetadataPB metadata_pb;
     if (!metadata_pb.ParseFromArray(existing_value.cdata(), existing_value.size())) {
       LOG(ERROR) << "Transaction metadata failed to parse.";
@@ -125,10 +163,6 @@ rocksdb::FilterDecision DocDBIntentsCompactionFilter::Filter(
     AddToSet(*result);
   }
 
-  // TODO(dtxn): If/when we add processing of reverse index or intents here - we will need to
-  // respect key_bounds passed to constructor in order to ignore/delete non-relevant keys. As of
-  // 2019/06/19, intents and reverse indexes are being deleted by docdb::PrepareApplyIntentsBatch.
-
   return rocksdb::FilterDecision::kKeep;
 }
 
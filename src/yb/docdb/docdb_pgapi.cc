@@ -14,6 +14,10 @@
 
 #include "yb/docdb/docdb_pgapi.h"
 
+#include <limits>
+#include <vector>
+
+#include "yb/util/format.h"
 #include "yb/util/status.h"
 #include "yb/common/ql_expr.h"
 #include "yb/yql/pggate/ybc_pg_typedefs.h"
@@ -82,10 +86,71 @@ const YBCPgTypeEntity* DocPgGetTypeEntity(YbgTypeDesc pg_type) {
     return Singleton<DocPgTypeAnalyzer>::get()->GetTypeEntity(pg_type.type_id);
 }
 
+namespace {
+
+// Evaluates the expression referencing var_refs columns, each column value is converted to its own
+// YSQL type. Attribute number of the column is its order in the schema.
+Status DocPgEvalExprWithVars(char* expr_cstring,
+                             const YBCPgTypeEntity* ret_type,
+                             const std::vector<DocPgVarRef>& var_refs,
+                             const QLTableRow& table_row,
+                             const Schema *schema,
+                             QLValue* result) {
+  struct VarValue {
+    int32_t attno;
+    const YBCPgTypeEntity* type;
+    YBCPgTypeAttrs type_attrs;
+    const QLValuePB* value;
+  };
+  std::vector<VarValue> var_values;
+  var_values.reserve(var_refs.size());
+  int32_t min_attno = std::numeric_limits<int32_t>::max();
+  int32_t max_attno = std::numeric_limits<int32_t>::min();
+  for (const auto& var_ref : var_refs) {
+    auto column = schema->column_by_id(var_ref.var_colid);
+    SCHECK(column.ok(), InternalError, "Invalid Schema");
+    const YBCPgTypeEntity* type = DocPgGetTypeEntity(var_ref.var_type);
+    SCHECK(type != nullptr, InvalidArgument,
+           Format("Unsupported type $0 of column $1", var_ref.var_type.type_id, column->name()));
+    const int32_t attno = column->order();
+    var_values.push_back(VarValue{attno, type, {var_ref.var_type.type_mod},
+                                  table_row.GetColumn(var_ref.var_colid.rep())});
+    min_attno = std::min(min_attno, attno);
+    max_attno = std::max(max_attno, attno);
+  }
+
+  YbgExprContext expr_ctx;
+  PG_RETURN_NOT_OK(YbgExprContextCreate(min_attno, max_attno, &expr_ctx));
+
+  for (const auto& var_value : var_values) {
+    bool is_null = true;
+    uint64_t datum = 0;
+    // Column that was never written is missing from the row, i.e. it is NULL.
+    if (var_value.value != nullptr) {
+      RETURN_NOT_OK(PgValueFromPB(
+          var_value.type, var_value.type_attrs, *var_value.value, &datum, &is_null));
+    }
+    PG_RETURN_NOT_OK(YbgExprContextAddColValue(expr_ctx, var_value.attno, datum, is_null));
+  }
+
+  bool is_null = false;
+  uint64_t datum;
+  PG_RETURN_NOT_OK(YbgEvalExpr(expr_cstring, expr_ctx, &datum, &is_null));
+
+  RETURN_NOT_OK(PgValueToPB(ret_type, datum, is_null, result));
+
+  PG_RETURN_NOT_OK(YbgResetMemoryContext());
+
+  return Status::OK();
+}
+
+} // namespace
+
 Status DocPgEvalExpr(const std::string& expr_str,
                      int32_t col_attrno,
                      int32_t ret_typeid,
                      int32_t ret_typemod,
+                     const std::vector<DocPgVarRef>& var_refs,
                      const QLTableRow& table_row,
                      const Schema *schema,
                      QLValue* result) {
@@ -96,6 +161,10 @@ Status DocPgEvalExpr(const std::string& expr_str,
   const YBCPgTypeEntity *ret_type = DocPgGetTypeEntity(pg_type);
   YBCPgTypeAttrs type_attrs = { pg_type.type_mod };
 
+  if (!var_refs.empty()) {
+    return DocPgEvalExprWithVars(expr_cstring, ret_type, var_refs, table_row, schema, result);
+  }
+
   // Create the context expression evaluation.
   // Since we currently only allow referencing the target col just set min/max attr to col_attno.
   // TODO Eventually this context should be created once per row and contain all (referenced)
@@ -16,7 +16,7 @@
 // Analogous to YCQL this should be used for write expressions (e.g. SET clause), filtering
 // (e.g. WHERE clause), expression projections (e.g. SELECT targets) etc.
 // Currently it just supports evaluating an YSQL expressions into a QLValues and is only used
-// for the UPDATE .. SET clause.
+// for the UPDATE .. SET clause and the WHERE clause of sequential scans.
 //
 // The implementation for these should typically call (and/or extend) either the PG/YSQL C API
 // from pgapi.h or  directly the pggate C++ API.
@@ -42,10 +42,20 @@ const YBCPgTypeEntity* DocPgGetTypeEntity(YbgTypeDesc pg_type);
 // Expressions/Values
 //-----------------------------------------------------------------------------
 
+// Column referenced by an YSQL expression along with its YSQL type, since the DocDB schema only
+// has the YQL types.
+struct DocPgVarRef {
+  ColumnId var_colid;
+  YbgTypeDesc var_type;
+};
+
+// Evaluates an YSQL expression against the table row. When var_refs is empty, the only column
+// referenced by the expression is col_attrno, and it has the same type as the result.
 Status DocPgEvalExpr(const std::string& expr_str,
                      int32_t col_attrno,
                      int32_t ret_typeid,
                      int32_t ret_typemod,
+                     const std::vector<DocPgVarRef>& var_refs,
                      const QLTableRow& table_row,
                      const Schema *schema,
                      QLValue* result);
@@ -16,6 +16,7 @@
 #include <thread>
 #include <memory>
 
+#include "yb/common/doc_hybrid_time.h"
 #include "yb/common/transaction.h"
 
 #include "yb/rocksdb/memtablerep.h"
@@ -30,13 +31,16 @@
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 #include "yb/gutil/sysinfo.h"
 
@@ -86,19 +90,44 @@ DEFINE_int64(db_index_block_size_bytes, 32_KB,
 DEFINE_int64(db_min_keys_per_index_block, 100,
              "Minimum number of keys per index block.");
 
+DEFINE_uint64(db_max_auto_readahead_size_bytes, 2_MB,
+              "Maximum size of readahead done by iterators that read SST data blocks "
+              "sequentially. 0 to disable readahead.");
+
 DEFINE_int64(db_write_buffer_size, -1,
              "Size of RocksDB write buffer (in bytes). -1 to use default.");
 
 DEFINE_int32(memstore_size_mb, 128,
              "Max size (in mb) of the memstore, before needing to flush.");
 
+DEFINE_int32(memstore_bloom_filter_size_kb, 0,
+             "Size (in kb) of bloom filter of DocDB keys, that is allocated for each memstore. "
+             "Point reads of keys, that are not in the memstore, skip it. 0 to disable.");
+TAG_FLAG(memstore_bloom_filter_size_kb, advanced);
+
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
+DEFINE_bool(use_read_time_file_filter, true,
+            "Whether reads should skip SST files, that contain only records written after the "
+            "read time limit, using hybrid time range of the file.");
+TAG_FLAG(use_read_time_file_filter, advanced);
+TAG_FLAG(use_read_time_file_filter, runtime);
+DEFINE_int32(max_prevs_to_avoid_seek, 4,
+             "The number of prev calls to try before resorting to a rocksdb seek, when iterator "
+             "is moved backward.");
 DEFINE_bool(trace_docdb_calls, false, "Whether we should trace calls into the docdb.");
 DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.");
+DEFINE_bool(use_docdb_aware_data_block_encoding, false,
+            "Whether to delta encode DocHybridTime of keys in data blocks separately from "
+            "the rest of the key. SST files written with this option cannot be read by older "
+            "versions.");
+DEFINE_bool(use_docdb_aware_data_block_hash_index, false,
+            "Whether to add hash index by DocKey to data blocks, so point seeks don't need binary "
+            "search inside the block. SST files written with this option cannot be read by older "
+            "versions.");
 
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
@@ -107,6 +136,23 @@ DEFINE_int32(num_reserved_small_compaction_threads, -1, "Number of reserved smal
 
 DEFINE_bool(enable_ondisk_compression, true,
             "Determines whether SSTable compression is enabled or not.");
+DEFINE_bool(rocksdb_use_lz4_compression, false,
+            "Use LZ4 instead of Snappy to compress SSTables, when on-disk compression is enabled.");
+DEFINE_uint64(rocksdb_large_compaction_zstd_threshold_bytes, 0,
+              "Compactions with at least this total input size compress output files with ZSTD, "
+              "when on-disk compression is enabled. 0 means that ZSTD is not used.");
+DEFINE_int32(rocksdb_compression_dict_max_bytes, 0,
+             "Max size of dictionary sampled from compaction input and used to compress data "
+             "blocks of files compressed with ZSTD. 0 means that dictionary is not used.");
+DEFINE_int32(rocksdb_compression_dict_max_train_bytes, 0,
+             "Max size of samples used to train ZSTD dictionary. 0 means that raw samples are "
+             "used as the dictionary.");
+
+DEFINE_uint64(rocksdb_parallel_memtable_insert_part_size, 0,
+              "Write batch with at least twice this number of updates is split into parts, that "
+              "are inserted into memtable in parallel. 0 disables parallel memtable inserts.");
+DEFINE_int32(rocksdb_memtable_insert_threads, 4,
+             "Max number of threads used for parallel memtable inserts of large write batches.");
 
 DEFINE_int32(priority_thread_pool_size, -1,
              "Max running workers in compaction thread pool. "
@@ -122,6 +168,8 @@ namespace yb {
 namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
+std::shared_ptr<rocksdb::ReadFileFilter> CreateReadTimeFileFilter(
+    HybridTime max_ht, std::shared_ptr<rocksdb::ReadFileFilter> filter);
 
 void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter) {
   if (!iter->Valid() || iter->key().compare(slice) >= 0) {
@@ -151,6 +199,43 @@ void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter) {
   key_bytes->RemoveValueTypeSuffix(ValueType::kMaxByte);
 }
 
+bool PrevBefore(const rocksdb::Slice& key, rocksdb::Iterator* iter) {
+  if (!iter->Valid()) {
+    return false;
+  }
+  for (int prevs = FLAGS_max_prevs_to_avoid_seek;;) {
+    if (iter->key().compare(key) < 0) {
+      return true;
+    }
+    if (prevs-- <= 0) {
+      return false;
+    }
+    VLOG(4) << "Skipping backward: " << SubDocKey::DebugSliceToString(iter->key());
+    iter->Prev();
+    if (!iter->Valid()) {
+      // There are no keys before key.
+      return true;
+    }
+  }
+}
+
+void SeekBackward(const rocksdb::Slice& key, rocksdb::Iterator* iter) {
+  // When the iterator is positioned before key, we don't know whether it is the last key before
+  // it, so have to perform a seek.
+  if (iter->Valid() && iter->key().compare(key) >= 0 && PrevBefore(key, iter)) {
+    if (FLAGS_trace_docdb_calls) {
+      TRACE("Did Prev(s) instead of a backward Seek");
+    }
+    return;
+  }
+  ROCKSDB_SEEK(iter, key);
+  if (iter->Valid()) {
+    iter->Prev();
+  } else {
+    iter->SeekToLast();
+  }
+}
+
 void SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key,
                            int* next_count, int* seek_count) {
   for (int nexts = FLAGS_max_nexts_to_avoid_seek; nexts-- > 0;) {
@@ -230,6 +315,19 @@ rocksdb::ReadOptions PrepareReadOptions(
   return read_opts;
 }
 
+// Records written after the global limit are neither visible to the read, nor could require read
+// restart, so files that contain only such records don't have to be read.
+void AddReadTimeFileFilter(const ReadHybridTime& read_time, rocksdb::ReadOptions* read_opts) {
+  if (!FLAGS_use_read_time_file_filter) {
+    return;
+  }
+  auto max_ht = std::max(read_time.read, read_time.global_limit);
+  if (!max_ht.is_valid() || max_ht == HybridTime::kMax) {
+    return;
+  }
+  read_opts->file_filter = CreateReadTimeFileFilter(max_ht, std::move(read_opts->file_filter));
+}
+
 } // namespace
 
 BoundedRocksDbIterator CreateRocksDBIterator(
@@ -254,10 +352,31 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
-    const Slice* iterate_upper_bound) {
+    const Slice* iterate_upper_bound,
+    const KeyBounds* scan_bounds) {
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+  AddReadTimeFileFilter(read_time, &read_opts);
+  return std::make_unique<IntentAwareIterator>(
+      doc_db, read_opts, deadline, read_time, txn_op_context, scan_bounds);
+}
+
+unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
+    const DocDB& doc_db,
+    const std::vector<Slice>& user_keys_for_filter,
+    const rocksdb::QueryId query_id,
+    const TransactionOperationContextOpt& txn_op_context,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time) {
+  rocksdb::ReadOptions read_opts = PrepareReadOptions(
+      doc_db.regular, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none /* user_key_for_filter */,
+      query_id, nullptr /* file_filter */, nullptr /* iterate_upper_bound */);
+  if (FLAGS_use_docdb_aware_bloom_filter && !user_keys_for_filter.empty()) {
+    read_opts.table_aware_file_filter = doc_db.regular->GetOptions().table_factory->
+        NewTableAwareReadFileFilter(read_opts, user_keys_for_filter);
+  }
+  AddReadTimeFileFilter(read_time, &read_opts);
   return std::make_unique<IntentAwareIterator>(
       doc_db, read_opts, deadline, read_time, txn_op_context);
 }
@@ -359,6 +478,42 @@ class HybridTimeFilteringIterator : public rocksdb::FilteringIterator {
   HybridTime hybrid_time_filter_;
 };
 
+// Splits DocDB key into encoded DocHybridTime and the rest of the key, so that keys in data
+// blocks are delta encoded against both parts of the previous key.
+class DocHybridTimeSuffixExtractor : public rocksdb::KeySuffixExtractor {
+ public:
+  const char* Name() const override {
+    return "DocHybridTimeSuffixExtractor";
+  }
+
+  size_t SuffixSize(const Slice& user_key) const override {
+    int encoded_ht_size = 0;
+    // Some keys, e.g. transaction metadata in intents DB, do not have hybrid time at the end.
+    if (!DocHybridTime::CheckAndGetEncodedSize(user_key, &encoded_ht_size).ok()) {
+      return 0;
+    }
+    return encoded_ht_size;
+  }
+};
+
+// Uses DocKey of DocDB key as a key of data block hash index, so seeks to the document go
+// directly to the restart interval containing it.
+class DocKeyDataBlockHashKeyExtractor : public rocksdb::DataBlockHashKeyExtractor {
+ public:
+  const char* Name() const override {
+    return "DocKeyDataBlockHashKeyExtractor";
+  }
+
+  Slice HashKey(const Slice& user_key) const override {
+    // Keys that are not DocKeys, e.g. transaction metadata in intents DB, are not indexed.
+    auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+    if (!doc_key_size.ok()) {
+      return Slice();
+    }
+    return Slice(user_key.data(), *doc_key_size);
+  }
+};
+
 template <class T, class... Args>
 T* CreateOnArena(rocksdb::Arena* arena, Args&&... args) {
   if (!arena) {
@@ -407,12 +562,43 @@ void InitRocksDBOptions(
   options->priority_thread_pool_for_compactions_and_flushes =
       &priority_thread_pool_for_compactions_and_flushes;
 
+  if (FLAGS_rocksdb_parallel_memtable_insert_part_size > 0) {
+    // The pool is shared by all RocksDB instances, like the priority thread pool.
+    static auto memtable_insert_thread_pool = [] {
+      std::unique_ptr<ThreadPool> result;
+      CHECK_OK(ThreadPoolBuilder("memtable_insert")
+                   .set_max_threads(FLAGS_rocksdb_memtable_insert_threads)
+                   .Build(&result));
+      return result;
+    }();
+    options->allow_concurrent_memtable_write = true;
+    options->enable_write_thread_adaptive_yield = true;
+    options->parallel_memtable_insert_part_size = FLAGS_rocksdb_parallel_memtable_insert_part_size;
+    options->memtable_insert_thread_pool = memtable_insert_thread_pool.get();
+  }
+
   if (FLAGS_num_reserved_small_compaction_threads != -1) {
     options->num_reserved_small_compaction_threads = FLAGS_num_reserved_small_compaction_threads;
   }
 
   options->compression = rocksdb::Snappy_Supported() && FLAGS_enable_ondisk_compression
       ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  if (FLAGS_enable_ondisk_compression) {
+    if (FLAGS_rocksdb_use_lz4_compression && rocksdb::LZ4_Supported()) {
+      options->compression = rocksdb::kLZ4Compression;
+    }
+    // Files produced by large compactions live for a long time and are read a lot, so they are
+    // compressed with slower ZSTD, that has better compression ratio.
+    if (FLAGS_rocksdb_large_compaction_zstd_threshold_bytes > 0 && rocksdb::ZSTD_Supported()) {
+      options->large_compaction_compression = rocksdb::kZSTDNotFinalCompression;
+      options->large_compaction_compression_threshold =
+          FLAGS_rocksdb_large_compaction_zstd_threshold_bytes;
+      options->compression_opts.max_dict_bytes =
+          static_cast<uint32_t>(std::max(FLAGS_rocksdb_compression_dict_max_bytes, 0));
+      options->compression_opts.zstd_max_train_bytes =
+          static_cast<uint32_t>(std::max(FLAGS_rocksdb_compression_dict_max_train_bytes, 0));
+    }
+  }
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -422,16 +608,20 @@ void InitRocksDBOptions(
   rocksdb::BlockBasedTableOptions table_options;
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.index_and_filter_block_cache = tablet_options.index_and_filter_block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
   }
+  table_options.persistent_cache = tablet_options.persistent_cache;
+  options->table_cache = tablet_options.table_cache;
   table_options.block_size = FLAGS_db_block_size_bytes;
   table_options.filter_block_size = FLAGS_db_filter_block_size_bytes;
   table_options.index_block_size = FLAGS_db_index_block_size_bytes;
   table_options.min_keys_per_index_block = FLAGS_db_min_keys_per_index_block;
+  table_options.max_auto_readahead_size = FLAGS_db_max_auto_readahead_size_bytes;
 
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
@@ -451,6 +641,17 @@ void InitRocksDBOptions(
     table_options.index_type = rocksdb::IndexType::kBinarySearch;
   }
 
+  if (FLAGS_use_docdb_aware_data_block_encoding) {
+    table_options.data_block_key_value_encoding_format =
+        rocksdb::KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix;
+    table_options.data_block_key_suffix_extractor =
+        std::make_shared<DocHybridTimeSuffixExtractor>();
+  }
+  if (FLAGS_use_docdb_aware_data_block_hash_index) {
+    table_options.data_block_hash_key_extractor =
+        std::make_shared<DocKeyDataBlockHashKeyExtractor>();
+  }
+
   options->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
 
   // Compaction related options.
@@ -498,6 +699,9 @@ void InitRocksDBOptions(
 
   options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
       0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  // Keys added to the memtable bloom filter are transformed by the key transformer of DocDB aware
+  // filter policy, like keys added to bloom filters of SST files.
+  options->memtable_prefix_bloom_bits = std::max(FLAGS_memstore_bloom_filter_size_kb, 0) * 8_KB;
 
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 }
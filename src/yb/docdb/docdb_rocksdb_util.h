@@ -54,6 +54,15 @@ void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter);
 
 KeyBytes AppendDocHt(const Slice& key, const DocHybridTime& doc_ht);
 
+// Tries to move the iterator before the given key using up to max_prevs_to_avoid_seek Prev()
+// calls. Returns true if the iterator is positioned before the key, or is invalid because there
+// are no keys before it. Does nothing and returns false for an invalid iterator.
+bool PrevBefore(const rocksdb::Slice& key, rocksdb::Iterator* iter);
+
+// Positions the iterator at the last key before the given key. If the iterator is positioned
+// slightly after it, uses Prev() instead of a seek.
+void SeekBackward(const rocksdb::Slice& key, rocksdb::Iterator* iter);
+
 // A wrapper around the RocksDB seek operation that uses Next() up to the configured number of
 // times to avoid invalidating iterator state. In debug mode it also allows printing detailed
 // information about RocksDB seeks.
@@ -100,7 +109,18 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
-    const Slice* iterate_upper_bound = nullptr);
+    const Slice* iterate_upper_bound = nullptr,
+    const KeyBounds* scan_bounds = nullptr);
+
+// Creates intent aware iterator for looking up several keys in ascending order. Regular DB SST files
+// whose bloom filters do not match any of user_keys_for_filter are not read by the iterator.
+std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
+    const DocDB& doc_db,
+    const std::vector<Slice>& user_keys_for_filter,
+    const rocksdb::QueryId query_id,
+    const TransactionOperationContextOpt& transaction_context,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time);
 
 // Request RocksDB compaction and wait until it completes.
 void ForceRocksDBCompact(rocksdb::DB* db);
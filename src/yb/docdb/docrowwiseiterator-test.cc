@@ -18,6 +18,8 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/transaction-test-util.h"
 
+#include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/doc_row_cache.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_debug.h"
@@ -25,6 +27,7 @@
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/packed_row.h"
 
 #include "yb/server/hybrid_clock.h"
 
@@ -796,6 +799,293 @@ SubDocKey(DocKey([], ["row1", 11111]), [ColumnId(50); HT{ physical: 1000 w: 1 }]
   }
 }
 
+// Scans with IN condition on the second range column only, that are done with skip scan.
+TEST_F(DocRowwiseIteratorTest, SkipScanOverLeadingRangeColumn) {
+  const Schema schema({
+      ColumnSchema("h", DataType::INT64, false, true /* is_hash_key */),
+      ColumnSchema("r1", DataType::INT64, false),
+      ColumnSchema("r2", DataType::INT64, false),
+      ColumnSchema("v", DataType::INT64, true),
+  }, { 10_ColId, 20_ColId, 30_ColId, 40_ColId }, 3);
+  Schema projection;
+  ASSERT_OK(schema.CreateProjectionByNames({"v"}, &projection));
+
+  constexpr DocKeyHash kHash = 0x1234;
+  constexpr int kNumValues = 10;
+  const std::vector<PrimitiveValue> hashed_components = { PrimitiveValue(1) };
+  auto dwb = MakeDocWriteBatch();
+  for (int r1 = 0; r1 != kNumValues; ++r1) {
+    for (int r2 = 0; r2 != kNumValues; ++r2) {
+      DocKey doc_key(kHash, hashed_components, { PrimitiveValue(r1), PrimitiveValue(r2) });
+      ASSERT_OK(dwb.SetPrimitive(DocPath(doc_key.Encode(), PrimitiveValue(40_ColId)),
+                                 PrimitiveValue(r1 * kNumValues + r2)));
+    }
+  }
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(1000)));
+
+  auto add_condition = [](QLConditionPB* condition, ColumnId column_id, QLOperator op) {
+    auto* result = condition->add_operands()->mutable_condition();
+    result->set_op(op);
+    result->add_operands()->set_column_id(column_id.rep());
+    return result->add_operands()->mutable_value();
+  };
+
+  // Returns values of the rows found by the scan.
+  auto scan = [&](const QLConditionPB& condition, bool is_forward_scan)
+      -> Result<std::vector<int64_t>> {
+    DocQLScanSpec spec(
+        schema, kHash, kHash, hashed_components, &condition, nullptr /* if_req */,
+        rocksdb::kDefaultQueryId, is_forward_scan);
+    DocRowwiseIterator iter(
+        projection, schema, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+    RETURN_NOT_OK(iter.Init(spec));
+    std::vector<int64_t> result;
+    QLTableRow row;
+    QLValue value;
+    while (VERIFY_RESULT(iter.HasNext())) {
+      RETURN_NOT_OK(iter.NextRow(&row));
+      RETURN_NOT_OK(row.GetValue(projection.column_id(0), &value));
+      result.push_back(value.int64_value());
+    }
+    return result;
+  };
+
+  // r2 IN (3, 7)
+  QLConditionPB condition;
+  condition.set_op(QL_OP_AND);
+  auto* in_list = add_condition(&condition, 30_ColId, QL_OP_IN)->mutable_list_value();
+  in_list->add_elems()->set_int64_value(3);
+  in_list->add_elems()->set_int64_value(7);
+
+  std::vector<int64_t> expected;
+  for (int r1 = 0; r1 != kNumValues; ++r1) {
+    expected.push_back(r1 * kNumValues + 3);
+    expected.push_back(r1 * kNumValues + 7);
+  }
+  ASSERT_EQ(expected, ASSERT_RESULT(scan(condition, /* is_forward_scan= */ true)));
+  std::reverse(expected.begin(), expected.end());
+  ASSERT_EQ(expected, ASSERT_RESULT(scan(condition, /* is_forward_scan= */ false)));
+
+  // r1 >= 2 AND r1 <= 4 AND r2 IN (3, 7)
+  add_condition(&condition, 20_ColId, QL_OP_GREATER_THAN_EQUAL)->set_int64_value(2);
+  add_condition(&condition, 20_ColId, QL_OP_LESS_THAN_EQUAL)->set_int64_value(4);
+  expected = { 23, 27, 33, 37, 43, 47 };
+  ASSERT_EQ(expected, ASSERT_RESULT(scan(condition, /* is_forward_scan= */ true)));
+  std::reverse(expected.begin(), expected.end());
+  ASSERT_EQ(expected, ASSERT_RESULT(scan(condition, /* is_forward_scan= */ false)));
+}
+
+// Point reads served from the row cache, until the row is invalidated.
+TEST_F(DocRowwiseIteratorTest, RowCache) {
+  DocRowCache row_cache;
+  auto cached_doc_db = doc_db();
+  cached_doc_db.row_cache = &row_cache;
+
+  auto set_c = [this](const std::string& value, HybridTime hybrid_time)
+      -> Result<KeyValueWriteBatchPB> {
+    auto dwb = MakeDocWriteBatch();
+    RETURN_NOT_OK(dwb.SetPrimitive(
+        DocPath(kEncodedDocKey1, PrimitiveValue(30_ColId)), PrimitiveValue(value)));
+    KeyValueWriteBatchPB put_batch;
+    dwb.TEST_CopyToWriteBatchPB(&put_batch);
+    RETURN_NOT_OK(WriteToRocksDBAndClear(&dwb, hybrid_time));
+    return put_batch;
+  };
+
+  auto read_c = [&](HybridTime read_time) -> Result<std::string> {
+    DocQLScanSpec spec(kSchemaForIteratorTests, DocKey(PrimitiveValues("row1", 11111)),
+                       rocksdb::kDefaultQueryId);
+    DocRowwiseIterator iter(
+        kProjectionForIteratorTests, kSchemaForIteratorTests, kNonTransactionalOperationContext,
+        cached_doc_db, CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::SingleTime(read_time));
+    RETURN_NOT_OK(iter.Init(spec));
+    SCHECK(VERIFY_RESULT(iter.HasNext()), IllegalState, "Row not found");
+    QLTableRow row;
+    QLValue value;
+    RETURN_NOT_OK(iter.NextRow(&row));
+    RETURN_NOT_OK(row.GetValue(30_ColId, &value));
+    SCHECK(!VERIFY_RESULT(iter.HasNext()), IllegalState, "Extra row found");
+    return value.string_value();
+  };
+
+  ASSERT_OK(set_c("v1", 1000_usec_ht));
+  ASSERT_EQ("v1", ASSERT_RESULT(read_c(2000_usec_ht)));
+
+  // The row is written without invalidating the cache, so later reads are served from the cache,
+  // while earlier reads are not.
+  auto put_batch = ASSERT_RESULT(set_c("v2", 1500_usec_ht));
+  ASSERT_EQ("v1", ASSERT_RESULT(read_c(2500_usec_ht)));
+  ASSERT_EQ("v2", ASSERT_RESULT(read_c(1800_usec_ht)));
+
+  row_cache.InvalidateDocuments(put_batch, 1500_usec_ht);
+  ASSERT_EQ("v2", ASSERT_RESULT(read_c(2500_usec_ht)));
+
+  // The row was read before the invalidated write, so it is not cached.
+  row_cache.InvalidateDocuments(ASSERT_RESULT(set_c("v3", 3000_usec_ht)), 3000_usec_ht);
+  ASSERT_EQ("v2", ASSERT_RESULT(read_c(2800_usec_ht)));
+  ASSERT_EQ("v3", ASSERT_RESULT(read_c(3500_usec_ht)));
+  ASSERT_EQ("v2", ASSERT_RESULT(read_c(2800_usec_ht)));
+}
+
+namespace {
+
+// Reports intents of running transactions only within the specified doc key range.
+class KeyRangeTransactionStatusManagerMock : public TransactionStatusManagerMock {
+ public:
+  explicit KeyRangeTransactionStatusManagerMock(DocKeyRange range) : range_(std::move(range)) {}
+
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const override {
+    return range_.Overlaps(lower_bound, upper_bound);
+  }
+
+ private:
+  DocKeyRange range_;
+};
+
+} // namespace
+
+// Point reads only see intents when their doc key lies within the range of doc keys reported by
+// the transaction status manager. The range deliberately does not always contain the written
+// intent, so it is observable whether the intents DB was read.
+TEST_F(DocRowwiseIteratorTest, IntentsKeyRange) {
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row1_c"), HybridTime::FromMicros(1000)));
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey2, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row2_c"), HybridTime::FromMicros(1000)));
+
+  auto txn_id = TransactionId::GenerateRandom();
+  SetCurrentTransactionId(txn_id);
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey2, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row2_c_t1"), HybridTime::FromMicros(1500)));
+  ResetCurrentTransactionId();
+
+  auto read_c = [this, txn_id](const DocKeyRange& intents_range, const DocKey& doc_key)
+      -> Result<std::string> {
+    KeyRangeTransactionStatusManagerMock txn_status_manager(intents_range);
+    txn_status_manager.Commit(txn_id, HybridTime::FromMicros(1600));
+    const auto txn_context = TransactionOperationContext(
+        TransactionId::GenerateRandom(), &txn_status_manager);
+    DocQLScanSpec spec(kSchemaForIteratorTests, doc_key, rocksdb::kDefaultQueryId);
+    DocRowwiseIterator iter(
+        kProjectionForIteratorTests, kSchemaForIteratorTests, txn_context, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+    RETURN_NOT_OK(iter.Init(spec));
+    SCHECK(VERIFY_RESULT(iter.HasNext()), IllegalState, "Row not found");
+    QLTableRow row;
+    QLValue value;
+    RETURN_NOT_OK(iter.NextRow(&row));
+    RETURN_NOT_OK(row.GetValue(30_ColId, &value));
+    SCHECK(!VERIFY_RESULT(iter.HasNext()), IllegalState, "Extra row found");
+    return value.string_value();
+  };
+
+  const DocKey doc_key1(PrimitiveValues("row1", 11111));
+  const DocKey doc_key2(PrimitiveValues("row2", 22222));
+
+  DocKeyRange range_with_intents;
+  range_with_intents.Expand(kEncodedDocKey2.AsSlice(), kEncodedDocKey2.AsSlice());
+  ASSERT_EQ("row1_c", ASSERT_RESULT(read_c(range_with_intents, doc_key1)));
+  ASSERT_EQ("row2_c_t1", ASSERT_RESULT(read_c(range_with_intents, doc_key2)));
+  ASSERT_EQ("row2_c_t1", ASSERT_RESULT(read_c(DocKeyRange::Unbounded(), doc_key2)));
+
+  DocKeyRange range_without_intents;
+  range_without_intents.Expand(kEncodedDocKey1.AsSlice(), kEncodedDocKey1.AsSlice());
+  ASSERT_EQ("row1_c", ASSERT_RESULT(read_c(range_without_intents, doc_key1)));
+  ASSERT_EQ("row2_c", ASSERT_RESULT(read_c(range_without_intents, doc_key2)));
+  ASSERT_EQ("row2_c", ASSERT_RESULT(read_c(DocKeyRange(), doc_key2)));
+}
+
+// Backward scan over rows with multiple versions, records written after the read time and
+// provisional records of committed transactions.
+TEST_F(DocRowwiseIteratorTest, BackwardScanWithIntents) {
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+  TransactionStatusManagerMock txn_status_manager;
+
+  const Schema schema({
+      ColumnSchema("h", DataType::INT64, false, true /* is_hash_key */),
+      ColumnSchema("r", DataType::INT64, false),
+      ColumnSchema("v1", DataType::INT64, true),
+      ColumnSchema("v2", DataType::INT64, true),
+  }, { 10_ColId, 20_ColId, 30_ColId, 40_ColId }, 2);
+  Schema projection;
+  ASSERT_OK(schema.CreateProjectionByNames({"r", "v1", "v2"}, &projection));
+
+  constexpr DocKeyHash kHash = 0x1234;
+  constexpr int kNumRows = 20;
+  const std::vector<PrimitiveValue> hashed_components = { PrimitiveValue(1) };
+  auto doc_path = [&](int r, ColumnId column_id) {
+    return DocPath(
+        DocKey(kHash, hashed_components, { PrimitiveValue(r) }).Encode(),
+        PrimitiveValue(column_id));
+  };
+
+  // Values of r, v1 and v2.
+  using Row = std::tuple<int64_t, int64_t, int64_t>;
+  std::vector<Row> expected;
+  for (int r = 0; r != kNumRows; ++r) {
+    ASSERT_OK(SetPrimitive(doc_path(r, 30_ColId), PrimitiveValue(r), HybridTime::FromMicros(1000)));
+    ASSERT_OK(SetPrimitive(
+        doc_path(r, 40_ColId), PrimitiveValue(r * 10), HybridTime::FromMicros(1000)));
+    int64_t v1 = r;
+    int64_t v2 = r * 10;
+    if (r % 2 == 0) {
+      v1 = r + 100;
+      ASSERT_OK(SetPrimitive(
+          doc_path(r, 30_ColId), PrimitiveValue(v1), HybridTime::FromMicros(1500)));
+    }
+    if (r % 3 == 0) {
+      // Written after the read time, so should not be visible.
+      ASSERT_OK(SetPrimitive(
+          doc_path(r, 40_ColId), PrimitiveValue(r + 300), HybridTime::FromMicros(3000)));
+    }
+    if (r % 5 == 0) {
+      auto txn_id = TransactionId::GenerateRandom();
+      SetCurrentTransactionId(txn_id);
+      v2 = r + 500;
+      ASSERT_OK(SetPrimitive(
+          doc_path(r, 40_ColId), PrimitiveValue(v2), HybridTime::FromMicros(1200)));
+      ResetCurrentTransactionId();
+      txn_status_manager.Commit(txn_id, HybridTime::FromMicros(1300));
+    }
+    expected.emplace_back(r, v1, v2);
+  }
+
+  const auto txn_context = TransactionOperationContext(
+      TransactionId::GenerateRandom(), &txn_status_manager);
+  auto scan = [&](bool is_forward_scan) -> Result<std::vector<Row>> {
+    DocQLScanSpec spec(
+        schema, kHash, kHash, hashed_components, nullptr /* req */, nullptr /* if_req */,
+        rocksdb::kDefaultQueryId, is_forward_scan);
+    DocRowwiseIterator iter(
+        projection, schema, txn_context, doc_db(), CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::FromMicros(2000));
+    RETURN_NOT_OK(iter.Init(spec));
+    std::vector<Row> result;
+    QLTableRow row;
+    std::array<QLValue, 3> values;
+    while (VERIFY_RESULT(iter.HasNext())) {
+      RETURN_NOT_OK(iter.NextRow(&row));
+      for (size_t i = 0; i != values.size(); ++i) {
+        RETURN_NOT_OK(row.GetValue(projection.column_id(i), &values[i]));
+      }
+      result.emplace_back(
+          values[0].int64_value(), values[1].int64_value(), values[2].int64_value());
+    }
+    return result;
+  };
+
+  ASSERT_EQ(expected, ASSERT_RESULT(scan(/* is_forward_scan= */ true)));
+  std::reverse(expected.begin(), expected.end());
+  ASSERT_EQ(expected, ASSERT_RESULT(scan(/* is_forward_scan= */ false)));
+}
+
 TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorResolveWriteIntents) {
   SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
 
@@ -1224,5 +1514,211 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
   ASSERT_EQ(intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK), 6);
 }
 
+TEST_F(DocRowwiseIteratorTest, NextRowBatch) {
+  constexpr int kNumRows = 10;
+  for (int i = 0; i != kNumRows; ++i) {
+    const KeyBytes encoded_doc_key(DocKey(PrimitiveValues(Format("row$0", i), i)).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(40_ColId)),
+        PrimitiveValue(i * 10), HybridTime::FromMicros(1000)));
+  }
+
+  const Schema &projection = kProjectionForIteratorTests;
+  DocRowwiseIterator iter(
+      projection, kSchemaForIteratorTests, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.Init());
+
+  std::vector<QLTableRow> rows;
+  QLValue value;
+  int next_row = 0;
+  for (;;) {
+    // Use a batch size that does not divide the number of rows to check the partial last batch.
+    const size_t num_rows = ASSERT_RESULT(iter.NextRowBatch(projection, 3, &rows));
+    ASSERT_LE(num_rows, 3);
+    for (size_t i = 0; i != num_rows; ++i, ++next_row) {
+      ASSERT_OK(rows[i].GetValue(projection.column_id(0), &value));
+      ASSERT_TRUE(value.IsNull());
+      ASSERT_OK(rows[i].GetValue(projection.column_id(1), &value));
+      ASSERT_EQ(next_row * 10, value.int64_value());
+      ASSERT_OK(rows[i].GetValue(kSchemaForIteratorTests.column_id(0), &value));
+      ASSERT_EQ(Format("row$0", next_row), value.string_value());
+    }
+    if (num_rows < 3) {
+      break;
+    }
+  }
+  ASSERT_EQ(kNumRows, next_row);
+  ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
+}
+
+TEST_F(DocRowwiseIteratorTest, NextRowBatchReusesKeyColumns) {
+  constexpr int kNumGroups = 2;
+  constexpr int kRowsPerGroup = 5;
+  for (int group = 0; group != kNumGroups; ++group) {
+    for (int i = 0; i != kRowsPerGroup; ++i) {
+      const KeyBytes encoded_doc_key(
+          DocKey(PrimitiveValues(Format("group$0", group), i)).Encode());
+      // Only every other row has column d, so values of reused rows must not leak between rows.
+      if (i % 2 == 0) {
+        ASSERT_OK(SetPrimitive(
+            DocPath(encoded_doc_key, PrimitiveValue(40_ColId)),
+            PrimitiveValue(group * 100 + i), HybridTime::FromMicros(1000)));
+      }
+      ASSERT_OK(SetPrimitive(
+          DocPath(encoded_doc_key, PrimitiveValue(50_ColId)),
+          PrimitiveValue(Format("e$0_$1", group, i)), HybridTime::FromMicros(1000)));
+    }
+  }
+
+  const Schema &projection = kProjectionForIteratorTests;
+  const auto read_rows = [this, &projection](size_t batch_size, std::vector<QLTableRow>* result)
+      -> Result<size_t> {
+    DocRowwiseIterator iter(
+        projection, kSchemaForIteratorTests, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+    RETURN_NOT_OK(iter.Init());
+    std::vector<QLTableRow> rows;
+    for (;;) {
+      size_t num_rows = 0;
+      if (batch_size == 1) {
+        rows.resize(1);
+        rows[0].Clear();
+        if (VERIFY_RESULT(iter.HasNext())) {
+          RETURN_NOT_OK(iter.NextRow(projection, &rows[0]));
+          num_rows = 1;
+        }
+      } else {
+        num_rows = VERIFY_RESULT(iter.NextRowBatch(projection, batch_size, &rows));
+      }
+      result->insert(result->end(), rows.begin(), rows.begin() + num_rows);
+      if (num_rows < batch_size) {
+        break;
+      }
+    }
+    return iter.num_converted_key_columns();
+  };
+
+  std::vector<QLTableRow> expected_rows;
+  const auto row_by_row_conversions = ASSERT_RESULT(read_rows(1, &expected_rows));
+  // Both key columns are converted for every row.
+  ASSERT_EQ(kNumGroups * kRowsPerGroup * 2, row_by_row_conversions);
+
+  std::vector<QLTableRow> batched_rows;
+  const auto batched_conversions = ASSERT_RESULT(read_rows(4, &batched_rows));
+  // Column a is only converted for the first row of a batch and for the first row of a group.
+  // Batches start at rows 0, 4 and 8, groups start at rows 0 and 5.
+  ASSERT_EQ(kNumGroups * kRowsPerGroup + 4, batched_conversions);
+  ASSERT_LT(batched_conversions, row_by_row_conversions);
+
+  ASSERT_EQ(expected_rows.size(), batched_rows.size());
+  ASSERT_EQ(kNumGroups * kRowsPerGroup, batched_rows.size());
+  for (size_t i = 0; i != batched_rows.size(); ++i) {
+    SCOPED_TRACE(Format("Row $0", i));
+    ASSERT_EQ(expected_rows[i].ToString(), batched_rows[i].ToString());
+    const int group = static_cast<int>(i) / kRowsPerGroup;
+    const int idx = static_cast<int>(i) % kRowsPerGroup;
+    QLValue value;
+    ASSERT_OK(batched_rows[i].GetValue(kSchemaForIteratorTests.column_id(0), &value));
+    ASSERT_EQ(Format("group$0", group), value.string_value());
+    ASSERT_OK(batched_rows[i].GetValue(kSchemaForIteratorTests.column_id(1), &value));
+    ASSERT_EQ(idx, value.int64_value());
+    auto d = batched_rows[i].GetValue(projection.column_id(1));
+    if (idx % 2 == 0) {
+      ASSERT_TRUE(d.is_initialized());
+      ASSERT_EQ(group * 100 + idx, d->int64_value());
+    } else {
+      ASSERT_FALSE(d.is_initialized());
+    }
+    ASSERT_OK(batched_rows[i].GetValue(projection.column_id(2), &value));
+    ASSERT_EQ(Format("e$0_$1", group, idx), value.string_value());
+  }
+}
+
+TEST_F(DocRowwiseIteratorTest, PackedRow) {
+  // This value is written before the packed row, so it should be hidden by it.
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(30_ColId)),
+      PrimitiveValue("row1_c_old"), HybridTime::FromMicros(500)));
+
+  RowPacker packer1(/* schema_version= */ 0);
+  packer1.AddValue(30_ColId, PrimitiveValue("row1_c"));
+  packer1.AddValue(40_ColId, PrimitiveValue(10000));
+  packer1.AddValue(50_ColId, PrimitiveValue("row1_e"));
+  Value packed_row1;
+  packed_row1.SetPackedRow(packer1.Complete());
+  ASSERT_OK(SetPrimitive(DocPath(kEncodedDocKey1), packed_row1, HybridTime::FromMicros(1000)));
+
+  RowPacker packer2(/* schema_version= */ 0);
+  packer2.AddValue(40_ColId, PrimitiveValue(20000));
+  Value packed_row2;
+  packed_row2.SetPackedRow(packer2.Complete());
+  ASSERT_OK(SetPrimitive(DocPath(kEncodedDocKey2), packed_row2, HybridTime::FromMicros(1000)));
+
+  // Column updates after the packed row take precedence over the packed values.
+  ASSERT_OK(SetPrimitive(
+      DocPath(kEncodedDocKey1, PrimitiveValue(40_ColId)),
+      PrimitiveValue(30000), HybridTime::FromMicros(2000)));
+  ASSERT_OK(DeleteSubDoc(
+      DocPath(kEncodedDocKey1, PrimitiveValue(50_ColId)), HybridTime::FromMicros(2000)));
+
+  const Schema &projection = kProjectionForIteratorTests;
+  QLTableRow row;
+  QLValue value;
+
+  {
+    DocRowwiseIterator iter(
+        projection, kSchemaForIteratorTests, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(1500));
+    ASSERT_OK(iter.Init());
+
+    ASSERT_TRUE(ASSERT_RESULT(iter.HasNext()));
+    ASSERT_OK(iter.NextRow(&row));
+
+    ASSERT_OK(row.GetValue(projection.column_id(0), &value));
+    ASSERT_EQ("row1_c", value.string_value());
+    ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+    ASSERT_EQ(10000, value.int64_value());
+    ASSERT_OK(row.GetValue(projection.column_id(2), &value));
+    ASSERT_EQ("row1_e", value.string_value());
+
+    ASSERT_TRUE(ASSERT_RESULT(iter.HasNext()));
+    ASSERT_OK(iter.NextRow(&row));
+
+    ASSERT_OK(row.GetValue(projection.column_id(0), &value));
+    ASSERT_TRUE(value.IsNull());
+    ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+    ASSERT_EQ(20000, value.int64_value());
+    ASSERT_OK(row.GetValue(projection.column_id(2), &value));
+    ASSERT_TRUE(value.IsNull());
+
+    ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
+  }
+
+  {
+    DocRowwiseIterator iter(
+        projection, kSchemaForIteratorTests, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(3000));
+    ASSERT_OK(iter.Init());
+
+    ASSERT_TRUE(ASSERT_RESULT(iter.HasNext()));
+    ASSERT_OK(iter.NextRow(&row));
+
+    ASSERT_OK(row.GetValue(projection.column_id(0), &value));
+    ASSERT_EQ("row1_c", value.string_value());
+    ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+    ASSERT_EQ(30000, value.int64_value());
+    ASSERT_OK(row.GetValue(projection.column_id(2), &value));
+    ASSERT_TRUE(value.IsNull());
+
+    ASSERT_TRUE(ASSERT_RESULT(iter.HasNext()));
+    ASSERT_OK(iter.NextRow(&row));
+    ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+    ASSERT_EQ(20000, value.int64_value());
+
+    ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -275,6 +275,31 @@ bool DebugHasHybridTime(const Slice& subdoc_key_encoded) {
   return subdoc_key.has_hybrid_time();
 }
 
+// Returns false if no running transaction could have intents visible to a read at read_time
+// within scan_bounds, so the intents DB does not have to be read at all.
+bool MayHaveVisibleIntents(
+    const TransactionOperationContext& txn_op_context, const ReadHybridTime& read_time,
+    const KeyBounds* scan_bounds) {
+  auto& txn_status_manager = txn_op_context.txn_status_manager;
+  const auto min_running_ht = txn_status_manager.MinRunningHybridTime();
+  if (min_running_ht == HybridTime::kMax) {
+    return false;
+  }
+  // Transactions are committed after they start, so when all running transactions started after
+  // the global limit, none of them could be committed at read time. Intents of the current
+  // transaction are visible regardless of their time, so this only applies to reads outside of a
+  // transaction.
+  if (!txn_op_context.transactional() && min_running_ht.is_valid() &&
+      min_running_ht > read_time.global_limit) {
+    return false;
+  }
+  if (scan_bounds && !txn_status_manager.MayHaveIntentsInRange(
+          scan_bounds->lower, scan_bounds->upper)) {
+    return false;
+  }
+  return true;
+}
+
 } // namespace
 
 IntentAwareIterator::IntentAwareIterator(
@@ -282,7 +307,8 @@ IntentAwareIterator::IntentAwareIterator(
     const rocksdb::ReadOptions& read_opts,
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
-    const TransactionOperationContextOpt& txn_op_context)
+    const TransactionOperationContextOpt& txn_op_context,
+    const KeyBounds* scan_bounds)
     : read_time_(read_time),
       encoded_read_time_local_limit_(
           DocHybridTime(read_time_.local_limit, kMaxWriteId).EncodedInDocDbFormat()),
@@ -294,8 +320,7 @@ IntentAwareIterator::IntentAwareIterator(
   VLOG(4) << "IntentAwareIterator, read_time: " << read_time
           << ", txn_op_context: " << txn_op_context_;
 
-  if (txn_op_context &&
-      txn_op_context->txn_status_manager.MinRunningHybridTime() != HybridTime::kMax) {
+  if (txn_op_context && MayHaveVisibleIntents(*txn_op_context, read_time, scan_bounds)) {
     intent_iter_ = docdb::CreateRocksDBIterator(doc_db.intents,
                                                 doc_db.key_bounds,
                                                 docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
@@ -516,23 +541,14 @@ Status IntentAwareIterator::NextFullValue(
 bool IntentAwareIterator::PreparePrev(const Slice& key) {
   VLOG(4) << __func__ << "(" << SubDocKey::DebugSliceToString(key) << ")";
 
-  ROCKSDB_SEEK(&iter_, key);
-
-  if (iter_.Valid()) {
-    iter_.Prev();
-  } else {
-    iter_.SeekToLast();
-  }
+  // During backward scan both iterators are usually positioned right after the key, so they are
+  // moved with Prev() when possible.
+  docdb::SeekBackward(key, &iter_);
   SkipFutureRecords(Direction::kBackward);
 
   if (intent_iter_.Initialized()) {
     ResetIntentUpperbound();
-    ROCKSDB_SEEK(&intent_iter_, GetIntentPrefixForKeyWithoutHt(key));
-    if (intent_iter_.Valid()) {
-      intent_iter_.Prev();
-    } else {
-      intent_iter_.SeekToLast();
-    }
+    docdb::SeekBackward(GetIntentPrefixForKeyWithoutHt(key).AsSlice(), &intent_iter_);
     SeekToSuitableIntent<Direction::kBackward>();
     seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
     skip_future_intents_needed_ = false;
@@ -587,7 +603,16 @@ void IntentAwareIterator::SeekToLatestDocKeyInternal() {
     status_ = dockey_size.status();
     return;
   }
-  Seek(Slice(subdockey_slice.data(), *dockey_size));
+  KeyBytes doc_key(Slice(subdockey_slice.data(), *dockey_size));
+  // After moving backward, iterators are positioned inside or before the found row. Move them
+  // before the row with Prev(), so the following seek to the row start is done using Next().
+  if (iter_valid_) {
+    docdb::PrevBefore(doc_key.AsSlice(), &iter_);
+  }
+  if (intent_iter_.Initialized()) {
+    docdb::PrevBefore(GetIntentPrefixForKeyWithoutHt(doc_key.AsSlice()).AsSlice(), &intent_iter_);
+  }
+  Seek(doc_key.AsSlice());
 }
 
 void IntentAwareIterator::SeekIntentIterIfNeeded() {
@@ -86,12 +86,15 @@ struct FetchKeyResult {
 // HybridTime of subdoc_key in Seek* methods would be ignored.
 class IntentAwareIterator {
  public:
+  // If scan_bounds is specified, the caller guarantees that only keys within these bounds will be
+  // read, so the intents DB is not read at all when no running transaction has intents there.
   IntentAwareIterator(
       const DocDB& doc_db,
       const rocksdb::ReadOptions& read_opts,
       CoarseTimePoint deadline,
       const ReadHybridTime& read_time,
-      const TransactionOperationContextOpt& txn_op_context);
+      const TransactionOperationContextOpt& txn_op_context,
+      const KeyBounds* scan_bounds = nullptr);
 
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
@@ -150,6 +153,9 @@ class IntentAwareIterator {
   ReadHybridTime read_time() { return read_time_; }
   HybridTime max_seen_ht() { return max_seen_ht_; }
 
+  // Whether intents of running transactions are read, i.e. could be visible to this read.
+  bool reads_intents() const { return intent_iter_.Initialized(); }
+
   // Iterate through Next() until a row containing a full record (non merge record) is found.
   // The key is not guaranteed to stay the same. The key without hybrid time and value of the
   // merge record go in final_key (optionally), and result_value, while the write time of the
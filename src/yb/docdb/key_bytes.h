@@ -105,11 +105,11 @@ class KeyBytes {
     }
   }
 
-  void AppendString(const std::string& raw_string) {
+  void AppendString(const Slice& raw_string) {
     ZeroEncodeAndAppendStrToKey(raw_string, &data_);
   }
 
-  void AppendDescendingString(const std::string &raw_string) {
+  void AppendDescendingString(const Slice& raw_string) {
     ComplementZeroEncodeAndAppendStrToKey(raw_string, &data_);
   }
 
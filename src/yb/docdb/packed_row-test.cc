@@ -0,0 +1,122 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+#include "yb/docdb/subdocument.h"
+#include "yb/docdb/value.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class PackedRowTest : public YBTest {
+ protected:
+  static std::string PackTestRow() {
+    RowPacker packer(/* schema_version= */ 7);
+    packer.AddValue(ColumnId(10), PrimitiveValue("value10"));
+    packer.AddValue(ColumnId(11), PrimitiveValue(42));
+    packer.AddValue(ColumnId(20), PrimitiveValue(""));
+    return packer.Complete();
+  }
+};
+
+TEST_F(PackedRowTest, EncodeDecode) {
+  const auto packed_row = PackTestRow();
+
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(packed_row));
+  ASSERT_EQ(7, decoder.schema_version());
+
+  ColumnId column_id;
+  Slice encoded_value;
+  PrimitiveValue value;
+  ASSERT_TRUE(ASSERT_RESULT(decoder.Next(&column_id, &encoded_value)));
+  ASSERT_EQ(ColumnId(10), column_id);
+  ASSERT_OK(value.DecodeFromValue(encoded_value));
+  ASSERT_EQ(PrimitiveValue("value10"), value);
+
+  ASSERT_TRUE(ASSERT_RESULT(decoder.Next(&column_id, &encoded_value)));
+  ASSERT_EQ(ColumnId(11), column_id);
+  ASSERT_OK(value.DecodeFromValue(encoded_value));
+  ASSERT_EQ(PrimitiveValue(42), value);
+
+  ASSERT_TRUE(ASSERT_RESULT(decoder.Next(&column_id, &encoded_value)));
+  ASSERT_EQ(ColumnId(20), column_id);
+  ASSERT_OK(value.DecodeFromValue(encoded_value));
+  ASSERT_EQ(PrimitiveValue(""), value);
+
+  ASSERT_FALSE(ASSERT_RESULT(decoder.Next(&column_id, &encoded_value)));
+}
+
+TEST_F(PackedRowTest, Corruption) {
+  const auto packed_row = PackTestRow();
+
+  PackedRowDecoder decoder;
+  ASSERT_NOK(decoder.Init(Slice(packed_row.data() + 1, packed_row.size() - 1)));
+
+  // Cut the last column value in the middle.
+  ASSERT_OK(decoder.Init(Slice(packed_row.data(), packed_row.size() - 1)));
+  ColumnId column_id;
+  Slice encoded_value;
+  ASSERT_TRUE(ASSERT_RESULT(decoder.Next(&column_id, &encoded_value)));
+  ASSERT_TRUE(ASSERT_RESULT(decoder.Next(&column_id, &encoded_value)));
+  ASSERT_NOK(decoder.Next(&column_id, &encoded_value));
+}
+
+TEST_F(PackedRowTest, Value) {
+  Value value;
+  value.SetPackedRow(PackTestRow());
+  *value.mutable_ttl() = MonoDelta::FromSeconds(10);
+  const auto encoded_value = value.Encode();
+
+  Value decoded_value;
+  ASSERT_OK(decoded_value.Decode(encoded_value));
+  ASSERT_EQ(ValueType::kPackedRow, decoded_value.value_type());
+  ASSERT_EQ(value.packed_row(), decoded_value.packed_row());
+  ASSERT_TRUE(decoded_value.ttl().Equals(MonoDelta::FromSeconds(10)));
+  LOG(INFO) << "Decoded value: " << decoded_value.ToString();
+}
+
+TEST_F(PackedRowTest, UnpackToSubDocument) {
+  SubDocument result;
+  ASSERT_OK(UnpackRowToSubDocument(PackTestRow(), /* write_time_micros= */ 1000, &result));
+  size_t num_children = 0;
+  ASSERT_OK(result.NumChildren(&num_children));
+  ASSERT_EQ(3, num_children);
+  const SubDocument* column = result.GetChild(PrimitiveValue(ColumnId(11)));
+  ASSERT_NE(nullptr, column);
+  ASSERT_EQ(ValueType::kInt64, column->value_type());
+  ASSERT_EQ(42, column->GetInt64());
+  ASSERT_EQ(1000, column->GetWriteTime());
+}
+
+TEST_F(PackedRowTest, RemoveColumns) {
+  const auto packed_row = PackTestRow();
+  std::string repacked_row;
+  ASSERT_FALSE(ASSERT_RESULT(RemoveColumnsFromPackedRow(
+      packed_row, ColumnIds{ColumnId(12)}, &repacked_row)));
+  ASSERT_TRUE(repacked_row.empty());
+
+  ASSERT_TRUE(ASSERT_RESULT(RemoveColumnsFromPackedRow(
+      packed_row, ColumnIds{ColumnId(11), ColumnId(12)}, &repacked_row)));
+
+  RowPacker packer(/* schema_version= */ 7);
+  packer.AddValue(ColumnId(10), PrimitiveValue("value10"));
+  packer.AddValue(ColumnId(20), PrimitiveValue(""));
+  ASSERT_EQ(packer.Complete(), repacked_row);
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,150 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include "yb/docdb/subdocument.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/fast_varint.h"
+
+namespace yb {
+namespace docdb {
+
+RowPacker::RowPacker(uint32_t schema_version) {
+  result_.push_back(ValueTypeAsChar::kPackedRow);
+  util::FastAppendUnsignedVarIntToStr(schema_version, &result_);
+}
+
+void RowPacker::AddValue(ColumnId column_id, const PrimitiveValue& value) {
+  DCHECK_GT(column_id.rep(), last_column_id_);
+  last_column_id_ = column_id.rep();
+  auto encoded_value = value.ToValue();
+  util::FastAppendUnsignedVarIntToStr(column_id.ToUint64(), &result_);
+  util::FastAppendUnsignedVarIntToStr(encoded_value.size(), &result_);
+  result_.append(encoded_value);
+}
+
+Status PackedRowDecoder::Init(const Slice& packed_row) {
+  input_ = packed_row;
+  if (!input_.TryConsumeByte(ValueTypeAsChar::kPackedRow)) {
+    return STATUS_FORMAT(Corruption, "Packed row expected, got: $0", packed_row.ToDebugHexString());
+  }
+  auto schema_version = VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input_));
+  if (schema_version > std::numeric_limits<uint32_t>::max()) {
+    return STATUS_FORMAT(Corruption, "Bad schema version in packed row: $0", schema_version);
+  }
+  schema_version_ = static_cast<uint32_t>(schema_version);
+  return Status::OK();
+}
+
+Result<bool> PackedRowDecoder::Next(ColumnId* column_id, Slice* value) {
+  if (input_.empty()) {
+    return false;
+  }
+  auto column_id_as_uint64 = VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input_));
+  RETURN_NOT_OK(ColumnId::FromInt64(column_id_as_uint64, column_id));
+  auto value_size = VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input_));
+  if (value_size > input_.size()) {
+    return STATUS_FORMAT(
+        Corruption, "Not enough bytes for column $0 in packed row: $1, need $2",
+        *column_id, input_.size(), value_size);
+  }
+  *value = Slice(input_.data(), value_size);
+  input_.remove_prefix(value_size);
+  return true;
+}
+
+Status UnpackRowToSubDocument(
+    const Slice& packed_row, int64_t write_time_micros, SubDocument* result) {
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(packed_row));
+  if (!IsObjectType(result->value_type())) {
+    *result = SubDocument();
+  }
+  ColumnId column_id;
+  Slice encoded_value;
+  while (VERIFY_RESULT(decoder.Next(&column_id, &encoded_value))) {
+    PrimitiveValue value;
+    RETURN_NOT_OK_PREPEND(
+        value.DecodeFromValue(encoded_value),
+        Format("Failed to decode column $0 of packed row", column_id));
+    // Packed rows are only written without TTL, see RowPacker users.
+    value.SetTtl(-1);
+    value.SetWriteTime(write_time_micros);
+    result->SetChildPrimitive(PrimitiveValue(column_id), std::move(value));
+  }
+  return Status::OK();
+}
+
+Result<bool> RemoveColumnsFromPackedRow(
+    const Slice& packed_row, const ColumnIds& deleted_cols, std::string* out) {
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(packed_row));
+  // Most of the time there are no deleted columns in the row, so check it before repacking.
+  bool has_deleted_columns = false;
+  ColumnId column_id;
+  Slice encoded_value;
+  while (VERIFY_RESULT(decoder.Next(&column_id, &encoded_value))) {
+    if (deleted_cols.count(column_id)) {
+      has_deleted_columns = true;
+      break;
+    }
+  }
+  if (!has_deleted_columns) {
+    return false;
+  }
+
+  RETURN_NOT_OK(decoder.Init(packed_row));
+  out->clear();
+  out->push_back(ValueTypeAsChar::kPackedRow);
+  util::FastAppendUnsignedVarIntToStr(decoder.schema_version(), out);
+  while (VERIFY_RESULT(decoder.Next(&column_id, &encoded_value))) {
+    if (deleted_cols.count(column_id)) {
+      continue;
+    }
+    util::FastAppendUnsignedVarIntToStr(column_id.ToUint64(), out);
+    util::FastAppendUnsignedVarIntToStr(encoded_value.size(), out);
+    out->append(encoded_value.cdata(), encoded_value.size());
+  }
+  return true;
+}
+
+std::string PackedRowToString(const Slice& packed_row) {
+  PackedRowDecoder decoder;
+  auto status = decoder.Init(packed_row);
+  if (!status.ok()) {
+    return status.ToString();
+  }
+  std::string result = Format("PackedRow(version: $0", decoder.schema_version());
+  ColumnId column_id;
+  Slice encoded_value;
+  for (;;) {
+    auto next = decoder.Next(&column_id, &encoded_value);
+    if (!next.ok()) {
+      result += ", " + next.status().ToString();
+      break;
+    }
+    if (!*next) {
+      break;
+    }
+    PrimitiveValue value;
+    status = value.DecodeFromValue(encoded_value);
+    result += Format(", $0: $1", column_id, status.ok() ? value.ToString() : status.ToString());
+  }
+  result += ")";
+  return result;
+}
+
+}  // namespace docdb
+}  // namespace yb
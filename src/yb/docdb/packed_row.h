@@ -0,0 +1,101 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Packed row is an alternative encoding of a row version where all non-key columns are stored in a
+// single RocksDB value at the DocKey level, instead of one key-value pair per column.
+//
+// Encoded format (following the usual value control fields, see Value::EncodeAndAppend):
+//   ValueType::kPackedRow
+//   schema version (unsigned varint)
+//   for each column, in increasing column id order:
+//     column id (unsigned varint)
+//     size of the encoded value (unsigned varint)
+//     encoded value, in the same format that is used for a column value (PrimitiveValue::ToValue)
+//
+// Columns that are absent from the packed row are NULL. A packed row fully overwrites the row it is
+// written to, i.e. it also acts as the liveness column and hides all column values with an earlier
+// hybrid time. Column values written later than the packed row take precedence over the values
+// stored in it.
+
+#ifndef YB_DOCDB_PACKED_ROW_H_
+#define YB_DOCDB_PACKED_ROW_H_
+
+#include <string>
+
+#include "yb/common/schema.h"
+
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+class SubDocument;
+
+// Builds packed row value. Columns should be added in increasing column id order.
+class RowPacker {
+ public:
+  explicit RowPacker(uint32_t schema_version);
+
+  void AddValue(ColumnId column_id, const PrimitiveValue& value);
+
+  // Returns encoded packed row, starting with ValueType::kPackedRow.
+  const std::string& Complete() const {
+    return result_;
+  }
+
+ private:
+  std::string result_;
+  int64_t last_column_id_ = -1;
+};
+
+// Iterates over columns of an encoded packed row.
+class PackedRowDecoder {
+ public:
+  PackedRowDecoder() = default;
+
+  // packed_row should start with ValueType::kPackedRow and should outlive the decoder.
+  CHECKED_STATUS Init(const Slice& packed_row);
+
+  uint32_t schema_version() const {
+    return schema_version_;
+  }
+
+  // Fetches next column. Returns false when all columns were fetched.
+  // value points to the encoded column value inside the packed row.
+  Result<bool> Next(ColumnId* column_id, Slice* value);
+
+ private:
+  Slice input_;
+  uint32_t schema_version_ = 0;
+};
+
+// Adds all columns of the packed row to result as children keyed by column id, setting each
+// column write time to write_time_micros. Result is converted to an object if it is not an object
+// yet.
+CHECKED_STATUS UnpackRowToSubDocument(
+    const Slice& packed_row, int64_t write_time_micros, SubDocument* result);
+
+// Repacks packed_row without the columns from deleted_cols. Returns false if packed_row does not
+// have any of the deleted columns, in which case out is left untouched.
+Result<bool> RemoveColumnsFromPackedRow(
+    const Slice& packed_row, const ColumnIds& deleted_cols, std::string* out);
+
+std::string PackedRowToString(const Slice& packed_row);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_PACKED_ROW_H_
@@ -13,6 +13,9 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <boost/optional/optional_io.hpp>
 
 #include "yb/common/partition.h"
@@ -22,6 +25,7 @@
 
 #include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value_util.h"
 
 #include "yb/util/flag_tags.h"
@@ -36,6 +40,26 @@ DECLARE_bool(ysql_disable_index_backfill);
 DEFINE_double(ysql_scan_timeout_multiplier, 0.5,
               "YSQL read scan timeout multipler of retryable_rpc_single_call_timeout_ms.");
 
+DEFINE_int32(ysql_scan_batch_size, 1024,
+             "Number of rows read from the DocDB iterator at a time by YSQL scans that do not use "
+             "a secondary index. Set to 1 to read rows one at a time.");
+
+DEFINE_bool(ysql_enable_compiled_where_expr, true,
+            "Whether YSQL scans should evaluate simple pushed-down where conditions over batches "
+            "of rows instead of evaluating the expression tree for each row.");
+TAG_FLAG(ysql_enable_compiled_where_expr, advanced);
+
+DEFINE_bool(ysql_sorted_ybctid_batch_lookup, true,
+            "Whether YSQL reads by a batch of ybctids should look up the rows in key order with a "
+            "single iterator, that skips SST files not containing any of the ybctids according to "
+            "bloom filters, instead of creating an iterator for each ybctid.");
+TAG_FLAG(ysql_sorted_ybctid_batch_lookup, advanced);
+
+DEFINE_bool(ysql_enable_packed_row, false,
+            "Whether YSQL inserts should write all non-key columns of a row as a single packed "
+            "row value instead of one value per column.");
+TAG_FLAG(ysql_enable_packed_row, experimental);
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -47,6 +71,14 @@ namespace {
 CHECKED_STATUS CreateProjection(const Schema& schema,
                                 const PgsqlColumnRefsPB& column_refs,
                                 Schema* projection) {
+  return schema.CreateProjectionByIdsIgnoreMissing(
+      PgsqlProjectionColumnIds(schema, column_refs), projection);
+}
+
+} // namespace
+
+std::vector<ColumnId> PgsqlProjectionColumnIds(
+    const Schema& schema, const PgsqlColumnRefsPB& column_refs) {
   // Create projection of non-primary key columns. Primary key columns are implicitly read by DocDB.
   // It will also sort the columns before scanning.
   vector<ColumnId> column_ids;
@@ -57,11 +89,9 @@ CHECKED_STATUS CreateProjection(const Schema& schema,
       column_ids.emplace_back(column_id);
     }
   }
-  return schema.CreateProjectionByIdsIgnoreMissing(column_ids, projection);
+  return column_ids;
 }
 
-} // namespace
-
 //--------------------------------------------------------------------------------------------------
 
 Status PgsqlWriteOperation::Init(PgsqlWriteRequestPB* request, PgsqlResponsePB* response) {
@@ -143,6 +173,23 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     }
   }
 
+  // Upsert could be used to change only some of the columns of an existing row, while packed row
+  // overwrites the whole row.
+  if (FLAGS_ysql_enable_packed_row && !is_upsert) {
+    auto status = InsertPackedRow(data, table_row);
+    if (status.IsInvalidArgument()) {
+      // Nothing was written for the row, so only this request fails and not the whole batch.
+      response_->set_status(PgsqlResponsePB::PGSQL_STATUS_USAGE_ERROR);
+      response_->set_error_message(status.message().ToBuffer());
+      return Status::OK();
+    }
+    RETURN_NOT_OK(status);
+    RETURN_NOT_OK(PopulateResultSet(table_row));
+
+    response_->set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
+    return Status::OK();
+  }
+
   // Add the liveness column.
   static const PrimitiveValue kLivenessColumnId =
       PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn);
@@ -182,6 +229,52 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
   return Status::OK();
 }
 
+Status PgsqlWriteOperation::InsertPackedRow(
+    const DocOperationApplyData& data, const QLTableRow& table_row) {
+  std::vector<std::pair<ColumnId, PrimitiveValue>> columns;
+  columns.reserve(request_.column_values_size());
+  for (const auto& column_value : request_.column_values()) {
+    if (!column_value.has_column_id()) {
+      return STATUS(InvalidArgument, "column id missing", column_value.DebugString());
+    }
+    const ColumnId column_id(column_value.column_id());
+    const ColumnSchema& column = VERIFY_RESULT(schema_.column_by_id(column_id));
+
+    if (GetTSWriteInstruction(column_value.expr()) != bfpg::TSOpcode::kScalarInsert) {
+      return STATUS_FORMAT(
+          InvalidArgument, "Illegal write instruction for column $0: $1",
+          column_id, column_value.expr().ShortDebugString());
+    }
+
+    QLExprResult expr_result;
+    RETURN_NOT_OK(EvalExpr(column_value.expr(), table_row, expr_result.Writer()));
+    const SubDocument sub_doc =
+        SubDocument::FromQLValuePB(expr_result.Value(), column.sorting_type());
+    if (!sub_doc.IsTombstoneOrPrimitive()) {
+      return STATUS_FORMAT(
+          InvalidArgument, "Packed row could contain only primitive values, column $0: $1",
+          column_id, sub_doc.ToString());
+    }
+    // Columns that are absent in the packed row are NULL.
+    if (sub_doc.value_type() != ValueType::kTombstone) {
+      columns.emplace_back(column_id, sub_doc);
+    }
+  }
+  std::sort(columns.begin(), columns.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+
+  RowPacker packer(request_.schema_version());
+  for (const auto& column : columns) {
+    packer.AddValue(column.first, column.second);
+  }
+  Value value;
+  value.SetPackedRow(packer.Complete());
+  return data.doc_write_batch->SetPrimitive(
+      DocPath(encoded_doc_key_.as_slice()), value,
+      data.read_time, data.deadline, request_.stmt_id());
+}
+
 Status PgsqlWriteOperation::ApplyUpdate(const DocOperationApplyData& data) {
   QLTableRow table_row;
   RETURN_NOT_OK(ReadColumns(data, &table_row));
@@ -419,7 +512,9 @@ Result<size_t> PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storag
                                            CoarseTimePoint deadline,
                                            const ReadHybridTime& read_time,
                                            const Schema& schema,
+                                           const Schema& projection,
                                            const Schema *index_schema,
+                                           const Schema *index_projection,
                                            faststring *result_buffer,
                                            HybridTime *restart_read_ht) {
   size_t fetched_rows = 0;
@@ -435,16 +530,18 @@ Result<size_t> PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storag
   if (request_.batch_arguments_size() > 0) {
     if (request_.has_ybctid_column_value()) {
       fetched_rows = VERIFY_RESULT(ExecuteBatchYbctid(
-          ql_storage, deadline, read_time, schema, result_buffer, restart_read_ht));
+          ql_storage, deadline, read_time, schema, projection, result_buffer, restart_read_ht));
     } else {
       fetched_rows = VERIFY_RESULT(ExecuteBatch(ql_storage, deadline, read_time, schema,
-                                                index_schema, result_buffer, restart_read_ht,
+                                                projection, index_schema, index_projection,
+                                                result_buffer, restart_read_ht,
                                                 &has_paging_state));
     }
   } else {
     fetched_rows = VERIFY_RESULT(ExecuteScalar(ql_storage, deadline, read_time, schema,
-                                               index_schema, -1 /* batch_arg_index */,
-                                               result_buffer, restart_read_ht, &has_paging_state));
+                                               projection, index_schema, index_projection,
+                                               -1 /* batch_arg_index */, result_buffer,
+                                               restart_read_ht, &has_paging_state));
   }
 
   if (FLAGS_trace_docdb_calls) {
@@ -458,7 +555,9 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
                                                  CoarseTimePoint deadline,
                                                  const ReadHybridTime& read_time,
                                                  const Schema& schema,
+                                                 const Schema& projection,
                                                  const Schema *index_schema,
+                                                 const Schema *index_projection,
                                                  int64_t batch_arg_index,
                                                  faststring *result_buffer,
                                                  HybridTime *restart_read_ht,
@@ -474,16 +573,13 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
     row_count_limit = request_.limit();
   }
 
-  // Create the projection of regular columns selected by the row block plus any referenced in
-  // the WHERE condition. When DocRowwiseIterator::NextRow() populates the value map, it uses this
-  // projection only to scan sub-documents. The query schema is used to select only referenced
-  // columns and key columns.
-  Schema projection;
-  Schema index_projection;
+  // The projection of regular columns selected by the row block plus any referenced in the WHERE
+  // condition. When DocRowwiseIterator::NextRow() populates the value map, it uses this projection
+  // only to scan sub-documents. The query schema is used to select only referenced columns and key
+  // columns.
   common::YQLRowwiseIteratorIf *iter;
   const Schema* scan_schema;
 
-  RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
   RETURN_NOT_OK(ql_storage.GetIterator(request_, batch_arg_index,
                                        projection, schema, txn_op_context_,
                                        deadline, read_time, &table_iter_));
@@ -491,9 +587,9 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
   ColumnId ybbasectid_id;
   if (request_.has_index_request()) {
     const PgsqlReadRequestPB& index_request = request_.index_request();
-    RETURN_NOT_OK(CreateProjection(*index_schema, index_request.column_refs(), &index_projection));
+    SCHECK(index_projection != nullptr, InvalidArgument, "Index projection is not specified");
     RETURN_NOT_OK(ql_storage.GetIterator(index_request, batch_arg_index,
-                                         index_projection, *index_schema,
+                                         *index_projection, *index_schema,
                                          txn_op_context_, deadline, read_time, &index_iter_));
     iter = index_iter_.get();
     const size_t idx = index_schema->find_column("ybidxbasectid");
@@ -515,48 +611,89 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
   // Fetching data.
   int match_count = 0;
   QLTableRow row;
-  while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
-         !scan_time_exceeded) {
-
-    row.Clear();
 
-    // If there is an index request, fetch ybbasectid from the index and use it as ybctid
-    // to fetch from the base table. Otherwise, fetch from the base table directly.
-    if (request_.has_index_request()) {
-      RETURN_NOT_OK(iter->NextRow(&row));
-      const auto& tuple_id = row.GetValue(ybbasectid_id);
-      SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
-      if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
-        DocKey doc_key;
-        RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
-        return STATUS_FORMAT(Corruption, "ybctid $0 not found in indexed table", doc_key);
-      }
-      row.Clear();
-      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+  // Add the row matching the where condition to the row block.
+  auto process_match = [this, &match_count, &fetched_rows, result_buffer](
+      const QLTableRow& row) -> Status {
+    match_count++;
+    if (request_.is_aggregate()) {
+      RETURN_NOT_OK(EvalAggregate(row));
     } else {
-      RETURN_NOT_OK(iter->NextRow(projection, &row));
+      RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+      ++fetched_rows;
     }
+    return Status::OK();
+  };
 
-    // Match the row with the where condition before adding to the row block.
-    bool is_match = true;
+  // Match the row with the where condition before adding to the row block.
+  auto process_row = [this, &process_match, &schema](const QLTableRow& row) -> Status {
     if (request_.has_where_expr()) {
       QLExprResult match;
-      RETURN_NOT_OK(EvalExpr(request_.where_expr(), row, match.Writer()));
-      is_match = match.Value().bool_value();
+      // Schema is needed to evaluate YSQL expressions pushed down to DocDB.
+      RETURN_NOT_OK(EvalExpr(request_.where_expr(), row, match.Writer(), &schema));
+      if (!match.Value().bool_value()) {
+        return Status::OK();
+      }
     }
-    if (is_match) {
-      match_count++;
-      if (request_.is_aggregate()) {
-        RETURN_NOT_OK(EvalAggregate(row));
+    return process_match(row);
+  };
+
+  if (!request_.has_index_request() && FLAGS_ysql_scan_batch_size > 1) {
+    // Without an index request every scanned row comes straight from the table iterator, so rows
+    // can be read in batches. Each row produces at most one result row, so never read more rows
+    // than are still needed to keep the iterator positioned correctly for the paging state.
+    // Simple where conditions are compiled to be evaluated over the whole batch at once.
+    const bool use_compiled_where = request_.has_where_expr() &&
+                                    FLAGS_ysql_enable_compiled_where_expr &&
+                                    compiled_where_.Init(request_.where_expr());
+    while (fetched_rows < row_count_limit && !scan_time_exceeded) {
+      const size_t max_rows = std::min<size_t>(
+          FLAGS_ysql_scan_batch_size, row_count_limit - fetched_rows);
+      const size_t num_rows = VERIFY_RESULT(iter->NextRowBatch(projection, max_rows, &row_batch_));
+      if (use_compiled_where) {
+        RETURN_NOT_OK(compiled_where_.Evaluate(row_batch_, num_rows, &row_batch_selection_));
+        for (size_t i : row_batch_selection_) {
+          RETURN_NOT_OK(process_match(row_batch_[i]));
+        }
       } else {
-        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
-        ++fetched_rows;
+        for (size_t i = 0; i != num_rows; ++i) {
+          RETURN_NOT_OK(process_row(row_batch_[i]));
+        }
+      }
+      if (num_rows < max_rows) {
+        break;
       }
+      scan_time_exceeded = CoarseMonoClock::now() >= deadline;
     }
+  } else {
+    while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
+           !scan_time_exceeded) {
 
-    // Check every row_count_limit matches whether we've exceeded our scan time.
-    if (match_count % row_count_limit == 0) {
-      scan_time_exceeded = CoarseMonoClock::now() >= deadline;
+      row.Clear();
+
+      // If there is an index request, fetch ybbasectid from the index and use it as ybctid
+      // to fetch from the base table. Otherwise, fetch from the base table directly.
+      if (request_.has_index_request()) {
+        RETURN_NOT_OK(iter->NextRow(&row));
+        const auto& tuple_id = row.GetValue(ybbasectid_id);
+        SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
+        if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
+          DocKey doc_key;
+          RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
+          return STATUS_FORMAT(Corruption, "ybctid $0 not found in indexed table", doc_key);
+        }
+        row.Clear();
+        RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+      } else {
+        RETURN_NOT_OK(iter->NextRow(projection, &row));
+      }
+
+      RETURN_NOT_OK(process_row(row));
+
+      // Check every row_count_limit matches whether we've exceeded our scan time.
+      if (match_count % row_count_limit == 0) {
+        scan_time_exceeded = CoarseMonoClock::now() >= deadline;
+      }
     }
   }
 
@@ -579,7 +716,9 @@ Result<size_t> PgsqlReadOperation::ExecuteBatch(const common::YQLStorageIf& ql_s
                                                 CoarseTimePoint deadline,
                                                 const ReadHybridTime& read_time,
                                                 const Schema& schema,
+                                                const Schema& projection,
                                                 const Schema *index_schema,
+                                                const Schema *index_projection,
                                                 faststring *result_buffer,
                                                 HybridTime *restart_read_ht,
                                                 bool *has_paging_state) {
@@ -590,8 +729,9 @@ Result<size_t> PgsqlReadOperation::ExecuteBatch(const common::YQLStorageIf& ql_s
   int64_t batch_arg_index = 0;
   while (!exec_has_paging_state && batch_arg_index < batch_arg_count) {
     fetched_rows += VERIFY_RESULT(ExecuteScalar(ql_storage, deadline, read_time, schema,
-                                                index_schema, batch_arg_index, result_buffer,
-                                                restart_read_ht, &exec_has_paging_state));
+                                                projection, index_schema, index_projection,
+                                                batch_arg_index, result_buffer, restart_read_ht,
+                                                &exec_has_paging_state));
     batch_arg_index++;
   }
   *has_paging_state = exec_has_paging_state;
@@ -604,26 +744,74 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const common::YQLStorageIf
                                                       CoarseTimePoint deadline,
                                                       const ReadHybridTime& read_time,
                                                       const Schema& schema,
+                                                      const Schema& projection,
                                                       faststring *result_buffer,
                                                       HybridTime *restart_read_ht) {
-  Schema projection;
-  RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
-
   QLTableRow row;
   size_t row_count = 0;
-  for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
-    // Get the row.
-    RETURN_NOT_OK(ql_storage.GetIterator(request_, projection, schema, txn_op_context_,
-                                         deadline, read_time, batch_argument.ybctid().value(),
-                                         &table_iter_));
-    row.Clear();
+  if (!FLAGS_ysql_sorted_ybctid_batch_lookup) {
+    for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
+      // Get the row.
+      RETURN_NOT_OK(ql_storage.GetIterator(request_, projection, schema, txn_op_context_,
+                                           deadline, read_time, batch_argument.ybctid().value(),
+                                           &table_iter_));
+      row.Clear();
+
+      SCHECK(VERIFY_RESULT(table_iter_->HasNext()), Corruption,
+             "Given ybctid is not associated with any row in table");
+      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
 
-    SCHECK(VERIFY_RESULT(table_iter_->HasNext()), Corruption,
+      // Populate result set.
+      RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+      row_count++;
+    }
+    response_.set_batch_arg_count(row_count);
+    return row_count;
+  }
+
+  // Look up the rows in ybctid order with a single iterator, so it only moves forward, and then
+  // return them in the order of batch arguments.
+  const auto& batch_arguments = request_.batch_arguments();
+  std::vector<size_t> order(batch_arguments.size());
+  std::iota(order.begin(), order.end(), 0);
+  auto ybctid = [&batch_arguments](size_t index) {
+    return Slice(batch_arguments.Get(index).ybctid().value().binary_value());
+  };
+  std::sort(order.begin(), order.end(), [&ybctid](size_t lhs, size_t rhs) {
+    return ybctid(lhs).compare(ybctid(rhs)) < 0;
+  });
+
+  // The same ybctid could be requested several times, it is looked up only once.
+  std::vector<Slice> ybctids;
+  ybctids.reserve(order.size());
+  std::vector<size_t> row_index(order.size());
+  for (size_t index : order) {
+    if (ybctids.empty() || ybctids.back() != ybctid(index)) {
+      ybctids.push_back(ybctid(index));
+    }
+    row_index[index] = ybctids.size() - 1;
+  }
+
+  RETURN_NOT_OK(ql_storage.GetIterator(projection, schema, txn_op_context_, deadline, read_time,
+                                       ybctids, &table_iter_));
+
+  faststring rows_buffer;
+  // Offsets of encoded rows in rows_buffer, with the end offset of the last row.
+  std::vector<size_t> row_offsets;
+  row_offsets.reserve(ybctids.size() + 1);
+  for (const auto& tuple_id : ybctids) {
+    SCHECK(VERIFY_RESULT(table_iter_->SeekTuple(tuple_id)), Corruption,
            "Given ybctid is not associated with any row in table");
+    row.Clear();
     RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+    row_offsets.push_back(rows_buffer.size());
+    RETURN_NOT_OK(PopulateResultSet(row, &rows_buffer));
+  }
+  row_offsets.push_back(rows_buffer.size());
 
-    // Populate result set.
-    RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+  for (size_t index : row_index) {
+    result_buffer->append(rows_buffer.data() + row_offsets[index],
+                          row_offsets[index + 1] - row_offsets[index]);
     row_count++;
   }
 
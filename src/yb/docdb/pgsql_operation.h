@@ -16,6 +16,7 @@
 
 #include "yb/common/ql_rowwise_iterator_interface.h"
 
+#include "yb/docdb/compiled_condition.h"
 #include "yb/docdb/doc_expr.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_operation.h"
@@ -34,6 +35,11 @@ namespace docdb {
 
 YB_STRONGLY_TYPED_BOOL(IsUpsert);
 
+// Returns ids of the projection of non-primary key columns referenced by a request. Primary key
+// columns are implicitly read by DocDB.
+std::vector<ColumnId> PgsqlProjectionColumnIds(
+    const Schema& schema, const PgsqlColumnRefsPB& column_refs);
+
 class PgsqlWriteOperation :
     public DocOperationBase<DocOperationType::PGSQL_WRITE_OPERATION, PgsqlWriteRequestPB>,
     public DocExprExecutor {
@@ -78,6 +84,10 @@ class PgsqlWriteOperation :
   CHECKED_STATUS ApplyDelete(const DocOperationApplyData& data);
   CHECKED_STATUS ApplyTruncateColocated(const DocOperationApplyData& data);
 
+  // Writes all column values of the inserted row as a single packed row value. Returns
+  // InvalidArgument, before anything is written, when the request could not be packed.
+  CHECKED_STATUS InsertPackedRow(const DocOperationApplyData& data, const QLTableRow& table_row);
+
   CHECKED_STATUS DeleteRow(const DocPath& row_path, DocWriteBatch* doc_write_batch,
                            const ReadHybridTime& read_ht, CoarseTimePoint deadline);
 
@@ -134,11 +144,16 @@ class PgsqlReadOperation : public DocExprExecutor {
   // - Batch argument: The query condition is representd by many sets of values. For example, a
   //   batch protobuf will carry many ybctids.
   //     SELECT ... WHERE ybctid IN (y1, y2, y3)
+  //
+  // projection and index_projection should be created from PgsqlProjectionColumnIds of the
+  // request and of its index request.
   Result<size_t> Execute(const common::YQLStorageIf& ql_storage,
                          CoarseTimePoint deadline,
                          const ReadHybridTime& read_time,
                          const Schema& schema,
+                         const Schema& projection,
                          const Schema *index_schema,
+                         const Schema *index_projection,
                          faststring *result_buffer,
                          HybridTime *restart_read_ht);
 
@@ -152,7 +167,9 @@ class PgsqlReadOperation : public DocExprExecutor {
                                CoarseTimePoint deadline,
                                const ReadHybridTime& read_time,
                                const Schema& schema,
+                               const Schema& projection,
                                const Schema *index_schema,
+                               const Schema *index_projection,
                                int64_t batch_arg_index,
                                faststring *result_buffer,
                                HybridTime *restart_read_ht,
@@ -165,7 +182,9 @@ class PgsqlReadOperation : public DocExprExecutor {
                               CoarseTimePoint deadline,
                               const ReadHybridTime& read_time,
                               const Schema& schema,
+                              const Schema& projection,
                               const Schema *index_schema,
+                              const Schema *index_projection,
                               faststring *result_buffer,
                               HybridTime *restart_read_ht,
                               bool *has_paging_state);
@@ -175,6 +194,7 @@ class PgsqlReadOperation : public DocExprExecutor {
                                     CoarseTimePoint deadline,
                                     const ReadHybridTime& read_time,
                                     const Schema& schema,
+                                    const Schema& projection,
                                     faststring *result_buffer,
                                     HybridTime *restart_read_ht);
 
@@ -207,6 +227,13 @@ class PgsqlReadOperation : public DocExprExecutor {
   PgsqlResponsePB response_;
   common::YQLRowwiseIteratorIf::UniPtr table_iter_;
   common::YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // Reused across NextRowBatch calls to avoid reallocating rows for every batch.
+  std::vector<QLTableRow> row_batch_;
+
+  // Where condition compiled for evaluation over row_batch_, and the indexes of the matching rows.
+  CompiledPgsqlCondition compiled_where_;
+  std::vector<size_t> row_batch_selection_;
 };
 
 }  // namespace docdb
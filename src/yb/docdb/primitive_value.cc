@@ -58,6 +58,7 @@ using yb::util::DecodeDoubleFromKey;
     case ValueType::kMergeFlags: FALLTHROUGH_INTENDED; \
     case ValueType::kRowLock: FALLTHROUGH_INTENDED; \
     case ValueType::kBitSet: FALLTHROUGH_INTENDED; \
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED; \
     case ValueType::kGroupEnd: FALLTHROUGH_INTENDED; \
     case ValueType::kGroupEndDescending: FALLTHROUGH_INTENDED; \
     case ValueType::kInvalid: FALLTHROUGH_INTENDED; \
@@ -227,6 +228,7 @@ string PrimitiveValue::ToString() const {
     case ValueType::kMergeFlags: FALLTHROUGH_INTENDED;
     case ValueType::kRowLock: FALLTHROUGH_INTENDED;
     case ValueType::kBitSet: FALLTHROUGH_INTENDED;
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED;
     case ValueType::kGroupEnd: FALLTHROUGH_INTENDED;
     case ValueType::kGroupEndDescending: FALLTHROUGH_INTENDED;
     case ValueType::kTtl: FALLTHROUGH_INTENDED;
@@ -372,16 +374,16 @@ void PrimitiveValue::AppendToKey(KeyBytes* key_bytes) const {
     case ValueType::kTransactionId: FALLTHROUGH_INTENDED;
     case ValueType::kTableId: FALLTHROUGH_INTENDED;
     case ValueType::kUuid: {
-      std::string bytes;
-      uuid_val_.EncodeToComparable(&bytes);
-      key_bytes->AppendString(bytes);
+      uint8_t bytes[kUuidSize];
+      uuid_val_.EncodeToComparable(bytes);
+      key_bytes->AppendString(Slice(bytes, kUuidSize));
       return;
     }
 
     case ValueType::kUuidDescending: {
-      std::string bytes;
-      uuid_val_.EncodeToComparable(&bytes);
-      key_bytes->AppendDescendingString(bytes);
+      uint8_t bytes[kUuidSize];
+      uuid_val_.EncodeToComparable(bytes);
+      key_bytes->AppendDescendingString(Slice(bytes, kUuidSize));
       return;
     }
 
@@ -557,6 +559,7 @@ string PrimitiveValue::ToValue() const {
     case ValueType::kMergeFlags: FALLTHROUGH_INTENDED;
     case ValueType::kRowLock: FALLTHROUGH_INTENDED;
     case ValueType::kBitSet: FALLTHROUGH_INTENDED;
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED;
     case ValueType::kGroupEnd: FALLTHROUGH_INTENDED;
     case ValueType::kGroupEndDescending: FALLTHROUGH_INTENDED;
     case ValueType::kObsoleteIntentPrefix: FALLTHROUGH_INTENDED;
@@ -1146,6 +1149,7 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
     case ValueType::kMergeFlags: FALLTHROUGH_INTENDED;
     case ValueType::kRowLock: FALLTHROUGH_INTENDED;
     case ValueType::kBitSet: FALLTHROUGH_INTENDED;
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED;
     case ValueType::kTtl: FALLTHROUGH_INTENDED;
     case ValueType::kUserTimestamp: FALLTHROUGH_INTENDED;
     case ValueType::kColumnId: FALLTHROUGH_INTENDED;
@@ -1334,6 +1334,22 @@ Status RedisReadOperation::ExecuteHGetAllLikeCommands(ValueType value_type,
     data.count_only = !return_array_response;
   }
 
+  // Subkeys of hashes and sets are strings, so the page could be started from any of them.
+  const bool paged = return_array_response && request_.page_size() > 0 &&
+                     (value_type == ValueType::kObject || value_type == ValueType::kRedisSet);
+  KeyBytes low_subkey_bound;
+  SliceKeyBound low_subkey;
+  if (paged) {
+    if (request_.has_start_subkey()) {
+      low_subkey_bound = encoded_doc_key;
+      PrimitiveValue(request_.start_subkey()).AppendToKey(&low_subkey_bound);
+      low_subkey = SliceKeyBound(low_subkey_bound, LowerBound(false /* exclusive */));
+      data.low_subkey = &low_subkey;
+    }
+    // Read one more entry, to know whether there is a next page.
+    data.limit = request_.page_size() + 1;
+  }
+
   RETURN_NOT_OK(GetSubDocument(iterator_.get(), data, /* projection */ nullptr,
                                SeekFwdSuffices::kFalse));
   if (return_array_response)
@@ -1348,7 +1364,13 @@ Status RedisReadOperation::ExecuteHGetAllLikeCommands(ValueType value_type,
 
   if (VerifyTypeAndSetCode(value_type, doc.value_type(), &response_)) {
     if (return_array_response) {
-      RETURN_NOT_OK(PopulateResponseFrom(doc.object_container(), AddResponseValuesGeneric,
+      auto& container = doc.object_container();
+      if (paged && container.size() > static_cast<size_t>(request_.page_size())) {
+        auto last = std::prev(container.end());
+        response_.set_next_subkey(last->first.GetString());
+        container.erase(last);
+      }
+      RETURN_NOT_OK(PopulateResponseFrom(container, AddResponseValuesGeneric,
                                          &response_, add_keys, add_values));
     } else {
       int64_t card = has_cardinality_subkey ?
@@ -22,6 +22,7 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
@@ -33,6 +34,13 @@ using std::vector;
 using std::stack;
 using std::thread;
 
+// Lock manager metrics belong to the tablet entity, that is defined in the tablet library, which
+// is not linked into DocDB tests.
+METRIC_DEFINE_entity(tablet);
+
+METRIC_DECLARE_histogram(lock_manager_wait_time);
+METRIC_DECLARE_gauge_int64(lock_manager_waiters);
+
 namespace yb {
 namespace docdb {
 
@@ -184,5 +192,80 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+// Runs concurrent batches, that lock keys of many lock table shards, and checks lock wait metrics.
+TEST_F(SharedLockManagerTest, ConcurrentBatchesAcrossShards) {
+  constexpr int kNumKeys = 64;
+  constexpr int kThreads = 8;
+  constexpr int kIterations = 200;
+
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_tablet.Instantiate(&registry, "test-tablet");
+  lm_.SetMetricEntity(entity);
+  auto wait_time = METRIC_lock_manager_wait_time.Instantiate(entity);
+  auto waiters = METRIC_lock_manager_waiters.Instantiate(entity, 0);
+
+  // Batch of all keys, in the same order for all threads. So it spans all lock table shards, and
+  // batches could not deadlock.
+  const IntentTypeSet kStrongWrite({IntentType::kStrongWrite});
+  auto all_keys_batch = [kStrongWrite] {
+    LockBatchEntries result;
+    for (int i = 0; i != kNumKeys; ++i) {
+      result.push_back(LockBatchEntry{RefCntPrefix(Format("key_$0", i)), kStrongWrite});
+    }
+    return result;
+  };
+
+  {
+    LockBatch blocker(&lm_, all_keys_batch(), CoarseTimePoint::max());
+    ASSERT_OK(blocker.status());
+
+    std::vector<std::thread> threads;
+    std::atomic<int> locked{0};
+    for (int i = 0; i != kThreads; ++i) {
+      threads.emplace_back([this, &all_keys_batch, &locked] {
+        LockBatch lb(&lm_, all_keys_batch(), CoarseTimePoint::max());
+        CHECK_OK(lb.status());
+        locked.fetch_add(1, std::memory_order_acq_rel);
+      });
+    }
+
+    // Each thread blocks on the first key of its batch.
+    ASSERT_OK(WaitFor([&waiters] { return waiters->value() == kThreads; }, 10s, "All waiting"));
+    ASSERT_EQ(locked.load(std::memory_order_acquire), 0);
+    ASSERT_EQ(wait_time->TotalCount(), 0U);
+
+    blocker.Reset();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(locked.load(std::memory_order_acquire), kThreads);
+  }
+
+  // Each thread waited at least once, and all waits finished.
+  ASSERT_GE(wait_time->TotalCount(), static_cast<uint64_t>(kThreads));
+  ASSERT_EQ(waiters->value(), 0);
+
+  // Threads lock overlapping random subsets of keys, sorted the same way by all of them.
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kThreads; ++i) {
+    threads.emplace_back([this, kStrongWrite] {
+      for (int iteration = 0; iteration != kIterations; ++iteration) {
+        LockBatchEntries entries;
+        for (int key = 0; key != kNumKeys; ++key) {
+          if (RandomUniformInt(0, 3) == 0) {
+            entries.push_back(LockBatchEntry{RefCntPrefix(Format("key_$0", key)), kStrongWrite});
+          }
+        }
+        LockBatch lb(&lm_, std::move(entries), CoarseTimePoint::max());
+        CHECK_OK(lb.status());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(waiters->value(), 0);
+}
+
 } // namespace docdb
 } // namespace yb
@@ -21,12 +21,22 @@
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/thread.h"
 #include "yb/util/tostring.h"
 #include "yb/util/trace.h"
 
 using std::string;
 
+METRIC_DEFINE_histogram(
+    tablet, lock_manager_wait_time, "Key lock wait time", yb::MetricUnit::kMicroseconds,
+    "Time spent waiting for a conflicting key lock to be released", 60000000LU, 2);
+
+METRIC_DEFINE_gauge_int64(tablet, lock_manager_waiters, "Key lock waiters",
+                          yb::MetricUnit::kRequests,
+                          "Number of lock attempts currently waiting for a conflicting key lock");
+
 namespace yb {
 namespace docdb {
 
@@ -88,6 +98,19 @@ std::array<LockState, kIntentTypeSetMapSize> GenerateByMask(LockState single_int
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetAdd = GenerateByMask(1);
 
+// Number of independently locked shards of the lock table. Keys are distributed between shards by
+// hash, so batches locking unrelated keys do not contend on the same mutex.
+constexpr size_t kNumLockShards = 16;
+
+// Set of shards touched by a batch, bit i stands for the shard with index i.
+typedef uint32_t ShardMask;
+static_assert(kNumLockShards <= sizeof(ShardMask) * 8, "Too many lock shards for ShardMask");
+
+struct LockMetrics {
+  scoped_refptr<Histogram> wait_time;
+  scoped_refptr<AtomicGauge<int64_t>> waiters;
+};
+
 } // namespace
 
 bool IntentTypeSetsConflict(IntentTypeSet lhs, IntentTypeSet rhs) {
@@ -107,8 +130,11 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Index of the lock table shard this entry belongs to. Entries never move between shards.
+  const size_t shard_idx;
+
+  // Refcounting for garbage collection. Can only be used while the mutex of the shard that this
+  // entry belongs to is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -116,7 +142,10 @@ struct LockedBatchEntry {
 
   std::atomic<size_t> num_waiters{0};
 
-  MUST_USE_RESULT bool Lock(IntentTypeSet lock, CoarseTimePoint deadline);
+  explicit LockedBatchEntry(size_t shard_idx_) : shard_idx(shard_idx_) {}
+
+  MUST_USE_RESULT bool Lock(
+      IntentTypeSet lock, CoarseTimePoint deadline, const LockMetrics& metrics);
 
   void Unlock(IntentTypeSet lock);
 
@@ -133,29 +162,43 @@ class SharedLockManager::Impl {
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+    metrics_.wait_time = METRIC_lock_manager_wait_time.Instantiate(metric_entity);
+    metrics_.waiters = METRIC_lock_manager_waiters.Instantiate(metric_entity, 0);
+  }
+
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  struct LockShard {
+    // The shard mutex should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  };
+
+  // Make sure the entries exist in the locks map of the appropriate shard and return pointers so
+  // we can access them without holding the shard lock. Returns a vector with pointers in the same
+  // order as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  std::array<LockShard, kNumLockShards> shards_;
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  LockMetrics metrics_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -180,11 +223,18 @@ std::string SharedLockManager::ToString(const LockState& state) {
   return result;
 }
 
-bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
+bool LockedBatchEntry::Lock(
+    IntentTypeSet lock_type, CoarseTimePoint deadline, const LockMetrics& metrics) {
   size_t type_idx = lock_type.ToUIntPtr();
   auto& num_holding = this->num_holding;
   auto old_value = num_holding.load(std::memory_order_acquire);
   auto add = kIntentTypeSetAdd[type_idx];
+  CoarseTimePoint wait_start;
+  auto record_wait_time = ScopeExit([&wait_start, &metrics] {
+    if (wait_start != CoarseTimePoint() && metrics.wait_time) {
+      metrics.wait_time->Increment(MonoDelta(CoarseMonoClock::now() - wait_start).ToMicroseconds());
+    }
+  });
   for (;;) {
     if ((old_value & kIntentTypeSetConflicts[type_idx]) == 0) {
       auto new_value = old_value + add;
@@ -193,13 +243,19 @@ bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
       }
       continue;
     }
+    if (wait_start == CoarseTimePoint()) {
+      wait_start = CoarseMonoClock::now();
+    }
     num_waiters.fetch_add(1, std::memory_order_release);
-    auto se = ScopeExit([this] {
+    IncrementGauge(metrics.waiters);
+    auto se = ScopeExit([this, &metrics] {
+      DecrementGauge(metrics.waiters);
       num_waiters.fetch_sub(1, std::memory_order_release);
     });
     std::unique_lock<std::mutex> lock(mutex);
     old_value = num_holding.load(std::memory_order_acquire);
     if ((old_value & kIntentTypeSetConflicts[type_idx]) != 0) {
+      ScopedWaitState wait_state(WaitState::kLockManager);
       if (deadline != CoarseTimePoint::max()) {
         if (cond_var.wait_until(lock, deadline) == std::cv_status::timeout) {
           return false;
@@ -259,7 +315,7 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
     const auto intent_types = key_and_intent_type.intent_types;
     VLOG(4) << "Locking " << yb::ToString(intent_types) << ": "
             << key_and_intent_type.key.as_slice().ToDebugHexString();
-    if (!key_and_intent_type.locked->Lock(intent_types, deadline)) {
+    if (!key_and_intent_type.locked->Lock(intent_types, deadline, metrics_)) {
       while (it != key_to_intent_type->begin()) {
         --it;
         it->locked->Unlock(it->intent_types);
@@ -274,20 +330,40 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
-  for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
-    if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
-      } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+  // Each touched shard is locked once per batch, in shard index order, and entries of the batch
+  // that belong to it are reserved while it is locked.
+  std::vector<uint8_t> entry_shards(key_to_intent_type->size());
+  ShardMask touched_shards = 0;
+  for (size_t i = 0; i != key_to_intent_type->size(); ++i) {
+    const auto shard_idx = RefCntPrefixHash()((*key_to_intent_type)[i].key) % kNumLockShards;
+    entry_shards[i] = shard_idx;
+    touched_shards |= ShardMask(1) << shard_idx;
+  }
+
+  for (size_t shard_idx = 0; touched_shards; ++shard_idx, touched_shards >>= 1) {
+    if (!(touched_shards & 1)) {
+      continue;
+    }
+    auto& shard = shards_[shard_idx];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (size_t i = 0; i != key_to_intent_type->size(); ++i) {
+      if (entry_shards[i] != shard_idx) {
+        continue;
+      }
+      auto& key_and_intent_type = (*key_to_intent_type)[i];
+      auto& value = shard.locks[key_and_intent_type.key];
+      if (!value) {
+        if (!shard.free_lock_entries.empty()) {
+          value = shard.free_lock_entries.back();
+          shard.free_lock_entries.pop_back();
+        } else {
+          shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>(shard_idx));
+          value = shard.lock_entries.back().get();
+        }
       }
+      value->ref_count++;
+      key_and_intent_type.locked = value;
     }
-    value->ref_count++;
-    key_and_intent_type.locked = value;
   }
 }
 
@@ -302,11 +378,27 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  // Same as in Reserve, each touched shard is locked once. Shard of the entry does not change, so
+  // it could be read without the shard lock.
+  ShardMask touched_shards = 0;
   for (const auto& item : key_to_intent_type) {
-    if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+    touched_shards |= ShardMask(1) << item.locked->shard_idx;
+  }
+
+  for (size_t shard_idx = 0; touched_shards; ++shard_idx, touched_shards >>= 1) {
+    if (!(touched_shards & 1)) {
+      continue;
+    }
+    auto& shard = shards_[shard_idx];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (const auto& item : key_to_intent_type) {
+      if (item.locked->shard_idx != shard_idx) {
+        continue;
+      }
+      if (--(item.locked->ref_count) == 0) {
+        shard.locks.erase(item.key);
+        shard.free_lock_entries.push_back(item.locked);
+      }
     }
   }
 }
@@ -324,5 +416,9 @@ void SharedLockManager::Unlock(const LockBatchEntries& key_to_intent_type) {
   impl_->Unlock(key_to_intent_type);
 }
 
+void SharedLockManager::SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+  impl_->SetMetricEntity(metric_entity);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -22,10 +22,14 @@
 
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/lock_batch.h"
+#include "yb/gutil/ref_counted.h"
 #include "yb/gutil/spinlock.h"
 #include "yb/util/cross_thread_mutex.h"
 
 namespace yb {
+
+class MetricEntity;
+
 namespace docdb {
 
 // This class manages six types of locks on string keys. On each key, the possibilities are:
@@ -49,6 +53,10 @@ class SharedLockManager {
   // Release the batch of locks. Requires that the locks are held.
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  // Starts reporting lock wait time and number of waiters to the metric entity.
+  // Should be invoked before any lock is acquired.
+  void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity);
+
   // Whether or not the state is possible
   static std::string ToString(const LockState& state);
 
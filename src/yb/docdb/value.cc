@@ -15,6 +15,7 @@
 
 #include "yb/common/table_properties_constants.h"
 #include "yb/docdb/value.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/gutil/strings/substitute.h"
 
 namespace yb {
@@ -106,6 +107,11 @@ Status Value::DecodeControlFields(Slice* slice) {
 Status Value::Decode(const Slice& rocksdb_value) {
   Slice slice = rocksdb_value;
   RETURN_NOT_OK(DecodeControlFields(&slice));
+  if (slice.FirstByteOr(ValueTypeAsChar::kInvalid) == ValueTypeAsChar::kPackedRow) {
+    SetPackedRow(slice.ToBuffer());
+    return Status::OK();
+  }
+  packed_row_.clear();
   RETURN_NOT_OK_PREPEND(
       primitive_value_.DecodeFromValue(slice),
       Format("Failed to decode value in $0", rocksdb_value.ToDebugHexString()));
@@ -113,7 +119,8 @@ Status Value::Decode(const Slice& rocksdb_value) {
 }
 
 std::string Value::ToString() const {
-  std::string result = primitive_value_.ToString();
+  std::string result = value_type() == ValueType::kPackedRow ? PackedRowToString(packed_row_)
+                                                             : primitive_value_.ToString();
   if (merge_flags_) {
     result += Format("; merge flags: $0", merge_flags_);
   }
@@ -162,10 +169,12 @@ void Value::EncodeAndAppend(std::string *value_bytes, const Slice* external_valu
     value_bytes->push_back(ValueTypeAsChar::kUserTimestamp);
     util::AppendBigEndianUInt64(user_timestamp_, value_bytes);
   }
-  if (!external_value) {
-    value_bytes->append(primitive_value_.ToValue());
-  } else {
+  if (external_value) {
     value_bytes->append(external_value->cdata(), external_value->size());
+  } else if (value_type() == ValueType::kPackedRow) {
+    value_bytes->append(packed_row_);
+  } else {
+    value_bytes->append(primitive_value_.ToValue());
   }
 }
 
@@ -198,6 +207,12 @@ const string& Value::EncodedTombstone() {
   return kEncodedTombstone;
 }
 
+void Value::SetPackedRow(std::string packed_row) {
+  DCHECK(!packed_row.empty() && packed_row[0] == ValueTypeAsChar::kPackedRow);
+  primitive_value_ = PrimitiveValue(ValueType::kPackedRow);
+  packed_row_ = std::move(packed_row);
+}
+
 void Value::ClearIntentDocHt() {
   intent_doc_ht_ = DocHybridTime::kInvalid;
 }
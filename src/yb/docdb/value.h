@@ -71,6 +71,11 @@ class Value {
 
   const DocHybridTime& intent_doc_ht() const { return intent_doc_ht_; }
 
+  // Encoded packed row, valid only when value_type() is kPackedRow. See packed_row.h.
+  const std::string& packed_row() const { return packed_row_; }
+
+  void SetPackedRow(std::string packed_row);
+
   void ClearIntentDocHt();
 
   // Consume the merge_flags portion of the slice if it exists and return it.
@@ -151,6 +156,10 @@ class Value {
   // If this value was written using a transaction,
   // this field stores the original intent doc hybrid time.
   DocHybridTime intent_doc_ht_;
+
+  // Encoded packed row when primitive_value_ has kPackedRow type, empty otherwise. The packed row
+  // is not a primitive value, so it is kept in its encoded form.
+  std::string packed_row_;
 };
 
 }  // namespace docdb
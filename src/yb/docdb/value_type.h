@@ -123,6 +123,9 @@ namespace docdb {
     /* Indicator for whether an intent is for a row lock. */ \
     ((kRowLock, 'l'))  /* ASCII code 108 */ \
     ((kBitSet, 'm')) /* ASCII code 109 */ \
+    /* All non-key columns of a row version encoded into a single value at the DocKey level. */ \
+    /* See packed_row.h for the format. */ \
+    ((kPackedRow, 'p')) /* ASCII code 112 */ \
     /* Timestamp value in microseconds */ \
     ((kTimestamp, 's'))  /* ASCII code 115 */ \
     /* TTL value in milliseconds, optionally present at the start of a value. */ \
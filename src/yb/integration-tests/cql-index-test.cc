@@ -20,6 +20,7 @@ using namespace std::literals;
 
 DECLARE_bool(disable_index_backfill);
 DECLARE_int32(client_read_write_timeout_ms);
+DECLARE_int32(ql_index_write_max_flushes_in_flight);
 DECLARE_int32(rpc_workers_limit);
 DECLARE_uint64(transaction_manager_workers_limit);
 DECLARE_uint64(TEST_inject_txn_get_status_delay_ms);
@@ -148,4 +149,51 @@ TEST_F_EX(CqlIndexTest, ConcurrentIndexUpdate, CqlIndexSmallWorkersTest) {
   SetAtomicFlag(0, &FLAGS_TEST_inject_txn_get_status_delay_ms);
 }
 
+TEST_F(CqlIndexTest, NonTransactionalIndexBatching) {
+  constexpr int kThreads = 8;
+  constexpr int kRowsPerThread = 50;
+
+  // Make index updates of concurrent writes be collected while a flush is in progress.
+  FLAGS_ql_index_write_max_flushes_in_flight = 1;
+
+  auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+  ASSERT_OK(session.ExecuteQuery(
+      "CREATE TABLE t (key INT PRIMARY KEY, value INT) WITH transactions = { 'enabled' : false }"));
+  ASSERT_OK(session.ExecuteQuery(
+      "CREATE INDEX idx ON t (value) WITH transactions = "
+      "{ 'enabled' : false, 'consistency_level' : 'user_enforced' }"));
+
+  constexpr auto kNamespace = "test";
+  const client::YBTableName table_name(YQL_DATABASE_CQL, kNamespace, "t");
+  const client::YBTableName index_table_name(YQL_DATABASE_CQL, kNamespace, "idx");
+  auto perm = ASSERT_RESULT(client_->WaitUntilIndexPermissionsAtLeast(
+      table_name, index_table_name, IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE));
+  ASSERT_EQ(perm, IndexPermissions::INDEX_PERM_READ_WRITE_AND_DELETE);
+
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kThreads; ++i) {
+    thread_holder.AddThreadFunctor([this, i] {
+      auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+      auto prepared = ASSERT_RESULT(session.Prepare("INSERT INTO t (key, value) VALUES (?, ?)"));
+      for (int j = 0; j != kRowsPerThread; ++j) {
+        const cass_int32_t key = i * kRowsPerThread + j;
+        auto stmt = prepared.Bind();
+        stmt.Bind(0, key);
+        stmt.Bind(1, key * 10);
+        ASSERT_OK(session.Execute(stmt));
+      }
+    });
+  }
+  thread_holder.JoinAll();
+
+  for (cass_int32_t key = 0; key != kThreads * kRowsPerThread; ++key) {
+    auto result = ASSERT_RESULT(session.ExecuteWithResult(
+        Format("SELECT key FROM t WHERE value = $0", key * 10)));
+    auto iter = result.CreateIterator();
+    ASSERT_TRUE(iter.Next()) << "Key not found in index: " << key;
+    ASSERT_EQ(iter.Row().Value(0).As<cass_int32_t>(), key);
+    ASSERT_FALSE(iter.Next());
+  }
+}
+
 } // namespace yb
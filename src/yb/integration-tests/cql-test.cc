@@ -19,6 +19,7 @@
 using namespace std::literals;
 
 DECLARE_int64(cql_processors_limit);
+DECLARE_int32(cql_unprepared_statements_cache_size);
 
 namespace yb {
 
@@ -47,4 +48,27 @@ TEST_F(CqlTest, ProcessorsLimit) {
   ASSERT_TRUE(has_failures);
 }
 
+TEST_F(CqlTest, UnpreparedStatementsCache) {
+  FLAGS_cql_unprepared_statements_cache_size = 2;
+
+  auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+  ASSERT_OK(session.ExecuteQuery("CREATE TABLE t (key INT PRIMARY KEY, v1 INT)"));
+
+  const std::string kSelect = "SELECT * FROM t WHERE key = 1";
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_OK(session.ExecuteQuery(Format("INSERT INTO t (key, v1) VALUES (1, $0)", i)));
+    ASSERT_OK(session.ExecuteAndProcessOneRow(kSelect, [i](const CassandraRow& row) {
+      ASSERT_EQ(row.Value(1).As<cass_int32_t>(), i);
+    }));
+  }
+
+  // Cached statement should be replaced after schema change.
+  ASSERT_OK(session.ExecuteQuery("ALTER TABLE t ADD v2 INT"));
+  ASSERT_OK(session.ExecuteQuery("UPDATE t SET v2 = 4 WHERE key = 1"));
+  ASSERT_OK(session.ExecuteAndProcessOneRow(kSelect, [](const CassandraRow& row) {
+    ASSERT_EQ(row.Value(1).As<cass_int32_t>(), 3);
+    ASSERT_EQ(row.Value(2).As<cass_int32_t>(), 4);
+  }));
+}
+
 } // namespace yb
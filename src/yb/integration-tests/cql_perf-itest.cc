@@ -0,0 +1,182 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Performance workloads of YCQL, see PerfReport for how results are reported and compared against
+// baselines.
+
+#include <cassandra.h>
+
+#include "yb/integration-tests/cql_test_util.h"
+#include "yb/integration-tests/external_mini_cluster-itest-base.h"
+#include "yb/integration-tests/perf_report.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+
+using namespace std::literals;
+
+namespace yb {
+
+namespace {
+
+constexpr size_t kNumThreads = 16;
+constexpr int kNumKeys = 100000;
+constexpr int kNumScanPartitions = 100;
+constexpr int kRowsPerScanPartition = 1000;
+// Number of keys updated by contended transactions.
+constexpr int kNumHotKeys = 10;
+
+struct ThreadSession {
+  CassandraSession session;
+  CassandraPrepared statement;
+};
+
+} // namespace
+
+class CqlPerfTest : public ExternalMiniClusterITestBase {
+ public:
+  void SetUp() override {
+    ASSERT_NO_FATALS(ExternalMiniClusterITestBase::SetUp());
+    if (!PerfTestsEnabled()) {
+      LOG(INFO) << "Skipping performance test, use --run_perf_tests to run it";
+      return;
+    }
+    ASSERT_NO_FATALS(StartCluster(PerfClusterTServerFlags()));
+
+    std::vector<std::string> hosts;
+    for (int i = 0; i < cluster_->num_tablet_servers(); ++i) {
+      hosts.push_back(cluster_->tablet_server(i)->bind_host());
+    }
+    driver_ = std::make_unique<CppCassandraDriver>(
+        hosts, cluster_->tablet_server(0)->cql_rpc_port(), true /* use_partition_aware_routing */);
+    ASSERT_OK(WaitFor([this] {
+      auto session = EstablishSession(driver_.get());
+      if (!session.ok()) {
+        return false;
+      }
+      session_ = std::move(*session);
+      return true;
+    }, 60s, "Establish session"));
+  }
+
+  void SetUpCluster(ExternalMiniClusterOptions* opts) override {
+    ASSERT_NO_FATALS(ExternalMiniClusterITestBase::SetUpCluster(opts));
+    opts->bind_to_unique_loopback_addresses = true;
+  }
+
+  void TearDown() override {
+    driver_.reset();
+    ExternalMiniClusterITestBase::TearDown();
+  }
+
+ protected:
+  // Creates a session for each workload thread, with the specified statement prepared.
+  Result<std::vector<ThreadSession>> PrepareSessions(const std::string& statement) {
+    std::vector<ThreadSession> result(kNumThreads);
+    for (auto& thread_session : result) {
+      thread_session.session = VERIFY_RESULT(EstablishSession(driver_.get()));
+      thread_session.statement = VERIFY_RESULT(thread_session.session.Prepare(statement));
+    }
+    return result;
+  }
+
+  std::unique_ptr<CppCassandraDriver> driver_;
+  CassandraSession session_;
+};
+
+TEST_F(CqlPerfTest, PointOps) {
+  if (!PerfTestsEnabled()) {
+    return;
+  }
+  ASSERT_OK(session_.ExecuteQuery("CREATE TABLE kv (k INT PRIMARY KEY, v TEXT)"));
+  const std::string value(100, 'v');
+  PerfReport report("cql_point_ops");
+
+  auto sessions = ASSERT_RESULT(PrepareSessions("INSERT INTO kv (k, v) VALUES (?, ?)"));
+  report.Add(RunPerfWorkload("cql_point_write", kNumThreads, [&sessions, &value](size_t idx) {
+    auto statement = sessions[idx].statement.Bind();
+    statement.Bind(0, static_cast<cass_int32_t>(RandomUniformInt(0, kNumKeys - 1)));
+    statement.Bind(1, value);
+    return sessions[idx].session.Execute(statement);
+  }));
+
+  sessions = ASSERT_RESULT(PrepareSessions("SELECT v FROM kv WHERE k = ?"));
+  report.Add(RunPerfWorkload("cql_point_read", kNumThreads, [&sessions](size_t idx) {
+    auto statement = sessions[idx].statement.Bind();
+    statement.Bind(0, static_cast<cass_int32_t>(RandomUniformInt(0, kNumKeys - 1)));
+    auto result = sessions[idx].session.ExecuteWithResult(statement);
+    return result.ok() ? Status::OK() : result.status();
+  }));
+
+  ASSERT_OK(report.Finish());
+}
+
+TEST_F(CqlPerfTest, Scan) {
+  if (!PerfTestsEnabled()) {
+    return;
+  }
+  ASSERT_OK(session_.ExecuteQuery(
+      "CREATE TABLE scan (h INT, r INT, v TEXT, PRIMARY KEY ((h), r))"));
+  auto insert = ASSERT_RESULT(session_.Prepare("INSERT INTO scan (h, r, v) VALUES (?, ?, ?)"));
+  const std::string value(100, 'v');
+  for (int h = 0; h != kNumScanPartitions; ++h) {
+    CassandraBatch batch(CASS_BATCH_TYPE_LOGGED);
+    for (int r = 0; r != kRowsPerScanPartition; ++r) {
+      auto statement = insert.Bind();
+      statement.Bind(0, static_cast<cass_int32_t>(h));
+      statement.Bind(1, static_cast<cass_int32_t>(r));
+      statement.Bind(2, value);
+      batch.Add(&statement);
+    }
+    ASSERT_OK(session_.ExecuteBatch(batch));
+  }
+
+  PerfReport report("cql_scan");
+  auto sessions = ASSERT_RESULT(PrepareSessions("SELECT r, v FROM scan WHERE h = ?"));
+  report.Add(RunPerfWorkload("cql_partition_scan", kNumThreads, [&sessions](size_t idx) {
+    auto statement = sessions[idx].statement.Bind();
+    statement.Bind(0, static_cast<cass_int32_t>(RandomUniformInt(0, kNumScanPartitions - 1)));
+    auto result = sessions[idx].session.ExecuteWithResult(statement);
+    return result.ok() ? Status::OK() : result.status();
+  }));
+
+  ASSERT_OK(report.Finish());
+}
+
+TEST_F(CqlPerfTest, ContendedTransactions) {
+  if (!PerfTestsEnabled()) {
+    return;
+  }
+  ASSERT_OK(session_.ExecuteQuery(
+      "CREATE TABLE txn_kv (k INT PRIMARY KEY, v INT) WITH transactions = { 'enabled' : true }"));
+
+  PerfReport report("cql_contended_transactions");
+  auto sessions = ASSERT_RESULT(PrepareSessions(
+      "BEGIN TRANSACTION "
+      "INSERT INTO txn_kv (k, v) VALUES (?, ?); "
+      "INSERT INTO txn_kv (k, v) VALUES (?, ?); "
+      "END TRANSACTION;"));
+  report.Add(RunPerfWorkload("cql_contended_txn", kNumThreads, [&sessions](size_t idx) {
+    auto statement = sessions[idx].statement.Bind();
+    const auto value = static_cast<cass_int32_t>(RandomUniformInt(0, 1000000));
+    statement.Bind(0, static_cast<cass_int32_t>(RandomUniformInt(0, kNumHotKeys - 1)));
+    statement.Bind(1, value);
+    statement.Bind(2, static_cast<cass_int32_t>(RandomUniformInt(0, kNumHotKeys - 1)));
+    statement.Bind(3, value);
+    return sessions[idx].session.Execute(statement);
+  }));
+
+  ASSERT_OK(report.Finish());
+}
+
+} // namespace yb
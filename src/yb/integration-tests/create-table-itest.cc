@@ -62,6 +62,8 @@ METRIC_DECLARE_entity(tablet);
 METRIC_DECLARE_gauge_int64(is_raft_leader);
 METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerAdminService_CreateTablet);
 METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerAdminService_DeleteTablet);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerAdminService_CreateTablets);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerAdminService_DeleteTablets);
 
 namespace yb {
 
@@ -89,6 +91,16 @@ class CreateTableITest : public ExternalMiniClusterITestBase {
         .wait(true)
         .Create();
   }
+
+  // Returns the number of RPCs handled by the tablet server, including batched ones.
+  Result<int64_t> GetNumRpcs(int ts_idx, const MetricPrototype* single,
+                             const MetricPrototype* batched) {
+    auto* ts = cluster_->tablet_server(ts_idx);
+    return VERIFY_RESULT(ts->GetInt64Metric(
+               &METRIC_ENTITY_server, "yb.tabletserver", single, "total_count")) +
+           VERIFY_RESULT(ts->GetInt64Metric(
+               &METRIC_ENTITY_server, "yb.tabletserver", batched, "total_count"));
+  }
 };
 
 // TODO(bogdan): disabled until ENG-2687
@@ -201,11 +213,9 @@ TEST_F(CreateTableITest, TestCreateWhenMajorityOfReplicasFailCreation) {
   int64_t num_create_attempts = 0;
   while (num_create_attempts < 3) {
     SleepFor(MonoDelta::FromMilliseconds(100));
-    num_create_attempts = ASSERT_RESULT(cluster_->tablet_server(0)->GetInt64Metric(
-        &METRIC_ENTITY_server,
-        "yb.tabletserver",
-        &METRIC_handler_latency_yb_tserver_TabletServerAdminService_CreateTablet,
-        "total_count"));
+    num_create_attempts = ASSERT_RESULT(GetNumRpcs(
+        0, &METRIC_handler_latency_yb_tserver_TabletServerAdminService_CreateTablet,
+        &METRIC_handler_latency_yb_tserver_TabletServerAdminService_CreateTablets));
     LOG(INFO) << "Waiting for the master to retry creating the tablet 3 times... "
               << num_create_attempts << " RPCs seen so far";
 
@@ -325,6 +335,47 @@ TEST_F(CreateTableITest, TestSpreadReplicasEvenly) {
   ASSERT_GE(avg_num_peers, kNumServers / 2);
 }
 
+// Check that replicas of a table with many tablets are created and deleted with batched RPCs.
+TEST_F(CreateTableITest, TestBatchedCreateAndDeleteReplicas) {
+  const int kNumServers = 3;
+  const int kNumTablets = 24;
+  vector<string> ts_flags;
+  vector<string> master_flags;
+  master_flags.push_back("--ts_admin_rpc_batch_window_ms=100");
+  master_flags.push_back("--ts_admin_rpc_batch_max_size=1000");
+  ASSERT_NO_FATALS(StartCluster(ts_flags, master_flags, kNumServers));
+
+  ASSERT_OK(client_->CreateNamespaceIfNotExists(kTableName.namespace_name(),
+                                                kTableName.namespace_type()));
+  std::unique_ptr<client::YBTableCreator> table_creator(client_->NewTableCreator());
+  client::YBSchema client_schema(client::YBSchemaFromSchema(GetSimpleTestSchema()));
+  ASSERT_OK(table_creator->table_name(kTableName)
+            .schema(&client_schema)
+            .num_tablets(kNumTablets)
+            .Create());
+
+  for (int ts_idx = 0; ts_idx != kNumServers; ++ts_idx) {
+    ASSERT_EQ(kNumTablets, inspect_->ListTabletsWithDataOnTS(ts_idx).size());
+    auto num_create_rpcs = ASSERT_RESULT(GetNumRpcs(
+        ts_idx, &METRIC_handler_latency_yb_tserver_TabletServerAdminService_CreateTablet,
+        &METRIC_handler_latency_yb_tserver_TabletServerAdminService_CreateTablets));
+    LOG(INFO) << "TS " << ts_idx << " handled " << num_create_rpcs << " create tablet RPCs";
+    ASSERT_LT(num_create_rpcs, kNumTablets);
+  }
+
+  ASSERT_OK(client_->DeleteTable(kTableName));
+  for (int ts_idx = 0; ts_idx != kNumServers; ++ts_idx) {
+    ASSERT_OK(WaitFor([this, ts_idx] {
+      return inspect_->ListTabletsWithDataOnTS(ts_idx).empty();
+    }, MonoDelta::FromSeconds(30), "Wait for tablets to be deleted"));
+    auto num_delete_rpcs = ASSERT_RESULT(GetNumRpcs(
+        ts_idx, &METRIC_handler_latency_yb_tserver_TabletServerAdminService_DeleteTablet,
+        &METRIC_handler_latency_yb_tserver_TabletServerAdminService_DeleteTablets));
+    LOG(INFO) << "TS " << ts_idx << " handled " << num_delete_rpcs << " delete tablet RPCs";
+    ASSERT_LT(num_delete_rpcs, kNumTablets);
+  }
+}
+
 TEST_F(CreateTableITest, TestNoAllocBlacklist) {
   const int kNumServers = 4;
   const int kNumTablets = 24;
@@ -0,0 +1,252 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/integration-tests/perf_report.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+#include <gflags/gflags.h>
+
+#include "yb/util/env.h"
+#include "yb/util/faststring.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/jsonreader.h"
+#include "yb/util/jsonwriter.h"
+#include "yb/util/path_util.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DEFINE_bool(run_perf_tests, false,
+            "Performance tests are skipped unless this flag is set. They run fixed time workloads "
+            "on a cluster and only fail on regression against a baseline, so they are not run "
+            "with regular tests.");
+
+DEFINE_int32(perf_workload_warmup_sec, 5,
+             "Time each performance workload runs before its ops are measured.");
+
+DEFINE_int32(perf_workload_duration_sec, 30,
+             "Time each performance workload is measured.");
+
+DEFINE_string(perf_report_dir, "",
+              "If set, performance tests write reports with results of their workloads to this "
+              "directory.");
+
+DEFINE_string(perf_baseline_dir, "",
+              "If set, performance tests compare results of their workloads against baseline "
+              "reports from this directory, and fail when a workload regressed.");
+
+DEFINE_double(perf_regression_threshold, 0.2,
+              "Performance workload is considered regressed when its throughput is lower, or its "
+              "p99 latency is higher than in the baseline by more than this fraction.");
+
+namespace yb {
+
+namespace {
+
+// Latencies above this value are recorded as this value.
+constexpr uint64_t kMaxTrackedLatencyUs = 60000000;
+
+} // namespace
+
+bool PerfTestsEnabled() {
+  return FLAGS_run_perf_tests;
+}
+
+std::vector<std::string> PerfClusterTServerFlags() {
+  return {
+    "--memory_limit_hard_bytes=2147483648",
+    "--db_block_cache_size_bytes=268435456",
+    "--num_reactor_threads=4",
+    "--yb_num_shards_per_tserver=2",
+    "--ysql_num_shards_per_tserver=2",
+  };
+}
+
+std::string PerfWorkloadResult::ToString() const {
+  return Format(
+      "{ name: $0 ops: $1 errors: $2 duration: $3 ops_per_sec: $4 latency_us: { mean: $5 "
+      "p50: $6 p95: $7 p99: $8 p999: $9 max: $10 } }",
+      name, ops, errors, duration, ops_per_sec, latency_mean_us, latency_p50_us, latency_p95_us,
+      latency_p99_us, latency_p999_us, latency_max_us);
+}
+
+PerfWorkloadResult RunPerfWorkload(
+    const std::string& name, size_t num_threads, const PerfOp& op) {
+  HdrHistogram latency(kMaxTrackedLatencyUs, 2);
+  std::atomic<uint64_t> ops{0};
+  std::atomic<uint64_t> errors{0};
+  const auto measure_start = CoarseMonoClock::now() + FLAGS_perf_workload_warmup_sec * 1s;
+
+  LOG(INFO) << "Running workload " << name << " with " << num_threads << " threads";
+  TestThreadHolder thread_holder;
+  for (size_t thread_idx = 0; thread_idx != num_threads; ++thread_idx) {
+    thread_holder.AddThreadFunctor(
+        [&stop = thread_holder.stop_flag(), &op, &latency, &ops, &errors, measure_start,
+         thread_idx] {
+      while (!stop.load(std::memory_order_acquire)) {
+        const auto start = CoarseMonoClock::now();
+        auto status = op(thread_idx);
+        const auto finish = CoarseMonoClock::now();
+        if (start < measure_start) {
+          continue;
+        }
+        if (status.ok()) {
+          ops.fetch_add(1, std::memory_order_relaxed);
+          latency.Increment(std::min<uint64_t>(
+              MonoDelta(finish - start).ToMicroseconds(), kMaxTrackedLatencyUs));
+        } else {
+          YB_LOG_EVERY_N_SECS(WARNING, 1) << "Op failed: " << status;
+          errors.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  thread_holder.WaitAndStop(
+      (FLAGS_perf_workload_warmup_sec + FLAGS_perf_workload_duration_sec) * 1s);
+
+  PerfWorkloadResult result;
+  result.name = name;
+  result.ops = ops.load();
+  result.errors = errors.load();
+  result.duration = CoarseMonoClock::now() - measure_start;
+  result.ops_per_sec = result.duration.ToMicroseconds() > 0
+      ? result.ops * 1000000 / result.duration.ToMicroseconds()
+      : 0;
+  result.latency_mean_us = static_cast<uint64_t>(latency.MeanValue());
+  result.latency_p50_us = latency.ValueAtPercentile(50);
+  result.latency_p95_us = latency.ValueAtPercentile(95);
+  result.latency_p99_us = latency.ValueAtPercentile(99);
+  result.latency_p999_us = latency.ValueAtPercentile(99.9);
+  result.latency_max_us = latency.MaxValue();
+  LOG(INFO) << "Workload result: " << result.ToString();
+  return result;
+}
+
+PerfReport::PerfReport(std::string name) : name_(std::move(name)) {
+}
+
+void PerfReport::Add(PerfWorkloadResult result) {
+  results_.push_back(std::move(result));
+}
+
+std::string PerfReport::ToJson() const {
+  std::stringstream out;
+  JsonWriter writer(&out, JsonWriter::PRETTY);
+  writer.StartObject();
+  writer.String("workloads");
+  writer.StartArray();
+  for (const auto& result : results_) {
+    writer.StartObject();
+    writer.String("name");
+    writer.String(result.name);
+    writer.String("ops");
+    writer.Uint64(result.ops);
+    writer.String("errors");
+    writer.Uint64(result.errors);
+    writer.String("duration_us");
+    writer.Int64(result.duration.ToMicroseconds());
+    writer.String("ops_per_sec");
+    writer.Uint64(result.ops_per_sec);
+    writer.String("latency_us");
+    writer.StartObject();
+    writer.String("mean");
+    writer.Uint64(result.latency_mean_us);
+    writer.String("p50");
+    writer.Uint64(result.latency_p50_us);
+    writer.String("p95");
+    writer.Uint64(result.latency_p95_us);
+    writer.String("p99");
+    writer.Uint64(result.latency_p99_us);
+    writer.String("p999");
+    writer.Uint64(result.latency_p999_us);
+    writer.String("max");
+    writer.Uint64(result.latency_max_us);
+    writer.EndObject();
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return out.str();
+}
+
+Status PerfReport::Finish() const {
+  const auto file_name = name_ + ".json";
+  if (!FLAGS_perf_report_dir.empty()) {
+    auto* env = Env::Default();
+    RETURN_NOT_OK(env->CreateDirs(FLAGS_perf_report_dir));
+    const auto path = JoinPathSegments(FLAGS_perf_report_dir, file_name);
+    RETURN_NOT_OK(WriteStringToFile(env, ToJson(), path));
+    LOG(INFO) << "Performance report written to " << path;
+  }
+  if (!FLAGS_perf_baseline_dir.empty()) {
+    const auto path = JoinPathSegments(FLAGS_perf_baseline_dir, file_name);
+    if (!Env::Default()->FileExists(path)) {
+      LOG(WARNING) << "No performance baseline at " << path;
+      return Status::OK();
+    }
+    return CompareWithBaseline(path);
+  }
+  return Status::OK();
+}
+
+Status PerfReport::CompareWithBaseline(const std::string& path) const {
+  faststring text;
+  RETURN_NOT_OK(ReadFileToString(Env::Default(), path, &text));
+  JsonReader reader(text.ToString());
+  RETURN_NOT_OK(reader.Init());
+  std::vector<const rapidjson::Value*> workloads;
+  RETURN_NOT_OK(reader.ExtractObjectArray(reader.root(), "workloads", &workloads));
+
+  const auto threshold = FLAGS_perf_regression_threshold;
+  std::vector<std::string> regressions;
+  for (const auto* workload : workloads) {
+    std::string name;
+    RETURN_NOT_OK(reader.ExtractString(workload, "name", &name));
+    auto it = std::find_if(results_.begin(), results_.end(), [&name](const auto& result) {
+      return result.name == name;
+    });
+    if (it == results_.end()) {
+      LOG(WARNING) << "Workload " << name << " from baseline was not run";
+      continue;
+    }
+    int64_t ops_per_sec;
+    RETURN_NOT_OK(reader.ExtractInt64(workload, "ops_per_sec", &ops_per_sec));
+    const rapidjson::Value* latency;
+    RETURN_NOT_OK(reader.ExtractObject(workload, "latency_us", &latency));
+    int64_t p99;
+    RETURN_NOT_OK(reader.ExtractInt64(latency, "p99", &p99));
+
+    LOG(INFO) << "Workload " << name << ": ops_per_sec " << it->ops_per_sec << " vs "
+              << ops_per_sec << " in baseline, p99 latency " << it->latency_p99_us << "us vs "
+              << p99 << "us in baseline";
+    if (it->ops_per_sec < ops_per_sec * (1.0 - threshold)) {
+      regressions.push_back(Format(
+          "$0 throughput $1 ops/sec, baseline $2 ops/sec", name, it->ops_per_sec, ops_per_sec));
+    }
+    if (it->latency_p99_us > p99 * (1.0 + threshold)) {
+      regressions.push_back(Format(
+          "$0 p99 latency $1us, baseline $2us", name, it->latency_p99_us, p99));
+    }
+  }
+
+  if (!regressions.empty()) {
+    return STATUS_FORMAT(
+        IllegalState, "Performance regressed against $0: $1", path, regressions);
+  }
+  return Status::OK();
+}
+
+} // namespace yb
@@ -0,0 +1,89 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_INTEGRATION_TESTS_PERF_REPORT_H
+#define YB_INTEGRATION_TESTS_PERF_REPORT_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "yb/util/monotime.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+// Returns true when performance tests should run, i.e. run_perf_tests is set. Fixtures of
+// performance tests do not start a cluster and their tests return immediately otherwise.
+bool PerfTestsEnabled();
+
+// Tablet server flags, that pin resources used by a cluster in performance tests. So results do
+// not depend on the number of cores and memory of the test machine.
+std::vector<std::string> PerfClusterTServerFlags();
+
+// Throughput and latency of a performance workload. Latencies are in microseconds, and only
+// include successful ops.
+struct PerfWorkloadResult {
+  std::string name;
+  uint64_t ops = 0;
+  uint64_t errors = 0;
+  MonoDelta duration;
+  uint64_t ops_per_sec = 0;
+  uint64_t latency_mean_us = 0;
+  uint64_t latency_p50_us = 0;
+  uint64_t latency_p95_us = 0;
+  uint64_t latency_p99_us = 0;
+  uint64_t latency_p999_us = 0;
+  uint64_t latency_max_us = 0;
+
+  std::string ToString() const;
+};
+
+// Performs one op of a workload in the specified thread. Failed ops are counted as errors, e.g.
+// transaction conflicts under contention, and do not stop the workload.
+typedef std::function<Status(size_t thread_idx)> PerfOp;
+
+// Runs op from num_threads threads, for perf_workload_warmup_sec and then for
+// perf_workload_duration_sec seconds. Only ops performed after the warmup are measured.
+PerfWorkloadResult RunPerfWorkload(const std::string& name, size_t num_threads, const PerfOp& op);
+
+// Collects results of workloads run by a test, writes them as JSON to
+// perf_report_dir/<report name>.json, and compares them against the baseline report with the same
+// name in perf_baseline_dir. Report has the following format:
+// {"workloads": [{"name": "cql_point_read", "ops": 1000, "errors": 0, "duration_us": 1000000,
+//                 "ops_per_sec": 1000, "latency_us": {"mean": 950, "p50": 900, "p95": 1500,
+//                 "p99": 2000, "p999": 3000, "max": 5000}}]}
+// So a baseline is just a report of an earlier run, that is stored with the sources.
+class PerfReport {
+ public:
+  explicit PerfReport(std::string name);
+
+  void Add(PerfWorkloadResult result);
+
+  // Writes the report and compares it against the baseline, when the corresponding dirs are set.
+  // Returns error if a workload is slower than its baseline by more than
+  // perf_regression_threshold, in throughput or p99 latency.
+  CHECKED_STATUS Finish() const;
+
+  std::string ToJson() const;
+
+ private:
+  CHECKED_STATUS CompareWithBaseline(const std::string& path) const;
+
+  const std::string name_;
+  std::vector<PerfWorkloadResult> results_;
+};
+
+} // namespace yb
+
+#endif // YB_INTEGRATION_TESTS_PERF_REPORT_H
@@ -86,11 +86,13 @@ DECLARE_int32(leader_lease_duration_ms);
 DECLARE_int32(ht_lease_duration_ms);
 DECLARE_int32(rpc_timeout);
 
+METRIC_DECLARE_entity(server);
 METRIC_DECLARE_entity(tablet);
 METRIC_DECLARE_counter(not_leader_rejections);
 METRIC_DECLARE_gauge_int64(raft_term);
 METRIC_DECLARE_counter(log_cache_disk_reads);
 METRIC_DECLARE_gauge_int64(log_cache_num_ops);
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus);
 
 namespace yb {
 namespace tserver {
@@ -516,6 +518,33 @@ TEST_F(RaftConsensusITest, TestInsertAndMutateThroughConsensus) {
   ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread * num_iters);
 }
 
+// Heartbeats are sent through MultiRaftUpdateConsensus, and replication keeps working with them.
+TEST_F(RaftConsensusITest, BatchedHeartbeats) {
+  ASSERT_NO_FATALS(BuildAndStart(vector<string>()));
+
+  auto count_batched_updates = [this]() -> Result<int64_t> {
+    int64_t result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      result += VERIFY_RESULT(cluster_->tablet_server(i)->GetInt64Metric(
+          &METRIC_ENTITY_server, "yb.tabletserver",
+          &METRIC_handler_latency_yb_consensus_ConsensusService_MultiRaftUpdateConsensus,
+          "total_count"));
+    }
+    return result;
+  };
+
+  ASSERT_OK(WaitFor(
+      [&count_batched_updates]() -> Result<bool> {
+        return VERIFY_RESULT(count_batched_updates()) > 0;
+      },
+      30s, "Batched heartbeats"));
+
+  ASSERT_NO_FATALS(InsertTestRowsRemoteThread(
+      0, FLAGS_client_inserts_per_thread, FLAGS_client_num_batches_per_thread,
+      vector<CountDownLatch*>()));
+  ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread);
+}
+
 TEST_F(RaftConsensusITest, TestFailedOperation) {
   ASSERT_NO_FATALS(BuildAndStart(vector<string>()));
 
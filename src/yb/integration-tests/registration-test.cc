@@ -30,7 +30,9 @@
 // under the License.
 //
 
+#include <limits>
 #include <memory>
+#include <set>
 #include <string>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
@@ -41,6 +43,7 @@
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/integration-tests/mini_cluster.h"
 #include "yb/integration-tests/yb_mini_cluster_test_base.h"
+#include "yb/master/catalog_manager.h"
 #include "yb/master/mini_master.h"
 #include "yb/master/master.h"
 #include "yb/master/master.pb.h"
@@ -58,6 +61,7 @@
 DECLARE_int32(heartbeat_interval_ms);
 DECLARE_int32(yb_num_shards_per_tserver);
 DECLARE_bool(enable_ysql);
+DECLARE_int32(master_table_locations_cache_max_entries);
 
 METRIC_DECLARE_counter(rows_inserted);
 
@@ -65,7 +69,10 @@ namespace yb {
 
 using std::vector;
 using std::shared_ptr;
+using master::GetTableLocationsRequestPB;
+using master::GetTableLocationsResponsePB;
 using master::MiniMaster;
+using master::TableIdentifierPB;
 using master::TSDescriptor;
 using master::TabletLocationsPB;
 using tserver::MiniTabletServer;
@@ -210,6 +217,32 @@ class RegistrationTest : public YBMiniClusterTestBase<MiniCluster> {
     // the TS, and verifies that the master notices the issue.
   }
 
+  CHECKED_STATUS GetTableLocations(
+      const TableIdentifierPB& table, GetTableLocationsResponsePB* resp) {
+    GetTableLocationsRequestPB req;
+    *req.mutable_table() = table;
+    req.set_max_returned_locations(std::numeric_limits<int32_t>::max());
+    resp->Clear();
+    return cluster_->mini_master()->master()->catalog_manager()->GetTableLocations(&req, resp);
+  }
+
+  // Waits until locations of the table, that could be served from the master cache, match
+  // the locations built with cache disabled. Locations could change in between, so we have to
+  // wait instead of comparing once.
+  CHECKED_STATUS WaitTableLocationsMatch(
+      const TableIdentifierPB& table, GetTableLocationsResponsePB* resp) {
+    return WaitFor([this, &table, resp]() -> Result<bool> {
+      RETURN_NOT_OK(GetTableLocations(table, resp));
+      GetTableLocationsResponsePB uncached;
+      {
+        google::FlagSaver flag_saver;
+        FLAGS_master_table_locations_cache_max_entries = 0;
+        RETURN_NOT_OK(GetTableLocations(table, &uncached));
+      }
+      return resp->ShortDebugString() == uncached.ShortDebugString();
+    }, MonoDelta::FromSeconds(10), "Table locations match");
+  }
+
  protected:
   Schema schema_;
 };
@@ -261,4 +294,98 @@ TEST_F(RegistrationTest, TestCopartitionedTables) {
   CheckTabletReports(/* co_partition */ true);
 }
 
+// Checks that GetTableLocations responses cached by the master are refreshed after the tables
+// and tablets they cover are created, altered and deleted.
+TEST_F(RegistrationTest, TableLocationsCache) {
+  FLAGS_yb_num_shards_per_tserver = 2;
+  ASSERT_OK(cluster_->WaitForTabletServerCount(1));
+
+  string tablet_id;
+  string table_id;
+  CreateTabletForTesting(cluster_->mini_master(),
+                         YBTableName(YQL_DATABASE_CQL, "my_keyspace", "fake-table"),
+                         schema_,
+                         &tablet_id,
+                         &table_id);
+  TabletLocationsPB locs;
+  ASSERT_OK(cluster_->WaitForReplicaCount(tablet_id, 1, &locs));
+
+  TableIdentifierPB table;
+  table.set_table_id(table_id);
+  GetTableLocationsResponsePB resp;
+  ASSERT_OK(WaitTableLocationsMatch(table, &resp));
+  ASSERT_EQ(FLAGS_yb_num_shards_per_tserver, resp.tablet_locations_size());
+  // Response is cached now, so the following changes should invalidate it.
+  ASSERT_OK(GetTableLocations(table, &resp));
+
+  // Copartitioned table is added to table ids of existing tablets.
+  Schema copartitioned_schema(schema_);
+  copartitioned_schema.SetCopartitionTableId(table_id);
+  string copartitioned_tablet_id;
+  string copartitioned_table_id;
+  CreateTabletForTesting(cluster_->mini_master(),
+                         YBTableName(YQL_DATABASE_CQL, "my_keyspace", "fake-table2"),
+                         copartitioned_schema,
+                         &copartitioned_tablet_id,
+                         &copartitioned_table_id);
+  ASSERT_OK(WaitTableLocationsMatch(table, &resp));
+  ASSERT_EQ(FLAGS_yb_num_shards_per_tserver, resp.tablet_locations_size());
+  for (const auto& tablet : resp.tablet_locations()) {
+    ASSERT_EQ(2, tablet.table_ids_size()) << tablet.ShortDebugString();
+    ASSERT_EQ(table_id, tablet.table_ids(0));
+    ASSERT_EQ(copartitioned_table_id, tablet.table_ids(1));
+  }
+
+  // Rename the table, it should be found only by the new name.
+  {
+    master::AlterTableRequestPB req;
+    master::AlterTableResponsePB alter_resp;
+    req.mutable_table()->set_table_id(table_id);
+    req.set_new_table_name("fake-table-renamed");
+    ASSERT_OK(cluster_->mini_master()->master()->catalog_manager()->AlterTable(
+        &req, &alter_resp, /* rpc::RpcContext* */ nullptr));
+  }
+  TableIdentifierPB table_by_name;
+  YBTableName(YQL_DATABASE_CQL, "my_keyspace", "fake-table-renamed").SetIntoTableIdentifierPB(
+      &table_by_name);
+  ASSERT_OK(WaitTableLocationsMatch(table_by_name, &resp));
+  ASSERT_EQ(FLAGS_yb_num_shards_per_tserver, resp.tablet_locations_size());
+  YBTableName(YQL_DATABASE_CQL, "my_keyspace", "fake-table").SetIntoTableIdentifierPB(
+      &table_by_name);
+  ASSERT_NOK(GetTableLocations(table_by_name, &resp));
+
+  // Delete the table and create another one with the same name.
+  const YBTableName other_table_name(YQL_DATABASE_CQL, "my_keyspace", "fake-table3");
+  string other_tablet_id;
+  string other_table_id;
+  CreateTabletForTesting(
+      cluster_->mini_master(), other_table_name, schema_, &other_tablet_id, &other_table_id);
+  ASSERT_OK(cluster_->WaitForReplicaCount(other_tablet_id, 1, &locs));
+  other_table_name.SetIntoTableIdentifierPB(&table_by_name);
+  ASSERT_OK(WaitTableLocationsMatch(table_by_name, &resp));
+  std::set<string> old_tablet_ids;
+  for (const auto& tablet : resp.tablet_locations()) {
+    old_tablet_ids.insert(tablet.tablet_id());
+  }
+  {
+    master::DeleteTableRequestPB req;
+    master::DeleteTableResponsePB delete_resp;
+    req.mutable_table()->set_table_id(other_table_id);
+    ASSERT_OK(cluster_->mini_master()->master()->catalog_manager()->DeleteTable(
+        &req, &delete_resp, /* rpc::RpcContext* */ nullptr));
+  }
+  table.set_table_id(other_table_id);
+  ASSERT_NOK(GetTableLocations(table, &resp));
+
+  CreateTabletForTesting(
+      cluster_->mini_master(), other_table_name, schema_, &other_tablet_id, &other_table_id);
+  ASSERT_OK(cluster_->WaitForReplicaCount(other_tablet_id, 1, &locs));
+  ASSERT_OK(WaitTableLocationsMatch(table_by_name, &resp));
+  ASSERT_EQ(FLAGS_yb_num_shards_per_tserver, resp.tablet_locations_size());
+  for (const auto& tablet : resp.tablet_locations()) {
+    ASSERT_EQ(0, old_tablet_ids.count(tablet.tablet_id())) << tablet.ShortDebugString();
+    ASSERT_EQ(other_table_id, tablet.table_id());
+  }
+}
+
 } // namespace yb
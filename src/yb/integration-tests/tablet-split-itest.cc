@@ -498,6 +498,41 @@ TEST_F(TabletSplitITest, SlowSplitSingleTablet) {
   ASSERT_NO_FATALS(WaitForTabletSplitCompletion());
 }
 
+// Post-split tablets are compacted in background after split, so they drop keys of the other
+// child tablet and could be split again.
+TEST_F(TabletSplitITest, PostSplitCompaction) {
+  constexpr auto kNumRows = 500;
+
+  SetNumTablets(1);
+  CreateTable();
+
+  const auto split_hash_code = ASSERT_RESULT(WriteRowsAndGetMiddleHashCode(kNumRows));
+
+  auto& leader_master = *ASSERT_NOTNULL(cluster_->leader_mini_master()->master());
+  auto source_tablet_info = ASSERT_RESULT(GetSingleTestTabletInfo(leader_master));
+  auto* catalog_mgr = leader_master.catalog_manager();
+  ASSERT_OK(catalog_mgr->TEST_SplitTablet(source_tablet_info, split_hash_code));
+
+  ASSERT_NO_FATALS(WaitForTabletSplitCompletion());
+
+  ASSERT_OK(WaitFor([this] {
+    for (auto peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      const auto* tablet = peer->tablet();
+      if (!tablet || tablet->table_type() == TRANSACTION_STATUS_TABLE_TYPE ||
+          tablet->metadata()->tablet_data_state() ==
+              tablet::TabletDataState::TABLET_DATA_SPLIT_COMPLETED) {
+        continue;
+      }
+      if (!tablet->metadata()->has_been_fully_compacted()) {
+        return false;
+      }
+    }
+    return true;
+  }, 30s * kTimeMultiplier, "Wait for post-split compaction"));
+
+  ASSERT_NO_FATALS(CheckPostSplitTabletReplicasData(kNumRows));
+}
+
 void TabletSplitITest::CheckTableKeysInRange(const size_t num_keys) {
   client::TableHandle table;
   ASSERT_OK(table.Open(client::kTableName, client_.get()));
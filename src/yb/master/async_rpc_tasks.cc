@@ -18,6 +18,7 @@
 #include "yb/consensus/consensus.proxy.h"
 
 #include "yb/master/master.h"
+#include "yb/master/ts_admin_rpc_batcher.h"
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/catalog_manager.h"
 
@@ -516,7 +517,14 @@ void AsyncCreateReplica::HandleResponse(int attempt) {
 }
 
 bool AsyncCreateReplica::SendRequest(int attempt) {
-  ts_admin_proxy_->CreateTabletAsync(req_, &resp_, &rpc_, BindRpcCallback());
+  auto* batchers = master_->catalog_manager()->ts_admin_rpc_batchers();
+  auto batcher = batchers ? batchers->CreateTabletBatcher(permanent_uuid_, ts_admin_proxy_)
+                          : nullptr;
+  if (batcher) {
+    batcher->AddRequest(req_, &resp_, &rpc_, BindRpcCallback());
+  } else {
+    ts_admin_proxy_->CreateTabletAsync(req_, &resp_, &rpc_, BindRpcCallback());
+  }
   VLOG_WITH_PREFIX(1) << "Send create tablet request to " << permanent_uuid_ << ":\n"
                       << " (attempt " << attempt << "):\n"
                       << req_.DebugString();
@@ -592,7 +600,14 @@ bool AsyncDeleteReplica::SendRequest(int attempt) {
     req.set_cas_config_opid_index_less_or_equal(*cas_config_opid_index_less_or_equal_);
   }
 
-  ts_admin_proxy_->DeleteTabletAsync(req, &resp_, &rpc_, BindRpcCallback());
+  auto* batchers = master_->catalog_manager()->ts_admin_rpc_batchers();
+  auto batcher = batchers ? batchers->DeleteTabletBatcher(permanent_uuid_, ts_admin_proxy_)
+                          : nullptr;
+  if (batcher) {
+    batcher->AddRequest(req, &resp_, &rpc_, BindRpcCallback());
+  } else {
+    ts_admin_proxy_->DeleteTabletAsync(req, &resp_, &rpc_, BindRpcCallback());
+  }
   VLOG_WITH_PREFIX(1) << "Send delete tablet request to " << permanent_uuid_
                       << " (attempt " << attempt << "):\n"
                       << req.DebugString();
@@ -147,6 +147,9 @@ class TestLoadBalancerBase {
     PrepareTestState(ts_descs_multi_az);
     TestNoPlacement();
 
+    PrepareTestState(ts_descs_multi_az);
+    TestNoPlacementWithDiskUsage();
+
     PrepareTestState(ts_descs_multi_az);
     TestWithPlacement();
 
@@ -549,6 +552,29 @@ class TestLoadBalancerBase {
     ASSERT_EQ(0, cb_->get_total_over_replication());
   }
 
+  void TestNoPlacementWithDiskUsage() {
+    LOG(INFO) << "Testing with no placement information and uneven disk usage";
+    PlacementInfoPB* cluster_placement = replication_info_.mutable_live_replicas();
+    cluster_placement->set_num_replicas(kNumReplicas);
+
+    // Same number of tablets everywhere, but ts0 has the most data.
+    ts_descs_[0]->set_total_sst_file_size(10LL * 1024 * 1024 * 1024);
+    ts_descs_.push_back(SetupTS("3333", "a"));
+    ASSERT_OK(AnalyzeTablets());
+
+    string placeholder;
+    string expected_to_ts = ts_descs_[3]->permanent_uuid();
+    // Among servers with equal load, the one with the biggest disk usage is picked first.
+    string expected_from_ts = ts_descs_[0]->permanent_uuid();
+    TestAddLoad(placeholder, expected_from_ts, expected_to_ts);
+
+    // ts0 now has less load, so we are back to picking the largest ID.
+    expected_from_ts = ts_descs_[2]->permanent_uuid();
+    TestAddLoad(placeholder, expected_from_ts, expected_to_ts);
+
+    ts_descs_[0]->set_total_sst_file_size(0);
+  }
+
   void TestWithMissingTabletServers() {
     LOG(INFO) << "Testing with missing tablet servers";
     SetupClusterConfig({"a"}, &replication_info_);
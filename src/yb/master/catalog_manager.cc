@@ -104,6 +104,7 @@
 #include "yb/master/sys_catalog.h"
 #include "yb/master/system_tablet.h"
 #include "yb/master/tasks_tracker.h"
+#include "yb/master/ts_admin_rpc_batcher.h"
 #include "yb/master/ts_descriptor.h"
 #include "yb/master/ts_manager.h"
 #include "yb/master/yql_aggregates_vtable.h"
@@ -219,6 +220,12 @@ DEFINE_bool(catalog_manager_check_ts_count_for_create_table, true,
             "a table to be created.");
 TAG_FLAG(catalog_manager_check_ts_count_for_create_table, hidden);
 
+DEFINE_int32(master_table_locations_cache_max_entries, 10000,
+             "Maximum number of GetTableLocations responses cached by the master leader. Cached "
+             "responses are used until tablet locations change. 0 disables the cache.");
+TAG_FLAG(master_table_locations_cache_max_entries, advanced);
+TAG_FLAG(master_table_locations_cache_max_entries, runtime);
+
 METRIC_DEFINE_gauge_uint32(cluster, num_tablet_servers_live,
                            "Number of live tservers in the cluster", yb::MetricUnit::kUnits,
                            "The number of tablet servers that have responded or done a heartbeat "
@@ -273,6 +280,13 @@ DEFINE_bool(
     "This cuts down test logs significantly.");
 TAG_FLAG(hide_pg_catalog_table_creation_logs, hidden);
 
+DEFINE_int32(ysql_catalog_inval_messages_max_versions, 1000,
+    "Number of the latest YSQL catalog versions, whose invalidation messages are kept by the "
+    "master. Backends that are behind by more versions reload all their caches. 0 disables "
+    "serving invalidation messages.");
+TAG_FLAG(ysql_catalog_inval_messages_max_versions, advanced);
+TAG_FLAG(ysql_catalog_inval_messages_max_versions, runtime);
+
 DEFINE_test_flag(int32, simulate_slow_table_create_secs, 0,
     "Simulates a slow table creation by sleeping after the table has been added to memory.");
 
@@ -560,6 +574,8 @@ Status CatalogManager::Init(bool is_first_run) {
   metric_num_tablet_servers_dead_ =
     METRIC_num_tablet_servers_dead.Instantiate(master_->metric_entity_cluster(), 0);
 
+  ts_admin_rpc_batchers_ = std::make_unique<TSAdminRpcBatchers>(master_->messenger());
+
   RETURN_NOT_OK_PREPEND(InitSysCatalogAsync(is_first_run),
                         "Failed to initialize sys tables async");
 
@@ -848,8 +864,15 @@ Status CatalogManager::RunLoaders(int64_t term) {
   // Clear redis config mapping.
   redis_config_map_.clear();
 
+  // Tablets are reloaded, so responses cached for previous tablet objects should not be used.
+  tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
+
   // Clear ysql catalog config.
   ysql_catalog_config_.reset();
+  {
+    std::lock_guard<std::mutex> lock(ysql_catalog_inval_messages_mutex_);
+    ysql_catalog_inval_messages_.clear();
+  }
 
   // Clear recent tasks.
   tasks_tracker_->Reset();
@@ -1577,6 +1600,8 @@ Status CatalogManager::CreateCopartitionedTable(const CreateTableRequestPB& req,
   for (TabletInfo *tablet : tablets) {
     tablet->mutable_metadata()->CommitMutation();
   }
+  // Table ids are part of tablet locations.
+  tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
 
   for (const auto& tablet : scoped_ref_tablets) {
     SendCopartitionTabletRequest(tablet, this_table_info);
@@ -1654,7 +1679,7 @@ Status CatalogManager::DoSplitTablet(
 Result<scoped_refptr<TabletInfo>> CatalogManager::GetTabletInfo(const TabletId& tablet_id) {
   RETURN_NOT_OK(CheckOnline());
 
-  std::lock_guard<LockType> l(lock_);
+  SharedLock<LockType> l(lock_);
   TRACE("Acquired catalog manager lock");
 
   const auto tablet_info = FindPtrOrNull(*tablet_map_, tablet_id);
@@ -1887,12 +1912,46 @@ Status CatalogManager::GetYsqlCatalogConfig(const GetYsqlCatalogConfigRequestPB*
                                             rpc::RpcContext* rpc) {
   RETURN_NOT_OK(CheckOnline());
   VLOG(1) << "GetYsqlCatalogConfig request: " << req->ShortDebugString();
-  auto l = CHECK_NOTNULL(ysql_catalog_config_.get())->LockForRead();
-  resp->set_version(l->data().pb.ysql_catalog_config().version());
+  uint64_t version;
+  {
+    auto l = CHECK_NOTNULL(ysql_catalog_config_.get())->LockForRead();
+    version = l->data().pb.ysql_catalog_config().version();
+  }
+  resp->set_version(version);
+
+  if (!req->has_inval_messages_from_version() || req->inval_messages_from_version() >= version) {
+    return Status::OK();
+  }
+
+  // Messages of the version being incremented concurrently could be already recorded, so only
+  // versions up to the reported one are used.
+  const auto from_version = req->inval_messages_from_version();
+  std::lock_guard<std::mutex> lock(ysql_catalog_inval_messages_mutex_);
+  auto it = std::find_if(
+      ysql_catalog_inval_messages_.begin(), ysql_catalog_inval_messages_.end(),
+      [from_version](const auto& entry) { return entry.first == from_version + 1; });
+  if (it == ysql_catalog_inval_messages_.end() ||
+      ysql_catalog_inval_messages_.back().first < version) {
+    return Status::OK();
+  }
+  std::string* messages = resp->mutable_inval_messages();
+  for (; it != ysql_catalog_inval_messages_.end() && it->first <= version; ++it) {
+    messages->append(it->second);
+  }
 
   return Status::OK();
 }
 
+Status CatalogManager::IncrementYsqlCatalogVersion(
+    const IncrementYsqlCatalogVersionRequestPB* req,
+    IncrementYsqlCatalogVersionResponsePB* resp,
+    rpc::RpcContext* rpc) {
+  RETURN_NOT_OK(CheckOnline());
+  resp->set_version(VERIFY_RESULT(IncrementYsqlCatalogVersion(
+      req->has_inval_messages() ? &req->inval_messages() : nullptr)));
+  return Status::OK();
+}
+
 Status CatalogManager::CopyPgsqlSysTables(const NamespaceId& namespace_id,
                                           const std::vector<scoped_refptr<TableInfo>>& tables) {
   const uint32_t database_oid = CHECK_RESULT(GetPgsqlDatabaseOid(namespace_id));
@@ -2268,6 +2327,8 @@ Status CatalogManager::CreateTable(const CreateTableRequestPB* orig_req,
         tablet_lock->mutable_data()->pb.add_table_ids(table->id());
         RETURN_NOT_OK(sys_catalog_->UpdateItem(tablet.get(), leader_ready_term()));
         tablet_lock->Commit();
+        // Table ids are part of tablet locations.
+        tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
 
         tablet->mutable_metadata()->StartMutation();
         table->AddTablets(tablets);
@@ -2903,6 +2964,7 @@ Status CatalogManager::RemoveTableIdsFromTabletInfo(
 
   RETURN_NOT_OK(sys_catalog_->UpdateItem(tablet_info.get(), leader_ready_term()));
   tablet_lock->Commit();
+  tablet_locations_version_.fetch_add(1, std::memory_order_acq_rel);
   return Status::OK();
 }
 
@@ -3095,8 +3157,7 @@ Status CatalogManager::IsTruncateTableDone(const IsTruncateTableDoneRequestPB* r
 
   // Lookup the truncated table.
   TRACE("Looking up table $0", req->table_id());
-  std::lock_guard<LockType> l_map(lock_);
-  scoped_refptr<TableInfo> table = FindPtrOrNull(*table_ids_map_, req->table_id());
+  scoped_refptr<TableInfo> table = GetTableInfo(req->table_id());
 
   if (table == nullptr) {
     Status s = STATUS(NotFound, "The object does not exist: table with id", req->table_id());
@@ -3410,9 +3471,10 @@ void CatalogManager::CleanUpDeletedTables() {
   // TODO(bogdan): Cache tables being deleted to make this iterate only over those?
   vector<scoped_refptr<TableInfo>> tables_to_delete;
   {
-    std::lock_guard<LockType> l_map(lock_);
+    SharedLock<LockType> l_map(lock_);
     // Garbage collecting.
-    // Going through all tables under the global lock.
+    // Going through all tables under the global lock, shared mode is enough since the maps are
+    // not modified here.
     for (const auto& it : *table_ids_map_) {
       scoped_refptr<TableInfo> table(it.second);
 
@@ -3500,8 +3562,7 @@ Status CatalogManager::IsDeleteTableDone(const IsDeleteTableDoneRequestPB* req,
 
   // Lookup the deleted table.
   TRACE("Looking up table $0", req->table_id());
-  std::lock_guard<LockType> l_map(lock_);
-  scoped_refptr<TableInfo> table = FindPtrOrNull(*table_ids_map_, req->table_id());
+  scoped_refptr<TableInfo> table = GetTableInfo(req->table_id());
 
   if (table == nullptr) {
     LOG(INFO) << "Servicing IsDeleteTableDone request for table id "
@@ -4582,13 +4643,13 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
           // Report opid_index is equal to the previous opid_index. If some
           // replica is reporting the same consensus configuration we already know about and hasn't
           // been added as replica, add it.
-          LOG(INFO) << "Peer " << ts_desc->permanent_uuid() << " sent "
-                    << (full_report.is_incremental() ? "incremental" : "full tablet")
-                    << " report for " << tablet->tablet_id()
-                    << ", prev state op id: " << prev_cstate.config().opid_index()
-                    << ", prev state term: " << prev_cstate.current_term()
-                    << ", prev state has_leader_uuid: " << prev_cstate.has_leader_uuid()
-                    << ". Consensus state: " << cstate.ShortDebugString();
+          VLOG(2) << "Peer " << ts_desc->permanent_uuid() << " sent "
+                  << (full_report.is_incremental() ? "incremental" : "full tablet")
+                  << " report for " << tablet->tablet_id()
+                  << ", prev state op id: " << prev_cstate.config().opid_index()
+                  << ", prev state term: " << prev_cstate.current_term()
+                  << ", prev state has_leader_uuid: " << prev_cstate.has_leader_uuid()
+                  << ". Consensus state: " << cstate.ShortDebugString();
           UpdateTabletReplicaInLocalMemory(ts_desc, &cstate, report.state(), tablet);
         }
 
@@ -4650,8 +4711,13 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
     }
 
     // 11. Publish the in-memory tablet mutations and release the locks.
+    // Locks of tablets that were not mutated are just released, so the reported tablets that did
+    // not change do not block readers of their metadata with commit lock.
+    for (auto* tablet : mutated_tablets) {
+      tablet_write_locks[tablet->tablet_id()]->Commit();
+    }
     for (auto& l : tablet_write_locks) {
-      l.second->Commit();
+      l.second->Unlock();
     }
     tablet_write_locks.clear();
 
@@ -4925,8 +4991,8 @@ void CatalogManager::ProcessPendingNamespace(
 
   scoped_refptr<NamespaceInfo> ns;
   {
-    std::lock_guard<LockType> l(lock_);
-    ns = FindPtrOrNull(namespace_ids_map_, id);;
+    SharedLock<LockType> l(lock_);
+    ns = FindPtrOrNull(namespace_ids_map_, id);
   }
   if (ns == nullptr) {
     LOG(WARNING) << "Pending Namespace not found to finish creation: " << id;
@@ -5528,7 +5594,7 @@ Status CatalogManager::RedisConfigGet(
   DCHECK(req->has_keyword());
   resp->set_keyword(req->keyword());
   TRACE("Acquired catalog manager lock");
-  std::lock_guard<LockType> l_big(lock_);
+  SharedLock<LockType> l_big(lock_);
   scoped_refptr<RedisConfigInfo> cfg = FindPtrOrNull(redis_config_map_, req->keyword());
   if (cfg == nullptr) {
     Status s = STATUS_SUBSTITUTE(NotFound, "Redis config for $0 does not exists", req->keyword());
@@ -5849,7 +5915,7 @@ bool CatalogManager::CDCStreamExistsUnlocked(const CDCStreamId& stream_id) {
   return false;
 }
 
-Result<uint64_t> CatalogManager::IncrementYsqlCatalogVersion() {
+Result<uint64_t> CatalogManager::IncrementYsqlCatalogVersion(const std::string* inval_messages) {
 
   auto l = CHECK_NOTNULL(ysql_catalog_config_.get())->LockForWrite();
   uint64_t new_version = l->data().pb.ysql_catalog_config().version() + 1;
@@ -5857,6 +5923,23 @@ Result<uint64_t> CatalogManager::IncrementYsqlCatalogVersion() {
 
   // Write to sys_catalog and in memory.
   RETURN_NOT_OK(sys_catalog_->UpdateItem(ysql_catalog_config_.get(), leader_ready_term()));
+
+  {
+    // Recorded before commit, so readers of the new version always find its messages.
+    std::lock_guard<std::mutex> lock(ysql_catalog_inval_messages_mutex_);
+    const auto max_versions = FLAGS_ysql_catalog_inval_messages_max_versions;
+    if (!inval_messages || max_versions <= 0 ||
+        (!ysql_catalog_inval_messages_.empty() &&
+         ysql_catalog_inval_messages_.back().first + 1 != new_version)) {
+      ysql_catalog_inval_messages_.clear();
+    }
+    if (inval_messages && max_versions > 0) {
+      ysql_catalog_inval_messages_.emplace_back(new_version, *inval_messages);
+      while (ysql_catalog_inval_messages_.size() > static_cast<size_t>(max_versions)) {
+        ysql_catalog_inval_messages_.pop_front();
+      }
+    }
+  }
   l->Commit();
 
   return new_version;
@@ -7096,10 +7179,23 @@ Status CatalogManager::GetTableLocations(const GetTableLocationsRequestPB* req,
   auto l = table->LockForRead();
   RETURN_NOT_OK(CheckIfTableDeletedOrNotRunning(l.get(), resp));
 
+  // Version should be read before building locations, so a concurrent change of locations
+  // invalidates the response that is being built.
+  const auto locations_version = tablet_locations_version();
+  const auto partitions_version = l->data().pb.partitions_version();
+  std::string cache_key;
+  if (FLAGS_master_table_locations_cache_max_entries > 0 && !IsSystemTable(*table)) {
+    cache_key = table->id() + req->SerializeAsString();
+    if (GetCachedTableLocations(cache_key, locations_version, partitions_version, resp)) {
+      return Status::OK();
+    }
+  }
+
   vector<scoped_refptr<TabletInfo>> tablets_in_range;
   table->GetTabletsInRange(req, &tablets_in_range);
 
   bool require_tablets_runnings = req->require_tablets_running();
+  bool all_tablets_running = true;
   for (const scoped_refptr<TabletInfo>& tablet : tablets_in_range) {
     auto status = BuildLocationsForTablet(tablet, resp->add_tablet_locations());
     if (!status.ok()) {
@@ -7109,15 +7205,55 @@ Status CatalogManager::GetTableLocations(const GetTableLocationsRequestPB* req,
         return SetupError(resp->mutable_error(), MasterErrorPB::OBJECT_NOT_FOUND, status);
       }
       resp->mutable_tablet_locations()->RemoveLast();
+      all_tablets_running = false;
     }
   }
 
   resp->set_table_type(l->data().pb.table_type());
-  resp->set_partitions_version(l->data().pb.partitions_version());
+  resp->set_partitions_version(partitions_version);
+
+  // Tablet could become running without change of its locations, so only responses with all
+  // tablets running are cached.
+  if (!cache_key.empty() && all_tablets_running) {
+    CacheTableLocations(cache_key, locations_version, *resp);
+  }
 
   return Status::OK();
 }
 
+bool CatalogManager::GetCachedTableLocations(
+    const std::string& key, uintptr_t locations_version, uint32_t partitions_version,
+    GetTableLocationsResponsePB* resp) {
+  std::lock_guard<std::mutex> lock(table_locations_cache_mutex_);
+  if (table_locations_cache_version_ != locations_version) {
+    table_locations_cache_.clear();
+    table_locations_cache_version_ = locations_version;
+    return false;
+  }
+  auto it = table_locations_cache_.find(key);
+  // Partitions version changes when tablets are split.
+  if (it == table_locations_cache_.end() ||
+      it->second.partitions_version() != partitions_version) {
+    return false;
+  }
+  *resp = it->second;
+  return true;
+}
+
+void CatalogManager::CacheTableLocations(
+    const std::string& key, uintptr_t locations_version, const GetTableLocationsResponsePB& resp) {
+  std::lock_guard<std::mutex> lock(table_locations_cache_mutex_);
+  if (table_locations_cache_version_ != locations_version) {
+    // Locations were changed while the response was being built.
+    return;
+  }
+  if (table_locations_cache_.size() >=
+      static_cast<size_t>(FLAGS_master_table_locations_cache_max_entries)) {
+    table_locations_cache_.clear();
+  }
+  table_locations_cache_[key] = resp;
+}
+
 Status CatalogManager::GetCurrentConfig(consensus::ConsensusStatePB* cpb) const {
   auto tablet_peer = sys_catalog_->tablet_peer();
   auto consensus = tablet_peer ? tablet_peer->shared_consensus() : nullptr;
@@ -7568,7 +7704,7 @@ std::string BlacklistState::ToString() {
 
 int64_t CatalogManager::GetNumRelevantReplicas(const BlacklistState& state, bool leaders_only) {
   int64_t res = 0;
-  std::lock_guard <LockType> tablet_map_lock(lock_);
+  SharedLock<LockType> tablet_map_lock(lock_);
   for (const TabletInfoMap::value_type& entry : *tablet_map_) {
     scoped_refptr<TabletInfo> tablet = entry.second;
     auto l = tablet->LockForRead();
@@ -33,8 +33,10 @@
 #ifndef YB_MASTER_CATALOG_MANAGER_H
 #define YB_MASTER_CATALOG_MANAGER_H
 
+#include <deque>
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -112,6 +114,7 @@ class TSDescriptor;
 class ChangeEncryptionInfoRequestPB;
 class ChangeEncryptionInfoResponsePB;
 class TasksTracker;
+class TSAdminRpcBatchers;
 
 struct DeferredAssignmentActions;
 
@@ -183,11 +186,17 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
                                   ReservePgsqlOidsResponsePB* resp,
                                   rpc::RpcContext* rpc);
 
-  // Get the info (current only version) for the ysql system catalog.
+  // Get the info (current only version) for the ysql system catalog, along with invalidation
+  // messages of versions after inval_messages_from_version, when requested and available.
   CHECKED_STATUS GetYsqlCatalogConfig(const GetYsqlCatalogConfigRequestPB* req,
                                       GetYsqlCatalogConfigResponsePB* resp,
                                       rpc::RpcContext* rpc);
 
+  // Increment the ysql system catalog version for changes, that are not tied to a catalog write.
+  CHECKED_STATUS IncrementYsqlCatalogVersion(const IncrementYsqlCatalogVersionRequestPB* req,
+                                             IncrementYsqlCatalogVersionResponsePB* resp,
+                                             rpc::RpcContext* rpc);
+
   // Copy Postgres sys catalog tables into a new namespace.
   CHECKED_STATUS CopyPgsqlSysTables(const NamespaceId& namespace_id,
                                     const std::vector<scoped_refptr<TableInfo>>& tables);
@@ -396,7 +405,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   virtual CHECKED_STATUS ChangeEncryptionInfo(const ChangeEncryptionInfoRequestPB* req,
                                               ChangeEncryptionInfoResponsePB* resp);
 
-  Result<uint64_t> IncrementYsqlCatalogVersion();
+  // Increments ysql catalog version. inval_messages, when not null, are kept in memory along
+  // with the new version, so backends could apply them instead of reloading all their caches.
+  Result<uint64_t> IncrementYsqlCatalogVersion(const std::string* inval_messages = nullptr);
 
   // Records the fact that initdb has succesfully completed.
   CHECKED_STATUS InitDbFinished(Status initdb_status, int64_t term);
@@ -645,6 +656,9 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
 
   ThreadPool* AsyncTaskPool() { return worker_pool_.get(); }
 
+  // Batchers of admin RPCs sent by async tasks, null before Init.
+  TSAdminRpcBatchers* ts_admin_rpc_batchers() { return ts_admin_rpc_batchers_.get(); }
+
   PermissionsManager* permissions_manager() {
     return permissions_manager_.get();
   }
@@ -1146,6 +1160,12 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // YSQL Catalog information.
   scoped_refptr<SysConfigInfo> ysql_catalog_config_ = nullptr; // No GUARD, only write on Load.
 
+  // Invalidation messages of the latest ysql catalog versions, with consecutive versions.
+  // Cleared when a version is incremented without messages, and when catalog is reloaded.
+  std::mutex ysql_catalog_inval_messages_mutex_;
+  std::deque<std::pair<uint64_t, std::string>> ysql_catalog_inval_messages_
+      GUARDED_BY(ysql_catalog_inval_messages_mutex_);
+
   Master *master_;
   Atomic32 closing_;
   ObjectIdGenerator oid_generator_;
@@ -1257,6 +1277,8 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Tracks most recent async tasks.
   scoped_refptr<TasksTracker> tasks_tracker_;
 
+  std::unique_ptr<TSAdminRpcBatchers> ts_admin_rpc_batchers_;
+
   // Tracks most recent user initiated jobs.
   scoped_refptr<TasksTracker> jobs_tracker_;
 
@@ -1267,9 +1289,26 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
  private:
   virtual bool CDCStreamExistsUnlocked(const CDCStreamId& id) REQUIRES_SHARED(lock_);
 
-  // Should be bumped up when tablet locations are changed.
+  // Should be bumped up when tablet locations are changed, including table ids of tablets.
   std::atomic<uintptr_t> tablet_locations_version_{0};
 
+  // Fills resp from GetTableLocations response cached with the specified key, when it was built
+  // for the same tablet locations and partitions versions. Returns false if there is no such
+  // response.
+  bool GetCachedTableLocations(
+      const std::string& key, uintptr_t locations_version, uint32_t partitions_version,
+      GetTableLocationsResponsePB* resp);
+
+  void CacheTableLocations(
+      const std::string& key, uintptr_t locations_version, const GetTableLocationsResponsePB& resp);
+
+  // Cached GetTableLocations responses, all of them were built at the same tablet locations
+  // version.
+  std::mutex table_locations_cache_mutex_;
+  uintptr_t table_locations_cache_version_ GUARDED_BY(table_locations_cache_mutex_) = 0;
+  std::unordered_map<std::string, GetTableLocationsResponsePB> table_locations_cache_
+      GUARDED_BY(table_locations_cache_mutex_);
+
   DISALLOW_COPY_AND_ASSIGN(CatalogManager);
 };
 
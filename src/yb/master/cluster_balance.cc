@@ -99,6 +99,14 @@ DEFINE_test_flag(bool, load_balancer_handle_under_replicated_tablets_only, false
 DEFINE_bool(load_balancer_skip_leader_as_remove_victim, false,
             "Should the LB skip a leader as a possible remove candidate.");
 
+DEFINE_int64(load_balancer_disk_usage_granularity_bytes, 1024LL * 1024 * 1024,
+             "Tablet servers with the same number of tablets are ordered by their total SST file "
+             "size rounded down to this granularity, so tablets are moved away from the servers "
+             "with more data first, and to the servers with less data first. Rounding keeps small "
+             "fluctuations of the size from changing the order. 0 to disable.");
+TAG_FLAG(load_balancer_disk_usage_granularity_bytes, advanced);
+TAG_FLAG(load_balancer_disk_usage_granularity_bytes, runtime);
+
 DECLARE_int32(min_leader_stepdown_retry_interval_ms);
 
 namespace yb {
@@ -54,6 +54,8 @@ DECLARE_int32(load_balancer_max_concurrent_moves);
 
 DECLARE_int32(load_balancer_max_concurrent_moves_per_table);
 
+DECLARE_int64(load_balancer_disk_usage_granularity_bytes);
+
 namespace yb {
 namespace master {
 
@@ -152,6 +154,10 @@ struct CBTabletServerMetadata {
 
   // The set of tablet leader ids that this tablet server is currently running.
   std::set<TabletId> leaders;
+
+  // Total SST file size reported by this tablet server, rounded down to
+  // load_balancer_disk_usage_granularity_bytes. Used to order servers with the same load.
+  uint64_t disk_usage_bucket = 0;
 };
 
 struct Options {
@@ -219,11 +225,15 @@ class PerTableLoadState {
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
     int load_a = GetLoad(a);
     int load_b = GetLoad(b);
-    if (load_a == load_b) {
-      return a < b;
-    } else {
+    if (load_a != load_b) {
       return load_a < load_b;
     }
+    auto disk_usage_a = per_ts_meta_.at(a).disk_usage_bucket;
+    auto disk_usage_b = per_ts_meta_.at(b).disk_usage_bucket;
+    if (disk_usage_a != disk_usage_b) {
+      return disk_usage_a < disk_usage_b;
+    }
+    return a < b;
   }
 
   bool CompareByReplica(const TabletReplica& a, const TabletReplica& b) {
@@ -434,6 +444,9 @@ class PerTableLoadState {
     // tablet servers that happen to not be serving any tablets, so were not in the map yet.
     auto& ts_meta = per_ts_meta_[ts_uuid];
     ts_meta.descriptor = ts_desc;
+    const auto disk_usage_granularity = FLAGS_load_balancer_disk_usage_granularity_bytes;
+    ts_meta.disk_usage_bucket = disk_usage_granularity > 0
+        ? ts_desc->total_sst_file_size() / disk_usage_granularity : 0;
 
     sorted_load_.push_back(ts_uuid);
 
@@ -56,6 +56,13 @@ DEFINE_int64(tablet_split_size_threshold_bytes, 0,
              "Threshold on tablet size after which tablet should be split. Automated splitting is "
              "disabled if this value is set to 0");
 
+DEFINE_int64(tablet_split_write_rows_per_sec_threshold, 0,
+             "Threshold on rate of rows written to tablet per second, after which tablet should be "
+             "split if this rate is sustained. Load based splitting is disabled if this value is "
+             "set to 0");
+TAG_FLAG(tablet_split_write_rows_per_sec_threshold, advanced);
+TAG_FLAG(tablet_split_write_rows_per_sec_threshold, runtime);
+
 DEFINE_int32(master_inject_latency_on_tablet_lookups_ms, 0,
              "Number of milliseconds that the master will sleep before responding to "
              "requests for tablet locations.");
@@ -225,9 +232,15 @@ void MasterServiceImpl::TSHeartbeat(const TSHeartbeatRequestPB* req,
   uint64_t version = server_->catalog_manager()->GetYsqlCatalogVersion();
   resp->set_ysql_catalog_version(version);
 
+  resp->set_tablet_locations_version(server_->catalog_manager()->tablet_locations_version());
+
   if (FLAGS_tablet_split_size_threshold_bytes > 0) {
     resp->set_tablet_split_size_threshold_bytes(FLAGS_tablet_split_size_threshold_bytes);
   }
+  if (FLAGS_tablet_split_write_rows_per_sec_threshold > 0) {
+    resp->set_tablet_split_write_rows_per_sec_threshold(
+        FLAGS_tablet_split_write_rows_per_sec_threshold);
+  }
 
   rpc.RespondSuccess();
 }
@@ -407,6 +420,13 @@ void MasterServiceImpl::GetYsqlCatalogConfig(const GetYsqlCatalogConfigRequestPB
   HandleIn(req, resp, &rpc, &CatalogManager::GetYsqlCatalogConfig);
 }
 
+void MasterServiceImpl::IncrementYsqlCatalogVersion(
+    const IncrementYsqlCatalogVersionRequestPB* req,
+    IncrementYsqlCatalogVersionResponsePB* resp,
+    rpc::RpcContext rpc) {
+  HandleIn(req, resp, &rpc, &CatalogManager::IncrementYsqlCatalogVersion);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Tablegroup
 // ------------------------------------------------------------------------------------------------
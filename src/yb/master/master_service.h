@@ -124,6 +124,10 @@ class MasterServiceImpl : public MasterServiceIf,
                             GetYsqlCatalogConfigResponsePB* resp,
                             rpc::RpcContext rpc) override;
 
+  void IncrementYsqlCatalogVersion(const IncrementYsqlCatalogVersionRequestPB* req,
+                                   IncrementYsqlCatalogVersionResponsePB* resp,
+                                   rpc::RpcContext rpc) override;
+
   void CreateTablegroup(const CreateTablegroupRequestPB* req,
                         CreateTablegroupResponsePB* resp,
                         rpc::RpcContext rpc) override;
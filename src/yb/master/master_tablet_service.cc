@@ -62,7 +62,9 @@ void MasterTabletServiceImpl::Write(const tserver::WriteRequestPB* req,
   }
   for (const auto& pg_req : req->pgsql_write_batch()) {
     if (pg_req.is_ysql_catalog_change()) {
-      const auto &res = master_->catalog_manager()->IncrementYsqlCatalogVersion();
+      const auto &res = master_->catalog_manager()->IncrementYsqlCatalogVersion(
+          pg_req.has_ysql_catalog_inval_messages() ? &pg_req.ysql_catalog_inval_messages()
+                                                   : nullptr);
       if (!res.ok()) {
         context.RespondRpcFailure(rpc::ErrorStatusPB::ERROR_APPLICATION,
             STATUS(InternalError, "Failed to increment YSQL catalog version"));
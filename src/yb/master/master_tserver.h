@@ -62,6 +62,11 @@ class MasterTabletServer : public tserver::TabletServerIf,
     return nullptr;
   }
 
+  CHECKED_STATUS GetLiveTServers(
+      std::vector<master::TSInformationPB> *live_tservers) const override {
+    return STATUS(NotSupported, "Live tservers are not tracked by master tserver");
+  }
+
  private:
   Master* master_ = nullptr;
   scoped_refptr<MetricEntity> metric_entity_;
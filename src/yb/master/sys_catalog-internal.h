@@ -27,6 +27,12 @@
 namespace yb {
 namespace master {
 
+// Entry read from sys catalog, that was not parsed yet.
+struct SysCatalogEntry {
+  std::string id;
+  std::string data;
+};
+
 class VisitorBase {
  public:
   VisitorBase() {}
@@ -36,7 +42,15 @@ class VisitorBase {
 
   virtual CHECKED_STATUS Visit(Slice id, Slice data) = 0;
 
+  // Visits entries in the order they were read from sys catalog. Metadata could be parsed in
+  // parallel using pool, but entries are visited one by one on the calling thread.
+  virtual CHECKED_STATUS VisitBatch(const std::vector<SysCatalogEntry>& entries, ThreadPool* pool);
+
  protected:
+  // Splits [0, count) into ranges, and invokes func for them in parallel, using pool and the
+  // calling thread. Returns the first failure.
+  static CHECKED_STATUS ParallelFor(
+      size_t count, ThreadPool* pool, const std::function<Status(size_t, size_t)>& func);
 };
 
 template <class PersistentDataEntryClass>
@@ -47,13 +61,26 @@ class Visitor : public VisitorBase {
 
   virtual CHECKED_STATUS Visit(Slice id, Slice data) {
     typename PersistentDataEntryClass::data_type metadata;
-    RETURN_NOT_OK_PREPEND(
-        pb_util::ParseFromArray(&metadata, data.data(), data.size()),
-        "Unable to parse metadata field for item id: " + id.ToBuffer());
-
+    RETURN_NOT_OK(Parse(id, data, &metadata));
     return Visit(id.ToBuffer(), metadata);
   }
 
+  CHECKED_STATUS VisitBatch(
+      const std::vector<SysCatalogEntry>& entries, ThreadPool* pool) override {
+    std::vector<typename PersistentDataEntryClass::data_type> metadata(entries.size());
+    RETURN_NOT_OK(ParallelFor(
+        entries.size(), pool, [&entries, &metadata](size_t begin, size_t end) -> Status {
+      for (auto i = begin; i != end; ++i) {
+        RETURN_NOT_OK(Parse(entries[i].id, entries[i].data, &metadata[i]));
+      }
+      return Status::OK();
+    }));
+    for (size_t i = 0; i != entries.size(); ++i) {
+      RETURN_NOT_OK(Visit(entries[i].id, metadata[i]));
+    }
+    return Status::OK();
+  }
+
   int entry_type() const { return PersistentDataEntryClass::type(); }
 
  protected:
@@ -61,6 +88,14 @@ class Visitor : public VisitorBase {
       const std::string& id, const typename PersistentDataEntryClass::data_type& metadata) = 0;
 
  private:
+  static CHECKED_STATUS Parse(
+      Slice id, Slice data, typename PersistentDataEntryClass::data_type* metadata) {
+    RETURN_NOT_OK_PREPEND(
+        pb_util::ParseFromArray(metadata, data.data(), data.size()),
+        "Unable to parse metadata field for item id: " + id.ToBuffer());
+    return Status::OK();
+  }
+
   DISALLOW_COPY_AND_ASSIGN(Visitor);
 };
 
@@ -50,6 +50,7 @@ using yb::rpc::MessengerBuilder;
 using yb::rpc::RpcController;
 
 DECLARE_string(cluster_uuid);
+DECLARE_int32(sys_catalog_load_batch_size);
 
 namespace yb {
 namespace master {
@@ -185,6 +186,34 @@ TEST_F(SysCatalogTest, TestSysCatalogTablesOperations) {
   ASSERT_EQ(kNumSystemTables, loader->tables.size());
 }
 
+// Test that entries parsed in parallel batches are all visited with correct metadata.
+TEST_F(SysCatalogTest, TestParallelVisit) {
+  constexpr int kNumTables = 1000;
+  FLAGS_sys_catalog_load_batch_size = 300;
+  SysCatalogTable* sys_catalog = master_->catalog_manager()->sys_catalog();
+
+  std::vector<scoped_refptr<TableInfo>> tables;
+  std::vector<TableInfo*> table_ptrs;
+  for (int i = 0; i != kNumTables; ++i) {
+    tables.push_back(master_->catalog_manager()->NewTableInfo(Format("table_$0", i)));
+    auto l = tables.back()->LockForWrite();
+    l->mutable_data()->pb.set_name(Format("testtb_$0", i));
+    l->mutable_data()->pb.set_version(i);
+    l->mutable_data()->pb.set_state(SysTablesEntryPB::RUNNING);
+    SchemaToPB(Schema(), l->mutable_data()->pb.mutable_schema());
+    l->Commit();
+    table_ptrs.push_back(tables.back().get());
+  }
+  ASSERT_OK(sys_catalog->AddItems(table_ptrs, kLeaderTerm));
+
+  unique_ptr<TestTableLoader> loader(new TestTableLoader());
+  ASSERT_OK(sys_catalog->Visit(loader.get()));
+  ASSERT_EQ(kNumTables + kNumSystemTables, loader->tables.size());
+  for (const auto& table : tables) {
+    ASSERT_METADATA_EQ(table.get(), loader->tables[table->id()]);
+  }
+}
+
 // Verify that data mutations are not available from metadata() until commit.
 TEST_F(SysCatalogTest, TestTableInfoCommit) {
   scoped_refptr<TableInfo> table(master_->catalog_manager()->NewTableInfo("123"));
@@ -70,6 +70,7 @@
 
 #include "yb/tserver/ts_tablet_manager.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/dns_resolver.h"
@@ -123,6 +124,16 @@ DEFINE_int32(copy_tables_batch_bytes, 500_KB, "Max bytes per batch for copy pg s
 DEFINE_test_flag(int32, sys_catalog_write_rejection_percentage, 0,
   "Reject specified percentage of sys catalog writes.");
 
+DEFINE_int32(sys_catalog_load_parallelism, 8,
+             "Number of threads used to parse sys catalog entries, while they are loaded into "
+             "memory, e.g. when master becomes leader. 1 means that entries are parsed by the "
+             "loading thread.");
+TAG_FLAG(sys_catalog_load_parallelism, advanced);
+
+DEFINE_int32(sys_catalog_load_batch_size, 4096,
+             "Number of sys catalog entries, that are parsed in parallel before they are visited.");
+TAG_FLAG(sys_catalog_load_batch_size, advanced);
+
 namespace yb {
 namespace master {
 
@@ -144,6 +155,12 @@ SysCatalogTable::SysCatalogTable(Master* master, MetricRegistry* metrics,
   CHECK_OK(ThreadPoolBuilder("prepare").set_min_threads(1).Build(&tablet_prepare_pool_));
   CHECK_OK(ThreadPoolBuilder("append").set_min_threads(1).Build(&append_pool_));
   CHECK_OK(ThreadPoolBuilder("log-alloc").set_min_threads(1).Build(&allocation_pool_));
+  if (FLAGS_sys_catalog_load_parallelism > 1) {
+    // The loading thread parses one range of entries itself.
+    CHECK_OK(ThreadPoolBuilder("sys-catalog-load")
+                 .set_max_threads(FLAGS_sys_catalog_load_parallelism - 1)
+                 .Build(&load_pool_));
+  }
 
   setup_config_dns_histogram_ = METRIC_dns_resolve_latency_during_sys_catalog_setup.Instantiate(
       metric_entity_);
@@ -160,6 +177,9 @@ void SysCatalogTable::Shutdown() {
   inform_removed_master_pool_->Shutdown();
   raft_pool_->Shutdown();
   tablet_prepare_pool_->Shutdown();
+  if (load_pool_) {
+    load_pool_->Shutdown();
+  }
 }
 
 Status SysCatalogTable::ConvertConfigToMasterAddresses(
@@ -699,11 +719,34 @@ Status SysCatalogTable::Visit(VisitorBase* visitor) {
   auto start = CoarseMonoClock::Now();
 
   uint64_t count = 0;
-  RETURN_NOT_OK(EnumerateSysCatalog(tablet.get(), schema_, visitor->entry_type(),
-                                    [visitor, &count](const Slice& id, const Slice& data) {
-    ++count;
-    return visitor->Visit(id, data);
-  }));
+  if (!load_pool_) {
+    RETURN_NOT_OK(EnumerateSysCatalog(tablet.get(), schema_, visitor->entry_type(),
+                                      [visitor, &count](const Slice& id, const Slice& data) {
+      ++count;
+      return visitor->Visit(id, data);
+    }));
+  } else {
+    // Parsing of metadata is the most CPU intensive part of visiting large number of entries,
+    // e.g. tablets, so entries are collected in batches and parsed in parallel.
+    const size_t batch_size = std::max(FLAGS_sys_catalog_load_batch_size, 1);
+    std::vector<SysCatalogEntry> batch;
+    batch.reserve(batch_size);
+    RETURN_NOT_OK(EnumerateSysCatalog(
+        tablet.get(), schema_, visitor->entry_type(),
+        [this, visitor, batch_size, &batch, &count](const Slice& id, const Slice& data) {
+      ++count;
+      batch.push_back(SysCatalogEntry{id.ToBuffer(), data.ToBuffer()});
+      if (batch.size() < batch_size) {
+        return Status::OK();
+      }
+      auto status = visitor->VisitBatch(batch, load_pool_.get());
+      batch.clear();
+      return status;
+    }));
+    if (!batch.empty()) {
+      RETURN_NOT_OK(visitor->VisitBatch(batch, load_pool_.get()));
+    }
+  }
 
   auto duration = CoarseMonoClock::Now() - start;
   string id = Format("num_entries_with_type_$0_loaded", std::to_string(visitor->entry_type()));
@@ -813,5 +856,45 @@ const Schema& SysCatalogTable::schema() {
   return schema_;
 }
 
+Status VisitorBase::VisitBatch(const std::vector<SysCatalogEntry>& entries, ThreadPool* pool) {
+  for (const auto& entry : entries) {
+    RETURN_NOT_OK(Visit(entry.id, entry.data));
+  }
+  return Status::OK();
+}
+
+Status VisitorBase::ParallelFor(
+    size_t count, ThreadPool* pool, const std::function<Status(size_t, size_t)>& func) {
+  // Don't bother other threads with small ranges.
+  constexpr size_t kMinRangeSize = 64;
+  const size_t num_ranges = pool ? std::min<size_t>(
+      std::max(FLAGS_sys_catalog_load_parallelism, 1), count / kMinRangeSize) : 1;
+  if (num_ranges <= 1) {
+    return func(0, count);
+  }
+
+  std::vector<Status> statuses(num_ranges);
+  CountDownLatch latch(num_ranges - 1);
+  for (size_t i = 1; i != num_ranges; ++i) {
+    const size_t begin = count * i / num_ranges;
+    const size_t end = count * (i + 1) / num_ranges;
+    auto* status = &statuses[i];
+    auto task = [&func, &latch, status, begin, end] {
+      *status = func(begin, end);
+      latch.CountDown();
+    };
+    if (!pool->SubmitFunc(task).ok()) {
+      task();
+    }
+  }
+  statuses[0] = func(0, count / num_ranges);
+  latch.Wait();
+
+  for (auto& status : statuses) {
+    RETURN_NOT_OK(status);
+  }
+  return Status::OK();
+}
+
 } // namespace master
 } // namespace yb
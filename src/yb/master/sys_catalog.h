@@ -237,6 +237,9 @@ class SysCatalogTable {
 
   std::unique_ptr<ThreadPool> allocation_pool_;
 
+  // Thread pool for parsing entries loaded by Visit, null when they are parsed by the visitor.
+  std::unique_ptr<ThreadPool> load_pool_;
+
   std::shared_ptr<tablet::TabletPeer> tablet_peer_;
 
   Master* master_;
@@ -0,0 +1,108 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/master/ts_admin_rpc_batcher.h"
+
+#include <algorithm>
+
+#include "yb/tserver/tserver_admin.proxy.h"
+
+#include "yb/util/flag_tags.h"
+
+using namespace std::literals;
+
+DEFINE_int32(ts_admin_rpc_batch_window_ms, 5,
+             "CreateTablet and DeleteTablet requests, that master sends to the same tablet "
+             "server, are collected during this time and sent in one RPC. 0 disables batching.");
+TAG_FLAG(ts_admin_rpc_batch_window_ms, advanced);
+TAG_FLAG(ts_admin_rpc_batch_window_ms, runtime);
+
+DEFINE_int32(ts_admin_rpc_batch_max_size, 100,
+             "Maximum number of CreateTablet or DeleteTablet requests sent in one batched RPC.");
+TAG_FLAG(ts_admin_rpc_batch_max_size, advanced);
+TAG_FLAG(ts_admin_rpc_batch_max_size, runtime);
+
+DECLARE_int32(master_ts_rpc_timeout_ms);
+
+namespace yb {
+namespace master {
+
+MonoDelta TSAdminRpcTraitsBase::BatchWindow() {
+  return FLAGS_ts_admin_rpc_batch_window_ms * 1ms;
+}
+
+size_t TSAdminRpcTraitsBase::MaxBatchSize() {
+  return std::max(FLAGS_ts_admin_rpc_batch_max_size, 1);
+}
+
+MonoDelta TSAdminRpcTraitsBase::Timeout() {
+  return FLAGS_master_ts_rpc_timeout_ms * 1ms;
+}
+
+void CreateTabletRpcTraits::Send(
+    tserver::TabletServerAdminServiceProxy* proxy, const Request& request, Response* response,
+    rpc::RpcController* controller, rpc::ResponseCallback callback) {
+  proxy->CreateTabletAsync(request, response, controller, std::move(callback));
+}
+
+void CreateTabletRpcTraits::SendBatch(
+    tserver::TabletServerAdminServiceProxy* proxy, const BatchRequest& request,
+    BatchResponse* response, rpc::RpcController* controller, rpc::ResponseCallback callback) {
+  proxy->CreateTabletsAsync(request, response, controller, std::move(callback));
+}
+
+void DeleteTabletRpcTraits::Send(
+    tserver::TabletServerAdminServiceProxy* proxy, const Request& request, Response* response,
+    rpc::RpcController* controller, rpc::ResponseCallback callback) {
+  proxy->DeleteTabletAsync(request, response, controller, std::move(callback));
+}
+
+void DeleteTabletRpcTraits::SendBatch(
+    tserver::TabletServerAdminServiceProxy* proxy, const BatchRequest& request,
+    BatchResponse* response, rpc::RpcController* controller, rpc::ResponseCallback callback) {
+  proxy->DeleteTabletsAsync(request, response, controller, std::move(callback));
+}
+
+TSAdminRpcBatchers::TSAdminRpcBatchers(rpc::Messenger* messenger) : messenger_(messenger) {
+}
+
+TSAdminRpcBatchers::~TSAdminRpcBatchers() = default;
+
+std::shared_ptr<CreateTabletRpcBatcher> TSAdminRpcBatchers::CreateTabletBatcher(
+    const std::string& ts_uuid, const TSAdminProxyPtr& proxy) {
+  return GetBatcher(ts_uuid, proxy, &create_batchers_);
+}
+
+std::shared_ptr<DeleteTabletRpcBatcher> TSAdminRpcBatchers::DeleteTabletBatcher(
+    const std::string& ts_uuid, const TSAdminProxyPtr& proxy) {
+  return GetBatcher(ts_uuid, proxy, &delete_batchers_);
+}
+
+template <class Batcher>
+std::shared_ptr<Batcher> TSAdminRpcBatchers::GetBatcher(
+    const std::string& ts_uuid, const TSAdminProxyPtr& proxy,
+    std::unordered_map<std::string, std::shared_ptr<Batcher>>* batchers) {
+  if (FLAGS_ts_admin_rpc_batch_window_ms <= 0 || !messenger_ || !proxy) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& batcher = (*batchers)[ts_uuid];
+  if (!batcher || batcher->proxy() != proxy) {
+    batcher = std::make_shared<Batcher>(ts_uuid, proxy, messenger_);
+  }
+  return batcher;
+}
+
+}  // namespace master
+}  // namespace yb
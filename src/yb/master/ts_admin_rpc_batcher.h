@@ -0,0 +1,138 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_TS_ADMIN_RPC_BATCHER_H
+#define YB_MASTER_TS_ADMIN_RPC_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/rpc/rpc_batcher.h"
+
+#include "yb/tserver/tserver_admin.pb.h"
+
+namespace yb {
+
+namespace tserver {
+class TabletServerAdminServiceProxy;
+}
+
+namespace master {
+
+typedef std::shared_ptr<tserver::TabletServerAdminServiceProxy> TSAdminProxyPtr;
+
+// Batching parameters shared by admin RPCs, see ts_admin_rpc_batch_window_ms and
+// ts_admin_rpc_batch_max_size.
+struct TSAdminRpcTraitsBase {
+  typedef tserver::TabletServerAdminServiceProxy Proxy;
+
+  static MonoDelta BatchWindow();
+  static size_t MaxBatchSize();
+  static MonoDelta Timeout();
+};
+
+struct CreateTabletRpcTraits : public TSAdminRpcTraitsBase {
+  typedef tserver::CreateTabletRequestPB Request;
+  typedef tserver::CreateTabletResponsePB Response;
+  typedef tserver::CreateTabletsRequestPB BatchRequest;
+  typedef tserver::CreateTabletsResponsePB BatchResponse;
+
+  static const char* Name() { return "CreateTablet"; }
+
+  static void Send(
+      tserver::TabletServerAdminServiceProxy* proxy, const Request& request, Response* response,
+      rpc::RpcController* controller, rpc::ResponseCallback callback);
+  static void SendBatch(
+      tserver::TabletServerAdminServiceProxy* proxy, const BatchRequest& request,
+      BatchResponse* response, rpc::RpcController* controller, rpc::ResponseCallback callback);
+
+  static Request* AddRequest(BatchRequest* batch) { return batch->add_create_tablet_request(); }
+  static const Request& GetRequest(const BatchRequest& batch, int index) {
+    return batch.create_tablet_request(index);
+  }
+  static int ResponseSize(const BatchResponse& batch) {
+    return batch.create_tablet_response_size();
+  }
+  static Response* MutableResponse(BatchResponse* batch, int index) {
+    return batch->mutable_create_tablet_response(index);
+  }
+};
+
+struct DeleteTabletRpcTraits : public TSAdminRpcTraitsBase {
+  typedef tserver::DeleteTabletRequestPB Request;
+  typedef tserver::DeleteTabletResponsePB Response;
+  typedef tserver::DeleteTabletsRequestPB BatchRequest;
+  typedef tserver::DeleteTabletsResponsePB BatchResponse;
+
+  static const char* Name() { return "DeleteTablet"; }
+
+  static void Send(
+      tserver::TabletServerAdminServiceProxy* proxy, const Request& request, Response* response,
+      rpc::RpcController* controller, rpc::ResponseCallback callback);
+  static void SendBatch(
+      tserver::TabletServerAdminServiceProxy* proxy, const BatchRequest& request,
+      BatchResponse* response, rpc::RpcController* controller, rpc::ResponseCallback callback);
+
+  static Request* AddRequest(BatchRequest* batch) { return batch->add_delete_tablet_request(); }
+  static const Request& GetRequest(const BatchRequest& batch, int index) {
+    return batch.delete_tablet_request(index);
+  }
+  static int ResponseSize(const BatchResponse& batch) {
+    return batch.delete_tablet_response_size();
+  }
+  static Response* MutableResponse(BatchResponse* batch, int index) {
+    return batch->mutable_delete_tablet_response(index);
+  }
+};
+
+// Admin RPCs of one kind, that async tasks send to the same tablet server, are coalesced into one
+// batched RPC. So creating or deleting a table with many tablets does not issue an RPC per tablet
+// replica. Each task keeps its own retry state and TasksTracker entry, only the transport is
+// shared.
+typedef rpc::RpcBatcher<CreateTabletRpcTraits> CreateTabletRpcBatcher;
+typedef rpc::RpcBatcher<DeleteTabletRpcTraits> DeleteTabletRpcBatcher;
+
+// Keeps admin RPC batchers of all tablet servers.
+class TSAdminRpcBatchers {
+ public:
+  explicit TSAdminRpcBatchers(rpc::Messenger* messenger);
+
+  ~TSAdminRpcBatchers();
+
+  // Return batcher for the tablet server with the specified uuid and admin proxy, or null if
+  // batching is disabled. Batcher is recreated when proxy of the tablet server changes, e.g.
+  // after it registered with a different address.
+  std::shared_ptr<CreateTabletRpcBatcher> CreateTabletBatcher(
+      const std::string& ts_uuid, const TSAdminProxyPtr& proxy);
+  std::shared_ptr<DeleteTabletRpcBatcher> DeleteTabletBatcher(
+      const std::string& ts_uuid, const TSAdminProxyPtr& proxy);
+
+ private:
+  template <class Batcher>
+  std::shared_ptr<Batcher> GetBatcher(
+      const std::string& ts_uuid, const TSAdminProxyPtr& proxy,
+      std::unordered_map<std::string, std::shared_ptr<Batcher>>* batchers);
+
+  rpc::Messenger* const messenger_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<CreateTabletRpcBatcher>> create_batchers_;
+  std::unordered_map<std::string, std::shared_ptr<DeleteTabletRpcBatcher>> delete_batchers_;
+};
+
+}  // namespace master
+}  // namespace yb
+
+#endif  // YB_MASTER_TS_ADMIN_RPC_BATCHER_H
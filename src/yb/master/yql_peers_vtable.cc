@@ -19,6 +19,15 @@
 
 #include "yb/rpc/messenger.h"
 
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(peers_vtable_cache_ttl_ms, 1000,
+             "Time in milliseconds for which rows of system.peers table are cached, while the set "
+             "of live tablet servers and their registrations do not change. 0 disables the "
+             "cache.");
+TAG_FLAG(peers_vtable_cache_ttl_ms, advanced);
+TAG_FLAG(peers_vtable_cache_ttl_ms, runtime);
+
 namespace yb {
 namespace master {
 
@@ -63,8 +72,50 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
 
   const auto& proxy_uuid = request.proxy_uuid();
 
+  auto peers = VERIFY_RESULT(GetPeers(descs));
+
   // Populate the YQL rows.
   auto vtable = std::make_shared<QLRowBlock>(schema_);
+  for (size_t i = 0; i != peers->ts_infos.size(); ++i) {
+    const auto& ts_info = peers->ts_infos[i];
+    // The system.peers table has one entry for each of its peers, whereas there is no entry for
+    // the node that the CQL client connects to. In this case, this node is the 'remote_endpoint'
+    // in QLReadRequestPB since that is address of the CQL proxy which sent this request. As a
+    // result, skip 'remote_endpoint' in the results.
+    if (!proxy_uuid.empty()) {
+      if (ts_info.tserver_instance().permanent_uuid() == proxy_uuid) {
+        continue;
+      }
+    } else {
+      // In case of old proxy, fallback to old endpoint based mechanism.
+      if (util::RemoteEndpointMatchesTServer(ts_info, remote_endpoint)) {
+        continue;
+      }
+    }
+    RETURN_NOT_OK(vtable->AddRow(peers->rows.rows()[i]));
+  }
+
+  return vtable;
+}
+
+Result<std::shared_ptr<const PeersVTable::Peers>> PeersVTable::GetPeers(
+    const std::vector<std::shared_ptr<TSDescriptor>>& descs) const {
+  // Tablet server information is replaced when the tablet server registers again, so comparing
+  // pointers also detects changes of its addresses.
+  std::vector<std::shared_ptr<TSInformationPB>> ts_infos;
+  ts_infos.reserve(descs.size());
+  for (const auto& desc : descs) {
+    // This is thread safe since all operations are reads.
+    ts_infos.push_back(desc->GetTSInformationPB());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FLAGS_peers_vtable_cache_ttl_ms > 0 && cache_ && cached_ts_infos_ == ts_infos &&
+        CoarseMonoClock::Now() < cache_expiration_) {
+      return cache_;
+    }
+  }
 
   struct Entry {
     size_t index;
@@ -76,33 +127,14 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
   entries.reserve(descs.size());
 
   size_t index = 0;
-  for (const auto& desc : descs) {
-    size_t current_index = index++;
-
-    // This is thread safe since all operations are reads.
-    TSInformationPB ts_info = *desc->GetTSInformationPB();
-
-    if (!proxy_uuid.empty()) {
-      if (desc->permanent_uuid() == proxy_uuid) {
-        continue;
-      }
-    } else {
-      // In case of old proxy, fallback to old endpoint based mechanism.
-      if (util::RemoteEndpointMatchesTServer(ts_info, remote_endpoint)) {
-        continue;
-      }
-    }
-
-    entries.push_back({current_index, std::move(ts_info)});
+  for (const auto& ts_info : ts_infos) {
+    entries.push_back({index++, *ts_info});
     auto& entry = entries.back();
     entry.ts_ips = util::GetPublicPrivateIPFutures(entry.ts_info, resolver_.get());
   }
 
+  auto peers = std::make_shared<Peers>(schema_);
   for (const auto& entry : entries) {
-    // The system.peers table has one entry for each of its peers, whereas there is no entry for
-    // the node that the CQL client connects to. In this case, this node is the 'remote_endpoint'
-    // in QLReadRequestPB since that is address of the CQL proxy which sent this request. As a
-    // result, skip 'remote_endpoint' in the results.
     auto private_ip = entry.ts_ips.private_ip_future.get();
     if (!private_ip.ok()) {
       LOG(ERROR) << "Failed to get private ip from " << entry.ts_info.ShortDebugString()
@@ -119,7 +151,8 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
 
     // Need to use only 1 rpc address per node since system.peers has only 1 entry for each host,
     // so pick the first one.
-    QLRow &row = vtable->Extend();
+    peers->ts_infos.push_back(entry.ts_info);
+    QLRow &row = peers->rows.Extend();
     RETURN_NOT_OK(SetColumnValue(kPeer, *public_ip, &row));
     RETURN_NOT_OK(SetColumnValue(kRPCAddress, *public_ip, &row));
     RETURN_NOT_OK(SetColumnValue(kPreferredIp, *private_ip, &row));
@@ -144,7 +177,12 @@ Result<std::shared_ptr<QLRowBlock>> PeersVTable::RetrieveData(
         kTokens, util::GetTokensValue(entry.index, descs.size()), &row));
   }
 
-  return vtable;
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_ = peers;
+  cached_ts_infos_ = std::move(ts_infos);
+  cache_expiration_ =
+      CoarseMonoClock::Now() + std::chrono::milliseconds(FLAGS_peers_vtable_cache_ttl_ms);
+  return peers;
 }
 
 Schema PeersVTable::CreateSchema() const {
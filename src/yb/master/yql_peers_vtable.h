@@ -14,8 +14,11 @@
 #ifndef YB_MASTER_YQL_PEERS_VTABLE_H
 #define YB_MASTER_YQL_PEERS_VTABLE_H
 
+#include <mutex>
+
 #include "yb/master/yql_virtual_table.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_fwd.h"
 
 namespace yb {
@@ -30,7 +33,26 @@ class PeersVTable : public YQLVirtualTable {
  private:
   Schema CreateSchema() const;
 
+  // Rows for all live tablet servers, before skipping the one that sent the request.
+  struct Peers {
+    std::vector<TSInformationPB> ts_infos;
+    QLRowBlock rows;
+
+    explicit Peers(const Schema& schema) : rows(schema) {}
+  };
+
+  // Returns rows for the specified descriptors, reusing cached rows while the set of live
+  // tablet servers and their registrations are the same, to avoid resolving their addresses on
+  // every query.
+  Result<std::shared_ptr<const Peers>> GetPeers(
+      const std::vector<std::shared_ptr<TSDescriptor>>& descs) const;
+
   std::unique_ptr<Resolver> resolver_;
+
+  mutable std::mutex mutex_;
+  mutable std::shared_ptr<const Peers> cache_;
+  mutable std::vector<std::shared_ptr<TSInformationPB>> cached_ts_infos_;
+  mutable CoarseTimePoint cache_expiration_;
 };
 
 }  // namespace master
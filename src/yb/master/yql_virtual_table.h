@@ -109,6 +109,17 @@ class YQLVirtualTable : public common::YQLStorageIf {
     return Status::OK();
   }
 
+  CHECKED_STATUS GetIterator(const Schema& projection,
+                             const Schema& schema,
+                             const TransactionOperationContextOpt& txn_op_context,
+                             CoarseTimePoint deadline,
+                             const ReadHybridTime& read_time,
+                             const std::vector<Slice>& ybctids,
+                             common::YQLRowwiseIteratorIf::UniPtr* iter) const override {
+    LOG(FATAL) << "Postgresql virtual tables are not yet implemented";
+    return Status::OK();
+  }
+
  protected:
   // Finds the given column name in the schema and updates the specified column in the given row
   // with the provided value.
@@ -157,6 +157,38 @@ class CompactionFilterFactory {
 
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
+
+  // Returns the key that should be used as a boundary between subcompactions instead of the
+  // user_key, or an empty slice if the user_key should not be used as a boundary. Result should be
+  // a prefix of the user_key.
+  // Each subcompaction uses its own compaction filter, so this could be used to keep keys that
+  // the filter should see together, in the same subcompaction.
+  virtual Slice SubcompactionBoundary(const Slice& user_key) const {
+    return user_key;
+  }
+
+  // Returns time window of the SST file with the specified largest user frontier. Universal
+  // compaction does not compact files from different time windows together, so data written
+  // during one window is kept in separate files, that could expire as a whole.
+  virtual uint64_t TimeWindow(const UserFrontier& largest_frontier) const {
+    return 0;
+  }
+
+  // Returns true if all entries of the SST file with the specified largest user frontier are
+  // expired, so the file could be deleted without compaction.
+  virtual bool Expired(const UserFrontier& largest_frontier) const {
+    return false;
+  }
+
+  // Returns true if all entries of the oldest SST file with the specified largest user frontier
+  // are expired, so the file could be deleted without compaction. newer_files_frontier is the
+  // merged largest user frontier of all newer files, or null if there are no such files. Files are
+  // checked starting from the oldest one, and checking stops at the first file that is not
+  // expired.
+  virtual bool ExpiredOldest(
+      const UserFrontier& largest_frontier, const UserFrontier* newer_files_frontier) const {
+    return false;
+  }
 };
 
 }  // namespace rocksdb
@@ -799,6 +799,10 @@ class DB {
   // Returns total number of SST Files.
   virtual uint64_t GetCurrentVersionNumSSTFiles() { return 0; }
 
+  // Closes table readers of SST files that are not in use, they are reopened on next access.
+  // Returns number of closed table readers.
+  virtual size_t ReleaseTableReaders() { return 0; }
+
   // Returns the combined size of all the SST Files data blocks for the current version in the
   // rocksdb instance.
   virtual uint64_t GetCurrentVersionDataSstFilesSize() { return 0; }
@@ -58,11 +58,12 @@ TableBuilder* NewTableBuilder(const ImmutableCFOptions& ioptions,
                               WritableFileWriter* file,
                               const CompressionType compression_type,
                               const CompressionOptions& compression_opts,
-                              const bool skip_filters) {
+                              const bool skip_filters,
+                              const std::string* compression_dict) {
   return ioptions.table_factory->NewTableBuilder(
       TableBuilderOptions(ioptions, internal_comparator,
                           int_tbl_prop_collector_factories, compression_type,
-                          compression_opts, skip_filters),
+                          compression_opts, skip_filters, compression_dict),
       column_family_id, file);
 }
 
@@ -74,11 +75,12 @@ TableBuilder* NewTableBuilder(const ImmutableCFOptions& ioptions,
                               WritableFileWriter* data_file,
                               const CompressionType compression_type,
                               const CompressionOptions& compression_opts,
-                              const bool skip_filters) {
+                              const bool skip_filters,
+                              const std::string* compression_dict) {
   return ioptions.table_factory->NewTableBuilder(
       TableBuilderOptions(ioptions, internal_comparator,
           int_tbl_prop_collector_factories, compression_type,
-          compression_opts, skip_filters),
+          compression_opts, skip_filters, compression_dict),
       column_family_id, metadata_file, data_file);
 }
 
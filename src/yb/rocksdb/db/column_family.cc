@@ -138,6 +138,13 @@ Status CheckCompressionSupported(const ColumnFamilyOptions& cf_options) {
           " is not linked with the binary.");
     }
   }
+  if (cf_options.large_compaction_compression_threshold != 0 &&
+      !CompressionTypeSupported(cf_options.large_compaction_compression)) {
+    return STATUS(InvalidArgument,
+        "Compression type " +
+        CompressionTypeToString(cf_options.large_compaction_compression) +
+        " is not linked with the binary.");
+  }
   return Status::OK();
 }
 
@@ -350,7 +357,7 @@ void SuperVersionUnrefHandle(void* ptr) {
 
 ColumnFamilyData::ColumnFamilyData(
     uint32_t id, const std::string& name, Version* _dummy_versions,
-    Cache* _table_cache, WriteBuffer* write_buffer,
+    Cache* _table_cache, uint64_t table_cache_id, WriteBuffer* write_buffer,
     const ColumnFamilyOptions& cf_options, const DBOptions* db_options,
     const EnvOptions& env_options, ColumnFamilySet* column_family_set)
     : id_(id),
@@ -387,7 +394,7 @@ ColumnFamilyData::ColumnFamilyData(
   if (_dummy_versions != nullptr) {
     internal_stats_.reset(
         new InternalStats(ioptions_.num_levels, db_options->env, this));
-    table_cache_.reset(new TableCache(ioptions_, env_options, _table_cache));
+    table_cache_.reset(new TableCache(ioptions_, env_options, _table_cache, table_cache_id));
     if (ioptions_.compaction_style == kCompactionStyleLevel) {
       compaction_picker_.reset(
           new LevelCompactionPicker(ioptions_, internal_comparator_.get()));
@@ -891,9 +898,10 @@ ColumnFamilySet::ColumnFamilySet(const std::string& dbname,
                                  const EnvOptions& env_options,
                                  Cache* table_cache,
                                  WriteBuffer* write_buffer,
-                                 WriteController* write_controller)
+                                 WriteController* write_controller,
+                                 uint64_t table_cache_id)
     : max_column_family_(0),
-      dummy_cfd_(new ColumnFamilyData(0, "", nullptr, nullptr, nullptr,
+      dummy_cfd_(new ColumnFamilyData(0, "", nullptr, nullptr, 0, nullptr,
                                       ColumnFamilyOptions(), db_options,
                                       env_options, nullptr)),
       default_cfd_cache_(nullptr),
@@ -901,6 +909,7 @@ ColumnFamilySet::ColumnFamilySet(const std::string& dbname,
       db_options_(db_options),
       env_options_(env_options),
       table_cache_(table_cache),
+      table_cache_id_(table_cache_id),
       write_buffer_(write_buffer),
       write_controller_(write_controller) {
   // initialize linked list
@@ -965,7 +974,7 @@ ColumnFamilyData* ColumnFamilySet::CreateColumnFamily(
     const ColumnFamilyOptions& options) {
   DCHECK_EQ(column_families_.count(name), 0);
   ColumnFamilyData* new_cfd =
-      new ColumnFamilyData(id, name, dummy_versions, table_cache_,
+      new ColumnFamilyData(id, name, dummy_versions, table_cache_, table_cache_id_,
                            write_buffer_, options, db_options_,
                            env_options_, this);
   column_families_.insert({name, id});
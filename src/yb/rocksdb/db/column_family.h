@@ -342,7 +342,7 @@ class ColumnFamilyData {
   friend class ColumnFamilySet;
   ColumnFamilyData(uint32_t id, const std::string& name,
                    Version* dummy_versions, Cache* table_cache,
-                   WriteBuffer* write_buffer,
+                   uint64_t table_cache_id, WriteBuffer* write_buffer,
                    const ColumnFamilyOptions& options,
                    const DBOptions* db_options, const EnvOptions& env_options,
                    ColumnFamilySet* column_family_set);
@@ -456,7 +456,8 @@ class ColumnFamilySet {
 
   ColumnFamilySet(const std::string& dbname, const DBOptions* db_options,
                   const EnvOptions& env_options, Cache* table_cache,
-                  WriteBuffer* write_buffer, WriteController* write_controller);
+                  WriteBuffer* write_buffer, WriteController* write_controller,
+                  uint64_t table_cache_id = 0);
   ~ColumnFamilySet();
 
   ColumnFamilyData* GetDefault() const;
@@ -511,6 +512,7 @@ class ColumnFamilySet {
   const DBOptions* const db_options_;
   const EnvOptions env_options_;
   Cache* table_cache_;
+  const uint64_t table_cache_id_;
   WriteBuffer* write_buffer_;
   WriteController* write_controller_;
 };
@@ -544,6 +544,8 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
+    // Output files of subcompactions into level 0 would be separate sorted runs with interleaved
+    // sequence number ranges, that universal compaction does not support.
     return number_levels_ > 1 && output_level_ > 0;
   } else {
     return false;
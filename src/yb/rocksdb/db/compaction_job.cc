@@ -30,9 +30,12 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <vector>
 #include <memory>
+#include <condition_variable>
 #include <list>
+#include <mutex>
 #include <set>
 #include <thread>
 #include <utility>
@@ -62,6 +65,7 @@
 #include "yb/rocksdb/table/merger.h"
 #include "yb/rocksdb/table/table_builder.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/log_buffer.h"
 #include "yb/rocksdb/util/logging.h"
@@ -72,11 +76,32 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/thread_status_util.h"
 
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/priority_thread_pool.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
+DEFINE_uint64(rocksdb_min_subcompaction_size_bytes, 256 * 1024 * 1024,
+              "Minimal approximate size of input data processed by a single subcompaction, when "
+              "size of compaction output files is not limited.");
+TAG_FLAG(rocksdb_min_subcompaction_size_bytes, advanced);
+
 namespace rocksdb {
 
+namespace {
+
+// Subcompactions continue the compaction that is already running, so they are scheduled with
+// priority higher than regular compactions, but lower than flushes (kFlushPriority in db_impl.cc).
+constexpr int kSubcompactionPriority = 99;
+
+// Size of continuous chunk of compaction input sampled to build compression dictionary. It is
+// close to the size of data block, so the dictionary captures content repeated across blocks.
+constexpr size_t kCompressionDictSampleSize = 4_KB;
+
+} // namespace
+
 // Maintains state for each sub-compaction
 struct CompactionJob::SubcompactionState {
   Compaction* compaction;
@@ -121,6 +146,9 @@ struct CompactionJob::SubcompactionState {
   uint64_t num_output_records;
   CompactionJobStats compaction_job_stats;
   uint64_t approx_size;
+  // Suspender of the thread that processes this subcompaction.
+  yb::PriorityThreadPoolSuspender* suspender = nullptr;
+  UserFrontierPtr largest_user_frontier;
 
   SubcompactionState(Compaction* c, Slice* _start, Slice* _end,
                      uint64_t size = 0)
@@ -153,6 +181,8 @@ struct CompactionJob::SubcompactionState {
     num_output_records = std::move(o.num_output_records);
     compaction_job_stats = std::move(o.compaction_job_stats);
     approx_size = std::move(o.approx_size);
+    suspender = o.suspender;
+    largest_user_frontier = std::move(o.largest_user_frontier);
     return *this;
   }
 
@@ -374,6 +404,7 @@ void CompactionJob::GenSubcompactionBoundaries() {
   std::vector<Slice> bounds;
   int start_lvl = c->start_level();
   int out_lvl = c->output_level();
+  const bool universal = cfd->ioptions()->compaction_style == kCompactionStyleUniversal;
 
   // Add the starting and/or ending key of certain input files as a potential
   // boundary
@@ -394,6 +425,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
           bounds.emplace_back(flevel->files[i].smallest.key);
           bounds.emplace_back(flevel->files[i].largest.key);
         }
+        // With universal compaction all input files could cover the same key range, so split
+        // them using keys sampled from their indexes.
+        if (universal) {
+          AddSampledBounds(*flevel, lvl, &bounds);
+        }
       } else {
         // For all other levels add the smallest/largest key in the level to
         // encompass the range covered by that level
@@ -443,9 +479,16 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const uint64_t max_output_file_size = c->max_output_file_size();
+  uint64_t max_output_files;
+  if (max_output_file_size == std::numeric_limits<uint64_t>::max()) {
+    // Output is not split into files by size, so each subcompaction produces a single file.
+    // Avoid producing too many small files.
+    max_output_files = std::max<uint64_t>(sum / FLAGS_rocksdb_min_subcompaction_size_bytes, 1);
+  } else {
+    max_output_files = static_cast<uint64_t>(std::ceil(
+        sum / min_file_fill_percent / max_output_file_size));
+  }
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -455,6 +498,11 @@ void CompactionJob::GenSubcompactionBoundaries() {
                                     : std::numeric_limits<double>::max();
 
   if (subcompactions > 1) {
+    // Compaction filter factory could adjust boundaries, when the compaction filter is not set
+    // explicitly, i.e. each subcompaction uses its own filter.
+    const CompactionFilterFactory* filter_factory =
+        cfd->ioptions()->compaction_filter ? nullptr
+                                           : cfd->ioptions()->compaction_filter_factory;
     // Greedily add ranges to the subcompaction until the sum of the ranges'
     // sizes becomes >= the expected mean size of a subcompaction
     sum = 0;
@@ -466,7 +514,16 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        Slice boundary = ExtractUserKey(ranges[i].range.limit);
+        if (filter_factory) {
+          boundary = filter_factory->SubcompactionBoundary(boundary);
+          if (boundary.empty() || (!boundaries_.empty() &&
+                                   cfd_comparator->Compare(boundaries_.back(), boundary) >= 0)) {
+            // Continue with the current subcompaction till the next suitable boundary.
+            continue;
+          }
+        }
+        boundaries_.push_back(boundary);
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
@@ -479,6 +536,196 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+void CompactionJob::AddSampledBounds(
+    const LevelFilesBrief& flevel, int level, std::vector<Slice>* bounds) {
+  auto* cfd = compact_->compaction->column_family_data();
+  // Sample several times more keys than the number of subcompactions, so ranges could be grouped
+  // into subcompactions of similar size.
+  const size_t keys_per_file = db_options_.max_subcompactions * 4;
+  const size_t old_size = sampled_keys_.size();
+  for (size_t i = 0; i < flevel.num_files; i++) {
+    auto trwh = cfd->table_cache()->GetTableReader(
+        env_options_, cfd->internal_comparator(), flevel.files[i].fd, kDefaultQueryId,
+        /* no_io =*/ false, cfd->internal_stats()->GetFileReadHist(level),
+        /* skip_filters =*/ true);
+    auto keys = trwh.ok() ? trwh->table_reader->GetSampleKeys(keys_per_file)
+                          : yb::Result<std::vector<std::string>>(trwh.status());
+    if (!keys.ok()) {
+      // Sampled keys only improve balance between subcompactions.
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+           "[%s] [JOB %d] Failed to sample keys from file #%" PRIu64 ": %s",
+           cfd->GetName().c_str(), job_id_, flevel.files[i].fd.GetNumber(),
+           keys.status().ToString().c_str());
+      continue;
+    }
+    std::move(keys->begin(), keys->end(), std::back_inserter(sampled_keys_));
+  }
+  // Slices are added after all keys are sampled, since sampled_keys_ could be reallocated.
+  for (size_t i = old_size; i < sampled_keys_.size(); i++) {
+    bounds->emplace_back(sampled_keys_[i]);
+  }
+}
+
+void CompactionJob::BuildCompressionDict() {
+  auto* c = compact_->compaction;
+  auto* cfd = c->column_family_data();
+  const auto& compression_opts = cfd->ioptions()->compression_opts;
+  if (c->output_compression() != kZSTDNotFinalCompression ||
+      compression_opts.max_dict_bytes == 0) {
+    return;
+  }
+  const uint64_t input_size = c->CalculateTotalInputSize();
+  if (input_size == 0) {
+    return;
+  }
+
+  const size_t max_sample_bytes =
+      std::max(compression_opts.max_dict_bytes, compression_opts.zstd_max_train_bytes);
+  ReadOptions read_options;
+  read_options.fill_cache = false;
+  std::string samples;
+  std::vector<size_t> sample_lengths;
+  for (size_t i = 0; i < c->num_input_levels(); i++) {
+    for (const auto* f : *c->inputs(i)) {
+      // Each file gets part of the samples proportional to its size.
+      const size_t file_sample_bytes = max_sample_bytes * f->fd.GetTotalFileSize() / input_size;
+      const size_t num_samples =
+          std::max<size_t>(file_sample_bytes / kCompressionDictSampleSize, 1);
+      auto trwh = cfd->table_cache()->GetTableReader(
+          env_options_, cfd->internal_comparator(), f->fd, kDefaultQueryId,
+          /* no_io =*/ false, cfd->internal_stats()->GetFileReadHist(c->level(i)),
+          /* skip_filters =*/ true);
+      auto keys = trwh.ok() ? trwh->table_reader->GetSampleKeys(num_samples)
+                            : yb::Result<std::vector<std::string>>(trwh.status());
+      if (!keys.ok()) {
+        // Output is still readable without dictionary, it is just compressed worse.
+        RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+             "[%s] [JOB %d] Failed to sample file #%" PRIu64 " for compression dictionary: %s",
+             cfd->GetName().c_str(), job_id_, f->fd.GetNumber(),
+             keys.status().ToString().c_str());
+        continue;
+      }
+      std::unique_ptr<InternalIterator> iter(trwh->table_reader->NewIterator(
+          read_options, /* arena =*/ nullptr, /* skip_filters =*/ true));
+      for (const auto& key : *keys) {
+        const size_t sample_start = samples.size();
+        for (iter->Seek(key);
+             iter->Valid() && samples.size() - sample_start < kCompressionDictSampleSize;
+             iter->Next()) {
+          samples.append(iter->key().cdata(), iter->key().size());
+          samples.append(iter->value().cdata(), iter->value().size());
+        }
+        if (samples.size() != sample_start) {
+          sample_lengths.push_back(samples.size() - sample_start);
+        }
+      }
+    }
+  }
+
+  if (compression_opts.zstd_max_train_bytes > 0) {
+    compression_dict_ =
+        ZSTD_TrainDictionary(samples, sample_lengths, compression_opts.max_dict_bytes);
+  } else {
+    samples.resize(std::min<size_t>(samples.size(), compression_opts.max_dict_bytes));
+    compression_dict_ = std::move(samples);
+  }
+  RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
+       "[%s] [JOB %d] Compression dictionary of %" ROCKSDB_PRIszt " bytes built from %"
+       ROCKSDB_PRIszt " samples",
+       cfd->GetName().c_str(), job_id_, compression_dict_.size(), sample_lengths.size());
+}
+
+// Subcompactions are submitted to the priority thread pool, but a subcompaction that was not
+// started by the pool yet is processed by the compaction thread itself, after it is done with its
+// own subcompaction. So the compaction never waits for pool workers, that could be busy with other
+// compactions waiting for their subcompactions.
+class CompactionJob::SubcompactionRunner {
+ public:
+  SubcompactionRunner(CompactionJob* job, FileNumbersHolder* holder)
+      : job_(job), holder_(holder), started_(job->compact_->sub_compact_states.size()) {}
+
+  // Processes subcompaction with specified index, unless it was already started.
+  void TryRun(size_t idx, yb::PriorityThreadPoolSuspender* suspender) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (started_[idx]) {
+        return;
+      }
+      started_[idx] = true;
+      ++running_;
+    }
+    auto* sub_compact = &job_->compact_->sub_compact_states[idx];
+    sub_compact->suspender = suspender;
+    job_->ProcessKeyValueCompaction(holder_, sub_compact);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--running_ == 0) {
+      cond_.notify_all();
+    }
+  }
+
+  // Processes all subcompactions that were not started yet and waits for the rest to complete.
+  void RunRemainingAndWait(yb::PriorityThreadPoolSuspender* suspender) {
+    for (size_t i = 0; i != started_.size(); ++i) {
+      TryRun(i, suspender);
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return running_ == 0; });
+  }
+
+ private:
+  CompactionJob* const job_;
+  FileNumbersHolder* const holder_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<bool> started_;
+  size_t running_ = 0;
+};
+
+class CompactionJob::SubcompactionTask : public yb::PriorityThreadPoolTask {
+ public:
+  SubcompactionTask(std::shared_ptr<SubcompactionRunner> runner, int job_id, size_t idx)
+      : runner_(std::move(runner)), job_id_(job_id), idx_(idx) {}
+
+  void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+    // Aborted subcompaction is processed by the compaction thread.
+    if (status.ok()) {
+      runner_->TryRun(idx_, suspender);
+    }
+  }
+
+  // Subcompactions are not removed from the pool, since the compaction waits for them.
+  bool BelongsTo(void* key) override {
+    return false;
+  }
+
+  std::string ToString() const override {
+    return yb::Format("{ subcompaction: $0 job: $1 }", idx_, job_id_);
+  }
+
+ private:
+  std::shared_ptr<SubcompactionRunner> runner_;
+  const int job_id_;
+  const size_t idx_;
+};
+
+void CompactionJob::RunSubcompactionsInThreadPool(
+    yb::PriorityThreadPool* thread_pool, FileNumbersHolder* holder) {
+  auto runner = std::make_shared<SubcompactionRunner>(this, holder);
+  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+    auto task = std::make_unique<SubcompactionTask>(runner, job_id_, i);
+    auto status = thread_pool->Submit(kSubcompactionPriority, &task);
+    if (!status.ok()) {
+      // Subcompaction will be processed by the current thread.
+      RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+           "[JOB %d] Failed to submit subcompaction %" ROCKSDB_PRIszt ": %s",
+           job_id_, i, status.ToString().c_str());
+    }
+  }
+
+  runner->RunRemainingAndWait(compact_->compaction->suspender());
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
@@ -493,23 +740,39 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(num_threads - 1);
+  BuildCompressionDict();
+
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
-  }
+  auto* priority_thread_pool = db_options_.priority_thread_pool_for_compactions_and_flushes;
+  // Compaction is running in the priority thread pool when it has suspender.
+  if (num_threads > 1 && priority_thread_pool && compact_->compaction->suspender()) {
+    RunSubcompactionsInThreadPool(priority_thread_pool, &file_numbers_holder);
+  } else {
+    // Launch a thread for each of subcompactions 1...num_threads-1
+    std::vector<std::thread> thread_pool;
+    thread_pool.reserve(num_threads - 1);
+    for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+      thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
+                               &file_numbers_holder, &compact_->sub_compact_states[i]);
+    }
+
+    // Always schedule the first subcompaction (whether or not there are also
+    // others) in the current thread to be efficient with resources
+    compact_->sub_compact_states[0].suspender = compact_->compaction->suspender();
+    ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
 
-  // Always schedule the first subcompaction (whether or not there are also
-  // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
+    // Wait for all other threads (if there are any) to finish execution
+    for (auto& thread : thread_pool) {
+      thread.join();
+    }
+  }
 
-  // Wait for all other threads (if there are any) to finish execution
-  for (auto& thread : thread_pool) {
-    thread.join();
+  for (const auto& state : compact_->sub_compact_states) {
+    if (state.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier_, state.largest_user_frontier, UpdateUserValueType::kLargest);
+    }
   }
 
   if (output_directory_ && !db_options_.disableDataSync) {
@@ -660,7 +923,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = compaction_filter->GetLargestUserFrontier();
   }
 
   MergeHelper merge(
@@ -1049,7 +1312,7 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), env_options_, sub_compact->suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -1074,7 +1337,7 @@ Status CompactionJob::OpenCompactionOutputFile(
       cfd->int_tbl_prop_collector_factories(), cfd->GetID(),
       sub_compact->base_outfile.get(), sub_compact->data_outfile.get(),
       sub_compact->compaction->output_compression(), cfd->ioptions()->compression_opts,
-      skip_filters));
+      skip_filters, &compression_dict_));
   LogFlush(db_options_.info_log);
   return Status::OK();
 }
@@ -1102,7 +1365,8 @@ void CompactionJob::CleanupCompaction() {
       // If this file was inserted into the table cache then remove
       // them here because this compaction was not committed.
       if (!sub_status.ok()) {
-        TableCache::Evict(table_cache_.get(), out.meta.fd.GetNumber());
+        compact_->compaction->column_family_data()->table_cache()->Evict(
+            out.meta.fd.GetNumber());
       }
     }
   }
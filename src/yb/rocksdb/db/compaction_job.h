@@ -73,6 +73,7 @@ class VersionSet;
 class Arena;
 class FileNumbersProvider;
 class FileNumbersHolder;
+struct LevelFilesBrief;
 
 class CompactionJob {
  public:
@@ -107,9 +108,22 @@ class CompactionJob {
 
  private:
   struct SubcompactionState;
+  class SubcompactionRunner;
+  class SubcompactionTask;
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Adds keys sampled from the level 0 input files to bounds.
+  void AddSampledBounds(const LevelFilesBrief& flevel, int level, std::vector<Slice>* bounds);
+
+  // Builds dictionary from data sampled from the input files, when output is compressed with
+  // dictionary.
+  void BuildCompressionDict();
+
+  // Runs subcompactions 1...N-1 in the priority thread pool, while the first one is processed in
+  // the current thread.
+  void RunSubcompactionsInThreadPool(
+      yb::PriorityThreadPool* thread_pool, FileNumbersHolder* holder);
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -185,6 +199,10 @@ class CompactionJob {
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
+  // Keys sampled from input files, that boundaries_ could refer to.
+  std::vector<std::string> sampled_keys_;
+  // Dictionary used to compress data blocks of output files, empty if it is not used.
+  std::string compression_dict_;
 
   UserFrontierPtr largest_user_frontier_;
 };
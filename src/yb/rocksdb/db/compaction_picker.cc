@@ -28,6 +28,7 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
 #include <limits>
 #include <queue>
 #include <string>
@@ -35,6 +36,7 @@
 
 #include <gflags/gflags.h>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/column_family.h"
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/util/log_buffer.h"
@@ -155,6 +157,22 @@ CompressionType GetCompressionType(const ImmutableCFOptions& ioptions,
   }
 }
 
+CompressionType GetUniversalCompressionType(const ImmutableCFOptions& ioptions,
+                                            int level,
+                                            const std::vector<CompactionInputFiles>& inputs,
+                                            const bool enable_compression) {
+  if (enable_compression && ioptions.large_compaction_compression_threshold != 0) {
+    uint64_t input_size = 0;
+    for (const auto& input : inputs) {
+      input_size += TotalFileSize(input.files);
+    }
+    if (input_size >= ioptions.large_compaction_compression_threshold) {
+      return ioptions.large_compaction_compression;
+    }
+  }
+  return GetCompressionType(ioptions, level, 1, enable_compression);
+}
+
 CompactionPicker::CompactionPicker(const ImmutableCFOptions& ioptions,
                                    const InternalKeyComparator* icmp)
     : ioptions_(ioptions), icmp_(icmp) {}
@@ -511,11 +529,11 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         return nullptr;
       }
     }
+    auto compression = GetUniversalCompressionType(ioptions_, output_level, inputs);
     auto c = std::make_unique<Compaction>(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
-        /* max_grandparent_overlap_bytes */ LLONG_MAX, output_path_id,
-        GetCompressionType(ioptions_, output_level, 1),
+        /* max_grandparent_overlap_bytes */ LLONG_MAX, output_path_id, compression,
         /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ true);
     if (start_level == 0) {
       level0_compactions_in_progress_.insert(c.get());
@@ -1148,7 +1166,72 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  return vstorage->CompactionScore(kLevel0) >= 1 || !GetExpiredFiles(*vstorage).empty();
+}
+
+std::vector<FileMetaData*> UniversalCompactionPicker::GetExpiredFiles(
+    const VersionStorageInfo& vstorage) const {
+  std::vector<FileMetaData*> result;
+  auto* filter_factory = ioptions_.compaction_filter_factory;
+  if (!filter_factory || vstorage.num_levels() != 1) {
+    return result;
+  }
+  for (FileMetaData* f : vstorage.LevelFiles(0)) {
+    if (!f->being_compacted && f->largest.user_frontier &&
+        filter_factory->Expired(*f->largest.user_frontier)) {
+      result.push_back(f);
+    }
+  }
+
+  // Level 0 files are ordered from the newest to the oldest. So newer_frontiers[i] is the merged
+  // largest frontier of files that are newer than files[i].
+  const auto& files = vstorage.LevelFiles(0);
+  std::vector<UserFrontierPtr> newer_frontiers(files.size());
+  for (size_t i = 1; i < files.size(); ++i) {
+    newer_frontiers[i] = newer_frontiers[i - 1];
+    if (files[i - 1]->largest.user_frontier) {
+      UpdateUserFrontier(
+          &newer_frontiers[i], files[i - 1]->largest.user_frontier, UpdateUserValueType::kLargest);
+    }
+  }
+  for (size_t i = files.size(); i-- > 0;) {
+    FileMetaData* f = files[i];
+    if (std::find(result.begin(), result.end(), f) != result.end()) {
+      continue;
+    }
+    if (f->being_compacted || !f->largest.user_frontier ||
+        !filter_factory->ExpiredOldest(*f->largest.user_frontier, newer_frontiers[i].get())) {
+      break;
+    }
+    result.push_back(f);
+  }
+  return result;
+}
+
+std::unique_ptr<Compaction> UniversalCompactionPicker::PickExpiredFilesCompaction(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, LogBuffer* log_buffer) {
+  std::vector<CompactionInputFiles> inputs(1);
+  inputs[0].level = 0;
+  inputs[0].files = GetExpiredFiles(*vstorage);
+  if (inputs[0].files.empty()) {
+    return nullptr;
+  }
+  for (auto* f : inputs[0].files) {
+    char tmp_fsize[16];
+    AppendHumanBytes(f->fd.GetTotalFileSize(), tmp_fsize, sizeof(tmp_fsize));
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: picking expired file %" PRIu64
+                              " with size %s for deletion",
+                  cf_name.c_str(), f->fd.GetNumber(), tmp_fsize);
+  }
+  auto c = std::make_unique<Compaction>(
+      vstorage, mutable_cf_options, std::move(inputs), 0 /* output_level */,
+      0 /* target_file_size */, 0 /* max_grandparent_overlap_bytes */, 0 /* output_path_id */,
+      kNoCompression, std::vector<FileMetaData*>(), /* is manual */ false,
+      vstorage->CompactionScore(0),
+      /* is deletion compaction */ true, CompactionReason::kUniversalFilesExpired);
+  level0_compactions_in_progress_.insert(c.get());
+  return c;
 }
 
 struct UniversalCompactionPicker::SortedRun {
@@ -1225,8 +1308,18 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
                                                    const ImmutableCFOptions& ioptions,
                                                    uint64_t max_file_size) {
   std::vector<std::vector<SortedRun>> ret(1);
+  auto* filter_factory = ioptions.compaction_filter_factory;
+  uint64_t prev_time_window = 0;
   for (FileMetaData* f : vstorage.LevelFiles(0)) {
     if (f->fd.GetTotalFileSize() <= max_file_size) {
+      // Files from different time windows are not compacted together, so start a new sequence.
+      if (filter_factory && f->largest.user_frontier) {
+        const auto time_window = filter_factory->TimeWindow(*f->largest.user_frontier);
+        if (!ret.back().empty() && time_window != prev_time_window) {
+          ret.emplace_back();
+        }
+        prev_time_window = time_window;
+      }
       ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
           f->being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
@@ -1353,6 +1446,12 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompaction(
     const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage,
     LogBuffer* log_buffer) {
+  // Deleting expired files is cheap and reduces amount of data to compact, so do it first.
+  auto c = PickExpiredFilesCompaction(cf_name, mutable_cf_options, vstorage, log_buffer);
+  if (c) {
+    return c;
+  }
+
   std::vector<std::vector<SortedRun>> sorted_runs = CalculateSortedRuns(
       *vstorage,
       ioptions_,
@@ -1712,10 +1811,11 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   } else {
     compaction_reason = CompactionReason::kUniversalSizeRatio;
   }
+  auto compression = GetUniversalCompressionType(
+      ioptions_, start_level, inputs, enable_compression);
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
-      mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, start_level, 1, enable_compression),
+      mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id, compression,
       /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false, score,
       false /* deletion_compaction */, compaction_reason);
 }
@@ -1832,12 +1932,12 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
                 cf_name.c_str(), file_num_buf);
   }
 
+  auto compression = GetUniversalCompressionType(ioptions_, vstorage->num_levels() - 1, inputs);
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs),
       vstorage->num_levels() - 1,
       mutable_cf_options.MaxFileSizeForLevel(vstorage->num_levels() - 1),
-      /* max_grandparent_overlap_bytes */ LLONG_MAX, path_id,
-      GetCompressionType(ioptions_, vstorage->num_levels() - 1, 1),
+      /* max_grandparent_overlap_bytes */ LLONG_MAX, path_id, compression,
       /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false, score,
       false /* deletion_compaction */,
       CompactionReason::kUniversalSizeAmplification);
@@ -271,6 +271,15 @@ class UniversalCompactionPicker : public CompactionPicker {
       LogBuffer* log_buffer,
       const std::vector<SortedRun>& sorted_runs);
 
+  // Returns files, that have all entries expired according to compaction filter factory and are
+  // not being compacted. Only single level universal compaction is supported.
+  std::vector<FileMetaData*> GetExpiredFiles(const VersionStorageInfo& vstorage) const;
+
+  // Pick deletion compaction, that removes expired files.
+  std::unique_ptr<Compaction> PickExpiredFilesCompaction(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, LogBuffer* log_buffer);
+
   // Pick Universal compaction to limit read amplification
   std::unique_ptr<Compaction> PickCompactionUniversalReadAmp(
       const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
@@ -285,7 +294,8 @@ class UniversalCompactionPicker : public CompactionPicker {
       const std::vector<SortedRun>& sorted_runs, LogBuffer* log_buffer);
 
   // At level 0 we could compact only continuous sequence of files.
-  // Since there could be too-large-to-compact files, we could get several such sequences.
+  // Since there could be too-large-to-compact files, or files from different time windows (see
+  // CompactionFilterFactory::TimeWindow), we could get several such sequences.
   // Files from one sequence are compacted together, and files from different sequences are not
   // compacted.
   // One sequence is std::vector<SortedRun>.
@@ -373,6 +383,13 @@ CompressionType GetCompressionType(const ImmutableCFOptions& ioptions,
                                    int level, int base_level,
                                    const bool enable_compression = true);
 
+// Determines compression type of universal compaction output. Compactions with total input size
+// above large_compaction_compression_threshold use large_compaction_compression.
+CompressionType GetUniversalCompressionType(const ImmutableCFOptions& ioptions,
+                                            int level,
+                                            const std::vector<CompactionInputFiles>& inputs,
+                                            const bool enable_compression = true);
+
 }  // namespace rocksdb
 
 #endif // YB_ROCKSDB_DB_COMPACTION_PICKER_H
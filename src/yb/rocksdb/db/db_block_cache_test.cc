@@ -179,6 +179,51 @@ TEST_F(DBBlockCacheTest, TestWithoutCompressedBlockCache) {
   FLAGS_cache_overflow_single_touch = true;
 }
 
+TEST_F(DBBlockCacheTest, TestWithIndexAndFilterBlockCache) {
+  ReadOptions read_options;
+  auto table_options = GetTableOptions();
+  auto options = GetOptions(table_options);
+  InitTable(options);
+
+  // Make multi-level index with several levels.
+  table_options.index_type = IndexType::kMultiLevelBinarySearch;
+  table_options.index_block_size = 1;
+  table_options.min_keys_per_index_block = 2;
+  table_options.cache_index_and_filter_blocks = true;
+  std::shared_ptr<Cache> cache = NewLRUCache(1024 * 1024, 0, false);
+  std::shared_ptr<Cache> index_cache = NewLRUCache(1024 * 1024, 0, false);
+  table_options.block_cache = cache;
+  table_options.index_and_filter_block_cache = index_cache;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek(ToString(i));
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(iter->Valid());
+  }
+  const size_t index_usage = index_cache->GetUsage();
+  ASSERT_LT(0, index_usage);
+  ASSERT_LT(0, cache->GetUsage());
+
+  // Evicting data blocks does not affect index blocks.
+  cache->SetCapacity(0);
+  ASSERT_EQ(0, cache->GetUsage());
+  ASSERT_EQ(index_usage, index_cache->GetUsage());
+
+  // All index blocks are found in the cache, and top level of the index is pinned by the reader.
+  const auto index_misses = TestGetTickerCount(options, BLOCK_CACHE_INDEX_MISS);
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek(ToString(i));
+    ASSERT_OK(iter->status());
+    ASSERT_TRUE(iter->Valid());
+  }
+  ASSERT_EQ(index_misses, TestGetTickerCount(options, BLOCK_CACHE_INDEX_MISS));
+  ASSERT_EQ(index_usage, index_cache->GetUsage());
+}
+
 #ifdef SNAPPY
 TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
   ReadOptions read_options;
@@ -35,8 +35,11 @@
 
 #include <algorithm>
 #include <climits>
+#include <condition_variable>
 #include <cstdio>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -125,6 +128,7 @@
 #include "yb/rocksdb/db/db_iterator_wrapper.h"
 
 #include "yb/util/stats/iostats_context_imp.h"
+#include "yb/util/threadpool.h"
 
 using namespace std::literals;
 
@@ -156,6 +160,20 @@ DEFINE_int32(compaction_priority_step_size, 5,
 DEFINE_int32(small_compaction_extra_priority, 1,
              "Small compaction will get small_compaction_extra_priority extra priority.");
 
+DEFINE_int32(compaction_read_rate_priority_step, 0,
+             "Compaction task of DB will get 1 extra priority per every specified number of reads "
+             "per second served by this DB, up to compaction_read_rate_max_extra_priority. So DBs "
+             "where compactions save the most read I/O are compacted first. 0 means that read rate "
+             "does not affect compaction priority.");
+TAG_FLAG(compaction_read_rate_priority_step, advanced);
+TAG_FLAG(compaction_read_rate_priority_step, runtime);
+
+DEFINE_int32(compaction_read_rate_max_extra_priority, 3,
+             "Maximum extra priority that compaction task could get because of read rate, see "
+             "compaction_read_rate_priority_step.");
+TAG_FLAG(compaction_read_rate_max_extra_priority, advanced);
+TAG_FLAG(compaction_read_rate_max_extra_priority, runtime);
+
 DEFINE_bool(rocksdb_use_logging_iterator, false,
             "Wrap newly created RocksDB iterators in a logging wrapper");
 
@@ -334,6 +352,12 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       result += FLAGS_small_compaction_extra_priority;
     }
 
+    result += db_impl_->ReadRateCompactionPriority();
+
+    if (manual_compaction_) {
+      result += manual_compaction_->extra_priority;
+    }
+
     return result;
   }
 
@@ -598,16 +622,22 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname)
       opened_successfully_(false) {
   CHECK_OK(env_->GetAbsolutePath(dbname, &db_absolute_path_));
 
-  // Reserve ten files or so for other uses and give the rest to TableCache.
-  // Give a large number for setting of "infinite" open files.
-  const int table_cache_size = (db_options_.max_open_files == -1) ?
-        4194304 : db_options_.max_open_files - 10;
-  table_cache_ =
-      NewLRUCache(table_cache_size, db_options_.table_cache_numshardbits);
+  if (db_options_.table_cache) {
+    // The number of open files is limited by the capacity of the shared cache.
+    table_cache_ = db_options_.table_cache;
+    table_cache_id_ = table_cache_->NewId();
+  } else {
+    // Reserve ten files or so for other uses and give the rest to TableCache.
+    // Give a large number for setting of "infinite" open files.
+    const int table_cache_size = (db_options_.max_open_files == -1) ?
+          4194304 : db_options_.max_open_files - 10;
+    table_cache_ =
+        NewLRUCache(table_cache_size, db_options_.table_cache_numshardbits);
+  }
 
   versions_.reset(new VersionSet(dbname_, &db_options_, env_options_,
                                  table_cache_.get(), &write_buffer_,
-                                 &write_controller_));
+                                 &write_controller_, table_cache_id_));
   pending_outputs_ = std::make_unique<FileNumbersProvider>(versions_.get());
   column_family_memtables_.reset(
       new ColumnFamilyMemTablesImpl(versions_->GetColumnFamilySet()));
@@ -746,6 +776,11 @@ DBImpl::~DBImpl() {
   }
   logs_.clear();
 
+  if (table_cache_id_) {
+    // Shared table cache outlives this DB, so readers of its files should not stay there.
+    EraseTableReadersUnlocked();
+  }
+
   // versions need to be destroyed before table_cache since it can hold
   // references to table_cache.
   versions_.reset();
@@ -1124,7 +1159,7 @@ void DBImpl::PurgeObsoleteFiles(const JobContext& state) {
     std::string fname;
     if (type == kTableFile) {
       // evict from cache
-      TableCache::Evict(table_cache_.get(), number);
+      TableCache::Evict(table_cache_.get(), table_cache_id_, number);
       fname = TableFileName(db_options_.db_paths, number, path_id);
     } else {
       fname = ((type == kLogFile) ?
@@ -1942,6 +1977,26 @@ uint64_t DBImpl::GetCurrentVersionNumSSTFiles() {
   return default_cf_handle_->cfd()->current()->storage_info()->NumFiles();
 }
 
+size_t DBImpl::ReleaseTableReaders() {
+  if (!table_cache_id_) {
+    // Each table reader is charged as 1, and readers pinned by iterators or by version
+    // (max_open_files == -1) are not evicted.
+    return table_cache_->Evict(std::numeric_limits<size_t>::max());
+  }
+  InstrumentedMutexLock lock(&mutex_);
+  return EraseTableReadersUnlocked();
+}
+
+size_t DBImpl::EraseTableReadersUnlocked() {
+  mutex_.AssertHeld();
+  std::vector<FileDescriptor> live_files;
+  versions_->AddLiveFiles(&live_files);
+  for (const auto& fd : live_files) {
+    TableCache::Evict(table_cache_.get(), table_cache_id_, fd.GetNumber());
+  }
+  return live_files.size();
+}
+
 void DBImpl::SetSSTFileTickers() {
   if (stats_) {
     auto sst_files_size = GetCurrentVersionSstFilesSize();
@@ -2054,7 +2109,8 @@ Status DBImpl::CompactRange(const CompactRangeOptions& options,
     // Always compact all files together.
     s = RunManualCompaction(cfd, ColumnFamilyData::kCompactAllLevels,
                             cfd->NumberLevels() - 1, options.target_path_id,
-                            begin, end, exclusive);
+                            begin, end, exclusive, false /* disallow_trivial_move */,
+                            options.extra_priority);
     final_output_level = cfd->NumberLevels() - 1;
   } else {
     for (int level = 0; level <= max_level_with_files; level++) {
@@ -2089,7 +2145,8 @@ Status DBImpl::CompactRange(const CompactRangeOptions& options,
         }
       }
       s = RunManualCompaction(cfd, level, output_level, options.target_path_id,
-                              begin, end, exclusive);
+                              begin, end, exclusive, false /* disallow_trivial_move */,
+                              options.extra_priority);
       if (!s.ok()) {
         break;
       }
@@ -2733,7 +2790,8 @@ void DBImpl::SubmitCompactionOrFlushTask(std::unique_ptr<ThreadPoolTask> task) {
 Status DBImpl::RunManualCompaction(ColumnFamilyData* cfd, int input_level,
                                    int output_level, uint32_t output_path_id,
                                    const Slice* begin, const Slice* end,
-                                   bool exclusive, bool disallow_trivial_move) {
+                                   bool exclusive, bool disallow_trivial_move,
+                                   int extra_priority) {
   assert(input_level == ColumnFamilyData::kCompactAllLevels ||
          input_level >= 0);
 
@@ -2752,6 +2810,7 @@ Status DBImpl::RunManualCompaction(ColumnFamilyData* cfd, int input_level,
   manual_compaction.incomplete = false;
   manual_compaction.exclusive = exclusive;
   manual_compaction.disallow_trivial_move = disallow_trivial_move;
+  manual_compaction.extra_priority = extra_priority;
   // For universal compaction, we enforce every manual compaction to compact
   // all files.
   if (begin == nullptr ||
@@ -3083,6 +3142,27 @@ bool DBImpl::IsLargeCompaction(const Compaction& compaction) {
   return compaction.CalculateTotalInputSize() >= db_options_.compaction_size_threshold_bytes;
 }
 
+int DBImpl::ReadRateCompactionPriority() {
+  mutex_.AssertHeld();
+
+  const auto step = FLAGS_compaction_read_rate_priority_step;
+  if (step <= 0) {
+    return 0;
+  }
+
+  // Read rate is recalculated at most once per second, over the interval since previous sample.
+  constexpr uint64_t kReadRateSampleIntervalUs = 1000000;
+  const auto now = env_->NowMicros();
+  const auto passed = now - read_rate_sample_time_;
+  if (passed >= kReadRateSampleIntervalUs) {
+    const auto reads = num_reads_.load(std::memory_order_relaxed);
+    read_rate_ = (reads - read_rate_sample_reads_) * 1e6 / passed;
+    read_rate_sample_reads_ = reads;
+    read_rate_sample_time_ = now;
+  }
+  return std::min<int>(read_rate_ / step, FLAGS_compaction_read_rate_max_extra_priority);
+}
+
 void DBImpl::AddToFlushQueue(ColumnFamilyData* cfd) {
   assert(!cfd->pending_flush());
   cfd->Ref();
@@ -3504,8 +3584,8 @@ Result<FileNumbersHolder> DBImpl::BackgroundCompaction(
     // file if there is alive snapshot pointing to it
     assert(c->num_input_files(1) == 0);
     assert(c->level() == 0);
-    assert(c->column_family_data()->ioptions()->compaction_style ==
-           kCompactionStyleFIFO);
+    assert(c->column_family_data()->ioptions()->compaction_style == kCompactionStyleFIFO ||
+           c->column_family_data()->ioptions()->compaction_style == kCompactionStyleUniversal);
 
     compaction_job_stats.num_input_files = c->num_input_files(0);
 
@@ -3898,6 +3978,7 @@ Status DBImpl::GetImpl(const ReadOptions& read_options,
                        std::string* value, bool* value_found) {
   StopWatch sw(env_, stats_, DB_GET);
   PERF_TIMER_GUARD(get_snapshot_time);
+  num_reads_.fetch_add(1, std::memory_order_relaxed);
 
   auto cfh = down_cast<ColumnFamilyHandleImpl*>(column_family);
   auto cfd = cfh->cfd();
@@ -3959,6 +4040,7 @@ std::vector<Status> DBImpl::MultiGet(
 
   StopWatch sw(env_, stats_, DB_MULTIGET);
   PERF_TIMER_GUARD(get_snapshot_time);
+  num_reads_.fetch_add(keys.size(), std::memory_order_relaxed);
 
   struct MultiGetColumnFamilyData {
     ColumnFamilyData* cfd;
@@ -4553,6 +4635,7 @@ Iterator* DBImpl::NewIterator(const ReadOptions& read_options,
     return NewErrorIterator(STATUS(NotSupported,
         "ReadTier::kPersistedData is not yet supported in iterators."));
   }
+  num_reads_.fetch_add(1, std::memory_order_relaxed);
   auto cfh = down_cast<ColumnFamilyHandleImpl*>(column_family);
   auto cfd = cfh->cfd();
 
@@ -4666,6 +4749,7 @@ Status DBImpl::NewIterators(
     return STATUS(NotSupported,
         "ReadTier::kPersistedData is not yet supported in iterators.");
   }
+  num_reads_.fetch_add(column_families.size(), std::memory_order_relaxed);
   iterators->clear();
   iterators->reserve(column_families.size());
   XFUNC_TEST("", "managed_new", managed_new1, xf_manage_new,
@@ -4801,6 +4885,99 @@ Status DBImpl::WriteWithCallback(const WriteOptions& write_options,
 }
 #endif  // ROCKSDB_LITE
 
+namespace {
+
+// Upper bound for the number of parts, that a single write batch is split into.
+constexpr size_t kMaxParallelMemTableInsertParts = 16;
+
+// Parts of a write batch are submitted to the memtable insert thread pool, but a part that was not
+// picked up by the pool yet is inserted by the writing thread itself. So the write never waits for
+// busy pool workers.
+class ParallelMemTableInsertRunner {
+ public:
+  typedef std::function<Status(const WriteBatchInternal::Part&)> InsertFunc;
+
+  ParallelMemTableInsertRunner(std::vector<WriteBatchInternal::Part> parts, InsertFunc insert)
+      : parts_(std::move(parts)), insert_(std::move(insert)), started_(parts_.size()),
+        statuses_(parts_.size()) {}
+
+  size_t num_parts() const {
+    return parts_.size();
+  }
+
+  // Inserts part with specified index, unless it was already started.
+  void TryRun(size_t idx) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (started_[idx]) {
+        return;
+      }
+      started_[idx] = true;
+      ++running_;
+    }
+    statuses_[idx] = insert_(parts_[idx]);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--running_ == 0) {
+      cond_.notify_all();
+    }
+  }
+
+  // Inserts all parts that were not started yet and waits for the rest to complete.
+  Status RunRemainingAndWait() {
+    for (size_t i = 0; i != parts_.size(); ++i) {
+      TryRun(i);
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this] { return running_ == 0; });
+    }
+    for (const auto& status : statuses_) {
+      RETURN_NOT_OK(status);
+    }
+    return Status::OK();
+  }
+
+ private:
+  const std::vector<WriteBatchInternal::Part> parts_;
+  const InsertFunc insert_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<bool> started_;
+  std::vector<Status> statuses_;
+  size_t running_ = 0;
+};
+
+} // namespace
+
+Status DBImpl::InsertIntoMemTablesInParallel(
+    WriteBatch* batch, SequenceNumber sequence, size_t max_parts,
+    bool ignore_missing_column_families) {
+  WriteBatchInternal::SetSequence(batch, sequence);
+  std::vector<WriteBatchInternal::Part> parts;
+  RETURN_NOT_OK(WriteBatchInternal::Split(batch, max_parts, &parts));
+
+  auto runner = std::make_shared<ParallelMemTableInsertRunner>(
+      std::move(parts),
+      [this, batch, ignore_missing_column_families](const WriteBatchInternal::Part& part) {
+        // Each thread should use its own instance.
+        ColumnFamilyMemTablesImpl column_family_memtables(versions_->GetColumnFamilySet());
+        InsertFlags insert_flags{InsertFlag::kConcurrentMemtableWrites};
+        return WriteBatchInternal::InsertInto(
+            batch, part, &column_family_memtables, &flush_scheduler_,
+            ignore_missing_column_families, this, insert_flags);
+      });
+  for (size_t i = 1; i < runner->num_parts(); ++i) {
+    auto status = db_options_.memtable_insert_thread_pool->SubmitFunc(
+        [runner, i] { runner->TryRun(i); });
+    if (!status.ok()) {
+      // Remaining parts will be inserted by the current thread.
+      break;
+    }
+  }
+  return runner->RunRemainingAndWait();
+}
+
 Status DBImpl::WriteImpl(const WriteOptions& write_options,
                          WriteBatch* my_batch, WriteCallback* callback) {
 
@@ -5019,17 +5196,26 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     // 3. Deletes or SingleDeletes are not okay if filtering deletes
     //    (controlled by both batch and memtable setting)
     // 4. Merges are not okay
-    // 5. YugaByte-specific user-specified sequence numbers are currently not compatible with
-    //    parallel memtable writes.
+    // 5. SingleDeletes are not okay, since they could erase entries from the memtable
+    //    (MemTable::Erase), and such entries could be added by a concurrent writer.
     //
     // Rules 1..3 are enforced by checking the options
     // during startup (CheckConcurrentWritesSupported), so if
     // options.allow_concurrent_memtable_write is true then they can be
-    // assumed to be true.  Rule 4 is checked for each batch.  We could
+    // assumed to be true.  Rules 4 and 5 are checked for each batch.  We could
     // relax rules 2 and 3 if we could prevent write batches from referring
     // more than once to a particular key.
+    //
+    // The same rules allow to split a single large batch into parts, that are inserted in
+    // parallel. Each update still gets its own sequence number, so parts never overlap in the
+    // memtable, and frontiers are merged into the memtable under its own lock.
     bool parallel =
         db_options_.allow_concurrent_memtable_write && write_group.size() > 1;
+    const size_t part_size = db_options_.parallel_memtable_insert_part_size;
+    bool split_batch =
+        db_options_.allow_concurrent_memtable_write && write_group.size() == 1 &&
+        part_size != 0 && db_options_.memtable_insert_thread_pool != nullptr &&
+        WriteBatchInternal::Count(w.batch) >= 2 * part_size && !w.CallbackFailed();
     size_t total_count = 0;
     uint64_t total_byte_size = 0;
     for (auto writer : write_group) {
@@ -5037,7 +5223,10 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         total_count += WriteBatchInternal::Count(writer->batch);
         total_byte_size = WriteBatchInternal::AppendedByteSize(
             total_byte_size, WriteBatchInternal::ByteSize(writer->batch));
-        parallel = parallel && !writer->batch->HasMerge();
+        const bool concurrent_insert_allowed =
+            !writer->batch->HasMerge() && !writer->batch->HasSingleDelete();
+        parallel = parallel && concurrent_insert_allowed;
+        split_batch = split_batch && concurrent_insert_allowed;
       }
     }
 
@@ -5155,7 +5344,13 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         }
       }
 
-      if (!parallel) {
+      if (split_batch) {
+        w.status = InsertIntoMemTablesInParallel(
+            w.batch, current_sequence,
+            std::min(total_count / part_size, kMaxParallelMemTableInsertParts),
+            write_options.ignore_missing_column_families);
+        status = w.status;
+      } else if (!parallel) {
         InsertFlags insert_flags{InsertFlag::kFilterDeletes};
         status = WriteBatchInternal::InsertInto(
             write_group, current_sequence, column_family_memtables_.get(),
@@ -312,7 +312,8 @@ class DBImpl : public DB {
                              int output_level, uint32_t output_path_id,
                              const Slice* begin, const Slice* end,
                              bool exclusive,
-                             bool disallow_trivial_move = false);
+                             bool disallow_trivial_move = false,
+                             int extra_priority = 0);
 
   // Return an internal iterator over the current state of the database.
   // The keys of this iterator are internal keys (see format.h).
@@ -521,6 +522,12 @@ class DBImpl : public DB {
   Status WriteImpl(const WriteOptions& options, WriteBatch* updates,
                    WriteCallback* callback);
 
+  // Splits batch into at most max_parts parts and inserts them into memtables in parallel using
+  // memtable_insert_thread_pool.
+  Status InsertIntoMemTablesInParallel(
+      WriteBatch* batch, SequenceNumber sequence, size_t max_parts,
+      bool ignore_missing_column_families);
+
  private:
   friend class DB;
   friend class InternalStats;
@@ -636,11 +643,17 @@ class DBImpl : public DB {
 
   uint64_t GetCurrentVersionNumSSTFiles() override;
 
+  size_t ReleaseTableReaders() override;
+
   int GetCfdImmNumNotFlushed() override;
 
   // Updates stats_ object with SST files size metrics.
   void SetSSTFileTickers();
 
+  // Removes readers of live table files of this DB from the table cache.
+  // REQUIRES: mutex locked
+  size_t EraseTableReadersUnlocked();
+
   void PrintStatistics();
 
   // dump rocksdb.stats to LOG
@@ -667,6 +680,10 @@ class DBImpl : public DB {
   // Compaction is marked as large based on options, so cannot be static or free function.
   bool IsLargeCompaction(const Compaction& compaction);
 
+  // Extra priority of compactions of this DB because of its read rate, see
+  // compaction_read_rate_priority_step.
+  int ReadRateCompactionPriority();
+
   // helper function to call after some of the logs_ were synced
   void MarkLogsSynced(uint64_t up_to, bool synced_dir, const Status& status);
 
@@ -698,6 +715,8 @@ class DBImpl : public DB {
 
   // table_cache_ provides its own synchronization
   std::shared_ptr<Cache> table_cache_;
+  // Partitions table_cache_ when it is shared with other DBs, 0 when it is owned by this DB.
+  uint64_t table_cache_id_ = 0;
 
   // Lock over the persistent DB state.  Non-nullptr iff successfully acquired.
   FileLock* db_lock_;
@@ -891,6 +910,14 @@ class DBImpl : public DB {
   // And we remove them from this set, when they are processed/aborted by thread pool.
   std::unordered_set<CompactionTask*> compaction_tasks_;
 
+  // Number of point reads and created iterators, used to estimate read rate of this DB.
+  std::atomic<uint64_t> num_reads_{0};
+
+  // Last sample of read rate estimation, see ReadRateCompactionPriority.
+  uint64_t read_rate_sample_reads_ = 0;
+  uint64_t read_rate_sample_time_ = 0;
+  double read_rate_ = 0;
+
   // stores the total number of compactions that are currently running
   int num_total_running_compactions_;
 
@@ -915,6 +942,7 @@ class DBImpl : public DB {
     bool incomplete;              // only part of requested range compacted
     bool exclusive;               // current behavior of only one manual
     bool disallow_trivial_move;   // Force actual compaction to run
+    int extra_priority;           // Added to priority of the compaction task
     const InternalKey* begin;     // nullptr means beginning of key range
     const InternalKey* end;       // nullptr means end of key range
     InternalKey* manual_end;      // how far we are compacting
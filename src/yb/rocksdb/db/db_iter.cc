@@ -40,6 +40,7 @@
 #include "yb/rocksdb/util/mutexlock.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/util/string_util.h"
+#include "yb/util/thread.h"
 
 namespace rocksdb {
 
@@ -254,6 +255,8 @@ inline bool DBIter::ParseKey(ParsedInternalKey* ikey) {
 
 void DBIter::Next() {
   assert(valid_);
+  yb::ScopedWaitState wait_state(yb::WaitState::kRocksDBNext);
+  PERF_COUNTER_ADD(iter_next_count, 1);
 
   if (direction_ == kReverse) {
     FindNextUserKey();
@@ -452,6 +455,7 @@ void DBIter::MergeValuesNewToOld() {
 
 void DBIter::Prev() {
   assert(valid_);
+  PERF_COUNTER_ADD(iter_next_count, 1);
   if (direction_ == kForward) {
     ReverseToBackward();
   }
@@ -747,6 +751,8 @@ void DBIter::FindParseableKey(ParsedInternalKey* ikey, Direction direction) {
 }
 
 void DBIter::Seek(const Slice& target) {
+  yb::ScopedWaitState wait_state(yb::WaitState::kRocksDBSeek);
+  PERF_COUNTER_ADD(iter_seek_count, 1);
   saved_key_.Clear();
   // now savved_key is used to store internal key.
   saved_key_.SetInternalKey(target, sequence_);
@@ -776,6 +782,7 @@ void DBIter::Seek(const Slice& target) {
 }
 
 void DBIter::SeekToFirst() {
+  PERF_COUNTER_ADD(iter_seek_count, 1);
   // Don't use iter_::Seek() if we set a prefix extractor
   // because prefix seek will be used.
   if (prefix_extractor_ != nullptr) {
@@ -807,6 +814,7 @@ void DBIter::SeekToFirst() {
 }
 
 void DBIter::SeekToLast() {
+  PERF_COUNTER_ADD(iter_seek_count, 1);
   // Don't use iter_::Seek() if we set a prefix extractor
   // because prefix seek will be used.
   if (prefix_extractor_ != nullptr) {
@@ -24,6 +24,8 @@
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
 
+#include "yb/util/threadpool.h"
+
 namespace rocksdb {
 
 class DBTest2 : public DBTestBase {
@@ -72,6 +74,136 @@ TEST_F(DBTest2, IteratorPropertyVersionNumber) {
   delete iter2;
   delete iter3;
 }
+
+TEST_F(DBTest2, ParallelMemTableInsert) {
+  constexpr int kNumKeys = 1000;
+  constexpr size_t kPartSize = 100;
+
+  std::unique_ptr<yb::ThreadPool> thread_pool;
+  ASSERT_OK(yb::ThreadPoolBuilder("memtable_insert").set_max_threads(4).Build(&thread_pool));
+
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.parallel_memtable_insert_part_size = kPartSize;
+  options.memtable_insert_thread_pool = thread_pool.get();
+  options.boundary_extractor = test::MakeBoundaryValuesExtractor();
+  DestroyAndReopen(options);
+
+  const SequenceNumber initial_sequence = db_->GetLatestSequenceNumber();
+  WriteBatch batch;
+  test::TestUserFrontiers frontiers(1, 5);
+  batch.SetFrontiers(&frontiers);
+  for (int i = 0; i != kNumKeys; ++i) {
+    batch.Put(Key(i), "v" + std::to_string(i));
+  }
+  // Key from the first part is overwritten in the last part, so the last value should win.
+  batch.Put(Key(0), "last");
+  WriteOptions write_options;
+  write_options.disableWAL = true;
+  ASSERT_OK(db_->Write(write_options, &batch));
+
+  ASSERT_EQ(initial_sequence + kNumKeys + 1, db_->GetLatestSequenceNumber());
+  ASSERT_EQ("last", Get(Key(0)));
+  for (int i = 1; i != kNumKeys; ++i) {
+    ASSERT_EQ("v" + std::to_string(i), Get(Key(i)));
+  }
+
+  ASSERT_OK(Flush());
+  ASSERT_EQ(5U, down_cast<test::TestUserFrontier&>(*dbfull()->GetFlushedFrontier()).Value());
+  ASSERT_EQ("last", Get(Key(0)));
+  ASSERT_EQ("v" + std::to_string(kNumKeys - 1), Get(Key(kNumKeys - 1)));
+}
+
+TEST_F(DBTest2, ReadaheadForSequentialScan) {
+  constexpr int kNumKeys = 10000;
+  constexpr int kValueSize = 100;
+  constexpr int kBlockSize = 1_KB;
+
+  Options options = CurrentOptions();
+  env_->count_random_reads_ = true;
+  options.env = env_;
+  BlockBasedTableOptions table_options;
+  table_options.no_block_cache = true;
+  table_options.block_size = kBlockSize;
+  table_options.max_auto_readahead_size = 0;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  const std::string value(kValueSize, 'v');
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), value));
+  }
+  ASSERT_OK(Flush());
+
+  auto scan = [this, &value] {
+    env_->random_read_counter_.Reset();
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      EXPECT_EQ(Key(count), iter->key().ToString());
+      EXPECT_EQ(value, iter->value().ToString());
+      ++count;
+    }
+    EXPECT_OK(iter->status());
+    EXPECT_EQ(kNumKeys, count);
+    return env_->random_read_counter_.Read();
+  };
+
+  // Each data block is read separately without readahead.
+  const int reads_without_readahead = scan();
+  ASSERT_GT(reads_without_readahead, kNumKeys * kValueSize / kBlockSize);
+
+  table_options.max_auto_readahead_size = 256_KB;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  Reopen(options);
+  const int reads_with_readahead = scan();
+  ASSERT_LT(reads_with_readahead * 10, reads_without_readahead);
+}
+
+TEST_F(DBTest2, SharedTableCache) {
+  constexpr int kNumFiles = 5;
+  constexpr size_t kMaxOpenTables = 3;
+
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.table_cache = NewLRUCache(kMaxOpenTables, 0 /* num_shard_bits */);
+  DestroyAndReopen(options);
+
+  const std::string other_dbname = dbname_ + "_other";
+  ASSERT_OK(DestroyDB(other_dbname, options));
+  DB* other_db_ptr = nullptr;
+  ASSERT_OK(DB::Open(options, other_dbname, &other_db_ptr));
+  std::unique_ptr<DB> other_db(other_db_ptr);
+
+  // Both DBs have files with the same numbers, but different contents.
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_OK(Put(Key(i), "main"));
+    ASSERT_OK(Flush());
+    ASSERT_OK(other_db->Put(WriteOptions(), Key(i), "other"));
+    ASSERT_OK(other_db->Flush(FlushOptions()));
+  }
+
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_EQ("main", Get(Key(i)));
+    std::string value;
+    ASSERT_OK(other_db->Get(ReadOptions(), Key(i), &value));
+    ASSERT_EQ("other", value);
+    ASSERT_LE(options.table_cache->GetUsage(), kMaxOpenTables);
+  }
+
+  // Readers of the closed DB are removed from the shared cache, so it is empty after readers of
+  // the main DB are released.
+  other_db.reset();
+  ASSERT_EQ(static_cast<size_t>(kNumFiles), db_->ReleaseTableReaders());
+  ASSERT_EQ(0U, options.table_cache->GetUsage());
+
+  for (int i = 0; i != kNumFiles; ++i) {
+    ASSERT_EQ("main", Get(Key(i)));
+  }
+  ASSERT_LE(options.table_cache->GetUsage(), kMaxOpenTables);
+  ASSERT_OK(DestroyDB(other_dbname, options));
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
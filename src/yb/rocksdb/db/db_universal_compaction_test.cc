@@ -26,6 +26,10 @@
 #if !defined(ROCKSDB_LITE)
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/priority_thread_pool.h"
+
+DECLARE_uint64(rocksdb_min_subcompaction_size_bytes);
+
 namespace rocksdb {
 
 static std::string CompressibleString(Random* rnd, int len) {
@@ -1474,6 +1478,252 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+TEST_F(DBTestUniversalCompaction, Subcompactions) {
+  constexpr int kNumFiles = 4;
+  constexpr int kNumKeys = 4000;
+  constexpr uint32_t kMaxSubcompactions = 4;
+
+  google::FlagSaver flag_saver;
+  FLAGS_rocksdb_min_subcompaction_size_bytes = 1;
+  yb::PriorityThreadPool thread_pool(kMaxSubcompactions);
+
+  // Compaction into level 0 is not split, since its output files would have interleaved sequence
+  // number ranges.
+  for (int num_levels : {1, 3}) {
+    for (bool use_thread_pool : {false, true}) {
+      Options options;
+      options.compaction_style = kCompactionStyleUniversal;
+      options.num_levels = num_levels;
+      options.max_subcompactions = kMaxSubcompactions;
+      options.write_buffer_size = 100 * 1024 * 1024;
+      if (use_thread_pool) {
+        options.priority_thread_pool_for_compactions_and_flushes = &thread_pool;
+      }
+      BlockBasedTableOptions table_options;
+      table_options.block_size = 1024;
+      options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+      options = CurrentOptions(options);
+      DestroyAndReopen(options);
+      ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "true"}}));
+
+      // All files cover the whole key range, so only keys sampled from them could split compaction.
+      for (int file = 0; file != kNumFiles; ++file) {
+        for (int i = file; i < kNumKeys; i += kNumFiles) {
+          ASSERT_OK(Put(Key(i), "value" + std::to_string(i)));
+        }
+        ASSERT_OK(Put(Key(0), "first" + std::to_string(file)));
+        ASSERT_OK(Flush());
+      }
+      ASSERT_EQ(kNumFiles, NumTableFilesAtLevel(0));
+
+      ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+      std::vector<LiveFileMetaData> files;
+      db_->GetLiveFilesMetaData(&files);
+      if (num_levels == 1) {
+        ASSERT_EQ(1U, files.size()) << "Use thread pool: " << use_thread_pool;
+      } else {
+        ASSERT_EQ(files.size(), static_cast<size_t>(NumTableFilesAtLevel(num_levels - 1)));
+        ASSERT_GT(files.size(), 1U) << "Use thread pool: " << use_thread_pool;
+        ASSERT_LE(files.size(), kMaxSubcompactions);
+      }
+      std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.smallest.key < rhs.smallest.key;
+      });
+      for (size_t i = 1; i < files.size(); ++i) {
+        ASSERT_LT(files[i - 1].largest.key, files[i].smallest.key);
+      }
+
+      ASSERT_EQ("first" + std::to_string(kNumFiles - 1), Get(Key(0)));
+      for (int i = 1; i != kNumKeys; ++i) {
+        ASSERT_EQ("value" + std::to_string(i), Get(Key(i)));
+      }
+      Close();
+    }
+  }
+
+  thread_pool.Shutdown();
+}
+
+TEST_F(DBTestUniversalCompaction, LargeCompactionCompressionDict) {
+  if (!ZSTD_Supported()) {
+    return;
+  }
+  constexpr int kNumFiles = 4;
+  constexpr int kNumKeys = 2000;
+  constexpr int kNumFragments = 64;
+
+  // Blocks are small comparing to the set of distinct fragments, so most of content repeated
+  // across blocks could be found only in the dictionary.
+  Random rnd(301);
+  std::vector<std::string> fragments;
+  for (int i = 0; i != kNumFragments; ++i) {
+    fragments.push_back(RandomString(&rnd, 100));
+  }
+  auto value = [&fragments](int i) {
+    return fragments[(i * 7) % kNumFragments] + std::to_string(i);
+  };
+
+  uint64_t size_without_dict = 0;
+  for (uint32_t max_dict_bytes : {0, 16 * 1024}) {
+    Options options;
+    options.compaction_style = kCompactionStyleUniversal;
+    options.num_levels = 1;
+    options.compression = kNoCompression;
+    options.large_compaction_compression = kZSTDNotFinalCompression;
+    options.large_compaction_compression_threshold = 1;
+    options.compression_opts.max_dict_bytes = max_dict_bytes;
+    options.write_buffer_size = 100 * 1024 * 1024;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 1024;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    options = CurrentOptions(options);
+    DestroyAndReopen(options);
+    ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "true"}}));
+
+    for (int file = 0; file != kNumFiles; ++file) {
+      for (int i = file; i < kNumKeys; i += kNumFiles) {
+        ASSERT_OK(Put(Key(i), value(i)));
+      }
+      ASSERT_OK(Flush());
+    }
+    const auto uncompressed_size = TotalSize();
+
+    ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+    ASSERT_EQ(1, NumTableFilesAtLevel(0));
+    const auto compressed_size = TotalSize();
+    ASSERT_LT(compressed_size, uncompressed_size);
+    if (max_dict_bytes == 0) {
+      size_without_dict = compressed_size;
+    } else {
+      ASSERT_LT(compressed_size, size_without_dict);
+    }
+
+    // Reopen, so blocks are read from the file by a new table reader.
+    Reopen(options);
+    for (int i = 0; i != kNumKeys; ++i) {
+      ASSERT_EQ(value(i), Get(Key(i)));
+    }
+    Close();
+  }
+}
+
+namespace {
+
+// Time window of a file is the tens of its test frontier value.
+class TimeWindowFilterFactory : public KeepFilterFactory {
+ public:
+  uint64_t TimeWindow(const UserFrontier& largest_frontier) const override {
+    return down_cast<const test::TestUserFrontier&>(largest_frontier).Value() / 10;
+  }
+
+  bool Expired(const UserFrontier& largest_frontier) const override {
+    return down_cast<const test::TestUserFrontier&>(largest_frontier).Value() < expired_below_;
+  }
+
+  std::atomic<uint64_t> expired_below_{0};
+};
+
+// Oldest files are expired while their test frontier value is below the limit.
+class OldestExpiredFilterFactory : public KeepFilterFactory {
+ public:
+  bool ExpiredOldest(
+      const UserFrontier& largest_frontier,
+      const UserFrontier* newer_files_frontier) const override {
+    auto value = down_cast<const test::TestUserFrontier&>(largest_frontier).Value();
+    // Newer files should be available, and their merged frontier should be the largest one.
+    return newer_files_frontier &&
+           down_cast<const test::TestUserFrontier*>(newer_files_frontier)->Value() ==
+               newest_value_ &&
+           value < expired_below_;
+  }
+
+  std::atomic<uint64_t> expired_below_{0};
+  std::atomic<uint64_t> newest_value_{0};
+};
+
+} // namespace
+
+TEST_F(DBTestUniversalCompaction, TimeWindowsAndExpiredFiles) {
+  auto filter_factory = std::make_shared<TimeWindowFilterFactory>();
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.level0_file_num_compaction_trigger = 3;
+  options.compaction_filter_factory = filter_factory;
+  options.boundary_extractor = test::MakeBoundaryValuesExtractor();
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  auto write_file = [this](uint64_t value) {
+    WriteBatch batch;
+    test::TestUserFrontiers frontiers(value, value);
+    batch.SetFrontiers(&frontiers);
+    batch.Put(Key(static_cast<int>(value)), "v");
+    ASSERT_OK(db_->Write(WriteOptions(), &batch));
+    ASSERT_OK(Flush());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  };
+
+  // There are enough files to trigger compaction, but not within a single time window.
+  for (uint64_t value : {1, 2, 11, 12}) {
+    write_file(value);
+  }
+  ASSERT_EQ(4, NumTableFilesAtLevel(0));
+
+  write_file(13);
+  ASSERT_EQ(3, NumTableFilesAtLevel(0));
+
+  // Files of the first window are deleted after the next flush, without compaction.
+  filter_factory->expired_below_ = 10;
+  write_file(21);
+  ASSERT_EQ(2, NumTableFilesAtLevel(0));
+  ASSERT_EQ("NOT_FOUND", Get(Key(1)));
+  ASSERT_EQ("NOT_FOUND", Get(Key(2)));
+  for (int key : {11, 12, 13, 21}) {
+    ASSERT_EQ("v", Get(Key(key)));
+  }
+}
+
+TEST_F(DBTestUniversalCompaction, OldestExpiredFiles) {
+  auto filter_factory = std::make_shared<OldestExpiredFilterFactory>();
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.level0_file_num_compaction_trigger = 10;
+  options.compaction_filter_factory = filter_factory;
+  options.boundary_extractor = test::MakeBoundaryValuesExtractor();
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  auto write_file = [this, &filter_factory](uint64_t value) {
+    WriteBatch batch;
+    test::TestUserFrontiers frontiers(value, value);
+    batch.SetFrontiers(&frontiers);
+    batch.Put(Key(static_cast<int>(value)), "v");
+    filter_factory->newest_value_ = std::max<uint64_t>(filter_factory->newest_value_, value);
+    ASSERT_OK(db_->Write(WriteOptions(), &batch));
+    ASSERT_OK(Flush());
+    ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  };
+
+  for (uint64_t value : {1, 2, 8, 3}) {
+    write_file(value);
+  }
+  ASSERT_EQ(4, NumTableFilesAtLevel(0));
+
+  // Only the oldest files are deleted. File with value 3 is expired, but it is newer than the
+  // file with value 8, so it is kept.
+  filter_factory->expired_below_ = 5;
+  write_file(9);
+  ASSERT_EQ(3, NumTableFilesAtLevel(0));
+  ASSERT_EQ("NOT_FOUND", Get(Key(1)));
+  ASSERT_EQ("NOT_FOUND", Get(Key(2)));
+  for (int key : {3, 8, 9}) {
+    ASSERT_EQ("v", Get(Key(key)));
+  }
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
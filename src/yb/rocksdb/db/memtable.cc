@@ -36,7 +36,9 @@
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/merge_operator.h"
 #include "yb/rocksdb/slice_transform.h"
+#include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/internal_iterator.h"
+#include "yb/rocksdb/table/iterator_wrapper.h"
 #include "yb/rocksdb/table/merger.h"
 #include "yb/rocksdb/util/arena.h"
 #include "yb/rocksdb/util/coding.h"
@@ -103,6 +105,8 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
                  ? moptions_.inplace_update_num_locks
                  : 0),
       prefix_extractor_(ioptions.prefix_extractor),
+      filter_key_transformer_(
+          ioptions.table_factory ? ioptions.table_factory->GetFilterKeyTransformer() : nullptr),
       flush_state_(FlushState::kNotRequested),
       env_(ioptions.env) {
   UpdateFlushState();
@@ -116,6 +120,13 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
         moptions_.memtable_prefix_bloom_probes, nullptr,
         moptions_.memtable_prefix_bloom_huge_page_tlb_size,
         ioptions.info_log));
+  } else if (filter_key_transformer_ && moptions_.memtable_prefix_bloom_bits > 0) {
+    filter_key_bloom_.reset(new DynamicBloom(
+        &allocator_,
+        moptions_.memtable_prefix_bloom_bits, ioptions.bloom_locality,
+        moptions_.memtable_prefix_bloom_probes, nullptr,
+        moptions_.memtable_prefix_bloom_huge_page_tlb_size,
+        ioptions.info_log));
   }
 
   if (moptions_.mem_tracker) {
@@ -344,6 +355,23 @@ class MemTableIterator : public InternalIterator {
 InternalIterator* MemTable::NewIterator(const ReadOptions& read_options,
                                         Arena* arena) {
   assert(arena != nullptr);
+  if (filter_key_bloom_ && read_options.table_aware_file_filter) {
+    const auto* user_keys = read_options.table_aware_file_filter->UserKeys();
+    if (user_keys && !user_keys->empty()) {
+      bool may_contain = false;
+      for (const auto& user_key : *user_keys) {
+        if (filter_key_bloom_->MayContain(filter_key_transformer_->Transform(user_key))) {
+          may_contain = true;
+          break;
+        }
+      }
+      if (!may_contain) {
+        PERF_COUNTER_ADD(bloom_memtable_miss_count, 1);
+        return NewEmptyInternalIterator(arena);
+      }
+      PERF_COUNTER_ADD(bloom_memtable_hit_count, 1);
+    }
+  }
   auto mem = arena->AllocateAligned(sizeof(MemTableIterator));
   return new (mem) MemTableIterator(*this, read_options, arena);
 }
@@ -437,6 +465,9 @@ void MemTable::Add(SequenceNumber s, ValueType type,
       assert(prefix_extractor_);
       prefix_bloom_->Add(prefix_extractor_->Transform(key));
     }
+    if (filter_key_bloom_) {
+      filter_key_bloom_->Add(filter_key_transformer_->Transform(key));
+    }
 
     // The first sequence number inserted into the memtable.
     // Multiple occurences of the same sequence number in the write batch are allowed
@@ -464,6 +495,9 @@ void MemTable::Add(SequenceNumber s, ValueType type,
       assert(prefix_extractor_);
       prefix_bloom_->AddConcurrently(prefix_extractor_->Transform(key));
     }
+    if (filter_key_bloom_) {
+      filter_key_bloom_->AddConcurrently(filter_key_transformer_->Transform(key));
+    }
 
     // atomically update first_seqno_ and earliest_seqno_.
     uint64_t cur_seq_num = first_seqno_.load(std::memory_order_relaxed);
@@ -708,16 +742,18 @@ bool MemTable::Get(const LookupKey& key, std::string* value, Status* s,
   Slice user_key = key.user_key();
   bool found_final_value = false;
   bool merge_in_progress = s->IsMergeInProgress();
+  DynamicBloom* const bloom = prefix_bloom_ ? prefix_bloom_.get() : filter_key_bloom_.get();
   bool const may_contain =
-      nullptr == prefix_bloom_
+      nullptr == bloom
           ? false
-          : prefix_bloom_->MayContain(prefix_extractor_->Transform(user_key));
-  if (prefix_bloom_ && !may_contain) {
+          : bloom->MayContain(prefix_bloom_ ? prefix_extractor_->Transform(user_key)
+                                            : filter_key_transformer_->Transform(user_key));
+  if (bloom && !may_contain) {
     // iter is null if prefix bloom says the key does not exist
     PERF_COUNTER_ADD(bloom_memtable_miss_count, 1);
     *seq = kMaxSequenceNumber;
   } else {
-    if (prefix_bloom_) {
+    if (bloom) {
       PERF_COUNTER_ADD(bloom_memtable_hit_count, 1);
     }
     Saver saver;
@@ -38,6 +38,7 @@
 #include "yb/rocksdb/db/version_edit.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/immutable_options.h"
 #include "yb/rocksdb/db/memtable_allocator.h"
@@ -412,6 +413,11 @@ class MemTable {
   const SliceTransform* const prefix_extractor_;
   std::unique_ptr<DynamicBloom> prefix_bloom_;
 
+  // Bloom of keys transformed by filter key transformer of the table factory, used when there is
+  // no prefix extractor.
+  const FilterPolicy::KeyTransformer* const filter_key_transformer_;
+  std::unique_ptr<DynamicBloom> filter_key_bloom_;
+
   std::atomic<FlushState> flush_state_;
 
   Env* env_;
@@ -62,10 +62,20 @@ static void DeleteTableReader(void* arg1, void* arg2) {
   delete table_reader;
 }
 
-static Slice GetSliceForFileNumber(const uint64_t* file_number) {
-  return Slice(reinterpret_cast<const char*>(file_number),
-      sizeof(*file_number));
-}
+// Key of the table reader in the table cache. Only file number is used when the cache is not
+// shared between DBs.
+class TableCacheKey {
+ public:
+  TableCacheKey(uint64_t cache_id, uint64_t file_number) : data_{file_number, cache_id} {}
+
+  Slice AsSlice() const {
+    return Slice(reinterpret_cast<const char*>(data_),
+                 data_[1] ? sizeof(data_) : sizeof(data_[0]));
+  }
+
+ private:
+  uint64_t data_[2];
+};
 
 #ifndef ROCKSDB_LITE
 
@@ -80,8 +90,8 @@ void AppendVarint64(IterKey* key, uint64_t v) {
 }  // namespace
 
 TableCache::TableCache(const ImmutableCFOptions& ioptions,
-    const EnvOptions& env_options, Cache* const cache)
-    : ioptions_(ioptions), env_options_(env_options), cache_(cache) {
+    const EnvOptions& env_options, Cache* const cache, uint64_t cache_id)
+    : ioptions_(ioptions), env_options_(env_options), cache_(cache), cache_id_(cache_id) {
   if (ioptions_.row_cache) {
     // If the same cache is shared by multiple instances, we need to
     // disambiguate its entries.
@@ -176,8 +186,8 @@ Status TableCache::FindTable(const EnvOptions& env_options,
                              HistogramImpl* file_read_hist, bool skip_filters) {
   PERF_TIMER_GUARD(find_table_nanos);
   Status s;
-  uint64_t number = fd.GetNumber();
-  Slice key = GetSliceForFileNumber(&number);
+  TableCacheKey cache_key(cache_id_, fd.GetNumber());
+  Slice key = cache_key.AsSlice();
   *handle = cache_->Lookup(key, query_id);
   TEST_SYNC_POINT_CALLBACK("TableCache::FindTable:0",
       const_cast<bool*>(&no_io));
@@ -497,8 +507,8 @@ size_t TableCache::GetMemoryUsageByTableReader(
   return ret;
 }
 
-void TableCache::Evict(Cache* cache, uint64_t file_number) {
-  cache->Erase(GetSliceForFileNumber(&file_number));
+void TableCache::Evict(Cache* cache, uint64_t cache_id, uint64_t file_number) {
+  cache->Erase(TableCacheKey(cache_id, file_number).AsSlice());
 }
 
 }  // namespace rocksdb
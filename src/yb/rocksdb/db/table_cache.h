@@ -50,8 +50,11 @@ class InternalIterator;
 
 class TableCache {
  public:
+  // cache could be shared by multiple DBs. In this case each DB should allocate cache_id using
+  // cache->NewId(), so entries of different DBs with the same file number don't collide.
+  // cache_id 0 means that cache is used only by one DB.
   TableCache(const ImmutableCFOptions& ioptions,
-             const EnvOptions& storage_options, Cache* cache);
+             const EnvOptions& storage_options, Cache* cache, uint64_t cache_id = 0);
   ~TableCache();
 
   struct TableReaderWithHandle {
@@ -111,7 +114,11 @@ class TableCache {
              bool skip_filters = false);
 
   // Evict any entry for the specified file number
-  static void Evict(Cache* cache, uint64_t file_number);
+  static void Evict(Cache* cache, uint64_t cache_id, uint64_t file_number);
+
+  void Evict(uint64_t file_number) {
+    Evict(cache_, cache_id_, file_number);
+  }
 
   // Returns table reader, tries to get it in following order:
   // - From fd.table_reader
@@ -189,6 +196,7 @@ class TableCache {
   const ImmutableCFOptions& ioptions_;
   const EnvOptions& env_options_;
   Cache* const cache_;
+  const uint64_t cache_id_;
   std::string row_cache_id_;
 };
 
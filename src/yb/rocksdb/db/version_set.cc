@@ -2102,10 +2102,11 @@ constexpr uint64_t VersionSet::kInitialNextFileNumber;
 VersionSet::VersionSet(const std::string& dbname, const DBOptions* db_options,
                        const EnvOptions& storage_options, Cache* table_cache,
                        WriteBuffer* write_buffer,
-                       WriteController* write_controller)
+                       WriteController* write_controller,
+                       uint64_t table_cache_id)
     : column_family_set_(new ColumnFamilySet(
           dbname, db_options, storage_options, table_cache,
-          write_buffer, write_controller)),
+          write_buffer, write_controller, table_cache_id)),
       env_(db_options->env),
       dbname_(dbname),
       db_options_(db_options),
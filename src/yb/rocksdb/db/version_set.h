@@ -608,9 +608,11 @@ class VersionSet {
  public:
   static constexpr uint64_t kInitialNextFileNumber = 2;
 
+  // table_cache_id partitions table_cache when it is shared with other DBs, see TableCache.
   VersionSet(const std::string& dbname, const DBOptions* db_options,
              const EnvOptions& env_options, Cache* table_cache,
-             WriteBuffer* write_buffer, WriteController* write_controller);
+             WriteBuffer* write_buffer, WriteController* write_controller,
+             uint64_t table_cache_id = 0);
   ~VersionSet();
 
   // Apply *edit to the current version to form a new descriptor that
@@ -43,6 +43,7 @@
 
 #include "yb/rocksdb/write_batch.h"
 
+#include <algorithm>
 #include <stack>
 #include <stdexcept>
 #include <vector>
@@ -288,13 +289,29 @@ Status WriteBatch::Iterate(Handler* handler) const {
   }
 
   input.remove_prefix(kHeader);
-  Slice key, value, blob;
   size_t found = 0;
   Status s;
 
   if (frontiers_) {
     s = handler->Frontiers(*frontiers_);
   }
+  if (s.ok()) {
+    s = IterateRecords(input, handler, &found);
+  }
+  if (!s.ok()) {
+    return s;
+  }
+  if (found != WriteBatchInternal::Count(this)) {
+    return STATUS(Corruption, "WriteBatch has wrong count");
+  } else {
+    return Status::OK();
+  }
+}
+
+Status WriteBatch::IterateRecords(Slice input, Handler* handler, size_t* found) const {
+  Slice key, value, blob;
+  Status s;
+
   while (s.ok() && !input.empty() && handler->Continue()) {
     char tag = 0;
     uint32_t column_family = 0;  // default
@@ -311,28 +328,28 @@ Status WriteBatch::Iterate(Handler* handler) const {
         assert(content_flags_.load(std::memory_order_relaxed) &
                (ContentFlags::DEFERRED | ContentFlags::HAS_PUT));
         s = handler->PutCF(column_family, key, value);
-        found++;
+        ++*found;
         break;
       case kTypeColumnFamilyDeletion:
       case kTypeDeletion:
         assert(content_flags_.load(std::memory_order_relaxed) &
                (ContentFlags::DEFERRED | ContentFlags::HAS_DELETE));
         s = handler->DeleteCF(column_family, key);
-        found++;
+        ++*found;
         break;
       case kTypeColumnFamilySingleDeletion:
       case kTypeSingleDeletion:
         assert(content_flags_.load(std::memory_order_relaxed) &
                (ContentFlags::DEFERRED | ContentFlags::HAS_SINGLE_DELETE));
         s = handler->SingleDeleteCF(column_family, key);
-        found++;
+        ++*found;
         break;
       case kTypeColumnFamilyMerge:
       case kTypeMerge:
         assert(content_flags_.load(std::memory_order_relaxed) &
                (ContentFlags::DEFERRED | ContentFlags::HAS_MERGE));
         s = handler->MergeCF(column_family, key, value);
-        found++;
+        ++*found;
         break;
       case kTypeLogData:
         handler->LogData(blob);
@@ -341,14 +358,7 @@ Status WriteBatch::Iterate(Handler* handler) const {
         return STATUS(Corruption, "unknown WriteBatch tag");
     }
   }
-  if (!s.ok()) {
-    return s;
-  }
-  if (found != WriteBatchInternal::Count(this)) {
-    return STATUS(Corruption, "WriteBatch has wrong count");
-  } else {
-    return Status::OK();
-  }
+  return s;
 }
 
 uint32_t WriteBatchInternal::Count(const WriteBatch* b) {
@@ -892,6 +902,62 @@ Status WriteBatchInternal::InsertInto(const WriteBatch* batch,
   return batch->Iterate(&inserter);
 }
 
+Status WriteBatchInternal::Split(
+    const WriteBatch* batch, size_t max_parts, std::vector<Part>* parts) {
+  Slice input(batch->rep_);
+  if (input.size() < kHeader) {
+    return STATUS(Corruption, "malformed WriteBatch (too small)");
+  }
+  input.remove_prefix(kHeader);
+
+  const size_t total_count = Count(batch);
+  const size_t part_count = std::max<size_t>((total_count + max_parts - 1) / max_parts, 1);
+  parts->clear();
+  Part current = {kHeader, kHeader, Sequence(batch), 0};
+  Slice key, value, blob;
+  while (!input.empty()) {
+    char tag = 0;
+    uint32_t column_family = 0;
+    RETURN_NOT_OK(ReadRecordFromWriteBatch(
+        &input, &tag, &column_family, &key, &value, &blob));
+    if (tag != kTypeLogData) {
+      ++current.count;
+    }
+    current.end = batch->rep_.size() - input.size();
+    if (current.count == part_count) {
+      parts->push_back(current);
+      current = Part{current.end, current.end, current.sequence + current.count, 0};
+    }
+  }
+  if (current.begin != current.end) {
+    parts->push_back(current);
+  }
+  if (current.sequence + current.count - Sequence(batch) != total_count) {
+    return STATUS(Corruption, "WriteBatch has wrong count");
+  }
+  return Status::OK();
+}
+
+Status WriteBatchInternal::InsertInto(const WriteBatch* batch, const Part& part,
+                                      ColumnFamilyMemTables* memtables,
+                                      FlushScheduler* flush_scheduler,
+                                      bool ignore_missing_column_families,
+                                      DB* db, InsertFlags insert_flags) {
+  MemTableInserter inserter(part.sequence, memtables, flush_scheduler,
+                            ignore_missing_column_families, 0 /* log_number */, db,
+                            insert_flags);
+  if (part.begin == kHeader && batch->frontiers_) {
+    RETURN_NOT_OK(inserter.Frontiers(*batch->frontiers_));
+  }
+  size_t found = 0;
+  RETURN_NOT_OK(batch->IterateRecords(
+      Slice(batch->rep_.data() + part.begin, part.end - part.begin), &inserter, &found));
+  if (found != part.count) {
+    return STATUS(Corruption, "WriteBatch has wrong count");
+  }
+  return Status::OK();
+}
+
 void WriteBatchInternal::SetContents(WriteBatch* b, const Slice& contents) {
   DCHECK_GE(contents.size(), kHeader);
   b->rep_.assign(contents.cdata(), contents.size());
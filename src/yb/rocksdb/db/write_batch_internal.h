@@ -176,6 +176,31 @@ class WriteBatchInternal {
                            uint64_t log_number = 0, DB* db = nullptr,
                            InsertFlags insert_flags = InsertFlags());
 
+  // Contiguous part of write batch records, used to insert a large batch into memtables from
+  // several threads.
+  struct Part {
+    // Offsets of the part records in the batch contents.
+    size_t begin;
+    size_t end;
+    // Sequence number of the first update in the part.
+    SequenceNumber sequence;
+    // Number of updates in the part.
+    size_t count;
+  };
+
+  // Splits records of the batch into at most max_parts parts with approximately equal number of
+  // updates. Sequence number should be already assigned to the batch.
+  static Status Split(const WriteBatch* batch, size_t max_parts, std::vector<Part>* parts);
+
+  // Inserts updates from the part of the batch into memtable. Frontiers of the batch are applied
+  // together with the part that starts at the first record.
+  static Status InsertInto(const WriteBatch* batch, const Part& part,
+                           ColumnFamilyMemTables* memtables,
+                           FlushScheduler* flush_scheduler,
+                           bool ignore_missing_column_families = false,
+                           DB* db = nullptr,
+                           InsertFlags insert_flags = InsertFlags());
+
   static void Append(WriteBatch* dst, const WriteBatch* src);
 
   // Returns the byte size of appending a WriteBatch with ByteSize
@@ -19,6 +19,50 @@
 //
 #pragma once
 
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "yb/util/slice.h"
+
 namespace rocksdb {
-int db_bench_tool(int argc, char** argv);
+
+struct Options;
+class Statistics;
+class UserFrontiers;
+
+// Profile of a storage layer built on top of RocksDB, that is used by profile* benchmarks to
+// produce keys, values and options of this layer, e.g. DocDB.
+//
+// Each key has multiple versions, every write to a key produces a new version stored under its own
+// RocksDB key, that consists of key prefix and version suffix. Newer versions should be ordered
+// before older ones, and all versions of a key should be ordered before versions of other keys.
+class DbBenchProfile {
+ public:
+  virtual ~DbBenchProfile() {}
+
+  virtual const char* Name() const = 0;
+
+  // Updates options initialized from flags with options used by the storage layer.
+  virtual void InitOptions(const std::shared_ptr<Statistics>& statistics,
+                           Options* options) const = 0;
+
+  // Appends prefix shared by all versions of the key with specified index.
+  virtual void AppendKeyPrefix(int64_t key_index, std::string* out) const = 0;
+
+  // Appends suffix of the specified version to the key prefix.
+  virtual void AppendKeySuffix(uint64_t version, std::string* out) const = 0;
+
+  virtual void AppendValue(const Slice& value, std::string* out) const = 0;
+
+  // Creates frontiers for a write batch that contains versions from the specified range, or
+  // nullptr if the storage layer does not use frontiers.
+  virtual std::unique_ptr<UserFrontiers> CreateFrontiers(
+      uint64_t min_version, uint64_t max_version) const = 0;
+};
+
+// When profile is specified, profile* benchmarks are available.
+int db_bench_tool(int argc, char** argv, const DbBenchProfile* profile = nullptr);
+
 }  // namespace rocksdb
@@ -111,6 +111,10 @@ struct ImmutableCFOptions {
 
   CompressionOptions compression_opts;
 
+  CompressionType large_compaction_compression;
+
+  uint64_t large_compaction_compression_threshold;
+
   bool level_compaction_dynamic_level_bytes;
 
   Options::AccessHint access_hint_on_compaction_start;
@@ -74,6 +74,8 @@ enum class CompactionReason {
   kManualCompaction,
   // DB::SuggestCompactRange() marked files for compaction
   kFilesMarkedForCompaction,
+  // [Universal] all entries of files are expired, so files are deleted
+  kUniversalFilesExpired,
 };
 
 #ifndef ROCKSDB_LITE
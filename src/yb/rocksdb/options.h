@@ -46,6 +46,7 @@ namespace yb {
 
 class MemTracker;
 class PriorityThreadPool;
+class ThreadPool;
 
 }
 
@@ -168,9 +169,22 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of the dictionary used to compress data blocks of an SST file produced by
+  // compaction. Dictionary is sampled from compaction input and stored in the SST meta block, so
+  // small blocks, that share a lot of content with each other, compress much better.
+  // Only supported by ZSTD.
+  // Default: 0, dictionary is not used.
+  uint32_t max_dict_bytes;
+  // Maximum size of samples used to train the dictionary. When 0, raw samples truncated to
+  // max_dict_bytes are used as the dictionary.
+  // Default: 0.
+  uint32_t zstd_max_train_bytes;
+  CompressionOptions()
+      : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0), zstd_max_train_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0,
+                     uint32_t _zstd_max_train_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes),
+        zstd_max_train_bytes(_zstd_max_train_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -381,6 +395,15 @@ struct ColumnFamilyOptions {
   // different options for compression algorithms
   CompressionOptions compression_opts;
 
+  // Universal compaction with total input size of at least
+  // large_compaction_compression_threshold bytes uses large_compaction_compression instead of
+  // the compression specified above. Such compactions produce big files that live for a long time,
+  // so it is worth using slower compression with better ratio for them, while small and young
+  // files are compressed with a fast one.
+  // Default: 0, all compactions use the same compression.
+  CompressionType large_compaction_compression;
+  uint64_t large_compaction_compression_threshold;
+
   // If non-nullptr, use the specified function to determine the
   // prefixes for keys.  These prefixes will be placed in the filter.
   // Depending on the workload, this can reduce the number of read-IOP
@@ -745,7 +768,11 @@ struct ColumnFamilyOptions {
                                    std::string* merged_value);
 
   // if prefix_extractor is set and bloom_bits is not 0, create prefix bloom
-  // for memtable
+  // for memtable.
+  // if prefix_extractor is not set, bloom_bits is not 0 and filter policy of
+  // the table factory has key transformer, create bloom of transformed keys
+  // for memtable. It is used to skip memtable for gets and for reads limited
+  // by table_aware_file_filter.
   //
   // Dynamically changeable through SetOptions() API
   uint32_t memtable_prefix_bloom_bits;
@@ -1262,6 +1289,17 @@ struct DBOptions {
   // Default: false
   bool allow_concurrent_memtable_write;
 
+  // If set together with allow_concurrent_memtable_write, write batch with at least twice this
+  // number of updates is split into parts of at least this size. Parts are inserted into memtable
+  // in parallel using memtable_insert_thread_pool, while the writing thread inserts parts that
+  // were not picked up by the pool yet.
+  //
+  // Default: 0, i.e. each batch is inserted by a single thread.
+  size_t parallel_memtable_insert_part_size;
+
+  // Thread pool used for parallel memtable inserts, see parallel_memtable_insert_part_size.
+  yb::ThreadPool* memtable_insert_thread_pool = nullptr;
+
   // If true, threads synchronizing with the write batch group leader will
   // wait for up to write_thread_max_yield_usec before blocking on a mutex.
   // This can substantially improve throughput for concurrent workloads,
@@ -1308,6 +1346,11 @@ struct DBOptions {
   // Not supported in ROCKSDB_LITE mode!
   std::shared_ptr<Cache> row_cache;
 
+  // Cache of table readers, that could be shared by multiple DBs to limit the total number of
+  // open table files. Each table reader is charged as 1 against its capacity.
+  // Default: nullptr (each DB has own table cache sized from max_open_files)
+  std::shared_ptr<Cache> table_cache;
+
 #ifndef ROCKSDB_LITE
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
@@ -1406,6 +1449,10 @@ class TableAwareReadFileFilter {
  public:
   virtual bool Filter(TableReader*) const = 0;
 
+  // Returns user keys, that the read is limited to, or nullptr if they are not known.
+  // Used to skip memtables that do not contain such keys.
+  virtual const std::vector<std::string>* UserKeys() const { return nullptr; }
+
  protected:
   virtual ~TableAwareReadFileFilter() {}
 };
@@ -1636,6 +1683,8 @@ struct CompactRangeOptions {
   // if there is a compaction filter
   BottommostLevelCompaction bottommost_level_compaction =
       BottommostLevelCompaction::kIfHaveCompactionFilter;
+  // Added to the priority of the compaction task, when priority thread pool is used.
+  int extra_priority = 0;
 };
 }  // namespace rocksdb
 
@@ -50,6 +50,10 @@ struct PerfContext {
   uint64_t internal_key_skipped_count;
   // total number of deletes and single deletes skipped over during iteration
   uint64_t internal_delete_skipped_count;
+  // total number of seeks done by user facing iterators
+  uint64_t iter_seek_count;
+  // total number of next and prev calls on user facing iterators
+  uint64_t iter_next_count;
 
   uint64_t get_snapshot_time;       // total nanos spent on getting snapshot
   uint64_t get_from_memtable_time;  // total nanos spent on querying memtables
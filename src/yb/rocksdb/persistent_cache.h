@@ -0,0 +1,59 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// PersistentCache is the second tier of the block cache, that keeps raw blocks on a fast local
+// device, for instance NVMe SSD, when SST files are located on slower storage. Blocks are
+// looked up in it after a miss in the block cache, before reading the SST file.
+
+#ifndef YB_ROCKSDB_PERSISTENT_CACHE_H
+#define YB_ROCKSDB_PERSISTENT_CACHE_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "yb/rocksdb/status.h"
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+class Env;
+
+class PersistentCache {
+ public:
+  virtual ~PersistentCache() {}
+
+  // Stores block contents for the key, replacing the previous block stored for it.
+  virtual CHECKED_STATUS Insert(const Slice& key, const Slice& data) = 0;
+
+  // Reads block stored for the key into buf, that should have space for size bytes.
+  // Returns NotFound if there is no block of such size stored for the key.
+  virtual CHECKED_STATUS Lookup(const Slice& key, size_t size, char* buf) = 0;
+
+  // Returns a new numeric id, used to generate cache keys for files without unique id.
+  virtual uint64_t NewId() = 0;
+
+  virtual size_t GetCapacity() const = 0;
+
+  virtual size_t GetUsage() const = 0;
+};
+
+// Creates persistent cache that stores blocks in files under the specified directory, using at
+// most capacity bytes. Files left in the directory by previous instances are removed, since the
+// index of cached blocks is kept in memory only.
+CHECKED_STATUS NewFilePersistentCache(Env* env, const std::string& path, size_t capacity,
+                                      std::shared_ptr<PersistentCache>* result);
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_PERSISTENT_CACHE_H
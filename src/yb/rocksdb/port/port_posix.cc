@@ -76,6 +76,18 @@ void Mutex::Lock() {
 #endif
 }
 
+bool Mutex::TryLock() {
+  int err = pthread_mutex_trylock(&mu_);
+  if (err == EBUSY) {
+    return false;
+  }
+  PthreadCall("trylock", err);
+#ifndef NDEBUG
+  locked_ = true;
+#endif
+  return true;
+}
+
 void Mutex::Unlock() {
 #ifndef NDEBUG
   locked_ = false;
@@ -107,6 +107,8 @@ class Mutex {
   ~Mutex();
 
   void Lock();
+  // Returns true if the mutex was acquired without blocking.
+  bool TryLock();
   void Unlock();
   // this will assert if the mutex is not locked
   // it does NOT verify that mutex is held by a calling thread
@@ -35,8 +35,10 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/immutable_options.h"
@@ -47,6 +49,7 @@ namespace rocksdb {
 
 // -- Block-based Table
 class FlushBlockPolicyFactory;
+class PersistentCache;
 struct TableReaderOptions;
 struct TableBuilderOptions;
 class TableBuilder;
@@ -78,6 +81,46 @@ YB_DEFINE_ENUM(IndexType,
   (kMultiLevelBinarySearch)
 );
 
+YB_DEFINE_ENUM(KeyValueEncodingFormat,
+  // Key is stored as a number of bytes shared with the previous key and the remaining bytes.
+  (kKeyDeltaEncodingSharedPrefix)
+
+  // Key is split into prefix and suffix using KeySuffixExtractor, each of them is stored as a
+  // number of bytes shared with the same part of the previous key and the remaining bytes.
+  // Suffix includes 8 bytes of internal key footer. This way keys that differ mostly in the
+  // trailing part, for instance DocDB keys that differ in DocHybridTime, are stored compactly.
+  (kKeyDeltaEncodingSharedPrefixAndSuffix)
+);
+
+// Determines suffix of user keys that is delta encoded separately from the rest of the key, when
+// kKeyDeltaEncodingSharedPrefixAndSuffix is used for data blocks.
+class KeySuffixExtractor {
+ public:
+  virtual ~KeySuffixExtractor() {}
+
+  virtual const char* Name() const = 0;
+
+  // Returns size of the suffix of the user key, that should not exceed the size of the key.
+  virtual size_t SuffixSize(const Slice& user_key) const = 0;
+};
+
+// Determines part of user keys that is used as a key of hash index inside data blocks, for
+// instance DocKey of DocDB keys.
+// Requires: for any keys a < b with different hash keys and any key c with the same hash key as b,
+// a < c should hold. I.e. hash keys should be prefixes of user keys, and none of them should be
+// a prefix of another one.
+class DataBlockHashKeyExtractor {
+ public:
+  virtual ~DataBlockHashKeyExtractor() {}
+
+  // Name is stored in table properties, and hash index is used only for files written with
+  // extractor of the same name.
+  virtual const char* Name() const = 0;
+
+  // Returns hash key of the user key, or empty slice if key should not be indexed.
+  virtual Slice HashKey(const Slice& user_key) const = 0;
+};
+
 // For advanced user only
 struct BlockBasedTableOptions {
   // @flush_block_policy_factory creates the instances of flush block policy.
@@ -122,6 +165,16 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL use the specified cache for index and filter blocks instead of block_cache, so
+  // they are not evicted by data blocks. In this case the top level of multi-level index is kept
+  // by the table reader while it is open, instead of being cached.
+  std::shared_ptr<Cache> index_and_filter_block_cache = nullptr;
+
+  // If non-NULL, raw blocks that are read from SST files are also stored in this cache, usually
+  // located on a faster local device, and looked up there before reading SST file on a block cache
+  // miss.
+  std::shared_ptr<PersistentCache> persistent_cache = nullptr;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
@@ -156,12 +209,35 @@ struct BlockBasedTableOptions {
   // used to avoid too many index levels in case we have large keys.
   size_t min_keys_per_index_block = 64;
 
+  // Maximum size of readahead done by iterators, that read adjacent data blocks sequentially.
+  // Readahead starts after a few sequential block reads by the same iterator, with size, that is
+  // doubled on each readahead up to this limit. Prefetched data is not added to the block cache, so
+  // long scans don't need one small read per data block. 0 disables readahead.
+  size_t max_auto_readahead_size = 256_KB;
+
   // Use delta encoding to compress keys in blocks.
   // Iterator::PinData() requires this option to be disabled.
   //
   // Default: true
   bool use_delta_encoding = true;
 
+  // Encoding of keys in data blocks. This option only affects newly written data blocks, the format
+  // of an existing block is stored in the block itself.
+  KeyValueEncodingFormat data_block_key_value_encoding_format =
+      KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
+
+  // Used to split keys of data blocks for kKeyDeltaEncodingSharedPrefixAndSuffix. If nullptr, only
+  // internal key footer is used as a suffix.
+  std::shared_ptr<const KeySuffixExtractor> data_block_key_suffix_extractor;
+
+  // If non-nullptr, hash index from hash key to restart interval is added to data blocks, so
+  // seeks to keys with hash key present in the hash index don't need a binary search over restart
+  // points.
+  std::shared_ptr<const DataBlockHashKeyExtractor> data_block_hash_key_extractor;
+
+  // Ratio of the number of hash keys to the number of buckets of data block hash index.
+  double data_block_hash_table_util_ratio = 0.75;
+
   // If non-nullptr, use the specified filter policy for new SST files to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
@@ -220,6 +296,8 @@ struct BlockBasedTablePropertyNames {
   static const char kWholeKeyFiltering[];
   // value is "1" for true and "0" for false.
   static const char kPrefixFiltering[];
+  // name of the data block hash key extractor, absent if data blocks don't have hash index.
+  static const char kDataBlockHashKeyExtractor[];
 };
 
 // Create default block based table factory.
@@ -423,6 +501,16 @@ class TableFactory {
   // DocDbAwareFilterPolicy and HashedComponentsExtractor.
   virtual std::shared_ptr<TableAwareReadFileFilter> NewTableAwareReadFileFilter(
       const ReadOptions &read_options, const Slice &user_key) const { return nullptr; }
+
+  // Same as above, but the file is pruned out only when it does not contain any of user_keys.
+  virtual std::shared_ptr<TableAwareReadFileFilter> NewTableAwareReadFileFilter(
+      const ReadOptions &read_options, const std::vector<Slice> &user_keys) const {
+    return nullptr;
+  }
+
+  // Returns key transformer applied to keys added to bloom filters of tables, nullptr if there is
+  // no such transformer.
+  virtual const FilterPolicy::KeyTransformer* GetFilterKeyTransformer() const { return nullptr; }
 };
 
 #ifndef ROCKSDB_LITE
@@ -33,8 +33,10 @@
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/table/format.h"
 #include "yb/rocksdb/table/block_hash_index.h"
+#include "yb/rocksdb/table/block_internal.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
 #include "yb/rocksdb/util/logging.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 
@@ -48,6 +50,9 @@ namespace {
 // - num_restarts: uint32
 const size_t kMinBlockSize = 2*sizeof(uint32_t);
 
+// Sequence number and value type of internal key.
+constexpr size_t kInternalKeyFooterSize = sizeof(uint64_t);
+
 } // namespace
 
 // Helper routine: decode the next block entry starting at "p",
@@ -80,6 +85,68 @@ static inline const char* DecodeEntry(const char* p, const char* limit,
   return p;
 }
 
+// Same as DecodeEntry, but for kKeyDeltaEncodingSharedPrefixAndSuffix format, that also has
+// number of shared and non shared bytes of the key suffix.
+static inline const char* DecodeEntryWithSuffix(const char* p, const char* limit,
+                                                uint32_t* shared,
+                                                uint32_t* non_shared,
+                                                uint32_t* value_length,
+                                                uint32_t* suffix_shared,
+                                                uint32_t* suffix_non_shared) {
+  if (limit - p < 5) return nullptr;
+  const auto* u = reinterpret_cast<const unsigned char*>(p);
+  if ((u[0] | u[1] | u[2] | u[3] | u[4]) < 128) {
+    // Fast path: all five values are encoded in one byte each
+    *shared = u[0];
+    *non_shared = u[1];
+    *value_length = u[2];
+    *suffix_shared = u[3];
+    *suffix_non_shared = u[4];
+    p += 5;
+  } else {
+    if ((p = GetVarint32Ptr(p, limit, shared)) == nullptr) return nullptr;
+    if ((p = GetVarint32Ptr(p, limit, non_shared)) == nullptr) return nullptr;
+    if ((p = GetVarint32Ptr(p, limit, value_length)) == nullptr) return nullptr;
+    if ((p = GetVarint32Ptr(p, limit, suffix_shared)) == nullptr) return nullptr;
+    if ((p = GetVarint32Ptr(p, limit, suffix_non_shared)) == nullptr) return nullptr;
+  }
+
+  if (static_cast<uint64_t>(limit - p) <
+          static_cast<uint64_t>(*non_shared) + *suffix_non_shared + *value_length) {
+    return nullptr;
+  }
+  return p;
+}
+
+// Decodes key of the entry at restart point, that is stored without sharing bytes with the
+// previous key. Returns false in case of corruption.
+static inline bool DecodeRestartEntryKey(const char* p, const char* limit,
+                                         KeyValueEncodingFormat key_value_encoding_format,
+                                         Slice* key) {
+  uint32_t shared, non_shared, value_length;
+  switch (key_value_encoding_format) {
+    case KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix: {
+      const char* key_ptr = DecodeEntry(p, limit, &shared, &non_shared, &value_length);
+      if (key_ptr == nullptr || shared != 0) {
+        return false;
+      }
+      *key = Slice(key_ptr, non_shared);
+      return true;
+    }
+    case KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix: {
+      uint32_t suffix_shared, suffix_non_shared;
+      const char* key_ptr = DecodeEntryWithSuffix(
+          p, limit, &shared, &non_shared, &value_length, &suffix_shared, &suffix_non_shared);
+      if (key_ptr == nullptr || shared != 0 || suffix_shared != 0) {
+        return false;
+      }
+      *key = Slice(key_ptr, non_shared + suffix_non_shared);
+      return true;
+    }
+  }
+  FATAL_INVALID_ENUM_VALUE(KeyValueEncodingFormat, key_value_encoding_format);
+}
+
 void BlockIter::Next() {
   assert(Valid());
   ParseNextKey();
@@ -107,19 +174,25 @@ void BlockIter::Prev() {
 }
 
 void BlockIter::Initialize(const Comparator* comparator, const char* data,
+                           KeyValueEncodingFormat key_value_encoding_format,
                            uint32_t restarts, uint32_t num_restarts, BlockHashIndex* hash_index,
-                           BlockPrefixIndex* prefix_index) {
+                           BlockPrefixIndex* prefix_index,
+                           const DataBlockHashIndex& data_block_hash_index,
+                           const DataBlockHashKeyExtractor* hash_key_extractor) {
   DCHECK(data_ == nullptr); // Ensure it is called only once
   DCHECK_GT(num_restarts, 0); // Ensure the param is valid
 
   comparator_ = comparator;
   data_ = data;
+  key_value_encoding_format_ = key_value_encoding_format;
   restarts_ = restarts;
   num_restarts_ = num_restarts;
   current_ = restarts_;
   restart_index_ = num_restarts_;
   hash_index_ = hash_index;
   prefix_index_ = prefix_index;
+  data_block_hash_index_ = data_block_hash_index;
+  hash_key_extractor_ = data_block_hash_index.num_buckets != 0 ? hash_key_extractor : nullptr;
 }
 
 
@@ -132,9 +205,13 @@ void BlockIter::Seek(const Slice& target) {
   bool ok = false;
   if (prefix_index_) {
     ok = PrefixSeek(target, &index);
+  } else if (hash_index_) {
+    ok = HashSeek(target, &index);
   } else {
-    ok = hash_index_ ? HashSeek(target, &index)
-      : BinarySeek(target, 0, num_restarts_ - 1, &index);
+    if (DataBlockHashSeek(target)) {
+      return;
+    }
+    ok = BinarySeek(target, 0, num_restarts_ - 1, &index);
   }
 
   if (!ok) {
@@ -186,6 +263,7 @@ void BlockIter::CorruptionError() {
   restart_index_ = num_restarts_;
   status_ = BadEntryInBlockError();
   key_.Clear();
+  key_suffix_size_ = 0;
   value_.clear();
 }
 
@@ -202,11 +280,12 @@ bool BlockIter::ParseNextKey() {
 
   // Decode next entry
   uint32_t shared, non_shared, value_length;
-  p = DecodeEntry(p, limit, &shared, &non_shared, &value_length);
-  if (p == nullptr || key_.Size() < shared) {
-    CorruptionError();
-    return false;
-  } else {
+  if (key_value_encoding_format_ == KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix) {
+    p = DecodeEntry(p, limit, &shared, &non_shared, &value_length);
+    if (p == nullptr || key_.Size() < shared) {
+      CorruptionError();
+      return false;
+    }
     if (shared == 0) {
       // If this key dont share any bytes with prev key then we dont need
       // to decode it and can use it's address in the block directly.
@@ -216,12 +295,40 @@ bool BlockIter::ParseNextKey() {
       key_.TrimAppend(shared, p, non_shared);
     }
     value_ = Slice(p + non_shared, value_length);
-    while (restart_index_ + 1 < num_restarts_ &&
-           GetRestartPoint(restart_index_ + 1) < current_) {
-      ++restart_index_;
+  } else {
+    uint32_t suffix_shared, suffix_non_shared;
+    p = DecodeEntryWithSuffix(
+        p, limit, &shared, &non_shared, &value_length, &suffix_shared, &suffix_non_shared);
+    if (p == nullptr || key_.Size() < shared + key_suffix_size_ ||
+        key_suffix_size_ < suffix_shared) {
+      CorruptionError();
+      return false;
     }
-    return true;
+    if (shared == 0 && suffix_shared == 0) {
+      // Whole key is stored contiguously in the block, so use it directly.
+      key_.SetKey(Slice(p, non_shared + suffix_non_shared), false /* copy */);
+    } else {
+      // Shared part of the suffix follows the prefix in the previous key, so it should be saved
+      // before the prefix is updated.
+      const char* prev_suffix = key_.GetKey().cdata() + key_.Size() - key_suffix_size_;
+      suffix_buffer_.assign(prev_suffix, suffix_shared);
+      suffix_buffer_.append(p + non_shared, suffix_non_shared);
+      key_.TrimAppend(shared, p, non_shared);
+      key_.TrimAppend(key_.Size(), suffix_buffer_.data(), suffix_buffer_.size());
+    }
+    key_suffix_size_ = suffix_shared + suffix_non_shared;
+    value_ = Slice(p + non_shared + suffix_non_shared, value_length);
   }
+  while (restart_index_ + 1 < num_restarts_ &&
+         GetRestartPoint(restart_index_ + 1) < current_) {
+    ++restart_index_;
+  }
+  return true;
+}
+
+bool BlockIter::DecodeRestartKey(uint32_t index, Slice* key) {
+  return DecodeRestartEntryKey(
+      data_ + GetRestartPoint(index), data_ + restarts_, key_value_encoding_format_, key);
 }
 
 // Binary search in restart array to find the first restart point
@@ -232,16 +339,11 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
 
   while (left < right) {
     uint32_t mid = (left + right + 1) / 2;
-    uint32_t region_offset = GetRestartPoint(mid);
-    uint32_t shared, non_shared, value_length;
-    const char* key_ptr =
-        DecodeEntry(data_ + region_offset, data_ + restarts_, &shared,
-                    &non_shared, &value_length);
-    if (key_ptr == nullptr || (shared != 0)) {
+    Slice mid_key;
+    if (!DecodeRestartKey(mid, &mid_key)) {
       CorruptionError();
       return false;
     }
-    Slice mid_key(key_ptr, non_shared);
     int cmp = Compare(mid_key, target);
     if (cmp < 0) {
       // Key at "mid" is smaller than "target". Therefore all
@@ -263,15 +365,11 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
 // Compare target key and the block key of the block of `block_index`.
 // Return -1 if error.
 int BlockIter::CompareBlockKey(uint32_t block_index, const Slice& target) {
-  uint32_t region_offset = GetRestartPoint(block_index);
-  uint32_t shared, non_shared, value_length;
-  const char* key_ptr = DecodeEntry(data_ + region_offset, data_ + restarts_,
-                                    &shared, &non_shared, &value_length);
-  if (key_ptr == nullptr || (shared != 0)) {
+  Slice block_key;
+  if (!DecodeRestartKey(block_index, &block_key)) {
     CorruptionError();
     return 1;  // Return target is smaller
   }
-  Slice block_key(key_ptr, non_shared);
   return Compare(block_key, target);
 }
 
@@ -355,9 +453,41 @@ bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
   }
 }
 
+bool BlockIter::DataBlockHashSeek(const Slice& target) {
+  if (hash_key_extractor_ == nullptr || target.size() < kInternalKeyFooterSize) {
+    return false;
+  }
+  const Slice hash_key = hash_key_extractor_->HashKey(ExtractUserKey(target));
+  if (hash_key.empty()) {
+    return false;
+  }
+  const uint32_t restart_index = data_block_hash_index_.buckets[
+      GetSliceHash(hash_key) % data_block_hash_index_.num_buckets];
+  if (restart_index >= num_restarts_) {
+    // No entry or collision.
+    return false;
+  }
+
+  SeekToRestartPoint(restart_index);
+  while (ParseNextKey()) {
+    if (restart_index_ > restart_index + 1) {
+      // Keys with target hash key are absent or there are too many of them to scan linearly.
+      return false;
+    }
+    if (Compare(key_.GetKey(), target) >= 0) {
+      // The bucket could be occupied by another hash key, so the restart interval is guaranteed to
+      // be correct only when the found key has target hash key, i.e. target hash key is present in
+      // the block.
+      return key_.Size() >= kInternalKeyFooterSize &&
+             hash_key_extractor_->HashKey(ExtractUserKey(key_.GetKey())) == hash_key;
+    }
+  }
+  return false;
+}
+
 uint32_t Block::NumRestarts() const {
   assert(size_ >= kMinBlockSize);
-  return DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  return UnpackNumRestarts(DecodeFixed32(data_ + size_ - sizeof(uint32_t)));
 }
 
 Block::Block(BlockContents&& contents)
@@ -367,9 +497,32 @@ Block::Block(BlockContents&& contents)
   if (size_ < sizeof(uint32_t)) {
     size_ = 0;  // Error marker
   } else {
+    const auto packed_num_restarts = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+    if ((packed_num_restarts >> kKeyValueEncodingFormatShift) >= kKeyValueEncodingFormatMapSize) {
+      size_ = 0;  // Unknown key value encoding format
+      return;
+    }
+    key_value_encoding_format_ = UnpackKeyValueEncodingFormat(packed_num_restarts);
+    // Size of the block without trailer that follows restarts array.
+    size_t restarts_end = size_ - sizeof(uint32_t);
+    if (UnpackHasHashIndex(packed_num_restarts)) {
+      if (restarts_end < sizeof(uint32_t)) {
+        size_ = 0;
+        return;
+      }
+      restarts_end -= sizeof(uint32_t);
+      const auto num_buckets = DecodeFixed32(data_ + restarts_end);
+      if (num_buckets == 0 || num_buckets > restarts_end) {
+        size_ = 0;
+        return;
+      }
+      restarts_end -= num_buckets;
+      data_block_hash_index_.buckets = reinterpret_cast<const uint8_t*>(data_ + restarts_end);
+      data_block_hash_index_.num_buckets = num_buckets;
+    }
     restart_offset_ =
-        static_cast<uint32_t>(size_) - (1 + NumRestarts()) * sizeof(uint32_t);
-    if (restart_offset_ > size_ - sizeof(uint32_t)) {
+        static_cast<uint32_t>(restarts_end) - NumRestarts() * sizeof(uint32_t);
+    if (restart_offset_ > restarts_end) {
       // The size is too small for NumRestarts() and therefore
       // restart_offset_ wrapped around.
       size_ = 0;
@@ -378,7 +531,8 @@ Block::Block(BlockContents&& contents)
 }
 
 InternalIterator* Block::NewIterator(const Comparator* cmp, BlockIter* iter,
-                                     bool total_order_seek) {
+                                     bool total_order_seek,
+                                     const DataBlockHashKeyExtractor* hash_key_extractor) {
   if (size_ < kMinBlockSize) {
     if (iter != nullptr) {
       iter->SetStatus(BadBlockContentsError());
@@ -402,11 +556,12 @@ InternalIterator* Block::NewIterator(const Comparator* cmp, BlockIter* iter,
         total_order_seek ? nullptr : prefix_index_.get();
 
     if (iter != nullptr) {
-      iter->Initialize(cmp, data_, restart_offset_, num_restarts,
-                    hash_index_ptr, prefix_index_ptr);
+      iter->Initialize(cmp, data_, key_value_encoding_format_, restart_offset_, num_restarts,
+                    hash_index_ptr, prefix_index_ptr, data_block_hash_index_, hash_key_extractor);
     } else {
-      iter = new BlockIter(cmp, data_, restart_offset_, num_restarts,
-                           hash_index_ptr, prefix_index_ptr);
+      iter = new BlockIter(cmp, data_, key_value_encoding_format_, restart_offset_, num_restarts,
+                           hash_index_ptr, prefix_index_ptr, data_block_hash_index_,
+                           hash_key_extractor);
     }
   }
 
@@ -439,16 +594,38 @@ yb::Result<Slice> Block::GetMiddleKey() const {
     return STATUS(Incomplete, "Empty block");
   }
 
-  const auto restart_idx = (NumRestarts() - 1) / 2;
+  return GetRestartKey((NumRestarts() - 1) / 2);
+}
+
+yb::Result<std::vector<Slice>> Block::GetSampleKeys(size_t max_keys) const {
+  if (size_ < kMinBlockSize) {
+    return BadBlockContentsError();
+  }
+
+  std::vector<Slice> result;
+  if (size_ == kMinBlockSize || max_keys == 0) {
+    return result;
+  }
+
+  // Pick restart keys in the middles of max_keys equal parts of the restart array.
+  const size_t num_restarts = NumRestarts();
+  const size_t num_keys = std::min<size_t>(max_keys, num_restarts);
+  result.reserve(num_keys);
+  for (size_t i = 0; i != num_keys; ++i) {
+    result.push_back(VERIFY_RESULT(GetRestartKey(
+        static_cast<uint32_t>((2 * i + 1) * num_restarts / (2 * num_keys)))));
+  }
+  return result;
+}
 
+yb::Result<Slice> Block::GetRestartKey(uint32_t restart_idx) const {
   const auto entry_offset = DecodeFixed32(data_ + restart_offset_ + restart_idx * sizeof(uint32_t));
-  uint32_t shared, non_shared, value_length;
-  const char* key_ptr = DecodeEntry(
-      data_ + entry_offset, data_ + restart_offset_, &shared, &non_shared, &value_length);
-  if (key_ptr == nullptr || (shared != 0)) {
+  Slice key;
+  if (!DecodeRestartEntryKey(
+          data_ + entry_offset, data_ + restart_offset_, key_value_encoding_format_, &key)) {
     return BadEntryInBlockError();
   }
-  return Slice(key_ptr, non_shared);
+  return key;
 }
 
 }  // namespace rocksdb
@@ -30,6 +30,8 @@
 #include <malloc.h>
 #endif
 
+#include <vector>
+
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/db/dbformat.h"
@@ -46,6 +48,12 @@ class BlockIter;
 class BlockHashIndex;
 class BlockPrefixIndex;
 
+// Hash index stored inside data block, see block_internal.h for its format.
+struct DataBlockHashIndex {
+  const uint8_t* buckets = nullptr;
+  uint32_t num_buckets = 0;
+};
+
 class Block {
  public:
   // Initialize the block with the specified contents.
@@ -65,6 +73,9 @@ class Block {
     return size_;
   }
   uint32_t NumRestarts() const;
+  KeyValueEncodingFormat key_value_encoding_format() const {
+    return key_value_encoding_format_;
+  }
   CompressionType compression_type() const {
     return contents_.compression_type;
   }
@@ -82,9 +93,13 @@ class Block {
   // If total_order_seek is true, hash_index_ and prefix_index_ are ignored.
   // This option only applies for index block. For data block, hash_index_
   // and prefix_index_ are null, so this option does not matter.
+  //
+  // If hash_key_extractor is not null and the block has data block hash index, it is used to seek
+  // in the block. Hash index preserves total order seek semantics.
   InternalIterator* NewIterator(const Comparator* comparator,
                                 BlockIter* iter = nullptr,
-                                bool total_order_seek = true);
+                                bool total_order_seek = true,
+                                const DataBlockHashKeyExtractor* hash_key_extractor = nullptr);
   void SetBlockHashIndex(BlockHashIndex* hash_index);
   void SetBlockPrefixIndex(BlockPrefixIndex* prefix_index);
 
@@ -95,13 +110,21 @@ class Block {
   // points description).
   yb::Result<Slice> GetMiddleKey() const;
 
+  // Returns up to max_keys restart keys from this block, evenly spread over the block and sorted.
+  yb::Result<std::vector<Slice>> GetSampleKeys(size_t max_keys) const;
+
  private:
+  yb::Result<Slice> GetRestartKey(uint32_t restart_idx) const;
+
   BlockContents contents_;
   const char* data_;            // contents_.data.data()
   size_t size_;                 // contents_.data.size()
   uint32_t restart_offset_;     // Offset in data_ of restart array
+  KeyValueEncodingFormat key_value_encoding_format_ =
+      KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
   std::unique_ptr<BlockHashIndex> hash_index_;
   std::unique_ptr<BlockPrefixIndex> prefix_index_;
+  DataBlockHashIndex data_block_hash_index_;
 
   // No copying allowed
   Block(const Block&);
@@ -113,6 +136,7 @@ class BlockIter : public InternalIterator {
   BlockIter()
       : comparator_(nullptr),
         data_(nullptr),
+        key_value_encoding_format_(KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix),
         restarts_(0),
         num_restarts_(0),
         current_(0),
@@ -121,17 +145,22 @@ class BlockIter : public InternalIterator {
         hash_index_(nullptr),
         prefix_index_(nullptr) {}
 
-  BlockIter(const Comparator* comparator, const char* data, uint32_t restarts,
+  BlockIter(const Comparator* comparator, const char* data,
+       KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts,
        uint32_t num_restarts, BlockHashIndex* hash_index,
-       BlockPrefixIndex* prefix_index)
+       BlockPrefixIndex* prefix_index, const DataBlockHashIndex& data_block_hash_index,
+       const DataBlockHashKeyExtractor* hash_key_extractor)
       : BlockIter() {
-    Initialize(comparator, data, restarts, num_restarts,
-        hash_index, prefix_index);
+    Initialize(comparator, data, key_value_encoding_format, restarts, num_restarts,
+        hash_index, prefix_index, data_block_hash_index, hash_key_extractor);
   }
 
+  // hash_key_extractor could be nullptr, data block hash index is not used in this case.
   void Initialize(const Comparator* comparator, const char* data,
+      KeyValueEncodingFormat key_value_encoding_format,
       uint32_t restarts, uint32_t num_restarts, BlockHashIndex* hash_index,
-      BlockPrefixIndex* prefix_index);
+      BlockPrefixIndex* prefix_index, const DataBlockHashIndex& data_block_hash_index,
+      const DataBlockHashKeyExtractor* hash_key_extractor);
 
   void SetStatus(Status s) {
     status_ = s;
@@ -173,6 +202,7 @@ class BlockIter : public InternalIterator {
  private:
   const Comparator* comparator_;
   const char* data_;       // underlying block contents
+  KeyValueEncodingFormat key_value_encoding_format_;
   uint32_t restarts_;      // Offset of restart array (list of fixed32)
   uint32_t num_restarts_;  // Number of uint32_t entries in restart array
 
@@ -180,10 +210,16 @@ class BlockIter : public InternalIterator {
   uint32_t current_;
   uint32_t restart_index_;  // Index of restart block in which current_ falls
   IterKey key_;
+  // Size of the key_ suffix for kKeyDeltaEncodingSharedPrefixAndSuffix format.
+  uint32_t key_suffix_size_ = 0;
+  // Buffer used to decode key suffix.
+  std::string suffix_buffer_;
   Slice value_;
   Status status_;
   BlockHashIndex* hash_index_;
   BlockPrefixIndex* prefix_index_;
+  DataBlockHashIndex data_block_hash_index_;
+  const DataBlockHashKeyExtractor* hash_key_extractor_ = nullptr;
 
   inline int Compare(const Slice& a, const Slice& b) const {
     return comparator_->Compare(a, b);
@@ -202,6 +238,7 @@ class BlockIter : public InternalIterator {
 
   void SeekToRestartPoint(uint32_t index) {
     key_.Clear();
+    key_suffix_size_ = 0;
     restart_index_ = index;
     // current_ will be fixed by ParseNextKey();
 
@@ -214,6 +251,9 @@ class BlockIter : public InternalIterator {
 
   bool ParseNextKey();
 
+  // Decodes key of the entry at the specified restart point. Returns false in case of corruption.
+  bool DecodeRestartKey(uint32_t index, Slice* key);
+
   bool BinarySeek(const Slice& target, uint32_t left, uint32_t right,
                   uint32_t* index);
 
@@ -227,6 +267,10 @@ class BlockIter : public InternalIterator {
 
   bool PrefixSeek(const Slice& target, uint32_t* index);
 
+  // Positions iterator at the first key >= target using data block hash index. Returns false if
+  // hash index could not be used for the target, so binary search should be used instead.
+  bool DataBlockHashSeek(const Slice& target);
+
 };
 
 }  // namespace rocksdb
@@ -110,7 +110,8 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
-                    std::string* compressed_output) {
+                    std::string* compressed_output,
+                    const CompressionDict* compression_dict = nullptr) {
   if (*type == kNoCompression) {
     return raw;
   }
@@ -163,7 +164,7 @@ Slice CompressBlock(const Slice& raw,
       break;     // fall back to no compression.
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -289,6 +290,8 @@ struct BlockBasedTableBuilder::Rep {
   std::string last_filter_key;
   const CompressionType compression_type;
   const CompressionOptions compression_opts;
+  // Dictionary used to compress data blocks, null when they are compressed without dictionary.
+  const std::unique_ptr<CompressionDict> compression_dict;
   TableProperties props;
 
   bool closed = false;  // Either Finish() or Abandon() has been called.
@@ -312,7 +315,8 @@ struct BlockBasedTableBuilder::Rep {
       WritableFileWriter* data_file,
       const CompressionType _compression_type,
       const CompressionOptions& _compression_opts,
-      const bool skip_filters);
+      const bool skip_filters,
+      const std::string* _compression_dict);
 
   bool is_split_sst() const { return data_writer != metadata_writer; }
 };
@@ -331,6 +335,11 @@ Status BlockBasedTableBuilder::BlockBasedTablePropertiesCollector::Finish(
   val.clear();
   PutFixed32(&val, rep_->data_index_builder->NumLevels());
   properties->emplace(BlockBasedTablePropertyNames::kNumIndexLevels, val);
+  const auto& hash_key_extractor = rep_->table_options.data_block_hash_key_extractor;
+  if (hash_key_extractor) {
+    properties->emplace(
+        BlockBasedTablePropertyNames::kDataBlockHashKeyExtractor, hash_key_extractor->Name());
+  }
   return Status::OK();
 }
 
@@ -344,7 +353,8 @@ BlockBasedTableBuilder::Rep::Rep(
     WritableFileWriter* data_file,
     const CompressionType _compression_type,
     const CompressionOptions& _compression_opts,
-    const bool skip_filters)
+    const bool skip_filters,
+    const std::string* _compression_dict)
     : ioptions(_ioptions),
       table_options(table_opt),
       internal_comparator(icomparator),
@@ -352,7 +362,11 @@ BlockBasedTableBuilder::Rep::Rep(
       filter_block_builder(skip_filters ? nullptr : CreateFilterBlockBuilder(
           _ioptions, table_options, filter_type)),
       data_block_builder(table_options.block_restart_interval,
-                 table_options.use_delta_encoding),
+                 table_options.use_delta_encoding,
+                 table_options.data_block_key_value_encoding_format,
+                 table_options.data_block_key_suffix_extractor.get(),
+                 table_options.data_block_hash_key_extractor.get(),
+                 table_options.data_block_hash_table_util_ratio),
       internal_prefix_transform(_ioptions.prefix_extractor),
       filter_key_transformer(table_opt.filter_policy ?
           table_opt.filter_policy->GetKeyTransformer() : nullptr),
@@ -368,6 +382,9 @@ BlockBasedTableBuilder::Rep::Rep(
               nullptr /* prefix_extractor */, table_options)),
       compression_type(_compression_type),
       compression_opts(_compression_opts),
+      compression_dict(_compression_dict && !_compression_dict->empty()
+          ? std::make_unique<CompressionDict>(*_compression_dict, _compression_opts.level)
+          : nullptr),
       flush_block_policy(
           table_options.flush_block_policy_factory->NewFlushBlockPolicy(
               table_options, data_block_builder)) {
@@ -404,7 +421,8 @@ BlockBasedTableBuilder::BlockBasedTableBuilder(
     WritableFileWriter* data_file,
     const CompressionType compression_type,
     const CompressionOptions& compression_opts,
-    const bool skip_filters) {
+    const bool skip_filters,
+    const std::string* compression_dict) {
   BlockBasedTableOptions sanitized_table_options(table_options);
   if (sanitized_table_options.format_version == 0 &&
       sanitized_table_options.checksum != kCRC32c) {
@@ -418,7 +436,7 @@ BlockBasedTableBuilder::BlockBasedTableBuilder(
 
   rep_ = new Rep(ioptions, sanitized_table_options, internal_comparator,
                  int_tbl_prop_collector_factories, column_family_id, metadata_file, data_file,
-                 compression_type, compression_opts, skip_filters);
+                 compression_type, compression_opts, skip_filters, compression_dict);
 
   if (rep_->filter_block_builder != nullptr) {
     rep_->filter_block_builder->StartBlock(0);
@@ -490,7 +508,7 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
 
   if (!r->data_block_builder.empty()) {
     data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+        r->data_writer.get(), r->compression_dict.get());
   }
   if (!ok()) return;
 
@@ -563,15 +581,17 @@ void BlockBasedTableBuilder::FlushFilterBlock(const Slice& next_block_first_key)
 
 size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
-  size_t block_size = WriteBlock(block->Finish(), handle, writer_info);
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const CompressionDict* compression_dict) {
+  size_t block_size = WriteBlock(block->Finish(), handle, writer_info, compression_dict);
   block->Reset();
   return block_size;
 }
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const CompressionDict* compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -584,7 +604,7 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, &r->compressed_output, compression_dict);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -731,6 +751,14 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && r->compression_dict) {
+    // Dictionary is stored uncompressed, since it is needed to uncompress data blocks.
+    BlockHandle compression_dict_block_handle;
+    WriteRawBlock(r->compression_dict->raw(), kNoCompression, &compression_dict_block_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(kCompressionDictBlock, compression_dict_block_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
@@ -38,6 +38,7 @@
 namespace rocksdb {
 
 class BlockBuilder;
+class CompressionDict;
 class BlockHandle;
 class WritableFile;
 struct BlockBasedTableOptions;
@@ -58,7 +59,8 @@ class BlockBasedTableBuilder : public TableBuilder {
       uint32_t column_family_id, WritableFileWriter* metadata_file,
       WritableFileWriter* data_file,
       const CompressionType compression_type,
-      const CompressionOptions& compression_opts, const bool skip_filters);
+      const CompressionOptions& compression_opts, const bool skip_filters,
+      const std::string* compression_dict = nullptr);
 
   // REQUIRES: Either Finish() or Abandon() has been called.
   ~BlockBasedTableBuilder();
@@ -108,11 +110,14 @@ class BlockBasedTableBuilder : public TableBuilder {
   bool ok() const { return status().ok(); }
   // Call block's Finish() method and then write the finalize block contents to
   // file. Returns number of bytes written to file.
+  // Block is compressed using compression_dict, when it is not null.
   size_t WriteBlock(BlockBuilder* block, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const CompressionDict* compression_dict = nullptr);
   // Directly write block content to the file. Returns number of bytes written to file.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const CompressionDict* compression_dict = nullptr);
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
       FileWriterWithOffsetAndCachePrefix* writer_info);
   Status InsertBlockInCache(const Slice& block_contents,
@@ -31,6 +31,7 @@
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/flush_block_policy.h"
 #include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/table/block_based_table_builder.h"
 #include "yb/rocksdb/table/block_based_table_reader.h"
 #include "yb/rocksdb/table/format.h"
@@ -97,7 +98,8 @@ TableBuilder* BlockBasedTableFactory::NewTableBuilder(
       data_file,
       table_builder_options.compression_type,
       table_builder_options.compression_opts,
-      table_builder_options.skip_filters);
+      table_builder_options.skip_filters,
+      table_builder_options.compression_dict);
 
   return table_builder;
 }
@@ -165,6 +167,24 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
              table_options_.block_cache_compressed->GetCapacity());
     ret.append(buffer);
   }
+  snprintf(buffer, kBufferSize, "  index_and_filter_block_cache: %p\n",
+           table_options_.index_and_filter_block_cache.get());
+  ret.append(buffer);
+  if (table_options_.index_and_filter_block_cache) {
+    snprintf(buffer, kBufferSize,
+             "  index_and_filter_block_cache_size: %" ROCKSDB_PRIszt "\n",
+             table_options_.index_and_filter_block_cache->GetCapacity());
+    ret.append(buffer);
+  }
+  snprintf(buffer, kBufferSize, "  persistent_cache: %p\n",
+           table_options_.persistent_cache.get());
+  ret.append(buffer);
+  if (table_options_.persistent_cache) {
+    snprintf(buffer, kBufferSize,
+             "  persistent_cache_size: %" ROCKSDB_PRIszt "\n",
+             table_options_.persistent_cache->GetCapacity());
+    ret.append(buffer);
+  }
   snprintf(buffer, kBufferSize, "  block_size: %" ROCKSDB_PRIszt "\n",
            table_options_.block_size);
   ret.append(buffer);
@@ -177,6 +197,23 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
   snprintf(buffer, kBufferSize, "  index_block_restart_interval: %d\n",
            table_options_.index_block_restart_interval);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  max_auto_readahead_size: %" ROCKSDB_PRIszt "\n",
+           table_options_.max_auto_readahead_size);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_key_value_encoding_format: %s\n",
+           ToCString(table_options_.data_block_key_value_encoding_format));
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_key_suffix_extractor: %s\n",
+           table_options_.data_block_key_suffix_extractor == nullptr ?
+             "nullptr" : table_options_.data_block_key_suffix_extractor->Name());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_hash_key_extractor: %s\n",
+           table_options_.data_block_hash_key_extractor == nullptr ?
+             "nullptr" : table_options_.data_block_hash_key_extractor->Name());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  data_block_hash_table_util_ratio: %f\n",
+           table_options_.data_block_hash_table_util_ratio);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  filter_policy: %s\n",
            table_options_.filter_policy == nullptr ?
              "nullptr" : table_options_.filter_policy->Name());
@@ -201,6 +238,15 @@ std::shared_ptr<TableAwareReadFileFilter> BlockBasedTableFactory::NewTableAwareR
   return std::make_shared<BloomFilterAwareFileFilter>(read_options, user_key);
 }
 
+std::shared_ptr<TableAwareReadFileFilter> BlockBasedTableFactory::NewTableAwareReadFileFilter(
+    const ReadOptions &read_options, const std::vector<Slice> &user_keys) const {
+  return std::make_shared<BloomFilterAwareFileFilter>(read_options, user_keys);
+}
+
+const FilterPolicy::KeyTransformer* BlockBasedTableFactory::GetFilterKeyTransformer() const {
+  return table_options_.filter_policy ? table_options_.filter_policy->GetKeyTransformer() : nullptr;
+}
+
 TableFactory* NewBlockBasedTableFactory(
     const BlockBasedTableOptions& _table_options) {
   return new BlockBasedTableFactory(_table_options);
@@ -214,6 +260,8 @@ const char BlockBasedTablePropertyNames::kWholeKeyFiltering[] =
     "rocksdb.block.based.table.whole.key.filtering";
 const char BlockBasedTablePropertyNames::kPrefixFiltering[] =
     "rocksdb.block.based.table.prefix.filtering";
+const char BlockBasedTablePropertyNames::kDataBlockHashKeyExtractor[] =
+    "rocksdb.block.based.table.data.block.hash.key.extractor";
 const char kHashIndexPrefixesBlock[] = "rocksdb.hashindex.prefixes";
 const char kHashIndexPrefixesMetadataBlock[] =
     "rocksdb.hashindex.metadata";
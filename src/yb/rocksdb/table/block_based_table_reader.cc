@@ -23,6 +23,8 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <utility>
 #include <cinttypes>
@@ -35,6 +37,7 @@
 #include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table_properties.h"
@@ -56,6 +59,7 @@
 #include "yb/rocksdb/table/two_level_iterator.h"
 
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/stop_watch.h"
@@ -149,6 +153,9 @@ struct BlockBasedTable::FileReaderWithCachePrefix {
   // Similar prefix, but for compressed blocks cache:
   block_based_table::CacheKeyPrefixBuffer compressed_cache_key_prefix;
 
+  // Similar prefix, but for persistent cache:
+  block_based_table::CacheKeyPrefixBuffer persistent_cache_key_prefix;
+
   explicit FileReaderWithCachePrefix(unique_ptr<RandomAccessFileReader>&& _reader) :
       reader(std::move(_reader)) {}
 };
@@ -200,6 +207,26 @@ struct BlockBasedTable::Rep {
     } else if (ioptions.mem_tracker) {
       mem_tracker = yb::MemTracker::FindOrCreateTracker("BlockBasedTable", ioptions.mem_tracker);
     }
+    if (mem_tracker) {
+      index_and_filter_mem_tracker = yb::MemTracker::FindOrCreateTracker(
+          "IndexAndFilter", mem_tracker);
+    }
+  }
+
+  // Returns cache for index and filter blocks. It is the block cache, unless separate cache for
+  // index and filter blocks is configured.
+  Cache* IndexAndFilterBlockCache() const {
+    return table_options.index_and_filter_block_cache
+        ? table_options.index_and_filter_block_cache.get() : table_options.block_cache.get();
+  }
+
+  Cache* GetBlockCache(BlockType block_type) const {
+    return block_type == BlockType::kIndex ? IndexAndFilterBlockCache()
+                                           : table_options.block_cache.get();
+  }
+
+  const yb::MemTrackerPtr& GetMemTracker(BlockType block_type) const {
+    return block_type == BlockType::kIndex ? index_and_filter_mem_tracker : mem_tracker;
   }
 
   const ImmutableCFOptions& ioptions;
@@ -232,18 +259,92 @@ struct BlockBasedTable::Rep {
   bool hash_index_allow_collision;
   bool whole_key_filtering;
   bool prefix_filtering;
+  // Extractor used for data block hash index, nullptr if hash index should not be used.
+  const DataBlockHashKeyExtractor* data_block_hash_key_extractor = nullptr;
   // TODO(kailiu) It is very ugly to use internal key in table, since table
   // module should not be relying on db module. However to make things easier
   // and compatible with existing code, we introduce a wrapper that allows
   // block to extract prefix without knowing if a key is internal or not.
   unique_ptr<SliceTransform> internal_prefix_transform;
   DataIndexLoadMode data_index_load_mode;
+  // Keep top level data index reader in data_index_reader instead of the cache.
+  bool pin_top_level_index = false;
   yb::MemTrackerPtr mem_tracker;
+  // Child of mem_tracker, that tracks memory of index and filter blocks.
+  yb::MemTrackerPtr index_and_filter_mem_tracker;
+  // Dictionary used to compress data blocks, null if it is not used.
+  std::unique_ptr<UncompressionDict> compression_dict;
+
+  const UncompressionDict* GetCompressionDict(BlockType block_type) const {
+    return block_type == BlockType::kData ? compression_dict.get() : nullptr;
+  }
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+// Detects sequential reads of adjacent data blocks by the iterator and prefetches the following
+// blocks with a single large read. Readahead size starts from kInitialReadaheadSize and is doubled
+// on each prefetch up to max_readahead_size, so short scans don't read too much extra data.
+// Prefetched blocks are not added to the block cache until the iterator actually reads them.
+class BlockBasedTable::DataBlockReadahead {
+ public:
+  // Number of sequential block reads after which readahead is started.
+  static constexpr size_t kMinSequentialReads = 2;
+  static constexpr size_t kInitialReadaheadSize = 256_KB;
+
+  explicit DataBlockReadahead(size_t max_readahead_size)
+      : max_readahead_size_(max_readahead_size) {
+    Reset();
+  }
+
+  // Should be called on each data block access, including block cache hits.
+  void BlockAccessed(const BlockHandle& handle) {
+    if (handle.offset() == next_block_offset_) {
+      ++num_sequential_reads_;
+    } else {
+      Reset();
+    }
+    next_block_offset_ = handle.offset() + handle.size() + kBlockTrailerSize;
+  }
+
+  // Should be called before reading the block from file. Returns the buffer that contains the
+  // block, or nullptr if block should be read from the file directly.
+  FilePrefetchBuffer* Prefetch(RandomAccessFileReader* reader, const BlockHandle& handle) {
+    if (num_sequential_reads_ < kMinSequentialReads) {
+      return nullptr;
+    }
+    const size_t block_size = handle.size() + kBlockTrailerSize;
+    if (buffer_.Contains(handle.offset(), block_size)) {
+      return &buffer_;
+    }
+    const auto status = buffer_.Prefetch(
+        reader, handle.offset(), std::max(readahead_size_, block_size));
+    if (!status.ok()) {
+      // Block will be read from the file directly, and the error reported there if any.
+      VLOG(1) << "Readahead failed for " << reader->file()->filename() << ": " << status;
+      return nullptr;
+    }
+    readahead_size_ = std::min(readahead_size_ * 2, max_readahead_size_);
+    return &buffer_;
+  }
+
+ private:
+  void Reset() {
+    num_sequential_reads_ = 0;
+    readahead_size_ = std::min(kInitialReadaheadSize, max_readahead_size_);
+  }
+
+  const size_t max_readahead_size_;
+  uint64_t next_block_offset_ = std::numeric_limits<uint64_t>::max();
+  size_t num_sequential_reads_;
+  size_t readahead_size_;
+  FilePrefetchBuffer buffer_;
+};
+
+constexpr size_t BlockBasedTable::DataBlockReadahead::kMinSequentialReads;
+constexpr size_t BlockBasedTable::DataBlockReadahead::kInitialReadaheadSize;
+
+// BlockEntryIteratorState is used as an adapter to BlockBasedTable. It is used by TwoLevelIterator
+// and MultiLevelIterator to call BlockBasedTable functions in order to check if prefix may match or
+// to create a secondary iterator. The only state it keeps is data block readahead of the iterator.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -253,10 +354,16 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         table_(table),
         read_options_(read_options),
         skip_filters_(skip_filters),
-        block_type_(block_type) {}
+        block_type_(block_type) {
+    const auto max_readahead_size = table->rep_->table_options.max_auto_readahead_size;
+    if (block_type == BlockType::kData && max_readahead_size > 0) {
+      readahead_ = std::make_unique<DataBlockReadahead>(max_readahead_size);
+    }
+  }
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
-    return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
+    return table_->NewDataBlockIterator(
+        read_options_, index_value, block_type_, nullptr /* input_iter */, readahead_.get());
   }
 
   bool PrefixMayMatch(const Slice& internal_key) override {
@@ -274,6 +381,7 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+  std::unique_ptr<DataBlockReadahead> readahead_;
 };
 
 
@@ -299,9 +407,12 @@ void BlockBasedTable::SetupCacheKeyPrefix(Rep* rep,
     FileReaderWithCachePrefix* reader_with_cache_prefix) {
   reader_with_cache_prefix->cache_key_prefix.size = 0;
   reader_with_cache_prefix->compressed_cache_key_prefix.size = 0;
-  if (rep->table_options.block_cache != nullptr) {
-    GenerateCachePrefix(rep->table_options.block_cache.get(),
-        reader_with_cache_prefix->reader->file(),
+  reader_with_cache_prefix->persistent_cache_key_prefix.size = 0;
+  // The same prefix is used for keys in the block cache and the index and filter block cache.
+  Cache* cache = rep->table_options.block_cache ? rep->table_options.block_cache.get()
+                                                : rep->IndexAndFilterBlockCache();
+  if (cache != nullptr) {
+    GenerateCachePrefix(cache, reader_with_cache_prefix->reader->file(),
         &reader_with_cache_prefix->cache_key_prefix);
   }
   if (rep->table_options.block_cache_compressed != nullptr) {
@@ -309,6 +420,11 @@ void BlockBasedTable::SetupCacheKeyPrefix(Rep* rep,
         reader_with_cache_prefix->reader->file(),
         &reader_with_cache_prefix->compressed_cache_key_prefix);
   }
+  if (rep->table_options.persistent_cache != nullptr) {
+    GenerateCachePrefix(rep->table_options.persistent_cache.get(),
+        reader_with_cache_prefix->reader->file(),
+        &reader_with_cache_prefix->persistent_cache_key_prefix);
+  }
 }
 
 BlockBasedTable::FileReaderWithCachePrefix* BlockBasedTable::GetBlockReader(BlockType block_type) {
@@ -323,22 +439,39 @@ BlockBasedTable::FileReaderWithCachePrefix* BlockBasedTable::GetBlockReader(Bloc
 
 BloomFilterAwareFileFilter::BloomFilterAwareFileFilter(
     const ReadOptions& read_options, const Slice& user_key)
-    : read_options_(read_options), user_key_(user_key.ToBuffer()) {}
+    : read_options_(read_options), user_keys_{user_key.ToBuffer()} {}
+
+BloomFilterAwareFileFilter::BloomFilterAwareFileFilter(
+    const ReadOptions& read_options, const std::vector<Slice>& user_keys)
+    : read_options_(read_options) {
+  user_keys_.reserve(user_keys.size());
+  for (const auto& user_key : user_keys) {
+    user_keys_.push_back(user_key.ToBuffer());
+  }
+}
 
 bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
   auto table = down_cast<BlockBasedTable*>(reader);
   if (table->rep_->filter_type == FilterType::kFixedSizeFilter) {
-    const auto filter_key = table->GetFilterKeyFromUserKey(user_key_);
-    auto filter_entry = table->GetFilter(read_options_.query_id,
-        read_options_.read_tier == kBlockCacheTier /* no_io */, &filter_key);
-    FilterBlockReader* filter = filter_entry.value;
-    // If bloom filter was not useful, then take this file into account.
-    const bool use_file = table->NonBlockBasedFilterKeyMayMatch(filter, filter_key);
+    bool use_file = false;
+    // Fixed-size filter block depends on the key, so it is looked up for each key. The file is
+    // taken into account as soon as one of the keys may match.
+    for (const auto& user_key : user_keys_) {
+      const auto filter_key = table->GetFilterKeyFromUserKey(user_key);
+      auto filter_entry = table->GetFilter(read_options_.query_id,
+          read_options_.read_tier == kBlockCacheTier /* no_io */, &filter_key);
+      FilterBlockReader* filter = filter_entry.value;
+      // If bloom filter was not useful, then take this file into account.
+      use_file = table->NonBlockBasedFilterKeyMayMatch(filter, filter_key);
+      filter_entry.Release(table->rep_->IndexAndFilterBlockCache());
+      if (use_file) {
+        break;
+      }
+    }
     if (!use_file) {
       // Record that the bloom filter was useful.
       RecordTick(table->rep_->ioptions.statistics, BLOOM_FILTER_USEFUL);
     }
-    filter_entry.Release(table->rep_->table_options.block_cache.get());
     return use_file;
   } else {
     // For non fixed-size filters - take file into account. We are only using fixed-size bloom
@@ -348,6 +481,20 @@ bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
 }
 
 namespace {
+
+IndexType IndexTypeOnFile(const TableProperties* table_properties) {
+  // Some old version of block-based tables don't have index type present in
+  // table properties. If that's the case we can safely use the kBinarySearch.
+  if (table_properties) {
+    auto& props = table_properties->user_collected_properties;
+    auto pos = props.find(BlockBasedTablePropertyNames::kIndexType);
+    if (pos != props.end()) {
+      return static_cast<IndexType>(DecodeFixed32(pos->second.c_str()));
+    }
+  }
+  return IndexType::kBinarySearch;
+}
+
 // Return True if table_properties has `user_prop_name` has a `true` value
 // or it doesn't contain this property (for backward compatible).
 bool IsFeatureSupported(const TableProperties& table_properties,
@@ -409,12 +556,19 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->ReadPropertiesBlock(meta_iter.get()));
 
+  RETURN_NOT_OK(new_table->ReadCompressionDictBlock(meta_iter.get()));
+
+  // Top level of multi-level index is small, so it is kept by the table reader, when index and
+  // filter blocks have their own cache. So lookups in this file don't need to load it again.
+  rep->pin_top_level_index = table_options.index_and_filter_block_cache != nullptr &&
+      IndexTypeOnFile(rep->table_properties.get()) == IndexType::kMultiLevelBinarySearch;
+
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
     if (table_options.cache_index_and_filter_blocks) {
-      DCHECK_ONLY_NOTNULL(table_options.block_cache.get());
+      DCHECK_ONLY_NOTNULL(rep->IndexAndFilterBlockCache());
       // Hack: Call NewIndexIterator() to implicitly add index to the
       // block_cache
       unique_ptr<InternalIterator> iter(new_table->NewIndexIterator(ReadOptions::kDefault));
@@ -440,7 +594,7 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
     // Will use block cache for filter blocks access?
     if (table_options.cache_index_and_filter_blocks) {
-      assert(table_options.block_cache != nullptr);
+      assert(rep->IndexAndFilterBlockCache() != nullptr);
       bool corrupted_filter_type = true;
       switch (rep->filter_type) {
         case FilterType::kFullFilter:
@@ -448,7 +602,7 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
         case FilterType::kBlockBasedFilter: {
           // Hack: Call GetFilter() to implicitly add filter to the block_cache
           auto filter_entry = new_table->GetFilter(kDefaultQueryId);
-          filter_entry.Release(table_options.block_cache.get());
+          filter_entry.Release(rep->IndexAndFilterBlockCache());
           corrupted_filter_type = false;
           break;
         }
@@ -502,6 +656,20 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
   return Status::OK();
 }
 
+Status BlockBasedTable::ReadCompressionDictBlock(InternalIterator* meta_iter) {
+  BlockHandle handle;
+  if (!FindMetaBlock(meta_iter, kCompressionDictBlock, &handle).ok()) {
+    // File was written without dictionary.
+    return Status::OK();
+  }
+  BlockContents contents;
+  RETURN_NOT_OK(ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      handle, &contents, rep_->ioptions.env, rep_->mem_tracker, false /* do_uncompress */));
+  rep_->compression_dict = std::make_unique<UncompressionDict>(contents.data.ToBuffer());
+  return Status::OK();
+}
+
 Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
   // Read the properties
   bool found_properties_block = true;
@@ -544,6 +712,16 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
     rep_->prefix_filtering &= IsFeatureSupported(
         *(rep_->table_properties),
         BlockBasedTablePropertyNames::kPrefixFiltering, rep_->ioptions.info_log);
+
+    // Use data block hash index only if it was built with the same hash key extractor.
+    const auto& hash_key_extractor = rep_->table_options.data_block_hash_key_extractor;
+    if (hash_key_extractor) {
+      const auto& props = rep_->table_properties->user_collected_properties;
+      auto pos = props.find(BlockBasedTablePropertyNames::kDataBlockHashKeyExtractor);
+      if (pos != props.end() && pos->second == hash_key_extractor->Name()) {
+        rep_->data_block_hash_key_extractor = hash_key_extractor.get();
+      }
+    }
   }
 
   return Status::OK();
@@ -734,7 +912,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* compression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -778,7 +957,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, compression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -806,7 +985,8 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* compression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -815,7 +995,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, compression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -865,7 +1045,7 @@ Status BlockBasedTable::CreateFilterIndexReader(std::unique_ptr<IndexReader>* fi
   auto env = rep_->ioptions.env;
   auto footer = rep_->footer;
   return BinarySearchIndexReader::Create(base_file_reader, footer, rep_->filter_handle, env,
-      SharedBytewiseComparator(), filter_index_reader, rep_->mem_tracker);
+      SharedBytewiseComparator(), filter_index_reader, rep_->index_and_filter_mem_tracker);
 }
 
 FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_handle, Rep* rep,
@@ -878,7 +1058,8 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
   BlockContents block;
   if (!ReadBlockContents(
            rep->base_reader_with_cache_prefix->reader.get(), rep->footer, ReadOptions::kDefault,
-           filter_handle, &block, rep->ioptions.env, rep->mem_tracker, false).ok()) {
+           filter_handle, &block, rep->ioptions.env, rep->index_and_filter_mem_tracker,
+           false).ok()) {
     // Error reading the block
     return nullptr;
   }
@@ -969,7 +1150,7 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
 
   PERF_TIMER_GUARD(read_filter_block_nanos);
 
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = rep_->IndexAndFilterBlockCache();
   if (rep_->filter_policy == nullptr /* do not use filter */ ||
       block_cache == nullptr /* no block cache at all */) {
     // If we get here, we have:
@@ -1065,10 +1246,11 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
   PERF_TIMER_GUARD(read_index_block_nanos);
 
   const bool no_io = read_options.read_tier == kBlockCacheTier;
-  Cache* const block_cache = rep_->table_options.block_cache.get();
+  Cache* const block_cache = rep_->IndexAndFilterBlockCache();
 
-  if (block_cache && (rep_->data_index_load_mode == DataIndexLoadMode::USE_CACHE ||
-      rep_->table_options.cache_index_and_filter_blocks)) {
+  if (block_cache && !rep_->pin_top_level_index &&
+      (rep_->data_index_load_mode == DataIndexLoadMode::USE_CACHE ||
+       rep_->table_options.cache_index_and_filter_blocks)) {
     char cache_key[block_based_table::kCacheKeyBufferSize];
     auto key = GetCacheKey(rep_->base_reader_with_cache_prefix->cache_key_prefix,
         rep_->footer.index_handle(), cache_key);
@@ -1130,7 +1312,7 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
   if (index_reader_result->cache_handle) {
     auto iter = new_iter ? new_iter : input_iter;
     iter->RegisterCleanup(
-        &ReleaseCachedEntry, rep_->table_options.block_cache.get(),
+        &ReleaseCachedEntry, rep_->IndexAndFilterBlockCache(),
         index_reader_result->cache_handle);
   }
 
@@ -1142,13 +1324,16 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
 // If input_iter is null, new a iterator
 // If input_iter is not null, update this iter and return it
 InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
-    const Slice& index_value, BlockType block_type, BlockIter* input_iter) {
+    const Slice& index_value, BlockType block_type, BlockIter* input_iter,
+    DataBlockReadahead* readahead) {
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
   const bool no_io = (ro.read_tier == kBlockCacheTier);
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = rep_->GetBlockCache(block_type);
   Cache* block_cache_compressed =
       rep_->table_options.block_cache_compressed.get();
+  const auto& mem_tracker = rep_->GetMemTracker(block_type);
+  const auto* compression_dict = rep_->GetCompressionDict(block_type);
   CachableEntry<Block> block;
 
   BlockHandle handle;
@@ -1167,6 +1352,17 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  if (readahead != nullptr) {
+    readahead->BlockAccessed(handle);
+  }
+
+  PersistentCache* persistent_cache = rep_->table_options.persistent_cache.get();
+  char persistent_cache_key_buffer[block_based_table::kCacheKeyBufferSize];
+  Slice persistent_cache_key;
+  if (persistent_cache != nullptr) {
+    persistent_cache_key = GetCacheKey(
+        reader->persistent_cache_key_prefix, handle, persistent_cache_key_buffer);
+  }
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
@@ -1187,7 +1383,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, mem_tracker, compression_dict);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1195,13 +1391,16 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            mem_tracker, block_cache_compressed == nullptr, persistent_cache,
+            persistent_cache_key, compression_dict,
+            readahead ? readahead->Prefetch(reader->reader.get(), handle) : nullptr);
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, mem_tracker,
+                                compression_dict);
       }
     }
   }
@@ -1220,7 +1419,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        mem_tracker, true /* do_uncompress */, persistent_cache, persistent_cache_key,
+        compression_dict,
+        readahead ? readahead->Prefetch(reader->reader.get(), handle) : nullptr);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1228,7 +1429,9 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
   InternalIterator* iter;
   if (s.ok() && block.value != nullptr) {
-    iter = block.value->NewIterator(rep_->comparator.get(), input_iter);
+    iter = block.value->NewIterator(
+        rep_->comparator.get(), input_iter, true /* total_order_seek */,
+        rep_->data_block_hash_key_extractor);
     if (block.cache_handle != nullptr) {
       iter->RegisterCleanup(&ReleaseCachedEntry, block_cache,
           block.cache_handle);
@@ -1340,7 +1543,7 @@ bool BlockBasedTable::PrefixMayMatch(const Slice& internal_key) {
     RecordTick(statistics, BLOOM_FILTER_PREFIX_USEFUL);
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(rep_->IndexAndFilterBlockCache());
   return may_match;
 }
 
@@ -1460,7 +1663,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
     }
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(rep_->IndexAndFilterBlockCache());
   return s;
 }
 
@@ -1544,17 +1747,7 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
 //  5. index_type
 Status BlockBasedTable::CreateDataBlockIndexReader(
     std::unique_ptr<IndexReader>* index_reader, InternalIterator* preloaded_meta_index_iter) {
-  // Some old version of block-based tables don't have index type present in
-  // table properties. If that's the case we can safely use the kBinarySearch.
-  auto index_type_on_file = IndexType::kBinarySearch;
-  if (rep_->table_properties) {
-    auto& props = rep_->table_properties->user_collected_properties;
-    auto pos = props.find(BlockBasedTablePropertyNames::kIndexType);
-    if (pos != props.end()) {
-      index_type_on_file = static_cast<IndexType>(
-          DecodeFixed32(pos->second.c_str()));
-    }
-  }
+  auto index_type_on_file = IndexTypeOnFile(rep_->table_properties.get());
 
   auto file = rep_->base_reader_with_cache_prefix->reader.get();
   auto env = rep_->ioptions.env;
@@ -1573,7 +1766,8 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
   switch (index_type_on_file) {
     case IndexType::kBinarySearch: {
       return BinarySearchIndexReader::Create(
-          file, footer, footer.index_handle(), env, comparator, index_reader, rep_->mem_tracker);
+          file, footer, footer.index_handle(), env, comparator, index_reader,
+          rep_->index_and_filter_mem_tracker);
     }
     case IndexType::kHashSearch: {
       std::unique_ptr<Block> meta_guard;
@@ -1588,7 +1782,8 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
               "Unable to read the metaindex block."
               " Fall back to binary search index.");
           return BinarySearchIndexReader::Create(
-            file, footer, footer.index_handle(), env, comparator, index_reader, rep_->mem_tracker);
+            file, footer, footer.index_handle(), env, comparator, index_reader,
+          rep_->index_and_filter_mem_tracker);
         }
         meta_index_iter = meta_iter_guard.get();
       }
@@ -1600,7 +1795,7 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
       return HashIndexReader::Create(
           rep_->internal_prefix_transform.get(), footer, file, env, comparator,
           footer.index_handle(), meta_index_iter, index_reader,
-          rep_->hash_index_allow_collision, rep_->mem_tracker);
+          rep_->hash_index_allow_collision, rep_->index_and_filter_mem_tracker);
     }
     case IndexType::kMultiLevelBinarySearch: {
       auto& props = DCHECK_NOTNULL(rep_->table_properties.get())->user_collected_properties;
@@ -1612,7 +1807,8 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
       }
       int num_levels = DecodeFixed32(pos->second.c_str());
       auto result = MultiLevelIndexReader::Create(
-          file, footer, num_levels, footer.index_handle(), env, comparator, rep_->mem_tracker);
+          file, footer, num_levels, footer.index_handle(), env, comparator,
+          rep_->index_and_filter_mem_tracker);
       RETURN_NOT_OK(result);
       *index_reader = std::move(*result);
       return Status::OK();
@@ -1692,6 +1888,10 @@ Status BlockBasedTable::DumpTable(WritableFile* out_file) {
         RETURN_NOT_OK(out_file->Append("  Properties block handle: "));
         RETURN_NOT_OK(out_file->Append(meta_iter->value().ToString(true).c_str()));
         RETURN_NOT_OK(out_file->Append("\n"));
+      } else if (meta_iter->key() == rocksdb::kCompressionDictBlock) {
+        RETURN_NOT_OK(out_file->Append("  Compression dictionary block handle: "));
+        RETURN_NOT_OK(out_file->Append(meta_iter->value().ToString(true).c_str()));
+        RETURN_NOT_OK(out_file->Append("\n"));
       } else if (strstr(meta_iter->key().ToString().c_str(),
                         "filter.rocksdb.") != nullptr) {
         RETURN_NOT_OK(out_file->Append("  Filter block handle: "));
@@ -1890,7 +2090,7 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
 
   // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
   auto se = yb::ScopeExit([this, &index_reader] {
-    index_reader.Release(rep_->table_options.block_cache.get());
+    index_reader.Release(rep_->IndexAndFilterBlockCache());
   });
 
   const auto index_middle_key = VERIFY_RESULT(index_reader.value->GetMiddleKey());
@@ -1908,4 +2108,29 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
   return iter->key().ToBuffer();
 }
 
+yb::Result<std::vector<std::string>> BlockBasedTable::GetSampleKeys(size_t max_keys) {
+  auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
+  auto se = yb::ScopeExit([this, &index_reader] {
+    index_reader.Release(rep_->IndexAndFilterBlockCache());
+  });
+
+  const auto index_keys = VERIFY_RESULT(index_reader.value->GetSampleKeys(max_keys));
+  std::unique_ptr<InternalIterator> iter(
+      NewIterator(ReadOptions::kDefault, nullptr, /* skip_filters =*/ true));
+  // Keys from the index might be shortened, so use the first actual key after each of them.
+  std::vector<std::string> result;
+  result.reserve(index_keys.size());
+  for (const auto& index_key : index_keys) {
+    iter->Seek(index_key);
+    if (!iter->Valid()) {
+      break;
+    }
+    if (result.empty() || iter->key() != result.back()) {
+      result.push_back(iter->key().ToBuffer());
+    }
+  }
+  RETURN_NOT_OK(iter->status());
+  return result;
+}
+
 }  // namespace rocksdb
@@ -28,6 +28,7 @@
 #include <memory>
 #include <utility>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/statistics.h"
@@ -53,6 +54,7 @@ class InternalKeyComparator;
 class Iterator;
 class TableCache;
 class TableReader;
+class UncompressionDict;
 class WritableFile;
 struct BlockBasedTableOptions;
 struct EnvOptions;
@@ -85,16 +87,19 @@ YB_DEFINE_ENUM(BlockType, (kData)(kIndex));
 // the key and it should be used together with DocDbAwareFilterPolicy which only takes into account
 // hashed components of key for filtering.
 // BloomFilterAwareFileFilter ignores an SST file completely if there are no keys with the same
-// hashed components as the key specified in constructor.
+// hashed components as any of the keys specified in constructor.
 class BloomFilterAwareFileFilter : public TableAwareReadFileFilter {
  public:
   BloomFilterAwareFileFilter(const ReadOptions& read_options, const Slice& user_key);
+  BloomFilterAwareFileFilter(const ReadOptions& read_options, const std::vector<Slice>& user_keys);
 
   bool Filter(TableReader* reader) const override;
 
+  const std::vector<std::string>* UserKeys() const override { return &user_keys_; }
+
  private:
   const ReadOptions read_options_;
-  const std::string user_key_;
+  std::vector<std::string> user_keys_;
 };
 
 // A Table is a sorted map from strings to strings.  Tables are
@@ -102,6 +107,8 @@ class BloomFilterAwareFileFilter : public TableAwareReadFileFilter {
 // multiple threads without external synchronization.
 class BlockBasedTable : public TableReader {
  public:
+  class DataBlockReadahead;
+
   // No copying allowed
   explicit BlockBasedTable(const TableReader&) = delete;
   void operator=(const TableReader&) = delete;
@@ -181,14 +188,17 @@ class BlockBasedTable : public TableReader {
   CHECKED_STATUS DumpTable(WritableFile* out_file) override;
 
   // input_iter: if it is not null, update this one and return it as Iterator
+  // readahead: if it is not null, used to prefetch following blocks during sequential scan.
   InternalIterator* NewDataBlockIterator(
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
-      BlockIter* input_iter = nullptr);
+      BlockIter* input_iter = nullptr, DataBlockReadahead* readahead = nullptr);
 
   const ImmutableCFOptions& ioptions();
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) override;
+
   ~BlockBasedTable();
 
   bool TEST_filter_block_preloaded() const;
@@ -252,7 +262,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* compression_dict = nullptr);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -267,7 +278,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* compression_dict = nullptr);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -290,6 +302,9 @@ class BlockBasedTable : public TableReader {
 
   CHECKED_STATUS ReadPropertiesBlock(InternalIterator* meta_iter);
 
+  // Loads dictionary used to compress data blocks, if the file has it.
+  CHECKED_STATUS ReadCompressionDictBlock(InternalIterator* meta_iter);
+
   CHECKED_STATUS SetupFilter(InternalIterator* meta_iter);
 
   // Read the meta block from sst.
@@ -40,10 +40,26 @@
 //     value: char[value_length]
 // shared_bytes == 0 for restart points.
 //
+// In kKeyDeltaEncodingSharedPrefixAndSuffix format the key is split into prefix and suffix, and
+// an entry has the form:
+//     shared_bytes: varint32
+//     unshared_bytes: varint32
+//     value_length: varint32
+//     suffix_shared_bytes: varint32
+//     suffix_unshared_bytes: varint32
+//     key_delta: char[unshared_bytes]
+//     suffix_delta: char[suffix_unshared_bytes]
+//     value: char[value_length]
+// Here shared_bytes is counted against the prefix of the previous key and suffix_shared_bytes
+// against its suffix. Both are 0 for restart points, so the whole key is stored contiguously there.
+//
 // The trailer of the block has the form:
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+// Key value encoding format is stored in the highest bits of num_restarts, see block_internal.h.
+// Optional data block hash index is stored between restarts and num_restarts, see
+// block_internal.h for its format.
 
 #include "yb/rocksdb/table/block_builder.h"
 
@@ -53,13 +69,39 @@
 
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/table/block_internal.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
 
 namespace rocksdb {
 
-BlockBuilder::BlockBuilder(int block_restart_interval, bool use_delta_encoding)
+namespace {
+
+// Sequence number and value type of internal key.
+constexpr size_t kInternalKeyFooterSize = sizeof(uint64_t);
+
+size_t SharedPrefixSize(const Slice& lhs, const Slice& rhs) {
+  const size_t min_length = std::min(lhs.size(), rhs.size());
+  size_t shared = 0;
+  while (shared < min_length && lhs[shared] == rhs[shared]) {
+    shared++;
+  }
+  return shared;
+}
+
+} // namespace
+
+BlockBuilder::BlockBuilder(
+    int block_restart_interval, bool use_delta_encoding,
+    KeyValueEncodingFormat key_value_encoding_format,
+    const KeySuffixExtractor* key_suffix_extractor,
+    const DataBlockHashKeyExtractor* hash_key_extractor, double hash_table_util_ratio)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
+      key_value_encoding_format_(key_value_encoding_format),
+      key_suffix_extractor_(key_suffix_extractor),
+      hash_key_extractor_(hash_key_extractor),
+      hash_table_util_ratio_(hash_table_util_ratio > 0 ? hash_table_util_ratio : 1.0),
       restarts_(),
       counter_(0),
       finished_(false) {
@@ -74,6 +116,9 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  last_key_suffix_size_ = 0;
+  hash_index_entries_.clear();
+  last_hash_key_.clear();
 }
 
 size_t BlockBuilder::CurrentSizeEstimate() const {
@@ -82,6 +127,10 @@ size_t BlockBuilder::CurrentSizeEstimate() const {
     // Restarts haven't been flushed to buffer yet.
     size += restarts_.size() * sizeof(uint32_t) +    // Restart array.
             sizeof(uint32_t);                        // Restart array length.
+    const size_t num_buckets = NumHashIndexBuckets();
+    if (num_buckets != 0) {
+      size += num_buckets + sizeof(uint32_t);        // Hash index.
+    }
   }
   return size;
 }
@@ -97,6 +146,10 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key, const Slice& value)
   estimate += sizeof(int32_t); // varint for shared prefix length.
   estimate += VarintLength(key.size()); // varint for key length.
   estimate += VarintLength(value.size()); // varint for value length.
+  if (key_value_encoding_format_ ==
+          KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix) {
+    estimate += 2; // varints for suffix lengths.
+  }
 
   return estimate;
 }
@@ -110,27 +163,81 @@ Slice BlockBuilder::Finish() {
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
-  PutFixed32(&buffer_, static_cast<uint32_t>(restarts_.size()));
+  const size_t num_buckets = NumHashIndexBuckets();
+  if (num_buckets != 0) {
+    AppendHashIndex(num_buckets);
+  }
+  PutFixed32(&buffer_, PackNumRestarts(
+      restarts_.size(), key_value_encoding_format_, num_buckets != 0));
   finished_ = true;
   return Slice(buffer_);
 }
 
 void BlockBuilder::Add(const Slice& key, const Slice& value) {
-  Slice last_key_piece(last_key_);
   assert(!finished_);
   assert(counter_ <= block_restart_interval_);
-  size_t shared = 0;  // number of bytes shared with prev key
+  bool use_delta_encoding = use_delta_encoding_;
   if (counter_ >= block_restart_interval_) {
     // Restart compression
     restarts_.push_back(static_cast<uint32_t>(buffer_.size()));
     counter_ = 0;
-  } else if (use_delta_encoding_) {
-    // See how much sharing to do with previous string
-    const size_t min_length = std::min(last_key_piece.size(), key.size());
-    while ((shared < min_length) && (last_key_piece[shared] == key[shared])) {
-      shared++;
+    use_delta_encoding = false;
+  }
+  switch (key_value_encoding_format_) {
+    case KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix:
+      AddWithSharedPrefix(key, value, use_delta_encoding);
+      break;
+    case KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix:
+      AddWithSharedPrefixAndSuffix(key, value, use_delta_encoding);
+      break;
+  }
+  if (hash_key_extractor_ != nullptr) {
+    AddToHashIndex(key);
+  }
+  counter_++;
+}
+
+void BlockBuilder::AddToHashIndex(const Slice& key) {
+  if (key.size() < kInternalKeyFooterSize) {
+    return;
+  }
+  const Slice hash_key = hash_key_extractor_->HashKey(
+      Slice(key.cdata(), key.size() - kInternalKeyFooterSize));
+  if (hash_key.empty() || hash_key == Slice(last_hash_key_)) {
+    // Keys with the same hash key go one after another, so only the first of them is indexed.
+    return;
+  }
+  last_hash_key_.assign(hash_key.cdata(), hash_key.size());
+  hash_index_entries_.emplace_back(
+      GetSliceHash(hash_key), static_cast<uint32_t>(restarts_.size() - 1));
+}
+
+size_t BlockBuilder::NumHashIndexBuckets() const {
+  if (hash_index_entries_.empty() || restarts_.size() > kDataBlockHashIndexMaxRestarts) {
+    return 0;
+  }
+  const auto num_buckets = static_cast<size_t>(hash_index_entries_.size() / hash_table_util_ratio_);
+  return std::max<size_t>(num_buckets, 1);
+}
+
+void BlockBuilder::AppendHashIndex(size_t num_buckets) {
+  std::vector<uint8_t> buckets(num_buckets, kDataBlockHashIndexNoEntry);
+  for (const auto& entry : hash_index_entries_) {
+    auto& bucket = buckets[entry.first % num_buckets];
+    if (bucket == kDataBlockHashIndexNoEntry) {
+      bucket = static_cast<uint8_t>(entry.second);
+    } else if (bucket != entry.second) {
+      bucket = kDataBlockHashIndexCollision;
     }
   }
+  buffer_.append(reinterpret_cast<const char*>(buckets.data()), buckets.size());
+  PutFixed32(&buffer_, static_cast<uint32_t>(num_buckets));
+}
+
+void BlockBuilder::AddWithSharedPrefix(
+    const Slice& key, const Slice& value, bool use_delta_encoding) {
+  // See how much sharing to do with previous string
+  const size_t shared = use_delta_encoding ? SharedPrefixSize(last_key_, key) : 0;
   const size_t non_shared = key.size() - shared;
 
   // Add "<shared><non_shared><value_size>" to buffer_
@@ -146,7 +253,51 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
   last_key_.resize(shared);
   last_key_.append(key.cdata() + shared, non_shared);
   assert(Slice(last_key_) == key);
-  counter_++;
+}
+
+size_t BlockBuilder::KeySuffixSize(const Slice& key) const {
+  if (key.size() < kInternalKeyFooterSize) {
+    return key.size();
+  }
+  // Internal key footer is always a part of suffix.
+  const size_t user_key_size = key.size() - kInternalKeyFooterSize;
+  if (key_suffix_extractor_ == nullptr) {
+    return kInternalKeyFooterSize;
+  }
+  const size_t user_key_suffix_size = key_suffix_extractor_->SuffixSize(
+      Slice(key.cdata(), user_key_size));
+  return kInternalKeyFooterSize + std::min(user_key_suffix_size, user_key_size);
+}
+
+void BlockBuilder::AddWithSharedPrefixAndSuffix(
+    const Slice& key, const Slice& value, bool use_delta_encoding) {
+  const size_t suffix_size = KeySuffixSize(key);
+  const Slice prefix(key.cdata(), key.size() - suffix_size);
+  const Slice suffix(prefix.cend(), suffix_size);
+
+  size_t shared = 0;
+  size_t suffix_shared = 0;
+  if (use_delta_encoding) {
+    const Slice last_prefix(last_key_.data(), last_key_.size() - last_key_suffix_size_);
+    const Slice last_suffix(last_prefix.cend(), last_key_suffix_size_);
+    shared = SharedPrefixSize(last_prefix, prefix);
+    suffix_shared = SharedPrefixSize(last_suffix, suffix);
+  }
+  const size_t non_shared = prefix.size() - shared;
+  const size_t suffix_non_shared = suffix.size() - suffix_shared;
+
+  PutVarint32(&buffer_, static_cast<uint32_t>(shared));
+  PutVarint32(&buffer_, static_cast<uint32_t>(non_shared));
+  PutVarint32(&buffer_, static_cast<uint32_t>(value.size()));
+  PutVarint32(&buffer_, static_cast<uint32_t>(suffix_shared));
+  PutVarint32(&buffer_, static_cast<uint32_t>(suffix_non_shared));
+
+  buffer_.append(prefix.cdata() + shared, non_shared);
+  buffer_.append(suffix.cdata() + suffix_shared, suffix_non_shared);
+  buffer_.append(value.cdata(), value.size());
+
+  last_key_.assign(key.cdata(), key.size());
+  last_key_suffix_size_ = suffix_size;
 }
 
 }  // namespace rocksdb
@@ -26,6 +26,9 @@
 
 #include <stdint.h>
 #include <vector>
+
+#include "yb/rocksdb/table.h"
+
 #include "yb/util/slice.h"
 
 namespace rocksdb {
@@ -35,8 +38,16 @@ class BlockBuilder {
   BlockBuilder(const BlockBuilder&) = delete;
   void operator=(const BlockBuilder&) = delete;
 
+  // key_suffix_extractor is used for kKeyDeltaEncodingSharedPrefixAndSuffix format only, and should
+  // outlive the builder. If hash_key_extractor is not nullptr, hash index is added to the block,
+  // keys should be internal keys in this case.
   explicit BlockBuilder(int block_restart_interval,
-                        bool use_delta_encoding = true);
+                        bool use_delta_encoding = true,
+                        KeyValueEncodingFormat key_value_encoding_format =
+                            KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix,
+                        const KeySuffixExtractor* key_suffix_extractor = nullptr,
+                        const DataBlockHashKeyExtractor* hash_key_extractor = nullptr,
+                        double hash_table_util_ratio = 0.75);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -65,14 +76,39 @@ class BlockBuilder {
   }
 
  private:
+  // When use_delta_encoding is false, the key is stored without sharing bytes with the previous
+  // key.
+  void AddWithSharedPrefix(const Slice& key, const Slice& value, bool use_delta_encoding);
+
+  void AddWithSharedPrefixAndSuffix(const Slice& key, const Slice& value, bool use_delta_encoding);
+
+  // Returns size of the key suffix for kKeyDeltaEncodingSharedPrefixAndSuffix format.
+  size_t KeySuffixSize(const Slice& key) const;
+
+  void AddToHashIndex(const Slice& key);
+
+  // Returns number of hash index buckets for the current number of hash keys, 0 if hash index
+  // should not be added to the block.
+  size_t NumHashIndexBuckets() const;
+
+  void AppendHashIndex(size_t num_buckets);
+
   const int          block_restart_interval_;
   const bool         use_delta_encoding_;
+  const KeyValueEncodingFormat key_value_encoding_format_;
+  const KeySuffixExtractor* const key_suffix_extractor_;
+  const DataBlockHashKeyExtractor* const hash_key_extractor_;
+  const double hash_table_util_ratio_;
 
   std::string           buffer_;    // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
   int                   counter_;   // Number of entries emitted since restart
   bool                  finished_;  // Has Finish() been called?
   std::string           last_key_;
+  size_t                last_key_suffix_size_ = 0;
+  // Hash of hash key and index of restart interval containing the first key with this hash key.
+  std::vector<std::pair<uint32_t, uint32_t>> hash_index_entries_;
+  std::string           last_hash_key_;
 };
 
 }  // namespace rocksdb
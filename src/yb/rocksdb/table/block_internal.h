@@ -0,0 +1,68 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_BLOCK_INTERNAL_H
+#define YB_ROCKSDB_TABLE_BLOCK_INTERNAL_H
+
+#include "yb/rocksdb/table.h"
+#include "yb/rocksdb/util/hash.h"
+
+#include "yb/util/logging.h"
+
+namespace rocksdb {
+
+// The last uint32 of the block stores the number of restarts in the lower bits, flag whether block
+// has hash index in kDataBlockHashIndexFlag bit, and the key value encoding format in the highest
+// kKeyValueEncodingFormatBits bits. Blocks in kKeyDeltaEncodingSharedPrefix format without hash
+// index have zeros there, so they have the same layout as before the format was introduced.
+// Readers that are not aware of the format detect such blocks as corrupted, because the number of
+// restarts does not fit the block.
+constexpr uint32_t kKeyValueEncodingFormatBits = 4;
+constexpr uint32_t kKeyValueEncodingFormatShift = 32 - kKeyValueEncodingFormatBits;
+constexpr uint32_t kDataBlockHashIndexFlag = 1u << (kKeyValueEncodingFormatShift - 1);
+constexpr uint32_t kNumRestartsMask = kDataBlockHashIndexFlag - 1;
+
+inline uint32_t PackNumRestarts(
+    size_t num_restarts, KeyValueEncodingFormat format, bool has_hash_index = false) {
+  DCHECK_LE(num_restarts, kNumRestartsMask);
+  return static_cast<uint32_t>(num_restarts) |
+         (has_hash_index ? kDataBlockHashIndexFlag : 0) |
+         (static_cast<uint32_t>(format) << kKeyValueEncodingFormatShift);
+}
+
+inline uint32_t UnpackNumRestarts(uint32_t packed) {
+  return packed & kNumRestartsMask;
+}
+
+inline bool UnpackHasHashIndex(uint32_t packed) {
+  return (packed & kDataBlockHashIndexFlag) != 0;
+}
+
+inline KeyValueEncodingFormat UnpackKeyValueEncodingFormat(uint32_t packed) {
+  return static_cast<KeyValueEncodingFormat>(packed >> kKeyValueEncodingFormatShift);
+}
+
+// Data block hash index is stored between restarts array and num_restarts:
+//     buckets: uint8[num_buckets]
+//     num_buckets: uint32
+// Hash key is mapped to the bucket GetSliceHash(hash_key) % num_buckets. Each bucket contains index
+// of the restart interval, that contains the first key with hash key mapped to the bucket, or one
+// of the special values below.
+constexpr uint8_t kDataBlockHashIndexNoEntry = 255;
+constexpr uint8_t kDataBlockHashIndexCollision = 254;
+// Hash index is not built for blocks with more restarts, since restart index should fit a bucket.
+constexpr size_t kDataBlockHashIndexMaxRestarts = kDataBlockHashIndexCollision;
+
+} // namespace rocksdb
+
+#endif // YB_ROCKSDB_TABLE_BLOCK_INTERNAL_H
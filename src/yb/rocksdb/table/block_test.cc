@@ -287,6 +287,214 @@ TEST_F(BlockTest, GetMiddleKey) {
   CheckMiddleKey(/* num_keys =*/ 16, block_restart_interval, /* expected_middle_key =*/ 8);
 }
 
+TEST_F(BlockTest, GetSampleKeys) {
+  constexpr int kNumKeys = 100;
+  BlockBuilder builder(/* block_restart_interval =*/ 10);
+  for (int i = 1; i <= kNumKeys; ++i) {
+    const auto padded_num = GetPaddedNum(i);
+    builder.Add("k" + padded_num, "v" + padded_num);
+  }
+  BlockContents contents;
+  contents.data = builder.Finish();
+  contents.cachable = false;
+  Block reader(std::move(contents));
+
+  auto keys = ASSERT_RESULT(reader.GetSampleKeys(/* max_keys =*/ 0));
+  ASSERT_TRUE(keys.empty());
+
+  keys = ASSERT_RESULT(reader.GetSampleKeys(/* max_keys =*/ 2));
+  ASSERT_EQ(2U, keys.size());
+  ASSERT_EQ("k" + GetPaddedNum(21), keys[0].ToBuffer());
+  ASSERT_EQ("k" + GetPaddedNum(71), keys[1].ToBuffer());
+
+  // There are only 10 restart keys in the block.
+  keys = ASSERT_RESULT(reader.GetSampleKeys(/* max_keys =*/ 20));
+  ASSERT_EQ(10U, keys.size());
+  for (int i = 0; i != 10; ++i) {
+    ASSERT_EQ("k" + GetPaddedNum(i * 10 + 1), keys[i].ToBuffer());
+  }
+}
+
+namespace {
+
+constexpr size_t kTestKeySuffixSize = 8;
+
+class FixedSizeKeySuffixExtractor : public KeySuffixExtractor {
+ public:
+  const char* Name() const override { return "FixedSizeKeySuffixExtractor"; }
+
+  size_t SuffixSize(const Slice&) const override { return kTestKeySuffixSize; }
+};
+
+// Generates keys similar to DocDB ones: several columns per row, that have the same time suffix
+// followed by internal key footer.
+std::vector<std::string> GenerateKeysWithSuffix(int num_rows, int num_columns) {
+  std::vector<std::string> keys;
+  for (int row = 0; row != num_rows; ++row) {
+    char suffix[kTestKeySuffixSize + 1];
+    snprintf(suffix, sizeof(suffix), "T%07d", 1000000 - row * 7);
+    for (int column = 0; column != num_columns; ++column) {
+      std::string key = GetPaddedNum(row) + static_cast<char>('a' + column) + suffix;
+      PutFixed64(&key, PackSequenceAndType(row * num_columns + column + 1, kTypeValue));
+      keys.push_back(std::move(key));
+    }
+  }
+  return keys;
+}
+
+} // namespace
+
+TEST_F(BlockTest, SharedPrefixAndSuffix) {
+  const auto keys = GenerateKeysWithSuffix(/* num_rows =*/ 1000, /* num_columns =*/ 4);
+  FixedSizeKeySuffixExtractor extractor;
+  BlockBuilder builder(
+      16, true /* use_delta_encoding */,
+      KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix, &extractor);
+  BlockBuilder shared_prefix_builder(16);
+  for (size_t i = 0; i != keys.size(); ++i) {
+    const auto value = std::to_string(i);
+    builder.Add(keys[i], value);
+    shared_prefix_builder.Add(keys[i], value);
+  }
+
+  const Slice raw_block = builder.Finish();
+  ASSERT_LT(raw_block.size(), shared_prefix_builder.Finish().size());
+
+  BlockContents contents;
+  contents.data = raw_block;
+  contents.cachable = false;
+  Block reader(std::move(contents));
+  ASSERT_EQ(KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix,
+            reader.key_value_encoding_format());
+
+  std::unique_ptr<InternalIterator> iter(reader.NewIterator(BytewiseComparator()));
+  size_t count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++count) {
+    ASSERT_LT(count, keys.size());
+    ASSERT_EQ(keys[count], iter->key().ToBuffer());
+    ASSERT_EQ(std::to_string(count), iter->value().ToBuffer());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(keys.size(), count);
+
+  for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+    --count;
+    ASSERT_EQ(keys[count], iter->key().ToBuffer());
+  }
+  ASSERT_EQ(0U, count);
+
+  Random rnd(301);
+  for (int i = 0; i != 1000; ++i) {
+    const auto index = rnd.Uniform(static_cast<int>(keys.size()));
+    iter->Seek(keys[index]);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(keys[index], iter->key().ToBuffer());
+    ASSERT_EQ(std::to_string(index), iter->value().ToBuffer());
+  }
+
+  const auto middle_key = ASSERT_RESULT(reader.GetMiddleKey());
+  ASSERT_EQ(keys[(keys.size() / 16 - 1) / 2 * 16], middle_key.ToBuffer());
+}
+
+namespace {
+
+constexpr size_t kTestRowSize = 10;
+
+// Uses row part of keys generated by GenerateKeysWithSuffix as hash key.
+class RowHashKeyExtractor : public DataBlockHashKeyExtractor {
+ public:
+  const char* Name() const override { return "RowHashKeyExtractor"; }
+
+  Slice HashKey(const Slice& user_key) const override {
+    return user_key.size() < kTestRowSize ? Slice() : Slice(user_key.data(), kTestRowSize);
+  }
+};
+
+std::string RowSeekKey(int row) {
+  std::string key = GetPaddedNum(row);
+  PutFixed64(&key, PackSequenceAndType(kMaxSequenceNumber, kValueTypeForSeek));
+  return key;
+}
+
+void TestDataBlockHashIndex(KeyValueEncodingFormat key_value_encoding_format) {
+  constexpr int kNumRows = 1000;
+  constexpr int kNumColumns = 4;
+  const auto all_keys = GenerateKeysWithSuffix(kNumRows, kNumColumns);
+  // Keep only even rows, so seeks to absent rows could be checked.
+  std::vector<std::string> keys;
+  for (size_t i = 0; i != all_keys.size(); ++i) {
+    if (i / kNumColumns % 2 == 0) {
+      keys.push_back(all_keys[i]);
+    }
+  }
+
+  FixedSizeKeySuffixExtractor suffix_extractor;
+  RowHashKeyExtractor hash_key_extractor;
+  BlockBuilder builder(
+      16, true /* use_delta_encoding */, key_value_encoding_format, &suffix_extractor,
+      &hash_key_extractor);
+  BlockBuilder builder_without_hash_index(
+      16, true /* use_delta_encoding */, key_value_encoding_format, &suffix_extractor);
+  for (size_t i = 0; i != keys.size(); ++i) {
+    const auto value = std::to_string(i);
+    builder.Add(keys[i], value);
+    builder_without_hash_index.Add(keys[i], value);
+  }
+  const auto estimated_size = builder.CurrentSizeEstimate();
+  const Slice raw_block = builder.Finish();
+  ASSERT_EQ(estimated_size, raw_block.size());
+  ASSERT_GT(raw_block.size(), builder_without_hash_index.Finish().size());
+
+  BlockContents contents;
+  contents.data = raw_block;
+  contents.cachable = false;
+  Block reader(std::move(contents));
+
+  std::unique_ptr<InternalIterator> iter(reader.NewIterator(
+      BytewiseComparator(), nullptr /* iter */, true /* total_order_seek */, &hash_key_extractor));
+  std::unique_ptr<InternalIterator> iter_without_hash_index(
+      reader.NewIterator(BytewiseComparator()));
+
+  size_t count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++count) {
+    ASSERT_LT(count, keys.size());
+    ASSERT_EQ(keys[count], iter->key().ToBuffer());
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(keys.size(), count);
+
+  for (size_t i = 0; i != keys.size(); ++i) {
+    iter->Seek(keys[i]);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(keys[i], iter->key().ToBuffer());
+    ASSERT_EQ(std::to_string(i), iter->value().ToBuffer());
+  }
+
+  // Seek to the rows without suffix, both present and absent in the block.
+  for (int row = 0; row <= kNumRows; ++row) {
+    const auto target = RowSeekKey(row);
+    iter->Seek(target);
+    iter_without_hash_index->Seek(target);
+    ASSERT_EQ(iter_without_hash_index->Valid(), iter->Valid()) << "Row: " << row;
+    if (!iter->Valid()) {
+      continue;
+    }
+    ASSERT_EQ(iter_without_hash_index->key().ToBuffer(), iter->key().ToBuffer()) << "Row: " << row;
+    ASSERT_EQ(GetPaddedNum(row + row % 2), iter->key().ToBuffer().substr(0, kTestRowSize));
+  }
+  ASSERT_OK(iter->status());
+
+  const auto middle_key = ASSERT_RESULT(reader.GetMiddleKey());
+  ASSERT_EQ(keys[(keys.size() / 16 - 1) / 2 * 16], middle_key.ToBuffer());
+}
+
+} // namespace
+
+TEST_F(BlockTest, DataBlockHashIndex) {
+  TestDataBlockHashIndex(KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix);
+  TestDataBlockHashIndex(KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char **argv) {
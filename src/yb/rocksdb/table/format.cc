@@ -28,6 +28,7 @@
 #include <string>
 
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/table/block.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/compression.h"
@@ -441,7 +442,10 @@ BlockContents::BlockContents(
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                         PersistentCache* persistent_cache, const Slice& persistent_cache_key,
+                         const UncompressionDict* compression_dict,
+                         FilePrefetchBuffer* prefetch_buffer) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
@@ -460,11 +464,41 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
     used_buf = heap_buf.get();
   }
 
-  status = ReadBlock(file, footer, options, handle, &slice, used_buf);
+  bool read_from_persistent_cache = false;
+  if (persistent_cache != nullptr) {
+    status = persistent_cache->Lookup(persistent_cache_key, n + kBlockTrailerSize, used_buf);
+    if (status.ok() && options.verify_checksums) {
+      status = VerifyBlockChecksum(file, footer, handle, used_buf, n);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to read block from persistent cache: " << status;
+      }
+    }
+    if (status.ok()) {
+      slice = Slice(used_buf, n + kBlockTrailerSize);
+      read_from_persistent_cache = true;
+    }
+  }
 
-  if (!status.ok()) {
-    LOG(ERROR) << __func__ << ": " << status << "\n" << yb::GetStackTrace();
-    return status;
+  if (!read_from_persistent_cache) {
+    if (prefetch_buffer != nullptr &&
+        prefetch_buffer->TryRead(handle.offset(), n + kBlockTrailerSize, used_buf)) {
+      slice = Slice(used_buf, n + kBlockTrailerSize);
+      if (options.verify_checksums) {
+        status = VerifyBlockChecksum(file, footer, handle, used_buf, n);
+      }
+    } else {
+      status = ReadBlock(file, footer, options, handle, &slice, used_buf);
+    }
+
+    if (!status.ok()) {
+      LOG(ERROR) << __func__ << ": " << status << "\n" << yb::GetStackTrace();
+      return status;
+    }
+
+    if (persistent_cache != nullptr && options.fill_cache) {
+      WARN_NOT_OK(persistent_cache->Insert(persistent_cache_key, slice),
+                  "Failed to insert block into persistent cache");
+    }
   }
 
   PERF_TIMER_GUARD(block_decompress_time);
@@ -472,7 +506,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
   compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
 
   if (decompression_requested && compression_type != kNoCompression) {
-    return UncompressBlockContents(slice.cdata(), n, contents, footer.version(), mem_tracker);
+    return UncompressBlockContents(
+        slice.cdata(), n, contents, footer.version(), mem_tracker, compression_dict);
   }
 
   if (slice.cdata() != used_buf) {
@@ -499,7 +534,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
 Status UncompressBlockContents(const char* data, size_t n,
                                BlockContents* contents,
                                uint32_t format_version,
-                               const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+                               const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                               const UncompressionDict* compression_dict) {
   std::unique_ptr<char[]> ubuf;
   int decompress_size = 0;
   assert(data[n] != kNoCompression);
@@ -568,7 +604,7 @@ Status UncompressBlockContents(const char* data, size_t n,
       break;
     case kZSTDNotFinalCompression:
       ubuf =
-          std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size));
+          std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size, compression_dict));
       if (!ubuf) {
         static char zstd_corrupt_msg[] =
             "ZSTD not supported or corrupted ZSTD compressed block contents";
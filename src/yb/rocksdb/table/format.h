@@ -40,6 +40,9 @@ class MemTracker;
 namespace rocksdb {
 
 class Block;
+class FilePrefetchBuffer;
+class PersistentCache;
+class UncompressionDict;
 struct ReadOptions;
 
 // the length of the magic number in bytes.
@@ -244,13 +247,22 @@ struct BlockContents {
 
 // Read the block identified by "handle" from "file".  On failure
 // return non-OK.  On success fill *result and return OK.
+// If persistent_cache is specified, the raw block is looked up there by persistent_cache_key
+// before reading the file, and is stored there after reading the file when options.fill_cache
+// is set.
+// If prefetch_buffer is specified and contains the block, the block is copied from it instead of
+// reading the file.
 extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const Footer& footer,
                                 const ReadOptions& options,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                PersistentCache* persistent_cache = nullptr,
+                                const Slice& persistent_cache_key = Slice(),
+                                const UncompressionDict* compression_dict = nullptr,
+                                FilePrefetchBuffer* prefetch_buffer = nullptr);
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -259,10 +271,12 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 // free this buffer.
 // For description of compress_format_version and possible values, see
 // util/compression.h
+// compression_dict should be the dictionary that the block was compressed with, if any.
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const UncompressionDict* compression_dict = nullptr);
 
 // Implementation details follow.  Clients should ignore,
 
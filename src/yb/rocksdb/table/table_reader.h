@@ -25,6 +25,7 @@
 #define YB_ROCKSDB_TABLE_TABLE_READER_H
 
 #include <memory>
+#include <vector>
 
 #include "yb/util/slice.h"
 
@@ -120,6 +121,12 @@ class TableReader {
   virtual yb::Result<std::string> GetMiddleKey() {
     return STATUS(NotSupported, "GetMiddleKey() not supported");
   }
+
+  // Returns up to max_keys keys from this SST file, that split it into parts of roughly the same
+  // size. Keys are sorted and unique.
+  virtual yb::Result<std::vector<std::string>> GetSampleKeys(size_t max_keys) {
+    return STATUS(NotSupported, "GetSampleKeys() not supported");
+  }
 };
 
 }  // namespace rocksdb
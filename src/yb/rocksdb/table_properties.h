@@ -111,6 +111,8 @@ struct TablePropertiesNames {
 };
 
 extern const std::string kPropertiesBlock;
+// Meta block containing dictionary used to compress data blocks of the SST file.
+extern const std::string kCompressionDictBlock;
 
 enum EntryType {
   kEntryPut,
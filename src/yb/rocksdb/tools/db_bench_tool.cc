@@ -51,6 +51,8 @@
 
 #include "yb/rocksdb/db/db_impl.h"
 #include "yb/rocksdb/db/version_set.h"
+#include "yb/rocksdb/db_bench_tool.h"
+#include "yb/rocksdb/metadata.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/db.h"
@@ -173,9 +175,17 @@ DEFINE_string(benchmarks,
               "\trandomtransaction     -- execute N random transactions and "
               "verify correctness\n"
               "\trandomreplacekeys     -- randomly replaces N keys by deleting "
-              "the old version and putting the new version\n\n"
+              "the old version and putting the new version\n"
+              "\tprofilefill           -- write N values in sequential key "
+              "order using keys, values and options of the storage profile\n"
+              "\tprofileoverwrite      -- write N new versions of random keys "
+              "using the storage profile\n"
+              "\tprofilereadrandom     -- read latest versions of N random keys "
+              "using the storage profile\n\n"
               "Meta operations:\n"
               "\tcompact     -- Compact the entire DB\n"
+              "\tamplification -- Print write and read amplification, requires "
+              "--statistics\n"
               "\tstats       -- Print DB stats\n"
               "\tlevelstats  -- Print the number of files and bytes per level\n"
               "\tsstables    -- Print sstable info\n"
@@ -266,8 +276,11 @@ DEFINE_bool(enable_numa, false,
             "CPU and memory of same node. Use \"$numactl --hardware\" command "
             "to see NUMA memory architecture.");
 
+// Binaries that link db_bench together with DocDB get db_write_buffer_size flag from DocDB.
+#ifndef DB_BENCH_EXTERNAL_DB_WRITE_BUFFER_SIZE
 DEFINE_int64(db_write_buffer_size, rocksdb::Options().db_write_buffer_size,
              "Number of bytes to buffer in all memtables before compacting");
+#endif
 
 DEFINE_int64(write_buffer_size, rocksdb::Options().write_buffer_size,
              "Number of bytes to buffer in memtable before compacting");
@@ -425,6 +438,11 @@ DEFINE_bool(verify_checksum, false, "Verify checksum for every block read"
 DEFINE_bool(statistics, false, "Database statistics");
 static class std::shared_ptr<rocksdb::Statistics> dbstats;
 
+DEFINE_bool(profile_use_bloom_filter, true,
+            "Whether profilereadrandom skips files using the bloom filter of "
+            "the storage profile");
+static const rocksdb::DbBenchProfile* db_bench_profile = nullptr;
+
 DEFINE_int64(writes, -1, "Number of write operations to do. If negative, do"
              " --num reads.");
 
@@ -1580,6 +1598,10 @@ class Benchmark {
   int64_t merge_keys_;
   bool report_file_operations_;
   int cachedev_fd_;
+  // Last version used by profile benchmarks.
+  std::atomic<uint64_t> profile_last_version_{0};
+  // Next key to be written by profilefill.
+  std::atomic<int64_t> profile_next_key_{0};
 
   bool SanityCheck() {
     if (FLAGS_compression_ratio > 1) {
@@ -2041,6 +2063,16 @@ class Benchmark {
       } else if (name == "randomreplacekeys") {
         fresh_db = true;
         method = &Benchmark::RandomReplaceKeys;
+      } else if (name == "profilefill") {
+        fresh_db = true;
+        profile_next_key_ = 0;
+        method = &Benchmark::ProfileWriteSeq;
+      } else if (name == "profileoverwrite") {
+        method = &Benchmark::ProfileWriteRandom;
+      } else if (name == "profilereadrandom") {
+        method = &Benchmark::ProfileReadRandom;
+      } else if (name == "amplification") {
+        PrintAmplification();
       } else if (name == "stats") {
         PrintStats("rocksdb.stats");
       } else if (name == "levelstats") {
@@ -2052,6 +2084,12 @@ class Benchmark {
         exit(1);
       }
 
+      if (Slice(name).starts_with("profile") &&
+          (db_bench_profile == nullptr || FLAGS_num_multi_db > 1)) {
+        fprintf(stderr, "%s requires storage profile and single DB\n", name.c_str());
+        exit(1);
+      }
+
       if (fresh_db) {
         if (FLAGS_use_existing_db) {
           fprintf(stdout, "%-12s : skipped (--use_existing_db is true)\n",
@@ -2348,7 +2386,9 @@ class Benchmark {
 
     options.create_if_missing = !FLAGS_use_existing_db;
     options.create_missing_column_families = FLAGS_num_column_families > 1;
+#ifndef DB_BENCH_EXTERNAL_DB_WRITE_BUFFER_SIZE
     options.db_write_buffer_size = FLAGS_db_write_buffer_size;
+#endif
     options.write_buffer_size = FLAGS_write_buffer_size;
     options.max_write_buffer_number = FLAGS_max_write_buffer_number;
     options.min_write_buffer_number_to_merge =
@@ -2622,6 +2662,15 @@ class Benchmark {
     }
 #endif  // ROCKSDB_LITE
 
+    if (db_bench_profile) {
+      // Options produced by the profile take precedence over flags, except the ones that are
+      // specific to the benchmark run.
+      Env* env = options.env;
+      db_bench_profile->InitOptions(dbstats, &options);
+      options.env = env;
+      options.create_if_missing = !FLAGS_use_existing_db;
+    }
+
     if (FLAGS_num_multi_db <= 1) {
       OpenDb(options, FLAGS_db, &db_);
     } else {
@@ -3095,6 +3144,111 @@ class Benchmark {
     }
   }
 
+  void ProfileWriteSeq(ThreadState* thread) {
+    ProfileWrite(thread, SEQUENTIAL);
+  }
+
+  void ProfileWriteRandom(ThreadState* thread) {
+    ProfileWrite(thread, RANDOM);
+  }
+
+  void ProfileWrite(ThreadState* thread, WriteMode write_mode) {
+    const int64_t num_ops = writes_ == 0 ? num_ : writes_;
+    Duration duration(write_mode == RANDOM ? FLAGS_duration : 0, num_ops);
+    RandomGenerator gen;
+    WriteBatch batch;
+    std::string key;
+    std::string value;
+    int64_t bytes = 0;
+    while (!duration.Done(entries_per_batch_)) {
+      batch.Clear();
+      // Versions are reserved for the whole batch, so the batch could be described by frontiers.
+      const uint64_t min_version =
+          profile_last_version_.fetch_add(entries_per_batch_, std::memory_order_acq_rel) + 1;
+      for (int64_t j = 0; j < entries_per_batch_; j++) {
+        int64_t key_index = write_mode == RANDOM
+            ? thread->rand.Next() % FLAGS_num
+            : profile_next_key_.fetch_add(1, std::memory_order_acq_rel) % FLAGS_num;
+        key.clear();
+        db_bench_profile->AppendKeyPrefix(key_index, &key);
+        db_bench_profile->AppendKeySuffix(min_version + j, &key);
+        value.clear();
+        db_bench_profile->AppendValue(gen.Generate(value_size_), &value);
+        batch.Put(key, value);
+        bytes += key.size() + value.size();
+      }
+      auto frontiers = db_bench_profile->CreateFrontiers(
+          min_version, min_version + entries_per_batch_ - 1);
+      batch.SetFrontiers(frontiers.get());
+      Status s = db_.db->Write(write_options_, &batch);
+      if (!s.ok()) {
+        fprintf(stderr, "put error: %s\n", s.ToString().c_str());
+        exit(1);
+      }
+      thread->stats.FinishedOps(&db_, db_.db, entries_per_batch_, kWrite);
+    }
+    thread->stats.AddBytes(bytes);
+  }
+
+  // Reads the latest version of random keys, creating iterator for each read as the storage layer
+  // does.
+  void ProfileReadRandom(ThreadState* thread) {
+    int64_t read = 0;
+    int64_t found = 0;
+    int64_t bytes = 0;
+    std::string prefix;
+    Duration duration(FLAGS_duration, reads_);
+    while (!duration.Done(1)) {
+      prefix.clear();
+      db_bench_profile->AppendKeyPrefix(thread->rand.Next() % FLAGS_num, &prefix);
+      ReadOptions options(FLAGS_verify_checksum, true);
+      if (FLAGS_profile_use_bloom_filter) {
+        options.table_aware_file_filter =
+            db_.db->GetOptions().table_factory->NewTableAwareReadFileFilter(options, prefix);
+      }
+      std::unique_ptr<Iterator> iter(db_.db->NewIterator(options));
+      iter->Seek(prefix);
+      read++;
+      if (iter->Valid() && iter->key().starts_with(prefix)) {
+        found++;
+        bytes += iter->key().size() + iter->value().size();
+      }
+      thread->stats.FinishedOps(&db_, db_.db, 1, kRead);
+    }
+
+    char msg[100];
+    snprintf(msg, sizeof(msg), "(%" PRIu64 " of %" PRIu64 " found)\n", found, read);
+    thread->stats.AddBytes(bytes);
+    thread->stats.AddMessage(msg);
+  }
+
+  // Write amplification is the ratio of bytes written by flushes and compactions to bytes written
+  // by users. Read amplification is the number of data blocks accessed per seek or point read.
+  void PrintAmplification() {
+    if (!dbstats) {
+      fprintf(stderr, "amplification requires --statistics\n");
+      return;
+    }
+    const uint64_t user_bytes = dbstats->getTickerCount(BYTES_WRITTEN);
+    const uint64_t flush_bytes = dbstats->getTickerCount(FLUSH_WRITE_BYTES);
+    const uint64_t compact_bytes = dbstats->getTickerCount(COMPACT_WRITE_BYTES);
+    const uint64_t reads =
+        dbstats->getTickerCount(NUMBER_DB_SEEK) + dbstats->getTickerCount(NUMBER_KEYS_READ);
+    const uint64_t data_blocks = dbstats->getTickerCount(BLOCK_CACHE_DATA_MISS) +
+                                 dbstats->getTickerCount(BLOCK_CACHE_DATA_HIT);
+    fprintf(stdout,
+            "Write amplification: %.3f (user: %" PRIu64 " bytes, flush: %" PRIu64
+            " bytes, compaction: %" PRIu64 " bytes)\n",
+            user_bytes ? static_cast<double>(flush_bytes + compact_bytes) / user_bytes : 0.0,
+            user_bytes, flush_bytes, compact_bytes);
+    fprintf(stdout,
+            "Read amplification: %.3f data blocks per read (reads: %" PRIu64
+            ", data block misses: %" PRIu64 ", bloom filter useful: %" PRIu64 ")\n",
+            reads ? static_cast<double>(data_blocks) / reads : 0.0, reads,
+            dbstats->getTickerCount(BLOCK_CACHE_DATA_MISS),
+            dbstats->getTickerCount(BLOOM_FILTER_USEFUL));
+  }
+
   void SeekRandom(ThreadState* thread) {
     int64_t read = 0;
     int64_t found = 0;
@@ -4052,8 +4206,9 @@ class Benchmark {
   }
 };
 
-int db_bench_tool(int argc, char** argv) {
+int db_bench_tool(int argc, char** argv, const DbBenchProfile* profile) {
   rocksdb::port::InstallStackTraceHandler();
+  db_bench_profile = profile;
   SetUsageMessage(std::string("\nUSAGE:\n") + std::string(argv[0]) +
                   " [OPTIONS]...");
   ParseCommandLineFlags(&argc, &argv, true);
@@ -37,6 +37,7 @@
 
 #include "yb/util/enums.h"
 #include "yb/util/random_util.h"
+#include "yb/util/thread.h"
 
 // 0 value means that there exist no single_touch cache and
 // 1 means that the entire cache is treated as a multi-touch cache.
@@ -54,6 +55,25 @@ Cache::~Cache() {
 
 namespace {
 
+// Locks cache shard mutex, marking the current thread as waiting for it while it is contended.
+class CacheMutexLock {
+ public:
+  explicit CacheMutexLock(port::Mutex* mu) : mu_(mu) {
+    if (!mu_->TryLock()) {
+      yb::ScopedWaitState wait_state(yb::WaitState::kBlockCacheMutex);
+      mu_->Lock();
+    }
+  }
+
+  ~CacheMutexLock() { mu_->Unlock(); }
+
+  CacheMutexLock(const CacheMutexLock&) = delete;
+  void operator=(const CacheMutexLock&) = delete;
+
+ private:
+  port::Mutex* const mu_;
+};
+
 // LRU cache implementation
 
 // An entry is a variable length heap-allocated structure.
@@ -577,7 +597,7 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
-  MutexLock l(&mutex_);
+  CacheMutexLock l(&mutex_);
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->in_cache);
@@ -659,7 +679,7 @@ void LRUCache::Release(Cache::Handle* handle) {
   LRUHandle* e = reinterpret_cast<LRUHandle*>(handle);
   bool last_reference = false;
   {
-    MutexLock l(&mutex_);
+    CacheMutexLock l(&mutex_);
     LRUSubCache* sub_cache = GetSubCache(e->GetSubCacheType());
     last_reference = Unref(e);
     if (last_reference) {
@@ -731,7 +751,7 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
   memcpy(e->key_data, key.data(), key.size());
 
   {
-    MutexLock l(&mutex_);
+    CacheMutexLock l(&mutex_);
     // Free the space following strict LRU policy until enough space
     // is freed or the lru list is empty.
     // Check if there is a single touch cache.
@@ -819,7 +839,7 @@ void LRUCache::Erase(const Slice& key, uint32_t hash) {
   LRUHandle* e;
   bool last_reference = false;
   {
-    MutexLock l(&mutex_);
+    CacheMutexLock l(&mutex_);
     e = table_.Remove(key, hash);
     if (e != nullptr) {
       last_reference = Unref(e);
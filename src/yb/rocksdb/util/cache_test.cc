@@ -24,11 +24,13 @@
 #include "yb/rocksdb/cache.h"
 
 #include <forward_list>
+#include <thread>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <gflags/gflags.h>
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/random.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/testharness.h"
 
@@ -741,6 +743,163 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+TEST_F(CacheTest, ClockCacheHitAndMiss) {
+  auto cache = NewClockCache(kCacheSize, kNumShardBits);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_EQ(-1, Lookup(cache, 200));
+
+  ASSERT_OK(Insert(cache, 200, 201));
+  ASSERT_OK(Insert(cache, 100, 102));
+  ASSERT_EQ(102, Lookup(cache, 100));
+  ASSERT_EQ(201, Lookup(cache, 200));
+  ASSERT_EQ(2U, cache->GetUsage());
+
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[0]);
+  ASSERT_EQ(101, deleted_values_[0]);
+
+  Erase(cache, 200);
+  ASSERT_EQ(-1, Lookup(cache, 200));
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(200, deleted_keys_[1]);
+  ASSERT_EQ(1U, cache->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheEntriesArePinned) {
+  auto cache = NewClockCache(kCacheSize, kNumShardBits);
+  ASSERT_OK(Insert(cache, 100, 101));
+  Cache::Handle* h1 = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(101, DecodeValue(cache->Value(h1)));
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+
+  ASSERT_OK(Insert(cache, 100, 102));
+  Cache::Handle* h2 = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(102, DecodeValue(cache->Value(h2)));
+  ASSERT_EQ(0U, deleted_keys_.size());
+  ASSERT_EQ(2U, cache->GetUsage());
+  ASSERT_EQ(2U, cache->GetPinnedUsage());
+
+  cache->Release(h1);
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+  ASSERT_EQ(1U, cache->GetUsage());
+
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(1U, cache->GetUsage());
+
+  cache->Release(h2);
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+  ASSERT_EQ(0U, cache->GetUsage());
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
+TEST_F(CacheTest, ClockCacheScanResistance) {
+  constexpr int kCapacity = 10;
+  constexpr QueryId kScanQueryId = 3;
+
+  for (QueryId hot_query_id : {kTestQueryId + 1, kTestQueryId}) {
+    auto cache = NewClockCache(kCapacity, 0);
+    for (int i = 0; i < kCapacity / 2; ++i) {
+      ASSERT_OK(Insert(cache, i, i));
+      ASSERT_EQ(i, Lookup(cache, i, hot_query_id));
+    }
+    for (int i = 100; i < 100 + kCapacity; ++i) {
+      ASSERT_OK(Insert(cache, i, i, 1, kScanQueryId));
+      ASSERT_EQ(i, Lookup(cache, i, kScanQueryId));
+    }
+    ASSERT_EQ(static_cast<size_t>(kCapacity), cache->GetUsage());
+    // Entries touched by another query survive the scan, while scanned entries replace each other.
+    // Entries touched only by the query that inserted them are evicted by the scan.
+    const bool hot_kept = hot_query_id != kTestQueryId;
+    for (int i = 0; i < kCapacity / 2; ++i) {
+      ASSERT_EQ(hot_kept ? i : -1, Lookup(cache, i)) << "Hot query id: " << hot_query_id;
+    }
+    for (int i = 100 + kCapacity / 2; i < 100 + kCapacity; ++i) {
+      ASSERT_EQ(i, Lookup(cache, i));
+    }
+  }
+}
+
+TEST_F(CacheTest, ClockCacheStrictCapacityLimit) {
+  auto cache = NewClockCache(10, 0, true);
+  std::vector<Cache::Handle*> handles(10);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(cache->Insert(EncodeKey(i), kTestQueryId, EncodeValue(i), 1, &CacheTest::Deleter,
+                            &handles[i]));
+    ASSERT_NE(nullptr, handles[i]);
+  }
+  ASSERT_EQ(10U, cache->GetPinnedUsage());
+
+  // All entries are pinned, so there is no space for the new one.
+  Cache::Handle* handle = nullptr;
+  Status s = cache->Insert(EncodeKey(10), kTestQueryId, EncodeValue(10), 1, &CacheTest::Deleter,
+                           &handle);
+  ASSERT_TRUE(s.IsIncomplete());
+  ASSERT_EQ(nullptr, handle);
+  ASSERT_EQ(0U, deleted_keys_.size());
+
+  // Without handle the value is cleaned up by the cache.
+  s = Insert(cache, 10, 10);
+  ASSERT_TRUE(s.IsIncomplete());
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(10, deleted_keys_[0]);
+
+  for (auto* h : handles) {
+    cache->Release(h);
+  }
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+  ASSERT_OK(Insert(cache, 10, 10));
+  ASSERT_EQ(10, Lookup(cache, 10));
+  ASSERT_EQ(10U, cache->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheConcurrentAccess) {
+  constexpr size_t kCapacity = 100;
+  constexpr int kNumThreads = 8;
+  constexpr int kOpsPerThread = 20000;
+  constexpr int kNumKeys = 300;
+
+  auto cache = NewClockCache(kCapacity, 2);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([&cache, t] {
+      Random rnd(t + 1);
+      for (int i = 0; i != kOpsPerThread; ++i) {
+        const std::string key = EncodeKey(rnd.Uniform(kNumKeys));
+        switch (rnd.Uniform(10)) {
+          case 0:
+            cache->Erase(key);
+            break;
+          case 1: FALLTHROUGH_INTENDED;
+          case 2:
+            ASSERT_OK(cache->Insert(key, t, EncodeValue(i), 1, &dumbDeleter));
+            break;
+          default: {
+            Cache::Handle* handle = cache->Lookup(key, t);
+            if (handle != nullptr) {
+              cache->Value(handle);
+              cache->Release(handle);
+            }
+            break;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+  ASSERT_LE(cache->GetUsage(), kCapacity);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -0,0 +1,691 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <mutex>
+
+#include <gflags/gflags.h>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/port/port.h"
+#include "yb/rocksdb/util/autovector.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/rocksdb/util/mutexlock.h"
+#include "yb/rocksdb/util/statistics.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
+
+DECLARE_double(cache_single_touch_ratio);
+
+namespace rocksdb {
+
+namespace {
+
+// CLOCK cache implementation.
+//
+// Each shard keeps its entries in a hash table and on a circular list, that is scanned by the
+// clock hand when space should be freed.
+//
+// Unlike LRUCache, a hit does not modify any structure shared by the shard. The entry is found in
+// the hash table under the shared lock, and only its own atomic flags are updated. The hash table
+// and the clock list are modified under the exclusive lock, i.e. by insert, erase and eviction,
+// which happen on a miss. Release does not take the lock at all.
+//
+// Flags of an entry contain:
+// - kInCacheBit, set while the entry is referenced by the hash table.
+// - kUsageBit, set when the entry was used since the clock hand passed it.
+// - Number of external references, in units of kOneRef.
+//
+// The clock hand clears usage bit of entries it passes, and evicts the ones that don't have it
+// and are not referenced externally. An entry is freed by the one who clears the last of its
+// references and kInCacheBit.
+//
+// The usage bit is set only when the entry is touched by a query other than the one that
+// inserted it. So blocks read by a single scan are evicted first, just like single-touch entries
+// of LRUCache. Entries inserted with kInMultiTouchId start with the usage bit set.
+struct ClockHandle {
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  ClockHandle* next_hash;
+  // Neighbours on the clock list.
+  ClockHandle* next;
+  ClockHandle* prev;
+  size_t charge;
+  size_t key_length;
+  std::atomic<uint32_t> flags;
+  uint32_t hash;      // Hash of key(); used for fast sharding and comparisons
+  QueryId query_id;   // Query id that added the value to the cache.
+  char key_data[1];   // Beginning of key
+
+  Slice key() const {
+    return Slice(key_data, key_length);
+  }
+};
+
+constexpr uint32_t kInCacheBit = 1;
+constexpr uint32_t kUsageBit = 2;
+constexpr uint32_t kOneRef = 4;
+
+inline uint32_t RefsOf(uint32_t flags) {
+  return flags / kOneRef;
+}
+
+// Hash table of clock cache shard, the same as HandleTable of LRU cache.
+// Lookup could be invoked concurrently, while other methods require exclusive access.
+class ClockHandleTable {
+ public:
+  ClockHandleTable() : length_(0), elems_(0), list_(nullptr) {
+    Resize();
+  }
+
+  ~ClockHandleTable() {
+    delete[] list_;
+  }
+
+  ClockHandle* Lookup(const Slice& key, uint32_t hash) const {
+    return *FindPointer(key, hash);
+  }
+
+  ClockHandle* Insert(ClockHandle* h) {
+    ClockHandle** ptr = FindPointer(h->key(), h->hash);
+    ClockHandle* old = *ptr;
+    h->next_hash = (old == nullptr ? nullptr : old->next_hash);
+    *ptr = h;
+    if (old == nullptr) {
+      ++elems_;
+      if (elems_ > length_) {
+        Resize();
+      }
+    }
+    return old;
+  }
+
+  ClockHandle* Remove(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = FindPointer(key, hash);
+    ClockHandle* result = *ptr;
+    if (result != nullptr) {
+      *ptr = result->next_hash;
+      --elems_;
+    }
+    return result;
+  }
+
+  size_t size() const {
+    return elems_;
+  }
+
+ private:
+  ClockHandle** FindPointer(const Slice& key, uint32_t hash) const {
+    ClockHandle** ptr = &list_[hash & (length_ - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+      ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+  }
+
+  void Resize() {
+    uint32_t new_length = 16;
+    while (new_length < elems_ * 1.5) {
+      new_length *= 2;
+    }
+    ClockHandle** new_list = new ClockHandle*[new_length];
+    memset(new_list, 0, sizeof(new_list[0]) * new_length);
+    for (uint32_t i = 0; i < length_; i++) {
+      ClockHandle* h = list_[i];
+      while (h != nullptr) {
+        ClockHandle* next = h->next_hash;
+        ClockHandle** ptr = &new_list[h->hash & (new_length - 1)];
+        h->next_hash = *ptr;
+        *ptr = h;
+        h = next;
+      }
+    }
+    delete[] list_;
+    list_ = new_list;
+    length_ = new_length;
+  }
+
+  uint32_t length_;
+  uint32_t elems_;
+  ClockHandle** list_;
+};
+
+// A single shard of sharded clock cache.
+class ClockCache {
+ public:
+  ClockCache() = default;
+  ~ClockCache();
+
+  void SetCapacity(size_t capacity);
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) {
+    strict_capacity_limit_ = strict_capacity_limit;
+  }
+
+  void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) {
+    metrics_ = std::move(metrics);
+  }
+
+  Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
+                Cache::Handle** handle, Statistics* statistics);
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                        Statistics* statistics);
+  void Release(Cache::Handle* handle);
+  void Erase(const Slice& key, uint32_t hash);
+  size_t Evict(size_t required);
+
+  size_t GetUsage() const {
+    return usage_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetPinnedUsage() const {
+    return pinned_usage_.load(std::memory_order_relaxed);
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe);
+
+ private:
+  typedef autovector<ClockHandle*> ClockHandles;
+
+  // Moves the clock hand, evicting entries until usage drops to target_usage, or every entry was
+  // visited twice, so all entries that could be evicted were evicted.
+  // Evicted entries that should be freed are added to evicted, after the lock is released.
+  // Returns total charge of evicted entries.
+  size_t EvictUnlocked(size_t target_usage, ClockHandles* evicted);
+
+  // Removes entry, that was already removed from the hash table, from the clock list.
+  // Returns true if there are no more references to it, so it should be freed.
+  bool RemoveUnlocked(ClockHandle* e);
+
+  // Frees entry after it was removed from cache, and the last reference was released.
+  void Free(ClockHandle* e);
+  void FreeAll(const ClockHandles& handles);
+
+  // Protects table_ and the clock list. Only the lock of the current CPU is acquired on hit,
+  // so readers on different CPUs don't contend with each other.
+  yb::percpu_rwlock mutex_;
+
+  std::atomic<size_t> capacity_{0};
+  bool strict_capacity_limit_ = false;
+
+  // Charge of entries that were not freed yet, including ones that were erased but are still
+  // referenced externally.
+  std::atomic<size_t> usage_{0};
+  // Charge of entries referenced externally.
+  std::atomic<size_t> pinned_usage_{0};
+
+  ClockHandleTable table_;
+  // Clock hand, the next entry to visit during eviction. nullptr when the cache is empty.
+  ClockHandle* hand_ = nullptr;
+
+  shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+ClockCache::~ClockCache() {
+  if (hand_ == nullptr) {
+    return;
+  }
+  ClockHandle* e = hand_;
+  do {
+    ClockHandle* next = e->next;
+    DCHECK_EQ(RefsOf(e->flags.load(std::memory_order_acquire)), 0) << "Entry is still referenced";
+    Free(e);
+    e = next;
+  } while (e != hand_);
+}
+
+void ClockCache::SetCapacity(size_t capacity) {
+  ClockHandles evicted;
+  {
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    capacity_.store(capacity, std::memory_order_release);
+    EvictUnlocked(capacity, &evicted);
+  }
+  FreeAll(evicted);
+}
+
+size_t ClockCache::EvictUnlocked(size_t target_usage, ClockHandles* evicted) {
+  const size_t usage = usage_.load(std::memory_order_acquire);
+  size_t evicted_charge = 0;
+  size_t steps_left = table_.size() * 2;
+  while (hand_ != nullptr && usage > target_usage + evicted_charge && steps_left > 0) {
+    --steps_left;
+    ClockHandle* e = hand_;
+    hand_ = e->next;
+    // Lookup does not add references while we hold the exclusive lock, so the entry without
+    // references cannot become referenced before it is removed.
+    auto flags = e->flags.load(std::memory_order_acquire);
+    if (RefsOf(flags) != 0) {
+      continue;
+    }
+    if (flags & kUsageBit) {
+      e->flags.fetch_and(~kUsageBit, std::memory_order_relaxed);
+      continue;
+    }
+    table_.Remove(e->key(), e->hash);
+    if (RemoveUnlocked(e)) {
+      evicted_charge += e->charge;
+      evicted->push_back(e);
+    }
+  }
+  return evicted_charge;
+}
+
+bool ClockCache::RemoveUnlocked(ClockHandle* e) {
+  if (e->next == e) {
+    hand_ = nullptr;
+  } else {
+    e->next->prev = e->prev;
+    e->prev->next = e->next;
+    if (hand_ == e) {
+      hand_ = e->next;
+    }
+  }
+  auto old_flags = e->flags.fetch_and(~kInCacheBit, std::memory_order_acq_rel);
+  DCHECK(old_flags & kInCacheBit);
+  return RefsOf(old_flags) == 0;
+}
+
+void ClockCache::Free(ClockHandle* e) {
+  (*e->deleter)(e->key(), e->value);
+  usage_.fetch_sub(e->charge, std::memory_order_release);
+  if (metrics_ != nullptr) {
+    metrics_->cache_usage->DecrementBy(e->charge);
+  }
+  e->flags.~atomic();
+  delete[] reinterpret_cast<char*>(e);
+}
+
+void ClockCache::FreeAll(const ClockHandles& handles) {
+  for (auto* e : handles) {
+    Free(e);
+  }
+}
+
+Cache::Handle* ClockCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
+                                  Statistics* statistics) {
+  ClockHandle* e;
+  {
+    yb::shared_lock<yb::rw_spinlock> lock(mutex_.get_lock());
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      auto old_flags = e->flags.fetch_add(kOneRef, std::memory_order_acquire);
+      if (RefsOf(old_flags) == 0) {
+        pinned_usage_.fetch_add(e->charge, std::memory_order_relaxed);
+      }
+      if ((old_flags & kUsageBit) == 0 &&
+          (e->query_id != query_id || FLAGS_cache_single_touch_ratio == 0)) {
+        e->flags.fetch_or(kUsageBit, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  if (statistics != nullptr) {
+    if (e != nullptr) {
+      RecordTick(statistics, BLOCK_CACHE_HIT);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_MISS);
+    }
+  }
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (e != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+  return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCache::Release(Cache::Handle* handle) {
+  if (handle == nullptr) {
+    return;
+  }
+  ClockHandle* e = reinterpret_cast<ClockHandle*>(handle);
+  auto old_flags = e->flags.fetch_sub(kOneRef, std::memory_order_acq_rel);
+  DCHECK_GE(RefsOf(old_flags), 1);
+  if (RefsOf(old_flags) != 1) {
+    return;
+  }
+  pinned_usage_.fetch_sub(e->charge, std::memory_order_relaxed);
+  if ((old_flags & kInCacheBit) == 0) {
+    Free(e);
+    return;
+  }
+  // Cache could go over capacity while all entries were pinned, evict now that it is possible.
+  const size_t capacity = capacity_.load(std::memory_order_acquire);
+  if (usage_.load(std::memory_order_acquire) > capacity) {
+    ClockHandles evicted;
+    {
+      std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+      EvictUnlocked(capacity, &evicted);
+    }
+    FreeAll(evicted);
+  }
+}
+
+size_t ClockCache::Evict(size_t required) {
+  ClockHandles evicted;
+  size_t result;
+  {
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    const size_t usage = usage_.load(std::memory_order_acquire);
+    result = EvictUnlocked(usage > required ? usage - required : 0, &evicted);
+  }
+  FreeAll(evicted);
+  return result;
+}
+
+Status ClockCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
+                          void* value, size_t charge,
+                          void (*deleter)(const Slice& key, void* value),
+                          Cache::Handle** handle, Statistics* statistics) {
+  // Allocate the memory here outside of the mutex.
+  ClockHandle* e = reinterpret_cast<ClockHandle*>(new char[sizeof(ClockHandle) - 1 + key.size()]);
+  e->value = value;
+  e->deleter = deleter;
+  e->next_hash = e->next = e->prev = nullptr;
+  e->charge = charge;
+  e->key_length = key.size();
+  e->hash = hash;
+  e->query_id = query_id;
+  memcpy(e->key_data, key.data(), key.size());
+  uint32_t flags = kInCacheBit;
+  if (handle != nullptr) {
+    flags += kOneRef;
+  }
+  if (query_id == kInMultiTouchId || FLAGS_cache_single_touch_ratio == 0) {
+    flags |= kUsageBit;
+  }
+  new (&e->flags) std::atomic<uint32_t>(flags);
+
+  Status s;
+  ClockHandles evicted;
+  {
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    const size_t capacity = capacity_.load(std::memory_order_acquire);
+    const size_t evicted_charge = EvictUnlocked(capacity > charge ? capacity - charge : 0,
+                                                &evicted);
+    if (strict_capacity_limit_ &&
+        usage_.load(std::memory_order_acquire) + charge > capacity + evicted_charge) {
+      s = STATUS(Incomplete, "Insert failed due to CLOCK cache being full.");
+    } else {
+      usage_.fetch_add(charge, std::memory_order_release);
+      if (handle != nullptr) {
+        pinned_usage_.fetch_add(charge, std::memory_order_relaxed);
+      }
+      // Link the new entry right behind the hand, so it is visited last.
+      if (hand_ == nullptr) {
+        e->next = e->prev = e;
+        hand_ = e;
+      } else {
+        e->next = hand_;
+        e->prev = hand_->prev;
+        e->prev->next = e;
+        hand_->prev = e;
+      }
+      ClockHandle* old = table_.Insert(e);
+      if (old != nullptr && RemoveUnlocked(old)) {
+        evicted.push_back(old);
+      }
+    }
+  }
+
+  if (s.ok()) {
+    if (handle != nullptr) {
+      *handle = reinterpret_cast<Cache::Handle*>(e);
+    }
+    if (metrics_ != nullptr) {
+      metrics_->cache_usage->IncrementBy(charge);
+    }
+  } else {
+    e->flags.~atomic();
+    delete[] reinterpret_cast<char*>(e);
+    if (handle == nullptr) {
+      (*deleter)(key, value);
+    } else {
+      *handle = nullptr;
+    }
+  }
+  FreeAll(evicted);
+
+  if (statistics != nullptr) {
+    if (s.ok()) {
+      RecordTick(statistics, BLOCK_CACHE_ADD);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    }
+  }
+  return s;
+}
+
+void ClockCache::Erase(const Slice& key, uint32_t hash) {
+  ClockHandle* e;
+  bool last_reference = false;
+  {
+    std::lock_guard<yb::percpu_rwlock> lock(mutex_);
+    e = table_.Remove(key, hash);
+    if (e != nullptr) {
+      last_reference = RemoveUnlocked(e);
+    }
+  }
+  // last_reference will only be true if e != nullptr
+  if (last_reference) {
+    Free(e);
+  }
+}
+
+void ClockCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+  yb::shared_lock<yb::rw_spinlock> lock;
+  if (thread_safe) {
+    yb::shared_lock<yb::rw_spinlock>(mutex_.get_lock()).swap(lock);
+  }
+  if (hand_ == nullptr) {
+    return;
+  }
+  ClockHandle* e = hand_;
+  do {
+    callback(e->value, e->charge);
+    e = e->next;
+  } while (e != hand_);
+}
+
+static int kNumShardBits = 4;          // default values, can be overridden
+
+class ShardedClockCache : public Cache {
+ private:
+  ClockCache* shards_;
+  port::Mutex id_mutex_;
+  port::Mutex capacity_mutex_;
+  uint64_t last_id_;
+  size_t num_shard_bits_;
+  size_t capacity_;
+  bool strict_capacity_limit_;
+  shared_ptr<yb::CacheMetrics> metrics_;
+
+  static inline uint32_t HashSlice(const Slice& s) {
+    return Hash(s.data(), s.size(), 0);
+  }
+
+  uint32_t Shard(uint32_t hash) {
+    // Note, hash >> 32 yields hash in gcc, not the zero we expect!
+    return (num_shard_bits_ > 0) ? (hash >> (32 - num_shard_bits_)) : 0;
+  }
+
+  bool IsValidQueryId(const QueryId query_id) {
+    return query_id >= 0 || query_id == kInMultiTouchId || query_id == kNoCacheQueryId;
+  }
+
+  size_t NumShards() const {
+    return 1ULL << num_shard_bits_;
+  }
+
+ public:
+  ShardedClockCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
+      : last_id_(0),
+        num_shard_bits_(num_shard_bits),
+        capacity_(capacity),
+        strict_capacity_limit_(strict_capacity_limit) {
+    shards_ = new ClockCache[NumShards()];
+    const size_t per_shard = (capacity + (NumShards() - 1)) / NumShards();
+    for (size_t s = 0; s < NumShards(); s++) {
+      shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+      shards_[s].SetCapacity(per_shard);
+    }
+  }
+
+  virtual ~ShardedClockCache() {
+    delete[] shards_;
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const size_t per_shard = (capacity + (NumShards() - 1)) / NumShards();
+    MutexLock l(&capacity_mutex_);
+    for (size_t s = 0; s < NumShards(); s++) {
+      shards_[s].SetCapacity(per_shard);
+    }
+    capacity_ = capacity;
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    DCHECK(IsValidQueryId(query_id));
+    // Queries with no cache query ids are not cached.
+    if (query_id == kNoCacheQueryId) {
+      return Status::OK();
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Insert(key, hash, query_id, value, charge, deleter,
+                                       handle, statistics);
+  }
+
+  size_t Evict(size_t bytes_to_evict) override {
+    size_t total_evicted = 0;
+    // Start at random shard.
+    auto index = Shard(yb::RandomUniformInt<uint32_t>());
+    for (size_t i = 0; bytes_to_evict > total_evicted && i != NumShards(); ++i) {
+      total_evicted += shards_[index].Evict(bytes_to_evict - total_evicted);
+      index = (index + 1) & (NumShards() - 1);
+    }
+    return total_evicted;
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    DCHECK(IsValidQueryId(query_id));
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    ClockHandle* h = reinterpret_cast<ClockHandle*>(handle);
+    shards_[Shard(h->hash)].Release(handle);
+  }
+
+  void Erase(const Slice& key) override {
+    const uint32_t hash = HashSlice(key);
+    shards_[Shard(hash)].Erase(key, hash);
+  }
+
+  void* Value(Handle* handle) override {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+  }
+
+  uint64_t NewId() override {
+    MutexLock l(&id_mutex_);
+    return ++(last_id_);
+  }
+
+  size_t GetCapacity() const override { return capacity_; }
+
+  bool HasStrictCapacityLimit() const override {
+    return strict_capacity_limit_;
+  }
+
+  size_t GetUsage() const override {
+    size_t usage = 0;
+    for (size_t s = 0; s < NumShards(); s++) {
+      usage += shards_[s].GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->charge;
+  }
+
+  size_t GetPinnedUsage() const override {
+    size_t usage = 0;
+    for (size_t s = 0; s < NumShards(); s++) {
+      usage += shards_[s].GetPinnedUsage();
+    }
+    return usage;
+  }
+
+  void DisownData() override {
+    shards_ = nullptr;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    for (size_t s = 0; s < NumShards(); s++) {
+      shards_[s].ApplyToAllCacheEntries(callback, thread_safe);
+    }
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    metrics_ = std::make_shared<yb::CacheMetrics>(entity);
+    for (size_t s = 0; s < NumShards(); s++) {
+      shards_[s].SetMetrics(metrics_);
+    }
+  }
+
+  // Clock cache does not have separate single-touch pool, so whole usage is reported as
+  // multi-touch.
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    std::vector<std::pair<size_t, size_t>> cache_sizes;
+    cache_sizes.reserve(NumShards());
+    for (size_t i = 0; i < NumShards(); ++i) {
+      cache_sizes.emplace_back(0, shards_[i].GetUsage());
+    }
+    return cache_sizes;
+  }
+};
+
+}  // end anonymous namespace
+
+shared_ptr<Cache> NewClockCache(size_t capacity) {
+  return NewClockCache(capacity, kNumShardBits, false);
+}
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits) {
+  return NewClockCache(capacity, num_shard_bits, false);
+}
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits, strict_capacity_limit);
+}
+
+}  // namespace rocksdb
@@ -26,10 +26,13 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
 
+#include "yb/util/slice.h"
+
 #ifdef SNAPPY
 #include <snappy.h>
 #endif
@@ -49,6 +52,7 @@
 
 #if defined(ZSTD)
 #include <zstd.h>
+#include <zdict.h>
 #endif
 
 namespace rocksdb {
@@ -620,8 +624,111 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   return false;
 }
 
+// Dictionary used to compress data blocks of a file. ZSTD digests the dictionary once, when it is
+// created, instead of once per compressed block. Also holds the compression context, so it should
+// be used by one thread at a time.
+class CompressionDict {
+ public:
+  // dict should outlive this object.
+  CompressionDict(const Slice& dict, int level) : dict_(dict) {
+#ifdef ZSTD
+    if (!dict_.empty()) {
+      cdict_ = ZSTD_createCDict(dict_.data(), dict_.size(), level);
+      context_ = ZSTD_createCCtx();
+    }
+#endif
+  }
+
+  CompressionDict(const CompressionDict&) = delete;
+  void operator=(const CompressionDict&) = delete;
+
+  ~CompressionDict() {
+#ifdef ZSTD
+    if (cdict_) {
+      ZSTD_freeCDict(cdict_);
+    }
+    if (context_) {
+      ZSTD_freeCCtx(context_);
+    }
+#endif
+  }
+
+  // Raw dictionary, that should be stored in the file, so blocks could be uncompressed.
+  const Slice& raw() const { return dict_; }
+
+  bool empty() const { return dict_.empty(); }
+
+#ifdef ZSTD
+  ZSTD_CDict* zstd_cdict() const { return cdict_; }
+  ZSTD_CCtx* zstd_context() const { return context_; }
+#endif
+
+ private:
+  const Slice dict_;
+#ifdef ZSTD
+  ZSTD_CDict* cdict_ = nullptr;
+  ZSTD_CCtx* context_ = nullptr;
+#endif
+};
+
+// Dictionary used to uncompress data blocks of a file, digested by ZSTD once when the file is
+// opened. Could be used by several threads concurrently.
+class UncompressionDict {
+ public:
+  explicit UncompressionDict(std::string dict) : dict_(std::move(dict)) {
+#ifdef ZSTD
+    if (!dict_.empty()) {
+      ddict_ = ZSTD_createDDict(dict_.data(), dict_.size());
+    }
+#endif
+  }
+
+  UncompressionDict(const UncompressionDict&) = delete;
+  void operator=(const UncompressionDict&) = delete;
+
+  ~UncompressionDict() {
+#ifdef ZSTD
+    if (ddict_) {
+      ZSTD_freeDDict(ddict_);
+    }
+#endif
+  }
+
+  const std::string& raw() const { return dict_; }
+
+  bool empty() const { return dict_.empty(); }
+
+#ifdef ZSTD
+  ZSTD_DDict* zstd_ddict() const { return ddict_; }
+#endif
+
+ private:
+  const std::string dict_;
+#ifdef ZSTD
+  ZSTD_DDict* ddict_ = nullptr;
+#endif
+};
+
+#ifdef ZSTD
+// Decompression context that is reused by all dictionary decompressions of the current thread.
+inline ZSTD_DCtx* ThreadLocalZSTDDecompressionContext() {
+  struct ContextHolder {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+
+    ~ContextHolder() {
+      ZSTD_freeDCtx(context);
+    }
+  };
+  static thread_local ContextHolder holder;
+  return holder.context;
+}
+#endif
+
+// When compression_dict is not null and not empty, it is used as the dictionary. The same
+// dictionary should be passed to ZSTD_Uncompress.
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const CompressionDict* compression_dict = nullptr) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +740,18 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  size_t outlen;
+  if (!compression_dict || compression_dict->empty()) {
+    outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
+                           input, length, opts.level);
+  } else if (!compression_dict->zstd_cdict() || !compression_dict->zstd_context()) {
+    return false;
+  } else {
+    outlen = ZSTD_compress_usingCDict(
+        compression_dict->zstd_context(), &(*output)[output_header_len], compressBound, input,
+        length, compression_dict->zstd_cdict());
+  }
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -645,7 +761,8 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 }
 
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const UncompressionDict* compression_dict = nullptr) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -654,8 +771,21 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   }
 
   char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
+  size_t actual_output_length;
+  if (!compression_dict || compression_dict->empty()) {
+    actual_output_length = ZSTD_decompress(output, output_len, input_data, input_length);
+  } else if (!compression_dict->zstd_ddict()) {
+    delete[] output;
+    return nullptr;
+  } else {
+    actual_output_length = ZSTD_decompress_usingDDict(
+        ThreadLocalZSTDDecompressionContext(), output, output_len, input_data, input_length,
+        compression_dict->zstd_ddict());
+  }
+  if (ZSTD_isError(actual_output_length)) {
+    delete[] output;
+    return nullptr;
+  }
   assert(actual_output_length == output_len);
   *decompress_size = static_cast<int>(actual_output_length);
   return output;
@@ -663,4 +793,24 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   return nullptr;
 }
 
+// Trains dictionary of at most max_dict_bytes for compression of data similar to the samples.
+// samples contains all samples concatenated, sample_lengths contains size of each of them.
+// Returns empty string if dictionary could not be trained.
+inline std::string ZSTD_TrainDictionary(const std::string& samples,
+                                        const std::vector<size_t>& sample_lengths,
+                                        size_t max_dict_bytes) {
+#ifdef ZSTD
+  std::string dict_data(max_dict_bytes, '\0');
+  size_t dict_len = ZDICT_trainFromBuffer(
+      &dict_data[0], max_dict_bytes, samples.data(), sample_lengths.data(),
+      static_cast<unsigned>(sample_lengths.size()));
+  if (ZDICT_isError(dict_len)) {
+    return std::string();
+  }
+  dict_data.resize(dict_len);
+  return dict_data;
+#endif
+  return std::string();
+}
+
 }  // namespace rocksdb
@@ -84,6 +84,27 @@ Status RandomAccessFileReader::ReadAndValidate(
   return s;
 }
 
+Status FilePrefetchBuffer::Prefetch(RandomAccessFileReader* reader, uint64_t offset, size_t n) {
+  if (n > capacity_) {
+    buffer_.reset(new char[n]);
+    capacity_ = n;
+  }
+  data_ = Slice();
+  Slice result;
+  RETURN_NOT_OK(reader->Read(offset, n, &result, buffer_.get()));
+  offset_ = offset;
+  data_ = result;
+  return Status::OK();
+}
+
+bool FilePrefetchBuffer::TryRead(uint64_t offset, size_t n, char* buf) const {
+  if (!Contains(offset, n)) {
+    return false;
+  }
+  memcpy(buf, data_.cdata() + (offset - offset_), n);
+  return true;
+}
+
 Status WritableFileWriter::Append(const Slice& data) {
   const char* src = data.cdata();
   size_t left = data.size();
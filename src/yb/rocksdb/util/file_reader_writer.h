@@ -114,6 +114,29 @@ class RandomAccessFileReader {
   RandomAccessFile* file() { return file_.get(); }
 };
 
+// Keeps a single contiguous range of the file read ahead of time, so a sequence of small
+// adjacent reads could be served by one large read.
+class FilePrefetchBuffer {
+ public:
+  // Reads up to n bytes at offset into the buffer, replacing previously prefetched data.
+  // Read could return less than n bytes near the end of the file.
+  CHECKED_STATUS Prefetch(RandomAccessFileReader* reader, uint64_t offset, size_t n);
+
+  // Returns true if the whole [offset, offset + n) range was prefetched.
+  bool Contains(uint64_t offset, size_t n) const {
+    return offset >= offset_ && offset + n <= offset_ + data_.size();
+  }
+
+  // Copies n bytes at offset to buf, returns false if the range was not prefetched.
+  bool TryRead(uint64_t offset, size_t n, char* buf) const;
+
+ private:
+  std::unique_ptr<char[]> buffer_;
+  size_t capacity_ = 0;
+  uint64_t offset_ = 0;
+  Slice data_;
+};
+
 // Use posix write to write data to a file.
 class WritableFileWriter {
  private:
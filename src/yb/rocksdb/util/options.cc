@@ -81,6 +81,8 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       compression(options.compression),
       compression_per_level(options.compression_per_level),
       compression_opts(options.compression_opts),
+      large_compaction_compression(options.large_compaction_compression),
+      large_compaction_compression_threshold(options.large_compaction_compression_threshold),
       level_compaction_dynamic_level_bytes(
           options.level_compaction_dynamic_level_bytes),
       access_hint_on_compaction_start(options.access_hint_on_compaction_start),
@@ -105,6 +107,8 @@ ColumnFamilyOptions::ColumnFamilyOptions()
       min_write_buffer_number_to_merge(1),
       max_write_buffer_number_to_maintain(0),
       compression(Snappy_Supported() ? kSnappyCompression : kNoCompression),
+      large_compaction_compression(kNoCompression),
+      large_compaction_compression_threshold(0),
       prefix_extractor(nullptr),
       num_levels(7),
       level0_file_num_compaction_trigger(4),
@@ -164,6 +168,8 @@ ColumnFamilyOptions::ColumnFamilyOptions(const Options& options)
       compression(options.compression),
       compression_per_level(options.compression_per_level),
       compression_opts(options.compression_opts),
+      large_compaction_compression(options.large_compaction_compression),
+      large_compaction_compression_threshold(options.large_compaction_compression_threshold),
       prefix_extractor(options.prefix_extractor),
       num_levels(options.num_levels),
       level0_file_num_compaction_trigger(
@@ -283,12 +289,14 @@ DBOptions::DBOptions()
       enable_thread_tracking(false),
       delayed_write_rate(2 * 1024U * 1024U),
       allow_concurrent_memtable_write(false),
+      parallel_memtable_insert_part_size(0),
       enable_write_thread_adaptive_yield(false),
       write_thread_max_yield_usec(100),
       write_thread_slow_yield_usec(3),
       skip_stats_update_on_db_open(false),
       wal_recovery_mode(WALRecoveryMode::kTolerateCorruptedTailRecords),
       row_cache(nullptr),
+      table_cache(nullptr),
 #ifndef ROCKSDB_LITE
       wal_filter(nullptr),
 #endif  // ROCKSDB_LITE
@@ -401,6 +409,8 @@ void DBOptions::Dump(Logger* log) const {
       enable_thread_tracking);
   RHEADER(log, "         Options.allow_concurrent_memtable_write: %d",
       allow_concurrent_memtable_write);
+  RHEADER(log, "      Options.parallel_memtable_insert_part_size: %" ROCKSDB_PRIszt,
+      parallel_memtable_insert_part_size);
   RHEADER(log, "      Options.enable_write_thread_adaptive_yield: %d",
       enable_write_thread_adaptive_yield);
   RHEADER(log, "             Options.write_thread_max_yield_usec: %" PRIu64,
@@ -413,6 +423,12 @@ void DBOptions::Dump(Logger* log) const {
     } else {
       RHEADER(log, "                               Options.row_cache: None");
     }
+    if (table_cache) {
+      RHEADER(log, "                             Options.table_cache: %" ROCKSDB_PRIszt,
+          table_cache->GetCapacity());
+    } else {
+      RHEADER(log, "                             Options.table_cache: None");
+    }
   RHEADER(log, "                           Options.initial_seqno: %" PRIu64, initial_seqno);
 #ifndef ROCKSDB_LITE
   RHEADER(log, "       Options.wal_filter: %s",
@@ -457,6 +473,14 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compression_opts.level);
   RHEADER(log, "              Options.compression_opts.strategy: %d",
       compression_opts.strategy);
+  RHEADER(log, "        Options.compression_opts.max_dict_bytes: %" PRIu32,
+      compression_opts.max_dict_bytes);
+  RHEADER(log, "  Options.compression_opts.zstd_max_train_bytes: %" PRIu32,
+      compression_opts.zstd_max_train_bytes);
+  RHEADER(log, "          Options.large_compaction_compression: %s",
+      CompressionTypeToString(large_compaction_compression).c_str());
+  RHEADER(log, "Options.large_compaction_compression_threshold: %" PRIu64,
+      large_compaction_compression_threshold);
   RHEADER(log, "     Options.level0_file_num_compaction_trigger: %d",
       level0_file_num_compaction_trigger);
   RHEADER(log, "         Options.level0_slowdown_writes_trigger: %d",
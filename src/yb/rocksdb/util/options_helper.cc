@@ -372,6 +372,10 @@ bool ParseOptionHelper(char* opt_address, const OptionType& opt_type,
       return ParseEnum<IndexType>(
           block_base_table_index_type_string_map, value,
           reinterpret_cast<IndexType*>(opt_address));
+    case OptionType::kKeyValueEncodingFormat:
+      return ParseEnum<KeyValueEncodingFormat>(
+          key_value_encoding_format_string_map, value,
+          reinterpret_cast<KeyValueEncodingFormat*>(opt_address));
     case OptionType::kEncodingType:
       return ParseEnum<EncodingType>(
           encoding_type_string_map, value,
@@ -513,6 +517,11 @@ bool SerializeSingleOptionHelper(const char* opt_address,
           block_base_table_index_type_string_map,
           *reinterpret_cast<const IndexType*>(opt_address),
           value);
+    case OptionType::kKeyValueEncodingFormat:
+      return SerializeEnum<KeyValueEncodingFormat>(
+          key_value_encoding_format_string_map,
+          *reinterpret_cast<const KeyValueEncodingFormat*>(opt_address),
+          value);
     case OptionType::kFlushBlockPolicyFactory: {
       const auto* ptr =
           reinterpret_cast<const std::shared_ptr<FlushBlockPolicyFactory>*>(
@@ -824,8 +833,20 @@ Status ParseColumnFamilyOption(const std::string& name,
         return STATUS(InvalidArgument,
             "unable to parse the specified CF option " + name);
       }
+      end = value.find(':', start);
       new_options->compression_opts.strategy =
-          ParseInt(value.substr(start, value.size() - start));
+          ParseInt(value.substr(start, end - start));
+      // max_dict_bytes and zstd_max_train_bytes are optional, for backward compatibility.
+      if (end != std::string::npos) {
+        start = end + 1;
+        end = value.find(':', start);
+        new_options->compression_opts.max_dict_bytes =
+            ParseUint32(value.substr(start, end - start));
+        if (end != std::string::npos) {
+          new_options->compression_opts.zstd_max_train_bytes =
+              ParseUint32(value.substr(end + 1));
+        }
+      }
     } else if (name == "compaction_options_fifo") {
       new_options->compaction_options_fifo.max_table_files_size =
           ParseUint64(value);
@@ -1056,6 +1077,9 @@ std::string ParseBlockBasedTableOption(const std::string& name,
     } else if (name == "block_cache_compressed") {
       new_options->block_cache_compressed = NewLRUCache(ParseSizeT(value));
       return "";
+    } else if (name == "index_and_filter_block_cache") {
+      new_options->index_and_filter_block_cache = NewLRUCache(ParseSizeT(value));
+      return "";
     } else if (name == "filter_policy") {
       // Expect the following format
       // bloomfilter:int:bool
@@ -107,6 +107,7 @@ enum class OptionType {
   kMergeOperator,
   kMemTableRepFactory,
   kBlockBasedTableIndexType,
+  kKeyValueEncodingFormat,
   kFilterPolicy,
   kFlushBlockPolicyFactory,
   kChecksumType,
@@ -320,6 +321,9 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"allow_concurrent_memtable_write",
      {offsetof(struct DBOptions, allow_concurrent_memtable_write),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"parallel_memtable_insert_part_size",
+     {offsetof(struct DBOptions, parallel_memtable_insert_part_size),
+      OptionType::kSizeT, OptionVerificationType::kNormal}},
     {"wal_recovery_mode",
      {offsetof(struct DBOptions, wal_recovery_mode),
       OptionType::kWALRecoveryMode, OptionVerificationType::kNormal}},
@@ -485,6 +489,12 @@ static std::unordered_map<std::string, OptionTypeInfo> cf_options_type_info = {
     {"compression_per_level",
      {offsetof(struct ColumnFamilyOptions, compression_per_level),
       OptionType::kVectorCompressionType, OptionVerificationType::kNormal}},
+    {"large_compaction_compression",
+     {offsetof(struct ColumnFamilyOptions, large_compaction_compression),
+      OptionType::kCompressionType, OptionVerificationType::kNormal}},
+    {"large_compaction_compression_threshold",
+     {offsetof(struct ColumnFamilyOptions, large_compaction_compression_threshold),
+      OptionType::kUInt64T, OptionVerificationType::kNormal}},
     {"comparator",
      {offsetof(struct ColumnFamilyOptions, comparator), OptionType::kComparator,
       OptionVerificationType::kByName}},
@@ -515,6 +525,10 @@ static std::unordered_map<std::string,
     /* currently not supported
       std::shared_ptr<Cache> block_cache = nullptr;
       std::shared_ptr<Cache> block_cache_compressed = nullptr;
+      std::shared_ptr<Cache> index_and_filter_block_cache = nullptr;
+      std::shared_ptr<PersistentCache> persistent_cache = nullptr;
+      std::shared_ptr<const KeySuffixExtractor> data_block_key_suffix_extractor;
+      std::shared_ptr<const DataBlockHashKeyExtractor> data_block_hash_key_extractor;
      */
     {"flush_block_policy_factory",
      {offsetof(struct BlockBasedTableOptions, flush_block_policy_factory),
@@ -555,6 +569,15 @@ static std::unordered_map<std::string,
     {"min_keys_per_index_block",
      {offsetof(struct BlockBasedTableOptions, min_keys_per_index_block), OptionType::kSizeT,
       OptionVerificationType::kNormal}},
+    {"max_auto_readahead_size",
+     {offsetof(struct BlockBasedTableOptions, max_auto_readahead_size), OptionType::kSizeT,
+      OptionVerificationType::kNormal}},
+    {"data_block_key_value_encoding_format",
+     {offsetof(struct BlockBasedTableOptions, data_block_key_value_encoding_format),
+      OptionType::kKeyValueEncodingFormat, OptionVerificationType::kNormal}},
+    {"data_block_hash_table_util_ratio",
+     {offsetof(struct BlockBasedTableOptions, data_block_hash_table_util_ratio),
+      OptionType::kDouble, OptionVerificationType::kNormal}},
     {"filter_policy",
      {offsetof(struct BlockBasedTableOptions, filter_policy),
       OptionType::kFilterPolicy, OptionVerificationType::kByName}},
@@ -610,6 +633,12 @@ static std::unordered_map<std::string, IndexType>
         {"kHashSearch", IndexType::kHashSearch},
         {"kMultiLevelBinarySearch", IndexType::kMultiLevelBinarySearch}};
 
+static std::unordered_map<std::string, KeyValueEncodingFormat>
+    key_value_encoding_format_string_map = {
+        {"kKeyDeltaEncodingSharedPrefix", KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix},
+        {"kKeyDeltaEncodingSharedPrefixAndSuffix",
+         KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefixAndSuffix}};
+
 static std::unordered_map<std::string, EncodingType> encoding_type_string_map =
     {{"kPlain", kPlain}, {"kPrefix", kPrefix}};
 
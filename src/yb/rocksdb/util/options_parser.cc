@@ -571,6 +571,10 @@ bool AreEqualOptions(
       return (
           *reinterpret_cast<const IndexType*>(offset1) ==
           *reinterpret_cast<const IndexType*>(offset2));
+    case OptionType::kKeyValueEncodingFormat:
+      return (
+          *reinterpret_cast<const KeyValueEncodingFormat*>(offset1) ==
+          *reinterpret_cast<const KeyValueEncodingFormat*>(offset2));
     case OptionType::kWALRecoveryMode:
       return (*reinterpret_cast<const WALRecoveryMode*>(offset1) ==
               *reinterpret_cast<const WALRecoveryMode*>(offset2));
@@ -127,7 +127,9 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
        "kLZ4Compression:"
        "kLZ4HCCompression:"
        "kZSTDNotFinalCompression"},
-      {"compression_opts", "4:5:6"},
+      {"compression_opts", "4:5:6:7:8"},
+      {"large_compaction_compression", "kZlibCompression"},
+      {"large_compaction_compression_threshold", "30"},
       {"num_levels", "7"},
       {"level0_file_num_compaction_trigger", "8"},
       {"level0_slowdown_writes_trigger", "9"},
@@ -223,6 +225,10 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
   ASSERT_EQ(new_cf_opt.compression_opts.window_bits, 4);
   ASSERT_EQ(new_cf_opt.compression_opts.level, 5);
   ASSERT_EQ(new_cf_opt.compression_opts.strategy, 6);
+  ASSERT_EQ(new_cf_opt.compression_opts.max_dict_bytes, 7U);
+  ASSERT_EQ(new_cf_opt.compression_opts.zstd_max_train_bytes, 8U);
+  ASSERT_EQ(new_cf_opt.large_compaction_compression, kZlibCompression);
+  ASSERT_EQ(new_cf_opt.large_compaction_compression_threshold, 30U);
   ASSERT_EQ(new_cf_opt.num_levels, 7);
   ASSERT_EQ(new_cf_opt.level0_file_num_compaction_trigger, 8);
   ASSERT_EQ(new_cf_opt.level0_slowdown_writes_trigger, 9);
@@ -489,7 +495,7 @@ TEST_F(OptionsTest, GetBlockBasedTableOptionsFromString) {
             "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=4096;"
             "block_size_deviation=8;block_restart_interval=4;index_block_size=16384;"
             "min_keys_per_index_block=16;filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
-            "skip_table_builder_flush=1",
+            "skip_table_builder_flush=1;max_auto_readahead_size=1048576",
             &new_opt));
   ASSERT_TRUE(new_opt.cache_index_and_filter_blocks);
   ASSERT_EQ(new_opt.index_type, IndexType::kHashSearch);
@@ -506,6 +512,7 @@ TEST_F(OptionsTest, GetBlockBasedTableOptionsFromString) {
   ASSERT_EQ(new_opt.block_restart_interval, 4);
   ASSERT_EQ(new_opt.index_block_size, 16384UL);
   ASSERT_EQ(new_opt.min_keys_per_index_block, 16);
+  ASSERT_EQ(new_opt.max_auto_readahead_size, 1048576UL);
   ASSERT_TRUE(new_opt.filter_policy != nullptr);
   ASSERT_TRUE(new_opt.skip_table_builder_flush);
 
@@ -1618,6 +1625,9 @@ Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* des
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=16384;"
       "block_size_deviation=8;block_restart_interval=4; "
       "index_block_restart_interval=4;index_block_size=16384;min_keys_per_index_block=16;"
+      "max_auto_readahead_size=65536;"
+      "data_block_key_value_encoding_format=kKeyDeltaEncodingSharedPrefixAndSuffix;"
+      "data_block_hash_table_util_ratio=0.5;"
       "filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
       "skip_table_builder_flush=1;format_version=1;"
       "hash_index_allow_collision=false;";
@@ -1685,6 +1695,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "advise_random_on_open=true;"
       "fail_if_options_file_error=true;"
       "allow_concurrent_memtable_write=true;"
+      "parallel_memtable_insert_part_size=1000;"
       "wal_recovery_mode=kPointInTimeRecovery;"
       "enable_write_thread_adaptive_yield=true;"
       "write_thread_slow_yield_usec=5;"
@@ -1736,6 +1747,8 @@ Status GetFromString(ColumnFamilyOptions* source, ColumnFamilyOptions* destinati
       "max_bytes_for_level_multiplier=60;"
       "memtable_factory=SkipListFactory;"
       "compression=kNoCompression;"
+      "large_compaction_compression=kZlibCompression;"
+      "large_compaction_compression_threshold=4294971408;"
       "min_partial_merge_operands=7576;"
       "level0_stop_writes_trigger=33;"
       "num_levels=99;"
@@ -1890,6 +1903,10 @@ TEST_F(OptionsParserTest, BlockBasedTableOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(BlockBasedTableOptions, flush_block_policy_factory),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache),
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache_compressed),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, index_and_filter_block_cache),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, persistent_cache),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_key_suffix_extractor),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_hash_key_extractor),
       BLACKLIST_ENTRY(BlockBasedTableOptions, filter_policy),
       BLACKLIST_ENTRY(BlockBasedTableOptions, supported_filter_policies),
   };
@@ -1915,6 +1932,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, env),
       BLACKLIST_ENTRY(DBOptions, checkpoint_env),
       BLACKLIST_ENTRY(DBOptions, priority_thread_pool_for_compactions_and_flushes),
+      BLACKLIST_ENTRY(DBOptions, memtable_insert_thread_pool),
       BLACKLIST_ENTRY(DBOptions, rate_limiter),
       BLACKLIST_ENTRY(DBOptions, sst_file_manager),
       BLACKLIST_ENTRY(DBOptions, info_log),
@@ -1925,6 +1943,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, memory_monitor),
       BLACKLIST_ENTRY(DBOptions, listeners),
       BLACKLIST_ENTRY(DBOptions, row_cache),
+      BLACKLIST_ENTRY(DBOptions, table_cache),
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
       BLACKLIST_ENTRY(DBOptions, mem_table_flush_filter_factory),
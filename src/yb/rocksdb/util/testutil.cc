@@ -210,6 +210,7 @@ void RandomInitDBOptions(DBOptions* db_opt, Random* rnd) {
   db_opt->log_file_time_to_roll = rnd->Uniform(10000);
   db_opt->manifest_preallocation_size = rnd->Uniform(10000);
   db_opt->max_log_file_size = rnd->Uniform(10000);
+  db_opt->parallel_memtable_insert_part_size = rnd->Uniform(10000);
 
   // std::string options
   db_opt->db_log_dir = "path/to/db_log_dir";
@@ -284,6 +285,7 @@ void RandomInitCFOptions(ColumnFamilyOptions* cf_opt, Random* rnd) {
   static const uint64_t uint_max = static_cast<uint64_t>(UINT_MAX);
   cf_opt->max_sequential_skip_in_iterations = uint_max + rnd->Uniform(10000);
   cf_opt->target_file_size_base = uint_max + rnd->Uniform(10000);
+  cf_opt->large_compaction_compression_threshold = uint_max + rnd->Uniform(10000);
 
   // unsigned int options
   cf_opt->rate_limit_delay_max_milliseconds = rnd->Uniform(10000);
@@ -300,6 +302,7 @@ void RandomInitCFOptions(ColumnFamilyOptions* cf_opt, Random* rnd) {
 
   // custom typed options
   cf_opt->compression = RandomCompressionType(rnd);
+  cf_opt->large_compaction_compression = RandomCompressionType(rnd);
   RandomCompressionTypeVector(cf_opt->num_levels,
                               &cf_opt->compression_per_level, rnd);
 }
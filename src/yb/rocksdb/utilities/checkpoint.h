@@ -38,7 +38,10 @@ namespace checkpoint {
   // (2) a copied manifest files and other files
   // The directory should not already exist and will be created by this API.
   // The directory will be an absolute path
-  CHECKED_STATUS CreateCheckpoint(DB* db, const std::string& checkpoint_dir);
+  // If flush_memtable is false, data that is only present in memtables is not included into
+  // the checkpoint.
+  CHECKED_STATUS CreateCheckpoint(
+      DB* db, const std::string& checkpoint_dir, bool flush_memtable = true);
 
 }  // namespace checkpoint
 }  // namespace rocksdb
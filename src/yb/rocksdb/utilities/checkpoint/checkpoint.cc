@@ -52,7 +52,7 @@ namespace checkpoint {
 // (2) a copied manifest files and other files
 // The directory should not already exist and will be created by this API.
 // The directory will be an absolute path
-Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
+Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir, bool flush_memtable) {
   if (!db->GetCheckpointEnv()->IsPlainText()) {
     return STATUS(InvalidArgument, "db's checkpoint env is not plaintext.");
   }
@@ -74,7 +74,7 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
   s = db->DisableFileDeletions();
   if (s.ok()) {
     // this will return live_files prefixed with "/"
-    s = db->GetLiveFiles(live_files, &manifest_file_size, true);
+    s = db->GetLiveFiles(live_files, &manifest_file_size, flush_memtable);
   }
   // if we have more than one column family, we need to also get WAL files
   if (s.ok()) {
@@ -0,0 +1,212 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/persistent_cache.h"
+
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+
+namespace rocksdb {
+
+namespace {
+
+constexpr char kCacheFileSuffix[] = ".pcache";
+
+// Number of files that the cache capacity is split into. Whole file is dropped at once when
+// cache runs out of capacity, so this is also inverse of the fraction of the cache that is evicted
+// at a time.
+constexpr size_t kNumCacheFiles = 16;
+
+// Blocks are appended to the current cache file, and the whole oldest file is removed when
+// the cache is over capacity, so the device only sees sequential writes. Index of cached blocks
+// is kept in memory.
+class FilePersistentCache : public PersistentCache {
+ public:
+  FilePersistentCache(Env* env, const std::string& path, size_t capacity)
+      : env_(env), path_(path), capacity_(capacity),
+        file_size_limit_(std::max<size_t>(capacity / kNumCacheFiles, 1)) {}
+
+  ~FilePersistentCache() {
+    if (writer_) {
+      WARN_NOT_OK(writer_->Close(), "Failed to close persistent cache file");
+    }
+    for (const auto& file : files_) {
+      WARN_NOT_OK(env_->DeleteFile(file->name), "Failed to delete persistent cache file");
+    }
+  }
+
+  CHECKED_STATUS Open() {
+    RETURN_NOT_OK(env_->CreateDirIfMissing(path_));
+    std::vector<std::string> children;
+    RETURN_NOT_OK(env_->GetChildren(path_, &children));
+    for (const auto& child : children) {
+      if (boost::ends_with(child, kCacheFileSuffix)) {
+        RETURN_NOT_OK(env_->DeleteFile(path_ + "/" + child));
+      }
+    }
+    return Status::OK();
+  }
+
+  CHECKED_STATUS Insert(const Slice& key, const Slice& data) override {
+    if (data.size() > file_size_limit_) {
+      return STATUS_FORMAT(InvalidArgument, "Block of $0 bytes is too big for persistent cache",
+                           data.size());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!writer_ || files_.back()->size + data.size() > file_size_limit_) {
+      RETURN_NOT_OK(NewFileUnlocked());
+    }
+    auto& file = files_.back();
+    RETURN_NOT_OK(writer_->Append(data));
+    // Flush, so the block could be read back through the file reader.
+    RETURN_NOT_OK(writer_->Flush());
+
+    auto key_str = key.ToBuffer();
+    auto& location = index_[key_str];
+    location = Location{file, file->size, data.size()};
+    file->keys.push_back(std::move(key_str));
+    file->size += data.size();
+    usage_ += data.size();
+
+    while (usage_ > capacity_ && files_.size() > 1) {
+      DropOldestFileUnlocked();
+    }
+    return Status::OK();
+  }
+
+  CHECKED_STATUS Lookup(const Slice& key, size_t size, char* buf) override {
+    Location location;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key.ToBuffer());
+      if (it == index_.end() || it->second.size != size) {
+        return STATUS(NotFound, "");
+      }
+      location = it->second;
+    }
+
+    // Read outside of the mutex, the file is kept alive by the shared pointer even if it was
+    // dropped from the cache meanwhile.
+    Slice result;
+    RETURN_NOT_OK(location.file->reader->Read(
+        location.offset, size, &result, reinterpret_cast<uint8_t*>(buf)));
+    if (result.size() != size) {
+      return STATUS_FORMAT(Corruption, "Truncated read from persistent cache file $0: $1 vs $2",
+                           location.file->name, result.size(), size);
+    }
+    if (result.cdata() != buf) {
+      memcpy(buf, result.cdata(), size);
+    }
+    return Status::OK();
+  }
+
+  uint64_t NewId() override {
+    return last_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+  size_t GetUsage() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+  }
+
+ private:
+  struct CacheFile {
+    std::string name;
+    std::unique_ptr<RandomAccessFile> reader;
+    // Keys of blocks stored in this file, used to clean up index when file is dropped.
+    std::vector<std::string> keys;
+    size_t size = 0;
+  };
+
+  struct Location {
+    std::shared_ptr<CacheFile> file;
+    size_t offset;
+    size_t size;
+  };
+
+  CHECKED_STATUS NewFileUnlocked() {
+    if (writer_) {
+      RETURN_NOT_OK(writer_->Close());
+      writer_.reset();
+    }
+    auto file = std::make_shared<CacheFile>();
+    file->name = yb::Format("$0/$1$2", path_, ++last_file_number_, kCacheFileSuffix);
+    EnvOptions env_options;
+    RETURN_NOT_OK(env_->NewWritableFile(file->name, &writer_, env_options));
+    auto status = env_->NewRandomAccessFile(file->name, &file->reader, env_options);
+    if (!status.ok()) {
+      writer_.reset();
+      env_->CleanupFile(file->name);
+      return status;
+    }
+    files_.push_back(std::move(file));
+    return Status::OK();
+  }
+
+  void DropOldestFileUnlocked() {
+    auto file = std::move(files_.front());
+    files_.pop_front();
+    for (const auto& key : file->keys) {
+      auto it = index_.find(key);
+      // The key could be inserted again into a newer file.
+      if (it != index_.end() && it->second.file == file) {
+        index_.erase(it);
+      }
+    }
+    usage_ -= file->size;
+    env_->CleanupFile(file->name);
+  }
+
+  Env* const env_;
+  const std::string path_;
+  const size_t capacity_;
+  const size_t file_size_limit_;
+  std::atomic<uint64_t> last_id_{0};
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Location> index_;
+  std::deque<std::shared_ptr<CacheFile>> files_;
+  std::unique_ptr<WritableFile> writer_;
+  uint64_t last_file_number_ = 0;
+  size_t usage_ = 0;
+};
+
+} // namespace
+
+Status NewFilePersistentCache(Env* env, const std::string& path, size_t capacity,
+                              std::shared_ptr<PersistentCache>* result) {
+  if (capacity == 0) {
+    return STATUS(InvalidArgument, "Persistent cache capacity should be positive");
+  }
+  auto cache = std::make_shared<FilePersistentCache>(env, path, capacity);
+  RETURN_NOT_OK(cache->Open());
+  *result = std::move(cache);
+  return Status::OK();
+}
+
+} // namespace rocksdb
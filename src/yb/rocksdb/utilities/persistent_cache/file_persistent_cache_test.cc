@@ -0,0 +1,100 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/persistent_cache.h"
+#include "yb/rocksdb/util/testharness.h"
+
+#include "yb/util/test_macros.h"
+
+namespace rocksdb {
+
+class FilePersistentCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = test::TmpDir() + "/file_persistent_cache_test";
+  }
+
+  std::string Lookup(PersistentCache* cache, const std::string& key, size_t size) {
+    std::string result(size, 0);
+    if (!cache->Lookup(key, size, &result[0]).ok()) {
+      return std::string();
+    }
+    return result;
+  }
+
+  std::string path_;
+};
+
+TEST_F(FilePersistentCacheTest, InsertAndLookup) {
+  std::shared_ptr<PersistentCache> cache;
+  ASSERT_OK(NewFilePersistentCache(Env::Default(), path_, 1024 * 1024, &cache));
+
+  ASSERT_OK(cache->Insert("a", "block_a"));
+  ASSERT_OK(cache->Insert("b", "block_b"));
+  ASSERT_EQ("block_a", Lookup(cache.get(), "a", 7));
+  ASSERT_EQ("block_b", Lookup(cache.get(), "b", 7));
+  ASSERT_EQ("", Lookup(cache.get(), "c", 7));
+  // Size mismatch is reported as a miss.
+  ASSERT_EQ("", Lookup(cache.get(), "a", 6));
+
+  ASSERT_OK(cache->Insert("a", "new_block_a"));
+  ASSERT_EQ("new_block_a", Lookup(cache.get(), "a", 11));
+  ASSERT_EQ(25U, cache->GetUsage());
+}
+
+TEST_F(FilePersistentCacheTest, Eviction) {
+  constexpr size_t kCapacity = 16 * 1024;
+  constexpr size_t kBlockSize = 100;
+  constexpr int kNumBlocks = 1000;
+
+  std::shared_ptr<PersistentCache> cache;
+  ASSERT_OK(NewFilePersistentCache(Env::Default(), path_, kCapacity, &cache));
+
+  auto block = [](int i) {
+    return std::string(kBlockSize, static_cast<char>('a' + i % 26));
+  };
+
+  for (int i = 0; i != kNumBlocks; ++i) {
+    ASSERT_OK(cache->Insert(std::to_string(i), block(i)));
+    ASSERT_LE(cache->GetUsage(), kCapacity);
+  }
+
+  // Oldest blocks are evicted, while the most recent ones are still in the cache.
+  ASSERT_EQ("", Lookup(cache.get(), "0", kBlockSize));
+  for (int i = kNumBlocks - 100; i != kNumBlocks; ++i) {
+    ASSERT_EQ(block(i), Lookup(cache.get(), std::to_string(i), kBlockSize));
+  }
+}
+
+TEST_F(FilePersistentCacheTest, CleanupOnOpen) {
+  {
+    std::shared_ptr<PersistentCache> cache;
+    ASSERT_OK(NewFilePersistentCache(Env::Default(), path_, 1024 * 1024, &cache));
+    ASSERT_OK(cache->Insert("a", "block_a"));
+  }
+  std::shared_ptr<PersistentCache> cache;
+  ASSERT_OK(NewFilePersistentCache(Env::Default(), path_, 1024 * 1024, &cache));
+  ASSERT_EQ("", Lookup(cache.get(), "a", 7));
+  ASSERT_EQ(0U, cache->GetUsage());
+}
+
+} // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -261,6 +261,10 @@ class WriteBatch : public WriteBatchBase {
   // Performs deferred computation of content_flags if necessary
   uint32_t ComputeContentFlags() const;
 
+  // Iterates over records in input, that is a part of rep_ starting at record boundary.
+  // found is incremented by the number of iterated updates.
+  CHECKED_STATUS IterateRecords(Slice input, Handler* handler, size_t* found) const;
+
  protected:
   std::string rep_;  // See comment in write_batch.cc for the format of rep_
   const UserFrontiers* frontiers_ = nullptr;
@@ -0,0 +1,89 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/rpc/circular_read_buffer.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_bool(rpc_pool_idle_read_buffers);
+
+namespace yb {
+namespace rpc {
+
+constexpr size_t kCapacity = 0x100;
+
+class CircularReadBufferTest : public YBTest {
+ protected:
+  MemTrackerPtr tracker_ = MemTracker::FindOrCreateTracker("CircularReadBufferTest");
+};
+
+TEST_F(CircularReadBufferTest, ReleaseWhenEmpty) {
+  CircularReadBuffer buffer(kCapacity, tracker_);
+  auto receive_tracker = MemTracker::FindOrCreateTracker("Receive", tracker_, AddToParent::kFalse);
+  ASSERT_FALSE(buffer.Allocated());
+  ASSERT_EQ(receive_tracker->consumption(), 0);
+
+  auto iov = ASSERT_RESULT(buffer.PrepareAppend());
+  ASSERT_EQ(iov.size(), 1U);
+  ASSERT_EQ(iov[0].iov_len, kCapacity);
+  ASSERT_TRUE(buffer.Allocated());
+  ASSERT_EQ(receive_tracker->consumption(), static_cast<int64_t>(kCapacity));
+
+  // Nothing was received, so buffer is released.
+  buffer.ReleaseIfEmpty();
+  ASSERT_FALSE(buffer.Allocated());
+  ASSERT_EQ(receive_tracker->consumption(), 0);
+
+  iov = ASSERT_RESULT(buffer.PrepareAppend());
+  memset(iov[0].iov_base, 'X', 10);
+  buffer.DataAppended(10);
+  buffer.ReleaseIfEmpty();
+  ASSERT_TRUE(buffer.Allocated());
+
+  buffer.Consume(4, Slice());
+  ASSERT_TRUE(buffer.Allocated());
+  auto appended = buffer.AppendedVecs();
+  ASSERT_EQ(appended.size(), 1U);
+  ASSERT_EQ(Slice(static_cast<const uint8_t*>(appended[0].iov_base), appended[0].iov_len),
+            Slice(std::string(6, 'X')));
+
+  // Buffer becomes empty, so it is returned to the pool.
+  buffer.Consume(6, Slice());
+  ASSERT_FALSE(buffer.Allocated());
+  ASSERT_EQ(receive_tracker->consumption(), 0);
+
+  buffer.Reset();
+  ASSERT_NOK(buffer.PrepareAppend());
+}
+
+TEST_F(CircularReadBufferTest, NoPooling) {
+  FLAGS_rpc_pool_idle_read_buffers = false;
+  CircularReadBuffer buffer(kCapacity, tracker_);
+  ASSERT_TRUE(buffer.Allocated());
+
+  ASSERT_RESULT(buffer.PrepareAppend());
+  buffer.DataAppended(10);
+  buffer.Consume(10, Slice());
+  buffer.ReleaseIfEmpty();
+  ASSERT_TRUE(buffer.Allocated());
+
+  buffer.Reset();
+  ASSERT_FALSE(buffer.Allocated());
+  ASSERT_NOK(buffer.PrepareAppend());
+}
+
+} // namespace rpc
+} // namespace yb
@@ -13,13 +13,77 @@
 
 #include "yb/rpc/circular_read_buffer.h"
 
+#include <map>
+#include <mutex>
+
+#include "yb/rpc/growable_buffer.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(rpc_pool_idle_read_buffers, true,
+            "Take read buffers of connections from the shared pool only while they have data, "
+            "so idle connections do not hold read buffers.");
+TAG_FLAG(rpc_pool_idle_read_buffers, advanced);
+
 namespace yb {
 namespace rpc {
 
+namespace {
+
+// Returns pool of read buffers with specified capacity. Pools are never destroyed, since
+// connections could outlive any other object.
+GrowableBufferAllocator* ReadBufferPool(size_t capacity) {
+  static std::mutex mutex;
+  static auto* pools = new std::map<size_t, std::unique_ptr<GrowableBufferAllocator>>();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& pool = (*pools)[capacity];
+  if (!pool) {
+    auto pools_tracker = MemTracker::FindOrCreateTracker("Read Buffer Pool");
+    pool = std::make_unique<GrowableBufferAllocator>(
+        capacity, MemTracker::FindOrCreateTracker(std::to_string(capacity), pools_tracker));
+  }
+  return pool.get();
+}
+
+} // namespace
+
 CircularReadBuffer::CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker)
     : consumption_(MemTracker::FindOrCreateTracker("Receive", parent_tracker, AddToParent::kFalse),
-                   capacity),
-      buffer_(static_cast<char*>(malloc(capacity))), capacity_(capacity) {
+                   0),
+      allocator_(FLAGS_rpc_pool_idle_read_buffers ? ReadBufferPool(capacity) : nullptr),
+      capacity_(capacity) {
+  if (!allocator_) {
+    EnsureAllocated();
+  }
+}
+
+CircularReadBuffer::~CircularReadBuffer() {
+  ReleaseBuffer();
+}
+
+void CircularReadBuffer::EnsureAllocated() {
+  if (buffer_) {
+    return;
+  }
+  if (allocator_) {
+    buffer_.reset(reinterpret_cast<char*>(allocator_->Allocate(/* forced= */ true)));
+  } else {
+    buffer_.reset(static_cast<char*>(malloc(capacity_)));
+  }
+  consumption_.Reset(capacity_);
+}
+
+void CircularReadBuffer::ReleaseBuffer() {
+  if (!buffer_) {
+    return;
+  }
+  if (allocator_) {
+    allocator_->Free(reinterpret_cast<uint8_t*>(buffer_.release()), /* was_forced= */ true);
+  } else {
+    buffer_.reset();
+  }
+  consumption_.Reset(0);
 }
 
 bool CircularReadBuffer::Empty() {
@@ -27,13 +91,21 @@ bool CircularReadBuffer::Empty() {
 }
 
 void CircularReadBuffer::Reset() {
-  buffer_.reset();
+  reset_ = true;
+  ReleaseBuffer();
+}
+
+void CircularReadBuffer::ReleaseIfEmpty() {
+  if (allocator_ && size_ == 0) {
+    ReleaseBuffer();
+  }
 }
 
 Result<IoVecs> CircularReadBuffer::PrepareAppend() {
-  if (!buffer_) {
+  if (reset_) {
     return STATUS(IllegalState, "Read buffer was reset");
   }
+  EnsureAllocated();
 
   IoVecs result;
 
@@ -59,7 +131,8 @@ Result<IoVecs> CircularReadBuffer::PrepareAppend() {
 }
 
 std::string CircularReadBuffer::ToString() const {
-  return Format("{ capacity: $0 pos: $1 size: $2 }", capacity_, pos_, size_);
+  return Format("{ capacity: $0 pos: $1 size: $2 allocated: $3 }",
+                capacity_, pos_, size_, Allocated());
 }
 
 void CircularReadBuffer::DataAppended(size_t len) {
@@ -95,12 +168,14 @@ void CircularReadBuffer::Consume(size_t count, const Slice& prepend) {
     pos_ -= capacity_;
   }
   size_ -= count;
-  if (size_ == 0) {
-    pos_ = 0;
-  }
   DCHECK(prepend_.empty());
   prepend_ = prepend;
   had_prepend_ = !prepend.empty();
+  if (size_ == 0) {
+    pos_ = 0;
+    // Prepend points to memory of the call, so buffer is not required to fill it.
+    ReleaseIfEmpty();
+  }
 }
 
 bool CircularReadBuffer::ReadyToRead() {
@@ -21,6 +21,8 @@
 namespace yb {
 namespace rpc {
 
+class GrowableBufferAllocator;
+
 struct FreeMemory {
   void operator()(void* data) const {
     free(data);
@@ -28,9 +30,14 @@ struct FreeMemory {
 };
 
 // StreamReadBuffer implementation that is based on circular buffer of fixed capacity.
+//
+// When rpc_pool_idle_read_buffers is set, memory is taken from the process wide pool of buffers
+// of the same capacity, when data is about to be received, and returned to the pool as soon as
+// buffer becomes empty. So idle connections do not hold read buffers.
 class CircularReadBuffer : public StreamReadBuffer {
  public:
   explicit CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker);
+  ~CircularReadBuffer();
 
   bool ReadyToRead() override;
   bool Empty() override;
@@ -41,11 +48,22 @@ class CircularReadBuffer : public StreamReadBuffer {
   IoVecs AppendedVecs() override;
   bool Full() override;
   void Consume(size_t count, const Slice& prepend) override;
+  void ReleaseIfEmpty() override;
+
+  bool Allocated() const {
+    return buffer_ != nullptr;
+  }
 
  private:
+  void EnsureAllocated();
+  void ReleaseBuffer();
+
   ScopedTrackedConsumption consumption_;
+  // Pool of buffers with our capacity, null when buffers are not pooled.
+  GrowableBufferAllocator* const allocator_;
   std::unique_ptr<char, FreeMemory> buffer_;
   const size_t capacity_;
+  bool reset_ = false;
   size_t pos_ = 0;
   size_t size_ = 0;
   Slice prepend_;
@@ -0,0 +1,514 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/compressed_stream.h"
+
+#include <lz4.h>
+
+#include "yb/gutil/endian.h"
+
+#include "yb/rpc/circular_read_buffer.h"
+#include "yb/rpc/outbound_data.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
+
+DEFINE_int32(rpc_compression_min_frame_size, 512,
+             "Frames smaller than this number of bytes are sent by compressed stream as is.");
+
+METRIC_DEFINE_counter(server, rpc_compression_bytes_sent,
+                      "RPC Compression Bytes Sent",
+                      yb::MetricUnit::kBytes,
+                      "Number of bytes sent to the network by compressed streams.");
+
+METRIC_DEFINE_counter(server, rpc_compression_bytes_saved,
+                      "RPC Compression Bytes Saved",
+                      yb::MetricUnit::kBytes,
+                      "Number of bytes saved by compressed streams, i.e. difference between "
+                      "original size of sent data and size of data sent to the network.");
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+// Sent by connecting side before any other data. Differs from the YB RPC connection header in the
+// third byte, so plain connections are detected by accepting side at once.
+const char kCompressionHeader[] = { 'Y', 'B', 'Z', 1 };
+constexpr size_t kCompressionHeaderSize = sizeof(kCompressionHeader);
+
+// Frame header consists of stored size and original size of the frame, both fixed32.
+// Frame is compressed iff stored size is less than original size.
+constexpr size_t kFrameHeaderSize = 8;
+
+// Max original size of the frame. It is much less than the read buffer size, so the whole frame
+// always fits the read buffer.
+constexpr size_t kMaxFrameSize = 64_KB;
+
+class CompressedOutboundData : public OutboundData {
+ public:
+  CompressedOutboundData(RefCntBuffer buffer, OutboundDataPtr lower_data)
+      : buffer_(std::move(buffer)), lower_data_(std::move(lower_data)) {}
+
+  void Transferred(const Status& status, Connection* conn) override {
+    if (lower_data_) {
+      lower_data_->Transferred(status, conn);
+    }
+  }
+
+  bool DumpPB(const DumpRunningRpcsRequestPB& req, RpcCallInProgressPB* resp) override {
+    return lower_data_ && lower_data_->DumpPB(req, resp);
+  }
+
+  void Serialize(boost::container::small_vector_base<RefCntBuffer>* output) override {
+    output->push_back(std::move(buffer_));
+  }
+
+  std::string ToString() const override {
+    return Format("Compressed[$0]", lower_data_);
+  }
+
+  size_t ObjectSize() const override { return sizeof(*this); }
+
+  size_t DynamicMemoryUsage() const override { return DynamicMemoryUsageOf(buffer_, lower_data_); }
+
+ private:
+  RefCntBuffer buffer_;
+  OutboundDataPtr lower_data_;
+};
+
+class CompressedStream : public Stream, public StreamContext {
+ public:
+  CompressedStream(std::unique_ptr<Stream> lower_stream, size_t receive_buffer_size,
+                   const MemTrackerPtr& buffer_tracker,
+                   const scoped_refptr<MetricEntity>& metric_entity)
+      : lower_stream_(std::move(lower_stream)),
+        compressed_read_buffer_(receive_buffer_size, buffer_tracker) {
+    if (metric_entity) {
+      bytes_sent_ = METRIC_rpc_compression_bytes_sent.Instantiate(metric_entity);
+      bytes_saved_ = METRIC_rpc_compression_bytes_saved.Instantiate(metric_entity);
+    }
+  }
+
+  CompressedStream(const CompressedStream&) = delete;
+  void operator=(const CompressedStream&) = delete;
+
+  size_t GetPendingWriteBytes() override {
+    return lower_stream_->GetPendingWriteBytes();
+  }
+
+ private:
+  CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
+  void Close() override;
+  void Shutdown(const Status& status) override;
+  size_t Send(OutboundDataPtr data) override;
+  CHECKED_STATUS TryWrite() override;
+  void ParseReceived() override;
+
+  void Cancelled(size_t handle) override {
+    lower_stream_->Cancelled(handle);
+  }
+
+  bool Idle(std::string* reason_not_idle) override;
+  bool IsConnected() override;
+  void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override;
+
+  const Endpoint& Remote() override;
+  const Endpoint& Local() override;
+
+  const Protocol* GetProtocol() override {
+    return CompressedStreamProtocol();
+  }
+
+  // Implementation StreamContext
+  void UpdateLastActivity() override;
+  void UpdateLastRead() override;
+  void UpdateLastWrite() override;
+  void Transferred(const OutboundDataPtr& data, const Status& status) override;
+  void Destroy(const Status& status) override;
+  Result<ProcessDataResult> ProcessReceived(
+      const IoVecs& data, ReadBufferFull read_buffer_full) override;
+  void Connected() override;
+
+  StreamReadBuffer& ReadBuffer() override {
+    return compressed_read_buffer_;
+  }
+
+  void Established(CompressedState state);
+  void AppendFrame(const char* data, size_t size, faststring* out);
+  Result<size_t> ProcessFrames(const Slice& data);
+  CHECKED_STATUS Decompressed(Slice data);
+
+  std::string ToString() override;
+
+  std::unique_ptr<Stream> lower_stream_;
+  StreamContext* context_ = nullptr;
+  CompressedState state_ = CompressedState::kInitial;
+  bool need_connect_ = false;
+  bool connected_ = false;
+  std::vector<OutboundDataPtr> pending_data_;
+  size_t decompressed_bytes_to_skip_ = 0;
+
+  CircularReadBuffer compressed_read_buffer_;
+  // Used to make frame contiguous when it wraps around the end of the circular read buffer.
+  faststring frame_buffer_;
+  faststring decompress_buffer_;
+  faststring input_buffer_;
+
+  scoped_refptr<Counter> bytes_sent_;
+  scoped_refptr<Counter> bytes_saved_;
+};
+
+Status CompressedStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context) {
+  context_ = context;
+  need_connect_ = connect;
+  return lower_stream_->Start(connect, loop, this);
+}
+
+void CompressedStream::Close() {
+  lower_stream_->Close();
+}
+
+void CompressedStream::Shutdown(const Status& status) {
+  VLOG_WITH_PREFIX(1) << "CompressedStream::Shutdown with status: " << status;
+
+  for (auto& data : pending_data_) {
+    if (data) {
+      context_->Transferred(data, status);
+    }
+  }
+  pending_data_.clear();
+
+  lower_stream_->Shutdown(status);
+}
+
+size_t CompressedStream::Send(OutboundDataPtr data) {
+  switch (state_) {
+    case CompressedState::kInitial:
+      pending_data_.push_back(std::move(data));
+      return std::numeric_limits<size_t>::max();
+    case CompressedState::kDisabled:
+      return lower_stream_->Send(std::move(data));
+    case CompressedState::kEnabled: {
+      boost::container::small_vector<RefCntBuffer, 10> queue;
+      data->Serialize(&queue);
+      faststring output;
+      input_buffer_.clear();
+      size_t original_size = 0;
+      for (const auto& buf : queue) {
+        original_size += buf.size();
+        Slice slice(buf.data(), buf.size());
+        while (!slice.empty()) {
+          if (input_buffer_.empty() && slice.size() >= kMaxFrameSize) {
+            // Avoid extra copy when the whole frame is located in a single buffer.
+            AppendFrame(slice.cdata(), kMaxFrameSize, &output);
+            slice.remove_prefix(kMaxFrameSize);
+            continue;
+          }
+          auto len = std::min(slice.size(), kMaxFrameSize - input_buffer_.size());
+          input_buffer_.append(slice.data(), len);
+          slice.remove_prefix(len);
+          if (input_buffer_.size() == kMaxFrameSize) {
+            AppendFrame(input_buffer_.c_str(), input_buffer_.size(), &output);
+            input_buffer_.clear();
+          }
+        }
+      }
+      if (!input_buffer_.empty()) {
+        AppendFrame(input_buffer_.c_str(), input_buffer_.size(), &output);
+        input_buffer_.clear();
+      }
+      if (bytes_sent_) {
+        bytes_sent_->IncrementBy(output.size());
+        // Frame headers could make output larger than original data, do not count it.
+        if (output.size() < original_size) {
+          bytes_saved_->IncrementBy(original_size - output.size());
+        }
+      }
+      VLOG_WITH_PREFIX(4) << "Send compressed: " << original_size << " => " << output.size();
+      return lower_stream_->Send(std::make_shared<CompressedOutboundData>(
+          RefCntBuffer(output), std::move(data)));
+    }
+  }
+
+  FATAL_INVALID_ENUM_VALUE(CompressedState, state_);
+}
+
+void CompressedStream::AppendFrame(const char* data, size_t size, faststring* out) {
+  auto header_pos = out->size();
+  out->resize(header_pos + kFrameHeaderSize);
+  size_t stored_size = size;
+  if (size >= static_cast<size_t>(FLAGS_rpc_compression_min_frame_size)) {
+    auto bound = LZ4_compressBound(size);
+    out->resize(header_pos + kFrameHeaderSize + bound);
+    auto compressed_size = LZ4_compress_default(
+        data, pointer_cast<char*>(out->data()) + header_pos + kFrameHeaderSize, size, bound);
+    if (compressed_size > 0 && static_cast<size_t>(compressed_size) < size) {
+      stored_size = compressed_size;
+    }
+    out->resize(header_pos + kFrameHeaderSize + (stored_size == size ? 0 : stored_size));
+  }
+  if (stored_size == size) {
+    out->append(data, size);
+  }
+  auto* header = out->data() + header_pos;
+  LittleEndian::Store32(header, static_cast<uint32_t>(stored_size));
+  LittleEndian::Store32(header + 4, static_cast<uint32_t>(size));
+}
+
+Status CompressedStream::TryWrite() {
+  return lower_stream_->TryWrite();
+}
+
+void CompressedStream::ParseReceived() {
+  lower_stream_->ParseReceived();
+}
+
+bool CompressedStream::Idle(std::string* reason) {
+  return lower_stream_->Idle(reason);
+}
+
+bool CompressedStream::IsConnected() {
+  return connected_;
+}
+
+void CompressedStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
+  lower_stream_->DumpPB(req, resp);
+}
+
+const Endpoint& CompressedStream::Remote() {
+  return lower_stream_->Remote();
+}
+
+const Endpoint& CompressedStream::Local() {
+  return lower_stream_->Local();
+}
+
+std::string CompressedStream::ToString() {
+  return Format("COMPRESSED $0 $1", state_, lower_stream_->ToString());
+}
+
+void CompressedStream::UpdateLastActivity() {
+  context_->UpdateLastActivity();
+}
+
+void CompressedStream::UpdateLastRead() {
+  context_->UpdateLastRead();
+}
+
+void CompressedStream::UpdateLastWrite() {
+  context_->UpdateLastWrite();
+}
+
+void CompressedStream::Transferred(const OutboundDataPtr& data, const Status& status) {
+  context_->Transferred(data, status);
+}
+
+void CompressedStream::Destroy(const Status& status) {
+  context_->Destroy(status);
+}
+
+void CompressedStream::Connected() {
+  // Connecting side always uses compression, the header is sent before any other data.
+  if (need_connect_) {
+    lower_stream_->Send(std::make_shared<CompressedOutboundData>(
+        RefCntBuffer(kCompressionHeader, kCompressionHeaderSize), nullptr));
+    Established(CompressedState::kEnabled);
+  }
+}
+
+void CompressedStream::Established(CompressedState state) {
+  VLOG_WITH_PREFIX(4) << "Established with state: " << state;
+
+  state_ = state;
+  ResetLogPrefix();
+  connected_ = true;
+  context_->Connected();
+  for (auto& data : pending_data_) {
+    Send(std::move(data));
+  }
+  pending_data_.clear();
+}
+
+Result<ProcessDataResult> CompressedStream::ProcessReceived(
+    const IoVecs& data, ReadBufferFull read_buffer_full) {
+  switch (state_) {
+    case CompressedState::kInitial: {
+      // Header could be split between iovecs, so compare it byte by byte.
+      size_t matched = 0;
+      for (const auto& iov : data) {
+        auto* bytes = static_cast<const char*>(iov.iov_base);
+        for (size_t i = 0; i != iov.iov_len && matched != kCompressionHeaderSize; ++i, ++matched) {
+          if (bytes[i] != kCompressionHeader[matched]) {
+            VLOG_WITH_PREFIX(4) << "Plain connection";
+            Established(CompressedState::kDisabled);
+            return context_->ProcessReceived(data, read_buffer_full);
+          }
+        }
+      }
+      if (matched < kCompressionHeaderSize) {
+        return ProcessDataResult{0, Slice()};
+      }
+      Established(CompressedState::kEnabled);
+      IoVecs rest(data);
+      size_t header_left = kCompressionHeaderSize;
+      while (header_left >= rest.front().iov_len) {
+        header_left -= rest.front().iov_len;
+        rest.erase(rest.begin());
+        if (rest.empty()) {
+          return ProcessDataResult{ kCompressionHeaderSize, Slice() };
+        }
+      }
+      rest.front().iov_base = static_cast<char*>(rest.front().iov_base) + header_left;
+      rest.front().iov_len -= header_left;
+      auto result = VERIFY_RESULT(ProcessReceived(rest, read_buffer_full));
+      result.consumed += kCompressionHeaderSize;
+      return result;
+    }
+
+    case CompressedState::kDisabled:
+      return context_->ProcessReceived(data, read_buffer_full);
+
+    case CompressedState::kEnabled: {
+      size_t consumed = 0;
+      if (data.size() == 1) {
+        consumed = VERIFY_RESULT(ProcessFrames(
+            Slice(static_cast<const char*>(data[0].iov_base), data[0].iov_len)));
+      } else {
+        // Frames located in the first iovec are processed in place, and the frame that wraps around
+        // the end of the circular buffer is copied to the frame buffer.
+        Slice first(static_cast<const char*>(data[0].iov_base), data[0].iov_len);
+        consumed = VERIFY_RESULT(ProcessFrames(first));
+        frame_buffer_.clear();
+        frame_buffer_.append(first.data() + consumed, first.size() - consumed);
+        for (size_t i = 1; i != data.size(); ++i) {
+          frame_buffer_.append(data[i].iov_base, data[i].iov_len);
+        }
+        consumed += VERIFY_RESULT(ProcessFrames(Slice(frame_buffer_.data(), frame_buffer_.size())));
+      }
+      return ProcessDataResult{ consumed, Slice() };
+    }
+  }
+
+  return STATUS_FORMAT(IllegalState, "Unexpected state: $0", to_underlying(state_));
+}
+
+// Processes all complete frames from data, returns number of consumed bytes.
+Result<size_t> CompressedStream::ProcessFrames(const Slice& data) {
+  auto* p = data.data();
+  auto* end = data.end();
+  while (static_cast<size_t>(end - p) >= kFrameHeaderSize) {
+    auto stored_size = LittleEndian::Load32(p);
+    auto original_size = LittleEndian::Load32(p + 4);
+    if (original_size > kMaxFrameSize || stored_size > original_size) {
+      return STATUS_FORMAT(NetworkError, "Bad compressed frame header: $0, $1",
+                           stored_size, original_size);
+    }
+    if (static_cast<size_t>(end - p) < kFrameHeaderSize + stored_size) {
+      break;
+    }
+    auto* frame = pointer_cast<const char*>(p + kFrameHeaderSize);
+    if (stored_size == original_size) {
+      RETURN_NOT_OK(Decompressed(Slice(frame, stored_size)));
+    } else {
+      decompress_buffer_.resize(original_size);
+      auto size = LZ4_decompress_safe(
+          frame, pointer_cast<char*>(decompress_buffer_.data()), stored_size, original_size);
+      if (size < 0 || static_cast<size_t>(size) != original_size) {
+        return STATUS_FORMAT(NetworkError, "Failed to decompress frame: $0, expected size: $1",
+                             size, original_size);
+      }
+      RETURN_NOT_OK(Decompressed(Slice(decompress_buffer_.data(), decompress_buffer_.size())));
+    }
+    p += kFrameHeaderSize + stored_size;
+  }
+  return p - data.data();
+}
+
+// Passes decompressed data to the upper layer.
+Status CompressedStream::Decompressed(Slice data) {
+  auto& read_buffer = context_->ReadBuffer();
+  while (!data.empty()) {
+    if (decompressed_bytes_to_skip_ > 0) {
+      auto len = std::min(data.size(), decompressed_bytes_to_skip_);
+      decompressed_bytes_to_skip_ -= len;
+      data.remove_prefix(len);
+      continue;
+    }
+    auto out = VERIFY_RESULT(read_buffer.PrepareAppend());
+    size_t appended = 0;
+    for (auto iov = out.begin(); iov != out.end() && !data.empty(); ++iov) {
+      auto len = std::min(data.size(), iov->iov_len);
+      memcpy(iov->iov_base, data.data(), len);
+      data.remove_prefix(len);
+      appended += len;
+    }
+    read_buffer.DataAppended(appended);
+    if (read_buffer.ReadyToRead()) {
+      auto temp = VERIFY_RESULT(context_->ProcessReceived(
+          read_buffer.AppendedVecs(), ReadBufferFull(read_buffer.Full())));
+      read_buffer.Consume(temp.consumed, temp.buffer);
+      DCHECK_EQ(decompressed_bytes_to_skip_, 0);
+      decompressed_bytes_to_skip_ = temp.bytes_to_skip;
+    } else if (appended == 0) {
+      return STATUS(NetworkError, "No space in read buffer for decompressed data");
+    }
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+const Protocol* CompressedStreamProtocol() {
+  static Protocol result("tcpc");
+  return &result;
+}
+
+StreamFactoryPtr CompressedStreamFactory(
+    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker,
+    const scoped_refptr<MetricEntity>& metric_entity) {
+  class CompressedStreamFactory : public StreamFactory {
+   public:
+    CompressedStreamFactory(
+        StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker,
+        const scoped_refptr<MetricEntity>& metric_entity)
+        : lower_layer_factory_(std::move(lower_layer_factory)), buffer_tracker_(buffer_tracker),
+          metric_entity_(metric_entity) {
+    }
+
+   private:
+    std::unique_ptr<Stream> Create(const StreamCreateData& data) override {
+      auto receive_buffer_size = data.socket->GetReceiveBufferSize();
+      if (!receive_buffer_size.ok()) {
+        LOG(WARNING) << "Compressed stream failure: " << receive_buffer_size.status();
+        receive_buffer_size = 256_KB;
+      }
+      auto lower_stream = lower_layer_factory_->Create(data);
+      return std::make_unique<CompressedStream>(
+          std::move(lower_stream), std::max<size_t>(*receive_buffer_size, 2 * kMaxFrameSize),
+          buffer_tracker_, metric_entity_);
+    }
+
+    StreamFactoryPtr lower_layer_factory_;
+    MemTrackerPtr buffer_tracker_;
+    scoped_refptr<MetricEntity> metric_entity_;
+  };
+
+  return std::make_shared<CompressedStreamFactory>(
+      std::move(lower_layer_factory), buffer_tracker, metric_entity);
+}
+
+} // namespace rpc
+} // namespace yb
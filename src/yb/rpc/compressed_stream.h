@@ -0,0 +1,42 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_COMPRESSED_STREAM_H
+#define YB_RPC_COMPRESSED_STREAM_H
+
+#include "yb/rpc/stream.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/metrics.h"
+
+namespace yb {
+namespace rpc {
+
+YB_DEFINE_ENUM(CompressedState, (kInitial)(kEnabled)(kDisabled));
+
+// Stream layer that compresses sent data with LZ4.
+// Connecting side sends compression header first, so accepting side detects whether remote peer
+// uses compression and falls back to plain stream otherwise. Data is transferred in frames, each
+// frame is prefixed with its stored and original sizes, small frames and frames that could not be
+// compressed are stored as is.
+const Protocol* CompressedStreamProtocol();
+
+// metric_entity could be null, in this case compression metrics are not reported.
+StreamFactoryPtr CompressedStreamFactory(
+    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker,
+    const scoped_refptr<MetricEntity>& metric_entity);
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_COMPRESSED_STREAM_H
@@ -41,6 +41,7 @@
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/serialization.h"
+#include "yb/rpc/service_if.h"
 #include "yb/rpc/service_pool.h"
 
 #include "yb/util/debug/trace_event.h"
@@ -101,6 +102,10 @@ InboundCall::~InboundCall() {
 void InboundCall::NotifyTransferred(const Status& status, Connection* conn) {
   if (status.ok()) {
     TRACE_TO(trace_, "Transfer finished");
+    if (response_transfer_time_ && timing_.time_response_queued.Initialized()) {
+      response_transfer_time_->Increment(
+          (MonoTime::Now() - timing_.time_response_queued).ToMicroseconds());
+    }
   } else {
     YB_LOG_EVERY_N_SECS(WARNING, 10) << LogPrefix() << "Connection torn down before " << ToString()
                                      << " could send its response: " << status.ToString();
@@ -146,22 +151,30 @@ void InboundCall::RecordHandlingStarted(scoped_refptr<Histogram> incoming_queue_
   LOG_IF_WITH_PREFIX(DFATAL, timing_.time_handled.Initialized()) << "Already marked as started";
   timing_.time_handled = MonoTime::Now();
   VLOG_WITH_PREFIX(4) << "Handling";
-  incoming_queue_time->Increment(
-      timing_.time_handled.GetDeltaSince(timing_.time_received).ToMicroseconds());
+  auto queue_time_us = timing_.time_handled.GetDeltaSince(timing_.time_received).ToMicroseconds();
+  queue_time_us_.store(queue_time_us, std::memory_order_release);
+  incoming_queue_time->Increment(queue_time_us);
 }
 
 MonoDelta InboundCall::GetTimeInQueue() const {
   return timing_.time_handled.GetDeltaSince(timing_.time_received);
 }
 
-void InboundCall::RecordHandlingCompleted(scoped_refptr<Histogram> handler_run_time) {
+void InboundCall::RecordHandlingCompleted(const RpcMethodMetrics& metrics) {
   // Protect against multiple calls.
   LOG_IF_WITH_PREFIX(DFATAL, timing_.time_completed.Initialized()) << "Already marked as completed";
   timing_.time_completed = MonoTime::Now();
   VLOG_WITH_PREFIX(4) << "Completed handling";
-  if (handler_run_time) {
-    handler_run_time->Increment((timing_.time_completed - timing_.time_handled).ToMicroseconds());
+  auto handler_time_us = (timing_.time_completed - timing_.time_handled).ToMicroseconds();
+  handler_time_us_.store(handler_time_us, std::memory_order_release);
+  if (metrics.handler_latency) {
+    metrics.handler_latency->Increment(handler_time_us);
   }
+  // Local calls are not queued to the service thread pool.
+  if (metrics.queue_time && timing_.time_queued.Initialized()) {
+    metrics.queue_time->Increment((timing_.time_handled - timing_.time_queued).ToMicroseconds());
+  }
+  response_transfer_time_ = metrics.response_transfer_time;
 }
 
 bool InboundCall::ClientTimedOut() const {
@@ -178,12 +191,35 @@ void InboundCall::QueueResponse(bool is_success) {
   LogTrace();
   bool expected = false;
   if (responded_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+    timing_.time_response_queued = MonoTime::Now();
+    if (timing_.time_completed.Initialized()) {
+      response_time_us_.store(
+          (timing_.time_response_queued - timing_.time_completed).ToMicroseconds(),
+          std::memory_order_release);
+    }
     connection()->context().QueueResponse(connection(), shared_from(this));
   } else {
     LOG_WITH_PREFIX(DFATAL) << "Response already queued";
   }
 }
 
+void InboundCall::DumpTiming(RpcCallInProgressPB* resp) const {
+  auto queue_time_us = queue_time_us_.load(std::memory_order_acquire);
+  if (queue_time_us < 0) {
+    return;
+  }
+  auto* timing = resp->mutable_timing();
+  timing->set_queue_micros(queue_time_us);
+  auto handler_time_us = handler_time_us_.load(std::memory_order_acquire);
+  if (handler_time_us >= 0) {
+    timing->set_handler_micros(handler_time_us);
+  }
+  auto response_time_us = response_time_us_.load(std::memory_order_acquire);
+  if (response_time_us >= 0) {
+    timing->set_response_micros(response_time_us);
+  }
+}
+
 std::string InboundCall::LogPrefix() const {
   return Format("$0: ", this);
 }
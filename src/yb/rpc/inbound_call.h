@@ -79,9 +79,11 @@ class RpcCallDetailsPB;
 class CQLCallDetailsPB;
 
 struct InboundCallTiming {
-  MonoTime time_received;   // Time the call was first accepted.
-  MonoTime time_handled;    // Time the call handler was kicked off.
-  MonoTime time_completed;  // Time the call handler completed.
+  MonoTime time_received;         // Time the call was first accepted.
+  MonoTime time_queued;           // Time the call was queued to the service thread pool.
+  MonoTime time_handled;          // Time the call handler was kicked off.
+  MonoTime time_completed;        // Time the call handler completed.
+  MonoTime time_response_queued;  // Time the response was queued for sending.
 };
 
 class InboundCallHandler {
@@ -90,9 +92,9 @@ class InboundCallHandler {
 
   virtual void Failure(const InboundCallPtr& call, const Status& status) = 0;
 
-  virtual bool CallQueued() = 0;
+  virtual bool CallQueued(const InboundCall& call) = 0;
 
-  virtual void CallDequeued() = 0;
+  virtual void CallDequeued(const InboundCall& call) = 0;
 
  protected:
   ~InboundCallHandler() = default;
@@ -132,10 +134,12 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   virtual void RecordHandlingStarted(scoped_refptr<Histogram> incoming_queue_time);
 
   // When RPC call Handle() completed execution on the server side.
-  // Updates the Histogram with time elapsed since the call was started,
-  // and should only be called once on a given instance.
+  // Updates method histograms with time elapsed since the call was started and time the call
+  // spent in the service queue. Time spent sending the response is recorded later, when the
+  // response is transferred.
+  // Should only be called once on a given instance.
   // Not thread-safe. Should only be called by the current "owner" thread.
-  void RecordHandlingCompleted(scoped_refptr<Histogram> handler_run_time);
+  void RecordHandlingCompleted(const RpcMethodMetrics& metrics);
 
   // Return true if the deadline set by the client has already elapsed.
   // In this case, the server may stop processing the call, since the
@@ -153,10 +157,11 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   ThreadPoolTask* BindTask(InboundCallHandler* handler) {
     auto shared_this = shared_from(this);
-    if (!handler->CallQueued()) {
+    if (!handler->CallQueued(*this)) {
       return nullptr;
     }
     tracker_ = handler;
+    timing_.time_queued = MonoTime::Now();
     task_.Bind(handler, shared_this);
     return &task_;
   }
@@ -182,7 +187,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
       return false;
     }
     if (tracker_) {
-      tracker_->CallDequeued();
+      tracker_->CallDequeued(*this);
     }
     return true;
   }
@@ -198,6 +203,9 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   size_t DynamicMemoryUsage() const override;
 
+  // Fills timing breakdown of stages finished by this call. Could be invoked from any thread.
+  void DumpTiming(RpcCallInProgressPB* resp) const;
+
   const CallData& request_data() const { return request_data_; }
 
  protected:
@@ -226,6 +234,15 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // Timing information related to this RPC call.
   InboundCallTiming timing_;
 
+  // Durations of finished processing stages in microseconds, -1 if stage is not finished yet.
+  // timing_ is accessed by the owner thread only, while these are also read by DumpPB.
+  std::atomic<int64_t> queue_time_us_{-1};
+  std::atomic<int64_t> handler_time_us_{-1};
+  std::atomic<int64_t> response_time_us_{-1};
+
+  // Filled when handling is completed, incremented when response is transferred.
+  scoped_refptr<Histogram> response_transfer_time_;
+
   std::atomic<bool> processing_started_{false};
 
   std::atomic<bool> responded_{false};
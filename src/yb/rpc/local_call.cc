@@ -34,7 +34,24 @@ LocalOutboundCall::LocalOutboundCall(
 
 Status LocalOutboundCall::SetRequestParam(
     const google::protobuf::Message& req, const MemTrackerPtr& mem_tracker) {
-  req_ = &req;
+  auto fields = std::move(controller()->serialized_request_fields_);
+  if (fields.empty()) {
+    req_ = &req;
+    return Status::OK();
+  }
+
+  // Local call does not serialize the request, so already serialized fields are merged into
+  // a copy of it.
+  std::string serialized_fields;
+  for (const auto& field : fields) {
+    serialized_fields.append(field.data(), field.size());
+  }
+  merged_req_.reset(req.New());
+  merged_req_->CopyFrom(req);
+  if (!merged_req_->MergeFromString(serialized_fields)) {
+    return STATUS(InvalidArgument, "Failed to parse serialized request fields");
+  }
+  req_ = merged_req_.get();
   return Status::OK();
 }
 
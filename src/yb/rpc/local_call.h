@@ -49,6 +49,9 @@ class LocalOutboundCall : public OutboundCall {
 
   const google::protobuf::Message* req_ = nullptr;
 
+  // Copy of the request with merged serialized fields, if they were specified.
+  std::unique_ptr<google::protobuf::Message> merged_req_;
+
   std::shared_ptr<LocalYBInboundCall> inbound_call_;
 };
 
@@ -77,6 +80,11 @@ class LocalYBInboundCall : public YBInboundCall {
     return sidecars_.size() - 1;
   }
 
+  size_t AddRpcSidecar(RefCntBuffer car) override {
+    sidecars_.push_back(std::move(car));
+    return sidecars_.size() - 1;
+  }
+
  protected:
   void Respond(const google::protobuf::MessageLite& response, bool is_success) override;
 
@@ -486,6 +486,12 @@ void Messenger::QueueOutboundCall(OutboundCallPtr call) {
     return;
   }
 
+  if (outbound_messenger_ &&
+      outbound_messenger_->stream_factories_.count(call->conn_id().protocol())) {
+    outbound_messenger_->QueueOutboundCall(std::move(call));
+    return;
+  }
+
   reactor->QueueOutboundCall(std::move(call));
 }
 
@@ -560,7 +566,8 @@ Messenger::Messenger(const MessengerBuilder &bld)
       scheduler_(&io_thread_pool_.io_service()),
       normal_thread_pool_(new rpc::ThreadPool(name_, bld.queue_limit_, bld.workers_limit_)),
       rpc_metrics_(new RpcMetrics(bld.metric_entity_)),
-      num_connections_to_server_(bld.num_connections_to_server_) {
+      num_connections_to_server_(bld.num_connections_to_server_),
+      outbound_messenger_(bld.outbound_messenger_) {
 #ifndef NDEBUG
   creation_stack_trace_.Collect(/* skip_frames */ 1);
 #endif
@@ -628,6 +635,16 @@ Status Messenger::QueueEventOnAllReactors(
   return Status::OK();
 }
 
+Status Messenger::QueueEventOnFilteredConnections(
+    ServerEventListPtr server_event, const SourceLocation& source_location,
+    const ConnectionFilter& filter) {
+  shared_lock<rw_spinlock> guard(lock_.get_lock());
+  for (const auto& reactor : reactors_) {
+    reactor->QueueEventOnFilteredConnections(server_event, source_location, filter);
+  }
+  return Status::OK();
+}
+
 void Messenger::RemoveScheduledTask(ScheduledTaskId id) {
   CHECK_GT(id, 0);
   std::lock_guard<std::mutex> guard(mutex_scheduled_tasks_);
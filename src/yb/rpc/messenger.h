@@ -150,6 +150,15 @@ class MessengerBuilder {
     return num_connections_to_server_;
   }
 
+  // Send outbound calls over connections of the specified messenger, so messengers of the same
+  // process share one connection per remote endpoint and protocol instead of opening their own.
+  // Calls using protocols that are not supported by the specified messenger are still sent over
+  // own connections. The specified messenger should outlive the built one.
+  MessengerBuilder& set_outbound_messenger(Messenger* messenger) {
+    outbound_messenger_ = messenger;
+    return *this;
+  }
+
   const std::shared_ptr<MemTracker>& last_used_parent_mem_tracker() const {
     return last_used_parent_mem_tracker_;
   }
@@ -166,6 +175,7 @@ class MessengerBuilder {
   size_t queue_limit_;
   size_t workers_limit_;
   int num_connections_to_server_;
+  Messenger* outbound_messenger_ = nullptr;
   std::shared_ptr<MemTracker> last_used_parent_mem_tracker_;
 };
 
@@ -231,6 +241,11 @@ class Messenger : public ProxyContext {
   CHECKED_STATUS QueueEventOnAllReactors(
       ServerEventListPtr server_event, const SourceLocation& source_location);
 
+  // Queues a server event on the connections of all reactors, that are accepted by filter.
+  CHECKED_STATUS QueueEventOnFilteredConnections(
+      ServerEventListPtr server_event, const SourceLocation& source_location,
+      const ConnectionFilter& filter);
+
   // Dump the current RPCs into the given protobuf.
   CHECKED_STATUS DumpRunningRpcs(const DumpRunningRpcsRequestPB& req,
                                  DumpRunningRpcsResponsePB* resp);
@@ -287,7 +302,10 @@ class Messenger : public ProxyContext {
   const std::shared_ptr<MemTracker>& parent_mem_tracker() override;
 
   int num_connections_to_server() const override {
-    return num_connections_to_server_;
+    // Calls sent over connections of outbound messenger should use its limit, otherwise sharing
+    // could open more connections to the server than the outbound messenger itself would.
+    return outbound_messenger_ ? outbound_messenger_->num_connections_to_server()
+                               : num_connections_to_server_;
   }
 
   // Use specified IP address as base address for outbound connections from messenger.
@@ -380,6 +398,10 @@ class Messenger : public ProxyContext {
   // Number of outbound connections to create per each destination server address.
   int num_connections_to_server_;
 
+  // Messenger whose connections are used to send outbound calls, see
+  // MessengerBuilder::set_outbound_messenger.
+  Messenger* const outbound_messenger_;
+
 #ifndef NDEBUG
   // This is so we can log where exactly a Messenger was instantiated to better diagnose a CHECK
   // failure in the destructor (ENG-2838). This can be removed when that is fixed.
@@ -237,6 +237,76 @@ TEST_F(MultiThreadedRpcTest, TestBlowOutServiceQueue) {
   ASSERT_EQ(1, rpcs_queue_overflow->value());
 }
 
+// Test that a single connection could not occupy the whole service queue.
+TEST_F(MultiThreadedRpcTest, ConnectionShareOfServiceQueue) {
+  constexpr size_t kQueueLimit = 4;
+  // Half of the queue limit is allowed to be occupied by a single connection.
+  constexpr size_t kConnectionCalls = kQueueLimit / 2;
+
+  MessengerBuilder bld("messenger1");
+  bld.set_metric_entity(metric_entity());
+  std::unique_ptr<Messenger> server_messenger = ASSERT_RESULT(bld.Build());
+
+  Endpoint server_addr;
+  ASSERT_OK(server_messenger->ListenAddress(
+      CreateConnectionContextFactory<YBInboundConnectionContext>(),
+      Endpoint(), &server_addr));
+
+  std::unique_ptr<ServiceIf> service(new GenericCalculatorService());
+  auto service_name = service->service_name();
+  // Thread pool without workers, so calls stay in the queue.
+  ThreadPool thread_pool("bogus_pool", kQueueLimit, 0UL);
+  scoped_refptr<ServicePool> service_pool(new ServicePool(kQueueLimit,
+                                                          &thread_pool,
+                                                          &server_messenger->scheduler(),
+                                                          std::move(service),
+                                                          metric_entity()));
+  ASSERT_OK(server_messenger->RegisterService(service_name, service_pool));
+  ASSERT_OK(server_messenger->StartAcceptor());
+
+  rpc_test::AddRequestPB req;
+  req.set_x(1);
+  req.set_y(2);
+  rpc_test::AddResponsePB responses[kConnectionCalls + 2];
+  RpcController controllers[kConnectionCalls + 2];
+  CountDownLatch first_client_latch(1);
+  CountDownLatch second_client_latch(1);
+
+  auto first_client = CreateAutoShutdownMessengerHolder("Client1");
+  Proxy first_proxy(first_client.get(), HostPort::FromBoundEndpoint(server_addr));
+  for (size_t i = 0; i != kConnectionCalls + 1; ++i) {
+    controllers[i].set_timeout(10s);
+    first_proxy.AsyncRequest(
+        CalculatorServiceMethods::AddMethod(), req, &responses[i], &controllers[i],
+        [&first_client_latch] { first_client_latch.CountDown(); });
+  }
+
+  // Call over the connection share is rejected, while the queue is not full yet.
+  first_client_latch.Wait();
+  ASSERT_TRUE(controllers[kConnectionCalls].finished());
+  ASSERT_NE(controllers[kConnectionCalls].status().ToString().find("queue is full"),
+            std::string::npos) << controllers[kConnectionCalls].status();
+
+  // Calls from the other connection are still queued.
+  auto second_client = CreateAutoShutdownMessengerHolder("Client2");
+  Proxy second_proxy(second_client.get(), HostPort::FromBoundEndpoint(server_addr));
+  auto& second_controller = controllers[kConnectionCalls + 1];
+  second_controller.set_timeout(10s);
+  second_proxy.AsyncRequest(
+      CalculatorServiceMethods::AddMethod(), req, &responses[kConnectionCalls + 1],
+      &second_controller, [&second_client_latch] { second_client_latch.CountDown(); });
+  ASSERT_FALSE(second_client_latch.WaitFor(1s));
+
+  ASSERT_OK(server_messenger->UnregisterService(service_name));
+  service_pool->Shutdown();
+  thread_pool.Shutdown();
+  server_messenger->Shutdown();
+
+  Counter *rpcs_queue_overflow =
+    METRIC_rpcs_queue_overflow.Instantiate(metric_entity()).get();
+  ASSERT_EQ(1, rpcs_queue_overflow->value());
+}
+
 static void HammerServerWithTCPConns(const Endpoint& addr) {
   while (true) {
     Socket socket;
@@ -80,6 +80,12 @@ DEFINE_int64(
     " (Advanced debugging option)");
 TAG_FLAG(rpc_callback_max_cycles, advanced);
 TAG_FLAG(rpc_callback_max_cycles, runtime);
+DEFINE_bool(rpc_propagate_trace_id, false,
+            "Send trace id in the RPC header, so traces of the same request on different nodes "
+            "are logged with the same trace id.");
+TAG_FLAG(rpc_propagate_trace_id, advanced);
+TAG_FLAG(rpc_propagate_trace_id, runtime);
+
 DECLARE_bool(rpc_dump_all_traces);
 
 namespace yb {
@@ -202,8 +208,13 @@ OutboundCall::OutboundCall(const RemoteMethod* remote_method,
   // Avoid expensive conn_id.ToString() in production.
   TRACE_TO_WITH_TIME(trace_, start_, "Outbound Call initiated.");
 
-  if (Trace::CurrentTrace()) {
-    Trace::CurrentTrace()->AddChildTrace(trace_.get());
+  auto* current_trace = Trace::CurrentTrace();
+  if (current_trace) {
+    if (FLAGS_rpc_propagate_trace_id) {
+      // Assign id to the parent trace, so all calls made on behalf of it share the same id.
+      current_trace->GetOrCreateTraceId();
+    }
+    current_trace->AddChildTrace(trace_.get());
   }
 
   DVLOG(4) << "OutboundCall " << this << " constructed with state_: " << StateName(state_)
@@ -221,7 +232,7 @@ OutboundCall::~OutboundCall() {
   if (PREDICT_FALSE(FLAGS_rpc_dump_all_traces)) {
     LOG(INFO) << ToString() << " took "
               << MonoTime::Now().GetDeltaSince(start_).ToMicroseconds()
-              << "us. Trace:";
+              << "us. Trace" << TraceIdSuffix(trace_->trace_id()) << ":";
     trace_->Dump(&LOG(INFO), true);
   }
 
@@ -248,6 +259,10 @@ void OutboundCall::NotifyTransferred(const Status& status, Connection* conn) {
 
 void OutboundCall::Serialize(boost::container::small_vector_base<RefCntBuffer>* output) {
   output->push_back(std::move(buffer_));
+  for (auto& field : serialized_request_fields_) {
+    output->push_back(std::move(field));
+  }
+  serialized_request_fields_.clear();
   buffer_consumption_ = ScopedTrackedConsumption();
 }
 
@@ -256,10 +271,16 @@ Status OutboundCall::SetRequestParam(
   using serialization::SerializeHeader;
   using serialization::SerializeMessage;
 
+  serialized_request_fields_ = std::move(controller_->serialized_request_fields_);
+  int fields_size = 0;
+  for (const auto& field : serialized_request_fields_) {
+    fields_size += static_cast<int>(field.size());
+  }
+
   size_t message_size = 0;
   auto status = SerializeMessage(message,
                                  /* param_buf */ nullptr,
-                                 /* additional_size */ 0,
+                                 /* additional_size */ fields_size,
                                  /* use_cached_size */ false,
                                  /* offset */ 0,
                                  &message_size);
@@ -270,7 +291,8 @@ Status OutboundCall::SetRequestParam(
 
   RequestHeader header;
   InitHeader(&header);
-  status = SerializeHeader(header, message_size, &buffer_, message_size, &header_size);
+  status = SerializeHeader(
+      header, message_size + fields_size, &buffer_, message_size, &header_size);
   remote_method_pool_->Release(header.release_remote_method());
   if (!status.ok()) {
     return status;
@@ -282,7 +304,7 @@ Status OutboundCall::SetRequestParam(
 
   return SerializeMessage(message,
                           &buffer_,
-                          /* additional_size */ 0,
+                          /* additional_size */ fields_size,
                           /* use_cached_size */ true,
                           header_size);
 }
@@ -564,6 +586,9 @@ void OutboundCall::InitHeader(RequestHeader* header) {
     }
   }
   header->set_allocated_remote_method(remote_method_pool_->Take());
+  if (FLAGS_rpc_propagate_trace_id) {
+    header->set_trace_id(trace_->GetOrCreateTraceId());
+  }
 }
 
 ///
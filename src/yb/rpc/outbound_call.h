@@ -383,6 +383,9 @@ class OutboundCall : public RpcCall {
   // Consumption of buffer_.
   ScopedTrackedConsumption buffer_consumption_;
 
+  // Already serialized fields of the request, sent after buffer_.
+  std::vector<RefCntBuffer> serialized_request_fields_;
+
   // Once a response has been received for this call, contains that response.
   CallResponse call_response_;
 
@@ -475,6 +475,20 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
           "  yb::MetricUnit::kMicroseconds,\n"
           "  \"Microseconds spent handling $rpc_full_name$() RPC requests\",\n"
           "  60000000LU, 2);\n"
+          "\n"
+          "METRIC_DEFINE_histogram_with_percentiles(server,"
+          " queue_time_$rpc_full_name_plainchars$,\n"
+          "  \"$rpc_full_name$ RPC Queue Time\",\n"
+          "  yb::MetricUnit::kMicroseconds,\n"
+          "  \"Microseconds $rpc_full_name$() RPC requests spent in the service queue\",\n"
+          "  60000000LU, 2);\n"
+          "\n"
+          "METRIC_DEFINE_histogram_with_percentiles(server,"
+          " response_transfer_time_$rpc_full_name_plainchars$,\n"
+          "  \"$rpc_full_name$ RPC Response Transfer Time\",\n"
+          "  yb::MetricUnit::kMicroseconds,\n"
+          "  \"Microseconds spent sending responses to $rpc_full_name$() RPC requests\",\n"
+          "  60000000LU, 2);\n"
           "\n");
         subs->Pop();
       }
@@ -553,6 +567,10 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
         Print(printer, *subs,
           "  metrics_[$metric_enum_key$].handler_latency = \n"
           "      METRIC_handler_latency_$rpc_full_name_plainchars$.Instantiate(entity);\n"
+          "  metrics_[$metric_enum_key$].queue_time = \n"
+          "      METRIC_queue_time_$rpc_full_name_plainchars$.Instantiate(entity);\n"
+          "  metrics_[$metric_enum_key$].response_transfer_time = \n"
+          "      METRIC_response_transfer_time_$rpc_full_name_plainchars$.Instantiate(entity);\n"
         );
 
         subs->Pop();
@@ -287,6 +287,19 @@ void Reactor::QueueEventOnAllConnections(
   }, source_location);
 }
 
+void Reactor::QueueEventOnFilteredConnections(
+    ServerEventListPtr server_event, const SourceLocation& source_location,
+    ConnectionFilter filter) {
+  ScheduleReactorFunctor([server_event = std::move(server_event), filter = std::move(filter)](
+                             Reactor* reactor) {
+    for (const ConnectionPtr& conn : reactor->server_conns_) {
+      if (filter(conn)) {
+        conn->QueueOutboundData(server_event);
+      }
+    }
+  }, source_location);
+}
+
 Status Reactor::DumpRunningRpcs(const DumpRunningRpcsRequestPB& req,
                                 DumpRunningRpcsResponsePB* resp) {
   return RunOnReactorThread([&req, resp](Reactor* reactor) -> Status {
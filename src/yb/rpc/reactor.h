@@ -354,6 +354,12 @@ class Reactor {
   void QueueEventOnAllConnections(
       ServerEventListPtr server_event, const SourceLocation& source_location);
 
+  // Queues a server event on the connections accepted by filter. Filter is invoked on the reactor
+  // thread.
+  void QueueEventOnFilteredConnections(
+      ServerEventListPtr server_event, const SourceLocation& source_location,
+      ConnectionFilter filter);
+
   // Queue a new incoming connection. Takes ownership of the underlying fd from
   // 'socket', but not the Socket object itself.
   // If the reactor is already shut down, takes care of closing the socket.
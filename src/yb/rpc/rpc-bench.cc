@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include <algorithm>
+#include <fstream>
 #include <string>
 #include <thread>
 
@@ -37,9 +39,20 @@
 
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rtest.proxy.h"
-#include "yb/util/countdown_latch.h"
+#include "yb/rpc/secure_stream.h"
+#include "yb/rpc/tcp_stream.h"
+
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/jsonwriter.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/test_util.h"
 
+DEFINE_int32(rpc_bench_duration_ms, 5000, "Duration of each benchmark run in milliseconds.");
+DEFINE_string(rpc_bench_results_file, "",
+              "File to append benchmark results to, one JSON object per line.");
+
+DECLARE_int32(num_connections_to_server);
+
 using namespace std::literals; // NOLINT
 
 using std::string;
@@ -48,107 +61,283 @@ using std::shared_ptr;
 namespace yb {
 namespace rpc {
 
-class RpcBench : public RpcTestBase {
- public:
-  RpcBench() {}
+namespace {
+
+#if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
+constexpr size_t kDefaultNumThreads = 4;
+#else
+constexpr size_t kDefaultNumThreads = 16;
+#endif
+
+// Calls are done with 10 seconds timeout, so latency could not be bigger.
+constexpr auto kCallTimeout = 10s;
+constexpr uint64_t kMaxLatencyUs = 10000000;
 
+const std::vector<size_t> kMixedPayloadSizes = {64, 512, 4_KB, 32_KB, 256_KB};
+
+struct BenchmarkOptions {
+  bool secure = false;
+  size_t num_threads = kDefaultNumThreads;
+  // When true each client thread uses its own messenger, so there are num_connections_to_server
+  // connections per thread. Otherwise all threads share the same messenger and connections.
+  bool messenger_per_thread = true;
+  int num_connections_to_server = -1;
+  size_t num_client_reactors = 1;
+  size_t num_server_reactors = kDefaultServerMessengerOptions.n_reactors;
+  // Each call picks its payload size from this list in round robin. Zero size means trivial Add
+  // call without payload.
+  std::vector<size_t> payload_sizes = {0};
+  // Whether payload is returned in the response sidecar, otherwise it is echoed in request and
+  // response.
+  bool sidecars = false;
+};
+
+} // namespace
+
+class RpcBench : public RpcTestBase {
  protected:
-  friend class ClientThread;
+  void RunBenchmark(const std::string& name, const BenchmarkOptions& options);
 
+ private:
+  std::unique_ptr<Messenger> CreateBenchMessenger(
+      const std::string& name, MessengerOptions messenger_options, size_t num_reactors);
+  void RunClient(Messenger* messenger, std::atomic<bool>* running, HdrHistogram* latency,
+                 size_t* request_count);
+  void ReportResult(const std::string& name, size_t num_requests, const Stopwatch& stopwatch,
+                    const HdrHistogram& latency);
+
+  BenchmarkOptions options_;
   HostPort server_hostport_;
-  std::atomic<bool> should_run_{true};
+  std::unique_ptr<SecureContext> secure_context_;
 };
 
-class ClientThread {
- public:
-  explicit ClientThread(RpcBench *bench)
-    : bench_(bench),
-      request_count_(0) {
+std::unique_ptr<Messenger> RpcBench::CreateBenchMessenger(
+    const std::string& name, MessengerOptions messenger_options, size_t num_reactors) {
+  messenger_options.n_reactors = num_reactors;
+  messenger_options.num_connections_to_server = options_.num_connections_to_server;
+  auto builder = CreateMessengerBuilder(name, messenger_options);
+  if (options_.secure) {
+    builder.SetListenProtocol(SecureStreamProtocol());
+    builder.AddStreamFactory(
+        SecureStreamProtocol(),
+        SecureStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker(),
+                            secure_context_.get()));
   }
+  return EXPECT_RESULT(builder.Build());
+}
 
-  void Start() {
-    thread_.reset(new std::thread(&ClientThread::Run, this));
-  }
+void RpcBench::RunClient(Messenger* messenger, std::atomic<bool>* running, HdrHistogram* latency,
+                         size_t* request_count) {
+  Proxy proxy(messenger, server_hostport_,
+              options_.secure ? SecureStreamProtocol() : TcpStream::StaticProtocol());
+  const auto& sizes = options_.payload_sizes;
+  const std::string payload = RandomHumanReadableString(
+      *std::max_element(sizes.begin(), sizes.end()));
 
-  void Join() {
-    thread_->join();
-  }
-
-  void Run() {
-    CDSAttacher attacher;
-    auto client_messenger = CreateAutoShutdownMessengerHolder(bench_->CreateMessenger("Client"));
-    ProxyCache proxy_cache(client_messenger.get());
-
-    rpc_test::CalculatorServiceProxy p(&proxy_cache, HostPort(bench_->server_hostport_));
-
-    rpc_test::AddRequestPB req;
-    rpc_test::AddResponsePB resp;
-    while (bench_->should_run_.load(std::memory_order_acquire)) {
-      req.set_x(request_count_);
-      req.set_y(request_count_);
-      RpcController controller;
-      controller.set_timeout(MonoDelta::FromSeconds(10));
-      CHECK_OK(p.Add(req, &resp, &controller));
+  size_t idx = 0;
+  while (running->load(std::memory_order_acquire)) {
+    const size_t size = sizes[idx % sizes.size()];
+    RpcController controller;
+    controller.set_timeout(kCallTimeout);
+    auto start = MonoTime::Now();
+    if (size == 0) {
+      rpc_test::AddRequestPB req;
+      req.set_x(idx);
+      req.set_y(idx);
+      rpc_test::AddResponsePB resp;
+      CHECK_OK(proxy.SyncRequest(CalculatorServiceMethods::AddMethod(), req, &resp, &controller));
       CHECK_EQ(req.x() + req.y(), resp.result());
-      request_count_++;
+    } else if (options_.sidecars) {
+      rpc_test::SendStringsRequestPB req;
+      req.set_random_seed(idx);
+      req.add_sizes(size);
+      rpc_test::SendStringsResponsePB resp;
+      CHECK_OK(proxy.SyncRequest(
+          CalculatorServiceMethods::SendStringsMethod(), req, &resp, &controller));
+      CHECK_EQ(size, CHECK_RESULT(controller.GetSidecar(resp.sidecars(0))).size());
+    } else {
+      rpc_test::EchoRequestPB req;
+      req.set_data(payload.data(), size);
+      rpc_test::EchoResponsePB resp;
+      CHECK_OK(proxy.SyncRequest(CalculatorServiceMethods::EchoMethod(), req, &resp, &controller));
+      CHECK_EQ(size, resp.data().size());
     }
+    latency->Increment(MonoTime::Now().GetDeltaSince(start).ToMicroseconds());
+    ++idx;
   }
+  *request_count = idx;
+}
 
-  std::unique_ptr<std::thread> thread_;
-  RpcBench *bench_;
-  int request_count_;
-};
-
+void RpcBench::RunBenchmark(const std::string& name, const BenchmarkOptions& options) {
+  options_ = options;
+  if (options_.secure && !secure_context_) {
+    secure_context_ = std::make_unique<SecureContext>();
+    ASSERT_OK(secure_context_->TEST_GenerateKeys(1024, "127.0.0.1"));
+  }
 
-// Test making successful RPC calls.
-TEST_F(RpcBench, BenchmarkCalls) {
-  TestServerOptions options;
-  options.n_worker_threads = 1;
+  TestServerOptions server_options;
+  StartTestServer(
+      CreateBenchMessenger(
+          "TestServer", server_options.messenger_options, options_.num_server_reactors),
+      &server_hostport_, server_options);
 
-  // Set up server.
-  StartTestServerWithGeneratedCode(&server_hostport_);
+  AutoShutdownMessengerHolder shared_messenger;
+  if (!options_.messenger_per_thread) {
+    shared_messenger = rpc::CreateAutoShutdownMessengerHolder(CreateBenchMessenger(
+        "Client", kDefaultClientMessengerOptions, options_.num_client_reactors));
+  }
 
-  // Set up client.
-  LOG(INFO) << "Connecting to " << server_hostport_;
-  MessengerOptions client_options = kDefaultClientMessengerOptions;
-  client_options.n_reactors = 2;
-  auto client_messenger = CreateAutoShutdownMessengerHolder("Client", client_options);
+  HdrHistogram latency(kMaxLatencyUs, 2);
+  std::atomic<bool> running{true};
+  std::vector<size_t> request_counts(options_.num_threads);
+  std::vector<std::thread> threads;
 
   Stopwatch sw(Stopwatch::ALL_THREADS);
   sw.start();
-
-  std::vector<std::unique_ptr<ClientThread>> threads;
-#if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
-  constexpr int kNumThreads = 4;
-#else
-  constexpr int kNumThreads = 16;
-#endif
-  for (int i = 0; i < kNumThreads; i++) {
-    auto thr = std::make_unique<ClientThread>(this);
-    thr->Start();
-    threads.push_back(std::move(thr));
+  for (size_t i = 0; i != options_.num_threads; ++i) {
+    threads.emplace_back([this, i, &shared_messenger, &running, &latency, &request_counts] {
+      CDSAttacher attacher;
+      AutoShutdownMessengerHolder own_messenger;
+      auto messenger = shared_messenger.get();
+      if (!messenger) {
+        own_messenger = rpc::CreateAutoShutdownMessengerHolder(CreateBenchMessenger(
+            Format("Client-$0", i), kDefaultClientMessengerOptions, options_.num_client_reactors));
+        messenger = own_messenger.get();
+      }
+      RunClient(messenger, &running, &latency, &request_counts[i]);
+    });
   }
 
-  std::this_thread::sleep_for(10s);
-  should_run_.store(false, std::memory_order_release);
+  std::this_thread::sleep_for(FLAGS_rpc_bench_duration_ms * 1ms);
+  running.store(false, std::memory_order_release);
 
-  int total_reqs = 0;
-
-  for (const auto& thr : threads) {
-    thr->Join();
-    total_reqs += thr->request_count_;
+  for (auto& thread : threads) {
+    thread.join();
   }
   sw.stop();
 
-  float reqs_per_second = static_cast<float>(total_reqs / sw.elapsed().wall_seconds());
-  float user_cpu_micros_per_req = static_cast<float>(sw.elapsed().user / 1000.0 / total_reqs);
-  float sys_cpu_micros_per_req = static_cast<float>(sw.elapsed().system / 1000.0 / total_reqs);
+  size_t total_requests = 0;
+  for (auto count : request_counts) {
+    total_requests += count;
+  }
+  ReportResult(name, total_requests, sw, latency);
+}
+
+void RpcBench::ReportResult(const std::string& name, size_t num_requests,
+                            const Stopwatch& stopwatch, const HdrHistogram& latency) {
+  auto reqs_per_second = num_requests / stopwatch.elapsed().wall_seconds();
+  auto user_cpu_micros_per_req = stopwatch.elapsed().user / 1000.0 / num_requests;
+  auto sys_cpu_micros_per_req = stopwatch.elapsed().system / 1000.0 / num_requests;
+  auto num_connections_to_server = options_.num_connections_to_server >= 0
+      ? options_.num_connections_to_server : FLAGS_num_connections_to_server;
 
+  LOG(INFO) << name << " results:";
   LOG(INFO) << "Reqs/sec:         " << reqs_per_second;
   LOG(INFO) << "User CPU per req: " << user_cpu_micros_per_req << "us";
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
+  LOG(INFO) << "Latency p50/p99:  " << latency.ValueAtPercentile(50) << "us/"
+            << latency.ValueAtPercentile(99) << "us";
+
+  std::stringstream out;
+  {
+    JsonWriter writer(&out, JsonWriter::COMPACT);
+    writer.StartObject();
+    writer.String("name");
+    writer.String(name);
+    writer.String("secure");
+    writer.Bool(options_.secure);
+    writer.String("threads");
+    writer.Uint64(options_.num_threads);
+    writer.String("messenger_per_thread");
+    writer.Bool(options_.messenger_per_thread);
+    writer.String("connections_to_server");
+    writer.Int(num_connections_to_server);
+    writer.String("client_reactors");
+    writer.Uint64(options_.num_client_reactors);
+    writer.String("server_reactors");
+    writer.Uint64(options_.num_server_reactors);
+    writer.String("payload_sizes");
+    writer.StartArray();
+    for (auto size : options_.payload_sizes) {
+      writer.Uint64(size);
+    }
+    writer.EndArray();
+    writer.String("sidecars");
+    writer.Bool(options_.sidecars);
+    writer.String("requests");
+    writer.Uint64(num_requests);
+    writer.String("reqs_per_sec");
+    writer.Double(reqs_per_second);
+    writer.String("user_cpu_us_per_req");
+    writer.Double(user_cpu_micros_per_req);
+    writer.String("sys_cpu_us_per_req");
+    writer.Double(sys_cpu_micros_per_req);
+    writer.String("latency_us");
+    writer.StartObject();
+    writer.String("mean");
+    writer.Double(latency.MeanValue());
+    for (auto percentile : {50.0, 95.0, 99.0, 99.9}) {
+      writer.String(Format("p$0", percentile));
+      writer.Uint64(latency.ValueAtPercentile(percentile));
+    }
+    writer.String("max");
+    writer.Uint64(latency.MaxValue());
+    writer.EndObject();
+    writer.EndObject();
+  }
+
+  LOG(INFO) << "RESULT: " << out.str();
+  if (!FLAGS_rpc_bench_results_file.empty()) {
+    std::ofstream file(FLAGS_rpc_bench_results_file, std::ios_base::app);
+    file << out.str() << std::endl;
+    ASSERT_TRUE(file.good()) << "Failed to write " << FLAGS_rpc_bench_results_file;
+  }
+}
+
+// Trivial calls without payload.
+TEST_F(RpcBench, BenchmarkCalls) {
+  RunBenchmark("BenchmarkCalls", BenchmarkOptions());
+}
+
+TEST_F(RpcBench, MixedPayload) {
+  BenchmarkOptions options;
+  options.payload_sizes = kMixedPayloadSizes;
+  RunBenchmark("MixedPayload", options);
+}
+
+TEST_F(RpcBench, MixedSidecars) {
+  BenchmarkOptions options;
+  options.payload_sizes = kMixedPayloadSizes;
+  options.sidecars = true;
+  RunBenchmark("MixedSidecars", options);
+}
+
+TEST_F(RpcBench, Secure) {
+  BenchmarkOptions options;
+  options.payload_sizes = kMixedPayloadSizes;
+  options.secure = true;
+  RunBenchmark("Secure", options);
+}
+
+// All client threads share single connection to the server.
+TEST_F(RpcBench, SingleConnection) {
+  BenchmarkOptions options;
+  options.messenger_per_thread = false;
+  options.num_connections_to_server = 1;
+  options.payload_sizes = kMixedPayloadSizes;
+  RunBenchmark("SingleConnection", options);
+}
+
+TEST_F(RpcBench, ReactorSweep) {
+  for (size_t num_reactors : {1, 2, 4, 8}) {
+    BenchmarkOptions options;
+    options.messenger_per_thread = false;
+    options.num_client_reactors = num_reactors;
+    options.num_server_reactors = num_reactors;
+    options.payload_sizes = kMixedPayloadSizes;
+    ASSERT_NO_FATALS(RunBenchmark(Format("ReactorSweep/$0", num_reactors), options));
+  }
 }
 
 } // namespace rpc
 } // namespace yb
-
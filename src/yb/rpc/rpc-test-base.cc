@@ -454,6 +454,14 @@ TestServer RpcTestBase::StartTestServer(const std::string& name, const IpAddress
   return TestServer(std::move(service), CreateMessenger("TestServer"), options);
 }
 
+void RpcTestBase::StartTestServer(std::unique_ptr<Messenger>&& messenger,
+                                  HostPort* server_hostport,
+                                  const TestServerOptions& options) {
+  std::unique_ptr<ServiceIf> service(new GenericCalculatorService(metric_entity_));
+  server_.reset(new TestServer(std::move(service), std::move(messenger), options));
+  *server_hostport = HostPort::FromBoundEndpoint(server_->bound_endpoint());
+}
+
 void RpcTestBase::StartTestServerWithGeneratedCode(HostPort* server_hostport,
                                                    const TestServerOptions& options) {
   server_.reset(new TestServer(
@@ -204,6 +204,9 @@ class RpcTestBase : public YBTest {
   void StartTestServer(Endpoint* server_endpoint,
                        const TestServerOptions& options = TestServerOptions());
   TestServer StartTestServer(const std::string& name, const IpAddress& address);
+  void StartTestServer(std::unique_ptr<Messenger>&& messenger,
+                       HostPort* server_hostport,
+                       const TestServerOptions& options = TestServerOptions());
   void StartTestServerWithGeneratedCode(HostPort* server_hostport,
                                         const TestServerOptions& options = TestServerOptions());
   void StartTestServerWithGeneratedCode(std::unique_ptr<Messenger>&& messenger,
@@ -50,6 +50,7 @@
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/secure_stream.h"
 #include "yb/rpc/serialization.h"
 #include "yb/rpc/tcp_stream.h"
@@ -63,7 +64,11 @@
 #include "yb/util/memory/memory_usage_test_util.h"
 
 METRIC_DECLARE_histogram(handler_latency_yb_rpc_test_CalculatorService_Sleep);
+METRIC_DECLARE_histogram(queue_time_yb_rpc_test_CalculatorService_Sleep);
+METRIC_DECLARE_histogram(response_transfer_time_yb_rpc_test_CalculatorService_Sleep);
 METRIC_DECLARE_histogram(rpc_incoming_queue_time);
+METRIC_DECLARE_counter(rpc_compression_bytes_saved);
+METRIC_DECLARE_counter(rpc_compression_bytes_sent);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -71,6 +76,7 @@ DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_int32(num_connections_to_server);
 DECLARE_bool(enable_rpc_keepalive);
+DECLARE_bool(enable_kernel_tls);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_int32(rpc_throttle_threshold_bytes);
 DECLARE_bool(TEST_pause_calculator_echo_request);
@@ -188,6 +194,58 @@ TEST_F(TestRpc, TestCall) {
   }
 }
 
+// Test that messenger sends calls over connections of its outbound messenger.
+TEST_F(TestRpc, OutboundMessenger) {
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  MessengerOptions messenger_options = kDefaultClientMessengerOptions;
+  messenger_options.n_reactors = 1;
+  messenger_options.num_connections_to_server = 1;
+  auto shared_messenger = CreateAutoShutdownMessengerHolder("Shared", messenger_options);
+  messenger_options.num_connections_to_server = 4;
+  auto builder = CreateMessengerBuilder("Client", messenger_options);
+  builder.set_outbound_messenger(shared_messenger.get());
+  auto client_messenger = rpc::CreateAutoShutdownMessengerHolder(ASSERT_RESULT(builder.Build()));
+  ASSERT_EQ(1, client_messenger->num_connections_to_server());
+
+  Proxy shared_proxy(shared_messenger.get(), server_addr);
+  Proxy client_proxy(client_messenger.get(), server_addr);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_OK(DoTestSyncCall(&shared_proxy, CalculatorServiceMethods::AddMethod()));
+    ASSERT_OK(DoTestSyncCall(&client_proxy, CalculatorServiceMethods::AddMethod()));
+  }
+
+  ASSERT_NO_FATALS(CheckClientMessengerConnections(shared_messenger.get(), 1));
+  ASSERT_NO_FATALS(CheckClientMessengerConnections(client_messenger.get(), 0));
+}
+
+// Test that fields serialized in advance are sent as a part of the request.
+TEST_F(TestRpc, SerializedRequestFields) {
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  // Serialized fields are parsed after fields of the request message, so the value of y from them
+  // overrides the one set in the request message.
+  AddRequestPB y_field;
+  y_field.set_y(20);
+  std::vector<RefCntBuffer> fields;
+  fields.emplace_back(y_field.SerializePartialAsString());
+
+  AddRequestPB req;
+  req.set_x(10);
+  req.set_y(1);
+  AddResponsePB resp;
+  RpcController controller;
+  controller.set_timeout(MonoDelta::FromMilliseconds(10000));
+  controller.set_serialized_request_fields(std::move(fields));
+  ASSERT_OK(p.SyncRequest(CalculatorServiceMethods::AddMethod(), req, &resp, &controller));
+  ASSERT_EQ(30, resp.result());
+}
+
 TEST_F(TestRpc, BigTimeout) {
   // Set up server.
   TestServerOptions options;
@@ -621,6 +679,17 @@ TEST_F(TestRpc, TestRpcHandlerLatencyMetric) {
   ASSERT_GE(latency_histogram->MaxValueForTests(), sleep_micros);
   ASSERT_TRUE(latency_histogram->MinValueForTests() == latency_histogram->MaxValueForTests());
 
+  auto queue_time_histogram = down_cast<Histogram*>(
+      FindOrDie(metric_map, &METRIC_queue_time_yb_rpc_test_CalculatorService_Sleep).get());
+  ASSERT_EQ(1, queue_time_histogram->TotalCount());
+
+  // Response transfer is completed on the server side asynchronously to the client receiving it.
+  auto response_transfer_time_histogram = down_cast<Histogram*>(FindOrDie(
+      metric_map, &METRIC_response_transfer_time_yb_rpc_test_CalculatorService_Sleep).get());
+  ASSERT_OK(WaitFor([response_transfer_time_histogram] {
+    return response_transfer_time_histogram->TotalCount() == 1;
+  }, 5s, "Response transferred"));
+
   // TODO: Implement an incoming queue latency test.
   // For now we just assert that the metric exists.
   YB_ASSERT_TRUE(FindOrDie(metric_map, &METRIC_rpc_incoming_queue_time));
@@ -1077,6 +1146,32 @@ TEST_F(TestRpcSecure, TLS) {
   ASSERT_EQ(30, resp.result());
 }
 
+// Kernel TLS could be unavailable in test environment, in this case connections should fallback to
+// encryption in user space.
+TEST_F(TestRpcSecure, KernelTls) {
+  FLAGS_enable_kernel_tls = true;
+  auto client_messenger = rpc::CreateAutoShutdownMessengerHolder(CreateSecureMessenger("Client"));
+  auto proxy_cache = std::make_unique<ProxyCache>(client_messenger.get());
+
+  TestServerOptions options;
+  HostPort server_hostport;
+  StartTestServerWithGeneratedCode(
+      CreateSecureMessenger("TestServer", kDefaultServerMessengerOptions), &server_hostport,
+      options);
+
+  rpc_test::CalculatorServiceProxy p(proxy_cache.get(), server_hostport, SecureStreamProtocol());
+
+  for (size_t size : std::vector<size_t>{10, 1_MB, 10}) {
+    RpcController controller;
+    controller.set_timeout(5s);
+    rpc_test::EchoRequestPB req;
+    req.set_data(RandomHumanReadableString(size));
+    rpc_test::EchoResponsePB resp;
+    ASSERT_OK(p.Echo(req, &resp, &controller));
+    ASSERT_EQ(req.data(), resp.data());
+  }
+}
+
 TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   // Set up server.
   TestServerOptions options = SetupServerForTestCantAllocateReadBuffer();
@@ -1090,5 +1185,57 @@ TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   TestCantAllocateReadBuffer(client_messenger.get(), server_addr);
 }
 
+class TestRpcCompression : public RpcTestBase {
+ protected:
+  std::unique_ptr<Messenger> CreateCompressedMessenger(
+      const std::string& name, const MessengerOptions& options = kDefaultClientMessengerOptions) {
+    auto builder = CreateMessengerBuilder(name, options);
+    builder.SetListenProtocol(CompressedStreamProtocol());
+    builder.AddStreamFactory(
+        CompressedStreamProtocol(),
+        CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker(),
+                                metric_entity()));
+    return EXPECT_RESULT(builder.Build());
+  }
+
+  void TestEcho(const Protocol* protocol, std::unique_ptr<Messenger> client_messenger) {
+    auto client_messenger_holder = rpc::CreateAutoShutdownMessengerHolder(
+        std::move(client_messenger));
+    auto proxy_cache = std::make_unique<ProxyCache>(client_messenger_holder.get());
+
+    TestServerOptions options;
+    HostPort server_hostport;
+    StartTestServerWithGeneratedCode(
+        CreateCompressedMessenger("TestServer", kDefaultServerMessengerOptions), &server_hostport,
+        options);
+
+    rpc_test::CalculatorServiceProxy p(proxy_cache.get(), server_hostport, protocol);
+
+    // Small request is sent uncompressed, while large one spans several frames.
+    for (size_t size : std::vector<size_t>{10, 1_MB}) {
+      RpcController controller;
+      controller.set_timeout(5s);
+      rpc_test::EchoRequestPB req;
+      req.set_data(RandomHumanReadableString(size / 16) + std::string(size, 'X'));
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(p.Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+  }
+};
+
+TEST_F(TestRpcCompression, Compression) {
+  TestEcho(CompressedStreamProtocol(), CreateCompressedMessenger("Client"));
+  auto bytes_saved = METRIC_rpc_compression_bytes_saved.Instantiate(metric_entity());
+  // Both request and response are compressed.
+  ASSERT_GT(bytes_saved->value(), 2_MB);
+}
+
+TEST_F(TestRpcCompression, PlainClient) {
+  TestEcho(TcpStream::StaticProtocol(), CreateMessenger("Client"));
+  auto bytes_sent = METRIC_rpc_compression_bytes_sent.Instantiate(metric_entity());
+  ASSERT_EQ(bytes_sent->value(), 0);
+}
+
 } // namespace rpc
 } // namespace yb
@@ -0,0 +1,228 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_RPC_BATCHER_H
+#define YB_RPC_RPC_BATCHER_H
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/rpc_header.pb.h"
+
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace rpc {
+
+// Coalesces RPCs of one kind, that are sent to the same destination, into one batched RPC.
+// Responses are copied to the responses of the individual requests, and their callbacks are
+// invoked.
+//
+// A batch is sent Traits::BatchWindow() after its first request was added, or as soon as it has
+// Traits::MaxBatchSize() requests.
+//
+// When the batch RPC fails, its requests are sent individually, so callers observe the same errors
+// as without batching, and batching to this destination is suspended until one of those succeeds.
+// When the destination reports that it does not implement the batched RPC, e.g. during rolling
+// upgrade, batching is not retried for kUnsupportedRetryInterval.
+//
+// Traits should provide:
+//   Proxy, Request, Response, BatchRequest and BatchResponse types.
+//   static const char* Name() - used in the log prefix.
+//   static void Send(Proxy*, const Request&, Response*, RpcController*, ResponseCallback) and
+//   static void SendBatch(Proxy*, const BatchRequest&, BatchResponse*, RpcController*,
+//                         ResponseCallback) - send individual and batched RPC.
+//   static Request* AddRequest(BatchRequest*),
+//   static const Request& GetRequest(const BatchRequest&, int),
+//   static int ResponseSize(const BatchResponse&) and
+//   static Response* MutableResponse(BatchResponse*, int) - access batched requests and responses.
+//   static MonoDelta BatchWindow(), static size_t MaxBatchSize() and
+//   static MonoDelta Timeout() - batching parameters and timeout of the batched RPC.
+template <class Traits>
+class RpcBatcher : public std::enable_shared_from_this<RpcBatcher<Traits>> {
+ public:
+  typedef typename Traits::Proxy Proxy;
+  typedef typename Traits::Request Request;
+  typedef typename Traits::Response Response;
+
+  static constexpr std::chrono::seconds kUnsupportedRetryInterval{60};
+
+  RpcBatcher(std::string destination, std::shared_ptr<Proxy> proxy, Messenger* messenger)
+      : destination_(std::move(destination)), proxy_(std::move(proxy)), messenger_(messenger) {
+  }
+
+  // Adds request to the current batch. The request is copied, response is filled and callback
+  // is invoked when the batch response is received. controller is only used when request has to
+  // be sent individually, otherwise its status stays OK.
+  void AddRequest(const Request& request, Response* response, RpcController* controller,
+                  ResponseCallback callback) {
+    ResponseTarget target{response, controller, std::move(callback)};
+    std::shared_ptr<Batch> full_batch;
+    bool schedule_flush = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (BatchingSuspendedUnlocked()) {
+        lock.unlock();
+        SendIndividually(request, target);
+        return;
+      }
+      if (!current_batch_) {
+        current_batch_ = std::make_shared<Batch>();
+        schedule_flush = true;
+      }
+      Traits::AddRequest(&current_batch_->request)->CopyFrom(request);
+      current_batch_->targets.push_back(std::move(target));
+      if (current_batch_->targets.size() >= std::max<size_t>(Traits::MaxBatchSize(), 1)) {
+        full_batch = std::move(current_batch_);
+      }
+    }
+
+    if (full_batch) {
+      SendBatch(std::move(full_batch));
+    } else if (schedule_flush) {
+      // The task keeps the batcher alive, so the batch is always sent and all callbacks are
+      // invoked, also when the task is aborted during shutdown.
+      messenger_->scheduler().Schedule(
+          [self = this->shared_from_this()](const Status& status) {
+            self->FlushBatch();
+          },
+          Traits::BatchWindow().ToSteadyDuration());
+    }
+  }
+
+  const std::shared_ptr<Proxy>& proxy() const { return proxy_; }
+
+ private:
+  struct ResponseTarget {
+    Response* response;
+    RpcController* controller;
+    ResponseCallback callback;
+  };
+
+  struct Batch {
+    typename Traits::BatchRequest request;
+    typename Traits::BatchResponse response;
+    RpcController controller;
+    std::vector<ResponseTarget> targets;
+  };
+
+  // Sends the current batch if it is not empty.
+  void FlushBatch() {
+    std::shared_ptr<Batch> batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batch = std::move(current_batch_);
+    }
+    if (batch) {
+      SendBatch(std::move(batch));
+    }
+  }
+
+  void SendBatch(std::shared_ptr<Batch> batch) {
+    VLOG_WITH_PREFIX(1) << "Sending " << batch->targets.size() << " batched requests";
+    auto& controller = batch->controller;
+    controller.set_timeout(Traits::Timeout());
+    auto* batch_ptr = batch.get();
+    Traits::SendBatch(
+        proxy_.get(), batch_ptr->request, &batch_ptr->response, &controller,
+        [self = this->shared_from_this(), batch = std::move(batch)] {
+          self->ProcessBatchResponse(batch);
+        });
+  }
+
+  void ProcessBatchResponse(const std::shared_ptr<Batch>& batch) {
+    const auto num_requests = batch->targets.size();
+    auto status = batch->controller.status();
+    if (status.ok() &&
+        static_cast<size_t>(Traits::ResponseSize(batch->response)) != num_requests) {
+      status = STATUS_FORMAT(
+          IllegalState, "Got $0 responses for $1 batched requests",
+          Traits::ResponseSize(batch->response), num_requests);
+    }
+
+    if (!status.ok()) {
+      const auto* error = batch->controller.error_response();
+      const bool unsupported =
+          error && error->has_code() && error->code() == ErrorStatusPB::ERROR_NO_SUCH_METHOD;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        suspended_ = true;
+        if (unsupported) {
+          unsupported_until_ = CoarseMonoClock::now() + kUnsupportedRetryInterval;
+        }
+      }
+      YB_LOG_WITH_PREFIX_EVERY_N_SECS(WARNING, 5)
+          << "Failed to send " << num_requests << " batched requests, sending them individually: "
+          << status;
+      for (size_t i = 0; i != num_requests; ++i) {
+        SendIndividually(Traits::GetRequest(batch->request, i), batch->targets[i]);
+      }
+      return;
+    }
+
+    for (size_t i = 0; i != num_requests; ++i) {
+      auto& target = batch->targets[i];
+      target.response->Swap(Traits::MutableResponse(&batch->response, i));
+      target.callback();
+    }
+  }
+
+  void SendIndividually(const Request& request, const ResponseTarget& target) {
+    auto* controller = target.controller;
+    Traits::Send(
+        proxy_.get(), request, target.response, controller,
+        [self = this->shared_from_this(), controller, callback = target.callback] {
+          if (controller->status().ok()) {
+            std::lock_guard<std::mutex> lock(self->mutex_);
+            self->suspended_ = false;
+          }
+          callback();
+        });
+  }
+
+  bool BatchingSuspendedUnlocked() {
+    return suspended_ || unsupported_until_ > CoarseMonoClock::now();
+  }
+
+  std::string LogPrefix() const {
+    return Format("$0 batcher to $1: ", Traits::Name(), destination_);
+  }
+
+  const std::string destination_;
+  const std::shared_ptr<Proxy> proxy_;
+  Messenger* const messenger_;
+
+  std::mutex mutex_;
+  std::shared_ptr<Batch> current_batch_;
+  // Set when a batch RPC fails, reset when a request sent individually succeeds.
+  bool suspended_ = false;
+  // Batching is not retried before this time after the destination reported that it does not
+  // implement the batched RPC.
+  CoarseTimePoint unsupported_until_;
+};
+
+template <class Traits>
+constexpr std::chrono::seconds RpcBatcher<Traits>::kUnsupportedRetryInterval;
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_RPC_BATCHER_H
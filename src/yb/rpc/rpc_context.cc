@@ -128,12 +128,14 @@ RpcContext::RpcContext(std::shared_ptr<LocalYBInboundCall> call,
 }
 
 void RpcContext::RespondSuccess() {
-  if (response_pb_->ByteSize() > FLAGS_rpc_max_message_size) {
+  // Response of local call is passed to the caller by pointer, so it is not limited by the max
+  // message size, and there is no need to calculate its size.
+  if (!call_->IsLocalCall() && response_pb_->ByteSize() > FLAGS_rpc_max_message_size) {
     RespondFailure(STATUS_FORMAT(InvalidArgument, "RPC message too long: $0 vs $1",
                                  response_pb_->ByteSize(), FLAGS_rpc_max_message_size));
     return;
   }
-  call_->RecordHandlingCompleted(metrics_.handler_latency);
+  call_->RecordHandlingCompleted(metrics_);
   TRACE_EVENT_ASYNC_END2("rpc_call", "RPC", this,
                          "response", TracePb(*response_pb_),
                          "trace", trace()->DumpToString(true));
@@ -142,7 +144,7 @@ void RpcContext::RespondSuccess() {
 }
 
 void RpcContext::RespondFailure(const Status &status) {
-  call_->RecordHandlingCompleted(metrics_.handler_latency);
+  call_->RecordHandlingCompleted(metrics_);
   TRACE_EVENT_ASYNC_END2("rpc_call", "RPC", this,
                          "status", status.ToString(),
                          "trace", trace()->DumpToString(true));
@@ -151,7 +153,7 @@ void RpcContext::RespondFailure(const Status &status) {
 }
 
 void RpcContext::RespondRpcFailure(ErrorStatusPB_RpcErrorCodePB err, const Status& status) {
-  call_->RecordHandlingCompleted(metrics_.handler_latency);
+  call_->RecordHandlingCompleted(metrics_);
   TRACE_EVENT_ASYNC_END2("rpc_call", "RPC", this,
                          "status", status.ToString(),
                          "trace", trace()->DumpToString(true));
@@ -161,7 +163,7 @@ void RpcContext::RespondRpcFailure(ErrorStatusPB_RpcErrorCodePB err, const Statu
 
 void RpcContext::RespondApplicationError(int error_ext_id, const std::string& message,
                                          const Message& app_error_pb) {
-  call_->RecordHandlingCompleted(metrics_.handler_latency);
+  call_->RecordHandlingCompleted(metrics_);
   TRACE_EVENT_ASYNC_END2("rpc_call", "RPC", this,
                          "response", TracePb(app_error_pb),
                          "trace", trace()->DumpToString(true));
@@ -173,6 +175,10 @@ size_t RpcContext::AddRpcSidecar(const Slice& car) {
   return call_->AddRpcSidecar(car);
 }
 
+size_t RpcContext::AddRpcSidecar(RefCntBuffer car) {
+  return call_->AddRpcSidecar(std::move(car));
+}
+
 void RpcContext::ResetRpcSidecars() {
   call_->ResetRpcSidecars();
 }
@@ -174,6 +174,9 @@ class RpcContext {
   // Returns the index of the sidecar.
   size_t AddRpcSidecar(const Slice& car);
 
+  // Same as above, but the buffer is sent as is, without copying its data.
+  size_t AddRpcSidecar(RefCntBuffer car);
+
   // Removes all RpcSidecars.
   void ResetRpcSidecars();
 
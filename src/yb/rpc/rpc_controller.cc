@@ -70,6 +70,7 @@ void RpcController::Swap(RpcController* other) {
   std::swap(allow_local_calls_in_curr_thread_, other->allow_local_calls_in_curr_thread_);
   std::swap(call_, other->call_);
   std::swap(invoke_callback_mode_, other->invoke_callback_mode_);
+  std::swap(serialized_request_fields_, other->serialized_request_fields_);
 }
 
 void RpcController::Reset() {
@@ -78,6 +79,7 @@ void RpcController::Reset() {
     CHECK(finished());
   }
   call_.reset();
+  serialized_request_fields_.clear();
 }
 
 bool RpcController::finished() const {
@@ -105,6 +107,10 @@ Result<Slice> RpcController::GetSidecar(int idx) const {
   return call_->GetSidecar(idx);
 }
 
+std::shared_ptr<const void> RpcController::ResponseHolder() const {
+  return call_;
+}
+
 void RpcController::set_timeout(const MonoDelta& timeout) {
   std::lock_guard<simple_spinlock> l(lock_);
   DCHECK(!call_ || call_->state() == RpcCallState::READY);
@@ -33,6 +33,7 @@
 #define YB_RPC_RPC_CONTROLLER_H
 
 #include <memory>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -40,6 +41,7 @@
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -144,6 +146,14 @@ class RpcController {
 
   InvokeCallbackMode invoke_callback_mode() { return invoke_callback_mode_; }
 
+  // Sets buffers with already serialized fields of the request message, that are sent right after
+  // the fields serialized from the request message itself, so the receiver parses them as a part
+  // of the request. Allows sending the same fields to multiple servers without serializing them
+  // for each call. Buffers are consumed by the next call made with this controller.
+  void set_serialized_request_fields(std::vector<RefCntBuffer> fields) {
+    serialized_request_fields_ = std::move(fields);
+  }
+
   // Return the configured timeout.
   MonoDelta timeout() const;
 
@@ -155,7 +165,13 @@ class RpcController {
   // May fail if index is invalid.
   Result<Slice> GetSidecar(int idx) const;
 
+  // Returns the object that owns memory of the received response. Holding it keeps slices returned
+  // by GetSidecar valid after the controller is Reset() or destroyed, so sidecars could be used
+  // without copying them.
+  std::shared_ptr<const void> ResponseHolder() const;
+
  private:
+  friend class LocalOutboundCall;
   friend class OutboundCall;
   friend class Proxy;
 
@@ -167,6 +183,7 @@ class RpcController {
   OutboundCallPtr call_;
   bool allow_local_calls_in_curr_thread_ = false;
   InvokeCallbackMode invoke_callback_mode_ = InvokeCallbackMode::kThreadPoolNormal;
+  std::vector<RefCntBuffer> serialized_request_fields_;
 
   DISALLOW_COPY_AND_ASSIGN(RpcController);
 };
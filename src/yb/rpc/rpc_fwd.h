@@ -97,6 +97,9 @@ typedef std::shared_ptr<OutboundData> OutboundDataPtr;
 class ServerEventList;
 typedef std::shared_ptr<ServerEventList> ServerEventListPtr;
 
+// Selects connections, that should receive a server event.
+typedef std::function<bool(const ConnectionPtr&)> ConnectionFilter;
+
 class ServiceIf;
 typedef std::shared_ptr<ServiceIf> ServiceIfPtr;
 
@@ -26,6 +26,8 @@
 #include "yb/util/memory/memory.h"
 #include "yb/util/tostring.h"
 
+DECLARE_int32(rpc_scheduler_wheel_tick_ms);
+
 namespace yb {
 namespace rpc {
 
@@ -33,9 +35,11 @@ using std::shared_ptr;
 using namespace std::placeholders;
 using namespace std::literals;
 
-class SchedulerTest : public RpcTestBase {
+// Parameter is the tick of scheduler timer wheel in milliseconds, 0 means that wheel is not used.
+class SchedulerTest : public RpcTestBase, public testing::WithParamInterface<int> {
  public:
   void SetUp() override {
+    FLAGS_rpc_scheduler_wheel_tick_ms = GetParam();
     pool_.emplace("test", 1);
     scheduler_.emplace(&pool_->io_service());
   }
@@ -57,7 +61,7 @@ auto SetPromiseValueToStatusFunctor(std::promise<Status>* promise) {
   return [promise](Status status) { promise->set_value(std::move(status)); };
 }
 
-TEST_F(SchedulerTest, TestFunctionIsCalled) {
+TEST_P(SchedulerTest, TestFunctionIsCalled) {
   for (int i = 0; i != kCycles; ++i) {
     std::promise<Status> promise;
     auto future = promise.get_future();
@@ -66,7 +70,7 @@ TEST_F(SchedulerTest, TestFunctionIsCalled) {
   }
 }
 
-TEST_F(SchedulerTest, TestFunctionIsCalledAtTheRightTime) {
+TEST_P(SchedulerTest, TestFunctionIsCalledAtTheRightTime) {
   using yb::ToString;
 
   for (int i = 0; i != 10; ++i) {
@@ -83,12 +87,13 @@ TEST_F(SchedulerTest, TestFunctionIsCalledAtTheRightTime) {
 #else
     auto upper = delay + 50ms;
 #endif
+    upper += std::chrono::milliseconds(GetParam());
     CHECK(delta >= delay) << "Delta: " << ToString(delta) << ", lower bound: " << ToString(delay);
     CHECK(delta < upper) << "Delta: " << ToString(delta) << ", upper bound: " << ToString(upper);
   }
 }
 
-TEST_F(SchedulerTest, TestFunctionIsCalledIfReactorShutdown) {
+TEST_P(SchedulerTest, TestFunctionIsCalledIfReactorShutdown) {
   std::promise<Status> promise;
   auto future = promise.get_future();
   scheduler_->Schedule(SetPromiseValueToStatusFunctor(&promise), 60s);
@@ -96,7 +101,7 @@ TEST_F(SchedulerTest, TestFunctionIsCalledIfReactorShutdown) {
   ASSERT_TRUE(future.get().IsAborted());
 }
 
-TEST_F(SchedulerTest, Abort) {
+TEST_P(SchedulerTest, Abort) {
   for (int i = 0; i != kCycles; ++i) {
     std::promise<Status> promise;
     auto future = promise.get_future();
@@ -108,7 +113,7 @@ TEST_F(SchedulerTest, Abort) {
   }
 }
 
-TEST_F(SchedulerTest, Shutdown) {
+TEST_P(SchedulerTest, Shutdown) {
   const size_t kThreads = 8;
   std::vector<std::thread> threads;
   std::atomic<size_t> scheduled(0);
@@ -141,5 +146,38 @@ TEST_F(SchedulerTest, Shutdown) {
   ASSERT_EQ(scheduled.load(std::memory_order_acquire), executed.load(std::memory_order_acquire));
 }
 
+TEST_P(SchedulerTest, ManyTasks) {
+  constexpr int kTasks = 10000;
+  std::atomic<int> executed(0);
+  std::atomic<int> aborted(0);
+  std::atomic<bool> early(false);
+  CountDownLatch latch(kTasks);
+  std::vector<ScheduledTaskId> task_ids;
+  for (int i = 0; i != kTasks; ++i) {
+    auto time = std::chrono::steady_clock::now() + std::chrono::milliseconds(i % 300);
+    task_ids.push_back(scheduler_->Schedule([&, time](const Status& status) {
+      if (status.ok()) {
+        ++executed;
+        if (std::chrono::steady_clock::now() < time) {
+          early = true;
+        }
+      } else if (status.IsAborted()) {
+        ++aborted;
+      }
+      latch.CountDown();
+    }, time));
+  }
+  // Abort every tenth task, some of them could be already executed.
+  for (int i = 0; i < kTasks; i += 10) {
+    scheduler_->Abort(task_ids[i]);
+  }
+  ASSERT_TRUE(latch.WaitFor(10s));
+  ASSERT_FALSE(early.load());
+  ASSERT_EQ(kTasks, executed.load() + aborted.load());
+  ASSERT_LE(aborted.load(), kTasks / 10);
+}
+
+INSTANTIATE_TEST_CASE_P(WheelTick, SchedulerTest, ::testing::Values(0, 1, 10));
+
 } // namespace rpc
 } // namespace yb
@@ -15,6 +15,11 @@
 
 #include "yb/rpc/scheduler.h"
 
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 
@@ -26,6 +31,7 @@
 #include <glog/logging.h>
 
 #include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/status.h"
 
 using namespace std::placeholders;
@@ -33,22 +39,55 @@ using boost::multi_index::const_mem_fun;
 using boost::multi_index::hashed_unique;
 using boost::multi_index::ordered_non_unique;
 
+DEFINE_int32(rpc_scheduler_wheel_tick_ms, 0,
+             "When positive, scheduler keeps tasks in a hashed timer wheel with ticks of this "
+             "duration, instead of ordering them by time. So scheduling and aborting a task "
+             "takes constant time, but task could be run up to one tick later than requested.");
+TAG_FLAG(rpc_scheduler_wheel_tick_ms, advanced);
+
 namespace yb {
 namespace rpc {
 
+namespace {
+
+// Number of slots in timer wheel. Tasks that are scheduled further than this number of ticks
+// share slots with earlier tasks, and are skipped until their tick.
+constexpr size_t kWheelSlots = 512;
+
+} // namespace
+
 class Scheduler::Impl {
  public:
   explicit Impl(IoService* io_service)
-      : io_service_(*io_service), strand_(*io_service), timer_(*io_service) {}
+      : io_service_(*io_service), strand_(*io_service), timer_(*io_service),
+        wheel_tick_(std::chrono::milliseconds(std::max(FLAGS_rpc_scheduler_wheel_tick_ms, 0))),
+        wheel_start_(std::chrono::steady_clock::now()) {
+    if (UseWheel()) {
+      wheel_.resize(kWheelSlots);
+    }
+  }
 
   ~Impl() {
     Shutdown();
     DCHECK_EQ(timer_counter_, 0);
     DCHECK(tasks_.empty());
+    DCHECK(wheel_index_.empty());
   }
 
   void Abort(ScheduledTaskId task_id) {
     strand_.dispatch([this, task_id] {
+      if (UseWheel()) {
+        auto it = wheel_index_.find(task_id);
+        if (it != wheel_index_.end()) {
+          auto& slot = wheel_[it->second.first];
+          io_service_.post([task = it->second.second->task] {
+            task->Run(STATUS(Aborted, "Task aborted"));
+          });
+          slot.erase(it->second.second);
+          wheel_index_.erase(it);
+        }
+        return;
+      }
       auto& index = tasks_.get<IdTag>();
       auto it = index.find(task_id);
       if (it != index.end()) {
@@ -74,6 +113,13 @@ class Scheduler::Impl {
           io_service_.post([task, status] { task->Run(status); });
         }
         tasks_.clear();
+        for (auto& slot : wheel_) {
+          for (auto& entry : slot) {
+            io_service_.post([task = entry.task, status] { task->Run(status); });
+          }
+          slot.clear();
+        }
+        wheel_index_.clear();
       });
     }
   }
@@ -87,6 +133,11 @@ class Scheduler::Impl {
         return;
       }
 
+      if (UseWheel()) {
+        ScheduleInWheel(task);
+        return;
+      }
+
       auto pair = tasks_.insert(task);
       CHECK(pair.second);
       if (pair.first == tasks_.begin()) {
@@ -104,6 +155,88 @@ class Scheduler::Impl {
   }
 
  private:
+  struct WheelEntry {
+    std::shared_ptr<ScheduledTaskBase> task;
+    // Number of the tick that the task should be run at.
+    int64_t tick;
+  };
+
+  typedef std::list<WheelEntry> WheelSlot;
+
+  bool UseWheel() const {
+    return wheel_tick_ != std::chrono::steady_clock::duration::zero();
+  }
+
+  // Returns the first tick, that is not before the specified time.
+  int64_t TickNotBefore(SteadyTimePoint time) const {
+    auto ticks = (time - wheel_start_) / wheel_tick_;
+    return wheel_start_ + ticks * wheel_tick_ < time ? ticks + 1 : ticks;
+  }
+
+  void ScheduleInWheel(const std::shared_ptr<ScheduledTaskBase>& task) {
+    DCHECK(strand_.running_in_this_thread());
+
+    auto tick = TickNotBefore(task->time());
+    if (tick <= current_tick_) {
+      io_service_.post([task] { task->Run(Status::OK()); });
+      return;
+    }
+
+    auto slot_idx = tick % kWheelSlots;
+    auto& slot = wheel_[slot_idx];
+    slot.push_back(WheelEntry{task, tick});
+    CHECK(wheel_index_.emplace(task->id(), std::make_pair(slot_idx, --slot.end())).second);
+    if (wheel_index_.size() == 1) {
+      StartWheelTimer();
+    }
+  }
+
+  void StartWheelTimer() {
+    DCHECK(strand_.running_in_this_thread());
+
+    boost::system::error_code ec;
+    timer_.expires_at(wheel_start_ + (current_tick_ + 1) * wheel_tick_, ec);
+    LOG_IF(ERROR, ec) << "Reschedule timer failed: " << ec.message();
+    ++timer_counter_;
+    timer_.async_wait(strand_.wrap(std::bind(&Impl::HandleWheelTimer, this, _1)));
+  }
+
+  void HandleWheelTimer(const boost::system::error_code& ec) {
+    DCHECK(strand_.running_in_this_thread());
+    --timer_counter_;
+
+    if (ec) {
+      LOG_IF(ERROR, ec != boost::asio::error::operation_aborted) << "Wait failed: " << ec.message();
+      return;
+    }
+    if (closing_.load(std::memory_order_acquire)) {
+      return;
+    }
+
+    auto now_tick = (std::chrono::steady_clock::now() - wheel_start_) / wheel_tick_;
+    // Timer is not running while wheel is empty, so there could be a lot of passed ticks.
+    // But visiting each slot once is enough to find all due tasks.
+    auto num_ticks = std::min<int64_t>(now_tick - current_tick_, kWheelSlots);
+    for (int64_t i = 1; i <= num_ticks; ++i) {
+      auto& slot = wheel_[(current_tick_ + i) % kWheelSlots];
+      for (auto it = slot.begin(); it != slot.end();) {
+        if (it->tick > now_tick) {
+          ++it;
+          continue;
+        }
+        auto task = std::move(it->task);
+        wheel_index_.erase(task->id());
+        it = slot.erase(it);
+        io_service_.post([task = std::move(task)] { task->Run(Status::OK()); });
+      }
+    }
+    current_tick_ = std::max<int64_t>(current_tick_, now_tick);
+
+    if (!wheel_index_.empty()) {
+      StartWheelTimer();
+    }
+  }
+
   void StartTimer() {
     DCHECK(strand_.running_in_this_thread());
     DCHECK(!tasks_.empty());
@@ -156,11 +289,21 @@ class Scheduler::Impl {
   IoService& io_service_;
   std::atomic<ScheduledTaskId> id_ = {0};
   Tasks tasks_;
-  // Strand that protects tasks_ and timer_ fields.
+  // Strand that protects tasks_, timer_ and wheel fields.
   boost::asio::io_service::strand strand_;
   boost::asio::steady_timer timer_;
   int timer_counter_ = 0;
   std::atomic<bool> closing_ = {false};
+
+  // Duration of wheel tick, zero when tasks are ordered by time in tasks_.
+  const std::chrono::steady_clock::duration wheel_tick_;
+  // Time of tick 0.
+  const SteadyTimePoint wheel_start_;
+  // Last tick whose tasks were run. All tasks in the wheel have greater ticks.
+  int64_t current_tick_ = 0;
+  std::vector<WheelSlot> wheel_;
+  // Maps task id to its slot and position in it.
+  std::unordered_map<ScheduledTaskId, std::pair<size_t, WheelSlot::iterator>> wheel_index_;
 };
 
 Scheduler::Scheduler(IoService* io_service) : impl_(new Impl(io_service)) {}
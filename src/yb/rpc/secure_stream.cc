@@ -13,8 +13,11 @@
 
 #include "yb/rpc/secure_stream.h"
 
+#include <netinet/tcp.h>
+
 #include <openssl/evp.h>
 #include <openssl/err.h>
+#include <openssl/hmac.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 #include <openssl/x509v3.h>
@@ -30,10 +33,29 @@
 #include "yb/util/size_literals.h"
 #include "yb/util/encryption_util.h"
 
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#define YB_RPC_KERNEL_TLS_SUPPORTED 1
+#endif
+#endif
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+
 using namespace std::literals;
 
 DEFINE_bool(allow_insecure_connections, true, "Whether we should allow insecure connections.");
 DEFINE_bool(dump_certificate_entries, false, "Whether we should dump certificate entries.");
+DEFINE_bool(enable_kernel_tls, false,
+            "Whether we should offload encryption of sent data to the kernel (kTLS) after TLS "
+            "handshake. TLS 1.3 is not negotiated when enabled. Connections that cannot use kTLS "
+            "encrypt data in user space.");
 
 namespace yb {
 namespace rpc {
@@ -292,6 +314,117 @@ Status SecureContext::UseCertificate(const Slice& data) {
 
 namespace {
 
+#ifdef YB_RPC_KERNEL_TLS_SUPPORTED
+
+// TLS 1.2 pseudorandom function, see RFC 5246 section 5.
+CHECKED_STATUS Tls12Prf(
+    const EVP_MD* md, const Slice& secret, const Slice& label, const Slice& seed, uint8_t* out,
+    size_t out_size) {
+  const std::string label_and_seed = label.ToBuffer() + seed.ToBuffer();
+  // A(0) = seed, A(i) = HMAC(secret, A(i - 1)).
+  std::string a = label_and_seed;
+  uint8_t block[EVP_MAX_MD_SIZE];
+  unsigned int block_size = 0;
+  while (out_size > 0) {
+    if (!HMAC(md, secret.data(), secret.size(), pointer_cast<const uint8_t*>(a.data()), a.size(),
+              block, &block_size)) {
+      return SSL_STATUS(InternalError, "HMAC failed: $0");
+    }
+    a.assign(pointer_cast<const char*>(block), block_size);
+    // Output block is HMAC(secret, A(i) + seed).
+    const std::string input = a + label_and_seed;
+    if (!HMAC(md, secret.data(), secret.size(), pointer_cast<const uint8_t*>(input.data()),
+              input.size(), block, &block_size)) {
+      return SSL_STATUS(InternalError, "HMAC failed: $0");
+    }
+    auto size = std::min<size_t>(out_size, block_size);
+    memcpy(out, block, size);
+    out += size;
+    out_size -= size;
+  }
+  return Status::OK();
+}
+
+template <class CryptoInfo>
+CHECKED_STATUS SetKernelTlsTx(
+    int fd, uint16_t cipher_type, const uint8_t* key, const uint8_t* salt) {
+  CryptoInfo info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = TLS_1_2_VERSION;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, key, sizeof(info.key));
+  memcpy(info.salt, salt, sizeof(info.salt));
+  // The only record encrypted with session keys so far is Finished, that has sequence number 0.
+  // Record sequence number is also used as explicit nonce.
+  info.rec_seq[sizeof(info.rec_seq) - 1] = 1;
+  static_assert(sizeof(info.iv) == sizeof(info.rec_seq), "Unexpected IV size");
+  memcpy(info.iv, info.rec_seq, sizeof(info.iv));
+
+  if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+    return STATUS(NotSupported, "Failed to set TLS ULP", Errno(errno));
+  }
+  if (setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info)) != 0) {
+    return STATUS(NotSupported, "Failed to set TLS_TX", Errno(errno));
+  }
+  return Status::OK();
+}
+
+// Passes write key of established TLS 1.2 session to the kernel, so it would encrypt data sent
+// to the socket. Only AES GCM ciphers are supported.
+CHECKED_STATUS EnableKernelTlsTx(SSL* ssl, int fd, bool is_client) {
+  if (SSL_version(ssl) != TLS1_2_VERSION) {
+    return STATUS_FORMAT(NotSupported, "Kernel TLS is not supported for $0", SSL_get_version(ssl));
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  const int cipher_nid = SSL_CIPHER_get_cipher_nid(cipher);
+  size_t key_size;
+  const EVP_MD* md;
+  if (cipher_nid == NID_aes_128_gcm) {
+    key_size = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    md = EVP_sha256();
+#ifdef TLS_CIPHER_AES_GCM_256
+  } else if (cipher_nid == NID_aes_256_gcm) {
+    key_size = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    md = EVP_sha384();
+#endif
+  } else {
+    return STATUS_FORMAT(NotSupported, "Kernel TLS is not supported for cipher $0",
+                         SSL_CIPHER_get_name(cipher));
+  }
+  constexpr size_t kMaxKeySize = 32;
+  constexpr size_t kSaltSize = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+
+  uint8_t master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  auto master_key_size = SSL_SESSION_get_master_key(
+      SSL_get_session(ssl), master_key, sizeof(master_key));
+  uint8_t seed[2 * SSL3_RANDOM_SIZE];
+  SSL_get_server_random(ssl, seed, SSL3_RANDOM_SIZE);
+  SSL_get_client_random(ssl, seed + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+  // Key block of AEAD cipher consists of client write key, server write key, client write IV and
+  // server write IV. Only fixed part of IV, i.e. salt, is present there.
+  uint8_t key_block[2 * (kMaxKeySize + kSaltSize)];
+  RETURN_NOT_OK(Tls12Prf(
+      md, Slice(master_key, master_key_size), "key expansion", Slice(seed, sizeof(seed)),
+      key_block, 2 * (key_size + kSaltSize)));
+  const uint8_t* key = key_block + (is_client ? 0 : key_size);
+  const uint8_t* salt = key_block + 2 * key_size + (is_client ? 0 : kSaltSize);
+
+#ifdef TLS_CIPHER_AES_GCM_256
+  if (key_size == TLS_CIPHER_AES_GCM_256_KEY_SIZE) {
+    return SetKernelTlsTx<tls12_crypto_info_aes_gcm_256>(fd, TLS_CIPHER_AES_GCM_256, key, salt);
+  }
+#endif
+  return SetKernelTlsTx<tls12_crypto_info_aes_gcm_128>(fd, TLS_CIPHER_AES_GCM_128, key, salt);
+}
+
+#endif // YB_RPC_KERNEL_TLS_SUPPORTED
+
+// kRequested - session is configured to use kernel TLS after handshake.
+// kPending - handshake is completed, waiting for data encrypted by OpenSSL to be written to socket.
+// kEnabled - sent data is encrypted by the kernel.
+YB_DEFINE_ENUM(KernelTlsState, (kNone)(kRequested)(kPending)(kEnabled));
+
 class SecureStream : public Stream, public StreamContext {
  public:
   SecureStream(const SecureContext& context, std::unique_ptr<Stream> lower_stream,
@@ -318,6 +451,11 @@ class SecureStream : public Stream, public StreamContext {
   void ParseReceived() override;
 
   void Cancelled(size_t handle) override {
+    // Handle belongs to lower stream, when data is sent to it as is.
+    if (state_ == SecureState::kDisabled || kernel_tls_state_ == KernelTlsState::kEnabled) {
+      lower_stream_->Cancelled(handle);
+      return;
+    }
     LOG_WITH_PREFIX(DFATAL) << "Cancel is not supported for secure stream: " << handle;
   }
 
@@ -350,6 +488,8 @@ class SecureStream : public Stream, public StreamContext {
 
   CHECKED_STATUS Init();
   void Established(SecureState state);
+  void SendPending();
+  void StartKernelTls();
   static int VerifyCallback(int preverified, X509_STORE_CTX* store_context);
   bool Verify(bool preverified, X509_STORE_CTX* store_context);
   void WriteEncrypted(OutboundDataPtr data);
@@ -364,6 +504,7 @@ class SecureStream : public Stream, public StreamContext {
   StreamContext* context_;
   size_t decrypted_bytes_to_skip_ = 0;
   SecureState state_ = SecureState::kInitial;
+  KernelTlsState kernel_tls_state_ = KernelTlsState::kNone;
   bool need_connect_ = false;
   bool connected_ = false;
   std::vector<OutboundDataPtr> pending_data_;
@@ -405,6 +546,13 @@ size_t SecureStream::Send(OutboundDataPtr data) {
     pending_data_.push_back(std::move(data));
     return std::numeric_limits<size_t>::max();
   case SecureState::kEnabled: {
+      if (kernel_tls_state_ == KernelTlsState::kPending) {
+        pending_data_.push_back(std::move(data));
+        return std::numeric_limits<size_t>::max();
+      }
+      if (kernel_tls_state_ == KernelTlsState::kEnabled) {
+        return lower_stream_->Send(std::move(data));
+      }
       boost::container::small_vector<RefCntBuffer, 10> queue;
       data->Serialize(&queue);
       for (const auto& buf : queue) {
@@ -467,7 +615,9 @@ const Endpoint& SecureStream::Local() {
 }
 
 std::string SecureStream::ToString() {
-  return Format("SECURE $0 $1", state_, lower_stream_->ToString());
+  return Format("SECURE $0$1 $2", state_,
+                kernel_tls_state_ == KernelTlsState::kEnabled ? " KTLS" : "",
+                lower_stream_->ToString());
 }
 
 void SecureStream::UpdateLastActivity() {
@@ -484,6 +634,10 @@ void SecureStream::UpdateLastWrite() {
 
 void SecureStream::Transferred(const OutboundDataPtr& data, const Status& status) {
   context_->Transferred(data, status);
+  if (kernel_tls_state_ == KernelTlsState::kPending && status.ok() &&
+      lower_stream_->GetPendingWriteBytes() == 0) {
+    StartKernelTls();
+  }
 }
 
 void SecureStream::Destroy(const Status& status) {
@@ -701,6 +855,18 @@ Status SecureStream::Init() {
     bio_.reset(temp_bio);
 
     SSL_set_verify(ssl_.get(), SSL_VERIFY_PEER, &VerifyCallback);
+
+#ifdef YB_RPC_KERNEL_TLS_SUPPORTED
+    if (FLAGS_enable_kernel_tls && lower_stream_->socket()) {
+      // Kernel is configured with TLS 1.2 session keys, and session keys should not change after
+      // they were passed to the kernel.
+      SSL_set_max_proto_version(ssl_.get(), TLS1_2_VERSION);
+#ifdef SSL_OP_NO_RENEGOTIATION
+      SSL_set_options(ssl_.get(), SSL_OP_NO_RENEGOTIATION);
+#endif
+      kernel_tls_state_ = KernelTlsState::kRequested;
+    }
+#endif
   }
 
   return Status::OK();
@@ -710,13 +876,46 @@ void SecureStream::Established(SecureState state) {
   VLOG_WITH_PREFIX(4) << "Established with state: " << state;
 
   state_ = state;
+  if (state == SecureState::kEnabled && kernel_tls_state_ == KernelTlsState::kRequested) {
+    kernel_tls_state_ = KernelTlsState::kPending;
+  }
   ResetLogPrefix();
   connected_ = true;
   context_->Connected();
-  for (auto& data : pending_data_) {
-    Send(std::move(data));
+  if (kernel_tls_state_ == KernelTlsState::kPending) {
+    // Handshake data encrypted by OpenSSL should be written to the socket before the kernel starts
+    // encrypting, so sending is postponed until then.
+    if (lower_stream_->GetPendingWriteBytes() == 0) {
+      StartKernelTls();
+    }
+    return;
   }
+  SendPending();
+}
+
+void SecureStream::SendPending() {
+  auto pending_data = std::move(pending_data_);
   pending_data_.clear();
+  for (auto& data : pending_data) {
+    Send(std::move(data));
+  }
+}
+
+void SecureStream::StartKernelTls() {
+#ifdef YB_RPC_KERNEL_TLS_SUPPORTED
+  auto status = EnableKernelTlsTx(ssl_.get(), lower_stream_->socket()->GetFd(), need_connect_);
+#else
+  auto status = STATUS(NotSupported, "Kernel TLS is not supported");
+#endif
+  if (status.ok()) {
+    kernel_tls_state_ = KernelTlsState::kEnabled;
+  } else {
+    YB_LOG_EVERY_N_SECS(WARNING, 60) << LogPrefix() << "Kernel TLS is not used: " << status;
+    kernel_tls_state_ = KernelTlsState::kNone;
+  }
+  VLOG_WITH_PREFIX(4) << "Kernel TLS: " << kernel_tls_state_;
+  ResetLogPrefix();
+  SendPending();
 }
 
 int SecureStream::VerifyCallback(int preverified, X509_STORE_CTX* store_context) {
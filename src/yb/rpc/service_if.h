@@ -58,6 +58,10 @@ struct RpcMethodMetrics {
   ~RpcMethodMetrics();
 
   scoped_refptr<Histogram> handler_latency;
+  // Time spent by the call in the service thread pool queue.
+  scoped_refptr<Histogram> queue_time;
+  // Time from queueing the response until it was written to the connection.
+  scoped_refptr<Histogram> response_transfer_time;
 };
 
 // Handles incoming messages that initiate an RPC.
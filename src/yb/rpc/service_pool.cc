@@ -33,8 +33,10 @@
 #include "yb/rpc/service_pool.h"
 
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/asio/strand.hpp>
@@ -76,6 +78,13 @@ DEFINE_int64(backpressure_recovery_period_ms, 600000,
              "for this duration (in ms)");
 TAG_FLAG(backpressure_recovery_period_ms, advanced);
 TAG_FLAG(backpressure_recovery_period_ms, runtime);
+DEFINE_double(rpc_queue_max_connection_share, 0.5,
+              "When the service queue is at least half full, calls from a connection that "
+              "already has this share of the queue limit queued are rejected, so a single client "
+              "could not occupy the whole queue and starve other clients. Value of 1 or greater "
+              "disables the per connection limit.");
+TAG_FLAG(rpc_queue_max_connection_share, advanced);
+TAG_FLAG(rpc_queue_max_connection_share, runtime);
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
@@ -145,6 +154,21 @@ class ServicePoolImpl final : public InboundCallHandler {
                   description, MetricUnit::kRequests, description, MetricLevel::kInfo)),
               static_cast<int64>(0) /* initial_value */);
 
+          // Create per service histogram for queue time, so queue time of high priority services
+          // could be distinguished from the others.
+          auto queue_time_id = Format("rpc_incoming_queue_time_$0", service_->service_name());
+          EscapeMetricNameForPrometheus(&queue_time_id);
+          string queue_time_description = Format(
+              "Number of microseconds incoming $0 requests spend in the worker queue",
+              service_->service_name());
+          service_incoming_queue_time_ = entity->FindOrCreateHistogram(
+              std::make_unique<OwningHistogramPrototype>(
+                  OwningMetricCtorArgs(
+                      entity->prototype().name(), std::move(queue_time_id),
+                      queue_time_description, MetricUnit::kMicroseconds, queue_time_description,
+                      MetricLevel::kInfo),
+                  60000000LU, 2));
+
           LOG_WITH_PREFIX(INFO) << "yb::rpc::ServicePoolImpl created at " << this;
   }
 
@@ -248,6 +272,7 @@ class ServicePoolImpl final : public InboundCallHandler {
 
   void Handle(InboundCallPtr incoming) override {
     incoming->RecordHandlingStarted(incoming_queue_time_);
+    service_incoming_queue_time_->Increment(incoming->GetTimeInQueue().ToMicroseconds());
     ADOPT_TRACE(incoming->trace());
 
     const char* error_message;
@@ -379,13 +404,13 @@ class ServicePoolImpl final : public InboundCallHandler {
     return log_prefix_;
   }
 
-  bool CallQueued() override {
+  bool CallQueued(const InboundCall& call) override {
     auto queued_calls = queued_calls_.fetch_add(1, std::memory_order_acq_rel);
     if (queued_calls < 0) {
       YB_LOG_EVERY_N_SECS(DFATAL, 5) << "Negative number of queued calls: " << queued_calls;
     }
 
-    if (queued_calls >= max_queued_calls_) {
+    if (queued_calls >= max_queued_calls_ || !ConnectionCallQueued(call, queued_calls)) {
       queued_calls_.fetch_sub(1, std::memory_order_relaxed);
       return false;
     }
@@ -394,11 +419,47 @@ class ServicePoolImpl final : public InboundCallHandler {
     return true;
   }
 
-  void CallDequeued() override {
+  void CallDequeued(const InboundCall& call) override {
+    ConnectionCallDequeued(call);
     queued_calls_.fetch_sub(1, std::memory_order_relaxed);
     rpcs_in_queue_->Decrement();
   }
 
+  // Accounts call in the number of calls queued from its connection. Returns false if the queue
+  // is under pressure and the connection already has more than its share of queued calls.
+  bool ConnectionCallQueued(const InboundCall& call, int64_t queued_calls) {
+    auto connection = call.connection();
+    if (!connection) {
+      return true;
+    }
+    auto max_share = GetAtomicFlag(&FLAGS_rpc_queue_max_connection_share);
+    size_t max_connection_calls = std::max<size_t>(max_queued_calls_ * max_share, 1);
+    std::lock_guard<std::mutex> lock(connection_queued_calls_mutex_);
+    auto it = connection_queued_calls_.emplace(connection.get(), 0).first;
+    if (max_share < 1 && static_cast<size_t>(queued_calls) * 2 >= max_queued_calls_ &&
+        it->second >= max_connection_calls) {
+      return false;
+    }
+    ++it->second;
+    return true;
+  }
+
+  void ConnectionCallDequeued(const InboundCall& call) {
+    auto connection = call.connection();
+    if (!connection) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(connection_queued_calls_mutex_);
+    auto it = connection_queued_calls_.find(connection.get());
+    if (it == connection_queued_calls_.end()) {
+      LOG_WITH_PREFIX(DFATAL) << "Dequeued call from unknown connection: " << call.ToString();
+      return;
+    }
+    if (--it->second == 0) {
+      connection_queued_calls_.erase(it);
+    }
+  }
+
   const size_t max_queued_calls_;
   ThreadPool& thread_pool_;
   Scheduler& scheduler_;
@@ -411,6 +472,12 @@ class ServicePoolImpl final : public InboundCallHandler {
   // Have to use CoarseDuration here, since CoarseTimePoint does not work with clang + libstdc++
   std::atomic<CoarseDuration> last_backpressure_at_{CoarseTimePoint().time_since_epoch()};
   std::atomic<int64_t> queued_calls_{0};
+  scoped_refptr<Histogram> service_incoming_queue_time_;
+
+  // Number of queued calls for each connection, used to limit share of the queue that could be
+  // occupied by a single client.
+  std::mutex connection_queued_calls_mutex_;
+  std::unordered_map<const Connection*, size_t> connection_queued_calls_;
 
   // It is too expensive to update timeout priority queue when each call is received.
   // So we are doing the following trick.
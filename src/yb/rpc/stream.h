@@ -74,6 +74,10 @@ class StreamReadBuffer {
   // entry of vector returned by PrepareAppend.
   virtual void Consume(size_t count, const Slice& prepend) = 0;
 
+  // Invoked when there is no more data to receive for now. Empty buffer could release its memory
+  // until next data arrives.
+  virtual void ReleaseIfEmpty() {}
+
   // Render this buffer to string.
   virtual std::string ToString() const = 0;
 
@@ -138,6 +142,10 @@ class Stream {
 
   virtual const Protocol* GetProtocol() = 0;
 
+  // Returns socket that data sent to this stream is written to as is, or nullptr if this stream
+  // transforms data. Could be used by upper layer to offload its work to the kernel.
+  virtual Socket* socket() { return nullptr; }
+
   virtual ~Stream() {}
 
  protected:
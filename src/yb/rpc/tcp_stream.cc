@@ -92,6 +92,7 @@ Status TcpStream::DoStart(ev::loop_ref* loop, bool connect) {
   io_.set<TcpStream, &TcpStream::Handler>(this);
   int events = ev::READ | (!connected_ ? ev::WRITE : 0);
   io_.start(socket_.GetFd(), events);
+  io_events_ = events;
 
   DVLOG_WITH_PREFIX(3) << "Starting, listen events: " << events << ", fd: " << socket_.GetFd();
 
@@ -291,8 +292,9 @@ void TcpStream::UpdateEvents() {
   if (waiting_write_ready_) {
     events |= ev::WRITE;
   }
-  if (events) {
+  if (events && events != io_events_) {
     io_.set(events);
+    io_events_ = events;
   }
 }
 
@@ -300,7 +302,8 @@ Status TcpStream::ReadHandler() {
   context_->UpdateLastRead();
 
   for (;;) {
-    auto received = Receive();
+    bool drained = false;
+    auto received = Receive(&drained);
     if (PREDICT_FALSE(!received.ok())) {
       if (Errno(received.status()) == ESHUTDOWN) {
         VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
@@ -319,13 +322,13 @@ Status TcpStream::ReadHandler() {
     if (!continue_receiving.ok()) {
       return continue_receiving.status();
     }
-    if (!continue_receiving.get()) {
+    if (!continue_receiving.get() || drained) {
       return Status::OK();
     }
   }
 }
 
-Result<bool> TcpStream::Receive() {
+Result<bool> TcpStream::Receive(bool* drained) {
   auto iov = ReadBuffer().PrepareAppend();
   if (!iov.ok()) {
     VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
@@ -359,11 +362,18 @@ Result<bool> TcpStream::Receive() {
   if (!nread.ok()) {
     DVLOG_WITH_PREFIX(3) << "socket_.Recvv() error: " << nread.status();
     if (Socket::IsTemporarySocketError(nread.status())) {
+      ReadBuffer().ReleaseIfEmpty();
       return false;
     }
     return nread.status();
   }
 
+  size_t capacity = 0;
+  for (const auto& vec : *iov) {
+    capacity += vec.iov_len;
+  }
+  *drained = static_cast<size_t>(*nread) < capacity;
+
   ReadBuffer().DataAppended(*nread);
   return *nread != 0;
 }
@@ -54,7 +54,7 @@ class TcpStream : public Stream {
   explicit TcpStream(const StreamCreateData& data);
   ~TcpStream();
 
-  Socket* socket() { return &socket_; }
+  Socket* socket() override { return &socket_; }
 
   size_t GetPendingWriteBytes() override {
     return queued_bytes_to_send_ - send_position_;
@@ -97,7 +97,9 @@ class TcpStream : public Stream {
   CHECKED_STATUS ReadHandler();
   CHECKED_STATUS WriteHandler(bool just_connected);
 
-  Result<bool> Receive();
+  // Sets *drained to true when socket had less data than could be received, so there is no need
+  // to try receiving again until the next read event.
+  Result<bool> Receive(bool* drained);
   // Try to parse received data and process it.
   Result<bool> TryProcessReceived();
 
@@ -130,6 +132,10 @@ class TcpStream : public Stream {
   // Notifies us when our socket is readable or writable.
   ev::io io_;
 
+  // Events that io_ currently listens for. Each change of io_ events results in epoll_ctl call,
+  // so it is done only when events are actually changed.
+  int io_events_ = 0;
+
   ev::timer connect_delayer_;
 
   // Set to true when the connection is registered on a loop.
@@ -14,6 +14,8 @@
 //
 
 #include <atomic>
+#include <mutex>
+#include <set>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -256,6 +258,35 @@ TEST_F(ThreadPoolTest, TestOwns) {
   ASSERT_TRUE(pool.Owns(task.thread()));
 }
 
+TEST_F(ThreadPoolTest, StealTasks) {
+  constexpr size_t kTotalTasks = 20;
+  constexpr size_t kTotalWorkers = 4;
+  ThreadPool pool("test", kTotalTasks + 1, kTotalWorkers);
+
+  CountDownLatch latch(kTotalTasks);
+  std::mutex mutex;
+  std::set<Thread*> threads;
+  pool.EnqueueFunctor([&pool, &latch, &mutex, &threads] {
+    // Tasks enqueued from the worker are put to its local queue, while the worker itself is
+    // blocked until all of them are completed. So they could only be executed by other workers.
+    for (size_t i = 0; i != kTotalTasks; ++i) {
+      pool.EnqueueFunctor([&latch, &mutex, &threads] {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          threads.insert(Thread::current_thread());
+        }
+        std::this_thread::sleep_for(10ms);
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+  });
+
+  latch.Wait();
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_GT(threads.size(), 1);
+}
+
 TEST_F(ThreadPoolTest, Strand) {
   constexpr size_t kTotalTasks = 100;
   constexpr size_t kTotalWorkers = 4;
@@ -16,6 +16,7 @@
 #include "yb/rpc/thread_pool.h"
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <thread>
 
@@ -38,11 +39,17 @@ typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
 struct ThreadPoolShare {
   ThreadPoolOptions options;
+  // Tasks that were enqueued from threads that are not workers of this pool.
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
+  // Started workers, used to steal tasks from their local queues.
+  std::unique_ptr<std::atomic<Worker*>[]> workers;
+  std::atomic<size_t> num_workers{0};
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)), workers(new std::atomic<Worker*>[options.max_workers]()) {}
+
+  bool StealTask(Worker* thief, ThreadPoolTask** task);
 };
 
 namespace {
@@ -51,6 +58,9 @@ const std::string kRpcThreadCategory = "rpc_thread_pool";
 
 } // namespace
 
+// Worker that is executing on the current thread.
+thread_local Worker* current_worker = nullptr;
+
 class Worker {
  public:
   explicit Worker(ThreadPoolShare* share)
@@ -59,15 +69,50 @@ class Worker {
 
   CHECKED_STATUS Start(size_t index) {
     auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
-    return yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_);
+    RETURN_NOT_OK(yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_));
+    share_->workers[index].store(this, std::memory_order_release);
+    share_->num_workers.store(index + 1, std::memory_order_release);
+    return Status::OK();
   }
 
   ~Worker() {
+    Join();
+  }
+
+  void Join() {
     if (thread_) {
       thread_->Join();
+      thread_ = nullptr;
     }
   }
 
+  ThreadPoolShare* share() const {
+    return share_;
+  }
+
+  // Tasks enqueued by the worker itself are put to its local queue, so workers don't contend
+  // on the shared queue, when tasks are spawned by other tasks. Idle workers steal them.
+  void PushLocalTask(ThreadPoolTask* task) {
+    std::lock_guard<std::mutex> lock(local_tasks_mutex_);
+    local_tasks_.push_back(task);
+    num_local_tasks_.fetch_add(1, std::memory_order_release);
+  }
+
+  bool PopLocalTask(ThreadPoolTask** task) {
+    // Avoid locking when queue is empty, that is the usual case for steal attempts.
+    if (num_local_tasks_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(local_tasks_mutex_);
+    if (local_tasks_.empty()) {
+      return false;
+    }
+    *task = local_tasks_.front();
+    local_tasks_.pop_front();
+    num_local_tasks_.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
   Worker(const Worker& worker) = delete;
   void operator=(const Worker& worker) = delete;
 
@@ -99,6 +144,7 @@ class Worker {
   // does not have free hands (worker queue empty)
   void Execute() {
     Thread::current_thread()->SetUserData(share_);
+    current_worker = this;
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
       if (PopTask(&task)) {
@@ -111,7 +157,7 @@ class Worker {
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (TryPopTask(task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -127,7 +173,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (TryPopTask(task)) {
         return true;
       }
 
@@ -135,13 +181,17 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (TryPopTask(task)) {
         return true;
       }
     }
     return false;
   }
 
+  bool TryPopTask(ThreadPoolTask** task) {
+    return PopLocalTask(task) || share_->task_queue.pop(*task) || share_->StealTask(this, task);
+  }
+
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
       auto pushed = share_->waiting_workers.push(this);
@@ -157,8 +207,23 @@ class Worker {
   std::atomic<bool> stop_requested_ = {false};
   bool waiting_task_ = false;
   bool added_to_waiting_workers_ = false;
+
+  std::mutex local_tasks_mutex_;
+  std::deque<ThreadPoolTask*> local_tasks_;
+  std::atomic<size_t> num_local_tasks_{0};
 };
 
+bool ThreadPoolShare::StealTask(Worker* thief, ThreadPoolTask** task) {
+  auto size = num_workers.load(std::memory_order_acquire);
+  for (size_t i = 0; i != size; ++i) {
+    auto* victim = workers[i].load(std::memory_order_acquire);
+    if (victim && victim != thief && victim->PopLocalTask(task)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } // namespace
 
 class ThreadPool::Impl {
@@ -183,8 +248,12 @@ class ThreadPool::Impl {
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
-    DCHECK(added); // BasketQueue always succeed.
+    if (current_worker && current_worker->share() == &share_) {
+      current_worker->PushLocalTask(task);
+    } else {
+      bool added = share_.task_queue.push(task);
+      DCHECK(added); // BasketQueue always succeed.
+    }
     Worker* worker = nullptr;
     while (share_.waiting_workers.pop(worker)) {
       if (worker->Notify()) {
@@ -240,8 +309,15 @@ class ThreadPool::Impl {
     while (adding_ != 0) {
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
-    workers_.clear();
     ThreadPoolTask* task = nullptr;
+    for (auto& worker : workers_) {
+      worker->Join();
+      while (worker->PopLocalTask(&task)) {
+        task->Done(shutdown_status_);
+      }
+    }
+    share_.num_workers.store(0, std::memory_order_release);
+    workers_.clear();
     while (share_.task_queue.pop(task)) {
       task->Done(shutdown_status_);
     }
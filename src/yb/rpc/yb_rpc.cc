@@ -29,6 +29,7 @@
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/trace.h"
 
 using google::protobuf::io::CodedInputStream;
 using namespace yb::size_literals;
@@ -280,6 +281,11 @@ Status YBInboundCall::ParseFrom(const MemTrackerPtr& mem_tracker, CallData* call
   consumption_ = ScopedTrackedConsumption(mem_tracker, call_data->size());
   request_data_ = std::move(*call_data);
 
+  if (header_.has_trace_id()) {
+    // Calls made while serving this one will inherit the trace id.
+    trace_->set_trace_id(header_.trace_id());
+  }
+
   // Adopt the service/method info from the header as soon as it's available.
   if (PREDICT_FALSE(!header_.has_remote_method())) {
     return STATUS(Corruption, "Non-connection context request header must specify remote_method");
@@ -325,6 +331,27 @@ size_t YBInboundCall::AddRpcSidecar(Slice car) {
   return num_sidecars_++;
 }
 
+size_t YBInboundCall::AddRpcSidecar(RefCntBuffer car) {
+  sidecar_offsets_.Add(total_sidecars_size_);
+  total_sidecars_size_ += car.size();
+  if (!sidecar_buffers_.empty()) {
+    // The buffer is appended after the last one, so the unused tail of the last buffer is dropped.
+    auto& last_buffer = sidecar_buffers_.back();
+    if (consumption_) {
+      consumption_.Add(
+          -static_cast<int64_t>(last_buffer.size() - filled_bytes_in_last_sidecar_buffer_));
+    }
+    last_buffer.Shrink(filled_bytes_in_last_sidecar_buffer_);
+  }
+  if (consumption_) {
+    consumption_.Add(car.size());
+  }
+  filled_bytes_in_last_sidecar_buffer_ = car.size();
+  sidecar_buffers_.push_back(std::move(car));
+
+  return num_sidecars_++;
+}
+
 void YBInboundCall::ResetRpcSidecars() {
   if (consumption_) {
     for (const auto& buffer : sidecar_buffers_) {
@@ -411,6 +438,7 @@ bool YBInboundCall::DumpPB(const DumpRunningRpcsRequestPB& req,
   }
   resp->set_elapsed_millis(MonoTime::Now().GetDeltaSince(timing_.time_received)
       .ToMilliseconds());
+  DumpTiming(resp);
   return true;
 }
 
@@ -424,7 +452,8 @@ void YBInboundCall::LogTrace() const {
       // TODO: consider pushing this onto another thread since it may be slow.
       // The traces may also be too large to fit in a log message.
       LOG(WARNING) << ToString() << " took " << total_time << "ms (client timeout "
-                   << header_.timeout_millis() << "ms).";
+                   << header_.timeout_millis() << "ms)" << TraceIdSuffix(trace_->trace_id())
+                   << ".";
       std::string s = trace_->DumpToString(true);
       if (!s.empty()) {
         LOG(WARNING) << "Trace:\n" << s;
@@ -436,7 +465,8 @@ void YBInboundCall::LogTrace() const {
   if (PREDICT_FALSE(
           FLAGS_rpc_dump_all_traces ||
           total_time > FLAGS_rpc_slow_query_threshold_ms)) {
-    LOG(INFO) << ToString() << " took " << total_time << "ms. Trace:";
+    LOG(INFO) << ToString() << " took " << total_time << "ms. Trace"
+              << TraceIdSuffix(trace_->trace_id()) << ":";
     trace_->Dump(&LOG(INFO), true);
   }
 }
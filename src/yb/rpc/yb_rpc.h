@@ -124,6 +124,7 @@ class YBInboundCall : public InboundCall {
 
   // See RpcContext::AddRpcSidecar()
   virtual size_t AddRpcSidecar(Slice car);
+  virtual size_t AddRpcSidecar(RefCntBuffer car);
 
   // See RpcContext::ResetRpcSidecars()
   void ResetRpcSidecars();
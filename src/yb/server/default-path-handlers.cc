@@ -273,6 +273,18 @@ static void WriteForPrometheus(const MetricRegistry* const metrics,
     string arg = FindWithDefault(req.parsed_args, "level", "debug");
     opts.level = MetricLevelFromName(arg);
   }
+  {
+    const string* arg = FindOrNull(req.parsed_args, "metrics");
+    if (arg != nullptr) {
+      SplitStringUsing(*arg, ",", &opts.requested_metrics);
+    }
+  }
+  {
+    const string* arg = FindOrNull(req.parsed_args, "metric_types");
+    if (arg != nullptr) {
+      SplitStringUsing(*arg, ",", &opts.metric_types);
+    }
+  }
 
   PrometheusWriter writer(output);
   WARN_NOT_OK(metrics->WriteForPrometheus(&writer, opts),
@@ -90,6 +90,28 @@ TEST(MockHybridClockTest, TestMockedSystemClock) {
             HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(time.time_point, 1).ToUint64());
 }
 
+// Logical component overflow carries into the physical component.
+TEST(MockHybridClockTest, TestLogicalOverflow) {
+  MockClock mock_clock;
+  scoped_refptr<HybridClock> clock(new HybridClock(mock_clock.AsClock()));
+  ASSERT_OK(clock->Init());
+  PhysicalTime time = {1234, 100};
+  mock_clock.Set(time);
+  clock->Update(HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(
+      time.time_point, HybridTime::kLogicalBitMask - 1));
+  HybridTime hybrid_time;
+  uint64_t max_error_usec;
+  clock->NowWithError(&hybrid_time, &max_error_usec);
+  ASSERT_EQ(HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(
+                time.time_point, HybridTime::kLogicalBitMask), hybrid_time);
+  ASSERT_EQ(max_error_usec, time.max_error);
+  clock->NowWithError(&hybrid_time, &max_error_usec);
+  ASSERT_EQ(HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(time.time_point + 1, 0),
+            hybrid_time);
+  // Returned time is ahead of the physical clock, so the error is extended.
+  ASSERT_EQ(max_error_usec, time.max_error + 1);
+}
+
 // Test that two subsequent time reads are monotonically increasing.
 TEST_F(HybridClockTest, TestNow_ValuesIncreaseMonotonically) {
   const HybridTime now1 = clock_->Now();
@@ -141,15 +141,16 @@ void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec
   }
 
   // If the current time surpasses the last update just return it
-  HybridClockComponents current_components = components_.load(boost::memory_order_acquire);
-  HybridClockComponents new_components = { now->time_point, 1 };
+  auto current = next_hybrid_time_.load(std::memory_order_acquire);
+  const auto now_repr = HybridTimeFromMicroseconds(now->time_point).ToUint64();
 
-  VLOG(4) << __func__ << ", new: " << new_components << ", current: " << current_components;
+  VLOG(4) << __func__ << ", now: " << now->time_point << ", current: " << HybridTime(current);
 
   // Loop over the check in case of concurrent updates making the CAS fail.
-  while (now->time_point > current_components.last_usec) {
-    if (components_.compare_exchange_weak(current_components, new_components)) {
-      *hybrid_time = HybridTimeFromMicroseconds(new_components.last_usec);
+  while (now->time_point > GetPhysicalValueMicros(HybridTime(current))) {
+    if (next_hybrid_time_.compare_exchange_weak(
+            current, now_repr + 1, std::memory_order_acq_rel)) {
+      *hybrid_time = HybridTime(now_repr);
       *max_error_usec = now->max_error;
       if (PREDICT_FALSE(VLOG_IS_ON(2))) {
         VLOG(2) << "Current clock is higher than the last one. Resetting logical values."
@@ -176,19 +177,17 @@ void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec
   // always return: last - (now - e) as the new maximum error.
   // This broadens the error interval for both cases but always returns
   // a correct error interval.
+  //
+  // The next hybrid time could only grow, so it is ahead of the physical time read above, and
+  // the logical component could be just incremented. Overflow of the logical component carries
+  // into the physical one, since both are stored in the same word.
+  *hybrid_time = HybridTime(next_hybrid_time_.fetch_add(1, std::memory_order_acq_rel));
+  if (PREDICT_FALSE(GetLogicalValue(*hybrid_time) == HybridTime::kLogicalBitMask)) {
+    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Logical component overflow: " << *hybrid_time;
+  }
 
-  do {
-    new_components.last_usec = current_components.last_usec;
-    new_components.logical = current_components.logical + 1;
-    new_components.HandleLogicalComponentOverflow();
-    // Loop over the check until the CAS succeeds, in case there are concurrent updates.
-  } while (!components_.compare_exchange_weak(current_components, new_components));
-
-  *max_error_usec = new_components.last_usec - (now->time_point - now->max_error);
+  *max_error_usec = GetPhysicalValueMicros(*hybrid_time) - (now->time_point - now->max_error);
 
-  // We've already atomically incremented the logical, so subtract 1.
-  *hybrid_time = HybridTimeFromMicrosecondsAndLogicalValue(
-      new_components.last_usec, new_components.logical).Decremented();
   if (PREDICT_FALSE(VLOG_IS_ON(2))) {
     VLOG(2) << "Current clock is lower than the last one. Returning last read and incrementing"
         " logical values. Hybrid time: " << *hybrid_time << " Error: " << *max_error_usec;
@@ -200,21 +199,18 @@ void HybridClock::Update(const HybridTime& to_update) {
     return;
   }
 
-  HybridClockComponents current_components = components_.load(boost::memory_order_acquire);
-  HybridClockComponents new_components = {
-    GetPhysicalValueMicros(to_update), GetLogicalValue(to_update) + 1
-  };
+  auto current = next_hybrid_time_.load(std::memory_order_acquire);
+  const auto new_value = to_update.ToUint64() + 1;
 
   // VLOG(4) crashes in TSAN mode
   if (VLOG_IS_ON(4)) {
-    LOG(INFO) << __func__ << ", new: " << new_components << ", current: " << current_components;
+    LOG(INFO) << __func__ << ", new: " << HybridTime(new_value)
+              << ", current: " << HybridTime(current);
   }
 
-  new_components.HandleLogicalComponentOverflow();
-
   // Keep trying to CAS until it works or until HT has advanced past this update.
-  while (current_components < new_components &&
-      !components_.compare_exchange_weak(current_components, new_components)) {}
+  while (current < new_value &&
+      !next_hybrid_time_.compare_exchange_weak(current, new_value, std::memory_order_acq_rel)) {}
 }
 
 // Used to get the hybrid_time for metrics.
@@ -231,29 +227,6 @@ uint64_t HybridClock::ErrorForMetrics() {
   return error;
 }
 
-std::string HybridClockComponents::ToString() const {
-  return Format("{ last_usec: $0 logical: $1 }", last_usec, logical);
-}
-
-std::ostream& operator<<(std::ostream& out, const HybridClockComponents& components) {
-  return out << components.ToString();
-}
-
-void HybridClockComponents::HandleLogicalComponentOverflow() {
-  if (logical > HybridTime::kLogicalBitMask) {
-    static constexpr uint64_t kMaxOverflowValue = 1ULL << HybridTime::kBitsForLogicalComponent;
-    if (logical > kMaxOverflowValue) {
-      LOG(FATAL) << "Logical component is too high: last_usec=" << last_usec
-                 << "logical=" << logical << ", max allowed is " << kMaxOverflowValue;
-    }
-    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Logical component overflow: "
-        << "last_usec=" << last_usec << ", logical=" << logical;
-
-    last_usec += logical >> HybridTime::kBitsForLogicalComponent;
-    logical &= HybridTime::kLogicalBitMask;
-  }
-}
-
 void HybridClock::RegisterMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
   METRIC_hybrid_clock_hybrid_time.InstantiateFunctionGauge(
       metric_entity,
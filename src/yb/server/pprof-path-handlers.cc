@@ -50,23 +50,30 @@
 #endif
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <glog/logging.h>
 #include "yb/gutil/map-util.h"
+#include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/numbers.h"
 #include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/stringpiece.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/strings/util.h"
 #include "yb/gutil/sysinfo.h"
 #include "yb/server/webserver.h"
 #include "yb/util/env.h"
 #include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/monotime.h"
 #include "yb/util/spinlock_profiling.h"
 #include "yb/util/status.h"
+#include "yb/util/url-coding.h"
 
 DECLARE_bool(enable_process_lifetime_heap_profiling);
 DECLARE_string(heap_profile_path);
@@ -185,6 +192,214 @@ static void PprofGrowthHandler(const Webserver::WebRequest& req, Webserver::WebR
 #endif
 }
 
+#ifdef TCMALLOC_ENABLED
+
+namespace {
+
+// Memory category that sampled heap allocations are attributed to, by symbols of their stacks.
+struct HeapSampleCategory {
+  const char* name;
+  // Ids (or id prefixes) of MemTrackers that account memory of this category.
+  std::vector<const char*> mem_tracker_ids;
+  // Allocation belongs to the category, when one of its frames contains one of those symbols.
+  std::vector<const char*> symbols;
+};
+
+const std::vector<HeapSampleCategory>& HeapSampleCategories() {
+  static const std::vector<HeapSampleCategory> result = {
+    { "Log cache", { "log_cache" }, { "yb::log::LogCache::" } },
+    { "Block cache", { "BlockBasedTable" },
+      { "rocksdb::LRUCache", "rocksdb::ShardedCache", "rocksdb::BlockBasedTable::" } },
+    { "MemTables", { "MemTable" }, { "rocksdb::MemTable", "rocksdb::ConcurrentArena" } },
+    { "RPC buffers", { "Call", "Reading", "Sending", "Receive" }, { "yb::rpc::" } },
+  };
+  return result;
+}
+
+struct HeapSampleStack {
+  double bytes = 0;
+  double count = 0;
+  std::vector<std::string> frames;
+  size_t category;
+};
+
+// Sums consumption of trackers matching any of ids, skipping trackers whose parent also matches,
+// so memory is not counted twice.
+int64_t CategoryConsumption(
+    const HeapSampleCategory& category, const std::vector<MemTrackerPtr>& trackers) {
+  auto matches = [&category](const MemTracker* tracker) {
+    for (const char* id : category.mem_tracker_ids) {
+      if (HasPrefixString(tracker->id(), id)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  int64_t result = 0;
+  for (const auto& tracker : trackers) {
+    if (matches(tracker.get()) && (!tracker->parent() || !matches(tracker->parent().get()))) {
+      result += tracker->consumption();
+    }
+  }
+  return result;
+}
+
+// Parses heap sample in the pprof heap_v2 format and estimates allocated sizes the same way pprof
+// does, i.e. scaling sampled values according to the sampling rate.
+std::vector<HeapSampleStack> ParseHeapSample(const std::string& sample) {
+  std::vector<HeapSampleStack> result;
+  std::unordered_map<uint64_t, std::string> symbols;
+  std::unordered_map<std::string, size_t> symbol_categories;
+  const auto& categories = HeapSampleCategories();
+  double sample_rate = 0;
+  std::vector<GStringPiece> lines = strings::Split(sample, "\n", strings::SkipEmpty());
+  for (GStringPiece line : lines) {
+    if (line.starts_with("MAPPED_LIBRARIES")) {
+      break;
+    }
+    auto at_pos = line.find(" @ ");
+    if (at_pos == GStringPiece::npos) {
+      continue;
+    }
+    std::vector<GStringPiece> values = strings::Split(
+        line.substr(0, at_pos), strings::delimiter::AnyOf(" :[]"), strings::SkipEmpty());
+    auto tail = line.substr(at_pos + 3);
+    if (line.starts_with("heap profile:")) {
+      auto slash_pos = tail.find('/');
+      if (slash_pos != GStringPiece::npos) {
+        sample_rate = strtod(tail.substr(slash_pos + 1).as_string().c_str(), nullptr);
+      }
+      continue;
+    }
+    if (values.size() < 2) {
+      continue;
+    }
+    HeapSampleStack stack;
+    stack.count = strtod(values[0].as_string().c_str(), nullptr);
+    stack.bytes = strtod(values[1].as_string().c_str(), nullptr);
+    if (stack.count > 0 && sample_rate > 0) {
+      double ratio = stack.bytes / stack.count / sample_rate;
+      double scale = 1 / (1 - std::exp(-ratio));
+      stack.bytes *= scale;
+      stack.count *= scale;
+    }
+    stack.category = categories.size();
+    std::vector<GStringPiece> addresses = strings::Split(tail, " ", strings::SkipEmpty());
+    for (GStringPiece address : addresses) {
+      uint64_t pc;
+      if (!safe_strtou64_base(address.as_string().c_str(), &pc, 16)) {
+        continue;
+      }
+      auto it = symbols.find(pc);
+      if (it == symbols.end()) {
+        char symbol_buf[1024];
+        std::string symbol = google::Symbolize(reinterpret_cast<void*>(pc), symbol_buf,
+                                               sizeof(symbol_buf))
+            ? symbol_buf : address.as_string();
+        it = symbols.emplace(pc, std::move(symbol)).first;
+      }
+      const auto& symbol = it->second;
+      if (stack.category == categories.size()) {
+        auto category_it = symbol_categories.find(symbol);
+        if (category_it == symbol_categories.end()) {
+          size_t category = 0;
+          for (; category != categories.size(); ++category) {
+            bool found = false;
+            for (const char* pattern : categories[category].symbols) {
+              if (symbol.find(pattern) != std::string::npos) {
+                found = true;
+                break;
+              }
+            }
+            if (found) {
+              break;
+            }
+          }
+          category_it = symbol_categories.emplace(symbol, category).first;
+        }
+        stack.category = category_it->second;
+      }
+      stack.frames.push_back(symbol);
+    }
+    result.push_back(std::move(stack));
+  }
+  return result;
+}
+
+} // namespace
+
+#endif
+
+// Shows live heap allocations sampled by tcmalloc, attributed to memory categories by their
+// stacks, next to consumption of the MemTrackers for those categories. The difference between
+// sampled size and tracked consumption of a category points to untracked memory, and the top
+// stacks show which code paths hold it. Sampling is continuous for the process lifetime without
+// restarting the profiler, when TCMALLOC_SAMPLE_PARAMETER environment variable is set.
+static void HeapSamplesHandler(const Webserver::WebRequest& req, Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+#ifndef TCMALLOC_ENABLED
+  (*output) << "Heap sampling is not available without tcmalloc.";
+#else
+  string sample;
+  MallocExtension::instance()->GetHeapSample(&sample);
+  auto stacks = ParseHeapSample(sample);
+  if (stacks.empty()) {
+    (*output) << "No heap samples collected, set TCMALLOC_SAMPLE_PARAMETER environment variable "
+              << "to enable heap sampling.";
+    return;
+  }
+
+  const auto& categories = HeapSampleCategories();
+  std::vector<double> category_bytes(categories.size() + 1);
+  double total_bytes = 0;
+  for (const auto& stack : stacks) {
+    category_bytes[stack.category] += stack.bytes;
+    total_bytes += stack.bytes;
+  }
+  auto trackers = MemTracker::ListTrackers();
+
+  (*output) << "<h1>Heap samples</h1>\n";
+  (*output) << "<table class='table table-striped'>\n";
+  (*output) << "  <tr><th>Category</th><th>Sampled heap</th><th>MemTracker consumption</th></tr>\n";
+  for (size_t i = 0; i <= categories.size(); ++i) {
+    (*output) << "  <tr><td>" << (i == categories.size() ? "Other" : categories[i].name)
+              << "</td><td>" << HumanReadableNumBytes::ToString(category_bytes[i]) << "</td><td>"
+              << (i == categories.size()
+                      ? "" : HumanReadableNumBytes::ToString(
+                                 CategoryConsumption(categories[i], trackers)))
+              << "</td></tr>\n";
+  }
+  (*output) << "  <tr><td>Total</td><td>" << HumanReadableNumBytes::ToString(total_bytes)
+            << "</td><td>" << HumanReadableNumBytes::ToString(
+                                  MemTracker::GetRootTracker()->consumption())
+            << "</td></tr>\n";
+  (*output) << "</table>\n";
+
+  string stacks_str = FindWithDefault(req.parsed_args, "stacks", "");
+  size_t num_stacks = std::min<size_t>(
+      ParseLeadingInt32Value(stacks_str.c_str(), 20), stacks.size());
+  std::partial_sort(
+      stacks.begin(), stacks.begin() + num_stacks, stacks.end(),
+      [](const HeapSampleStack& lhs, const HeapSampleStack& rhs) { return lhs.bytes > rhs.bytes; });
+
+  (*output) << "<h2>Top " << num_stacks << " stacks</h2>\n";
+  (*output) << "<table class='table table-striped'>\n";
+  (*output) << "  <tr><th>Sampled heap</th><th>Objects</th><th>Category</th><th>Stack</th></tr>\n";
+  for (size_t i = 0; i != num_stacks; ++i) {
+    const auto& stack = stacks[i];
+    (*output) << "  <tr><td>" << HumanReadableNumBytes::ToString(stack.bytes) << "</td><td>"
+              << static_cast<int64_t>(stack.count) << "</td><td>"
+              << (stack.category == categories.size() ? "Other" : categories[stack.category].name)
+              << "</td><td><pre>";
+    for (const auto& frame : stack.frames) {
+      (*output) << EscapeForHtmlToString(frame) << "\n";
+    }
+    (*output) << "</pre></td></tr>\n";
+  }
+  (*output) << "</table>\n";
+#endif
+}
+
 // Lock contention profiling
 static void PprofContentionHandler(const Webserver::WebRequest& req,
                                     Webserver::WebResponse* resp) {
@@ -280,6 +495,7 @@ void AddPprofPathHandlers(Webserver* webserver) {
   webserver->RegisterPathHandler("/pprof/profile", "", PprofCpuProfileHandler, false, false);
   webserver->RegisterPathHandler("/pprof/symbol", "", PprofSymbolHandler, false, false);
   webserver->RegisterPathHandler("/pprof/contention", "", PprofContentionHandler, false, false);
+  webserver->RegisterPathHandler("/heap-samples", "Heap samples", HeapSamplesHandler, true, false);
 }
 
 } // namespace yb
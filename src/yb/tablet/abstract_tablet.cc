@@ -11,12 +11,15 @@
 // under the License.
 //
 
+#include <boost/optional.hpp>
+
 #include "yb/common/ql_resultset.h"
 
 #include "yb/common/ql_value.h"
 
 #include "yb/docdb/cql_operation.h"
 #include "yb/docdb/pgsql_operation.h"
+#include "yb/rocksdb/perf_context.h"
 
 #include "yb/tablet/abstract_tablet.h"
 #include "yb/util/trace.h"
@@ -25,6 +28,14 @@
 namespace yb {
 namespace tablet {
 
+Result<SchemaPtr> AbstractTablet::GetProjection(
+    const std::vector<ColumnId>& column_ids, const std::string& table_id) const {
+  auto projection = std::make_shared<Schema>();
+  RETURN_NOT_OK(GetSchema(table_id)->CreateProjectionByIdsIgnoreMissing(
+      column_ids, projection.get()));
+  return projection;
+}
+
 Status AbstractTablet::HandleQLReadRequest(CoarseTimePoint deadline,
                                            const ReadHybridTime& read_time,
                                            const QLReadRequestPB& ql_read_request,
@@ -36,7 +47,6 @@ Status AbstractTablet::HandleQLReadRequest(CoarseTimePoint deadline,
 
   // Form a schema of columns that are referenced by this query.
   const SchemaPtr schema = GetSchema();
-  Schema projection;
   const QLReferencedColumnsPB& column_pbs = ql_read_request.column_refs();
   vector<ColumnId> column_refs;
   for (int32_t id : column_pbs.static_ids()) {
@@ -45,13 +55,14 @@ Status AbstractTablet::HandleQLReadRequest(CoarseTimePoint deadline,
   for (int32_t id : column_pbs.ids()) {
     column_refs.emplace_back(id);
   }
-  RETURN_NOT_OK(schema->CreateProjectionByIdsIgnoreMissing(column_refs, &projection));
+  const SchemaPtr projection = VERIFY_RESULT(GetProjection(column_refs));
 
   const QLRSRowDesc rsrow_desc(ql_read_request.rsrow_desc());
   QLResultSet resultset(&rsrow_desc, &result->rows_data);
   TRACE("Start Execute");
   const Status s = doc_op.Execute(
-      QLStorage(), deadline, read_time, *schema, projection, &resultset, &result->restart_read_ht);
+      QLStorage(), deadline, read_time, *schema, *projection, &resultset,
+      &result->restart_read_ht);
   TRACE("Done Execute");
   if (!s.ok()) {
     if (s.IsQLError()) {
@@ -83,11 +94,41 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
   const SchemaPtr schema = GetSchema(pgsql_read_request.table_id());
   const SchemaPtr index_schema = pgsql_read_request.has_index_request()
       ? GetSchema(pgsql_read_request.index_request().table_id()) : nullptr;
+  const SchemaPtr projection = VERIFY_RESULT(GetProjection(
+      docdb::PgsqlProjectionColumnIds(*schema, pgsql_read_request.column_refs()),
+      pgsql_read_request.table_id()));
+  SchemaPtr index_projection;
+  if (index_schema) {
+    const auto& index_request = pgsql_read_request.index_request();
+    index_projection = VERIFY_RESULT(GetProjection(
+        docdb::PgsqlProjectionColumnIds(*index_schema, index_request.column_refs()),
+        index_request.table_id()));
+  }
+
+  // Request is executed on the current thread, so its storage counters are the change of the
+  // thread local perf context.
+  boost::optional<rocksdb::PerfContext> perf_context_before;
+  if (pgsql_read_request.return_metrics()) {
+    perf_context_before = rocksdb::perf_context;
+  }
 
   TRACE("Start Execute");
-  auto fetched_rows = doc_op.Execute(QLStorage(), deadline, read_time, *schema, index_schema.get(),
+  auto fetched_rows = doc_op.Execute(QLStorage(), deadline, read_time, *schema, *projection,
+                                     index_schema.get(), index_projection.get(),
                                      &result->rows_data, &result->restart_read_ht);
   TRACE("Done Execute");
+  if (perf_context_before) {
+    const auto& before = *perf_context_before;
+    const auto& after = rocksdb::perf_context;
+    auto& metrics = *doc_op.response().mutable_metrics();
+    metrics.set_seeks(after.iter_seek_count - before.iter_seek_count);
+    metrics.set_nexts(after.iter_next_count - before.iter_next_count);
+    metrics.set_internal_keys_skipped(
+        after.internal_key_skipped_count - before.internal_key_skipped_count);
+    metrics.set_block_cache_hits(after.block_cache_hit_count - before.block_cache_hit_count);
+    metrics.set_blocks_read(after.block_read_count - before.block_read_count);
+    metrics.set_block_bytes_read(after.block_read_byte - before.block_read_byte);
+  }
   if (!fetched_rows.ok()) {
     result->response.set_status(PgsqlResponsePB::PGSQL_STATUS_RUNTIME_ERROR);
     const auto& s = fetched_rows.status();
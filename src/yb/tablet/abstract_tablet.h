@@ -45,6 +45,10 @@ class AbstractTablet {
 
   virtual yb::SchemaPtr GetSchema(const std::string& table_id = "") const = 0;
 
+  // Returns projection of the table schema to the given columns, ignoring missing ones.
+  virtual Result<yb::SchemaPtr> GetProjection(
+      const std::vector<ColumnId>& column_ids, const std::string& table_id = "") const;
+
   virtual const common::YQLStorageIf& QLStorage() const = 0;
 
   virtual TableType table_type() const = 0;
@@ -150,6 +150,20 @@ TEST_F(MvccTest, Abort) {
   }));
 }
 
+// Safe time returned without acquiring the mutex should not go backwards, when the next call has
+// to be served under the mutex because of an older lease.
+TEST_F(MvccTest, SafeTimeMonotonicWithOlderLease) {
+  HybridTime ht;
+  manager_.AddPending(&ht);
+  auto now = clock_->Now();
+  auto safe_time = manager_.SafeTime({ .time = now, .lease = AddLogical(ht, 10) });
+  ASSERT_EQ(ht.Decremented(), safe_time);
+  HybridTime old_lease(ht.ToUint64() - 2);
+  ASSERT_EQ(safe_time, manager_.SafeTime({ .time = old_lease, .lease = old_lease }));
+  manager_.Replicated(ht);
+  ASSERT_GE(manager_.SafeTime({ .time = now, .lease = AddLogical(ht, 10) }), ht);
+}
+
 void MvccTest::RunRandomizedTest(bool use_ht_lease) {
   constexpr size_t kTotalOperations = 20000;
   enum class Op { kAdd, kReplicated, kAborted };
@@ -46,6 +46,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/thread.h"
 
 DEFINE_test_flag(int64, mvcc_op_trace_num_items, 32,
                  "Number of items to keep in an MvccManager operation trace. Set to 0 to disable "
@@ -266,6 +267,7 @@ void MvccManager::Replicated(HybridTime ht) {
     CHECK_EQ(queue_.front(), ht) << InvariantViolationLogPrefix();
     PopFront(&lock);
     last_replicated_ = ht;
+    PublishState();
   }
   cond_.notify_all();
 }
@@ -281,6 +283,7 @@ void MvccManager::Aborted(HybridTime ht) {
     CHECK(!queue_.empty()) << InvariantViolationLogPrefix();
     if (queue_.front() == ht) {
       PopFront(&lock);
+      PublishState();
     } else {
       aborted_.push(ht);
       return;
@@ -343,6 +346,8 @@ void MvccManager::AddPending(HybridTime* ht) {
           max_safe_time_returned_with_lease_.safe_time,
           max_safe_time_returned_without_lease_.safe_time,
           max_safe_time_returned_for_follower_.safe_time,
+          lock_free_max_safe_time_with_lease_.load(std::memory_order_acquire),
+          lock_free_max_safe_time_without_lease_.load(std::memory_order_acquire),
           last_replicated_,
           last_ht_in_queue});
 
@@ -406,6 +411,7 @@ void MvccManager::AddPending(HybridTime* ht) {
     });
   }
   queue_.push_back(*ht);
+  PublishState();
 }
 
 void MvccManager::SetLastReplicated(HybridTime ht) {
@@ -417,6 +423,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
     last_replicated_ = ht;
+    PublishState();
   }
   cond_.notify_all();
 }
@@ -519,6 +526,7 @@ HybridTime MvccManager::SafeTimeForFollower(
     }
     return result.safe_time >= min_allowed;
   };
+  ScopedWaitState wait_state(WaitState::kSafeTime);
   if (deadline == CoarseTimePoint::max()) {
     cond_.wait(lock, predicate);
   } else if (!cond_.wait_until(lock, deadline, predicate)) {
@@ -547,8 +555,14 @@ HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
     CoarseTimePoint deadline,
     const FixedHybridTimeLease& ht_lease) const NO_THREAD_SAFETY_ANALYSIS {
+  // Lock free calls are not recorded in the operation trace.
+  auto safe_time = TrySafeTimeLockFree(min_allowed, ht_lease);
+  if (safe_time) {
+    return safe_time;
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
-  auto safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
+  safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
   if (op_trace_) {
     op_trace_->Add(SafeTimeTraceItem {
       .min_allowed = min_allowed,
@@ -602,11 +616,16 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
 
   // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid time
   // ht_lease, which is by definition higher than min_allowed, so we would not get blocked.
+  ScopedWaitState wait_state(WaitState::kSafeTime);
   if (deadline == CoarseTimePoint::max()) {
     cond_.wait(*lock, predicate);
   } else if (!cond_.wait_until(*lock, deadline, predicate)) {
     return HybridTime::kInvalid;
   }
+  auto& lock_free_max_safe_time = has_lease ? lock_free_max_safe_time_with_lease_
+                                             : lock_free_max_safe_time_without_lease_;
+  // Safe time returned by a lock free call is still safe to read at, so keep result monotonic.
+  result = std::max(result, lock_free_max_safe_time.load(std::memory_order_acquire));
   VLOG_WITH_PREFIX(1) << "DoGetSafeTime(" << min_allowed << ", "
                       << ht_lease << "), result = " << result;
 
@@ -629,9 +648,41 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
   } else {
     max_safe_time_returned_without_lease_ = { result, source };
   }
+  UpdateAtomicMax(&lock_free_max_safe_time, result);
   return result;
 }
 
+HybridTime MvccManager::TrySafeTimeLockFree(
+    HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const {
+  auto queue_front = published_queue_front_.load(std::memory_order_acquire);
+  if (!queue_front) {
+    // Safe time for empty queue depends on the clock, and AddPending should pick time after it.
+    return HybridTime::kInvalid;
+  }
+  auto result = std::max(queue_front.Decremented(),
+                         published_last_replicated_.load(std::memory_order_acquire));
+  const bool has_lease = !ht_lease.empty();
+  if (result < min_allowed || (has_lease && result > ht_lease.lease)) {
+    return HybridTime::kInvalid;
+  }
+
+  auto& max_safe_time = has_lease ? lock_free_max_safe_time_with_lease_
+                                  : lock_free_max_safe_time_without_lease_;
+  auto max_value = max_safe_time.load(std::memory_order_acquire);
+  while (result >= max_value) {
+    if (max_safe_time.compare_exchange_weak(max_value, result, std::memory_order_acq_rel)) {
+      return result;
+    }
+  }
+  return HybridTime::kInvalid;
+}
+
+void MvccManager::PublishState() {
+  published_queue_front_.store(
+      queue_.empty() ? HybridTime::kInvalid : queue_.front(), std::memory_order_release);
+  published_last_replicated_.store(last_replicated_, std::memory_order_release);
+}
+
 HybridTime MvccManager::LastReplicatedHybridTime() const {
   std::lock_guard<std::mutex> lock(mutex_);
   VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated_;
@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <deque>
@@ -137,6 +138,9 @@ class MvccManager {
   //
   // Returns invalid hybrid time in case it cannot satisfy provided requirements, for instance
   // because of timeout.
+  //
+  // When there are pending operations and no waiting is required, safe time is calculated from
+  // the lock free snapshot of the state, without acquiring the mutex.
   HybridTime SafeTime(
       HybridTime min_allowed, CoarseTimePoint deadline, const FixedHybridTimeLease& ht_lease) const;
 
@@ -161,6 +165,15 @@ class MvccManager {
                            const FixedHybridTimeLease& ht_lease,
                            std::unique_lock<std::mutex>* lock) const;
 
+  // Tries to calculate safe time using published state only. Returns invalid hybrid time when
+  // the full calculation under the mutex is required.
+  HybridTime TrySafeTimeLockFree(HybridTime min_allowed,
+                                 const FixedHybridTimeLease& ht_lease) const;
+
+  // Publishes the state used by TrySafeTimeLockFree, should be called with mutex_ held after
+  // the queue or last replicated time has changed.
+  void PublishState();
+
   const std::string& LogPrefix() const { return prefix_; }
 
   struct InvariantViolationLoggingHelper;
@@ -201,6 +214,18 @@ class MvccManager {
   mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 
+  // Front of queue_, or invalid hybrid time when queue is empty, and last_replicated_, published
+  // for the lock free safe time calculation. Published values could lag behind the state under
+  // the mutex, but since operations are mutated only from the front of the queue, stale values
+  // could only make the calculated safe time lower.
+  std::atomic<HybridTime> published_queue_front_{HybridTime::kInvalid};
+  std::atomic<HybridTime> published_last_replicated_{HybridTime::kMin};
+
+  // Max safe time returned by SafeTime with and without lease, including lock free calls. Used to
+  // keep returned safe time monotonic.
+  mutable std::atomic<HybridTime> lock_free_max_safe_time_with_lease_{HybridTime::kMin};
+  mutable std::atomic<HybridTime> lock_free_max_safe_time_without_lease_{HybridTime::kMin};
+
   std::unique_ptr<MvccOpTrace> op_trace_ GUARDED_BY(mutex_);
 };
 
@@ -206,7 +206,7 @@ void WriteOperationState::UpdateRequestFromConsensusRound() {
 }
 
 void WriteOperationState::Commit() {
-  tablet()->mvcc_manager()->Replicated(hybrid_time_);
+  tablet()->ApplyReplicated(hybrid_time_);
   ReleaseDocDbLocks();
 
   // After committing, we may respond to the RPC and delete the
@@ -0,0 +1,172 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/ql_index_write_batcher.h"
+
+#include <unordered_map>
+
+#include "yb/client/error.h"
+#include "yb/client/session.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+DEFINE_int32(ql_index_write_max_flushes_in_flight, 4,
+             "Maximum number of concurrent flushes of non-transactional QL index updates per "
+             "tablet. Updates of write batches received while this many flushes are in progress "
+             "are collected and flushed together. 0 disables batching, so each write batch "
+             "flushes its index updates in its own session.");
+TAG_FLAG(ql_index_write_max_flushes_in_flight, advanced);
+TAG_FLAG(ql_index_write_max_flushes_in_flight, runtime);
+
+DEFINE_int32(ql_index_async_update_max_pending_ops, 0,
+             "When positive, writes to tables with non-transactional indexes are completed "
+             "without waiting for index updates, as long as the tablet has no more than this "
+             "number of index updates in progress. Failed asynchronous updates are only logged, "
+             "so such index could miss them. 0 disables asynchronous index updates.");
+TAG_FLAG(ql_index_async_update_max_pending_ops, advanced);
+TAG_FLAG(ql_index_async_update_max_pending_ops, runtime);
+
+namespace yb {
+namespace tablet {
+
+QLIndexWriteBatcher::QLIndexWriteBatcher(std::shared_future<client::YBClient*> client_future)
+    : client_future_(std::move(client_future)) {
+}
+
+QLIndexWriteBatcher::~QLIndexWriteBatcher() = default;
+
+bool QLIndexWriteBatcher::Enabled() {
+  return FLAGS_ql_index_write_max_flushes_in_flight > 0;
+}
+
+void QLIndexWriteBatcher::Write(std::vector<client::YBqlWriteOpPtr> ops, StatusFunctor callback) {
+  auto batch = std::make_shared<Batch>();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (flushes_in_flight_ >=
+            static_cast<size_t>(std::max(FLAGS_ql_index_write_max_flushes_in_flight, 1))) {
+      if (!pending_batch_) {
+        pending_batch_ = std::make_shared<Batch>();
+      }
+      pending_batch_->push_back(Entry{std::move(ops), std::move(callback)});
+      return;
+    }
+    ++flushes_in_flight_;
+  }
+  batch->push_back(Entry{std::move(ops), std::move(callback)});
+  Flush(std::move(batch));
+}
+
+bool QLIndexWriteBatcher::TryWriteAsync(std::vector<client::YBqlWriteOpPtr> ops) {
+  const auto limit = FLAGS_ql_index_async_update_max_pending_ops;
+  if (limit <= 0) {
+    return false;
+  }
+  const size_t num_ops = ops.size();
+  auto pending = async_pending_ops_.load(std::memory_order_acquire);
+  do {
+    if (pending + num_ops > static_cast<size_t>(limit)) {
+      return false;
+    }
+  } while (!async_pending_ops_.compare_exchange_weak(pending, pending + num_ops));
+
+  auto callback = [self = shared_from_this(), ops](const Status& status) {
+    if (!status.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << "Asynchronous index update failed: " << status;
+    } else {
+      for (const auto& op : ops) {
+        if (op->response().status() != QLResponsePB::YQL_STATUS_OK) {
+          YB_LOG_EVERY_N_SECS(WARNING, 5)
+              << "Asynchronous index update " << op->ToString() << " failed: "
+              << op->response().ShortDebugString();
+          break;
+        }
+      }
+    }
+    self->async_pending_ops_.fetch_sub(ops.size(), std::memory_order_acq_rel);
+  };
+  Write(std::move(ops), std::move(callback));
+  return true;
+}
+
+void QLIndexWriteBatcher::Flush(BatchPtr batch) {
+  auto session = std::make_shared<client::YBSession>(client_future_.get());
+  std::vector<Status> apply_statuses;
+  apply_statuses.reserve(batch->size());
+  for (auto& entry : *batch) {
+    Status status;
+    for (const auto& op : entry.ops) {
+      status = session->Apply(op);
+      if (!status.ok()) {
+        break;
+      }
+    }
+    apply_statuses.push_back(std::move(status));
+  }
+
+  session->FlushAsync(
+      [self = shared_from_this(), batch, session, apply_statuses = std::move(apply_statuses)](
+          const Status& status) {
+        // Start flushing updates collected during this flush, before notifying the writers.
+        BatchPtr next_batch;
+        {
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          next_batch = std::move(self->pending_batch_);
+          if (!next_batch) {
+            --self->flushes_in_flight_;
+          }
+        }
+        if (next_batch) {
+          self->Flush(std::move(next_batch));
+        }
+
+        self->FlushDone(batch, apply_statuses, session, status);
+      });
+}
+
+void QLIndexWriteBatcher::FlushDone(
+    const BatchPtr& batch, const std::vector<Status>& apply_statuses,
+    const client::YBSessionPtr& session, const Status& status) {
+  // When any error occurs during the dispatching of YBOperation, YBSession saves the error and
+  // returns IOError. Then errors are assigned to the entries of the failed ops.
+  std::unordered_map<const client::YBOperation*, Status> op_errors;
+  if (!status.ok() && status.IsIOError()) {
+    for (const auto& error : session->GetPendingErrors()) {
+      op_errors.emplace(&error->failed_op(), error->status());
+    }
+  }
+
+  for (size_t i = 0; i != batch->size(); ++i) {
+    auto& entry = (*batch)[i];
+    Status entry_status = apply_statuses[i];
+    if (entry_status.ok() && !status.ok()) {
+      if (op_errors.empty()) {
+        entry_status = status;
+      } else {
+        for (const auto& op : entry.ops) {
+          auto it = op_errors.find(op.get());
+          if (it != op_errors.end()) {
+            entry_status = it->second;
+            break;
+          }
+        }
+      }
+    }
+    entry.callback(entry_status);
+  }
+}
+
+} // namespace tablet
+} // namespace yb
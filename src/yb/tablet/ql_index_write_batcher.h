@@ -0,0 +1,89 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_QL_INDEX_WRITE_BATCHER_H
+#define YB_TABLET_QL_INDEX_WRITE_BATCHER_H
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/util/async_util.h"
+
+namespace yb {
+namespace tablet {
+
+// Writes non-transactional secondary index updates of concurrent QL write batches of a tablet.
+//
+// Updates of a write batch are flushed at once, when fewer than
+// ql_index_write_max_flushes_in_flight flushes are in progress. Otherwise updates are collected
+// until one of the flushes is done, and all collected updates are flushed in one session. So
+// under low load index writes are sent without delay, and under high load updates of many write
+// batches, that go to the same index tablets, share RPCs.
+//
+// Updates could also be written asynchronously, when enabled by
+// ql_index_async_update_max_pending_ops. The base table write is then completed without waiting
+// for its index updates, so the index could lag behind the table by up to that many updates.
+class QLIndexWriteBatcher : public std::enable_shared_from_this<QLIndexWriteBatcher> {
+ public:
+  explicit QLIndexWriteBatcher(std::shared_future<client::YBClient*> client_future);
+
+  ~QLIndexWriteBatcher();
+
+  // Writes index ops, and invokes callback with the first error of these ops, or OK, after they
+  // are flushed. Responses of the ops are filled before callback is invoked.
+  void Write(std::vector<client::YBqlWriteOpPtr> ops, StatusFunctor callback);
+
+  // Writes index ops without waiting for them. Returns false, when it is disabled or the number of
+  // pending asynchronous updates would exceed the limit, so the caller should use Write instead.
+  bool TryWriteAsync(std::vector<client::YBqlWriteOpPtr> ops);
+
+  size_t num_async_pending_ops() const {
+    return async_pending_ops_.load(std::memory_order_acquire);
+  }
+
+  // Whether index updates should be written through this batcher.
+  static bool Enabled();
+
+ private:
+  struct Entry {
+    std::vector<client::YBqlWriteOpPtr> ops;
+    StatusFunctor callback;
+  };
+
+  typedef std::vector<Entry> Batch;
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  void Flush(BatchPtr batch);
+
+  void FlushDone(const BatchPtr& batch, const std::vector<Status>& apply_statuses,
+                 const client::YBSessionPtr& session, const Status& status);
+
+  const std::shared_future<client::YBClient*> client_future_;
+
+  std::mutex mutex_;
+  // Updates collected while the maximal number of flushes is in progress.
+  BatchPtr pending_batch_;
+  size_t flushes_in_flight_ = 0;
+
+  std::atomic<size_t> async_pending_ops_{0};
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_QL_INDEX_WRITE_BATCHER_H
@@ -20,11 +20,19 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/yb_pg_errcodes.h"
 
+using namespace std::literals;
 using namespace std::placeholders;
 
 DEFINE_test_flag(uint64, transaction_delay_status_reply_usec_in_tests, 0,
                  "For tests only. Delay handling status reply by specified amount of usec.");
 
+DEFINE_int32(transaction_pending_status_cache_ms, 10,
+             "PENDING transaction status received from the transaction coordinator within this "
+             "number of milliseconds is reused by conflict resolution instead of requesting status "
+             "again. 0 to disable.");
+TAG_FLAG(transaction_pending_status_cache_ms, advanced);
+TAG_FLAG(transaction_pending_status_cache_ms, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -38,12 +46,11 @@ RunningTransaction::RunningTransaction(TransactionMetadata metadata,
       context_(*context),
       remove_intents_task_(&context->applier_, &context->participant_context_, context,
                            metadata_.transaction_id),
-      get_status_handle_(context->rpcs_.InvalidHandle()),
       abort_handle_(context->rpcs_.InvalidHandle()) {
 }
 
 RunningTransaction::~RunningTransaction() {
-  context_.rpcs_.Abort({&get_status_handle_, &abort_handle_});
+  context_.rpcs_.Abort({&abort_handle_});
 }
 
 void RunningTransaction::AddReplicatedBatch(
@@ -85,6 +92,17 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
       return;
     }
   }
+  if (request.accept_recent_pending && last_known_status_ == TransactionStatus::PENDING &&
+      CoarseMonoClock::now() <
+          last_known_status_received_time_ + FLAGS_transaction_pending_status_cache_ms * 1ms) {
+    // The transaction was pending a moment ago, concurrent conflict resolvers do not have to
+    // request its status again and again.
+    HybridTime last_known_status_hybrid_time = last_known_status_hybrid_time_;
+    lock->unlock();
+    request.callback(
+        TransactionStatusResult{TransactionStatus::PENDING, last_known_status_hybrid_time});
+    return;
+  }
   bool was_empty = status_waiters_.empty();
   status_waiters_.push_back(request);
   if (!was_empty) {
@@ -183,19 +201,9 @@ boost::optional<TransactionStatus> RunningTransaction::GetStatusAt(
 
 void RunningTransaction::SendStatusRequest(
     int64_t serial_no, const RunningTransactionPtr& shared_self) {
-  tserver::GetTransactionStatusRequestPB req;
-  req.set_tablet_id(metadata_.status_tablet);
-  req.add_transaction_id()->assign(
-      pointer_cast<const char*>(metadata_.transaction_id.data()), metadata_.transaction_id.size());
-  req.set_propagated_hybrid_time(context_.participant_context_.Now().ToUint64());
-  context_.rpcs_.RegisterAndStart(
-      client::GetTransactionStatus(
-          TransactionRpcDeadline(),
-          nullptr /* tablet */,
-          context_.participant_context_.client_future().get(),
-          &req,
-          std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self)),
-      &get_status_handle_);
+  context_.status_batcher_.Request(
+      metadata_.status_tablet, metadata_.transaction_id,
+      std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self));
 }
 
 void RunningTransaction::StatusReceived(
@@ -222,7 +230,6 @@ void RunningTransaction::DoStatusReceived(const Status& status,
     context_.participant_context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
   }
 
-  context_.rpcs_.Unregister(&get_status_handle_);
   decltype(status_waiters_) status_waiters;
   HybridTime time_of_status;
   TransactionStatus transaction_status;
@@ -257,6 +264,7 @@ void RunningTransaction::DoStatusReceived(const Status& status,
       if (last_known_status_hybrid_time_ <= time_of_status) {
         last_known_status_hybrid_time_ = time_of_status;
         last_known_status_ = response.status(0);
+        last_known_status_received_time_ = CoarseMonoClock::now();
         if (response.status(0) == TransactionStatus::ABORTED) {
           context_.EnqueueRemoveUnlocked(id(), &min_running_notifier);
         }
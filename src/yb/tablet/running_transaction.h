@@ -128,8 +128,9 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   TransactionStatus last_known_status_ = TransactionStatus::CREATED;
   HybridTime last_known_status_hybrid_time_ = HybridTime::kMin;
+  // Time when last_known_status_ was received from the transaction coordinator.
+  CoarseTimePoint last_known_status_received_time_;
   std::vector<StatusRequest> status_waiters_;
-  rpc::Rpcs::Handle get_status_handle_;
   rpc::Rpcs::Handle abort_handle_;
   std::vector<TransactionStatusCallback> abort_waiters_;
 };
@@ -17,6 +17,7 @@
 #include "yb/rpc/rpc.h"
 
 #include "yb/tablet/transaction_participant.h"
+#include "yb/tablet/transaction_status_batcher.h"
 
 #include "yb/util/delayer.h"
 
@@ -49,7 +50,8 @@ class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
                             TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+      : participant_context_(*participant_context), applier_(*applier),
+        status_batcher_(participant_context, &rpcs_) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -80,6 +82,10 @@ class RunningTransactionContext {
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  // Status requests of running transactions are sent through it, so status requests of different
+  // transactions are batched per status tablet.
+  TransactionStatusBatcher status_batcher_;
+
   // Used only in tests.
   Delayer delayer_;
 };
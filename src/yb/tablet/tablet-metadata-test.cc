@@ -149,5 +149,25 @@ TEST_F(TestRaftGroupMetadata, TestDeleteTabletDataClearsDisk) {
   ASSERT_FALSE(env_->DirExists(tablet->metadata()->snapshots_dir()));
 }
 
+TEST_F(TestRaftGroupMetadata, TestProjectionCache) {
+  auto table_info = ASSERT_RESULT(harness_->tablet()->metadata()->GetTableInfo(""));
+  const std::vector<ColumnId> column_ids = {
+      ColumnId(kFirstColumnId + 2), ColumnId(kFirstColumnId + 1) };
+
+  auto projection = ASSERT_RESULT(table_info->GetProjection(column_ids));
+  ASSERT_EQ(2U, projection->num_columns());
+  ASSERT_EQ(ColumnId(kFirstColumnId + 2), projection->column_id(0));
+  ASSERT_EQ(ColumnId(kFirstColumnId + 1), projection->column_id(1));
+
+  // The same projection is returned for the same columns.
+  ASSERT_EQ(projection, ASSERT_RESULT(table_info->GetProjection(column_ids)));
+
+  auto other_projection = ASSERT_RESULT(table_info->GetProjection(
+      { ColumnId(kFirstColumnId + 1), ColumnId(kFirstColumnId + 100) }));
+  ASSERT_NE(projection, other_projection);
+  ASSERT_EQ(1U, other_projection->num_columns());
+  ASSERT_EQ(ColumnId(kFirstColumnId + 1), other_projection->column_id(0));
+}
+
 } // namespace tablet
 } // namespace yb
@@ -19,15 +19,26 @@
 #include "yb/common/ql_value.h"
 
 #include "yb/docdb/docdb.h"
+#include "yb/docdb/docdb-internal.h"
+#include "yb/docdb/docdb_compaction_filter_intents.h"
 #include "yb/docdb/docdb_debug.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/value.h"
+
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/write_batch.h"
 
 #include "yb/tablet/tablet-test-util.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_options.h"
 #include "yb/tablet/local_tablet_writer.h"
+#include "yb/util/bitmap.h"
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 
 DECLARE_int64(db_write_buffer_size);
+DECLARE_bool(enable_transaction_sealing);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
 
@@ -215,11 +226,149 @@ TEST_F(TabletSplitTest, SplitTablet) {
   ASSERT_TRUE(source_docdb_dump.empty()) << boost::algorithm::join(source_docdb_dump, "\n");
 }
 
+namespace {
+
+class WriteBatchCollector : public rocksdb::WriteBatch::Handler {
+ public:
+  void Put(const Slice& key, const Slice& value) override {
+    records.emplace_back(key.ToBuffer(), value.ToBuffer());
+  }
+
+  std::vector<std::pair<std::string, std::string>> records;
+};
+
+// Returns key of the intent referred by reverse index record value.
+Slice ReverseIndexIntentKey(Slice value) {
+  if (!value.empty() && value[0] == docdb::ValueTypeAsChar::kBitSet) {
+    value.remove_prefix(1);
+    CHECK_OK(OneWayBitmap::Skip(&value));
+  }
+  return value;
+}
+
+} // namespace
+
+// Checks that compaction of the intents DB of a split tablet drops only intents and reverse index
+// records that are not related to its key bounds, and that the transaction could be applied after
+// that.
+TEST_F(TabletSplitTest, SplitIntentsCompaction) {
+  FLAGS_enable_transaction_sealing = true;
+  constexpr int kNumRows = 100;
+  constexpr docdb::DocKeyHash kSplitHash = 0x8000;
+
+  const auto transaction_id = TransactionId::GenerateRandom();
+  const auto write_ht = tablet()->clock()->Now();
+
+  // Reverse index value of the last intent of each batch is prefixed with replicated batches.
+  OneWayBitmap replicated_batches;
+  replicated_batches.Set(0);
+  boost::container::small_vector<uint8_t, 16> replicated_batches_state;
+  replicated_batches_state.push_back(docdb::ValueTypeAsChar::kBitSet);
+  replicated_batches.EncodeTo(&replicated_batches_state);
+
+  rocksdb::WriteBatch intents_batch;
+  IntraTxnWriteId write_id = 0;
+  std::array<size_t, 2> num_rows_in_tablet = {0, 0};
+  for (int i = 0; i != kNumRows; ++i) {
+    // Row with split hash code checks that the lower bound of the second tablet is inclusive.
+    const docdb::DocKeyHash hash = i == 0 ? kSplitHash : (i * 1543) & 0xffff;
+    ++num_rows_in_tablet[hash < kSplitHash ? 0 : 1];
+    docdb::SubDocKey sub_doc_key(
+        docdb::DocKey(hash, {docdb::PrimitiveValue::Int32(i)}),
+        docdb::PrimitiveValue(ColumnId(kFirstColumnId + 1)));
+    docdb::KeyValueWriteBatchPB put_batch;
+    auto* pair = put_batch.add_write_pairs();
+    pair->set_key(sub_doc_key.EncodeWithoutHt().ToStringBuffer());
+    pair->set_value(docdb::Value(docdb::PrimitiveValue(Format("value_$0", i))).Encode());
+    docdb::PrepareTransactionWriteBatch(
+        put_batch, write_ht, &intents_batch, transaction_id, IsolationLevel::SNAPSHOT_ISOLATION,
+        docdb::PartialRangeKeyIntents::kTrue,
+        Slice(replicated_batches_state.data(), replicated_batches_state.size()), &write_id);
+  }
+  WriteBatchCollector source_records;
+  ASSERT_OK(intents_batch.Iterate(&source_records));
+
+  docdb::KeyBytes split_key;
+  docdb::DocKeyEncoderAfterTableIdStep(&split_key).Hash(
+      kSplitHash, std::vector<docdb::PrimitiveValue>());
+  const std::array<docdb::KeyBounds, 2> key_bounds = {{
+      docdb::KeyBounds(Slice(), split_key.AsSlice()),
+      docdb::KeyBounds(split_key.AsSlice(), Slice()),
+  }};
+
+  for (size_t idx = 0; idx != key_bounds.size(); ++idx) {
+    const auto& bounds = key_bounds[idx];
+    rocksdb::Options options;
+    docdb::InitRocksDBOptions(
+        &options, Format("Intents $0: ", idx), rocksdb::CreateDBStatistics(), TabletOptions());
+    options.compaction_filter_factory =
+        std::make_shared<docdb::DocDBIntentsCompactionFilterFactory>(tablet().get(), &bounds);
+    rocksdb::DB* db = nullptr;
+    ASSERT_OK(rocksdb::DB::Open(options, GetTestPath(Format("intents-$0", idx)), &db));
+    std::unique_ptr<rocksdb::DB> intents_db(db);
+
+    rocksdb::WriteBatch batch;
+    for (const auto& record : source_records.records) {
+      batch.Put(record.first, record.second);
+    }
+    ASSERT_OK(intents_db->Write(rocksdb::WriteOptions(), &batch));
+    ASSERT_OK(intents_db->Flush(rocksdb::FlushOptions()));
+    docdb::ForceRocksDBCompact(intents_db.get());
+
+    std::unordered_map<std::string, std::string> compacted;
+    rocksdb::ReadOptions read_opts;
+    read_opts.query_id = rocksdb::kDefaultQueryId;
+    std::unique_ptr<rocksdb::Iterator> iter(intents_db->NewIterator(read_opts));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      compacted.emplace(iter->key().ToBuffer(), iter->value().ToBuffer());
+    }
+
+    // Weak intents on the table root are related to all tablets, other intents only to the
+    // tablet that contains their key. Reverse index record is kept together with its intent.
+    auto is_related_intent = [&bounds](Slice intent_key) {
+      return intent_key.starts_with(docdb::ValueTypeAsChar::kGroupEnd) ||
+             bounds.IsWithinBounds(intent_key);
+    };
+    size_t num_kept_reverse = 0;
+    size_t num_sealed_reverse = 0;
+    for (const auto& record : source_records.records) {
+      const auto key_type = docdb::GetKeyType(record.first, docdb::StorageDbType::kIntents);
+      bool related = true;
+      if (key_type == docdb::KeyType::kIntentKey) {
+        related = is_related_intent(record.first);
+      } else if (key_type == docdb::KeyType::kReverseTxnKey) {
+        const auto intent_key = ReverseIndexIntentKey(record.second);
+        related = is_related_intent(intent_key);
+        ASSERT_TRUE(compacted.count(intent_key.ToBuffer()) || !related)
+            << "Intent of kept reverse index record was removed: "
+            << Slice(record.second).ToDebugHexString();
+        if (related) {
+          ++num_kept_reverse;
+          if (intent_key.size() != record.second.size()) {
+            ++num_sealed_reverse;
+          }
+        }
+      }
+      ASSERT_EQ(compacted.count(record.first), related ? 1 : 0)
+          << "Tablet " << idx << ", " << key_type << ": "
+          << Slice(record.first).ToDebugHexString();
+    }
+    ASSERT_GT(num_kept_reverse, num_rows_in_tablet[idx]);
+    ASSERT_EQ(num_sealed_reverse, num_rows_in_tablet[idx]);
+
+    // Pending transaction is still applied to the split tablet, with rows of this tablet only.
+    rocksdb::WriteBatch regular_batch;
+    ASSERT_OK(docdb::PrepareApplyIntentsBatch(
+        transaction_id, write_ht, &bounds, &regular_batch, intents_db.get(),
+        nullptr /* intents_batch */));
+    ASSERT_EQ(regular_batch.Count(), num_rows_in_tablet[idx]);
+  }
+}
+
 // TODO: Need to test with distributed transactions both pending and committed
 // (but not yet applied) during split.
 // Split tablets should not return unexpected data for not yet applied, but committed transactions
 // before and after compaction.
-// Also check that non-relevant intents are cleaned from split intents DB after compaction.
 //
 // This test would be possible as an integration test when upper layers of tablet splitting are
 // implemented.
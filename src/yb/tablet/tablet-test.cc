@@ -42,6 +42,7 @@
 
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/join.h"
+#include "yb/rocksdb/db.h"
 #include "yb/tablet/local_tablet_writer.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet-test-base.h"
@@ -56,6 +57,8 @@
 using std::shared_ptr;
 using std::unordered_set;
 
+DECLARE_int64(follower_apply_batch_max_size_bytes);
+
 namespace yb {
 namespace tablet {
 
@@ -215,5 +218,91 @@ TYPED_TEST(TestTablet, TestFlushedOpId) {
   ASSERT_EQ(id.index, start_index + 2*kCount);
 }
 
+// Applies writes the way a follower does, see ReplicaState::ApplyPendingOperationsUnlocked.
+TYPED_TEST(TestTablet, TestFollowerApplyBatch) {
+  auto tablet = this->tablet().get();
+  auto* db = tablet->TEST_db();
+  auto* mvcc = tablet->mvcc_manager();
+  LocalTabletWriter writer(tablet);
+  const int kCount = 10;
+
+  ASSERT_OK(this->InsertTestRow(&writer, 0, 0));
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  const int64_t start_index = ASSERT_RESULT(tablet->MaxPersistentOpId()).regular.index;
+
+  // Writes are combined, and neither written to RocksDB nor marked as replicated in MVCC, until
+  // the batch is finished.
+  auto last_replicated = mvcc->LastReplicatedHybridTime();
+  auto sequence_number = db->GetLatestSequenceNumber();
+  tablet->StartApplyBatch();
+  for (int i = 1; i <= kCount; ++i) {
+    ASSERT_OK(this->InsertTestRow(&writer, i, 0));
+  }
+  ASSERT_EQ(last_replicated, mvcc->LastReplicatedHybridTime());
+  ASSERT_EQ(sequence_number, db->GetLatestSequenceNumber());
+
+  // A non write operation finishes the batch, and a new one is started after it.
+  tablet->FinishApplyBatch();
+  ASSERT_GT(mvcc->LastReplicatedHybridTime(), last_replicated);
+  ASSERT_GE(tablet->SafeTime(), mvcc->LastReplicatedHybridTime());
+  ASSERT_GT(db->GetLatestSequenceNumber(), sequence_number);
+  last_replicated = mvcc->LastReplicatedHybridTime();
+  tablet->StartApplyBatch();
+  for (int i = kCount + 1; i <= 2 * kCount; ++i) {
+    ASSERT_OK(this->UpdateTestRow(&writer, i - kCount, i));
+  }
+  ASSERT_EQ(last_replicated, mvcc->LastReplicatedHybridTime());
+  tablet->FinishApplyBatch();
+  ASSERT_GT(mvcc->LastReplicatedHybridTime(), last_replicated);
+
+  // Flushed op id covers all operations of the batches.
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  ASSERT_EQ(ASSERT_RESULT(tablet->MaxPersistentOpId()).regular.index, start_index + 2 * kCount);
+
+  vector<string> out_rows;
+  ASSERT_OK(this->IterateToStringList(&out_rows));
+  ASSERT_EQ(kCount + 1, out_rows.size());
+  unordered_set<string> rows(out_rows.begin(), out_rows.end());
+  for (int i = 1; i <= kCount; ++i) {
+    ASSERT_EQ(1, rows.count(this->setup_.FormatDebugRow(i, i + kCount, true)));
+  }
+
+  // Batch that reaches follower_apply_batch_max_size_bytes is written right away, while marking
+  // the operation as replicated is deferred to the next batch.
+  FLAGS_follower_apply_batch_max_size_bytes = 1;
+  last_replicated = mvcc->LastReplicatedHybridTime();
+  sequence_number = db->GetLatestSequenceNumber();
+  tablet->StartApplyBatch();
+  ASSERT_OK(this->UpdateTestRow(&writer, 0, 1));
+  ASSERT_GT(db->GetLatestSequenceNumber(), sequence_number);
+  ASSERT_EQ(last_replicated, mvcc->LastReplicatedHybridTime());
+  tablet->FinishApplyBatch();
+  ASSERT_GT(mvcc->LastReplicatedHybridTime(), last_replicated);
+}
+
+TYPED_TEST(TestTablet, TestHibernate) {
+  auto tablet = this->tablet().get();
+  LocalTabletWriter writer(tablet);
+  const int64_t kCount = 100;
+
+  ASSERT_OK(this->InsertTestRow(&writer, 0, 0));
+  ASSERT_OK(tablet->Flush(FlushMode::kSync));
+  this->InsertTestRows(1, kCount, 0);
+  const auto flushed = ASSERT_RESULT(tablet->MaxPersistentOpId()).regular;
+
+  ASSERT_OK(tablet->Hibernate());
+  ASSERT_TRUE(tablet->hibernated());
+  // Memtable should be flushed during hibernation.
+  ASSERT_EQ(ASSERT_RESULT(tablet->MaxPersistentOpId()).regular.index, flushed.index + kCount);
+
+  // Table readers are reopened on demand.
+  vector<string> out_rows;
+  ASSERT_OK(this->IterateToStringList(&out_rows));
+  ASSERT_EQ(kCount + 1, out_rows.size());
+
+  ASSERT_OK(this->UpdateTestRow(&writer, 0, 1));
+  ASSERT_FALSE(tablet->hibernated());
+}
+
 } // namespace tablet
 } // namespace yb
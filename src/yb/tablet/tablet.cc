@@ -130,6 +130,7 @@
 #include "yb/util/pg_connstr.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/slice.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
 #include "yb/util/url-coding.h"
@@ -185,6 +186,18 @@ DEFINE_int32(backfill_index_rate_rows_per_sec, 0, "Rate of at which the "
 TAG_FLAG(backfill_index_rate_rows_per_sec, advanced);
 TAG_FLAG(backfill_index_rate_rows_per_sec, runtime);
 
+DEFINE_int32(backfill_index_target_write_latency_ms, 0,
+             "If set > 0, index backfill slows down while writing a batch to the index table "
+             "takes longer than this. Such latency means that the index tablets are busy, e.g. "
+             "with foreground writes, so backfill backs off to leave them room.");
+TAG_FLAG(backfill_index_target_write_latency_ms, advanced);
+TAG_FLAG(backfill_index_target_write_latency_ms, runtime);
+
+DEFINE_int32(backfill_index_max_throttle_delay_ms, 1000,
+             "Maximum delay between backfill batches added because of index write latency.");
+TAG_FLAG(backfill_index_max_throttle_delay_ms, advanced);
+TAG_FLAG(backfill_index_max_throttle_delay_ms, runtime);
+
 DEFINE_int32(backfill_index_timeout_grace_margin_ms, 50,
              "The time we give the backfill process to wrap up the current set "
              "of writes and return successfully the RPC with the information about "
@@ -211,9 +224,29 @@ DEFINE_test_flag(bool, tablet_verify_flushed_frontier_after_modifying, false,
                  "After modifying the flushed frontier in RocksDB, verify that the restored value "
                  "of it is as expected. Used for testing.");
 
+DEFINE_int64(follower_apply_batch_max_size_bytes, 1_MB,
+             "Max size of RocksDB write batch, that combines writes of several operations applied "
+             "on a follower. 0 disables combining.");
+TAG_FLAG(follower_apply_batch_max_size_bytes, advanced);
+TAG_FLAG(follower_apply_batch_max_size_bytes, runtime);
+
 DEFINE_test_flag(bool, docdb_log_write_batches, false,
                  "Dump write batches being written to RocksDB");
 
+DEFINE_bool(post_split_trigger_compaction, true,
+            "Compact a tablet created by split, after it is opened, to drop keys of the other "
+            "child tablet from SST files shared with the parent tablet.");
+TAG_FLAG(post_split_trigger_compaction, advanced);
+TAG_FLAG(post_split_trigger_compaction, runtime);
+
+DEFINE_int32(post_split_compaction_extra_priority, 5,
+             "Extra priority of the compaction of a tablet created by split, over regular "
+             "compactions, in the compaction thread pool.");
+TAG_FLAG(post_split_compaction_extra_priority, advanced);
+TAG_FLAG(post_split_compaction_extra_priority, runtime);
+
+DECLARE_int32(docdb_shared_write_batch_cache_max_entries);
+DECLARE_int32(docdb_row_cache_max_entries);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 
@@ -406,11 +439,16 @@ Tablet::Tablet(const TabletInitData& data)
       log_prefix_suffix_(data.log_prefix_suffix),
       is_sys_catalog_(data.is_sys_catalog),
       txns_enabled_(data.txns_enabled),
-      retention_policy_(std::make_shared<TabletRetentionPolicy>(clock_, metadata_.get())) {
+      retention_policy_(std::make_shared<TabletRetentionPolicy>(clock_, metadata_.get())),
+      ql_index_write_batcher_(std::make_shared<QLIndexWriteBatcher>(client_future_)) {
   CHECK(schema()->has_column_ids());
   LOG_WITH_PREFIX(INFO) << "Schema version for " << metadata_->table_name() << " is "
                         << metadata_->schema_version();
 
+  if (FLAGS_docdb_row_cache_max_entries > 0) {
+    row_cache_ = std::make_unique<docdb::DocRowCache>();
+  }
+
   if (data.metric_registry) {
     MetricEntity::AttributeMap attrs;
     // TODO(KUDU-745): table_id is apparently not set in the metadata.
@@ -446,6 +484,7 @@ Tablet::Tablet(const TabletInitData& data)
     });
 
     metrics_.reset(new TabletMetrics(metric_entity_));
+    shared_lock_manager_.SetMetricEntity(metric_entity_);
 
     mem_tracker_->SetMetricEntity(metric_entity_);
   }
@@ -753,6 +792,62 @@ void Tablet::RegularDbFilesChanged() {
 
 void Tablet::SetCleanupPool(ThreadPool* thread_pool) {
   cleanup_intent_files_token_ = thread_pool->NewToken(ThreadPool::ExecutionMode::SERIAL);
+  post_split_compaction_token_ = thread_pool->NewToken(ThreadPool::ExecutionMode::SERIAL);
+}
+
+void Tablet::TriggerPostSplitCompactionIfNeeded() {
+  if (!GetAtomicFlag(&FLAGS_post_split_trigger_compaction) || !post_split_compaction_token_ ||
+      !key_bounds_.IsInitialized() || metadata_->has_been_fully_compacted()) {
+    return;
+  }
+
+  WARN_WITH_PREFIX_NOT_OK(
+      post_split_compaction_token_->SubmitFunc(std::bind(&Tablet::DoPostSplitCompaction, this)),
+      "Submit post-split compaction failed");
+}
+
+void Tablet::DoPostSplitCompaction() {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  if (!scoped_read_operation.ok() || shutdown_requested_.load(std::memory_order_acquire) ||
+      !regular_db_) {
+    return;
+  }
+
+  // Files that contain only keys of the other child tablet are deleted without reading them.
+  // RocksDB deletes only the oldest file of level 0, so files are tried from the oldest one.
+  std::vector<rocksdb::LiveFileMetaData> files;
+  regular_db_->GetLiveFilesMetaData(&files);
+  std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.largest.seqno < rhs.largest.seqno;
+  });
+  for (const auto& file : files) {
+    const bool out_of_bounds =
+        (!key_bounds_.lower.empty() && Slice(file.largest.key).compare(key_bounds_.lower) < 0) ||
+        (!key_bounds_.upper.empty() && Slice(file.smallest.key).compare(key_bounds_.upper) >= 0);
+    if (!out_of_bounds) {
+      break;
+    }
+    LOG_WITH_PREFIX(INFO) << "Post-split SST file out of key bounds will be deleted: "
+                          << file.ToString();
+    auto delete_status = regular_db_->DeleteFile(file.name);
+    if (!delete_status.ok()) {
+      LOG_WITH_PREFIX(WARNING) << "Failed to delete " << file.name << ": " << delete_status;
+      break;
+    }
+  }
+
+  // Remaining keys of the other child tablet are dropped by the compaction filter.
+  rocksdb::CompactRangeOptions options;
+  options.exclusive_manual_compaction = false;
+  options.extra_priority = FLAGS_post_split_compaction_extra_priority;
+  LOG_WITH_PREFIX(INFO) << "Starting post-split compaction, key bounds: "
+                        << key_bounds_.ToString();
+  auto status = regular_db_->CompactRange(options, nullptr /* begin */, nullptr /* end */);
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Post-split compaction failed: " << status;
+    return;
+  }
+  LOG_WITH_PREFIX(INFO) << "Post-split compaction done";
 }
 
 void Tablet::CleanupIntentFiles() {
@@ -905,6 +1000,10 @@ void Tablet::CompleteShutdown(IsDropTable is_drop_table) {
 
   StartShutdown();
 
+  // Wait for post-split compaction, that could be running, before pausing operations, because it
+  // keeps the read operation while compaction is in progress.
+  post_split_compaction_token_.reset();
+
   auto op_pause = PauseReadWriteOperations(Stop::kTrue);
   if (!op_pause.ok()) {
     LOG_WITH_PREFIX(WARNING) << "Failed to shut down: " << op_pause.status();
@@ -964,6 +1063,10 @@ Status Tablet::ResetRocksDBs(Destroy destroy, DisableFlushOnShutdown disable_flu
   Status intents_status = ResetRocksDB(destroy, rocksdb_options, &intents_db_);
   Status regular_status = ResetRocksDB(destroy, rocksdb_options, &regular_db_);
   key_bounds_ = docdb::KeyBounds();
+  shared_write_batch_cache_.Clear();
+  if (row_cache_) {
+    row_cache_->Clear();
+  }
 
   return regular_status.ok() ? intents_status : regular_status;
 }
@@ -1036,7 +1139,7 @@ Status Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
           : *operation_state->request();
   const KeyValueWriteBatchPB& put_batch = write_request.write_batch();
   if (metrics_) {
-    metrics_->rows_inserted->IncrementBy(write_request.write_batch().write_pairs().size());
+    metrics_->rows_inserted->IncrementBy(docdb::WritePairsCount(write_request.write_batch()));
   }
 
   return ApplyOperationState(*operation_state, write_request.batch_idx(), put_batch);
@@ -1053,10 +1156,63 @@ Status Tablet::ApplyOperationState(
   // Even if we have an external hybrid time, use the local commit hybrid time in the consensus
   // frontier.
   set_hybrid_time(operation_state.hybrid_time(), &frontiers);
+  if (!write_batch.has_transaction()) {
+    docdb::SetTtlExpiration(write_batch, hybrid_time, &frontiers.Largest());
+  }
   return ApplyKeyValueRowOperations(
       batch_idx, write_batch, &frontiers, hybrid_time);
 }
 
+namespace {
+
+// Returns the smallest and the largest doc keys among keys of the specified pairs.
+Result<std::pair<Slice, Slice>> MinMaxDocKeys(
+    const google::protobuf::RepeatedPtrField<docdb::KeyValuePairPB>& pairs) {
+  std::pair<Slice, Slice> result;
+  bool first = true;
+  for (const auto& pair : pairs) {
+    Slice key(pair.key());
+    auto doc_key_size = VERIFY_RESULT(
+        docdb::DocKey::EncodedSize(key, docdb::DocKeyPart::kWholeDocKey));
+    Slice doc_key = key.Prefix(doc_key_size);
+    if (first || doc_key.compare(result.first) < 0) {
+      result.first = doc_key;
+    }
+    if (first || doc_key.compare(result.second) > 0) {
+      result.second = doc_key;
+    }
+    first = false;
+  }
+  return result;
+}
+
+// Returns RocksDB write batch size, that is enough to hold records of the specified put batch in
+// most cases, so the write batch buffer is allocated once instead of growing by reallocations.
+size_t EstimateWriteBatchSize(const KeyValueWriteBatchPB& put_batch) {
+  // Write batch header.
+  constexpr size_t kHeaderSize = 12;
+  // Record type, varint sizes of key and value, and encoded hybrid time appended to the key.
+  constexpr size_t kRecordOverhead = 24;
+  // Transaction write also stores a reverse index record per intent, whose key is the transaction
+  // id with hybrid time and write id, and whose value is the intent key.
+  constexpr size_t kReverseIndexRecordOverhead = kRecordOverhead + 32;
+
+  const bool transactional = put_batch.has_transaction();
+  size_t result = kHeaderSize;
+  for (const auto& pair : put_batch.write_pairs()) {
+    result += pair.key().size() + pair.value().size() + kRecordOverhead;
+    if (transactional) {
+      result += pair.key().size() + kReverseIndexRecordOverhead;
+    }
+  }
+  // Encoded pairs already include varint sizes of keys and values.
+  result += put_batch.encoded_write_pairs().size() +
+            put_batch.encoded_write_pairs_count() * kRecordOverhead;
+  return result;
+}
+
+} // namespace
+
 Status Tablet::PrepareTransactionWriteBatch(
     int64_t batch_idx,
     const KeyValueWriteBatchPB& put_batch,
@@ -1084,6 +1240,20 @@ Status Tablet::PrepareTransactionWriteBatch(
                          PgsqlError(YBPgErrorCode::YB_PG_T_R_SERIALIZATION_FAILURE));
   }
 
+  if (!put_batch.write_pairs().empty()) {
+    auto min_max_doc_keys = MinMaxDocKeys(put_batch.write_pairs());
+    if (min_max_doc_keys.ok()) {
+      transaction_participant()->ExpandIntentsKeyRange(
+          min_max_doc_keys->first, min_max_doc_keys->second);
+    } else {
+      // Replicated intents should be written anyway, so just cover all possible doc keys.
+      LOG_WITH_PREFIX(DFATAL) << "Failed to decode doc keys of write batch: "
+                              << min_max_doc_keys.status();
+      static const char kMaxByte = docdb::ValueTypeAsChar::kMaxByte;
+      transaction_participant()->ExpandIntentsKeyRange(Slice(), Slice(&kMaxByte, 1));
+    }
+  }
+
   auto isolation_level = prepare_batch_data->first;
   auto& last_batch_data = prepare_batch_data->second;
   yb::docdb::PrepareTransactionWriteBatch(
@@ -1101,27 +1271,53 @@ Status Tablet::ApplyKeyValueRowOperations(int64_t batch_idx,
                                           const KeyValueWriteBatchPB& put_batch,
                                           const rocksdb::UserFrontiers* frontiers,
                                           const HybridTime hybrid_time) {
-  if (put_batch.write_pairs().empty() && put_batch.read_pairs().empty()) {
+  if (put_batch.write_pairs().empty() && put_batch.read_pairs().empty() &&
+      put_batch.encoded_write_pairs().empty()) {
     return Status::OK();
   }
 
+  MarkAccessed();
+
   // Could return failure only for cases where it is safe to skip applying operations to DB.
   // For instance where aborted transaction intents are written.
   // In all other cases we should crash instead of skipping apply.
 
-  rocksdb::WriteBatch write_batch;
+  rocksdb::WriteBatch write_batch(apply_batch_.active && !put_batch.has_transaction()
+      ? 0 : EstimateWriteBatchSize(put_batch));
   if (put_batch.has_transaction()) {
     RequestScope request_scope(transaction_participant_.get());
     RETURN_NOT_OK(PrepareTransactionWriteBatch(batch_idx, put_batch, hybrid_time, &write_batch));
     WriteToRocksDB(frontiers, &write_batch, StorageDbType::kIntents);
   } else {
-    PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
-    WriteToRocksDB(frontiers, &write_batch, StorageDbType::kRegular);
-    if (snapshot_coordinator_) {
-      for (const auto& pair : put_batch.write_pairs()) {
-        WARN_NOT_OK(snapshot_coordinator_->ApplyWritePair(pair.key(), pair.value()),
-                    "ApplyWritePair failed");
+    if (apply_batch_.active) {
+      PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &apply_batch_.write_batch);
+      if (!apply_batch_.frontiers) {
+        apply_batch_.frontiers = frontiers->Clone();
+      } else {
+        apply_batch_.frontiers->MergeFrontiers(*frontiers);
+      }
+      if (apply_batch_.write_batch.GetDataSize() >=
+              static_cast<size_t>(FLAGS_follower_apply_batch_max_size_bytes)) {
+        FinishApplyBatch();
+        StartApplyBatch();
       }
+    } else {
+      PrepareNonTransactionWriteBatch(put_batch, hybrid_time, &write_batch);
+      WriteToRocksDB(frontiers, &write_batch, StorageDbType::kRegular);
+    }
+    shared_write_batch_cache_.InvalidateDocuments(put_batch);
+    if (row_cache_) {
+      row_cache_->InvalidateDocuments(put_batch, hybrid_time);
+    }
+    if (snapshot_coordinator_) {
+      WARN_NOT_OK(docdb::EnumerateWritePairs(
+                      put_batch,
+                      [this](const Slice& key, const Slice& value) {
+                        WARN_NOT_OK(snapshot_coordinator_->ApplyWritePair(key, value),
+                                    "ApplyWritePair failed");
+                        return Status::OK();
+                      }),
+                  "Enumerate write pairs failed");
     }
   }
 
@@ -1143,8 +1339,9 @@ void Tablet::WriteToRocksDB(
 
   write_batch->SetFrontiers(frontiers);
 
-  // We are using Raft replication index for the RocksDB sequence number for
-  // all members of this write batch.
+  // RocksDB assigns sequence numbers to the batch, while Raft replication index is tracked by
+  // frontiers. Large batches could be inserted into memtable by several threads, see
+  // rocksdb_parallel_memtable_insert_part_size.
   rocksdb::WriteOptions write_options;
   InitRocksDBWriteOptions(&write_options);
 
@@ -1162,6 +1359,35 @@ void Tablet::WriteToRocksDB(
   }
 }
 
+void Tablet::StartApplyBatch() {
+  apply_batch_.active = FLAGS_follower_apply_batch_max_size_bytes > 0;
+}
+
+void Tablet::FinishApplyBatch() {
+  if (!apply_batch_.active) {
+    return;
+  }
+  apply_batch_.active = false;
+  if (apply_batch_.write_batch.Count() != 0) {
+    WriteToRocksDB(
+        apply_batch_.frontiers.get(), &apply_batch_.write_batch, StorageDbType::kRegular);
+    apply_batch_.write_batch.Clear();
+  }
+  apply_batch_.frontiers.reset();
+  for (auto hybrid_time : apply_batch_.replicated) {
+    mvcc_.Replicated(hybrid_time);
+  }
+  apply_batch_.replicated.clear();
+}
+
+void Tablet::ApplyReplicated(HybridTime hybrid_time) {
+  if (apply_batch_.active) {
+    apply_batch_.replicated.push_back(hybrid_time);
+  } else {
+    mvcc_.Replicated(hybrid_time);
+  }
+}
+
 namespace {
 
 // Separate Redis / QL / row operations write batches from write_request in preparation for the
@@ -1235,6 +1461,7 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
   // TODO: move this locking to the top-level read request handler in TabletService.
   ScopedRWOperation scoped_read_operation(&pending_op_counter_, deadline);
   RETURN_NOT_OK(scoped_read_operation);
+  MarkAccessed();
 
   ScopedTabletMetricsTracker metrics_tracker(metrics_->redis_read_latency);
 
@@ -1254,6 +1481,7 @@ Status Tablet::HandleQLReadRequest(
     QLReadRequestResult* result) {
   ScopedRWOperation scoped_read_operation(&pending_op_counter_, deadline);
   RETURN_NOT_OK(scoped_read_operation);
+  MarkAccessed();
   ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
 
   if (metadata()->schema_version() != ql_read_request.schema_version()) {
@@ -1423,8 +1651,8 @@ void Tablet::CompleteQLWriteBatch(std::unique_ptr<WriteOperation> operation, con
 }
 
 void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
-  client::YBClient* client = nullptr;
-  client::YBSessionPtr session;
+  bool has_index_requests = false;
+  bool has_unique_index = false;
   client::YBTransactionPtr txn;
   IndexOps index_ops;
   const ChildTransactionDataPB* child_transaction_data = nullptr;
@@ -1433,9 +1661,8 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
     if (write_op->index_requests()->empty()) {
       continue;
     }
-    if (!client) {
-      client = client_future_.get();
-      session = std::make_shared<YBSession>(client);
+    if (!has_index_requests) {
+      has_index_requests = true;
       if (write_op->request().has_child_transaction_data()) {
         child_transaction_data = &write_op->request().child_transaction_data();
         if (!transaction_manager_) {
@@ -1451,7 +1678,6 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
           return;
         }
         txn = std::make_shared<YBTransaction>(&transaction_manager_.get(), *child_data);
-        session->SetTransaction(txn);
       } else {
         child_transaction_data = nullptr;
       }
@@ -1486,20 +1712,49 @@ void Tablet::UpdateQLIndexes(std::unique_ptr<WriteOperation> operation) {
       shared_ptr<client::YBqlWriteOp> index_op(index_table->NewQLWrite());
       index_op->mutable_request()->Swap(&pair.second);
       index_op->mutable_request()->MergeFrom(pair.second);
-      status = session->Apply(index_op);
-      if (!status.ok()) {
-        WriteOperation::StartSynchronization(std::move(operation), status);
-        return;
-      }
       index_ops.emplace_back(std::move(index_op), write_op);
+      has_unique_index = has_unique_index || pair.first->is_unique();
     }
   }
 
-  if (!session) {
+  if (!has_index_requests) {
     CompleteQLWriteBatch(std::move(operation), Status::OK());
     return;
   }
 
+  // Updates of non-transactional indexes do not depend on this write batch, so they are written
+  // together with updates of concurrent write batches. Unless unique index could reject the write,
+  // they could even be written asynchronously.
+  if (!txn && QLIndexWriteBatcher::Enabled()) {
+    std::vector<client::YBqlWriteOpPtr> ops;
+    ops.reserve(index_ops.size());
+    for (const auto& pair : index_ops) {
+      ops.push_back(pair.first);
+    }
+    if (!has_unique_index && ql_index_write_batcher_->TryWriteAsync(ops)) {
+      CompleteQLWriteBatch(std::move(operation), Status::OK());
+      return;
+    }
+    auto* op = operation.release();
+    ql_index_write_batcher_->Write(
+        std::move(ops), [this, op, index_ops = std::move(index_ops)](const Status& status) {
+          UpdateQLIndexesFlushed(op, nullptr /* session */, nullptr /* txn */, index_ops, status);
+        });
+    return;
+  }
+
+  auto session = std::make_shared<YBSession>(client_future_.get());
+  if (txn) {
+    session->SetTransaction(txn);
+  }
+  for (const auto& pair : index_ops) {
+    auto status = session->Apply(pair.first);
+    if (!status.ok()) {
+      WriteOperation::StartSynchronization(std::move(operation), status);
+      return;
+    }
+  }
+
   session->FlushAsync(std::bind(
       &Tablet::UpdateQLIndexesFlushed, this, operation.release(), session, txn,
       std::move(index_ops), _1));
@@ -1513,7 +1768,8 @@ void Tablet::UpdateQLIndexesFlushed(
   if (PREDICT_FALSE(!status.ok())) {
     // When any error occurs during the dispatching of YBOperation, YBSession saves the error and
     // returns IOError. When it happens, retrieves the errors and discard the IOError.
-    if (status.IsIOError()) {
+    // Batched index updates are flushed without own session, their errors are already retrieved.
+    if (status.IsIOError() && session) {
       for (const auto& error : session->GetPendingErrors()) {
         // return just the first error seen.
         operation->state()->CompleteWithStatus(error->status());
@@ -1564,6 +1820,7 @@ Status Tablet::HandlePgsqlReadRequest(
     PgsqlReadRequestResult* result) {
   ScopedRWOperation scoped_read_operation(&pending_op_counter_, deadline);
   RETURN_NOT_OK(scoped_read_operation);
+  MarkAccessed();
   // TODO(neil) Work on metrics for PGSQL.
   // ScopedTabletMetricsTracker metrics_tracker(metrics_->pgsql_read_latency);
 
@@ -1863,8 +2120,50 @@ Status Tablet::WaitForFlush() {
   return Status::OK();
 }
 
+Status Tablet::Hibernate() {
+  ScopedRWOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+
+  if (hibernated_.exchange(true, std::memory_order_acq_rel)) {
+    return Status::OK();
+  }
+
+  // Flush job opens table reader to verify the new file, so wait for it before releasing readers.
+  RETURN_NOT_OK(Flush(FlushMode::kSync));
+
+  size_t released_readers = 0;
+  for (auto* db : {regular_db_.get(), intents_db_.get()}) {
+    if (db) {
+      released_readers += db->ReleaseTableReaders();
+    }
+  }
+  LOG_WITH_PREFIX(INFO) << "Hibernated, released " << released_readers << " table readers";
+
+  return Status::OK();
+}
+
+void Tablet::MarkAccessed() {
+  const auto now = CoarseMonoClock::now();
+  // Don't write shared cache line on each operation, approximate time is enough.
+  if (now - last_access_time_.load(std::memory_order_relaxed) > 1s) {
+    last_access_time_.store(now, std::memory_order_relaxed);
+  }
+  if (PREDICT_FALSE(hibernated_.load(std::memory_order_relaxed)) &&
+      hibernated_.exchange(false, std::memory_order_acq_rel)) {
+    LOG_WITH_PREFIX(INFO) << "Leaving hibernation";
+  }
+}
+
 Status Tablet::ImportData(const std::string& source_dir) {
+  // Keep RocksDB open while files are linked into it, the tablet could be shut down concurrently.
+  ScopedRWOperation scoped_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_operation);
+
   // We import only regular records, so don't have to deal with intents here.
+  shared_write_batch_cache_.Clear();
+  if (row_cache_) {
+    row_cache_->Clear(clock_->Now());
+  }
   return regular_db_->Import(source_dir);
 }
 
@@ -1889,6 +2188,12 @@ Status Tablet::ApplyIntents(const TransactionApplyData& data) {
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
   WriteToRocksDB(&frontiers, &regular_write_batch, StorageDbType::kRegular);
+  // Transactions are expected to be rare in workloads that benefit from the shared cache, so do not
+  // bother decoding the applied keys.
+  shared_write_batch_cache_.Clear();
+  if (row_cache_) {
+    row_cache_->Clear(data.commit_ht);
+  }
   return Status::OK();
 }
 
@@ -1898,11 +2203,9 @@ CHECKED_STATUS Tablet::RemoveIntentsImpl(const RemoveIntentsData& data, const Id
   RETURN_NOT_OK(scoped_read_operation);
 
   rocksdb::WriteBatch intents_write_batch;
-  for (const auto& id : ids) {
-    RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-        id, HybridTime() /* commit_ht */, &key_bounds_, nullptr /* regular_write_batch */,
-        intents_db_.get(), &intents_write_batch));
-  }
+  RETURN_NOT_OK(docdb::PrepareRemoveIntentsBatch(
+      std::vector<TransactionId>(ids.begin(), ids.end()), intents_db_.get(),
+      &intents_write_batch));
 
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
@@ -1968,7 +2271,17 @@ Status Tablet::AddTable(const TableInfoPB& table_info) {
   return Status::OK();
 }
 
-Status Tablet::RemoveTable(const std::string& table_id) {
+Status Tablet::RemoveTable(const std::string& table_id, const OperationState& operation_state) {
+  auto table_info = metadata_->GetTableInfo(table_id);
+  // Table could be already removed, when operation is replayed during bootstrap.
+  if (table_info.ok() && metadata_->colocated() && (*table_info)->schema.has_pgtable_id()) {
+    docdb::KeyValueWriteBatchPB write_batch;
+    auto* pair = write_batch.add_write_pairs();
+    pair->set_key(docdb::DocKey((*table_info)->schema.pgtable_id()).Encode().ToStringBuffer());
+    pair->set_value(docdb::Value(docdb::PrimitiveValue::kTombstone).Encode());
+    RETURN_NOT_OK(ApplyOperationState(operation_state, -1 /* batch_idx */, write_batch));
+  }
+
   metadata_->RemoveTable(table_id);
   RETURN_NOT_OK(metadata_->Flush());
   return Status::OK();
@@ -2294,9 +2607,11 @@ Status Tablet::FlushIndexBatchIfRequired(
                     (!ops_by_primary_key.empty() ? ops_by_primary_key.size()
                                                  : write_ops.size()));
   constexpr int kMaxNumRetries = 10;
+  const auto flush_start = CoarseMonoClock::Now();
   RETURN_NOT_OK(FlushWithRetries(session, write_ops, kMaxNumRetries));
 
   auto now = CoarseMonoClock::Now();
+  ThrottleBackfill(now - flush_start);
   if (FLAGS_backfill_index_rate_rows_per_sec > 0) {
     auto duration_since_last_batch = MonoDelta(now - last_backfill_flush_at_);
     auto expected_duration_ms = MonoDelta::FromMilliseconds(
@@ -2314,6 +2629,29 @@ Status Tablet::FlushIndexBatchIfRequired(
   return Status::OK();
 }
 
+void Tablet::ThrottleBackfill(CoarseDuration write_latency) {
+  if (FLAGS_backfill_index_target_write_latency_ms <= 0) {
+    backfill_throttle_delay_ = CoarseDuration::zero();
+    return;
+  }
+
+  // Double the delay while index writes are slower than the target, and halve it otherwise, so
+  // backfill quickly backs off under foreground load and speeds up again when the load is gone.
+  const CoarseDuration target = FLAGS_backfill_index_target_write_latency_ms * 1ms;
+  if (write_latency > target) {
+    const CoarseDuration max_delay = FLAGS_backfill_index_max_throttle_delay_ms * 1ms;
+    backfill_throttle_delay_ = std::min(
+        std::max(backfill_throttle_delay_ * 2, write_latency - target), max_delay);
+  } else {
+    backfill_throttle_delay_ /= 2;
+  }
+  if (backfill_throttle_delay_ > CoarseDuration::zero()) {
+    DVLOG(3) << "Index write latency " << MonoDelta(write_latency)
+             << " sleeping for " << MonoDelta(backfill_throttle_delay_);
+    SleepFor(MonoDelta(backfill_throttle_delay_));
+  }
+}
+
 Status Tablet::FlushWithRetries(
     shared_ptr<YBSession> session,
     const std::vector<shared_ptr<client::YBqlWriteOp>> &write_ops,
@@ -2609,6 +2947,22 @@ Result<HybridTime> Tablet::OldestMutableMemtableWriteHybridTime() const {
   return result;
 }
 
+Result<size_t> Tablet::MutableMemtablesSize() const {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  size_t result = 0;
+  for (auto* db : { regular_db_.get(), intents_db_.get() }) {
+    if (db) {
+      uint64_t size = 0;
+      if (db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &size)) {
+        result += size;
+      }
+    }
+  }
+  return result;
+}
+
 Status Tablet::DebugDump(vector<string> *lines) {
   switch (table_type_) {
     case TableType::PGSQL_TABLE_TYPE: FALLTHROUGH_INTENDED;
@@ -2810,12 +3164,18 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
     InitMarkerBehavior init_marker_behavior = tablet_.table_type() == TableType::REDIS_TABLE_TYPE
         ? InitMarkerBehavior::kRequired
         : InitMarkerBehavior::kOptional;
+    // Transactional operations could read their own provisional records, so they don't share
+    // what they read with other operations.
+    auto* shared_write_batch_cache =
+        isolation_level_ == IsolationLevel::NON_TRANSACTIONAL &&
+        FLAGS_docdb_shared_write_batch_cache_max_entries > 0
+            ? tablet_.shared_write_batch_cache() : nullptr;
     for (;;) {
       RETURN_NOT_OK(docdb::ExecuteDocWriteOperation(
           operation_->doc_ops(), operation_->deadline(), real_read_time, tablet_.doc_db(),
           operation_->request()->mutable_write_batch(), init_marker_behavior,
           tablet_.monotonic_counter(), &restart_read_ht,
-          tablet_.metadata()->table_name()));
+          tablet_.metadata()->table_name(), shared_write_batch_cache));
 
       // For serializable isolation we don't fix read time, so could do read restart locally,
       // instead of failing whole transaction.
@@ -2833,6 +3193,8 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
       restart_read_ht = HybridTime();
 
       operation_->request()->mutable_write_batch()->clear_write_pairs();
+      operation_->request()->mutable_write_batch()->clear_encoded_write_pairs();
+      operation_->request()->mutable_write_batch()->clear_encoded_write_pairs_count();
 
       for (auto& doc_op : operation_->doc_ops()) {
         doc_op->ClearResponse();
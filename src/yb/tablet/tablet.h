@@ -56,6 +56,7 @@
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/doc_operation.h"
+#include "yb/docdb/doc_row_cache.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/shared_lock_manager.h"
 
@@ -68,6 +69,7 @@
 #include "yb/tablet/abstract_tablet.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/mvcc.h"
+#include "yb/tablet/ql_index_write_batcher.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -224,6 +226,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const std::vector<std::shared_ptr<client::YBqlWriteOp>>& write_ops,
       int num_retries);
 
+  // Sleeps before the next backfill batch if writes of the last batch to the index took longer
+  // than --backfill_index_target_write_latency_ms.
+  void ThrottleBackfill(CoarseDuration write_latency);
+
   // Mark that the tablet has finished bootstrapping.
   // This transitions from kBootstrapping to kOpen state.
   void MarkFinishedBootstrapping();
@@ -295,6 +301,19 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       rocksdb::WriteBatch* write_batch,
       docdb::StorageDbType storage_db_type);
 
+  // Starts combining non transactional writes of applied operations into a single RocksDB write
+  // batch, bounded by follower_apply_batch_max_size_bytes. Marking such operations as replicated in
+  // MVCC is deferred until the batch is written. Only the thread that applies operations could
+  // use the apply batch.
+  void StartApplyBatch();
+
+  // Writes the combined batch and marks its operations as replicated.
+  void FinishApplyBatch();
+
+  // Marks operation with the specified hybrid time as replicated in MVCC, or defers it until the
+  // current apply batch is written.
+  void ApplyReplicated(HybridTime hybrid_time);
+
   //------------------------------------------------------------------------------------------------
   // Redis Request Processing.
   // Takes a Redis WriteRequestPB as input with its redis_write_batch.
@@ -366,6 +385,20 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS WaitForFlush();
 
+  // Releases memory used by an idle tablet: memtables are flushed and table readers of SST files
+  // are closed, so their index and filter blocks could be evicted from block cache. Readers are
+  // reopened on demand, and the tablet leaves hibernation on the next read or write.
+  CHECKED_STATUS Hibernate();
+
+  bool hibernated() const {
+    return hibernated_.load(std::memory_order_acquire);
+  }
+
+  // Approximate time of the last read or write of this tablet.
+  CoarseTimePoint last_access_time() const {
+    return last_access_time_.load(std::memory_order_relaxed);
+  }
+
   // Prepares the transaction context for the alter schema operation.
   // An error will be returned if the specified schema is invalid (e.g.
   // key mismatch, or missing IDs)
@@ -386,8 +419,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Apply replicated add table operation.
   CHECKED_STATUS AddTable(const TableInfoPB& table_info);
 
-  // Apply replicated remove table operation.
-  CHECKED_STATUS RemoveTable(const std::string& table_id);
+  // Apply replicated remove table operation. Data of removed colocated YSQL table is deleted with
+  // a table tombstone, so it is removed by compactions.
+  CHECKED_STATUS RemoveTable(const std::string& table_id, const OperationState& operation_state);
 
   // Truncate this tablet by resetting the content of RocksDB.
   CHECKED_STATUS Truncate(TruncateOperationState* state);
@@ -412,6 +446,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::atomic<int64_t>* monotonic_counter() { return &monotonic_counter_; }
 
+  docdb::SharedDocWriteBatchCache* shared_write_batch_cache() {
+    return &shared_write_batch_cache_;
+  }
+
   // Set the conter to at least 'value'.
   void UpdateMonotonicCounter(int64_t value);
 
@@ -450,6 +488,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // is empty.
   Result<HybridTime> OldestMutableMemtableWriteHybridTime() const;
 
+  // Returns approximate total size of mutable memtables in RocksDB.
+  Result<size_t> MutableMemtablesSize() const;
+
   // For non-kudu table type fills key-value batch in transaction state request and updates
   // request in state. Due to acquiring locks it can block the thread.
   void AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation> operation);
@@ -475,6 +516,12 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     return yb::SchemaPtr(table_info, &table_info->schema);
   }
 
+  // Projections are cached in table info, so they are not created for every read.
+  Result<yb::SchemaPtr> GetProjection(
+      const std::vector<ColumnId>& column_ids, const std::string& table_id = "") const override {
+    return VERIFY_RESULT(metadata_->GetTableInfo(table_id))->GetProjection(column_ids);
+  }
+
   Schema GetKeySchema(const std::string& table_id = "") const {
     if (table_id.empty()) {
       return key_schema_;
@@ -507,7 +554,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void ForceRocksDBCompactInTest();
 
-  docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
+  docdb::DocDB doc_db() const {
+    return { regular_db_.get(), intents_db_.get(), &key_bounds_, row_cache_.get() };
+  }
 
   // Returns approximate middle key for tablet split:
   // - for hash-based partitions: encoded hash code in order to split by hash code.
@@ -594,6 +643,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void SetCleanupPool(ThreadPool* thread_pool);
 
+  // Schedules compaction of a tablet created by split, that was not compacted yet, to drop keys
+  // that are out of its key bounds.
+  void TriggerPostSplitCompactionIfNeeded();
+
   TabletSnapshots& snapshots() {
     return *snapshots_;
   }
@@ -777,6 +830,29 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // restarts and leader changes.
   std::atomic<int64_t> monotonic_counter_{0};
 
+  // See Hibernate and MarkAccessed.
+  std::atomic<CoarseTimePoint> last_access_time_{CoarseMonoClock::now()};
+  std::atomic<bool> hibernated_{false};
+
+  // Key prefixes read from the regular DB by non-transactional write operations, reused by later
+  // write operations. Invalidated when writes are applied to the regular DB.
+  docdb::SharedDocWriteBatchCache shared_write_batch_cache_;
+
+  // Rows read by point reads, served to later reads of the same rows. Invalidated when writes are
+  // applied to the regular DB. Null when the row cache is disabled.
+  std::unique_ptr<docdb::DocRowCache> row_cache_;
+
+  // Non transactional writes of several applied operations, see StartApplyBatch.
+  struct ApplyBatch {
+    bool active = false;
+    rocksdb::WriteBatch write_batch;
+    std::unique_ptr<rocksdb::UserFrontiers> frontiers;
+    // Hybrid times of operations that should be marked as replicated after the batch is written.
+    std::vector<HybridTime> replicated;
+  };
+
+  ApplyBatch apply_batch_;
+
   // Number of pending operations. We use this to make sure we don't shut down RocksDB before all
   // pending operations are finished. We don't have a strict definition of an "operation" for the
   // purpose of this counter. We simply wait for this counter to go to zero before shutting down
@@ -830,8 +906,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   void CleanupIntentFiles();
   void DoCleanupIntentFiles();
 
+  // Deletes SST files that are out of key bounds, and compacts the rest of regular DB.
+  void DoPostSplitCompaction();
+
   void RegularDbFilesChanged();
 
+  // Updates last access time and leaves hibernation, called for each read and write.
+  void MarkAccessed();
+
   HybridTime ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadline) override;
 
   void MinRunningHybridTimeSatisfied() override {
@@ -850,8 +932,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   IsSysCatalogTablet is_sys_catalog_;
   TransactionsEnabled txns_enabled_;
   CoarseTimePoint last_backfill_flush_at_;
+  // Extra delay between backfill batches, adjusted by the latency of index writes.
+  CoarseDuration backfill_throttle_delay_ = CoarseDuration::zero();
 
   std::unique_ptr<ThreadPoolToken> cleanup_intent_files_token_;
+  std::unique_ptr<ThreadPoolToken> post_split_compaction_token_;
 
   std::unique_ptr<TabletSnapshots> snapshots_;
 
@@ -867,6 +952,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::shared_ptr<TabletRetentionPolicy> retention_policy_;
 
+  // Writes updates of non-transactional secondary indexes of concurrent write batches.
+  std::shared_ptr<QLIndexWriteBatcher> ql_index_write_batcher_;
+
   DISALLOW_COPY_AND_ASSIGN(Tablet);
 };
 
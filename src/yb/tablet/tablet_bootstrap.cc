@@ -31,11 +31,14 @@
 //
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <future>
+
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_sync_group.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/retryable_requests.h"
 
@@ -90,6 +93,12 @@ DEFINE_bool(skip_flushed_entries, true,
             "Only replay WAL entries that are not flushed to RocksDB or within the retryable "
             "request timeout.");
 
+DEFINE_bool(bootstrap_read_ahead_log_segment, true,
+            "Read and decode the next WAL segment in background while entries of the current "
+            "segment are replayed during tablet bootstrap.");
+TAG_FLAG(bootstrap_read_ahead_log_segment, advanced);
+TAG_FLAG(bootstrap_read_ahead_log_segment, runtime);
+
 DECLARE_int32(retryable_request_timeout_secs);
 
 DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
@@ -421,6 +430,7 @@ class TabletBootstrap {
         listener_(data.listener),
         append_pool_(data.append_pool),
         allocation_pool_(data.allocation_pool),
+        log_sync_groups_(data.log_sync_groups),
       skip_wal_rewrite_(FLAGS_skip_wal_rewrite) ,
         test_hooks_(data.test_hooks) {
   }
@@ -701,6 +711,9 @@ class TabletBootstrap {
     const auto& metadata = *tablet_->metadata();
     log_options.retention_secs = metadata.wal_retention_secs();
     log_options.env = GetEnv();
+    if (log_sync_groups_ && !metadata.wal_root_dir().empty()) {
+      log_options.sync_group = log_sync_groups_->Get(metadata.wal_root_dir());
+    }
     if (tablet_->metadata()->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE) {
       auto log_segment_size = FLAGS_transaction_status_tablet_log_segment_size_bytes;
       if (log_segment_size) {
@@ -1203,10 +1216,25 @@ class TabletBootstrap {
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
+
+    // Reading and decoding of the next segment is pipelined with replay of the current one, so
+    // at most two segments are kept in memory.
+    std::future<log::ReadEntriesResult> next_read_result;
+    auto start_read = [&next_read_result](const scoped_refptr<ReadableLogSegment>& segment) {
+      next_read_result = std::async(
+          FLAGS_bootstrap_read_ahead_log_segment ? std::launch::async : std::launch::deferred,
+          [segment] { return segment->ReadEntries(); });
+    };
+    if (iter != segments.end()) {
+      start_read(*iter);
+    }
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      auto read_result = next_read_result.get();
+      if (iter + 1 != segments.end()) {
+        start_read(*(iter + 1));
+      }
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
@@ -1563,6 +1591,8 @@ class TabletBootstrap {
 
   ThreadPool* allocation_pool_;
 
+  log::LogSyncGroups* log_sync_groups_;
+
   // Statistics on the replay of entries in the log.
   struct Stats {
     std::string ToString() const;
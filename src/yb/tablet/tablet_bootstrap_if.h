@@ -63,6 +63,7 @@ class PartitionSchema;
 namespace log {
 class Log;
 class LogAnchorRegistry;
+class LogSyncGroups;
 }
 
 namespace consensus {
@@ -164,6 +165,9 @@ struct BootstrapTabletData {
   TabletStatusListener* listener = nullptr;
   ThreadPool* append_pool = nullptr;
   ThreadPool* allocation_pool = nullptr;
+  // If specified, periodic syncs of the tablet log are combined with syncs of other logs on the
+  // same disk.
+  log::LogSyncGroups* log_sync_groups = nullptr;
   consensus::RetryableRequests* retryable_requests = nullptr;
 
   std::shared_ptr<TabletBootstrapTestHooksIf> test_hooks = nullptr;
@@ -70,6 +70,11 @@ TAG_FLAG(enable_tablet_orphaned_block_deletion, advanced);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, hidden);
 TAG_FLAG(enable_tablet_orphaned_block_deletion, runtime);
 
+DEFINE_int32(max_cached_projections_per_table, 32,
+             "Maximum number of distinct column projections of a table schema cached for reads.");
+TAG_FLAG(max_cached_projections_per_table, advanced);
+TAG_FLAG(max_cached_projections_per_table, runtime);
+
 using std::shared_ptr;
 
 using base::subtle::Barrier_AtomicIncrement;
@@ -124,6 +129,26 @@ TableInfo::TableInfo(const TableInfo& other,
   this->deleted_cols.insert(this->deleted_cols.end(), deleted_cols.begin(), deleted_cols.end());
 }
 
+Result<SchemaPtr> TableInfo::GetProjection(const std::vector<ColumnId>& column_ids) const {
+  {
+    std::lock_guard<std::mutex> lock(projections_mutex_);
+    auto it = projections_.find(column_ids);
+    if (it != projections_.end()) {
+      return it->second;
+    }
+  }
+
+  auto projection = std::make_shared<Schema>();
+  RETURN_NOT_OK(schema.CreateProjectionByIdsIgnoreMissing(column_ids, projection.get()));
+
+  std::lock_guard<std::mutex> lock(projections_mutex_);
+  if (projections_.size() <
+          static_cast<size_t>(std::max(FLAGS_max_cached_projections_per_table, 0))) {
+    return projections_.emplace(column_ids, std::move(projection)).first->second;
+  }
+  return projection;
+}
+
 Status TableInfo::LoadFromPB(const TableInfoPB& pb) {
   table_id = pb.table_id();
   table_name = pb.table_name();
@@ -32,7 +32,9 @@
 #ifndef YB_TABLET_TABLET_METADATA_H
 #define YB_TABLET_TABLET_METADATA_H
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -115,6 +117,15 @@ struct TableInfo {
     ToPB(&pb);
     return pb.ShortDebugString();
   }
+
+  // Returns projection of schema to the given columns, ignoring missing ones. Projections are
+  // reused by reads with the same columns. TableInfo is replaced when schema changes, so they
+  // always belong to schema_version.
+  Result<SchemaPtr> GetProjection(const std::vector<ColumnId>& column_ids) const;
+
+ private:
+  mutable std::mutex projections_mutex_;
+  mutable std::map<std::vector<ColumnId>, SchemaPtr> projections_;
 };
 
 // Describes KV-store. Single KV-store is backed by one or two RocksDB instances, depending on
@@ -29,6 +29,7 @@ namespace rocksdb {
 class Cache;
 class EventListener;
 class MemoryMonitor;
+class PersistentCache;
 class Env;
 }
 
@@ -49,6 +50,12 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Optional separate cache for index and filter blocks.
+  std::shared_ptr<rocksdb::Cache> index_and_filter_block_cache;
+  // Optional second tier of the block cache, located on a fast local device.
+  std::shared_ptr<rocksdb::PersistentCache> persistent_cache;
+  // Optional cache of table readers shared across tablets, limits the number of open SST files.
+  std::shared_ptr<rocksdb::Cache> table_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
@@ -188,7 +188,8 @@ Status TabletPeer::InitTabletPeer(
     ThreadPool* raft_pool,
     ThreadPool* tablet_prepare_pool,
     consensus::RetryableRequests* retryable_requests,
-    const yb::OpId& split_op_id) {
+    const yb::OpId& split_op_id,
+    consensus::MultiRaftManager* multi_raft_manager) {
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
 
@@ -238,6 +239,7 @@ Status TabletPeer::InitTabletPeer(
     });
 
     tablet_->SetCleanupPool(raft_pool);
+    tablet_->TriggerPostSplitCompactionIfNeeded();
 
     ConsensusOptions options;
     options.tablet_id = meta_->raft_group_id();
@@ -268,7 +270,8 @@ Status TabletPeer::InitTabletPeer(
         tablet_->table_type(),
         raft_pool,
         retryable_requests,
-        split_op_id);
+        split_op_id,
+        multi_raft_manager);
     has_consensus_.store(true, std::memory_order_release);
 
     tablet_->SetHybridTimeLeaseProvider(std::bind(&TabletPeer::HybridTimeLease, this, _1, _2));
@@ -1052,6 +1055,14 @@ bool TabletPeer::ShouldApplyWrite() {
   return tablet_->ShouldApplyWrite();
 }
 
+void TabletPeer::StartApplyBatch() {
+  tablet_->StartApplyBatch();
+}
+
+void TabletPeer::FinishApplyBatch() {
+  tablet_->FinishApplyBatch();
+}
+
 consensus::Consensus* TabletPeer::consensus() const {
   return raft_consensus();
 }
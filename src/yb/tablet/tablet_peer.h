@@ -165,7 +165,8 @@ class TabletPeer : public consensus::ConsensusContext,
       ThreadPool* raft_pool,
       ThreadPool* tablet_prepare_pool,
       consensus::RetryableRequests* retryable_requests,
-      const yb::OpId& split_op_id);
+      const yb::OpId& split_op_id,
+      consensus::MultiRaftManager* multi_raft_manager = nullptr);
 
   // Starts the TabletPeer, making it available for Write()s. If this
   // TabletPeer is part of a consensus configuration this will connect it to other peers
@@ -228,6 +229,10 @@ class TabletPeer : public consensus::ConsensusContext,
   // Returns false if it is preferable to don't apply write operation.
   bool ShouldApplyWrite() override;
 
+  void StartApplyBatch() override;
+
+  void FinishApplyBatch() override;
+
   consensus::Consensus* consensus() const;
   consensus::RaftConsensus* raft_consensus() const;
 
@@ -130,7 +130,14 @@ HybridTime TabletRetentionPolicy::HistoryCutoffToPropagate(HybridTime last_write
 }
 
 HybridTime TabletRetentionPolicy::EffectiveHistoryCutoff() {
-  auto retention_delta = -FLAGS_timestamp_history_retention_interval_sec * 1s;
+  // Tables with frequent overwrites could be configured to retain less history than the default,
+  // so scans don't have to skip obsolete versions until they are garbage-collected.
+  const auto schema = metadata_.schema();
+  const auto& table_properties = schema->table_properties();
+  const auto retention_interval_sec = table_properties.HasHistoryRetentionInterval()
+      ? table_properties.history_retention_interval_sec()
+      : FLAGS_timestamp_history_retention_interval_sec;
+  auto retention_delta = -retention_interval_sec * 1s;
   // We try to garbage-collect history older than current time minus the configured retention
   // interval, but we might not be able to do so if there are still read operations reading at an
   // older snapshot.
@@ -23,7 +23,8 @@ namespace yb {
 namespace tablet {
 
 // History retention policy used by a tablet. It is based on pending reads and a fixed retention
-// interval configured by the user.
+// interval configured by the user, globally or in the history_retention_interval_sec property of
+// the table.
 class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
  public:
   explicit TabletRetentionPolicy(server::ClockPtr clock, const RaftGroupMetadata* metadata);
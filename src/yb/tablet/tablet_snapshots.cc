@@ -297,7 +297,8 @@ Status TabletSnapshots::Delete(SnapshotOperationState* tx_state) {
 }
 
 Status TabletSnapshots::CreateCheckpoint(
-    const std::string& dir, const CreateIntentsCheckpointIn create_intents_checkpoint_in) {
+    const std::string& dir, const CreateIntentsCheckpointIn create_intents_checkpoint_in,
+    FlushBeforeCheckpoint flush) {
   ScopedRWOperation scoped_read_operation(&pending_op_counter());
   RETURN_NOT_OK(scoped_read_operation);
 
@@ -316,13 +317,15 @@ Status TabletSnapshots::CreateCheckpoint(
   RETURN_NOT_OK_PREPEND(metadata().fs_manager()->CreateDirIfMissing(parent_dir),
                         Format("Unable to create checkpoints directory $0", parent_dir));
 
-  // Order does not matter because we flush both DBs and does not have parallel writes.
+  // Order does not matter when we flush both DBs, because there are no parallel writes.
+  // Otherwise intents DB checkpoint should be created first, so regular DB checkpoint is not
+  // older than it. It is the same invariant that is kept by flushes of intents DB.
   Status status;
   if (has_intents_db()) {
-    status = rocksdb::checkpoint::CreateCheckpoint(&intents_db(), temp_intents_dir);
+    status = rocksdb::checkpoint::CreateCheckpoint(&intents_db(), temp_intents_dir, flush.get());
   }
   if (status.ok()) {
-    status = rocksdb::checkpoint::CreateCheckpoint(&regular_db(), dir);
+    status = rocksdb::checkpoint::CreateCheckpoint(&regular_db(), dir, flush.get());
   }
   if (status.ok() && has_intents_db() &&
       create_intents_checkpoint_in == CreateIntentsCheckpointIn::kUseIntentsDbSuffix) {
@@ -20,6 +20,7 @@
 #include "yb/docdb/docdb_fwd.h"
 
 #include "yb/util/status.h"
+#include "yb/util/strongly_typed_bool.h"
 
 namespace rocksdb {
 
@@ -35,6 +36,7 @@ class rw_semaphore;
 namespace tablet {
 
 YB_DEFINE_ENUM(CreateIntentsCheckpointIn, (kSubDir)(kUseIntentsDbSuffix));
+YB_STRONGLY_TYPED_BOOL(FlushBeforeCheckpoint);
 
 class TabletSnapshots : public TabletComponent {
  public:
@@ -58,10 +60,13 @@ class TabletSnapshots : public TabletComponent {
   // YQL_TABLE_TYPE.
   // use_subdir_for_intents specifies whether to create intents DB checkpoint inside
   // <dir>/<kIntentsSubdir> or <dir>.<kIntentsDBSuffix>
+  // Without flush, the checkpoint contains only data flushed so far. So the operations after its
+  // flushed frontier should be replayed from the Raft log, like after a crash.
   CHECKED_STATUS CreateCheckpoint(
       const std::string& dir,
       CreateIntentsCheckpointIn create_intents_checkpoint_in =
-          CreateIntentsCheckpointIn::kUseIntentsDbSuffix);
+          CreateIntentsCheckpointIn::kUseIntentsDbSuffix,
+      FlushBeforeCheckpoint flush = FlushBeforeCheckpoint::kTrue);
 
   // Returns the location of the last rocksdb checkpoint. Used for tests only.
   std::string TEST_LastRocksDBCheckpointDir() { return TEST_last_rocksdb_checkpoint_dir_; }
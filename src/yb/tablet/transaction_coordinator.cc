@@ -67,6 +67,15 @@ DEFINE_double(transaction_max_missed_heartbeat_periods, 10.0 * yb::kTimeMultipli
               "microseconds is transaction_heartbeat_usec times "
               "transaction_max_missed_heartbeat_periods. The value passed to this flag may be "
               "fractional.");
+DEFINE_double(transaction_min_heartbeat_replication_periods, 0.0,
+              "Heartbeat of a pending transaction is replicated only when at least this number of "
+              "heartbeat periods passed since the last replicated update of this transaction. "
+              "Otherwise the heartbeat is acknowledged without a Raft write to the status tablet. "
+              "Heartbeats are always replicated when half of the transaction timeout passed. "
+              "0 means that every heartbeat is replicated.");
+TAG_FLAG(transaction_min_heartbeat_replication_periods, advanced);
+TAG_FLAG(transaction_min_heartbeat_replication_periods, runtime);
+
 DEFINE_uint64(transaction_check_interval_usec, 500000, "Transaction check interval in usec.");
 DEFINE_uint64(transaction_resend_applying_interval_usec, 5000000,
               "Transaction resend applying interval in usec.");
@@ -540,6 +549,10 @@ class TransactionState {
         status = STATUS_FORMAT(IllegalState,
             "Transaction in wrong state during heartbeat: $0",
             TransactionStatus_Name(status_));
+      } else if (!HeartbeatReplicationRequired()) {
+        VLOG_WITH_PREFIX(4) << "Heartbeat acknowledged without replication";
+        context_.CompleteWithStatus(std::move(request), Status::OK());
+        return;
       } else {
         status = Status::OK();
       }
@@ -558,6 +571,23 @@ class TransactionState {
     CHECK(submitted);
   }
 
+  // Whether heartbeat should be replicated, or it is enough that this transaction was touched
+  // recently. In the latter case last touch stays as is, so the transaction is still expired in
+  // time if heartbeats stop.
+  bool HeartbeatReplicationRequired() const {
+    const double min_periods =
+        GetAtomicFlag(&FLAGS_transaction_min_heartbeat_replication_periods);
+    if (min_periods <= 0) {
+      return true;
+    }
+    const double interval = std::min<double>(
+        min_periods * GetAtomicFlag(&FLAGS_transaction_heartbeat_usec),
+        GetTransactionTimeout().count() / 2.0);
+    const auto passed = context_.coordinator_context().clock().Now().GetPhysicalValueMicros() -
+                        last_touch_.GetPhysicalValueMicros();
+    return passed >= interval;
+  }
+
   CHECKED_STATUS HandleCommit() {
     auto hybrid_time = context_.coordinator_context().clock().Now();
     if (ExpiredAt(hybrid_time)) {
@@ -1031,6 +1061,12 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     return managed_transactions_.size();
   }
 
+  HybridTime test_last_touch(const TransactionId& transaction_id) {
+    std::lock_guard<std::mutex> lock(managed_mutex_);
+    auto it = managed_transactions_.find(transaction_id);
+    return it != managed_transactions_.end() ? it->last_touch() : HybridTime::kInvalid;
+  }
+
   CHECKED_STATUS ProcessReplicated(const ReplicatedData& data) {
     auto id = FullyDecodeTransactionId(data.state.transaction_id());
     if (!id.ok()) {
@@ -1387,6 +1423,10 @@ size_t TransactionCoordinator::test_count_transactions() const {
   return impl_->test_count_transactions();
 }
 
+HybridTime TransactionCoordinator::test_last_touch(const TransactionId& transaction_id) const {
+  return impl_->test_last_touch(transaction_id);
+}
+
 void TransactionCoordinator::Handle(
     std::unique_ptr<tablet::UpdateTxnOperationState> request, int64_t term) {
   impl_->Handle(std::move(request), term);
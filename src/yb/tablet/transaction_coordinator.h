@@ -147,6 +147,10 @@ class TransactionCoordinator {
   // Returns count of managed transactions. Used in tests.
   size_t test_count_transactions() const;
 
+  // Returns last touch of the managed transaction, or invalid hybrid time if this coordinator
+  // does not manage it. Used in tests.
+  HybridTime test_last_touch(const TransactionId& transaction_id) const;
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
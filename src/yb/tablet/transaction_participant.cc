@@ -298,6 +298,16 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     (**it).BatchReplicated(data);
   }
 
+  void ExpandIntentsKeyRange(const Slice& min_doc_key, const Slice& max_doc_key) {
+    std::lock_guard<simple_spinlock> lock(intents_key_range_mutex_);
+    intents_key_range_.Expand(min_doc_key, max_doc_key);
+  }
+
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) {
+    std::lock_guard<simple_spinlock> lock(intents_key_range_mutex_);
+    return intents_key_range_.Overlaps(lower_bound, upper_bound);
+  }
+
   void RequestStatusAt(const StatusRequest& request) {
     auto lock_and_iterator = LockAndFind(*request.id, *request.reason, request.flags);
     if (!lock_and_iterator.found()) {
@@ -835,6 +845,7 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     if (transactions_.empty()) {
       min_running_ht_.store(HybridTime::kMax, std::memory_order_release);
       CheckMinRunningHybridTimeSatisfiedUnlocked(min_running_notifier);
+      ResetIntentsKeyRange();
       return;
     }
 
@@ -849,6 +860,13 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     }
   }
 
+  // Invoked when there are no running transactions, so intents key range could be started from
+  // scratch.
+  void ResetIntentsKeyRange() {
+    std::lock_guard<simple_spinlock> lock(intents_key_range_mutex_);
+    intents_key_range_.Clear();
+  }
+
   void EnqueueRemoveUnlocked(
       const TransactionId& id, MinRunningNotifier* min_running_notifier) REQUIRES(mutex_) override {
     auto now = participant_context_.Now();
@@ -1366,6 +1384,13 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   std::atomic<bool> closing_{false};
   CountDownLatch start_latch_{1};
 
+  // Range of doc keys that could have strong write intents of running transactions.
+  // It is unbounded until all transactions are loaded, because intents of loaded transactions are
+  // not tracked, and is reset each time there are no running transactions.
+  simple_spinlock intents_key_range_mutex_;
+  docdb::DocKeyRange intents_key_range_ GUARDED_BY(intents_key_range_mutex_) =
+      docdb::DocKeyRange::Unbounded();
+
   std::atomic<HybridTime> min_running_ht_{HybridTime::kInvalid};
   std::atomic<CoarseTimePoint> next_check_min_running_{CoarseTimePoint()};
   HybridTime waiting_for_min_running_ht_ = HybridTime::kMax;
@@ -1409,6 +1434,16 @@ void TransactionParticipant::BatchReplicated(
   return impl_->BatchReplicated(id, data);
 }
 
+void TransactionParticipant::ExpandIntentsKeyRange(
+    const Slice& min_doc_key, const Slice& max_doc_key) {
+  impl_->ExpandIntentsKeyRange(min_doc_key, max_doc_key);
+}
+
+bool TransactionParticipant::MayHaveIntentsInRange(
+    const Slice& lower_bound, const Slice& upper_bound) const {
+  return impl_->MayHaveIntentsInRange(lower_bound, upper_bound);
+}
+
 HybridTime TransactionParticipant::LocalCommitTime(const TransactionId& id) {
   return impl_->LocalCommitTime(id);
 }
@@ -170,6 +170,13 @@ class TransactionParticipant : public TransactionStatusManager {
 
   void BatchReplicated(const TransactionId& id, const TransactionalBatchData& data);
 
+  // Extends key range that could contain strong write intents of running transactions, so it
+  // includes all doc keys in [min_doc_key, max_doc_key]. Should be invoked before intents for these
+  // keys are written to the intents DB.
+  void ExpandIntentsKeyRange(const Slice& min_doc_key, const Slice& max_doc_key);
+
+  bool MayHaveIntentsInRange(const Slice& lower_bound, const Slice& upper_bound) const override;
+
   HybridTime LocalCommitTime(const TransactionId& id) override;
 
   void RequestStatusAt(const StatusRequest& request) override;
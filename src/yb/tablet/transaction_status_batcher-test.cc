@@ -0,0 +1,358 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <deque>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/tablet/operations/update_txn_operation.h"
+#include "yb/tablet/running_transaction.h"
+#include "yb/tablet/running_transaction_context.h"
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_uint64(max_transactions_in_status_request);
+DECLARE_int32(transaction_pending_status_cache_ms);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const std::string kStatusTablet = "status_tablet";
+const std::string kOtherStatusTablet = "other_status_tablet";
+const std::string kReason = "test";
+constexpr uint64_t kNowHybridTime = 1000;
+
+class ParticipantContextMock : public TransactionParticipantContext {
+ public:
+  const std::string& permanent_uuid() const override {
+    return permanent_uuid_;
+  }
+
+  const std::string& tablet_id() const override {
+    return tablet_id_;
+  }
+
+  const std::shared_future<client::YBClient*>& client_future() const override {
+    return client_future_;
+  }
+
+  const server::ClockPtr& clock_ptr() const override {
+    return clock_;
+  }
+
+  void GetLastReplicatedData(RemoveIntentsData* data) override {}
+
+  void StrandEnqueue(rpc::StrandTask* task) override {
+    LOG(FATAL) << "Not supported";
+  }
+
+  HybridTime Now() override {
+    return HybridTime(kNowHybridTime);
+  }
+
+  void UpdateClock(HybridTime hybrid_time) override {}
+
+  bool IsLeader() override {
+    return true;
+  }
+
+  void SubmitUpdateTransaction(
+      std::unique_ptr<UpdateTxnOperationState> state, int64_t term) override {
+    LOG(FATAL) << "Not supported";
+  }
+
+  HybridTime SafeTimeForTransactionParticipant() override {
+    return HybridTime::kMax;
+  }
+
+ private:
+  const std::string permanent_uuid_ = "peer";
+  const std::string tablet_id_ = "tablet";
+  std::shared_future<client::YBClient*> client_future_;
+  server::ClockPtr clock_;
+};
+
+class IntentApplierMock : public TransactionIntentApplier {
+ public:
+  CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) override {
+    return STATUS(NotSupported, "ApplyIntents");
+  }
+
+  CHECKED_STATUS RemoveIntents(
+      const RemoveIntentsData& data, const TransactionId& transaction_id) override {
+    return STATUS(NotSupported, "RemoveIntents");
+  }
+
+  CHECKED_STATUS RemoveIntents(
+      const RemoveIntentsData& data, const TransactionIdSet& transactions) override {
+    return STATUS(NotSupported, "RemoveIntents");
+  }
+
+  HybridTime ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadline) override {
+    return HybridTime::kMax;
+  }
+
+  void MinRunningHybridTimeSatisfied() override {}
+};
+
+// Status request captured instead of sending the RPC.
+struct SentRequest {
+  tserver::GetTransactionStatusRequestPB request;
+  TransactionStatusResponseCallback callback;
+
+  std::vector<TransactionId> TransactionIds() const {
+    std::vector<TransactionId> result;
+    for (const auto& id : request.transaction_id()) {
+      result.push_back(CHECK_RESULT(FullyDecodeTransactionId(id)));
+    }
+    return result;
+  }
+};
+
+class RunningTransactionContextMock : public RunningTransactionContext {
+ public:
+  RunningTransactionContextMock(
+      TransactionParticipantContext* participant_context, TransactionIntentApplier* applier,
+      std::deque<SentRequest>* sent_requests)
+      : RunningTransactionContext(participant_context, applier) {
+    status_batcher_.TEST_SetSender(
+        [sent_requests](const tserver::GetTransactionStatusRequestPB& request,
+                        TransactionStatusResponseCallback callback) {
+          sent_requests->push_back(SentRequest{request, std::move(callback)});
+        });
+  }
+
+  bool RemoveUnlocked(
+      const TransactionId& id, const std::string& reason,
+      MinRunningNotifier* min_running_notifier) override {
+    return false;
+  }
+
+  void EnqueueRemoveUnlocked(
+      const TransactionId& id, MinRunningNotifier* min_running_notifier) override {}
+
+  const std::string& LogPrefix() const override {
+    return log_prefix_;
+  }
+
+  std::mutex& mutex() {
+    return mutex_;
+  }
+
+ private:
+  const std::string log_prefix_ = "Test: ";
+};
+
+tserver::GetTransactionStatusResponsePB MakeResponse(
+    const std::vector<std::pair<TransactionStatus, uint64_t>>& statuses) {
+  tserver::GetTransactionStatusResponsePB response;
+  for (const auto& status_and_time : statuses) {
+    response.add_status(status_and_time.first);
+    response.add_status_hybrid_time(status_and_time.second);
+  }
+  return response;
+}
+
+} // namespace
+
+class TransactionStatusBatcherTest : public YBTest {
+ protected:
+  // Requests status of the transaction, received status is appended to statuses.
+  void Request(
+      const TabletId& status_tablet, const TransactionId& transaction_id,
+      std::vector<TransactionStatus>* statuses) {
+    batcher_.Request(
+        status_tablet, transaction_id,
+        [statuses](const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+          ASSERT_OK(status);
+          ASSERT_EQ(1, response.status().size());
+          statuses->push_back(response.status(0));
+        });
+  }
+
+  SentRequest PopSentRequest() {
+    CHECK(!sent_requests_.empty());
+    auto result = std::move(sent_requests_.front());
+    sent_requests_.pop_front();
+    return result;
+  }
+
+  void SetUp() override {
+    YBTest::SetUp();
+    batcher_.TEST_SetSender(
+        [this](const tserver::GetTransactionStatusRequestPB& request,
+               TransactionStatusResponseCallback callback) {
+          sent_requests_.push_back(SentRequest{request, std::move(callback)});
+        });
+  }
+
+  ParticipantContextMock participant_context_;
+  rpc::Rpcs rpcs_;
+  TransactionStatusBatcher batcher_{&participant_context_, &rpcs_};
+  std::deque<SentRequest> sent_requests_;
+};
+
+TEST_F(TransactionStatusBatcherTest, BatchPerStatusTablet) {
+  const auto txn1 = TransactionId::GenerateRandom();
+  const auto txn2 = TransactionId::GenerateRandom();
+  const auto txn3 = TransactionId::GenerateRandom();
+  const auto txn4 = TransactionId::GenerateRandom();
+  std::vector<TransactionStatus> statuses1, statuses2, statuses3, statuses4;
+
+  // Request is sent right away when nothing is in flight for its status tablet.
+  Request(kStatusTablet, txn1, &statuses1);
+  ASSERT_EQ(1, sent_requests_.size());
+  auto first = PopSentRequest();
+  ASSERT_EQ(kStatusTablet, first.request.tablet_id());
+  ASSERT_EQ(std::vector<TransactionId>{txn1}, first.TransactionIds());
+
+  // Requests for the same status tablet wait for the request in flight, while request for another
+  // status tablet is sent.
+  Request(kStatusTablet, txn2, &statuses2);
+  Request(kStatusTablet, txn3, &statuses3);
+  Request(kOtherStatusTablet, txn4, &statuses4);
+  ASSERT_EQ(1, sent_requests_.size());
+  auto other = PopSentRequest();
+  ASSERT_EQ(kOtherStatusTablet, other.request.tablet_id());
+  ASSERT_EQ(std::vector<TransactionId>{txn4}, other.TransactionIds());
+
+  // Waiting requests are sent in a single batch, when response is received.
+  first.callback(Status::OK(), MakeResponse({{TransactionStatus::PENDING, 100}}));
+  ASSERT_EQ(std::vector<TransactionStatus>{TransactionStatus::PENDING}, statuses1);
+  ASSERT_EQ(1, sent_requests_.size());
+  auto batch = PopSentRequest();
+  ASSERT_EQ(kStatusTablet, batch.request.tablet_id());
+  ASSERT_EQ((std::vector<TransactionId>{txn2, txn3}), batch.TransactionIds());
+
+  // Each waiter receives its own status from the batch response.
+  batch.callback(Status::OK(), MakeResponse(
+      {{TransactionStatus::COMMITTED, 200}, {TransactionStatus::ABORTED, 300}}));
+  ASSERT_EQ(std::vector<TransactionStatus>{TransactionStatus::COMMITTED}, statuses2);
+  ASSERT_EQ(std::vector<TransactionStatus>{TransactionStatus::ABORTED}, statuses3);
+  ASSERT_TRUE(sent_requests_.empty());
+
+  other.callback(Status::OK(), MakeResponse({{TransactionStatus::PENDING, 400}}));
+  ASSERT_EQ(std::vector<TransactionStatus>{TransactionStatus::PENDING}, statuses4);
+  ASSERT_TRUE(sent_requests_.empty());
+}
+
+TEST_F(TransactionStatusBatcherTest, BatchLimitAndSingleStatusResponse) {
+  FLAGS_max_transactions_in_status_request = 2;
+  std::vector<TransactionId> txns;
+  std::vector<std::vector<TransactionStatus>> statuses(4);
+  for (size_t i = 0; i != statuses.size(); ++i) {
+    txns.push_back(TransactionId::GenerateRandom());
+  }
+
+  Request(kStatusTablet, txns[0], &statuses[0]);
+  auto first = PopSentRequest();
+  for (size_t i = 1; i != txns.size(); ++i) {
+    Request(kStatusTablet, txns[i], &statuses[i]);
+  }
+  ASSERT_TRUE(sent_requests_.empty());
+
+  first.callback(Status::OK(), MakeResponse({{TransactionStatus::PENDING, 100}}));
+  auto batch = PopSentRequest();
+  ASSERT_EQ((std::vector<TransactionId>{txns[1], txns[2]}), batch.TransactionIds());
+  ASSERT_TRUE(sent_requests_.empty());
+
+  // Coordinator of old version answers with status of the first transaction only, so the other
+  // one is requested again, before the transactions that were waiting.
+  batch.callback(Status::OK(), MakeResponse({{TransactionStatus::COMMITTED, 200}}));
+  ASSERT_EQ(std::vector<TransactionStatus>{TransactionStatus::COMMITTED}, statuses[1]);
+  ASSERT_TRUE(statuses[2].empty());
+  batch = PopSentRequest();
+  ASSERT_EQ((std::vector<TransactionId>{txns[2], txns[3]}), batch.TransactionIds());
+
+  batch.callback(Status::OK(), MakeResponse(
+      {{TransactionStatus::PENDING, 300}, {TransactionStatus::PENDING, 300}}));
+  ASSERT_EQ(std::vector<TransactionStatus>{TransactionStatus::PENDING}, statuses[2]);
+  ASSERT_EQ(std::vector<TransactionStatus>{TransactionStatus::PENDING}, statuses[3]);
+  ASSERT_TRUE(sent_requests_.empty());
+}
+
+TEST_F(TransactionStatusBatcherTest, RecentPendingStatus) {
+  FLAGS_transaction_pending_status_cache_ms = 60000;
+  std::deque<SentRequest> sent_requests;
+  ParticipantContextMock participant_context;
+  IntentApplierMock applier;
+  RunningTransactionContextMock context(&participant_context, &applier, &sent_requests);
+
+  TransactionMetadata metadata;
+  metadata.transaction_id = TransactionId::GenerateRandom();
+  metadata.status_tablet = kStatusTablet;
+  auto transaction = std::make_shared<RunningTransaction>(
+      metadata, TransactionalBatchData(), OneWayBitmap(), &context);
+
+  std::vector<Result<TransactionStatusResult>> results;
+  auto request_status = [&](uint64_t time, bool accept_recent_pending) {
+    StatusRequest request;
+    request.id = &metadata.transaction_id;
+    request.read_ht = HybridTime(time);
+    request.global_limit_ht = HybridTime(time);
+    request.serial_no = 0;
+    request.reason = &kReason;
+    request.callback = [&results](Result<TransactionStatusResult> result) {
+      results.push_back(std::move(result));
+    };
+    request.accept_recent_pending = accept_recent_pending;
+    std::unique_lock<std::mutex> lock(context.mutex());
+    transaction->RequestStatusAt(request, &lock);
+  };
+
+  // Nothing is known about the transaction, so its status is requested.
+  request_status(100, true);
+  ASSERT_EQ(1, sent_requests.size());
+  ASSERT_TRUE(results.empty());
+  sent_requests.front().callback(
+      Status::OK(), MakeResponse({{TransactionStatus::PENDING, 100}}));
+  sent_requests.pop_front();
+  ASSERT_EQ(1, results.size());
+  ASSERT_EQ(TransactionStatus::PENDING, ASSERT_RESULT(results.back()).status);
+
+  // Status received a moment ago is not known at a later time, but it is good enough for a
+  // resolver that accepts recent pending status.
+  request_status(200, true);
+  ASSERT_TRUE(sent_requests.empty());
+  ASSERT_EQ(2, results.size());
+  ASSERT_EQ(TransactionStatus::PENDING, ASSERT_RESULT(results.back()).status);
+
+  // Other requests for a later time still request status.
+  request_status(200, false);
+  ASSERT_EQ(1, sent_requests.size());
+  ASSERT_EQ(2, results.size());
+  sent_requests.front().callback(
+      Status::OK(), MakeResponse({{TransactionStatus::PENDING, 200}}));
+  sent_requests.pop_front();
+  ASSERT_EQ(3, results.size());
+  ASSERT_EQ(TransactionStatus::PENDING, ASSERT_RESULT(results.back()).status);
+
+  // Pending status is not reused when the cache is disabled.
+  FLAGS_transaction_pending_status_cache_ms = 0;
+  request_status(300, true);
+  ASSERT_EQ(1, sent_requests.size());
+  ASSERT_EQ(3, results.size());
+  sent_requests.front().callback(
+      Status::OK(), MakeResponse({{TransactionStatus::COMMITTED, 250}}));
+  sent_requests.pop_front();
+  ASSERT_EQ(4, results.size());
+  ASSERT_EQ(TransactionStatus::COMMITTED, ASSERT_RESULT(results.back()).status);
+}
+
+} // namespace tablet
+} // namespace yb
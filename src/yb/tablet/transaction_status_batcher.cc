@@ -0,0 +1,170 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include <gflags/gflags.h>
+
+#include "yb/client/transaction_rpc.h"
+
+DECLARE_uint64(max_transactions_in_status_request);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Extracts status of a single transaction from response for multiple transactions.
+tserver::GetTransactionStatusResponsePB ExtractResponse(
+    const tserver::GetTransactionStatusResponsePB& response, int idx) {
+  tserver::GetTransactionStatusResponsePB result;
+  if (response.has_propagated_hybrid_time()) {
+    result.set_propagated_hybrid_time(response.propagated_hybrid_time());
+  }
+  result.add_status(response.status(idx));
+  if (idx < response.status_hybrid_time().size()) {
+    result.add_status_hybrid_time(response.status_hybrid_time(idx));
+  }
+  if (idx < response.num_replicated_batches().size()) {
+    result.add_num_replicated_batches(response.num_replicated_batches(idx));
+  }
+  return result;
+}
+
+} // namespace
+
+TransactionStatusBatcher::TransactionStatusBatcher(
+    TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs)
+    : participant_context_(*participant_context), rpcs_(*rpcs) {
+}
+
+void TransactionStatusBatcher::Request(
+    const TabletId& status_tablet, const TransactionId& transaction_id,
+    TransactionStatusResponseCallback callback) {
+  std::vector<Waiter> batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& queue = queues_[status_tablet];
+    queue.waiters.push_back(Waiter{transaction_id, std::move(callback)});
+    if (queue.in_flight) {
+      return;
+    }
+    batch = NextBatchUnlocked(status_tablet, &queue);
+  }
+  Send(status_tablet, std::move(batch));
+}
+
+std::vector<TransactionStatusBatcher::Waiter> TransactionStatusBatcher::NextBatchUnlocked(
+    const TabletId& status_tablet, Queue* queue) {
+  std::vector<Waiter> result;
+  if (queue->waiters.empty()) {
+    queues_.erase(status_tablet);
+    return result;
+  }
+  auto batch_size = std::min<size_t>(
+      std::max<uint64_t>(FLAGS_max_transactions_in_status_request, 1), queue->waiters.size());
+  result.reserve(batch_size);
+  for (size_t i = 0; i != batch_size; ++i) {
+    result.push_back(std::move(queue->waiters.front()));
+    queue->waiters.pop_front();
+  }
+  queue->in_flight = true;
+  return result;
+}
+
+void TransactionStatusBatcher::Send(const TabletId& status_tablet, std::vector<Waiter> batch) {
+  tserver::GetTransactionStatusRequestPB req;
+  req.set_tablet_id(status_tablet);
+  req.set_propagated_hybrid_time(participant_context_.Now().ToUint64());
+  for (const auto& waiter : batch) {
+    req.add_transaction_id()->assign(
+        pointer_cast<const char*>(waiter.transaction_id.data()), waiter.transaction_id.size());
+  }
+
+  if (test_sender_) {
+    auto shared_batch = std::make_shared<std::vector<Waiter>>(std::move(batch));
+    test_sender_(req, [this, status_tablet, shared_batch](
+        const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+      Received(status_tablet, shared_batch.get(), status, response);
+    });
+    return;
+  }
+
+  auto handle = rpcs_.Prepare();
+  if (handle == rpcs_.InvalidHandle()) {
+    Received(status_tablet, &batch, STATUS(Aborted, "Aborted because cannot start RPC"),
+             tserver::GetTransactionStatusResponsePB());
+    return;
+  }
+  auto shared_batch = std::make_shared<std::vector<Waiter>>(std::move(batch));
+  *handle = client::GetTransactionStatus(
+      TransactionRpcDeadline(),
+      nullptr /* tablet */,
+      participant_context_.client_future().get(),
+      &req,
+      [this, handle, status_tablet, shared_batch](
+          const Status& status, const tserver::GetTransactionStatusResponsePB& response) {
+        rpcs_.Unregister(handle);
+        Received(status_tablet, shared_batch.get(), status, response);
+      });
+  (**handle).SendRpc();
+}
+
+void TransactionStatusBatcher::Received(
+    const TabletId& status_tablet, std::vector<Waiter>* batch, const Status& status,
+    const tserver::GetTransactionStatusResponsePB& response) {
+  std::vector<Waiter> not_answered;
+  bool split_response = status.ok() && batch->size() > 1;
+  if (split_response && static_cast<size_t>(response.status().size()) != batch->size()) {
+    if (response.status().size() == 1) {
+      // Node with old software version would always return status of the first transaction only,
+      // so request the other ones again.
+      not_answered.assign(std::make_move_iterator(batch->begin() + 1),
+                          std::make_move_iterator(batch->end()));
+      batch->resize(1);
+      split_response = false;
+    } else {
+      LOG(DFATAL) << "Bad response size, expected " << batch->size() << " entries, but found: "
+                  << response.ShortDebugString();
+      split_response = false;
+    }
+  }
+
+  for (size_t i = 0; i != batch->size(); ++i) {
+    auto& waiter = (*batch)[i];
+    if (split_response) {
+      waiter.callback(status, ExtractResponse(response, static_cast<int>(i)));
+    } else {
+      waiter.callback(status, response);
+    }
+  }
+
+  // Callbacks could request status again, such requests are queued and sent as part of the next
+  // batch.
+  std::vector<Waiter> next_batch;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& queue = queues_[status_tablet];
+    queue.waiters.insert(queue.waiters.begin(),
+                         std::make_move_iterator(not_answered.begin()),
+                         std::make_move_iterator(not_answered.end()));
+    queue.in_flight = false;
+    next_batch = NextBatchUnlocked(status_tablet, &queue);
+  }
+  if (!next_batch.empty()) {
+    Send(status_tablet, std::move(next_batch));
+  }
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,91 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+#define YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/tablet/transaction_participant.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+namespace yb {
+namespace tablet {
+
+// Receives response for status of a single transaction, as if it was requested alone.
+using TransactionStatusResponseCallback =
+    std::function<void(const Status&, const tserver::GetTransactionStatusResponsePB&)>;
+
+// Sends status request instead of the GetTransactionStatus RPC, used in tests.
+using TransactionStatusRequestSender = std::function<void(
+    const tserver::GetTransactionStatusRequestPB&, TransactionStatusResponseCallback)>;
+
+// Batches status requests of different transactions which have the same status tablet.
+// Only one status request per status tablet is in flight at a time. Requests that arrive while
+// it is in flight are queued, and sent together in a single RPC when the response is received.
+// So under contention the number of status RPCs is bounded by the number of status tablets,
+// while a request that arrives when nothing is in flight is sent immediately.
+class TransactionStatusBatcher {
+ public:
+  TransactionStatusBatcher(TransactionParticipantContext* participant_context, rpc::Rpcs* rpcs);
+
+  void Request(const TabletId& status_tablet, const TransactionId& transaction_id,
+               TransactionStatusResponseCallback callback);
+
+  // Should be called before the first request.
+  void TEST_SetSender(TransactionStatusRequestSender sender) {
+    test_sender_ = std::move(sender);
+  }
+
+ private:
+  struct Waiter {
+    TransactionId transaction_id;
+    TransactionStatusResponseCallback callback;
+  };
+
+  struct Queue {
+    bool in_flight = false;
+    std::deque<Waiter> waiters;
+  };
+
+  // Extracts next batch of waiters from the queue, or marks the queue as not in flight when it is
+  // empty.
+  std::vector<Waiter> NextBatchUnlocked(const TabletId& status_tablet, Queue* queue);
+
+  void Send(const TabletId& status_tablet, std::vector<Waiter> batch);
+
+  void Received(const TabletId& status_tablet, std::vector<Waiter>* batch,
+                const Status& status, const tserver::GetTransactionStatusResponsePB& response);
+
+  TransactionParticipantContext& participant_context_;
+  rpc::Rpcs& rpcs_;
+
+  TransactionStatusRequestSender test_sender_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, Queue> queues_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_STATUS_BATCHER_H
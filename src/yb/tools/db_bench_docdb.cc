@@ -0,0 +1,115 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// db_bench with DocDB storage profile: profile* benchmarks write DocDB SubDocKeys with hybrid
+// times and ConsensusFrontiers, to RocksDB opened with options built by the tablet server.
+// Example:
+//   db_bench_docdb --benchmarks=profilefill,profileoverwrite,profilereadrandom,amplification \
+//       --statistics --num=10000000 --value_size=100 --batch_size=16
+
+#include "yb/common/partition.h"
+
+#include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/db_bench_tool.h"
+#include "yb/rocksdb/options.h"
+
+#include "yb/tablet/tablet_options.h"
+
+#include "yb/util/opid.h"
+#include "yb/util/size_literals.h"
+
+DECLARE_int64(cache_size);
+DECLARE_int32(cache_numshardbits);
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Hybrid time of the first version, so keys look like keys written by a real cluster.
+const uint64_t kFirstVersionMicros = 1600000000000000ULL;
+
+// Block cache used when --cache_size is not specified.
+constexpr int64_t kDefaultBlockCacheSize = 1_GB;
+
+class DocDbBenchProfile : public rocksdb::DbBenchProfile {
+ public:
+  const char* Name() const override {
+    return "docdb";
+  }
+
+  void InitOptions(const std::shared_ptr<rocksdb::Statistics>& statistics,
+                   rocksdb::Options* options) const override {
+    tablet::TabletOptions tablet_options;
+    tablet_options.block_cache = rocksdb::NewLRUCache(
+        FLAGS_cache_size >= 0 ? FLAGS_cache_size : kDefaultBlockCacheSize,
+        FLAGS_cache_numshardbits);
+    InitRocksDBOptions(options, "db_bench_docdb: ", statistics, tablet_options);
+  }
+
+  // Key is a single int64 column of a hash partitioned table, like in YCQL table with
+  // PRIMARY KEY ((k)). Each version updates the same value column.
+  void AppendKeyPrefix(int64_t key_index, std::string* out) const override {
+    std::vector<PrimitiveValue> hashed_components = { PrimitiveValue(key_index) };
+    KeyBytes hashed_key;
+    for (const auto& component : hashed_components) {
+      component.AppendToKey(&hashed_key);
+    }
+    auto hash = YBPartition::HashColumnCompoundValue(hashed_key.ToStringBuffer());
+    SubDocKey sub_doc_key(
+        DocKey(hash, std::move(hashed_components)), PrimitiveValue(ColumnId(kValueColumnId)));
+    auto encoded = sub_doc_key.EncodeWithoutHt();
+    out->append(encoded.AsSlice().cdata(), encoded.size());
+  }
+
+  void AppendKeySuffix(uint64_t version, std::string* out) const override {
+    out->push_back(ValueTypeAsChar::kHybridTime);
+    DocHybridTime(HybridTime::FromMicros(kFirstVersionMicros + version), 0)
+        .AppendEncodedInDocDbFormat(out);
+  }
+
+  void AppendValue(const Slice& value, std::string* out) const override {
+    out->push_back(ValueTypeAsChar::kString);
+    out->append(value.cdata(), value.size());
+  }
+
+  std::unique_ptr<rocksdb::UserFrontiers> CreateFrontiers(
+      uint64_t min_version, uint64_t max_version) const override {
+    auto frontiers = std::make_unique<ConsensusFrontiers>();
+    frontiers->Smallest().set_op_id(OpId(1, min_version));
+    frontiers->Largest().set_op_id(OpId(1, max_version));
+    frontiers->Smallest().set_hybrid_time(
+        HybridTime::FromMicros(kFirstVersionMicros + min_version));
+    frontiers->Largest().set_hybrid_time(
+        HybridTime::FromMicros(kFirstVersionMicros + max_version));
+    return std::move(frontiers);
+  }
+
+ private:
+  static constexpr int kValueColumnId = 1;
+};
+
+} // namespace
+
+} // namespace docdb
+} // namespace yb
+
+int main(int argc, char** argv) {
+  yb::docdb::DocDbBenchProfile profile;
+  return rocksdb::db_bench_tool(argc, argv, &profile);
+}
@@ -83,7 +83,9 @@ static string GetYsckUsage(const char* progname) {
          "and that table metadata is consistent. Use the 'checksum' flag to check that\n"
          "tablet data is consistent (also see the 'tables' and 'tablets' flags below).\n"
          "Use the 'checksum_snapshot' along with 'checksum' if the table or tablets are\n"
-         "actively receiving inserts or updates.";
+         "actively receiving inserts or updates.\n"
+         "Use the 'checksum_incremental' flag to skip scanning replicas that did not change\n"
+         "since the previous checksum scan.";
   return msg;
 }
 
@@ -59,14 +59,19 @@ DEFINE_int32(checksum_timeout_sec, 120,
              "before timing out.");
 DEFINE_int32(checksum_scan_concurrency, 4,
              "Number of concurrent checksum scans to execute per tablet server.");
+DEFINE_bool(checksum_incremental, false,
+            "Reuse checksums that tablet servers calculated during previous runs, for replicas "
+            "that did not receive writes and did not change their SST files since then.");
 
 ChecksumOptions::ChecksumOptions()
     : timeout(MonoDelta::FromSeconds(FLAGS_checksum_timeout_sec)),
-      scan_concurrency(FLAGS_checksum_scan_concurrency) {}
+      scan_concurrency(FLAGS_checksum_scan_concurrency),
+      use_cache(FLAGS_checksum_incremental) {}
 
-ChecksumOptions::ChecksumOptions(MonoDelta timeout, int scan_concurrency)
+ChecksumOptions::ChecksumOptions(MonoDelta timeout, int scan_concurrency, bool use_cache)
     : timeout(std::move(timeout)),
-      scan_concurrency(scan_concurrency) {}
+      scan_concurrency(scan_concurrency),
+      use_cache(use_cache) {}
 
 string YsckTable::ToString() const {
   return Format(
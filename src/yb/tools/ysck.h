@@ -56,13 +56,17 @@ struct ChecksumOptions {
 
   ChecksumOptions();
 
-  ChecksumOptions(MonoDelta timeout, int scan_concurrency);
+  ChecksumOptions(MonoDelta timeout, int scan_concurrency, bool use_cache = false);
 
   // The maximum total time to wait for results to come back from all replicas.
   MonoDelta timeout;
 
   // The maximum number of concurrent checksum scans to run per tablet server.
   int scan_concurrency;
+
+  // Whether tablet servers could return checksums calculated by previous runs for replicas
+  // whose data did not change since then, instead of scanning them again.
+  bool use_cache;
 };
 
 // Representation of a tablet replica on a tablet server.
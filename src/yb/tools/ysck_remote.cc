@@ -148,6 +148,7 @@ class ChecksumStepper {
   void SendRequest() {
     req_.set_tablet_id(tablet_id_);
     req_.set_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+    req_.set_use_cache(options_.use_cache);
     rpc_.set_timeout(GetDefaultTimeout());
     auto handler = std::make_unique<ChecksumCallbackHandler>(this);
     rpc::ResponseCallback cb = std::bind(&ChecksumCallbackHandler::Run, handler.get());
@@ -452,6 +452,11 @@ Status Heartbeater::Thread::TryHeartbeat() {
     server_->SetYSQLCatalogVersion(last_hb_response_.ysql_catalog_version());
   }
 
+  // Update the master's tablet locations version (i.e. if tablet leadership moved).
+  if (last_hb_response_.has_tablet_locations_version()) {
+    server_->SetTabletLocationsVersion(last_hb_response_.tablet_locations_version());
+  }
+
   // Update the live tserver list.
   return server_->PopulateLiveTServers(last_hb_response_);
 }
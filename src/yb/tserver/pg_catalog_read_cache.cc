@@ -0,0 +1,192 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_catalog_read_cache.h"
+
+#include "yb/client/client.h"
+#include "yb/client/error.h"
+#include "yb/client/session.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/tserver/service_util.h"
+#include "yb/tserver/tablet_server_interface.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
+
+DEFINE_int32(pg_catalog_read_cache_capacity_mb, 64,
+             "Memory limit of the node local cache of YSQL catalog reads, that is shared by "
+             "postgres backends of this tablet server. 0 disables caching.");
+TAG_FLAG(pg_catalog_read_cache_capacity_mb, advanced);
+TAG_FLAG(pg_catalog_read_cache_capacity_mb, runtime);
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+// Requests of different backends differ only in statement id, so it should be ignored.
+std::string MakeKey(const ReadCatalogRequestPB& req) {
+  ReadCatalogRequestPB key_req(req);
+  key_req.clear_ysql_catalog_version();
+  for (auto& pgsql_req : *key_req.mutable_pgsql_batch()) {
+    pgsql_req.clear_stmt_id();
+  }
+  return key_req.SerializeAsString();
+}
+
+} // namespace
+
+PgCatalogReadCache::PgCatalogReadCache(TabletServerIf* server) : server_(server) {
+}
+
+PgCatalogReadCache::~PgCatalogReadCache() {
+}
+
+void PgCatalogReadCache::Read(
+    const ReadCatalogRequestPB& req, ReadCatalogResponsePB* resp, rpc::RpcContext context) {
+  const auto catalog_version = req.ysql_catalog_version();
+  bool cacheable = FLAGS_pg_catalog_read_cache_capacity_mb > 0 && catalog_version != 0;
+  std::string key;
+  if (cacheable) {
+    key = MakeKey(req);
+    EntryPtr entry;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (catalog_version > catalog_version_) {
+        catalog_version_ = catalog_version;
+        entries_.clear();
+        tables_.clear();
+        size_ = 0;
+      }
+      if (catalog_version == catalog_version_) {
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+          entry = it->second;
+        }
+      } else {
+        // Backend with outdated catalog version, don't mix its data with the current one.
+        cacheable = false;
+      }
+    }
+    if (entry) {
+      Respond(*entry, resp, &context);
+      return;
+    }
+  }
+
+  ReadFromMaster(
+      req, resp, std::make_shared<rpc::RpcContext>(std::move(context)), std::move(key), cacheable);
+}
+
+void PgCatalogReadCache::ReadFromMaster(
+    const ReadCatalogRequestPB& req, ReadCatalogResponsePB* resp,
+    std::shared_ptr<rpc::RpcContext> context, std::string key, bool cacheable) {
+  auto session = server_->client()->NewSession();
+  session->SetTimeout(context->GetClientDeadline() - CoarseMonoClock::Now());
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> ops;
+  ops.reserve(req.pgsql_batch().size());
+  for (const auto& pgsql_req : req.pgsql_batch()) {
+    auto table = GetTable(pgsql_req.table_id());
+    Status status;
+    if (table.ok()) {
+      ops.emplace_back(client::YBPgsqlReadOp::NewSelect(*table));
+      *ops.back()->mutable_request() = pgsql_req;
+      status = session->Apply(ops.back());
+    } else {
+      status = table.status();
+    }
+    if (!status.ok()) {
+      SetupErrorAndRespond(
+          resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR, context.get());
+      return;
+    }
+  }
+
+  session->FlushAsync([this, session, ops = std::move(ops), resp, context, key = std::move(key),
+                       cacheable, catalog_version = req.ysql_catalog_version()](
+      const Status& status) mutable {
+    if (!status.ok()) {
+      auto errors = session->GetPendingErrors();
+      SetupErrorAndRespond(
+          resp->mutable_error(), errors.empty() ? status : errors.front()->status(),
+          TabletServerErrorPB::UNKNOWN_ERROR, context.get());
+      return;
+    }
+    auto entry = std::make_shared<Entry>();
+    entry->responses.reserve(ops.size());
+    entry->rows_data.reserve(ops.size());
+    entry->size = key.size();
+    for (const auto& op : ops) {
+      cacheable = cacheable && op->succeeded();
+      entry->responses.push_back(op->response());
+      entry->rows_data.emplace_back(op->rows_data());
+      entry->size += entry->responses.back().ByteSizeLong() + entry->rows_data.back().size();
+    }
+    Respond(*entry, resp, context.get());
+    if (cacheable) {
+      Insert(catalog_version, std::move(key), std::move(entry));
+    }
+  });
+}
+
+Result<client::YBTablePtr> PgCatalogReadCache::GetTable(const std::string& table_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tables_.find(table_id);
+    if (it != tables_.end()) {
+      return it->second;
+    }
+  }
+  auto table = VERIFY_RESULT(server_->client()->OpenTable(table_id));
+  std::lock_guard<std::mutex> lock(mutex_);
+  tables_.emplace(table_id, table);
+  return table;
+}
+
+void PgCatalogReadCache::Insert(uint64_t catalog_version, std::string key, EntryPtr entry) {
+  const size_t capacity = FLAGS_pg_catalog_read_cache_capacity_mb * 1_MB;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (catalog_version != catalog_version_ || entry->size > capacity) {
+    return;
+  }
+  // Catalog data is read in bulk during backend startup, so there is no point in tracking
+  // recency of separate entries.
+  if (size_ + entry->size > capacity) {
+    entries_.clear();
+    size_ = 0;
+  }
+  auto size = entry->size;
+  if (entries_.emplace(std::move(key), std::move(entry)).second) {
+    size_ += size;
+  }
+}
+
+void PgCatalogReadCache::Respond(
+    const Entry& entry, ReadCatalogResponsePB* resp, rpc::RpcContext* context) {
+  for (size_t i = 0; i != entry.responses.size(); ++i) {
+    auto& pgsql_resp = *resp->add_pgsql_batch();
+    pgsql_resp = entry.responses[i];
+    if (entry.rows_data[i].empty()) {
+      pgsql_resp.clear_rows_data_sidecar();
+    } else {
+      pgsql_resp.set_rows_data_sidecar(context->AddRpcSidecar(entry.rows_data[i]));
+    }
+  }
+  context->RespondSuccess();
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_PG_CATALOG_READ_CACHE_H
+#define YB_TSERVER_PG_CATALOG_READ_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/pgsql_protocol.pb.h"
+
+#include "yb/rpc/rpc_context.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/ref_cnt_buffer.h"
+
+namespace yb {
+namespace tserver {
+
+class TabletServerIf;
+
+// Node local cache of YSQL catalog reads, shared by all postgres backends of this tablet server.
+// Catalog data does not change while catalog version stays the same, so backends that warm up
+// their catalog caches with the same catalog version could reuse responses read by each other,
+// instead of reading the same data from the master.
+class PgCatalogReadCache {
+ public:
+  explicit PgCatalogReadCache(TabletServerIf* server);
+  ~PgCatalogReadCache();
+
+  // Responds to the catalog read request, using cached response when available.
+  void Read(const ReadCatalogRequestPB& req, ReadCatalogResponsePB* resp, rpc::RpcContext context);
+
+ private:
+  struct Entry {
+    std::vector<PgsqlResponsePB> responses;
+    std::vector<RefCntBuffer> rows_data;
+    size_t size = 0;
+  };
+
+  typedef std::shared_ptr<const Entry> EntryPtr;
+
+  // Reads requested catalog data from the master, and adds it to cache when cacheable is true.
+  void ReadFromMaster(
+      const ReadCatalogRequestPB& req, ReadCatalogResponsePB* resp,
+      std::shared_ptr<rpc::RpcContext> context, std::string key, bool cacheable);
+
+  Result<client::YBTablePtr> GetTable(const std::string& table_id);
+
+  // Adds entry to the cache if it is still relevant for the current catalog version.
+  void Insert(uint64_t catalog_version, std::string key, EntryPtr entry);
+
+  static void Respond(const Entry& entry, ReadCatalogResponsePB* resp, rpc::RpcContext* context);
+
+  TabletServerIf* const server_;
+
+  std::mutex mutex_;
+  // Catalog version of cached entries. Entries of older versions are dropped, when request with
+  // newer version is received.
+  uint64_t catalog_version_ = 0;
+  std::unordered_map<std::string, EntryPtr> entries_;
+  std::unordered_map<std::string, client::YBTablePtr> tables_;
+  size_t size_ = 0;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_PG_CATALOG_READ_CACHE_H
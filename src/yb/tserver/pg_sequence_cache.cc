@@ -0,0 +1,457 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_sequence_cache.h"
+
+#include <vector>
+
+#include "yb/client/client.h"
+#include "yb/client/error.h"
+#include "yb/client/session.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/wire_protocol.h"
+
+#include "yb/master/master.pb.h"
+
+#include "yb/rpc/rpc_controller.h"
+
+#include "yb/tserver/service_util.h"
+#include "yb/tserver/tablet_server_interface.h"
+#include "yb/tserver/tserver_service.proxy.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+
+#include "yb/yql/pggate/util/pg_doc_data.h"
+
+DEFINE_int64(ysql_sequence_lease_size, 1000,
+             "Number of values of a YSQL sequence, that are leased by the tablet server at once "
+             "and handed out to local postgres backends. 0 disables leasing.");
+TAG_FLAG(ysql_sequence_lease_size, advanced);
+TAG_FLAG(ysql_sequence_lease_size, runtime);
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+// Columns of the sequences data table, see PgSession::CreateSequencesDataTable.
+constexpr size_t kLastValueColIdx = 2;
+constexpr size_t kIsCalledColIdx = 3;
+
+int64_t Advance(int64_t value, uint64_t steps, int64_t inc_by) {
+  return static_cast<int64_t>(static_cast<uint64_t>(value) + steps * static_cast<uint64_t>(inc_by));
+}
+
+// Returns the first value and the number of values, up to max_num_values, that follow the
+// sequence tuple within sequence bounds. Checks are done the same way as in nextval_internal.
+boost::optional<std::pair<int64_t, uint64_t>> NextRange(
+    int64_t last_value, bool is_called, int64_t inc_by, int64_t min_value, int64_t max_value,
+    uint64_t max_num_values) {
+  int64_t first = last_value;
+  if (is_called) {
+    if (inc_by > 0) {
+      if ((max_value >= 0 && last_value > max_value - inc_by) ||
+          (max_value < 0 && last_value + inc_by > max_value)) {
+        return boost::none;
+      }
+    } else if ((min_value < 0 && last_value < min_value - inc_by) ||
+               (min_value >= 0 && last_value + inc_by < min_value)) {
+      return boost::none;
+    }
+    first = last_value + inc_by;
+  }
+  if (first < min_value || first > max_value) {
+    return boost::none;
+  }
+  uint64_t distance, step;
+  if (inc_by > 0) {
+    distance = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(first);
+    step = static_cast<uint64_t>(inc_by);
+  } else {
+    distance = static_cast<uint64_t>(first) - static_cast<uint64_t>(min_value);
+    step = -static_cast<uint64_t>(inc_by);
+  }
+  return std::make_pair(first, std::min(max_num_values - 1, distance / step) + 1);
+}
+
+void AddSequenceKey(int64_t db_oid, int64_t seq_oid, PgsqlWriteRequestPB* req) {
+  req->add_partition_column_values()->mutable_value()->set_int64_value(db_oid);
+  req->add_partition_column_values()->mutable_value()->set_int64_value(seq_oid);
+}
+
+void AddSequenceKey(int64_t db_oid, int64_t seq_oid, PgsqlReadRequestPB* req) {
+  req->add_partition_column_values()->mutable_value()->set_int64_value(db_oid);
+  req->add_partition_column_values()->mutable_value()->set_int64_value(seq_oid);
+}
+
+Status OpStatus(const Status& flush_status, client::YBSession* session,
+                const client::YBPgsqlOp& op) {
+  if (!flush_status.ok()) {
+    auto errors = session->GetPendingErrors();
+    return errors.empty() ? flush_status : errors.front()->status();
+  }
+  if (!op.succeeded()) {
+    return STATUS_FORMAT(
+        RemoteError, "Sequence operation failed: $0", op.response().error_message());
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+PgSequenceCache::PgSequenceCache(TabletServerIf* server) : server_(server) {
+}
+
+PgSequenceCache::~PgSequenceCache() {
+}
+
+void PgSequenceCache::FetchRange(
+    const FetchSequenceRangeRequestPB& req, FetchSequenceRangeResponsePB* resp,
+    rpc::RpcContext context) {
+  // Responding without values tells the backend to allocate them itself.
+  if (FLAGS_ysql_sequence_lease_size <= 0 || req.num_values() <= 0 || req.inc_by() == 0 ||
+      req.min_value() > req.max_value()) {
+    context.RespondSuccess();
+    return;
+  }
+
+  const SequenceKey key(req.db_oid(), req.seq_oid());
+  const auto catalog_version = req.ysql_catalog_version();
+  boost::optional<LeaseContext> lease;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (catalog_version > catalog_version_) {
+      catalog_version_ = catalog_version;
+      entries_.clear();
+    }
+    if (catalog_version == catalog_version_) {
+      auto& entry = entries_[key];
+      if (!entry || entry->inc_by != req.inc_by() || entry->min_value != req.min_value() ||
+          entry->max_value != req.max_value()) {
+        // Values leased with other parameters are dropped. If they are still being leased, their
+        // waiters are served by the old entry.
+        entry = std::make_shared<Entry>();
+        entry->inc_by = req.inc_by();
+        entry->min_value = req.min_value();
+        entry->max_value = req.max_value();
+      }
+      if (!TakeValuesUnlocked(req.num_values(), entry.get(), resp)) {
+        auto deadline = context.GetClientDeadline();
+        entry->waiters.push_back(Waiter {
+          req.num_values(), resp, std::make_shared<rpc::RpcContext>(std::move(context))
+        });
+        if (!entry->leasing) {
+          entry->leasing = true;
+          lease = LeaseContext { key, entry, catalog_version, deadline };
+        }
+        if (!lease) {
+          return;
+        }
+      }
+    }
+    // Otherwise it is a backend with outdated catalog version, that should use its own values.
+  }
+
+  if (lease) {
+    Lease(*lease);
+  } else {
+    context.RespondSuccess();
+  }
+}
+
+void PgSequenceCache::ResetRange(
+    const ResetSequenceRangeRequestPB& req, ResetSequenceRangeResponsePB* resp,
+    rpc::RpcContext context) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(SequenceKey(req.db_oid(), req.seq_oid()));
+    if (it != entries_.end()) {
+      // Waiters of the running lease allocate values themselves.
+      it->second->reset = true;
+      it->second->num_values = 0;
+      entries_.erase(it);
+    }
+  }
+
+  if (req.forward_to_live_tservers()) {
+    ForwardReset(req, resp, std::move(context));
+  } else {
+    context.RespondSuccess();
+  }
+}
+
+void PgSequenceCache::ForwardReset(
+    const ResetSequenceRangeRequestPB& req, ResetSequenceRangeResponsePB* resp,
+    rpc::RpcContext context) {
+  std::vector<master::TSInformationPB> live_tservers;
+  auto status = server_->GetLiveTServers(&live_tservers);
+  if (!status.ok()) {
+    SetupErrorAndRespond(
+        resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR, &context);
+    return;
+  }
+
+  struct ForwardState {
+    ResetSequenceRangeRequestPB req;
+    std::mutex mutex;
+    size_t pending;
+    Status status;
+    ResetSequenceRangeResponsePB* resp;
+    std::shared_ptr<rpc::RpcContext> context;
+  };
+  auto state = std::make_shared<ForwardState>();
+  state->req.set_db_oid(req.db_oid());
+  state->req.set_seq_oid(req.seq_oid());
+  state->pending = live_tservers.size() + 1;
+  state->resp = resp;
+  state->context = std::make_shared<rpc::RpcContext>(std::move(context));
+  auto done = [state](const Status& status) {
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (!status.ok() && state->status.ok()) {
+        state->status = status;
+      }
+      last = --state->pending == 0;
+    }
+    if (!last) {
+      return;
+    }
+    if (state->status.ok()) {
+      state->context->RespondSuccess();
+    } else {
+      SetupErrorAndRespond(
+          state->resp->mutable_error(), state->status, TabletServerErrorPB::UNKNOWN_ERROR,
+          state->context.get());
+    }
+  };
+
+  const auto deadline = state->context->GetClientDeadline();
+  for (const auto& ts_info : live_tservers) {
+    const auto& addresses = ts_info.registration().common().private_rpc_addresses();
+    if (addresses.empty()) {
+      done(STATUS_FORMAT(
+          IllegalState, "Tablet server $0 has no rpc address",
+          ts_info.tserver_instance().permanent_uuid()));
+      continue;
+    }
+    auto proxy = std::make_shared<TabletServerServiceProxy>(
+        &server_->client()->proxy_cache(), HostPortFromPB(addresses.Get(0)));
+    auto forward_resp = std::make_shared<ResetSequenceRangeResponsePB>();
+    auto controller = std::make_shared<rpc::RpcController>();
+    controller->set_deadline(deadline);
+    proxy->ResetSequenceRangeAsync(
+        state->req, forward_resp.get(), controller.get(),
+        [proxy, forward_resp, controller, done] {
+      auto status = controller->status();
+      if (status.ok() && forward_resp->has_error()) {
+        status = StatusFromPB(forward_resp->error().status());
+      }
+      done(status);
+    });
+  }
+  // Accounts for this tserver, that has already dropped its values.
+  done(Status::OK());
+}
+
+void PgSequenceCache::Lease(const LeaseContext& lease) {
+  auto table = GetTable();
+  if (!table.ok()) {
+    LeaseDone(lease, table.status(), boost::none);
+    return;
+  }
+  auto session = server_->client()->NewSession();
+  session->SetTimeout(lease.deadline - CoarseMonoClock::Now());
+
+  std::shared_ptr<client::YBPgsqlReadOp> op(client::YBPgsqlReadOp::NewSelect(*table));
+  auto* req = op->mutable_request();
+  req->set_ysql_catalog_version(lease.catalog_version);
+  AddSequenceKey(lease.key.first, lease.key.second, req);
+  for (auto idx : {kLastValueColIdx, kIsCalledColIdx}) {
+    auto column_id = (**table).schema().ColumnId(idx);
+    req->add_targets()->set_column_id(column_id);
+    req->mutable_column_refs()->add_ids(column_id);
+  }
+  auto status = session->Apply(op);
+  if (!status.ok()) {
+    LeaseDone(lease, status, boost::none);
+    return;
+  }
+  session->FlushAsync([this, lease, table = *table, session, op](const Status& status) {
+    auto op_status = OpStatus(status, session.get(), *op);
+    if (!op_status.ok()) {
+      LeaseDone(lease, op_status, boost::none);
+      return;
+    }
+    LeaseRead(lease, table, session, op);
+  });
+}
+
+void PgSequenceCache::LeaseRead(
+    const LeaseContext& lease, const client::YBTablePtr& table,
+    const client::YBSessionPtr& session, const std::shared_ptr<client::YBPgsqlReadOp>& op) {
+  Slice cursor;
+  int64_t row_count = 0;
+  pggate::PgDocData::LoadCache(op->rows_data(), &row_count, &cursor);
+  int64_t last_value = 0;
+  bool is_called = false;
+  bool found = row_count != 0;
+  if (found) {
+    found = !pggate::PgDocData::ReadDataHeader(&cursor).is_null();
+  }
+  if (found) {
+    cursor.remove_prefix(pggate::PgDocData::ReadNumber(&cursor, &last_value));
+    found = !pggate::PgDocData::ReadDataHeader(&cursor).is_null();
+  }
+  if (!found) {
+    LeaseDone(lease, STATUS_FORMAT(NotFound, "Sequence $0 not found", lease.key.second),
+              boost::none);
+    return;
+  }
+  pggate::PgDocData::ReadNumber(&cursor, &is_called);
+
+  const auto& entry = *lease.entry;
+  auto range = NextRange(
+      last_value, is_called, entry.inc_by, entry.min_value, entry.max_value,
+      FLAGS_ysql_sequence_lease_size);
+  if (!range) {
+    // Backends handle reaching the sequence bound.
+    LeaseDone(lease, Status::OK(), boost::none);
+    return;
+  }
+
+  std::shared_ptr<client::YBPgsqlWriteOp> write_op(client::YBPgsqlWriteOp::NewUpdate(table));
+  auto* req = write_op->mutable_request();
+  req->set_ysql_catalog_version(lease.catalog_version);
+  AddSequenceKey(lease.key.first, lease.key.second, req);
+  const auto& schema = table->schema();
+  auto* column_value = req->add_column_new_values();
+  column_value->set_column_id(schema.ColumnId(kLastValueColIdx));
+  column_value->mutable_expr()->mutable_value()->set_int64_value(
+      Advance(range->first, range->second - 1, entry.inc_by));
+  column_value = req->add_column_new_values();
+  column_value->set_column_id(schema.ColumnId(kIsCalledColIdx));
+  column_value->mutable_expr()->mutable_value()->set_bool_value(true);
+
+  // Same condition as used by backends, so concurrent updates of the sequence are detected.
+  auto* where_pb = req->mutable_where_expr()->mutable_condition();
+  where_pb->set_op(QL_OP_AND);
+  auto* cond = where_pb->add_operands()->mutable_condition();
+  cond->set_op(QL_OP_EQUAL);
+  cond->add_operands()->set_column_id(schema.ColumnId(kLastValueColIdx));
+  cond->add_operands()->mutable_value()->set_int64_value(last_value);
+  cond = where_pb->add_operands()->mutable_condition();
+  cond->set_op(QL_OP_EQUAL);
+  cond->add_operands()->set_column_id(schema.ColumnId(kIsCalledColIdx));
+  cond->add_operands()->mutable_value()->set_bool_value(is_called);
+  req->mutable_column_refs()->add_ids(schema.ColumnId(kLastValueColIdx));
+  req->mutable_column_refs()->add_ids(schema.ColumnId(kIsCalledColIdx));
+
+  auto status = session->Apply(write_op);
+  if (!status.ok()) {
+    LeaseDone(lease, status, boost::none);
+    return;
+  }
+  session->FlushAsync([this, lease, session, write_op, range](const Status& status) {
+    auto op_status = OpStatus(status, session.get(), *write_op);
+    if (!op_status.ok()) {
+      LeaseDone(lease, op_status, boost::none);
+    } else if (write_op->response().skipped()) {
+      // The sequence was updated concurrently, retry with its new state.
+      Lease(lease);
+    } else {
+      LeaseDone(lease, Status::OK(), range);
+    }
+  });
+}
+
+void PgSequenceCache::LeaseDone(
+    const LeaseContext& lease, const Status& status, const boost::optional<ValueRange>& leased) {
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << "Failed to lease values of sequence " << lease.key.second << " of database "
+        << lease.key.first << ": " << status;
+  }
+
+  std::vector<Waiter> ready;
+  boost::optional<LeaseContext> next_lease;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = *lease.entry;
+    if (leased && !entry.reset) {
+      entry.next_value = leased->first;
+      entry.num_values = leased->second;
+    }
+    while (!entry.waiters.empty() &&
+           TakeValuesUnlocked(entry.waiters.front().num_values, &entry,
+                              entry.waiters.front().resp)) {
+      ready.push_back(std::move(entry.waiters.front()));
+      entry.waiters.pop_front();
+    }
+    if (!entry.waiters.empty() && leased && !entry.reset) {
+      // More values were requested while leasing.
+      next_lease = lease;
+      next_lease->deadline = entry.waiters.front().context->GetClientDeadline();
+    } else {
+      // Remaining waiters allocate values themselves.
+      for (auto& waiter : entry.waiters) {
+        ready.push_back(std::move(waiter));
+      }
+      entry.waiters.clear();
+      entry.leasing = false;
+    }
+  }
+
+  for (auto& waiter : ready) {
+    waiter.context->RespondSuccess();
+  }
+  if (next_lease) {
+    Lease(*next_lease);
+  }
+}
+
+bool PgSequenceCache::TakeValuesUnlocked(
+    int64_t num_values, Entry* entry, FetchSequenceRangeResponsePB* resp) {
+  if (entry->num_values == 0) {
+    return false;
+  }
+  const auto count = std::min(static_cast<uint64_t>(num_values), entry->num_values);
+  resp->set_found(true);
+  resp->set_first_value(entry->next_value);
+  resp->set_last_value(Advance(entry->next_value, count - 1, entry->inc_by));
+  entry->num_values -= count;
+  if (entry->num_values != 0) {
+    entry->next_value = Advance(entry->next_value, count, entry->inc_by);
+  }
+  return true;
+}
+
+Result<client::YBTablePtr> PgSequenceCache::GetTable() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (table_) {
+      return table_;
+    }
+  }
+  auto table = VERIFY_RESULT(server_->client()->OpenTable(
+      GetPgsqlTableId(kPgSequencesDataDatabaseOid, kPgSequencesDataTableOid)));
+  std::lock_guard<std::mutex> lock(mutex_);
+  table_ = table;
+  return table;
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,132 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TSERVER_PG_SEQUENCE_CACHE_H
+#define YB_TSERVER_PG_SEQUENCE_CACHE_H
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <boost/optional.hpp>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/rpc/rpc_context.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tserver {
+
+class TabletServerIf;
+
+// Node local allocator of YSQL sequence values, shared by all postgres backends of this tablet
+// server. Blocks of ysql_sequence_lease_size values are leased from the sequences data table with
+// the same read and conditional update, that backends use, and requested ranges are handed out
+// from them. So each lease costs one read and one write, instead of every backend paying them
+// for each nextval() not served from its own cache.
+//
+// Values are only leased within sequence bounds. When a sequence has no values left before its
+// bound, the backend is told to allocate values itself, so cycling and errors are handled by
+// postgres as usual.
+class PgSequenceCache {
+ public:
+  explicit PgSequenceCache(TabletServerIf* server);
+  ~PgSequenceCache();
+
+  void FetchRange(const FetchSequenceRangeRequestPB& req, FetchSequenceRangeResponsePB* resp,
+                  rpc::RpcContext context);
+
+  // Drops values leased for the sequence, since they do not follow its tuple after setval() or
+  // ALTER SEQUENCE ... RESTART. When requested, values leased by other live tservers are dropped
+  // as well, and the response is sent once all of them replied.
+  void ResetRange(const ResetSequenceRangeRequestPB& req, ResetSequenceRangeResponsePB* resp,
+                  rpc::RpcContext context);
+
+ private:
+  struct Waiter {
+    int64_t num_values;
+    FetchSequenceRangeResponsePB* resp;
+    std::shared_ptr<rpc::RpcContext> context;
+  };
+
+  struct Entry {
+    // Sequence parameters the values were leased with.
+    int64_t inc_by;
+    int64_t min_value;
+    int64_t max_value;
+
+    // Next value to hand out and the number of leased values starting with it.
+    int64_t next_value = 0;
+    uint64_t num_values = 0;
+
+    bool leasing = false;
+    std::deque<Waiter> waiters;
+
+    // Set when the sequence was reset, so values of the running lease are not handed out.
+    bool reset = false;
+  };
+
+  typedef std::shared_ptr<Entry> EntryPtr;
+  // Database oid and sequence oid.
+  typedef std::pair<int64_t, int64_t> SequenceKey;
+  // First value and number of values.
+  typedef std::pair<int64_t, uint64_t> ValueRange;
+
+  struct LeaseContext {
+    SequenceKey key;
+    EntryPtr entry;
+    uint64_t catalog_version;
+    CoarseTimePoint deadline;
+  };
+
+  // Reads the sequence tuple, and updates it to lease the next block of values.
+  void Lease(const LeaseContext& lease);
+
+  void LeaseRead(
+      const LeaseContext& lease, const client::YBTablePtr& table,
+      const client::YBSessionPtr& session, const std::shared_ptr<client::YBPgsqlReadOp>& op);
+
+  // Adds leased values to the entry, and responds to waiters while it has values.
+  void LeaseDone(
+      const LeaseContext& lease, const Status& status, const boost::optional<ValueRange>& leased);
+
+  // Hands out up to num_values values from the entry. Returns false if it has no values.
+  static bool TakeValuesUnlocked(int64_t num_values, Entry* entry,
+                                 FetchSequenceRangeResponsePB* resp);
+
+  Result<client::YBTablePtr> GetTable();
+
+  // Sends reset of the sequence to live tservers, and responds with the first failure, if any.
+  void ForwardReset(const ResetSequenceRangeRequestPB& req, ResetSequenceRangeResponsePB* resp,
+                    rpc::RpcContext context);
+
+  TabletServerIf* const server_;
+
+  std::mutex mutex_;
+  // Catalog version of leased values. ALTER SEQUENCE increments catalog version, so leases of
+  // older versions are dropped, when request with newer version is received.
+  uint64_t catalog_version_ = 0;
+  std::map<SequenceKey, EntryPtr> entries_;
+  client::YBTablePtr table_;
+};
+
+} // namespace tserver
+} // namespace yb
+
+#endif // YB_TSERVER_PG_SEQUENCE_CACHE_H
@@ -32,6 +32,9 @@
 
 #include "yb/tserver/remote_bootstrap_client.h"
 
+#include <future>
+#include <unordered_set>
+
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 
@@ -97,6 +100,12 @@ DEFINE_test_flag(int32, simulate_long_remote_bootstrap_sec, 0,
                  "We use this for testing a scenario where a remote bootstrap takes longer than "
                  "follower_unavailable_considered_failed_sec seconds.");
 
+DEFINE_int32(remote_bootstrap_max_concurrent_file_downloads, 4,
+             "Maximum number of RocksDB files downloaded concurrently by a single remote bootstrap "
+             "session.");
+TAG_FLAG(remote_bootstrap_max_concurrent_file_downloads, advanced);
+TAG_FLAG(remote_bootstrap_max_concurrent_file_downloads, runtime);
+
 DECLARE_int32(bytes_remote_bootstrap_durable_write_mb);
 
 namespace yb {
@@ -641,15 +650,21 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  // Files with the same inode are hard links to the same data, so they are linked to the first
+  // downloaded copy after all other files are downloaded.
+  std::vector<const tablet::FilePB*> files_to_download;
+  std::vector<const tablet::FilePB*> files_to_link;
+  std::unordered_set<uint64_t> inodes;
   for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
-    auto start = MonoTime::Now();
-    RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
-    auto elapsed = MonoTime::Now().GetDeltaSince(start);
-    LOG_WITH_PREFIX(INFO)
-        << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
-        << " in " << elapsed.ToSeconds() << " seconds";
+    if (file_pb.inode() != 0 && !inodes.insert(file_pb.inode()).second) {
+      files_to_link.push_back(&file_pb);
+    } else {
+      files_to_download.push_back(&file_pb);
+    }
+  }
+  RETURN_NOT_OK(DownloadRocksDBFilesConcurrently(files_to_download, rocksdb_dir));
+  for (const auto* file_pb : files_to_link) {
+    RETURN_NOT_OK(DownloadRocksDBFile(*file_pb, rocksdb_dir));
   }
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
@@ -667,6 +682,54 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
   return Status::OK();
 }
 
+Status RemoteBootstrapClient::DownloadRocksDBFilesConcurrently(
+    const std::vector<const tablet::FilePB*>& files, const std::string& dir) {
+  const size_t num_workers = std::min<size_t>(
+      std::max(FLAGS_remote_bootstrap_max_concurrent_file_downloads, 1), files.size());
+  std::atomic<size_t> next_file{0};
+  std::atomic<bool> failed{false};
+  auto worker = [this, &files, &dir, &next_file, &failed]() -> Status {
+    while (!failed.load(std::memory_order_acquire)) {
+      auto idx = next_file.fetch_add(1, std::memory_order_acq_rel);
+      if (idx >= files.size()) {
+        break;
+      }
+      auto status = DownloadRocksDBFile(*files[idx], dir);
+      if (!status.ok()) {
+        failed.store(true, std::memory_order_release);
+        return status;
+      }
+    }
+    return Status::OK();
+  };
+
+  std::vector<std::future<Status>> futures;
+  for (size_t i = 1; i < num_workers; ++i) {
+    futures.push_back(std::async(std::launch::async, worker));
+  }
+  auto status = worker();
+  for (auto& future : futures) {
+    auto worker_status = future.get();
+    if (status.ok()) {
+      status = worker_status;
+    }
+  }
+  return status;
+}
+
+Status RemoteBootstrapClient::DownloadRocksDBFile(
+    const tablet::FilePB& file_pb, const std::string& dir) {
+  DataIdPB data_id;
+  data_id.set_type(DataIdPB::ROCKSDB_FILE);
+  auto start = MonoTime::Now();
+  RETURN_NOT_OK(downloader_.DownloadFile(file_pb, dir, &data_id));
+  auto elapsed = MonoTime::Now().GetDeltaSince(start);
+  LOG_WITH_PREFIX(INFO)
+      << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
+      << " in " << elapsed.ToSeconds() << " seconds";
+  return Status::OK();
+}
+
 Status RemoteBootstrapClient::DownloadWAL(uint64_t wal_segment_seqno) {
   VLOG_WITH_PREFIX(1) << "Downloading WAL segment with seqno " << wal_segment_seqno;
   DataIdPB data_id;
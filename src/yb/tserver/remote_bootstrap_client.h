@@ -172,6 +172,12 @@ class RemoteBootstrapClient {
 
   CHECKED_STATUS DownloadRocksDBFiles();
 
+  // Download RocksDB files using up to --remote_bootstrap_max_concurrent_file_downloads threads.
+  CHECKED_STATUS DownloadRocksDBFilesConcurrently(
+      const std::vector<const tablet::FilePB*>& files, const std::string& dir);
+
+  CHECKED_STATUS DownloadRocksDBFile(const tablet::FilePB& file_pb, const std::string& dir);
+
   // End the remote bootstrap session.
   CHECKED_STATUS EndRemoteSession();
 
@@ -24,6 +24,7 @@
 #include "yb/util/crc.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/net/rate_limiter.h"
 
@@ -77,6 +78,10 @@ CHECKED_STATUS ExtractRemoteError(
 
 extern std::atomic<int32_t> remote_bootstrap_clients_started_;
 
+// Number of files that are being downloaded by all remote bootstrap clients, a client could
+// download several files concurrently.
+std::atomic<int32_t> remote_bootstrap_downloads_in_progress_{0};
+
 RemoteBootstrapFileDownloader::RemoteBootstrapFileDownloader(
     const std::string* log_prefix, FsManager* fs_manager)
     : log_prefix_(*log_prefix), fs_manager_(*fs_manager) {
@@ -100,16 +105,23 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string existing_file;
+    {
+      std::lock_guard<std::mutex> lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        existing_file = it->second;
+      }
+    }
+    if (!existing_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << existing_file;
+      auto link_status = env().LinkFile(existing_file, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << existing_file
                              << ": " << link_status;
     }
   }
@@ -126,6 +138,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
@@ -154,8 +167,13 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
                                    << remote_bootstrap_clients_started;
         return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
       }
+      // Share the limit between all concurrent downloads, so downloading several files at once
+      // does not exceed it.
+      auto num_streams = std::max(
+          remote_bootstrap_clients_started,
+          remote_bootstrap_downloads_in_progress_.load(std::memory_order_acquire));
       return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / num_streams);
     };
 
     rate_limiter = std::make_unique<RateLimiter>(rate_updater);
@@ -164,6 +182,11 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     rate_limiter = std::make_unique<RateLimiter>();
   }
 
+  remote_bootstrap_downloads_in_progress_.fetch_add(1, std::memory_order_acq_rel);
+  auto se = ScopeExit([] {
+    remote_bootstrap_downloads_in_progress_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+
   rpc::RpcController controller;
   controller.set_timeout(session_idle_timeout_);
   FetchDataRequestPB req;
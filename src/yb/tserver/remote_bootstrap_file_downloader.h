@@ -15,6 +15,7 @@
 #define YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -45,6 +46,7 @@ class RemoteBootstrapFileDownloader {
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
       MonoDelta session_idle_timeout);
 
+  // Could be called concurrently for files with different inodes.
   CHECKED_STATUS DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
@@ -81,6 +83,7 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
+  std::mutex inode2file_mutex_;
   std::unordered_map<uint64_t, std::string> inode2file_;
 };
 
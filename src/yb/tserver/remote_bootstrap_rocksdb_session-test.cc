@@ -13,6 +13,8 @@
 
 #include "yb/tserver/remote_bootstrap_session-test.h"
 
+DECLARE_bool(remote_bootstrap_flush_before_checkpoint);
+
 namespace yb {
 namespace tserver {
 
@@ -50,6 +52,19 @@ TEST_F(RemoteBootstrapRocksDBTest, TestCheckpointDirectory) {
   ASSERT_FALSE(env_->FileExists(checkpoint_dir));
 }
 
+TEST_F(RemoteBootstrapRocksDBTest, TestCheckpointWithoutFlush) {
+  FLAGS_remote_bootstrap_flush_before_checkpoint = false;
+  ASSERT_NO_FATALS(PopulateTablet(/* flush */ false));
+  const auto num_sst_files = tablet()->GetCurrentVersionNumSSTFiles();
+
+  auto temp_session = make_scoped_refptr<RemoteBootstrapSession>(
+      tablet_peer_, "TestTempSession", "FakeUUID", nullptr /* nsessions */);
+  ASSERT_OK(temp_session->Init());
+  // Session should not flush the tablet, but still provide already flushed files.
+  ASSERT_EQ(num_sst_files, tablet()->GetCurrentVersionNumSSTFiles());
+  ASSERT_FALSE(temp_session->tablet_superblock().kv_store().rocksdb_files().empty());
+}
+
 TEST_F(RemoteBootstrapRocksDBTest, CheckSuperBlockHasRocksDBFields) {
   auto superblock = session_->tablet_superblock();
   const auto& kv_store = superblock.kv_store();
@@ -194,7 +194,7 @@ class RemoteBootstrapTest : public YBTabletTest {
               << ". Reason: " << context->ToString();
   }
 
-  void PopulateTablet() {
+  void PopulateTablet(bool flush = true) {
     for (int32_t i = 0; i < 1000; i++) {
       WriteRequestPB req;
       req.set_tablet_id(tablet_peer_->tablet_id());
@@ -212,7 +212,9 @@ class RemoteBootstrapTest : public YBTabletTest {
       ASSERT_EQ(QLResponsePB::YQL_STATUS_OK, resp.ql_response_batch(0).status()) <<
           "Insert error: " << resp.ShortDebugString();
     }
-    ASSERT_OK(tablet()->Flush(tablet::FlushMode::kSync));
+    if (flush) {
+      ASSERT_OK(tablet()->Flush(tablet::FlushMode::kSync));
+    }
   }
 
   virtual void InitSession() {
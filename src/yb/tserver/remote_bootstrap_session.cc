@@ -47,6 +47,7 @@
 
 #include "yb/tserver/remote_bootstrap_snapshots.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
@@ -54,6 +55,13 @@
 DECLARE_int32(rpc_max_message_size);
 DECLARE_int64(remote_bootstrap_rate_limit_bytes_per_sec);
 
+DEFINE_bool(remote_bootstrap_flush_before_checkpoint, true,
+            "Flush memtables of the tablet before creating checkpoint for remote bootstrap. "
+            "Otherwise unflushed operations are replayed from the WAL by the new replica, that "
+            "avoids flush stalls on the source under heavy write load.");
+TAG_FLAG(remote_bootstrap_flush_before_checkpoint, advanced);
+TAG_FLAG(remote_bootstrap_flush_before_checkpoint, runtime);
+
 namespace yb {
 namespace tserver {
 
@@ -251,7 +259,11 @@ Status RemoteBootstrapSession::Init() {
   // Clear any previous RocksDB files in the superblock. Each session should create a new list
   // based the checkpoint directory files.
   kv_store->clear_rocksdb_files();
-  auto status = tablet->snapshots().CreateCheckpoint(checkpoint_dir_);
+  // Log segments are anchored above, so operations that are not present in an unflushed
+  // checkpoint are still in the segments sent to the new replica.
+  auto status = tablet->snapshots().CreateCheckpoint(
+      checkpoint_dir_, tablet::CreateIntentsCheckpointIn::kUseIntentsDbSuffix,
+      tablet::FlushBeforeCheckpoint(FLAGS_remote_bootstrap_flush_before_checkpoint));
   if (status.ok()) {
     *kv_store->mutable_rocksdb_files() = VERIFY_RESULT(ListFiles(checkpoint_dir_));
   } else if (!status.IsNotSupported()) {
@@ -570,11 +582,22 @@ bool RemoteBootstrapSession::Succeeded() {
 }
 
 void RemoteBootstrapSession::EnsureRateLimiterIsInitialized() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
   if (!rate_limiter_.IsInitialized()) {
     InitRateLimiter();
   }
 }
 
+uint64_t RemoteBootstrapSession::GetMaxSizeForNextTransmission() {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  return rate_limiter_.GetMaxSizeForNextTransmission();
+}
+
+void RemoteBootstrapSession::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+  rate_limiter_.UpdateDataSizeAndMaybeSleep(data_size);
+}
+
 
 void RemoteBootstrapSession::InitRateLimiter() {
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0 && nsessions_) {
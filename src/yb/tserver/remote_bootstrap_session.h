@@ -33,6 +33,7 @@
 #define YB_TSERVER_REMOTE_BOOTSTRAP_SESSION_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -132,7 +133,10 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   void EnsureRateLimiterIsInitialized();
 
-  RateLimiter& rate_limiter() { return rate_limiter_; }
+  // Rate limiter accessors, they could be called concurrently, because a client could fetch
+  // several files of the same session at once.
+  uint64_t GetMaxSizeForNextTransmission();
+  void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
   static const std::string kCheckpointsDir;
 
@@ -217,6 +221,7 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   MonoTime start_time_;
 
   // Used to limit the transmission rate.
+  std::mutex rate_limiter_mutex_;
   RateLimiter rate_limiter_;
 
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
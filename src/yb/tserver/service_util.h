@@ -68,31 +68,45 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer);
 
 // Template helpers.
 
-template<class ReqClass, class RespClass>
-bool CheckUuidMatchOrRespond(TabletPeerLookupIf* tablet_manager,
-                             const char* method_name,
-                             const ReqClass* req,
-                             RespClass* resp,
-                             rpc::RpcContext* context) {
+// Checks that the request is addressed to this server, returns an error with WRONG_SERVER_UUID code
+// otherwise.
+template<class ReqClass>
+CHECKED_STATUS CheckUuidMatch(TabletPeerLookupIf* tablet_manager,
+                              const char* method_name,
+                              const ReqClass* req,
+                              const std::string& requestor_string) {
   const string& local_uuid = tablet_manager->NodeInstance().permanent_uuid();
   if (req->dest_uuid().empty()) {
     // Maintain compat in release mode, but complain.
     string msg = strings::Substitute("$0: Missing destination UUID in request from $1: $2",
-        method_name, context->requestor_string(), req->ShortDebugString());
+        method_name, requestor_string, req->ShortDebugString());
 #ifdef NDEBUG
     YB_LOG_EVERY_N(ERROR, 100) << msg;
 #else
     LOG(FATAL) << msg;
 #endif
-    return true;
+    return Status::OK();
   }
   if (PREDICT_FALSE(req->dest_uuid() != local_uuid)) {
     const Status s = STATUS_SUBSTITUTE(InvalidArgument,
         "$0: Wrong destination UUID requested. Local UUID: $1. Requested UUID: $2",
         method_name, local_uuid, req->dest_uuid());
-    LOG(WARNING) << s.ToString() << ": from " << context->requestor_string()
+    LOG(WARNING) << s.ToString() << ": from " << requestor_string
                  << ": " << req->ShortDebugString();
-    SetupErrorAndRespond(resp->mutable_error(), s,
+    return s.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::WRONG_SERVER_UUID));
+  }
+  return Status::OK();
+}
+
+template<class ReqClass, class RespClass>
+bool CheckUuidMatchOrRespond(TabletPeerLookupIf* tablet_manager,
+                             const char* method_name,
+                             const ReqClass* req,
+                             RespClass* resp,
+                             rpc::RpcContext* context) {
+  auto status = CheckUuidMatch(tablet_manager, method_name, req, context->requestor_string());
+  if (PREDICT_FALSE(!status.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), status,
                          TabletServerErrorPB::WRONG_SERVER_UUID, context);
     return false;
   }
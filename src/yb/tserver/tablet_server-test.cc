@@ -895,5 +895,44 @@ TEST_F(TabletServerTest, TestChecksumScan) {
   ASSERT_EQ(first_crc, resp.checksum());
 }
 
+TEST_F(TabletServerTest, TestCachedChecksum) {
+  InsertTestRowsRemote(0, 1, 1);
+
+  ChecksumRequestPB req;
+  req.set_tablet_id(kTabletId);
+  req.set_use_cache(true);
+  ChecksumResponsePB resp;
+  RpcController controller;
+  ASSERT_OK(proxy_->Checksum(req, &resp, &controller));
+  ASSERT_FALSE(resp.has_error()) << resp.error().DebugString();
+  ASSERT_FALSE(resp.cached());
+  auto first_crc = resp.checksum();
+
+  // Tablet did not change, so checksum is taken from cache.
+  controller.Reset();
+  ASSERT_OK(proxy_->Checksum(req, &resp, &controller));
+  ASSERT_TRUE(resp.cached());
+  ASSERT_EQ(first_crc, resp.checksum());
+
+  // Flush does not change the data, but changes files, so tablet is scanned again.
+  ASSERT_OK(tablet_peer_->tablet()->Flush(tablet::FlushMode::kSync));
+  controller.Reset();
+  ASSERT_OK(proxy_->Checksum(req, &resp, &controller));
+  ASSERT_FALSE(resp.cached());
+  ASSERT_EQ(first_crc, resp.checksum());
+
+  InsertTestRowsRemote(0, 2, 1);
+  controller.Reset();
+  ASSERT_OK(proxy_->Checksum(req, &resp, &controller));
+  ASSERT_FALSE(resp.cached());
+  ASSERT_NE(first_crc, resp.checksum());
+
+  // Cache is not used when it was not requested.
+  req.set_use_cache(false);
+  controller.Reset();
+  ASSERT_OK(proxy_->Checksum(req, &resp, &controller));
+  ASSERT_FALSE(resp.cached());
+}
+
 } // namespace tserver
 } // namespace yb
@@ -137,7 +137,7 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   CHECKED_STATUS PopulateLiveTServers(const master::TSHeartbeatResponsePB& heartbeat_resp);
 
   CHECKED_STATUS GetLiveTServers(
-      std::vector<master::TSInformationPB> *live_tservers) const {
+      std::vector<master::TSInformationPB> *live_tservers) const override {
     std::lock_guard<simple_spinlock> l(lock_);
     *live_tservers = live_tservers_;
     return Status::OK();
@@ -178,6 +178,16 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
     return ysql_catalog_version_;
   }
 
+  void SetTabletLocationsVersion(uint64_t version) {
+    tablet_locations_version_.store(version, std::memory_order_release);
+  }
+
+  // Latest tablet locations version of the master leader, see TSHeartbeatResponsePB. Only
+  // inequality of versions is meaningful, since the version is reset when master leader changes.
+  uint64_t tablet_locations_version() const {
+    return tablet_locations_version_.load(std::memory_order_acquire);
+  }
+
   virtual Env* GetEnv();
 
   virtual rocksdb::Env* GetRocksDBEnv();
@@ -256,6 +266,9 @@ class TabletServer : public server::RpcAndWebServerBase, public TabletServerIf {
   // Latest known version from the YSQL catalog (as reported by last heartbeat response).
   uint64_t ysql_catalog_version_ = 0;
 
+  // Latest known tablet locations version (as reported by last heartbeat response).
+  std::atomic<uint64_t> tablet_locations_version_{0};
+
   // An instance to tablet server service. This pointer is no longer valid after RpcAndWebServerBase
   // is shut down.
   TabletServiceImpl* tablet_server_service_;
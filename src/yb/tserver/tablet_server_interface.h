@@ -14,6 +14,8 @@
 #ifndef YB_TSERVER_TABLET_SERVER_INTERFACE_H
 #define YB_TSERVER_TABLET_SERVER_INTERFACE_H
 
+#include <vector>
+
 #include "yb/client/client_fwd.h"
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/server/clock.h"
@@ -47,6 +49,9 @@ class TabletServerIf : public LocalTabletServer {
   virtual client::TransactionPool* TransactionPool() = 0;
 
   virtual client::YBClient* client() = 0;
+
+  virtual CHECKED_STATUS GetLiveTServers(
+      std::vector<master::TSInformationPB> *live_tservers) const = 0;
 };
 
 } // namespace tserver
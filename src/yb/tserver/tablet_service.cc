@@ -57,6 +57,7 @@
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/escaping.h"
 #include "yb/master/sys_catalog_constants.h"
+#include "yb/rocksdb/db.h"
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -162,6 +163,21 @@ TAG_FLAG(min_rejection_delay_ms, runtime);
 DEFINE_uint64(max_rejection_delay_ms, 5000, ".");
 TAG_FLAG(max_rejection_delay_ms, runtime);
 
+DEFINE_bool(enable_write_backpressure, false,
+            "When a tablet is over sst_files_soft_limit or memory soft limit, accept writes and "
+            "advertise to clients the interval between writes to this tablet, instead of "
+            "rejecting part of the writes. Writes are still rejected at sst_files_hard_limit and "
+            "memory limit.");
+TAG_FLAG(enable_write_backpressure, advanced);
+TAG_FLAG(enable_write_backpressure, runtime);
+
+DEFINE_int32(write_backpressure_max_interval_ms, 100,
+             "Interval between writes to a tablet, that is advertised to clients when the tablet "
+             "reaches sst_files_hard_limit or memory limit. The interval grows linearly from 0 "
+             "at the soft limits.");
+TAG_FLAG(write_backpressure_max_interval_ms, advanced);
+TAG_FLAG(write_backpressure_max_interval_ms, runtime);
+
 DEFINE_uint64(index_backfill_upperbound_for_user_enforced_txn_duration_ms, 65000,
               "For Non-Txn tables, it is impossible to know at the tservers "
               "weather or not an 'old transaction' is still active. To avoid "
@@ -193,6 +209,12 @@ DEFINE_int32(index_backfill_wait_for_old_txns_ms, 0,
 TAG_FLAG(index_backfill_wait_for_old_txns_ms, evolving);
 TAG_FLAG(index_backfill_wait_for_old_txns_ms, runtime);
 
+DEFINE_bool(tserver_coalesce_identical_reads, false,
+            "Whether identical non-transactional reads of the same tablet, that are received "
+            "while such read is executed, should be executed once and share the result.");
+TAG_FLAG(tserver_coalesce_identical_reads, advanced);
+TAG_FLAG(tserver_coalesce_identical_reads, runtime);
+
 DEFINE_test_flag(int32, write_rejection_percentage, 0,
                  "Reject specified percentage of writes.");
 
@@ -313,6 +335,34 @@ bool RejectWrite(tablet::TabletPeer* tablet_peer, const std::string& message, do
   return false;
 }
 
+// Write pressure of the tablet, 0 below sst_files_soft_limit and memory soft limits, 1 or greater
+// at sst_files_hard_limit or memory limit.
+double WritePressure(tablet::TabletPeer* tablet_peer) {
+  double result = tablet_peer->tablet()->mem_tracker()->SoftLimitPressure();
+  const uint64_t num_sst_files = tablet_peer->raft_consensus()->MajorityNumSSTFiles();
+  const auto sst_files_soft_limit = FLAGS_sst_files_soft_limit;
+  const auto sst_files_hard_limit = FLAGS_sst_files_hard_limit;
+  if (num_sst_files >= sst_files_soft_limit) {
+    result = std::max(result, sst_files_hard_limit > sst_files_soft_limit
+        ? static_cast<double>(num_sst_files - sst_files_soft_limit) /
+              (sst_files_hard_limit - sst_files_soft_limit)
+        : 1.0);
+  }
+  return result;
+}
+
+// Advertises the interval between writes to the tablet, see WriteResponsePB::write_interval_us.
+void SetWriteInterval(tablet::TabletPeer* tablet_peer, WriteResponsePB* resp) {
+  if (!FLAGS_enable_write_backpressure) {
+    return;
+  }
+  const auto pressure = WritePressure(tablet_peer);
+  if (pressure > 0.0) {
+    resp->set_write_interval_us(static_cast<uint64_t>(
+        std::min(pressure, 1.0) * FLAGS_write_backpressure_max_interval_ms * 1000));
+  }
+}
+
 void AdjustYsqlOperationTransactionality(
     size_t ysql_batch_size,
     const TabletPeer* tablet_peer,
@@ -331,7 +381,21 @@ bool TabletServiceImpl::CheckWriteThrottlingOrRespond(
   // Check for memory pressure; don't bother doing any additional work if we've
   // exceeded the limit.
   auto tablet = tablet_peer->tablet();
-  auto soft_limit_exceeded_result = tablet->mem_tracker()->AnySoftLimitExceeded(score);
+  const bool backpressure = FLAGS_enable_write_backpressure;
+  if (backpressure && tablet->mem_tracker()->AnyLimitExceeded()) {
+    // Writes below the memory limit are paced by clients instead of being rejected.
+    tablet->metrics()->leader_memory_pressure_rejections->Increment();
+    auto status = STATUS(ServiceUnavailable, "Memory limit exceeded",
+                         TabletServerDelay(FLAGS_min_rejection_delay_ms * 1ms));
+    YB_LOG_EVERY_N_SECS(WARNING, 1) << "Rejecting Write request: " << status << THROTTLE_MSG;
+    SetupErrorAndRespond(resp->mutable_error(), status,
+                         TabletServerErrorPB::UNKNOWN_ERROR,
+                         context);
+    return false;
+  }
+  auto soft_limit_exceeded_result = backpressure
+      ? SoftLimitExceededResult{false, 0.0}
+      : tablet->mem_tracker()->AnySoftLimitExceeded(score);
   if (soft_limit_exceeded_result.exceeded) {
     tablet->metrics()->leader_memory_pressure_rejections->Increment();
     string msg = StringPrintf(
@@ -355,7 +419,8 @@ bool TabletServiceImpl::CheckWriteThrottlingOrRespond(
   if (sst_files_used_delta >= 0) {
     const auto sst_files_hard_limit = FLAGS_sst_files_hard_limit;
     const auto sst_files_full_delta = sst_files_hard_limit - sst_files_soft_limit;
-    if (sst_files_used_delta >= sst_files_full_delta * (1 - score)) {
+    // With backpressure, writes are only rejected at the hard limit.
+    if (sst_files_used_delta >= sst_files_full_delta * (backpressure ? 1.0 : 1 - score)) {
       tablet->metrics()->majority_sst_files_rejections->Increment();
       auto message = Format("SST files limit exceeded $0 against ($1, $2), score: $3",
                             num_sst_files, sst_files_soft_limit, sst_files_hard_limit, score);
@@ -501,7 +566,9 @@ class ScanResultChecksummer {
 
 TabletServiceImpl::TabletServiceImpl(TabletServerIf* server)
     : TabletServerServiceIf(server->MetricEnt()),
-      server_(server) {
+      server_(server),
+      catalog_read_cache_(server),
+      sequence_cache_(server) {
 }
 
 TabletServiceAdminImpl::TabletServiceAdminImpl(TabletServer* server)
@@ -1065,61 +1132,69 @@ void TabletServiceImpl::Truncate(const TruncateRequestPB* req,
 void TabletServiceAdminImpl::CreateTablet(const CreateTabletRequestPB* req,
                                           CreateTabletResponsePB* resp,
                                           rpc::RpcContext context) {
+  TabletServerErrorPB::Code code = TabletServerErrorPB::UNKNOWN_ERROR;
+  auto s = DoCreateTablet(*req, context.requestor_string(), &code);
+  if (PREDICT_FALSE(!s.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), s, code, &context);
+    return;
+  }
+  context.RespondSuccess();
+}
+
+Status TabletServiceAdminImpl::DoCreateTablet(
+    const CreateTabletRequestPB& req, const std::string& requestor,
+    TabletServerErrorPB::Code* code) {
   if (PREDICT_FALSE(FLAGS_TEST_txn_status_table_tablet_creation_delay_ms > 0 &&
-                    req->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE)) {
+                    req.table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE)) {
     std::this_thread::sleep_for(FLAGS_TEST_txn_status_table_tablet_creation_delay_ms * 1ms);
   }
 
-  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "CreateTablet", req, resp, &context)) {
-    return;
+  auto s = CheckUuidMatch(server_->tablet_manager(), "CreateTablet", &req, requestor);
+  if (!s.ok()) {
+    *code = TabletServerErrorPB::WRONG_SERVER_UUID;
+    return s;
   }
-  DVLOG(3) << "Received CreateTablet RPC: " << yb::ToString(*req);
+  DVLOG(3) << "Received CreateTablet RPC: " << yb::ToString(req);
   TRACE_EVENT1("tserver", "CreateTablet",
-               "tablet_id", req->tablet_id());
+               "tablet_id", req.tablet_id());
 
   Schema schema;
-  Status s = SchemaFromPB(req->schema(), &schema);
+  s = SchemaFromPB(req.schema(), &schema);
   DCHECK(schema.has_column_ids());
   if (!s.ok()) {
-    SetupErrorAndRespond(resp->mutable_error(),
-                         STATUS(InvalidArgument, "Invalid Schema."),
-                         TabletServerErrorPB::INVALID_SCHEMA, &context);
-    return;
+    *code = TabletServerErrorPB::INVALID_SCHEMA;
+    return STATUS(InvalidArgument, "Invalid Schema.");
   }
 
   PartitionSchema partition_schema;
-  s = PartitionSchema::FromPB(req->partition_schema(), schema, &partition_schema);
+  s = PartitionSchema::FromPB(req.partition_schema(), schema, &partition_schema);
   if (!s.ok()) {
-    SetupErrorAndRespond(resp->mutable_error(),
-                         STATUS(InvalidArgument, "Invalid PartitionSchema."),
-                         TabletServerErrorPB::INVALID_SCHEMA, &context);
-    return;
+    *code = TabletServerErrorPB::INVALID_SCHEMA;
+    return STATUS(InvalidArgument, "Invalid PartitionSchema.");
   }
 
   Partition partition;
-  Partition::FromPB(req->partition(), &partition);
+  Partition::FromPB(req.partition(), &partition);
 
-  LOG(INFO) << "Processing CreateTablet for tablet " << req->tablet_id()
-            << " (table=" << req->table_name()
-            << " [id=" << req->table_id() << "]), partition="
+  LOG(INFO) << "Processing CreateTablet for tablet " << req.tablet_id()
+            << " (table=" << req.table_name()
+            << " [id=" << req.table_id() << "]), partition="
             << partition_schema.PartitionDebugString(partition, schema);
-  VLOG(1) << "Full request: " << req->DebugString();
+  VLOG(1) << "Full request: " << req.DebugString();
 
-  s = server_->tablet_manager()->CreateNewTablet(req->table_id(), req->tablet_id(), partition,
-      req->table_name(), req->table_type(), schema, partition_schema,
-      req->has_index_info() ? boost::optional<IndexInfo>(req->index_info()) : boost::none,
-      req->config(), /* tablet_peer */ nullptr, req->colocated());
+  s = server_->tablet_manager()->CreateNewTablet(req.table_id(), req.tablet_id(), partition,
+      req.table_name(), req.table_type(), schema, partition_schema,
+      req.has_index_info() ? boost::optional<IndexInfo>(req.index_info()) : boost::none,
+      req.config(), /* tablet_peer */ nullptr, req.colocated());
   if (PREDICT_FALSE(!s.ok())) {
-    TabletServerErrorPB::Code code;
     if (s.IsAlreadyPresent()) {
-      code = TabletServerErrorPB::TABLET_ALREADY_EXISTS;
+      *code = TabletServerErrorPB::TABLET_ALREADY_EXISTS;
     } else {
-      code = TabletServerErrorPB::UNKNOWN_ERROR;
+      *code = TabletServerErrorPB::UNKNOWN_ERROR;
     }
-    SetupErrorAndRespond(resp->mutable_error(), s, code, &context);
-    return;
+    return s;
   }
-  context.RespondSuccess();
+  return Status::OK();
 }
 
 void TabletServiceAdminImpl::DeleteTablet(const DeleteTabletRequestPB* req,
@@ -1130,36 +1205,89 @@ void TabletServiceAdminImpl::DeleteTablet(const DeleteTabletRequestPB* req,
     return;
   }
 
-  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "DeleteTablet", req, resp, &context)) {
+  TabletServerErrorPB::Code code = TabletServerErrorPB::UNKNOWN_ERROR;
+  auto s = DoDeleteTablet(*req, context.requestor_string(), &code);
+  if (PREDICT_FALSE(!s.ok())) {
+    HandleErrorResponse(resp, &context, s, code);
     return;
   }
+  context.RespondSuccess();
+}
+
+Status TabletServiceAdminImpl::DoDeleteTablet(
+    const DeleteTabletRequestPB& req, const std::string& requestor,
+    TabletServerErrorPB::Code* code) {
+  auto s = CheckUuidMatch(server_->tablet_manager(), "DeleteTablet", &req, requestor);
+  if (!s.ok()) {
+    *code = TabletServerErrorPB::WRONG_SERVER_UUID;
+    return s;
+  }
   TRACE_EVENT2("tserver", "DeleteTablet",
-               "tablet_id", req->tablet_id(),
-               "reason", req->reason());
+               "tablet_id", req.tablet_id(),
+               "reason", req.reason());
 
   tablet::TabletDataState delete_type = tablet::TABLET_DATA_UNKNOWN;
-  if (req->has_delete_type()) {
-    delete_type = req->delete_type();
+  if (req.has_delete_type()) {
+    delete_type = req.delete_type();
   }
-  LOG(INFO) << "T " << req->tablet_id() << " P " << server_->permanent_uuid()
+  LOG(INFO) << "T " << req.tablet_id() << " P " << server_->permanent_uuid()
             << ": Processing DeleteTablet with delete_type " << TabletDataState_Name(delete_type)
-            << (req->has_reason() ? (" (" + req->reason() + ")") : "")
-            << " from " << context.requestor_string();
-  VLOG(1) << "Full request: " << req->DebugString();
+            << (req.has_reason() ? (" (" + req.reason() + ")") : "")
+            << " from " << requestor;
+  VLOG(1) << "Full request: " << req.DebugString();
 
   boost::optional<int64_t> cas_config_opid_index_less_or_equal;
-  if (req->has_cas_config_opid_index_less_or_equal()) {
-    cas_config_opid_index_less_or_equal = req->cas_config_opid_index_less_or_equal();
+  if (req.has_cas_config_opid_index_less_or_equal()) {
+    cas_config_opid_index_less_or_equal = req.cas_config_opid_index_less_or_equal();
   }
   boost::optional<TabletServerErrorPB::Code> error_code;
-  Status s = server_->tablet_manager()->DeleteTablet(req->tablet_id(),
-                                                     delete_type,
-                                                     cas_config_opid_index_less_or_equal,
-                                                     &error_code);
+  s = server_->tablet_manager()->DeleteTablet(req.tablet_id(),
+                                              delete_type,
+                                              cas_config_opid_index_less_or_equal,
+                                              &error_code);
   if (PREDICT_FALSE(!s.ok())) {
-    HandleErrorResponse(resp, &context, s, error_code);
+    *code = error_code.get_value_or(TabletServerErrorPB::UNKNOWN_ERROR);
+    return s;
+  }
+  return Status::OK();
+}
+
+void TabletServiceAdminImpl::CreateTablets(const CreateTabletsRequestPB* req,
+                                           CreateTabletsResponsePB* resp,
+                                           rpc::RpcContext context) {
+  DVLOG(3) << "Received " << req->create_tablet_request_size() << " batched CreateTablet requests";
+  // Errors are reported in the response of each tablet, so other tablets of the batch are not
+  // affected.
+  for (const auto& create_req : req->create_tablet_request()) {
+    auto* create_resp = resp->add_create_tablet_response();
+    TabletServerErrorPB::Code code = TabletServerErrorPB::UNKNOWN_ERROR;
+    auto s = DoCreateTablet(create_req, context.requestor_string(), &code);
+    if (PREDICT_FALSE(!s.ok())) {
+      StatusToPB(s, create_resp->mutable_error()->mutable_status());
+      create_resp->mutable_error()->set_code(code);
+    }
+  }
+  context.RespondSuccess();
+}
+
+void TabletServiceAdminImpl::DeleteTablets(const DeleteTabletsRequestPB* req,
+                                           DeleteTabletsResponsePB* resp,
+                                           rpc::RpcContext context) {
+  if (PREDICT_FALSE(FLAGS_TEST_rpc_delete_tablet_fail)) {
+    context.RespondFailure(STATUS(NetworkError, "Simulating network partition for test"));
     return;
   }
+
+  DVLOG(3) << "Received " << req->delete_tablet_request_size() << " batched DeleteTablet requests";
+  for (const auto& delete_req : req->delete_tablet_request()) {
+    auto* delete_resp = resp->add_delete_tablet_response();
+    TabletServerErrorPB::Code code = TabletServerErrorPB::UNKNOWN_ERROR;
+    auto s = DoDeleteTablet(delete_req, context.requestor_string(), &code);
+    if (PREDICT_FALSE(!s.ok())) {
+      StatusToPB(s, delete_resp->mutable_error()->mutable_status());
+      delete_resp->mutable_error()->set_code(code);
+    }
+  }
   context.RespondSuccess();
 }
 
@@ -1341,6 +1469,7 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
           req->rejection_score(), tablet.peer.get(), resp, &context)) {
     return;
   }
+  SetWriteInterval(tablet.peer.get(), resp);
 
 #if defined(DUMP_WRITE)
   if (req->has_write_batch() && req->write_batch().has_transaction()) {
@@ -1369,7 +1498,8 @@ void TabletServiceImpl::Write(const WriteRequestPB* req,
 #endif
 
   if (PREDICT_FALSE(req->has_write_batch() && !req->has_external_hybrid_time() &&
-      (!req->write_batch().write_pairs().empty() || !req->write_batch().read_pairs().empty()))) {
+      (!req->write_batch().write_pairs().empty() || !req->write_batch().read_pairs().empty() ||
+       req->write_batch().has_encoded_write_pairs()))) {
     Status s = STATUS(NotSupported, "Write Request contains write batch. This field should be "
         "used only for post-processed write requests during "
         "Raft replication.");
@@ -1582,6 +1712,18 @@ struct ReadContext {
   bool allow_retry = false;
   RequestScope request_scope;
 
+  // Reads that are responded with result of this read.
+  std::vector<CoalescedRead>* coalesced_reads = nullptr;
+  // Sidecars of the response, when it should be copied to coalesced reads.
+  std::vector<RefCntBuffer> sidecars;
+
+  size_t AddSidecar(RefCntBuffer sidecar) {
+    if (coalesced_reads) {
+      sidecars.push_back(sidecar);
+    }
+    return context->AddRpcSidecar(std::move(sidecar));
+  }
+
   bool transactional() const {
     return tablet->IsTransactionalRequest(req->pgsql_batch_size() > 0);
   }
@@ -1615,6 +1757,55 @@ struct ReadContext {
   }
 };
 
+struct CoalescedRead {
+  ReadContext read_context;
+  std::shared_ptr<rpc::RpcContext> context;
+  HostPortPB host_port_pb;
+};
+
+struct CoalescedReads {
+  std::string tablet_id;
+  std::vector<CoalescedRead> pending;
+};
+
+namespace {
+
+// Max number of rounds of queued reads executed by the read that became the leader of coalesced
+// reads. After that the leader role is passed to a task in the tablet thread pool, so the thread of
+// the read, that was already responded, is not held by a stream of identical reads.
+constexpr int kMaxCoalescedReadRounds = 4;
+
+// Identical reads could be executed once only when their results do not depend on the read time
+// picked by the client, i.e. they are not transactional and read time is picked by the tablet.
+bool CanCoalesceRead(const ReadRequestPB& req, const ReadContext& read_context) {
+  return !req.has_transaction() && read_context.allow_retry && !req.include_trace() &&
+         req.redis_batch().empty() && (req.ql_batch().empty() || req.pgsql_batch().empty());
+}
+
+// Key of the read, that is the same for reads that have the same result when executed at the same
+// read time.
+std::string CoalescedReadKey(const ReadRequestPB& req, const HostPortPB& host_port_pb) {
+  ReadRequestPB key_req(req);
+  key_req.clear_propagated_hybrid_time();
+  key_req.clear_rejection_score();
+  key_req.clear_batch_idx();
+  for (auto& ql_req : *key_req.mutable_ql_batch()) {
+    ql_req.clear_request_id();
+    // Remote endpoint is set from the RPC connection, so reads from different clients are not
+    // coalesced.
+    *ql_req.mutable_remote_endpoint() = host_port_pb;
+  }
+  for (auto& pgsql_req : *key_req.mutable_pgsql_batch()) {
+    pgsql_req.clear_stmt_id();
+  }
+  if (key_req.ql_batch().empty()) {
+    key_req.clear_proxy_uuid();
+  }
+  return key_req.SerializeAsString();
+}
+
+} // namespace
+
 // Used when we write intents during read, i.e. for serializable isolation.
 // We cannot proceed with read from ReadOperationCompletionCallback, to avoid holding
 // replica state lock for too long.
@@ -1655,6 +1846,35 @@ class ReadCompletionTask : public rpc::ThreadPoolTask {
   std::shared_ptr<rpc::RpcContext> context_;
 };
 
+// Executes reads queued for the in flight execution of identical read, when the leader role is
+// passed to it.
+class CoalescedReadsTask : public rpc::ThreadPoolTask {
+ public:
+  CoalescedReadsTask(
+      TabletServiceImpl* service, std::string key, std::shared_ptr<CoalescedReads> reads)
+      : service_(service), key_(std::move(key)), reads_(std::move(reads)) {
+  }
+
+  virtual ~CoalescedReadsTask() = default;
+
+ private:
+  void Run() override {
+    service_->ExecutePendingCoalescedReads(key_, reads_);
+  }
+
+  void Done(const Status& status) override {
+    if (!status.ok()) {
+      service_->AbortPendingCoalescedReads(key_, reads_, status);
+    }
+
+    delete this;
+  }
+
+  TabletServiceImpl* service_;
+  const std::string key_;
+  const std::shared_ptr<CoalescedReads> reads_;
+};
+
 class ReadOperationCompletionCallback : public OperationCompletionCallback {
  public:
   explicit ReadOperationCompletionCallback(
@@ -1867,13 +2087,130 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     return;
   }
 
+  if (FLAGS_tserver_coalesce_identical_reads && CanCoalesceRead(*req, read_context)) {
+    CoalesceRead(CoalescedReadKey(*req, host_port_pb), &read_context);
+    return;
+  }
+
+  CompleteRead(&read_context);
+}
+
+// Read that is received while identical read is executed cannot use its result, because the
+// execution could have picked read time before the write, that was acknowledged before the read
+// was received. So such reads are queued, and executed once after the in flight execution
+// completes, at the max read time picked by them. It is not less than read time picked by each of
+// them, and is safe time of the tablet, so every queued read observes the same writes, as it would
+// when executed individually.
+void TabletServiceImpl::CoalesceRead(const std::string& key, ReadContext* read_context) {
+  std::shared_ptr<CoalescedReads> reads;
+  {
+    std::lock_guard<std::mutex> lock(coalesced_reads_mutex_);
+    auto it = coalesced_reads_.find(key);
+    if (it != coalesced_reads_.end()) {
+      CoalescedRead read;
+      read.host_port_pb = *read_context->host_port_pb;
+      read.context = std::make_shared<rpc::RpcContext>(std::move(*read_context->context));
+      read.read_context = std::move(*read_context);
+      it->second->pending.push_back(std::move(read));
+      TRACE("Read coalesced");
+      return;
+    }
+    reads = std::make_shared<CoalescedReads>();
+    reads->tablet_id = read_context->req->tablet_id();
+    coalesced_reads_.emplace(key, reads);
+  }
+
+  CompleteRead(read_context);
+
+  ExecutePendingCoalescedReads(key, reads);
+}
+
+void TabletServiceImpl::ExecutePendingCoalescedReads(
+    const std::string& key, const std::shared_ptr<CoalescedReads>& reads) {
+  for (int round = 0;; ++round) {
+    std::vector<CoalescedRead> pending;
+    {
+      std::lock_guard<std::mutex> lock(coalesced_reads_mutex_);
+      if (reads->pending.empty()) {
+        coalesced_reads_.erase(key);
+        return;
+      }
+      if (round == kMaxCoalescedReadRounds) {
+        break;
+      }
+      pending.swap(reads->pending);
+    }
+    ExecuteCoalescedReads(&pending);
+  }
+
+  // Identical reads keep arriving, so pass the leader role to a task. Reads received meanwhile are
+  // queued as before, because the key is still registered.
+  TRACE("Pass coalesced reads leader");
+  auto task = new CoalescedReadsTask(this, key, reads);
+  tablet::TabletPeerPtr tablet_peer;
+  auto status = server_->tablet_peer_lookup()->GetTabletPeer(reads->tablet_id, &tablet_peer);
+  if (!status.ok()) {
+    task->Done(status);
+    return;
+  }
+  tablet_peer->Enqueue(task);
+}
+
+void TabletServiceImpl::AbortPendingCoalescedReads(
+    const std::string& key, const std::shared_ptr<CoalescedReads>& reads, const Status& status) {
+  std::vector<CoalescedRead> pending;
+  {
+    std::lock_guard<std::mutex> lock(coalesced_reads_mutex_);
+    pending.swap(reads->pending);
+    coalesced_reads_.erase(key);
+  }
+  for (auto& read : pending) {
+    SetupErrorAndRespond(
+        read.read_context.resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR,
+        read.context.get());
+  }
+}
+
+void TabletServiceImpl::ExecuteCoalescedReads(std::vector<CoalescedRead>* reads) {
+  auto it = std::max_element(
+      reads->begin(), reads->end(), [](const CoalescedRead& lhs, const CoalescedRead& rhs) {
+    return lhs.read_context.read_time.read < rhs.read_context.read_time.read;
+  });
+  CoalescedRead executed = std::move(*it);
+  reads->erase(it);
+
+  auto& read_context = executed.read_context;
+  read_context.context = executed.context.get();
+  read_context.host_port_pb = &executed.host_port_pb;
+  read_context.coalesced_reads = reads;
   CompleteRead(&read_context);
+
+  // Reads are not responded when the executed read failed, so they are executed individually.
+  for (auto& read : *reads) {
+    read.read_context.context = read.context.get();
+    read.read_context.host_port_pb = &read.host_port_pb;
+    CompleteRead(&read.read_context);
+  }
+}
+
+void TabletServiceImpl::RespondCoalescedReads(ReadContext* read_context) {
+  for (auto& read : *read_context->coalesced_reads) {
+    read.read_context.resp->CopyFrom(*read_context->resp);
+    for (const auto& sidecar : read_context->sidecars) {
+      read.context->AddRpcSidecar(sidecar);
+    }
+    RpcOperationCompletionCallback<ReadResponsePB> callback(
+        std::move(*read.context), read.read_context.resp, server_->Clock());
+    callback.OperationCompleted();
+  }
+  read_context->coalesced_reads->clear();
 }
 
 void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
   for (;;) {
     read_context->resp->Clear();
     read_context->context->ResetRpcSidecars();
+    read_context->sidecars.clear();
     VLOG(1) << "Read time: " << read_context->read_time
             << ", safe: " << read_context->safe_ht_to_read;
     Result<ReadHybridTime> result{ReadHybridTime()};
@@ -1947,6 +2284,10 @@ void TabletServiceImpl::CompleteRead(ReadContext* read_context) {
   }
 #endif
 
+  if (read_context->coalesced_reads) {
+    RespondCoalescedReads(read_context);
+  }
+
   RpcOperationCompletionCallback<ReadResponsePB> callback(
       std::move(*read_context->context), read_context->resp, server_->Clock());
   callback.OperationCompleted();
@@ -1975,6 +2316,8 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
     size_t count = read_context->req->redis_batch_size();
     std::vector<Status> rets(count);
     CountDownLatch latch(count);
+    auto* read_pool = server_->tablet_manager()->read_pool(
+        down_cast<tablet::Tablet*>(read_context->tablet.get())->metadata()->data_root_dir());
     for (int idx = 0; idx < count; idx++) {
       const RedisReadRequestPB& redis_read_req = read_context->req->redis_batch(idx);
       Status &failed_status_ = rets[idx];
@@ -1995,7 +2338,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
       Status s;
       bool run_async = FLAGS_parallelize_read_ops && (idx != count - 1);
       if (run_async) {
-        s = server_->tablet_manager()->read_pool()->SubmitClosure(func);
+        s = read_pool->SubmitClosure(func);
       }
 
       if (!s.ok() || !run_async) {
@@ -2046,7 +2389,8 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
         read_context->read_time.local_limit = read_context->safe_ht_to_read;
         return read_context->read_time;
       }
-      result.response.set_rows_data_sidecar(read_context->context->AddRpcSidecar(result.rows_data));
+      result.response.set_rows_data_sidecar(read_context->AddSidecar(
+          RefCntBuffer(std::move(result.rows_data))));
       read_context->resp->add_ql_batch()->Swap(&result.response);
     }
     return ReadHybridTime();
@@ -2067,7 +2411,8 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
         read_context->read_time.local_limit = read_context->safe_ht_to_read;
         return read_context->read_time;
       }
-      result.response.set_rows_data_sidecar(read_context->context->AddRpcSidecar(result.rows_data));
+      result.response.set_rows_data_sidecar(read_context->AddSidecar(
+          RefCntBuffer(std::move(result.rows_data))));
       read_context->resp->add_pgsql_batch()->Swap(&result.response);
     }
     return ReadHybridTime();
@@ -2106,8 +2451,9 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
   // gives us a const request, but we need to be able to move messages out of the request for
   // efficiency.
-  Status s = consensus->Update(
-      const_cast<ConsensusRequestPB*>(req), resp, context.GetClientDeadline());
+  Status s = UpdateTabletConsensus(
+      tablet_peer, consensus.get(), const_cast<ConsensusRequestPB*>(req), resp,
+      context.GetClientDeadline());
   if (PREDICT_FALSE(!s.ok())) {
     // Clear the response first, since a partially-filled response could
     // result in confusing a caller, or in having missing required fields
@@ -2120,13 +2466,72 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
     return;
   }
 
+  context.RespondSuccess();
+}
+
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB* req,
+    consensus::MultiRaftConsensusResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batched Consensus Update RPC: " << req->ShortDebugString();
+  const auto deadline = context.GetClientDeadline();
+  // The same checks as in UpdateConsensus are done for each tablet, but errors are reported in
+  // the response of the tablet, so other tablets of the batch are not affected.
+  for (const auto& consensus_req : req->consensus_request()) {
+    auto* consensus_resp = resp->add_consensus_response();
+    auto status = CheckUuidMatch(tablet_manager_, "MultiRaftUpdateConsensus", &consensus_req,
+                                 context.requestor_string());
+    std::shared_ptr<tablet::TabletPeer> tablet_peer;
+    shared_ptr<Consensus> consensus;
+    if (status.ok()) {
+      status = tablet_manager_->GetTabletPeer(consensus_req.tablet_id(), &tablet_peer);
+      if (!status.ok() && !status.IsServiceUnavailable()) {
+        status = status.CloneAndAddErrorCode(
+            TabletServerError(TabletServerErrorPB::TABLET_NOT_FOUND));
+      }
+    }
+    if (status.ok()) {
+      auto state = tablet_peer->state();
+      if (state != tablet::RUNNING) {
+        status = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStateError(state))
+            .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+      }
+    }
+    if (status.ok()) {
+      consensus = tablet_peer->shared_consensus();
+      if (!consensus) {
+        status = STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running")
+            .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
+      }
+    }
+    if (status.ok()) {
+      status = UpdateTabletConsensus(
+          tablet_peer, consensus.get(), const_cast<ConsensusRequestPB*>(&consensus_req),
+          consensus_resp, deadline);
+    }
+    if (PREDICT_FALSE(!status.ok())) {
+      consensus_resp->Clear();
+      auto ts_error = TabletServerError::FromStatus(status);
+      StatusToPB(status, consensus_resp->mutable_error()->mutable_status());
+      consensus_resp->mutable_error()->set_code(
+          ts_error ? ts_error->value() : TabletServerErrorPB::UNKNOWN_ERROR);
+    }
+  }
+  context.RespondSuccess();
+}
+
+Status ConsensusServiceImpl::UpdateTabletConsensus(
+    const std::shared_ptr<tablet::TabletPeer>& tablet_peer, Consensus* consensus,
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, CoarseTimePoint deadline) {
+  RETURN_NOT_OK(consensus->Update(req, resp, deadline));
+
   auto tablet = tablet_peer->shared_tablet();
   if (tablet) {
     resp->set_num_sst_files(tablet->GetCurrentVersionNumSSTFiles());
   }
 
   resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
-  context.RespondSuccess();
+  return Status::OK();
 }
 
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
@@ -2469,6 +2874,21 @@ Result<uint64_t> CalcChecksum(tablet::Tablet* tablet, CoarseTimePoint deadline)
   return collector.agg_checksum();
 }
 
+// Returns string that changes when data of the tablet could have changed: hybrid time of the
+// last replicated operation and the set of regular SST files. So a compaction invalidates the
+// cached checksum, but tablet that did not receive writes keeps its checksum.
+std::string ChecksumFingerprint(tablet::Tablet* tablet) {
+  std::vector<std::string> files;
+  auto* db = tablet->doc_db().regular;
+  if (db) {
+    for (const auto& file : db->GetLiveFilesMetaData()) {
+      files.push_back(file.name);
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return Format("$0 $1", tablet->mvcc_manager()->LastReplicatedHybridTime(), files);
+}
+
 } // namespace
 
 void TabletServiceImpl::Checksum(const ChecksumRequestPB* req,
@@ -2482,14 +2902,32 @@ void TabletServiceImpl::Checksum(const ChecksumRequestPB* req,
           AllowSplitTablet::kTrue)) {
     return;
   }
-  auto checksum = CalcChecksum(
-      down_cast<tablet::Tablet*>(abstract_tablet.get()), context.GetClientDeadline());
+  auto* tablet = down_cast<tablet::Tablet*>(abstract_tablet.get());
+  // Fingerprint is taken before the scan, so writes done during the scan invalidate the result.
+  auto fingerprint = ChecksumFingerprint(tablet);
+  if (req->use_cache()) {
+    std::lock_guard<std::mutex> lock(checksum_cache_mutex_);
+    auto it = checksum_cache_.find(tablet->tablet_id());
+    if (it != checksum_cache_.end() && it->second.fingerprint == fingerprint) {
+      resp->set_checksum(it->second.checksum);
+      resp->set_cached(true);
+      context.RespondSuccess();
+      return;
+    }
+  }
+
+  auto checksum = CalcChecksum(tablet, context.GetClientDeadline());
   if (!checksum.ok()) {
     SetupErrorAndRespond(resp->mutable_error(), checksum.status(),
                          TabletServerErrorPB::UNKNOWN_ERROR, &context);
     return;
   }
 
+  {
+    std::lock_guard<std::mutex> lock(checksum_cache_mutex_);
+    checksum_cache_[tablet->tablet_id()] = CachedChecksum{std::move(fingerprint), *checksum};
+  }
+
   resp->set_checksum(*checksum);
 
   context.RespondSuccess();
@@ -2501,7 +2939,9 @@ void TabletServiceImpl::ImportData(const ImportDataRequestPB* req,
   auto peer = VERIFY_RESULT_OR_RETURN(LookupTabletPeerOrRespond(
       server_->tablet_peer_lookup(), req->tablet_id(), resp, &context));
 
-  auto status = peer->tablet()->ImportData(req->source_dir());
+  auto tablet = peer->shared_tablet();
+  auto status = tablet ? tablet->ImportData(req->source_dir())
+                       : STATUS_FORMAT(IllegalState, "Tablet $0 is not open", req->tablet_id());
   if (!status.ok()) {
     SetupErrorAndRespond(resp->mutable_error(),
                          status,
@@ -2553,6 +2993,24 @@ void TabletServiceImpl::TakeTransaction(const TakeTransactionRequestPB* req,
   context.RespondSuccess();
 }
 
+void TabletServiceImpl::ReadCatalog(const ReadCatalogRequestPB* req,
+                                    ReadCatalogResponsePB* resp,
+                                    rpc::RpcContext context) {
+  catalog_read_cache_.Read(*req, resp, std::move(context));
+}
+
+void TabletServiceImpl::FetchSequenceRange(const FetchSequenceRangeRequestPB* req,
+                                           FetchSequenceRangeResponsePB* resp,
+                                           rpc::RpcContext context) {
+  sequence_cache_.FetchRange(*req, resp, std::move(context));
+}
+
+void TabletServiceImpl::ResetSequenceRange(const ResetSequenceRangeRequestPB* req,
+                                           ResetSequenceRangeResponsePB* resp,
+                                           rpc::RpcContext context) {
+  sequence_cache_.ResetRange(*req, resp, std::move(context));
+}
+
 void TabletServiceImpl::Shutdown() {
 }
 
@@ -33,7 +33,9 @@
 #define YB_TSERVER_TABLET_SERVICE_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "yb/common/read_hybrid_time.h"
@@ -43,6 +45,8 @@
 #include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/tablet_peer.h"
 
+#include "yb/tserver/pg_catalog_read_cache.h"
+#include "yb/tserver/pg_sequence_cache.h"
 #include "yb/tserver/tablet_server_interface.h"
 #include "yb/tserver/tserver_admin.service.h"
 #include "yb/tserver/tserver_service.service.h"
@@ -54,10 +58,13 @@ class HybridTime;
 
 namespace tserver {
 
+class CoalescedReadsTask;
 class ReadCompletionTask;
 class TabletPeerLookupIf;
 class TabletServer;
 
+struct CoalescedRead;
+struct CoalescedReads;
 struct ReadContext;
 
 YB_STRONGLY_TYPED_BOOL(AllowSplitTablet);
@@ -134,9 +141,22 @@ class TabletServiceImpl : public TabletServerServiceIf {
                        TakeTransactionResponsePB* resp,
                        rpc::RpcContext context) override;
 
+  void ReadCatalog(const ReadCatalogRequestPB* req,
+                   ReadCatalogResponsePB* resp,
+                   rpc::RpcContext context) override;
+
+  void FetchSequenceRange(const FetchSequenceRangeRequestPB* req,
+                          FetchSequenceRangeResponsePB* resp,
+                          rpc::RpcContext context) override;
+
+  void ResetSequenceRange(const ResetSequenceRangeRequestPB* req,
+                          ResetSequenceRangeResponsePB* resp,
+                          rpc::RpcContext context) override;
+
   void Shutdown() override;
 
  private:
+  friend class CoalescedReadsTask;
   friend class ReadCompletionTask;
 
   CHECKED_STATUS CheckPeerIsLeader(const tablet::TabletPeer& tablet_peer);
@@ -180,7 +200,38 @@ class TabletServiceImpl : public TabletServerServiceIf {
   // Sends response, etc.
   void CompleteRead(ReadContext* read_context);
 
+  // Completes read, sharing execution with identical reads in flight on the same tablet.
+  void CoalesceRead(const std::string& key, ReadContext* read_context);
+  // Executes reads queued for key, for at most kMaxCoalescedReadRounds rounds, then passes the
+  // leader role to a task if reads are still queued.
+  void ExecutePendingCoalescedReads(
+      const std::string& key, const std::shared_ptr<CoalescedReads>& reads);
+  // Responds reads queued for key with status, when the task they were passed to failed to run.
+  void AbortPendingCoalescedReads(
+      const std::string& key, const std::shared_ptr<CoalescedReads>& reads, const Status& status);
+  // Completes one of reads with the max read time, and responds to others with its result.
+  void ExecuteCoalescedReads(std::vector<CoalescedRead>* reads);
+  // Copies response of completed read to reads that were coalesced with it and responds them.
+  void RespondCoalescedReads(ReadContext* read_context);
+
   TabletServerIf *const server_;
+
+  std::mutex coalesced_reads_mutex_;
+  // Reads waiting for the in flight execution of identical read to complete, by read key.
+  std::unordered_map<std::string, std::shared_ptr<CoalescedReads>> coalesced_reads_;
+
+  PgCatalogReadCache catalog_read_cache_;
+
+  PgSequenceCache sequence_cache_;
+
+  struct CachedChecksum {
+    // Identifies tablet data the checksum was calculated for.
+    std::string fingerprint;
+    uint64_t checksum;
+  };
+
+  std::mutex checksum_cache_mutex_;
+  std::unordered_map<TabletId, CachedChecksum> checksum_cache_;
 };
 
 class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
@@ -196,6 +247,14 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
                     DeleteTabletResponsePB* resp,
                     rpc::RpcContext context) override;
 
+  void CreateTablets(const CreateTabletsRequestPB* req,
+                     CreateTabletsResponsePB* resp,
+                     rpc::RpcContext context) override;
+
+  void DeleteTablets(const DeleteTabletsRequestPB* req,
+                     DeleteTabletsResponsePB* resp,
+                     rpc::RpcContext context) override;
+
   void AlterSchema(const ChangeMetadataRequestPB* req,
                    ChangeMetadataResponsePB* resp,
                    rpc::RpcContext context) override;
@@ -243,6 +302,13 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
       rpc::RpcContext context) override;
 
  private:
+  // Implementation of CreateTablet and DeleteTablet for a single tablet. On failure, code is set
+  // to the error code of the response.
+  CHECKED_STATUS DoCreateTablet(const CreateTabletRequestPB& req, const std::string& requestor,
+                                TabletServerErrorPB::Code* code);
+  CHECKED_STATUS DoDeleteTablet(const DeleteTabletRequestPB& req, const std::string& requestor,
+                                TabletServerErrorPB::Code* code);
+
   TabletServer* server_;
 
   // Used to implement wait/signal mechanism for backfill requests.
@@ -264,6 +330,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                consensus::ConsensusResponsePB *resp,
                                rpc::RpcContext context) override;
 
+  void MultiRaftUpdateConsensus(const consensus::MultiRaftConsensusRequestPB* req,
+                                consensus::MultiRaftConsensusResponsePB* resp,
+                                rpc::RpcContext context) override;
+
   virtual void RequestConsensusVote(const consensus::VoteRequestPB* req,
                                     consensus::VoteResponsePB* resp,
                                     rpc::RpcContext context) override;
@@ -301,6 +371,12 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                                     rpc::RpcContext context) override;
 
  private:
+  // Applies the update to the consensus of the tablet and fills the response on success.
+  CHECKED_STATUS UpdateTabletConsensus(
+      const std::shared_ptr<tablet::TabletPeer>& tablet_peer, consensus::Consensus* consensus,
+      consensus::ConsensusRequestPB* req, consensus::ConsensusResponsePB* resp,
+      CoarseTimePoint deadline);
+
   TabletPeerLookupIf* tablet_manager_;
 };
 
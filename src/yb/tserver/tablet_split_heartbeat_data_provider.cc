@@ -15,16 +15,26 @@
 
 #include "yb/master/master.pb.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/service_util.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 
 DEFINE_int32(tablet_split_monitor_heartbeat_interval_ms, 5000,
              "Interval (in milliseconds) at which tserver check tablets and sends a list of "
              "tablets to split in a heartbeat to master.");
 
+DEFINE_int32(tablet_split_load_sustained_intervals, 3,
+             "Number of consecutive tablet split monitor intervals during which tablet write rate "
+             "should be above the threshold received from master, before tablet is split because "
+             "of its load.");
+TAG_FLAG(tablet_split_load_sustained_intervals, advanced);
+TAG_FLAG(tablet_split_load_sustained_intervals, runtime);
+
 using namespace std::literals;
 
 namespace yb {
@@ -36,12 +46,12 @@ TabletSplitHeartbeatDataProvider::TabletSplitHeartbeatDataProvider(TabletServer*
 
 void TabletSplitHeartbeatDataProvider::DoAddData(
     const master::TSHeartbeatResponsePB& last_resp, master::TSHeartbeatRequestPB* req) {
-  if (!last_resp.has_tablet_split_size_threshold_bytes()) {
-    return;
-  }
   const auto split_size_threshold = last_resp.tablet_split_size_threshold_bytes();
-  VLOG_WITH_FUNC(2) << "split_size_threshold: " << split_size_threshold;
-  if (split_size_threshold <= 0) {
+  const auto write_rows_per_sec_threshold = last_resp.tablet_split_write_rows_per_sec_threshold();
+  VLOG_WITH_FUNC(2) << "split_size_threshold: " << split_size_threshold
+                    << ", write_rows_per_sec_threshold: " << write_rows_per_sec_threshold;
+  UpdateWriteLoads(write_rows_per_sec_threshold);
+  if (split_size_threshold <= 0 && write_rows_per_sec_threshold <= 0) {
     return;
   }
 
@@ -54,22 +64,30 @@ void TabletSplitHeartbeatDataProvider::DoAddData(
       continue;
     }
     const auto& tablet = tablet_peer->shared_tablet();
-    if (!tablet || !tablet->metadata() ||
+    if (!tablet) {
+      continue;
+    }
+    const bool over_size_threshold =
+        split_size_threshold > 0 &&
+        tablet->GetCurrentVersionSstFilesSize() >= split_size_threshold;
+    const bool write_load_sustained = IsWriteLoadSustained(tablet->tablet_id());
+    if (!tablet->metadata() ||
         tablet->table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE ||
         // TODO(tsplit): Tablet splitting for colocated tables is not supported.
         tablet->metadata()->colocated() ||
         tablet->metadata()->tablet_data_state() != tablet::TabletDataState::TABLET_DATA_READY ||
-        tablet->GetCurrentVersionSstFilesSize() < split_size_threshold ||
+        (!over_size_threshold && !write_load_sustained) ||
         // TODO(tsplit): We don't split not yet fully compacted post-split tablets for now, since
         // detecting effective middle key and tablet size for such tablets is not yet implemented.
         (tablet->doc_db().key_bounds->IsInitialized() &&
          !tablet->metadata()->has_been_fully_compacted())) {
       VLOG_WITH_FUNC(3) << Format(
-          "Skipping tablet: $0, data state: $1, SST files size: $2, has key bounds: $3, has been "
-          "fully compacted: $4",
+          "Skipping tablet: $0, data state: $1, SST files size: $2, write load sustained: $3, "
+          "has key bounds: $4, has been fully compacted: $5",
           tablet->tablet_id(),
           tablet->metadata() ? AsString(tablet->metadata()->tablet_data_state()) : "NONE",
-          tablet->GetCurrentVersionSstFilesSize(), tablet->doc_db().key_bounds->IsInitialized(),
+          tablet->GetCurrentVersionSstFilesSize(), write_load_sustained,
+          tablet->doc_db().key_bounds->IsInitialized(),
           tablet->metadata()->has_been_fully_compacted());
       continue;
     }
@@ -101,13 +119,58 @@ void TabletSplitHeartbeatDataProvider::DoAddData(
       tablet_for_split->set_split_partition_key(*split_encoded_key);
     }
     VLOG_WITH_FUNC(1) << Format(
-        "Found tablet to split: $0, size: $1", tablet->tablet_id(),
-        tablet->GetCurrentVersionSstFilesSize());
+        "Found tablet to split: $0, size: $1, write load sustained: $2", tablet->tablet_id(),
+        tablet->GetCurrentVersionSstFilesSize(), write_load_sustained);
+    // Start counting from scratch, so the same tablet is not proposed again until its write load
+    // is sustained for a new series of intervals.
+    write_loads_.erase(tablet_id);
     // TODO(tsplit): remove this return after issue with splitting more than one tablet "at once"
     // is fixed.
     return;
   }
 }
 
+void TabletSplitHeartbeatDataProvider::UpdateWriteLoads(int64_t write_rows_per_sec_threshold) {
+  if (write_rows_per_sec_threshold <= 0) {
+    write_loads_.clear();
+    return;
+  }
+
+  const auto now = CoarseMonoClock::Now();
+  std::unordered_map<TabletId, WriteLoad> new_write_loads;
+  for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
+    if (!tablet_peer->CheckRunning().ok() || !LeaderTerm(*tablet_peer).ok()) {
+      continue;
+    }
+    const auto& tablet = tablet_peer->shared_tablet();
+    if (!tablet || !tablet->metrics()) {
+      continue;
+    }
+    const auto& tablet_id = tablet->tablet_id();
+    WriteLoad load;
+    load.rows_inserted = tablet->metrics()->rows_inserted->value();
+    load.sample_time = now;
+    auto it = write_loads_.find(tablet_id);
+    if (it != write_loads_.end()) {
+      const auto seconds = MonoDelta(now - it->second.sample_time).ToSeconds();
+      const auto rows = load.rows_inserted - it->second.rows_inserted;
+      if (seconds > 0 && rows >= write_rows_per_sec_threshold * seconds) {
+        load.hot_intervals = it->second.hot_intervals + 1;
+      }
+      VLOG_WITH_FUNC(3) << Format(
+          "Tablet: $0, rows written: $1, seconds: $2, hot intervals: $3", tablet_id, rows,
+          seconds, load.hot_intervals);
+    }
+    new_write_loads.emplace(tablet_id, load);
+  }
+  write_loads_ = std::move(new_write_loads);
+}
+
+bool TabletSplitHeartbeatDataProvider::IsWriteLoadSustained(const TabletId& tablet_id) const {
+  auto it = write_loads_.find(tablet_id);
+  return it != write_loads_.end() &&
+         it->second.hot_intervals >= std::max(FLAGS_tablet_split_load_sustained_intervals, 1);
+}
+
 } // namespace tserver
 } // namespace yb
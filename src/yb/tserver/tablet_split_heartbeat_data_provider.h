@@ -15,7 +15,9 @@
 #define YB_TSERVER_TABLET_SPLIT_HEARTBEAT_DATA_PROVIDER_H
 
 #include <memory>
+#include <unordered_map>
 
+#include "yb/common/entity_ids.h"
 #include "yb/tserver/heartbeater.h"
 
 namespace yb {
@@ -28,6 +30,22 @@ class TabletSplitHeartbeatDataProvider : public PeriodicalHeartbeatDataProvider
  private:
   void DoAddData(
       const master::TSHeartbeatResponsePB& last_resp, master::TSHeartbeatRequestPB* req) override;
+
+  // Samples number of rows written to leader tablets and updates write_loads_. Tablets that are
+  // no longer present are dropped from write_loads_.
+  void UpdateWriteLoads(int64_t write_rows_per_sec_threshold);
+
+  // Returns true if tablet has been written at a rate above the threshold for at least
+  // FLAGS_tablet_split_load_sustained_intervals intervals in a row.
+  bool IsWriteLoadSustained(const TabletId& tablet_id) const;
+
+  struct WriteLoad {
+    int64_t rows_inserted = 0;
+    CoarseTimePoint sample_time;
+    int hot_intervals = 0;
+  };
+
+  std::unordered_map<TabletId, WriteLoad> write_loads_;
 };
 
 } // namespace tserver
@@ -58,6 +58,7 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(TEST_pretend_memory_exceeded_enforce_flush);
+DECLARE_bool(use_shared_tablet_pool);
 
 namespace yb {
 namespace tserver {
@@ -165,6 +166,25 @@ TEST_F(TsTabletManagerTest, TestCreateTablet) {
   ASSERT_EQ(kTabletId, peer->tablet()->tablet_id());
 }
 
+TEST_F(TsTabletManagerTest, TestSharedTabletPool) {
+  mini_server_->Shutdown();
+  FLAGS_use_shared_tablet_pool = true;
+  CreateMiniTabletServer();
+  ASSERT_OK(mini_server_->Start());
+  mini_server_->FailHeartbeats();
+  tablet_manager_ = mini_server_->server()->tablet_manager();
+
+  ASSERT_EQ(tablet_manager_->raft_pool(), tablet_manager_->tablet_prepare_pool());
+  ASSERT_EQ(tablet_manager_->raft_pool(), tablet_manager_->append_pool());
+
+  // Tablets should become leaders, while Raft, prepare and append tasks share the pool.
+  for (int i = 0; i != 3; ++i) {
+    std::shared_ptr<TabletPeer> peer;
+    ASSERT_OK(CreateNewTablet(Format("$0-$1", kTabletId, i), schema_, &peer));
+    ASSERT_OK(peer->consensus()->WaitUntilLeaderForTests(MonoDelta::FromSeconds(10)));
+  }
+}
+
 TEST_F(TsTabletManagerTest, TestTombstonedTabletsAreUnregistered) {
   const std::string kTableId = "my-table-id";
   const std::string kTabletId1 = "my-tablet-id-1";
@@ -49,7 +49,9 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
+#include "yb/consensus/log_sync_group.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -68,6 +70,7 @@
 #include "yb/master/sys_catalog.h"
 
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/persistent_cache.h"
 
 #include "yb/rpc/messenger.h"
 
@@ -124,6 +127,17 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_bool(db_block_cache_use_clock, false,
+            "Use CLOCK eviction policy instead of LRU for the block cache. Hits in CLOCK cache "
+            "do not take an exclusive lock on the cache shard.");
+TAG_FLAG(db_block_cache_use_clock, advanced);
+
+DEFINE_string(tserver_meta_cache_snapshot_file, "",
+              "File that tablet locations cached by the tablet server client are saved to on "
+              "shutdown and loaded from on start, so tablets do not have to be looked up through "
+              "the master after restart. Disabled when empty.");
+TAG_FLAG(tserver_meta_cache_snapshot_file, advanced);
+
 DEFINE_bool(enable_log_cache_gc, true,
             "Set to true to enable log cache garbage collector.");
 
@@ -181,10 +195,32 @@ DEFINE_int32(flush_background_task_interval_msec, 0,
              "This defaults to 0, which means disable the background task "
              "And only use callbacks on memstore allocations. ");
 
+DEFINE_int32(tablet_hibernation_idle_time_sec, 0,
+             "Tablets that were not read or written for this time are hibernated: memtables are "
+             "flushed, table readers of SST files and log cache are released. The tablet keeps "
+             "participating in Raft, and leaves hibernation on the next read or write. "
+             "0 to disable, could only be enabled at startup.");
+TAG_FLAG(tablet_hibernation_idle_time_sec, advanced);
+TAG_FLAG(tablet_hibernation_idle_time_sec, runtime);
+
+DEFINE_int32(tablet_hibernation_check_interval_ms, 60000,
+             "How often tablets are checked for hibernation, "
+             "see tablet_hibernation_idle_time_sec.");
+TAG_FLAG(tablet_hibernation_check_interval_ms, advanced);
+
 DEFINE_int64(global_memstore_size_percentage, 10,
              "Percentage of total available memory to use for the global memstore. "
              "Default is 10. See also memstore_size_mb and "
              "global_memstore_size_mb_max.");
+DEFINE_int32(memstore_flush_age_weight_sec, 0,
+             "When the global memstore limit is reached, the tablet to flush is chosen by the "
+             "size of its mutable memtables multiplied by 1 + age / memstore_flush_age_weight_sec, "
+             "where age is the time since the oldest write in them. So big memtables are flushed "
+             "first, while old ones, that retain the WAL, are eventually flushed too. 0 means that "
+             "the tablet with the oldest write is flushed, regardless of its memtable size.");
+TAG_FLAG(memstore_flush_age_weight_sec, advanced);
+TAG_FLAG(memstore_flush_age_weight_sec, runtime);
+
 DEFINE_int64(global_memstore_size_mb_max, 2048,
              "Global memstore size is determined as a percentage of the available "
              "memory. However, this flag limits it in absolute size. Value of 0 "
@@ -200,6 +236,46 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_int64(db_index_and_filter_block_cache_size_bytes, 0,
+             "Size of cross-tablet shared RocksDB cache for index and filter blocks (in bytes), "
+             "in addition to the block cache. When set, index and filter blocks are not evicted "
+             "by data blocks, and top level of multi-level index is kept in memory while the "
+             "SST file is open. Value of 0 means that index and filter blocks are stored in the "
+             "block cache.");
+TAG_FLAG(db_index_and_filter_block_cache_size_bytes, advanced);
+
+DEFINE_int32(db_table_cache_max_open_tables, 0,
+             "Maximum number of SST files kept open by all tablets of this server, using the "
+             "cross-tablet shared table cache with LRU eviction. Each open SST keeps its base and "
+             "data files open. Value of 0 means that each RocksDB instance has own table cache, "
+             "limited by its max_open_files.");
+TAG_FLAG(db_table_cache_max_open_tables, advanced);
+
+DEFINE_string(db_persistent_cache_path, "",
+              "Directory for cross-tablet shared persistent block cache, that should be located "
+              "on a fast local device. Blocks read from SST files are stored there, and looked up "
+              "there on a block cache miss. Contents of this directory are removed on startup. "
+              "Empty value disables persistent cache.");
+TAG_FLAG(db_persistent_cache_path, advanced);
+
+DEFINE_int64(db_persistent_cache_size_bytes, 0,
+             "Size of persistent block cache (in bytes), used when db_persistent_cache_path is "
+             "set.");
+TAG_FLAG(db_persistent_cache_size_bytes, advanced);
+
+DEFINE_bool(log_sync_per_disk, false,
+            "Combine WAL syncs of all tablets located on the same disk into a single file system "
+            "sync, instead of syncing WAL of each tablet separately. Applies both to periodic "
+            "syncs and to syncs of each write with durable_wal_write.");
+TAG_FLAG(log_sync_per_disk, advanced);
+
+DEFINE_bool(use_shared_tablet_pool, false,
+            "Run Raft, prepare and WAL append tasks of all tablets on one thread pool, instead of "
+            "a separate pool for each kind of task. Tasks of each tablet are still serialized by "
+            "their own tokens, but idle threads are reused by all kinds of tasks, so the server "
+            "runs fewer threads.");
+TAG_FLAG(use_shared_tablet_pool, advanced);
+
 DEFINE_int32(read_pool_max_threads, 128,
              "The maximum number of threads allowed for read_pool_. This pool is used "
              "to run multiple read operations, that are part of the same tablet rpc, "
@@ -208,6 +284,17 @@ DEFINE_int32(read_pool_max_queue_size, 128,
              "The maximum number of tasks that can be held in the queue for read_pool_. This pool "
              "is used to run multiple read operations, that are part of the same tablet rpc, "
              "in parallel.");
+DEFINE_bool(read_pool_per_data_dir, false,
+            "Use a separate read pool for tablets of each data root dir, so slow disk does not "
+            "exhaust threads used by tablets on other disks. Each pool is limited by "
+            "read_pool_max_threads and read_pool_max_queue_size.");
+TAG_FLAG(read_pool_per_data_dir, advanced);
+
+DEFINE_bool(tablet_placement_by_free_space, false,
+            "When a new tablet could be placed to several data or WAL root dirs with the same "
+            "number of tablets of its table, place it to the dir with the most free disk space.");
+TAG_FLAG(tablet_placement_by_free_space, advanced);
+TAG_FLAG(tablet_placement_by_free_space, runtime);
 
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
@@ -329,19 +416,81 @@ void TSTabletManager::MaybeFlushTablet() {
   }
 }
 
+// Only called from the hibernation task.
+void TSTabletManager::HibernateIdleTablets() {
+  const auto idle_time_sec = FLAGS_tablet_hibernation_idle_time_sec;
+  if (idle_time_sec <= 0) {
+    return;
+  }
+  const auto idle_since = CoarseMonoClock::now() - idle_time_sec * 1s;
+  std::vector<TabletPeerPtr> peers;
+  {
+    SharedLock<RWMutex> lock(mutex_);
+    for (const auto& entry : tablet_map_) {
+      const auto tablet = entry.second->shared_tablet();
+      if (tablet && !tablet->hibernated() && tablet->last_access_time() < idle_since) {
+        peers.push_back(entry.second);
+      }
+    }
+  }
+
+  for (const auto& peer : peers) {
+    const auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    auto status = tablet->Hibernate();
+    if (!status.ok()) {
+      LOG(WARNING) << TabletLogPrefix(peer->tablet_id()) << "Hibernate failed: " << status;
+      continue;
+    }
+    auto consensus = peer->shared_consensus();
+    if (consensus) {
+      down_cast<consensus::RaftConsensus*>(consensus.get())->EvictLogCache(
+          std::numeric_limits<int64_t>::max());
+    }
+  }
+}
+
+ThreadPool* TSTabletManager::read_pool(const std::string& data_root_dir) const {
+  auto it = data_dir_read_pools_.find(data_root_dir);
+  return it != data_dir_read_pools_.end() ? it->second.get() : read_pool_.get();
+}
+
 // Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
-// empty or about to flush.
+// empty or about to flush. See memstore_flush_age_weight_sec for the case when memtable size is
+// also taken into account.
 TabletPeerPtr TSTabletManager::TabletToFlush() {
+  const auto age_weight_sec = FLAGS_memstore_flush_age_weight_sec;
+  const auto now = server_->clock()->Now();
   SharedLock<RWMutex> lock(mutex_); // For using the tablet map
   HybridTime oldest_write_in_memstores = HybridTime::kMax;
+  double best_score = 0;
   TabletPeerPtr tablet_to_flush;
   for (const TabletMap::value_type& entry : tablet_map_) {
     const auto tablet = entry.second->shared_tablet();
     if (tablet) {
       const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
       if (ht.ok()) {
-        if (*ht < oldest_write_in_memstores) {
-          oldest_write_in_memstores = *ht;
+        if (age_weight_sec <= 0) {
+          if (*ht < oldest_write_in_memstores) {
+            oldest_write_in_memstores = *ht;
+            tablet_to_flush = entry.second;
+          }
+          continue;
+        }
+        if (*ht == HybridTime::kMax) {
+          continue;
+        }
+        const auto size = tablet->MutableMemtablesSize();
+        if (!size.ok()) {
+          continue;
+        }
+        const auto age_sec = std::max<int64_t>(
+            now.GetPhysicalValueMicros() - ht->GetPhysicalValueMicros(), 0) / 1e6;
+        const auto score = *size * (1.0 + age_sec / age_weight_sec);
+        if (score > best_score) {
+          best_score = score;
           tablet_to_flush = entry.second;
         }
       } else {
@@ -418,28 +567,48 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
   // "number of CPUs" may cause blocking tasks to starve other "fast" tasks).
   // However, the effective upper bound is the number of replicas as each will
   // submit its own tasks via a dedicated token.
-  CHECK_OK(ThreadPoolBuilder("raft")
-               .set_min_threads(1)
-               .unlimited_threads()
-               .Build(&raft_pool_));
-  CHECK_OK(ThreadPoolBuilder("prepare")
-               .set_min_threads(1)
-               .unlimited_threads()
-               .Build(&tablet_prepare_pool_));
-  CHECK_OK(ThreadPoolBuilder("append")
-               .set_min_threads(1)
-               .unlimited_threads()
-               .set_idle_timeout(MonoDelta::FromMilliseconds(10000))
-               .Build(&append_pool_));
+  if (FLAGS_use_shared_tablet_pool) {
+    CHECK_OK(ThreadPoolBuilder("tablet")
+                 .set_min_threads(1)
+                 .unlimited_threads()
+                 .set_idle_timeout(MonoDelta::FromMilliseconds(10000))
+                 .Build(&shared_tablet_pool_));
+  } else {
+    CHECK_OK(ThreadPoolBuilder("raft")
+                 .set_min_threads(1)
+                 .unlimited_threads()
+                 .Build(&raft_pool_));
+    CHECK_OK(ThreadPoolBuilder("prepare")
+                 .set_min_threads(1)
+                 .unlimited_threads()
+                 .Build(&tablet_prepare_pool_));
+    CHECK_OK(ThreadPoolBuilder("append")
+                 .set_min_threads(1)
+                 .unlimited_threads()
+                 .set_idle_timeout(MonoDelta::FromMilliseconds(10000))
+                 .Build(&append_pool_));
+  }
   CHECK_OK(ThreadPoolBuilder("log-alloc")
                .set_min_threads(1)
                .unlimited_threads()
                .Build(&allocation_pool_));
+  if (FLAGS_log_sync_per_disk) {
+    log_sync_groups_ = std::make_unique<log::LogSyncGroups>(fs_manager_->env());
+  }
   ThreadPoolMetrics read_metrics = {
       METRIC_op_read_queue_length.Instantiate(server_->metric_entity()),
       METRIC_op_read_queue_time.Instantiate(server_->metric_entity()),
       METRIC_op_read_run_time.Instantiate(server_->metric_entity())
   };
+  if (FLAGS_read_pool_per_data_dir) {
+    for (const auto& data_root_dir : fs_manager_->GetDataRootDirs()) {
+      CHECK_OK(ThreadPoolBuilder("read-parallel")
+                   .set_max_threads(FLAGS_read_pool_max_threads)
+                   .set_max_queue_size(FLAGS_read_pool_max_queue_size)
+                   .set_metrics(read_metrics)
+                   .Build(&data_dir_read_pools_[data_root_dir]));
+    }
+  }
   CHECK_OK(ThreadPoolBuilder("read-parallel")
                .set_max_threads(FLAGS_read_pool_max_threads)
                .set_max_queue_size(FLAGS_read_pool_max_queue_size)
@@ -460,17 +629,42 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
     block_cache_size_bytes = total_ram_avail * FLAGS_db_block_cache_size_percentage / 100;
   }
 
+  const bool use_index_and_filter_block_cache =
+      FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled &&
+      FLAGS_db_index_and_filter_block_cache_size_bytes > 0;
   block_based_table_mem_tracker_ = MemTracker::FindOrCreateTracker(
-      block_cache_size_bytes, "BlockBasedTable", server_->mem_tracker());
+      block_cache_size_bytes +
+          (use_index_and_filter_block_cache ? FLAGS_db_index_and_filter_block_cache_size_bytes : 0),
+      "BlockBasedTable", server_->mem_tracker());
 
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                       FLAGS_db_block_cache_num_shard_bits);
+    tablet_options_.block_cache = FLAGS_db_block_cache_use_clock
+        ? rocksdb::NewClockCache(block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits)
+        : rocksdb::NewLRUCache(block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits);
     tablet_options_.block_cache->SetMetrics(server_->metric_entity());
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(tablet_options_.block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
   }
 
+  // Garbage collector is not registered for this cache, so data blocks are evicted first when
+  // memory is needed, and it is bounded by its own capacity.
+  if (use_index_and_filter_block_cache) {
+    tablet_options_.index_and_filter_block_cache = rocksdb::NewLRUCache(
+        FLAGS_db_index_and_filter_block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits);
+    tablet_options_.index_and_filter_block_cache->SetMetrics(server_->metric_entity());
+  }
+
+  if (FLAGS_db_table_cache_max_open_tables > 0) {
+    tablet_options_.table_cache = rocksdb::NewLRUCache(
+        FLAGS_db_table_cache_max_open_tables, FLAGS_db_block_cache_num_shard_bits);
+  }
+
+  if (!FLAGS_db_persistent_cache_path.empty() && FLAGS_db_persistent_cache_size_bytes > 0) {
+    CHECK_OK(rocksdb::NewFilePersistentCache(
+        server_->GetRocksDBEnv(), FLAGS_db_persistent_cache_path,
+        FLAGS_db_persistent_cache_size_bytes, &tablet_options_.persistent_cache));
+  }
+
   auto log_cache_mem_tracker = consensus::LogCache::GetServerMemTracker(server_->mem_tracker());
   log_cache_gc_ = std::make_shared<FunctorGC>(
       std::bind(&TSTabletManager::LogCacheGC, this, log_cache_mem_tracker.get(), _1));
@@ -502,6 +696,14 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
         std::function<void()>([this](){
                                 YB_WARN_NOT_OK(background_task_->Wake(), "Wakeup error"); }));
   }
+
+  if (FLAGS_tablet_hibernation_idle_time_sec > 0) {
+    hibernation_task_ = std::make_unique<BackgroundTask>(
+        std::function<void()>([this] { HibernateIdleTablets(); }),
+        "tablet manager",
+        "tablet hibernation bgtask",
+        std::chrono::milliseconds(FLAGS_tablet_hibernation_check_interval_ms));
+  }
 }
 
 TSTabletManager::~TSTabletManager() {
@@ -521,12 +723,20 @@ Status TSTabletManager::Init() {
     if (tserver != nullptr && tserver->proxy() != nullptr) {
       client->SetLocalTabletServer(tserver->permanent_uuid(), tserver->proxy(), tserver);
     }
+    if (!FLAGS_tserver_meta_cache_snapshot_file.empty()) {
+      auto status = client->LoadMetaCacheSnapshot(FLAGS_tserver_meta_cache_snapshot_file);
+      LOG_IF(WARNING, !status.ok() && !status.IsNotFound())
+          << "Failed to load meta cache snapshot: " << status;
+    }
   });
 
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
   tablet_options_.listeners = server_->options().listeners;
 
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache());
+
   // Start the threadpool we'll use to open tablets.
   // This has to be done in Init() instead of the constructor, since the
   // FsManager isn't initialized until this point.
@@ -610,6 +820,9 @@ Status TSTabletManager::Init() {
   if (background_task_) {
     RETURN_NOT_OK(background_task_->Init());
   }
+  if (hibernation_task_) {
+    RETURN_NOT_OK(hibernation_task_->Init());
+  }
 
   return Status::OK();
 }
@@ -1400,6 +1613,7 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .listener = tablet_peer->status_listener(),
       .append_pool = append_pool(),
       .allocation_pool = allocation_pool_.get(),
+      .log_sync_groups = log_sync_groups_.get(),
       .retryable_requests = &retryable_requests,
     };
     s = BootstrapTablet(data, &tablet, &log, &bootstrap_info);
@@ -1423,7 +1637,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
         raft_pool(),
         tablet_prepare_pool(),
         &retryable_requests,
-        yb::OpId::FromPB(bootstrap_info.split_op_id));
+        yb::OpId::FromPB(bootstrap_info.split_op_id),
+        multi_raft_manager_.get());
 
     if (!s.ok()) {
       LOG(ERROR) << kLogPrefix << "Tablet failed to init: "
@@ -1455,11 +1670,22 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
 }
 
 void TSTabletManager::StartShutdown() {
+  if (!FLAGS_tserver_meta_cache_snapshot_file.empty()) {
+    const auto& client_future = async_client_init_->get_client_future();
+    if (client_future.wait_for(0s) == std::future_status::ready && client_future.get()) {
+      WARN_NOT_OK(
+          client_future.get()->SaveMetaCacheSnapshot(FLAGS_tserver_meta_cache_snapshot_file),
+          "Failed to save meta cache snapshot");
+    }
+  }
   async_client_init_->Shutdown();
 
   if (background_task_) {
     background_task_->Shutdown();
   }
+  if (hibernation_task_) {
+    hibernation_task_->Shutdown();
+  }
 
   {
     std::lock_guard<RWMutex> lock(mutex_);
@@ -1537,6 +1763,9 @@ void TSTabletManager::CompleteShutdown() {
   if (append_pool_) {
     append_pool_->Shutdown();
   }
+  if (shared_tablet_pool_) {
+    shared_tablet_pool_->Shutdown();
+  }
 
   {
     std::lock_guard<RWMutex> l(mutex_);
@@ -1964,23 +2193,13 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
   }
   // Find the data directory with the least count of tablets for this table.
   table_data_assignment_iter = table_data_assignment_map_.find(table_id);
-  auto data_assignment_value_map = table_data_assignment_iter->second;
-  string min_dir;
-  uint64_t min_dir_count = kuint64max;
-  for (auto it = data_assignment_value_map.begin(); it != data_assignment_value_map.end(); ++it) {
-    if (min_dir_count > it->second.size()) {
-      min_dir = it->first;
-      min_dir_count = it->second.size();
-    }
-  }
+  string min_dir = SelectRootDir(fs_manager, table_data_assignment_iter->second);
   *data_root_dir = min_dir;
   // Increment the count for min_dir.
   auto data_assignment_value_iter = table_data_assignment_map_[table_id].find(min_dir);
   data_assignment_value_iter->second.insert(tablet_id);
 
   // Find the wal directory with the least count of tablets for this table.
-  min_dir = "";
-  min_dir_count = kuint64max;
   auto wal_root_dirs = fs_manager->GetWalRootDirs();
   CHECK(!wal_root_dirs.empty()) << "No wal root directories found";
   auto table_wal_assignment_iter = table_wal_assignment_map_.find(table_id);
@@ -1991,13 +2210,7 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
     }
   }
   table_wal_assignment_iter = table_wal_assignment_map_.find(table_id);
-  auto wal_assignment_value_map = table_wal_assignment_iter->second;
-  for (auto it = wal_assignment_value_map.begin(); it != wal_assignment_value_map.end(); ++it) {
-    if (min_dir_count > it->second.size()) {
-      min_dir = it->first;
-      min_dir_count = it->second.size();
-    }
-  }
+  min_dir = SelectRootDir(fs_manager, table_wal_assignment_iter->second);
   *wal_root_dir = min_dir;
   auto wal_assignment_value_iter = table_wal_assignment_map_[table_id].find(min_dir);
   wal_assignment_value_iter->second.insert(tablet_id);
@@ -2059,6 +2272,38 @@ void TSTabletManager::RegisterDataAndWalDir(FsManager* fs_manager,
   }
 }
 
+std::string TSTabletManager::SelectRootDir(
+    FsManager* fs_manager, const TabletIdSetByDirectoryMap& tablets_by_dir) {
+  const bool by_free_space = FLAGS_tablet_placement_by_free_space;
+  string min_dir;
+  uint64_t min_dir_count = kuint64max;
+  uint64_t min_dir_free_space = 0;
+  for (const auto& dir_and_tablets : tablets_by_dir) {
+    const auto count = dir_and_tablets.second.size();
+    if (count > min_dir_count || (count == min_dir_count && !by_free_space)) {
+      continue;
+    }
+    uint64_t free_space = 0;
+    if (by_free_space) {
+      auto free_space_result = fs_manager->env()->GetFreeSpaceBytes(dir_and_tablets.first);
+      if (free_space_result.ok()) {
+        free_space = *free_space_result;
+      } else {
+        YB_LOG_EVERY_N_SECS(WARNING, 10)
+            << "Failed to get free space of " << dir_and_tablets.first << ": "
+            << free_space_result.status();
+      }
+      if (count == min_dir_count && free_space <= min_dir_free_space) {
+        continue;
+      }
+    }
+    min_dir = dir_and_tablets.first;
+    min_dir_count = count;
+    min_dir_free_space = free_space;
+  }
+  return min_dir;
+}
+
 TSTabletManager::TableDiskAssignmentMap* TSTabletManager::GetTableDiskAssignmentMapUnlocked(
     TabletDirType dir_type) {
   switch (dir_type) {
@@ -76,6 +76,10 @@ class Partition;
 class Schema;
 class BackgroundTask;
 
+namespace log {
+class LogSyncGroups;
+}
+
 namespace consensus {
 class RaftConfigPB;
 } // namespace consensus
@@ -150,10 +154,14 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Completes shutdown process and waits for it's completeness.
   void CompleteShutdown();
 
-  ThreadPool* tablet_prepare_pool() const { return tablet_prepare_pool_.get(); }
-  ThreadPool* raft_pool() const { return raft_pool_.get(); }
+  ThreadPool* tablet_prepare_pool() const { return PoolOrShared(tablet_prepare_pool_); }
+  ThreadPool* raft_pool() const { return PoolOrShared(raft_pool_); }
   ThreadPool* read_pool() const { return read_pool_.get(); }
-  ThreadPool* append_pool() const { return append_pool_.get(); }
+
+  // Returns read pool for tablets located at the specified data root dir, see
+  // read_pool_per_data_dir. Falls back to the shared read pool.
+  ThreadPool* read_pool(const std::string& data_root_dir) const;
+  ThreadPool* append_pool() const { return PoolOrShared(append_pool_); }
 
   // Create a new tablet and register it with the tablet manager. The new tablet
   // is persisted on disk and opened before this method returns.
@@ -305,6 +313,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Flush some tablet if the memstore memory limit is exceeded
   void MaybeFlushTablet();
 
+  // Hibernate tablets that were not accessed for tablet_hibernation_idle_time_sec.
+  void HibernateIdleTablets();
+
   client::YBClient& client();
 
   tablet::TabletOptions* TEST_tablet_options() { return &tablet_options_; }
@@ -323,6 +334,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   typedef std::unordered_set<TabletId> TabletIdUnorderedSet;
 
+  ThreadPool* PoolOrShared(const std::unique_ptr<ThreadPool>& pool) const {
+    return shared_tablet_pool_ ? shared_tablet_pool_.get() : pool.get();
+  }
+
   // Maps directory to set of tablets (IDs) using that directory.
   typedef std::unordered_map<std::string, TabletIdUnorderedSet> TabletIdSetByDirectoryMap;
 
@@ -403,6 +418,12 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Returns either table_data_assignment_map_ or table_wal_assignment_map_ depending on dir_type.
   TableDiskAssignmentMap* GetTableDiskAssignmentMapUnlocked(TabletDirType dir_type);
 
+  // Returns the root dir with the least number of tablets of the table. When
+  // tablet_placement_by_free_space is set, ties are broken by free space on the disk of the dir,
+  // instead of the order of dirs.
+  static std::string SelectRootDir(
+      FsManager* fs_manager, const TabletIdSetByDirectoryMap& tablets_by_dir);
+
   // Returns assigned root dir of specified type for specified table and tablet.
   // If root dir is not registered for the specified table_id and tablet_id combination - returns
   // error.
@@ -522,18 +543,33 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool for Raft-related operations, shared between all tablets.
   std::unique_ptr<ThreadPool> raft_pool_;
 
+  // Batches heartbeats of tablets led by this server.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // Thread pool for appender threads, shared between all tablets.
   std::unique_ptr<ThreadPool> append_pool_;
 
+  // Replaces raft, prepare and append pools when use_shared_tablet_pool is set.
+  std::unique_ptr<ThreadPool> shared_tablet_pool_;
+
   // Thread pool for log allocation threads, shared between all tablets.
   std::unique_ptr<ThreadPool> allocation_pool_;
 
+  // Sync groups of WAL root directories, used when --log_sync_per_disk is set.
+  std::unique_ptr<log::LogSyncGroups> log_sync_groups_;
+
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
+  // Read pools of data root directories, used when --read_pool_per_data_dir is set.
+  std::unordered_map<std::string, std::unique_ptr<ThreadPool>> data_dir_read_pools_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
+  // Used for hibernating idle tablets, see tablet_hibernation_idle_time_sec.
+  std::unique_ptr<BackgroundTask> hibernation_task_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
@@ -16,7 +16,10 @@
 
 #include <openssl/ossl_typ.h>
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/util/status.h"
 #include "yb/util/result.h"
@@ -72,9 +75,21 @@ class BlockAccessCipherStream {
   void IncrementCounter(const uint64_t start_idx, uint8_t* iv,
                         EncryptionOverflowWorkaround counter_overflow_workaround);
 
+  typedef std::unique_ptr<EVP_CIPHER_CTX, std::function<void(EVP_CIPHER_CTX*)>> ContextPtr;
+
+  static ContextPtr NewContext();
+
+  // Returns context with cipher and key initialized, that is not used by other threads.
+  Result<ContextPtr> TakeContext();
+  void ReturnContext(ContextPtr context);
+
   EncryptionParamsPtr encryption_params_;
-  std::unique_ptr<EVP_CIPHER_CTX, std::function<void(EVP_CIPHER_CTX*)>> encryption_context_;
+  // Context with cipher and key initialized, that is copied to create contexts for concurrent
+  // operations. So key is expanded once per stream, and only the IV is set for each operation.
+  ContextPtr encryption_context_;
   mutable simple_spinlock mutex_;
+  // Contexts that are not used by any thread.
+  std::vector<ContextPtr> free_contexts_ GUARDED_BY(mutex_);
 };
 
 } // namespace enterprise
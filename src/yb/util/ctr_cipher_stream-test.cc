@@ -25,6 +25,7 @@
 #include "yb/util/cipher_stream.h"
 
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -34,6 +35,8 @@ DECLARE_bool(TEST_encryption_use_openssl_compatible_counter_overflow);
 namespace yb {
 namespace enterprise {
 
+using namespace yb::size_literals;
+
 constexpr int kDataSize = 1024;
 constexpr int kNumRuns = 1000;
 
@@ -128,6 +131,44 @@ TEST_F(TestCipherStream, ConcurrentEncryption) {
   }
 }
 
+TEST_F(TestCipherStream, DecryptPerf) {
+  InitOpenSSL();
+
+  constexpr size_t kBlockSize = 32 * 1024;
+  constexpr int kNumBlocks = 2000;
+  constexpr int kNumThreads = 8;
+  auto cipher_stream = ASSERT_RESULT(BlockAccessCipherStream::FromEncryptionParams(
+      EncryptionParams::NewEncryptionParams()));
+  auto plaintext_bytes = RandomBytes(kBlockSize);
+  std::vector<uint8_t> encrypted_bytes(kBlockSize);
+  ASSERT_OK(cipher_stream->Encrypt(
+      0, Slice(plaintext_bytes.data(), kBlockSize), encrypted_bytes.data()));
+
+  for (bool in_place : {false, true}) {
+    auto start = MonoTime::Now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kNumThreads; i++) {
+      threads.emplace_back([&]() {
+        std::vector<uint8_t> buffer(kBlockSize);
+        for (int j = 0; j < kNumBlocks; j++) {
+          if (in_place) {
+            memcpy(buffer.data(), encrypted_bytes.data(), kBlockSize);
+          }
+          const uint8_t* input = in_place ? buffer.data() : encrypted_bytes.data();
+          ASSERT_OK(cipher_stream->Decrypt(0, Slice(input, kBlockSize), buffer.data()));
+        }
+        ASSERT_EQ(Slice(plaintext_bytes.data(), kBlockSize), Slice(buffer.data(), kBlockSize));
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto elapsed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << (in_place ? "In place" : "Separate buffers") << " decryption: "
+              << kBlockSize * kNumBlocks * kNumThreads / 1_MB / elapsed.ToSeconds() << " MB/s";
+  }
+}
+
 TEST_F(TestCipherStream, Overflow) {
   // Create a cipher stream on a iv about to overflow.
   ASSERT_OK(TestOverFlowWithKeyType(true /* use_openssl_compatible_counter_overflow */ ));
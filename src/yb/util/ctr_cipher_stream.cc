@@ -22,6 +22,13 @@
 namespace yb {
 namespace enterprise {
 
+namespace {
+
+// Max number of unused cipher contexts kept by a stream.
+constexpr size_t kMaxFreeContexts = 16;
+
+} // namespace
+
 Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEncryptionParams(
     EncryptionParamsPtr encryption_params) {
   auto stream = std::make_unique<BlockAccessCipherStream>(std::move(encryption_params));
@@ -29,13 +36,17 @@ Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEn
   return stream;
 }
 
+BlockAccessCipherStream::ContextPtr BlockAccessCipherStream::NewContext() {
+  return ContextPtr(EVP_CIPHER_CTX_new(), [](EVP_CIPHER_CTX* ctx){
+    EVP_CIPHER_CTX_cleanup(ctx);
+    EVP_CIPHER_CTX_free(ctx);
+  });
+}
+
 BlockAccessCipherStream::BlockAccessCipherStream(
     EncryptionParamsPtr encryption_params) :
     encryption_params_(std::move(encryption_params)),
-    encryption_context_(EVP_CIPHER_CTX_new(), [](EVP_CIPHER_CTX* ctx){
-      EVP_CIPHER_CTX_cleanup(ctx);
-      EVP_CIPHER_CTX_free(ctx);
-    }) {}
+    encryption_context_(NewContext()) {}
 
 Status BlockAccessCipherStream::Init() {
   EVP_CIPHER_CTX_init(encryption_context_.get());
@@ -56,7 +67,7 @@ Status BlockAccessCipherStream::Init() {
   }
 
   const auto encrypt_init_ex_result = EVP_EncryptInit_ex(
-      encryption_context_.get(), cipher, /* impl */ nullptr, /* key */ nullptr,
+      encryption_context_.get(), cipher, /* impl */ nullptr, encryption_params_->key,
       /* iv */ nullptr);
   if (encrypt_init_ex_result != 1) {
     return STATUS_FORMAT(InternalError,
@@ -74,6 +85,30 @@ Status BlockAccessCipherStream::Init() {
   return Status::OK();
 }
 
+Result<BlockAccessCipherStream::ContextPtr> BlockAccessCipherStream::TakeContext() {
+  {
+    std::lock_guard<simple_spinlock> l(mutex_);
+    if (!free_contexts_.empty()) {
+      auto result = std::move(free_contexts_.back());
+      free_contexts_.pop_back();
+      return result;
+    }
+  }
+  auto result = NewContext();
+  const auto copy_result = EVP_CIPHER_CTX_copy(result.get(), encryption_context_.get());
+  if (copy_result != 1) {
+    return STATUS_FORMAT(InternalError, "EVP_CIPHER_CTX_copy returned $0", copy_result);
+  }
+  return result;
+}
+
+void BlockAccessCipherStream::ReturnContext(ContextPtr context) {
+  std::lock_guard<simple_spinlock> l(mutex_);
+  if (free_contexts_.size() < kMaxFreeContexts) {
+    free_contexts_.push_back(std::move(context));
+  }
+}
+
 Status BlockAccessCipherStream::Encrypt(
     uint64_t file_offset,
     const Slice& input,
@@ -115,7 +150,7 @@ Status BlockAccessCipherStream::Encrypt(
 }
 
 // Decrypt data at the file offset. Since CTR mode uses symmetric XOR operation,
-// just calls Encrypt.
+// just calls Encrypt. Output could be the same buffer as input, to decrypt in place.
 Status BlockAccessCipherStream::Decrypt(
     uint64_t file_offset, const Slice& input, void* output,
     EncryptionOverflowWorkaround counter_overflow_workaround) {
@@ -147,12 +182,13 @@ Status BlockAccessCipherStream::EncryptByBlock(
   const uint64_t start_index = encryption_params_->counter + block_index;
   IncrementCounter(start_index, iv, counter_overflow_workaround);
 
-  // Lock the encryption op since we modify encryption context.
-  std::lock_guard<simple_spinlock> l(mutex_);
+  // Each operation uses its own context, so concurrent operations don't wait for each other.
+  auto context = VERIFY_RESULT(TakeContext());
 
+  // Key schedule is kept by the context, so only set the counter block.
   const int init_result =
-      EVP_EncryptInit_ex(encryption_context_.get(), /* cipher */ nullptr, /* impl */ nullptr,
-                         encryption_params_->key, iv);
+      EVP_EncryptInit_ex(context.get(), /* cipher */ nullptr, /* impl */ nullptr,
+                         /* key */ nullptr, iv);
   if (init_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptInit_ex returned $0 when encrypting/decrypting $1 bytes "
@@ -163,7 +199,7 @@ Status BlockAccessCipherStream::EncryptByBlock(
   // Perform the encryption.
   int bytes_updated = 0;
   const int update_result = EVP_EncryptUpdate(
-      encryption_context_.get(), static_cast<uint8_t*>(output), &bytes_updated, input.data(),
+      context.get(), static_cast<uint8_t*>(output), &bytes_updated, input.data(),
       data_size);
   if (update_result != 1) {
     return STATUS_FORMAT(InternalError,
@@ -179,6 +215,7 @@ Status BlockAccessCipherStream::EncryptByBlock(
 
   }
 
+  ReturnContext(std::move(context));
   return Status::OK();
 }
 
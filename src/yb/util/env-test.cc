@@ -620,6 +620,48 @@ TEST_F(TestEnv, TestReopen) {
   ASSERT_EQ(first + second, s.ToString());
 }
 
+TEST_F(TestEnv, TestReuseExisting) {
+  string test_path = GetTestPath("test_env_wf");
+  string first(kOneMb, 'a');
+  string second = "jumps over the lazy dog";
+
+  shared_ptr<WritableFile> writer;
+  ASSERT_OK(env_util::OpenFileForWrite(WritableFileOptions(), env_.get(), test_path, &writer));
+  ASSERT_OK(writer->Append(first));
+  ASSERT_OK(writer->Close());
+
+  // Reuse the file, its old content should be replaced by zeros.
+  WritableFileOptions reuse_opts;
+  reuse_opts.mode = Env::REUSE_EXISTING;
+  Status status = env_util::OpenFileForWrite(reuse_opts, env_.get(), test_path, &writer);
+  if (status.IsNotSupported()) {
+    LOG(INFO) << "Reusing files is not supported, skipping test: " << status;
+    return;
+  }
+  ASSERT_OK(status);
+  ASSERT_EQ(0, writer->Size());
+  ASSERT_OK(writer->Append(second));
+  ASSERT_OK(writer->Sync());
+  uint64_t size = ASSERT_RESULT(env_->GetFileSize(test_path));
+  ASSERT_EQ(first.length(), size);
+
+  shared_ptr<RandomAccessFile> reader;
+  ASSERT_OK(env_util::OpenFileForRandom(env_.get(), test_path, &reader));
+  std::vector<uint8_t> scratch(first.length());
+  Slice s;
+  ASSERT_OK(env_util::ReadFully(reader.get(), 0, first.length(), &s, scratch.data()));
+  ASSERT_EQ(second + string(first.length() - second.length(), '\0'), s.ToString());
+
+  // Unused space is truncated on close.
+  ASSERT_OK(writer->Close());
+  size = ASSERT_RESULT(env_->GetFileSize(test_path));
+  ASSERT_EQ(second.length(), size);
+
+  // File that does not exist cannot be reused.
+  ASSERT_NOK(env_util::OpenFileForWrite(
+      reuse_opts, env_.get(), GetTestPath("test_env_missing"), &writer));
+}
+
 TEST_F(TestEnv, TestIsDirectory) {
   string dir = GetTestPath("a_directory");
   ASSERT_OK(env_->CreateDir(dir));
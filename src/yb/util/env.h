@@ -185,10 +185,16 @@ class Env {
   // CREATE_IF_NON_EXISTING_TRUNCATE | opens + truncates | creates
   // CREATE_NON_EXISTING             | fails             | creates
   // OPEN_EXISTING                   | opens             | fails
+  // REUSE_EXISTING                  | opens + zeroes    | fails
+  //
+  // REUSE_EXISTING discards content of the file but keeps its space allocated, so file is written
+  // from the beginning without allocating new space. Fails with NotSupported when the platform or
+  // file system cannot zero the file in place.
   enum CreateMode {
     CREATE_IF_NON_EXISTING_TRUNCATE,
     CREATE_NON_EXISTING,
-    OPEN_EXISTING
+    OPEN_EXISTING,
+    REUSE_EXISTING
   };
 
   Env() { }
@@ -304,6 +310,13 @@ class Env {
   // Synchronize the entry for a specific directory.
   virtual CHECKED_STATUS SyncDir(const std::string& dirname) = 0;
 
+  // Synchronize all data and metadata of the file system that contains the specified path, so
+  // a single call could replace fsync of many files located on the same file system.
+  // Returns NotSupported if the platform does not provide such an operation.
+  virtual CHECKED_STATUS SyncFileSystem(const std::string& path) {
+    return STATUS(NotSupported, "File system sync is not supported");
+  }
+
   // Recursively delete the specified directory.
   // This should operate safely, not following any symlinks, etc.
   virtual CHECKED_STATUS DeleteRecursively(const std::string &dirname) = 0;
@@ -730,6 +743,9 @@ class EnvWrapper : public Env {
   CHECKED_STATUS DeleteFile(const std::string& f) override { return target_->DeleteFile(f); }
   CHECKED_STATUS CreateDir(const std::string& d) override { return target_->CreateDir(d); }
   CHECKED_STATUS SyncDir(const std::string& d) override { return target_->SyncDir(d); }
+  CHECKED_STATUS SyncFileSystem(const std::string& path) override {
+    return target_->SyncFileSystem(path);
+  }
   CHECKED_STATUS DeleteDir(const std::string& d) override { return target_->DeleteDir(d); }
   CHECKED_STATUS DeleteRecursively(const std::string& d) override {
     return target_->DeleteRecursively(d);
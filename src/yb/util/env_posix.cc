@@ -77,6 +77,9 @@
 #ifndef FALLOC_FL_PUNCH_HOLE
 #define FALLOC_FL_PUNCH_HOLE  0x02 /* de-allocates range */
 #endif
+#ifndef FALLOC_FL_ZERO_RANGE
+#define FALLOC_FL_ZERO_RANGE  0x10 /* zeroes range keeping it allocated */
+#endif
 
 // For platforms without fdatasync (like OS X)
 #ifndef fdatasync
@@ -240,6 +243,7 @@ static Status DoOpen(const string& filename, Env::CreateMode mode, int* fd, int
       flags |= O_CREAT | O_EXCL;
       break;
     case Env::OPEN_EXISTING:
+    case Env::REUSE_EXISTING:
       break;
     default:
       return STATUS(NotSupported, Substitute("Unknown create mode $0", mode));
@@ -399,6 +403,31 @@ class PosixWritableFile : public WritableFile {
 
   const string& filename() const override { return filename_; }
 
+  // Zeroes the first size bytes of the file keeping them allocated, so they are treated as
+  // preallocated space. Should be invoked before anything is written to the file.
+  // The file is truncated on close, also when zeroing fails.
+  Status ZeroAllocatedSpace(uint64_t size) {
+    TRACE_EVENT1("io", "PosixWritableFile::ZeroAllocatedSpace", "path", filename_);
+    ThreadRestrictions::AssertIOAllowed();
+    DCHECK_EQ(filesize_, 0);
+    if (size == 0) {
+      return Status::OK();
+    }
+    pre_allocated_size_ = size;
+#if defined(__linux__)
+    if (fallocate(fd_, FALLOC_FL_ZERO_RANGE, 0, size) < 0) {
+      if (errno == EOPNOTSUPP || errno == ENOSYS) {
+        return STATUS(NotSupported, "Zeroing range of file is not supported", filename_);
+      }
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    // Make sure that old content does not reappear after crash.
+    return DoSync(fd_, filename_);
+#else
+    return STATUS(NotSupported, "Zeroing range of file is not supported on this platform");
+#endif
+  }
+
  protected:
     const std::string filename_;
     int fd_;
@@ -1041,6 +1070,25 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  Status SyncFileSystem(const std::string& path) override {
+#if defined(__linux__)
+    TRACE_EVENT1("io", "SyncFileSystem", "path", path);
+    ThreadRestrictions::AssertIOAllowed();
+    if (FLAGS_never_fsync) return Status::OK();
+    int fd;
+    if ((fd = open(path.c_str(), O_RDONLY)) == -1) {
+      return STATUS_IO_ERROR(path, errno);
+    }
+    ScopedFdCloser fd_closer(fd);
+    if (syncfs(fd) != 0) {
+      return STATUS_IO_ERROR(path, errno);
+    }
+    return Status::OK();
+#else
+    return Env::SyncFileSystem(path);
+#endif
+  }
+
   Status DeleteRecursively(const std::string &name) override {
     return Walk(name, POST_ORDER, Bind(&PosixEnv::DeleteRecursivelyCb,
                                        Unretained(this)));
@@ -1558,8 +1606,11 @@ class PosixFileFactory : public FileFactory {
                                     const WritableFileOptions& opts,
                                     std::unique_ptr<WritableFile>* result) {
     uint64_t file_size = 0;
+    uint64_t reused_size = 0;
     if (opts.mode == PosixEnv::OPEN_EXISTING) {
       file_size = VERIFY_RESULT(GetFileSize(fname));
+    } else if (opts.mode == PosixEnv::REUSE_EXISTING) {
+      reused_size = VERIFY_RESULT(GetFileSize(fname));
     }
     PosixWritableFile *posix_writable_file;
 #if defined(__linux__)
@@ -1569,6 +1620,13 @@ class PosixFileFactory : public FileFactory {
 #endif
     posix_writable_file = new PosixWritableFile(fname, fd, file_size, opts.sync_on_close);
     result->reset(posix_writable_file);
+    if (opts.mode == PosixEnv::REUSE_EXISTING) {
+      auto status = posix_writable_file->ZeroAllocatedSpace(reused_size);
+      if (!status.ok()) {
+        result->reset();
+        return status;
+      }
+    }
     return Status::OK();
   }
 };
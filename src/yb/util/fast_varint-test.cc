@@ -456,5 +456,30 @@ TEST(FastVarIntTest, DecodeDescendingSignedCheck) {
   }
 }
 
+TEST(FastVarIntTest, DecodeDescendingSignedVarInts) {
+  constexpr size_t kNumValues = 4;
+  auto values = GenerateRandomValues<int64_t>(500 * kNumValues);
+
+  char buffer[kMaxVarIntBufferSize * kNumValues];
+  for (size_t i = 0; i != values.size(); i += kNumValues) {
+    char* end = buffer;
+    for (size_t j = 0; j != kNumValues; ++j) {
+      end = FastEncodeDescendingSignedVarInt(values[i + j], end);
+    }
+    Slice slice(buffer, end);
+    int64_t decoded[kNumValues];
+    ASSERT_OK_FAST(FastDecodeDescendingSignedVarInts(&slice, decoded, kNumValues));
+    ASSERT_TRUE(slice.empty());
+    for (size_t j = 0; j != kNumValues; ++j) {
+      ASSERT_EQ(values[i + j], decoded[j]);
+    }
+
+    // Truncated input should fail and leave the slice unchanged.
+    Slice truncated(buffer, end - 1);
+    ASSERT_NOK(FastDecodeDescendingSignedVarInts(&truncated, decoded, kNumValues));
+    ASSERT_EQ(end - 1 - buffer, truncated.size());
+  }
+}
+
 }  // namespace util
 }  // namespace yb
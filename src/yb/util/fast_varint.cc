@@ -157,16 +157,15 @@ const uint64_t kVarIntMasks[] = {
     0xffffffffffffffffULL,
 };
 
-Result<std::pair<int64_t, size_t>> FastDecodeSignedVarInt(const uint8_t* src, size_t src_size) {
-  typedef std::pair<int64_t, size_t> ResultType;
-  if (src_size == 0) {
-    return STATUS(Corruption, "Cannot decode a variable-length integer of zero size");
-  }
+namespace {
 
+// Returns the number of bytes used by the signed varint that starts at src, src_size should be
+// positive. negative is set to 0 for non negative values and to 0xffffffffffffffff otherwise.
+inline size_t DecodeSignedVarIntSize(const uint8_t* src, size_t src_size, uint64_t* negative) {
   uint16_t header = src[0] << 8 | (src_size > 1 ? src[1] : 0);
   // When value is positive then negative = 0, otherwise it is 0xffffffffffffffff.
-  uint64_t negative = -static_cast<uint64_t>((header & 0x8000) == 0);
-  header ^= negative;
+  *negative = -static_cast<uint64_t>((header & 0x8000) == 0);
+  header ^= *negative;
   // We need to count ones, so invert the header. 0x7fff - mask when we count them.
   // 0x20 used to put one after end of range where we are interested in them.
   //
@@ -184,17 +183,19 @@ Result<std::pair<int64_t, size_t>> FastDecodeSignedVarInt(const uint8_t* src, si
   // n_bytes                   : 10
   //
   // Argument of __builtin_clz is always unsigned int.
-  size_t n_bytes = __builtin_clz((~header & 0x7fff) | 0x20) - 16;
-  if (src_size < n_bytes) {
-    return NotEnoughEncodedBytes(n_bytes, src_size);
-  }
+  return __builtin_clz((~header & 0x7fff) | 0x20) - 16;
+}
+
+// Decodes the value of the signed varint of n_bytes bytes that starts at src, with sign obtained
+// from DecodeSignedVarIntSize. Caller is responsible for checking that n_bytes are available.
+inline int64_t DecodeSignedVarIntValue(const uint8_t* src, size_t n_bytes, uint64_t negative) {
   auto mask = kVarIntMasks[n_bytes];
 #if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
   uint64_t temp = 0;
   for (const uint8_t* i = std::max(src - 8 + n_bytes, src); i != src + n_bytes; ++i) {
     temp = (temp << 8) | *i;
   }
-  return ResultType(((temp & mask) | (~mask & negative)) - negative, n_bytes);
+  return ((temp & mask) | (~mask & negative)) - negative;
 #else
   // We are interested in range [src, src+n_bytes), so we use 64bit number that ends at src+n_bytes.
   // Then we use mask to drop header and bytes out of range.
@@ -203,13 +204,27 @@ Result<std::pair<int64_t, size_t>> FastDecodeSignedVarInt(const uint8_t* src, si
   // And add one: "- negative".
   // In case of non negative number, negative == 0.
   // So number will be unchanged by those manipulations.
-  return ResultType(
-        ((__builtin_bswap64(*reinterpret_cast<const uint64_t*>(src - 8 + n_bytes)) & mask) |
-            (~mask & negative)) - negative,
-        n_bytes);
+  return ((__builtin_bswap64(*reinterpret_cast<const uint64_t*>(src - 8 + n_bytes)) & mask) |
+             (~mask & negative)) - negative;
 #endif
 }
 
+} // namespace
+
+Result<std::pair<int64_t, size_t>> FastDecodeSignedVarInt(const uint8_t* src, size_t src_size) {
+  typedef std::pair<int64_t, size_t> ResultType;
+  if (src_size == 0) {
+    return STATUS(Corruption, "Cannot decode a variable-length integer of zero size");
+  }
+
+  uint64_t negative;
+  size_t n_bytes = DecodeSignedVarIntSize(src, src_size, &negative);
+  if (src_size < n_bytes) {
+    return NotEnoughEncodedBytes(n_bytes, src_size);
+  }
+  return ResultType(DecodeSignedVarIntValue(src, n_bytes, negative), n_bytes);
+}
+
 Status FastDecodeSignedVarInt(
     const uint8_t* src, size_t src_size, int64_t* v, size_t* decoded_size) {
   auto temp = VERIFY_RESULT(FastDecodeSignedVarInt(src, src_size));
@@ -242,6 +257,26 @@ Result<int64_t> FastDecodeDescendingSignedVarInt(Slice* slice) {
   return -temp.first;
 }
 
+Status FastDecodeDescendingSignedVarInts(Slice* slice, int64_t* dest, size_t count) {
+  const uint8_t* src = slice->data();
+  const uint8_t* end = slice->end();
+  for (size_t i = 0; i != count; ++i) {
+    const size_t src_size = end - src;
+    if (src_size == 0) {
+      return STATUS(Corruption, "Cannot decode a variable-length integer of zero size");
+    }
+    uint64_t negative;
+    const size_t n_bytes = DecodeSignedVarIntSize(src, src_size, &negative);
+    if (src_size < n_bytes) {
+      return NotEnoughEncodedBytes(n_bytes, src_size);
+    }
+    dest[i] = -DecodeSignedVarIntValue(src, n_bytes, negative);
+    src += n_bytes;
+  }
+  slice->remove_prefix(src - slice->data());
+  return Status::OK();
+}
+
 size_t UnsignedVarIntLength(uint64_t v) {
   size_t result = 1;
   v >>= 7;
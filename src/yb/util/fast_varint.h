@@ -73,6 +73,12 @@ inline void FastEncodeDescendingSignedVarInt(int64_t v, std::string *dest) {
 CHECKED_STATUS FastDecodeDescendingSignedVarInt(Slice *slice, int64_t *dest);
 Result<int64_t> FastDecodeDescendingSignedVarInt(Slice* slice);
 
+// Decodes count consecutive "descending VarInts" to dest, consuming decoded part of the slice.
+// Produces the same values as count calls to FastDecodeDescendingSignedVarInt, but does not
+// create intermediate results, so it is preferred on hot paths such as DocHybridTime decoding.
+// The slice is left unchanged in case of failure.
+CHECKED_STATUS FastDecodeDescendingSignedVarInts(Slice* slice, int64_t* dest, size_t count);
+
 size_t UnsignedVarIntLength(uint64_t v);
 void FastAppendUnsignedVarIntToStr(uint64_t v, std::string* dest);
 void FastEncodeUnsignedVarInt(uint64_t v, uint8_t *dest, size_t *size);
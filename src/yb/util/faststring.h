@@ -57,7 +57,7 @@ class faststring {
       len_(0),
       capacity_(kInitialCapacity) {
     if (capacity > capacity_) {
-      data_ = new uint8_t[capacity];
+      data_ = AllocateArray(capacity);
       capacity_ = capacity;
     }
     ASAN_POISON_MEMORY_REGION(data_, capacity_);
@@ -66,7 +66,7 @@ class faststring {
   ~faststring() {
     ASAN_UNPOISON_MEMORY_REGION(initial_data_, arraysize(initial_data_));
     if (data_ != initial_data_) {
-      delete[] data_;
+      FreeArray(data_);
     }
   }
 
@@ -92,22 +92,6 @@ class faststring {
     ASAN_UNPOISON_MEMORY_REGION(data_, len_);
   }
 
-  // Releases the underlying array; after this, the buffer is left empty.
-  //
-  // NOTE: the data pointer returned by release() is not necessarily the pointer
-  uint8_t *release() WARN_UNUSED_RESULT {
-    uint8_t *ret = data_;
-    if (ret == initial_data_) {
-      ret = new uint8_t[len_];
-      memcpy(ret, data_, len_);
-    }
-    len_ = 0;
-    capacity_ = kInitialCapacity;
-    data_ = initial_data_;
-    ASAN_POISON_MEMORY_REGION(data_, capacity_);
-    return ret;
-  }
-
   // Reserve space for the given total amount of data. If the current capacity is already
   // larger than the newly requested capacity, this is a no-op (i.e. it does not ever free memory).
   //
@@ -257,6 +241,15 @@ class faststring {
   // the current capacity.
   void GrowArray(size_t newcapacity);
 
+  // Heap array is allocated with space for RefCntBuffer header before it, so RefCntBuffer could
+  // take ownership of the array without copying the data.
+  static constexpr size_t kHeapArrayHeaderSize = 16;
+
+  static uint8_t* AllocateArray(size_t capacity);
+  static void FreeArray(uint8_t* data);
+
+  friend class RefCntBuffer;
+
   enum {
     kInitialCapacity = 32
   };
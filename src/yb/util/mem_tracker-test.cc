@@ -46,6 +46,7 @@
 
 DECLARE_int32(memory_limit_soft_percentage);
 DECLARE_int64(mem_tracker_update_consumption_interval_us);
+DECLARE_int64(mem_tracker_parent_update_batch_bytes);
 
 namespace yb {
 
@@ -147,6 +148,44 @@ class GcTest : public GarbageCollector {
 
 } // namespace
 
+TEST(MemTrackerTest, BatchedParentUpdate) {
+  google::FlagSaver saver;
+  FLAGS_mem_tracker_parent_update_batch_bytes = 100;
+
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker(200, "p");
+  shared_ptr<MemTracker> c = MemTracker::CreateTracker("c", p);
+
+  // Parent is updated only when accumulated change reaches the batch size.
+  c->Consume(60);
+  EXPECT_EQ(c->consumption(), 60);
+  EXPECT_EQ(p->consumption(), 0);
+  c->Consume(50);
+  EXPECT_EQ(c->consumption(), 110);
+  EXPECT_EQ(p->consumption(), 110);
+  c->Release(30);
+  EXPECT_EQ(c->consumption(), 80);
+  EXPECT_EQ(p->consumption(), 110);
+
+  // TryConsume checks limits of ancestors against up to date consumption.
+  EXPECT_FALSE(c->TryConsume(130));
+  EXPECT_EQ(p->consumption(), 80);
+  EXPECT_TRUE(c->TryConsume(120));
+  EXPECT_EQ(c->consumption(), 200);
+  EXPECT_EQ(p->consumption(), 200);
+
+  c->Release(200);
+  EXPECT_EQ(c->consumption(), 0);
+  EXPECT_EQ(p->consumption(), 0);
+
+  // Pending change is applied to ancestors when tracker is destroyed.
+  EXPECT_TRUE(c->TryConsume(70));
+  c->Release(70);
+  EXPECT_EQ(c->consumption(), 0);
+  EXPECT_EQ(p->consumption(), 70);
+  c.reset();
+  EXPECT_EQ(p->consumption(), 0);
+}
+
 TEST(MemTrackerTest, GcFunctions) {
   shared_ptr<MemTracker> t = MemTracker::CreateTracker(10, "");
   ASSERT_TRUE(t->has_limit());
@@ -305,6 +344,22 @@ TEST(MemTrackerTest, SoftLimitExceeded) {
   }
 }
 
+TEST(MemTrackerTest, SoftLimitPressure) {
+  const int kMemLimit = 1000;
+  google::FlagSaver saver;
+  FLAGS_memory_limit_soft_percentage = 50;
+  shared_ptr<MemTracker> m = MemTracker::CreateTracker(kMemLimit, "test");
+
+  ScopedTrackedConsumption consumption(m, kMemLimit / 4);
+  ASSERT_EQ(0.0, m->SoftLimitPressure());
+
+  consumption.Reset(kMemLimit * 3 / 4);
+  ASSERT_NEAR(0.5, m->SoftLimitPressure(), 0.01);
+
+  consumption.Reset(kMemLimit);
+  ASSERT_NEAR(1.0, m->SoftLimitPressure(), 0.01);
+}
+
 #ifdef TCMALLOC_ENABLED
 TEST(MemTrackerTest, TcMallocRootTracker) {
   const auto kWaitTimeout = std::chrono::microseconds(
@@ -103,6 +103,14 @@ DEFINE_int64(mem_tracker_update_consumption_interval_us, 2000000,
              "Interval that is used to update memory consumption from external source. "
              "For instance from tcmalloc statistics.");
 
+DEFINE_int64(mem_tracker_parent_update_batch_bytes, 0,
+             "If positive, Consume and Release update ancestors of a tracker only after the "
+             "tracker accumulated this number of bytes of not propagated change, so ancestors "
+             "could lag by up to this number of bytes per descendant. TryConsume always "
+             "propagates pending change of the tracker before checking limits.");
+TAG_FLAG(mem_tracker_parent_update_batch_bytes, advanced);
+TAG_FLAG(mem_tracker_parent_update_batch_bytes, runtime);
+
 namespace yb {
 
 // NOTE: this class has been adapted from Impala, so the code style varies
@@ -337,6 +345,7 @@ MemTracker::~MemTracker() {
   if (!consumption_functor_) {
     DCHECK_EQ(consumption(), 0) << "Memory tracker " << ToString();
   }
+  FlushPendingAncestorsUpdate();
   if (parent_) {
     if (add_to_parent_) {
       parent_->Release(consumption());
@@ -475,6 +484,9 @@ void MemTracker::Consume(int64_t bytes) {
   if (PREDICT_FALSE(enable_logging_)) {
     LogUpdate(true, bytes);
   }
+  if (BatchedUpdate(bytes)) {
+    return;
+  }
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
       IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
@@ -483,11 +495,40 @@ void MemTracker::Consume(int64_t bytes) {
   }
 }
 
+bool MemTracker::BatchedUpdate(int64_t bytes) {
+  auto batch_bytes = FLAGS_mem_tracker_parent_update_batch_bytes;
+  if (batch_bytes <= 0 || all_trackers_.size() == 1) {
+    return false;
+  }
+  // The caller already checked that this tracker does not use consumption functor.
+  IncrementBy(bytes, &consumption_, metrics_);
+  auto pending = pending_ancestors_update_.fetch_add(bytes, std::memory_order_acq_rel) + bytes;
+  if (std::abs(pending) >= batch_bytes) {
+    FlushPendingAncestorsUpdate();
+  }
+  return true;
+}
+
+void MemTracker::FlushPendingAncestorsUpdate() {
+  auto pending = pending_ancestors_update_.exchange(0, std::memory_order_acq_rel);
+  if (pending == 0) {
+    return;
+  }
+  for (auto it = all_trackers_.begin() + 1; it != all_trackers_.end(); ++it) {
+    auto* tracker = *it;
+    if (!tracker->UpdateConsumption()) {
+      IncrementBy(pending, &tracker->consumption_, tracker->metrics_);
+    }
+  }
+}
+
 bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   UpdateConsumption();
   if (bytes <= 0) {
     return true;
   }
+  // Limits of ancestors should be checked against up to date consumption.
+  FlushPendingAncestorsUpdate();
   if (PREDICT_FALSE(enable_logging_)) {
     LogUpdate(true, bytes);
   }
@@ -560,6 +601,10 @@ void MemTracker::Release(int64_t bytes) {
     LogUpdate(false, bytes);
   }
 
+  if (BatchedUpdate(-bytes)) {
+    return;
+  }
+
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
       IncrementBy(-bytes, &tracker->consumption_, tracker->metrics_);
@@ -636,6 +681,23 @@ int64_t MemTracker::SpareCapacity() const {
   return result;
 }
 
+double MemTracker::SoftLimitPressure() const {
+  double result = 0.0;
+  for (const auto& tracker : limit_trackers_) {
+    const int64_t usage = tracker->consumption();
+    if (usage < tracker->soft_limit_) {
+      continue;
+    }
+    if (tracker->limit_ == tracker->soft_limit_) {
+      result = std::max(result, 1.0);
+    } else {
+      result = std::max(result, static_cast<double>(usage - tracker->soft_limit_) /
+                                (tracker->limit_ - tracker->soft_limit_));
+    }
+  }
+  return result;
+}
+
 bool MemTracker::GcMemory(int64_t max_consumption) {
   if (max_consumption < 0) {
     // Impossible to GC enough memory to reach the goal.
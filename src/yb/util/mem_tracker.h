@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -321,6 +322,11 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // limits and a negative value if any limit is already exceeded.
   int64_t SpareCapacity() const;
 
+  // Returns how far consumption is between the soft limit and the limit, for the most loaded of
+  // this tracker and its parents that have limits. It is 0 below soft limits, and 1 or greater
+  // when a limit is reached.
+  double SoftLimitPressure() const;
+
 
   int64_t limit() const { return limit_; }
   bool has_limit() const { return limit_ >= 0; }
@@ -398,6 +404,13 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // Logs the stack of the current consume/release. Used for debugging only.
   void LogUpdate(bool is_consume, int64_t bytes) const;
 
+  // Adds bytes to consumption of this tracker, and to consumption of its ancestors in batches of
+  // at least mem_tracker_parent_update_batch_bytes. Returns false if batching is disabled.
+  bool BatchedUpdate(int64_t bytes);
+
+  // Applies consumption change that was not yet propagated to ancestors.
+  void FlushPendingAncestorsUpdate();
+
   // Variant of CreateTracker() that:
   // 1. Must be called with a non-NULL parent, and
   // 2. Must be called with parent->child_trackers_lock_ held.
@@ -438,6 +451,10 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   HighWaterMark consumption_{0};
 
+  // Consumption change of this tracker that was not yet applied to its ancestors,
+  // see BatchedUpdate.
+  std::atomic<int64_t> pending_ancestors_update_{0};
+
   // this tracker plus all of its ancestors
   std::vector<MemTracker*> all_trackers_;
   // all_trackers_ with valid limits
@@ -441,11 +441,15 @@ class InMemoryEnv : public EnvWrapper {
         case OPEN_EXISTING:
           result->reset(new Type(file_map_[fname]));
           return Status::OK();
+        case REUSE_EXISTING:
+          // There is no allocated space to keep in memory, so just discard content.
+          DeleteFileInternal(fname);
+          break; // creates a new file below
         default:
           return STATUS(NotSupported, Substitute("Unknown create mode $0",
                                                  mode));
       }
-    } else if (mode == OPEN_EXISTING) {
+    } else if (mode == OPEN_EXISTING || mode == REUSE_EXISTING) {
       return STATUS(IOError, fname, "File not found");
     }
 
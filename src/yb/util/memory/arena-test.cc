@@ -236,6 +236,37 @@ TEST(TestArena, TestMemoryTrackingEnforced) {
   ASSERT_EQ(256, mem_tracker->consumption());
 }
 
+TEST(TestArena, TestPoolingAllocator) {
+  PoolingBufferAllocator allocator(HeapBufferAllocator::Get(), 1024);
+  size_t footprint = 0;
+  {
+    Arena arena(&allocator, 256, 1024);
+    // Does not fit into the first component, so the second one of 512 bytes is allocated.
+    ASSERT_TRUE(arena.AllocateBytes(256));
+    footprint = arena.memory_footprint();
+    ASSERT_EQ(0U, allocator.pooled_bytes());
+  }
+  ASSERT_EQ(768U, footprint);
+  ASSERT_EQ(footprint, allocator.pooled_bytes());
+
+  {
+    // Components of the same sizes are taken from the pool.
+    Arena arena(&allocator, 256, 1024);
+    ASSERT_EQ(512U, allocator.pooled_bytes());
+    ASSERT_TRUE(arena.AllocateBytes(256));
+    ASSERT_EQ(0U, allocator.pooled_bytes());
+  }
+  ASSERT_EQ(footprint, allocator.pooled_bytes());
+
+  {
+    // Pooled buffers are too small, and this one does not fit into the pool, so it is returned to
+    // the delegate.
+    Arena arena(&allocator, 2048, 2048);
+    ASSERT_EQ(footprint, allocator.pooled_bytes());
+  }
+  ASSERT_EQ(footprint, allocator.pooled_bytes());
+}
+
 TEST(TestArena, TestSTLAllocator) {
   Arena a(256, 256 * 1024);
   typedef vector<int, ArenaAllocator<int>> ArenaVector;
@@ -240,6 +240,62 @@ void ClearingBufferAllocator::FreeInternal(Buffer* buffer) {
   DelegateFree(delegate_, buffer);
 }
 
+PoolingBufferAllocator::~PoolingBufferAllocator() {
+  for (const auto& pooled : pool_) {
+    // Returns the buffer to the delegate when destroyed.
+    Buffer buffer = CreateBuffer(pooled.data, pooled.size, delegate_);
+  }
+}
+
+size_t PoolingBufferAllocator::pooled_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pooled_bytes_;
+}
+
+Buffer PoolingBufferAllocator::AllocateInternal(size_t requested,
+                                                size_t minimal,
+                                                BufferAllocator* originator) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Pick the largest kept buffer that fits into [max(minimal, requested / 2), requested].
+    const size_t min_size = std::max(minimal, requested / 2);
+    auto best = pool_.end();
+    for (auto it = pool_.begin(); it != pool_.end(); ++it) {
+      if (it->size >= min_size && it->size <= requested &&
+          (best == pool_.end() || it->size > best->size)) {
+        best = it;
+      }
+    }
+    if (best != pool_.end()) {
+      const auto pooled = *best;
+      *best = pool_.back();
+      pool_.pop_back();
+      pooled_bytes_ -= pooled.size;
+      return CreateBuffer(pooled.data, pooled.size, originator);
+    }
+  }
+  return DelegateAllocate(delegate_, requested, minimal, originator);
+}
+
+bool PoolingBufferAllocator::ReallocateInternal(size_t requested,
+                                                size_t minimal,
+                                                Buffer* buffer,
+                                                BufferAllocator* originator) {
+  return DelegateReallocate(delegate_, requested, minimal, buffer, originator);
+}
+
+void PoolingBufferAllocator::FreeInternal(Buffer* buffer) {
+  if (buffer->size() != 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pooled_bytes_ + buffer->size() <= max_pooled_bytes_) {
+      pool_.push_back(PooledBuffer{buffer->data(), buffer->size()});
+      pooled_bytes_ += buffer->size();
+      return;
+    }
+  }
+  DelegateFree(delegate_, buffer);
+}
+
 Buffer MediatingBufferAllocator::AllocateInternal(
     const size_t requested,
     const size_t minimal,
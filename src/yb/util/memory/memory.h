@@ -51,6 +51,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <boost/mpl/if.hpp>
@@ -322,6 +323,55 @@ class ClearingBufferAllocator : public BufferAllocator {
   DISALLOW_COPY_AND_ASSIGN(ClearingBufferAllocator);
 };
 
+// Wrapper around the delegate allocator, that keeps freed buffers instead of returning them to
+// the delegate, as long as the total size of kept buffers does not exceed max_pooled_bytes.
+// Allocation requests are served from kept buffers, whose size is in the requested range, but not
+// less than half of the requested size, so small buffers do not replace larger requested ones.
+// So arenas that are repeatedly created and destroyed, e.g. per statement, reuse the same blocks
+// instead of going through malloc for each of them.
+// Thread safe.
+class PoolingBufferAllocator : public BufferAllocator {
+ public:
+  // Does not take ownership of the delegate.
+  PoolingBufferAllocator(BufferAllocator* delegate, size_t max_pooled_bytes)
+      : delegate_(delegate), max_pooled_bytes_(max_pooled_bytes) {}
+
+  virtual ~PoolingBufferAllocator();
+
+  virtual size_t Available() const override {
+    return delegate_->Available();
+  }
+
+  // Total size of buffers kept by this allocator.
+  size_t pooled_bytes() const;
+
+ private:
+  virtual Buffer AllocateInternal(size_t requested,
+                                  size_t minimal,
+                                  BufferAllocator* originator) override;
+
+  virtual bool ReallocateInternal(size_t requested,
+                                  size_t minimal,
+                                  Buffer* buffer,
+                                  BufferAllocator* originator) override;
+
+  virtual void FreeInternal(Buffer* buffer) override;
+
+  struct PooledBuffer {
+    void* data;
+    size_t size;
+  };
+
+  BufferAllocator* const delegate_;
+  const size_t max_pooled_bytes_;
+
+  mutable std::mutex mutex_;
+  std::vector<PooledBuffer> pool_;
+  size_t pooled_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(PoolingBufferAllocator);
+};
+
 // Abstract policy for modifying allocation requests - e.g. enforcing quotas.
 class Mediator {
  public:
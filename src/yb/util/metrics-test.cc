@@ -292,6 +292,43 @@ TEST_F(MetricsTest, JsonPrintTest) {
   ASSERT_EQ("", out.str());
 }
 
+METRIC_DEFINE_counter(server, test_prometheus_requests, "Test Requests", MetricUnit::kRequests,
+                      "Number of test requests");
+METRIC_DEFINE_counter(server, test_prometheus_errors, "Test Errors", MetricUnit::kRequests,
+                      "Number of failed test requests");
+
+TEST_F(MetricsTest, PrometheusFilterTest) {
+  auto server_entity = METRIC_ENTITY_server.Instantiate(&registry_, "yb.test");
+  scoped_refptr<Counter> requests = METRIC_test_prometheus_requests.Instantiate(server_entity);
+  scoped_refptr<Counter> errors = METRIC_test_prometheus_errors.Instantiate(server_entity);
+  requests->Increment();
+
+  auto write = [this](const MetricPrometheusOptions& opts) {
+    std::stringstream out;
+    PrometheusWriter writer(&out);
+    CHECK_OK(registry_.WriteForPrometheus(&writer, opts));
+    return out.str();
+  };
+
+  MetricPrometheusOptions opts;
+  auto output = write(opts);
+  ASSERT_STR_CONTAINS(output, "test_prometheus_requests");
+  ASSERT_STR_CONTAINS(output, "test_prometheus_errors");
+
+  opts.requested_metrics = { "requests" };
+  output = write(opts);
+  ASSERT_STR_CONTAINS(output, "test_prometheus_requests");
+  ASSERT_EQ(std::string::npos, output.find("test_prometheus_errors")) << output;
+
+  opts.requested_metrics.clear();
+  opts.metric_types = { "tablet" };
+  output = write(opts);
+  ASSERT_EQ(std::string::npos, output.find("test_prometheus")) << output;
+
+  opts.metric_types = { "server" };
+  ASSERT_STR_CONTAINS(write(opts), "test_prometheus_errors");
+}
+
 // Test that metrics are retired when they are no longer referenced.
 TEST_F(MetricsTest, RetirementTest) {
   FLAGS_metrics_retirement_age_ms = 100;
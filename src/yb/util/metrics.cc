@@ -307,6 +307,12 @@ Status MetricEntity::WriteAsJson(JsonWriter* writer,
 
 CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer,
                                                 const MetricPrometheusOptions& opts) const {
+  if (!opts.metric_types.empty() &&
+      std::find(opts.metric_types.begin(), opts.metric_types.end(), prototype_->name()) ==
+          opts.metric_types.end()) {
+    return Status::OK();
+  }
+
   // We want the keys to be in alphabetical order when printing, so we use an ordered map here.
   typedef std::map<const char*, scoped_refptr<Metric> > OrderedMetricMap;
   OrderedMetricMap metrics;
@@ -322,6 +328,10 @@ CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer,
       const MetricPrototype* prototype = val.first;
       const scoped_refptr<Metric>& metric = val.second;
 
+      if (!opts.requested_metrics.empty() &&
+          !MatchMetricInList(prototype->name(), opts.requested_metrics)) {
+        continue;
+      }
       InsertOrDie(&metrics, prototype->name(), metric);
     }
   }
@@ -858,6 +868,14 @@ Histogram::Histogram(const HistogramPrototype* proto)
     export_percentiles_(proto->export_percentiles()) {
 }
 
+Histogram::Histogram(std::unique_ptr<HistogramPrototype> proto)
+  : Metric(std::move(proto)),
+    histogram_(new HdrHistogram(
+        down_cast<const HistogramPrototype*>(prototype())->max_trackable_value(),
+        down_cast<const HistogramPrototype*>(prototype())->num_sig_digits())),
+    export_percentiles_(down_cast<const HistogramPrototype*>(prototype())->export_percentiles()) {
+}
+
 void Histogram::Increment(int64_t value) {
   histogram_->Increment(value);
 }
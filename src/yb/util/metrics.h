@@ -519,6 +519,15 @@ struct MetricPrometheusOptions {
   // Include the metrics at a level and above.
   // Default: debug
   MetricLevel level;
+
+  // Include only metrics whose names contain one of these substrings, "*" matches all metrics.
+  // Metrics written by external callbacks are included regardless of their names.
+  // Default: empty, i.e. all metrics.
+  std::vector<std::string> requested_metrics;
+
+  // Include only metrics of entities of these types, i.e. tablet, server, cluster or cdc.
+  // Default: empty, i.e. entities of all types.
+  std::vector<std::string> metric_types;
 };
 
 class MetricEntityPrototype {
@@ -562,6 +571,8 @@ class MetricEntity : public RefCountedThreadSafe<MetricEntity> {
   scoped_refptr<AtomicMillisLag> FindOrCreateAtomicMillisLag(const MillisLagPrototype* proto);
   scoped_refptr<Histogram> FindOrCreateHistogram(const HistogramPrototype* proto);
 
+  scoped_refptr<Histogram> FindOrCreateHistogram(std::unique_ptr<HistogramPrototype> proto);
+
   template<typename T>
   scoped_refptr<AtomicGauge<T>> FindOrCreateGauge(const GaugePrototype<T>* proto,
                                                   const T& initial_value);
@@ -731,7 +742,7 @@ class PrometheusWriter {
     }
     *output_ << " " << value;
     *output_ << " " << timestamp_;
-    *output_ << std::endl;
+    *output_ << '\n';
     return Status::OK();
   }
 
@@ -1445,6 +1456,7 @@ class Histogram : public Metric {
   FRIEND_TEST(MetricsTest, ResetHistogramTest);
   friend class MetricEntity;
   explicit Histogram(const HistogramPrototype* proto);
+  explicit Histogram(std::unique_ptr<HistogramPrototype> proto);
 
   const gscoped_ptr<HdrHistogram> histogram_;
   const ExportPercentiles export_percentiles_;
@@ -1537,6 +1549,18 @@ inline scoped_refptr<Histogram> MetricEntity::FindOrCreateHistogram(
   return m;
 }
 
+inline scoped_refptr<Histogram> MetricEntity::FindOrCreateHistogram(
+    std::unique_ptr<HistogramPrototype> proto) {
+  CheckInstantiation(proto.get());
+  std::lock_guard<simple_spinlock> l(lock_);
+  auto m = down_cast<Histogram*>(FindPtrOrNull(metric_map_, proto.get()).get());
+  if (!m) {
+    m = new Histogram(std::move(proto));
+    InsertOrDie(&metric_map_, m->prototype(), m);
+  }
+  return m;
+}
+
 template<typename T>
 inline scoped_refptr<AtomicGauge<T> > MetricEntity::FindOrCreateGauge(
     const GaugePrototype<T>* proto,
@@ -1614,6 +1638,19 @@ class OwningGaugePrototype : public OwningMetricCtorArgs, public GaugePrototype<
             OwningMetricCtorArgs::level, flags)) {}
 };
 
+class OwningHistogramPrototype : public OwningMetricCtorArgs, public HistogramPrototype {
+ public:
+  OwningHistogramPrototype(
+      OwningMetricCtorArgs args, uint64_t max_trackable_value, int num_sig_digits,
+      ExportPercentiles export_percentiles = ExportPercentiles::kFalse)
+      : OwningMetricCtorArgs(std::move(args)),
+        HistogramPrototype(MetricPrototype::CtorArgs(
+            OwningMetricCtorArgs::entity_type.c_str(), OwningMetricCtorArgs::name.c_str(),
+            OwningMetricCtorArgs::label.c_str(), unit, OwningMetricCtorArgs::description.c_str(),
+            OwningMetricCtorArgs::level, flags),
+            max_trackable_value, num_sig_digits, export_percentiles) {}
+};
+
 // Replace specific chars with underscore to pass PrometheusNameRegex().
 void EscapeMetricNameForPrometheus(std::string *id);
 
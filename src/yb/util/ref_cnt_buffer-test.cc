@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/util/faststring.h"
 #include "yb/util/ref_cnt_buffer.h"
 
 #include "yb/util/test_util.h"
@@ -71,6 +72,34 @@ TEST_F(RefCntBufferTest, TestFromData) {
   }
 }
 
+// Test buffer that takes ownership of faststring data.
+TEST_F(RefCntBufferTest, TestFromFaststring) {
+  unsigned int seed = SeedRandom();
+  for (auto i = 1000; i--;) {
+    size_t size = rand_r(&seed) % (kSizeLimit + 1); // Zero size is also allowed
+    faststring str;
+    for (size_t index = 0; index != size; ++index) {
+      str.push_back(static_cast<uint8_t>(index));
+    }
+    const uint8_t* data = str.data();
+
+    RefCntBuffer buffer(std::move(str));
+    ASSERT_TRUE(str.empty());
+    ASSERT_EQ(size, buffer.size());
+    // Data of long string is not copied.
+    if (size > 32) {
+      ASSERT_EQ(data, buffer.udata());
+    }
+    for (size_t index = 0; index != size; ++index) {
+      ASSERT_EQ(static_cast<uint8_t>(index), buffer.udata()[index]);
+    }
+
+    // String could be reused after its data was taken.
+    str.append("test");
+    ASSERT_EQ("test", str.ToString());
+  }
+}
+
 // Test vector of buffers.
 TEST_F(RefCntBufferTest, TestVector) {
   std::vector<RefCntBuffer> v;
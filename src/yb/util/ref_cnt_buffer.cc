@@ -48,6 +48,27 @@ RefCntBuffer::RefCntBuffer(const faststring& string)
     : RefCntBuffer(string.data(), string.size()) {
 }
 
+RefCntBuffer::RefCntBuffer(faststring&& string)
+    : data_(nullptr) {
+  static_assert(faststring::kHeapArrayHeaderSize == sizeof(CounterType) + sizeof(size_t),
+                "faststring should reserve space for RefCntBuffer header");
+  if (string.data_ == string.initial_data_) {
+    *this = RefCntBuffer(string.data(), string.size());
+    string.clear();
+    return;
+  }
+
+  ASAN_UNPOISON_MEMORY_REGION(string.data_, string.capacity_);
+  data_ = reinterpret_cast<char*>(string.data_) - faststring::kHeapArrayHeaderSize;
+  size_reference() = string.len_;
+  new (&counter_reference()) CounterType(1);
+
+  string.data_ = string.initial_data_;
+  string.len_ = 0;
+  string.capacity_ = faststring::kInitialCapacity;
+  ASAN_POISON_MEMORY_REGION(string.data_, string.capacity_);
+}
+
 RefCntBuffer::~RefCntBuffer() {
   Reset();
 }
@@ -46,6 +46,10 @@ class RefCntBuffer {
 
   explicit RefCntBuffer(const faststring& string);
 
+  // Takes ownership of the string data, so it is not copied when the string is long enough to be
+  // allocated on the heap. The string is left empty.
+  explicit RefCntBuffer(faststring&& string);
+
   explicit RefCntBuffer(const Slice& slice) :
       RefCntBuffer(slice.data(), slice.size()) {}
 
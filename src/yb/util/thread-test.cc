@@ -33,6 +33,7 @@
 #include "yb/util/thread.h"
 
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -122,6 +123,34 @@ TEST_F(ThreadTest, TestCallOnExit) {
   ASSERT_EQ("hello 1, hello 2", s);
 }
 
+TEST_F(ThreadTest, TestScopedWaitState) {
+  std::vector<WaitState> states;
+  auto record = [&states] {
+    states.push_back(Thread::current_thread()->wait_state());
+  };
+  scoped_refptr<Thread> holder;
+  ASSERT_OK(Thread::Create("test", "TestScopedWaitState", [&record] {
+    record();
+    {
+      ScopedWaitState outer(WaitState::kLockManager);
+      record();
+      {
+        ScopedWaitState inner(WaitState::kLogSync);
+        record();
+      }
+      record();
+    }
+    record();
+  }, &holder));
+  holder->Join();
+  ASSERT_EQ((std::vector<WaitState>{
+      WaitState::kNone, WaitState::kLockManager, WaitState::kLogSync, WaitState::kLockManager,
+      WaitState::kNone}), states);
+
+  // Not a yb::Thread, so wait state is not tracked.
+  ScopedWaitState wait_state(WaitState::kSafeTime);
+}
+
 // The following tests only run in debug mode, since thread restrictions are no-ops
 // in release builds.
 #ifndef NDEBUG
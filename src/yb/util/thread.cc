@@ -43,6 +43,7 @@
 #endif // defined(__linux__)
 
 #include <algorithm>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -52,13 +53,17 @@
 #include <cds/init.h>
 #include <cds/gc/dhp.h>
 
+#include <gflags/gflags.h>
+
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/dynamic_annotations.h"
 #include "yb/gutil/mathlimits.h"
 #include "yb/gutil/once.h"
+#include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
 #include "yb/util/mutex.h"
@@ -67,6 +72,17 @@
 #include "yb/util/url-coding.h"
 #include "yb/util/web_callback_registry.h"
 
+DEFINE_int32(thread_stack_sampling_interval_ms, 0,
+             "Interval between collecting stack traces of all threads, which are aggregated and "
+             "served in folded format at /profile. 0 to disable sampling.");
+TAG_FLAG(thread_stack_sampling_interval_ms, advanced);
+TAG_FLAG(thread_stack_sampling_interval_ms, runtime);
+
+DEFINE_int32(thread_stack_sampling_history_minutes, 30,
+             "Number of minutes of aggregated thread stack samples kept for /profile.");
+TAG_FLAG(thread_stack_sampling_history_minutes, advanced);
+TAG_FLAG(thread_stack_sampling_history_minutes, runtime);
+
 METRIC_DEFINE_gauge_uint64(server, threads_started,
                            "Threads Started",
                            yb::MetricUnit::kThreads,
@@ -179,6 +195,9 @@ scoped_refptr<AtomicGauge<uint64>> ThreadCategoryTracker::FindOrCreateGauge(
   return gauges_[category];
 }
 
+// Duration of time covered by one entry of aggregated stack samples.
+const MonoDelta kStackSamplesBucket = MonoDelta::FromSeconds(60);
+
 // A singleton class that tracks all live threads, and groups them together for easy
 // auditing. Used only by Thread.
 class ThreadMgr {
@@ -205,32 +224,47 @@ class ThreadMgr {
   // Registers a thread to the supplied category. The key is a pthread_t,
   // not the system TID, since pthread_t is less prone to being recycled.
   void AddThread(const pthread_t& pthread_id, const string& name, const string& category,
-      int64_t tid);
+      int64_t tid, const Thread* thread);
 
   // Removes a thread from the supplied category. If the thread has
   // already been removed, this is a no-op.
   void RemoveThread(const pthread_t& pthread_id, const string& category);
 
  private:
+  Status StartInstrumentationUnlocked(
+      const scoped_refptr<MetricEntity>& metrics, WebCallbackRegistry* web);
+
+  // Number of samples of each (thread category, stack trace) pair collected during one minute.
+  struct StackSamples {
+    MonoTime start;
+    std::map<std::pair<std::string, StackTrace>, size_t> counts;
+    // Number of samples of threads in each category being in each wait state except kNone.
+    std::map<std::pair<std::string, WaitState>, size_t> wait_states;
+  };
+
   // Container class for any details we want to capture about a thread
   // TODO: Add start-time.
   // TODO: Track fragment ID.
   class ThreadDescriptor {
    public:
     ThreadDescriptor() { }
-    ThreadDescriptor(string category, string name, int64_t thread_id)
+    ThreadDescriptor(string category, string name, int64_t thread_id, const Thread* thread)
         : name_(std::move(name)),
           category_(std::move(category)),
-          thread_id_(thread_id) {}
+          thread_id_(thread_id),
+          thread_(thread) {}
 
     const string& name() const { return name_; }
     const string& category() const { return category_; }
     int64_t thread_id() const { return thread_id_; }
+    WaitState wait_state() const { return thread_ ? thread_->wait_state() : WaitState::kNone; }
 
    private:
     string name_;
     string category_;
     int64_t thread_id_;
+    // Removed from ThreadMgr before destruction of the thread object.
+    const Thread* thread_ = nullptr;
   };
 
   // A ThreadCategory is a set of threads that are logically related.
@@ -260,6 +294,16 @@ class ThreadMgr {
   std::unique_ptr<ThreadCategoryTracker> started_category_tracker_;
   std::unique_ptr<ThreadCategoryTracker> running_category_tracker_;
 
+  // Thread that periodically samples stacks of all threads, started by the first
+  // StartInstrumentation(..) call.
+  scoped_refptr<Thread> sampler_thread_;
+
+  // Protects samples_.
+  Mutex samples_lock_;
+
+  // Aggregated stack samples, one entry per minute, oldest first.
+  std::deque<StackSamples> samples_;
+
   // Metric callbacks.
   uint64_t ReadThreadsStarted();
   uint64_t ReadThreadsRunning();
@@ -268,6 +312,19 @@ class ThreadMgr {
   void ThreadPathHandler(const WebCallbackRegistry::WebRequest& args,
                                 WebCallbackRegistry::WebResponse* resp);
   void RenderThreadCategoryRows(const ThreadCategory& category, std::string* output);
+
+  void SamplerLoop();
+  void SampleStacks();
+
+  // Webpage callback; prints aggregated stack samples in folded format, i.e. one line
+  // "category;outermost frame;...;innermost frame count" per distinct stack.
+  void ProfilePathHandler(const WebCallbackRegistry::WebRequest& req,
+                          WebCallbackRegistry::WebResponse* resp);
+
+  // Webpage callback; prints number of threads in each wait state by category, both current and
+  // sampled when stack sampling is enabled.
+  void WaitStatePathHandler(const WebCallbackRegistry::WebRequest& req,
+                            WebCallbackRegistry::WebResponse* resp);
 };
 
 void ThreadMgr::SetThreadName(const string& name, int64 tid) {
@@ -284,7 +341,22 @@ void ThreadMgr::SetThreadName(const string& name, int64 tid) {
 
 Status ThreadMgr::StartInstrumentation(const scoped_refptr<MetricEntity>& metrics,
                                        WebCallbackRegistry* web) {
-  MutexLock l(lock_);
+  bool start_sampler;
+  {
+    MutexLock l(lock_);
+    start_sampler = !metrics_enabled_;
+    RETURN_NOT_OK(StartInstrumentationUnlocked(metrics, web));
+  }
+  // Thread registers itself in ThreadMgr, so it should be started without holding lock_.
+  if (start_sampler) {
+    RETURN_NOT_OK(Thread::Create(
+        "thread_mgr", "stack_sampler", &ThreadMgr::SamplerLoop, this, &sampler_thread_));
+  }
+  return Status::OK();
+}
+
+Status ThreadMgr::StartInstrumentationUnlocked(const scoped_refptr<MetricEntity>& metrics,
+                                               WebCallbackRegistry* web) {
   metrics_enabled_ = true;
   started_category_tracker_ = std::make_unique<ThreadCategoryTracker>("threads_started", metrics);
   running_category_tracker_ = std::make_unique<ThreadCategoryTracker>("threads_running", metrics);
@@ -313,9 +385,196 @@ Status ThreadMgr::StartInstrumentation(const scoped_refptr<MetricEntity>& metric
   WebCallbackRegistry::PathHandlerCallback thread_callback =
       std::bind(&ThreadMgr::ThreadPathHandler, this, _1, _2);
   DCHECK_NOTNULL(web)->RegisterPathHandler("/threadz", "Threads", thread_callback, true, false);
+  WebCallbackRegistry::PathHandlerCallback profile_callback =
+      std::bind(&ThreadMgr::ProfilePathHandler, this, _1, _2);
+  web->RegisterPathHandler("/profile", "Profile", profile_callback, false, false);
+  WebCallbackRegistry::PathHandlerCallback wait_state_callback =
+      std::bind(&ThreadMgr::WaitStatePathHandler, this, _1, _2);
+  web->RegisterPathHandler("/waitz", "Wait States", wait_state_callback, true, false);
   return Status::OK();
 }
 
+void ThreadMgr::SamplerLoop() {
+  for (;;) {
+    auto interval_ms = FLAGS_thread_stack_sampling_interval_ms;
+    if (interval_ms <= 0) {
+      SleepFor(MonoDelta::FromSeconds(1));
+      continue;
+    }
+    SleepFor(MonoDelta::FromMilliseconds(interval_ms));
+    SampleStacks();
+  }
+}
+
+void ThreadMgr::SampleStacks() {
+  // Pairs of thread id and category, sorted by thread id as required by ThreadStacks.
+  std::vector<std::pair<ThreadIdForStack, const std::string*>> threads;
+  std::vector<std::pair<const std::string*, WaitState>> wait_states;
+  const auto self = Thread::CurrentThreadIdForStack();
+  {
+    MutexLock l(lock_);
+    for (const auto& category : thread_categories_) {
+      for (const auto& thread : category.second) {
+        auto wait_state = thread.second.wait_state();
+        if (wait_state != WaitState::kNone) {
+          wait_states.emplace_back(&category.first, wait_state);
+        }
+#if defined(__linux__)
+        ThreadIdForStack tid_for_stack = thread.second.thread_id();
+#else
+        ThreadIdForStack tid_for_stack = thread.first;
+#endif
+        if (tid_for_stack != self) {
+          // Categories are never removed from thread_categories_, so the key stays valid.
+          threads.emplace_back(tid_for_stack, &category.first);
+        }
+      }
+    }
+  }
+  if (threads.empty() && wait_states.empty()) {
+    return;
+  }
+
+  std::sort(threads.begin(), threads.end());
+  std::vector<ThreadIdForStack> thread_ids;
+  thread_ids.reserve(threads.size());
+  for (const auto& thread : threads) {
+    thread_ids.push_back(thread.first);
+  }
+  auto stacks = ThreadStacks(thread_ids);
+
+  // Stacks are symbolized only when profile is requested, so sampling itself is cheap.
+  const auto now = MonoTime::Now();
+  const auto history = MonoDelta::FromSeconds(60 * FLAGS_thread_stack_sampling_history_minutes);
+  MutexLock l(samples_lock_);
+  if (samples_.empty() || now - samples_.back().start >= kStackSamplesBucket) {
+    samples_.emplace_back();
+    samples_.back().start = now;
+  }
+  while (!samples_.empty() && now - samples_.front().start > history) {
+    samples_.pop_front();
+  }
+  if (samples_.empty()) {
+    // Zero history, nothing to keep.
+    return;
+  }
+  auto& counts = samples_.back().counts;
+  for (size_t i = 0; i != stacks.size(); ++i) {
+    if (stacks[i].ok()) {
+      ++counts[std::make_pair(*threads[i].second, *stacks[i])];
+    }
+  }
+  for (const auto& wait_state : wait_states) {
+    ++samples_.back().wait_states[std::make_pair(*wait_state.first, wait_state.second)];
+  }
+}
+
+void ThreadMgr::WaitStatePathHandler(const WebCallbackRegistry::WebRequest& req,
+                                     WebCallbackRegistry::WebResponse* resp) {
+  std::stringstream* output = &resp->output;
+  auto render = [output](const std::map<std::pair<std::string, WaitState>, size_t>& counts) {
+    (*output) << "<table class='table table-hover table-border'>"
+              << "<tr><th>Thread group</th><th>Wait state</th><th>Count</th></tr>";
+    for (const auto& entry : counts) {
+      (*output) << "<tr><td>" << EscapeForHtmlToString(entry.first.first) << "</td><td>"
+                << ToString(entry.first.second) << "</td><td>" << entry.second << "</td></tr>";
+    }
+    (*output) << "</table>";
+  };
+
+  std::map<std::pair<std::string, WaitState>, size_t> counts;
+  {
+    MutexLock l(lock_);
+    for (const auto& category : thread_categories_) {
+      for (const auto& thread : category.second) {
+        auto wait_state = thread.second.wait_state();
+        if (wait_state != WaitState::kNone) {
+          ++counts[std::make_pair(category.first, wait_state)];
+        }
+      }
+    }
+  }
+  (*output) << "<h2>Current Wait States</h2>";
+  render(counts);
+
+  if (FLAGS_thread_stack_sampling_interval_ms <= 0) {
+    (*output) << "<p>Set --thread_stack_sampling_interval_ms to collect wait state samples.</p>";
+    return;
+  }
+
+  int minutes = FLAGS_thread_stack_sampling_history_minutes;
+  auto it = req.parsed_args.find("minutes");
+  if (it != req.parsed_args.end()) {
+    minutes = atoi(it->second.c_str());
+  }
+  counts.clear();
+  {
+    const auto since = MonoTime::Now() - MonoDelta::FromSeconds(60 * minutes);
+    MutexLock l(samples_lock_);
+    for (const auto& samples : samples_) {
+      if (samples.start + kStackSamplesBucket < since) {
+        continue;
+      }
+      for (const auto& entry : samples.wait_states) {
+        counts[entry.first] += entry.second;
+      }
+    }
+  }
+  (*output) << "<h2>Sampled Wait States, last " << minutes << " minute(s)</h2>";
+  render(counts);
+}
+
+void ThreadMgr::ProfilePathHandler(const WebCallbackRegistry::WebRequest& req,
+                                   WebCallbackRegistry::WebResponse* resp) {
+  std::stringstream* output = &resp->output;
+  if (FLAGS_thread_stack_sampling_interval_ms <= 0) {
+    (*output) << "Stack sampling is disabled, "
+              << "set --thread_stack_sampling_interval_ms to enable it." << endl;
+    return;
+  }
+
+  // Only include samples from the last given number of minutes.
+  int minutes = FLAGS_thread_stack_sampling_history_minutes;
+  auto it = req.parsed_args.find("minutes");
+  if (it != req.parsed_args.end()) {
+    minutes = atoi(it->second.c_str());
+  }
+  // Idle threads, i.e. waiting for a task in thread pool, are skipped unless requested.
+  const bool include_idle = req.parsed_args.find("include_idle") != req.parsed_args.end();
+
+  std::map<std::pair<std::string, StackTrace>, size_t> counts;
+  {
+    const auto since = MonoTime::Now() - MonoDelta::FromSeconds(60 * minutes);
+    MutexLock l(samples_lock_);
+    for (const auto& samples : samples_) {
+      // Bucket could contain samples for the whole minute after its start.
+      if (samples.start + kStackSamplesBucket < since) {
+        continue;
+      }
+      for (const auto& entry : samples.counts) {
+        counts[entry.first] += entry.second;
+      }
+    }
+  }
+
+  for (const auto& entry : counts) {
+    StackTraceGroup group = StackTraceGroup::kActive;
+    auto symbolized = entry.first.second.Symbolize(StackTraceLineFormat::SYMBOL_ONLY, &group);
+    if (group == StackTraceGroup::kIdle && !include_idle) {
+      continue;
+    }
+    std::vector<std::string> frames = strings::Split(symbolized, "\n", strings::SkipEmpty());
+    std::string line = entry.first.first;
+    for (auto frame = frames.rbegin(); frame != frames.rend(); ++frame) {
+      line += ';';
+      // Semicolon separates frames in folded format.
+      std::replace(frame->begin(), frame->end(), ';', ':');
+      line += *frame;
+    }
+    (*output) << line << ' ' << entry.second << '\n';
+  }
+}
+
 uint64_t ThreadMgr::ReadThreadsStarted() {
   MutexLock l(lock_);
   return threads_started_metric_;
@@ -327,7 +586,7 @@ uint64_t ThreadMgr::ReadThreadsRunning() {
 }
 
 void ThreadMgr::AddThread(const pthread_t& pthread_id, const string& name,
-    const string& category, int64_t tid) {
+    const string& category, int64_t tid, const Thread* thread) {
   // These annotations cause TSAN to ignore the synchronization on lock_
   // without causing the subsequent mutations to be treated as data races
   // in and of themselves (that's what IGNORE_READS_AND_WRITES does).
@@ -344,7 +603,7 @@ void ThreadMgr::AddThread(const pthread_t& pthread_id, const string& name,
   ANNOTATE_IGNORE_READS_AND_WRITES_BEGIN();
   {
     MutexLock l(lock_);
-    thread_categories_[category][pthread_id] = ThreadDescriptor(category, name, tid);
+    thread_categories_[category][pthread_id] = ThreadDescriptor(category, name, tid, thread);
     if (metrics_enabled_) {
       threads_running_metric_++;
       threads_started_metric_++;
@@ -749,7 +1008,7 @@ void* Thread::SuperviseThread(void* arg) {
   Release_Store(&t->tid_, system_tid);
 
   thread_manager->SetThreadName(name, t->tid());
-  thread_manager->AddThread(pthread_self(), name, t->category(), t->tid());
+  thread_manager->AddThread(pthread_self(), name, t->category(), t->tid(), t);
 
   cds::threading::Manager::attachThread();
 
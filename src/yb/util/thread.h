@@ -37,6 +37,7 @@
 #include <sys/syscall.h>
 #include <sys/types.h>
 
+#include <atomic>
 #include <functional>
 #include <string>
 #include <vector>
@@ -44,6 +45,7 @@
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/util/async_util.h"
+#include "yb/util/enums.h"
 #include "yb/util/result.h"
 #include "yb/util/status.h"
 
@@ -59,6 +61,17 @@ typedef int64_t ThreadIdForStack;
 typedef pthread_t ThreadIdForStack;
 #endif
 
+// Well-known points where a thread could wait, set with ScopedWaitState and reported at /waitz.
+YB_DEFINE_ENUM(WaitState,
+               (kNone)
+               (kLockManager)
+               (kSafeTime)
+               (kLogAppend)
+               (kLogSync)
+               (kBlockCacheMutex)
+               (kRocksDBSeek)
+               (kRocksDBNext));
+
 // Utility to join on a thread, printing warning messages if it
 // takes too long. For example:
 //
@@ -307,7 +320,13 @@ class Thread : public RefCountedThreadSafe<Thread> {
     user_data_ = value;
   }
 
+  // What this thread is currently waiting for, see ScopedWaitState.
+  WaitState wait_state() const {
+    return wait_state_.load(std::memory_order_relaxed);
+  }
+
  private:
+  friend class ScopedWaitState;
   friend class ThreadJoiner;
 
   // The various special values for tid_ that describe the various steps
@@ -363,6 +382,9 @@ class Thread : public RefCountedThreadSafe<Thread> {
   // this thread.
   void* user_data_ = nullptr;
 
+  // Written only by the thread itself, read when wait states are sampled.
+  std::atomic<WaitState> wait_state_{WaitState::kNone};
+
   // Starts the thread running SuperviseThread(), and returns once that thread has
   // initialised and its TID has been read. Waits for notification from the started
   // thread that initialisation is complete before returning. On success, stores a
@@ -397,8 +419,33 @@ class Thread : public RefCountedThreadSafe<Thread> {
 
 typedef scoped_refptr<Thread> ThreadPtr;
 
-// Registers /threadz with the debug webserver, and creates thread-tracking metrics under
-// the given entity.
+// Sets wait state of the current thread for the lifetime of this object, restoring the previous
+// one on destruction. Does nothing if the current thread is not a yb::Thread.
+class ScopedWaitState {
+ public:
+  explicit ScopedWaitState(WaitState state) : thread_(Thread::current_thread()) {
+    if (thread_) {
+      prev_ = thread_->wait_state_.load(std::memory_order_relaxed);
+      thread_->wait_state_.store(state, std::memory_order_relaxed);
+    }
+  }
+
+  ~ScopedWaitState() {
+    if (thread_) {
+      thread_->wait_state_.store(prev_, std::memory_order_relaxed);
+    }
+  }
+
+  ScopedWaitState(const ScopedWaitState&) = delete;
+  void operator=(const ScopedWaitState&) = delete;
+
+ private:
+  Thread* const thread_;
+  WaitState prev_ = WaitState::kNone;
+};
+
+// Registers /threadz, /profile and /waitz with the debug webserver, and creates thread-tracking
+// metrics under the given entity.
 Status StartThreadInstrumentation(const scoped_refptr<MetricEntity>& server_metrics,
                                   WebCallbackRegistry* web);
 
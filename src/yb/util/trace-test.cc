@@ -121,6 +121,23 @@ TEST_F(TraceTest, TestChildTrace) {
             XOutDigits(traceA->DumpToString(false)));
 }
 
+TEST_F(TraceTest, TestTraceId) {
+  scoped_refptr<Trace> traceA(new Trace);
+  scoped_refptr<Trace> traceB(new Trace);
+  ASSERT_EQ(0U, traceA->trace_id());
+  ASSERT_EQ("", TraceIdSuffix(traceA->trace_id()));
+
+  auto id = traceA->GetOrCreateTraceId();
+  ASSERT_NE(0U, id);
+  ASSERT_EQ(id, traceA->GetOrCreateTraceId());
+
+  traceA->AddChildTrace(traceB.get());
+  ASSERT_EQ(id, traceB->trace_id());
+
+  traceB->set_trace_id(0x1234);
+  ASSERT_EQ(" (trace id: 0000000000001234)", TraceIdSuffix(traceB->trace_id()));
+}
+
 static void GenerateTraceEvents(int thread_id,
                                 int num_events) {
   for (int i = 0; i < num_events; i++) {
@@ -48,6 +48,7 @@
 #include "yb/util/memory/arena.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/object_pool.h"
+#include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 
 DEFINE_bool(enable_tracing, false, "Flag to enable/disable tracing across the code.");
@@ -357,6 +358,33 @@ void Trace::AddChildTrace(Trace* child_trace) {
     child_traces_.push_back(ptr);
   }
   CHECK(!child_trace->HasOneRef());
+  auto id = trace_id();
+  if (id != 0) {
+    child_trace->set_trace_id(id);
+  }
+}
+
+std::string TraceIdSuffix(uint64_t trace_id) {
+  if (trace_id == 0) {
+    return std::string();
+  }
+  std::ostringstream out;
+  out << " (trace id: " << std::hex << std::setw(16) << std::setfill('0') << trace_id << ")";
+  return out.str();
+}
+
+uint64_t Trace::GetOrCreateTraceId() {
+  auto result = trace_id();
+  if (result != 0) {
+    return result;
+  }
+  uint64_t new_id = 0;
+  while (new_id == 0) {
+    new_id = RandomUniformInt<uint64_t>();
+  }
+  // Somebody could assign id concurrently, in this case we should use it.
+  return trace_id_.compare_exchange_strong(result, new_id, std::memory_order_acq_rel)
+      ? new_id : result;
 }
 
 size_t Trace::DynamicMemoryUsage() const {
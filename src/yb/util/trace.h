@@ -155,8 +155,23 @@ class Trace : public RefCountedThreadSafe<Trace> {
   std::string DumpToString(bool include_time_deltas) const;
 
   // Attaches the given trace which will get appended at the end when Dumping.
+  // Child trace inherits trace id of this trace, if it was assigned.
   void AddChildTrace(Trace* child_trace);
 
+  // Identifier shared by traces of all the calls made while serving the same request, possibly
+  // on different nodes. So slow traces of one request could be correlated across the cluster.
+  // 0 means that id was not assigned.
+  uint64_t trace_id() const {
+    return trace_id_.load(std::memory_order_acquire);
+  }
+
+  void set_trace_id(uint64_t value) {
+    trace_id_.store(value, std::memory_order_release);
+  }
+
+  // Returns trace id, assigning random one if it was not assigned yet.
+  uint64_t GetOrCreateTraceId();
+
   // Return the current trace attached to this thread, if there is one.
   static Trace* CurrentTrace() {
     return threadlocal_trace_;
@@ -202,11 +217,17 @@ class Trace : public RefCountedThreadSafe<Trace> {
 
   std::vector<scoped_refptr<Trace> > child_traces_;
 
+  std::atomic<uint64_t> trace_id_{0};
+
   DISALLOW_COPY_AND_ASSIGN(Trace);
 };
 
 typedef scoped_refptr<Trace> TracePtr;
 
+// Returns " (trace id: <hex id>)" for assigned trace id and empty string otherwise, to be appended
+// to log messages about the traced call.
+std::string TraceIdSuffix(uint64_t trace_id);
+
 // Adopt a Trace object into the current thread for the duration
 // of this object.
 // This should only be used on the stack (and thus created and destroyed
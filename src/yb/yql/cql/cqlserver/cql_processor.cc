@@ -80,6 +80,7 @@ METRIC_DEFINE_counter(server, cql_parsers_created,
                       "Number of created CQL Parsers.");
 
 DECLARE_bool(use_cassandra_authentication);
+DECLARE_int32(cql_unprepared_statements_cache_size);
 
 namespace yb {
 namespace cqlserver {
@@ -95,6 +96,27 @@ constexpr const char* const kCassandraPasswordAuthenticator =
 extern const char* const kRoleColumnNameSaltedHash;
 extern const char* const kRoleColumnNameCanLogin;
 
+namespace {
+
+// Only parse trees of DML statements are reused for identical queries. Other statements change
+// the metadata or the session state, and are not executed often with the same text anyway.
+bool IsCacheableQuery(const ql::ParseTree& parse_tree) {
+  if (parse_tree.root() == nullptr) {
+    return false;
+  }
+  switch (parse_tree.root()->opcode()) {
+    case ql::TreeNodeOpcode::kPTSelectStmt: FALLTHROUGH_INTENDED;
+    case ql::TreeNodeOpcode::kPTInsertStmt: FALLTHROUGH_INTENDED;
+    case ql::TreeNodeOpcode::kPTUpdateStmt: FALLTHROUGH_INTENDED;
+    case ql::TreeNodeOpcode::kPTDeleteStmt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
 using std::shared_ptr;
 using std::unique_ptr;
 
@@ -141,7 +163,8 @@ CQLMetrics::CQLMetrics(const scoped_refptr<yb::MetricEntity>& metric_entity)
 }
 
 //------------------------------------------------------------------------------------------------
-CQLProcessor::CQLProcessor(CQLServiceImpl* service_impl, const CQLProcessorListPos& pos)
+CQLProcessor::CQLProcessor(
+    CQLServiceImpl* service_impl, size_t shard, const CQLProcessorListPos& pos)
     : QLProcessor(service_impl->client(), service_impl->metadata_cache(),
                   service_impl->cql_metrics().get(),
                   &service_impl->parser_pool(),
@@ -149,6 +172,7 @@ CQLProcessor::CQLProcessor(CQLServiceImpl* service_impl, const CQLProcessorListP
                   std::bind(&CQLServiceImpl::TransactionPool, service_impl)),
       service_impl_(service_impl),
       cql_metrics_(service_impl->cql_metrics()),
+      shard_(shard),
       pos_(pos),
       statement_executed_cb_(Bind(&CQLProcessor::StatementExecuted, Unretained(this))),
       consumption_(service_impl->processors_mem_tracker(), sizeof(*this)) {
@@ -214,7 +238,9 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   const auto compression_scheme = context.compression_scheme();
   faststring msg;
   response.Serialize(compression_scheme, &msg);
-  call_->RespondSuccess(RefCntBuffer(msg), cql_metrics_->rpc_method_metrics_);
+  // The serialized response could be big, e.g. it embeds rows returned by the tservers, so hand
+  // its buffer over instead of copying it.
+  call_->RespondSuccess(RefCntBuffer(std::move(msg)), cql_metrics_->rpc_method_metrics_);
 
   MonoTime response_done = MonoTime::Now();
   cql_metrics_->time_to_process_request_->Increment(
@@ -231,8 +257,9 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   request_ = nullptr;
   stmts_.clear();
   parse_trees_.clear();
+  unprepared_stmt_ = nullptr;
   SetCurrentSession(nullptr);
-  service_impl_->ReturnProcessor(pos_);
+  service_impl_->ReturnProcessor(shard_, pos_);
 }
 
 CQLResponse* CQLProcessor::ProcessRequest(const CQLRequest& req) {
@@ -338,8 +365,32 @@ CQLResponse* CQLProcessor::ProcessRequest(const ExecuteRequest& req) {
 
 CQLResponse* CQLProcessor::ProcessRequest(const QueryRequest& req) {
   VLOG(1) << "QUERY " << req.query();
-  RunAsync(req.query(), req.params(), statement_executed_cb_);
-  return nullptr;
+  if (FLAGS_cql_unprepared_statements_cache_size <= 0) {
+    RunAsync(req.query(), req.params(), statement_executed_cb_);
+    return nullptr;
+  }
+
+  // Reuse the parse tree of an identical query in the same keyspace, the same way as for prepared
+  // statements. When it turns out to be stale during execution, the request is retried, and the
+  // stale statement is replaced in the cache.
+  const shared_ptr<CQLStatement> stmt = service_impl_->AllocateUnpreparedStatement(
+      CQLStatement::GetQueryId(ql_env_.CurrentKeyspace(), req.query()),
+      ql_env_.CurrentKeyspace(), req.query());
+  Status s = stmt->Prepare(this);
+  if (!s.ok()) {
+    service_impl_->DeleteUnpreparedStatement(stmt);
+    return ProcessError(s);
+  }
+  const Result<const ParseTree&> parse_tree = stmt->GetParseTree();
+  if (!parse_tree) {
+    return ProcessError(parse_tree.status());
+  }
+  if (!IsCacheableQuery(*parse_tree)) {
+    service_impl_->DeleteUnpreparedStatement(stmt);
+  }
+  unprepared_stmt_ = stmt;
+  s = stmt->ExecuteAsync(this, req.params(), statement_executed_cb_);
+  return s.ok() ? nullptr : ProcessError(s);
 }
 
 CQLResponse* CQLProcessor::ProcessRequest(const BatchRequest& req) {
@@ -444,6 +495,7 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
       if (++retry_count_ == 1) {
         stmts_.clear();
         parse_trees_.clear();
+        unprepared_stmt_ = nullptr;
         Reschedule(&process_request_task_.Bind(this));
         return nullptr;
       }
@@ -64,7 +64,7 @@ using CQLProcessorListPos = CQLProcessorList::iterator;
 class CQLProcessor : public ql::QLProcessor {
  public:
   // Constructor and destructor.
-  explicit CQLProcessor(CQLServiceImpl* service_impl, const CQLProcessorListPos& pos);
+  CQLProcessor(CQLServiceImpl* service_impl, size_t shard, const CQLProcessorListPos& pos);
   ~CQLProcessor();
 
   // Processing an inbound call.
@@ -111,7 +111,8 @@ class CQLProcessor : public ql::QLProcessor {
   // CQL metrics.
   std::shared_ptr<CQLMetrics> cql_metrics_;
 
-  // Position in the CQL processor list.
+  // Shard of the CQL processors pool and position in the shard's processor list.
+  const size_t shard_;
   const CQLProcessorListPos pos_;
 
   //----------------------------- StatementExecuted callback and state ---------------------------
@@ -121,6 +122,8 @@ class CQLProcessor : public ql::QLProcessor {
   std::shared_ptr<const CQLRequest> request_;
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
   std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
+  // Cached statement of the query being executed, when it was not prepared by the client.
+  std::shared_ptr<const CQLStatement> unprepared_stmt_;
 
   // Current retry count.
   int retry_count_ = 0;
@@ -213,14 +213,14 @@ void CQLInboundCall::RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_cod
       break;
     }
   }
-  response_msg_buf_ = RefCntBuffer(msg);
+  response_msg_buf_ = RefCntBuffer(std::move(msg));
 
   QueueResponse(/* is_success */ false);
 }
 
 void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer,
                                     const yb::rpc::RpcMethodMetrics& metrics) {
-  RecordHandlingCompleted(metrics.handler_latency);
+  RecordHandlingCompleted(metrics);
   response_msg_buf_ = buffer;
 
   QueueResponse(/* is_success */ true);
@@ -322,6 +322,7 @@ bool CQLInboundCall::DumpPB(const rpc::DumpRunningRpcsRequestPB& req,
   }
   resp->set_elapsed_millis(
       MonoTime::Now().GetDeltaSince(timing_.time_received).ToMilliseconds());
+  DumpTiming(resp);
   GetCallDetails(resp);
 
   return true;
@@ -49,12 +49,13 @@ class CQLConnectionContext : public rpc::ConnectionContextWithCallId,
     compression_scheme_ = compression_scheme;
   }
 
-  // Accessor methods for registered CQL events.
+  // Accessor methods for registered CQL events. Events are registered by the service thread, and
+  // could be checked by the reactor thread, when server event is queued.
   CQLMessage::Events registered_events() const {
-    return registered_events_;
+    return registered_events_.load(std::memory_order_acquire);
   }
   void add_registered_events(CQLMessage::Events events) {
-    registered_events_ |= events;
+    registered_events_.fetch_or(events, std::memory_order_acq_rel);
   }
 
   static std::string Name() { return "CQL"; }
@@ -85,7 +86,7 @@ class CQLConnectionContext : public rpc::ConnectionContextWithCallId,
   CQLMessage::CompressionScheme compression_scheme_ = CQLMessage::CompressionScheme::kNone;
 
   // Stored registered events for the connection.
-  CQLMessage::Events registered_events_ = CQLMessage::kNoEvents;
+  std::atomic<CQLMessage::Events> registered_events_{CQLMessage::kNoEvents};
 
   rpc::BinaryCallParser parser_;
 
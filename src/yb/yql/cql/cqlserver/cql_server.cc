@@ -17,7 +17,9 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/size_literals.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/yql/cql/cqlserver/cql_rpc.h"
 #include "yb/yql/cql/cqlserver/cql_service.h"
+#include "yb/rpc/connection.h"
 #include "yb/rpc/messenger.h"
 
 using yb::rpc::ServiceIf;
@@ -34,6 +36,13 @@ TAG_FLAG(cql_nodelist_refresh_interval_secs, advanced);
 
 DEFINE_int64(cql_rpc_memory_limit, 0, "CQL RPC memory limit");
 
+DEFINE_int32(cql_partitions_change_event_interval_ms, 2000,
+             "Interval at which the tablet locations known to the master are checked for changes, "
+             "e.g. moved tablet leadership. If they changed, an event is sent to all CQL clients, "
+             "so they refresh system.partitions and route requests directly to the new leaders. "
+             "0 to disable.");
+TAG_FLAG(cql_partitions_change_event_interval_ms, advanced);
+
 using namespace std::placeholders;
 
 namespace yb {
@@ -45,6 +54,10 @@ boost::posix_time::time_duration refresh_interval() {
   return boost::posix_time::seconds(FLAGS_cql_nodelist_refresh_interval_secs);
 }
 
+boost::posix_time::time_duration partitions_change_interval() {
+  return boost::posix_time::milliseconds(FLAGS_cql_partitions_change_event_interval_ms);
+}
+
 }
 
 CQLServer::CQLServer(const CQLServerOptions& opts,
@@ -57,6 +70,7 @@ CQLServer::CQLServer(const CQLServerOptions& opts,
               AddToParent::kTrue, CreateMetrics::kFalse)),
       opts_(opts),
       timer_(*io, refresh_interval()),
+      partitions_change_timer_(*io),
       tserver_(tserver) {
   SetConnectionContextFactory(rpc::CreateConnectionContextFactory<CQLConnectionContext>(
       FLAGS_cql_rpc_memory_limit, mem_tracker()->parent()));
@@ -75,6 +89,12 @@ Status CQLServer::Start() {
   // Start the CQL node list refresh timer.
   timer_.async_wait(boost::bind(&CQLServer::CQLNodeListRefresh, this,
                                 boost::asio::placeholders::error));
+
+  // Start the tablet locations change check timer.
+  if (tserver_ != nullptr && FLAGS_cql_partitions_change_event_interval_ms > 0) {
+    last_tablet_locations_version_ = tserver_->tablet_locations_version();
+    SchedulePartitionsChangeCheck();
+  }
   return Status::OK();
 }
 
@@ -84,9 +104,55 @@ void CQLServer::Shutdown() {
   if (ec) {
     LOG(WARNING) << "Failed to cancel timer: " << ec;
   }
+  partitions_change_timer_.cancel(ec);
+  if (ec) {
+    LOG(WARNING) << "Failed to cancel partitions change timer: " << ec;
+  }
   server::RpcAndWebServerBase::Shutdown();
 }
 
+void CQLServer::SchedulePartitionsChangeCheck() {
+  boost::system::error_code ec;
+  partitions_change_timer_.expires_from_now(partitions_change_interval(), ec);
+  if (ec) {
+    // Happens during shutdown.
+    LOG(WARNING) << "Failed to reschedule partitions change timer: " << ec;
+    return;
+  }
+  partitions_change_timer_.async_wait(boost::bind(&CQLServer::CQLPartitionsChangeCheck, this,
+                                                  boost::asio::placeholders::error));
+}
+
+void CQLServer::CQLPartitionsChangeCheck(const boost::system::error_code &ec) {
+  if (ec) {
+    return;
+  }
+
+  const auto tablet_locations_version = tserver_->tablet_locations_version();
+  if (tablet_locations_version != last_tablet_locations_version_) {
+    last_tablet_locations_version_ = tablet_locations_version;
+
+    // There is no dedicated event for tablet leadership changes in the CQL protocol, so use the
+    // 'MOVED_NODE' event, that forces the client to refresh its cluster topology including
+    // system.partitions. It is sent only to clients registered for topology changes, i.e.
+    // control connections of drivers.
+    auto cqlserver_event_list = std::make_shared<CQLServerEventList>();
+    cqlserver_event_list->AddEvent(
+        BuildTopologyChangeEvent(TopologyChangeEventResponse::kMovedNode, first_rpc_address()));
+    Status s = messenger_->QueueEventOnFilteredConnections(
+        cqlserver_event_list, SOURCE_LOCATION(), [](const rpc::ConnectionPtr& connection) {
+      auto& context = static_cast<CQLConnectionContext&>(connection->context());
+      return (context.registered_events() & CQLMessage::kTopologyChange) != 0;
+    });
+    if (!s.ok()) {
+      LOG (WARNING) << strings::Substitute("Failed to push events: [$0], due to: $1",
+                                           cqlserver_event_list->ToString(), s.ToString());
+    }
+  }
+
+  SchedulePartitionsChangeCheck();
+}
+
 void CQLServer::RescheduleTimer() {
   // Reschedule the timer.
   boost::system::error_code ec;
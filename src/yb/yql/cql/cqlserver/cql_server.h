@@ -59,6 +59,14 @@ class CQLServer : public server::RpcAndWebServerBase {
   void CQLNodeListRefresh(const boost::system::error_code &e);
   void RescheduleTimer();
   boost::asio::deadline_timer timer_;
+
+  // Sends an event to clients when tablet locations known to the master change, so they refresh
+  // tablet leaders and do not send requests to tservers that have to forward them to the leader.
+  void CQLPartitionsChangeCheck(const boost::system::error_code &e);
+  void SchedulePartitionsChangeCheck();
+  boost::asio::deadline_timer partitions_change_timer_;
+  uint64_t last_tablet_locations_version_ = 0;
+
   tserver::TabletServer* const tserver_;
 
   std::unique_ptr<CQLServerEvent> BuildTopologyChangeEvent(const std::string& event_type,
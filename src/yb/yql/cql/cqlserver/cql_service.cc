@@ -14,7 +14,9 @@
 #include "yb/yql/cql/cqlserver/cql_service.h"
 
 #include <openssl/sha.h>
+#include <sched.h>
 
+#include <algorithm>
 #include <mutex>
 #include <thread>
 
@@ -24,6 +26,7 @@
 #include "yb/client/transaction_pool.h"
 
 #include "yb/gutil/strings/join.h"
+#include "yb/gutil/sysinfo.h"
 
 #include "yb/yql/cql/cqlserver/cql_processor.h"
 #include "yb/yql/cql/cqlserver/cql_rpc.h"
@@ -36,6 +39,7 @@
 
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/crypt.h"
+#include "yb/util/flag_tags.h"
 
 #include "yb/util/mem_tracker.h"
 
@@ -52,6 +56,12 @@ DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "requests originating in the cql layer");
 DEFINE_int32(password_hash_cache_size, 64, "Number of password hashes to cache. 0 or "
              "negative disables caching.");
+DEFINE_int32(cql_unprepared_statements_cache_size, 0,
+             "The maximum number of distinct queries, not prepared by the clients, whose parse "
+             "trees are cached by the CQL proxy, so identical queries are not parsed and analyzed "
+             "again. Only DML statements are cached. 0 or negative disables caching.");
+TAG_FLAG(cql_unprepared_statements_cache_size, advanced);
+TAG_FLAG(cql_unprepared_statements_cache_size, runtime);
 DEFINE_int64(cql_processors_limit, -4000,
              "Limit number of CQL processors. Positive means absolute limit. "
              "Negative means number of processors per 1GB of root mem tracker memory limit. "
@@ -100,6 +110,15 @@ class ParserDeleter {
   CQLMetrics* metrics_;
 };
 
+size_t CurrentProcessorShard(size_t num_shards) {
+#if defined(__APPLE__)
+  // OSX doesn't have a way to get the CPU, so we'll pick a shard by the thread.
+  return std::hash<std::thread::id>()(std::this_thread::get_id()) % num_shards;
+#else
+  return static_cast<size_t>(sched_getcpu()) % num_shards;
+#endif // defined(__APPLE__)
+}
+
 int64_t CQLProcessorsLimit() {
   auto value = FLAGS_cql_processors_limit;
   if (value > 0) {
@@ -114,7 +133,6 @@ int64_t CQLProcessorsLimit() {
 CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts)
     : CQLServerServiceIf(server->metric_entity()),
       server_(server),
-      next_available_processor_(processors_.end()),
       password_cache_(FLAGS_password_hash_cache_size),
       // TODO(ENG-446): Handle metrics for all the methods individually.
       cql_metrics_(std::make_shared<CQLMetrics>(server->metric_entity())),
@@ -131,6 +149,13 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts)
 
   processors_mem_tracker_ = MemTracker::CreateTracker("CQL processors", server->mem_tracker());
 
+  // Need the actual number of CPUs, so we do not use the Gflag value.
+  const auto num_cpus = std::max(base::RawNumCPUs(), 1);
+  processor_shards_.reserve(num_cpus);
+  while (processor_shards_.size() != static_cast<size_t>(num_cpus)) {
+    processor_shards_.push_back(std::make_unique<ProcessorShard>());
+  }
+
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
       Substitute("SELECT $0, $1 FROM system_auth.roles WHERE role = ?",
@@ -165,13 +190,16 @@ void CQLServiceImpl::CompleteInit() {
 }
 
 void CQLServiceImpl::Shutdown() {
-  decltype(processors_) processors;
-  {
-    std::lock_guard<std::mutex> guard(processors_mutex_);
-    processors.swap(processors_);
-  }
-  for (const auto& processor : processors) {
-    processor->Shutdown();
+  for (auto& shard : processor_shards_) {
+    CQLProcessorList processors;
+    {
+      std::lock_guard<std::mutex> guard(shard->mutex);
+      processors.swap(shard->processors);
+      shard->next_available_processor = shard->processors.end();
+    }
+    for (const auto& processor : processors) {
+      processor->Shutdown();
+    }
   }
 
   auto client = this->client();
@@ -200,35 +228,58 @@ void CQLServiceImpl::Handle(yb::rpc::InboundCallPtr inbound_call) {
   (**processor).ProcessCall(std::move(inbound_call));
 }
 
+CQLProcessor* CQLServiceImpl::TakeAvailableProcessor(ProcessorShard* shard) {
+  std::lock_guard<std::mutex> guard(shard->mutex);
+  if (shard->next_available_processor != shard->processors.end()) {
+    return (shard->next_available_processor++)->get();
+  }
+  return nullptr;
+}
+
 Result<CQLProcessor*> CQLServiceImpl::GetProcessor() {
-  CQLProcessorListPos pos;
-  {
-    // Retrieve the next available processor. If none is available, allocate a new slot in the list.
-    // Then create the processor outside the mutex below.
-    std::lock_guard<std::mutex> guard(processors_mutex_);
-    if (next_available_processor_ != processors_.end()) {
-      return (next_available_processor_++)->get();
-    }
+  // Retrieve the next available processor of the current CPU's shard.
+  const size_t shard_idx = CurrentProcessorShard(processor_shards_.size());
+  auto& shard = *processor_shards_[shard_idx];
+  auto* processor = TakeAvailableProcessor(&shard);
+  if (processor) {
+    return processor;
+  }
 
-    auto limit = CQLProcessorsLimit();
-    if (num_allocated_processors_ >= limit) {
-      return STATUS_FORMAT(ServiceUnavailable,
-                           "Unable to allocate CQL processor, already allocated $0 of $1",
-                           num_allocated_processors_, limit);
+  // If none is available, allocate a new slot in the list. Then create the processor outside the
+  // mutex below.
+  const auto limit = CQLProcessorsLimit();
+  const auto num_allocated = num_allocated_processors_.fetch_add(1, std::memory_order_acq_rel);
+  if (num_allocated >= limit) {
+    num_allocated_processors_.fetch_sub(1, std::memory_order_acq_rel);
+    // Limit is reached, so reuse a processor available in another shard if there is one.
+    for (size_t i = 1; i < processor_shards_.size(); ++i) {
+      processor = TakeAvailableProcessor(
+          processor_shards_[(shard_idx + i) % processor_shards_.size()].get());
+      if (processor) {
+        return processor;
+      }
     }
-    ++num_allocated_processors_;
-    pos = processors_.emplace(processors_.end());
+    return STATUS_FORMAT(ServiceUnavailable,
+                         "Unable to allocate CQL processor, already allocated $0 of $1",
+                         num_allocated, limit);
   }
 
-  *pos = std::make_unique<CQLProcessor>(this, pos);
+  CQLProcessorListPos pos;
+  {
+    std::lock_guard<std::mutex> guard(shard.mutex);
+    pos = shard.processors.emplace(shard.processors.end());
+  }
+
+  *pos = std::make_unique<CQLProcessor>(this, shard_idx, pos);
   return pos->get();
 }
 
-void CQLServiceImpl::ReturnProcessor(const CQLProcessorListPos& pos) {
+void CQLServiceImpl::ReturnProcessor(size_t shard_idx, const CQLProcessorListPos& pos) {
   // Put the processor back before the next available one.
-  std::lock_guard<std::mutex> guard(processors_mutex_);
-  processors_.splice(next_available_processor_, processors_, pos);
-  next_available_processor_ = pos;
+  auto& shard = *processor_shards_[shard_idx];
+  std::lock_guard<std::mutex> guard(shard.mutex);
+  shard.processors.splice(shard.next_available_processor, shard.processors, pos);
+  shard.next_available_processor = pos;
 }
 
 shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
@@ -296,6 +347,54 @@ void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
+shared_ptr<CQLStatement> CQLServiceImpl::AllocateUnpreparedStatement(
+    const CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
+  std::lock_guard<std::mutex> guard(unprepared_stmts_mutex_);
+
+  const auto itr = unprepared_stmts_map_.find(query_id);
+  if (itr != unprepared_stmts_map_.end()) {
+    shared_ptr<CQLStatement> stmt = itr->second;
+    if (stmt->unprepared() || !stmt->stale()) {
+      unprepared_stmts_list_.splice(
+          unprepared_stmts_list_.begin(), unprepared_stmts_list_, stmt->pos());
+      return stmt;
+    }
+    // The statement was analyzed with stale metadata, replace it with a new one.
+    unprepared_stmts_list_.erase(stmt->pos());
+    stmt->set_pos(unprepared_stmts_list_.end());
+    unprepared_stmts_map_.erase(itr);
+  }
+
+  auto stmt = std::make_shared<CQLStatement>(keyspace, query, unprepared_stmts_list_.end());
+  unprepared_stmts_map_.emplace(query_id, stmt);
+  stmt->set_pos(unprepared_stmts_list_.insert(unprepared_stmts_list_.begin(), stmt));
+
+  const auto max_size = static_cast<size_t>(
+      std::max(FLAGS_cql_unprepared_statements_cache_size, 1));
+  while (unprepared_stmts_list_.size() > max_size) {
+    auto lru_stmt = unprepared_stmts_list_.back();
+    unprepared_stmts_map_.erase(lru_stmt->query_id());
+    unprepared_stmts_list_.pop_back();
+    lru_stmt->set_pos(unprepared_stmts_list_.end());
+  }
+
+  return stmt;
+}
+
+void CQLServiceImpl::DeleteUnpreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  std::lock_guard<std::mutex> guard(unprepared_stmts_mutex_);
+
+  // Same as for prepared statements, only delete the statement when it is the same object.
+  const auto itr = unprepared_stmts_map_.find(stmt->query_id());
+  if (itr != unprepared_stmts_map_.end() && itr->second == stmt) {
+    unprepared_stmts_map_.erase(itr);
+  }
+  if (stmt->pos() != unprepared_stmts_list_.end()) {
+    unprepared_stmts_list_.erase(stmt->pos());
+    stmt->set_pos(unprepared_stmts_list_.end());
+  }
+}
+
 bool CQLServiceImpl::CheckPassword(
     const std::string plain,
     const std::string expected_bcrypt_hash) {
@@ -17,6 +17,9 @@
 #ifndef YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 #define YB_YQL_CQL_CQLSERVER_CQL_SERVICE_H_
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <boost/compute/detail/lru_cache.hpp>
@@ -61,8 +64,8 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Processing all incoming request from RPC and sending response back.
   void Handle(yb::rpc::InboundCallPtr call) override;
 
-  // Return CQL processor at pos as available.
-  void ReturnProcessor(const CQLProcessorListPos& pos);
+  // Return CQL processor at pos of the shard as available.
+  void ReturnProcessor(size_t shard, const CQLProcessorListPos& pos);
 
   // Allocate a prepared statement. If the statement already exists, return it instead.
   std::shared_ptr<CQLStatement> AllocatePreparedStatement(
@@ -76,6 +79,14 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Delete the prepared statement from the cache.
   void DeletePreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
 
+  // Allocate a statement for a query that was not prepared by the client. If a statement of the
+  // same query exists in the unprepared statements cache and is not stale, return it instead.
+  std::shared_ptr<CQLStatement> AllocateUnpreparedStatement(
+      const CQLMessage::QueryId& id, const std::string& keyspace, const std::string& query);
+
+  // Delete the statement from the unprepared statements cache.
+  void DeleteUnpreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
+
   // Check that the password and hash match.  Leverages shared LRU cache.
   bool CheckPassword(const std::string plain, const std::string expected_bcrypt_hash);
 
@@ -109,9 +120,26 @@ class CQLServiceImpl : public CQLServerServiceIf,
  private:
   constexpr static int kRpcTimeoutSec = 5;
 
+  // CQL processors are pooled per CPU, so calls executed on different cores do not contend for the
+  // same mutex, and a processor is usually reused on the core where it was last used.
+  struct ProcessorShard {
+    // List of CQL processors (in-use and available). In-use ones are at the beginning and
+    // available ones at the end.
+    CQLProcessorList processors;
+
+    // Next available CQL processor.
+    CQLProcessorListPos next_available_processor = processors.end();
+
+    // Mutex that protects access to processors.
+    std::mutex mutex;
+  };
+
   // Either gets an available processor or creates a new one.
   Result<CQLProcessor*> GetProcessor();
 
+  // Gets an available processor from the shard, returns nullptr if there is none.
+  CQLProcessor* TakeAvailableProcessor(ProcessorShard* shard);
+
   // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
   // locked before this call.
   void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
@@ -135,15 +163,8 @@ class CQLServiceImpl : public CQLServerServiceIf,
   mutable std::atomic<bool> is_metadata_initialized_ = { false };
   mutable std::mutex metadata_init_mutex_;
 
-  // List of CQL processors (in-use and available). In-use ones are at the beginning and available
-  // ones at the end.
-  CQLProcessorList processors_;
-
-  // Next available CQL processor.
-  CQLProcessorListPos next_available_processor_;
-
-  // Mutex that protects access to processors_.
-  std::mutex processors_mutex_;
+  // Shards of the CQL processors pool, one per CPU.
+  std::vector<std::unique_ptr<ProcessorShard>> processor_shards_;
 
   // Prepared statements cache.
   CQLStatementMap prepared_stmts_map_;
@@ -154,6 +175,16 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Mutex that protects the prepared statements and the LRU list.
   std::mutex prepared_stmts_mutex_;
 
+  // Cache of statements of queries that were not prepared by the clients, so identical queries
+  // are not parsed and analyzed again. It is separate from the prepared statements cache, so
+  // these statements never evict the ones prepared by the clients.
+  CQLStatementMap unprepared_stmts_map_ GUARDED_BY(unprepared_stmts_mutex_);
+
+  // Unprepared statements LRU list (least recently used one at the end).
+  CQLStatementList unprepared_stmts_list_ GUARDED_BY(unprepared_stmts_mutex_);
+
+  std::mutex unprepared_stmts_mutex_;
+
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
   // Tracker to measure and limit memory usage of prepared statements.
@@ -177,7 +208,7 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Used to requeue the cql_inbound call to handle the response callback(s).
   rpc::Messenger* messenger_ = nullptr;
 
-  int64_t num_allocated_processors_ = 0;
+  std::atomic<int64_t> num_allocated_processors_{0};
 };
 
 }  // namespace cqlserver
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "yb/gutil/endian.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/integration-tests/yb_table_test_base.h"
 
@@ -29,6 +30,7 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(cql_server_always_send_events);
+DECLARE_int32(cql_partitions_change_event_interval_ms);
 
 namespace yb {
 namespace cqlserver {
@@ -49,14 +51,24 @@ class TestCQLService : public YBTableTestBase {
  protected:
   void SendRequestAndExpectTimeout(const string& cmd);
 
-  void SendRequestAndExpectResponse(const string& cmd, const string& resp);
+  // Sends the request over the specified socket, or over client_sock_ if it is null.
+  void SendRequestAndExpectResponse(
+      const string& cmd, const string& resp, Socket* sock = nullptr);
+
+  // Receives the next CQL message, that was not requested, e.g. an event.
+  Result<string> ReceiveMessage(Socket* sock, int timeout_in_millis);
+
+  Status ConnectClient(Socket* sock);
 
   int server_port() { return cql_server_port_; }
+
+  Socket client_sock_;
+
  private:
   Status SendRequestAndGetResponse(
-      const string& cmd, int expected_resp_length, int timeout_in_millis = 60000);
+      const string& cmd, int expected_resp_length, int timeout_in_millis = 60000,
+      Socket* sock = nullptr);
 
-  Socket client_sock_;
   unique_ptr<boost::asio::io_service> io_;
   unique_ptr<CQLServer> server_;
   int cql_server_port_ = 0;
@@ -94,11 +106,15 @@ void TestCQLService::SetUp() {
   CHECK_OK(server_->Start());
   LOG(INFO) << "CQL server successfully started.";
 
+  CHECK_OK(ConnectClient(&client_sock_));
+}
+
+Status TestCQLService::ConnectClient(Socket* sock) {
   Endpoint remote(IpAddress(), server_port());
-  CHECK_OK(client_sock_.Init(0));
-  CHECK_OK(client_sock_.SetNoDelay(false));
+  RETURN_NOT_OK(sock->Init(0));
+  RETURN_NOT_OK(sock->SetNoDelay(false));
   LOG(INFO) << "Connecting to CQL server " << remote;
-  CHECK_OK(client_sock_.Connect(remote));
+  return sock->Connect(remote);
 }
 
 void TestCQLService::TearDown() {
@@ -111,10 +127,11 @@ void TestCQLService::TearDown() {
 }
 
 Status TestCQLService::SendRequestAndGetResponse(
-    const string& cmd, int expected_resp_length, int timeout_in_millis) {
+    const string& cmd, int expected_resp_length, int timeout_in_millis, Socket* sock) {
+  Socket& client_sock = sock ? *sock : client_sock_;
   // Send the request.
   int32_t bytes_written = 0;
-  EXPECT_OK(client_sock_.Write(util::to_uchar_ptr(cmd.c_str()), cmd.length(), &bytes_written));
+  EXPECT_OK(client_sock.Write(util::to_uchar_ptr(cmd.c_str()), cmd.length(), &bytes_written));
 
   EXPECT_EQ(cmd.length(), bytes_written);
 
@@ -122,7 +139,7 @@ Status TestCQLService::SendRequestAndGetResponse(
   MonoTime deadline = MonoTime::Now();
   deadline.AddDelta(MonoDelta::FromMilliseconds(timeout_in_millis));
   size_t bytes_read = 0;
-  RETURN_NOT_OK(client_sock_.BlockingRecv(resp_, expected_resp_length, &bytes_read, deadline));
+  RETURN_NOT_OK(client_sock.BlockingRecv(resp_, expected_resp_length, &bytes_read, deadline));
   if (expected_resp_length != bytes_read) {
     return STATUS(
         IOError, Substitute("Received $1 bytes instead of $2", bytes_read, expected_resp_length));
@@ -132,7 +149,7 @@ Status TestCQLService::SendRequestAndGetResponse(
   bytes_read = 0;
   deadline = MonoTime::Now();
   deadline.AddDelta(MonoDelta::FromMilliseconds(200));
-  Status s = client_sock_.BlockingRecv(&resp_[expected_resp_length], 1, &bytes_read, deadline);
+  Status s = client_sock.BlockingRecv(&resp_[expected_resp_length], 1, &bytes_read, deadline);
   EXPECT_EQ(0, bytes_read) << "In the read socket unexpected extra byte: 0x" << std::hex <<
       static_cast<int>(resp_[expected_resp_length]) <<
       " (0x84 usually means additional unexpected CQL message)";
@@ -146,13 +163,29 @@ void TestCQLService::SendRequestAndExpectTimeout(const string& cmd) {
   ASSERT_TRUE(SendRequestAndGetResponse(cmd, 1).IsTimedOut());
 }
 
-void TestCQLService::SendRequestAndExpectResponse(const string& cmd, const string& resp) {
-  CHECK_OK(SendRequestAndGetResponse(cmd, resp.length()));
+void TestCQLService::SendRequestAndExpectResponse(
+    const string& cmd, const string& resp, Socket* sock) {
+  CHECK_OK(SendRequestAndGetResponse(cmd, resp.length(), 60000, sock));
 
   // Verify that the response is as expected.
   CHECK_EQ(resp, string(reinterpret_cast<char*>(resp_), resp.length()));
 }
 
+Result<string> TestCQLService::ReceiveMessage(Socket* sock, int timeout_in_millis) {
+  MonoTime deadline = MonoTime::Now();
+  deadline.AddDelta(MonoDelta::FromMilliseconds(timeout_in_millis));
+  string message(CQLMessage::kMessageHeaderLength, 0);
+  size_t bytes_read = 0;
+  RETURN_NOT_OK(sock->BlockingRecv(
+      util::to_uchar_ptr(&message[0]), message.size(), &bytes_read, deadline));
+  const auto body_length = BigEndian::Load32(&message[CQLMessage::kHeaderPosLength]);
+  message.resize(message.size() + body_length);
+  RETURN_NOT_OK(sock->BlockingRecv(
+      util::to_uchar_ptr(&message[CQLMessage::kMessageHeaderLength]), body_length, &bytes_read,
+      deadline));
+  return message;
+}
+
 // The following test cases test the CQL protocol marshalling/unmarshalling with hand-coded
 // request messages and expected responses. They are good as basic and error-handling tests.
 // These are expected to be few.
@@ -410,5 +443,60 @@ TEST_F(TestCQLServiceWithGFlag, SchemaChangeEventWithGFlag) {
   TestSchemaChangeEvent();
 }
 
+class TestCQLServicePartitionsChangeEvent : public TestCQLService {
+ public:
+  void SetUp() override {
+    FLAGS_cql_partitions_change_event_interval_ms = 100;
+    TestCQLService::SetUp();
+  }
+};
+
+TEST_F(TestCQLServicePartitionsChangeEvent, SentToRegisteredConnections) {
+  // client_sock_ registers for TOPOLOGY_CHANGE, schema_sock only for SCHEMA_CHANGE, and
+  // unregistered_sock does not register for events at all.
+  Socket schema_sock;
+  Socket unregistered_sock;
+  ASSERT_OK(ConnectClient(&schema_sock));
+  ASSERT_OK(ConnectClient(&unregistered_sock));
+  for (auto* sock : {&client_sock_, &schema_sock, &unregistered_sock}) {
+    SendRequestAndExpectResponse(
+        BINARY_STRING("\x04\x00\x00\x00\x01" "\x00\x00\x00\x16"
+                      "\x00\x01" "\x00\x0b" "CQL_VERSION"
+                                 "\x00\x05" "3.0.0"),
+        BINARY_STRING("\x84\x00\x00\x00\x02" "\x00\x00\x00\x00"),
+        sock);
+  }
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x00\x0b" "\x00\x00\x00\x13"
+                    "\x00\x01"  "\x00\x0f" "TOPOLOGY_CHANGE"),
+      BINARY_STRING("\x84\x00\x00\x00\x02" "\x00\x00\x00\x00"));
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x00\x0b" "\x00\x00\x00\x11"
+                    "\x00\x01"  "\x00\x0d" "SCHEMA_CHANGE"),
+      BINARY_STRING("\x84\x00\x00\x00\x02" "\x00\x00\x00\x00"),
+      &schema_sock);
+
+  // Simulate moved tablet leadership.
+  auto* tserver = mini_cluster()->mini_tablet_server(0)->server();
+  tserver->SetTabletLocationsVersion(tserver->tablet_locations_version() + 1000);
+
+  auto event = ASSERT_RESULT(ReceiveMessage(&client_sock_, 10000));
+  ASSERT_EQ(BINARY_STRING("\x84\x00\xff\xff\x0c"), event.substr(0, 5));
+  ASSERT_NE(string::npos, event.find(BINARY_STRING("\x00\x0f" "TOPOLOGY_CHANGE")));
+  ASSERT_NE(string::npos, event.find(BINARY_STRING("\x00\x0a" "MOVED_NODE")));
+
+  // Connections not registered for topology changes don't receive the event.
+  for (auto* sock : {&schema_sock, &unregistered_sock}) {
+    uint8_t byte = 0;
+    size_t bytes_read = 0;
+    MonoTime deadline = MonoTime::Now();
+    deadline.AddDelta(MonoDelta::FromMilliseconds(1000));
+    auto status = sock->BlockingRecv(&byte, 1, &bytes_read, deadline);
+    ASSERT_TRUE(status.IsTimedOut()) << "Unexpected data in socket: " << status << ", byte: 0x"
+                                     << std::hex << static_cast<int>(byte);
+    ASSERT_OK(sock->Close());
+  }
+}
+
 }  // namespace cqlserver
 }  // namespace yb
@@ -108,6 +108,7 @@ CHECKED_STATUS Executor::PTExprToPB(const PTBindVar *bind_pt, QLExpressionPB *ex
                                                         bind_pt->ql_type(),
                                                         &ql_bind));
   *expr_pb->mutable_value() = std::move(*ql_bind.mutable_value());
+  ++num_bind_vars_converted_;
   return Status::OK();
 }
 
@@ -16,11 +16,24 @@
 #include "yb/yql/cql/ql/exec/exec_context.h"
 #include "yb/yql/cql/ql/ptree/pt_select.h"
 #include "yb/client/callbacks.h"
+#include "yb/client/error.h"
 #include "yb/client/table.h"
 #include "yb/client/yb_op.h"
 #include "yb/rpc/thread_pool.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
 
+using namespace yb::size_literals;
+
+DEFINE_int32(cql_prefetch_max_staleness_ms, 1000,
+             "Prefetched next page of a SELECT is not returned to the client if it was read more "
+             "than this number of milliseconds before the client asked for it.");
+
+DEFINE_int64(cql_prefetch_max_page_bytes, 4_MB,
+             "Prefetched next page of a SELECT is dropped if its rows take more than this number "
+             "of bytes, unless the client already asked for it. At most one page is prefetched "
+             "per client connection.");
+
 namespace yb {
 namespace ql {
 
@@ -268,5 +281,70 @@ void TnodeContext::SetUncoveredSelectOp(const YBqlReadOpPtr& select_op) {
   keys_ = std::make_unique<QLRowBlock>(schema, key_column_ids);
 }
 
+//--------------------------------------------------------------------------------------------------
+PrefetchedRead::PrefetchedRead(std::string request_key, YBqlReadOpPtr op)
+    : request_key_(std::move(request_key)),
+      op_(std::move(op)),
+      start_time_(CoarseMonoClock::Now()) {
+}
+
+Status PrefetchedRead::Start(const YBSessionPtr& session) {
+  session_ = session;
+  TRACE("Apply Prefetch");
+  RETURN_NOT_OK(session_->Apply(op_));
+  session_->FlushAsync([prefetched_read = shared_from_this()](const Status& s) {
+      prefetched_read->FlushDone(s);
+    });
+  return Status::OK();
+}
+
+void PrefetchedRead::FlushDone(const Status& status) {
+  DoneCallback callback;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    // When the operation fails, YBSession saves its error and returns IOError.
+    if (status.IsIOError()) {
+      for (const auto& error : session_->GetPendingErrors()) {
+        op_status_ = error->status();
+      }
+    } else {
+      flush_status_ = status;
+    }
+    done_ = true;
+    if (!used_ &&
+        static_cast<int64_t>(op_->rows_data().size()) > FLAGS_cql_prefetch_max_page_bytes) {
+      dropped_ = true;
+      op_->mutable_rows_data()->clear();
+      op_->mutable_response()->Clear();
+    }
+    callback = std::move(callback_);
+  }
+  if (callback) {
+    callback(flush_status_, op_status_);
+  }
+}
+
+bool PrefetchedRead::TryUse() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (dropped_ ||
+      CoarseMonoClock::Now() - start_time_ >
+          std::chrono::milliseconds(FLAGS_cql_prefetch_max_staleness_ms)) {
+    return false;
+  }
+  used_ = true;
+  return true;
+}
+
+void PrefetchedRead::WaitAsync(DoneCallback callback) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!done_) {
+      callback_ = std::move(callback);
+      return;
+    }
+  }
+  callback(flush_status_, op_status_);
+}
+
 }  // namespace ql
 }  // namespace yb
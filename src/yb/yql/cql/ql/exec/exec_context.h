@@ -20,6 +20,10 @@
 #ifndef YB_YQL_CQL_QL_EXEC_EXEC_CONTEXT_H_
 #define YB_YQL_CQL_QL_EXEC_EXEC_CONTEXT_H_
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
 #include "yb/yql/cql/ql/ptree/process_context.h"
 #include "yb/yql/cql/ql/util/ql_env.h"
 #include "yb/yql/cql/ql/util/statement_params.h"
@@ -27,6 +31,7 @@
 #include "yb/common/common.pb.h"
 #include "yb/client/client.h"
 #include "yb/client/session.h"
+#include "yb/util/monotime.h"
 
 namespace yb {
 namespace ql {
@@ -175,6 +180,52 @@ class TnodeContext {
   std::unique_ptr<QLRowBlock> keys_;
 };
 
+// Read of the next page of a SELECT statement, issued while the current page is being returned to
+// the client. It is kept in the QL session of the client connection, and used instead of reading
+// the page again if the next execution of the statement continues from the same paging state.
+class PrefetchedRead : public std::enable_shared_from_this<PrefetchedRead> {
+ public:
+  // Callback invoked when the read is done, with the status of the flush and of the operation.
+  typedef std::function<void(const Status& flush_status, const Status& op_status)> DoneCallback;
+
+  PrefetchedRead(std::string request_key, client::YBqlReadOpPtr op);
+
+  // Key of the read, i.e. the serialized read request.
+  const std::string& request_key() const {
+    return request_key_;
+  }
+
+  const client::YBqlReadOpPtr& op() const {
+    return op_;
+  }
+
+  // Applies the read operation to the session and flushes it.
+  CHECKED_STATUS Start(const client::YBSessionPtr& session);
+
+  // Marks the prefetched page as used if it was not dropped and is not too stale to be returned.
+  // Returns true if it could be used.
+  bool TryUse();
+
+  // Invokes the callback once the read is done.
+  void WaitAsync(DoneCallback callback);
+
+ private:
+  void FlushDone(const Status& status);
+
+  const std::string request_key_;
+  const client::YBqlReadOpPtr op_;
+  const CoarseTimePoint start_time_;
+  client::YBSessionPtr session_;
+
+  mutable std::mutex mutex_;
+  bool done_ = false;
+  bool used_ = false;
+  bool dropped_ = false;
+  Status flush_status_;
+  Status op_status_;
+  DoneCallback callback_;
+};
+
 // Processing could take a while, we are rescheduling it to our thread pool, if not yet
 // running in it.
 class Rescheduler {
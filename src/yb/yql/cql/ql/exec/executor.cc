@@ -38,6 +38,10 @@
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
+DEFINE_bool(cql_prefetch_next_page, false,
+            "Whether to read the next page of a SELECT paged by the client while the current page "
+            "is being returned to the client.");
+
 namespace yb {
 namespace ql {
 
@@ -176,6 +180,11 @@ Status Executor::Execute(const ParseTree& parse_tree, const StatementParameters&
   exec_contexts_.emplace_back(parse_tree, params);
   exec_context_ = &exec_contexts_.back();
   auto root_node = parse_tree.root().get();
+  if (root_node && root_node->opcode() != TreeNodeOpcode::kPTSelectStmt) {
+    // Page prefetched before this statement may miss its writes, so drop it to let the next page
+    // of the SELECT be read again after them.
+    DropPrefetchedRead();
+  }
   RETURN_NOT_OK(PreExecTreeNode(root_node));
   return ProcessStatementStatus(parse_tree, ExecTreeNode(root_node));
 }
@@ -781,6 +790,36 @@ Status Executor::GetOffsetOrLimit(
 
 //--------------------------------------------------------------------------------------------------
 
+Status Executor::SelectedExprsToPB(const PTSelectStmt *tnode, QLReadRequestPB *req) {
+  // Specify selected list by adding the expressions to selected_exprs in read request.
+  QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
+  for (const auto& expr : tnode->selected_exprs()) {
+    if (expr->opcode() == TreeNodeOpcode::kPTAllColumns) {
+      const Status s = PTExprToPB(static_cast<const PTAllColumns*>(expr.get()), req);
+      if (PREDICT_FALSE(!s.ok())) {
+        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
+      }
+    } else {
+      const Status s = PTExprToPB(expr, req->add_selected_exprs());
+      if (PREDICT_FALSE(!s.ok())) {
+        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
+      }
+
+      // Add the expression metadata (rsrow descriptor).
+      QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
+      rscol_desc_pb->set_name(expr->QLName());
+      expr->rscol_type_PB(rscol_desc_pb->mutable_ql_type());
+    }
+  }
+
+  // Setup the column values that need to be read.
+  const Status s = ColumnRefsToPB(tnode, req->mutable_column_refs());
+  if (PREDICT_FALSE(!s.ok())) {
+    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
+  }
+  return Status::OK();
+}
+
 Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_context) {
   const shared_ptr<client::YBTable>& table = tnode->table();
   if (table == nullptr) {
@@ -851,32 +890,22 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
 
   req->set_is_forward_scan(tnode->is_forward_scan());
 
-  // Specify selected list by adding the expressions to selected_exprs in read request.
-  QLRSRowDescPB *rsrow_desc_pb = req->mutable_rsrow_desc();
-  for (const auto& expr : tnode->selected_exprs()) {
-    if (expr->opcode() == TreeNodeOpcode::kPTAllColumns) {
-      const Status s = PTExprToPB(static_cast<const PTAllColumns*>(expr.get()), req);
-      if (PREDICT_FALSE(!s.ok())) {
-        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
-      }
-    } else {
-      const Status s = PTExprToPB(expr, req->add_selected_exprs());
-      if (PREDICT_FALSE(!s.ok())) {
-        return exec_context_->Error(expr, s, ErrorCode::INVALID_ARGUMENTS);
-      }
-
-      // Add the expression metadata (rsrow descriptor).
-      QLRSColDescPB *rscol_desc_pb = rsrow_desc_pb->add_rscol_descs();
-      rscol_desc_pb->set_name(expr->QLName());
-      expr->rscol_type_PB(rscol_desc_pb->mutable_ql_type());
+  // Specify selected list and the column values that need to be read. They are the same for all
+  // executions of the statement unless the selected expressions use bind variables, so they are
+  // built once and copied from the template afterwards.
+  std::shared_ptr<const QLReadRequestPB> request_template = tnode->read_request_template();
+  if (request_template == nullptr) {
+    auto new_template = std::make_shared<QLReadRequestPB>();
+    const auto num_bind_vars_converted = num_bind_vars_converted_;
+    RETURN_NOT_OK(SelectedExprsToPB(tnode, new_template.get()));
+    if (num_bind_vars_converted_ == num_bind_vars_converted) {
+      tnode->set_read_request_template(new_template);
     }
+    request_template = std::move(new_template);
   }
+  req->MergeFrom(*request_template);
 
-  // Setup the column values that need to be read.
-  Status s = ColumnRefsToPB(tnode, req->mutable_column_refs());
-  if (PREDICT_FALSE(!s.ok())) {
-    return exec_context_->Error(tnode, s, ErrorCode::INVALID_ARGUMENTS);
-  }
+  Status s;
 
   // Set the IF clause.
   if (tnode->if_clause() != nullptr) {
@@ -981,10 +1010,88 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
     return Status::OK();
   }
 
+  // Save the request to prefetch the next page later, and use the current page if it was
+  // prefetched.
+  if (CanPrefetchNextPage(tnode, *req, tnode_context)) {
+    req->set_request_id(params.request_id());
+    prefetch_request_ = std::make_unique<QLReadRequestPB>(*req);
+    prefetch_tnode_ = tnode;
+    if (continue_select && UsePrefetchedRead(select_op, tnode_context)) {
+      return Status::OK();
+    }
+  }
+
   // Add the operation.
   return AddOperation(select_op, tnode_context);
 }
 
+bool Executor::CanPrefetchNextPage(const PTSelectStmt* tnode,
+                                   const QLReadRequestPB& req,
+                                   TnodeContext* tnode_context) const {
+  // Only plain selects paged by the client are prefetched, so the next request could be built from
+  // the current one and the paging state.
+  return FLAGS_cql_prefetch_next_page &&
+         exec_contexts_.size() == 1 &&
+         !exec_context_->HasTransaction() &&
+         exec_context_->parse_tree().root().get() == tnode &&
+         !tnode->is_system() &&
+         !tnode->child_select() &&
+         !tnode->is_aggregate() &&
+         !tnode->limit() &&
+         !tnode->offset() &&
+         req.return_paging_state() &&
+         tnode_context->UnreadPartitionsRemaining() == 0;
+}
+
+bool Executor::UsePrefetchedRead(const YBqlReadOpPtr& select_op, TnodeContext* tnode_context) {
+  auto prefetched_read = ql_env_->ql_session()->TakePrefetchedRead();
+  if (prefetched_read == nullptr ||
+      prefetched_read->request_key() != select_op->request().SerializeAsString() ||
+      !prefetched_read->TryUse()) {
+    return false;
+  }
+  TRACE("Use Prefetched Read");
+  tnode_context->AddOperation(select_op);
+  prefetched_read_ = std::move(prefetched_read);
+  prefetched_read_op_ = select_op;
+  return true;
+}
+
+void Executor::DropPrefetchedRead() {
+  if (ql_env_->ql_session()->TakePrefetchedRead()) {
+    TRACE("Drop Prefetched Read");
+  }
+}
+
+void Executor::PrefetchNextPage(const YBqlReadOpPtr& op, const QLPagingStatePB& paging_state) {
+  // Build the request the same way ExecPTNode() does when the SELECT is continued from the paging
+  // state, so it could be matched with the request of the next execution.
+  YBqlReadOpPtr next_op(prefetch_tnode_->table()->NewQLSelect());
+  QLReadRequestPB* req = next_op->mutable_request();
+  req->Swap(prefetch_request_.get());
+  prefetch_request_.reset();
+  prefetch_tnode_ = nullptr;
+  QLPagingStatePB* next_paging_state = req->mutable_paging_state();
+  next_paging_state->set_next_partition_key(paging_state.next_partition_key());
+  next_paging_state->set_next_row_key(paging_state.next_row_key());
+  next_paging_state->set_total_num_rows_read(paging_state.total_num_rows_read());
+  next_paging_state->set_total_rows_skipped(paging_state.total_rows_skipped());
+  next_op->set_yb_consistency_level(op->yb_consistency_level());
+
+  auto session = ql_env_->NewSession();
+  session->SetReadPoint(client::Restart::kFalse);
+  if (req->hashed_column_values().empty()) {
+    session->SetForceConsistentRead(client::ForceConsistentRead::kTrue);
+  }
+  auto prefetched_read = std::make_shared<PrefetchedRead>(req->SerializeAsString(), next_op);
+  const Status s = prefetched_read->Start(session);
+  if (!s.ok()) {
+    VLOG(1) << "Failed to prefetch next page: " << s;
+    return;
+  }
+  ql_env_->ql_session()->SetPrefetchedRead(std::move(prefetched_read));
+}
+
 Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
                                      const YBqlReadOpPtr& op,
                                      TnodeContext* tnode_context,
@@ -1074,6 +1181,10 @@ Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
       paging_state.set_original_request_id(exec_context_->params().request_id());
 
       current_result->SetPagingState(paging_state);
+
+      if (tnode == prefetch_tnode_) {
+        PrefetchNextPage(op, paging_state);
+      }
     }
 
     return false;
@@ -1525,10 +1636,15 @@ void Executor::FlushAsync() {
   // prior operations in the uncommitted transactions. num_flushes_ is updated before FlushAsync()
   // and CommitTransaction() are called to avoid race condition of recursive FlushAsync() called
   // from FlushAsyncDone() and CommitDone().
+  auto prefetched_read = std::move(prefetched_read_);
+  auto prefetched_read_op = std::move(prefetched_read_op_);
   DCHECK_EQ(num_async_calls_, 0);
-  num_async_calls_ = flush_sessions.size() + commit_contexts.size();
+  num_async_calls_ = flush_sessions.size() + commit_contexts.size() + (prefetched_read ? 1 : 0);
   num_flushes_ += flush_sessions.size();
   async_status_ = Status::OK();
+  if (ql_metrics_ != nullptr && (!flush_sessions.empty() || prefetched_read)) {
+    flush_start_time_ = MonoTime::Now();
+  }
   for (auto* exec_context : commit_contexts) {
     exec_context->CommitTransaction([this, exec_context](const Status& s) {
         CommitDone(s, exec_context);
@@ -1546,8 +1662,15 @@ void Executor::FlushAsync() {
         FlushAsyncDone(s, exec_context);
       });
   }
+  if (prefetched_read) {
+    prefetched_read->WaitAsync(
+        [this, prefetched_read, prefetched_read_op](
+            const Status& flush_status, const Status& op_status) {
+          PrefetchedReadDone(flush_status, op_status, prefetched_read, prefetched_read_op);
+        });
+  }
 
-  if (flush_sessions.empty() && commit_contexts.empty()) {
+  if (flush_sessions.empty() && commit_contexts.empty() && !prefetched_read) {
     // If this is a batch returning status, append the rows in the user-given order before
     // returning result.
     if (IsReturnsStatusBatch()) {
@@ -1577,6 +1700,12 @@ void Executor::FlushAsync() {
 // deferred to ProcessAsyncResults() that will be invoked exclusively.
 void Executor::FlushAsyncDone(Status s, ExecContext* exec_context) {
   TRACE("Flush Async Done");
+  // Operations in a session are sent to the tablets in parallel, one RPC per tablet, so each flush
+  // completes a sub-batch of the statements being executed.
+  if (ql_metrics_ != nullptr) {
+    ql_metrics_->time_to_flush_ql_ops_->Increment(
+        MonoTime::Now().GetDeltaSince(flush_start_time_).ToMicroseconds());
+  }
   // Process FlushAsync status for either transactional session in an ExecContext, or the
   // non-transactional session in the Executor for other ExecContexts with no transactional session.
   const YBSessionPtr& session = exec_context != nullptr ? GetSession(exec_context) : session_;
@@ -1591,6 +1720,29 @@ void Executor::FlushAsyncDone(Status s, ExecContext* exec_context) {
     s = Status::OK();
   }
 
+  FlushDone(std::move(s), op_errors, exec_context);
+}
+
+void Executor::PrefetchedReadDone(const Status& flush_status,
+                                  const Status& op_status,
+                                  const std::shared_ptr<PrefetchedRead>& prefetched_read,
+                                  const YBqlReadOpPtr& op) {
+  TRACE("Prefetched Read Done");
+  if (ql_metrics_ != nullptr) {
+    ql_metrics_->time_to_flush_ql_ops_->Increment(
+        MonoTime::Now().GetDeltaSince(flush_start_time_).ToMicroseconds());
+  }
+  // The prefetched read is used only once, so its result could be moved.
+  *op->mutable_response() = std::move(*prefetched_read->op()->mutable_response());
+  *op->mutable_rows_data() = std::move(*prefetched_read->op()->mutable_rows_data());
+  OpErrors op_errors;
+  if (!op_status.ok()) {
+    op_errors[op.get()] = op_status;
+  }
+  FlushDone(flush_status, op_errors, nullptr /* exec_context */);
+}
+
+void Executor::FlushDone(Status s, const OpErrors& op_errors, ExecContext* exec_context) {
   if (s.ok()) {
     if (exec_context != nullptr) {
       s = ProcessAsyncStatus(op_errors, exec_context);
@@ -2351,6 +2503,10 @@ void Executor::Reset() {
   write_batch_.Clear();
   session_->Abort();
   num_flushes_ = 0;
+  prefetch_request_.reset();
+  prefetch_tnode_ = nullptr;
+  prefetched_read_ = nullptr;
+  prefetched_read_op_ = nullptr;
   result_ = nullptr;
   cb_.Reset();
   returns_status_batch_opt_ = boost::none;
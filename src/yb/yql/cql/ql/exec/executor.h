@@ -142,6 +142,9 @@ class Executor : public QLExprExecutor {
   // Select statement.
   CHECKED_STATUS ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_context);
 
+  // Convert selected expressions and column references of a SELECT statement to protobuf.
+  CHECKED_STATUS SelectedExprsToPB(const PTSelectStmt *tnode, QLReadRequestPB *req);
+
   // Insert statement.
   CHECKED_STATUS ExecPTNode(const PTInsertStmt *tnode, TnodeContext* tnode_context);
 
@@ -211,6 +214,31 @@ class Executor : public QLExprExecutor {
   using OpErrors = std::unordered_map<const client::YBqlOp*, Status>;
   CHECKED_STATUS ProcessAsyncStatus(const OpErrors& op_errors, ExecContext* exec_context);
 
+  // Process the status of a flush of the session in exec_context, or of the non-transactional
+  // session if exec_context is null, with the errors of the flushed operations.
+  void FlushDone(Status s, const OpErrors& op_errors, ExecContext* exec_context);
+
+  // Whether the next page of the SELECT could be read ahead while the current one is returned.
+  bool CanPrefetchNextPage(const PTSelectStmt* tnode,
+                           const QLReadRequestPB& req,
+                           TnodeContext* tnode_context) const;
+
+  // Uses the page prefetched in the QL session as the result of select_op if it was read by the
+  // same request. Returns true if it is used.
+  bool UsePrefetchedRead(const client::YBqlReadOpPtr& select_op, TnodeContext* tnode_context);
+
+  // Drops the page prefetched in the QL session, so the next page of the SELECT is read again.
+  void DropPrefetchedRead();
+
+  // Starts reading the page of the SELECT, that follows the paging state returned to the client.
+  void PrefetchNextPage(const client::YBqlReadOpPtr& op, const QLPagingStatePB& paging_state);
+
+  // Callback for the prefetched read used as the result of op.
+  void PrefetchedReadDone(const Status& flush_status,
+                          const Status& op_status,
+                          const std::shared_ptr<PrefetchedRead>& prefetched_read,
+                          const client::YBqlReadOpPtr& op);
+
   // Append rows result.
   CHECKED_STATUS AppendRowsResult(RowsResult::SharedPtr&& rows_result);
 
@@ -416,6 +444,10 @@ class Executor : public QLExprExecutor {
   ExecContext* exec_context_ = nullptr;
   std::list<ExecContext> exec_contexts_;
 
+  // Number of bind variables converted to protobuf, used to detect whether a part of a request
+  // depends on bound values.
+  int64_t num_bind_vars_converted_ = 0;
+
   // Batch of outstanding write operations that are being applied.
   WriteBatch write_batch_;
 
@@ -432,6 +464,17 @@ class Executor : public QLExprExecutor {
   // The number of FlushAsync called to execute the statements.
   int64_t num_flushes_ = 0;
 
+  // Start time of the current round of flushes.
+  MonoTime flush_start_time_;
+
+  // Request of the SELECT statement whose next page would be prefetched, and its tree node.
+  std::unique_ptr<QLReadRequestPB> prefetch_request_;
+  const PTSelectStmt* prefetch_tnode_ = nullptr;
+
+  // Prefetched read to be used as the result of the operation reading the current page.
+  std::shared_ptr<PrefetchedRead> prefetched_read_;
+  client::YBqlReadOpPtr prefetched_read_op_;
+
   // Execution result.
   ExecutedResult::SharedPtr result_;
 
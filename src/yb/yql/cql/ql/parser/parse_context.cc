@@ -34,8 +34,10 @@ using std::string;
 ParseContext::ParseContext(const string& stmt,
                            const bool reparsed,
                            const MemTrackerPtr& mem_tracker,
-                           const bool internal)
-    : ProcessContext(ParseTree::UniPtr(new ParseTree(stmt, reparsed, mem_tracker, internal))),
+                           const bool internal,
+                           const ParseTreeMemPoolPtr& mem_pool)
+    : ProcessContext(ParseTree::UniPtr(
+          new ParseTree(stmt, reparsed, mem_tracker, internal, mem_pool))),
       bind_variables_(PTreeMem()),
       stmt_offset_(0),
       trace_scanning_(false),
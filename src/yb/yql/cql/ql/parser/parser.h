@@ -44,7 +44,8 @@ class Parser {
   // semantic analysis. Otherwise, it returns one of the errcodes that are defined in file
   // "yb/yql/cql/ql/errcodes.h", and the caller (QL API) should stop the compiling process.
   CHECKED_STATUS Parse(const std::string& stmt, bool reparsed,
-                       const MemTrackerPtr& mem_tracker = nullptr, const bool internal = false);
+                       const MemTrackerPtr& mem_tracker = nullptr, const bool internal = false,
+                       const ParseTreeMemPoolPtr& mem_pool = nullptr);
 
   // Returns the generated parse tree.
   ParseTree::UniPtr Done();
@@ -20,31 +20,74 @@
 #include "yb/yql/cql/ql/ptree/tree_node.h"
 #include "yb/yql/cql/ql/ptree/sem_context.h"
 
+#include "yb/gutil/bits.h"
+
 namespace yb {
 namespace ql {
 
 using std::string;
 
+namespace {
+
+BufferAllocator* BaseAllocator(const ParseTreeMemPoolPtr& mem_pool) {
+  return mem_pool ? mem_pool->allocator() : HeapBufferAllocator::Get();
+}
+
+} // namespace
+
+//--------------------------------------------------------------------------------------------------
+// Parse Tree Memory Pool
+//--------------------------------------------------------------------------------------------------
+
+ParseTreeMemPool::ParseTreeMemPool(size_t max_pooled_bytes)
+    : allocator_(HeapBufferAllocator::Get(), max_pooled_bytes),
+      ptree_block_size_(Arena::kStartBlockSize),
+      psem_block_size_(Arena::kStartBlockSize) {
+}
+
+void ParseTreeMemPool::RecordUsage(size_t ptree_footprint, size_t psem_footprint) {
+  UpdateBlockSize(ptree_footprint, &ptree_block_size_);
+  UpdateBlockSize(psem_footprint, &psem_block_size_);
+}
+
+void ParseTreeMemPool::UpdateBlockSize(size_t footprint, std::atomic<size_t>* block_size) {
+  // The footprint includes the initial block, so it is not less than the block size, unless the
+  // tree needed more blocks. Then the block size grows so the next tree of such size fits into
+  // one block. Sizes are rounded up to powers of 2, so blocks of similar trees can be reused.
+  size_t target = std::max<size_t>(footprint, Arena::kStartBlockSize);
+  target = std::min<size_t>(1ULL << Bits::Log2Ceiling64(target), Arena::kMaxBlockSize);
+  if (target > block_size->load(std::memory_order_relaxed)) {
+    block_size->store(target, std::memory_order_relaxed);
+  }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 // Parse Tree
 //--------------------------------------------------------------------------------------------------
 
 ParseTree::ParseTree(const string& stmt, const bool reparsed, const MemTrackerPtr& mem_tracker,
-                     const bool internal)
+                     const bool internal, const ParseTreeMemPoolPtr& mem_pool)
     : stmt_(stmt),
       reparsed_(reparsed),
+      mem_pool_(mem_pool),
       buffer_allocator_(mem_tracker ?
-                        std::make_shared<MemoryTrackingBufferAllocator>(HeapBufferAllocator::Get(),
+                        std::make_shared<MemoryTrackingBufferAllocator>(BaseAllocator(mem_pool),
                                                                         mem_tracker) :
                         nullptr),
-      ptree_mem_(buffer_allocator_ ? buffer_allocator_.get() : HeapBufferAllocator::Get()),
-      psem_mem_(buffer_allocator_ ? buffer_allocator_.get() : HeapBufferAllocator::Get()),
+      ptree_mem_(buffer_allocator_ ? buffer_allocator_.get() : BaseAllocator(mem_pool),
+                 mem_pool ? mem_pool->ptree_block_size() : Arena::kStartBlockSize),
+      psem_mem_(buffer_allocator_ ? buffer_allocator_.get() : BaseAllocator(mem_pool),
+                mem_pool ? mem_pool->psem_block_size() : Arena::kStartBlockSize),
       internal_(internal) {
 }
 
 ParseTree::~ParseTree() {
   // Make sure we delete the tree first before deleting the memory pools.
   root_ = nullptr;
+  if (mem_pool_) {
+    mem_pool_->RecordUsage(ptree_mem_.memory_footprint(), psem_mem_.memory_footprint());
+  }
 }
 
 CHECKED_STATUS ParseTree::Analyze(SemContext *sem_context) {
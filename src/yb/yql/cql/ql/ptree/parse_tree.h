@@ -21,14 +21,51 @@
 #ifndef YB_YQL_CQL_QL_PTREE_PARSE_TREE_H_
 #define YB_YQL_CQL_QL_PTREE_PARSE_TREE_H_
 
+#include <atomic>
+
 #include "yb/client/yb_table_name.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/memory/memory.h"
 #include "yb/yql/cql/ql/ptree/tree_node.h"
 #include "yb/yql/cql/ql/util/ql_env.h"
 
 namespace yb {
 namespace ql {
 
+// Memory shared by parse trees of one QL processor. Arena blocks of destroyed parse trees are kept
+// for the parse trees of next statements, and initial block sizes of their arenas grow to the
+// memory used by statements of this processor. So the tree of a short statement is normally built
+// in a single block taken from the pool, instead of allocating its nodes through malloc.
+class ParseTreeMemPool {
+ public:
+  explicit ParseTreeMemPool(size_t max_pooled_bytes);
+
+  PoolingBufferAllocator* allocator() {
+    return &allocator_;
+  }
+
+  // Initial block sizes of the parse tree and semantic analysis arenas.
+  size_t ptree_block_size() const {
+    return ptree_block_size_.load(std::memory_order_relaxed);
+  }
+
+  size_t psem_block_size() const {
+    return psem_block_size_.load(std::memory_order_relaxed);
+  }
+
+  // Grows initial block sizes to the memory used by a destroyed parse tree.
+  void RecordUsage(size_t ptree_footprint, size_t psem_footprint);
+
+ private:
+  static void UpdateBlockSize(size_t footprint, std::atomic<size_t>* block_size);
+
+  PoolingBufferAllocator allocator_;
+  std::atomic<size_t> ptree_block_size_;
+  std::atomic<size_t> psem_block_size_;
+};
+
+typedef std::shared_ptr<ParseTreeMemPool> ParseTreeMemPoolPtr;
+
 // Parse Tree
 class ParseTree {
  public:
@@ -40,9 +77,11 @@ class ParseTree {
   //------------------------------------------------------------------------------------------------
   // Public functions.
 
-  // Constructs a parse tree. The parse tree saves a reference to the statement string.
+  // Constructs a parse tree. The parse tree saves a reference to the statement string. When
+  // mem_pool is specified, the memory of the tree is allocated from it, and returned to it when the
+  // tree is destroyed.
   ParseTree(const std::string& stmt, bool reparsed, const MemTrackerPtr& mem_tracker = nullptr,
-            const bool internal = false);
+            const bool internal = false, const ParseTreeMemPoolPtr& mem_pool = nullptr);
   ~ParseTree();
 
   // Run semantics analysis.
@@ -111,6 +150,10 @@ class ParseTree {
   // Has this statement been reparsed?
   mutable std::atomic<bool> reparsed_ = {false};
 
+  // Pool the memory of this tree is allocated from. It is shared with the processor, because
+  // prepared statements could outlive it.
+  ParseTreeMemPoolPtr mem_pool_;
+
   std::shared_ptr<BufferAllocator> buffer_allocator_;
 
   // Set of tables used during semantic analysis.
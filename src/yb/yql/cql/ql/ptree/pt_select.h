@@ -18,6 +18,11 @@
 #ifndef YB_YQL_CQL_QL_PTREE_PT_SELECT_H_
 #define YB_YQL_CQL_QL_PTREE_PT_SELECT_H_
 
+#include <atomic>
+#include <memory>
+
+#include "yb/common/ql_protocol.pb.h"
+
 #include "yb/yql/cql/ql/ptree/list_node.h"
 #include "yb/yql/cql/ql/ptree/tree_node.h"
 #include "yb/yql/cql/ql/ptree/pt_name.h"
@@ -233,6 +238,19 @@ class PTSelectStmt : public PTDmlStmt {
     return covers_fully_;
   }
 
+  // Part of the read request that does not depend on bound values (selected expressions, result
+  // row descriptor and referenced columns). It is built by the executor at the first execution of
+  // the statement and copied into the requests of the following executions. The parse tree is
+  // shared by concurrent executions of a prepared statement, so the template is accessed
+  // atomically.
+  std::shared_ptr<const QLReadRequestPB> read_request_template() const {
+    return std::atomic_load(&read_request_template_);
+  }
+
+  void set_read_request_template(std::shared_ptr<const QLReadRequestPB> request) const {
+    std::atomic_store(&read_request_template_, std::move(request));
+  }
+
   // Certain tables can be read by any authorized role specifically because they are being used
   // by the Cassandra driver:
   // system_schema.keyspaces
@@ -305,6 +323,10 @@ class PTSelectStmt : public PTDmlStmt {
   // Name of all columns the SELECT statement is referenced. Similar to the list "column_refs_",
   // but this is a list of column names instead of column ids.
   MCSet<string> referenced_index_colnames_;
+
+  // -- The executor will cache the following information --
+
+  mutable std::shared_ptr<const QLReadRequestPB> read_request_template_;
 };
 
 }  // namespace ql
@@ -11,6 +11,7 @@
 // under the License.
 //
 
+#include <limits>
 #include <set>
 
 #include "yb/client/schema.h"
@@ -41,6 +42,7 @@ const std::map<std::string, PTTableProperty::KVProperty> PTTableProperty::kPrope
     {"dclocal_read_repair_chance", KVProperty::kDclocalReadRepairChance},
     {"default_time_to_live", KVProperty::kDefaultTimeToLive},
     {"gc_grace_seconds", KVProperty::kGcGraceSeconds},
+    {"history_retention_interval_sec", KVProperty::kHistoryRetentionIntervalSec},
     {"index_interval", KVProperty::kIndexInterval},
     {"memtable_flush_period_in_ms", KVProperty::kMemtableFlushPeriodInMs},
     {"min_index_interval", KVProperty::kMinIndexInterval},
@@ -207,6 +209,15 @@ CHECKED_STATUS PTTableProperty::Analyze(SemContext *sem_context) {
                                   ErrorCode::INVALID_ARGUMENTS);
       }
       break;
+    case KVProperty::kHistoryRetentionIntervalSec:
+      RETURN_SEM_CONTEXT_ERROR_NOT_OK(GetIntValueFromExpr(rhs_, table_property_name, &int_val));
+      if (int_val < 0 || int_val > std::numeric_limits<int32_t>::max()) {
+        return sem_context->Error(this,
+                                  Substitute("$0 must be greater than or equal to 0 (got $1)",
+                                             table_property_name, std::to_string(int_val)).c_str(),
+                                  ErrorCode::INVALID_ARGUMENTS);
+      }
+      break;
     case KVProperty::kIndexInterval: FALLTHROUGH_INTENDED;
     case KVProperty::kMinIndexInterval: FALLTHROUGH_INTENDED;
     case KVProperty::kMaxIndexInterval:
@@ -408,6 +419,15 @@ Status PTTableProperty::SetTableProperty(yb::TableProperties *table_property) co
       }
       table_property->SetNumTablets(val);
       break;
+    case KVProperty::kHistoryRetentionIntervalSec: {
+      int64_t val;
+      if (!GetIntValueFromExpr(rhs_, table_property_name, &val).ok()) {
+        return STATUS(InvalidArgument,
+                      Substitute("Invalid value for history_retention_interval_sec"));
+      }
+      table_property->SetHistoryRetentionIntervalSec(static_cast<int32_t>(val));
+      break;
+    }
   }
   return Status::OK();
 }
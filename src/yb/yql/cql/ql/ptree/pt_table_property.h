@@ -47,6 +47,7 @@ class PTTableProperty : public PTProperty {
     kDclocalReadRepairChance,
     kDefaultTimeToLive,
     kGcGraceSeconds,
+    kHistoryRetentionIntervalSec,
     kIndexInterval,
     kMemtableFlushPeriodInMs,
     kMinIndexInterval,
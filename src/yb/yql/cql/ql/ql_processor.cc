@@ -21,11 +21,20 @@
 #include "yb/client/table.h"
 #include "yb/client/yb_table_name.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/thread_restrictions.h"
 
 #include "yb/yql/cql/ql/statement.h"
 
+using namespace yb::size_literals;
+
+DEFINE_int64(ql_parse_tree_mem_pool_max_bytes, 256_KB,
+             "Maximum size of arena blocks of destroyed parse trees, that each QL processor keeps "
+             "for parse trees of next statements. 0 disables pooling.");
+TAG_FLAG(ql_parse_tree_mem_pool_max_bytes, advanced);
+
 DECLARE_bool(use_cassandra_authentication);
 
 METRIC_DEFINE_histogram_with_percentiles(
@@ -52,6 +61,11 @@ METRIC_DEFINE_histogram_with_percentiles(
     server, handler_latency_yb_cqlserver_SQLProcessor_NumFlushesToExecute,
     "Number of flushes to successfully execute a SQL query", yb::MetricUnit::kOperations,
     "Number of flushes to successfully execute a SQL query", 60000000LU, 2);
+METRIC_DEFINE_histogram_with_percentiles(
+    server, handler_latency_yb_cqlserver_SQLProcessor_FlushOps,
+    "Time spent flushing a round of buffered operations of a SQL query",
+    yb::MetricUnit::kMicroseconds,
+    "Time spent flushing a round of buffered operations of a SQL query", 60000000LU, 2);
 METRIC_DEFINE_histogram_with_percentiles(
     server, handler_latency_yb_cqlserver_SQLProcessor_SelectStmt,
     "Time spent processing a SELECT statement", yb::MetricUnit::kMicroseconds,
@@ -107,6 +121,8 @@ QLMetrics::QLMetrics(const scoped_refptr<yb::MetricEntity> &metric_entity) {
   num_flushes_to_execute_ql_ =
       METRIC_handler_latency_yb_cqlserver_SQLProcessor_NumFlushesToExecute.Instantiate(
           metric_entity);
+  time_to_flush_ql_ops_ =
+      METRIC_handler_latency_yb_cqlserver_SQLProcessor_FlushOps.Instantiate(metric_entity);
 
   ql_select_ =
       METRIC_handler_latency_yb_cqlserver_SQLProcessor_SelectStmt.Instantiate(metric_entity);
@@ -141,6 +157,10 @@ QLProcessor::QLProcessor(client::YBClient* client,
       executor_(&ql_env_, this, ql_metrics),
       ql_metrics_(ql_metrics),
       parser_pool_(parser_pool ? parser_pool : &default_parser_pool) {
+  if (FLAGS_ql_parse_tree_mem_pool_max_bytes > 0) {
+    parse_tree_mem_pool_ = std::make_shared<ParseTreeMemPool>(
+        FLAGS_ql_parse_tree_mem_pool_max_bytes);
+  }
 }
 
 QLProcessor::~QLProcessor() {
@@ -155,7 +175,7 @@ Status QLProcessor::Parse(const string& stmt, ParseTree::UniPtr* parse_tree,
   auto scope_exit = ScopeExit([this, parser] {
     this->parser_pool_->Release(parser);
   });
-  RETURN_NOT_OK(parser->Parse(stmt, reparsed, mem_tracker, internal));
+  RETURN_NOT_OK(parser->Parse(stmt, reparsed, mem_tracker, internal, parse_tree_mem_pool_));
   const MonoTime end_time = MonoTime::Now();
   if (ql_metrics_ != nullptr) {
     const MonoDelta elapsed_time = end_time.GetDeltaSince(begin_time);
@@ -42,6 +42,7 @@ class QLMetrics {
   scoped_refptr<yb::Histogram> num_rounds_to_analyze_ql_;
   scoped_refptr<yb::Histogram> num_retries_to_execute_ql_;
   scoped_refptr<yb::Histogram> num_flushes_to_execute_ql_;
+  scoped_refptr<yb::Histogram> time_to_flush_ql_ops_;
 
   scoped_refptr<yb::Histogram> ql_select_;
   scoped_refptr<yb::Histogram> ql_insert_;
@@ -114,6 +115,10 @@ class QLProcessor : public Rescheduler {
 
   ThreadSafeObjectPool<Parser>* parser_pool_;
 
+  // Memory reused by parse trees of statements processed by this processor. Null when pooling is
+  // disabled.
+  ParseTreeMemPoolPtr parse_tree_mem_pool_;
+
  private:
   friend class QLTestBase;
   friend class TestQLProcessor;
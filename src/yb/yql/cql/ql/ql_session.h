@@ -30,6 +30,8 @@
 namespace yb {
 namespace ql {
 
+class PrefetchedRead;
+
 static const char* const kUndefinedKeyspace = ""; // Must be empty string.
 static const char* const kUndefinedRoleName = ""; // Must be empty string.
 
@@ -67,6 +69,18 @@ class QLSession {
     current_role_name_ = role_name;
   }
 
+  // Access functions for the next page of a SELECT statement prefetched in this session. Only the
+  // page that was prefetched most recently is kept.
+  std::shared_ptr<PrefetchedRead> TakePrefetchedRead() {
+    std::lock_guard<std::mutex> l(prefetched_read_mutex_);
+    return std::move(prefetched_read_);
+  }
+
+  void SetPrefetchedRead(std::shared_ptr<PrefetchedRead> prefetched_read) {
+    std::lock_guard<std::mutex> l(prefetched_read_mutex_);
+    prefetched_read_ = std::move(prefetched_read);
+  }
+
  private:
   // Mutex to protect access to current_keyspace_.
   mutable boost::shared_mutex current_keyspace_mutex_;
@@ -76,6 +90,8 @@ class QLSession {
   // TODO (Bristy) : After Login has been done, test this.
   std::string current_role_name_;
 
+  std::mutex prefetched_read_mutex_;
+  std::shared_ptr<PrefetchedRead> prefetched_read_;
 };
 
 }  // namespace ql
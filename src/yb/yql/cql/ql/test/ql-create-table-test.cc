@@ -260,6 +260,34 @@ TEST_F(TestQLCreateTable, TestQLCreateTableWithTTL) {
   EXPECT_EQ(1000, properties_pb.default_time_to_live());
 }
 
+TEST_F(TestQLCreateTable, TestQLCreateTableWithHistoryRetention) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get an available processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  EXEC_INVALID_STMT("CREATE TABLE table_with_retention (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                        "history_retention_interval_sec = -1;");
+  EXEC_VALID_STMT("CREATE TABLE table_with_retention (c1 int, c2 int, PRIMARY KEY(c1)) WITH "
+                      "history_retention_interval_sec = 10;");
+
+  master::CatalogManager *catalog_manager = cluster_->mini_master()->master()->catalog_manager();
+  master::GetTableSchemaRequestPB request_pb;
+  request_pb.mutable_table()->mutable_namespace_()->set_name(kDefaultKeyspaceName);
+  request_pb.mutable_table()->set_table_name("table_with_retention");
+
+  master::GetTableSchemaResponsePB response_pb;
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  EXPECT_EQ(10, response_pb.schema().table_properties().history_retention_interval_sec());
+
+  EXEC_VALID_STMT("ALTER TABLE table_with_retention WITH history_retention_interval_sec = 0;");
+  response_pb.Clear();
+  CHECK_OK(catalog_manager->GetTableSchema(&request_pb, &response_pb));
+  EXPECT_TRUE(response_pb.schema().table_properties().has_history_retention_interval_sec());
+  EXPECT_EQ(0, response_pb.schema().table_properties().history_retention_interval_sec());
+}
+
 TEST_F(TestQLCreateTable, TestQLCreateTableWithClusteringOrderBy) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -323,5 +323,39 @@ TEST_F(QLTestParser, TestExplain) {
   PARSE_INVALID_STMT("EXPLAIN ANALYZE SELECT * FROM t WHERE C1=:c1;");
 }
 
+TEST_F(QLTestParser, TestParseTreeMemPool) {
+  auto mem_pool = std::make_shared<ParseTreeMemPool>(1_MB);
+  Parser parser;
+  const string short_stmt = "SELECT * FROM t WHERE c1 = 1;";
+  ASSERT_OK(parser.Parse(short_stmt, false /* reparsed */, nullptr /* mem_tracker */,
+                         false /* internal */, mem_pool));
+  auto parse_tree = parser.Done();
+  ASSERT_EQ(0U, mem_pool->allocator()->pooled_bytes());
+  parse_tree = nullptr;
+  const auto pooled_bytes = mem_pool->allocator()->pooled_bytes();
+  ASSERT_GT(pooled_bytes, 0U);
+  const auto block_size = mem_pool->ptree_block_size();
+
+  // Blocks of the destroyed tree are reused.
+  ASSERT_OK(parser.Parse(short_stmt, false /* reparsed */, nullptr /* mem_tracker */,
+                         false /* internal */, mem_pool));
+  parse_tree = parser.Done();
+  ASSERT_LT(mem_pool->allocator()->pooled_bytes(), pooled_bytes);
+  parse_tree = nullptr;
+  ASSERT_GE(mem_pool->allocator()->pooled_bytes(), pooled_bytes);
+
+  // Initial block grows after a statement that did not fit into one block.
+  string long_stmt = "SELECT * FROM t WHERE c1 IN (0";
+  for (int i = 1; i != 1000; ++i) {
+    long_stmt += Format(", $0", i);
+  }
+  long_stmt += ");";
+  ASSERT_OK(parser.Parse(long_stmt, false /* reparsed */, nullptr /* mem_tracker */,
+                         false /* internal */, mem_pool));
+  parse_tree = parser.Done();
+  parse_tree = nullptr;
+  ASSERT_GT(mem_pool->ptree_block_size(), block_size);
+}
+
 }  // namespace ql
 }  // namespace yb
@@ -13,6 +13,7 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <set>
 #include <thread>
 #include <cmath>
 
@@ -26,6 +27,10 @@
 #include "yb/util/crypt.h"
 #include "yb/yql/cql/ql/test/ql-test-base.h"
 
+DECLARE_bool(cql_prefetch_next_page);
+DECLARE_int32(peers_vtable_cache_ttl_ms);
+DECLARE_int32(tserver_unresponsive_timeout_ms);
+
 using std::string;
 using std::unique_ptr;
 using std::shared_ptr;
@@ -672,6 +677,120 @@ TEST_F(TestQLQuery, TestQLQuerySimple) {
   EXEC_VALID_STMT(drop_stmt);
 }
 
+TEST_F(TestQLQuery, TestPagingPrefetch) {
+  FLAGS_cql_prefetch_next_page = true;
+
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE t (h int, r int, v int, primary key((h), r));");
+
+  static constexpr int kNumHashKeys = 10;
+  static constexpr int kNumRows = 100;
+  for (int h = 1; h <= kNumHashKeys; h++) {
+    for (int r = 1; r <= kNumRows; r++) {
+      CHECK_VALID_STMT(Substitute("INSERT INTO t (h, r, v) VALUES ($0, $1, $2);", h, r, h + r));
+    }
+  }
+
+  // Read rows of a single hash key, while the following pages are prefetched.
+  {
+    StatementParameters params;
+    static constexpr int kPageSize = 7;
+    params.set_page_size(kPageSize);
+    int r = 0;
+    do {
+      CHECK_OK(processor->Run("SELECT h, r, v FROM t WHERE h = 1;", params));
+      std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+      for (int j = 0; j < row_block->row_count(); j++) {
+        const QLRow& row = row_block->row(j);
+        r++;
+        CHECK_EQ(row.column(0).int32_value(), 1);
+        CHECK_EQ(row.column(1).int32_value(), r);
+        CHECK_EQ(row.column(2).int32_value(), 1 + r);
+      }
+      if (processor->rows_result()->paging_state().empty()) {
+        break;
+      }
+      CHECK_EQ(row_block->row_count(), kPageSize);
+      CHECK_OK(params.SetPagingState(processor->rows_result()->paging_state()));
+    } while (true);
+    CHECK_EQ(r, kNumRows);
+  }
+
+  // Read the whole table across tablets.
+  {
+    StatementParameters params;
+    static constexpr int kPageSize = 30;
+    params.set_page_size(kPageSize);
+    int64_t num_rows = 0;
+    int64_t sum = 0;
+    do {
+      CHECK_OK(processor->Run("SELECT h, r, v FROM t;", params));
+      std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+      for (const auto& row : row_block->rows()) {
+        num_rows++;
+        CHECK_EQ(row.column(2).int32_value(),
+                 row.column(0).int32_value() + row.column(1).int32_value());
+        sum += row.column(2).int32_value();
+      }
+      if (processor->rows_result()->paging_state().empty()) {
+        break;
+      }
+      CHECK_OK(params.SetPagingState(processor->rows_result()->paging_state()));
+    } while (true);
+    CHECK_EQ(num_rows, kNumHashKeys * kNumRows);
+    // Sum of h + r over all rows.
+    CHECK_EQ(sum, kNumRows * kNumHashKeys * (kNumHashKeys + 1) / 2 +
+                  kNumHashKeys * kNumRows * (kNumRows + 1) / 2);
+  }
+}
+
+TEST_F(TestQLQuery, TestPagingPrefetchReadYourWrites) {
+  FLAGS_cql_prefetch_next_page = true;
+
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE t (h int, r int, v int, primary key((h), r));");
+
+  static constexpr int kNumRows = 30;
+  static constexpr int kPageSize = 7;
+  for (int r = 1; r <= kNumRows; r++) {
+    CHECK_VALID_STMT(Substitute("INSERT INTO t (h, r, v) VALUES (1, $0, $0);", r));
+  }
+
+  // Update rows of the next page between pages, the page prefetched before the update must not
+  // be returned.
+  StatementParameters params;
+  params.set_page_size(kPageSize);
+  int r = 0;
+  do {
+    CHECK_OK(processor->Run("SELECT r, v FROM t WHERE h = 1;", params));
+    std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+    for (const auto& row : row_block->rows()) {
+      r++;
+      CHECK_EQ(row.column(0).int32_value(), r);
+      CHECK_EQ(row.column(1).int32_value(), r > kPageSize ? -r : r);
+    }
+    if (processor->rows_result()->paging_state().empty()) {
+      break;
+    }
+    auto paging_state = processor->rows_result()->paging_state();
+    for (int i = r + 1; i <= std::min(r + kPageSize, kNumRows); i++) {
+      CHECK_VALID_STMT(Substitute("UPDATE t SET v = $0 WHERE h = 1 AND r = $1;", -i, i));
+    }
+    CHECK_OK(params.SetPagingState(paging_state));
+  } while (true);
+  CHECK_EQ(r, kNumRows);
+}
+
 TEST_F(TestQLQuery, TestPagingState) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
@@ -1582,6 +1701,56 @@ TEST_F(TestQLQuery, TestInvalidPeerTableEntries) {
   }
 }
 
+TEST_F(TestQLQuery, TestPeersTableCache) {
+  // Rows should be refreshed because tablet servers change, not because the cache expires.
+  FLAGS_peers_vtable_cache_ttl_ms = 3600 * 1000;
+  const int num_tservers = 3;
+  ASSERT_NO_FATALS(CreateSimulatedCluster(num_tservers));
+  ASSERT_OK(cluster_->WaitForTabletServerCount(num_tservers));
+
+  TestQLProcessor* processor = GetQLProcessor();
+  auto get_peers = [processor]() -> Result<std::set<string>> {
+    RETURN_NOT_OK(processor->Run("SELECT * FROM system.peers"));
+    std::set<string> result;
+    for (const auto& row : processor->row_block()->rows()) {
+      auto peer = row.column(0).inetaddress_value().ToString();
+      SCHECK(result.insert(peer).second, IllegalState, Format("Duplicate peer: $0", peer));
+    }
+    return result;
+  };
+  const auto initial_peers = ASSERT_RESULT(get_peers());
+  ASSERT_EQ(num_tservers - 1, initial_peers.size());
+
+  auto ts_manager = cluster_->leader_mini_master()->master()->ts_manager();
+  NodeInstancePB instance;
+  instance.set_permanent_uuid("0123456789abcdef0123456789abcdef");
+  instance.set_instance_seqno(0);
+  master::TSRegistrationPB registration;
+  auto hostport_pb = registration.mutable_common()->add_private_rpc_addresses();
+  hostport_pb->set_host("127.0.0.100");
+  hostport_pb->set_port(123);
+
+  // Tablet server joins.
+  ASSERT_OK(ts_manager->RegisterTS(instance, registration, CloudInfoPB(), nullptr));
+  auto expected_peers = initial_peers;
+  expected_peers.insert("127.0.0.100");
+  ASSERT_EQ(expected_peers, ASSERT_RESULT(get_peers()));
+
+  // Tablet server registers again with another address.
+  instance.set_instance_seqno(1);
+  hostport_pb->set_host("127.0.0.101");
+  ASSERT_OK(ts_manager->RegisterTS(instance, registration, CloudInfoPB(), nullptr));
+  expected_peers = initial_peers;
+  expected_peers.insert("127.0.0.101");
+  ASSERT_EQ(expected_peers, ASSERT_RESULT(get_peers()));
+
+  // Tablet server leaves, since it does not send heartbeats.
+  FLAGS_tserver_unresponsive_timeout_ms = 3000 * kTimeMultiplier;
+  ASSERT_OK(WaitFor([&get_peers, &initial_peers]() -> Result<bool> {
+    return VERIFY_RESULT(get_peers()) == initial_peers;
+  }, MonoDelta::FromSeconds(30) * kTimeMultiplier, "Tablet server leaves"));
+}
+
 TEST_F(TestQLQuery, TestPagination) {
   // Init the simulated cluster.
   ASSERT_NO_FATALS(CreateSimulatedCluster());
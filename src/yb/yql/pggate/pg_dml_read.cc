@@ -150,6 +150,31 @@ Status PgDmlRead::DeleteEmptyPrimaryBinds() {
 
 //--------------------------------------------------------------------------------------------------
 
+Status PgDmlRead::BindYbctids(int n, const char **ybctids, const int64_t *ybctid_sizes) {
+  SCHECK_GT(n, 0, InvalidArgument, "At least one ybctid should be bound");
+  SCHECK(!secondary_index_query_, InvalidArgument,
+         "Ybctids could not be bound to a statement that reads ybctids from index");
+  SCHECK(doc_op_, InvalidArgument, "Ybctids could not be bound to a statement without operator");
+
+  bound_ybctids_.clear();
+  bound_ybctid_slices_.clear();
+  bound_ybctids_.reserve(n);
+  bound_ybctid_slices_.reserve(n);
+  for (int i = 0; i != n; ++i) {
+    bound_ybctids_.emplace_back(ybctids[i], ybctid_sizes[i]);
+    bound_ybctid_slices_.emplace_back(bound_ybctids_.back());
+  }
+  return Status::OK();
+}
+
+Status PgDmlRead::BindWhereExpr(PgExpr *where_expr) {
+  SCHECK(!read_req_->has_where_expr(), InvalidArgument, "WHERE expression is already bound");
+
+  // Columns referenced by the expression are marked to be read, and the expression is evaluated
+  // by DocDB for every scanned row, before the row is returned or aggregated.
+  return where_expr->PrepareForRead(this, read_req_->mutable_where_expr());
+}
+
 Status PgDmlRead::Exec(const PgExecParameters *exec_params) {
   // Initialize doc operator.
   if (doc_op_) {
@@ -162,6 +187,16 @@ Status PgDmlRead::Exec(const PgExecParameters *exec_params) {
   // Delete key columns that are not bound to any values.
   RETURN_NOT_OK(DeleteEmptyPrimaryBinds());
 
+  if (!bound_ybctids_.empty()) {
+    // Read all rows of bound ybctids by a single batch of requests, one per tablet.
+    RETURN_NOT_OK(doc_op_->PopulateDmlByYbctidOps(&bound_ybctid_slices_,
+                                                  KeepYbctidOrder::kFalse));
+    RETURN_NOT_OK(UpdateBindPBs());
+    SCHECK_EQ(VERIFY_RESULT(doc_op_->Execute()), RequestSent::kTrue, IllegalState,
+              "YSQL read operation was not sent");
+    return Status::OK();
+  }
+
   // First, process the secondary index request.
   bool has_ybctid = VERIFY_RESULT(ProcessSecondaryIndexRequest(exec_params));
 
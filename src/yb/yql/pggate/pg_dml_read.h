@@ -75,6 +75,15 @@ class PgDmlRead : public PgDml {
   // Bind a column with an IN condition.
   CHECKED_STATUS BindColumnCondIn(int attnum, int n_attr_values, PgExpr **attr_values);
 
+  // Bind ybctids of the rows to read, for instance ybctids collected from outer rows of a nested
+  // loop join. Rows are fetched by one request per tablet instead of one request per ybctid,
+  // they are returned in arbitrary order, and ybctids of missing rows are skipped.
+  // Replaces ybctids bound previously, so the statement could be executed for the next batch.
+  CHECKED_STATUS BindYbctids(int n, const char **ybctids, const int64_t *ybctid_sizes);
+
+  // Bind a boolean expression, rows for which it is not true are filtered out by DocDB.
+  CHECKED_STATUS BindWhereExpr(PgExpr *where_expr);
+
   // Execute.
   virtual CHECKED_STATUS Exec(const PgExecParameters *exec_params);
 
@@ -102,6 +111,10 @@ class PgDmlRead : public PgDml {
 
   // References mutable request from template operation of doc_op_.
   PgsqlReadRequestPB *read_req_ = nullptr;
+
+  // Ybctids bound by BindYbctids, slices reference the strings.
+  std::vector<std::string> bound_ybctids_;
+  std::vector<Slice> bound_ybctid_slices_;
 };
 
 }  // namespace pggate
@@ -42,6 +42,10 @@ class PgDmlWrite : public PgDml {
     write_req_->set_is_ysql_catalog_change(true);
   }
 
+  void SetCatalogInvalMessages(const Slice& inval_messages) {
+    write_req_->set_ysql_catalog_inval_messages(inval_messages.cdata(), inval_messages.size());
+  }
+
   void SetCatalogCacheVersion(const uint64_t catalog_cache_version) override {
     write_req_->set_ysql_catalog_version(catalog_cache_version);
   }
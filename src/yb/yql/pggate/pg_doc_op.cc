@@ -163,6 +163,13 @@ Status PgDocOp::GetResult(list<PgDocResult> *rowsets) {
 
     DCHECK(response_.InProgress());
     auto rows = VERIFY_RESULT(ProcessResponse(response_.GetStatus()));
+    // Parallel ordered scan has no rows to return, until the tablet to be returned next responds
+    // with rows.
+    while (rows.empty() && !end_of_data_) {
+      exec_status_ = SendRequest(true /* force_non_bufferable */);
+      RETURN_NOT_OK(exec_status_);
+      rows = VERIFY_RESULT(ProcessResponse(response_.GetStatus()));
+    }
     // In case ProcessResponse doesn't fail with an error
     // it should return non empty rows and/or set end_of_data_.
     DCHECK(!rows.empty() || end_of_data_);
@@ -317,17 +324,28 @@ void PgDocReadOp::ExecuteInit(const PgExecParameters *exec_params) {
   PgDocOp::ExecuteInit(exec_params);
 
   template_op_->mutable_request()->set_return_paging_state(true);
+  if (FLAGS_ysql_collect_docdb_metrics) {
+    template_op_->mutable_request()->set_return_metrics(true);
+  }
   SetRequestPrefetchLimit();
   SetRowMark();
   SetReadTime();
 }
 
 Result<std::list<PgDocResult>> PgDocReadOp::ProcessResponseImpl() {
+  if (!ordered_scan_tablets_.empty()) {
+    return ProcessOrderedScanResponse();
+  }
+
   // Process result from tablet server and check result status.
   auto result = VERIFY_RESULT(ProcessResponseResult());
 
   // Process paging state and check status.
   RETURN_NOT_OK(ProcessResponsePagingState());
+
+  if (!end_of_data_) {
+    AdjustRequestPrefetchLimit(result);
+  }
   return result;
 }
 
@@ -343,7 +361,19 @@ Status PgDocReadOp::CreateRequests() {
     // Optimization for COUNT() operator.
     // - SELECT count(*) FROM sql_table;
     // - Multiple requests are created to run sequential COUNT() in parallel.
-    return PopulateParallelSelectCountOps();
+    return PopulateParallelSelectOps();
+
+  } else if (IsParallelScanAllowed()) {
+    // Optimization for filtered full scan.
+    // - SELECT * FROM sql_table WHERE non_key_column = 1;
+    // - Multiple requests are created to scan tablets in parallel.
+    return PopulateParallelSelectOps();
+
+  } else if (IsParallelOrderedScanAllowed()) {
+    // Optimization for full scan of range partitioned table.
+    // - SELECT * FROM range_table ORDER BY range_column;
+    // - Multiple requests are created to read ahead from following tablets.
+    return PopulateParallelOrderedScanOps();
 
   } else if (template_op_->request().partition_column_values_size() > 0) {
     // Optimization for multiple hash keys.
@@ -364,7 +394,8 @@ Status PgDocReadOp::CreateRequests() {
   }
 }
 
-Status PgDocReadOp::PopulateDmlByYbctidOps(const vector<Slice> *ybctids) {
+Status PgDocReadOp::PopulateDmlByYbctidOps(
+    const vector<Slice> *ybctids, KeepYbctidOrder keep_order) {
   // This function is called only when ybctids were returned from INDEX.
   //
   // NOTE on a typical process.
@@ -416,8 +447,11 @@ Status PgDocReadOp::PopulateDmlByYbctidOps(const vector<Slice> *ybctids) {
     batch_arg->set_order(batch_row_ordering_counter_);
     batch_arg->mutable_ybctid()->mutable_value()->set_binary_value(ybctid.data(), ybctid.size());
 
-    // Remember the order number for each request.
-    batch_row_orders_[partition].push_back(batch_row_ordering_counter_);
+    // Remember the order number for each request. Without order, the result rows are returned as
+    // they are received, so missing rows do not break the order of the following ones.
+    if (keep_order) {
+      batch_row_orders_[partition].push_back(batch_row_ordering_counter_);
+    }
 
     // Increment counter for the next row.
     batch_row_ordering_counter_++;
@@ -538,10 +572,58 @@ Status PgDocReadOp::InitializeHashPermutationStates() {
   return Status::OK();
 }
 
-Status PgDocReadOp::PopulateParallelSelectCountOps() {
-  // Create batch operators, one per partition, to SELECT COUNT() in parallel.
+bool PgDocReadOp::IsParallelScanAllowed() const {
+  if (!FLAGS_ysql_enable_parallel_scan) {
+    return false;
+  }
+
+  // Only full scans with filtering are split. Without the filter most of the time is spent on
+  // transferring rows, and with LIMIT most of the rows fetched from other tablets are wasted.
+  // Order of rows is lost, but a hash partitioned table does not return rows in key order anyway.
+  const PgsqlReadRequestPB& req = template_op_->request();
+  return exec_params_.limit_use_default &&
+         exec_params_.partition_key == nullptr &&
+         table_desc_->GetPartitionCount() > 1 &&
+         table_desc_->table()->partition_schema().IsHashPartitioning() &&
+         (req.has_where_expr() || req.has_condition_expr()) &&
+         !req.has_index_request() &&
+         !req.has_ybctid_column_value() &&
+         !req.has_hash_code() &&
+         !req.has_max_hash_code() &&
+         req.batch_arguments_size() == 0;
+}
+
+Status PgDocReadOp::PopulateParallelSelectOps() {
+  // Create batch operators, one per partition, to SELECT in parallel.
   RETURN_NOT_OK(ClonePgsqlOps(table_desc_->GetPartitionCount()));
+  RETURN_NOT_OK(SetSelectParallelismLevel());
+
+  // Assign partitions to operators.
+  const auto& partition_keys = table_desc_->table()->GetPartitions();
+  SCHECK_EQ(partition_keys.size(), pgsql_ops_.size(), IllegalState,
+            "Number of partitions and number of partition keys are not the same");
 
+  for (int partition = 0; partition < partition_keys.size(); partition++) {
+    // Construct a new YBPgsqlReadOp.
+    pgsql_ops_[partition]->set_active(true);
+    auto req = GetReadOp(partition)->mutable_request();
+
+    // Set paging state.
+    req->mutable_paging_state()->set_next_partition_key(partition_keys[partition]);
+
+    // Set max_hash_code to end of tablet (next key - 1).
+    if (partition < partition_keys.size() - 1) {
+      req->set_max_hash_code(
+          PartitionSchema::DecodeMultiColumnHashValue(partition_keys[partition + 1]) - 1);
+    }
+  }
+  active_op_count_ = partition_keys.size();
+  request_population_completed_ = true;
+
+  return Status::OK();
+}
+
+Status PgDocReadOp::SetSelectParallelismLevel() {
   // Set "pararallelism_level_" to control how many operators can be sent at one time.
   //
   // TODO(neil) The calculation for this control variable should be applied to ALL operators, but
@@ -559,32 +641,123 @@ Status PgDocReadOp::PopulateParallelSelectCountOps() {
     parallelism_level_ =
       std::min(std::max(tserver_count * 2, kMinParSelCountParallelism), kMaxParSelCountParallelism);
   }
+  return Status::OK();
+}
+
+bool PgDocReadOp::IsParallelOrderedScanAllowed() const {
+  if (!FLAGS_ysql_enable_parallel_ordered_scan) {
+    return false;
+  }
+
+  // Only forward full scans without LIMIT are split, with LIMIT most of the rows read ahead are
+  // wasted. Scans with range key conditions are bounded by the client, so each tablet could not
+  // be bounded by its end key.
+  const PgsqlReadRequestPB& req = template_op_->request();
+  return exec_params_.limit_use_default &&
+         exec_params_.partition_key == nullptr &&
+         table_desc_->GetPartitionCount() > 1 &&
+         !table_desc_->table()->partition_schema().IsHashPartitioning() &&
+         req.is_forward_scan() &&
+         !req.has_condition_expr() &&
+         req.range_column_values_size() == 0 &&
+         !req.has_index_request() &&
+         !req.has_ybctid_column_value() &&
+         !req.has_max_partition_key() &&
+         req.batch_arguments_size() == 0;
+}
+
+Status PgDocReadOp::PopulateParallelOrderedScanOps() {
+  // Create operators, one per tablet.
+  RETURN_NOT_OK(ClonePgsqlOps(table_desc_->GetPartitionCount()));
+  RETURN_NOT_OK(SetSelectParallelismLevel());
 
-  // Assign partitions to operators.
   const auto& partition_keys = table_desc_->table()->GetPartitions();
   SCHECK_EQ(partition_keys.size(), pgsql_ops_.size(), IllegalState,
             "Number of partitions and number of partition keys are not the same");
 
+  ordered_scan_tablets_.reserve(partition_keys.size());
   for (int partition = 0; partition < partition_keys.size(); partition++) {
-    // Construct a new YBPgsqlReadOp.
     pgsql_ops_[partition]->set_active(true);
     auto req = GetReadOp(partition)->mutable_request();
 
-    // Set paging state.
+    // Start scan at the first key of the tablet, and stop it at the end of the tablet, instead of
+    // continuing with the next tablet.
     req->mutable_paging_state()->set_next_partition_key(partition_keys[partition]);
-
-    // Set max_hash_code to end of tablet (next key - 1).
     if (partition < partition_keys.size() - 1) {
-      req->set_max_hash_code(
-          PartitionSchema::DecodeMultiColumnHashValue(partition_keys[partition + 1]) - 1);
+      req->set_max_partition_key(partition_keys[partition + 1]);
     }
+    ordered_scan_tablets_.push_back(OrderedScanTablet{pgsql_ops_[partition], {}});
   }
-  active_op_count_ = partition_keys.size();
+  ordered_scan_next_tablet_ = 0;
+  ArrangeOrderedScanOps();
   request_population_completed_ = true;
 
   return Status::OK();
 }
 
+Result<std::list<PgDocResult>> PgDocReadOp::ProcessOrderedScanResponse() {
+  // Keep rows of each tablet separately, as sent operators could belong to several tablets.
+  int32_t send_count = std::min(parallelism_level_, active_op_count_);
+  for (int op_index = 0; op_index < send_count; op_index++) {
+    YBPgsqlReadOp *read_op = GetReadOp(op_index);
+    RETURN_NOT_OK(pg_session_->HandleResponse(*read_op, PgObjectId()));
+    if (!read_op->rows_data().empty()) {
+      auto& tablet = ordered_scan_tablets_[ordered_scan_active_tablets_[op_index]];
+      tablet.rows.emplace_back(read_op->rows_data());
+    }
+  }
+
+  RETURN_NOT_OK(ProcessResponsePagingState());
+
+  // Return rows of the first tablet, that is not completely returned, and rows of following
+  // tablets while they are completely read.
+  std::list<PgDocResult> result;
+  while (ordered_scan_next_tablet_ < ordered_scan_tablets_.size()) {
+    auto& tablet = ordered_scan_tablets_[ordered_scan_next_tablet_];
+    result.splice(result.end(), tablet.rows);
+    if (tablet.op->is_active()) {
+      break;
+    }
+    ++ordered_scan_next_tablet_;
+  }
+
+  ArrangeOrderedScanOps();
+  if (!end_of_data_) {
+    AdjustRequestPrefetchLimit(result);
+  }
+  return result;
+}
+
+void PgDocReadOp::ArrangeOrderedScanOps() {
+  // The tablet to be returned next is always sent, together with the following tablets, that
+  // have no rows kept. Operators waiting for preceding tablets to be returned, and completed
+  // operators are placed after them.
+  auto is_sent = [this](size_t tablet) {
+    const auto& entry = ordered_scan_tablets_[tablet];
+    return entry.op->is_active() && (tablet == ordered_scan_next_tablet_ || entry.rows.empty());
+  };
+
+  pgsql_ops_.clear();
+  ordered_scan_active_tablets_.clear();
+  for (size_t tablet = 0; tablet < ordered_scan_tablets_.size(); ++tablet) {
+    if (is_sent(tablet)) {
+      pgsql_ops_.push_back(ordered_scan_tablets_[tablet].op);
+      ordered_scan_active_tablets_.push_back(tablet);
+    }
+  }
+  active_op_count_ = pgsql_ops_.size();
+
+  bool has_waiting_ops = false;
+  for (size_t tablet = 0; tablet < ordered_scan_tablets_.size(); ++tablet) {
+    if (!is_sent(tablet)) {
+      const auto& op = ordered_scan_tablets_[tablet].op;
+      has_waiting_ops |= op->is_active();
+      pgsql_ops_.push_back(op);
+    }
+  }
+  end_of_data_ = active_op_count_ == 0 && !has_waiting_ops;
+}
+
 // When postgres requests to scan a specific partition, set the partition parameter accordingly.
 Status PgDocReadOp::SetScanPartitionBoundary() {
   SCHECK(exec_params_.partition_key != nullptr, Uninitialized, "expected non-null partition_key");
@@ -696,10 +869,49 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
   int64_t limit_count = exec_params_.limit_count + exec_params_.limit_offset;
   suppress_next_result_prefetching_ = true;
   if (exec_params_.limit_use_default || limit_count > predicted_limit) {
+    // The scan could stop after a few rows, so start with a small page and let it grow while
+    // the upper level keeps asking for more rows.
     limit_count = predicted_limit;
+    if (FLAGS_ysql_prefetch_initial_limit > 0) {
+      limit_count = std::min<int64_t>(limit_count, FLAGS_ysql_prefetch_initial_limit);
+    }
     suppress_next_result_prefetching_ = false;
   }
   req->set_limit(limit_count);
+  prefetch_limit_ = limit_count;
+  max_prefetch_limit_ = suppress_next_result_prefetching_ ? limit_count : predicted_limit;
+}
+
+void PgDocReadOp::AdjustRequestPrefetchLimit(const std::list<PgDocResult>& rowsets) {
+  if (suppress_next_result_prefetching_) {
+    return;
+  }
+
+  int64_t limit = std::min(prefetch_limit_ * 2, max_prefetch_limit_);
+
+  // Estimate row size from the received page, so a page of wide rows does not exceed the budget.
+  if (FLAGS_ysql_prefetch_max_bytes > 0) {
+    int64_t row_count = 0;
+    size_t data_size = 0;
+    for (const auto& rowset : rowsets) {
+      row_count += rowset.row_count();
+      data_size += rowset.data_size();
+    }
+    if (row_count > 0 && data_size > 0) {
+      auto bytes_limit = FLAGS_ysql_prefetch_max_bytes * row_count / data_size;
+      limit = std::max<int64_t>(std::min<int64_t>(limit, bytes_limit), 1);
+    }
+  }
+
+  if (limit == prefetch_limit_) {
+    return;
+  }
+  VLOG(2) << "Change prefetch limit of " << this << " from " << prefetch_limit_ << " to " << limit;
+  prefetch_limit_ = limit;
+  template_op_->mutable_request()->set_limit(limit);
+  for (const auto& op : pgsql_ops_) {
+    static_cast<YBPgsqlReadOp*>(op.get())->mutable_request()->set_limit(limit);
+  }
 }
 
 void PgDocReadOp::SetRowMark() {
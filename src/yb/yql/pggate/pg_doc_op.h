@@ -27,6 +27,7 @@ namespace yb {
 namespace pggate {
 
 YB_STRONGLY_TYPED_BOOL(RequestSent);
+YB_STRONGLY_TYPED_BOOL(KeepYbctidOrder);
 
 //--------------------------------------------------------------------------------------------------
 // PgDocResult represents a batch of rows in ONE reply from tablet servers.
@@ -67,6 +68,11 @@ class PgDocResult {
     return row_count_;
   }
 
+  // Size of data selected from DocDB in this batch.
+  size_t data_size() const {
+    return data_.size();
+  }
+
  private:
   // Data selected from DocDB.
   string data_;
@@ -152,8 +158,10 @@ class PgDocResult {
 //        pgsql_ops_[0] = template_op_
 //    - CreateRequests()
 //    - ClonePgsqlOps() Clone template_op_ into one or more ops.
-//    - PopulateParallelSelectCountOps() Parallel processing SELECT COUNT.
+//    - PopulateParallelSelectOps() Parallel processing SELECT COUNT and filtered full scans.
 //      The same requests are constructed for each tablet server.
+//    - PopulateParallelOrderedScanOps() Parallel processing full scans of range partitioned
+//      tables. One request per tablet, rows are returned in tablet order.
 //    - PopulateNextHashPermutationOps() Parallel processing SELECT by hash conditions.
 //      Hash permutations will be group into different request based on their hash_codes.
 //    - PopulateDmlByYbctidOps() Parallel processing SELECT by ybctid values.
@@ -232,7 +240,10 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   //   SELECT ... FROM <table> WHERE ybctid IN (SELECT base_ybctids from INDEX)
   // After ybctids are queried from INDEX, PgGate will call "PopulateDmlByYbctidOps" to create
   // operators to fetch rows whose rowids equal queried ybctids.
-  virtual CHECKED_STATUS PopulateDmlByYbctidOps(const vector<Slice> *ybctids) = 0;
+  // When keep_order is false, rows are returned in arbitrary order, and ybctids of missing rows
+  // are allowed. It is used for ybctids bound by Postgres, for instance outer rows of a join.
+  virtual CHECKED_STATUS PopulateDmlByYbctidOps(
+      const vector<Slice> *ybctids, KeepYbctidOrder keep_order) = 0;
 
  protected:
   // Populate Protobuf requests using the collected informtion for this DocDB operator.
@@ -247,7 +258,7 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   //   * If (partition_count > 1), each operator is used for a specific partition range.
   //   * This optimization is used by
   //       PopulateDmlByYbctidOps()
-  //       PopulateParallelSelectCountOps()
+  //       PopulateParallelSelectOps()
   // - When parallelism by arguments is applied, each operator has only one argument.
   //   When tablet server will run the requests in parallel as it assigned one thread per request.
   //       PopulateNextHashPermutationOps()
@@ -391,7 +402,8 @@ class PgDocReadOp : public PgDocOp {
   // - Optimization for statement
   //     SELECT xxx FROM <table> WHERE ybctid IN (SELECT ybctid FROM INDEX)
   // - After being queried from inner select, ybctids are used for populate request for outer query.
-  CHECKED_STATUS PopulateDmlByYbctidOps(const vector<Slice> *ybctids) override;
+  CHECKED_STATUS PopulateDmlByYbctidOps(
+      const vector<Slice> *ybctids, KeepYbctidOrder keep_order) override;
   CHECKED_STATUS InitializeYbctidOperators();
 
   // Create operators by partition arguments.
@@ -408,7 +420,33 @@ class PgDocReadOp : public PgDocOp {
   // Create operators by partitions.
   // - Optimization for statement:
   //     Create parallel request for SELECT COUNT().
-  CHECKED_STATUS PopulateParallelSelectCountOps();
+  //     Create parallel request for filtered full scan of hash partitioned table.
+  CHECKED_STATUS PopulateParallelSelectOps();
+
+  // Whether the request is a full scan, that could be split by partitions of the table.
+  bool IsParallelScanAllowed() const;
+
+  // Create operators by tablets of range partitioned table.
+  // - Optimization for statement:
+  //     SELECT * FROM range_table ORDER BY <range key columns>;
+  // - Each operator scans one tablet. Up to "parallelism_level_" tablets are read at once, and
+  //   rows are returned to postgres in tablet order, that is the key order.
+  CHECKED_STATUS PopulateParallelOrderedScanOps();
+
+  // Whether the request is a forward full scan of range partitioned table, that could read
+  // tablets in parallel.
+  bool IsParallelOrderedScanAllowed() const;
+
+  // Set "parallelism_level_" for the parallel scans of several tablets.
+  CHECKED_STATUS SetSelectParallelismLevel();
+
+  // Keep rows of each tablet of the ordered scan until all preceding tablets are returned, and
+  // return rows, that could be returned now.
+  Result<std::list<PgDocResult>> ProcessOrderedScanResponse();
+
+  // Place operators of the ordered scan to pgsql_ops_ in tablet order. Operators, that have rows
+  // kept for later, are not sent again, so only one page is read ahead from each tablet.
+  void ArrangeOrderedScanOps();
 
   // Set partition boundaries to a given partition.
   CHECKED_STATUS SetScanPartitionBoundary();
@@ -425,6 +463,10 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Grow prefetch limit of the next requests, bounded by ysql_prefetch_max_bytes, after the scan
+  // has received one more page of rows.
+  void AdjustRequestPrefetchLimit(const std::list<PgDocResult>& rowsets);
+
   // Set the row_mark_type field of our read request based on our exec control parameter.
   void SetRowMark();
 
@@ -469,6 +511,24 @@ class PgDocReadOp : public PgDocOp {
   // For a query clause "h1 = 1 AND h2 IN (2,3) AND h3 IN (4,5,6) AND h4 = 7",
   // this will be initialized to [[1], [2, 3], [4, 5, 6], [7]]
   std::vector<std::vector<const PgsqlExpressionPB*>> partition_exprs_;
+
+  // Number of rows requested by the single request of the scan, and the maximum it could grow to.
+  int64_t prefetch_limit_ = 0;
+  int64_t max_prefetch_limit_ = 0;
+
+  // Used by PopulateParallelOrderedScanOps. Operators of all tablets in tablet order, and rows
+  // read from tablets, that follow the tablet being returned to postgres.
+  struct OrderedScanTablet {
+    std::shared_ptr<client::YBPgsqlOp> op;
+    std::list<PgDocResult> rows;
+  };
+  std::vector<OrderedScanTablet> ordered_scan_tablets_;
+
+  // Tablet indexes of operators in the active range pgsql_ops_[0, active_op_count_).
+  std::vector<size_t> ordered_scan_active_tablets_;
+
+  // First tablet, whose rows are not all returned yet.
+  size_t ordered_scan_next_tablet_ = 0;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -501,7 +561,8 @@ class PgDocWriteOp : public PgDocOp {
   // For write ops, we are not yet batching ybctid from index query.
   // TODO(neil) This function will be implemented when we push down sub-query inside WRITE ops to
   // the proxy layer. There's many scenarios where this optimization can be done.
-  CHECKED_STATUS PopulateDmlByYbctidOps(const vector<Slice> *ybctids) override {
+  CHECKED_STATUS PopulateDmlByYbctidOps(
+      const vector<Slice> *ybctids, KeepYbctidOrder keep_order) override {
     LOG(FATAL) << "Not yet implemented";
     return Status::OK();
   }
@@ -220,12 +220,13 @@ void PgExpr::TranslateDecimal(Slice *yb_cursor, const PgWireDataHeader& header,
   size_t read_size = PgDocData::ReadNumber(yb_cursor, &data_size);
   yb_cursor->remove_prefix(read_size);
 
-  std::string serialized_decimal = yb_cursor->ToBuffer();
+  // Decode only this value, not the rest of the rows in the buffer.
+  Slice serialized_decimal(yb_cursor->data(), data_size);
   yb_cursor->remove_prefix(data_size);
 
   util::Decimal yb_decimal;
   if (!yb_decimal.DecodeFromComparable(serialized_decimal).ok()) {
-    LOG(FATAL) << "Failed to deserialize DECIMAL from " << serialized_decimal;
+    LOG(FATAL) << "Failed to deserialize DECIMAL from " << serialized_decimal.ToDebugHexString();
     return;
   }
   auto plaintext = yb_decimal.ToString();
@@ -108,7 +108,7 @@ class PgExpr {
   //   the compilation of a statement.
   void TranslateData(Slice *yb_cursor, const PgWireDataHeader& header, int index,
                      PgTuple *pg_tuple) const {
-    CHECK(translate_data_) << "Data format translation is not provided";
+    DCHECK(translate_data_) << "Data format translation is not provided";
     translate_data_(yb_cursor, header, index, type_entity_, &type_attrs_, pg_tuple);
   }
 
@@ -203,8 +203,11 @@ class PgExpr {
   Opcode opcode_;
   const PgTypeEntity *type_entity_;
   const PgTypeAttrs type_attrs_;
-  std::function<void(Slice *, const PgWireDataHeader&, int, const YBCPgTypeEntity *,
-                     const PgTypeAttrs *, PgTuple *)> translate_data_;
+  // Called for every datum of every row, so it is a plain function pointer rather than
+  // std::function.
+  typedef void (*TranslateDataFunc)(Slice *, const PgWireDataHeader&, int,
+                                    const YBCPgTypeEntity *, const PgTypeAttrs *, PgTuple *);
+  TranslateDataFunc translate_data_ = nullptr;
 };
 
 class PgConstant : public PgExpr {
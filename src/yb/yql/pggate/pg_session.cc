@@ -36,10 +36,12 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/row_mark.h"
 #include "yb/common/transaction_error.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/primitive_value.h"
 
+#include "yb/tserver/tserver_service.proxy.h"
 #include "yb/tserver/tserver_shared_mem.h"
 
 #include "yb/util/logging.h"
@@ -237,6 +239,9 @@ Status PgSessionAsyncRunResult::GetStatus() {
   DCHECK(InProgress());
   auto status = future_status_.get();
   future_status_ = std::future<Status>();
+  if (!session_) {
+    return status;
+  }
   return CombineErrorsToStatus(session_->GetPendingErrors(), status);
 }
 
@@ -271,9 +276,12 @@ Status PgSession::RunHelper::Apply(std::shared_ptr<client::YBPgsqlOp> op,
     // see the results of first operation on DocDB side.
     // Multiple operations on same row must be performed in context of different RPC.
     // Flush is required in this case.
-    if (PREDICT_FALSE(!buffered_keys.insert(RowIdentifier(wop)).second)) {
+    // Same is true for the rows written by pipelined operations that are still in flight.
+    RowIdentifier row_id(wop);
+    if (PREDICT_FALSE(!buffered_keys.insert(row_id).second ||
+                      pg_session_.in_flight_keys_.count(row_id))) {
       RETURN_NOT_OK(pg_session_.FlushBufferedOperationsImpl());
-      buffered_keys.insert(RowIdentifier(wop));
+      buffered_keys.insert(std::move(row_id));
     }
     if (PREDICT_FALSE(yb_debug_log_docdb_requests)) {
       LOG(INFO) << "Buffering operation: " << op->ToString();
@@ -281,13 +289,16 @@ Status PgSession::RunHelper::Apply(std::shared_ptr<client::YBPgsqlOp> op,
 
     buffered_ops_.push_back({std::move(op), relation_id});
     // Flush buffers in case limit of operations in single RPC exceeded.
-    return PREDICT_TRUE(buffered_keys.size() < FLAGS_ysql_session_max_batch_size)
-        ? Status::OK()
+    if (PREDICT_TRUE(buffered_keys.size() < pg_session_.MaxBufferedOperations())) {
+      return Status::OK();
+    }
+    return pg_session_.CanPipelineBufferedOperations()
+        ? pg_session_.SendBufferedOperationsAsync()
         : pg_session_.FlushBufferedOperationsImpl();
   }
 
   // Flush all buffered operations (if any) before performing non-bufferable operation
-  if (!buffered_keys.empty()) {
+  if (!buffered_keys.empty() || !pg_session_.in_flight_ops_.empty()) {
     RETURN_NOT_OK(pg_session_.FlushBufferedOperationsImpl());
   }
   bool needs_pessimistic_locking = false;
@@ -297,11 +308,21 @@ Status PgSession::RunHelper::Apply(std::shared_ptr<client::YBPgsqlOp> op,
     auto row_mark_type = GetRowMarkTypeFromPB(read_req);
     read_only = read_only && !IsValidRowMarkType(row_mark_type);
     needs_pessimistic_locking = RowMarkNeedsPessimisticLock(row_mark_type);
+    if (pg_session_.ShouldUseCatalogReadCache(*op, transactional_)) {
+      DCHECK(!yb_session_);
+      catalog_read_ops_.push_back(std::static_pointer_cast<client::YBPgsqlReadOp>(op));
+      return Status::OK();
+    }
   }
 
   auto session = VERIFY_RESULT(pg_session_.GetSession(transactional_,
                                                       read_only,
                                                       needs_pessimistic_locking));
+  if (read_only && transactional_ && op->type() == YBOperation::Type::PGSQL_READ &&
+      pg_session_.pg_txn_manager_->IsFollowerRead()) {
+    down_cast<client::YBPgsqlReadOp*>(op.get())->set_yb_consistency_level(
+        YBConsistencyLevel::CONSISTENT_PREFIX);
+  }
   if (!yb_session_) {
     yb_session_ = session->shared_from_this();
     if (transactional_ && read_time) {
@@ -322,6 +343,9 @@ Status PgSession::RunHelper::Apply(std::shared_ptr<client::YBPgsqlOp> op,
 }
 
 Result<PgSessionAsyncRunResult> PgSession::RunHelper::Flush() {
+  if (!catalog_read_ops_.empty()) {
+    return pg_session_.ReadCatalogAsync(std::move(catalog_read_ops_));
+  }
   if (yb_session_) {
     auto future_status = MakeFuture<Status>([this](auto callback) {
       yb_session_->FlushAsync([callback](const Status& status) { callback(status); });
@@ -421,6 +445,7 @@ PgSession::PgSession(
 }
 
 PgSession::~PgSession() {
+  WARN_NOT_OK(WaitForInFlightOperations(), "Pipelined operations failed");
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -481,6 +506,15 @@ Status PgSession::GetCatalogMasterVersion(uint64_t *version) {
   return client_->GetYsqlCatalogMasterVersion(version);
 }
 
+Status PgSession::GetCatalogInvalMessages(uint64_t from_version, uint64_t *version,
+                                          boost::optional<std::string>* inval_messages) {
+  return client_->GetYsqlCatalogInvalMessages(from_version, version, inval_messages);
+}
+
+Status PgSession::IncrementCatalogVersion(const std::string& inval_messages, uint64_t *version) {
+  return client_->IncrementYsqlCatalogVersion(inval_messages, version);
+}
+
 Status PgSession::CreateSequencesDataTable() {
   const YBTableName table_name(YQL_DATABASE_PGSQL,
                                kPgSequencesDataNamespaceId,
@@ -614,6 +648,30 @@ Status PgSession::UpdateSequenceTuple(int64_t db_oid,
   if (skipped) {
     *skipped = psql_write->response().skipped();
   }
+  if (!expected_last_val && !psql_write->response().skipped()) {
+    // Sequence was set by setval() or ALTER SEQUENCE ... RESTART, so values leased from its old
+    // state should not be handed out anymore.
+    RETURN_NOT_OK(ResetSequenceRange(db_oid, seq_oid));
+  }
+  return Status::OK();
+}
+
+Status PgSession::ResetSequenceRange(int64_t db_oid, int64_t seq_oid) {
+  if (!FLAGS_ysql_use_tserver_sequence_cache || !tserver_shared_object_) {
+    return Status::OK();
+  }
+  tserver::ResetSequenceRangeRequestPB req;
+  req.set_db_oid(db_oid);
+  req.set_seq_oid(seq_oid);
+  req.set_forward_to_live_tservers(true);
+  tserver::ResetSequenceRangeResponsePB resp;
+  rpc::RpcController controller;
+  controller.set_timeout(client_->default_rpc_timeout());
+  RETURN_NOT_OK(TabletServerProxy()->ResetSequenceRange(req, &resp, &controller));
+  if (resp.has_error()) {
+    return StatusFromPB(resp.error().status()).CloneAndPrepend(
+        Format("Failed to reset values of sequence $0 leased by tablet servers", seq_oid));
+  }
   return Status::OK();
 }
 
@@ -680,6 +738,48 @@ Status PgSession::DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return session_->ApplyAndFlush(std::move(psql_delete));
 }
 
+Result<bool> PgSession::FetchSequenceRange(int64_t db_oid,
+                                           int64_t seq_oid,
+                                           uint64_t ysql_catalog_version,
+                                           int64_t inc_by,
+                                           int64_t min_value,
+                                           int64_t max_value,
+                                           int64_t num_values,
+                                           int64_t *first_value,
+                                           int64_t *last_value) {
+  if (!FLAGS_ysql_use_tserver_sequence_cache || !tserver_shared_object_) {
+    return false;
+  }
+  tserver::FetchSequenceRangeRequestPB req;
+  req.set_ysql_catalog_version(ysql_catalog_version);
+  req.set_db_oid(db_oid);
+  req.set_seq_oid(seq_oid);
+  req.set_inc_by(inc_by);
+  req.set_min_value(min_value);
+  req.set_max_value(max_value);
+  req.set_num_values(num_values);
+  tserver::FetchSequenceRangeResponsePB resp;
+  rpc::RpcController controller;
+  controller.set_timeout(client_->default_rpc_timeout());
+  auto status = TabletServerProxy()->FetchSequenceRange(req, &resp, &controller);
+  if (status.ok() && resp.has_error()) {
+    status = StatusFromPB(resp.error().status());
+  }
+  if (!status.ok()) {
+    // Values are allocated by the backend, e.g. when the tablet server is not upgraded yet.
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Failed to fetch values of sequence " << seq_oid << " from local tablet server: "
+        << status;
+    return false;
+  }
+  if (!resp.found()) {
+    return false;
+  }
+  *first_value = resp.first_value();
+  *last_value = resp.last_value();
+  return true;
+}
+
 Status PgSession::DeleteDBSequences(int64_t db_oid) {
   pggate::PgObjectId oid(kPgSequencesDataDatabaseOid, kPgSequencesDataTableOid);
   Result<PgTableDesc::ScopedRefPtr> r = LoadTable(oid);
@@ -794,6 +894,10 @@ void PgSession::StartOperationsBuffering() {
 Status PgSession::StopOperationsBuffering() {
   DCHECK(buffering_enabled_);
   buffering_enabled_ = false;
+  // Writes are kept in flight after the end of statement, until something waits for them.
+  if (CanPipelineBufferedOperations()) {
+    return SendBufferedOperationsAsync();
+  }
   return FlushBufferedOperationsImpl();
 }
 
@@ -802,9 +906,28 @@ Status PgSession::ResetOperationsBuffering() {
          IllegalState,
          Format("Pending operations are not expected, $0 found", buffered_keys_.size()));
   buffering_enabled_ = false;
+  bulk_load_batch_size_ = 0;
+  return Status::OK();
+}
+
+Status PgSession::StartBulkLoad(const PgObjectId& table_id) {
+  if (FLAGS_ysql_copy_max_in_flight_batches <= 0) {
+    return Status::OK();
+  }
+  // Batcher splits the batch by tablets, so every tablet receives about the same number of rows as
+  // in a single batch of regular writes.
+  auto table = VERIFY_RESULT(LoadTable(table_id));
+  bulk_load_batch_size_ = std::max(FLAGS_ysql_session_max_batch_size, 1) *
+                          std::max(table->GetPartitionCount(), 1);
   return Status::OK();
 }
 
+Status PgSession::FinishBulkLoad() {
+  auto status = FlushBufferedOperationsImpl();
+  bulk_load_batch_size_ = 0;
+  return status;
+}
+
 Status PgSession::FlushBufferedOperations() {
   return FlushBufferedOperationsImpl();
 }
@@ -815,9 +938,13 @@ void PgSession::DropBufferedOperations() {
   buffered_keys_.clear();
   buffered_ops_.clear();
   buffered_txn_ops_.clear();
+  // Operations that were already sent could not be dropped, but their errors are not relevant.
+  auto status = WaitForInFlightOperations();
+  VLOG_IF(1, !status.ok()) << "Dropped pipelined operations failed: " << status;
 }
 
 Status PgSession::FlushBufferedOperationsImpl() {
+  RETURN_NOT_OK(WaitForInFlightOperations());
   auto ops = std::move(buffered_ops_);
   auto txn_ops = std::move(buffered_txn_ops_);
   buffered_keys_.clear();
@@ -834,6 +961,58 @@ Status PgSession::FlushBufferedOperationsImpl() {
   return Status::OK();
 }
 
+size_t PgSession::MaxBufferedOperations() const {
+  return bulk_load_batch_size_ != 0 ? bulk_load_batch_size_ : FLAGS_ysql_session_max_batch_size;
+}
+
+bool PgSession::CanPipelineBufferedOperations() const {
+  if (bulk_load_batch_size_ != 0) {
+    // Bulk load waits for all its writes when finished, so writes of both kinds are pipelined.
+    return buffered_ops_.empty() || buffered_txn_ops_.empty();
+  }
+  // Non-transactional writes are not waited for by commit, so they are never pipelined.
+  return FLAGS_ysql_session_pipelined_writes && buffered_ops_.empty() &&
+         !YBCIsInitDbModeEnvVarSet();
+}
+
+Status PgSession::SendBufferedOperationsAsync() {
+  DCHECK(buffered_ops_.empty() || buffered_txn_ops_.empty());
+  const bool transactional = buffered_ops_.empty();
+  auto& buffered_ops = transactional ? buffered_txn_ops_ : buffered_ops_;
+  if (buffered_ops.empty()) {
+    return Status::OK();
+  }
+  const auto max_in_flight = bulk_load_batch_size_ != 0 ? FLAGS_ysql_copy_max_in_flight_batches
+                                                        : FLAGS_ysql_session_max_in_flight_batches;
+  RETURN_NOT_OK(WaitForInFlightOperations(std::max(max_in_flight, 1) - 1));
+  auto ops = std::move(buffered_ops);
+  buffered_ops.clear();
+  in_flight_keys_.insert(buffered_keys_.begin(), buffered_keys_.end());
+  buffered_keys_.clear();
+  auto result = VERIFY_RESULT(SendBufferedOperations(ops, transactional));
+  in_flight_ops_.push_back({std::move(ops), std::move(result)});
+  return Status::OK();
+}
+
+Status PgSession::WaitForInFlightOperations(size_t max_in_flight) {
+  Status result;
+  while (in_flight_ops_.size() > max_in_flight) {
+    auto in_flight = std::move(in_flight_ops_.front());
+    in_flight_ops_.pop_front();
+    auto status = in_flight.result.GetStatus();
+    if (status.ok()) {
+      status = HandleResponses(in_flight.ops);
+    }
+    if (result.ok()) {
+      result = status;
+    }
+  }
+  if (in_flight_ops_.empty()) {
+    in_flight_keys_.clear();
+  }
+  return result;
+}
+
 bool PgSession::ShouldHandleTransactionally(const client::YBPgsqlOp& op) {
   return op.IsTransactional() &&  !YBCIsInitDbModeEnvVarSet() &&
          (!op.IsYsqlCatalogOp() || pg_txn_manager_->IsDdlMode() ||
@@ -843,6 +1022,72 @@ bool PgSession::ShouldHandleTransactionally(const client::YBPgsqlOp& op) {
              FLAGS_ysql_enable_manual_sys_table_txn_ctl);
 }
 
+bool PgSession::ShouldUseCatalogReadCache(const client::YBPgsqlOp& op, bool transactional) {
+  return FLAGS_ysql_use_catalog_read_cache && tserver_shared_object_ && !transactional &&
+         op.IsYsqlCatalogOp() && !pg_txn_manager_->IsDdlMode() &&
+         down_cast<const client::YBPgsqlReadOp&>(op).request().ysql_catalog_version() != 0;
+}
+
+namespace {
+
+struct CatalogReadState {
+  std::vector<std::shared_ptr<client::YBPgsqlReadOp>> ops;
+  tserver::ReadCatalogRequestPB req;
+  tserver::ReadCatalogResponsePB resp;
+  rpc::RpcController controller;
+
+  Status Complete() {
+    RETURN_NOT_OK(controller.status());
+    if (resp.has_error()) {
+      return StatusFromPB(resp.error().status());
+    }
+    if (static_cast<size_t>(resp.pgsql_batch().size()) != ops.size()) {
+      return STATUS_FORMAT(
+          IllegalState, "Wrong number of catalog read responses: $0, expected: $1",
+          resp.pgsql_batch().size(), ops.size());
+    }
+    for (size_t i = 0; i != ops.size(); ++i) {
+      auto& pgsql_resp = *resp.mutable_pgsql_batch(i);
+      if (pgsql_resp.has_rows_data_sidecar()) {
+        auto rows_data = VERIFY_RESULT(controller.GetSidecar(pgsql_resp.rows_data_sidecar()));
+        ops[i]->mutable_rows_data()->assign(rows_data.cdata(), rows_data.size());
+      }
+      ops[i]->mutable_response()->Swap(&pgsql_resp);
+    }
+    return Status::OK();
+  }
+};
+
+} // namespace
+
+Result<PgSessionAsyncRunResult> PgSession::ReadCatalogAsync(
+    std::vector<std::shared_ptr<client::YBPgsqlReadOp>> ops) {
+  auto state = std::make_shared<CatalogReadState>();
+  state->req.set_ysql_catalog_version(ops.front()->request().ysql_catalog_version());
+  for (const auto& op : ops) {
+    if (PREDICT_FALSE(yb_debug_log_docdb_requests)) {
+      LOG(INFO) << "Reading catalog through local tserver: " << op->ToString();
+    }
+    *state->req.add_pgsql_batch() = op->request();
+  }
+  state->ops = std::move(ops);
+  state->controller.set_timeout(client_->default_rpc_timeout());
+  auto future_status = MakeFuture<Status>([proxy = TabletServerProxy(), state](auto callback) {
+    proxy->ReadCatalogAsync(state->req, &state->resp, &state->controller, [state, callback] {
+      callback(state->Complete());
+    });
+  });
+  return PgSessionAsyncRunResult(std::move(future_status), nullptr);
+}
+
+const std::shared_ptr<tserver::TabletServerServiceProxy>& PgSession::TabletServerProxy() {
+  if (!tablet_server_proxy_) {
+    tablet_server_proxy_ = std::make_shared<tserver::TabletServerServiceProxy>(
+        &client_->proxy_cache(), HostPort((**tserver_shared_object_).endpoint()));
+  }
+  return tablet_server_proxy_;
+}
+
 Result<YBSession*> PgSession::GetSession(bool transactional,
                                          bool read_only_op,
                                          bool needs_pessimistic_locking) {
@@ -885,7 +1130,14 @@ Result<bool> PgSession::IsInitDbDone() {
 }
 
 Status PgSession::FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional) {
-  DCHECK(ops.size() > 0 && ops.size() <= FLAGS_ysql_session_max_batch_size);
+  auto result = VERIFY_RESULT(SendBufferedOperations(ops, transactional));
+  RETURN_NOT_OK(result.GetStatus());
+  return HandleResponses(ops);
+}
+
+Result<PgSessionAsyncRunResult> PgSession::SendBufferedOperations(
+    const PgsqlOpBuffer& ops, bool transactional) {
+  DCHECK(ops.size() > 0 && ops.size() <= MaxBufferedOperations());
   auto session = VERIFY_RESULT(GetSession(transactional, false /* read_only_op */));
   if (session != session_.get()) {
     DCHECK(transactional);
@@ -905,9 +1157,10 @@ Status PgSession::FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool tra
         << ", initdb mode: " << YBCIsInitDbModeEnvVarSet();
     RETURN_NOT_OK(session->Apply(op));
   }
-  const auto status = session->FlushFuture().get();
-  RETURN_NOT_OK(CombineErrorsToStatus(session->GetPendingErrors(), status));
+  return PgSessionAsyncRunResult(session->FlushFuture(), session->shared_from_this());
+}
 
+Status PgSession::HandleResponses(const PgsqlOpBuffer& ops) {
   for (const auto& buffered_op : ops) {
     RETURN_NOT_OK(HandleResponse(*buffered_op.operation, buffered_op.relation_id));
   }
@@ -922,24 +1175,99 @@ Result<uint64_t> PgSession::GetSharedCatalogVersion() {
   }
 }
 
-bool PgSession::ForeignKeyReferenceExists(uint32_t table_id, std::string&& ybctid) {
+Result<bool> PgSession::ForeignKeyReferenceExists(
+    uint32_t table_id, std::string&& ybctid, const YbctidReader& reader) {
+  PgForeignKeyReference reference = {table_id, std::move(ybctid)};
+  auto& cache_index = fk_reference_cache_.get<1>();
+  auto cache_it = cache_index.find(reference);
+  if (cache_it != cache_index.end()) {
+    fk_reference_cache_.relocate(
+        fk_reference_cache_.end(), fk_reference_cache_.project<0>(cache_it));
+    return true;
+  }
+
+  // Absence of intent means that the row was already read in a batch with other rows, and was not
+  // found, or that intent was not added for it. Caller should check the row itself.
+  auto intent_it = fk_reference_intent_.find(reference);
+  if (intent_it == fk_reference_intent_.end()) {
+    return false;
+  }
+
+  // Read the row together with other intents of the same table, up to the session batch size.
+  const size_t max_batch_size = std::max(FLAGS_ysql_session_max_batch_size, 1);
+  std::vector<Slice> ybctids;
+  ybctids.reserve(std::min(fk_reference_intent_.size(), max_batch_size));
+  ybctids.push_back(intent_it->ybctid);
+  for (const auto& intent : fk_reference_intent_) {
+    if (ybctids.size() >= max_batch_size) {
+      break;
+    }
+    if (intent.table_id == table_id && intent.ybctid != reference.ybctid) {
+      ybctids.push_back(intent.ybctid);
+    }
+  }
+
+  auto existing_ybctids = VERIFY_RESULT(reader(table_id, ybctids));
+  bool found = false;
+  for (auto& existing_ybctid : existing_ybctids) {
+    found = found || existing_ybctid == reference.ybctid;
+    RETURN_NOT_OK(CacheForeignKeyReference(table_id, std::move(existing_ybctid)));
+  }
+
+  // Slices point to intents, so intents are removed only after the read.
+  std::vector<PgForeignKeyReference> read_intents;
+  read_intents.reserve(ybctids.size());
+  for (const auto& read_ybctid : ybctids) {
+    read_intents.emplace_back(table_id, read_ybctid.ToBuffer());
+  }
+  for (const auto& read_intent : read_intents) {
+    fk_reference_intent_.erase(read_intent);
+  }
+  return found;
+}
+
+void PgSession::AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid) {
   PgForeignKeyReference reference = {table_id, std::move(ybctid)};
-  return fk_reference_cache_.find(reference) != fk_reference_cache_.end();
+  if (fk_reference_cache_.get<1>().count(reference) == 0) {
+    fk_reference_intent_.insert(std::move(reference));
+  }
 }
 
 Status PgSession::CacheForeignKeyReference(uint32_t table_id, std::string&& ybctid) {
   PgForeignKeyReference reference = {table_id, std::move(ybctid)};
-  fk_reference_cache_.emplace(reference);
+  auto& cache_index = fk_reference_cache_.get<1>();
+  auto it = cache_index.find(reference);
+  if (it != cache_index.end()) {
+    fk_reference_cache_.relocate(fk_reference_cache_.end(), fk_reference_cache_.project<0>(it));
+    return Status::OK();
+  }
+  fk_reference_cache_.push_back(std::move(reference));
+  const size_t max_cache_size = std::max(FLAGS_ysql_fk_reference_cache_size, 1);
+  while (fk_reference_cache_.size() > max_cache_size) {
+    fk_reference_cache_.pop_front();
+  }
   return Status::OK();
 }
 
 Status PgSession::DeleteForeignKeyReference(uint32_t table_id, std::string&& ybctid) {
   PgForeignKeyReference reference = {table_id, std::move(ybctid)};
-  fk_reference_cache_.erase(reference);
+  fk_reference_cache_.get<1>().erase(reference);
   return Status::OK();
 }
 
 Status PgSession::HandleResponse(const client::YBPgsqlOp& op, const PgObjectId& relation_id) {
+  if (op.response().has_metrics()) {
+    const auto& metrics = op.response().metrics();
+    docdb_metrics_.set_seeks(docdb_metrics_.seeks() + metrics.seeks());
+    docdb_metrics_.set_nexts(docdb_metrics_.nexts() + metrics.nexts());
+    docdb_metrics_.set_internal_keys_skipped(
+        docdb_metrics_.internal_keys_skipped() + metrics.internal_keys_skipped());
+    docdb_metrics_.set_block_cache_hits(
+        docdb_metrics_.block_cache_hits() + metrics.block_cache_hits());
+    docdb_metrics_.set_blocks_read(docdb_metrics_.blocks_read() + metrics.blocks_read());
+    docdb_metrics_.set_block_bytes_read(
+        docdb_metrics_.block_bytes_read() + metrics.block_bytes_read());
+  }
   if (op.succeeded()) {
     return Status::OK();
   }
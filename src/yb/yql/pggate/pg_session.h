@@ -14,12 +14,20 @@
 #ifndef YB_YQL_PGGATE_PG_SESSION_H_
 #define YB_YQL_PGGATE_PG_SESSION_H_
 
+#include <deque>
+#include <functional>
 #include <unordered_set>
 
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <boost/optional.hpp>
 
 #include "yb/client/client_fwd.h"
 
+#include "yb/common/pgsql_protocol.pb.h"
+
 #include "yb/gutil/ref_counted.h"
 
 #include "yb/server/hybrid_clock.h"
@@ -33,6 +41,12 @@
 #include "yb/yql/pggate/pg_tabledesc.h"
 
 namespace yb {
+namespace tserver {
+
+class TabletServerServiceProxy;
+
+} // namespace tserver
+
 namespace pggate {
 
 YB_STRONGLY_TYPED_BOOL(OpBuffered);
@@ -138,6 +152,11 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   CHECKED_STATUS GetCatalogMasterVersion(uint64_t *version);
 
+  CHECKED_STATUS GetCatalogInvalMessages(uint64_t from_version, uint64_t *version,
+                                         boost::optional<std::string>* inval_messages);
+
+  CHECKED_STATUS IncrementCatalogVersion(const std::string& inval_messages, uint64_t *version);
+
   // API for sequences data operations.
   CHECKED_STATUS CreateSequencesDataTable();
 
@@ -166,6 +185,23 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   CHECKED_STATUS DeleteDBSequences(int64_t db_oid);
 
+  // Takes up to num_values values of the sequence from values leased by the local tablet server.
+  // Returns false when the tablet server has no values for this backend, or its sequence cache is
+  // not used. In this case values should be allocated with ReadSequenceTuple and
+  // UpdateSequenceTuple.
+  Result<bool> FetchSequenceRange(int64_t db_oid,
+                                  int64_t seq_oid,
+                                  uint64_t ysql_catalog_version,
+                                  int64_t inc_by,
+                                  int64_t min_value,
+                                  int64_t max_value,
+                                  int64_t num_values,
+                                  int64_t *first_value,
+                                  int64_t *last_value);
+
+  // Drops values of the sequence leased by tablet servers, after its tuple was set explicitly.
+  CHECKED_STATUS ResetSequenceRange(int64_t db_oid, int64_t seq_oid);
+
   //------------------------------------------------------------------------------------------------
   // Operations on Tablegroup.
   //------------------------------------------------------------------------------------------------
@@ -206,6 +242,22 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // but pending buffered operations are not allowed.
   CHECKED_STATUS ResetOperationsBuffering();
 
+  // Start bulk load into the table. Until bulk load is finished, buffered writes are sent in
+  // batches of up to ysql_session_max_batch_size rows per tablet of the table, and up to
+  // ysql_copy_max_in_flight_batches batches are kept in flight.
+  CHECKED_STATUS StartBulkLoad(const PgObjectId& table_id);
+  // Flush and wait for all writes of bulk load, and stop it.
+  CHECKED_STATUS FinishBulkLoad();
+
+  // Storage counters returned by DocDB for reads of this session since the last reset.
+  const PgsqlRequestMetricsPB& docdb_metrics() const {
+    return docdb_metrics_;
+  }
+
+  void ResetDocDBMetrics() {
+    docdb_metrics_.Clear();
+  }
+
   // Flush all pending buffered operations. Buffering mode remain unchanged.
   CHECKED_STATUS FlushBufferedOperations();
   // Drop all pending buffered operations. Buffering mode remain unchanged.
@@ -288,6 +340,7 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   void InvalidateForeignKeyReferenceCache() {
     fk_reference_cache_.clear();
+    fk_reference_intent_.clear();
   }
 
   // Check if initdb has already been run before. Needed to make initdb idempotent.
@@ -297,9 +350,19 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   // the shared memory has not been initialized (e.g. in initdb).
   Result<uint64_t> GetSharedCatalogVersion();
 
+  // Reads rows of the table by ybctids, and returns ybctids of the rows that exist.
+  typedef std::function<Result<std::vector<std::string>>(
+      uint32_t table_id, const std::vector<Slice>& ybctids)> YbctidReader;
+
   // Returns true if the row referenced by ybctid exists in FK reference cache (Used for caching
-  // foreign key checks).
-  bool ForeignKeyReferenceExists(uint32_t table_id, std::string&& ybctid);
+  // foreign key checks). When the row is not cached but its intent was added, the row is read by
+  // reader in one batch with other intents of the same table, and found rows are cached.
+  Result<bool> ForeignKeyReferenceExists(
+      uint32_t table_id, std::string&& ybctid, const YbctidReader& reader);
+
+  // Adds intent to check the row referenced by ybctid, so the check could be batched with
+  // checks of other rows.
+  void AddForeignKeyReferenceIntent(uint32_t table_id, std::string&& ybctid);
 
   // Adds the row referenced by ybctid to FK reference cache.
   CHECKED_STATUS CacheForeignKeyReference(uint32_t table_id, std::string&& ybctid);
@@ -326,6 +389,23 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   CHECKED_STATUS FlushBufferedOperationsImpl();
   CHECKED_STATUS FlushBufferedOperationsImpl(const PgsqlOpBuffer& ops, bool transactional);
 
+  // Applies buffered operations to the appropriate session and starts flushing them.
+  Result<PgSessionAsyncRunResult> SendBufferedOperations(
+      const PgsqlOpBuffer& ops, bool transactional);
+  CHECKED_STATUS HandleResponses(const PgsqlOpBuffer& ops);
+
+  // Number of buffered operations that are sent at once.
+  size_t MaxBufferedOperations() const;
+
+  // Whether buffered operations could be sent without waiting for them.
+  bool CanPipelineBufferedOperations() const;
+  // Sends buffered operations without waiting for them. Non-transactional operations are sent
+  // this way only by bulk load.
+  CHECKED_STATUS SendBufferedOperationsAsync();
+  // Waits until at most max_in_flight batches of pipelined operations are in flight.
+  // All batches are waited for even if some of them failed, the first error is returned.
+  CHECKED_STATUS WaitForInFlightOperations(size_t max_in_flight = 0);
+
   // Helper class to run multiple operations on single session.
   // This class allows to keep implementation of RunAsync template method simple
   // without moving its implementation details into header file.
@@ -343,8 +423,20 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
     bool transactional_;
     PgsqlOpBuffer& buffered_ops_;
     client::YBSessionPtr yb_session_;
+    // Catalog reads, that are sent through the local tablet server catalog read cache.
+    std::vector<std::shared_ptr<client::YBPgsqlReadOp>> catalog_read_ops_;
   };
 
+  // Whether operation should be sent through the catalog read cache of the local tablet server.
+  bool ShouldUseCatalogReadCache(const client::YBPgsqlOp& op, bool transactional);
+
+  // Reads catalog data through the local tablet server, so responses could be shared with other
+  // backends of the same node.
+  Result<PgSessionAsyncRunResult> ReadCatalogAsync(
+      std::vector<std::shared_ptr<client::YBPgsqlReadOp>> ops);
+
+  const std::shared_ptr<tserver::TabletServerServiceProxy>& TabletServerProxy();
+
   // Returns the appropriate session to use, in most cases the one used by the current transaction.
   // read_only_op - whether this is being done in the context of a read-only operation. For
   //                non-read-only operations we make sure to start a YB transaction.
@@ -382,16 +474,47 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   ObjectIdGenerator rowid_generator_;
 
   std::unordered_map<TableId, std::shared_ptr<client::YBTable>> table_cache_;
-  std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>> fk_reference_cache_;
+
+  // Referenced rows known to exist, evicted in LRU order when ysql_fk_reference_cache_size is
+  // reached.
+  typedef boost::multi_index_container<
+      PgForeignKeyReference,
+      boost::multi_index::indexed_by<
+          boost::multi_index::sequenced<>,
+          boost::multi_index::hashed_unique<
+              boost::multi_index::identity<PgForeignKeyReference>,
+              boost::hash<PgForeignKeyReference>>>> PgForeignKeyReferenceCache;
+  PgForeignKeyReferenceCache fk_reference_cache_;
+
+  // Referenced rows to be checked by the statement, that are not read yet.
+  std::unordered_set<PgForeignKeyReference, boost::hash<PgForeignKeyReference>>
+      fk_reference_intent_;
 
   // Should write operations be buffered?
   bool buffering_enabled_ = false;
   PgsqlOpBuffer buffered_ops_;
   PgsqlOpBuffer buffered_txn_ops_;
   std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>> buffered_keys_;
+  // Number of operations sent at once by bulk load, zero when bulk load is not in progress.
+  size_t bulk_load_batch_size_ = 0;
+
+  // Accumulated PgsqlResponsePB::metrics of handled responses.
+  PgsqlRequestMetricsPB docdb_metrics_;
+
+  // Batches of pipelined write operations, that were sent but not waited for yet.
+  struct InFlightOperations {
+    PgsqlOpBuffer ops;
+    PgSessionAsyncRunResult result;
+  };
+  std::deque<InFlightOperations> in_flight_ops_;
+  // Rows written by pipelined operations. Cleared when all of them are waited for.
+  std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>> in_flight_keys_;
 
   const tserver::TServerSharedObject* const tserver_shared_object_;
   const YBCPgCallbacks& pg_callbacks_;
+
+  // Proxy to the local tablet server, used for catalog reads and sequence values.
+  std::shared_ptr<tserver::TabletServerServiceProxy> tablet_server_proxy_;
 };
 
 }  // namespace pggate
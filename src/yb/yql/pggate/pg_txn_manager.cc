@@ -154,6 +154,12 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op,
     if (defer) {
       // This call is idempotent, meaning it has no affect after the first call.
       session_->DeferReadPoint();
+    } else if (read_only_ && !follower_read_ && FLAGS_ysql_follower_read_staleness_ms > 0) {
+      // Read the whole transaction at a single time in the past, so followers that are caught up
+      // to it could serve reads without waiting and without read restarts.
+      auto read_time = clock_->Now().AddMilliseconds(-FLAGS_ysql_follower_read_staleness_ms);
+      session_->SetReadPoint(ReadHybridTime::SingleTime(read_time));
+      follower_read_ = true;
     }
   } else {
     if (tserver_shared_object_) {
@@ -285,6 +291,7 @@ void PgTxnManager::ResetTxnAndSession() {
   txn_in_progress_ = false;
   session_ = nullptr;
   txn_ = nullptr;
+  follower_read_ = false;
   can_restart_.store(true, std::memory_order_release);
 }
 
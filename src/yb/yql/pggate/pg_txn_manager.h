@@ -72,6 +72,9 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
 
   bool IsDdlMode() const { return ddl_session_.get() != nullptr; }
 
+  // Whether reads of the current read-only transaction could be served by followers.
+  bool IsFollowerRead() const { return follower_read_ && !txn_; }
+
  private:
 
   client::TransactionManager* GetOrCreateTransactionManager();
@@ -95,6 +98,10 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
   bool read_only_ = false;
   bool deferrable_ = false;
 
+  // Whether read point of the current read-only transaction was moved to the past, see
+  // ysql_follower_read_staleness_ms.
+  bool follower_read_ = false;
+
   client::YBTransactionPtr ddl_txn_;
   client::YBSessionPtr ddl_session_;
 
@@ -14,8 +14,12 @@
 
 #include <boost/optional.hpp>
 
+#include "yb/client/yb_op.h"
 #include "yb/client/yb_table_name.h"
 
+#include "yb/common/pg_system_attr.h"
+#include "yb/common/row_mark.h"
+
 #include "yb/yql/pggate/pggate.h"
 #include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/pg_memctx.h"
@@ -23,6 +27,7 @@
 #include "yb/yql/pggate/pg_insert.h"
 #include "yb/yql/pggate/pg_update.h"
 #include "yb/yql/pggate/pg_delete.h"
+#include "yb/yql/pggate/pg_doc_op.h"
 #include "yb/yql/pggate/pg_truncate_colocated.h"
 #include "yb/yql/pggate/pg_select.h"
 #include "yb/yql/pggate/pg_txn_manager.h"
@@ -87,6 +92,43 @@ std::unique_ptr<tserver::TServerSharedObject> InitTServerSharedObject() {
       tserver::TServerSharedObject::OpenReadOnly(FLAGS_pggate_tserver_shm_fd)));
 }
 
+// Reads rows of the table by ybctids, and returns ybctids of existing rows. Rows are locked the
+// same way as by the foreign key check query of Postgres (SELECT ... FOR KEY SHARE).
+Result<std::vector<std::string>> FetchExistingYbctids(
+    const PgSession::ScopedRefPtr& pg_session, YBCPgOid database_id, YBCPgOid table_id,
+    const std::vector<Slice>& ybctids) {
+  auto table_desc = VERIFY_RESULT(pg_session->LoadTable(PgObjectId(database_id, table_id)));
+  auto read_op = table_desc->NewPgsqlSelect();
+  read_op->mutable_request()->add_targets()->set_column_id(
+      static_cast<int>(PgSystemAttrNum::kYBTupleId));
+  PgDocOp::SharedPtr doc_op = make_shared<PgDocReadOp>(
+      pg_session, table_desc, std::move(read_op));
+
+  PgExecParameters exec_params;
+  exec_params.limit_count = FLAGS_ysql_prefetch_limit;
+  exec_params.limit_offset = 0;
+  exec_params.limit_use_default = true;
+  exec_params.rowmark = ROW_MARK_KEYSHARE;
+  doc_op->ExecuteInit(&exec_params);
+  RETURN_NOT_OK(doc_op->PopulateDmlByYbctidOps(&ybctids, KeepYbctidOrder::kFalse));
+  RETURN_NOT_OK(doc_op->Execute());
+
+  std::vector<std::string> result;
+  result.reserve(ybctids.size());
+  std::list<PgDocResult> rowsets;
+  do {
+    rowsets.clear();
+    RETURN_NOT_OK(doc_op->GetResult(&rowsets));
+    for (auto& rowset : rowsets) {
+      RETURN_NOT_OK(rowset.ProcessSystemColumns());
+      for (const auto& ybctid : rowset.ybctids()) {
+        result.push_back(ybctid.ToBuffer());
+      }
+    }
+  } while (!rowsets.empty());
+  return result;
+}
+
 } // namespace
 
 using std::make_shared;
@@ -301,6 +343,22 @@ Status PgApiImpl::DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return pg_session_->DeleteSequenceTuple(db_oid, seq_oid);
 }
 
+Status PgApiImpl::FetchSequenceRange(int64_t db_oid,
+                                     int64_t seq_oid,
+                                     uint64_t ysql_catalog_version,
+                                     int64_t inc_by,
+                                     int64_t min_value,
+                                     int64_t max_value,
+                                     int64_t num_values,
+                                     int64_t *first_value,
+                                     int64_t *last_value,
+                                     bool *found) {
+  *found = VERIFY_RESULT(pg_session_->FetchSequenceRange(
+      db_oid, seq_oid, ysql_catalog_version, inc_by, min_value, max_value, num_values,
+      first_value, last_value));
+  return Status::OK();
+}
+
 
 //--------------------------------------------------------------------------------------------------
 
@@ -391,6 +449,18 @@ Status PgApiImpl::GetCatalogMasterVersion(uint64_t *version) {
   return pg_session_->GetCatalogMasterVersion(version);
 }
 
+Status PgApiImpl::GetCatalogInvalMessages(uint64_t from_version, uint64_t *version,
+                                          const std::string** inval_messages) {
+  RETURN_NOT_OK(pg_session_->GetCatalogInvalMessages(
+      from_version, version, &catalog_inval_messages_));
+  *inval_messages = catalog_inval_messages_ ? catalog_inval_messages_.get_ptr() : nullptr;
+  return Status::OK();
+}
+
+Status PgApiImpl::IncrementCatalogVersion(const Slice& inval_messages, uint64_t *version) {
+  return pg_session_->IncrementCatalogVersion(inval_messages.ToBuffer(), version);
+}
+
 Result<PgTableDesc::ScopedRefPtr> PgApiImpl::LoadTable(const PgObjectId& table_id) {
   return pg_session_->LoadTable(table_id);
 }
@@ -649,6 +719,24 @@ Status PgApiImpl::SetIsSysCatalogVersionChange(PgStatement *handle) {
   return STATUS(InvalidArgument, "Invalid statement handle");
 }
 
+Status PgApiImpl::SetCatalogInvalMessages(PgStatement *handle, const Slice& inval_messages) {
+  if (!handle) {
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+
+  switch (handle->stmt_op()) {
+    case StmtOp::STMT_UPDATE:
+    case StmtOp::STMT_DELETE:
+    case StmtOp::STMT_INSERT:
+      down_cast<PgDmlWrite *>(handle)->SetCatalogInvalMessages(inval_messages);
+      return Status::OK();
+    default:
+      break;
+  }
+
+  return STATUS(InvalidArgument, "Invalid statement handle");
+}
+
 Status PgApiImpl::SetCatalogCacheVersion(PgStatement *handle, uint64_t catalog_cache_version) {
   if (!handle) {
     return STATUS(InvalidArgument, "Invalid statement handle");
@@ -781,6 +869,21 @@ Status PgApiImpl::DmlBindColumnCondIn(PgStatement *handle, int attr_num, int n_a
   return down_cast<PgDmlRead*>(handle)->BindColumnCondIn(attr_num, n_attr_values, attr_values);
 }
 
+Status PgApiImpl::DmlBindYbctids(PgStatement *handle, int n, const char **ybctids,
+                                 const int64_t *ybctid_sizes) {
+  if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_SELECT)) {
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+  return down_cast<PgDmlRead*>(handle)->BindYbctids(n, ybctids, ybctid_sizes);
+}
+
+Status PgApiImpl::DmlBindWhereExpr(PgStatement *handle, PgExpr *where_expr) {
+  if (!PgStatement::IsValidStmt(handle, StmtOp::STMT_SELECT)) {
+    return STATUS(InvalidArgument, "Invalid statement handle");
+  }
+  return down_cast<PgDmlRead*>(handle)->BindWhereExpr(where_expr);
+}
+
 Status PgApiImpl::DmlBindTable(PgStatement *handle) {
   return down_cast<PgDml*>(handle)->BindTable();
 }
@@ -814,6 +917,28 @@ Status PgApiImpl::ResetOperationsBuffering() {
   return pg_session_->ResetOperationsBuffering();
 }
 
+Status PgApiImpl::StartBulkLoad(const PgObjectId& table_id) {
+  return pg_session_->StartBulkLoad(table_id);
+}
+
+Status PgApiImpl::FinishBulkLoad() {
+  return pg_session_->FinishBulkLoad();
+}
+
+void PgApiImpl::GetDocDBMetrics(YBCPgDocDBMetrics* metrics) {
+  const auto& docdb_metrics = pg_session_->docdb_metrics();
+  metrics->seeks = docdb_metrics.seeks();
+  metrics->nexts = docdb_metrics.nexts();
+  metrics->internal_keys_skipped = docdb_metrics.internal_keys_skipped();
+  metrics->block_cache_hits = docdb_metrics.block_cache_hits();
+  metrics->blocks_read = docdb_metrics.blocks_read();
+  metrics->block_bytes_read = docdb_metrics.block_bytes_read();
+}
+
+void PgApiImpl::ResetDocDBMetrics() {
+  pg_session_->ResetDocDBMetrics();
+}
+
 Status PgApiImpl::FlushBufferedOperations() {
   return pg_session_->FlushBufferedOperations();
 }
@@ -1140,8 +1265,16 @@ Status PgApiImpl::ExitSeparateDdlTxnMode(bool success) {
   return pg_txn_manager_->ExitSeparateDdlTxnMode(success);
 }
 
-bool PgApiImpl::ForeignKeyReferenceExists(YBCPgOid table_id, std::string&& ybctid) {
-  return pg_session_->ForeignKeyReferenceExists(table_id, std::move(ybctid));
+Result<bool> PgApiImpl::ForeignKeyReferenceExists(
+    YBCPgOid table_id, std::string&& ybctid, YBCPgOid database_id) {
+  auto reader = [this, database_id](uint32_t table_id, const std::vector<Slice>& ybctids) {
+    return FetchExistingYbctids(pg_session_, database_id, table_id, ybctids);
+  };
+  return pg_session_->ForeignKeyReferenceExists(table_id, std::move(ybctid), reader);
+}
+
+void PgApiImpl::AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid) {
+  pg_session_->AddForeignKeyReferenceIntent(table_id, std::move(ybctid));
 }
 
 Status PgApiImpl::CacheForeignKeyReference(YBCPgOid table_id, std::string&& ybctid) {
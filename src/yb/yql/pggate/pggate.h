@@ -132,6 +132,17 @@ class PgApiImpl {
 
   CHECKED_STATUS DeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
+  CHECKED_STATUS FetchSequenceRange(int64_t db_oid,
+                                    int64_t seq_oid,
+                                    uint64_t ysql_catalog_version,
+                                    int64_t inc_by,
+                                    int64_t min_value,
+                                    int64_t max_value,
+                                    int64_t num_values,
+                                    int64_t *first_value,
+                                    int64_t *last_value,
+                                    bool *found);
+
   // Remove all values and expressions that were bound to the given statement.
   CHECKED_STATUS ClearBinds(PgStatement *handle);
 
@@ -176,6 +187,15 @@ class PgApiImpl {
 
   CHECKED_STATUS GetCatalogMasterVersion(uint64_t *version);
 
+  // Get catalog master version, and invalidation messages of catalog versions after
+  // from_version. *inval_messages is set to null when master does not have all of them,
+  // otherwise it stays valid until the next call.
+  CHECKED_STATUS GetCatalogInvalMessages(uint64_t from_version, uint64_t *version,
+                                         const std::string** inval_messages);
+
+  // Increment catalog master version, recording inval_messages along with the new version.
+  CHECKED_STATUS IncrementCatalogVersion(const Slice& inval_messages, uint64_t *version);
+
   // Load table.
   Result<PgTableDesc::ScopedRefPtr> LoadTable(const PgObjectId& table_id);
 
@@ -264,6 +284,8 @@ class PgApiImpl {
 
   CHECKED_STATUS SetCatalogCacheVersion(PgStatement *handle, uint64_t catalog_cache_version);
 
+  CHECKED_STATUS SetCatalogInvalMessages(PgStatement *handle, const Slice& inval_messages);
+
   //------------------------------------------------------------------------------------------------
   // Create and drop index.
   CHECKED_STATUS NewCreateIndex(const char *database_name,
@@ -329,6 +351,13 @@ class PgApiImpl {
   CHECKED_STATUS DmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_attr_values,
       YBCPgExpr *attr_value);
 
+  // Bind a batch of ybctids to read, see YBCPgDmlBindYbctids.
+  CHECKED_STATUS DmlBindYbctids(YBCPgStatement handle, int n, const char **ybctids,
+                                const int64_t *ybctid_sizes);
+
+  // Bind a filter evaluated by DocDB, see YBCPgDmlBindWhereExpr.
+  CHECKED_STATUS DmlBindWhereExpr(YBCPgStatement handle, YBCPgExpr where_expr);
+
   // Binding Tables: Bind the whole table in a statement.  Do not use with BindColumn.
   CHECKED_STATUS DmlBindTable(YBCPgStatement handle);
 
@@ -369,6 +398,14 @@ class PgApiImpl {
   CHECKED_STATUS FlushBufferedOperations();
   void DropBufferedOperations();
 
+  // Bulk load.
+  CHECKED_STATUS StartBulkLoad(const PgObjectId& table_id);
+  CHECKED_STATUS FinishBulkLoad();
+
+  // Storage counters of DocDB reads.
+  void GetDocDBMetrics(YBCPgDocDBMetrics* metrics);
+  void ResetDocDBMetrics();
+
   //------------------------------------------------------------------------------------------------
   // Insert.
   CHECKED_STATUS NewInsert(const PgObjectId& table_id,
@@ -464,7 +501,9 @@ class PgApiImpl {
   CHECKED_STATUS OperatorAppendArg(PgExpr *op_handle, PgExpr *arg);
 
   // Foreign key reference caching.
-  bool ForeignKeyReferenceExists(YBCPgOid table_id, std::string&& ybctid);
+  Result<bool> ForeignKeyReferenceExists(
+      YBCPgOid table_id, std::string&& ybctid, YBCPgOid database_id);
+  void AddForeignKeyReferenceIntent(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS CacheForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
   CHECKED_STATUS DeleteForeignKeyReference(YBCPgOid table_id, std::string&& ybctid);
   void ClearForeignKeyReferenceCache();
@@ -510,6 +549,9 @@ class PgApiImpl {
   scoped_refptr<PgSession> pg_session_;
 
   YBCPgCallbacks pg_callbacks_;
+
+  // Invalidation messages returned by the last GetCatalogInvalMessages call.
+  boost::optional<std::string> catalog_inval_messages_;
 };
 
 }  // namespace pggate
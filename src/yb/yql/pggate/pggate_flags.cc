@@ -51,6 +51,15 @@ DEFINE_int32(ysql_request_limit, 1024,
 DEFINE_int32(ysql_prefetch_limit, 1024,
              "Maximum number of rows to prefetch");
 
+DEFINE_int32(ysql_prefetch_initial_limit, 128,
+             "Number of rows to prefetch by the first request of a scan. Page size is doubled with "
+             "every next page fetched by the scan, up to ysql_prefetch_limit rows. Zero disables "
+             "adaptive page sizing, so all pages use ysql_prefetch_limit");
+
+DEFINE_int64(ysql_prefetch_max_bytes, 1024 * 1024,
+             "Approximate limit on the size of rows prefetched by a single request of a scan. "
+             "Zero means no limit");
+
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
@@ -61,6 +70,11 @@ DEFINE_int32(ysql_session_max_batch_size, 512,
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
+DEFINE_int32(ysql_copy_max_in_flight_batches, 4,
+             "Maximum number of write batches COPY keeps in flight. Each batch contains up to "
+             "ysql_session_max_batch_size rows per tablet of the target table. Zero disables bulk "
+             "load mode of COPY, so it writes the same way as INSERT.");
+
 DEFINE_int32(ysql_max_read_restart_attempts, 20,
              "How many read restarts can we try transparently before giving up");
 
@@ -103,6 +117,50 @@ DEFINE_bool(ysql_serializable_isolation_for_ddl_txn, false,
             "By default, repeatable read isolation is used. "
             "This flag should go away once full transactional DDL is implemented.");
 
+DEFINE_bool(ysql_use_catalog_read_cache, false,
+            "Read YSQL catalog tables through the catalog read cache of the local tablet server, "
+            "so backends with the same catalog version share catalog data read from the master, "
+            "instead of reading it separately.");
+
+DEFINE_bool(ysql_use_tserver_sequence_cache, false,
+            "Take values of YSQL sequences, that don't cycle, from values leased by the local "
+            "tablet server, instead of reading and updating the sequence for each backend cache "
+            "refill. Like values cached by backends, leased values are still used after setval().");
+
+DEFINE_bool(ysql_session_pipelined_writes, false,
+            "Send full batches of buffered transactional writes asynchronously and keep them in "
+            "flight across statements. They are waited for before the next read, non-buffered "
+            "operation or commit, and their errors are reported by the statement that waits.");
+
+DEFINE_int32(ysql_session_max_in_flight_batches, 8,
+             "Maximum number of pipelined write batches sent by a session without waiting for "
+             "them. Used when ysql_session_pipelined_writes is true.");
+
 DEFINE_int32(ysql_select_parallelism, -1,
             "Number of read requests to issue in parallel to tablets of a table "
             "for SELECT.");
+
+DEFINE_int32(ysql_fk_reference_cache_size, 64 * 1024,
+             "Maximum number of referenced rows, known to exist, a session caches to skip foreign "
+             "key checks. Least recently used rows are evicted first.");
+
+DEFINE_bool(ysql_enable_parallel_scan, false,
+            "Scan tablets of a hash partitioned table in parallel for a filtered SELECT without "
+            "LIMIT. Rows are returned in no particular order, and up to ysql_select_parallelism "
+            "requests are in flight at once.");
+
+DEFINE_bool(ysql_enable_parallel_ordered_scan, false,
+            "Read ahead from following tablets while a range partitioned table is scanned in key "
+            "order by a SELECT without LIMIT. Rows of a tablet are kept until all rows of "
+            "preceding tablets are returned, and up to ysql_select_parallelism tablets are read "
+            "at once.");
+
+DEFINE_int32(ysql_follower_read_staleness_ms, 0,
+             "If positive, read-only transactions read a snapshot that is this number of "
+             "milliseconds in the past, which allows them to be served by followers. 0 means that "
+             "read-only transactions read the latest data from tablet leaders.");
+
+DEFINE_bool(ysql_collect_docdb_metrics, false,
+            "Request storage level counters (RocksDB seeks, nexts, blocks read) for each DocDB "
+            "read and accumulate them per session. They could be retrieved with "
+            "YBCPgGetDocDBMetrics.");
@@ -25,12 +25,19 @@ DECLARE_int32(pggate_tserver_shm_fd);
 DECLARE_bool(TEST_pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_request_limit);
 DECLARE_int32(ysql_prefetch_limit);
+DECLARE_int32(ysql_prefetch_initial_limit);
+DECLARE_int64(ysql_prefetch_max_bytes);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
 DECLARE_int32(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
+DECLARE_int32(ysql_copy_max_in_flight_batches);
 DECLARE_int32(ysql_max_read_restart_attempts);
 DECLARE_int32(ysql_output_buffer_size);
 DECLARE_int32(ysql_select_parallelism);
+DECLARE_bool(ysql_enable_parallel_scan);
+DECLARE_bool(ysql_enable_parallel_ordered_scan);
+DECLARE_int32(ysql_fk_reference_cache_size);
+DECLARE_int32(ysql_follower_read_staleness_ms);
 
 DECLARE_bool(ysql_suppress_unsupported_error);
 
@@ -42,5 +49,10 @@ DECLARE_bool(ysql_beta_feature_extension);
 DECLARE_bool(ysql_beta_feature_tablegroup);
 DECLARE_bool(ysql_enable_manual_sys_table_txn_ctl);
 DECLARE_bool(ysql_serializable_isolation_for_ddl_txn);
+DECLARE_bool(ysql_use_catalog_read_cache);
+DECLARE_bool(ysql_use_tserver_sequence_cache);
+DECLARE_bool(ysql_session_pipelined_writes);
+DECLARE_int32(ysql_session_max_in_flight_batches);
+DECLARE_bool(ysql_collect_docdb_metrics);
 
 #endif  // YB_YQL_PGGATE_PGGATE_FLAGS_H
@@ -13,8 +13,11 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include <map>
+
 #include "yb/yql/pggate/test/pggate_test.h"
 #include "yb/common/ybc-internal.h"
+#include "yb/docdb/doc_key.h"
 
 namespace yb {
 namespace pggate {
@@ -259,5 +262,108 @@ TEST_F(PggateTestSelect, TestSelectOneTablet) {
   pg_stmt = nullptr;
 }
 
+TEST_F(PggateTestSelect, TestSelectBoundYbctids) {
+  CHECK_OK(Init("TestSelectBoundYbctids"));
+
+  const char *tabname = "range_table";
+  const YBCPgOid tab_oid = 3;
+  YBCPgStatement pg_stmt;
+
+  // Create range partitioned table, so ybctid of a row is just its encoded range key.
+  int col_count = 0;
+  CHECK_YBC_STATUS(YBCPgNewCreateTable(kDefaultDatabase, kDefaultSchema, tabname,
+                                       kDefaultDatabaseOid, tab_oid,
+                                       false /* is_shared_table */, true /* if_not_exist */,
+                                       false /* add_primary_key */, true /* colocated */,
+                                       &pg_stmt));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "k", ++col_count,
+                                               DataType::INT64, false, true));
+  CHECK_YBC_STATUS(YBCTestCreateTableAddColumn(pg_stmt, "v", ++col_count,
+                                               DataType::INT64, false, false));
+  CHECK_YBC_STATUS(YBCPgExecCreateTable(pg_stmt));
+  pg_stmt = nullptr;
+
+  // INSERT rows (k, k * 10) for k in [0, kNumRows).
+  constexpr int64_t kNumRows = 10;
+  CHECK_YBC_STATUS(YBCPgNewInsert(kDefaultDatabaseOid, tab_oid,
+                                  false /* is_single_row_txn */, &pg_stmt));
+  YBCPgExpr expr_k;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt8(pg_stmt, 0, false, &expr_k));
+  YBCPgExpr expr_v;
+  CHECK_YBC_STATUS(YBCTestNewConstantInt8(pg_stmt, 0, false, &expr_v));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, 1, expr_k));
+  CHECK_YBC_STATUS(YBCPgDmlBindColumn(pg_stmt, 2, expr_v));
+  for (int64_t k = 0; k != kNumRows; ++k) {
+    YBCPgUpdateConstInt8(expr_k, k, false);
+    YBCPgUpdateConstInt8(expr_v, k * 10, false);
+    CHECK_YBC_STATUS(YBCPgExecInsert(pg_stmt));
+    CommitTransaction();
+  }
+  pg_stmt = nullptr;
+
+  // SELECT k, v by bound ybctids ------------------------------------------------------------------
+  CHECK_YBC_STATUS(YBCPgNewSelect(kDefaultDatabaseOid, tab_oid,
+                                  NULL /* prepare_params */, &pg_stmt));
+  YBCPgExpr colref;
+  YBCTestNewColumnRef(pg_stmt, 1, DataType::INT64, &colref);
+  CHECK_YBC_STATUS(YBCPgDmlAppendTarget(pg_stmt, colref));
+  YBCTestNewColumnRef(pg_stmt, 2, DataType::INT64, &colref);
+  CHECK_YBC_STATUS(YBCPgDmlAppendTarget(pg_stmt, colref));
+
+  uint64_t *values = static_cast<uint64_t*>(YBCPAlloc(col_count * sizeof(uint64_t)));
+  bool *isnulls = static_cast<bool*>(YBCPAlloc(col_count * sizeof(bool)));
+
+  // Binds ybctids of the specified keys, executes the statement and returns fetched rows as a map
+  // from k to v. Rows are returned in arbitrary order.
+  auto select_keys = [&](const std::vector<int64_t>& keys) {
+    std::vector<std::string> ybctids;
+    std::vector<const char*> ybctid_ptrs;
+    std::vector<int64_t> ybctid_sizes;
+    for (auto k : keys) {
+      ybctids.push_back(docdb::DocKey({ docdb::PrimitiveValue(k) }).Encode().ToStringBuffer());
+    }
+    for (const auto& ybctid : ybctids) {
+      ybctid_ptrs.push_back(ybctid.data());
+      ybctid_sizes.push_back(ybctid.size());
+    }
+    CHECK_YBC_STATUS(YBCPgDmlBindYbctids(
+        pg_stmt, static_cast<int>(ybctids.size()), ybctid_ptrs.data(), ybctid_sizes.data()));
+    CHECK_YBC_STATUS(YBCPgExecSelect(pg_stmt, nullptr /* exec_params */));
+
+    std::map<int64_t, int64_t> result;
+    for (;;) {
+      bool has_data = false;
+      CHECK_YBC_STATUS(YBCPgDmlFetch(pg_stmt, col_count, values, isnulls, nullptr, &has_data));
+      if (!has_data) {
+        break;
+      }
+      CHECK(!isnulls[0] && !isnulls[1]);
+      const auto k = static_cast<int64_t>(values[0]);
+      CHECK(result.emplace(k, static_cast<int64_t>(values[1])).second)
+          << "Row fetched twice: " << k;
+    }
+    return result;
+  };
+
+  LOG(INFO) << "Test SELECTing a batch of bound ybctids";
+  std::map<int64_t, int64_t> expected = {{1, 10}, {4, 40}, {7, 70}};
+  ASSERT_EQ(expected, select_keys({7, 1, 4}));
+
+  LOG(INFO) << "Test SELECTing bound ybctids of missing rows";
+  expected = {{2, 20}, {5, 50}};
+  ASSERT_EQ(expected, select_keys({kNumRows + 1, 2, kNumRows + 2, 5}));
+  ASSERT_TRUE(select_keys({kNumRows + 3}).empty());
+
+  LOG(INFO) << "Test SELECTing after binding ybctids again";
+  expected = {{9, 90}};
+  ASSERT_EQ(expected, select_keys({9}));
+
+  // At least one ybctid should be bound.
+  Status status(YBCPgDmlBindYbctids(pg_stmt, 0, nullptr, nullptr), AddRef::kFalse);
+  CHECK(status.IsInvalidArgument()) << status;
+
+  pg_stmt = nullptr;
+}
+
 } // namespace pggate
 } // namespace yb
@@ -14,7 +14,6 @@
 #ifndef YB_YQL_PGGATE_UTIL_PG_WIRE_H_
 #define YB_YQL_PGGATE_UTIL_PG_WIRE_H_
 
-#include <bitset>
 #include "yb/util/slice.h"
 #include "yb/client/client.h"
 
@@ -101,18 +100,21 @@ class PgWireDataHeader {
   }
 
   void set_null() {
-    data_[0] = 1;
+    data_ |= kNullFlag;
   }
   bool is_null() const {
-    return data_[0] == 1;
+    return (data_ & kNullFlag) != 0;
   }
 
   uint8_t ToUint8() const {
-    return static_cast<uint8_t>(data_.to_ulong());
+    return data_;
   }
 
  private:
-  std::bitset<8> data_;
+  // Header is read for every datum received from DocDB, so flags are kept in a plain byte.
+  static constexpr uint8_t kNullFlag = 0x01;
+
+  uint8_t data_ = 0;
 };
 
 }  // namespace pggate
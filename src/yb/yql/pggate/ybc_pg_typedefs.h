@@ -243,6 +243,16 @@ typedef struct PgTableProperties {
   bool is_colocated;
 } YBCPgTableProperties;
 
+// Storage level counters of DocDB reads, see PgsqlRequestMetricsPB.
+typedef struct PgDocDBMetrics {
+  uint64_t seeks;
+  uint64_t nexts;
+  uint64_t internal_keys_skipped;
+  uint64_t block_cache_hits;
+  uint64_t blocks_read;
+  uint64_t block_bytes_read;
+} YBCPgDocDBMetrics;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -201,6 +201,24 @@ YBCStatus YBCPgGetCatalogMasterVersion(uint64_t *version) {
   return ToYBCStatus(pgapi->GetCatalogMasterVersion(version));
 }
 
+YBCStatus YBCPgGetCatalogInvalMessages(uint64_t from_version,
+                                       uint64_t *version,
+                                       const char **messages,
+                                       size_t *messages_size) {
+  const std::string* inval_messages = nullptr;
+  YBCStatus status = ToYBCStatus(pgapi->GetCatalogInvalMessages(
+      from_version, version, &inval_messages));
+  *messages = inval_messages ? inval_messages->data() : nullptr;
+  *messages_size = inval_messages ? inval_messages->size() : 0;
+  return status;
+}
+
+YBCStatus YBCPgIncrementCatalogVersion(const char *messages,
+                                       size_t messages_size,
+                                       uint64_t *version) {
+  return ToYBCStatus(pgapi->IncrementCatalogVersion(Slice(messages, messages_size), version));
+}
+
 void YBCPgInvalidateTableCache(
     const YBCPgOid database_oid,
     const YBCPgOid table_oid) {
@@ -302,6 +320,21 @@ YBCStatus YBCDeleteSequenceTuple(int64_t db_oid, int64_t seq_oid) {
   return ToYBCStatus(pgapi->DeleteSequenceTuple(db_oid, seq_oid));
 }
 
+YBCStatus YBCFetchSequenceRange(int64_t db_oid,
+                                int64_t seq_oid,
+                                uint64_t ysql_catalog_version,
+                                int64_t inc_by,
+                                int64_t min_value,
+                                int64_t max_value,
+                                int64_t num_values,
+                                int64_t *first_value,
+                                int64_t *last_value,
+                                bool *found) {
+  return ToYBCStatus(pgapi->FetchSequenceRange(
+      db_oid, seq_oid, ysql_catalog_version, inc_by, min_value, max_value, num_values,
+      first_value, last_value, found));
+}
+
 // Table Operations -------------------------------------------------------------------------------
 
 YBCStatus YBCPgNewCreateTable(const char *database_name,
@@ -401,6 +434,12 @@ YBCStatus YBCPgSetCatalogCacheVersion(YBCPgStatement handle,
   return ToYBCStatus(pgapi->SetCatalogCacheVersion(handle, catalog_cache_version));
 }
 
+YBCStatus YBCPgSetCatalogInvalMessages(YBCPgStatement handle,
+                                       const char *messages,
+                                       size_t messages_size) {
+  return ToYBCStatus(pgapi->SetCatalogInvalMessages(handle, Slice(messages, messages_size)));
+}
+
 YBCStatus YBCPgDmlModifiesRow(YBCPgStatement handle, bool *modifies_row) {
   return ToYBCStatus(pgapi->DmlModifiesRow(handle, modifies_row));
 }
@@ -567,6 +606,15 @@ YBCStatus YBCPgDmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_at
   return ToYBCStatus(pgapi->DmlBindColumnCondIn(handle, attr_num, n_attr_values, attr_values));
 }
 
+YBCStatus YBCPgDmlBindYbctids(YBCPgStatement handle, int n, const char **ybctids,
+                              const int64_t *ybctid_sizes) {
+  return ToYBCStatus(pgapi->DmlBindYbctids(handle, n, ybctids, ybctid_sizes));
+}
+
+YBCStatus YBCPgDmlBindWhereExpr(YBCPgStatement handle, YBCPgExpr where_expr) {
+  return ToYBCStatus(pgapi->DmlBindWhereExpr(handle, where_expr));
+}
+
 YBCStatus YBCPgDmlBindTable(YBCPgStatement handle) {
   return ToYBCStatus(pgapi->DmlBindTable(handle));
 }
@@ -594,6 +642,22 @@ YBCStatus YBCPgResetOperationsBuffering() {
   return ToYBCStatus(pgapi->ResetOperationsBuffering());
 }
 
+YBCStatus YBCPgStartBulkLoad(YBCPgOid database_oid, YBCPgOid table_oid) {
+  return ToYBCStatus(pgapi->StartBulkLoad(PgObjectId(database_oid, table_oid)));
+}
+
+YBCStatus YBCPgFinishBulkLoad() {
+  return ToYBCStatus(pgapi->FinishBulkLoad());
+}
+
+void YBCPgGetDocDBMetrics(YBCPgDocDBMetrics* metrics) {
+  pgapi->GetDocDBMetrics(metrics);
+}
+
+void YBCPgResetDocDBMetrics() {
+  pgapi->ResetDocDBMetrics();
+}
+
 YBCStatus YBCPgFlushBufferedOperations() {
   return ToYBCStatus(pgapi->FlushBufferedOperations());
 }
@@ -795,8 +859,15 @@ YBCStatus YBCPgExitSeparateDdlTxnMode(bool success) {
 }
 
 // Referential Integrity Caching
-bool YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
-  return pgapi->ForeignKeyReferenceExists(table_id, std::string(ybctid, ybctid_size));
+YBCStatus YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size,
+                                       YBCPgOid database_id, bool* exists) {
+  return ExtractValueFromResult(
+      pgapi->ForeignKeyReferenceExists(table_id, std::string(ybctid, ybctid_size), database_id),
+      exists);
+}
+
+void YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
+  pgapi->AddForeignKeyReferenceIntent(table_id, std::string(ybctid, ybctid_size));
 }
 
 YBCStatus YBCCacheForeignKeyReference(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size) {
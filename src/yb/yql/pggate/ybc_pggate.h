@@ -104,6 +104,19 @@ YBCStatus YBCReadSequenceTuple(int64_t db_oid,
 
 YBCStatus YBCDeleteSequenceTuple(int64_t db_oid, int64_t seq_oid);
 
+// Takes up to num_values values of a sequence from values leased by the local tablet server.
+// Sets found to false if the values should be allocated by the backend.
+YBCStatus YBCFetchSequenceRange(int64_t db_oid,
+                                int64_t seq_oid,
+                                uint64_t ysql_catalog_version,
+                                int64_t inc_by,
+                                int64_t min_value,
+                                int64_t max_value,
+                                int64_t num_values,
+                                int64_t *first_value,
+                                int64_t *last_value,
+                                bool *found);
+
 // Create database.
 YBCStatus YBCPgNewCreateDatabase(const char *database_name,
                                  YBCPgOid database_oid,
@@ -135,6 +148,19 @@ YBCStatus YBCPgReserveOids(YBCPgOid database_oid,
 
 YBCStatus YBCPgGetCatalogMasterVersion(uint64_t *version);
 
+// Get catalog master version along with concatenated invalidation messages of catalog versions
+// after from_version. *messages is set to NULL if master does not have messages of all of them,
+// otherwise it stays valid until the next call.
+YBCStatus YBCPgGetCatalogInvalMessages(uint64_t from_version,
+                                       uint64_t *version,
+                                       const char **messages,
+                                       size_t *messages_size);
+
+// Increment catalog master version for invalidation messages not sent with any catalog write.
+YBCStatus YBCPgIncrementCatalogVersion(const char *messages,
+                                       size_t messages_size,
+                                       uint64_t *version);
+
 void YBCPgInvalidateTableCache(
     const YBCPgOid database_oid,
     const YBCPgOid table_oid);
@@ -232,6 +258,11 @@ YBCStatus YBCPgSetIsSysCatalogVersionChange(YBCPgStatement handle);
 
 YBCStatus YBCPgSetCatalogCacheVersion(YBCPgStatement handle, uint64_t catalog_cache_version);
 
+// Invalidation messages recorded by master along with the catalog version the write increments.
+YBCStatus YBCPgSetCatalogInvalMessages(YBCPgStatement handle,
+                                       const char *messages,
+                                       size_t messages_size);
+
 YBCStatus YBCPgIsTableColocated(const YBCPgOid database_oid,
                                 const YBCPgOid table_oid,
                                 bool *colocated);
@@ -325,6 +356,18 @@ YBCStatus YBCPgDmlBindColumnCondBetween(YBCPgStatement handle, int attr_num, YBC
 YBCStatus YBCPgDmlBindColumnCondIn(YBCPgStatement handle, int attr_num, int n_attr_values,
     YBCPgExpr *attr_values);
 
+// Bind a batch of ybctids to a SELECT, so rows for all of them are read by one request per tablet,
+// instead of a round trip per row. Intended for nested loop joins and other lookups of many keys
+// collected by the executor. Rows are returned in arbitrary order, missing rows are skipped.
+// Binding the next batch and executing the statement again reads the next batch of rows.
+YBCStatus YBCPgDmlBindYbctids(YBCPgStatement handle, int n, const char **ybctids,
+                              const int64_t *ybctid_sizes);
+
+// Bind a boolean expression to a SELECT, rows for which it does not evaluate to true are filtered
+// out by DocDB instead of being sent to Postgres. It is typically an "eval_expr_call" operator
+// built by the planner from WHERE clauses that DocDB is able to evaluate.
+YBCStatus YBCPgDmlBindWhereExpr(YBCPgStatement handle, YBCPgExpr where_expr);
+
 // Binding Tables: Bind the whole table in a statement.  Do not use with BindColumn.
 YBCStatus YBCPgDmlBindTable(YBCPgStatement handle);
 
@@ -347,11 +390,11 @@ YBCStatus YBCPgDmlBuildYBTupleId(YBCPgStatement handle, const YBCPgAttrValueDesc
 
 // DB Operations: WHERE, ORDER_BY, GROUP_BY, etc.
 // + The following operations are run by DocDB.
-//   - Not yet
+//   - API for "where_expr", see YBCPgDmlBindWhereExpr(), for expressions supported by DocDB.
 //
 // + The following operations are run by Postgres layer. An API might be added to move these
 //   operations to DocDB.
-//   - API for "where_expr"
+//   - API for "where_expr", for other expressions
 //   - API for "order_by_expr"
 //   - API for "group_by_expr"
 
@@ -363,6 +406,16 @@ YBCStatus YBCPgResetOperationsBuffering();
 YBCStatus YBCPgFlushBufferedOperations();
 void YBCPgDropBufferedOperations();
 
+// Bulk load of COPY. Buffered writes are sent in bigger batches and without waiting for them,
+// until the bulk load is finished.
+YBCStatus YBCPgStartBulkLoad(YBCPgOid database_oid, YBCPgOid table_oid);
+YBCStatus YBCPgFinishBulkLoad();
+
+// Storage counters of reads done by the session since the last reset, collected when
+// ysql_collect_docdb_metrics is true.
+void YBCPgGetDocDBMetrics(YBCPgDocDBMetrics* metrics);
+void YBCPgResetDocDBMetrics();
+
 // INSERT ------------------------------------------------------------------------------------------
 YBCStatus YBCPgNewInsert(YBCPgOid database_oid,
                          YBCPgOid table_oid,
@@ -451,8 +504,13 @@ YBCStatus YBCPgNewOperator(YBCPgStatement stmt, const char *opname,
 YBCStatus YBCPgOperatorAppendArg(YBCPgExpr op_handle, YBCPgExpr arg);
 
 // Referential Integrity Check Caching.
-// Check if foreign key reference exists in cache.
-bool YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
+// Check if foreign key reference exists in cache. If the reference is not cached, but its intent
+// was added, it is read from the database in a batch with other intents of the same table.
+YBCStatus YBCForeignKeyReferenceExists(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size,
+                                       YBCPgOid database_id, bool* exists);
+
+// Add intent to check foreign key reference, so checks of multiple rows could be batched.
+void YBCAddForeignKeyReferenceIntent(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
 
 // Add an entry to foreign key reference cache.
 YBCStatus YBCCacheForeignKeyReference(YBCPgOid table_id, const char* ybctid, int64_t ybctid_size);
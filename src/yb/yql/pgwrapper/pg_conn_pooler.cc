@@ -0,0 +1,957 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#include "yb/yql/pgwrapper/pg_conn_pooler.h"
+
+#include <cctype>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/optional.hpp>
+
+#include <gflags/gflags.h>
+
+#include "yb/gutil/endian.h"
+#include "yb/gutil/macros.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/thread.h"
+
+DEFINE_int32(ysql_conn_pooler_max_backends, 100,
+             "Maximal number of PostgreSQL backend connections opened by YSQL connection pooler. "
+             "Clients wait for a backend when all of them are busy.");
+TAG_FLAG(ysql_conn_pooler_max_backends, advanced);
+
+namespace yb {
+namespace pgwrapper {
+
+namespace {
+
+using boost::asio::ip::tcp;
+
+typedef std::function<void(const boost::system::error_code&)> IoHandler;
+
+// Special codes sent instead of protocol version in the startup packet.
+constexpr uint32_t kSslRequestCode = 80877103;
+constexpr uint32_t kCancelRequestCode = 80877102;
+constexpr uint32_t kProtocolVersion3 = 196608;
+
+// Same limit as used by postmaster.
+constexpr size_t kMaxStartupPacketSize = 10000;
+constexpr size_t kMaxMessageSize = 1_GB;
+
+// Message type byte followed by 4 bytes of length, that includes itself but not the type byte.
+constexpr size_t kMessageHeaderSize = 5;
+
+constexpr char kQueryMessage = 'Q';
+constexpr char kParseMessage = 'P';
+constexpr char kSyncMessage = 'S';
+constexpr char kFunctionCallMessage = 'F';
+constexpr char kTerminateMessage = 'X';
+constexpr char kCopyDataMessage = 'd';
+constexpr char kCopyDoneMessage = 'c';
+constexpr char kCopyFailMessage = 'f';
+constexpr char kAuthenticationMessage = 'R';
+constexpr char kErrorResponseMessage = 'E';
+constexpr char kReadyForQueryMessage = 'Z';
+
+// Transaction status reported by ReadyForQuery when backend is not inside a transaction block.
+constexpr char kIdleTransactionStatus = 'I';
+
+// Reads PostgreSQL protocol message, i.e. type byte followed by length prefixed body, into out.
+void AsyncReadMessage(tcp::socket* socket, std::string* out, IoHandler handler) {
+  out->resize(kMessageHeaderSize);
+  boost::asio::async_read(
+      *socket, boost::asio::buffer(&(*out)[0], kMessageHeaderSize),
+      [socket, out, handler = std::move(handler)](
+          const boost::system::error_code& ec, size_t transferred) {
+    if (ec) {
+      handler(ec);
+      return;
+    }
+    uint32_t length = BigEndian::Load32(out->data() + 1);
+    if (length < 4 || length > kMaxMessageSize) {
+      handler(boost::asio::error::message_size);
+      return;
+    }
+    size_t body_size = length - 4;
+    if (body_size == 0) {
+      handler(ec);
+      return;
+    }
+    out->resize(kMessageHeaderSize + body_size);
+    boost::asio::async_read(
+        *socket, boost::asio::buffer(&(*out)[kMessageHeaderSize], body_size),
+        [handler](const boost::system::error_code& ec, size_t transferred) {
+      handler(ec);
+    });
+  });
+}
+
+// Returns position after the end of the quoted literal, identifier or dollar quoted string,
+// that starts at pos, or npos if it is not terminated.
+size_t SkipQuoted(const std::string& query, size_t pos) {
+  const char quote = query[pos];
+  if (quote == '$') {
+    auto tag_end = query.find('$', pos + 1);
+    if (tag_end == std::string::npos) {
+      return tag_end;
+    }
+    auto end = query.find(query.substr(pos, tag_end + 1 - pos), tag_end + 1);
+    return end == std::string::npos ? end : end + tag_end + 1 - pos;
+  }
+  // Backslash escapes are only recognized in escape string constants, i.e. E'...'.
+  const bool backslash_escapes =
+      quote == '\'' && pos > 0 && (query[pos - 1] == 'E' || query[pos - 1] == 'e');
+  for (auto i = pos + 1; i < query.size(); ++i) {
+    if (backslash_escapes && query[i] == '\\') {
+      ++i;
+    } else if (query[i] == quote) {
+      return i + 1;
+    }
+  }
+  return std::string::npos;
+}
+
+// Whether dollar sign at pos starts dollar quoted string, i.e. $tag$ where tag is empty, or
+// identifier that does not start with digit.
+bool StartsDollarQuote(const std::string& query, size_t pos) {
+  for (auto i = pos + 1; i < query.size(); ++i) {
+    const auto ch = static_cast<unsigned char>(query[i]);
+    if (ch == '$') {
+      return true;
+    }
+    if (!(isalpha(ch) || ch == '_' || (i > pos + 1 && isdigit(ch)))) {
+      return false;
+    }
+  }
+  return false;
+}
+
+// Splits the query text, that starts at pos and ends at the end of message or at zero byte, into
+// statements. Each statement is returned as its unquoted words in lower case, and opening
+// parentheses as "(" tokens, other punctuation is dropped. Semicolons inside quoted literals,
+// identifiers and comments don't end a statement, and quoted text is not returned.
+std::vector<std::vector<std::string>> SplitStatements(const std::string& query, size_t pos) {
+  std::vector<std::vector<std::string>> result;
+  bool statement_started = false;
+  auto add_token = [&result, &statement_started](std::string token) {
+    if (!statement_started) {
+      result.emplace_back();
+      statement_started = true;
+    }
+    result.back().push_back(std::move(token));
+  };
+  while (pos < query.size() && query[pos]) {
+    const auto ch = static_cast<unsigned char>(query[pos]);
+    const char next = pos + 1 < query.size() ? query[pos + 1] : 0;
+    if (ch == ';') {
+      statement_started = false;
+      ++pos;
+    } else if (isspace(ch)) {
+      ++pos;
+    } else if (ch == '-' && next == '-') {
+      pos = query.find('\n', pos);
+    } else if (ch == '/' && next == '*') {
+      // Block comments could be nested.
+      int depth = 0;
+      do {
+        if (query.compare(pos, 2, "/*") == 0) {
+          ++depth;
+          pos += 2;
+        } else if (query.compare(pos, 2, "*/") == 0) {
+          --depth;
+          pos += 2;
+        } else {
+          ++pos;
+        }
+      } while (depth > 0 && pos < query.size());
+    } else if (ch == '(') {
+      add_token("(");
+      ++pos;
+    } else if (isalpha(ch) || ch == '_' || ch >= 0x80) {
+      std::string word;
+      while (pos < query.size()) {
+        const auto word_ch = static_cast<unsigned char>(query[pos]);
+        if (!(isalnum(word_ch) || word_ch == '_' || word_ch == '$' || word_ch >= 0x80)) {
+          break;
+        }
+        word += static_cast<char>(tolower(word_ch));
+        ++pos;
+      }
+      // Quoted literal with prefix, such as E'...', is skipped below. Prefix is not a word.
+      if (pos < query.size() && query[pos] == '\'' && word.size() <= 2) {
+        continue;
+      }
+      add_token(std::move(word));
+    } else if (ch == '\'' || ch == '"' || (ch == '$' && StartsDollarQuote(query, pos))) {
+      if (!statement_started) {
+        result.emplace_back();
+        statement_started = true;
+      }
+      pos = SkipQuoted(query, pos);
+    } else {
+      ++pos;
+    }
+  }
+  return result;
+}
+
+// Whether the statement, split into words by SplitStatements, creates state that lives longer than
+// the transaction.
+bool IsSessionScopedStatement(const std::vector<std::string>& words) {
+  // Functions that create such state when called with any arguments. Transaction scoped variants,
+  // such as pg_advisory_xact_lock, are not listed.
+  static const std::unordered_set<std::string> kSessionScopedFunctions = {
+      "set_config", "setseed", "pg_advisory_lock", "pg_advisory_lock_shared",
+      "pg_try_advisory_lock", "pg_try_advisory_lock_shared", "dblink_connect",
+      "dblink_connect_u", "dblink_open"};
+  // Words that precede TEMP or TEMPORARY, when it makes a temporary relation, i.e.
+  // CREATE [OR REPLACE] [LOCAL | GLOBAL] TEMP ... and SELECT ... INTO TEMP ...
+  static const std::unordered_set<std::string> kTemporaryRelationPrefixes = {
+      "create", "replace", "local", "global", "into"};
+
+  if (words.empty()) {
+    return false;
+  }
+  const auto& command = words[0];
+  if (command == "set") {
+    return words.size() < 2 ||
+           (words[1] != "local" && words[1] != "transaction" && words[1] != "constraints");
+  }
+  if (command == "reset" || command == "prepare" || command == "declare" || command == "listen" ||
+      command == "load") {
+    return true;
+  }
+  for (size_t i = 1; i < words.size(); ++i) {
+    const auto& word = words[i];
+    if ((word == "temp" || word == "temporary") &&
+        kTemporaryRelationPrefixes.count(words[i - 1])) {
+      return true;
+    }
+    if (word == "(" && kSessionScopedFunctions.count(words[i - 1])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whether the query text, that starts at pos, creates state that lives longer than the
+// transaction, so the client could not be moved to another backend after it. Each statement of
+// the query is checked, for the commands and the function calls that create session state.
+bool CreatesSessionState(const std::string& message, size_t pos) {
+  for (const auto& words : SplitStatements(message, pos)) {
+    if (IsSessionScopedStatement(words)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Connection to PostgreSQL backend, that could be attached to different clients over its life.
+// Backends are pooled by startup packet, that is used as a key.
+class PgBackend : public std::enable_shared_from_this<PgBackend> {
+ public:
+  // Invoked when backend is ready for query, or failed to start. In the latter case contains error
+  // response received from the backend, if any.
+  typedef std::function<void(const Status&, const std::string&)> ConnectCallback;
+
+  PgBackend(boost::asio::io_context* io_context, std::string key)
+      : socket_(*io_context), key_(std::move(key)) {}
+
+  // Connects to postmaster, sends startup packet and reads response until the first
+  // ReadyForQuery message.
+  void Connect(const Endpoint& endpoint, ConnectCallback callback) {
+    callback_ = std::move(callback);
+    socket_.async_connect(
+        endpoint,
+        [this, self = shared_from_this()](const boost::system::error_code& ec) {
+      if (ec) {
+        Finish(STATUS_FORMAT(NetworkError, "Connect failed: $0", ec.message()));
+        return;
+      }
+      boost::asio::async_write(
+          socket_, boost::asio::buffer(key_),
+          [this, self](const boost::system::error_code& ec, size_t transferred) {
+        if (ec) {
+          Finish(STATUS_FORMAT(NetworkError, "Send startup packet failed: $0", ec.message()));
+          return;
+        }
+        ReadStartupResponse();
+      });
+    });
+  }
+
+  void Close() {
+    boost::system::error_code ec;
+    socket_.close(ec);
+    LOG_IF(INFO, ec) << "Close backend failed: " << ec.message();
+  }
+
+  tcp::socket& socket() {
+    return socket_;
+  }
+
+  const std::string& key() const {
+    return key_;
+  }
+
+  // Messages sent by backend after startup packet, up to and including the first ReadyForQuery.
+  // Replayed to each client that gets this backend at startup.
+  const std::string& startup_response() const {
+    return startup_response_;
+  }
+
+ private:
+  void ReadStartupResponse() {
+    AsyncReadMessage(
+        &socket_, &message_,
+        [this, self = shared_from_this()](const boost::system::error_code& ec) {
+      if (ec) {
+        Finish(STATUS_FORMAT(NetworkError, "Read startup response failed: $0", ec.message()));
+        return;
+      }
+      switch (message_[0]) {
+        case kErrorResponseMessage:
+          Finish(STATUS(RuntimeError, "Backend startup failed"), message_);
+          return;
+        case kAuthenticationMessage:
+          if (message_.size() < kMessageHeaderSize + 4 ||
+              BigEndian::Load32(message_.data() + kMessageHeaderSize) != 0) {
+            Finish(STATUS(NotSupported, "Backend requested authentication"));
+            return;
+          }
+          break;
+        case kReadyForQueryMessage:
+          startup_response_ += message_;
+          Finish(Status::OK());
+          return;
+      }
+      startup_response_ += message_;
+      ReadStartupResponse();
+    });
+  }
+
+  void Finish(const Status& status, const std::string& error_response = std::string()) {
+    auto callback = std::move(callback_);
+    callback_ = nullptr;
+    callback(status, error_response);
+  }
+
+  tcp::socket socket_;
+  const std::string key_;
+  std::string startup_response_;
+  std::string message_;
+  ConnectCallback callback_;
+};
+
+typedef std::shared_ptr<PgBackend> PgBackendPtr;
+
+class PgBackendPool;
+
+
+// Client connection accepted by the pooler.
+class PgPooledClient : public std::enable_shared_from_this<PgPooledClient> {
+ public:
+  PgPooledClient(PgBackendPool* pool, tcp::socket* socket)
+      : pool_(*pool), socket_(std::move(*socket)) {
+    boost::system::error_code ec;
+    log_prefix_ = Format("Client $0: ", socket_.remote_endpoint(ec));
+  }
+
+  void Start() {
+    ReadStartupPacket();
+  }
+
+  // Invoked by the pool when backend is available for this client.
+  void Attached(const PgBackendPtr& backend);
+
+  // Invoked by the pool when backend could not be started for this client.
+  void Failed(const std::string& error_response);
+
+  void Close();
+
+  bool closed() const {
+    return closed_;
+  }
+
+  // Startup packet of the client, backends started with the same packet could serve it.
+  const std::string& key() const {
+    return startup_packet_;
+  }
+
+ private:
+  void ReadStartupPacket();
+  void HandleStartupPacket();
+  void StartRead();
+  void HandleMessage();
+  void ForwardMessage();
+  void StartBackendRead();
+  void HandleBackendMessage();
+  void HandleReadyForQuery();
+
+  // Backend could be returned to the pool when it is not inside a transaction block and all sent
+  // messages were answered.
+  bool CanDetach() const {
+    return backend_ && backend_idle_ && pending_ready_ == 0 && !unsynced_ && !pinned_;
+  }
+
+  const std::string& LogPrefix() const {
+    return log_prefix_;
+  }
+
+  PgBackendPool& pool_;
+  tcp::socket socket_;
+  std::string log_prefix_;
+  std::string startup_packet_;
+  std::string message_;
+  std::string backend_message_;
+  PgBackendPtr backend_;
+  // Startup response was sent to the client.
+  bool started_ = false;
+  bool closed_ = false;
+  // Client created session state, so it keeps its backend until disconnect.
+  bool pinned_ = false;
+  // Transaction status reported by the last ReadyForQuery of the attached backend is idle.
+  bool backend_idle_ = true;
+  // Number of messages sent to backend, that are answered with ReadyForQuery, i.e. Query, Sync
+  // and FunctionCall, for which ReadyForQuery was not received yet.
+  size_t pending_ready_ = 0;
+  // Extended query protocol messages were sent after the last Sync.
+  bool unsynced_ = false;
+};
+
+typedef std::shared_ptr<PgPooledClient> PgPooledClientPtr;
+
+// Keeps backends that are not attached to clients, and limits total number of backends.
+class PgBackendPool {
+ public:
+  PgBackendPool(boost::asio::io_context* io_context, const Endpoint& postmaster)
+      : io_context_(*io_context), postmaster_(postmaster) {}
+
+  // Attaches idle backend to the client, or opens a new one. Client waits when all backends are
+  // busy.
+  void Acquire(const PgPooledClientPtr& client) {
+    if (closing_) {
+      client->Close();
+      return;
+    }
+
+    auto it = idle_.find(client->key());
+    if (it != idle_.end()) {
+      auto backend = std::move(it->second.back());
+      it->second.pop_back();
+      if (it->second.empty()) {
+        idle_.erase(it);
+      }
+      client->Attached(backend);
+      return;
+    }
+
+    if (num_backends_ >= FLAGS_ysql_conn_pooler_max_backends && !CloseIdleBackend()) {
+      VLOG(2) << "All " << num_backends_ << " backends are busy";
+      waiters_.push_back(client);
+      return;
+    }
+
+    OpenBackend(client);
+  }
+
+  // Returns backend detached from client to the pool.
+  void Release(PgBackendPtr backend) {
+    auto client = PopWaiter();
+    if (client) {
+      if (client->key() == backend->key()) {
+        client->Attached(backend);
+      } else {
+        CloseBackend(backend);
+        OpenBackend(client);
+      }
+      return;
+    }
+    if (closing_) {
+      CloseBackend(backend);
+      return;
+    }
+    idle_[backend->key()].push_back(std::move(backend));
+  }
+
+  // Closes backend that should not be reused, for instance because it has session state.
+  void Discard(const PgBackendPtr& backend) {
+    CloseBackend(backend);
+    auto client = PopWaiter();
+    if (client) {
+      OpenBackend(client);
+    }
+  }
+
+  // Closes idle backends, backends that are still attached are closed by their clients.
+  void Shutdown() {
+    closing_ = true;
+    waiters_.clear();
+    for (const auto& key_and_backends : idle_) {
+      for (const auto& backend : key_and_backends.second) {
+        CloseBackend(backend);
+      }
+    }
+    idle_.clear();
+  }
+
+ private:
+  void OpenBackend(const PgPooledClientPtr& client) {
+    ++num_backends_;
+    auto backend = std::make_shared<PgBackend>(&io_context_, client->key());
+    backend->Connect(
+        postmaster_, [this, backend, client](const Status& status, const std::string& error) {
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to start backend: " << status;
+        client->Failed(error);
+        Discard(backend);
+        return;
+      }
+      if (client->closed()) {
+        Release(backend);
+        return;
+      }
+      client->Attached(backend);
+    });
+  }
+
+  bool CloseIdleBackend() {
+    if (idle_.empty()) {
+      return false;
+    }
+    auto it = idle_.begin();
+    CloseBackend(it->second.back());
+    it->second.pop_back();
+    if (it->second.empty()) {
+      idle_.erase(it);
+    }
+    return true;
+  }
+
+  void CloseBackend(const PgBackendPtr& backend) {
+    backend->Close();
+    --num_backends_;
+  }
+
+  PgPooledClientPtr PopWaiter() {
+    while (!waiters_.empty()) {
+      auto client = waiters_.front().lock();
+      waiters_.pop_front();
+      if (client && !client->closed()) {
+        return client;
+      }
+    }
+    return nullptr;
+  }
+
+  boost::asio::io_context& io_context_;
+  const Endpoint postmaster_;
+  bool closing_ = false;
+  std::deque<std::weak_ptr<PgPooledClient>> waiters_;
+  std::unordered_map<std::string, std::vector<PgBackendPtr>> idle_;
+  int num_backends_ = 0;
+};
+
+void PgPooledClient::ReadStartupPacket() {
+  startup_packet_.resize(4);
+  boost::asio::async_read(
+      socket_, boost::asio::buffer(&startup_packet_[0], 4),
+      [this, self = shared_from_this()](const boost::system::error_code& ec, size_t transferred) {
+    if (ec) {
+      VLOG_WITH_PREFIX(1) << "Read startup packet length failed: " << ec.message();
+      Close();
+      return;
+    }
+    uint32_t length = BigEndian::Load32(startup_packet_.data());
+    if (length < 8 || length > kMaxStartupPacketSize) {
+      LOG_WITH_PREFIX(WARNING) << "Invalid startup packet length: " << length;
+      Close();
+      return;
+    }
+    startup_packet_.resize(length);
+    boost::asio::async_read(
+        socket_, boost::asio::buffer(&startup_packet_[4], length - 4),
+        [this, self](const boost::system::error_code& ec, size_t transferred) {
+      if (ec) {
+        VLOG_WITH_PREFIX(1) << "Read startup packet failed: " << ec.message();
+        Close();
+        return;
+      }
+      HandleStartupPacket();
+    });
+  });
+}
+
+void PgPooledClient::HandleStartupPacket() {
+  uint32_t code = BigEndian::Load32(startup_packet_.data() + 4);
+  if (code == kSslRequestCode) {
+    // Refuse SSL, the client proceeds with the regular startup packet.
+    static const char kSslNotSupported = 'N';
+    boost::asio::async_write(
+        socket_, boost::asio::buffer(&kSslNotSupported, 1),
+        [this, self = shared_from_this()](
+            const boost::system::error_code& ec, size_t transferred) {
+      if (ec) {
+        Close();
+        return;
+      }
+      ReadStartupPacket();
+    });
+    return;
+  }
+  if (code == kCancelRequestCode) {
+    // Query cancellation is not supported, since backend could be already attached to another
+    // client.
+    VLOG_WITH_PREFIX(1) << "Ignoring cancel request";
+    Close();
+    return;
+  }
+  if (code != kProtocolVersion3) {
+    LOG_WITH_PREFIX(WARNING) << "Unsupported protocol version: " << code;
+    Close();
+    return;
+  }
+  pool_.Acquire(shared_from_this());
+}
+
+void PgPooledClient::Attached(const PgBackendPtr& backend) {
+  backend_ = backend;
+  backend_idle_ = true;
+  if (started_) {
+    ForwardMessage();
+    return;
+  }
+
+  // Client is idle after startup, so backend is returned to the pool right after replaying its
+  // startup response.
+  started_ = true;
+  boost::asio::async_write(
+      socket_, boost::asio::buffer(backend_->startup_response()),
+      [this, self = shared_from_this()](const boost::system::error_code& ec, size_t transferred) {
+    if (ec) {
+      Close();
+      return;
+    }
+    if (!closed_) {
+      pool_.Release(std::move(backend_));
+      backend_ = nullptr;
+    }
+    StartRead();
+  });
+}
+
+void PgPooledClient::Failed(const std::string& error_response) {
+  if (error_response.empty()) {
+    Close();
+    return;
+  }
+  message_ = error_response;
+  boost::asio::async_write(
+      socket_, boost::asio::buffer(message_),
+      [this, self = shared_from_this()](const boost::system::error_code& ec, size_t transferred) {
+    Close();
+  });
+}
+
+void PgPooledClient::Close() {
+  if (closed_) {
+    return;
+  }
+  closed_ = true;
+  boost::system::error_code ec;
+  socket_.close(ec);
+  LOG_IF_WITH_PREFIX(INFO, ec) << "Close failed: " << ec.message();
+  if (backend_) {
+    auto backend = std::move(backend_);
+    backend_ = nullptr;
+    if (backend_idle_ && pending_ready_ == 0 && !unsynced_ && !pinned_) {
+      pool_.Release(std::move(backend));
+    } else {
+      pool_.Discard(backend);
+    }
+  }
+}
+
+void PgPooledClient::StartRead() {
+  if (closed_) {
+    return;
+  }
+  AsyncReadMessage(
+      &socket_, &message_,
+      [this, self = shared_from_this()](const boost::system::error_code& ec) {
+    if (ec) {
+      VLOG_WITH_PREFIX(1) << "Read failed: " << ec.message();
+      Close();
+      return;
+    }
+    HandleMessage();
+  });
+}
+
+void PgPooledClient::HandleMessage() {
+  if (closed_) {
+    return;
+  }
+  if (message_[0] == kTerminateMessage) {
+    Close();
+    return;
+  }
+  if (!backend_) {
+    // Message is forwarded after backend is attached.
+    pool_.Acquire(shared_from_this());
+    return;
+  }
+  ForwardMessage();
+}
+
+void PgPooledClient::ForwardMessage() {
+  bool start_backend_read = CanDetach();
+  switch (message_[0]) {
+    case kQueryMessage:
+      pinned_ = pinned_ || CreatesSessionState(message_, kMessageHeaderSize);
+      ++pending_ready_;
+      unsynced_ = false;
+      break;
+    case kFunctionCallMessage:
+      // Function is identified by oid, so it is not known whether it creates session state, e.g.
+      // it could be set_config.
+      pinned_ = true;
+      FALLTHROUGH_INTENDED;
+    case kSyncMessage:
+      ++pending_ready_;
+      unsynced_ = false;
+      break;
+    case kCopyDataMessage: FALLTHROUGH_INTENDED;
+    case kCopyDoneMessage: FALLTHROUGH_INTENDED;
+    case kCopyFailMessage:
+      break;
+    case kParseMessage:
+      // Parse consists of statement name and query text, both zero terminated. Named prepared
+      // statement lives until the end of session, and query of unnamed one could create session
+      // state when executed.
+      if (!pinned_ && message_.size() > kMessageHeaderSize) {
+        pinned_ = message_[kMessageHeaderSize] != 0 ||
+                  CreatesSessionState(message_, kMessageHeaderSize + 1);
+      }
+      FALLTHROUGH_INTENDED;
+    default:
+      unsynced_ = true;
+      break;
+  }
+
+  boost::asio::async_write(
+      backend_->socket(), boost::asio::buffer(message_),
+      [this, self = shared_from_this()](const boost::system::error_code& ec, size_t transferred) {
+    if (ec) {
+      LOG_WITH_PREFIX(WARNING) << "Write to backend failed: " << ec.message();
+      Close();
+      return;
+    }
+    StartRead();
+  });
+
+  // Backend is read only while it could not be detached, so there is at most one read in flight.
+  if (start_backend_read) {
+    StartBackendRead();
+  }
+}
+
+void PgPooledClient::StartBackendRead() {
+  AsyncReadMessage(
+      &backend_->socket(), &backend_message_,
+      [this, self = shared_from_this()](const boost::system::error_code& ec) {
+    if (closed_) {
+      return;
+    }
+    if (ec) {
+      LOG_WITH_PREFIX(WARNING) << "Read from backend failed: " << ec.message();
+      Close();
+      return;
+    }
+    HandleBackendMessage();
+  });
+}
+
+void PgPooledClient::HandleBackendMessage() {
+  boost::asio::async_write(
+      socket_, boost::asio::buffer(backend_message_),
+      [this, self = shared_from_this()](const boost::system::error_code& ec, size_t transferred) {
+    if (ec) {
+      VLOG_WITH_PREFIX(1) << "Write failed: " << ec.message();
+      Close();
+      return;
+    }
+    if (closed_) {
+      return;
+    }
+    if (backend_message_[0] == kReadyForQueryMessage) {
+      HandleReadyForQuery();
+      return;
+    }
+    StartBackendRead();
+  });
+}
+
+void PgPooledClient::HandleReadyForQuery() {
+  backend_idle_ = backend_message_.size() > kMessageHeaderSize &&
+                  backend_message_[kMessageHeaderSize] == kIdleTransactionStatus;
+  if (pending_ready_ > 0) {
+    --pending_ready_;
+  }
+  if (!CanDetach()) {
+    StartBackendRead();
+    return;
+  }
+  VLOG_WITH_PREFIX(3) << "Detach backend";
+  pool_.Release(std::move(backend_));
+  backend_ = nullptr;
+}
+
+
+} // namespace
+
+// All connections are served by a single thread, so the pool and the connections are not
+// synchronized.
+class PgConnPooler::Impl {
+ public:
+  Impl() {
+    work_.emplace(io_context_);
+  }
+
+  ~Impl() {
+    LOG_IF(DFATAL, thread_ && !closing_) << "Connection pooler shutdown has not been started";
+  }
+
+  CHECKED_STATUS Start(const std::vector<Endpoint>& listen, const Endpoint& postmaster) {
+    pool_.emplace(&io_context_, postmaster);
+    for (const auto& endpoint : listen) {
+      LOG(INFO) << "Starting YSQL connection pooler: " << endpoint << " => " << postmaster;
+      tcp::acceptor acceptor(io_context_);
+      boost::system::error_code ec;
+      acceptor.open(endpoint.protocol(), ec);
+      if (ec) {
+        return STATUS_FORMAT(NetworkError, "Open failed: $0", ec.message());
+      }
+      acceptor.set_option(boost::asio::socket_base::reuse_address(true), ec);
+      if (ec) {
+        return STATUS_FORMAT(NetworkError, "Reuse address failed: $0", ec.message());
+      }
+      acceptor.bind(endpoint, ec);
+      if (ec) {
+        return STATUS_FORMAT(NetworkError, "Bind to $0 failed: $1", endpoint, ec.message());
+      }
+      acceptor.listen(tcp::socket::max_listen_connections, ec);
+      if (ec) {
+        return STATUS_FORMAT(NetworkError, "Listen failed: $0", ec.message());
+      }
+      acceptors_.push_back(std::make_unique<Acceptor>(&io_context_, std::move(acceptor)));
+    }
+
+    for (const auto& acceptor : acceptors_) {
+      StartAccept(acceptor.get());
+    }
+    return Thread::Create(
+        "pg_conn_pooler", "pg_conn_pooler", [this] { io_context_.run(); }, &thread_);
+  }
+
+  void Shutdown() {
+    if (!thread_ || closing_.exchange(true)) {
+      return;
+    }
+    io_context_.post([this] {
+      for (const auto& acceptor : acceptors_) {
+        boost::system::error_code ec;
+        acceptor->acceptor.close(ec);
+        LOG_IF(WARNING, ec) << "Close failed: " << ec.message();
+      }
+      pool_->Shutdown();
+      for (const auto& weak_client : clients_) {
+        auto client = weak_client.lock();
+        if (client) {
+          client->Close();
+        }
+      }
+      clients_.clear();
+    });
+    work_.reset();
+    thread_->Join();
+  }
+
+ private:
+  struct Acceptor {
+    Acceptor(boost::asio::io_context* io_context, tcp::acceptor&& acceptor_)
+        : acceptor(std::move(acceptor_)), socket(*io_context) {}
+
+    tcp::acceptor acceptor;
+    tcp::socket socket;
+  };
+
+  void StartAccept(Acceptor* acceptor) {
+    acceptor->acceptor.async_accept(
+        acceptor->socket, [this, acceptor](const boost::system::error_code& ec) {
+      if (ec) {
+        LOG_IF(WARNING, ec != boost::asio::error::operation_aborted)
+            << "Accept failed: " << ec.message();
+        return;
+      }
+      auto client = std::make_shared<PgPooledClient>(pool_.get_ptr(), &acceptor->socket);
+      acceptor->socket = tcp::socket(io_context_);
+      AddClient(client);
+      client->Start();
+      StartAccept(acceptor);
+    });
+  }
+
+  void AddClient(const PgPooledClientPtr& client) {
+    for (auto& weak_client : clients_) {
+      if (weak_client.expired()) {
+        weak_client = client;
+        return;
+      }
+    }
+    clients_.push_back(client);
+  }
+
+  boost::asio::io_context io_context_;
+  boost::optional<boost::asio::io_context::work> work_;
+  scoped_refptr<Thread> thread_;
+  std::atomic<bool> closing_{false};
+  boost::optional<PgBackendPool> pool_;
+  std::vector<std::unique_ptr<Acceptor>> acceptors_;
+  std::vector<std::weak_ptr<PgPooledClient>> clients_;
+};
+
+PgConnPooler::PgConnPooler() : impl_(new Impl) {
+}
+
+PgConnPooler::~PgConnPooler() {
+}
+
+Status PgConnPooler::Start(const std::vector<Endpoint>& listen, const Endpoint& postmaster) {
+  return impl_->Start(listen, postmaster);
+}
+
+void PgConnPooler::Shutdown() {
+  impl_->Shutdown();
+}
+
+}  // namespace pgwrapper
+}  // namespace yb
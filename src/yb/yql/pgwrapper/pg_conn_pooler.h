@@ -0,0 +1,52 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+
+#ifndef YB_YQL_PGWRAPPER_PG_CONN_POOLER_H
+#define YB_YQL_PGWRAPPER_PG_CONN_POOLER_H
+
+#include <memory>
+#include <vector>
+
+#include "yb/util/net/net_fwd.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace pgwrapper {
+
+// Accepts YSQL client connections and multiplexes them over a bounded pool of PostgreSQL backend
+// connections, so the number of backend processes does not grow with the number of clients.
+//
+// A backend is attached to a client when the client sends a message, and is returned to the pool
+// when it reports that it is idle, i.e. at transaction boundaries. Backends are pooled by startup
+// packet, so a client only reuses backends started for the same user, database and options.
+// A client that creates session state (named prepared statement, SET, temporary table, set_config,
+// session level advisory lock, fast path function call, ...) is pinned to its backend, and such
+// backend is closed when the client disconnects.
+class PgConnPooler {
+ public:
+  PgConnPooler();
+  ~PgConnPooler();
+
+  // Accepts clients at listen endpoints and opens backend connections to postmaster endpoint.
+  CHECKED_STATUS Start(const std::vector<Endpoint>& listen, const Endpoint& postmaster);
+
+  void Shutdown();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace pgwrapper
+}  // namespace yb
+
+#endif  // YB_YQL_PGWRAPPER_PG_CONN_POOLER_H
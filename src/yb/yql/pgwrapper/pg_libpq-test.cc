@@ -1128,6 +1128,252 @@ TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(NumberOfInitialRpcs)) {
   ASSERT_LT(rpcs_during, 150);
 }
 
+class PgLibPqCatalogReadCacheTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_use_catalog_read_cache=true");
+  }
+};
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(CatalogReadCache), PgLibPqCatalogReadCacheTest) {
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn.Execute("INSERT INTO t (key, value) VALUES (1, 2)"));
+
+  // Following connections reuse catalog data read by the previous ones.
+  for (int i = 0; i != 3; ++i) {
+    auto new_conn = ASSERT_RESULT(Connect());
+    ASSERT_EQ(ASSERT_RESULT(new_conn.FetchValue<int32_t>("SELECT value FROM t WHERE key = 1")), 2);
+  }
+
+  // Catalog change should be visible to new connections, after catalog version is propagated to
+  // tablet servers.
+  ASSERT_OK(conn.Execute("ALTER TABLE t ADD COLUMN extra INT"));
+  ASSERT_OK(conn.Execute("UPDATE t SET extra = 3 WHERE key = 1"));
+  ASSERT_OK(WaitFor([this]() -> Result<bool> {
+    auto new_conn = VERIFY_RESULT(Connect());
+    auto result = new_conn.FetchValue<int32_t>("SELECT extra FROM t WHERE key = 1");
+    return result.ok() && *result == 3;
+  }, 30s, "New column visible"));
+}
+
+// Catalog changes of one connection should be visible to the other one, after it applied their
+// invalidation messages or refreshed its caches.
+TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(CatalogInvalidationMessages)) {
+  auto conn1 = ASSERT_RESULT(Connect());
+  auto conn2 = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn1.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn1.Execute("INSERT INTO t (key, value) VALUES (1, 2)"));
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int32_t>("SELECT value FROM t WHERE key = 1")), 2);
+
+  ASSERT_OK(conn1.Execute("ALTER TABLE t ADD COLUMN extra INT DEFAULT 3"));
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int32_t>("SELECT extra FROM t WHERE key = 1")), 3);
+
+  // Several catalog versions are applied at once.
+  ASSERT_OK(conn1.Execute("ALTER TABLE t RENAME COLUMN extra TO renamed"));
+  ASSERT_OK(conn1.Execute("ALTER TABLE t RENAME TO t2"));
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int32_t>("SELECT renamed FROM t2 WHERE key = 1")), 3);
+  ASSERT_NOK(conn2.Fetch("SELECT * FROM t"));
+
+  // Own catalog changes do not hide the ones of the other connection done in between.
+  ASSERT_OK(conn2.Execute("ALTER TABLE t2 ADD COLUMN other INT DEFAULT 4"));
+  ASSERT_OK(conn1.Execute("ALTER TABLE t2 RENAME COLUMN other TO other2"));
+  ASSERT_OK(conn2.Execute("CREATE INDEX ON t2 (value)"));
+  ASSERT_EQ(ASSERT_RESULT(conn2.FetchValue<int32_t>("SELECT other2 FROM t2 WHERE key = 1")), 4);
+  ASSERT_EQ(ASSERT_RESULT(conn1.FetchValue<int32_t>("SELECT other2 FROM t2 WHERE value = 2")), 4);
+
+  ASSERT_OK(conn1.Execute("DROP TABLE t2"));
+  ASSERT_NOK(conn2.Fetch("SELECT * FROM t2"));
+}
+
+class PgLibPqTServerSequenceCacheTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_use_tserver_sequence_cache=true");
+    options->extra_tserver_flags.push_back("--ysql_sequence_lease_size=10");
+  }
+};
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(TServerSequenceCache),
+          PgLibPqTServerSequenceCacheTest) {
+  constexpr int kNumConnections = 3;
+  constexpr int kValuesPerConnection = 15;
+
+  std::vector<PGConn> conns;
+  for (int i = 0; i != kNumConnections; ++i) {
+    conns.push_back(ASSERT_RESULT(Connect()));
+  }
+  ASSERT_OK(conns[0].Execute("CREATE SEQUENCE s"));
+  ASSERT_OK(conns[0].Execute("CREATE SEQUENCE bounded MAXVALUE 12"));
+
+  // Connections of the same tablet server share leased values, so there are no gaps between them.
+  std::set<int64_t> values;
+  for (int i = 0; i != kValuesPerConnection; ++i) {
+    for (auto& conn : conns) {
+      auto value = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT nextval('s')"));
+      ASSERT_TRUE(values.insert(value).second) << "Duplicate value: " << value;
+    }
+  }
+  ASSERT_EQ(*values.begin(), 1);
+  ASSERT_EQ(*values.rbegin(), kNumConnections * kValuesPerConnection);
+
+  // Leased values are limited by the sequence bound, and reaching it is reported by backends.
+  for (int64_t i = 1; i <= 12; ++i) {
+    ASSERT_EQ(ASSERT_RESULT(conns[i % kNumConnections].FetchValue<int64_t>(
+        "SELECT nextval('bounded')")), i);
+  }
+  ASSERT_NOK(conns[0].FetchValue<int64_t>("SELECT nextval('bounded')"));
+}
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(TServerSequenceCacheSetval),
+          PgLibPqTServerSequenceCacheTest) {
+  auto* other_ts = cluster_->tablet_server(1);
+  auto conn = ASSERT_RESULT(Connect());
+  auto other_conn = ASSERT_RESULT(PGConn::Connect(
+      HostPort(other_ts->bind_host(), other_ts->pgsql_rpc_port())));
+  ASSERT_OK(conn.Execute("CREATE SEQUENCE s"));
+
+  // Both tablet servers lease values.
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT nextval('s')")), 1);
+  ASSERT_GT(ASSERT_RESULT(other_conn.FetchValue<int64_t>("SELECT nextval('s')")), 1);
+
+  // Values leased before setval are not handed out after it, by any tablet server.
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT setval('s', 100)")), 100);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT nextval('s')")), 101);
+  ASSERT_GT(ASSERT_RESULT(other_conn.FetchValue<int64_t>("SELECT nextval('s')")), 101);
+
+  // Same after restart of the sequence.
+  ASSERT_OK(other_conn.Execute("ALTER SEQUENCE s RESTART WITH 1000"));
+  ASSERT_EQ(ASSERT_RESULT(other_conn.FetchValue<int64_t>("SELECT nextval('s')")), 1000);
+  ASSERT_GT(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT nextval('s')")), 1000);
+}
+
+class PgLibPqConnPoolerTest : public PgLibPqTest {
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    options->extra_tserver_flags.push_back("--ysql_conn_pooler_enabled=true");
+    options->extra_tserver_flags.push_back("--ysql_conn_pooler_max_backends=2");
+  }
+};
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(ConnPooler), PgLibPqConnPoolerTest) {
+  constexpr int kNumConnections = 10;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+
+  // There are more clients than backends, but each client keeps working while connected.
+  std::vector<PGConn> conns;
+  for (int i = 0; i != kNumConnections; ++i) {
+    conns.push_back(ASSERT_RESULT(Connect()));
+  }
+  for (int i = 0; i != kNumConnections; ++i) {
+    ASSERT_OK(conns[i].ExecuteFormat("INSERT INTO t (key, value) VALUES ($0, $0)", i));
+  }
+
+  // Transaction block keeps its backend until commit, other clients use the remaining one.
+  ASSERT_OK(conns[0].Execute("BEGIN"));
+  ASSERT_OK(conns[0].Execute("UPDATE t SET value = 100 WHERE key = 0"));
+  ASSERT_EQ(ASSERT_RESULT(conns[1].FetchValue<int32_t>("SELECT value FROM t WHERE key = 0")), 0);
+  ASSERT_EQ(ASSERT_RESULT(conns[0].FetchValue<int32_t>("SELECT value FROM t WHERE key = 0")), 100);
+  ASSERT_OK(conns[0].Execute("COMMIT"));
+  ASSERT_EQ(ASSERT_RESULT(conns[1].FetchValue<int32_t>("SELECT value FROM t WHERE key = 0")), 100);
+
+  ASSERT_EQ(ASSERT_RESULT(conns.back().FetchValue<int64_t>("SELECT COUNT(*) FROM t")),
+            kNumConnections);
+}
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(ConnPoolerPerTServer), PgLibPqConnPoolerTest) {
+  // Tablet servers run on the same host, and each pooler should forward clients to the postmaster
+  // of its own tablet server.
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    auto* ts = cluster_->tablet_server(i);
+    auto conn = ASSERT_RESULT(PGConn::Connect(HostPort(ts->bind_host(), ts->pgsql_rpc_port())));
+    ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<std::string>("SELECT host(inet_server_addr())")),
+              ts->bind_host());
+  }
+}
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(ConnPoolerSessionState), PgLibPqConnPoolerTest) {
+  constexpr int kNumConnections = 5;
+
+  // Session state is created by a statement that is not the first one in the query, so the client
+  // should be pinned to its backend, and other clients should never get this backend.
+  auto pinned = ASSERT_RESULT(Connect());
+  ASSERT_OK(pinned.Execute("SELECT 1; SET statement_timeout = 123456"));
+
+  std::vector<PGConn> conns;
+  for (int i = 0; i != kNumConnections; ++i) {
+    conns.push_back(ASSERT_RESULT(Connect()));
+  }
+  for (int round = 0; round != 3; ++round) {
+    for (auto& conn : conns) {
+      ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<std::string>("SHOW statement_timeout")), "0");
+    }
+    ASSERT_EQ(ASSERT_RESULT(pinned.FetchValue<std::string>("SHOW statement_timeout")),
+              "123456ms");
+  }
+}
+
+TEST_F_EX(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(ConnPoolerSessionStateFunctions),
+          PgLibPqConnPoolerTest) {
+  constexpr int kNumConnections = 5;
+
+  std::vector<PGConn> conns;
+  for (int i = 0; i != kNumConnections; ++i) {
+    conns.push_back(ASSERT_RESULT(Connect()));
+  }
+
+  // Checks that query returns pinned_value for the pinned client, and other_value for other
+  // clients, i.e. that other clients never get the backend of the pinned client.
+  auto check_pinned = [&conns](PGConn* pinned, const std::string& query,
+                               const std::string& pinned_value, const std::string& other_value) {
+    for (int round = 0; round != 3; ++round) {
+      for (auto& conn : conns) {
+        ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<std::string>(query)), other_value);
+      }
+      ASSERT_EQ(ASSERT_RESULT(pinned->FetchValue<std::string>(query)), pinned_value);
+    }
+  };
+
+  // There are only 2 backends, so each pinned client is disconnected before the next one is
+  // connected, and its backend is closed.
+  LOG(INFO) << "set_config using simple query protocol";
+  {
+    auto pinned = ASSERT_RESULT(Connect());
+    PGResultPtr res(PQexec(
+        pinned.get(), "SELECT set_config('statement_timeout', '123456', false /* is_local */)"));
+    ASSERT_EQ(PQresultStatus(res.get()), PGRES_TUPLES_OK);
+    ASSERT_NO_FATALS(check_pinned(&pinned, "SHOW statement_timeout", "123456ms", "0"));
+  }
+
+  LOG(INFO) << "Session level advisory lock using extended query protocol";
+  {
+    auto pinned = ASSERT_RESULT(Connect());
+    ASSERT_RESULT(pinned.Fetch("SELECT pg_advisory_lock(1)"));
+    // Advisory locks are reentrant within the session, so only the pinned client gets the lock.
+    ASSERT_NO_FATALS(check_pinned(
+        &pinned, "SELECT pg_try_advisory_xact_lock(1)::text", "true", "false"));
+  }
+
+  LOG(INFO) << "Named prepared statement";
+  {
+    auto pinned = ASSERT_RESULT(Connect());
+    PGResultPtr res(PQprepare(pinned.get(), "stmt", "SELECT 1", 0 /* nParams */, nullptr));
+    ASSERT_EQ(PQresultStatus(res.get()), PGRES_COMMAND_OK);
+    ASSERT_NO_FATALS(check_pinned(
+        &pinned, "SELECT COUNT(*)::text FROM pg_prepared_statements", "1", "0"));
+  }
+
+  for (const auto& create_temp : {
+      "SELECT 1 AS value INTO TEMP t_temp",
+      "CREATE LOCAL TEMPORARY TABLE t_temp (value INT)",
+      "/* comment */ CREATE GLOBAL TEMP TABLE t_temp (value INT)"}) {
+    LOG(INFO) << "Temporary table: " << create_temp;
+    auto pinned = ASSERT_RESULT(Connect());
+    ASSERT_OK(pinned.Execute(create_temp));
+    ASSERT_NO_FATALS(check_pinned(
+        &pinned, "SELECT COALESCE(to_regclass('t_temp')::text, '')", "t_temp", ""));
+  }
+}
+
 TEST_F(PgLibPqTest, YB_DISABLE_TEST_IN_TSAN(RangePresplit)) {
   const string kDatabaseName ="yugabyte";
   auto client = ASSERT_RESULT(cluster_->CreateClient());
@@ -11,6 +11,8 @@
 // under the License.
 //
 
+#include <set>
+
 #include "yb/integration-tests/mini_cluster.h"
 #include "yb/integration-tests/yb_mini_cluster_test_base.h"
 
@@ -982,6 +984,66 @@ TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ManyRowsInsert), PgMiniSingleTServ
   LOG(INFO) << "Time: " << finish - start;
 }
 
+// Checks that data of a dropped colocated table is removed by compaction, while data of other
+// tables of the same colocated tablet is kept.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(DropColocatedTable), PgMiniSingleTServerTest) {
+  constexpr int kRows = 100;
+  const std::string kDatabaseName = "colocated_db";
+
+  FLAGS_timestamp_history_retention_interval_sec = 0;
+  FLAGS_history_cutoff_propagation_interval_ms = 1;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.ExecuteFormat("CREATE DATABASE $0 WITH colocated = true", kDatabaseName));
+  conn = ASSERT_RESULT(ConnectToDB(kDatabaseName));
+
+  // Waits until intents are applied, then flushes and compacts the colocated tablet and returns
+  // the number of its regular DB records.
+  auto compact_and_count_records = [this]() -> Result<size_t> {
+    RETURN_NOT_OK(WaitFor([this] {
+      for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+        auto* tablet = peer->tablet();
+        auto* participant = tablet ? tablet->transaction_participant() : nullptr;
+        if (participant && participant->TEST_CountIntents().first != 0) {
+          return false;
+        }
+      }
+      return true;
+    }, 10s, "Intents applied"));
+    RETURN_NOT_OK(cluster_->FlushTablets(tablet::FlushMode::kSync));
+    RETURN_NOT_OK(cluster_->CompactTablets());
+    size_t result = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      if (peer->tablet() && peer->tablet_metadata()->colocated()) {
+        result += peer->tablet()->TEST_CountRegularDBRecords();
+      }
+    }
+    return result;
+  };
+
+  ASSERT_OK(conn.Execute("CREATE TABLE kept (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO kept SELECT i, i FROM generate_series(1, $0) AS i", kRows));
+  const auto kept_records = ASSERT_RESULT(compact_and_count_records());
+  ASSERT_GT(kept_records, 0);
+
+  ASSERT_OK(conn.Execute("CREATE TABLE dropped (key INT PRIMARY KEY, value INT)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO dropped SELECT i, i FROM generate_series(1, $0) AS i", kRows));
+  ASSERT_GT(ASSERT_RESULT(compact_and_count_records()), kept_records);
+
+  ASSERT_OK(conn.Execute("DROP TABLE dropped"));
+
+  // The tablet removes the table asynchronously, after the master processed the drop.
+  ASSERT_OK(WaitFor([&compact_and_count_records, kept_records]() -> Result<bool> {
+    auto records = VERIFY_RESULT(compact_and_count_records());
+    LOG(INFO) << "Colocated tablet records: " << records << ", expected: " << kept_records;
+    return records == kept_records;
+  }, 30s, "Dropped table data removed"));
+
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT count(*) FROM kept")), kRows);
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(MoveMaster)) {
   ShutdownAllMasters(cluster_.get());
   cluster_->mini_master(0)->set_pass_master_addresses(false);
@@ -1280,5 +1342,281 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(CreateDatabase)) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+class PgMiniPipelinedWritesTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_session_pipelined_writes = true;
+    FLAGS_ysql_session_max_batch_size = 10;
+    PgMiniTest::SetUp();
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(PipelinedWrites), PgMiniPipelinedWritesTest) {
+  constexpr int kRowsPerStatement = 100;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT)"));
+
+  // Batches of both statements are in flight, and are waited for by the read.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  for (int i = 0; i != 2; ++i) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "INSERT INTO t SELECT generate_series($0, $1), 0",
+        i * kRowsPerStatement + 1, (i + 1) * kRowsPerStatement));
+  }
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")),
+            2 * kRowsPerStatement);
+  ASSERT_OK(conn.Execute("UPDATE t SET value = 1"));
+  ASSERT_OK(conn.Execute("COMMIT"));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(value) FROM t")),
+            2 * kRowsPerStatement);
+
+  // Error of pipelined write is reported, at the latest by commit, and aborts the transaction.
+  ASSERT_OK(conn.Execute("BEGIN"));
+  auto status = conn.ExecuteFormat(
+      "INSERT INTO t SELECT generate_series($0, $1), 2",
+      2 * kRowsPerStatement - 5, 2 * kRowsPerStatement + 5);
+  if (status.ok()) {
+    status = conn.Execute("COMMIT");
+  } else {
+    ASSERT_OK(conn.Execute("ROLLBACK"));
+  }
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "duplicate key value violates unique constraint");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")),
+            2 * kRowsPerStatement);
+}
+
+class PgMiniAdaptivePrefetchTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_prefetch_initial_limit = 2;
+    FLAGS_ysql_prefetch_limit = 100;
+    FLAGS_ysql_prefetch_max_bytes = 4096;
+    PgMiniTest::SetUp();
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(AdaptivePrefetch), PgMiniAdaptivePrefetchTest) {
+  constexpr int kNumRows = 1000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (h INT, r INT, value TEXT, PRIMARY KEY (h, r ASC))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT 1, i, repeat('x', i) FROM generate_series(1, $0) AS i", kNumRows));
+
+  // Page size grows while the scan proceeds, and is cut by the byte budget for the wide rows.
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t WHERE h = 1")),
+            kNumRows);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(length(value)) FROM t")),
+            kNumRows * (kNumRows + 1) / 2);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>(
+                "SELECT r FROM t WHERE h = 1 ORDER BY r DESC OFFSET 500 LIMIT 1")),
+            kNumRows - 500);
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int32_t>(
+                "SELECT r FROM t WHERE h = 1 ORDER BY r OFFSET 999 LIMIT 1")),
+            kNumRows);
+}
+
+class PgMiniBulkCopyTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_session_max_batch_size = 5;
+    FLAGS_ysql_copy_max_in_flight_batches = 3;
+    PgMiniTest::SetUp();
+  }
+
+  CHECKED_STATUS Copy(PGConn* conn, int first_key, int last_key) {
+    RETURN_NOT_OK(conn->CopyBegin("COPY t FROM STDIN WITH BINARY"));
+    for (int key = first_key; key <= last_key; ++key) {
+      conn->CopyStartRow(2);
+      conn->CopyPutInt32(key);
+      conn->CopyPutInt32(key);
+    }
+    return ResultToStatus(conn->CopyEnd());
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BulkCopy), PgMiniBulkCopyTest) {
+  constexpr int kNumRows = 1000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT) SPLIT INTO 4 TABLETS"));
+
+  ASSERT_OK(Copy(&conn, 1, kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+
+  // Error of a batch that was in flight fails the whole COPY.
+  auto status = Copy(&conn, kNumRows - 10, kNumRows + 100);
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "duplicate key value violates unique constraint");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")), kNumRows);
+
+  ASSERT_OK(Copy(&conn, kNumRows + 1, 2 * kNumRows));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(value) FROM t")),
+            kNumRows * (2 * kNumRows + 1));
+}
+
+class PgMiniFKReferenceCacheTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_session_max_batch_size = 10;
+    FLAGS_ysql_fk_reference_cache_size = 20;
+    PgMiniTest::SetUp();
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(FKReferenceBatching), PgMiniFKReferenceCacheTest) {
+  constexpr int kNumParents = 100;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE parent (id INT PRIMARY KEY)"));
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE child (id INT PRIMARY KEY, parent_id INT REFERENCES parent(id))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO parent SELECT generate_series(1, $0)", kNumParents));
+
+  // References are read in batches and evicted from the cache, while all of them are checked.
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, i % $0 + 1 FROM generate_series(1, $1) AS i",
+      kNumParents, 3 * kNumParents));
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM child")),
+            3 * kNumParents);
+
+  // Missing reference in the middle of a batch is detected.
+  auto status = conn.ExecuteFormat(
+      "INSERT INTO child SELECT i, CASE WHEN i = $0 THEN $1 ELSE i % $1 + 1 END "
+      "FROM generate_series($2, $3) AS i",
+      4 * kNumParents, kNumParents + 1, 3 * kNumParents + 1, 5 * kNumParents);
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "violates foreign key constraint");
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM child")),
+            3 * kNumParents);
+
+  // Parent deleted after its reference was cached is detected by the next transaction.
+  ASSERT_OK(conn.Execute("DELETE FROM child WHERE parent_id = 1"));
+  ASSERT_OK(conn.Execute("DELETE FROM parent WHERE id = 1"));
+  ASSERT_NOK(conn.Execute("INSERT INTO child VALUES (0, 1), (-1, 2)"));
+  ASSERT_OK(conn.Execute("INSERT INTO child VALUES (-1, 2)"));
+}
+
+class PgMiniParallelScanTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_enable_parallel_scan = true;
+    FLAGS_ysql_select_parallelism = 3;
+    FLAGS_ysql_prefetch_limit = 10;
+    PgMiniTest::SetUp();
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelScan), PgMiniParallelScanTest) {
+  constexpr int kNumRows = 1000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT PRIMARY KEY, value INT) SPLIT INTO 8 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i % 10 FROM generate_series(1, $0) AS i", kNumRows));
+
+  // Pages from all tablets are merged, without losing or duplicating rows.
+  auto res = ASSERT_RESULT(conn.Fetch("SELECT key FROM t WHERE value = 3"));
+  ASSERT_EQ(PQntuples(res.get()), kNumRows / 10);
+  std::set<int32_t> keys;
+  for (int i = 0; i != PQntuples(res.get()); ++i) {
+    auto key = ASSERT_RESULT(GetInt32(res.get(), i, 0));
+    ASSERT_EQ(key % 10, 3);
+    ASSERT_TRUE(keys.insert(key).second);
+  }
+
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>(
+                "SELECT COUNT(*) FROM (SELECT key FROM t WHERE value >= 5) AS s")),
+            kNumRows / 2);
+}
+
+class PgMiniParallelOrderedScanTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_enable_parallel_ordered_scan = true;
+    FLAGS_ysql_select_parallelism = 3;
+    FLAGS_ysql_prefetch_limit = 10;
+    PgMiniTest::SetUp();
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelOrderedScan),
+          PgMiniParallelOrderedScanTest) {
+  constexpr int kNumRows = 1000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT, value INT, PRIMARY KEY (key ASC)) "
+      "SPLIT AT VALUES ((100), (200), (300), (500), (700), (900))"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i % 10 FROM generate_series(1, $0) AS i", kNumRows));
+
+  // Rows of tablets read ahead are returned after rows of preceding tablets, and each tablet is
+  // scanned only once.
+  for (const auto* query : {"SELECT key FROM t", "SELECT key FROM t ORDER BY key"}) {
+    auto res = ASSERT_RESULT(conn.Fetch(query));
+    ASSERT_EQ(PQntuples(res.get()), kNumRows) << query;
+    for (int i = 0; i != PQntuples(res.get()); ++i) {
+      ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), i, 0)), i + 1) << query;
+    }
+  }
+
+  // Filtered scan returns pages with no rows from some tablets.
+  auto res = ASSERT_RESULT(conn.Fetch("SELECT key FROM t WHERE value = 3 ORDER BY key"));
+  ASSERT_EQ(PQntuples(res.get()), kNumRows / 10);
+  for (int i = 0; i != PQntuples(res.get()); ++i) {
+    ASSERT_EQ(ASSERT_RESULT(GetInt32(res.get(), i, 0)), i * 10 + 3);
+  }
+}
+
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ExpressionPushdown)) {
+  constexpr int kNumRows = 100;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT PRIMARY KEY, name TEXT, amount NUMERIC, ts TIMESTAMP)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, CASE WHEN i % 7 = 0 THEN NULL ELSE 'Name' || i END, i * 1.5, "
+      "'2020-01-01'::TIMESTAMP + i * INTERVAL '1 day' FROM generate_series(1, $0) AS i",
+      kNumRows));
+
+  auto explain = [&conn](const std::string& query) -> Result<std::string> {
+    auto res = VERIFY_RESULT(conn.Fetch("EXPLAIN " + query));
+    std::string plan;
+    for (int i = 0; i != PQntuples(res.get()); ++i) {
+      plan += VERIFY_RESULT(GetString(res.get(), i, 0)) + "\n";
+    }
+    return plan;
+  };
+
+  // Filters whose evaluation does not depend on the database collation are always pushed down.
+  const std::vector<std::string> filters = {
+      "amount * 2 > 100",
+      "ts + INTERVAL '1 day' < '2020-02-01'",
+      "name IS NULL OR key < 10",
+      "NOT (name IS NOT NULL AND amount < 30)",
+      "lower(name COLLATE \"C\") LIKE 'name1%' AND key % 2 = 0",
+  };
+  for (const auto& filter : filters) {
+    const auto count_query = "SELECT COUNT(*) FROM t WHERE " + filter;
+    const auto keys_query = "SELECT SUM(key) FROM (SELECT key FROM t WHERE " + filter + ") AS s";
+
+    ASSERT_OK(conn.Execute("SET yb_enable_expression_pushdown = false"));
+    ASSERT_EQ(ASSERT_RESULT(explain(count_query)).find("Remote Filter"), std::string::npos);
+    const auto expected_count = ASSERT_RESULT(conn.FetchValue<int64_t>(count_query));
+    const auto expected_keys = ASSERT_RESULT(conn.FetchValue<int64_t>(keys_query));
+    ASSERT_GT(expected_count, 0) << filter;
+
+    ASSERT_OK(conn.Execute("SET yb_enable_expression_pushdown = true"));
+    ASSERT_STR_CONTAINS(ASSERT_RESULT(explain(count_query)), "Remote Filter");
+    ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>(count_query)), expected_count) << filter;
+    ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>(keys_query)), expected_keys) << filter;
+  }
+}
+
 } // namespace pgwrapper
 } // namespace yb
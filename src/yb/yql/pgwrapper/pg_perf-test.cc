@@ -0,0 +1,148 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Performance workloads of YSQL, see PerfReport for how results are reported and compared against
+// baselines.
+
+#include "yb/integration-tests/perf_report.h"
+
+#include "yb/util/random_util.h"
+#include "yb/util/test_macros.h"
+
+#include "yb/yql/pgwrapper/libpq_test_base.h"
+#include "yb/yql/pgwrapper/libpq_utils.h"
+
+namespace yb {
+namespace pgwrapper {
+
+namespace {
+
+constexpr size_t kNumThreads = 16;
+constexpr int kNumKeys = 100000;
+constexpr int kNumScanPartitions = 100;
+constexpr int kRowsPerScanPartition = 1000;
+// Number of keys updated by contended transactions.
+constexpr int kNumHotKeys = 10;
+
+} // namespace
+
+class PgPerfTest : public LibPqTestBase {
+ protected:
+  void SetUp() override {
+    if (!PerfTestsEnabled()) {
+      LOG(INFO) << "Skipping performance test, use --run_perf_tests to run it";
+      YBMiniClusterTestBase<ExternalMiniCluster>::SetUp();
+      return;
+    }
+    LibPqTestBase::SetUp();
+  }
+
+  void UpdateMiniClusterOptions(ExternalMiniClusterOptions* options) override {
+    for (auto& flag : PerfClusterTServerFlags()) {
+      options->extra_tserver_flags.push_back(std::move(flag));
+    }
+  }
+
+  // Opens a connection for each workload thread.
+  Result<std::vector<PGConn>> ConnectThreads() {
+    std::vector<PGConn> result;
+    result.reserve(kNumThreads);
+    for (size_t i = 0; i != kNumThreads; ++i) {
+      result.push_back(VERIFY_RESULT(Connect()));
+    }
+    return result;
+  }
+};
+
+TEST_F(PgPerfTest, YB_DISABLE_TEST_IN_TSAN(PointOps)) {
+  if (!PerfTestsEnabled()) {
+    return;
+  }
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE kv (k INT PRIMARY KEY, v TEXT)"));
+  auto conns = ASSERT_RESULT(ConnectThreads());
+  const std::string value(100, 'v');
+  PerfReport report("ysql_point_ops");
+
+  report.Add(RunPerfWorkload("ysql_point_write", kNumThreads, [&conns, &value](size_t idx) {
+    return conns[idx].ExecuteFormat(
+        "INSERT INTO kv (k, v) VALUES ($0, '$1') ON CONFLICT (k) DO UPDATE SET v = EXCLUDED.v",
+        RandomUniformInt(0, kNumKeys - 1), value);
+  }));
+
+  report.Add(RunPerfWorkload("ysql_point_read", kNumThreads, [&conns](size_t idx) {
+    auto result = conns[idx].FetchFormat(
+        "SELECT v FROM kv WHERE k = $0", RandomUniformInt(0, kNumKeys - 1));
+    return result.ok() ? Status::OK() : result.status();
+  }));
+
+  ASSERT_OK(report.Finish());
+}
+
+TEST_F(PgPerfTest, YB_DISABLE_TEST_IN_TSAN(Scan)) {
+  if (!PerfTestsEnabled()) {
+    return;
+  }
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE scan (h INT, r INT, v TEXT, PRIMARY KEY (h HASH, r ASC))"));
+  for (int h = 0; h != kNumScanPartitions; ++h) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "INSERT INTO scan SELECT $0, r, repeat('v', 100) FROM generate_series(0, $1) r",
+        h, kRowsPerScanPartition - 1));
+  }
+  auto conns = ASSERT_RESULT(ConnectThreads());
+  PerfReport report("ysql_scan");
+
+  report.Add(RunPerfWorkload("ysql_partition_scan", kNumThreads, [&conns](size_t idx) {
+    auto result = conns[idx].FetchFormat(
+        "SELECT r, v FROM scan WHERE h = $0", RandomUniformInt(0, kNumScanPartitions - 1));
+    return result.ok() ? Status::OK() : result.status();
+  }));
+
+  ASSERT_OK(report.Finish());
+}
+
+TEST_F(PgPerfTest, YB_DISABLE_TEST_IN_TSAN(ContendedTransactions)) {
+  if (!PerfTestsEnabled()) {
+    return;
+  }
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE txn_kv (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO txn_kv SELECT k, 0 FROM generate_series(0, $0) k", kNumHotKeys - 1));
+  auto conns = ASSERT_RESULT(ConnectThreads());
+  PerfReport report("ysql_contended_transactions");
+
+  report.Add(RunPerfWorkload("ysql_contended_txn", kNumThreads, [&conns](size_t idx) {
+    auto& conn = conns[idx];
+    RETURN_NOT_OK(conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+    auto status = conn.ExecuteFormat(
+        "UPDATE txn_kv SET v = v + 1 WHERE k = $0", RandomUniformInt(0, kNumHotKeys - 1));
+    if (status.ok()) {
+      status = conn.ExecuteFormat(
+          "UPDATE txn_kv SET v = v + 1 WHERE k = $0", RandomUniformInt(0, kNumHotKeys - 1));
+    }
+    if (status.ok()) {
+      status = conn.CommitTransaction();
+    }
+    if (!status.ok()) {
+      WARN_NOT_OK(conn.RollbackTransaction(), "Rollback failed");
+    }
+    return status;
+  }));
+
+  ASSERT_OK(report.Finish());
+}
+
+} // namespace pgwrapper
+} // namespace yb
@@ -21,6 +21,7 @@
 
 #include <gflags/gflags.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/ip/tcp.hpp>
 
 #include "yb/util/errno.h"
 #include "yb/util/flag_tags.h"
@@ -31,6 +32,8 @@
 #include "yb/util/path_util.h"
 #include "yb/util/scope_exit.h"
 
+#include "yb/yql/pgwrapper/pg_conn_pooler.h"
+
 DEFINE_string(pg_proxy_bind_address, "", "Address for the PostgreSQL proxy to bind to");
 DEFINE_bool(pg_transactions_enabled, true,
             "True to enable transactions in YugaByte PostgreSQL API. This should eventually "
@@ -73,6 +76,17 @@ DEFINE_string(ysql_pg_conf, "",
 DEFINE_string(ysql_hba_conf, "",
               "Comma separated list of postgres hba rules (in order)");
 
+DEFINE_bool(ysql_conn_pooler_enabled, false,
+            "Accept ysql connections by the tablet server and multiplex them over a bounded pool "
+            "of postgres backends, instead of starting a backend per connection. Could not be "
+            "used with ysql_enable_auth, TLS or ysql_hba_conf, because postmaster then listens "
+            "on a loopback address and trusts all connections from loopback addresses.");
+DEFINE_int32(ysql_conn_pooler_postmaster_port, 6433,
+             "Local port that postmaster listens on when ysql connection pooler is enabled. "
+             "Postmaster uses the ysql bind address if it is a loopback address, and 127.0.0.1 "
+             "otherwise.");
+TAG_FLAG(ysql_conn_pooler_postmaster_port, advanced);
+
 using std::vector;
 using std::string;
 
@@ -182,7 +196,12 @@ Result<string> WritePostgresConfig(const PgProcessConf& conf) {
 Result<string> WritePgHbaConfig(const PgProcessConf& conf) {
   vector<string> lines;
 
-  if (FLAGS_ysql_enable_auth || conf.enable_tls) {
+  if (FLAGS_ysql_conn_pooler_enabled) {
+    // Postmaster listens on a loopback address, and is only reached through the connection
+    // pooler, that connects on behalf of its clients without authentication.
+    lines.push_back("host all all 127.0.0.0/8 trust");
+    lines.push_back("host all all ::1/128 trust");
+  } else if (FLAGS_ysql_enable_auth || conf.enable_tls) {
     const auto host_type =  conf.enable_tls ? "hostssl" : "host";
     const auto auth_method = FLAGS_ysql_enable_auth ? (conf.enable_tls ? "md5 clientcert=1" : "md5")
                                                     : "cert";
@@ -192,7 +211,7 @@ Result<string> WritePgHbaConfig(const PgProcessConf& conf) {
     }
   }
 
-  if (!FLAGS_ysql_hba_conf.empty()) {
+  if (!FLAGS_ysql_conn_pooler_enabled && !FLAGS_ysql_hba_conf.empty()) {
     ReadCSVConfigValues(FLAGS_ysql_hba_conf, &lines);
   }
 
@@ -471,10 +490,16 @@ PgSupervisor::PgSupervisor(PgProcessConf conf)
     : conf_(std::move(conf)) {
 }
 
+PgSupervisor::~PgSupervisor() {
+}
+
 Status PgSupervisor::Start() {
   std::lock_guard<std::mutex> lock(mtx_);
   RETURN_NOT_OK(ExpectStateUnlocked(PgProcessState::kNotStarted));
   RETURN_NOT_OK(CleanupOldServerUnlocked());
+  if (FLAGS_ysql_conn_pooler_enabled) {
+    RETURN_NOT_OK(StartConnPoolerUnlocked());
+  }
   LOG(INFO) << "Starting PostgreSQL server";
   RETURN_NOT_OK(StartServerUnlocked());
 
@@ -490,6 +515,37 @@ Status PgSupervisor::Start() {
   return Status::OK();
 }
 
+CHECKED_STATUS PgSupervisor::StartConnPoolerUnlocked() {
+  // Pooler connects to postmaster on behalf of clients, so it relies on trust authentication of
+  // loopback connections, and custom hba rules could not be applied to clients.
+  if (FLAGS_ysql_enable_auth || conf_.enable_tls || !FLAGS_ysql_hba_conf.empty()) {
+    return STATUS(NotSupported,
+                  "YSQL connection pooler could not be used with authentication, TLS or "
+                  "ysql_hba_conf");
+  }
+
+  std::vector<Endpoint> listen;
+  RETURN_NOT_OK(ParseAddressList(conf_.listen_addresses, conf_.pg_port, &listen));
+  // Postmaster is only reachable through the pooler. When YSQL is bound to a loopback address,
+  // postmaster listens on the same address, so tablet servers running on the same host with
+  // different loopback addresses don't share the postmaster endpoint.
+  IpAddress postmaster_address = boost::asio::ip::address_v4::loopback();
+  if (!listen.empty() && listen.front().address().is_loopback()) {
+    postmaster_address = listen.front().address();
+  }
+  Endpoint postmaster(postmaster_address, FLAGS_ysql_conn_pooler_postmaster_port);
+  conf_.listen_addresses = postmaster_address.to_string();
+  conf_.pg_port = postmaster.port();
+
+  conn_pooler_ = std::make_unique<PgConnPooler>();
+  auto status = conn_pooler_->Start(listen, postmaster);
+  if (!status.ok()) {
+    conn_pooler_->Shutdown();
+    conn_pooler_.reset();
+  }
+  return status;
+}
+
 CHECKED_STATUS PgSupervisor::CleanupOldServerUnlocked() {
   std::string postmaster_pid_filename = JoinPathSegments(conf_.data_dir, "postmaster.pid");
   if (Env::Default()->FileExists(postmaster_pid_filename)) {
@@ -588,6 +644,9 @@ void PgSupervisor::Stop() {
     }
   }
   supervisor_thread_->Join();
+  if (conn_pooler_) {
+    conn_pooler_->Shutdown();
+  }
 }
 
 }  // namespace pgwrapper
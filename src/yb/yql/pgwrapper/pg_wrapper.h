@@ -15,6 +15,7 @@
 
 #include <string>
 #include <atomic>
+#include <memory>
 
 #include <boost/optional.hpp>
 
@@ -27,6 +28,8 @@
 namespace yb {
 namespace pgwrapper {
 
+class PgConnPooler;
+
 // Returns the root directory of our PostgreSQL installation.
 std::string GetPostgresInstallRoot();
 
@@ -111,6 +114,7 @@ YB_DEFINE_ENUM(PgProcessState,
 class PgSupervisor {
  public:
   explicit PgSupervisor(PgProcessConf conf);
+  ~PgSupervisor();
 
   CHECKED_STATUS Start();
   void Stop();
@@ -119,11 +123,14 @@ class PgSupervisor {
  private:
   CHECKED_STATUS ExpectStateUnlocked(PgProcessState state);
   CHECKED_STATUS StartServerUnlocked();
+  // Starts connection pooler at the configured address, and moves postmaster to a local port.
+  CHECKED_STATUS StartConnPoolerUnlocked();
   void RunThread();
   CHECKED_STATUS CleanupOldServerUnlocked();
 
   PgProcessConf conf_;
   boost::optional<PgWrapper> pg_wrapper_;
+  std::unique_ptr<PgConnPooler> conn_pooler_;
   PgProcessState state_ = PgProcessState::kNotStarted;
   scoped_refptr<Thread> supervisor_thread_;
   std::mutex mtx_;
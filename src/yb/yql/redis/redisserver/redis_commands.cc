@@ -25,6 +25,8 @@
 #include "yb/client/table_creator.h"
 #include "yb/client/yb_op.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/master/master.pb.h"
 #include "yb/master/master_util.h"
 
@@ -63,6 +65,12 @@ DEFINE_string(redis_passwords_separator, ",", "The character used to separate mu
 DEFINE_int32(redis_keys_threshold, 10000,
              "Maximum number of keys allowed to be in the db before the KEYS operation errors out");
 
+DEFINE_int32(redis_collection_page_size, 0,
+             "When positive, HGETALL, HKEYS, HVALS and SMEMBERS read collections from tablet "
+             "servers in pages of up to this number of entries, instead of reading the whole "
+             "collection in one RPC. Pages are read at different times, so such command is not "
+             "atomic when the collection does not fit into one page.");
+
 __attribute__((unused))
 DEFINE_validator(redis_passwords_separator, &ValidateRedisPasswordSeparator);
 
@@ -75,13 +83,13 @@ namespace redisserver {
     ((hget, HGet, 3, READ)) \
     ((tsget, TsGet, 3, READ)) \
     ((hmget, HMGet, -3, READ)) \
-    ((hgetall, HGetAll, 2, READ)) \
-    ((hkeys, HKeys, 2, READ)) \
-    ((hvals, HVals, 2, READ)) \
+    ((hgetall, HGetAll, 2, PAGED_READ)) \
+    ((hkeys, HKeys, 2, PAGED_READ)) \
+    ((hvals, HVals, 2, PAGED_READ)) \
     ((hlen, HLen, 2, READ)) \
     ((hexists, HExists, 3, READ)) \
     ((hstrlen, HStrLen, 3, READ)) \
-    ((smembers, SMembers, 2, READ)) \
+    ((smembers, SMembers, 2, PAGED_READ)) \
     ((sismember, SIsMember, 3, READ)) \
     ((scard, SCard, 2, READ)) \
     ((strlen, StrLen, 2, READ)) \
@@ -120,6 +128,8 @@ namespace redisserver {
     ((config, Config, -1, LOCAL)) \
     ((info, Info, -1, LOCAL)) \
     ((role, Role, 1, LOCAL)) \
+    ((readonly, ReadOnly, 1, LOCAL)) \
+    ((readwrite, ReadWrite, 1, LOCAL)) \
     ((select, Select, 2, LOCAL)) \
     ((createdb, CreateDB, 2, LOCAL)) \
     ((listdb, ListDB, 1, LOCAL)) \
@@ -187,6 +197,15 @@ namespace {
 template<class Op>
 using Parser = Status(*)(Op*, const RedisClientCommand&);
 
+void SetupOperation(client::YBRedisReadOp* op, BatchContext* context) {
+  if (context->call()->connection_context().follower_reads()) {
+    op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+  }
+}
+
+void SetupOperation(client::YBRedisWriteOp* op, BatchContext* context) {
+}
+
 template<class Op>
 void Command(
     const RedisCommandInfo& info,
@@ -208,11 +227,14 @@ void Command(
     RespondWithFailure(context->call(), idx, s.message().ToBuffer());
     return;
   }
+  SetupOperation(op.get(), context);
   context->Apply(idx, std::move(op), info.metrics);
 }
 
 #define READ_COMMAND(cname) \
     Command<yb::client::YBRedisReadOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
+#define PAGED_READ_COMMAND(cname) \
+    PagedReadCommand(info, idx, &BOOST_PP_CAT(Parse, cname), context)
 #define WRITE_COMMAND(cname) \
     Command<yb::client::YBRedisWriteOp>(info, idx, &BOOST_PP_CAT(Parse, cname), context)
 #define LOCAL_COMMAND(cname) \
@@ -544,6 +566,18 @@ void HandleRole(LocalCommandData data) {
   data.Respond(&response);
 }
 
+// Allows reads of this connection to be served by the closest replica, that could be a follower
+// lagging behind the leader by at most max_stale_read_bound_time_ms.
+void HandleReadOnly(LocalCommandData data) {
+  data.call()->connection_context().set_follower_reads(true);
+  data.Respond();
+}
+
+void HandleReadWrite(LocalCommandData data) {
+  data.call()->connection_context().set_follower_reads(false);
+  data.Respond();
+}
+
 void HandleInfo(LocalCommandData data) {
   RedisResponsePB response;
   response.set_code(RedisResponsePB::OK);
@@ -986,6 +1020,126 @@ void HandleKeys(LocalCommandData data) {
   }
 }
 
+// Reads the collection in pages of redis_collection_page_size entries. When it does not fit into
+// one page, elements of the pages are encoded as they arrive, so only the encoded response is kept
+// in memory, and each tablet server RPC returns a bounded number of entries.
+class CollectionPagesReader : public std::enable_shared_from_this<CollectionPagesReader> {
+ public:
+  CollectionPagesReader(const LocalCommandData& data,
+                        std::shared_ptr<client::YBRedisReadOp> operation)
+      : data_(data), operation_(std::move(operation)) {
+  }
+
+  bool Store(client::YBSession* session, const StatusFunctor& callback) {
+    session_ = session;
+    callback_ = callback;
+    Execute();
+    return true;
+  }
+
+ private:
+  void Execute() {
+    operation_->mutable_request()->set_page_size(FLAGS_redis_collection_page_size);
+    session_->set_allow_local_calls_in_curr_thread(false);
+    auto status = session_->Apply(operation_);
+    if (!status.ok()) {
+      ProcessedAll(status, nullptr);
+      return;
+    }
+    session_->FlushAsync(std::bind(
+        &CollectionPagesReader::ProcessedPage, shared_from_this(), _1));
+  }
+
+  void ProcessedPage(const Status& status) {
+    if (!status.ok()) {
+      ProcessedAll(status, nullptr);
+      return;
+    }
+
+    auto& response = *operation_->mutable_response();
+    if (response.code() != RedisResponsePB::OK ||
+        (num_elements_ == 0 && !response.has_next_subkey())) {
+      // Errors, and collections that fit into one page, are returned as is.
+      ProcessedAll(Status::OK(), &response);
+      return;
+    }
+
+    for (const auto& element : response.array_response().elements()) {
+      auto old_size = encoded_.size();
+      encoded_.resize(old_size + SerializeBulkString(element, size_t(0)));
+      SerializeBulkString(element, pointer_cast<uint8_t*>(&encoded_[old_size]));
+    }
+    num_elements_ += response.array_response().elements_size();
+
+    if (!response.has_next_subkey()) {
+      RedisResponsePB result;
+      result.set_code(RedisResponsePB::OK);
+      encoded_.insert(0, "*" + std::to_string(num_elements_) + "\r\n");
+      result.mutable_encoded_response()->swap(encoded_);
+      ProcessedAll(Status::OK(), &result);
+      return;
+    }
+
+    // The next page is read by a new operation, since the operation could not be reused after
+    // its response is received.
+    auto next = std::make_shared<client::YBRedisReadOp>(data_.table()->shared_from_this());
+    next->mutable_request()->CopyFrom(operation_->request());
+    next->mutable_request()->set_start_subkey(response.next_subkey());
+    next->set_yb_consistency_level(operation_->yb_consistency_level());
+    operation_ = std::move(next);
+    Execute();
+  }
+
+  void ProcessedAll(const Status& status, RedisResponsePB* response) {
+    data_.Respond(status, response);
+    callback_(status);
+  }
+
+  LocalCommandData data_;
+  std::shared_ptr<client::YBRedisReadOp> operation_;
+  client::YBSession* session_ = nullptr;
+  StatusFunctor callback_;
+  // Elements of the pages received so far, encoded as bulk strings.
+  std::string encoded_;
+  size_t num_elements_ = 0;
+};
+
+void PagedReadCommand(
+    const RedisCommandInfo& info,
+    size_t idx,
+    Parser<client::YBRedisReadOp> parser,
+    BatchContext* context) {
+  if (FLAGS_redis_collection_page_size <= 0) {
+    Command<client::YBRedisReadOp>(info, idx, parser, context);
+    return;
+  }
+
+  VLOG(1) << "Processing " << info.name << " in pages.";
+
+  auto table = context->table();
+  if (!table) {
+    RespondWithFailure(context->call(), idx, "Could not open YBTable");
+    return;
+  }
+
+  auto op = std::make_shared<client::YBRedisReadOp>(table);
+  Status s = parser(op.get(), context->command(idx));
+  std::string partition_key;
+  if (s.ok()) {
+    s = op->GetPartitionKey(&partition_key);
+  }
+  if (!s.ok()) {
+    RespondWithFailure(context->call(), idx, s.message().ToBuffer());
+    return;
+  }
+  SetupOperation(op.get(), context);
+
+  LocalCommandData data(info, idx, context);
+  auto reader = std::make_shared<CollectionPagesReader>(data, std::move(op));
+  data.Apply(std::bind(&CollectionPagesReader::Store, reader, _1, _2), partition_key,
+             ManualResponse::kTrue);
+}
+
 void HandleCommand(LocalCommandData data) {
   data.Respond();
 }
@@ -0,0 +1,127 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "yb/yql/redis/redisserver/redis_parser.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace redisserver {
+
+class RedisParserTest : public YBTest {
+ protected:
+  // Parses command from single block and from two blocks split at the specified position.
+  // Numbers that are split between blocks are always parsed by the general routine, so the
+  // results show whether fast path accepts and rejects the same numbers as the general one.
+  void CheckSamePaths(const std::string& command, size_t split, bool expected_ok) {
+    SCOPED_TRACE(Format("Command: $0, split: $1", Slice(command).ToDebugString(), split));
+    ASSERT_LE(split, command.size());
+    std::string fast_input = command;
+    auto fast = Parse({MakeIoVec(&fast_input, 0, fast_input.size())});
+
+    std::string slow_input = command;
+    auto slow = Parse({MakeIoVec(&slow_input, 0, split),
+                       MakeIoVec(&slow_input, split, slow_input.size() - split)});
+
+    ASSERT_EQ(expected_ok, fast.ok()) << fast;
+    ASSERT_EQ(fast.ok(), slow.ok()) << "Fast: " << fast << ", slow: " << slow;
+    if (fast.ok()) {
+      ASSERT_EQ(*fast, *slow);
+    } else {
+      ASSERT_EQ(fast.status().code(), slow.status().code());
+      ASSERT_EQ(fast.status().message(), slow.status().message());
+    }
+  }
+
+  // Same as above, but splits the command after the first character of the number, that follows
+  // the first occurrence of prefix. So number should contain at least 2 characters, or be empty.
+  void CheckSamePaths(const std::string& command, char prefix, bool expected_ok) {
+    auto pos = command.find(prefix);
+    ASSERT_NE(pos, std::string::npos);
+    auto number_end = command.find('\r', pos);
+    ASSERT_NE(number_end, pos + 2);
+    CheckSamePaths(command, std::min(pos + 2, number_end), expected_ok);
+  }
+
+ private:
+  static iovec MakeIoVec(std::string* input, size_t offset, size_t length) {
+    return iovec{&(*input)[offset], length};
+  }
+
+  static Result<size_t> Parse(const IoVecs& source) {
+    RedisParser parser(source);
+    return parser.NextCommand();
+  }
+};
+
+TEST_F(RedisParserTest, NumberOfArguments) {
+  const std::string kArg = "$3\r\nfoo\r\n";
+  const std::string kLimit = std::to_string(1 << 20);
+  const std::string kOverLimit = std::to_string((1 << 20) + 1);
+  // Number is not split, so fast path is used in both cases.
+  CheckSamePaths("*1\r\n" + kArg, 1, true);
+  // 19 digits and sign are parsed by the general routine in both cases.
+  CheckSamePaths("*02\r\n" + kArg + kArg, '*', true);
+  CheckSamePaths("*01\r\n" + kArg, '*', true);
+  CheckSamePaths("*000000000000000001\r\n" + kArg, '*', true);
+  CheckSamePaths("*0000000000000000001\r\n" + kArg, '*', true);
+  CheckSamePaths("*+1\r\n" + kArg, '*', true);
+  // Command is not complete yet, but the number is accepted.
+  CheckSamePaths("*" + kLimit + "\r\n" + kArg, '*', true);
+
+  CheckSamePaths("*\r\n" + kArg, '*', false);
+  CheckSamePaths("*00\r\n" + kArg, '*', false);
+  CheckSamePaths("*-1\r\n" + kArg, '*', false);
+  CheckSamePaths("*" + kOverLimit + "\r\n" + kArg, '*', false);
+  CheckSamePaths("*1x\r\n" + kArg, '*', false);
+  CheckSamePaths("* 1\r\n" + kArg, '*', false);
+  CheckSamePaths("*999999999999999999\r\n" + kArg, '*', false);
+}
+
+TEST_F(RedisParserTest, ArgumentSize) {
+  const std::string kInt64Max = std::to_string(std::numeric_limits<int64_t>::max());
+  const std::string kInt64Min = std::to_string(std::numeric_limits<int64_t>::min());
+
+  CheckSamePaths("*1\r\n$3\r\nfoo\r\n", 5, true);
+  CheckSamePaths("*1\r\n$-0\r\n\r\n", '$', true);
+  CheckSamePaths("*1\r\n$03\r\nfoo\r\n", '$', true);
+  CheckSamePaths("*1\r\n$000000000000000003\r\nfoo\r\n", '$', true);
+  CheckSamePaths("*1\r\n$0000000000000000003\r\nfoo\r\n", '$', true);
+  CheckSamePaths("*1\r\n$00\r\n\r\n", '$', true);
+  CheckSamePaths("*1\r\n$+3\r\nfoo\r\n", '$', true);
+  CheckSamePaths("*1\r\n$" + std::to_string(kMaxRedisValueSize) + "\r\nfoo\r\n", '$', true);
+
+  CheckSamePaths("*1\r\n$\r\nfoo\r\n", '$', false);
+  CheckSamePaths("*1\r\n$-3\r\nfoo\r\n", '$', false);
+  CheckSamePaths("*1\r\n$" + std::to_string(kMaxRedisValueSize + 1) + "\r\nfoo\r\n", '$', false);
+  // Longest number accepted by fast path.
+  CheckSamePaths("*1\r\n$999999999999999999\r\nfoo\r\n", '$', false);
+  // INT64 boundaries are parsed by the general routine and rejected by bounds check.
+  CheckSamePaths("*1\r\n$" + kInt64Max + "\r\nfoo\r\n", '$', false);
+  CheckSamePaths("*1\r\n$" + kInt64Min + "\r\nfoo\r\n", '$', false);
+  // Overflow.
+  CheckSamePaths("*1\r\n$9223372036854775808\r\nfoo\r\n", '$', false);
+  CheckSamePaths("*1\r\n$-9223372036854775809\r\nfoo\r\n", '$', false);
+  CheckSamePaths("*1\r\n$99999999999999999999\r\nfoo\r\n", '$', false);
+  // Longer than kMaxNumberLength.
+  CheckSamePaths("*1\r\n$" + std::string(26, '0') + "3\r\nfoo\r\n", '$', false);
+}
+
+} // namespace redisserver
+} // namespace yb
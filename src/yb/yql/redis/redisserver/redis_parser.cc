@@ -96,6 +96,25 @@ Result<int32_t> ParseInt32(const Slice& slice, const char* field) {
   return static_cast<int32_t>(*val);
 }
 
+// Parses decimal number without sign, that fits int64_t.
+// Returns false when number has other form, so it should be parsed by general routine.
+bool TryParseUnsignedDecimal(const char* begin, const char* end, int64_t* result) {
+  constexpr ptrdiff_t kMaxSafeDigits = std::numeric_limits<int64_t>::digits10;
+  if (begin == end || end - begin > kMaxSafeDigits) {
+    return false;
+  }
+  int64_t value = 0;
+  for (auto p = begin; p != end; ++p) {
+    unsigned digit = static_cast<unsigned char>(*p) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  *result = value;
+  return true;
+}
+
 } // namespace
 
 CHECKED_STATUS ParseSet(YBRedisWriteOp *op, const RedisClientCommand& args) {
@@ -1201,11 +1220,20 @@ Result<ptrdiff_t> RedisParser::ParseNumber(char prefix,
     return STATUS_FORMAT(
         Corruption, "Too long $0 of length $1", name, expected_stop - number_begin);
   }
-  number_buffer_.reserve(kMaxNumberLength);
-  IoVecsToBuffer(source_, number_begin, expected_stop, &number_buffer_);
-  number_buffer_.push_back(0);
-  auto parsed_number = VERIFY_RESULT(CheckedStoll(
-      Slice(number_buffer_.data(), number_buffer_.size() - 1)));
+  int64_t parsed_number = 0;
+  // Fast path for the usual case of non negative number, that is not split between iovecs.
+  auto number_location = offset_to_idx_and_local_offset(number_begin);
+  const auto& number_iov = source_[number_location.first];
+  const size_t number_length = expected_stop - number_begin;
+  const char* number_ptr = IoVecBegin(number_iov) + number_location.second;
+  if (number_location.second + number_length > number_iov.iov_len ||
+      !TryParseUnsignedDecimal(number_ptr, number_ptr + number_length, &parsed_number)) {
+    number_buffer_.reserve(kMaxNumberLength);
+    IoVecsToBuffer(source_, number_begin, expected_stop, &number_buffer_);
+    number_buffer_.push_back(0);
+    parsed_number = VERIFY_RESULT(CheckedStoll(
+        Slice(number_buffer_.data(), number_buffer_.size() - 1)));
+  }
   static_assert(sizeof(parsed_number) == sizeof(ptrdiff_t), "Expected size");
   SCHECK_BOUNDS(parsed_number,
                 min,
@@ -294,6 +294,7 @@ bool RedisInboundCall::DumpPB(const rpc::DumpRunningRpcsRequestPB& req,
   }
   resp->set_elapsed_millis(MonoTime::Now().GetDeltaSince(timing_.time_received)
       .ToMilliseconds());
+  DumpTiming(resp);
 
   if (!parsed_.load(std::memory_order_acquire)) {
     return true;
@@ -386,7 +387,8 @@ void RedisInboundCall::Respond(size_t idx, bool is_success, RedisResponsePB* res
     // Did we get all responses and ready to send data.
     size_t responded = ready_count_.fetch_add(1, std::memory_order_release) + 1;
     if (responded == client_batch_.size()) {
-      RecordHandlingCompleted(/* handler_run_time */ nullptr);
+      // Per command metrics are recorded by RespondSuccess.
+      RecordHandlingCompleted(rpc::RpcMethodMetrics());
       QueueResponse(!had_failures_.load(std::memory_order_acquire));
     }
   }
@@ -56,6 +56,15 @@ class RedisConnectionContext : public rpc::ConnectionContextWithQueue {
     redis_db_name_ = name;
   }
 
+  // Whether reads of this connection could be served by followers, see READONLY command.
+  bool follower_reads() const {
+    return follower_reads_.load(std::memory_order_acquire);
+  }
+
+  void set_follower_reads(bool flag) {
+    follower_reads_.store(flag, std::memory_order_release);
+  }
+
   static std::string Name() { return "Redis"; }
 
   RedisClientMode ClientMode() { return mode_.load(std::memory_order_acquire); }
@@ -94,6 +103,7 @@ class RedisConnectionContext : public rpc::ConnectionContextWithQueue {
   size_t commands_in_batch_ = 0;
   size_t end_of_batch_ = 0;
   std::atomic<bool> authenticated_{false};
+  std::atomic<bool> follower_reads_{false};
   std::string redis_db_name_ = "0";
   std::atomic<RedisClientMode> mode_{RedisClientMode::kNormal};
   CoarseTimePoint soft_limit_exceeded_since_{CoarseTimePoint::max()};
@@ -874,6 +874,7 @@ class BatchContextImpl : public BatchContext {
       for (auto& operation : operations_) {
         operation.Respond(table.status());
       }
+      return;
     }
     auto deadline = CoarseMonoClock::Now() + FLAGS_redis_service_yb_client_timeout_millis * 1ms;
     lookups_left_.store(operations_.size(), std::memory_order_release);
@@ -931,7 +932,7 @@ class BatchContextImpl : public BatchContext {
     if (!result.ok()) {
       auto status = result.status();
       if (status.IsNotFound() && retries < kMaxRetries) {
-        retry_lookups_.store(false, std::memory_order_release);
+        retry_lookups_.store(true, std::memory_order_release);
       } else {
         operation->Respond(status);
       }
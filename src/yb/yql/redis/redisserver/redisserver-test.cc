@@ -58,6 +58,7 @@ DECLARE_int32(redis_service_yb_client_timeout_millis);
 DECLARE_int32(redis_max_value_size);
 DECLARE_int32(redis_max_command_size);
 DECLARE_int32(redis_password_caching_duration_ms);
+DECLARE_int32(redis_collection_page_size);
 DECLARE_int32(rpc_max_message_size);
 DECLARE_int32(consensus_max_batch_size_bytes);
 DECLARE_int32(consensus_rpc_timeout_ms);
@@ -5108,6 +5109,20 @@ TEST_F(TestRedisService, TestQuit) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestReadOnly) {
+  DoRedisTestOk(__LINE__, {"SET", "key", "value"});
+  SyncClient();
+  DoRedisTestOk(__LINE__, {"READONLY"});
+  DoRedisTestBulkString(__LINE__, {"GET", "key"}, "value");
+  // Writes are still allowed and served by the leader.
+  DoRedisTestOk(__LINE__, {"SET", "key", "new_value"});
+  SyncClient();
+  DoRedisTestOk(__LINE__, {"READWRITE"});
+  DoRedisTestBulkString(__LINE__, {"GET", "key"}, "new_value");
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestFlushAll) {
   TestFlush("FLUSHALL", false);
   TestFlush("FLUSHALL", true);
@@ -5282,5 +5297,33 @@ TEST_F(TestRedisService, SortedSetsIncr) {
   SyncClient();
 }
 
+TEST_F(TestRedisService, PagedCollections) {
+  FLAGS_redis_collection_page_size = 2;
+
+  DoRedisTestOk(__LINE__, {"HMSET", "map_key", "f1", "v1", "f2", "v2", "f3", "v3", "f4", "v4"});
+  DoRedisTestInt(__LINE__, {"SADD", "set_key", "s1", "s2", "s3", "s4", "s5"}, 5);
+  DoRedisTestInt(__LINE__, {"SADD", "small_set_key", "s1"}, 1);
+  SyncClient();
+
+  // Collection size is a multiple of the page size.
+  DoRedisTestArray(__LINE__, {"HGETALL", "map_key"},
+                   {"f1", "v1", "f2", "v2", "f3", "v3", "f4", "v4"});
+  DoRedisTestArray(__LINE__, {"HKEYS", "map_key"}, {"f1", "f2", "f3", "f4"});
+  DoRedisTestArray(__LINE__, {"HVALS", "map_key"}, {"v1", "v2", "v3", "v4"});
+  // Collection size is not a multiple of the page size.
+  DoRedisTestArray(__LINE__, {"SMEMBERS", "set_key"}, {"s1", "s2", "s3", "s4", "s5"});
+  // Collection fits into one page.
+  DoRedisTestArray(__LINE__, {"SMEMBERS", "small_set_key"}, {"s1"});
+  DoRedisTestArray(__LINE__, {"HGETALL", "does_not_exist"}, {});
+  DoRedisTestExpectError(__LINE__, {"HGETALL", "set_key"});
+  SyncClient();
+
+  DoRedisTestInt(__LINE__, {"HDEL", "map_key", "f3"}, 1);
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"HGETALL", "map_key"}, {"f1", "v1", "f2", "v2", "f4", "v4"});
+  SyncClient();
+  VerifyCallbacks();
+}
+
 }  // namespace redisserver
 }  // namespace yb